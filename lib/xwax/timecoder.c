@@ -273,12 +273,22 @@ struct timecode_def* timecoder_find_definition(const char *name)
 void timecoder_free_lookup(void) {
     unsigned int n;
 
-    for (n = 0; n < ARRAY_SIZE(timecodes); n++) {
-        struct timecode_def *def = &timecodes[n];
+    for (n = 0; n < ARRAY_SIZE(timecodes); n++)
+        timecoder_free_definition_lookup(&timecodes[n]);
+}
 
-        if (def->lookup)
-            lut_clear(&def->lut);
-    }
+/*
+ * Free the lookup table of a single timecode definition, it is built
+ * again by the next timecoder_find_definition()
+ */
+
+void timecoder_free_definition_lookup(struct timecode_def *def)
+{
+    if (!def->lookup)
+        return;
+
+    lut_clear(&def->lut);
+    def->lookup = false;
 }
 
 /*
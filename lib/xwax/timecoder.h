@@ -84,6 +84,7 @@ struct timecoder {
 
 struct timecode_def* timecoder_find_definition(const char *name);
 void timecoder_free_lookup(void);
+void timecoder_free_definition_lookup(struct timecode_def *def);
 
 void timecoder_init(struct timecoder *tc, struct timecode_def *def,
                     double speed, unsigned int sample_rate, bool phono);
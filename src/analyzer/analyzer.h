@@ -14,6 +14,8 @@
 
 #include "track/track_decl.h"
 
+class QDataStream;
+
 class Analyzer {
   public:
     virtual ~Analyzer() = default;
@@ -46,6 +48,24 @@ class Analyzer {
     // This function will be invoked after the results have been
     // stored or if processing aborted preliminary.
     virtual void cleanup() = 0;
+
+    // Checkpointing of intermediate results is optional. It allows to
+    // resume an interrupted analysis of long tracks later. Analyzers
+    // that support it serialize their state after all samples that have
+    // been processed so far and return true.
+    virtual bool saveCheckpoint(QDataStream* pStream) const {
+        Q_UNUSED(pStream);
+        return false;
+    }
+
+    // Restores the intermediate state after initialize() returned true.
+    // The following invocations of processSamples() continue with the
+    // samples after the checkpoint. Returns false if the state could not
+    // be restored, e.g. if the format or the settings have changed.
+    virtual bool restoreCheckpoint(QDataStream* pStream) {
+        Q_UNUSED(pStream);
+        return false;
+    }
 };
 
 typedef std::unique_ptr<Analyzer> AnalyzerPtr;
@@ -85,6 +105,16 @@ class AnalyzerWithState final {
         }
     }
 
+    bool saveCheckpoint(QDataStream* pStream) const {
+        DEBUG_ASSERT(m_active);
+        return m_analyzer->saveCheckpoint(pStream);
+    }
+
+    bool restoreCheckpoint(QDataStream* pStream) {
+        DEBUG_ASSERT(m_active);
+        return m_analyzer->restoreCheckpoint(pStream);
+    }
+
     void finish(TrackPointer tio) {
         if (m_active) {
             m_analyzer->storeResults(tio);
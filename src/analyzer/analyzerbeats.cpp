@@ -5,6 +5,7 @@
 #include <QVector>
 #include <QtDebug>
 
+#include "analyzer/analyzercheckpoint.h"
 #include "analyzer/constants.h"
 #include "analyzer/plugins/analyzerqueenmarybeats.h"
 #include "analyzer/plugins/analyzersoundtouchbeats.h"
@@ -13,6 +14,12 @@
 #include "track/beatutils.h"
 #include "track/track.h"
 
+namespace {
+
+const QString kCheckpointTag = QStringLiteral("beats/1");
+
+} // anonymous namespace
+
 // static
 QList<mixxx::AnalyzerPluginInfo> AnalyzerBeats::availablePlugins() {
     QList<mixxx::AnalyzerPluginInfo> plugins;
@@ -208,6 +215,34 @@ bool AnalyzerBeats::processSamples(const CSAMPLE *pIn, const int iLen) {
     return m_pPlugin->processSamples(pIn, iLen);
 }
 
+bool AnalyzerBeats::saveCheckpoint(QDataStream* pStream) const {
+    VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+        return false;
+    }
+    mixxx::analyzer::writeCheckpointTag(pStream, kCheckpointTag);
+    *pStream << m_pluginId
+             << static_cast<qint32>(m_iCurrentSample);
+    return m_pPlugin->saveCheckpoint(pStream);
+}
+
+bool AnalyzerBeats::restoreCheckpoint(QDataStream* pStream) {
+    VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+        return false;
+    }
+    if (!mixxx::analyzer::readCheckpointTag(pStream, kCheckpointTag)) {
+        return false;
+    }
+    QString pluginId;
+    qint32 currentSample = 0;
+    *pStream >> pluginId >> currentSample;
+    // The plugin might have been changed in the preferences
+    if (pStream->status() != QDataStream::Ok || pluginId != m_pluginId) {
+        return false;
+    }
+    m_iCurrentSample = currentSample;
+    return m_pPlugin->restoreCheckpoint(pStream);
+}
+
 void AnalyzerBeats::cleanup() {
     m_pPlugin.reset();
 }
@@ -33,6 +33,9 @@ class AnalyzerBeats : public Analyzer {
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
+    bool saveCheckpoint(QDataStream* pStream) const override;
+    bool restoreCheckpoint(QDataStream* pStream) override;
+
   private:
     bool shouldAnalyze(TrackPointer pTrack) const;
     static QHash<QString, QString> getExtraVersionInfo(
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QDataStream>
+#include <QString>
+#include <algorithm>
+#include <vector>
+
+#include "util/types.h"
+
+/// Helpers for serializing the intermediate state of analyzers, see
+/// Analyzer::saveCheckpoint() and Analyzer::restoreCheckpoint().
+namespace mixxx {
+
+namespace analyzer {
+
+/// Each analyzer starts its checkpoint with a tag that identifies both
+/// the analyzer and the format of the following data. The version must
+/// be incremented whenever the format changes.
+inline void writeCheckpointTag(QDataStream* pStream, const QString& tag) {
+    *pStream << tag;
+}
+
+inline bool readCheckpointTag(QDataStream* pStream, const QString& expectedTag) {
+    QString tag;
+    *pStream >> tag;
+    return pStream->status() == QDataStream::Ok && tag == expectedTag;
+}
+
+template<typename T>
+void writeCheckpointVector(QDataStream* pStream, const std::vector<T>& values) {
+    *pStream << static_cast<quint64>(values.size());
+    for (const auto& value : values) {
+        *pStream << value;
+    }
+}
+
+template<typename T>
+bool readCheckpointVector(QDataStream* pStream, std::vector<T>* pValues) {
+    quint64 size = 0;
+    *pStream >> size;
+    if (pStream->status() != QDataStream::Ok) {
+        return false;
+    }
+    pValues->clear();
+    // Don't trust the size of corrupt data for allocating memory upfront
+    constexpr quint64 kMaxReservedSize = 1 << 20;
+    pValues->reserve(static_cast<std::size_t>(std::min(size, kMaxReservedSize)));
+    for (quint64 i = 0; i < size; ++i) {
+        T value;
+        *pStream >> value;
+        if (pStream->status() != QDataStream::Ok) {
+            return false;
+        }
+        pValues->push_back(value);
+    }
+    return true;
+}
+
+} // namespace analyzer
+
+} // namespace mixxx
@@ -1,7 +1,10 @@
 #include "analyzer/analyzerebur128.h"
 
 #include <QtDebug>
+#include <cmath>
 
+#include "analyzer/analyzercheckpoint.h"
+#include "analyzer/constants.h"
 #include "track/track.h"
 #include "util/math.h"
 #include "util/sample.h"
@@ -9,11 +12,30 @@
 
 namespace {
 constexpr double kReplayGain2ReferenceLUFS = -18;
+
+// ITU-R BS.1770: Gating blocks of 400 ms with an overlap of 75%
+constexpr SINT kBlockStepsPerBlock = 4;
+constexpr double kAbsoluteGateLUFS = -70.0;
+constexpr double kRelativeGateLU = -10.0;
+
+const QString kCheckpointTag = QStringLiteral("ebur128/1");
+
+double loudnessToEnergy(double loudness) {
+    return std::pow(10.0, (loudness + 0.691) / 10.0);
+}
+
+double energyToLoudness(double energy) {
+    return 10.0 * std::log10(energy) - 0.691;
+}
+
 } // anonymous namespace
 
 AnalyzerEbur128::AnalyzerEbur128(UserSettingsPointer pConfig)
         : m_rgSettings(pConfig),
-          m_pState(nullptr) {
+          m_pState(nullptr),
+          m_framesPerBlockStep(0),
+          m_framesProcessed(0),
+          m_framesSinceReset(0) {
 }
 
 AnalyzerEbur128::~AnalyzerEbur128() {
@@ -28,10 +50,21 @@ bool AnalyzerEbur128::initialize(TrackPointer tio,
         return false;
     }
     DEBUG_ASSERT(m_pState == nullptr);
+    // The momentary loudness is calculated for the most recent 400 ms
     m_pState = ebur128_init(2u,
             static_cast<unsigned long>(sampleRate),
-            EBUR128_MODE_I);
-    return m_pState != nullptr;
+            EBUR128_MODE_M);
+    if (!m_pState) {
+        return false;
+    }
+    // Same rounding as libebur128
+    m_framesPerBlockStep = (static_cast<SINT>(sampleRate) + 5) / 10;
+    m_framesProcessed = 0;
+    m_framesSinceReset = 0;
+    m_blockEnergies.clear();
+    m_blockEnergies.reserve(
+            totalSamples / mixxx::kAnalysisChannels / m_framesPerBlockStep + 1);
+    return true;
 }
 
 void AnalyzerEbur128::cleanup() {
@@ -40,6 +73,7 @@ void AnalyzerEbur128::cleanup() {
         // ebur128_destroy clears the pointer but let's not rely on that.
         m_pState = nullptr;
     }
+    m_blockEnergies.clear();
 }
 
 bool AnalyzerEbur128::processSamples(const CSAMPLE *pIn, const int iLen) {
@@ -47,34 +81,116 @@ bool AnalyzerEbur128::processSamples(const CSAMPLE *pIn, const int iLen) {
         return false;
     }
     ScopedTimer t("AnalyzerEbur128::processSamples()");
-    size_t frames = iLen / 2;
-    int e = ebur128_add_frames_float(m_pState, pIn, frames);
-    VERIFY_OR_DEBUG_ASSERT(e == EBUR128_SUCCESS) {
-        qWarning() << "AnalyzerEbur128::processSamples() failed with" << e;
-        return false;
+    SINT remainingFrames = iLen / mixxx::kAnalysisChannels;
+    while (remainingFrames > 0) {
+        // Split the input at the boundaries of the gating blocks
+        const SINT frames = math_min(remainingFrames,
+                m_framesPerBlockStep - m_framesProcessed % m_framesPerBlockStep);
+        int e = ebur128_add_frames_float(m_pState, pIn, frames);
+        VERIFY_OR_DEBUG_ASSERT(e == EBUR128_SUCCESS) {
+            qWarning() << "AnalyzerEbur128::processSamples() failed with" << e;
+            return false;
+        }
+        pIn += frames * mixxx::kAnalysisChannels;
+        remainingFrames -= frames;
+        m_framesProcessed += frames;
+        m_framesSinceReset += frames;
+        if (m_framesProcessed % m_framesPerBlockStep == 0 &&
+                m_framesSinceReset >= kBlockStepsPerBlock * m_framesPerBlockStep) {
+            double blockLoudness;
+            e = ebur128_loudness_momentary(m_pState, &blockLoudness);
+            VERIFY_OR_DEBUG_ASSERT(e == EBUR128_SUCCESS) {
+                qWarning() << "AnalyzerEbur128::processSamples() failed with" << e;
+                return false;
+            }
+            if (blockLoudness >= kAbsoluteGateLUFS) {
+                m_blockEnergies.push_back(loudnessToEnergy(blockLoudness));
+            }
+        }
     }
     return true;
 }
 
+double AnalyzerEbur128::integratedLoudness() const {
+    if (m_blockEnergies.empty()) {
+        return -HUGE_VAL;
+    }
+    double energySum = 0.0;
+    for (const double energy : m_blockEnergies) {
+        energySum += energy;
+    }
+    const double relativeThreshold =
+            energySum / m_blockEnergies.size() *
+            std::pow(10.0, kRelativeGateLU / 10.0);
+    double gatedEnergySum = 0.0;
+    std::size_t gatedBlocks = 0;
+    for (const double energy : m_blockEnergies) {
+        if (energy >= relativeThreshold) {
+            gatedEnergySum += energy;
+            ++gatedBlocks;
+        }
+    }
+    if (gatedBlocks == 0) {
+        return -HUGE_VAL;
+    }
+    return energyToLoudness(gatedEnergySum / gatedBlocks);
+}
+
+double AnalyzerEbur128::replayGainRatio() const {
+    const double averageLufs = integratedLoudness();
+    if (averageLufs == -HUGE_VAL || averageLufs == 0.0) {
+        return 0.0;
+    }
+    return db2ratio(kReplayGain2ReferenceLUFS - averageLufs);
+}
+
 void AnalyzerEbur128::storeResults(TrackPointer tio) {
     VERIFY_OR_DEBUG_ASSERT(m_pState) {
         return;
     }
-    double averageLufs;
-    int e = ebur128_loudness_global(m_pState, &averageLufs);
-    VERIFY_OR_DEBUG_ASSERT(e == EBUR128_SUCCESS) {
-        qWarning() << "AnalyzerEbur128::storeResults() failed with" << e;
-        return;
-    }
-    if (averageLufs == -HUGE_VAL || averageLufs == 0.0) {
+    const double ratio = replayGainRatio();
+    if (ratio == 0.0) {
         qWarning() << "AnalyzerEbur128::storeResults() averageLufs invalid:"
-                   << averageLufs;
+                   << integratedLoudness();
         return;
     }
 
-    const double fReplayGain2 = kReplayGain2ReferenceLUFS - averageLufs;
     mixxx::ReplayGain replayGain(tio->getReplayGain());
-    replayGain.setRatio(db2ratio(fReplayGain2));
+    replayGain.setRatio(ratio);
     tio->setReplayGain(replayGain);
-    qDebug() << "ReplayGain 2.0 (libebur128) result is" << fReplayGain2 << "dB for" << tio->getFileInfo();
+    qDebug() << "ReplayGain 2.0 (libebur128) result is" << ratio2db(ratio)
+             << "dB for" << tio->getFileInfo();
+}
+
+bool AnalyzerEbur128::saveCheckpoint(QDataStream* pStream) const {
+    VERIFY_OR_DEBUG_ASSERT(m_pState) {
+        return false;
+    }
+    mixxx::analyzer::writeCheckpointTag(pStream, kCheckpointTag);
+    *pStream << static_cast<qint64>(m_framesPerBlockStep)
+             << static_cast<qint64>(m_framesProcessed);
+    mixxx::analyzer::writeCheckpointVector(pStream, m_blockEnergies);
+    return pStream->status() == QDataStream::Ok;
+}
+
+bool AnalyzerEbur128::restoreCheckpoint(QDataStream* pStream) {
+    VERIFY_OR_DEBUG_ASSERT(m_pState) {
+        return false;
+    }
+    if (!mixxx::analyzer::readCheckpointTag(pStream, kCheckpointTag)) {
+        return false;
+    }
+    qint64 framesPerBlockStep = 0;
+    qint64 framesProcessed = 0;
+    *pStream >> framesPerBlockStep >> framesProcessed;
+    if (pStream->status() != QDataStream::Ok ||
+            framesPerBlockStep != m_framesPerBlockStep ||
+            !mixxx::analyzer::readCheckpointVector(pStream, &m_blockEnergies)) {
+        return false;
+    }
+    // The K-weighting filters of m_pState start from scratch and
+    // the gating blocks overlapping the checkpoint are skipped.
+    m_framesProcessed = static_cast<SINT>(framesProcessed);
+    m_framesSinceReset = 0;
+    return true;
 }
@@ -2,6 +2,8 @@
 
 #include <ebur128.h>
 
+#include <vector>
+
 #include "analyzer/analyzer.h"
 #include "preferences/replaygainsettings.h"
 
@@ -21,7 +23,29 @@ class AnalyzerEbur128 : public Analyzer {
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
+    bool saveCheckpoint(QDataStream* pStream) const override;
+    bool restoreCheckpoint(QDataStream* pStream) override;
+
+    /// The ReplayGain 2.0 ratio of the samples that have been processed so
+    /// far, or 0 if they are silent. Allows to estimate the loudness before
+    /// the track has been processed completely.
+    double replayGainRatio() const;
+
   private:
+    // The gated integrated loudness according to ITU-R BS.1770
+    double integratedLoudness() const;
+
     ReplayGainSettings m_rgSettings;
     ebur128_state* m_pState;
+
+    // The energies of all overlapping 400 ms gating blocks above the
+    // absolute threshold are collected here instead of relying on the
+    // opaque state of libebur128. This allows to checkpoint the analysis.
+    std::vector<double> m_blockEnergies;
+    SINT m_framesPerBlockStep;
+    // Aligns the gating blocks with the start of the track
+    SINT m_framesProcessed;
+    // Gating blocks are only complete after 400 ms of audio have been
+    // passed to m_pState, i.e. after initializing or restoring
+    SINT m_framesSinceReset;
 };
@@ -0,0 +1,159 @@
+#include "analyzer/analyzerfingerprint.h"
+
+#include "analyzer/analyzercheckpoint.h"
+#include "analyzer/constants.h"
+#include "musicbrainz/chromaprinter.h"
+#include "track/track.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace {
+
+mixxx::Logger kLogger("AnalyzerFingerprint");
+
+// Disabled by default, because most users never look up the metadata
+// of their tracks
+const ConfigKey kAnalyzeFingerprintsConfigKey("[Library]", "AnalyzeFingerprints");
+
+const QString kCheckpointTag = QStringLiteral("fingerprint/1");
+
+} // anonymous namespace
+
+AnalyzerFingerprint::AnalyzerFingerprint(
+        UserSettingsPointer pConfig,
+        const QSqlDatabase& dbConnection)
+        : m_analysisDao(pConfig),
+          m_pContext(nullptr),
+          m_remainingSamples(0),
+          m_finished(false) {
+    m_analysisDao.initialize(dbConnection);
+}
+
+AnalyzerFingerprint::~AnalyzerFingerprint() {
+    cleanup(); // ...to prevent memory leaks
+}
+
+// static
+bool AnalyzerFingerprint::isEnabled(const UserSettingsPointer& pConfig) {
+    return pConfig->getValue(kAnalyzeFingerprintsConfigKey, false);
+}
+
+bool AnalyzerFingerprint::initialize(TrackPointer tio,
+        mixxx::audio::SampleRate sampleRate,
+        int totalSamples) {
+    if (totalSamples == 0 || !tio->getId().isValid()) {
+        return false;
+    }
+    if (!m_analysisDao.loadAnalysisFingerprint(
+                                 tio->getId(), ChromaPrinter::fingerprintVersion())
+                    .isEmpty()) {
+        kLogger.debug() << "Skipping track with a stored fingerprint";
+        return false;
+    }
+    DEBUG_ASSERT(!m_pContext);
+    m_pContext = chromaprint_new(CHROMAPRINT_ALGORITHM_DEFAULT);
+    if (!chromaprint_start(m_pContext,
+                static_cast<int>(sampleRate),
+                mixxx::kAnalysisChannels)) {
+        kLogger.warning() << "Failed to start fingerprinting";
+        cleanup();
+        return false;
+    }
+    m_remainingSamples = math_min(static_cast<SINT>(totalSamples),
+            ChromaPrinter::kFingerprintDuration *
+                    static_cast<SINT>(sampleRate) * mixxx::kAnalysisChannels);
+    m_convertedSamples.resize(mixxx::kAnalysisSamplesPerChunk);
+    m_fingerprint.clear();
+    m_finished = false;
+    return true;
+}
+
+bool AnalyzerFingerprint::processSamples(const CSAMPLE* pIn, const int iLen) {
+    if (m_finished) {
+        return true;
+    }
+    VERIFY_OR_DEBUG_ASSERT(m_pContext) {
+        return false;
+    }
+    const SINT numSamples = math_min(static_cast<SINT>(iLen), m_remainingSamples);
+    if (static_cast<SINT>(m_convertedSamples.size()) < numSamples) {
+        m_convertedSamples.resize(numSamples);
+    }
+    SampleUtil::convertFloat32ToS16(m_convertedSamples.data(), pIn, numSamples);
+    if (!chromaprint_feed(m_pContext,
+                m_convertedSamples.data(),
+                static_cast<int>(numSamples))) {
+        kLogger.warning() << "Failed to generate fingerprint from sample data";
+        return false;
+    }
+    m_remainingSamples -= numSamples;
+    if (m_remainingSamples <= 0) {
+        // Don't keep the context around for the remaining samples
+        finishFingerprint();
+    }
+    return true;
+}
+
+void AnalyzerFingerprint::finishFingerprint() {
+    DEBUG_ASSERT(m_pContext);
+    if (chromaprint_finish(m_pContext)) {
+        m_fingerprint = ChromaPrinter::encodeFingerprint(m_pContext);
+    }
+    chromaprint_free(m_pContext);
+    m_pContext = nullptr;
+    m_finished = true;
+}
+
+bool AnalyzerFingerprint::saveCheckpoint(QDataStream* pStream) const {
+    // The state of libchromaprint is opaque. Checkpoints are stored long
+    // after the fingerprint of the first minutes has been finished.
+    if (!m_finished) {
+        return false;
+    }
+    mixxx::analyzer::writeCheckpointTag(pStream, kCheckpointTag);
+    *pStream << m_fingerprint;
+    return pStream->status() == QDataStream::Ok;
+}
+
+bool AnalyzerFingerprint::restoreCheckpoint(QDataStream* pStream) {
+    if (!mixxx::analyzer::readCheckpointTag(pStream, kCheckpointTag)) {
+        return false;
+    }
+    QString fingerprint;
+    *pStream >> fingerprint;
+    if (pStream->status() != QDataStream::Ok) {
+        return false;
+    }
+    if (m_pContext) {
+        chromaprint_free(m_pContext);
+        m_pContext = nullptr;
+    }
+    m_fingerprint = fingerprint;
+    m_finished = true;
+    return true;
+}
+
+void AnalyzerFingerprint::storeResults(TrackPointer tio) {
+    if (!m_finished) {
+        // The track is shorter than the fingerprint duration
+        finishFingerprint();
+    }
+    if (m_fingerprint.isEmpty()) {
+        kLogger.warning() << "Failed to generate fingerprint for" << tio->getLocation();
+        return;
+    }
+    m_analysisDao.saveAnalysisFingerprint(tio->getId(),
+            ChromaPrinter::fingerprintVersion(),
+            m_fingerprint.toLatin1());
+}
+
+void AnalyzerFingerprint::cleanup() {
+    if (m_pContext) {
+        chromaprint_free(m_pContext);
+        m_pContext = nullptr;
+    }
+    m_fingerprint.clear();
+    m_finished = false;
+    m_remainingSamples = 0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chromaprint.h>
+
+#include <QSqlDatabase>
+#include <vector>
+
+#include "analyzer/analyzer.h"
+#include "library/dao/analysisdao.h"
+#include "preferences/usersettings.h"
+
+/// Calculates the AcoustID fingerprint of the first two minutes of the
+/// decoded stream and stores it in the library. Looking up the metadata
+/// of an analyzed track doesn't need to decode the file again.
+class AnalyzerFingerprint : public Analyzer {
+  public:
+    AnalyzerFingerprint(
+            UserSettingsPointer pConfig,
+            const QSqlDatabase& dbConnection);
+    ~AnalyzerFingerprint() override;
+
+    static bool isEnabled(const UserSettingsPointer& pConfig);
+
+    bool initialize(TrackPointer tio,
+            mixxx::audio::SampleRate sampleRate,
+            int totalSamples) override;
+    bool processSamples(const CSAMPLE* pIn, const int iLen) override;
+    void storeResults(TrackPointer tio) override;
+    void cleanup() override;
+
+    bool saveCheckpoint(QDataStream* pStream) const override;
+    bool restoreCheckpoint(QDataStream* pStream) override;
+
+  private:
+    void finishFingerprint();
+
+    AnalysisDao m_analysisDao;
+    ChromaprintContext* m_pContext;
+    // The samples that still need to be fed into m_pContext
+    SINT m_remainingSamples;
+    std::vector<SAMPLE> m_convertedSamples;
+    // Becomes valid as soon as enough samples have been processed
+    QString m_fingerprint;
+    bool m_finished;
+};
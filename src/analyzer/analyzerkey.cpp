@@ -3,6 +3,7 @@
 #include <QVector>
 #include <QtDebug>
 
+#include "analyzer/analyzercheckpoint.h"
 #include "analyzer/constants.h"
 #if defined __KEYFINDER__
 #include "analyzer/plugins/analyzerkeyfinder.h"
@@ -12,6 +13,12 @@
 #include "track/keyfactory.h"
 #include "track/track.h"
 
+namespace {
+
+const QString kCheckpointTag = QStringLiteral("key/1");
+
+} // anonymous namespace
+
 // static
 QList<mixxx::AnalyzerPluginInfo> AnalyzerKey::availablePlugins() {
     QList<mixxx::AnalyzerPluginInfo> analyzers;
@@ -163,6 +170,34 @@ bool AnalyzerKey::processSamples(const CSAMPLE *pIn, const int iLen) {
     return m_pPlugin->processSamples(pIn, iLen);
 }
 
+bool AnalyzerKey::saveCheckpoint(QDataStream* pStream) const {
+    VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+        return false;
+    }
+    mixxx::analyzer::writeCheckpointTag(pStream, kCheckpointTag);
+    *pStream << m_pluginId
+             << static_cast<qint32>(m_iCurrentSample);
+    return m_pPlugin->saveCheckpoint(pStream);
+}
+
+bool AnalyzerKey::restoreCheckpoint(QDataStream* pStream) {
+    VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+        return false;
+    }
+    if (!mixxx::analyzer::readCheckpointTag(pStream, kCheckpointTag)) {
+        return false;
+    }
+    QString pluginId;
+    qint32 currentSample = 0;
+    *pStream >> pluginId >> currentSample;
+    // The plugin might have been changed in the preferences
+    if (pStream->status() != QDataStream::Ok || pluginId != m_pluginId) {
+        return false;
+    }
+    m_iCurrentSample = currentSample;
+    return m_pPlugin->restoreCheckpoint(pStream);
+}
+
 void AnalyzerKey::cleanup() {
     m_pPlugin.reset();
 }
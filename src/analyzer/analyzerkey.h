@@ -26,6 +26,9 @@ class AnalyzerKey : public Analyzer {
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
+    bool saveCheckpoint(QDataStream* pStream) const override;
+    bool restoreCheckpoint(QDataStream* pStream) override;
+
   private:
     static QHash<QString, QString> getExtraVersionInfo(
             const QString& pluginId, bool bPreferencesFastAnalysis);
@@ -0,0 +1,117 @@
+#include "analyzer/analyzerpipeline.h"
+
+#include "util/assert.h"
+
+class AnalyzerPipeline::WorkerThread final : public QThread {
+  public:
+    WorkerThread(AnalyzerPipeline* pPipeline, AnalyzerWithState* pAnalyzer, int index)
+            : m_pPipeline(pPipeline),
+              m_pAnalyzer(pAnalyzer) {
+        setObjectName(QStringLiteral("AnalyzerPipeline %1").arg(index));
+    }
+
+  protected:
+    void run() override {
+        m_pPipeline->processChunks(m_pAnalyzer);
+    }
+
+  private:
+    AnalyzerPipeline* const m_pPipeline;
+    AnalyzerWithState* const m_pAnalyzer;
+};
+
+AnalyzerPipeline::AnalyzerPipeline(
+        std::vector<AnalyzerWithState>* pAnalyzers,
+        int numChunks,
+        SINT samplesPerChunk,
+        QThread::Priority priority)
+        : m_numCommittedChunks(0),
+          m_numPendingChunks(0),
+          m_quit(false) {
+    DEBUG_ASSERT(pAnalyzers);
+    DEBUG_ASSERT(numChunks > 0);
+    m_chunks.reserve(numChunks);
+    for (int i = 0; i < numChunks; ++i) {
+        m_chunks.emplace_back(samplesPerChunk);
+    }
+    m_workers.reserve(pAnalyzers->size());
+    for (auto& analyzer : *pAnalyzers) {
+        auto pWorker = std::make_unique<WorkerThread>(
+                this, &analyzer, static_cast<int>(m_workers.size()));
+        pWorker->start(priority);
+        m_workers.push_back(std::move(pWorker));
+    }
+}
+
+AnalyzerPipeline::~AnalyzerPipeline() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_chunkCommitted.notify_all();
+    for (const auto& pWorker : m_workers) {
+        pWorker->wait();
+    }
+}
+
+mixxx::SampleBuffer* AnalyzerPipeline::nextChunkBuffer() {
+    Chunk& chunk = m_chunks[m_numCommittedChunks % m_chunks.size()];
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_chunkProcessed.wait(lock, [&chunk] {
+        return chunk.pendingAnalyzers == 0;
+    });
+    return &chunk.buffer;
+}
+
+void AnalyzerPipeline::commitChunk(const CSAMPLE* pSamples, SINT numSamples) {
+    Chunk& chunk = m_chunks[m_numCommittedChunks % m_chunks.size()];
+    DEBUG_ASSERT(pSamples >= chunk.buffer.data());
+    DEBUG_ASSERT(pSamples + numSamples <= chunk.buffer.data() + chunk.buffer.size());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        DEBUG_ASSERT(chunk.pendingAnalyzers == 0);
+        if (m_workers.empty()) {
+            return;
+        }
+        chunk.pSamples = pSamples;
+        chunk.numSamples = numSamples;
+        chunk.pendingAnalyzers = static_cast<int>(m_workers.size());
+        ++m_numCommittedChunks;
+        ++m_numPendingChunks;
+    }
+    m_chunkCommitted.notify_all();
+}
+
+void AnalyzerPipeline::waitUntilProcessed() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_chunkProcessed.wait(lock, [this] {
+        return m_numPendingChunks == 0;
+    });
+}
+
+void AnalyzerPipeline::processChunks(AnalyzerWithState* pAnalyzer) {
+    quint64 numProcessedChunks = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_chunkCommitted.wait(lock, [this, &numProcessedChunks] {
+            return m_quit || numProcessedChunks < m_numCommittedChunks;
+        });
+        if (numProcessedChunks == m_numCommittedChunks) {
+            DEBUG_ASSERT(m_quit);
+            return;
+        }
+        Chunk& chunk = m_chunks[numProcessedChunks % m_chunks.size()];
+        lock.unlock();
+
+        // The chunk is immutable until all analyzers have processed it
+        pAnalyzer->processSamples(chunk.pSamples, static_cast<int>(chunk.numSamples));
+
+        lock.lock();
+        ++numProcessedChunks;
+        DEBUG_ASSERT(chunk.pendingAnalyzers > 0);
+        if (--chunk.pendingAnalyzers == 0) {
+            --m_numPendingChunks;
+            m_chunkProcessed.notify_all();
+        }
+    }
+}
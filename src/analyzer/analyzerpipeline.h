@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QThread>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "analyzer/analyzer.h"
+#include "util/samplebuffer.h"
+
+/// Runs the analyzers of an AnalyzerThread concurrently on separate
+/// worker threads, while the AnalyzerThread itself only decodes the audio
+/// data.
+///
+/// The decoded chunks are stored in a bounded ring. Each chunk is
+/// immutable after it has been committed and is shared by all analyzers,
+/// which consume the chunks in order. The decoder is blocked when the
+/// slowest analyzer falls behind by the capacity of the ring. This way
+/// expensive analyzers like beat and key detection overlap instead of
+/// summing up.
+///
+/// Only AnalyzerWithState::processSamples() is invoked by the workers.
+/// All other functions of the analyzers must only be invoked by the
+/// AnalyzerThread after waitUntilProcessed() returned.
+class AnalyzerPipeline final {
+  public:
+    /// Starts one worker thread for each analyzer. The analyzers must
+    /// outlive the pipeline.
+    AnalyzerPipeline(
+            std::vector<AnalyzerWithState>* pAnalyzers,
+            int numChunks,
+            SINT samplesPerChunk,
+            QThread::Priority priority);
+    ~AnalyzerPipeline();
+
+    AnalyzerPipeline(const AnalyzerPipeline&) = delete;
+    AnalyzerPipeline& operator=(const AnalyzerPipeline&) = delete;
+
+    /// Returns the buffer of the next chunk and blocks until it is no
+    /// longer used by any analyzer. Repeated invocations without
+    /// committing the chunk return the same buffer.
+    mixxx::SampleBuffer* nextChunkBuffer();
+
+    /// Publishes the next chunk with the readable part of its buffer
+    void commitChunk(const CSAMPLE* pSamples, SINT numSamples);
+
+    /// Blocks until all committed chunks have been processed by all
+    /// analyzers.
+    void waitUntilProcessed();
+
+  private:
+    class WorkerThread;
+
+    struct Chunk {
+        explicit Chunk(SINT size)
+                : buffer(size),
+                  pSamples(nullptr),
+                  numSamples(0),
+                  pendingAnalyzers(0) {
+        }
+        mixxx::SampleBuffer buffer;
+        const CSAMPLE* pSamples;
+        SINT numSamples;
+        // The number of analyzers that have not processed the chunk yet
+        int pendingAnalyzers;
+    };
+
+    // Invoked by the worker threads
+    void processChunks(AnalyzerWithState* pAnalyzer);
+
+    std::vector<Chunk> m_chunks;
+    std::vector<std::unique_ptr<WorkerThread>> m_workers;
+
+    std::mutex m_mutex;
+    // Signaled when a new chunk has been committed or while quitting
+    std::condition_variable m_chunkCommitted;
+    // Signaled when a chunk has been processed by all analyzers
+    std::condition_variable m_chunkProcessed;
+    // The total number of chunks that have been committed
+    quint64 m_numCommittedChunks;
+    // The total number of chunks that are pending for any analyzer
+    int m_numPendingChunks;
+    bool m_quit;
+};
@@ -1,15 +1,70 @@
 #include "analyzer/analyzersilence.h"
 
+#include "analyzer/analyzercheckpoint.h"
 #include "analyzer/constants.h"
 #include "engine/engine.h"
+#include "sources/audiosourcestereoproxy.h"
+#include "sources/soundsourceproxy.h"
 #include "track/track.h"
+#include "util/samplebuffer.h"
 
 namespace {
 
+const QString kCheckpointTag = QStringLiteral("silence/1");
+
 constexpr CSAMPLE kSilenceThreshold = 0.001f;
 // TODO: Change the above line to:
 //constexpr CSAMPLE kSilenceThreshold = db2ratio(-60.0f);
 
+// The beginning and the end of the track that are decoded by
+// scanFirstAndLastSound()
+constexpr double kSoundScanSeconds = 30.0;
+
+bool isSilentFrame(const CSAMPLE* pFrame) {
+    // Compute max of channels in this sample frame
+    CSAMPLE fMax = CSAMPLE_ZERO;
+    for (SINT ch = 0; ch < mixxx::kAnalysisChannels; ++ch) {
+        CSAMPLE fAbs = fabs(pFrame[ch]);
+        fMax = math_max(fMax, fAbs);
+    }
+    return fMax < kSilenceThreshold;
+}
+
+/// Returns the index of the first or the frame after the last frame that
+/// is not silent, or -1 if the whole range is silent or could not be read.
+SINT scanForSound(mixxx::AudioSource* pAudioSource,
+        mixxx::SampleBuffer* pSampleBuffer,
+        mixxx::IndexRange frameIndexRange,
+        bool findFirst) {
+    SINT soundFrameIndex = -1;
+    SINT frameIndex = frameIndexRange.start();
+    while (frameIndex < frameIndexRange.end()) {
+        const auto chunkFrameIndexRange = mixxx::IndexRange::forward(frameIndex,
+                math_min(mixxx::kAnalysisFramesPerChunk,
+                        frameIndexRange.end() - frameIndex));
+        const auto readableSampleFrames = pAudioSource->readSampleFrames(
+                mixxx::WritableSampleFrames(
+                        chunkFrameIndexRange,
+                        mixxx::SampleBuffer::WritableSlice(*pSampleBuffer)));
+        const auto readFrameIndexRange = readableSampleFrames.frameIndexRange();
+        if (readFrameIndexRange.empty() ||
+                readFrameIndexRange.start() != chunkFrameIndexRange.start()) {
+            return -1;
+        }
+        const CSAMPLE* pSamples = readableSampleFrames.readableData();
+        for (SINT i = 0; i < readFrameIndexRange.length(); ++i) {
+            if (!isSilentFrame(pSamples + i * mixxx::kAnalysisChannels)) {
+                soundFrameIndex = readFrameIndexRange.start() + i + (findFirst ? 0 : 1);
+                if (findFirst) {
+                    return soundFrameIndex;
+                }
+            }
+        }
+        frameIndex = readFrameIndexRange.end();
+    }
+    return soundFrameIndex;
+}
+
 bool shouldAnalyze(TrackPointer pTrack) {
     CuePointer pIntroCue = pTrack->findCueByType(mixxx::CueType::Intro);
     CuePointer pOutroCue = pTrack->findCueByType(mixxx::CueType::Outro);
@@ -21,6 +76,65 @@ bool shouldAnalyze(TrackPointer pTrack) {
     return false;
 }
 
+void storeSoundPositions(const UserSettingsPointer& pConfig,
+        const TrackPointer& pTrack,
+        mixxx::audio::FramePos firstSoundPosition,
+        mixxx::audio::FramePos lastSoundPosition) {
+    CuePointer pAudibleSound = pTrack->findCueByType(mixxx::CueType::AudibleSound);
+    if (pAudibleSound == nullptr) {
+        pAudibleSound = pTrack->createAndAddCue(
+                mixxx::CueType::AudibleSound,
+                Cue::kNoHotCue,
+                firstSoundPosition,
+                lastSoundPosition);
+    } else {
+        // The user has no way to directly edit the AudibleSound cue. If the user
+        // has deleted the Intro or Outro Cue, this analysis will be rerun when
+        // the track is loaded again. In this case, adjust the AudibleSound Cue's
+        // positions. This could be helpful, for example, when the track length
+        // is changed in a different program, or the silence detection threshold
+        // is changed.
+        pAudibleSound->setStartAndEndPosition(firstSoundPosition, lastSoundPosition);
+    }
+
+    CuePointer pIntroCue = pTrack->findCueByType(mixxx::CueType::Intro);
+
+    mixxx::audio::FramePos mainCuePosition = pTrack->getMainCuePosition();
+    mixxx::audio::FramePos introStartPosition = firstSoundPosition;
+    // Before Mixxx 2.3, the default position for the main cue was 0.0. In this
+    // case, move the main cue point to the first sound. This case can be
+    // distinguished from a user intentionally setting the main cue position
+    // to 0.0 at a later time after analysis because in that case the intro cue
+    // would have already been created by this analyzer.
+    bool upgradingWithMainCueAtDefault =
+            (mainCuePosition == mixxx::audio::kStartFramePos &&
+                    pIntroCue == nullptr);
+    if (!mainCuePosition.isValid() || upgradingWithMainCueAtDefault) {
+        pTrack->setMainCuePosition(firstSoundPosition);
+        // NOTE: the actual default for this ConfigValue is set in DlgPrefDeck.
+    } else if (pConfig->getValue(ConfigKey("[Controls]", "SetIntroStartAtMainCue"), false) &&
+            pIntroCue == nullptr) {
+        introStartPosition = mainCuePosition;
+    }
+
+    if (pIntroCue == nullptr) {
+        pIntroCue = pTrack->createAndAddCue(
+                mixxx::CueType::Intro,
+                Cue::kNoHotCue,
+                introStartPosition,
+                mixxx::audio::kInvalidFramePos);
+    }
+
+    CuePointer pOutroCue = pTrack->findCueByType(mixxx::CueType::Outro);
+    if (pOutroCue == nullptr) {
+        pOutroCue = pTrack->createAndAddCue(
+                mixxx::CueType::Outro,
+                Cue::kNoHotCue,
+                mixxx::audio::kInvalidFramePos,
+                lastSoundPosition);
+    }
+}
+
 } // anonymous namespace
 
 AnalyzerSilence::AnalyzerSilence(UserSettingsPointer pConfig)
@@ -78,6 +192,34 @@ bool AnalyzerSilence::processSamples(const CSAMPLE* pIn, const int iLen) {
 void AnalyzerSilence::cleanup() {
 }
 
+bool AnalyzerSilence::saveCheckpoint(QDataStream* pStream) const {
+    mixxx::analyzer::writeCheckpointTag(pStream, kCheckpointTag);
+    *pStream << static_cast<qint32>(m_iFramesProcessed)
+             << m_bPrevSilence
+             << static_cast<qint32>(m_iSignalStart)
+             << static_cast<qint32>(m_iSignalEnd);
+    return pStream->status() == QDataStream::Ok;
+}
+
+bool AnalyzerSilence::restoreCheckpoint(QDataStream* pStream) {
+    if (!mixxx::analyzer::readCheckpointTag(pStream, kCheckpointTag)) {
+        return false;
+    }
+    qint32 framesProcessed = 0;
+    bool prevSilence = true;
+    qint32 signalStart = -1;
+    qint32 signalEnd = -1;
+    *pStream >> framesProcessed >> prevSilence >> signalStart >> signalEnd;
+    if (pStream->status() != QDataStream::Ok) {
+        return false;
+    }
+    m_iFramesProcessed = framesProcessed;
+    m_bPrevSilence = prevSilence;
+    m_iSignalStart = signalStart;
+    m_iSignalEnd = signalEnd;
+    return true;
+}
+
 void AnalyzerSilence::storeResults(TrackPointer pTrack) {
     if (m_iSignalStart < 0) {
         m_iSignalStart = 0;
@@ -94,58 +236,50 @@ void AnalyzerSilence::storeResults(TrackPointer pTrack) {
 
     const auto firstSoundPosition = mixxx::audio::FramePos(m_iSignalStart);
     const auto lastSoundPosition = mixxx::audio::FramePos(m_iSignalEnd);
+    storeSoundPositions(m_pConfig, pTrack, firstSoundPosition, lastSoundPosition);
+}
 
-    CuePointer pAudibleSound = pTrack->findCueByType(mixxx::CueType::AudibleSound);
-    if (pAudibleSound == nullptr) {
-        pAudibleSound = pTrack->createAndAddCue(
-                mixxx::CueType::AudibleSound,
-                Cue::kNoHotCue,
-                firstSoundPosition,
-                lastSoundPosition);
-    } else {
-        // The user has no way to directly edit the AudibleSound cue. If the user
-        // has deleted the Intro or Outro Cue, this analysis will be rerun when
-        // the track is loaded again. In this case, adjust the AudibleSound Cue's
-        // positions. This could be helpful, for example, when the track length
-        // is changed in a different program, or the silence detection threshold
-        // is changed.
-        pAudibleSound->setStartAndEndPosition(firstSoundPosition, lastSoundPosition);
+// static
+bool AnalyzerSilence::scanFirstAndLastSound(TrackPointer pTrack, UserSettingsPointer pConfig) {
+    if (!pTrack || !shouldAnalyze(pTrack)) {
+        return false;
     }
 
-    CuePointer pIntroCue = pTrack->findCueByType(mixxx::CueType::Intro);
-
-    mixxx::audio::FramePos mainCuePosition = pTrack->getMainCuePosition();
-    mixxx::audio::FramePos introStartPosition = firstSoundPosition;
-    // Before Mixxx 2.3, the default position for the main cue was 0.0. In this
-    // case, move the main cue point to the first sound. This case can be
-    // distinguished from a user intentionally setting the main cue position
-    // to 0.0 at a later time after analysis because in that case the intro cue
-    // would have already been created by this analyzer.
-    bool upgradingWithMainCueAtDefault =
-            (mainCuePosition == mixxx::audio::kStartFramePos &&
-                    pIntroCue == nullptr);
-    if (!mainCuePosition.isValid() || upgradingWithMainCueAtDefault) {
-        pTrack->setMainCuePosition(firstSoundPosition);
-        // NOTE: the actual default for this ConfigValue is set in DlgPrefDeck.
-    } else if (m_pConfig->getValue(ConfigKey("[Controls]", "SetIntroStartAtMainCue"), false) &&
-            pIntroCue == nullptr) {
-        introStartPosition = mainCuePosition;
+    mixxx::AudioSource::OpenParams openParams;
+    openParams.setChannelCount(mixxx::kAnalysisChannels);
+    auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(openParams);
+    if (!pAudioSource) {
+        return false;
     }
+    mixxx::AudioSourceStereoProxy audioSourceProxy(
+            pAudioSource,
+            mixxx::kAnalysisFramesPerChunk);
+    mixxx::SampleBuffer sampleBuffer(mixxx::kAnalysisSamplesPerChunk);
 
-    if (pIntroCue == nullptr) {
-        pIntroCue = pTrack->createAndAddCue(
-                mixxx::CueType::Intro,
-                Cue::kNoHotCue,
-                introStartPosition,
-                mixxx::audio::kInvalidFramePos);
+    const auto frameIndexRange = pAudioSource->frameIndexRange();
+    const auto scanFrames = static_cast<SINT>(
+            pAudioSource->getSignalInfo().getSampleRate() * kSoundScanSeconds);
+    const auto headFrameIndexRange = intersect(frameIndexRange,
+            mixxx::IndexRange::forward(frameIndexRange.start(), scanFrames));
+    const SINT firstSoundFrameIndex = scanForSound(
+            &audioSourceProxy, &sampleBuffer, headFrameIndexRange, true);
+    if (firstSoundFrameIndex < 0) {
+        return false;
     }
-
-    CuePointer pOutroCue = pTrack->findCueByType(mixxx::CueType::Outro);
-    if (pOutroCue == nullptr) {
-        pOutroCue = pTrack->createAndAddCue(
-                mixxx::CueType::Outro,
-                Cue::kNoHotCue,
-                mixxx::audio::kInvalidFramePos,
-                lastSoundPosition);
+    // The tail starts at the first sound for short tracks
+    const auto tailFrameIndexRange = mixxx::IndexRange::between(
+            math_max(firstSoundFrameIndex, frameIndexRange.end() - scanFrames),
+            frameIndexRange.end());
+    const SINT lastSoundFrameIndex = scanForSound(
+            &audioSourceProxy, &sampleBuffer, tailFrameIndexRange, false);
+    if (lastSoundFrameIndex < 0) {
+        return false;
     }
+
+    // Like the full analysis, count the frames from the start of the source
+    storeSoundPositions(pConfig,
+            pTrack,
+            mixxx::audio::FramePos(firstSoundFrameIndex - frameIndexRange.start()),
+            mixxx::audio::FramePos(lastSoundFrameIndex - frameIndexRange.start()));
+    return true;
 }
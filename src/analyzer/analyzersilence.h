@@ -17,6 +17,17 @@ class AnalyzerSilence : public Analyzer {
     void storeResults(TrackPointer pTrack) override;
     void cleanup() override;
 
+    bool saveCheckpoint(QDataStream* pStream) const override;
+    bool restoreCheckpoint(QDataStream* pStream) override;
+
+    /// Finds the first and last sound by only decoding the beginning and
+    /// the end of the track, and stores them like the full analysis. The
+    /// results are the same as with the full analysis, which skips the
+    /// track afterwards. Returns false if the track has been analyzed
+    /// already or if the decoded ranges are silent, which is left to the
+    /// full analysis. Blocks while decoding, so call it on a worker thread.
+    static bool scanFirstAndLastSound(TrackPointer pTrack, UserSettingsPointer pConfig);
+
   private:
     UserSettingsPointer m_pConfig;
     CSAMPLE m_fThreshold;
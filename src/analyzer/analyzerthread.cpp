@@ -1,9 +1,12 @@
 #include "analyzer/analyzerthread.h"
 
+#include <QDataStream>
+#include <QDateTime>
 #include <mutex>
 
 #include "analyzer/analyzerbeats.h"
 #include "analyzer/analyzerebur128.h"
+#include "analyzer/analyzerfingerprint.h"
 #include "analyzer/analyzergain.h"
 #include "analyzer/analyzerkey.h"
 #include "analyzer/analyzersilence.h"
@@ -18,6 +21,7 @@
 #include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/logger.h"
+#include "util/metrics.h"
 #include "util/timer.h"
 
 namespace {
@@ -36,6 +40,42 @@ mixxx::Logger kLogger("AnalyzerThread");
 // continuous feedback.
 const mixxx::Duration kBusyProgressInhibitDuration = mixxx::Duration::fromMillis(60);
 
+const ConfigKey kAnalysisPipelineConfigKey("[Library]", "AnalysisPipeline");
+
+// The number of decoded chunks that might be buffered while the analyzers
+// are running concurrently, i.e. ~0.75 s of stereo audio at 44.1 kHz.
+constexpr int kAnalysisPipelineChunks = 8;
+
+const ConfigKey kAnalysisCheckpointsConfigKey("[Library]", "AnalysisCheckpoints");
+
+// Long tracks, e.g. recordings of DJ mixes, are checkpointed regularly
+// for resuming an interrupted analysis. Storing a checkpoint includes
+// the waveforms of all frames that have been analyzed so far.
+constexpr int kCheckpointIntervalSeconds = 15 * 60;
+
+// Must be incremented when the format of the header changes. The
+// analyzers manage the format of their state independently.
+const QString kCheckpointVersion = QStringLiteral("1");
+
+constexpr QDataStream::Version kCheckpointStreamVersion = QDataStream::Qt_5_12;
+
+SINT checkpointIntervalFrames(const mixxx::AudioSource& audioSource) {
+    return static_cast<SINT>(audioSource.getSignalInfo().getSampleRate()) *
+            kCheckpointIntervalSeconds;
+}
+
+bool isAnalysisPipelineEnabled(const UserSettingsPointer& pConfig) {
+    // Running each analyzer on a separate thread only pays off if there
+    // are enough cores available.
+    return pConfig->getValue(kAnalysisPipelineConfigKey,
+            QThread::idealThreadCount() > 2);
+}
+
+inline void addDuration(std::atomic<qint64>* pNanos, mixxx::Duration duration) {
+    pNanos->fetch_add(duration.toIntegerNanos(), std::memory_order_relaxed);
+    mixxx::metrics::analysisNanos.increment(duration.toIntegerNanos());
+}
+
 void deleteAnalyzerThread(AnalyzerThread* plainPtr) {
     if (plainPtr) {
         plainPtr->deleteAfterFinished();
@@ -84,8 +124,13 @@ AnalyzerThread::AnalyzerThread(
           m_pConfig(pConfig),
           m_modeFlags(modeFlags),
           m_nextTrack(2), // minimum capacity
+          m_decodeNanos(0),
+          m_analysisNanos(0),
+          m_analyzedFrames(0),
           m_sampleBuffer(mixxx::kAnalysisSamplesPerChunk),
-          m_emittedState(AnalyzerThreadState::Void) {
+          m_emittedState(AnalyzerThreadState::Void),
+          m_hasCheckpoint(false),
+          m_checkpointUnsupported(false) {
     std::call_once(registerMetaTypesOnceFlag, registerMetaTypesOnce);
 }
 
@@ -104,22 +149,48 @@ void AnalyzerThread::doRun() {
         }
         QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_dbConnectionPool);
         m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection)));
+        if (AnalyzerFingerprint::isEnabled(m_pConfig)) {
+            m_analyzers.push_back(AnalyzerWithState(
+                    std::make_unique<AnalyzerFingerprint>(m_pConfig, dbConnection)));
+        }
+        if (m_pConfig->getValue(kAnalysisCheckpointsConfigKey, true)) {
+            pAnalysisDao = std::make_unique<AnalysisDao>(m_pConfig);
+            pAnalysisDao->initialize(dbConnection);
+        }
+    }
+    const bool previewTier = (m_modeFlags & AnalyzerModeFlags::PreviewTier) != 0;
+    const bool deferredTier = (m_modeFlags & AnalyzerModeFlags::DeferredTier) != 0;
+    DEBUG_ASSERT(!(previewTier && deferredTier));
+    if (!deferredTier) {
+        if (AnalyzerGain::isEnabled(ReplayGainSettings(m_pConfig))) {
+            m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerGain>(m_pConfig)));
+        }
+        if (AnalyzerEbur128::isEnabled(ReplayGainSettings(m_pConfig))) {
+            m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerEbur128>(m_pConfig)));
+        }
     }
-    if (AnalyzerGain::isEnabled(ReplayGainSettings(m_pConfig))) {
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerGain>(m_pConfig)));
+    if (!previewTier) {
+        // BPM detection might be disabled in the config, but can be overridden
+        // and enabled by explicitly setting the mode flag.
+        const bool enforceBpmDetection = (m_modeFlags & AnalyzerModeFlags::WithBeats) != 0;
+        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerBeats>(m_pConfig, enforceBpmDetection)));
+        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerKey>(m_pConfig)));
     }
-    if (AnalyzerEbur128::isEnabled(ReplayGainSettings(m_pConfig))) {
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerEbur128>(m_pConfig)));
+    if (!deferredTier) {
+        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerSilence>(m_pConfig)));
     }
-    // BPM detection might be disabled in the config, but can be overridden
-    // and enabled by explicitly setting the mode flag.
-    const bool enforceBpmDetection = (m_modeFlags & AnalyzerModeFlags::WithBeats) != 0;
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerBeats>(m_pConfig, enforceBpmDetection)));
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerKey>(m_pConfig)));
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerSilence>(m_pConfig)));
     DEBUG_ASSERT(!m_analyzers.empty());
     kLogger.debug() << "Activated" << m_analyzers.size() << "analyzers";
 
+    if (isAnalysisPipelineEnabled(m_pConfig)) {
+        m_pPipeline = std::make_unique<AnalyzerPipeline>(
+                &m_analyzers,
+                kAnalysisPipelineChunks,
+                mixxx::kAnalysisSamplesPerChunk,
+                priority());
+        kLogger.debug() << "Running analyzers concurrently";
+    }
+
     m_lastBusyProgressEmittedTimer.start();
 
     mixxx::AudioSource::OpenParams openParams;
@@ -140,20 +211,30 @@ void AnalyzerThread::doRun() {
             continue;
         }
 
-        bool processTrack = false;
-        for (auto&& analyzer : m_analyzers) {
-            // Make sure not to short-circuit initialize(...)
-            if (analyzer.initialize(
-                        m_currentTrack,
-                        audioSource->getSignalInfo().getSampleRate(),
-                        audioSource->frameLength() * mixxx::kAnalysisChannels)) {
-                processTrack = true;
-            }
-        }
+        const bool processTrack = initializeAnalyzers(audioSource);
 
         if (processTrack) {
-            const auto analysisResult = analyzeAudioSource(audioSource);
+            // Only long tracks are checkpointed
+            AnalysisDao* const pCheckpointDao =
+                    audioSource->frameLength() > checkpointIntervalFrames(*audioSource)
+                    ? pAnalysisDao.get()
+                    : nullptr;
+            m_hasCheckpoint = false;
+            m_checkpointUnsupported = false;
+            SINT firstFrameIndex = audioSource->frameIndexRange().start();
+            if (pCheckpointDao) {
+                firstFrameIndex = restoreCheckpoint(pCheckpointDao, audioSource);
+            }
+            const auto analysisResult = analyzeAudioSource(
+                    audioSource, firstFrameIndex, pCheckpointDao);
             DEBUG_ASSERT(analysisResult != AnalysisResult::Pending);
+            if (m_pPipeline) {
+                // The analyzers might still be busy with buffered chunks
+                emitBusyProgress(kAnalyzerProgressFinalizing);
+                m_throughputTimer.start();
+                m_pPipeline->waitUntilProcessed();
+                addDuration(&m_analysisNanos, m_throughputTimer.elapsed());
+            }
             if (analysisResult == AnalysisResult::Finished) {
                 // The analysis has been finished, and is either complete without
                 // any errors or partial if it has been aborted due to a corrupt
@@ -166,6 +247,10 @@ void AnalyzerThread::doRun() {
                 for (auto&& analyzer : m_analyzers) {
                     analyzer.finish(m_currentTrack);
                 }
+                mixxx::metrics::analyzedTracks.increment();
+                if (m_hasCheckpoint) {
+                    pCheckpointDao->deleteAnalysisCheckpoint(m_currentTrack->getId());
+                }
                 emitDoneProgress(kAnalyzerProgressDone);
             } else {
                 for (auto&& analyzer : m_analyzers) {
@@ -181,6 +266,7 @@ void AnalyzerThread::doRun() {
     DEBUG_ASSERT(!m_currentTrack);
     DEBUG_ASSERT(isStopping());
 
+    m_pPipeline.reset();
     m_analyzers.clear();
 
     kLogger.debug() << "Exiting worker thread";
@@ -203,6 +289,16 @@ bool AnalyzerThread::submitNextTrack(TrackPointer nextTrack) {
     return false;
 }
 
+AnalyzerThread::Throughput AnalyzerThread::takeThroughput() {
+    Throughput throughput;
+    throughput.decodeDuration = mixxx::Duration::fromNanos(
+            m_decodeNanos.exchange(0, std::memory_order_relaxed));
+    throughput.analysisDuration = mixxx::Duration::fromNanos(
+            m_analysisNanos.exchange(0, std::memory_order_relaxed));
+    throughput.frames = m_analyzedFrames.exchange(0, std::memory_order_relaxed);
+    return throughput;
+}
+
 WorkerThread::TryFetchWorkItemsResult AnalyzerThread::tryFetchWorkItems() {
     DEBUG_ASSERT(!m_currentTrack);
     TrackPointer* pFront = m_nextTrack.front();
@@ -219,8 +315,158 @@ WorkerThread::TryFetchWorkItemsResult AnalyzerThread::tryFetchWorkItems() {
     }
 }
 
-AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
+bool AnalyzerThread::initializeAnalyzers(
         const mixxx::AudioSourcePointer& audioSource) {
+    bool processTrack = false;
+    for (auto&& analyzer : m_analyzers) {
+        // Make sure not to short-circuit initialize(...)
+        if (analyzer.initialize(
+                    m_currentTrack,
+                    audioSource->getSignalInfo().getSampleRate(),
+                    audioSource->frameLength() * mixxx::kAnalysisChannels)) {
+            processTrack = true;
+        }
+    }
+    return processTrack;
+}
+
+SINT AnalyzerThread::restoreCheckpoint(
+        AnalysisDao* pCheckpointDao,
+        const mixxx::AudioSourcePointer& audioSource) {
+    DEBUG_ASSERT(pCheckpointDao);
+    DEBUG_ASSERT(m_currentTrack);
+    const mixxx::IndexRange frameIndexRange = audioSource->frameIndexRange();
+    const QByteArray data = pCheckpointDao->loadAnalysisCheckpoint(
+            m_currentTrack->getId(), kCheckpointVersion);
+    if (data.isEmpty()) {
+        return frameIndexRange.start();
+    }
+    m_hasCheckpoint = true;
+
+    QDataStream stream(data);
+    stream.setVersion(kCheckpointStreamVersion);
+    qint64 fileSize = 0;
+    QDateTime fileLastModified;
+    qint32 sampleRate = 0;
+    qint64 frameIndexStart = 0;
+    qint64 frameIndexEnd = 0;
+    qint64 frameIndex = 0;
+    qint32 numAnalyzers = 0;
+    stream >> fileSize >> fileLastModified >> sampleRate >>
+            frameIndexStart >> frameIndexEnd >> frameIndex >> numAnalyzers;
+    // The checkpoint is only valid for the same, unmodified file
+    const auto fileInfo = m_currentTrack->getFileInfo();
+    bool restored = stream.status() == QDataStream::Ok &&
+            fileSize == fileInfo.sizeInBytes() &&
+            fileLastModified == fileInfo.lastModified() &&
+            sampleRate == static_cast<qint32>(
+                                  audioSource->getSignalInfo().getSampleRate()) &&
+            frameIndexStart == frameIndexRange.start() &&
+            frameIndexEnd == frameIndexRange.end() &&
+            frameIndex > frameIndexStart &&
+            frameIndex < frameIndexEnd &&
+            numAnalyzers == static_cast<qint32>(m_analyzers.size());
+    for (auto&& analyzer : m_analyzers) {
+        if (!restored) {
+            break;
+        }
+        bool active = false;
+        QByteArray state;
+        stream >> active >> state;
+        // The analyzers that need to process the track must not have
+        // changed in the meantime
+        if (stream.status() != QDataStream::Ok || active != analyzer.isActive()) {
+            restored = false;
+            break;
+        }
+        if (active) {
+            QDataStream analyzerStream(state);
+            analyzerStream.setVersion(kCheckpointStreamVersion);
+            restored = analyzer.restoreCheckpoint(&analyzerStream);
+        }
+    }
+    if (restored) {
+        kLogger.info()
+                << "Resuming analysis of"
+                << m_currentTrack->getFileInfo()
+                << "at frame"
+                << frameIndex;
+        return static_cast<SINT>(frameIndex);
+    }
+
+    kLogger.info()
+            << "Discarding outdated checkpoint of"
+            << m_currentTrack->getFileInfo();
+    // Some analyzers might already have been restored
+    for (auto&& analyzer : m_analyzers) {
+        analyzer.cancel();
+    }
+    initializeAnalyzers(audioSource);
+    pCheckpointDao->deleteAnalysisCheckpoint(m_currentTrack->getId());
+    m_hasCheckpoint = false;
+    return frameIndexRange.start();
+}
+
+void AnalyzerThread::saveCheckpoint(
+        AnalysisDao* pCheckpointDao,
+        const mixxx::AudioSourcePointer& audioSource,
+        SINT frameIndex) {
+    DEBUG_ASSERT(pCheckpointDao);
+    DEBUG_ASSERT(m_currentTrack);
+    if (m_checkpointUnsupported) {
+        return;
+    }
+    PerformanceTimer timer;
+    timer.start();
+    if (m_pPipeline) {
+        // The state of all analyzers must reflect all frames before
+        // frameIndex
+        m_pPipeline->waitUntilProcessed();
+    }
+
+    const auto fileInfo = m_currentTrack->getFileInfo();
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(kCheckpointStreamVersion);
+    stream << static_cast<qint64>(fileInfo.sizeInBytes())
+           << fileInfo.lastModified()
+           << static_cast<qint32>(audioSource->getSignalInfo().getSampleRate())
+           << static_cast<qint64>(audioSource->frameIndexRange().start())
+           << static_cast<qint64>(audioSource->frameIndexRange().end())
+           << static_cast<qint64>(frameIndex)
+           << static_cast<qint32>(m_analyzers.size());
+    for (const auto& analyzer : m_analyzers) {
+        QByteArray state;
+        if (analyzer.isActive()) {
+            QDataStream analyzerStream(&state, QIODevice::WriteOnly);
+            analyzerStream.setVersion(kCheckpointStreamVersion);
+            if (!analyzer.saveCheckpoint(&analyzerStream)) {
+                kLogger.debug()
+                        << "Checkpoints are not supported by all analyzers";
+                m_checkpointUnsupported = true;
+                return;
+            }
+        }
+        stream << analyzer.isActive() << state;
+    }
+
+    if (pCheckpointDao->saveAnalysisCheckpoint(
+                m_currentTrack->getId(), kCheckpointVersion, data)) {
+        m_hasCheckpoint = true;
+        kLogger.info()
+                << "Saved checkpoint of"
+                << m_currentTrack->getFileInfo()
+                << "at frame"
+                << frameIndex
+                << "in"
+                << timer.elapsed().debugMillisWithUnit();
+    }
+}
+
+AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
+        const mixxx::AudioSourcePointer& audioSource,
+        SINT firstFrameIndex,
+        AnalysisDao* pCheckpointDao) {
     DEBUG_ASSERT(m_currentTrack);
 
     mixxx::AudioSourceStereoProxy audioSourceProxy(
@@ -233,11 +479,22 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
     // Analysis starts now
     emitBusyProgress(kAnalyzerProgressNone);
 
-    mixxx::IndexRange remainingFrameRange = audioSource->frameIndexRange();
+    mixxx::IndexRange remainingFrameRange = mixxx::IndexRange::between(
+            firstFrameIndex, audioSource->frameIndexRange().end());
+    // All frames before this index have been analyzed
+    SINT analyzedFrameIndex = firstFrameIndex;
+    SINT checkpointFrameIndex = firstFrameIndex;
+    const auto cancelAnalysis = [&]() {
+        // Keep the progress for resuming the analysis later
+        if (pCheckpointDao && analyzedFrameIndex > checkpointFrameIndex) {
+            saveCheckpoint(pCheckpointDao, audioSource, analyzedFrameIndex);
+        }
+        return AnalysisResult::Cancelled;
+    };
     while (!remainingFrameRange.empty()) {
         sleepWhileSuspended();
         if (isStopping()) {
-            return AnalysisResult::Cancelled;
+            return cancelAnalysis();
         }
 
         // 1st step: Decode next chunk of audio data
@@ -248,12 +505,19 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
                         math_min(mixxx::kAnalysisFramesPerChunk, remainingFrameRange.length()));
         DEBUG_ASSERT(!chunkFrameRange.empty());
 
-        // Request the next chunk of audio data
+        // Request the next chunk of audio data. The buffer is owned by the
+        // pipeline if the analyzers are running concurrently.
+        m_throughputTimer.start();
+        mixxx::SampleBuffer* const pSampleBuffer =
+                m_pPipeline ? m_pPipeline->nextChunkBuffer() : &m_sampleBuffer;
+        // Waiting for a free chunk is accounted as analysis time
+        addDuration(&m_analysisNanos, m_throughputTimer.restart());
         const auto readableSampleFrames =
                 audioSourceProxy.readSampleFrames(
                         mixxx::WritableSampleFrames(
                                 chunkFrameRange,
-                                mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+                                mixxx::SampleBuffer::WritableSlice(*pSampleBuffer)));
+        addDuration(&m_decodeNanos, m_throughputTimer.elapsed());
         // The returned range fits into the requested range
         DEBUG_ASSERT(readableSampleFrames.frameIndexRange().isSubrangeOf(chunkFrameRange));
 
@@ -293,17 +557,31 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
 
         sleepWhileSuspended();
         if (isStopping()) {
-            return AnalysisResult::Cancelled;
+            return cancelAnalysis();
         }
 
         // 2nd: step: Analyze chunk of decoded audio data
         if (!readableSampleFrames.frameIndexRange().empty()) {
-            for (auto&& analyzer : m_analyzers) {
-                analyzer.processSamples(
+            m_throughputTimer.start();
+            if (m_pPipeline) {
+                m_pPipeline->commitChunk(
                         readableSampleFrames.readableData(),
                         readableSampleFrames.readableLength());
+            } else {
+                for (auto&& analyzer : m_analyzers) {
+                    analyzer.processSamples(
+                            readableSampleFrames.readableData(),
+                            readableSampleFrames.readableLength());
+                }
             }
+            addDuration(&m_analysisNanos, m_throughputTimer.elapsed());
+            m_analyzedFrames.fetch_add(
+                    readableSampleFrames.frameIndexRange().length(),
+                    std::memory_order_relaxed);
+            mixxx::metrics::analyzedFrames.increment(
+                    readableSampleFrames.frameIndexRange().length());
         }
+        analyzedFrameIndex = remainingFrameRange.start();
 
         // Don't check again for paused/stopped again and simply finish
         // the current iteration by emitting progress.
@@ -325,6 +603,14 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
             DEBUG_ASSERT(remainingFrameRange.empty());
             emitBusyProgress(kAnalyzerProgressUnknown);
         }
+
+        // 4th step: Store a checkpoint regularly
+        if (pCheckpointDao && !remainingFrameRange.empty() &&
+                analyzedFrameIndex - checkpointFrameIndex >=
+                        checkpointIntervalFrames(*audioSource)) {
+            saveCheckpoint(pCheckpointDao, audioSource, analyzedFrameIndex);
+            checkpointFrameIndex = analyzedFrameIndex;
+        }
     }
 
     return AnalysisResult::Finished;
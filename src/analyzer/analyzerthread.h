@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "analyzer/analyzer.h"
+#include "analyzer/analyzerpipeline.h"
 #include "analyzer/analyzerprogress.h"
 #include "preferences/usersettings.h"
 #include "rigtorp/SPSCQueue.h"
@@ -15,11 +17,21 @@
 #include "util/samplebuffer.h"
 #include "util/workerthread.h"
 
+class AnalysisDao;
+
 enum AnalyzerModeFlags {
     None = 0x00,
     WithBeats = 0x01,
     WithWaveform = 0x02,
     LowPriority = 0x04,
+    // Only evaluated by TrackAnalysisScheduler
+    AdaptiveThreads = 0x08,
+    // Only the cheap analyzers that are needed for displaying a loaded
+    // track, i.e. waveform, ReplayGain and silence detection
+    PreviewTier = 0x10,
+    // Only the expensive analyzers that are skipped by PreviewTier,
+    // i.e. beat and key detection
+    DeferredTier = 0x20,
     All = WithBeats | WithWaveform,
 };
 
@@ -77,6 +89,17 @@ class AnalyzerThread : public WorkerThread {
     // worker thread, yet.
     bool submitNextTrack(TrackPointer nextTrack);
 
+    // The time spent for decoding and for analyzing audio data
+    struct Throughput {
+        mixxx::Duration decodeDuration;
+        mixxx::Duration analysisDuration;
+        SINT frames = 0;
+    };
+
+    // Returns the accumulated throughput since the last invocation.
+    // Thread-safe, may be called from the host thread at any time.
+    Throughput takeThroughput();
+
   signals:
     // Use a single signal for progress updates to ensure that all signals
     // are queued and received in the same order as emitted from the internal
@@ -110,12 +133,20 @@ class AnalyzerThread : public WorkerThread {
     // for this purpose, which will become available in C++20.
     rigtorp::SPSCQueue<TrackPointer> m_nextTrack;
 
+    // Written by the worker thread, consumed by takeThroughput()
+    std::atomic<qint64> m_decodeNanos;
+    std::atomic<qint64> m_analysisNanos;
+    std::atomic<SINT> m_analyzedFrames;
+
     /////////////////////////////////////////////////////////////////////////
     // Thread local: Only used in the constructor/destructor and within
     // run() by the worker thread.
 
     std::vector<AnalyzerWithState> m_analyzers;
 
+    // Optional, runs the analyzers concurrently while this thread decodes
+    std::unique_ptr<AnalyzerPipeline> m_pPipeline;
+
     mixxx::SampleBuffer m_sampleBuffer;
 
     TrackPointer m_currentTrack;
@@ -124,13 +155,37 @@ class AnalyzerThread : public WorkerThread {
 
     PerformanceTimer m_lastBusyProgressEmittedTimer;
 
+    PerformanceTimer m_throughputTimer;
+
+    // A checkpoint of the current track has been stored or restored
+    bool m_hasCheckpoint;
+    // At least one analyzer doesn't support checkpointing
+    bool m_checkpointUnsupported;
+
     enum class AnalysisResult {
         Pending,
         Finished,
         Cancelled,
     };
+    // Returns true if at least one analyzer needs to process the track
+    bool initializeAnalyzers(
+            const mixxx::AudioSourcePointer& audioSource);
+
+    // The optional DAO is needed for storing checkpoints
     AnalysisResult analyzeAudioSource(
+            const mixxx::AudioSourcePointer& audioSource,
+            SINT firstFrameIndex,
+            AnalysisDao* pCheckpointDao);
+
+    // Restores the state of all analyzers from a checkpoint and returns
+    // the index of the first frame that remains to be analyzed
+    SINT restoreCheckpoint(
+            AnalysisDao* pCheckpointDao,
             const mixxx::AudioSourcePointer& audioSource);
+    void saveCheckpoint(
+            AnalysisDao* pCheckpointDao,
+            const mixxx::AudioSourcePointer& audioSource,
+            SINT frameIndex);
 
     // Blocks the worker thread until a next track becomes available
     TrackPointer receiveNextTrack();
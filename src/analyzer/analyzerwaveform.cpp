@@ -1,5 +1,8 @@
 #include "analyzer/analyzerwaveform.h"
 
+#include <cstring>
+
+#include "analyzer/analyzercheckpoint.h"
 #include "engine/engineobject.h"
 #include "engine/filters/enginefilterbessel4.h"
 #include "engine/filters/enginefilterbutterworth8.h"
@@ -11,6 +14,25 @@ namespace {
 
 mixxx::Logger kLogger("AnalyzerWaveform");
 
+const QString kCheckpointTag = QStringLiteral("waveform/1");
+
+void writeWaveformData(QDataStream* pStream, const WaveformData* pData, int size) {
+    *pStream << QByteArray::fromRawData(
+            reinterpret_cast<const char*>(pData),
+            size * static_cast<int>(sizeof(WaveformData)));
+}
+
+bool readWaveformData(QDataStream* pStream, WaveformData* pData, int size) {
+    QByteArray data;
+    *pStream >> data;
+    if (pStream->status() != QDataStream::Ok ||
+            data.size() != size * static_cast<int>(sizeof(WaveformData))) {
+        return false;
+    }
+    std::memcpy(pData, data.constData(), data.size());
+    return true;
+}
+
 } // namespace
 
 AnalyzerWaveform::AnalyzerWaveform(
@@ -91,43 +113,53 @@ bool AnalyzerWaveform::initialize(TrackPointer tio,
 bool AnalyzerWaveform::shouldAnalyze(TrackPointer tio) const {
     ConstWaveformPointer pTrackWaveform = tio->getWaveform();
     ConstWaveformPointer pTrackWaveformSummary = tio->getWaveformSummary();
-    ConstWaveformPointer pLoadedTrackWaveform;
-    ConstWaveformPointer pLoadedTrackWaveformSummary;
+    WaveformPointer pLoadedTrackWaveform;
 
     TrackId trackId = tio->getId();
     bool missingWaveform = pTrackWaveform.isNull();
     bool missingWavesummary = pTrackWaveformSummary.isNull();
 
-    if (trackId.isValid() && (missingWaveform || missingWavesummary)) {
-        QList<AnalysisDao::AnalysisInfo> analyses =
-                m_analysisDao.getAnalysesForTrack(trackId);
-
-        QListIterator<AnalysisDao::AnalysisInfo> it(analyses);
-        while (it.hasNext()) {
-            const AnalysisDao::AnalysisInfo& analysis = it.next();
-            WaveformFactory::VersionClass vc;
-
-            if (analysis.type == AnalysisDao::TYPE_WAVEFORM) {
-                vc = WaveformFactory::waveformVersionToVersionClass(analysis.version);
-                if (missingWaveform && vc == WaveformFactory::VC_USE) {
-                    pLoadedTrackWaveform = ConstWaveformPointer(
-                            WaveformFactory::loadWaveformFromAnalysis(analysis));
-                    missingWaveform = false;
-                } else if (vc != WaveformFactory::VC_KEEP) {
-                    // remove all other Analysis except that one we should keep
-                    m_analysisDao.deleteAnalysis(analysis.analysisId);
-                }
+    if (trackId.isValid() && missingWavesummary) {
+        // The summary is small compared to the waveform and loaded first,
+        // so the overview can already be displayed while the waveform is
+        // loaded and decompressed.
+        const QList<AnalysisDao::AnalysisInfo> analyses =
+                m_analysisDao.getAnalysesForTrackByType(
+                        trackId, AnalysisDao::TYPE_WAVESUMMARY);
+        for (const auto& analysis : analyses) {
+            const WaveformFactory::VersionClass vc =
+                    WaveformFactory::waveformSummaryVersionToVersionClass(
+                            analysis.version);
+            if (missingWavesummary && vc == WaveformFactory::VC_USE) {
+                WaveformPointer pLoadedTrackWaveformSummary = WaveformPointer(
+                        WaveformFactory::loadWaveformFromAnalysis(
+                                analysis, Waveform::Decoding::Deferred));
+                tio->setWaveformSummary(pLoadedTrackWaveformSummary);
+                pLoadedTrackWaveformSummary->decodeDeferredChunks();
+                missingWavesummary = false;
+            } else if (vc != WaveformFactory::VC_KEEP) {
+                // remove all other Analysis except that one we should keep
+                m_analysisDao.deleteAnalysis(analysis.analysisId);
             }
-            if (analysis.type == AnalysisDao::TYPE_WAVESUMMARY) {
-                vc = WaveformFactory::waveformSummaryVersionToVersionClass(analysis.version);
-                if (missingWavesummary && vc == WaveformFactory::VC_USE) {
-                    pLoadedTrackWaveformSummary = ConstWaveformPointer(
-                            WaveformFactory::loadWaveformFromAnalysis(analysis));
-                    missingWavesummary = false;
-                } else if (vc != WaveformFactory::VC_KEEP) {
-                    // remove all other Analysis except that one we should keep
-                    m_analysisDao.deleteAnalysis(analysis.analysisId);
-                }
+        }
+    }
+
+    if (trackId.isValid() && missingWaveform) {
+        // Don't load a checkpoint of the analysis that might also be stored
+        const QList<AnalysisDao::AnalysisInfo> analyses =
+                m_analysisDao.getAnalysesForTrackByType(
+                        trackId, AnalysisDao::TYPE_WAVEFORM);
+        for (const auto& analysis : analyses) {
+            const WaveformFactory::VersionClass vc =
+                    WaveformFactory::waveformVersionToVersionClass(analysis.version);
+            if (missingWaveform && vc == WaveformFactory::VC_USE) {
+                pLoadedTrackWaveform = WaveformPointer(
+                        WaveformFactory::loadWaveformFromAnalysis(
+                                analysis, Waveform::Decoding::Deferred));
+                missingWaveform = false;
+            } else if (vc != WaveformFactory::VC_KEEP) {
+                // remove all other Analysis except that one we should keep
+                m_analysisDao.deleteAnalysis(analysis.analysisId);
             }
         }
     }
@@ -135,11 +167,11 @@ bool AnalyzerWaveform::shouldAnalyze(TrackPointer tio) const {
     // If we don't need to calculate the waveform/wavesummary, skip.
     if (!missingWaveform && !missingWavesummary) {
         kLogger.debug() << "loadStored - Stored waveform loaded";
+        // The waveform is displayed while decoding the
+        // remaining data in this worker thread
         if (pLoadedTrackWaveform) {
             tio->setWaveform(pLoadedTrackWaveform);
-        }
-        if (pLoadedTrackWaveformSummary) {
-            tio->setWaveformSummary(pLoadedTrackWaveformSummary);
+            pLoadedTrackWaveform->decodeDeferredChunks();
         }
         return false;
     }
@@ -264,6 +296,72 @@ void AnalyzerWaveform::cleanup() {
     m_waveformSummaryData = nullptr;
 }
 
+bool AnalyzerWaveform::saveCheckpoint(QDataStream* pStream) const {
+    VERIFY_OR_DEBUG_ASSERT(m_waveform && m_waveformSummary) {
+        return false;
+    }
+    mixxx::analyzer::writeCheckpointTag(pStream, kCheckpointTag);
+    *pStream << static_cast<qint32>(m_waveform->getDataSize())
+             << static_cast<qint32>(m_waveformSummary->getDataSize())
+             << static_cast<qint32>(m_currentStride)
+             << static_cast<qint32>(m_currentSummaryStride)
+             << static_cast<qint32>(m_stride.m_position)
+             << static_cast<qint32>(m_stride.m_averageDivisor);
+    for (int i = 0; i < ChannelCount; ++i) {
+        *pStream << m_stride.m_overallData[i] << m_stride.m_averageOverallData[i];
+        for (int f = 0; f < FilterCount; ++f) {
+            *pStream << m_stride.m_filteredData[i][f] << m_stride.m_averageFilteredData[i][f];
+        }
+    }
+    writeWaveformData(pStream, m_waveformData, m_currentStride);
+    writeWaveformData(pStream, m_waveformSummaryData, m_currentSummaryStride);
+    return pStream->status() == QDataStream::Ok;
+}
+
+bool AnalyzerWaveform::restoreCheckpoint(QDataStream* pStream) {
+    VERIFY_OR_DEBUG_ASSERT(m_waveform && m_waveformSummary) {
+        return false;
+    }
+    if (!mixxx::analyzer::readCheckpointTag(pStream, kCheckpointTag)) {
+        return false;
+    }
+    qint32 dataSize = 0;
+    qint32 summaryDataSize = 0;
+    qint32 currentStride = 0;
+    qint32 currentSummaryStride = 0;
+    qint32 position = 0;
+    qint32 averageDivisor = 0;
+    *pStream >> dataSize >> summaryDataSize >> currentStride >>
+            currentSummaryStride >> position >> averageDivisor;
+    // The waveforms have been allocated by initialize() for the
+    // same audio source
+    if (pStream->status() != QDataStream::Ok ||
+            dataSize != m_waveform->getDataSize() ||
+            summaryDataSize != m_waveformSummary->getDataSize() ||
+            currentStride < 0 || currentStride > dataSize ||
+            currentSummaryStride < 0 || currentSummaryStride > summaryDataSize) {
+        return false;
+    }
+    for (int i = 0; i < ChannelCount; ++i) {
+        *pStream >> m_stride.m_overallData[i] >> m_stride.m_averageOverallData[i];
+        for (int f = 0; f < FilterCount; ++f) {
+            *pStream >> m_stride.m_filteredData[i][f] >> m_stride.m_averageFilteredData[i][f];
+        }
+    }
+    if (!readWaveformData(pStream, m_waveformData, currentStride) ||
+            !readWaveformData(pStream, m_waveformSummaryData, currentSummaryStride)) {
+        return false;
+    }
+    m_stride.m_position = position;
+    m_stride.m_averageDivisor = averageDivisor;
+    m_currentStride = currentStride;
+    m_currentSummaryStride = currentSummaryStride;
+    m_waveform->setCompletion(m_currentStride);
+    m_waveformSummary->setCompletion(m_currentSummaryStride);
+    // The filters start again from a settled state, see initialize()
+    return true;
+}
+
 void AnalyzerWaveform::storeResults(TrackPointer tio) {
     // Force completion to waveform size
     if (m_waveform) {
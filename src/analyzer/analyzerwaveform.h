@@ -147,6 +147,9 @@ class AnalyzerWaveform : public Analyzer {
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
+    bool saveCheckpoint(QDataStream* pStream) const override;
+    bool restoreCheckpoint(QDataStream* pStream) override;
+
   private:
     bool shouldAnalyze(TrackPointer tio) const;
 
@@ -82,24 +82,28 @@ AnalyzerPluginInfo AnalyzerKeyFinder::pluginInfo() {
 
 bool AnalyzerKeyFinder::initialize(mixxx::audio::SampleRate sampleRate) {
     m_audioData.setFrameRate(sampleRate);
-    m_audioData.setChannels(kAnalysisChannels);
+    // libkeyfinder only analyzes a mono downmix, which is done here to not
+    // copy both channels into its buffers first
+    m_audioData.setChannels(1);
     return true;
 }
 
 bool AnalyzerKeyFinder::processSamples(const CSAMPLE* pIn, const int iLen) {
     DEBUG_ASSERT(iLen % kAnalysisChannels == 0);
+    const SINT numInputFrames = iLen / kAnalysisChannels;
     if (m_audioData.getSampleCount() == 0) {
-        m_audioData.addToSampleCount(iLen);
+        m_audioData.addToSampleCount(numInputFrames);
     }
 
-    const SINT numInputFrames = iLen / kAnalysisChannels;
     m_currentFrame += numInputFrames;
 
     for (SINT frame = 0; frame < numInputFrames; frame++) {
+        // Same arithmetic as AudioData::reduceToMono() of libkeyfinder
+        double sum = 0.0;
         for (SINT channel = 0; channel < kAnalysisChannels; channel++) {
-            m_audioData.setSampleByFrame(
-                    frame, channel, pIn[frame * kAnalysisChannels + channel]);
+            sum += pIn[frame * kAnalysisChannels + channel];
         }
+        m_audioData.setSampleByFrame(frame, 0, sum / kAnalysisChannels);
     }
     m_keyFinder.progressiveChromagram(m_audioData, m_workspace);
     return true;
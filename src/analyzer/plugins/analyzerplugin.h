@@ -8,6 +8,8 @@
 #include "track/keys.h"
 #include "util/types.h"
 
+class QDataStream;
+
 namespace mixxx {
 
 class AnalyzerPluginInfo {
@@ -63,6 +65,17 @@ class AnalyzerPlugin {
     virtual bool initialize(mixxx::audio::SampleRate sampleRate) = 0;
     virtual bool processSamples(const CSAMPLE* pIn, const int iLen) = 0;
     virtual bool finalize() = 0;
+
+    // Optional, see Analyzer::saveCheckpoint()
+    virtual bool saveCheckpoint(QDataStream* pStream) const {
+        Q_UNUSED(pStream);
+        return false;
+    }
+    // Optional, see Analyzer::restoreCheckpoint()
+    virtual bool restoreCheckpoint(QDataStream* pStream) {
+        Q_UNUSED(pStream);
+        return false;
+    }
 };
 
 class AnalyzerBeatsPlugin : public AnalyzerPlugin {
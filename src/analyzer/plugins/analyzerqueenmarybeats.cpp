@@ -5,6 +5,7 @@
 // definitions interfere with qm-dsp's headers.
 #include "analyzer/plugins/analyzerqueenmarybeats.h"
 
+#include "analyzer/analyzercheckpoint.h"
 #include "analyzer/constants.h"
 
 namespace mixxx {
@@ -22,6 +23,8 @@ constexpr float kStepSecs = 0.01161f;
 // results in 43 Hz @ 44.1 kHz / 47 Hz @ 48 kHz / 47 Hz @ 96 kHz
 constexpr int kMaximumBinSizeHz = 50; // Hz
 
+const QString kCheckpointTag = QStringLiteral("qm-tempotracker/1");
+
 DFConfig makeDetectionFunctionConfig(int stepSizeFrames, int windowSize) {
     // These are the defaults for the VAMP beat tracker plugin we used in Mixxx
     // 2.0.
@@ -74,6 +77,41 @@ bool AnalyzerQueenMaryBeats::processSamples(const CSAMPLE* pIn, const int iLen)
     return m_helper.processStereoSamples(pIn, iLen);
 }
 
+bool AnalyzerQueenMaryBeats::saveCheckpoint(QDataStream* pStream) const {
+    if (!m_pDetectionFunction) {
+        return false;
+    }
+    analyzer::writeCheckpointTag(pStream, kCheckpointTag);
+    *pStream << static_cast<qint32>(m_stepSizeFrames)
+             << static_cast<qint32>(m_windowSize)
+             << static_cast<quint64>(m_helper.bufferWritePosition());
+    analyzer::writeCheckpointVector(pStream, m_helper.buffer());
+    analyzer::writeCheckpointVector(pStream, m_detectionResults);
+    return pStream->status() == QDataStream::Ok;
+}
+
+bool AnalyzerQueenMaryBeats::restoreCheckpoint(QDataStream* pStream) {
+    if (!m_pDetectionFunction ||
+            !analyzer::readCheckpointTag(pStream, kCheckpointTag)) {
+        return false;
+    }
+    qint32 stepSizeFrames = 0;
+    qint32 windowSize = 0;
+    quint64 bufferWritePosition = 0;
+    *pStream >> stepSizeFrames >> windowSize >> bufferWritePosition;
+    if (stepSizeFrames != m_stepSizeFrames || windowSize != m_windowSize) {
+        return false;
+    }
+    std::vector<double> buffer;
+    if (!analyzer::readCheckpointVector(pStream, &buffer) ||
+            !analyzer::readCheckpointVector(pStream, &m_detectionResults)) {
+        return false;
+    }
+    // The history of the detection function starts from scratch,
+    // which only affects the very first detection result.
+    return m_helper.restoreBuffer(std::move(buffer), bufferWritePosition);
+}
+
 bool AnalyzerQueenMaryBeats::finalize() {
     m_helper.finalize();
 
@@ -36,6 +36,9 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
     bool processSamples(const CSAMPLE* pIn, const int iLen) override;
     bool finalize() override;
 
+    bool saveCheckpoint(QDataStream* pStream) const override;
+    bool restoreCheckpoint(QDataStream* pStream) override;
+
     bool supportsBeatTracking() const override {
         return true;
     }
@@ -4,6 +4,7 @@
 // definitions interfere with qm-dsp's headers.
 #include "analyzer/plugins/analyzerqueenmarykey.h"
 
+#include "analyzer/analyzercheckpoint.h"
 #include "analyzer/constants.h"
 #include "util/assert.h"
 #include "util/math.h"
@@ -17,6 +18,8 @@ namespace {
 // Tuning frequency of concert A in Hertz. Default value from VAMP plugin.
 constexpr int kTuningFrequencyHertz = 440;
 
+const QString kCheckpointTag = QStringLiteral("qm-keydetector/1");
+
 } // namespace
 
 AnalyzerQueenMaryKey::AnalyzerQueenMaryKey()
@@ -87,6 +90,60 @@ bool AnalyzerQueenMaryKey::processSamples(const CSAMPLE* pIn, const int iLen) {
     return m_helper.processStereoSamples(pIn, iLen);
 }
 
+bool AnalyzerQueenMaryKey::saveCheckpoint(QDataStream* pStream) const {
+    if (!m_pKeyMode) {
+        return false;
+    }
+    analyzer::writeCheckpointTag(pStream, kCheckpointTag);
+    *pStream << static_cast<quint64>(m_currentFrame)
+             << static_cast<qint32>(m_prevKey)
+             << static_cast<quint64>(m_helper.bufferWritePosition());
+    analyzer::writeCheckpointVector(pStream, m_helper.buffer());
+    *pStream << static_cast<qint32>(m_resultKeys.size());
+    for (const auto& keyChange : m_resultKeys) {
+        *pStream << static_cast<qint32>(keyChange.first) << keyChange.second;
+    }
+    return pStream->status() == QDataStream::Ok;
+}
+
+bool AnalyzerQueenMaryKey::restoreCheckpoint(QDataStream* pStream) {
+    if (!m_pKeyMode ||
+            !analyzer::readCheckpointTag(pStream, kCheckpointTag)) {
+        return false;
+    }
+    quint64 currentFrame = 0;
+    qint32 prevKey = 0;
+    quint64 bufferWritePosition = 0;
+    *pStream >> currentFrame >> prevKey >> bufferWritePosition;
+    std::vector<double> buffer;
+    if (!analyzer::readCheckpointVector(pStream, &buffer)) {
+        return false;
+    }
+    qint32 numKeyChanges = 0;
+    *pStream >> numKeyChanges;
+    KeyChangeList resultKeys;
+    for (qint32 i = 0; i < numKeyChanges; ++i) {
+        qint32 key = 0;
+        double frame = 0;
+        *pStream >> key >> frame;
+        if (pStream->status() != QDataStream::Ok || !ChromaticKey_IsValid(key)) {
+            return false;
+        }
+        resultKeys.push_back(qMakePair(static_cast<ChromaticKey>(key), frame));
+    }
+    if (pStream->status() != QDataStream::Ok ||
+            !ChromaticKey_IsValid(prevKey) ||
+            !m_helper.restoreBuffer(std::move(buffer), bufferWritePosition)) {
+        return false;
+    }
+    // The chromagram of the key detector starts from scratch and needs
+    // a few windows to settle again.
+    m_currentFrame = currentFrame;
+    m_prevKey = static_cast<ChromaticKey>(prevKey);
+    m_resultKeys = std::move(resultKeys);
+    return true;
+}
+
 bool AnalyzerQueenMaryKey::finalize() {
     m_helper.finalize();
     m_pKeyMode.reset();
@@ -36,6 +36,9 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
     bool processSamples(const CSAMPLE* pIn, const int iLen) override;
     bool finalize() override;
 
+    bool saveCheckpoint(QDataStream* pStream) const override;
+    bool restoreCheckpoint(QDataStream* pStream) override;
+
     KeyChangeList getKeyChanges() const override {
         return m_resultKeys;
     }
@@ -1,19 +1,37 @@
 #include "analyzer/plugins/buffering_utils.h"
 
+#include <algorithm>
+
 #include "util/math.h"
 #include "util/sample.h"
 
-#include <string.h>
-
 namespace mixxx {
 
+namespace {
+
+// The number of steps that fit into the buffer in addition to the window
+// before the overlapping part is moved to the front again
+constexpr size_t kBufferedSteps = 64;
+
+// We analyze a mono downmix of the signal since we don't think stereo does
+// us any good.
+void downmixStereoToMono(double* pMono, const CSAMPLE* pStereo, size_t numFrames) {
+    // note: LOOP VECTORIZED.
+    for (size_t i = 0; i < numFrames; ++i) {
+        pMono[i] = (pStereo[i * 2] + pStereo[i * 2 + 1]) * 0.5;
+    }
+}
+
+} // anonymous namespace
+
 bool DownmixAndOverlapHelper::initialize(size_t windowSize,
         size_t stepSize,
         const WindowReadyCallback& callback) {
-    m_buffer.assign(windowSize, 0.0);
+    m_buffer.assign(windowSize + kBufferedSteps * stepSize, 0.0);
     m_callback = callback;
     m_windowSize = windowSize;
     m_stepSize = stepSize;
+    m_windowStart = 0;
     // make sure the first frame is centered into the fft window. This makes sure
     // that the result is significant starting fom the first step.
     m_bufferWritePosition = windowSize / 2;
@@ -21,6 +39,17 @@ bool DownmixAndOverlapHelper::initialize(size_t windowSize,
             m_stepSize <= m_windowSize && callback;
 }
 
+bool DownmixAndOverlapHelper::restoreBuffer(
+        std::vector<double> buffer, size_t bufferWritePosition) {
+    if (buffer.size() != m_windowSize || bufferWritePosition >= m_windowSize) {
+        return false;
+    }
+    std::copy(buffer.begin(), buffer.end(), m_buffer.begin());
+    m_windowStart = 0;
+    m_bufferWritePosition = bufferWritePosition;
+    return true;
+}
+
 bool DownmixAndOverlapHelper::processStereoSamples(const CSAMPLE* pInput, size_t inputStereoSamples) {
     const size_t numInputFrames = inputStereoSamples / 2;
     return processInner(pInput, numInputFrames);
@@ -40,33 +69,27 @@ bool DownmixAndOverlapHelper::finalize() {
 bool DownmixAndOverlapHelper::processInner(
         const CSAMPLE* pInput, size_t numInputFrames) {
     size_t inRead = 0;
-    double* pDownmix = m_buffer.data();
 
     while (inRead < numInputFrames) {
         size_t readAvailable = numInputFrames - inRead;
         DEBUG_ASSERT(m_bufferWritePosition <= m_windowSize);
         size_t writeAvailable = m_windowSize - m_bufferWritePosition;
         size_t numFrames = math_min(readAvailable, writeAvailable);
+        double* pWindow = m_buffer.data() + m_windowStart;
         if (pInput) {
-            for (size_t i = 0; i < numFrames; ++i) {
-                // We analyze a mono downmix of the signal since we don't think
-                // stereo does us any good.
-                pDownmix[m_bufferWritePosition + i] = (pInput[(inRead + i) * 2] +
-                                                              pInput[(inRead + i) * 2 + 1]) *
-                        0.5;
-            }
+            downmixStereoToMono(pWindow + m_bufferWritePosition,
+                    pInput + inRead * 2,
+                    numFrames);
         } else {
             // we are in the finalize call. Add silence to
             // complete samples left in th buffer.
-            for (size_t i = 0; i < numFrames; ++i) {
-                pDownmix[m_bufferWritePosition + i] = 0;
-            }
+            std::fill_n(pWindow + m_bufferWritePosition, numFrames, 0.0);
         }
         m_bufferWritePosition += numFrames;
         inRead += numFrames;
 
         if (m_bufferWritePosition == m_windowSize) {
-            bool result = m_callback(pDownmix, m_windowSize);
+            bool result = m_callback(pWindow, m_windowSize);
 
             // If the callback said not to continue then stop.
             if (!result) {
@@ -75,10 +98,14 @@ bool DownmixAndOverlapHelper::processInner(
 
             // If the window size equals the step size then this will result
             // in m_bufferWritePosition == 0.
-            for (size_t i = 0; i < (m_windowSize - m_stepSize); ++i) {
-                pDownmix[i] = pDownmix[i + m_stepSize];
-            }
+            m_windowStart += m_stepSize;
             m_bufferWritePosition -= m_stepSize;
+            if (m_windowStart + m_windowSize > m_buffer.size()) {
+                std::copy_n(m_buffer.begin() + m_windowStart,
+                        m_bufferWritePosition,
+                        m_buffer.begin());
+                m_windowStart = 0;
+            }
         }
     }
     return true;
@@ -10,6 +10,11 @@ namespace mixxx {
 // This is used for downmixing a stereo buffer into mono and framing it into
 // overlapping windows as is typically necessary when taking a short-time
 // Fourier transform.
+//
+// The windows are framed in a buffer that is large enough for many steps,
+// so the overlapping part of the window only needs to be moved to the front
+// of the buffer once in a while instead of after every step. The callback
+// must not modify the window.
 class DownmixAndOverlapHelper {
   public:
     DownmixAndOverlapHelper() = default;
@@ -27,6 +32,17 @@ class DownmixAndOverlapHelper {
 
     bool finalize();
 
+    // The partially filled window, needed for checkpointing
+    std::vector<double> buffer() const {
+        return std::vector<double>(m_buffer.begin() + m_windowStart,
+                m_buffer.begin() + m_windowStart + m_windowSize);
+    }
+    size_t bufferWritePosition() const {
+        return m_bufferWritePosition;
+    }
+    // Restores a partially filled window after initialize()
+    bool restoreBuffer(std::vector<double> buffer, size_t bufferWritePosition);
+
   private:
     bool processInner(const CSAMPLE* pInput, size_t numInputFrames);
 
@@ -35,6 +51,9 @@ class DownmixAndOverlapHelper {
     size_t m_windowSize = 0;
     // The number of frames to step the window forward on each output.
     size_t m_stepSize = 0;
+    // The start of the current window in m_buffer
+    size_t m_windowStart = 0;
+    // The write position relative to m_windowStart
     size_t m_bufferWritePosition = 0;
     WindowReadyCallback m_callback;
 };
@@ -1,8 +1,13 @@
 #include "analyzer/trackanalysisscheduler.h"
 
+#include <QFileInfo>
+#include <QSet>
+#include <QStorageInfo>
+
 #include "moc_trackanalysisscheduler.cpp"
 #include "track/track.h"
 #include "util/logger.h"
+#include "util/math.h"
 
 namespace {
 
@@ -13,6 +18,27 @@ constexpr QThread::Priority kWorkerThreadPriority = QThread::LowPriority;
 // Maximum frequency of progress updates
 constexpr std::chrono::milliseconds kProgressInhibitDuration(100);
 
+// Adaptive mode: Interval for adjusting the number of active workers
+constexpr int kAdaptIntervalMillis = 2000;
+
+// Adaptive mode: Don't draw any conclusions from too few measurements
+const mixxx::Duration kMinMeasuredDuration = mixxx::Duration::fromMillis(500);
+
+// Adaptive mode: The workers are considered I/O bound if they spend more
+// than this share of the time for decoding. Additional workers would
+// only compete for the same disk or network bandwidth. If they spend
+// less than the lower share the analysis is CPU bound and additional
+// workers will utilize more cores.
+constexpr double kIoBoundDecodeShare = 0.5;
+constexpr double kCpuBoundDecodeShare = 0.2;
+
+// Adaptive mode: Leave the remaining cores to the engine while playing
+constexpr int kMaxActiveWorkersWhilePlaying = 1;
+
+// The number of queued tracks that are considered when looking for
+// a track on a different volume
+constexpr std::size_t kVolumeLookahead = 8;
+
 void deleteTrackAnalysisScheduler(TrackAnalysisScheduler* plainPtr) {
     if (plainPtr) {
         // Trigger stop
@@ -51,6 +77,13 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
         const UserSettingsPointer& pConfig,
         AnalyzerModeFlags modeFlags)
         : m_pEnvironment(std::move(pEnvironment)),
+          m_adaptiveThreads(modeFlags & AnalyzerModeFlags::AdaptiveThreads),
+          m_numActiveWorkers(m_adaptiveThreads
+                          ? math_max(1, numWorkerThreads / 2)
+                          : numWorkerThreads),
+          m_numDecks(QStringLiteral("[Master]"),
+                  QStringLiteral("num_decks"),
+                  ControlFlag::AllowMissingOrInvalid),
           m_currentTrackProgress(kAnalyzerProgressUnknown),
           m_currentTrackNumber(0),
           m_dequeuedTracksCount(0),
@@ -66,7 +99,8 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
                 << "Starting"
                 << numWorkerThreads
                 << "worker threads. Priority: "
-                << (modeFlags & AnalyzerModeFlags::LowPriority ? "low" : "normal");
+                << (modeFlags & AnalyzerModeFlags::LowPriority ? "low" : "normal")
+                << (m_adaptiveThreads ? "Adaptive mode" : "");
     }
     // 1st pass: Create worker threads
     m_workers.reserve(numWorkerThreads);
@@ -86,6 +120,13 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
         worker.thread()->suspend();
         worker.thread()->start(kWorkerThreadPriority);
     }
+    if (m_adaptiveThreads) {
+        connect(&m_adaptTimer,
+                &QTimer::timeout,
+                this,
+                &TrackAnalysisScheduler::slotAdaptNumActiveWorkers);
+        m_adaptTimer.start(kAdaptIntervalMillis);
+    }
 }
 
 TrackAnalysisScheduler::~TrackAnalysisScheduler() {
@@ -199,7 +240,11 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
         DEBUG_ASSERT(!trackId.isValid());
         DEBUG_ASSERT(analyzerProgress == kAnalyzerProgressUnknown);
         worker.onAnalyzerProgress(analyzerProgress);
-        submitNextTrack(&worker);
+        worker.onThreadIdle();
+        // Inactive workers stay idle until they are activated again
+        if (isActiveWorker(worker)) {
+            submitNextTrack(&worker);
+        }
         break;
     case AnalyzerThreadState::Busy:
         DEBUG_ASSERT(trackId.isValid());
@@ -219,6 +264,7 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
                     || (analyzerProgress == kAnalyzerProgressUnknown)); // failure
             m_pendingTrackIds.erase(trackId);
             worker.onAnalyzerProgress(analyzerProgress);
+            worker.onTrackDone();
             emit trackProgress(trackId, analyzerProgress);
         }
         break;
@@ -275,6 +321,9 @@ void TrackAnalysisScheduler::resume() {
 
 bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
     DEBUG_ASSERT(worker);
+    if (m_adaptiveThreads) {
+        preferTrackOnOtherVolume(*worker);
+    }
     while (!m_queuedTrackIds.empty()) {
         TrackId nextTrackId = m_queuedTrackIds.front();
         DEBUG_ASSERT(nextTrackId.isValid());
@@ -283,7 +332,12 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
                     m_pEnvironment->loadTrackById(nextTrackId);
             if (nextTrack) {
                 if (m_pendingTrackIds.insert(nextTrackId).second) {
-                    if (worker->submitNextTrack(std::move(nextTrack))) {
+                    QString volume;
+                    if (m_adaptiveThreads) {
+                        volume = volumeOfTrack(nextTrackId);
+                        m_trackVolumes.erase(nextTrackId);
+                    }
+                    if (worker->submitNextTrack(std::move(nextTrack), std::move(volume))) {
                         m_queuedTrackIds.pop_front();
                         ++m_dequeuedTracksCount;
                         return true;
@@ -330,5 +384,125 @@ void TrackAnalysisScheduler::stop() {
     // and m_workers must not be modified!
     m_queuedTrackIds.clear();
     m_pendingTrackIds.clear();
+    m_trackVolumes.clear();
+    m_adaptTimer.stop();
     DEBUG_ASSERT((allTracksFinished()));
 }
+
+void TrackAnalysisScheduler::setNumActiveWorkers(int numActiveWorkers) {
+    DEBUG_ASSERT(numActiveWorkers > 0);
+    DEBUG_ASSERT(numActiveWorkers <= static_cast<int>(m_workers.size()));
+    kLogger.debug()
+            << "Changing the number of active workers from"
+            << m_numActiveWorkers
+            << "to"
+            << numActiveWorkers;
+    m_numActiveWorkers = numActiveWorkers;
+    // Deactivated workers finish their current track and then stay
+    // idle. Activated workers might be idle and need to be fed.
+    for (auto& worker : m_workers) {
+        if (worker && worker.isIdle() && isActiveWorker(worker)) {
+            submitNextTrack(&worker);
+        }
+    }
+}
+
+void TrackAnalysisScheduler::slotAdaptNumActiveWorkers() {
+    mixxx::Duration decodeDuration;
+    mixxx::Duration analysisDuration;
+    for (const auto& worker : m_workers) {
+        if (!worker) {
+            continue;
+        }
+        const auto throughput = worker.thread()->takeThroughput();
+        decodeDuration += throughput.decodeDuration;
+        analysisDuration += throughput.analysisDuration;
+    }
+
+    int numActiveWorkers = m_numActiveWorkers;
+    const auto measuredDuration = decodeDuration + analysisDuration;
+    if (measuredDuration >= kMinMeasuredDuration) {
+        const double decodeShare =
+                decodeDuration.toDoubleSeconds() /
+                measuredDuration.toDoubleSeconds();
+        if (decodeShare > kIoBoundDecodeShare) {
+            --numActiveWorkers;
+        } else if (decodeShare < kCpuBoundDecodeShare) {
+            ++numActiveWorkers;
+        }
+    }
+    // Running workers are not interrupted when a deck starts playing,
+    // they will finish their current track at low priority
+    const int maxActiveWorkers = isAnyDeckPlaying()
+            ? kMaxActiveWorkersWhilePlaying
+            : static_cast<int>(m_workers.size());
+    numActiveWorkers = math_clamp(numActiveWorkers, 1, math_max(1, maxActiveWorkers));
+    if (numActiveWorkers != m_numActiveWorkers) {
+        setNumActiveWorkers(numActiveWorkers);
+    }
+}
+
+bool TrackAnalysisScheduler::isAnyDeckPlaying() {
+    const int numDecks = static_cast<int>(m_numDecks.get());
+    while (static_cast<int>(m_playControls.size()) < numDecks) {
+        m_playControls.emplace_back(
+                QStringLiteral("[Channel%1]").arg(m_playControls.size() + 1),
+                QStringLiteral("play"),
+                ControlFlag::AllowMissingOrInvalid);
+    }
+    for (int i = 0; i < numDecks; ++i) {
+        if (m_playControls[i].toBool()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString TrackAnalysisScheduler::volumeOfTrack(TrackId trackId) {
+    const auto i = m_trackVolumes.find(trackId);
+    if (i != m_trackVolumes.end()) {
+        return i->second;
+    }
+    QString volume;
+    const TrackPointer pTrack = m_pEnvironment->loadTrackById(trackId);
+    if (pTrack) {
+        const QString directory = QFileInfo(pTrack->getLocation()).absolutePath();
+        auto j = m_directoryVolumes.constFind(directory);
+        if (j == m_directoryVolumes.constEnd()) {
+            // Querying the storage info is expensive
+            const QStorageInfo storageInfo(directory);
+            j = m_directoryVolumes.insert(directory,
+                    storageInfo.isValid() ? storageInfo.rootPath() : QString());
+        }
+        volume = j.value();
+    }
+    m_trackVolumes.emplace(trackId, volume);
+    return volume;
+}
+
+void TrackAnalysisScheduler::preferTrackOnOtherVolume(const Worker& worker) {
+    if (m_numActiveWorkers < 2 || m_queuedTrackIds.size() < 2) {
+        return;
+    }
+    QSet<QString> busyVolumes;
+    for (const auto& otherWorker : m_workers) {
+        if (&otherWorker != &worker && !otherWorker.volume().isEmpty()) {
+            busyVolumes.insert(otherWorker.volume());
+        }
+    }
+    if (busyVolumes.isEmpty()) {
+        return;
+    }
+    const std::size_t lookahead = math_min(m_queuedTrackIds.size(), kVolumeLookahead);
+    for (std::size_t i = 0; i < lookahead; ++i) {
+        const TrackId trackId = m_queuedTrackIds[i];
+        if (!busyVolumes.contains(volumeOfTrack(trackId))) {
+            if (i > 0) {
+                m_queuedTrackIds.erase(m_queuedTrackIds.begin() + i);
+                m_queuedTrackIds.push_front(trackId);
+            }
+            return;
+        }
+    }
+    // All tracks within the lookahead are stored on busy volumes
+}
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <QHash>
 #include <QList>
+#include <QTimer>
 #include <deque>
+#include <map>
 #include <memory>
 #include <set>
 #include <vector>
 
 #include "analyzer/analyzerthread.h"
+#include "control/pollingcontrolproxy.h"
 #include "util/db/dbconnectionpool.h"
 
 /// Callbacks for triggering side-effects in the outer context of
@@ -72,6 +76,9 @@ class TrackAnalysisScheduler : public QObject {
   private slots:
     void onWorkerThreadProgress(int threadId, AnalyzerThreadState threadState, TrackId trackId, AnalyzerProgress analyzerProgress);
 
+    // Periodically adjusts the number of active workers in adaptive mode
+    void slotAdaptNumActiveWorkers();
+
   private:
     // Owns an analyzer thread and buffers the most recent progress update
     // received from this thread during analysis. It does not need to be
@@ -81,7 +88,8 @@ class TrackAnalysisScheduler : public QObject {
       public:
         explicit Worker(AnalyzerThread::Pointer thread = AnalyzerThread::NullPointer())
             : m_thread(std::move(thread)),
-              m_analyzerProgress(kAnalyzerProgressUnknown) {
+              m_analyzerProgress(kAnalyzerProgressUnknown),
+              m_idle(false) {
         }
         Worker(const Worker&) = delete;
         Worker(Worker&&) = default;
@@ -99,10 +107,25 @@ class TrackAnalysisScheduler : public QObject {
             return m_analyzerProgress;
         }
 
-        bool submitNextTrack(TrackPointer track) {
+        // Idle workers are waiting for the next track
+        bool isIdle() const {
+            return m_idle;
+        }
+
+        // The volume of the track that is currently analyzed, if known
+        const QString& volume() const {
+            return m_volume;
+        }
+
+        bool submitNextTrack(TrackPointer track, QString volume) {
             DEBUG_ASSERT(track);
             DEBUG_ASSERT(m_thread);
-            return m_thread->submitNextTrack(std::move(track));
+            if (!m_thread->submitNextTrack(std::move(track))) {
+                return false;
+            }
+            m_idle = false;
+            m_volume = std::move(volume);
+            return true;
         }
 
         void suspendThread() {
@@ -128,20 +151,49 @@ class TrackAnalysisScheduler : public QObject {
             m_analyzerProgress = analyzerProgress;
         }
 
+        void onThreadIdle() {
+            DEBUG_ASSERT(m_thread);
+            m_idle = true;
+        }
+
+        void onTrackDone() {
+            m_volume.clear();
+        }
+
         void onThreadExit() {
             DEBUG_ASSERT(m_thread);
             m_thread.reset();
             m_analyzerProgress = kAnalyzerProgressUnknown;
+            m_idle = false;
+            m_volume.clear();
         }
 
       private:
         AnalyzerThread::Pointer m_thread;
         AnalyzerProgress m_analyzerProgress;
+        bool m_idle;
+        QString m_volume;
     };
 
     bool submitNextTrack(Worker* worker);
     void emitProgressOrFinished();
 
+    bool isActiveWorker(const Worker& worker) const {
+        return worker.thread()->id() < m_numActiveWorkers;
+    }
+    void setNumActiveWorkers(int numActiveWorkers);
+
+    bool isAnyDeckPlaying();
+
+    // Returns the root path of the volume that stores the file of the
+    // track or an empty string if unknown. The results are cached.
+    QString volumeOfTrack(TrackId trackId);
+    // Moves a queued track to the front, which is not stored on the same
+    // volume as the tracks that are currently analyzed by other workers.
+    // Concurrent reads from the same disk cause seeking, which slows
+    // down all workers.
+    void preferTrackOnOtherVolume(const Worker& worker);
+
     bool allTracksFinished() const {
         return m_queuedTrackIds.empty() &&
                 m_pendingTrackIds.empty();
@@ -151,6 +203,19 @@ class TrackAnalysisScheduler : public QObject {
 
     std::vector<Worker> m_workers;
 
+    // Adaptive mode: Only the first m_numActiveWorkers workers receive
+    // new tracks. This number is adjusted depending on whether the
+    // analysis is bound by decoding (I/O) or by the analyzers (CPU).
+    const bool m_adaptiveThreads;
+    int m_numActiveWorkers;
+    QTimer m_adaptTimer;
+
+    PollingControlProxy m_numDecks;
+    std::vector<PollingControlProxy> m_playControls;
+
+    std::map<TrackId, QString> m_trackVolumes;
+    QHash<QString, QString> m_directoryVolumes;
+
     std::deque<TrackId> m_queuedTrackIds;
 
     // Tracks that have already been submitted to workers
@@ -18,13 +18,16 @@
 
 namespace {
 const mixxx::Logger kLogger("BroadcastManager");
+
+constexpr int kSendStatisticsIntervalMillis = 1000;
 } // namespace
 
 BroadcastManager::BroadcastManager(SettingsManager* pSettingsManager,
                                    SoundManager* pSoundManager)
         : m_pConfig(pSettingsManager->settings()),
           m_pBroadcastSettings(pSettingsManager->broadcastSettings()),
-          m_pNetworkStream(pSoundManager->getNetworkStream()) {
+          m_pNetworkStream(pSoundManager->getNetworkStream()),
+          m_pEncoderPool(std::make_shared<BroadcastEncoderPool>()) {
     const bool persist = true;
     m_pBroadcastEnabled = new ControlPushButton(
             ConfigKey(BROADCAST_PREF_KEY,"enabled"), persist);
@@ -38,6 +41,16 @@ BroadcastManager::BroadcastManager(SettingsManager* pSettingsManager,
     m_pStatusCO->setReadOnly();
     m_pStatusCO->forceSet(STATUSCO_UNCONNECTED);
 
+    m_pSendQueueBytesCO = new ControlObject(ConfigKey(BROADCAST_PREF_KEY, "send_queue_bytes"));
+    m_pSendQueueBytesCO->setReadOnly();
+    m_pDroppedPacketsCO = new ControlObject(ConfigKey(BROADCAST_PREF_KEY, "dropped_packets"));
+    m_pDroppedPacketsCO->setReadOnly();
+    connect(&m_sendStatisticsTimer,
+            &QTimer::timeout,
+            this,
+            &BroadcastManager::slotUpdateSendStatistics);
+    m_sendStatisticsTimer.start(kSendStatisticsIntervalMillis);
+
     // Initialize libshout
     shout_init();
 
@@ -68,6 +81,9 @@ BroadcastManager::~BroadcastManager() {
     // Disable broadcast so when Mixxx starts again it will not connect.
     m_pBroadcastEnabled->set(0);
 
+    m_sendStatisticsTimer.stop();
+    delete m_pDroppedPacketsCO;
+    delete m_pSendQueueBytesCO;
     delete m_pStatusCO;
     delete m_pBroadcastEnabled;
 
@@ -160,7 +176,7 @@ bool BroadcastManager::addConnection(BroadcastProfilePtr profile) {
         return false;
     }
 
-    ShoutConnectionPtr connection(new ShoutConnection(profile, m_pConfig));
+    ShoutConnectionPtr connection(new ShoutConnection(profile, m_pConfig, m_pEncoderPool));
     m_pNetworkStream->addOutputWorker(connection);
 
     connect(profile.data(),
@@ -260,3 +276,18 @@ void BroadcastManager::slotConnectionStatusChanged(int newState) {
         m_pStatusCO->forceSet(STATUSCO_UNCONNECTED);
     }
 }
+
+void BroadcastManager::slotUpdateSendStatistics() {
+    int sendQueueBytes = 0;
+    int droppedPackets = 0;
+    const QVector<NetworkOutputStreamWorkerPtr> workers = m_pNetworkStream->outputWorkers();
+    for (const NetworkOutputStreamWorkerPtr& pWorker : workers) {
+        ShoutConnectionPtr connection = qSharedPointerCast<ShoutConnection>(pWorker);
+        if (connection) {
+            sendQueueBytes += connection->sendQueueBytes();
+            droppedPackets += connection->droppedPackets();
+        }
+    }
+    m_pSendQueueBytesCO->forceSet(sendQueueBytes);
+    m_pDroppedPacketsCO->forceSet(droppedPackets);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QObject>
+#include <QTimer>
 
 #include "preferences/settingsmanager.h"
 #include "preferences/usersettings.h"
@@ -42,6 +43,7 @@ class BroadcastManager : public QObject {
     void slotProfileRemoved(BroadcastProfilePtr profile);
     void slotProfilesChanged();
     void slotConnectionStatusChanged(int newState);
+    void slotUpdateSendStatistics();
 
   private:
     bool addConnection(BroadcastProfilePtr profile);
@@ -51,7 +53,13 @@ class BroadcastManager : public QObject {
     UserSettingsPointer m_pConfig;
     BroadcastSettingsPointer m_pBroadcastSettings;
     QSharedPointer<EngineNetworkStream> m_pNetworkStream;
+    // Shared by all connections to encode identical streams only once
+    std::shared_ptr<BroadcastEncoderPool> m_pEncoderPool;
 
     ControlPushButton* m_pBroadcastEnabled;
     ControlObject* m_pStatusCO;
+    // Encoded bytes waiting to be sent and packets dropped by all connections
+    ControlObject* m_pSendQueueBytesCO;
+    ControlObject* m_pDroppedPacketsCO;
+    QTimer m_sendStatisticsTimer;
 };
@@ -1,5 +1,9 @@
 #include "control/control.h"
 
+#include <QCoreApplication>
+#include <QThread>
+#include <QVarLengthArray>
+
 #include "control/controlobject.h"
 #include "moc_control.cpp"
 #include "util/stat.h"
@@ -13,20 +17,36 @@ namespace {
 /// configuration object would be arduous.
 UserSettingsPointer s_pUserConfig;
 
-/// Mutex guarding access to s_qCOHash and s_qCOAliasHash.
-MMutex s_qCOHashMutex;
+/// Lock guarding access to s_qCOHash and s_qCOAliasHash. Looking up existing
+/// controls, e.g. by the many ControlProxys created while loading skins and
+/// controller mappings, only needs the read lock and therefore doesn't block
+/// other threads that look up controls at the same time.
+MReadWriteLock s_qCOHashLock;
 
 /// Hash of ControlDoublePrivate instantiations.
 QHash<ConfigKey, QWeakPointer<ControlDoublePrivate>> s_qCOHash
-        GUARDED_BY(s_qCOHashMutex);
+        GUARDED_BY(s_qCOHashLock);
 
 /// Hash of aliases between ConfigKeys. Solely used for looking up the first
 /// alias associated with a key.
 QHash<ConfigKey, ConfigKey> s_qCOAliasHash
-        GUARDED_BY(s_qCOHashMutex);
+        GUARDED_BY(s_qCOHashLock);
 
 /// is used instead of a nullptr, helps to omit null checks everywhere
 QWeakPointer<ControlDoublePrivate> s_pDefaultCO;
+
+/// Mutex guarding access to s_coalescedControls.
+MMutex s_coalescedControlsMutex;
+
+/// Controls with subscribers of coalescedValueChanged() by the index of
+/// their value slot.
+QHash<int, ControlDoublePrivate*> s_coalescedControls
+        GUARDED_BY(s_coalescedControlsMutex);
+
+bool isMainThread() {
+    const auto* pApp = QCoreApplication::instance();
+    return pApp && QThread::currentThread() == pApp->thread();
+}
 } // namespace
 
 ControlDoublePrivate::ControlDoublePrivate()
@@ -37,7 +57,10 @@ ControlDoublePrivate::ControlDoublePrivate()
           m_trackFlags(Stat::COUNT | Stat::SUM | Stat::AVERAGE |
                   Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX),
           // default CO is read only
-          m_confirmRequired(true) {
+          m_confirmRequired(true),
+          m_valueIndex(ControlValueTable::allocate(0.0)),
+          m_pValueSlot(&ControlValueTable::slot(m_valueIndex)),
+          m_coalescedSubscribers(0) {
 }
 
 ControlDoublePrivate::ControlDoublePrivate(
@@ -55,7 +78,10 @@ ControlDoublePrivate::ControlDoublePrivate(
           m_trackType(Stat::UNSPECIFIED),
           m_trackFlags(Stat::COUNT | Stat::SUM | Stat::AVERAGE |
                   Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX),
-          m_confirmRequired(false) {
+          m_confirmRequired(false),
+          m_valueIndex(ControlValueTable::allocate(defaultValue)),
+          m_pValueSlot(&ControlValueTable::slot(m_valueIndex)),
+          m_coalescedSubscribers(0) {
     initialize(defaultValue);
 }
 
@@ -70,24 +96,29 @@ void ControlDoublePrivate::initialize(double defaultValue) {
         }
     }
     m_defaultValue.setValue(defaultValue);
-    m_value.setValue(value);
+    m_pValueSlot->value.store(value, std::memory_order_release);
 
-    //qDebug() << "Creating:" << m_trackKey << "at" << &m_value << sizeof(m_value);
+    //qDebug() << "Creating:" << m_trackKey << "at" << m_pValueSlot;
 
     if (m_bTrack) {
         // TODO(rryan): Make configurable.
         m_trackKey = "control " + m_key.group + "," + m_key.item;
         Stat::track(m_trackKey, static_cast<Stat::StatType>(m_trackType),
                     static_cast<Stat::ComputeFlags>(m_trackFlags),
-                    m_value.getValue());
+                    get());
     }
 }
 
 ControlDoublePrivate::~ControlDoublePrivate() {
-    s_qCOHashMutex.lock();
+    {
+        const MMutexLocker locker(&s_coalescedControlsMutex);
+        s_coalescedControls.remove(m_valueIndex);
+    }
+
+    s_qCOHashLock.lockForWrite();
     //qDebug() << "ControlDoublePrivate::s_qCOHash.remove(" << m_key.group << "," << m_key.item << ")";
     s_qCOHash.remove(m_key);
-    s_qCOHashMutex.unlock();
+    s_qCOHashLock.unlock();
 
     if (m_bPersistInConfiguration) {
         UserSettingsPointer pConfig = s_pUserConfig;
@@ -96,6 +127,7 @@ ControlDoublePrivate::~ControlDoublePrivate() {
         }
         pConfig->set(m_key, QString::number(get()));
     }
+    ControlValueTable::release(m_valueIndex);
 }
 
 //static
@@ -106,7 +138,7 @@ void ControlDoublePrivate::setUserConfig(const UserSettingsPointer& pConfig) {
 
 // static
 void ControlDoublePrivate::insertAlias(const ConfigKey& alias, const ConfigKey& key) {
-    MMutexLocker locker(&s_qCOHashMutex);
+    MWriteLocker locker(&s_qCOHashLock);
 
     auto it = s_qCOHash.constFind(key);
     VERIFY_OR_DEBUG_ASSERT(it != s_qCOHash.constEnd()) {
@@ -142,11 +174,11 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
         return nullptr;
     }
 
-    // Scope for MMutexLocker.
+    // Scope for MReadLocker.
     {
-        const MMutexLocker locker(&s_qCOHashMutex);
-        const auto it = s_qCOHash.find(key);
-        if (it != s_qCOHash.end()) {
+        const MReadLocker locker(&s_qCOHashLock);
+        const auto it = s_qCOHash.constFind(key);
+        if (it != s_qCOHash.constEnd()) {
             auto pControl = it.value().lock();
             if (pControl) {
                 // Control object already exists
@@ -159,10 +191,9 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
                     return nullptr;
                 }
                 return pControl;
-            } else {
-                // The weak pointer has become invalid and can be cleaned up
-                s_qCOHash.erase(it);
             }
+            // The weak pointer has become invalid. It is replaced below if the
+            // control is created again and removed otherwise.
         }
     }
 
@@ -174,12 +205,20 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
                         bTrack,
                         bPersist,
                         defaultValue));
-        const MMutexLocker locker(&s_qCOHashMutex);
+        const MWriteLocker locker(&s_qCOHashLock);
         //qDebug() << "ControlDoublePrivate::s_qCOHash.insert(" << key.group << "," << key.item << ")";
         s_qCOHash.insert(key, pControl);
         return pControl;
     }
 
+    {
+        const MWriteLocker locker(&s_qCOHashLock);
+        const auto it = s_qCOHash.find(key);
+        if (it != s_qCOHash.end() && it.value().isNull()) {
+            s_qCOHash.erase(it);
+        }
+    }
+
     if (!flags.testFlag(ControlFlag::NoWarnIfMissing)) {
         qWarning() << "ControlDoublePrivate::getControl returning NULL for ("
                    << key.group << "," << key.item << ")";
@@ -195,7 +234,7 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getDefaultControl() {
         // Try again with the mutex locked to protect against creating two
         // ControlDoublePrivateConst objects. Access to s_defaultCO itself is
         // thread save.
-        MMutexLocker locker(&s_qCOHashMutex);
+        MWriteLocker locker(&s_qCOHashLock);
         defaultCO = s_pDefaultCO.lock();
         if (!defaultCO) {
             defaultCO = QSharedPointer<ControlDoublePrivate>(new ControlDoublePrivateConst());
@@ -208,15 +247,16 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getDefaultControl() {
 // static
 QList<QSharedPointer<ControlDoublePrivate>> ControlDoublePrivate::getAllInstances() {
     QList<QSharedPointer<ControlDoublePrivate>> result;
-    MMutexLocker locker(&s_qCOHashMutex);
+    MWriteLocker locker(&s_qCOHashLock);
     result.reserve(s_qCOHash.size());
-    for (auto it = s_qCOHash.begin(); it != s_qCOHash.end(); ++it) {
+    for (auto it = s_qCOHash.begin(); it != s_qCOHash.end();) {
         auto pControl = it.value().lock();
         if (pControl) {
             result.append(std::move(pControl));
+            ++it;
         } else {
             // The weak pointer has become invalid and can be cleaned up
-            s_qCOHash.erase(it);
+            it = s_qCOHash.erase(it);
         }
     }
     return result;
@@ -225,7 +265,7 @@ QList<QSharedPointer<ControlDoublePrivate>> ControlDoublePrivate::getAllInstance
 // static
 QList<QSharedPointer<ControlDoublePrivate>> ControlDoublePrivate::takeAllInstances() {
     QList<QSharedPointer<ControlDoublePrivate>> result;
-    MMutexLocker locker(&s_qCOHashMutex);
+    MWriteLocker locker(&s_qCOHashLock);
     result.reserve(s_qCOHash.size());
     for (auto it = s_qCOHash.begin(); it != s_qCOHash.end(); ++it) {
         auto pControl = it.value().lock();
@@ -276,8 +316,33 @@ void ControlDoublePrivate::setInner(double value, QObject* pSender) {
     if (m_bIgnoreNops && get() == value) {
         return;
     }
-    m_value.setValue(value);
+    m_pValueSlot->value.store(value, std::memory_order_release);
     emit valueChanged(value, pSender);
+    emitCoalescedValueChanged(value, pSender);
+
+    if (m_bTrack) {
+        Stat::track(m_trackKey, static_cast<Stat::StatType>(m_trackType),
+                    static_cast<Stat::ComputeFlags>(m_trackFlags), value);
+    }
+}
+
+void ControlDoublePrivate::emitCoalescedValueChanged(double value, QObject* pSender) {
+    if (m_coalescedSubscribers.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    if (isMainThread()) {
+        emit coalescedValueChanged(value, pSender);
+    } else {
+        // Delivered with the next GuiTick
+        ControlValueTable::markChanged(m_valueIndex);
+    }
+}
+
+void ControlDoublePrivate::notifyValueChanged() {
+    const double value = get();
+    // The setter is unknown
+    emit valueChanged(value, nullptr);
+    emitCoalescedValueChanged(value, nullptr);
 
     if (m_bTrack) {
         Stat::track(m_trackKey, static_cast<Stat::StatType>(m_trackType),
@@ -341,3 +406,49 @@ double ControlDoublePrivate::getMidiParameter() const {
     }
     return pBehavior->valueToMidiParameter(get());
 }
+
+void ControlDoublePrivate::addCoalescedSubscriber() {
+    if (m_coalescedSubscribers.fetch_add(1) == 0) {
+        const MMutexLocker locker(&s_coalescedControlsMutex);
+        s_coalescedControls.insert(m_valueIndex, this);
+    }
+}
+
+void ControlDoublePrivate::removeCoalescedSubscriber() {
+    const int previousSubscribers = m_coalescedSubscribers.fetch_sub(1);
+    DEBUG_ASSERT(previousSubscribers > 0);
+    Q_UNUSED(previousSubscribers);
+    // The control stays registered until it is deleted. This avoids a race
+    // with a concurrent addCoalescedSubscriber().
+}
+
+// static
+void ControlDoublePrivate::dispatchCoalescedValueChanges() {
+    DEBUG_ASSERT(isMainThread());
+    QVarLengthArray<int, 256> changedIndices;
+    ControlValueTable::takeChanged([&changedIndices](int index) {
+        changedIndices.append(index);
+    });
+    if (changedIndices.isEmpty()) {
+        return;
+    }
+    // Signals are emitted after releasing the lock, because the connected
+    // slots might create or delete other controls.
+    QVarLengthArray<QSharedPointer<ControlDoublePrivate>, 256> changedControls;
+    {
+        const MMutexLocker locker(&s_coalescedControlsMutex);
+        for (const int index : qAsConst(changedIndices)) {
+            ControlDoublePrivate* pControl = s_coalescedControls.value(index);
+            if (pControl) {
+                // Null if the control is currently being deleted
+                auto pStrongControl = pControl->sharedFromThis();
+                if (pStrongControl) {
+                    changedControls.append(std::move(pStrongControl));
+                }
+            }
+        }
+    }
+    for (const auto& pControl : qAsConst(changedControls)) {
+        emit pControl->coalescedValueChanged(pControl->get(), nullptr);
+    }
+}
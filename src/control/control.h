@@ -1,13 +1,16 @@
 #pragma once
 
 #include <QAtomicPointer>
+#include <QEnableSharedFromThis>
 #include <QHash>
 #include <QObject>
 #include <QSharedPointer>
 #include <QString>
+#include <atomic>
 
 #include "control/controlbehavior.h"
 #include "control/controlvalue.h"
+#include "control/controlvaluetable.h"
 #include "preferences/usersettings.h"
 #include "util/mutex.h"
 
@@ -29,7 +32,8 @@ enum class ControlFlag {
 Q_DECLARE_FLAGS(ControlFlags, ControlFlag)
 Q_DECLARE_OPERATORS_FOR_FLAGS(ControlFlags)
 
-class ControlDoublePrivate : public QObject {
+class ControlDoublePrivate : public QObject,
+                             public QEnableSharedFromThis<ControlDoublePrivate> {
     Q_OBJECT
   public:
     ~ControlDoublePrivate() override;
@@ -87,11 +91,30 @@ class ControlDoublePrivate : public QObject {
     void setAndConfirm(double value, QObject* pSender);
     // Gets the control value.
     double get() const {
-        return m_value.getValue();
+        return m_pValueSlot->value.load(std::memory_order_acquire);
     }
     // Resets the control value to its default.
     void reset();
 
+    // The storage of the control value, see RealtimeControl
+    ControlValueTable::Slot* valueSlot() const {
+        return m_pValueSlot;
+    }
+    // Emits valueChanged() for the current value after it has been
+    // changed through the value slot without notification.
+    void notifyValueChanged();
+
+    // Subscribers of coalescedValueChanged() must register themselves.
+    // Otherwise no coalesced notifications are delivered for changes from
+    // other threads.
+    void addCoalescedSubscriber();
+    void removeCoalescedSubscriber();
+
+    // Emits coalescedValueChanged() in the main thread for all controls
+    // that have been changed from other threads since the last invocation.
+    // Invoked once per GuiTick.
+    static void dispatchCoalescedValueChanges();
+
     // Set the behavior to be used when setting values and translating between
     // parameter and value space. Returns the previously set behavior (if any).
     // Callers must allocate the passed behavior using new and ownership to this
@@ -153,6 +176,11 @@ class ControlDoublePrivate : public QObject {
     // pointer to the setter of the value (potentially NULL).
     void valueChanged(double value, QObject* pSender);
     void valueChangeRequest(double value);
+    // Emitted in the main thread only. Changes from the main thread are
+    // forwarded immediately. Changes from other threads are collected and
+    // only the latest value is emitted once per GuiTick, see
+    // dispatchCoalescedValueChanges(). pSender is nullptr for those.
+    void coalescedValueChanged(double value, QObject* pSender);
 
   protected:
     ControlDoublePrivate();
@@ -172,6 +200,7 @@ class ControlDoublePrivate : public QObject {
 
     void initialize(double defaultValue);
     virtual void setInner(double value, QObject* pSender);
+    void emitCoalescedValueChanged(double value, QObject* pSender);
 
     const ConfigKey m_key;
 
@@ -198,8 +227,11 @@ class ControlDoublePrivate : public QObject {
     // User-visible, i18n description for what the control does.
     QString m_description;
 
-    // The control value.
-    ControlValueAtomic<double> m_value;
+    // The control value, owned by the ControlValueTable.
+    const int m_valueIndex;
+    ControlValueTable::Slot* const m_pValueSlot;
+    // The number of registered subscribers of coalescedValueChanged()
+    std::atomic<int> m_coalescedSubscribers;
     // The default control value.
     ControlValueAtomic<double> m_defaultValue;
 
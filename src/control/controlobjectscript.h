@@ -17,6 +17,12 @@ class ControlObjectScript : public ControlProxy {
 
     bool addScriptConnection(const ScriptConnection& conn);
 
+    /// The ControlObject owning the control, or nullptr if it has been
+    /// deleted. Unlike ControlObject::getControl() this needs no lookup.
+    ControlObject* getControlObject() const {
+        return m_pControl->getCreatorCO();
+    }
+
     bool removeScriptConnection(const ScriptConnection& conn);
 
     // Required for legacy behavior of ControllerEngine::connectControl
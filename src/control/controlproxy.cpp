@@ -1,5 +1,7 @@
 #include "control/controlproxy.h"
 
+#include <QCoreApplication>
+#include <QThread>
 #include <QtDebug>
 
 #include "control/control.h"
@@ -10,7 +12,8 @@ ControlProxy::ControlProxy(const QString& g, const QString& i, QObject* pParent,
 }
 
 ControlProxy::ControlProxy(const ConfigKey& key, QObject* pParent, ControlFlags flags)
-        : QObject(pParent) {
+        : QObject(pParent),
+          m_bCoalescedSubscriber(false) {
     m_pControl = ControlDoublePrivate::getControl(key, flags);
     if (!m_pControl) {
         DEBUG_ASSERT(flags & ControlFlag::AllowMissingOrInvalid);
@@ -21,6 +24,14 @@ ControlProxy::ControlProxy(const ConfigKey& key, QObject* pParent, ControlFlags
 
 ControlProxy::~ControlProxy() {
     //qDebug() << "ControlProxy::~ControlProxy()";
+    if (m_bCoalescedSubscriber) {
+        m_pControl->removeCoalescedSubscriber();
+    }
+}
+
+bool ControlProxy::livesInMainThread() const {
+    const auto* pApp = QCoreApplication::instance();
+    return pApp && thread() == pApp->thread();
 }
 
 const ConfigKey& ControlProxy::getKey() const {
@@ -84,6 +84,21 @@ class ControlProxy : public QObject {
         // throws a [-Wclazy-lambda-unique-connection] warning.
         switch (requestedConnectionType) {
         case Qt::AutoConnection:
+            if (livesInMainThread()) {
+                // Changes from other threads, e.g. the engine, are coalesced
+                // and delivered once per GuiTick instead of posting an event
+                // for each change.
+                if (connect(m_pControl.data(),
+                            &ControlDoublePrivate::coalescedValueChanged,
+                            this,
+                            &ControlProxy::slotValueChangedAuto,
+                            copConnection)) {
+                    DEBUG_ASSERT(!m_bCoalescedSubscriber);
+                    m_bCoalescedSubscriber = true;
+                    m_pControl->addCoalescedSubscriber();
+                }
+                break;
+            }
             connect(m_pControl.data(), &ControlDoublePrivate::valueChanged, this, &ControlProxy::slotValueChangedAuto, copConnection);
             break;
         case Qt::DirectConnection:
@@ -186,4 +201,10 @@ class ControlProxy : public QObject {
   protected:
     /// Pointer to connected control.
     QSharedPointer<ControlDoublePrivate> m_pControl;
+
+  private:
+    bool livesInMainThread() const;
+
+    /// Set if connected to ControlDoublePrivate::coalescedValueChanged()
+    bool m_bCoalescedSubscriber;
 };
@@ -2,7 +2,9 @@
 
 #include <QAtomicInt>
 #include <QObject>
+#include <atomic>
 #include <limits>
+#include <type_traits>
 
 #include "util/assert.h"
 #include "util/compatibility/qatomic.h"
@@ -120,48 +122,44 @@ class ControlValueAtomicBase {
     QAtomicInt m_writeIndex;
 };
 
-// Specialized template for types that are deemed to be atomic on the target
+// Specialized template for types that are lock-free atomic on the target
 // architecture. Instead of using a read/write ring to guarantee atomicity,
-// direct assignment/read of an aligned member variable is used.
-template <typename T>
-class ControlValueAtomicBase<T, true> {
+// the value is stored in a single std::atomic.
+template <typename T, int cRingSize>
+class ControlValueAtomicBase<T, cRingSize, true> {
   public:
     inline T getValue() const {
-        return m_value;
-    }
-
-    inline T getValueOnce() {
-        return std::move(m_value);
+        return m_value.load(std::memory_order_acquire);
     }
 
     inline void setValue(const T& value) {
-        m_value = value;
+        m_value.store(value, std::memory_order_release);
     }
 
   protected:
-    ControlValueAtomicBase() = default;
+    ControlValueAtomicBase()
+            : m_value(T()) {
+    }
 
   private:
-#if defined(__GNUC__)
-    T m_value __attribute__((aligned(sizeof(void*))));
-#elif defined(_MSC_VER)
-#ifdef _WIN64
-    T __declspec(align(8)) m_value;
-#else
-    T __declspec(align(4)) m_value;
-#endif
-#else
-    T m_value;
-#endif
+    std::atomic<T> m_value;
 };
 
-// ControlValueAtomic is a wrapper around ControlValueAtomicBase which uses the
-// sizeof(T) to determine which underlying implementation of
-// ControlValueAtomicBase to use. For types where sizeof(T) <= sizeof(void*),
-// the specialized implementation of ControlValueAtomicBase for types that are
-// atomic on the architecture is used.
+// Only trivially copyable types can be wrapped by std::atomic
+template <typename T, bool = std::is_trivially_copyable_v<T>>
+struct IsLockFreeAtomic : std::false_type {};
+
+template <typename T>
+struct IsLockFreeAtomic<T, true>
+        : std::bool_constant<std::atomic<T>::is_always_lock_free> {};
+
+// ControlValueAtomic is a wrapper around ControlValueAtomicBase which
+// determines which underlying implementation of ControlValueAtomicBase to use.
+// For types that are lock-free atomic on the architecture, the specialized
+// implementation of ControlValueAtomicBase is used.
 template <typename T, int cRingSize = kDefaultRingSize>
-class ControlValueAtomic : public ControlValueAtomicBase<T, cRingSize, sizeof(T) <= sizeof(void*)> {
+class ControlValueAtomic
+        : public ControlValueAtomicBase<T, cRingSize, IsLockFreeAtomic<T>::value> {
   public:
     ControlValueAtomic() = default;
 };
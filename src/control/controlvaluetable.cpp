@@ -0,0 +1,72 @@
+#include "control/controlvaluetable.h"
+
+#include <QVector>
+
+#include "util/assert.h"
+#include "util/mutex.h"
+
+namespace {
+
+/// Guards the allocation of slots and chunks
+MMutex s_mutex;
+
+/// Released slots that are reused before allocating new ones
+QVector<int> s_freeSlots GUARDED_BY(s_mutex);
+
+constexpr int kSharedOverflowSlot =
+        ControlValueTable::kMaxChunks * ControlValueTable::kSlotsPerChunk - 1;
+
+} // anonymous namespace
+
+// static
+std::array<std::atomic<ControlValueTable::Chunk*>, ControlValueTable::kMaxChunks>
+        ControlValueTable::s_chunks{};
+
+// static
+std::atomic<int> ControlValueTable::s_allocatedSlots{0};
+
+// static
+std::array<std::atomic<std::uint64_t>,
+        ControlValueTable::kMaxChunks * ControlValueTable::kSlotsPerChunk /
+                ControlValueTable::kBitsPerWord>
+        ControlValueTable::s_changedBits{};
+
+// static
+int ControlValueTable::allocate(double value) {
+    int index;
+    {
+        const MMutexLocker locker(&s_mutex);
+        if (!s_freeSlots.isEmpty()) {
+            index = s_freeSlots.takeLast();
+        } else {
+            // Only modified while the mutex is locked
+            index = s_allocatedSlots.load(std::memory_order_relaxed);
+            const int chunkIndex = index >> kSlotsPerChunkBits;
+            // Running out of slots is a programming error. All excess
+            // controls share the last slot to keep Mixxx running in
+            // release builds.
+            VERIFY_OR_DEBUG_ASSERT(chunkIndex < kMaxChunks) {
+                return kSharedOverflowSlot;
+            }
+            if ((index & (kSlotsPerChunk - 1)) == 0) {
+                // The chunks are intentionally leaked, because they
+                // might still be accessed during the shutdown.
+                s_chunks[chunkIndex].store(new Chunk(), std::memory_order_release);
+            }
+            s_allocatedSlots.store(index + 1, std::memory_order_release);
+        }
+    }
+    Slot& newSlot = slot(index);
+    newSlot.value.store(value, std::memory_order_relaxed);
+    newSlot.changed.store(false, std::memory_order_release);
+    return index;
+}
+
+// static
+void ControlValueTable::release(int index) {
+    if (index == kSharedOverflowSlot) {
+        return;
+    }
+    const MMutexLocker locker(&s_mutex);
+    s_freeSlots.append(index);
+}
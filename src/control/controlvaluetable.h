@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+/// Flat storage of the values of all controls.
+///
+/// Each value occupies its own cache line to avoid false sharing between
+/// the engine thread and other threads that access neighboring controls.
+/// Slots are allocated in chunks that are never moved or freed, i.e. a
+/// slot can be addressed by its index or by a pointer that is resolved
+/// once when the control is created.
+///
+/// Additionally the table contains a lock-free set of changed slots, that
+/// is used for coalescing change notifications, see
+/// ControlDoublePrivate::dispatchCoalescedValueChanges().
+class ControlValueTable final {
+  public:
+    static constexpr int kCacheLineSize = 64;
+
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<double> value;
+        // Set when the value has been changed without notifying the
+        // listeners of the control, see RealtimeControl.
+        std::atomic<bool> changed;
+    };
+
+    static constexpr int kSlotsPerChunkBits = 10;
+    static constexpr int kSlotsPerChunk = 1 << kSlotsPerChunkBits;
+    static constexpr int kMaxChunks = 256;
+
+    /// Allocates a slot and initializes it with value. Thread-safe but
+    /// not real-time safe.
+    static int allocate(double value);
+
+    /// Returns the slot to the pool of free slots. Thread-safe but not
+    /// real-time safe.
+    static void release(int index);
+
+    /// Real-time safe
+    static Slot& slot(int index) {
+        return s_chunks[index >> kSlotsPerChunkBits]
+                .load(std::memory_order_acquire)
+                ->slots[index & (kSlotsPerChunk - 1)];
+    }
+
+    /// Adds the slot to the set of changed slots. Real-time safe.
+    static void markChanged(int index) {
+        s_changedBits[index / kBitsPerWord].fetch_or(
+                std::uint64_t(1) << (index % kBitsPerWord),
+                std::memory_order_release);
+    }
+
+    /// Invokes callback(index) for each slot that has been marked as
+    /// changed since the last invocation and clears the set. Only a
+    /// single thread must take the changes.
+    template<typename Callback>
+    static void takeChanged(Callback callback) {
+        const int numWords = (s_allocatedSlots.load(std::memory_order_acquire) +
+                                     kBitsPerWord - 1) /
+                kBitsPerWord;
+        for (int word = 0; word < numWords; ++word) {
+            if (s_changedBits[word].load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            std::uint64_t bits = s_changedBits[word].exchange(0, std::memory_order_acquire);
+            while (bits != 0) {
+                const int bit = std::countr_zero(bits);
+                bits &= bits - 1;
+                callback(word * kBitsPerWord + bit);
+            }
+        }
+    }
+
+  private:
+    struct Chunk {
+        std::array<Slot, kSlotsPerChunk> slots;
+    };
+
+    static constexpr int kBitsPerWord = 64;
+
+    static std::array<std::atomic<Chunk*>, kMaxChunks> s_chunks;
+    // The number of slots that have ever been allocated
+    static std::atomic<int> s_allocatedSlots;
+    static std::array<std::atomic<std::uint64_t>,
+            kMaxChunks * kSlotsPerChunk / kBitsPerWord>
+            s_changedBits;
+};
@@ -0,0 +1,57 @@
+#include "control/realtimecontrol.h"
+
+#include <QVarLengthArray>
+#include <QVector>
+
+#include "util/assert.h"
+#include "util/mutex.h"
+
+namespace {
+
+/// Guards s_realtimeControls
+MMutex s_realtimeControlsMutex;
+
+/// All instances that might have pending notifications
+QVector<const RealtimeControl*> s_realtimeControls
+        GUARDED_BY(s_realtimeControlsMutex);
+
+QSharedPointer<ControlDoublePrivate> getControlOrDefault(const ConfigKey& key) {
+    auto pControl = ControlDoublePrivate::getControl(key);
+    VERIFY_OR_DEBUG_ASSERT(pControl) {
+        pControl = ControlDoublePrivate::getDefaultControl();
+    }
+    return pControl;
+}
+
+} // anonymous namespace
+
+RealtimeControl::RealtimeControl(const ConfigKey& key)
+        : m_pControl(getControlOrDefault(key)),
+          m_pSlot(m_pControl->valueSlot()) {
+    const MMutexLocker locker(&s_realtimeControlsMutex);
+    s_realtimeControls.append(this);
+}
+
+RealtimeControl::~RealtimeControl() {
+    const MMutexLocker locker(&s_realtimeControlsMutex);
+    s_realtimeControls.removeOne(this);
+}
+
+// static
+void RealtimeControl::notifyChangedControls() {
+    // Signals are emitted after releasing the lock, because the connected
+    // slots might create or destroy other real-time controls.
+    QVarLengthArray<QSharedPointer<ControlDoublePrivate>, 256> changedControls;
+    {
+        const MMutexLocker locker(&s_realtimeControlsMutex);
+        for (const RealtimeControl* pRealtimeControl : qAsConst(s_realtimeControls)) {
+            if (pRealtimeControl->m_pSlot->changed.exchange(
+                        false, std::memory_order_acq_rel)) {
+                changedControls.append(pRealtimeControl->m_pControl);
+            }
+        }
+    }
+    for (const auto& pControl : qAsConst(changedControls)) {
+        pControl->notifyValueChanged();
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QSharedPointer>
+
+#include "control/control.h"
+#include "control/controlvaluetable.h"
+
+/// Real-time access to the value of a control for the engine thread.
+///
+/// The value slot of the control is resolved once on construction. Reading
+/// and writing it afterwards is a single atomic operation without hashing,
+/// locking, allocating memory or emitting Qt signals. Instead, the listeners
+/// of the control are notified in batches by notifyChangedControls(), which
+/// is invoked from the main thread for each GuiTick. Intermediate values are
+/// coalesced, i.e. listeners only see the latest value of each tick.
+///
+/// set() bypasses the ControlNumericBehavior and change request handlers of
+/// the control. It must only be used for controls that are owned by the
+/// engine and are exclusively written by the engine, e.g. indicators or
+/// meters.
+class RealtimeControl final {
+  public:
+    /// Must be constructed in the main thread, i.e. not in the callback.
+    explicit RealtimeControl(const ConfigKey& key);
+    RealtimeControl(const QString& group, const QString& item)
+            : RealtimeControl(ConfigKey(group, item)) {
+    }
+    ~RealtimeControl();
+
+    RealtimeControl(const RealtimeControl&) = delete;
+    RealtimeControl& operator=(const RealtimeControl&) = delete;
+
+    double get() const {
+        return m_pSlot->value.load(std::memory_order_acquire);
+    }
+
+    bool toBool() const {
+        return get() > 0.0;
+    }
+
+    /// Sets the value and schedules a notification of all listeners if the
+    /// value has changed.
+    void set(double value) {
+        if (m_pSlot->value.load(std::memory_order_relaxed) == value) {
+            return;
+        }
+        m_pSlot->value.store(value, std::memory_order_release);
+        m_pSlot->changed.store(true, std::memory_order_release);
+    }
+
+    /// Emits the pending change notifications of all real-time controls.
+    /// Must be called from the main thread.
+    static void notifyChangedControls();
+
+  private:
+    // not null
+    const QSharedPointer<ControlDoublePrivate> m_pControl;
+    ControlValueTable::Slot* const m_pSlot;
+};
@@ -8,6 +8,15 @@
 #include "util/time.h"
 #include "util/trace.h"
 
+namespace {
+
+// Screen frames are sent from the renderer threads. Unlike sendBytes() they
+// must not block forever, so the renderers can be stopped if the device
+// stalls.
+constexpr unsigned int kScreenTransferTimeoutMillis = 1000;
+
+} // anonymous namespace
+
 BulkReader::BulkReader(libusb_device_handle *handle, unsigned char in_epaddr)
         : QThread(),
           m_phandle(handle),
@@ -183,6 +192,8 @@ int BulkController::open() {
         m_pReader->start(QThread::HighPriority);
     }
 
+    startScreenRenderers();
+
     return 0;
 }
 
@@ -194,6 +205,8 @@ int BulkController::close() {
 
     qCInfo(m_logBase) << "Shutting down USB Bulk device" << getName();
 
+    stopScreenRenderers();
+
     // Stop the reading thread
     if (m_pReader == nullptr) {
         qCWarning(m_logBase) << "BulkReader not present for" << getName()
@@ -245,3 +258,48 @@ void BulkController::sendBytes(const QByteArray& data) {
                              << "serial #" << m_sUID;
     }
 }
+
+void BulkController::startScreenRenderers() {
+    VERIFY_OR_DEBUG_ASSERT(m_screenRenderers.empty()) {
+        return;
+    }
+    if (!m_pMapping) {
+        return;
+    }
+    for (const auto& screen : m_pMapping->getScreens()) {
+        qCInfo(m_logBase) << "Rendering screen" << screen.identifier << "with"
+                          << screen.size << "pixels at" << screen.targetFps << "fps";
+        auto pRenderer = std::make_unique<ControllerScreenRenderer>(screen,
+                [this](const QByteArray& packet) {
+                    sendScreenData(packet);
+                });
+        pRenderer->setObjectName(QStringLiteral("ControllerScreenRenderer %1 %2")
+                                         .arg(getName(), screen.identifier));
+        pRenderer->start();
+        m_screenRenderers.push_back(std::move(pRenderer));
+    }
+}
+
+void BulkController::stopScreenRenderers() {
+    for (const auto& pRenderer : m_screenRenderers) {
+        pRenderer->stop();
+    }
+    for (const auto& pRenderer : m_screenRenderers) {
+        pRenderer->wait();
+    }
+    m_screenRenderers.clear();
+}
+
+void BulkController::sendScreenData(const QByteArray& data) {
+    int transferred;
+    const int ret = libusb_bulk_transfer(m_phandle,
+            out_epaddr,
+            reinterpret_cast<unsigned char*>(const_cast<char*>(data.constData())),
+            data.size(),
+            &transferred,
+            kScreenTransferTimeoutMillis);
+    if (ret < 0) {
+        qCWarning(m_logOutput) << "Unable to send screen data to" << getName()
+                               << "serial #" << m_sUID << ":" << libusb_error_name(ret);
+    }
+}
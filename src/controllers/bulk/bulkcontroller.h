@@ -2,10 +2,13 @@
 
 #include <QAtomicInt>
 #include <QThread>
+#include <memory>
+#include <vector>
 
 #include "controllers/controller.h"
 #include "controllers/hid/legacyhidcontrollermapping.h"
 #include "controllers/hid/legacyhidcontrollermappingfilehandler.h"
+#include "controllers/rendering/controllerscreenrenderer.h"
 #include "util/duration.h"
 
 struct libusb_device_handle;
@@ -70,6 +73,11 @@ class BulkController : public Controller {
 
     bool matchProductInfo(const ProductInfo& product);
 
+    void startScreenRenderers();
+    void stopScreenRenderers();
+    /// Called from the renderer threads
+    void sendScreenData(const QByteArray& data);
+
     libusb_context* m_context;
     libusb_device_handle *m_phandle;
 
@@ -85,4 +93,5 @@ class BulkController : public Controller {
     QString m_sUID;
     BulkReader* m_pReader;
     std::shared_ptr<LegacyHidControllerMapping> m_pMapping;
+    std::vector<std::unique_ptr<ControllerScreenRenderer>> m_screenRenderers;
 };
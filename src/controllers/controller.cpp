@@ -25,7 +25,8 @@ Controller::Controller(const QString& deviceName)
           m_bIsOutputDevice(false),
           m_bIsInputDevice(false),
           m_bIsOpen(false),
-          m_bLearning(false) {
+          m_bLearning(false),
+          m_bDispatchingInput(false) {
     m_userActivityInhibitTimer.start();
 }
 
@@ -63,6 +64,9 @@ bool Controller::applyMapping() {
 
     const std::shared_ptr<LegacyControllerMapping> pMapping = cloneMapping();
 
+    // The slow callbacks of the previous mapping are meaningless now
+    m_scriptProfiler.reset();
+
     // Load the script code into the engine
     if (!m_pScriptEngineLegacy) {
         qCWarning(m_logBase) << "Controller::applyMapping(): No engine exists!";
@@ -81,6 +85,18 @@ bool Controller::applyMapping() {
     return m_pScriptEngineLegacy->initialize();
 }
 
+void Controller::dispatchPendingInput() {
+    // Event driven devices post their input from an IO thread. The event loop
+    // delivers posted events before firing timers, so only the input of
+    // polling devices could wait behind timer and output work.
+    if (!isOpen() || !isPolling() || m_bDispatchingInput) {
+        return;
+    }
+    m_bDispatchingInput = true;
+    poll();
+    m_bDispatchingInput = false;
+}
+
 void Controller::startLearning() {
     qCDebug(m_logBase) << m_sDeviceName << "started learning";
     m_bLearning = true;
@@ -7,6 +7,7 @@
 #include "controllers/controllermappinginfo.h"
 #include "controllers/legacycontrollermapping.h"
 #include "controllers/legacycontrollermappingfilehandler.h"
+#include "controllers/scripting/controllerscriptprofiler.h"
 #include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
 #include "util/duration.h"
 #include "util/runtimeloggingcategory.h"
@@ -59,6 +60,17 @@ class Controller : public QObject {
 
     virtual bool matchMapping(const MappingInfo& mapping) = 0;
 
+    /// The script callbacks of the current mapping that exceeded the latency
+    /// budget. Reading the slow callbacks is thread-safe.
+    ControllerScriptProfiler* scriptProfiler() {
+        return &m_scriptProfiler;
+    }
+
+    /// Handles the input a polling device has pending, so it is processed
+    /// before timer and output work. Must be called from the controller
+    /// thread, but not from within input processing.
+    void dispatchPendingInput();
+
   signals:
     /// Emitted when the controller is opened or closed.
     void openChanged(bool bOpen);
@@ -166,13 +178,16 @@ class Controller : public QObject {
     // Indicates whether or not the device has been opened for input/output.
     bool m_bIsOpen;
     bool m_bLearning;
+    bool m_bDispatchingInput;
     QElapsedTimer m_userActivityInhibitTimer;
+    ControllerScriptProfiler m_scriptProfiler;
 
     friend class ControllerJSProxy;
     // accesses lots of our stuff, but in the same thread
     friend class ControllerManager;
     // For testing
     friend class LegacyControllerMappingValidationTest;
+    friend class ControllerMappingBenchmark;
 };
 
 // An object of this class gets exposed to the JS engine, so the methods of this class
@@ -35,6 +35,10 @@ const mixxx::Duration ControllerManager::kPollInterval = mixxx::Duration::fromMi
 #endif
 
 namespace {
+
+const QString kUserMappingIndexFileName = QStringLiteral("controller_mappings_user.cache");
+const QString kSystemMappingIndexFileName = QStringLiteral("controller_mappings_system.cache");
+
 /// Strip slashes and spaces from device name, so that it can be used as config
 /// key or a filename.
 QString sanitizeDeviceName(QString name) {
@@ -139,10 +143,15 @@ void ControllerManager::slotInitialize() {
 
     // Initialize mapping info parsers. This object is only for use in the main
     // thread. Do not touch it from within ControllerManager.
+    // The parsed headers of the mappings are indexed in the settings
+    // directory, so only new or changed mapping files are parsed.
+    const QDir settingsDir(m_pConfig->getSettingsPath());
     m_pMainThreadUserMappingEnumerator = QSharedPointer<MappingInfoEnumerator>(
-            new MappingInfoEnumerator(userMappingsPath(m_pConfig)));
+            new MappingInfoEnumerator(userMappingsPath(m_pConfig),
+                    settingsDir.filePath(kUserMappingIndexFileName)));
     m_pMainThreadSystemMappingEnumerator = QSharedPointer<MappingInfoEnumerator>(
-            new MappingInfoEnumerator(resourceMappingsPath(m_pConfig)));
+            new MappingInfoEnumerator(resourceMappingsPath(m_pConfig),
+                    settingsDir.filePath(kSystemMappingIndexFileName)));
 
     // Instantiate all enumerators. Enumerators can take a long time to
     // construct since they interact with host MIDI APIs.
@@ -89,6 +89,56 @@ MappingInfo::MappingInfo(const QString& mapping_path)
     }
 }
 
+void MappingInfo::write(QDataStream* pStream) const {
+    *pStream << m_valid
+             << m_path
+             << m_dirPath
+             << m_name
+             << m_author
+             << m_description
+             << m_forumlink
+             << m_wikilink
+             << static_cast<qint32>(m_products.size());
+    for (const auto& product : m_products) {
+        *pStream << product.protocol
+                 << product.vendor_id
+                 << product.product_id
+                 << product.in_epaddr
+                 << product.out_epaddr
+                 << product.usage_page
+                 << product.usage
+                 << product.interface_number;
+    }
+}
+
+// static
+MappingInfo MappingInfo::read(QDataStream* pStream) {
+    MappingInfo info;
+    qint32 productCount = 0;
+    *pStream >> info.m_valid
+            >> info.m_path
+            >> info.m_dirPath
+            >> info.m_name
+            >> info.m_author
+            >> info.m_description
+            >> info.m_forumlink
+            >> info.m_wikilink
+            >> productCount;
+    for (qint32 i = 0; i < productCount && pStream->status() == QDataStream::Ok; ++i) {
+        ProductInfo product;
+        *pStream >> product.protocol
+                >> product.vendor_id
+                >> product.product_id
+                >> product.in_epaddr
+                >> product.out_epaddr
+                >> product.usage_page
+                >> product.usage
+                >> product.interface_number;
+        info.m_products.append(product);
+    }
+    return info;
+}
+
 ProductInfo MappingInfo::parseBulkProduct(const QDomElement& element) const {
     // <product protocol="bulk" vendor_id="0x06f8" product_id="0x0b105" in_epaddr="0x82" out_epaddr="0x03">
     ProductInfo product;
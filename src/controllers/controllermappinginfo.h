@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QDataStream>
 #include <QDomElement>
 #include <QFileInfo>
 #include <QList>
@@ -65,6 +66,10 @@ class MappingInfo {
         return m_products;
     }
 
+    /// Serializes the parsed header for the index of MappingInfoEnumerator
+    void write(QDataStream* pStream) const;
+    static MappingInfo read(QDataStream* pStream);
+
   private:
     ProductInfo parseBulkProduct(const QDomElement& element) const;
     ProductInfo parseHIDProduct(const QDomElement& element) const;
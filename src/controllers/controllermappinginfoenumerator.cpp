@@ -1,10 +1,19 @@
 #include "controllers/controllermappinginfoenumerator.h"
 
+#include <QDataStream>
 #include <QDirIterator>
+#include <QFile>
+#include <QSaveFile>
+#include <QSet>
 
 #include "controllers/defs_controllers.h"
 
 namespace {
+
+// Must be incremented when changing the serialized fields
+constexpr qint32 kIndexVersion = 1;
+constexpr QDataStream::Version kIndexStreamVersion = QDataStream::Qt_5_12;
+
 bool mappingInfoNameComparator(const MappingInfo& a, const MappingInfo& b) {
     if (a.getDirPath() == b.getDirPath()) {
         // FIXME: Mixxx copies every loaded mapping into the user mapping folder
@@ -23,12 +32,17 @@ bool mappingInfoNameComparator(const MappingInfo& a, const MappingInfo& b) {
 }
 } // namespace
 
-MappingInfoEnumerator::MappingInfoEnumerator(const QString& searchPath)
-        : MappingInfoEnumerator(QList<QString>{searchPath}) {
+MappingInfoEnumerator::MappingInfoEnumerator(
+        const QString& searchPath, const QString& indexFilePath)
+        : MappingInfoEnumerator(QList<QString>{searchPath}, indexFilePath) {
 }
 
-MappingInfoEnumerator::MappingInfoEnumerator(const QStringList& searchPaths)
-        : m_controllerDirPaths(searchPaths) {
+MappingInfoEnumerator::MappingInfoEnumerator(
+        const QStringList& searchPaths, const QString& indexFilePath)
+        : m_controllerDirPaths(searchPaths),
+          m_indexFilePath(indexFilePath),
+          m_indexModified(false) {
+    loadIndex();
     loadSupportedMappings();
 }
 
@@ -50,21 +64,39 @@ void MappingInfoEnumerator::loadSupportedMappings() {
     m_hidMappings.clear();
     m_bulkMappings.clear();
 
+    QSet<QString> enumeratedPaths;
     for (const QString& dirPath : qAsConst(m_controllerDirPaths)) {
         QDirIterator it(dirPath);
         while (it.hasNext()) {
             it.next();
             const QString path = it.filePath();
 
+            QList<MappingInfo>* pMappings = nullptr;
             if (path.endsWith(MIDI_MAPPING_EXTENSION, Qt::CaseInsensitive)) {
-                m_midiMappings.append(MappingInfo(path));
+                pMappings = &m_midiMappings;
             } else if (path.endsWith(HID_MAPPING_EXTENSION, Qt::CaseInsensitive)) {
-                m_hidMappings.append(MappingInfo(path));
+                pMappings = &m_hidMappings;
             } else if (path.endsWith(BULK_MAPPING_EXTENSION, Qt::CaseInsensitive)) {
-                m_bulkMappings.append(MappingInfo(path));
+                pMappings = &m_bulkMappings;
+            } else {
+                continue;
             }
+            const MappingInfo info = indexedMappingInfo(it.fileInfo());
+            enumeratedPaths.insert(info.getPath());
+            pMappings->append(info);
+        }
+    }
+
+    // Forget deleted mappings
+    for (auto i = m_index.begin(); i != m_index.end();) {
+        if (enumeratedPaths.contains(i.key())) {
+            ++i;
+        } else {
+            i = m_index.erase(i);
+            m_indexModified = true;
         }
     }
+    saveIndex();
 
     std::sort(m_midiMappings.begin(), m_midiMappings.end(), mappingInfoNameComparator);
     std::sort(m_hidMappings.begin(), m_hidMappings.end(), mappingInfoNameComparator);
@@ -77,3 +109,73 @@ void MappingInfoEnumerator::loadSupportedMappings() {
     qDebug() << "Extension" << BULK_MAPPING_EXTENSION << "total"
              << m_bulkMappings.length() << "mappings";
 }
+
+MappingInfo MappingInfoEnumerator::indexedMappingInfo(const QFileInfo& fileInfo) {
+    const QString path = fileInfo.absoluteFilePath();
+    const QDateTime fileLastModified = fileInfo.lastModified();
+    const qint64 fileSize = fileInfo.size();
+    const auto indexed = m_index.constFind(path);
+    if (indexed != m_index.constEnd() &&
+            indexed->fileLastModified == fileLastModified &&
+            indexed->fileSize == fileSize) {
+        return indexed->info;
+    }
+    const MappingInfo info(path);
+    if (!m_indexFilePath.isEmpty()) {
+        m_index.insert(path, IndexEntry{fileLastModified, fileSize, info});
+        m_indexModified = true;
+    }
+    return info;
+}
+
+void MappingInfoEnumerator::loadIndex() {
+    if (m_indexFilePath.isEmpty()) {
+        return;
+    }
+    QFile file(m_indexFilePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(kIndexStreamVersion);
+    qint32 version = 0;
+    qint32 count = 0;
+    stream >> version >> count;
+    if (version != kIndexVersion) {
+        qInfo() << "Discarding controller mapping index with version" << version;
+        return;
+    }
+    m_index.reserve(count);
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        IndexEntry entry;
+        stream >> entry.fileLastModified >> entry.fileSize;
+        entry.info = MappingInfo::read(&stream);
+        m_index.insert(entry.info.getPath(), entry);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Failed to read controller mapping index" << file.fileName();
+        m_index.clear();
+    }
+}
+
+void MappingInfoEnumerator::saveIndex() {
+    if (!m_indexModified) {
+        return;
+    }
+    m_indexModified = false;
+    QSaveFile file(m_indexFilePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write controller mapping index" << file.fileName();
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(kIndexStreamVersion);
+    stream << kIndexVersion << static_cast<qint32>(m_index.size());
+    for (const auto& entry : qAsConst(m_index)) {
+        stream << entry.fileLastModified << entry.fileSize;
+        entry.info.write(&stream);
+    }
+    if (!file.commit()) {
+        qWarning() << "Failed to write controller mapping index" << file.fileName();
+    }
+}
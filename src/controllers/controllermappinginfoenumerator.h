@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QDateTime>
+#include <QHash>
 #include <QList>
 #include <QString>
 #include <QStringList>
@@ -7,19 +9,40 @@
 #include "controllers/controllermappinginfo.h"
 
 /// Enumerate list of available controller mapping mappings
+///
+/// Parsing the XML of the several hundred bundled mappings is slow. If an
+/// index file is given, the parsed headers are stored there together with
+/// the modification time and size of the mapping files. Only new or changed
+/// files are parsed again.
 class MappingInfoEnumerator {
   public:
-    MappingInfoEnumerator(const QString& searchPath);
-    MappingInfoEnumerator(const QStringList& searchPaths);
+    MappingInfoEnumerator(const QString& searchPath,
+            const QString& indexFilePath = QString());
+    MappingInfoEnumerator(const QStringList& searchPaths,
+            const QString& indexFilePath = QString());
 
     // Return cached list of mappings for this extension
     QList<MappingInfo> getMappingsByExtension(const QString& extension);
     void loadSupportedMappings();
 
   private:
+    struct IndexEntry {
+        QDateTime fileLastModified;
+        qint64 fileSize;
+        MappingInfo info;
+    };
+
+    MappingInfo indexedMappingInfo(const QFileInfo& fileInfo);
+    void loadIndex();
+    void saveIndex();
+
     // List of paths for controller mappings
     QList<QString> m_controllerDirPaths;
 
+    const QString m_indexFilePath;
+    QHash<QString, IndexEntry> m_index;
+    bool m_indexModified;
+
     QList<MappingInfo> m_hidMappings;
     QList<MappingInfo> m_midiMappings;
     QList<MappingInfo> m_bulkMappings;
@@ -1400,11 +1400,30 @@ void ControlPickerMenu::addSingleControl(const QString& group,
         controlIndex = addAvailableControl(ConfigKey(group, control), prefixedTitle, prefixedDescription);
     }
 
-    auto pAction = make_parented<QAction>(actionTitle.isEmpty() ? title : actionTitle, pMenu);
-    connect(pAction, &QAction::triggered, this, [this, controlIndex] {
-        controlChosen(controlIndex);
-    });
-    pMenu->addAction(pAction);
+    QList<PendingAction>& pendingActions = m_pendingActions[pMenu];
+    if (pendingActions.isEmpty()) {
+        connect(pMenu, &QMenu::aboutToShow, this, [this, pMenu] {
+            addPendingActions(pMenu);
+        });
+    }
+    // Submenus and separators may be added before the action is created
+    const int position = pMenu->actions().size() + pendingActions.size();
+    pendingActions.append(PendingAction{
+            actionTitle.isEmpty() ? title : actionTitle, controlIndex, position});
+}
+
+void ControlPickerMenu::addPendingActions(QMenu* pMenu) {
+    const QList<PendingAction> pendingActions = m_pendingActions.take(pMenu);
+    // All actions before the position of an action are already in the
+    // menu, because the positions are ascending
+    for (const auto& pendingAction : pendingActions) {
+        auto pAction = make_parented<QAction>(pendingAction.title, pMenu);
+        const int controlIndex = pendingAction.controlIndex;
+        connect(pAction, &QAction::triggered, this, [this, controlIndex] {
+            controlChosen(controlIndex);
+        });
+        pMenu->insertAction(pMenu->actions().value(pendingAction.position), pAction);
+    }
 }
 
 void ControlPickerMenu::addControl(const QString& group,
@@ -90,6 +90,8 @@ class ControlPickerMenu : public QMenu {
             bool addReset = false);
 
     int addAvailableControl(const ConfigKey& key, const QString& title, const QString& description);
+    // Creates the actions of pMenu right before it is shown for the first time
+    void addPendingActions(QMenu* pMenu);
 
     QString m_effectMasterOutputStr;
     QString m_effectHeadphoneOutputStr;
@@ -106,6 +108,17 @@ class ControlPickerMenu : public QMenu {
     QString m_buttonParameterStr;
     QString m_libraryStr;
 
+    // An action for the control at controlIndex in m_controlsAvailable,
+    // which is inserted at position into the actions of its menu
+    struct PendingAction {
+        QString title;
+        int controlIndex;
+        int position;
+    };
+    // Most menus are never shown, e.g. the menu of ControlDelegate is only
+    // used to look up descriptions
+    QHash<QMenu*, QList<PendingAction>> m_pendingActions;
+
     QList<ConfigKey> m_controlsAvailable;
     QHash<ConfigKey, QString> m_descriptionsByKey;
     QHash<ConfigKey, QString> m_titlesByKey;
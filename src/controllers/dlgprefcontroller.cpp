@@ -22,6 +22,9 @@
 namespace {
 const QString kMappingExt(".midi.xml");
 
+// The remaining slow script callbacks are summarized
+constexpr int kMaxSlowScriptCallbacks = 5;
+
 QString mappingNameToPath(const QString& directory, const QString& mappingName) {
     // While / is allowed for the display name we can't use it for the file name.
     QString fileName = QString(mappingName).replace(QChar('/'), QChar('-'));
@@ -468,6 +471,7 @@ void DlgPrefController::slotUpdate() {
     // checkbox if there is a valid mapping saved in the mixxx.cfg file. However, the
     // checkbox should only be checked if the device is currently enabled.
     m_ui.chkEnabledDevice->setChecked(m_pController->isOpen());
+    m_ui.labelSlowScriptCallbacks->setText(slowScriptCallbacks());
 
     // If the controller is not mappable, disable the input and output mapping
     // sections and the learning wizard button.
@@ -537,6 +541,32 @@ QUrl DlgPrefController::helpUrl() const {
     return QUrl(MIXXX_MANUAL_CONTROLLERS_URL);
 }
 
+QString DlgPrefController::slowScriptCallbacks() const {
+    const QList<ControllerScriptProfiler::SlowCallback> slowCallbacks =
+            m_pController->scriptProfiler()->slowCallbacks();
+    if (slowCallbacks.isEmpty()) {
+        return tr("None");
+    }
+
+    const qint64 budgetMillis = ControllerScriptProfiler::kLatencyBudget.toIntegerMillis();
+    QStringList lines;
+    for (const auto& slowCallback : slowCallbacks) {
+        if (lines.size() == kMaxSlowScriptCallbacks) {
+            lines << tr("and %1 more").arg(slowCallbacks.size() - kMaxSlowScriptCallbacks);
+            break;
+        }
+        const QString maxMillis =
+                QString::number(slowCallback.maxDuration.toDoubleMillis(), 'f', 1);
+        lines << tr("%1 (%2): up to %3 ms, %4 times over %5 ms")
+                         .arg(slowCallback.name.toHtmlEscaped(),
+                                 ControllerScriptProfiler::callbackTypeName(slowCallback.type),
+                                 maxMillis,
+                                 QString::number(slowCallback.count),
+                                 QString::number(budgetMillis));
+    }
+    return lines.join(QStringLiteral("<br/>"));
+}
+
 QString DlgPrefController::mappingPathFromIndex(int index) const {
     if (index == 0) {
         // "No Mapping" item
@@ -751,6 +781,7 @@ void DlgPrefController::slotShowMapping(std::shared_ptr<LegacyControllerMapping>
     m_ui.labelLoadedMappingAuthor->setText(mappingAuthor(pMapping));
     m_ui.labelLoadedMappingSupportLinks->setText(mappingSupportLinks(pMapping));
     m_ui.labelLoadedMappingScriptFileLinks->setText(mappingFileLinks(pMapping));
+    m_ui.labelSlowScriptCallbacks->setText(slowScriptCallbacks());
 
     // We mutate this mapping so keep a reference to it while we are using it.
     // TODO(rryan): Clone it? Technically a waste since nothing else uses this
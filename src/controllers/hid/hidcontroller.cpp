@@ -105,13 +105,15 @@ int HidController::open() {
 
     setOpen(true);
 
-    m_pHidIoThread = std::make_unique<HidIoThread>(pHidDevice, m_deviceInfo);
+    m_pHidIoThread = std::make_unique<HidIoThread>(pHidDevice,
+            m_deviceInfo,
+            m_pMapping ? m_pMapping->getInputReportFields() : QList<HidInputReportField>());
     m_pHidIoThread->setObjectName(QStringLiteral("HidIoThread ") + getName());
 
     connect(m_pHidIoThread.get(),
-            &HidIoThread::receive,
+            &HidIoThread::inputReportsReceived,
             this,
-            &HidController::receive,
+            &HidController::processReceivedInputReports,
             Qt::QueuedConnection);
 
     // Controller input needs to be prioritized since it can affect the
@@ -137,6 +139,21 @@ int HidController::open() {
     return 0;
 }
 
+void HidController::processReceivedInputReports() {
+    // Queued signals may arrive after closing the device
+    if (!m_pHidIoThread) {
+        return;
+    }
+    m_pHidIoThread->processReceivedInputReports(
+            [this](const unsigned char* pData, int size, mixxx::Duration timestamp) {
+                // Reuses the buffer of the previous report, unless the script
+                // still references it
+                m_inputReportData.resize(size);
+                memcpy(m_inputReportData.data(), pData, size);
+                receive(m_inputReportData, timestamp);
+            });
+}
+
 int HidController::close() {
     if (!isOpen()) {
         qCWarning(m_logBase) << "HID device" << getName() << "already closed";
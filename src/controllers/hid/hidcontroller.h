@@ -35,6 +35,7 @@ class HidController final : public Controller {
   private slots:
     int open() override;
     int close() override;
+    void processReceivedInputReports();
 
   private:
     // For devices which only support a single report, reportID must be set to
@@ -45,6 +46,7 @@ class HidController final : public Controller {
 
     std::unique_ptr<HidIoThread> m_pHidIoThread;
     std::shared_ptr<LegacyHidControllerMapping> m_pMapping;
+    QByteArray m_inputReportData;
 
     friend class HidControllerJSProxy;
 };
@@ -0,0 +1,64 @@
+#include "controllers/hid/hidioinputreportfilter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "util/assert.h"
+
+namespace {
+constexpr int kBitsPerByte = 8;
+} // namespace
+
+HidIoInputReportFilter::HidIoInputReportFilter(const QList<HidInputReportField>& fields)
+        : m_usesReportIds(false) {
+    for (const auto& field : fields) {
+        VERIFY_OR_DEBUG_ASSERT(field.offset >= 0 && field.size > 0 &&
+                field.size <= static_cast<int>(sizeof(field.mask))) {
+            continue;
+        }
+        if (field.reportId != 0) {
+            m_usesReportIds = true;
+        }
+        std::vector<unsigned char>& mask = m_reports[field.reportId].mask;
+        if (static_cast<int>(mask.size()) < field.offset + field.size) {
+            mask.resize(field.offset + field.size, 0);
+        }
+        for (int i = 0; i < field.size; ++i) {
+            mask[field.offset + i] |= static_cast<unsigned char>(
+                    field.mask >> (i * kBitsPerByte));
+        }
+    }
+}
+
+bool HidIoInputReportFilter::isChanged(const unsigned char* pData, int size) {
+    VERIFY_OR_DEBUG_ASSERT(size > 0) {
+        return false;
+    }
+    ReportState& report = m_reports[m_usesReportIds ? pData[0] : 0];
+    bool changed = !report.received || static_cast<int>(report.lastData.size()) != size;
+    if (!changed) {
+        if (report.mask.empty()) {
+            changed = memcmp(pData, report.lastData.data(), size) != 0;
+        } else {
+            const int maskSize = std::min(size, static_cast<int>(report.mask.size()));
+            for (int i = 0; i < maskSize; ++i) {
+                if ((pData[i] ^ report.lastData[i]) & report.mask[i]) {
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+    if (changed) {
+        // The capacity is kept, so this only allocates for the first report
+        report.lastData.assign(pData, pData + size);
+        report.received = true;
+    }
+    return changed;
+}
+
+void HidIoInputReportFilter::reset() {
+    for (auto& report : m_reports) {
+        report.received = false;
+    }
+}
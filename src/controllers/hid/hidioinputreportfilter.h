@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QList>
+#include <QtGlobal>
+#include <array>
+#include <vector>
+
+/// A field of a HID InputReport whose changes are relevant for the mapping,
+/// like the bits of a button or the bytes of a jog wheel counter.
+struct HidInputReportField {
+    /// 1...255 for HID devices that use ReportIDs - or 0 for devices, which
+    /// don't use ReportIDs
+    quint8 reportId = 0;
+    /// Byte offset in the report data as passed to the mapping, which starts
+    /// with the ReportID for devices that use ReportIDs
+    int offset = 0;
+    /// Size in bytes, 1...4
+    int size = 1;
+    /// Relevant bits of the little endian field value
+    quint32 mask = 0xFFFFFFFF;
+
+    friend bool operator==(const HidInputReportField& lhs, const HidInputReportField& rhs) {
+        return lhs.reportId == rhs.reportId &&
+                lhs.offset == rhs.offset &&
+                lhs.size == rhs.size &&
+                lhs.mask == rhs.mask;
+    }
+};
+
+/// HidIoInputReportFilter decides in the HidIoThread, which InputReports are
+/// passed to the mapping. Many controllers send their complete state
+/// continuously at the USB polling rate, even if nothing changed.
+///
+/// Without fields, a report is passed if it differs from the previous one,
+/// which assumes that all reports use the same ReportID or that the device
+/// doesn't use ReportIDs.
+/// With fields declared by the mapping, the last passed report is tracked for
+/// each ReportID and a report is only passed if one of its declared fields
+/// changed. Changes in other bytes, e.g. timers or sensor noise, are ignored.
+/// Reports with a ReportID without declared fields are passed, if any of
+/// their bytes changed.
+class HidIoInputReportFilter {
+  public:
+    explicit HidIoInputReportFilter(const QList<HidInputReportField>& fields = {});
+
+    /// Returns true if the report must be passed to the mapping, in which case
+    /// it becomes the last passed report of its ReportID.
+    bool isChanged(const unsigned char* pData, int size);
+
+    /// Forgets the last passed reports, so the next report of each ReportID
+    /// is passed.
+    void reset();
+
+  private:
+    struct ReportState {
+        /// Relevant bits of each byte, all bits are relevant if empty
+        std::vector<unsigned char> mask;
+        std::vector<unsigned char> lastData;
+        bool received = false;
+    };
+
+    static constexpr int kNumReportIds = 256;
+
+    std::array<ReportState, kNumReportIds> m_reports;
+    bool m_usesReportIds;
+};
@@ -38,6 +38,7 @@ void HidIoOutputReport::updateCachedData(const QByteArray& data,
 
     } else {
         if (m_possiblyUnsentDataCached) {
+            ++m_stats.supersededReports;
             qCDebug(logOutput) << "t:" << mixxx::Time::elapsed().formatMillisWithUnit()
                                << "Skipped superseded OutputReport"
                                << deviceInfo.formatName() << "serial #"
@@ -92,6 +93,7 @@ bool HidIoOutputReport::sendCachedData(QMutex* pHidDeviceAndPollMutex,
         // Setting m_possiblyUnsentDataCached to false prevents,
         // that the byte array compare operation is executed for the same data again
         m_possiblyUnsentDataCached = false;
+        ++m_stats.identicalReports;
 
         cacheLock.unlock();
 
@@ -146,6 +148,11 @@ bool HidIoOutputReport::sendCachedData(QMutex* pHidDeviceAndPollMutex,
         return true;
     }
 
+    cacheLock.relock();
+    ++m_stats.sentReports;
+    m_stats.sentBytes += result;
+    cacheLock.unlock();
+
     qCDebug(logOutput) << "t:" << startOfHidWrite.formatMillisWithUnit() << " "
                        << result << "bytes sent to" << deviceInfo.formatName()
                        << "serial #" << deviceInfo.serialNumber()
@@ -155,3 +162,8 @@ bool HidIoOutputReport::sendCachedData(QMutex* pHidDeviceAndPollMutex,
     // Return with true, to signal the caller, that the time consuming hid_write operation was executed
     return true;
 }
+
+HidIoOutputReport::Stats HidIoOutputReport::stats() {
+    auto cacheLock = lockMutex(&m_cachedDataMutex);
+    return m_stats;
+}
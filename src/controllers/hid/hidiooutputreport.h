@@ -7,6 +7,15 @@
 
 class HidIoOutputReport {
   public:
+    struct Stats {
+        qint64 sentReports = 0;
+        qint64 sentBytes = 0;
+        /// Reports not sent because they are identical to the last sent one
+        qint64 identicalReports = 0;
+        /// Reports replaced by newer data before they were sent
+        qint64 supersededReports = 0;
+    };
+
     HidIoOutputReport(const quint8& reportId, const unsigned int& reportDataSize);
 
     /// Caches new report data, which will later send by the IO thread
@@ -23,6 +32,8 @@ class HidIoOutputReport {
             const mixxx::hid::DeviceInfo& deviceInfo,
             const RuntimeLoggingCategory& logOutput);
 
+    Stats stats();
+
   private:
     const quint8 m_reportId;
     QByteArray m_lastSentData;
@@ -38,4 +49,7 @@ class HidIoOutputReport {
     /// Due to swapping of the QbyteArrays, we need to store
     /// this information independent of the QBytearray size
     int m_lastCachedDataSize;
+
+    /// Mutex must be locked when reading/writing
+    Stats m_stats;
 };
@@ -24,6 +24,10 @@ constexpr int kMaxHidErrorMessageSize = 512;
 // the fastest possible rate of HID devices with USB HighSpeed or USB SuperSpeed interface is 8kHz
 constexpr int kSleepTimeWhenIdleMicros = 250;
 
+// At the typical rate of 1 kHz this holds the InputReports of a quarter of a
+// second of controller thread stall
+constexpr int kInputReportRingSize = 256;
+
 QString loggingCategoryPrefix(const QString& deviceName) {
     return QStringLiteral("controller.") +
             RuntimeLoggingCategory::removeInvalidCharsFromCategory(deviceName.toLower());
@@ -31,7 +35,9 @@ QString loggingCategoryPrefix(const QString& deviceName) {
 } // namespace
 
 HidIoThread::HidIoThread(
-        hid_device* pHidDevice, const mixxx::hid::DeviceInfo& deviceInfo)
+        hid_device* pHidDevice,
+        const mixxx::hid::DeviceInfo& deviceInfo,
+        const QList<HidInputReportField>& inputReportFields)
         : QThread(),
           m_deviceInfo(deviceInfo),
           // Defining RuntimeLoggingCategories locally in this thread improves runtime performance significiantly
@@ -41,21 +47,52 @@ HidIoThread::HidIoThread(
           m_logOutput(loggingCategoryPrefix(deviceInfo.formatName()) +
                   QStringLiteral(".output")),
           m_pHidDevice(pHidDevice),
-          m_lastPollSize(0),
-          m_pollingBufferIndex(0),
+          m_inputReports(kInputReportRingSize),
+          m_inputReportFilter(inputReportFields),
+          m_readInputReports(0),
+          m_passedInputReports(0),
           m_runLoopSemaphore(1) {
-    // Initializing isn't strictly necessary but is good practice.
-    for (int i = 0; i < kNumBuffers; i++) {
-        memset(m_pPollData[i], 0, kBufferSize);
-    }
     m_outputReportIterator = m_outputReports.begin();
     m_state.storeRelease(static_cast<int>(HidIoThreadState::Initialized));
 }
 
 HidIoThread::~HidIoThread() {
+    logInputStats();
+    logOutputStats();
     hid_close(m_pHidDevice);
 }
 
+void HidIoThread::logInputStats() {
+    if (m_readInputReports == 0) {
+        return;
+    }
+    qCInfo(m_logInput) << m_deviceInfo.formatName() << "input:"
+                       << m_readInputReports << "InputReports read,"
+                       << m_passedInputReports << "passed to the mapping and"
+                       << m_readInputReports - m_passedInputReports
+                       << "unchanged ones skipped";
+}
+
+void HidIoThread::logOutputStats() {
+    HidIoOutputReport::Stats total;
+    for (const auto& [reportId, pReport] : m_outputReports) {
+        Q_UNUSED(reportId);
+        const HidIoOutputReport::Stats stats = pReport->stats();
+        total.sentReports += stats.sentReports;
+        total.sentBytes += stats.sentBytes;
+        total.identicalReports += stats.identicalReports;
+        total.supersededReports += stats.supersededReports;
+    }
+    if (total.sentReports == 0) {
+        return;
+    }
+    qCInfo(m_logOutput) << m_deviceInfo.formatName() << "output:"
+                        << total.sentReports << "OutputReports with"
+                        << total.sentBytes << "bytes sent,"
+                        << total.identicalReports << "identical and"
+                        << total.supersededReports << "superseded ones skipped";
+}
+
 void HidIoThread::run() {
     const QSemaphoreReleaser releaser(m_runLoopSemaphore);
     m_runLoopSemaphore.acquire();
@@ -97,8 +134,23 @@ void HidIoThread::pollBufferedInputReports() {
     // - windows(64 reports)
     // If the interval between two polls is to long, multiple buffered HID InputReports
     // will be processed at the same time.
+    // Some controllers such as the Gemini GMX continuously send input reports even if it
+    // is identical to the previous send input report. Running JS code for all these
+    // redundant reports would be a big performance problem, so only changed reports are
+    // committed to the ring, see HidIoInputReportFilter.
+    bool reportsAdded = false;
     while (m_state.loadAcquire() == static_cast<int>(HidIoThreadState::InputOutputActive)) {
-        int bytesRead = hid_read(m_pHidDevice, m_pPollData[m_pollingBufferIndex], kBufferSize);
+        InputReport* pReport;
+        ring_buffer_size_t size;
+        InputReport* pUnusedReport;
+        ring_buffer_size_t unusedSize;
+        if (m_inputReports.aquireWriteRegions(
+                    1, &pReport, &size, &pUnusedReport, &unusedSize) < 1) {
+            // The controller thread is behind. Leave the remaining reports in
+            // the hidapi ring buffer instead of dropping them here.
+            break;
+        }
+        int bytesRead = hid_read(m_pHidDevice, pReport->data, kBufferSize);
         if (bytesRead < 0) {
             // -1 is the only error value according to hidapi documentation.
             qCWarning(m_logOutput) << "Unable to read buffered HID InputReports from"
@@ -112,44 +164,31 @@ void HidIoThread::pollBufferedInputReports() {
             // No InputReports left to be read
             break;
         }
-        processInputReport(bytesRead);
+        m_readInputReports++;
+        if (!m_inputReportFilter.isChanged(pReport->data, bytesRead)) {
+            // The slot is reused for the next report
+            continue;
+        }
+        pReport->size = bytesRead;
+        pReport->timestampNanos = mixxx::Time::elapsed().toIntegerNanos();
+        m_inputReports.releaseWriteRegions(1);
+        m_passedInputReports++;
+        reportsAdded = true;
     }
-}
-
-void HidIoThread::processInputReport(int bytesRead) {
-    Trace process("HidIO processInputReport");
-    unsigned char* pPreviousBuffer = m_pPollData[(m_pollingBufferIndex + 1) % kNumBuffers];
-    unsigned char* pCurrentBuffer = m_pPollData[m_pollingBufferIndex];
-    // Some controllers such as the Gemini GMX continuously send input reports even if it
-    // is identical to the previous send input report. If this loop processed all those redundant
-    // input report, it would be a big performance problem to run JS code for every  input report and
-    // would be unnecessary.
-    // This assumes that the redundant input report all use the same report ID. In practice we
-    // have not encountered any controllers that send redundant input report with different report
-    // IDs. If any such devices exist, this may be changed to use a separate buffer to store
-    // the last input report for each report ID.
-    if (bytesRead == m_lastPollSize &&
-            memcmp(pCurrentBuffer, pPreviousBuffer, bytesRead) == 0) {
-        return;
+    // Only one queued signal is pending at a time, the controller thread
+    // processes all reports in the ring at once.
+    if (reportsAdded && m_inputReportsSignaled.testAndSetOrdered(0, 1)) {
+        emit inputReportsReceived();
     }
-    // Cycle between buffers so the memcmp above does not require deep copying to another buffer.
-    m_pollingBufferIndex = (m_pollingBufferIndex + 1) % kNumBuffers;
-    m_lastPollSize = bytesRead;
-
-    // Convert array of bytes read in a JavaScript compatible return type, this is emitted as deep-copy, for thread safety.
-    // This eexecute callback function in JavaScript mapping and print to stdout in case of --controllerDebug
-    emit receive(QByteArray(reinterpret_cast<const char*>(pCurrentBuffer),
-                         bytesRead),
-            mixxx::Time::elapsed());
 }
 
 QByteArray HidIoThread::getInputReport(quint8 reportID) {
     auto startOfHidGetInputReport = mixxx::Time::elapsed();
     auto hidDeviceLock = lockMutex(&m_hidDeviceAndPollMutex);
 
-    m_pPollData[m_pollingBufferIndex][0] = reportID;
-    int bytesRead = hid_get_input_report(
-            m_pHidDevice, m_pPollData[m_pollingBufferIndex], kBufferSize);
+    unsigned char dataRead[kBufferSize];
+    dataRead[0] = reportID;
+    int bytesRead = hid_get_input_report(m_pHidDevice, dataRead, kBufferSize);
     if (bytesRead <= kReportIdSize) {
         // -1 is the only error value according to hidapi documentation.
         // Otherwise minimum possible value is 1, because 1 byte is for the reportID,
@@ -167,7 +206,7 @@ QByteArray HidIoThread::getInputReport(quint8 reportID) {
 
     // Convert array of bytes read in a JavaScript compatible return type, this is returned as deep-copy, for thread safety.
     QByteArray returnArray = QByteArray(
-            reinterpret_cast<char*>(m_pPollData[m_pollingBufferIndex] + kReportIdSize),
+            reinterpret_cast<char*>(dataRead + kReportIdSize),
             bytesRead - kReportIdSize);
 
     hidDeviceLock.unlock();
@@ -7,9 +7,11 @@
 
 #include "controllers/controller.h"
 #include "controllers/hid/hiddevice.h"
+#include "controllers/hid/hidioinputreportfilter.h"
 #include "controllers/hid/hidiooutputreport.h"
 #include "util/compatibility/qmutex.h"
 #include "util/duration.h"
+#include "util/fifo.h"
 
 enum class HidIoThreadState {
     Initialized,
@@ -24,7 +26,8 @@ class HidIoThread : public QThread {
     Q_OBJECT
   public:
     HidIoThread(hid_device* pDevice,
-            const mixxx::hid::DeviceInfo& deviceInfo);
+            const mixxx::hid::DeviceInfo& deviceInfo,
+            const QList<HidInputReportField>& inputReportFields = {});
     ~HidIoThread() override;
 
     void run() override;
@@ -46,18 +49,42 @@ class HidIoThread : public QThread {
             const QByteArray& reportData,
             bool resendUnchangedReport);
     QByteArray getInputReport(quint8 reportID);
+
+    /// Passes the InputReports received since the last call in order to
+    /// receiveFunction(const unsigned char* pData, int size, mixxx::Duration timestamp).
+    /// The data points into the report ring and is only valid during the call.
+    /// Must only be called from the controller thread.
+    template<typename ReceiveFunction>
+    void processReceivedInputReports(ReceiveFunction receiveFunction) {
+        // Reset before reading, so reports added meanwhile are signaled again
+        m_inputReportsSignaled.storeRelease(0);
+        InputReport* pReport;
+        ring_buffer_size_t size;
+        InputReport* pUnusedReport;
+        ring_buffer_size_t unusedSize;
+        while (m_inputReports.aquireReadRegions(
+                       1, &pReport, &size, &pUnusedReport, &unusedSize) > 0) {
+            receiveFunction(pReport->data,
+                    pReport->size,
+                    mixxx::Duration::fromNanos(pReport->timestampNanos));
+            m_inputReports.releaseReadRegions(1);
+        }
+    }
     void sendFeatureReport(quint8 reportID, const QByteArray& reportData);
     QByteArray getFeatureReport(quint8 reportID);
 
   signals:
-    /// Signals that a HID InputReport received by Interrupt triggered from HID device
-    void receive(const QByteArray& data, mixxx::Duration timestamp);
+    /// Signals that changed HID InputReports are available for
+    /// processReceivedInputReports(). It is not emitted again until they
+    /// have been processed.
+    void inputReportsReceived();
 
   private:
     bool sendNextCachedOutputReport();
+    void logInputStats();
+    void logOutputStats();
 
     void pollBufferedInputReports();
-    void processInputReport(int bytesRead);
 
     const mixxx::hid::DeviceInfo m_deviceInfo;
     const RuntimeLoggingCategory m_logBase;
@@ -67,18 +94,31 @@ class HidIoThread : public QThread {
     /// This mutex must be locked for any hid device operation using the m_pHidDevice structure.
     /// If the hid_error functions is called after the hid device operation to get the error message,
     /// this mutex must not be unlocked before hid_error.
-    /// This mutex must be locked also, for access to m_pPollData, m_lastPollSize, m_pollingBufferIndex.
+    /// This mutex must be locked also, for writing to m_inputReports and access to
+    /// m_inputReportFilter.
     QMutex m_hidDeviceAndPollMutex;
 
     /// const pointer to the C data structure, which hidapi uses for communication between functions
     hid_device* const
             m_pHidDevice;
 
-    static constexpr int kNumBuffers = 2;
     static constexpr int kBufferSize = 255;
-    unsigned char m_pPollData[kNumBuffers][kBufferSize];
-    int m_lastPollSize;
-    int m_pollingBufferIndex;
+
+    struct InputReport {
+        int size;
+        qint64 timestampNanos;
+        unsigned char data[kBufferSize];
+    };
+
+    /// Preallocated ring of the InputReports to be processed by the
+    /// controller thread. hid_read writes directly into the next free slot,
+    /// which is only committed if the report passes m_inputReportFilter.
+    FIFO<InputReport> m_inputReports;
+    HidIoInputReportFilter m_inputReportFilter;
+    /// Set while an inputReportsReceived() signal is pending
+    QAtomicInt m_inputReportsSignaled;
+    qint64 m_readInputReports;
+    qint64 m_passedInputReports;
 
     /// Must be locked when a operation changes the size of the m_outputReports map,
     /// or when modify the m_outputReportIterator
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "controllers/hid/hidioinputreportfilter.h"
 #include "controllers/hid/legacyhidcontrollermappingfilehandler.h"
 #include "controllers/legacycontrollermapping.h"
+#include "controllers/rendering/controllerscreen.h"
 
 /// This class represents a HID or Bulk controller mapping, containing the data
 /// elements that make it up.
@@ -19,4 +21,29 @@ class LegacyHidControllerMapping : public LegacyControllerMapping {
     bool saveMapping(const QString& fileName) const override;
 
     bool isMappable() const override;
+
+    /// The InputReport fields whose changes are passed to the script. If
+    /// empty, all changes are passed.
+    const QList<HidInputReportField>& getInputReportFields() const {
+        return m_inputReportFields;
+    }
+
+    void addInputReportField(const HidInputReportField& field) {
+        m_inputReportFields.append(field);
+        setDirty(true);
+    }
+
+    /// The screens of the controller rendered natively, see ControllerScreen
+    const QList<ControllerScreen>& getScreens() const {
+        return m_screens;
+    }
+
+    void addScreen(const ControllerScreen& screen) {
+        m_screens.append(screen);
+        setDirty(true);
+    }
+
+  private:
+    QList<HidInputReportField> m_inputReportFields;
+    QList<ControllerScreen> m_screens;
 };
@@ -2,9 +2,61 @@
 
 #include "controllers/hid/legacyhidcontrollermapping.h"
 
+namespace {
+
+constexpr int kMaxReportSize = 255;
+constexpr int kMaxFieldSize = 4;
+
+QString formatHex(quint32 value) {
+    return QStringLiteral("0x") + QString::number(value, 16).toUpper();
+}
+
+int intAttribute(const QDomElement& element, const QString& name, int defaultValue) {
+    bool ok = false;
+    const int value = element.attribute(name).toInt(&ok, 0);
+    return ok ? value : defaultValue;
+}
+
+double doubleAttribute(const QDomElement& element, const QString& name, double defaultValue) {
+    bool ok = false;
+    const double value = element.attribute(name).toDouble(&ok);
+    return ok ? value : defaultValue;
+}
+
+QColor colorAttribute(const QDomElement& element, const QString& name, const QColor& defaultValue) {
+    const QColor color(element.attribute(name));
+    return color.isValid() ? color : defaultValue;
+}
+
+Qt::Alignment alignmentFromString(const QString& alignment) {
+    if (alignment == QLatin1String("left")) {
+        return Qt::AlignLeft | Qt::AlignVCenter;
+    } else if (alignment == QLatin1String("right")) {
+        return Qt::AlignRight | Qt::AlignVCenter;
+    }
+    return Qt::AlignCenter;
+}
+
+QString alignmentToString(Qt::Alignment alignment) {
+    if (alignment & Qt::AlignLeft) {
+        return QStringLiteral("left");
+    } else if (alignment & Qt::AlignRight) {
+        return QStringLiteral("right");
+    }
+    return QStringLiteral("center");
+}
+
+const QString kTextElement = QStringLiteral("text");
+const QString kBarElement = QStringLiteral("bar");
+const QString kIndicatorElement = QStringLiteral("indicator");
+
+} // anonymous namespace
+
 bool LegacyHidControllerMappingFileHandler::save(const LegacyHidControllerMapping& mapping,
         const QString& fileName) const {
     QDomDocument doc = buildRootWithScripts(mapping);
+    addInputReportsToDocument(mapping, &doc);
+    addScreensToDocument(mapping, &doc);
     return writeDocument(doc, fileName);
 }
 
@@ -25,5 +77,193 @@ LegacyHidControllerMappingFileHandler::load(const QDomElement& root,
     pMapping->setFilePath(filePath);
     parseMappingInfo(root, pMapping);
     addScriptFilesToMapping(controller, pMapping, systemMappingsPath);
+    addInputReportFieldsToMapping(controller, pMapping.get());
+    addScreensToMapping(controller, pMapping.get());
     return pMapping;
 }
+
+void LegacyHidControllerMappingFileHandler::addInputReportFieldsToMapping(
+        const QDomElement& controller, LegacyHidControllerMapping* pMapping) const {
+    QDomElement report = controller.firstChildElement("inputreports").firstChildElement("report");
+    while (!report.isNull()) {
+        bool ok = false;
+        // Allow specifying hex, octal, or decimal.
+        const uint reportId = report.attribute("id", "0").toUInt(&ok, 0);
+        if (!ok || reportId > 0xFF) {
+            qWarning() << "Ignoring HID InputReport with invalid id"
+                       << report.attribute("id");
+            report = report.nextSiblingElement("report");
+            continue;
+        }
+
+        QDomElement fieldNode = report.firstChildElement("field");
+        while (!fieldNode.isNull()) {
+            HidInputReportField field;
+            field.reportId = static_cast<quint8>(reportId);
+            bool offsetOk = false;
+            bool sizeOk = false;
+            bool maskOk = false;
+            field.offset = fieldNode.attribute("offset").toInt(&offsetOk, 0);
+            field.size = fieldNode.attribute("size", "1").toInt(&sizeOk, 0);
+            const QString mask = fieldNode.attribute("mask");
+            if (mask.isEmpty()) {
+                maskOk = true;
+            } else {
+                field.mask = mask.toUInt(&maskOk, 0);
+            }
+            if (offsetOk && sizeOk && maskOk &&
+                    field.offset >= 0 &&
+                    field.size > 0 && field.size <= kMaxFieldSize &&
+                    field.offset + field.size <= kMaxReportSize) {
+                pMapping->addInputReportField(field);
+            } else {
+                qWarning() << "Ignoring invalid field of HID InputReport"
+                           << formatHex(reportId) << "with offset"
+                           << fieldNode.attribute("offset") << "size"
+                           << fieldNode.attribute("size") << "mask" << mask;
+            }
+            fieldNode = fieldNode.nextSiblingElement("field");
+        }
+        report = report.nextSiblingElement("report");
+    }
+}
+
+void LegacyHidControllerMappingFileHandler::addInputReportsToDocument(
+        const LegacyHidControllerMapping& mapping, QDomDocument* doc) const {
+    if (mapping.getInputReportFields().isEmpty()) {
+        return;
+    }
+    QDomElement controller = doc->documentElement().firstChildElement("controller");
+    QDomElement inputReports = doc->createElement("inputreports");
+
+    // Fields are grouped by the report they have been declared in
+    QDomElement report;
+    for (const auto& field : mapping.getInputReportFields()) {
+        const QString reportId = formatHex(field.reportId);
+        if (report.isNull() || report.attribute("id") != reportId) {
+            report = doc->createElement("report");
+            report.setAttribute("id", reportId);
+            inputReports.appendChild(report);
+        }
+        QDomElement fieldNode = doc->createElement("field");
+        fieldNode.setAttribute("offset", field.offset);
+        fieldNode.setAttribute("size", field.size);
+        if (field.mask != HidInputReportField().mask) {
+            fieldNode.setAttribute("mask", formatHex(field.mask));
+        }
+        report.appendChild(fieldNode);
+    }
+    controller.appendChild(inputReports);
+}
+
+void LegacyHidControllerMappingFileHandler::addScreensToMapping(
+        const QDomElement& controller, LegacyHidControllerMapping* pMapping) const {
+    QDomElement screenNode = controller.firstChildElement("screens").firstChildElement("screen");
+    while (!screenNode.isNull()) {
+        ControllerScreen screen;
+        screen.identifier = screenNode.attribute("identifier");
+        screen.size = QSize(intAttribute(screenNode, "width", 0),
+                intAttribute(screenNode, "height", 0));
+        screen.targetFps = intAttribute(screenNode, "targetfps", screen.targetFps);
+        screen.tileSize = intAttribute(screenNode, "tilesize", screen.tileSize);
+        screen.bigEndian = screenNode.attribute("byteorder") == QLatin1String("big");
+        screen.tileHeader = QByteArray::fromHex(screenNode.attribute("tileheader").toLatin1());
+        screen.backgroundColor = colorAttribute(screenNode, "background", screen.backgroundColor);
+
+        QDomElement elementNode = screenNode.firstChildElement();
+        while (!elementNode.isNull()) {
+            ControllerScreen::Element element;
+            const QString type = elementNode.tagName();
+            if (type == kTextElement) {
+                element.type = ControllerScreen::Element::Type::Text;
+            } else if (type == kBarElement) {
+                element.type = ControllerScreen::Element::Type::Bar;
+            } else if (type == kIndicatorElement) {
+                element.type = ControllerScreen::Element::Type::Indicator;
+            } else {
+                qWarning() << "Ignoring unknown element" << type << "of controller screen"
+                           << screen.identifier;
+                elementNode = elementNode.nextSiblingElement();
+                continue;
+            }
+            element.rect = QRect(intAttribute(elementNode, "x", 0),
+                    intAttribute(elementNode, "y", 0),
+                    intAttribute(elementNode, "width", 0),
+                    intAttribute(elementNode, "height", 0));
+            element.key = ConfigKey(elementNode.attribute("group"), elementNode.attribute("key"));
+            element.color = colorAttribute(elementNode, "color", element.color);
+            element.offColor = colorAttribute(elementNode, "offcolor", element.offColor);
+            element.format = elementNode.attribute("format", element.format);
+            element.decimals = intAttribute(elementNode, "decimals", element.decimals);
+            element.fontPixelSize = intAttribute(elementNode, "size", element.fontPixelSize);
+            element.alignment = alignmentFromString(elementNode.attribute("align"));
+            element.minimum = doubleAttribute(elementNode, "min", element.minimum);
+            element.maximum = doubleAttribute(elementNode, "max", element.maximum);
+            screen.elements.append(element);
+            elementNode = elementNode.nextSiblingElement();
+        }
+
+        if (screen.isValid()) {
+            pMapping->addScreen(screen);
+        } else {
+            qWarning() << "Ignoring invalid controller screen" << screen.identifier;
+        }
+        screenNode = screenNode.nextSiblingElement("screen");
+    }
+}
+
+void LegacyHidControllerMappingFileHandler::addScreensToDocument(
+        const LegacyHidControllerMapping& mapping, QDomDocument* doc) const {
+    if (mapping.getScreens().isEmpty()) {
+        return;
+    }
+    QDomElement controller = doc->documentElement().firstChildElement("controller");
+    QDomElement screens = doc->createElement("screens");
+    for (const auto& screen : mapping.getScreens()) {
+        QDomElement screenNode = doc->createElement("screen");
+        screenNode.setAttribute("identifier", screen.identifier);
+        screenNode.setAttribute("width", screen.size.width());
+        screenNode.setAttribute("height", screen.size.height());
+        screenNode.setAttribute("targetfps", screen.targetFps);
+        screenNode.setAttribute("tilesize", screen.tileSize);
+        screenNode.setAttribute("byteorder",
+                screen.bigEndian ? QStringLiteral("big") : QStringLiteral("little"));
+        screenNode.setAttribute("tileheader", QString::fromLatin1(screen.tileHeader.toHex(' ')));
+        screenNode.setAttribute("background", screen.backgroundColor.name(QColor::HexArgb));
+        for (const auto& element : screen.elements) {
+            QString type;
+            switch (element.type) {
+            case ControllerScreen::Element::Type::Text:
+                type = kTextElement;
+                break;
+            case ControllerScreen::Element::Type::Bar:
+                type = kBarElement;
+                break;
+            case ControllerScreen::Element::Type::Indicator:
+                type = kIndicatorElement;
+                break;
+            }
+            QDomElement elementNode = doc->createElement(type);
+            elementNode.setAttribute("x", element.rect.x());
+            elementNode.setAttribute("y", element.rect.y());
+            elementNode.setAttribute("width", element.rect.width());
+            elementNode.setAttribute("height", element.rect.height());
+            elementNode.setAttribute("group", element.key.group);
+            elementNode.setAttribute("key", element.key.item);
+            elementNode.setAttribute("color", element.color.name(QColor::HexArgb));
+            elementNode.setAttribute("offcolor", element.offColor.name(QColor::HexArgb));
+            if (element.type == ControllerScreen::Element::Type::Text) {
+                elementNode.setAttribute("format", element.format);
+                elementNode.setAttribute("decimals", element.decimals);
+                elementNode.setAttribute("size", element.fontPixelSize);
+                elementNode.setAttribute("align", alignmentToString(element.alignment));
+            } else if (element.type == ControllerScreen::Element::Type::Bar) {
+                elementNode.setAttribute("min", element.minimum);
+                elementNode.setAttribute("max", element.maximum);
+            }
+            screenNode.appendChild(elementNode);
+        }
+        screens.appendChild(screenNode);
+    }
+    controller.appendChild(screens);
+}
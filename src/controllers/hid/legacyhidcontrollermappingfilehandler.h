@@ -15,4 +15,17 @@ class LegacyHidControllerMappingFileHandler : public LegacyControllerMappingFile
     virtual std::shared_ptr<LegacyControllerMapping> load(const QDomElement& root,
             const QString& filePath,
             const QDir& systemMappingsPath);
+
+    /// Parses the optional <inputreports> element, which declares the fields
+    /// of the InputReports whose changes are passed to the script
+    void addInputReportFieldsToMapping(const QDomElement& controller,
+            LegacyHidControllerMapping* pMapping) const;
+    void addInputReportsToDocument(const LegacyHidControllerMapping& mapping,
+            QDomDocument* doc) const;
+    /// Parses the optional <screens> element, which declares the natively
+    /// rendered screens of the controller
+    void addScreensToMapping(const QDomElement& controller,
+            LegacyHidControllerMapping* pMapping) const;
+    void addScreensToDocument(const LegacyHidControllerMapping& mapping,
+            QDomDocument* doc) const;
 };
@@ -48,31 +48,38 @@ bool KeyboardEventFilter::eventFilter(QObject*, QEvent* e) {
             }
         }
 
-        QKeySequence ks = getKeySeq(ke);
-        if (!ks.isEmpty()) {
-            ConfigValueKbd ksv(ks);
+        const int keyCombination = getKeyCombination(ke);
+        if (keyCombination != 0) {
+            if (CmdlineArgs::Instance().getDeveloper()) {
+                qDebug() << "keyboard press: " << QKeySequence(keyCombination).toString();
+            }
+            auto it = m_keyCombinationToControls.find(keyCombination);
+            if (it == m_keyCombinationToControls.end()) {
+                return false;
+            }
+            for (auto& mapping : it.value()) {
+                resolveControl(&mapping);
+            }
+            // Setting a value might replace the keyboard config, so iterate
+            // over an implicitly shared copy of the mappings.
+            const QVector<KeyMapping> mappings = it.value();
             // Check if a shortcut is defined
             bool result = false;
-            // using const_iterator here is faster than QMultiHash::values()
-            for (auto it = m_keySequenceToControlHash.constFind(ksv);
-                 it != m_keySequenceToControlHash.constEnd() && it.key() == ksv; ++it) {
-                const ConfigKey& configKey = it.value();
-                if (configKey.group != "[KeyboardShortcuts]") {
-                    ControlObject* control = ControlObject::getControl(configKey);
-                    if (control) {
-                        //qDebug() << configKey << "MidiOpCode::NoteOn" << 1;
-                        // Add key to active key list
-                        m_qActiveKeyList.append(KeyDownInformation(
+            for (const auto& mapping : mappings) {
+                ControlObject* control = mapping.pControl;
+                if (control) {
+                    //qDebug() << mapping.key << "MidiOpCode::NoteOn" << 1;
+                    // Add key to active key list
+                    m_qActiveKeyList.append(KeyDownInformation(
                             keyId, ke->modifiers(), control));
-                        // Since setting the value might cause us to go down
-                        // a route that would eventually clear the active
-                        // key list, do that last.
-                        control->setValueFromMidi(MidiOpCode::NoteOn, 1);
-                        result = true;
-                    } else {
-                        qDebug() << "Warning: Keyboard key is configured for nonexistent control:"
-                                 << configKey.group << configKey.item;
-                    }
+                    // Since setting the value might cause us to go down
+                    // a route that would eventually clear the active
+                    // key list, do that last.
+                    control->setValueFromMidi(MidiOpCode::NoteOn, 1);
+                    result = true;
+                } else {
+                    qDebug() << "Warning: Keyboard key is configured for nonexistent control:"
+                             << mapping.key.group << mapping.key.item;
                 }
             }
             return result;
@@ -126,41 +133,28 @@ bool KeyboardEventFilter::eventFilter(QObject*, QEvent* e) {
     return false;
 }
 
-QKeySequence KeyboardEventFilter::getKeySeq(QKeyEvent* e) {
-    QString modseq;
-    QKeySequence k;
-
-    // TODO(XXX) check if we may simply return QKeySequence(e->modifiers()+e->key())
-
-    if (e->modifiers() & Qt::ShiftModifier) {
-        modseq += "Shift+";
-    }
-
-    if (e->modifiers() & Qt::ControlModifier) {
-        modseq += "Ctrl+";
-    }
-
-    if (e->modifiers() & Qt::AltModifier) {
-        modseq += "Alt+";
-    }
-
-    if (e->modifiers() & Qt::MetaModifier) {
-        modseq += "Meta+";
-    }
-
-    if (e->key() >= 0x01000020 && e->key() <= 0x01000023) {
+// static
+int KeyboardEventFilter::getKeyCombination(QKeyEvent* e) {
+    if (e->key() >= Qt::Key_Shift && e->key() <= Qt::Key_Alt) {
         // Do not act on Modifier only
         // avoid returning "khmer vowel sign ie (U+17C0)"
-        return k;
+        return 0;
     }
+    // The keypad modifier is ignored like in the key sequences of the
+    // keyboard config
+    const int modifiers = static_cast<int>(e->modifiers() &
+            (Qt::ShiftModifier | Qt::ControlModifier | Qt::AltModifier |
+                    Qt::MetaModifier));
+    return e->key() | modifiers;
+}
 
-    QString keyseq = QKeySequence(e->key()).toString();
-    k = QKeySequence(modseq + keyseq);
-
-    if (CmdlineArgs::Instance().getDeveloper()) {
-        qDebug() << "keyboard press: " << k.toString();
+// static
+ControlObject* KeyboardEventFilter::resolveControl(KeyMapping* pMapping) {
+    if (!pMapping->pControl) {
+        pMapping->pControl = ControlObject::getControl(
+                pMapping->key, ControlFlag::NoWarnIfMissing);
     }
-    return k;
+    return pMapping->pControl;
 }
 
 void KeyboardEventFilter::setKeyboardConfig(ConfigObject<ConfigValueKbd>* pKbdConfigObject) {
@@ -168,7 +162,30 @@ void KeyboardEventFilter::setKeyboardConfig(ConfigObject<ConfigValueKbd>* pKbdCo
     // invert the mapping to create an injection from key sequence to
     // ConfigKey. This allows a key sequence to trigger multiple controls in
     // Mixxx.
-    m_keySequenceToControlHash = pKbdConfigObject->transpose();
+    // The key sequences are compiled into their key codes and the controls
+    // resolved once, so a key press only needs a single hash lookup.
+    const QMultiHash<ConfigValueKbd, ConfigKey> keySequenceToControlHash =
+            pKbdConfigObject->transpose();
+    m_keyCombinationToControls.clear();
+    for (auto it = keySequenceToControlHash.constBegin();
+            it != keySequenceToControlHash.constEnd();
+            ++it) {
+        if (it.value().group == QLatin1String("[KeyboardShortcuts]")) {
+            continue;
+        }
+        const QKeySequence keySequence(it.key().value);
+        // Only single key combinations can be triggered by a key press
+        if (keySequence.count() != 1) {
+            continue;
+        }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        const int keyCombination = keySequence[0].toCombined();
+#else
+        const int keyCombination = keySequence[0];
+#endif
+        m_keyCombinationToControls[keyCombination].append(KeyMapping{it.value(),
+                ControlObject::getControl(it.value(), ControlFlag::NoWarnIfMissing)});
+    }
     m_pKbdConfigObject = pKbdConfigObject;
 }
 
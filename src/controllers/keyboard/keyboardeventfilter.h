@@ -1,9 +1,11 @@
 #pragma once
 
-#include <QObject>
 #include <QEvent>
+#include <QHash>
 #include <QKeyEvent>
-#include <QMultiHash>
+#include <QObject>
+#include <QPointer>
+#include <QVector>
 
 #include "preferences/configobject.h"
 
@@ -37,12 +39,23 @@ class KeyboardEventFilter : public QObject {
         ControlObject* pControl;
     };
 
-    // Returns a valid QString with modifier keys from a QKeyEvent
-    QKeySequence getKeySeq(QKeyEvent *e);
+    struct KeyMapping {
+        ConfigKey key;
+        // Resolved when the mapping is loaded, or on the first key press if
+        // the control didn't exist yet then
+        QPointer<ControlObject> pControl;
+    };
+
+    // Returns the key code combined with the relevant modifiers of a key
+    // event, the same value as the first key of the mapped QKeySequence, or
+    // 0 if only a modifier key was pressed.
+    static int getKeyCombination(QKeyEvent* e);
+    static ControlObject* resolveControl(KeyMapping* pMapping);
     // List containing keys which is currently pressed
     QList<KeyDownInformation> m_qActiveKeyList;
     // Pointer to keyboard config object
     ConfigObject<ConfigValueKbd> *m_pKbdConfigObject;
-    // Multi-hash of key sequence to
-    QMultiHash<ConfigValueKbd, ConfigKey> m_keySequenceToControlHash;
+    // Combined key code and modifiers to the mapped controls, compiled from
+    // the keyboard config
+    QHash<int, QVector<KeyMapping>> m_keyCombinationToControls;
 };
@@ -0,0 +1,262 @@
+#include "controllers/midi/alsaseqmidiinput.h"
+
+#include <alsa/asoundlib.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <vector>
+
+#include "moc_alsaseqmidiinput.cpp"
+#include "util/assert.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/time.h"
+
+namespace {
+
+const mixxx::Logger kLogger("AlsaSeqMidiInput");
+
+// Same limit as the sysex buffer of PortMidiController
+constexpr int kMaxSysexSize = 1024;
+
+// The largest MIDI message without sysex
+constexpr int kMaxShortMessageSize = 3;
+
+constexpr unsigned char kStartOfExclusive = 0xF0;
+constexpr unsigned char kEndOfExclusive = 0xF7;
+
+} // anonymous namespace
+
+AlsaSeqMidiInput::AlsaSeqMidiInput(const QString& portName)
+        : m_portName(portName),
+          m_pSeq(nullptr),
+          m_pDecoder(nullptr),
+          m_port(-1),
+          m_queue(-1),
+          m_wakeFds{-1, -1},
+          m_quit(false) {
+    setObjectName(QStringLiteral("AlsaSeqMidiInput ") + portName);
+}
+
+AlsaSeqMidiInput::~AlsaSeqMidiInput() {
+    close();
+}
+
+bool AlsaSeqMidiInput::open() {
+    VERIFY_OR_DEBUG_ASSERT(!isOpen()) {
+        return false;
+    }
+
+    if (snd_seq_open(&m_pSeq, "default", SND_SEQ_OPEN_INPUT, SND_SEQ_NONBLOCK) < 0) {
+        kLogger.warning() << "Failed to open the ALSA sequencer";
+        m_pSeq = nullptr;
+        return false;
+    }
+    snd_seq_set_client_name(m_pSeq, "Mixxx");
+
+    int sourceClient = -1;
+    int sourcePort = -1;
+    if (!findSourcePort(&sourceClient, &sourcePort)) {
+        kLogger.info() << "No ALSA sequencer port" << m_portName;
+        closeSequencer();
+        return false;
+    }
+
+    const QByteArray portName = m_portName.toLocal8Bit();
+    m_port = snd_seq_create_simple_port(m_pSeq,
+            portName.constData(),
+            SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE,
+            SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+    m_queue = snd_seq_alloc_named_queue(m_pSeq, "Mixxx MIDI input");
+    if (m_port < 0 || m_queue < 0) {
+        kLogger.warning() << "Failed to create the ALSA sequencer port for" << m_portName;
+        closeSequencer();
+        return false;
+    }
+
+    // The events are timestamped by the queue in real time when they
+    // arrive at our port
+    snd_seq_addr_t sender;
+    sender.client = static_cast<unsigned char>(sourceClient);
+    sender.port = static_cast<unsigned char>(sourcePort);
+    snd_seq_addr_t dest;
+    dest.client = static_cast<unsigned char>(snd_seq_client_id(m_pSeq));
+    dest.port = static_cast<unsigned char>(m_port);
+    snd_seq_port_subscribe_t* pSubscription;
+    snd_seq_port_subscribe_alloca(&pSubscription);
+    snd_seq_port_subscribe_set_sender(pSubscription, &sender);
+    snd_seq_port_subscribe_set_dest(pSubscription, &dest);
+    snd_seq_port_subscribe_set_queue(pSubscription, m_queue);
+    snd_seq_port_subscribe_set_time_update(pSubscription, 1);
+    snd_seq_port_subscribe_set_time_real(pSubscription, 1);
+    if (snd_seq_subscribe_port(m_pSeq, pSubscription) < 0) {
+        kLogger.warning() << "Failed to subscribe to the ALSA sequencer port" << m_portName;
+        closeSequencer();
+        return false;
+    }
+    snd_seq_start_queue(m_pSeq, m_queue, nullptr);
+    snd_seq_drain_output(m_pSeq);
+    m_queueStartTime = mixxx::Time::elapsed();
+
+    if (snd_midi_event_new(kMaxShortMessageSize, &m_pDecoder) < 0) {
+        m_pDecoder = nullptr;
+        closeSequencer();
+        return false;
+    }
+    // Every message gets its status byte
+    snd_midi_event_no_status(m_pDecoder, 1);
+
+    if (::pipe(m_wakeFds) != 0) {
+        m_wakeFds[0] = -1;
+        m_wakeFds[1] = -1;
+        closeSequencer();
+        return false;
+    }
+
+    m_sysex.clear();
+    m_quit.store(false);
+    // Controller input needs to be prioritized since it can affect the
+    // audio directly, like when scratching
+    start(QThread::HighPriority);
+    kLogger.info() << "Reading" << m_portName << "from the ALSA sequencer";
+    return true;
+}
+
+void AlsaSeqMidiInput::close() {
+    if (isRunning()) {
+        m_quit.store(true);
+        const char wake = 0;
+        if (::write(m_wakeFds[1], &wake, 1) != 1) {
+            kLogger.warning() << "Failed to wake up" << objectName();
+        }
+        wait();
+    }
+    closeSequencer();
+}
+
+void AlsaSeqMidiInput::closeSequencer() {
+    if (m_pDecoder) {
+        snd_midi_event_free(m_pDecoder);
+        m_pDecoder = nullptr;
+    }
+    for (int& fd : m_wakeFds) {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    if (m_pSeq) {
+        // Also removes our port, the queue and the subscription
+        snd_seq_close(m_pSeq);
+        m_pSeq = nullptr;
+    }
+    m_port = -1;
+    m_queue = -1;
+}
+
+bool AlsaSeqMidiInput::findSourcePort(int* pClient, int* pPort) const {
+    // PortMidi names its devices after the sequencer ports. If several
+    // ports have the same name, the first one is used.
+    const QByteArray portName = m_portName.toLocal8Bit();
+    snd_seq_client_info_t* pClientInfo;
+    snd_seq_client_info_alloca(&pClientInfo);
+    snd_seq_port_info_t* pPortInfo;
+    snd_seq_port_info_alloca(&pPortInfo);
+    constexpr unsigned int kCapabilities = SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ;
+
+    snd_seq_client_info_set_client(pClientInfo, -1);
+    while (snd_seq_query_next_client(m_pSeq, pClientInfo) >= 0) {
+        const int client = snd_seq_client_info_get_client(pClientInfo);
+        snd_seq_port_info_set_client(pPortInfo, client);
+        snd_seq_port_info_set_port(pPortInfo, -1);
+        while (snd_seq_query_next_port(m_pSeq, pPortInfo) >= 0) {
+            if ((snd_seq_port_info_get_capability(pPortInfo) & kCapabilities) !=
+                    kCapabilities) {
+                continue;
+            }
+            if (portName == snd_seq_port_info_get_name(pPortInfo)) {
+                *pClient = client;
+                *pPort = snd_seq_port_info_get_port(pPortInfo);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void AlsaSeqMidiInput::run() {
+    const int numSeqFds = snd_seq_poll_descriptors_count(m_pSeq, POLLIN);
+    std::vector<pollfd> fds(numSeqFds + 1);
+    snd_seq_poll_descriptors(m_pSeq, fds.data(), numSeqFds, POLLIN);
+    fds[numSeqFds].fd = m_wakeFds[0];
+    fds[numSeqFds].events = POLLIN;
+    fds[numSeqFds].revents = 0;
+
+    while (!m_quit.load()) {
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            kLogger.warning() << "poll() failed, stopping" << objectName();
+            break;
+        }
+        if (fds[numSeqFds].revents & POLLIN) {
+            // Woken up by close()
+            break;
+        }
+        snd_seq_event_t* pEvent = nullptr;
+        while (true) {
+            const int result = snd_seq_event_input(m_pSeq, &pEvent);
+            if (result == -ENOSPC) {
+                kLogger.warning() << "Input overrun, MIDI events of"
+                                  << m_portName << "were lost";
+                continue;
+            }
+            if (result < 0) {
+                // -EAGAIN if all events were read
+                break;
+            }
+            processEvent(pEvent);
+        }
+    }
+}
+
+void AlsaSeqMidiInput::processEvent(const snd_seq_event_t* pEvent) {
+    const mixxx::Duration timestamp = m_queueStartTime +
+            mixxx::Duration::fromNanos(
+                    static_cast<qint64>(pEvent->time.time.tv_sec) * 1000000000 +
+                    pEvent->time.time.tv_nsec);
+
+    if (pEvent->type == SND_SEQ_EVENT_SYSEX) {
+        const auto* pData = static_cast<const unsigned char*>(pEvent->data.ext.ptr);
+        const int size = static_cast<int>(pEvent->data.ext.len);
+        if (size <= 0) {
+            return;
+        }
+        if (pData[0] == kStartOfExclusive) {
+            m_sysex.clear();
+        }
+        m_sysex.append(reinterpret_cast<const char*>(pData),
+                math_min(size, kMaxSysexSize - static_cast<int>(m_sysex.size())));
+        if (pData[size - 1] == kEndOfExclusive) {
+            emit receivedSysex(m_sysex, timestamp);
+            m_sysex.clear();
+        }
+        return;
+    }
+
+    unsigned char bytes[kMaxShortMessageSize] = {};
+    const long size = snd_midi_event_decode(m_pDecoder,
+            bytes,
+            kMaxShortMessageSize,
+            pEvent);
+    if (size <= 0) {
+        // Not a MIDI message, e.g. a notification of the sequencer
+        return;
+    }
+    emit receivedShortMessage(bytes[0],
+            size > 1 ? bytes[1] : 0,
+            size > 2 ? bytes[2] : 0,
+            timestamp);
+}
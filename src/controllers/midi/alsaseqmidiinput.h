@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QThread>
+#include <atomic>
+
+#include "util/duration.h"
+
+typedef struct _snd_seq snd_seq_t;
+typedef struct snd_midi_event snd_midi_event_t;
+typedef struct snd_seq_event snd_seq_event_t;
+
+/// Event-driven MIDI input from a port of the ALSA sequencer
+///
+/// The input of a PortMidiController is polled by the ControllerManager,
+/// which delays every message by up to one poll interval. This class
+/// subscribes to the same sequencer port and reads it on its own thread,
+/// which sleeps in poll() until an event arrives. The messages are
+/// signaled together with the time the sequencer received them, on the
+/// time base of mixxx::Time.
+class AlsaSeqMidiInput : public QThread {
+    Q_OBJECT
+  public:
+    explicit AlsaSeqMidiInput(const QString& portName);
+    ~AlsaSeqMidiInput() override;
+
+    /// Subscribes to the first readable port with the name and starts the
+    /// thread. Returns false if the port is not found or the sequencer is
+    /// not available, the caller polls the input with PortMidi instead.
+    bool open();
+    void close();
+
+    bool isOpen() const {
+        return m_pSeq != nullptr;
+    }
+
+  signals:
+    void receivedShortMessage(unsigned char status,
+            unsigned char control,
+            unsigned char value,
+            mixxx::Duration timestamp);
+    void receivedSysex(const QByteArray& data, mixxx::Duration timestamp);
+
+  protected:
+    void run() override;
+
+  private:
+    bool findSourcePort(int* pClient, int* pPort) const;
+    void processEvent(const snd_seq_event_t* pEvent);
+    void closeSequencer();
+
+    const QString m_portName;
+
+    snd_seq_t* m_pSeq;
+    snd_midi_event_t* m_pDecoder;
+    int m_port;
+    int m_queue;
+    mixxx::Duration m_queueStartTime;
+
+    // Written by close() to wake up the thread
+    int m_wakeFds[2];
+    std::atomic<bool> m_quit;
+
+    // Sysex messages may arrive in several events
+    QByteArray m_sysex;
+};
@@ -10,9 +10,32 @@
 #include "util/math.h"
 #include "util/screensaver.h"
 
+namespace {
+
+constexpr int kShortMessageBytes = 3;
+
+// All combinations of the status and the control byte of a MidiKey
+constexpr int kNumMidiKeys = 0x10000;
+
+} // anonymous namespace
+
 MidiController::MidiController(const QString& deviceName)
-        : Controller(deviceName) {
+        : Controller(deviceName),
+          m_inputMappingsChanged(true),
+          m_outputFlushTimer(this),
+          m_outputBytesCounter(QStringLiteral("MidiController %1 output bytes").arg(deviceName)),
+          m_sysexBytesSent(0) {
     setDeviceCategory(tr("MIDI Controller"));
+    // Send everything that has been queued while processing the current
+    // event, e.g. all LED changes caused by a single control change, at once.
+    m_outputFlushTimer.setSingleShot(true);
+    m_outputFlushTimer.setInterval(0);
+    connect(&m_outputFlushTimer, &QTimer::timeout, this, [this] {
+        // Input that is already pending takes priority over the output
+        dispatchPendingInput();
+        flushOutput();
+    });
+    m_outputStatsTimer.start();
 }
 
 MidiController::~MidiController() {
@@ -31,6 +54,34 @@ QString MidiController::mappingExtension() {
 
 void MidiController::setMapping(std::shared_ptr<LegacyControllerMapping> pMapping) {
     m_pMapping = downcastAndTakeOwnership<LegacyMidiControllerMapping>(std::move(pMapping));
+    m_inputMappingsChanged = true;
+}
+
+void MidiController::compileInputMappings() {
+    m_inputMappingsChanged = false;
+    m_compiledInputMappings.clear();
+    m_inputDispatchOffsets.assign(kNumMidiKeys + 1, 0);
+    if (!m_pMapping) {
+        return;
+    }
+    const auto& inputMappings = m_pMapping->getInputMappings();
+    m_compiledInputMappings.reserve(inputMappings.size());
+    for (int key = 0; key < kNumMidiKeys; ++key) {
+        m_inputDispatchOffsets[key] = static_cast<quint32>(m_compiledInputMappings.size());
+        // Same order as the lookup in the hash
+        for (auto it = inputMappings.constFind(static_cast<uint16_t>(key));
+                it != inputMappings.constEnd() && it.key() == key;
+                ++it) {
+            const MidiInputMapping& mapping = it.value();
+            ControlObject* pControl = nullptr;
+            if (!mapping.options.testFlag(MidiOption::Script)) {
+                pControl = ControlObject::getControl(mapping.control,
+                        ControlFlag::NoWarnIfMissing | ControlFlag::NoAssertIfMissing);
+            }
+            m_compiledInputMappings.push_back(CompiledInputMapping{mapping, pControl});
+        }
+    }
+    m_inputDispatchOffsets[kNumMidiKeys] = static_cast<quint32>(m_compiledInputMappings.size());
 }
 
 std::shared_ptr<LegacyControllerMapping> MidiController::cloneMapping() {
@@ -42,9 +93,65 @@ std::shared_ptr<LegacyControllerMapping> MidiController::cloneMapping() {
 
 int MidiController::close() {
     destroyOutputHandlers();
+    // Send what the shutdown function of the mapping has queued
+    m_outputFlushTimer.stop();
+    flushOutput();
+    logOutputStats();
+    m_outputQueue.resetStats();
+    m_outputQueue.invalidateSentState();
+    m_sysexBytesSent = 0;
     return 0;
 }
 
+void MidiController::queueShortMsg(unsigned char status,
+        unsigned char byte1,
+        unsigned char byte2) {
+    if (m_outputQueue.enqueue(status, byte1, byte2) &&
+            !m_outputFlushTimer.isActive()) {
+        m_outputFlushTimer.start();
+    }
+}
+
+void MidiController::flushOutput() {
+    if (m_outputQueue.isEmpty()) {
+        return;
+    }
+    int bytes = 0;
+    m_outputQueue.flush([this, &bytes](const MidiOutputQueue::Message& message) {
+        sendShortMsg(message.status, message.byte1, message.byte2);
+        bytes += kShortMessageBytes;
+    });
+    if (bytes > 0) {
+        m_outputBytesCounter.increment(bytes);
+    }
+}
+
+void MidiController::send(const QList<int>& data, unsigned int length) {
+    m_outputFlushTimer.stop();
+    flushOutput();
+    // A SysEx message may alter the outputs in device specific ways
+    m_outputQueue.invalidateSentState();
+    m_sysexBytesSent += data.size();
+    m_outputBytesCounter.increment(data.size());
+    Controller::send(data, length);
+}
+
+void MidiController::logOutputStats() const {
+    const MidiOutputQueue::Stats& stats = m_outputQueue.stats();
+    if (stats.enqueued == 0 && m_sysexBytesSent == 0) {
+        return;
+    }
+    const qint64 bytes = stats.sent * kShortMessageBytes + m_sysexBytesSent;
+    const double seconds = m_outputStatsTimer.elapsed() / 1000.0;
+    qCInfo(m_logOutput) << getName() << "output:"
+                        << stats.enqueued << "short messages queued,"
+                        << stats.sent << "sent,"
+                        << stats.redundant << "redundant and"
+                        << stats.coalesced << "superseded dropped,"
+                        << m_sysexBytesSent << "SysEx bytes sent,"
+                        << (seconds > 0 ? bytes / seconds : 0) << "bytes/s on average";
+}
+
 bool MidiController::matchMapping(const MappingInfo& mapping) {
     // Product info mapping not implemented for MIDI devices yet
     Q_UNUSED(mapping);
@@ -60,6 +167,7 @@ bool MidiController::applyMapping() {
         if (m_outputs.count() > 0) {
             destroyOutputHandlers();
         }
+        m_outputStatsTimer.start();
         createOutputHandlers();
         updateAllOutputs();
     }
@@ -207,6 +315,7 @@ void MidiController::commitTemporaryInputMappings() {
         m_pMapping->addInputMapping(it.key(), it.value());
     }
     m_temporaryInputMappings.clear();
+    m_inputMappingsChanged = true;
 }
 
 void MidiController::receivedShortMessage(unsigned char status,
@@ -227,6 +336,10 @@ void MidiController::receivedShortMessage(unsigned char status,
         return;
     }
 
+    // Buttons with LEDs that the device toggles on its own would otherwise
+    // not be set back by a redundant looking message from the mapping
+    m_outputQueue.invalidateSentState(status, control);
+
     qCDebug(m_logInput) << QStringLiteral("incoming: ")
                         << MidiUtils::formatMidiOpCode(getName(),
                                    status,
@@ -250,9 +363,28 @@ void MidiController::receivedShortMessage(unsigned char status,
         }
     }
 
-    auto it = m_pMapping->getInputMappings().constFind(mappingKey.key);
-    for (; it != m_pMapping->getInputMappings().constEnd() && it.key() == mappingKey.key; ++it) {
-        processInputMapping(it.value(), status, control, value, timestamp);
+    if (m_inputMappingsChanged) {
+        compileInputMappings();
+    }
+    const quint32 end = m_inputDispatchOffsets[mappingKey.key + 1];
+    for (quint32 i = m_inputDispatchOffsets[mappingKey.key]; i < end; ++i) {
+        CompiledInputMapping& compiled = m_compiledInputMappings[i];
+        if (compiled.mapping.options.testFlag(MidiOption::Script)) {
+            processInputMapping(compiled.mapping, status, control, value, timestamp);
+            continue;
+        }
+        if (!compiled.pControl) {
+            // The control didn't exist while compiling or has been deleted
+            compiled.pControl = ControlObject::getControl(compiled.mapping.control);
+            if (!compiled.pControl) {
+                continue;
+            }
+        }
+        processInputMapping(compiled.mapping,
+                compiled.pControl.data(),
+                status,
+                control,
+                value);
     }
 }
 
@@ -261,37 +393,49 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
                                          unsigned char control,
                                          unsigned char value,
                                          mixxx::Duration timestamp) {
-    Q_UNUSED(timestamp);
-    unsigned char channel = MidiUtils::channelFromStatus(status);
-    MidiOpCode opCode = MidiUtils::opCodeFromStatus(status);
-
-    if (mapping.options.testFlag(MidiOption::Script)) {
-        ControllerScriptEngineLegacy* pEngine = getScriptEngine();
-        if (pEngine == nullptr) {
+    if (!mapping.options.testFlag(MidiOption::Script)) {
+        // Only pass values on to valid ControlObjects.
+        ControlObject* pCO = ControlObject::getControl(mapping.control);
+        if (pCO == nullptr) {
             return;
         }
-
-        QJSValue function = pEngine->wrapFunctionCode(mapping.control.item, 5);
-        const auto args = QJSValueList{
-                channel,
-                control,
-                value,
-                status,
-                mapping.control.group,
-        };
-        if (!pEngine->executeFunction(function, args)) {
-            qCWarning(m_logBase) << "MidiController: Invalid script function"
-                                 << mapping.control.item;
-        }
+        processInputMapping(mapping, pCO, status, control, value);
         return;
     }
 
-    // Only pass values on to valid ControlObjects.
-    ControlObject* pCO = ControlObject::getControl(mapping.control);
-    if (pCO == nullptr) {
+    ControllerScriptEngineLegacy* pEngine = getScriptEngine();
+    if (pEngine == nullptr) {
         return;
     }
 
+    QJSValue function = pEngine->wrapFunctionCode(mapping.control.item, 5);
+    const auto args = QJSValueList{
+            MidiUtils::channelFromStatus(status),
+            control,
+            value,
+            status,
+            mapping.control.group,
+    };
+    pEngine->setInputTimestamp(timestamp);
+    const bool success = pEngine->executeFunction(
+            ControllerScriptProfiler::CallbackType::Input,
+            [&mapping] { return mapping.control.item; },
+            function,
+            args);
+    pEngine->setInputTimestamp(mixxx::Duration::empty());
+    if (!success) {
+        qCWarning(m_logBase) << "MidiController: Invalid script function"
+                             << mapping.control.item;
+    }
+}
+
+void MidiController::processInputMapping(const MidiInputMapping& mapping,
+        ControlObject* pCO,
+        unsigned char status,
+        unsigned char control,
+        unsigned char value) {
+    MidiOpCode opCode = MidiUtils::opCodeFromStatus(status);
+
     double newValue = value;
 
     const bool mapping_is_14bit = mapping.options &
@@ -528,7 +672,9 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
         if (pEngine == nullptr) {
             return;
         }
+        pEngine->setInputTimestamp(timestamp);
         pEngine->handleIncomingData(data);
+        pEngine->setInputTimestamp(mixxx::Duration::empty());
         return;
     }
     qCWarning(m_logBase) << "MidiController: No script function specified for"
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <QPointer>
+#include <QTimer>
+#include <vector>
+
 #include "controllers/controller.h"
 #include "controllers/midi/legacymidicontrollermapping.h"
 #include "controllers/midi/legacymidicontrollermappingfilehandler.h"
 #include "controllers/midi/midimessage.h"
 #include "controllers/midi/midioutputhandler.h"
+#include "controllers/midi/midioutputqueue.h"
 #include "controllers/softtakeover.h"
+#include "util/counter.h"
 
+class ControlObject;
 class DlgControllerLearning;
 
 /// MIDI Controller base class
@@ -45,6 +52,17 @@ class MidiController : public Controller {
             unsigned char byte1,
             unsigned char byte2) = 0;
 
+    /// Queues a short message for output. Queued messages are sent by
+    /// sendShortMsg() when control returns to the event loop, after dropping
+    /// redundant and superseded ones (see MidiOutputQueue).
+    void queueShortMsg(unsigned char status,
+            unsigned char byte1,
+            unsigned char byte2);
+
+    /// Sends the queued short messages before the SysEx message to keep
+    /// their order.
+    void send(const QList<int>& data, unsigned int length = 0) override;
+
     /// Alias for send()
     /// The length parameter is here for backwards compatibility for when scripts
     /// were required to specify it.
@@ -71,12 +89,29 @@ class MidiController : public Controller {
     void commitTemporaryInputMappings();
 
   private:
+    // An input mapping of m_pMapping with its control resolved in advance
+    struct CompiledInputMapping {
+        MidiInputMapping mapping;
+        // null for scripts and for controls that didn't exist while compiling
+        QPointer<ControlObject> pControl;
+    };
+
+    // Rebuilds m_compiledInputMappings and m_inputDispatchOffsets from the
+    // input mappings of m_pMapping
+    void compileInputMappings();
+
     void processInputMapping(
             const MidiInputMapping& mapping,
             unsigned char status,
             unsigned char control,
             unsigned char value,
             mixxx::Duration timestamp);
+    void processInputMapping(
+            const MidiInputMapping& mapping,
+            ControlObject* pCO,
+            unsigned char status,
+            unsigned char control,
+            unsigned char value);
     void processInputMapping(
             const MidiInputMapping& mapping,
             const QByteArray& data,
@@ -86,16 +121,31 @@ class MidiController : public Controller {
     void createOutputHandlers();
     void updateAllOutputs();
     void destroyOutputHandlers();
+    void flushOutput();
+    void logOutputStats() const;
 
     QHash<uint16_t, MidiInputMapping> m_temporaryInputMappings;
     QList<MidiOutputHandler*> m_outputs;
     std::shared_ptr<LegacyMidiControllerMapping> m_pMapping;
+    // The input mappings of m_pMapping ordered by their MidiKey. The ones of
+    // a key are found at [m_inputDispatchOffsets[key], m_inputDispatchOffsets[key + 1]),
+    // so a short message is dispatched without any hash lookup.
+    std::vector<CompiledInputMapping> m_compiledInputMappings;
+    std::vector<quint32> m_inputDispatchOffsets;
+    bool m_inputMappingsChanged;
     SoftTakeoverCtrl m_st;
     QList<QPair<MidiInputMapping, unsigned char>> m_fourteen_bit_queued_mappings;
 
+    MidiOutputQueue m_outputQueue;
+    QTimer m_outputFlushTimer;
+    Counter m_outputBytesCounter;
+    qint64 m_sysexBytesSent;
+    QElapsedTimer m_outputStatsTimer;
+
     // So it can access sendShortMsg()
     friend class MidiOutputHandler;
     friend class MidiControllerTest;
+    friend class ControllerMappingBenchmark;
     friend class MidiControllerJSProxy;
 
     // MIDI learning assistant
@@ -113,7 +163,7 @@ class MidiControllerJSProxy : public ControllerJSProxy {
     Q_INVOKABLE void sendShortMsg(unsigned char status,
             unsigned char byte1,
             unsigned char byte2) {
-        m_pMidiController->sendShortMsg(status, byte1, byte2);
+        m_pMidiController->queueShortMsg(status, byte1, byte2);
     }
 
     Q_INVOKABLE void sendSysexMsg(const QList<int>& data, unsigned int length = 0) {
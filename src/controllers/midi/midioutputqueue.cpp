@@ -0,0 +1,87 @@
+#include "controllers/midi/midioutputqueue.h"
+
+#include "controllers/midi/midiutils.h"
+
+namespace {
+
+// Controller numbers of (N)RPN and data entry, their meaning depends on the
+// order of the messages.
+bool isParameterNumberControl(unsigned char control) {
+    switch (control) {
+    case 0x06: // Data Entry MSB
+    case 0x26: // Data Entry LSB
+    case 0x60: // Data Increment
+    case 0x61: // Data Decrement
+    case 0x62: // NRPN LSB
+    case 0x63: // NRPN MSB
+    case 0x64: // RPN LSB
+    case 0x65: // RPN MSB
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // anonymous namespace
+
+MidiOutputQueue::MidiOutputQueue() {
+    m_pendingIndex.fill(kNone);
+    m_lastSent.fill(kNone);
+}
+
+// static
+int MidiOutputQueue::stateKey(unsigned char status, unsigned char byte1) {
+    int kind;
+    switch (MidiUtils::opCodeFromStatus(status)) {
+    case MidiOpCode::NoteOff:
+    case MidiOpCode::NoteOn:
+        kind = 0;
+        break;
+    case MidiOpCode::PolyphonicKeyPressure:
+        kind = 1;
+        break;
+    case MidiOpCode::ControlChange:
+        if (isParameterNumberControl(byte1)) {
+            return kNone;
+        }
+        kind = 2;
+        break;
+    default:
+        return kNone;
+    }
+    return (kind * 16 + MidiUtils::channelFromStatus(status)) * 128 + (byte1 & 0x7F);
+}
+
+bool MidiOutputQueue::enqueue(unsigned char status, unsigned char byte1, unsigned char byte2) {
+    ++m_stats.enqueued;
+    const Message message = {status, byte1, byte2};
+    const int key = stateKey(message);
+    if (key < 0) {
+        m_pending.push_back(message);
+        return true;
+    }
+    const int pendingIndex = m_pendingIndex[key];
+    if (pendingIndex != kNone) {
+        m_pending[pendingIndex] = message;
+        ++m_stats.coalesced;
+        return true;
+    }
+    if (m_lastSent[key] == stateValue(message)) {
+        ++m_stats.redundant;
+        return false;
+    }
+    m_pendingIndex[key] = static_cast<int>(m_pending.size());
+    m_pending.push_back(message);
+    return true;
+}
+
+void MidiOutputQueue::invalidateSentState() {
+    m_lastSent.fill(kNone);
+}
+
+void MidiOutputQueue::invalidateSentState(unsigned char status, unsigned char byte1) {
+    const int key = stateKey(status, byte1);
+    if (key >= 0) {
+        m_lastSent[key] = kNone;
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QtGlobal>
+#include <array>
+#include <vector>
+
+/// MidiOutputQueue collects the short messages sent to a MIDI controller
+/// until they are flushed, usually once per event loop iteration of the
+/// controller thread.
+///
+/// Note, polyphonic pressure and control change messages set the state of an
+/// output like an LED. For these
+///  * a message is dropped if the output already has the value last sent and
+///  * only the last of several changes of an output between two flushes is
+///    sent, at the position of the first one.
+/// All other messages, and control changes that are part of (N)RPN and data
+/// entry sequences, are sent unmodified in order.
+class MidiOutputQueue {
+  public:
+    struct Message {
+        unsigned char status;
+        unsigned char byte1;
+        unsigned char byte2;
+    };
+
+    struct Stats {
+        /// Messages passed to enqueue()
+        qint64 enqueued = 0;
+        /// Messages passed to the send function by flush()
+        qint64 sent = 0;
+        /// Messages dropped, because the output already had the value
+        qint64 redundant = 0;
+        /// Messages superseded by a later change before being sent
+        qint64 coalesced = 0;
+    };
+
+    MidiOutputQueue();
+
+    /// Queues a message. Returns false if it has been dropped because it
+    /// would not change the state of the output.
+    bool enqueue(unsigned char status, unsigned char byte1, unsigned char byte2);
+
+    bool isEmpty() const {
+        return m_pending.empty();
+    }
+
+    /// Passes all pending messages to sendFunction(const Message&) and
+    /// clears the queue.
+    template<typename SendFunction>
+    void flush(SendFunction sendFunction) {
+        for (const Message& message : m_pending) {
+            const int key = stateKey(message);
+            if (key >= 0) {
+                m_pendingIndex[key] = kNone;
+                const int value = stateValue(message);
+                if (m_lastSent[key] == value) {
+                    // Changed back to the last sent value before the flush
+                    ++m_stats.redundant;
+                    continue;
+                }
+                m_lastSent[key] = value;
+            }
+            ++m_stats.sent;
+            sendFunction(message);
+        }
+        m_pending.clear();
+    }
+
+    /// Forget the values last sent to all outputs, so every following message
+    /// is sent. Must be called when the device may have changed its outputs
+    /// on its own, e.g. after SysEx messages or reconnecting.
+    void invalidateSentState();
+    /// Forget the value last sent to the output addressed by the message,
+    /// e.g. because an input with the same address was received and the device
+    /// might have changed its LED locally.
+    void invalidateSentState(unsigned char status, unsigned char byte1);
+
+    const Stats& stats() const {
+        return m_stats;
+    }
+    void resetStats() {
+        m_stats = Stats();
+    }
+
+  private:
+    static constexpr int kNone = -1;
+    // (Note, polyphonic pressure, control change) x 16 channels x 128
+    static constexpr int kNumStateKeys = 3 * 16 * 128;
+
+    /// Returns the index of the output whose state the message sets, or -1 if
+    /// the message is not a state message.
+    static int stateKey(unsigned char status, unsigned char byte1);
+    static int stateKey(const Message& message) {
+        return stateKey(message.status, message.byte1);
+    }
+    /// Note on and off set the same output, so the value includes the status
+    static int stateValue(const Message& message) {
+        return (message.status << 8) | message.byte2;
+    }
+
+    std::vector<Message> m_pending;
+    /// Index into m_pending of the pending message for an output
+    std::array<int, kNumStateKeys> m_pendingIndex;
+    std::array<int, kNumStateKeys> m_lastSent;
+    Stats m_stats;
+};
@@ -1,7 +1,15 @@
 #include "controllers/midi/portmidicontroller.h"
 
+#include <porttime.h>
+
 #include "controllers/midi/midiutils.h"
 #include "moc_portmidicontroller.cpp"
+#include "util/assert.h"
+#include "util/time.h"
+
+#ifdef __ALSAMIDI__
+#include "controllers/midi/alsaseqmidiinput.h"
+#endif
 
 namespace {
 const QString kUnknownControllerName = QStringLiteral("Unknown PortMidiController");
@@ -56,7 +64,12 @@ int PortMidiController::open() {
     m_bInSysex = false;
     m_cReceiveMsg_index = 0;
 
-    if (m_pInputDevice && isInputDevice()) {
+#ifdef __ALSAMIDI__
+    const bool eventDrivenInput = m_pInputDevice && isInputDevice() && openAlsaSeqInput();
+#else
+    const bool eventDrivenInput = false;
+#endif
+    if (m_pInputDevice && isInputDevice() && !eventDrivenInput) {
         qCInfo(m_logBase) << "PortMidiController: Opening"
                           << m_pInputDevice->info()->name << "index"
                           << m_pInputDevice->index() << "for input";
@@ -66,6 +79,10 @@ int PortMidiController::open() {
             qCWarning(m_logBase) << "PortMidi error:" << Pm_GetErrorText(err);
             return -2;
         }
+        // PortMidi timestamps the input with the PortTime clock, which has
+        // been started by opening the input. Remember its offset to report
+        // timestamps on the mixxx::Time clock that is used by the engine.
+        m_portTimeOffset = mixxx::Time::elapsed() - mixxx::Duration::fromMillis(Pt_Time());
     }
     if (m_pOutputDevice && isOutputDevice()) {
         qCInfo(m_logBase) << "PortMidiController: Opening"
@@ -90,6 +107,15 @@ int PortMidiController::close() {
         return -1;
     }
 
+#ifdef __ALSAMIDI__
+    if (m_pAlsaSeqInput) {
+        // Stop the input before the shutdown function of the mapping
+        disconnect(m_pAlsaSeqInput.get());
+        m_pAlsaSeqInput->close();
+        m_pAlsaSeqInput.reset();
+    }
+#endif
+
     stopEngine();
     MidiController::close();
 
@@ -115,6 +141,35 @@ int PortMidiController::close() {
     return result;
 }
 
+#ifdef __ALSAMIDI__
+bool PortMidiController::openAlsaSeqInput() {
+    DEBUG_ASSERT(!m_pAlsaSeqInput);
+    // Only the devices of PortMidi's ALSA backend are sequencer ports
+    if (qstrcmp(m_pInputDevice->info()->interf, "ALSA") != 0) {
+        return false;
+    }
+    auto pInput = std::make_unique<AlsaSeqMidiInput>(
+            QString::fromLocal8Bit(m_pInputDevice->info()->name));
+    connect(pInput.get(),
+            &AlsaSeqMidiInput::receivedShortMessage,
+            this,
+            &PortMidiController::receivedShortMessage,
+            Qt::QueuedConnection);
+    connect(pInput.get(),
+            &AlsaSeqMidiInput::receivedSysex,
+            this,
+            &PortMidiController::receive,
+            Qt::QueuedConnection);
+    if (!pInput->open()) {
+        qCInfo(m_logBase) << "PortMidiController: Polling the input of"
+                          << getName() << "with PortMidi";
+        return false;
+    }
+    m_pAlsaSeqInput = std::move(pInput);
+    return true;
+}
+#endif
+
 bool PortMidiController::poll() {
     // Poll the controller for new data if it's an input device
     if (m_pInputDevice.isNull() || !m_pInputDevice->isOpen()) {
@@ -132,7 +187,8 @@ bool PortMidiController::poll() {
 
     for (int i = 0; i < numEvents; i++) {
         unsigned char status = Pm_MessageStatus(m_midiBuffer[i].message);
-        mixxx::Duration timestamp = mixxx::Duration::fromMillis(m_midiBuffer[i].timestamp);
+        mixxx::Duration timestamp = m_portTimeOffset +
+                mixxx::Duration::fromMillis(m_midiBuffer[i].timestamp);
 
         if ((status & 0xF8) == 0xF8) {
             // Handle real-time MIDI messages at any time
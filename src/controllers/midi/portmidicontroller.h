@@ -3,10 +3,15 @@
 #include <portmidi.h>
 
 #include <QScopedPointer>
+#include <memory>
 
 #include "controllers/midi/midicontroller.h"
 #include "controllers/midi/portmididevice.h"
 
+#ifdef __ALSAMIDI__
+class AlsaSeqMidiInput;
+#endif
+
 // Note:
 // A standard Midi device runs at 31.25 kbps, with 10 bits / byte
 // 1 byte / 320 microseconds
@@ -71,9 +76,19 @@ class PortMidiController : public MidiController {
     void sendBytes(const QByteArray& data) override;
 
     bool isPolling() const override {
+#ifdef __ALSAMIDI__
+        // The input is read by m_pAlsaSeqInput without polling
+        if (m_pAlsaSeqInput) {
+            return false;
+        }
+#endif
         return true;
     }
 
+#ifdef __ALSAMIDI__
+    bool openAlsaSeqInput();
+#endif
+
     // For testing only so that test fixtures can install mock PortMidiDevices.
     void setPortMidiInputDevice(PortMidiDevice* device) {
         m_pInputDevice.reset(device);
@@ -84,8 +99,13 @@ class PortMidiController : public MidiController {
 
     QScopedPointer<PortMidiDevice> m_pInputDevice;
     QScopedPointer<PortMidiDevice> m_pOutputDevice;
+#ifdef __ALSAMIDI__
+    std::unique_ptr<AlsaSeqMidiInput> m_pAlsaSeqInput;
+#endif
 
     PmEvent m_midiBuffer[MIXXX_PORTMIDI_BUFFER_LEN];
+    /// Offset of the PortTime clock to mixxx::Time
+    mixxx::Duration m_portTimeOffset;
 
     // Storage for SysEx messages
     unsigned char m_cReceiveMsg[MIXXX_SYSEX_BUFFER_LEN];
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QByteArray>
+#include <QColor>
+#include <QList>
+#include <QRect>
+#include <QSize>
+#include <QString>
+
+#include "preferences/configobject.h"
+
+/// Describes a screen of a controller, e.g. in a jog wheel, which is rendered
+/// natively from the values of controls and sent to the device without
+/// running any script code per frame.
+///
+/// The screen is divided into tiles. Only the tiles that changed since the
+/// previous frame are sent, horizontally adjacent ones merged into a single
+/// packet. Each packet consists of
+///  * the tile header bytes of the screen,
+///  * x, y, width and height of the area as 16 bit values and
+///  * the RGB565 pixels of the area row by row,
+/// all multi byte values in the byte order of the screen.
+struct ControllerScreen {
+    struct Element {
+        enum class Type {
+            /// The formatted value of the control
+            Text,
+            /// A horizontal bar filled proportionally to the value
+            Bar,
+            /// A rectangle filled with the color if the value is above 0.5 and
+            /// with the off color otherwise
+            Indicator,
+        };
+
+        Type type = Type::Text;
+        QRect rect;
+        ConfigKey key;
+        QColor color = Qt::white;
+        QColor offColor = Qt::transparent;
+
+        // Text
+        /// The value is inserted for %1
+        QString format = QStringLiteral("%1");
+        int decimals = 0;
+        int fontPixelSize = 16;
+        Qt::Alignment alignment = Qt::AlignCenter;
+
+        // Bar
+        double minimum = 0.0;
+        double maximum = 1.0;
+    };
+
+    QString identifier;
+    QSize size;
+    int targetFps = 30;
+    int tileSize = 16;
+    bool bigEndian = false;
+    QByteArray tileHeader;
+    QColor backgroundColor = Qt::black;
+    QList<Element> elements;
+
+    bool isValid() const {
+        return size.width() > 0 && size.height() > 0 && targetFps > 0 && tileSize > 0;
+    }
+};
@@ -0,0 +1,221 @@
+#include "controllers/rendering/controllerscreenrenderer.h"
+
+#include <QPainter>
+#include <QtEndian>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "moc_controllerscreenrenderer.cpp"
+#include "util/math.h"
+#include "util/time.h"
+#include "util/trace.h"
+
+namespace {
+
+constexpr QImage::Format kFrameFormat = QImage::Format_RGB16;
+constexpr int kBytesPerPixel = 2;
+// x, y, width and height
+constexpr int kAreaHeaderSize = 4 * 2;
+
+char* writeUInt16(char* pDest, quint16 value, bool bigEndian) {
+    if (bigEndian) {
+        qToBigEndian(value, pDest);
+    } else {
+        qToLittleEndian(value, pDest);
+    }
+    return pDest + 2;
+}
+
+bool isTileChanged(const QImage& previousFrame, const QImage& frame, const QRect& tile) {
+    const int offset = tile.x() * kBytesPerPixel;
+    const int length = tile.width() * kBytesPerPixel;
+    for (int y = tile.top(); y <= tile.bottom(); ++y) {
+        if (memcmp(previousFrame.constScanLine(y) + offset,
+                    frame.constScanLine(y) + offset,
+                    length) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int sendArea(const ControllerScreen& screen,
+        const QImage& frame,
+        const QRect& area,
+        const ControllerScreenRenderer::SendFunction& sendFunction) {
+    QByteArray packet(screen.tileHeader.size() + kAreaHeaderSize +
+                    area.width() * area.height() * kBytesPerPixel,
+            Qt::Uninitialized);
+    char* pDest = packet.data();
+    memcpy(pDest, screen.tileHeader.constData(), screen.tileHeader.size());
+    pDest += screen.tileHeader.size();
+    pDest = writeUInt16(pDest, static_cast<quint16>(area.x()), screen.bigEndian);
+    pDest = writeUInt16(pDest, static_cast<quint16>(area.y()), screen.bigEndian);
+    pDest = writeUInt16(pDest, static_cast<quint16>(area.width()), screen.bigEndian);
+    pDest = writeUInt16(pDest, static_cast<quint16>(area.height()), screen.bigEndian);
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        const quint16* pPixels =
+                reinterpret_cast<const quint16*>(frame.constScanLine(y)) + area.x();
+        for (int x = 0; x < area.width(); ++x) {
+            pDest = writeUInt16(pDest, pPixels[x], screen.bigEndian);
+        }
+    }
+    sendFunction(packet);
+    return packet.size();
+}
+
+} // anonymous namespace
+
+ControllerScreenRenderer::ControllerScreenRenderer(
+        const ControllerScreen& screen, SendFunction sendFunction)
+        : QThread(),
+          m_screen(screen),
+          m_sendFunction(std::move(sendFunction)),
+          m_stop(0) {
+    m_controls.reserve(m_screen.elements.size());
+    for (const auto& element : m_screen.elements) {
+        m_controls.emplace_back(element.key, ControlFlag::AllowMissingOrInvalid);
+    }
+    m_values.resize(m_controls.size());
+}
+
+ControllerScreenRenderer::~ControllerScreenRenderer() {
+    stop();
+    wait();
+}
+
+void ControllerScreenRenderer::stop() {
+    m_stop = 1;
+}
+
+void ControllerScreenRenderer::run() {
+    VERIFY_OR_DEBUG_ASSERT(m_screen.isValid()) {
+        return;
+    }
+    const auto frameDuration = mixxx::Duration::fromNanos(
+            mixxx::Duration::kNanosPerSecond / m_screen.targetFps);
+    auto nextFrameTime = mixxx::Time::elapsed();
+    while (m_stop.loadAcquire() == 0) {
+        renderAndSendFrame();
+
+        nextFrameTime += frameDuration;
+        const auto now = mixxx::Time::elapsed();
+        if (nextFrameTime > now) {
+            usleep((nextFrameTime - now).toIntegerMicros());
+        } else {
+            // Skip the frames that could not be rendered in time, e.g. because
+            // sending was slow, instead of rendering them back to back.
+            nextFrameTime = now;
+        }
+    }
+}
+
+void ControllerScreenRenderer::renderAndSendFrame() {
+    bool changed = m_frame.isNull();
+    for (size_t i = 0; i < m_controls.size(); ++i) {
+        const double value = m_controls[i].get();
+        if (value != m_values[i]) {
+            m_values[i] = value;
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return;
+    }
+
+    Trace render("ControllerScreenRenderer render");
+    m_previousFrame.swap(m_frame);
+    renderFrame(m_screen, m_values, &m_frame);
+    sendChangedTiles(m_screen, m_previousFrame, m_frame, m_sendFunction);
+}
+
+// static
+void ControllerScreenRenderer::renderFrame(const ControllerScreen& screen,
+        const std::vector<double>& values,
+        QImage* pFrame) {
+    VERIFY_OR_DEBUG_ASSERT(values.size() == static_cast<size_t>(screen.elements.size())) {
+        return;
+    }
+    if (pFrame->size() != screen.size || pFrame->format() != kFrameFormat) {
+        *pFrame = QImage(screen.size, kFrameFormat);
+    }
+    pFrame->fill(screen.backgroundColor);
+
+    QPainter painter(pFrame);
+    for (int i = 0; i < screen.elements.size(); ++i) {
+        const ControllerScreen::Element& element = screen.elements.at(i);
+        const double value = values[i];
+        switch (element.type) {
+        case ControllerScreen::Element::Type::Text: {
+            painter.fillRect(element.rect, element.offColor);
+            QFont font = painter.font();
+            font.setPixelSize(element.fontPixelSize);
+            painter.setFont(font);
+            painter.setPen(element.color);
+            painter.drawText(element.rect,
+                    element.alignment,
+                    element.format.arg(QString::number(value, 'f', element.decimals)));
+            break;
+        }
+        case ControllerScreen::Element::Type::Bar: {
+            painter.fillRect(element.rect, element.offColor);
+            const double range = element.maximum - element.minimum;
+            const double fraction = range != 0.0
+                    ? math_clamp((value - element.minimum) / range, 0.0, 1.0)
+                    : 0.0;
+            QRect filled = element.rect;
+            filled.setWidth(static_cast<int>(std::round(element.rect.width() * fraction)));
+            painter.fillRect(filled, element.color);
+            break;
+        }
+        case ControllerScreen::Element::Type::Indicator:
+            painter.fillRect(element.rect, value > 0.5 ? element.color : element.offColor);
+            break;
+        }
+    }
+}
+
+// static
+int ControllerScreenRenderer::sendChangedTiles(const ControllerScreen& screen,
+        const QImage& previousFrame,
+        const QImage& frame,
+        const SendFunction& sendFunction) {
+    VERIFY_OR_DEBUG_ASSERT(frame.format() == kFrameFormat && screen.tileSize > 0) {
+        return 0;
+    }
+    const bool compare = previousFrame.size() == frame.size() &&
+            previousFrame.format() == frame.format();
+    const int width = frame.width();
+    const int height = frame.height();
+    int sentBytes = 0;
+    for (int tileY = 0; tileY < height; tileY += screen.tileSize) {
+        const int tileHeight = std::min(screen.tileSize, height - tileY);
+        // The first tile of the current run of changed tiles
+        int runX = -1;
+        for (int tileX = 0; tileX < width; tileX += screen.tileSize) {
+            const QRect tile(tileX,
+                    tileY,
+                    std::min(screen.tileSize, width - tileX),
+                    tileHeight);
+            if (!compare || isTileChanged(previousFrame, frame, tile)) {
+                if (runX < 0) {
+                    runX = tileX;
+                }
+            } else if (runX >= 0) {
+                sentBytes += sendArea(screen,
+                        frame,
+                        QRect(runX, tileY, tileX - runX, tileHeight),
+                        sendFunction);
+                runX = -1;
+            }
+        }
+        if (runX >= 0) {
+            sentBytes += sendArea(screen,
+                    frame,
+                    QRect(runX, tileY, width - runX, tileHeight),
+                    sendFunction);
+        }
+    }
+    return sentBytes;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QImage>
+#include <QThread>
+#include <functional>
+#include <vector>
+
+#include "control/pollingcontrolproxy.h"
+#include "controllers/rendering/controllerscreen.h"
+
+/// ControllerScreenRenderer renders a ControllerScreen on its own thread at
+/// the target frame rate and passes the packets of the changed tiles to the
+/// send function, which is called from the renderer thread.
+///
+/// The values of the bound controls are polled every frame. A frame is only
+/// rendered if one of them changed, so an idle screen costs almost nothing.
+class ControllerScreenRenderer : public QThread {
+    Q_OBJECT
+  public:
+    using SendFunction = std::function<void(const QByteArray& packet)>;
+
+    ControllerScreenRenderer(const ControllerScreen& screen, SendFunction sendFunction);
+    ~ControllerScreenRenderer() override;
+
+    /// Requests the render loop to stop, use wait() to wait until it did.
+    void stop();
+
+    /// Renders the elements with the given values, one per element.
+    static void renderFrame(const ControllerScreen& screen,
+            const std::vector<double>& values,
+            QImage* pFrame);
+
+    /// Calls sendFunction with a packet for each run of horizontally
+    /// adjacent tiles that differ between the frames. All tiles are sent if
+    /// there is no previous frame. Returns the number of sent bytes.
+    static int sendChangedTiles(const ControllerScreen& screen,
+            const QImage& previousFrame,
+            const QImage& frame,
+            const SendFunction& sendFunction);
+
+  protected:
+    void run() override;
+
+  private:
+    void renderAndSendFrame();
+
+    const ControllerScreen m_screen;
+    const SendFunction m_sendFunction;
+    std::vector<PollingControlProxy> m_controls;
+    std::vector<double> m_values;
+    QImage m_frame;
+    QImage m_previousFrame;
+    QAtomicInt m_stop;
+};
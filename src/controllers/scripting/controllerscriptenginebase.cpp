@@ -12,6 +12,7 @@ ControllerScriptEngineBase::ControllerScriptEngineBase(
         : m_bDisplayingExceptionDialog(false),
           m_pJSEngine(nullptr),
           m_pController(controller),
+          m_pScriptProfiler(controller ? controller->scriptProfiler() : nullptr),
           m_logger(logger),
           m_bTesting(false) {
     // Handle error dialog buttons
@@ -95,6 +96,35 @@ bool ControllerScriptEngineBase::executeFunction(
     return true;
 }
 
+void ControllerScriptEngineBase::reportSlowCallback(
+        ControllerScriptProfiler::CallbackType type,
+        const QString& name,
+        mixxx::Duration duration) {
+    if (!m_pScriptProfiler) {
+        return;
+    }
+    if (m_pScriptProfiler->recordSlowCallback(type, name, duration) &&
+            duration > ControllerScriptProfiler::kLatencyBudget) {
+        qCWarning(m_logger).noquote()
+                << "Slow script" << ControllerScriptProfiler::callbackTypeName(type)
+                << "callback" << name << "took" << duration.formatMicrosWithUnit()
+                << "exceeding the latency budget of"
+                << ControllerScriptProfiler::kLatencyBudget.formatMillisWithUnit();
+    }
+}
+
+void ControllerScriptEngineBase::collectGarbage() {
+    if (m_pJSEngine) {
+        m_pJSEngine->collectGarbage();
+    }
+}
+
+void ControllerScriptEngineBase::dispatchPendingInput() {
+    if (m_pController) {
+        m_pController->dispatchPendingInput();
+    }
+}
+
 void ControllerScriptEngineBase::showScriptExceptionDialog(
         const QJSValue& evaluationResult, bool bFatalError) {
     VERIFY_OR_DEBUG_ASSERT(evaluationResult.isError()) {
@@ -7,7 +7,9 @@
 #include <memory>
 
 #include "controllers/legacycontrollermapping.h"
+#include "controllers/scripting/controllerscriptprofiler.h"
 #include "util/duration.h"
+#include "util/performancetimer.h"
 #include "util/runtimeloggingcategory.h"
 
 class Controller;
@@ -27,6 +29,47 @@ class ControllerScriptEngineBase : public QObject {
 
     bool executeFunction(QJSValue functionObject, const QJSValueList& arguments = {});
 
+    /// Calls the function like executeFunction() and reports the call to the
+    /// controller's script profiler if it exceeds the latency budget. The name
+    /// function returning the name of the callback is only evaluated then.
+    template<typename NameFunction>
+    bool executeFunction(ControllerScriptProfiler::CallbackType type,
+            NameFunction name,
+            QJSValue functionObject,
+            const QJSValueList& arguments = {}) {
+        PerformanceTimer timer;
+        timer.start();
+        const bool success = executeFunction(std::move(functionObject), arguments);
+        profileCallback(type, timer.elapsed(), name);
+        return success;
+    }
+
+    /// Reports a script callback that has been called outside of
+    /// executeFunction() to the controller's script profiler if it exceeds
+    /// the latency budget or the profiler records all callbacks.
+    template<typename NameFunction>
+    void profileCallback(ControllerScriptProfiler::CallbackType type,
+            mixxx::Duration duration,
+            NameFunction name) {
+        if (duration > ControllerScriptProfiler::kLatencyBudget ||
+                (m_pScriptProfiler && m_pScriptProfiler->isRecordingAllCallbacks())) {
+            reportSlowCallback(type, name(), duration);
+        }
+    }
+
+    /// The profiler of the controller, null without a controller.
+    ControllerScriptProfiler* scriptProfiler() const {
+        return m_pScriptProfiler;
+    }
+
+    /// Runs the garbage collector of the JS engine, which otherwise runs
+    /// unnoticed during the callbacks that allocate.
+    void collectGarbage();
+
+    /// Lets the controller handle its pending input before timer and output
+    /// work is done.
+    void dispatchPendingInput();
+
     /// Shows a UI dialog notifying of a script evaluation error.
     /// Precondition: QJSValue.isError() == true
     void showScriptExceptionDialog(const QJSValue& evaluationResult, bool bFatal = false);
@@ -44,11 +87,15 @@ class ControllerScriptEngineBase : public QObject {
     virtual void shutdown();
 
     void scriptErrorDialog(const QString& detailedError, const QString& key, bool bFatal = false);
+    void reportSlowCallback(ControllerScriptProfiler::CallbackType type,
+            const QString& name,
+            mixxx::Duration duration);
 
     bool m_bDisplayingExceptionDialog;
     std::shared_ptr<QJSEngine> m_pJSEngine;
 
     Controller* m_pController;
+    ControllerScriptProfiler* const m_pScriptProfiler;
     const RuntimeLoggingCategory m_logger;
 
     bool m_bTesting;
@@ -0,0 +1,59 @@
+#include "controllers/scripting/controllerscriptprofiler.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+
+#include "util/assert.h"
+
+bool ControllerScriptProfiler::recordSlowCallback(CallbackType type,
+        const QString& name,
+        mixxx::Duration duration) {
+    const QMutexLocker lock(&m_mutex);
+    auto it = m_slowCallbacks.find(name);
+    if (it == m_slowCallbacks.end()) {
+        m_slowCallbacks.insert(name, SlowCallback{type, name, 1, duration, duration});
+        return true;
+    }
+    it->count++;
+    it->totalDuration += duration;
+    if (duration > it->maxDuration) {
+        it->maxDuration = duration;
+        return true;
+    }
+    return false;
+}
+
+QList<ControllerScriptProfiler::SlowCallback> ControllerScriptProfiler::slowCallbacks() const {
+    QList<SlowCallback> slowCallbacks;
+    {
+        const QMutexLocker lock(&m_mutex);
+        slowCallbacks = m_slowCallbacks.values();
+    }
+    std::sort(slowCallbacks.begin(),
+            slowCallbacks.end(),
+            [](const SlowCallback& lhs, const SlowCallback& rhs) {
+                return lhs.maxDuration > rhs.maxDuration;
+            });
+    return slowCallbacks;
+}
+
+void ControllerScriptProfiler::reset() {
+    const QMutexLocker lock(&m_mutex);
+    m_slowCallbacks.clear();
+    m_getValueCount.store(0, std::memory_order_relaxed);
+    m_setValueCount.store(0, std::memory_order_relaxed);
+}
+
+// static
+QString ControllerScriptProfiler::callbackTypeName(CallbackType type) {
+    switch (type) {
+    case CallbackType::Input:
+        return QStringLiteral("input");
+    case CallbackType::Timer:
+        return QStringLiteral("timer");
+    case CallbackType::Connection:
+        return QStringLiteral("connection");
+    }
+    DEBUG_ASSERT(!"unhandled callback type");
+    return QString();
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+#include "util/duration.h"
+
+/// ControllerScriptProfiler collects the script callbacks of a controller
+/// mapping that exceeded the latency budget.
+///
+/// Every callback is measured by the script engine, but only those that take
+/// longer than the budget are reported here, so the cost for well-behaved
+/// mappings is a single time measurement per callback. The slow callbacks are
+/// recorded in the controller thread and read by the controller preferences,
+/// which helps mapping authors to find the hot spots of their scripts.
+///
+/// For profiling a mapping, e.g. with recorded input, all callbacks can be
+/// recorded regardless of the budget.
+class ControllerScriptProfiler {
+  public:
+    enum class CallbackType {
+        Input,
+        Timer,
+        Connection,
+    };
+
+    struct SlowCallback {
+        CallbackType type;
+        QString name;
+        /// Number of calls that exceeded the budget, or of all calls while
+        /// recording all callbacks
+        int count;
+        mixxx::Duration maxDuration;
+        mixxx::Duration totalDuration;
+    };
+
+    /// Callbacks running longer than this delay the processing of the next
+    /// input, e.g. jog wheel messages, noticeably.
+    static constexpr mixxx::Duration kLatencyBudget = mixxx::Duration::fromMillis(5);
+
+    ControllerScriptProfiler() = default;
+
+    /// Records a callback that exceeded the latency budget. Returns true if
+    /// this is the slowest call of the callback so far.
+    bool recordSlowCallback(CallbackType type,
+            const QString& name,
+            mixxx::Duration duration);
+
+    /// Returns the slow callbacks, the slowest first. Can be called from any
+    /// thread.
+    QList<SlowCallback> slowCallbacks() const;
+
+    /// Also records the callbacks within the latency budget. Can be called
+    /// from any thread.
+    void setRecordingAllCallbacks(bool recordingAllCallbacks) {
+        m_recordingAllCallbacks.store(recordingAllCallbacks, std::memory_order_relaxed);
+    }
+    bool isRecordingAllCallbacks() const {
+        return m_recordingAllCallbacks.load(std::memory_order_relaxed);
+    }
+
+    /// Counts the calls of engine.getValue() and engine.setValue(), which
+    /// are the most frequent calls of mappings into Mixxx.
+    void countGetValue() {
+        m_getValueCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    void countSetValue() {
+        m_setValueCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    quint64 getValueCount() const {
+        return m_getValueCount.load(std::memory_order_relaxed);
+    }
+    quint64 setValueCount() const {
+        return m_setValueCount.load(std::memory_order_relaxed);
+    }
+
+    void reset();
+
+    static QString callbackTypeName(CallbackType type);
+
+  private:
+    mutable QMutex m_mutex;
+    QHash<QString, SlowCallback> m_slowCallbacks;
+    std::atomic<bool> m_recordingAllCallbacks{false};
+    std::atomic<quint64> m_getValueCount{0};
+    std::atomic<quint64> m_setValueCount{0};
+};
@@ -187,7 +187,11 @@ bool ControllerScriptEngineLegacy::handleIncomingData(const QByteArray& data) {
     };
 
     for (const QJSValue& function : std::as_const(m_incomingDataFunctions)) {
-        ControllerScriptEngineBase::executeFunction(function, args);
+        ControllerScriptEngineBase::executeFunction(
+                ControllerScriptProfiler::CallbackType::Input,
+                [] { return QStringLiteral("incomingData"); },
+                function,
+                args);
     }
 
     return true;
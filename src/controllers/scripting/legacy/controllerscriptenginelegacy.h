@@ -7,6 +7,7 @@
 
 #include "controllers/legacycontrollermapping.h"
 #include "controllers/scripting/controllerscriptenginebase.h"
+#include "util/duration.h"
 
 /// ControllerScriptEngineLegacy loads and executes controller scripts for the legacy
 /// JS/XML hybrid controller mapping system.
@@ -26,6 +27,16 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
     /// and ensures the function is executed with the correct 'this' object.
     QJSValue wrapFunctionCode(const QString& codeSnippet, int numberOfArgs);
 
+    /// Set the timestamp of the input message that is handled by the script
+    /// functions called next. Reset it to an empty duration afterwards, so
+    /// calls from timers and connections are not attributed to old input.
+    void setInputTimestamp(mixxx::Duration timestamp) {
+        m_inputTimestamp = timestamp;
+    }
+    mixxx::Duration inputTimestamp() const {
+        return m_inputTimestamp;
+    }
+
   public slots:
     void setScriptFiles(const QList<LegacyControllerMapping::ScriptFileInfo>& scripts);
 
@@ -47,6 +58,8 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
 
     QFileSystemWatcher m_fileWatcher;
 
+    mixxx::Duration m_inputTimestamp;
+
     // There is lots of tight coupling between ControllerScriptEngineLegacy
     // and ControllerScriptInterface. This is probably not worth improving in legacy code.
     friend class ControllerScriptInterfaceLegacy;
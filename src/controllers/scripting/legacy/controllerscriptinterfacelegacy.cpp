@@ -4,6 +4,8 @@
 #include "control/controlobjectscript.h"
 #include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
 #include "controllers/scripting/legacy/scriptconnectionjsproxy.h"
+#include "controllers/scripting/legacy/scriptcontroljsproxy.h"
+#include "engine/jogscratchinput.h"
 #include "mixer/playermanager.h"
 #include "moc_controllerscriptinterfacelegacy.cpp"
 #include "util/fpclassify.h"
@@ -20,6 +22,17 @@ constexpr int kScratchTimerMs = 1;
 constexpr double kAlphaBetaDt = kScratchTimerMs / 1000.0;
 // stop ramping at a rate which doesn't produce any audible output anymore
 constexpr double kBrakeRampToRate = 0.01;
+
+// Limits the name of anonymous timer callbacks, which is their source code
+constexpr int kMaxTimerCallbackNameLength = 60;
+
+QString timerCallbackName(const QJSValue& callback) {
+    const QString name = callback.property(QStringLiteral("name")).toString();
+    if (!name.isEmpty()) {
+        return name;
+    }
+    return callback.toString().simplified().left(kMaxTimerCallbackNameLength);
+}
 } // namespace
 
 ControllerScriptInterfaceLegacy::ControllerScriptInterfaceLegacy(
@@ -37,6 +50,7 @@ ControllerScriptInterfaceLegacy::ControllerScriptInterfaceLegacy(
     m_brakeActive.resize(kDecks);
     m_spinbackActive.resize(kDecks);
     m_softStartActive.resize(kDecks);
+    m_timestampedScratch.resize(kDecks);
     // Initialize arrays used for testing and pointers
     for (int i = 0; i < kDecks; ++i) {
         m_dx[i] = 0.0;
@@ -45,6 +59,7 @@ ControllerScriptInterfaceLegacy::ControllerScriptInterfaceLegacy(
         m_brakeActive[i] = false;
         m_spinbackActive[i] = false;
         m_softStartActive[i] = false;
+        m_timestampedScratch[i] = false;
     }
 }
 
@@ -70,6 +85,14 @@ ControllerScriptInterfaceLegacy::~ControllerScriptInterfaceLegacy() {
         }
     }
 
+    for (auto it = m_jogScratchInputs.constBegin();
+            it != m_jogScratchInputs.constEnd();
+            ++it) {
+        if (m_timestampedScratch[it.key()]) {
+            it.value()->disable(mixxx::Time::elapsed(), false);
+        }
+    }
+
     for (int i = 0; i < kDecks; ++i) {
         delete m_scratchFilters[i];
         m_scratchFilters[i] = nullptr;
@@ -108,6 +131,9 @@ ControlObjectScript* ControllerScriptInterfaceLegacy::getControlObjectScript(
 }
 
 double ControllerScriptInterfaceLegacy::getValue(const QString& group, const QString& name) {
+    if (ControllerScriptProfiler* pProfiler = m_pScriptEngineLegacy->scriptProfiler()) {
+        pProfiler->countGetValue();
+    }
     ControlObjectScript* coScript = getControlObjectScript(group, name);
     if (coScript == nullptr) {
         qCWarning(m_logger) << "Unknown control" << group << name
@@ -119,6 +145,9 @@ double ControllerScriptInterfaceLegacy::getValue(const QString& group, const QSt
 
 void ControllerScriptInterfaceLegacy::setValue(
         const QString& group, const QString& name, double newValue) {
+    if (ControllerScriptProfiler* pProfiler = m_pScriptEngineLegacy->scriptProfiler()) {
+        pProfiler->countSetValue();
+    }
     if (util_isnan(newValue)) {
         qCWarning(m_logger) << "script setting [" << group << ","
                             << name << "] to NotANumber, ignoring.";
@@ -128,13 +157,22 @@ void ControllerScriptInterfaceLegacy::setValue(
     ControlObjectScript* coScript = getControlObjectScript(group, name);
 
     if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(
-                coScript->getKey(), ControlFlag::AllowMissingOrInvalid);
-        if (pControl &&
-                !m_st.ignore(
-                        pControl, coScript->getParameterForValue(newValue))) {
-            coScript->set(newValue);
-        }
+        setControlValue(coScript, newValue);
+    }
+}
+
+void ControllerScriptInterfaceLegacy::setControlValue(
+        ControlObjectScript* pControl, double newValue) {
+    if (util_isnan(newValue)) {
+        qCWarning(m_logger) << "script setting [" << pControl->getKey().group << ","
+                            << pControl->getKey().item << "] to NotANumber, ignoring.";
+        return;
+    }
+    ControlObject* pControlObject = pControl->getControlObject();
+    if (pControlObject &&
+            !m_st.ignore(
+                    pControlObject, pControl->getParameterForValue(newValue))) {
+        pControl->set(newValue);
     }
 }
 
@@ -159,11 +197,20 @@ void ControllerScriptInterfaceLegacy::setParameter(
     ControlObjectScript* coScript = getControlObjectScript(group, name);
 
     if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(
-                coScript->getKey(), ControlFlag::AllowMissingOrInvalid);
-        if (pControl && !m_st.ignore(pControl, newParameter)) {
-            coScript->setParameter(newParameter);
-        }
+        setControlParameter(coScript, newParameter);
+    }
+}
+
+void ControllerScriptInterfaceLegacy::setControlParameter(
+        ControlObjectScript* pControl, double newParameter) {
+    if (util_isnan(newParameter)) {
+        qCWarning(m_logger) << "script setting [" << pControl->getKey().group << ","
+                            << pControl->getKey().item << "] to NotANumber, ignoring.";
+        return;
+    }
+    ControlObject* pControlObject = pControl->getControlObject();
+    if (pControlObject && !m_st.ignore(pControlObject, newParameter)) {
+        pControl->setParameter(newParameter);
     }
 }
 
@@ -218,6 +265,48 @@ double ControllerScriptInterfaceLegacy::getDefaultParameter(
     return coScript->getParameterForValue(coScript->getDefault());
 }
 
+QJSValue ControllerScriptInterfaceLegacy::getControl(
+        const QString& group, const QString& name) {
+    auto pJsEngine = m_pScriptEngineLegacy->jsEngine();
+    VERIFY_OR_DEBUG_ASSERT(pJsEngine) {
+        return QJSValue();
+    }
+
+    ControlObjectScript* coScript = getControlObjectScript(group, name);
+    if (coScript == nullptr) {
+        qCWarning(m_logger) << "Unknown control" << group << name
+                            << ", returning undefined";
+        return QJSValue();
+    }
+    return pJsEngine->newQObject(new ScriptControlJSProxy(this, coScript));
+}
+
+void ControllerScriptInterfaceLegacy::setValues(
+        const QJSValue& controls, const QJSValue& values) {
+    if (!controls.isArray() || !values.isArray()) {
+        m_pScriptEngineLegacy->throwJSError(
+                QStringLiteral("engine.setValues expects two arrays"));
+        return;
+    }
+    const int length = controls.property(QStringLiteral("length")).toInt();
+    if (values.property(QStringLiteral("length")).toInt() != length) {
+        m_pScriptEngineLegacy->throwJSError(QStringLiteral(
+                "engine.setValues expects arrays of the same length"));
+        return;
+    }
+    for (int i = 0; i < length; ++i) {
+        auto* pProxy = qobject_cast<ScriptControlJSProxy*>(
+                controls.property(i).toQObject());
+        if (pProxy == nullptr) {
+            qCWarning(m_logger) << "engine.setValues: element" << i
+                                << "is not a control returned by engine.getControl";
+            continue;
+        }
+        // Go through the proxy, it knows whether its control still exists
+        pProxy->set(values.property(i).toNumber());
+    }
+}
+
 QJSValue ControllerScriptInterfaceLegacy::makeConnection(
         const QString& group, const QString& name, const QJSValue& callback) {
     return ControllerScriptInterfaceLegacy::makeConnectionInternal(group, name, callback, false);
@@ -522,7 +611,13 @@ void ControllerScriptInterfaceLegacy::timerEvent(QTimerEvent* event) {
         stopTimer(timerId);
     }
 
-    m_pScriptEngineLegacy->executeFunction(timerTarget.callback);
+    // Timers fire at a regular interval and some mappings use them for big
+    // LED refreshes, which must not delay input like jog wheel movements.
+    m_pScriptEngineLegacy->dispatchPendingInput();
+    m_pScriptEngineLegacy->executeFunction(
+            ControllerScriptProfiler::CallbackType::Timer,
+            [&timerTarget] { return timerCallbackName(timerTarget.callback); },
+            timerTarget.callback);
 }
 
 void ControllerScriptInterfaceLegacy::softTakeover(
@@ -607,12 +702,19 @@ void ControllerScriptInterfaceLegacy::scratchEnable(int deck,
         double rpm,
         double alpha,
         double beta,
-        bool ramp) {
+        bool ramp,
+        bool timestamped) {
     // If we're already scratching this deck, override that with this request
+    bool stoppedScratchTimer = false;
     if (static_cast<bool>(m_dx[deck])) {
         //qCDebug(m_logger) << "Already scratching deck" << deck << ". Overriding.";
-        int timerId = m_scratchTimers.key(deck);
-        stopScratchTimer(timerId);
+        if (m_timestampedScratch[deck]) {
+            jogScratchInput(deck)->disable(inputTimestamp(), false);
+        } else {
+            int timerId = m_scratchTimers.key(deck);
+            stopScratchTimer(timerId);
+            stoppedScratchTimer = true;
+        }
     }
 
     // Controller resolution in intervals per second at normal speed.
@@ -630,16 +732,27 @@ void ControllerScriptInterfaceLegacy::scratchEnable(int deck,
     m_ramp[deck] = false;
     m_rampFactor[deck] = 0.001;
     m_brakeActive[deck] = false;
+    m_timestampedScratch[deck] = timestamped;
 
     // PlayerManager::groupForDeck is 0-indexed.
     QString group = PlayerManager::groupForDeck(deck - 1);
 
-    // Ramp velocity, default to stopped.
-    double initVelocity = 0.0;
-
     ControlObjectScript* pScratch2Enable =
             getControlObjectScript(group, "scratch2_enable");
 
+    if (timestamped) {
+        // The engine follows the timestamped movements directly, alpha, beta
+        // and ramp only apply to the filtered scratching.
+        if (stoppedScratchTimer && pScratch2Enable != nullptr) {
+            pScratch2Enable->set(0);
+        }
+        jogScratchInput(deck)->enable(inputTimestamp());
+        return;
+    }
+
+    // Ramp velocity, default to stopped.
+    double initVelocity = 0.0;
+
     // If ramping is desired, figure out the deck's current speed
     if (ramp) {
         // See if the deck is already being scratched
@@ -678,6 +791,10 @@ void ControllerScriptInterfaceLegacy::scratchEnable(int deck,
 }
 
 void ControllerScriptInterfaceLegacy::scratchTick(int deck, int interval) {
+    if (m_timestampedScratch[deck]) {
+        jogScratchInput(deck)->move(m_dx[deck] * interval, inputTimestamp());
+        return;
+    }
     m_lastMovement[deck] = mixxx::Time::elapsed();
     m_intervalAccumulator[deck] += interval;
 }
@@ -791,6 +908,15 @@ void ControllerScriptInterfaceLegacy::scratchProcess(int timerId) {
 }
 
 void ControllerScriptInterfaceLegacy::scratchDisable(int deck, bool ramp) {
+    if (m_timestampedScratch[deck]) {
+        // The engine finishes the movements up to now and throws the record
+        // on its own if ramping is requested.
+        jogScratchInput(deck)->disable(inputTimestamp(), ramp);
+        m_timestampedScratch[deck] = false;
+        m_dx[deck] = 0.0;
+        return;
+    }
+
     // PlayerManager::groupForDeck is 0-indexed.
     QString group = PlayerManager::groupForDeck(deck - 1);
 
@@ -817,7 +943,25 @@ void ControllerScriptInterfaceLegacy::scratchDisable(int deck, bool ramp) {
 bool ControllerScriptInterfaceLegacy::isScratching(int deck) {
     // PlayerManager::groupForDeck is 0-indexed.
     QString group = PlayerManager::groupForDeck(deck - 1);
-    return getValue(group, "scratch2_enable") > 0;
+    return m_timestampedScratch[deck] || getValue(group, "scratch2_enable") > 0;
+}
+
+JogScratchInput* ControllerScriptInterfaceLegacy::jogScratchInput(int deck) {
+    QSharedPointer<JogScratchInput>& pInput = m_jogScratchInputs[deck];
+    if (pInput.isNull()) {
+        // PlayerManager::groupForDeck is 0-indexed.
+        pInput = JogScratchInput::getJogScratchInput(PlayerManager::groupForDeck(deck - 1));
+    }
+    return pInput.data();
+}
+
+mixxx::Duration ControllerScriptInterfaceLegacy::inputTimestamp() const {
+    const mixxx::Duration timestamp = m_pScriptEngineLegacy->inputTimestamp();
+    if (timestamp == mixxx::Duration::empty()) {
+        // Called from a timer or a connection
+        return mixxx::Time::elapsed();
+    }
+    return timestamp;
 }
 
 void ControllerScriptInterfaceLegacy::spinback(
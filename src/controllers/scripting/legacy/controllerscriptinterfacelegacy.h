@@ -2,12 +2,14 @@
 
 #include <QJSValue>
 #include <QObject>
+#include <QSharedPointer>
 
 #include "controllers/softtakeover.h"
 #include "util/alphabetafilter.h"
 #include "util/runtimeloggingcategory.h"
 
 class ControllerScriptEngineLegacy;
+class JogScratchInput;
 class ControlObjectScript;
 class ScriptConnection;
 class ConfigKey;
@@ -31,6 +33,13 @@ class ControllerScriptInterfaceLegacy : public QObject {
     Q_INVOKABLE void reset(const QString& group, const QString& name);
     Q_INVOKABLE double getDefaultValue(const QString& group, const QString& name);
     Q_INVOKABLE double getDefaultParameter(const QString& group, const QString& name);
+    /// Returns a handle to the control with get/set/getParameter/
+    /// setParameter/reset functions, which skip the lookup by group and name
+    /// of the functions above. Returns undefined for unknown controls.
+    Q_INVOKABLE QJSValue getControl(const QString& group, const QString& name);
+    /// Sets the values of an array of control handles to the values of an
+    /// array of the same length in a single call
+    Q_INVOKABLE void setValues(const QJSValue& controls, const QJSValue& values);
     Q_INVOKABLE QJSValue makeConnection(const QString& group,
             const QString& name,
             const QJSValue& callback);
@@ -52,7 +61,8 @@ class ControllerScriptInterfaceLegacy : public QObject {
             double rpm,
             double alpha,
             double beta,
-            bool ramp = true);
+            bool ramp = true,
+            bool timestamped = false);
     Q_INVOKABLE void scratchTick(int deck, int interval);
     Q_INVOKABLE void scratchDisable(int deck, bool ramp = true);
     Q_INVOKABLE bool isScratching(int deck);
@@ -68,6 +78,11 @@ class ControllerScriptInterfaceLegacy : public QObject {
             const double rate = -10.0);
     Q_INVOKABLE void softStart(const int deck, bool activate, double factor = 1.0);
 
+    /// Set a control like engine.setValue, respecting soft takeover
+    void setControlValue(ControlObjectScript* pControl, double newValue);
+    /// Set a control like engine.setParameter, respecting soft takeover
+    void setControlParameter(ControlObjectScript* pControl, double newParameter);
+
     bool removeScriptConnection(const ScriptConnection& conn);
     /// Execute a ScriptConnection's JS callback
     void triggerScriptConnection(const ScriptConnection& conn);
@@ -95,6 +110,10 @@ class ControllerScriptInterfaceLegacy : public QObject {
     QVarLengthArray<mixxx::Duration> m_lastMovement;
     QVarLengthArray<double> m_dx, m_rampTo, m_rampFactor;
     QVarLengthArray<bool> m_ramp, m_brakeActive, m_spinbackActive, m_softStartActive;
+    /// Decks whose movements are passed to the engine with their timestamps
+    /// instead of being filtered by scratchProcess
+    QVarLengthArray<bool> m_timestampedScratch;
+    QHash<int, QSharedPointer<JogScratchInput>> m_jogScratchInputs;
     QVarLengthArray<AlphaBetaFilter*> m_scratchFilters;
     QHash<int, int> m_scratchTimers;
     /// Applies the accumulated movement to the track speed
@@ -104,6 +123,9 @@ class ControllerScriptInterfaceLegacy : public QObject {
     void stopDeck(const QString& group);
     bool isTrackLoaded(const QString& group);
     double getDeckRate(const QString& group);
+    JogScratchInput* jogScratchInput(int deck);
+    /// The timestamp of the handled input message or the current time
+    mixxx::Duration inputTimestamp() const;
 
     ControllerScriptEngineLegacy* m_pScriptEngineLegacy;
     const RuntimeLoggingCategory m_logger;
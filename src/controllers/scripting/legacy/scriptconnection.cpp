@@ -1,6 +1,7 @@
 #include "controllers/scripting/legacy/scriptconnection.h"
 
 #include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
+#include "util/performancetimer.h"
 #include "util/trace.h"
 
 void ScriptConnection::executeCallback(double value) const {
@@ -11,7 +12,14 @@ void ScriptConnection::executeCallback(double value) const {
             key.item,
     };
     QJSValue func = callback; // copy function because QJSValue::call is not const
+    PerformanceTimer timer;
+    timer.start();
     QJSValue result = func.call(args);
+    if (controllerEngine != nullptr) {
+        controllerEngine->profileCallback(ControllerScriptProfiler::CallbackType::Connection,
+                timer.elapsed(),
+                [this] { return key.group + QLatin1Char(',') + key.item; });
+    }
     if (result.isError()) {
         if (controllerEngine != nullptr) {
             controllerEngine->showScriptExceptionDialog(result);
@@ -0,0 +1,39 @@
+#include "controllers/scripting/legacy/scriptcontroljsproxy.h"
+
+#include "controllers/scripting/legacy/controllerscriptinterfacelegacy.h"
+#include "moc_scriptcontroljsproxy.cpp"
+
+double ScriptControlJSProxy::get() const {
+    if (!m_pControl) {
+        return 0.0;
+    }
+    return m_pControl->get();
+}
+
+void ScriptControlJSProxy::set(double newValue) {
+    if (!m_pEngineJSProxy || !m_pControl) {
+        return;
+    }
+    m_pEngineJSProxy->setControlValue(m_pControl, newValue);
+}
+
+double ScriptControlJSProxy::getParameter() const {
+    if (!m_pControl) {
+        return 0.0;
+    }
+    return m_pControl->getParameter();
+}
+
+void ScriptControlJSProxy::setParameter(double newParameter) {
+    if (!m_pEngineJSProxy || !m_pControl) {
+        return;
+    }
+    m_pEngineJSProxy->setControlParameter(m_pControl, newParameter);
+}
+
+void ScriptControlJSProxy::reset() {
+    if (!m_pControl) {
+        return;
+    }
+    m_pControl->reset();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+
+#include "control/controlobjectscript.h"
+
+class ControllerScriptInterfaceLegacy;
+
+/// ScriptControlJSProxy provides scripts with a handle to a single control.
+/// Unlike engine.getValue/setValue it does not look up the control by its
+/// group and name on every access.
+class ScriptControlJSProxy : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QString group READ readGroup)
+    Q_PROPERTY(QString name READ readName)
+  public:
+    ScriptControlJSProxy(ControllerScriptInterfaceLegacy* pEngineJSProxy,
+            ControlObjectScript* pControl)
+            : m_pEngineJSProxy(pEngineJSProxy),
+              m_pControl(pControl),
+              m_key(pControl->getKey()) {
+    }
+    const QString& readGroup() const {
+        return m_key.group;
+    }
+    const QString& readName() const {
+        return m_key.item;
+    }
+    Q_INVOKABLE double get() const;
+    Q_INVOKABLE void set(double newValue);
+    Q_INVOKABLE double getParameter() const;
+    Q_INVOKABLE void setParameter(double newParameter);
+    Q_INVOKABLE void reset();
+
+  private:
+    // Both are owned by the script engine and may be gone during its shutdown
+    QPointer<ControllerScriptInterfaceLegacy> m_pEngineJSProxy;
+    QPointer<ControlObjectScript> m_pControl;
+    const ConfigKey m_key;
+};
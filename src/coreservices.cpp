@@ -1,9 +1,12 @@
 #include "coreservices.h"
 
 #include <QApplication>
+#include <QDateTime>
+#include <QDir>
 #include <QFileDialog>
 #include <QPushButton>
 #include <QStandardPaths>
+#include <QtConcurrentRun>
 
 #ifdef __BROADCAST__
 #include "broadcast/broadcastmanager.h"
@@ -22,19 +25,29 @@
 #include "mixer/playerinfo.h"
 #include "mixer/playermanager.h"
 #include "moc_coreservices.cpp"
+#include "musicbrainz/lookupcache.h"
+#include "network/controlserver.h"
+#include "network/metricsserver.h"
 #include "preferences/settingsmanager.h"
 #ifdef __MODPLUG__
 #include "preferences/dialog/dlgprefmodplug.h"
 #endif
 #include "soundio/soundmanager.h"
+#ifdef __MAD__
+#include "sources/soundsourcemp3.h"
+#endif
 #include "sources/soundsourceproxy.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/font.h"
 #include "util/logger.h"
+#include "util/memoryaccounting.h"
+#include "util/performancetimer.h"
+#include "util/realtimeprofile.h"
 #include "util/screensaver.h"
 #include "util/screensavermanager.h"
 #include "util/statsmanager.h"
 #include "util/time.h"
+#include "util/tracerecorder.h"
 #include "util/translations.h"
 #include "util/versionstore.h"
 #include "vinylcontrol/vinylcontrolmanager.h"
@@ -60,6 +73,8 @@ namespace {
 const mixxx::Logger kLogger("CoreServices");
 constexpr int kMicrophoneCount = 4;
 constexpr int kAuxiliaryCount = 4;
+// Covers a dropout that has been noticed by the user a few seconds later
+const auto kTraceSaveWindow = mixxx::Duration::fromSeconds(10);
 
 #define CLEAR_AND_CHECK_DELETED(x) clearHelper(x, #x);
 
@@ -100,6 +115,64 @@ inline QLocale inputLocale() {
     QInputMethod* pInputMethod = QGuiApplication::inputMethod();
     return pInputMethod ? pInputMethod->locale() : QLocale(QLocale::English);
 }
+
+/// Records the duration of the initialization phases, which are logged as a
+/// startup timeline in developer mode.
+class StartupTimeline {
+  public:
+    StartupTimeline()
+            : m_enabled(CmdlineArgs::Instance().getDeveloper()) {
+        if (m_enabled) {
+            m_timer.start();
+        }
+    }
+
+    /// Ends the current phase, if any, and starts the next one.
+    void startPhase(const QString& name) {
+        if (!m_enabled) {
+            return;
+        }
+        endPhase();
+        m_currentPhase = name;
+        m_phaseStart = m_timer.elapsed();
+    }
+
+    void log() {
+        if (!m_enabled) {
+            return;
+        }
+        endPhase();
+        const mixxx::Duration total = m_timer.elapsed();
+        kLogger.info() << "Startup timeline, total" << total.formatMillisWithUnit();
+        for (const auto& phase : std::as_const(m_phases)) {
+            kLogger.info()
+                    << " " << phase.startOffset.formatMillisWithUnit()
+                    << "+" << phase.duration.formatMillisWithUnit()
+                    << phase.name;
+        }
+    }
+
+  private:
+    struct Phase {
+        QString name;
+        mixxx::Duration startOffset;
+        mixxx::Duration duration;
+    };
+
+    void endPhase() {
+        if (m_currentPhase.isEmpty()) {
+            return;
+        }
+        m_phases.append(Phase{m_currentPhase, m_phaseStart, m_timer.elapsed() - m_phaseStart});
+        m_currentPhase.clear();
+    }
+
+    const bool m_enabled;
+    PerformanceTimer m_timer;
+    QString m_currentPhase;
+    mixxx::Duration m_phaseStart;
+    QList<Phase> m_phases;
+};
 } // anonymous namespace
 
 namespace mixxx {
@@ -120,6 +193,9 @@ CoreServices::CoreServices(const CmdlineArgs& args, QApplication* pApp)
     if (m_cmdlineArgs.getDeveloper()) {
         StatsManager::createInstance();
     }
+    if (m_cmdlineArgs.getTraceRecorder()) {
+        mixxx::TraceRecorder::enable();
+    }
     mixxx::Translations::initializeTranslations(
             m_pSettingsManager->settings(), pApp, m_cmdlineArgs.getLocale());
     initializeKeyboard();
@@ -194,7 +270,7 @@ void CoreServices::initializeSettings() {
 }
 
 void CoreServices::initializeLogging() {
-    mixxx::LogFlags logFlags = mixxx::LogFlag::LogToFile;
+    mixxx::LogFlags logFlags = mixxx::LogFlag::LogToFile | mixxx::LogFlag::AsyncWrite;
     if (m_cmdlineArgs.getDebugAssertBreak()) {
         logFlags.setFlag(mixxx::LogFlag::DebugAssertBreak);
     }
@@ -236,9 +312,21 @@ void CoreServices::initialize(QApplication* pApp) {
 
     QString resourcePath = pConfig->getResourcePath();
 
+    StartupTimeline timeline;
+
+    // Enumerating the sound devices may take several seconds and is only
+    // needed when the SoundManager is created
+    SoundManager::startPortAudioInitialization();
+
     emit initializationProgressUpdate(0, tr("fonts"));
+    timeline.startPhase(QStringLiteral("fonts and database"));
 
-    FontUtils::initializeFonts(resourcePath); // takes a long time
+    // Adding the fonts takes a long time. The font database is thread-safe
+    // and the fonts are not needed before the first widget is created, so
+    // they are added while the database is opened and upgraded.
+    QFuture<void> fontsFuture = QtConcurrent::run([resourcePath] {
+        FontUtils::initializeFonts(resourcePath);
+    });
 
     emit initializationProgressUpdate(10, tr("database"));
     m_pDbConnectionPool = MixxxDb(pConfig).connectionPool();
@@ -250,14 +338,18 @@ void CoreServices::initialize(QApplication* pApp) {
     if (!initializeDatabase()) {
         exit(-1);
     }
+    fontsFuture.waitForFinished();
 
     m_pControlIndicatorTimer = std::make_shared<mixxx::ControlIndicatorTimer>(this);
 
     auto pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
 
     emit initializationProgressUpdate(20, tr("effects"));
+    timeline.startPhase(QStringLiteral("effects and engine"));
     m_pEffectsManager = std::make_shared<EffectsManager>(pConfig, pChannelHandleFactory);
 
+    // Before the engine allocates the buffers that are locked by the profile
+    mixxx::RealtimeProfile::setSettings(mixxx::RealtimeProfile::readSettings(pConfig));
     m_pEngine = std::make_shared<EngineMaster>(
             pConfig,
             "[Master]",
@@ -266,6 +358,7 @@ void CoreServices::initialize(QApplication* pApp) {
             true);
 
     emit initializationProgressUpdate(30, tr("audio interface"));
+    timeline.startPhase(QStringLiteral("audio interface"));
     // Although m_pSoundManager is created here, m_pSoundManager->setupDevices()
     // needs to be called after m_pPlayerManager registers sound IO for each EngineChannel.
     m_pSoundManager = std::make_shared<SoundManager>(pConfig, m_pEngine.get());
@@ -286,6 +379,7 @@ void CoreServices::initialize(QApplication* pApp) {
 #endif
 
     emit initializationProgressUpdate(40, tr("decks"));
+    timeline.startPhase(QStringLiteral("decks"));
     // Create the player manager. (long)
     m_pPlayerManager = std::make_shared<PlayerManager>(
             pConfig,
@@ -331,7 +425,15 @@ void CoreServices::initialize(QApplication* pApp) {
             &ScreensaverManager::slotCurrentPlayingDeckChanged);
 
     emit initializationProgressUpdate(50, tr("library"));
-    CoverArtCache::createInstance();
+    timeline.startPhase(QStringLiteral("library"));
+    CoverArtCache::createInstance()->setThumbnailDirectory(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("covercache")));
+    mixxx::musicbrainz::LookupCache::setDirectory(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("musicbrainz")));
+#ifdef __MAD__
+    mixxx::SoundSourceMp3::setSeekIndexDirectory(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("mp3seekindex")));
+#endif
 
     m_pTrackCollectionManager = std::make_shared<TrackCollectionManager>(
             this,
@@ -374,6 +476,7 @@ void CoreServices::initialize(QApplication* pApp) {
     }
 
     emit initializationProgressUpdate(60, tr("controllers"));
+    timeline.startPhase(QStringLiteral("controllers"));
     // Initialize controller sub-system,
     // but do not set up controllers until the end of the application startup
     // (long)
@@ -384,6 +487,8 @@ void CoreServices::initialize(QApplication* pApp) {
     // controllers
     m_pControllerManager->setUpDevices();
 
+    timeline.startPhase(QStringLiteral("library scan and samplers"));
+
     // Scan the library for new files and directories
     bool rescan = pConfig->getValue<bool>(
             library::prefs::kRescanOnStartupConfigKey);
@@ -434,6 +539,16 @@ void CoreServices::initialize(QApplication* pApp) {
 
     m_pTouchShift = std::make_unique<ControlPushButton>(ConfigKey("[Controls]", "touch_shift"));
 
+    m_pTraceSave = std::make_unique<ControlPushButton>(ConfigKey("[Master]", "trace_save"));
+    connect(m_pTraceSave.get(),
+            &ControlObject::valueChanged,
+            this,
+            [this](double value) {
+                if (value > 0) {
+                    saveTrace();
+                }
+            });
+
     // The following UI controls must be created here so that controllers can bind to them
     // on startup.
     m_uiControls.clear();
@@ -462,6 +577,17 @@ void CoreServices::initialize(QApplication* pApp) {
         m_uiControls.back()->setButtonMode(ControlPushButton::TOGGLE);
     }
 
+    // Like controllers, remote clients may only subscribe to controls after
+    // all of them have been created
+    m_pControlServer = std::make_shared<network::ControlServer>(pConfig);
+    m_pControlServer->start();
+
+    m_pMetricsServer = std::make_shared<network::MetricsServer>(pConfig);
+    m_pMetricsServer->start();
+
+    // Applies the cover art budget after CoverArtCache has been created
+    m_pMemoryAccounting = std::make_shared<MemoryAccounting>(pConfig);
+
     // Load tracks in args.qlMusicFiles (command line arguments) into player
     // 1 and 2:
     const QList<QString>& musicFiles = m_cmdlineArgs.getMusicFiles();
@@ -471,9 +597,26 @@ void CoreServices::initialize(QApplication* pApp) {
         }
     }
 
+    timeline.log();
     m_isInitialized = true;
 }
 
+void CoreServices::saveTrace() {
+    if (!TraceRecorder::isEnabled()) {
+        qWarning() << "Not saving the trace, start Mixxx with --trace-recorder to record it";
+        return;
+    }
+    const QString fileName = QStringLiteral("trace-%1.json")
+                                     .arg(QDateTime::currentDateTime().toString(
+                                             QStringLiteral("yyyyMMdd-hhmmss")));
+    const QString filePath =
+            QDir(m_pSettingsManager->settings()->getSettingsPath()).filePath(fileName);
+    if (TraceRecorder::writeChromeTrace(filePath, kTraceSaveWindow)) {
+        qInfo() << "Saved the trace of the last" << kTraceSaveWindow.formatSecondsWithUnit()
+                << "to" << filePath;
+    }
+}
+
 void CoreServices::initializeKeyboard() {
     UserSettingsPointer pConfig = m_pSettingsManager->settings();
     QString resourcePath = pConfig->getResourcePath();
@@ -572,6 +715,12 @@ void CoreServices::finalize() {
     qDebug() << t.elapsed(false).debugMillisWithUnit() << "saving configuration";
     m_pSettingsManager->save();
 
+    // ControlServer depends on the controls of all other components
+    qDebug() << t.elapsed(false).debugMillisWithUnit() << "deleting ControlServer";
+    CLEAR_AND_CHECK_DELETED(m_pControlServer);
+    CLEAR_AND_CHECK_DELETED(m_pMetricsServer);
+    CLEAR_AND_CHECK_DELETED(m_pMemoryAccounting);
+
     // SoundManager depend on Engine and Config
     qDebug() << t.elapsed(false).debugMillisWithUnit() << "deleting SoundManager";
     CLEAR_AND_CHECK_DELETED(m_pSoundManager);
@@ -635,6 +784,7 @@ void CoreServices::finalize() {
     m_pDbConnectionPool.reset(); // should drop the last reference
 
     m_pTouchShift.reset();
+    m_pTraceSave.reset();
 
     m_uiControls.clear();
 
@@ -31,8 +31,14 @@ namespace mixxx {
 
 class ControlIndicatorTimer;
 class DbConnectionPool;
+class MemoryAccounting;
 class ScreensaverManager;
 
+namespace network {
+class ControlServer;
+class MetricsServer;
+} // namespace network
+
 class CoreServices : public QObject {
     Q_OBJECT
 
@@ -121,6 +127,8 @@ class CoreServices : public QObject {
     void initializeSettings();
     void initializeScreensaverManager();
     void initializeLogging();
+    /// Saves the recent regions of the TraceRecorder into the settings directory
+    void saveTrace();
 
     /// Tear down CoreServices that were previously initialized by `initialize()`.
     void finalize();
@@ -151,8 +159,13 @@ class CoreServices : public QObject {
 
     std::shared_ptr<mixxx::ScreensaverManager> m_pScreensaverManager;
 
+    std::shared_ptr<network::ControlServer> m_pControlServer;
+    std::shared_ptr<network::MetricsServer> m_pMetricsServer;
+    std::shared_ptr<MemoryAccounting> m_pMemoryAccounting;
+
     std::vector<std::unique_ptr<ControlPushButton>> m_uiControls;
     std::unique_ptr<ControlPushButton> m_pTouchShift;
+    std::unique_ptr<ControlPushButton> m_pTraceSave;
 
     Timer m_runtime_timer;
     const CmdlineArgs& m_cmdlineArgs;
@@ -12,7 +12,7 @@
 const QString MixxxDb::kDefaultSchemaFile(":/schema.xml");
 
 //static
-const int MixxxDb::kRequiredSchemaVersion = 39;
+const int MixxxDb::kRequiredSchemaVersion = 44;
 
 namespace {
 
@@ -30,6 +30,29 @@ const QString kUserName = QStringLiteral("mixxx");
 
 const QString kPassword = QStringLiteral("mixxx");
 
+// The journal mode is persistent and can't be changed within a
+// transaction, i.e. not by a schema migration. Readers don't block
+// the writer and vice versa in WAL mode, e.g. while the library
+// scanner imports tracks.
+// https://www.sqlite.org/wal.html
+const QStringList kOpenStatements = {
+        QStringLiteral("PRAGMA journal_mode=WAL"),
+        // Safe in WAL mode: Committed transactions might be rolled back
+        // after a power loss, but the database won't be corrupted
+        QStringLiteral("PRAGMA synchronous=NORMAL"),
+        // 16 MiB per connection, negative values are in KiB
+        QStringLiteral("PRAGMA cache_size=-16384"),
+        // 256 MiB
+        QStringLiteral("PRAGMA mmap_size=268435456"),
+};
+
+// Updates the query planner statistics if needed. Recommended to
+// be run before closing long-lived connections.
+// https://www.sqlite.org/pragma.html#pragma_optimize
+const QStringList kCloseStatements = {
+        QStringLiteral("PRAGMA optimize"),
+};
+
 // The connection parameters for the main Mixxx DB
 mixxx::DbConnection::Params dbConnectionParams(
         const UserSettingsPointer& pConfig,
@@ -58,6 +81,8 @@ mixxx::DbConnection::Params dbConnectionParams(
     }
     params.userName = kUserName;
     params.password = kPassword;
+    params.openStatements = kOpenStatements;
+    params.closeStatements = kCloseStatements;
     return params;
 }
 
@@ -223,7 +223,8 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
         SqlTransaction transaction(m_settingsDao.database());
 
         // TODO(XXX) We can't have semicolons in schema.xml for anything other
-        // than statement separators.
+        // than statement separators and within the BEGIN...END body of
+        // triggers.
         QStringList sqlStatements = sql.split(";");
 
         QStringListIterator it(sqlStatements);
@@ -231,6 +232,13 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
         bool result = true;
         while (result && it.hasNext()) {
             QString statement = it.next().trimmed();
+            if (statement.startsWith(QLatin1String("CREATE TRIGGER"), Qt::CaseInsensitive)) {
+                // Rejoin the statements of the trigger body
+                while (it.hasNext() &&
+                        !statement.endsWith(QLatin1String("END"), Qt::CaseInsensitive)) {
+                    statement = (statement + QChar(';') + it.next()).trimmed();
+                }
+            }
             if (statement.isEmpty()) {
                 // skip blank lines
                 continue;
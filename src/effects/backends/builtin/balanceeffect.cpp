@@ -70,8 +70,8 @@ BalanceGroupState::BalanceGroupState(const mixxx::EngineParameters& engineParame
           m_pHighBuf(MAX_BUFFER_LEN),
           m_oldSampleRate(engineParameters.sampleRate()),
           m_freq(kMinCornerHz),
-          m_oldBalance(0),
-          m_oldMidSide(0) {
+          m_balance(0),
+          m_midSide(0) {
     m_low = std::make_unique<EngineFilterLinkwitzRiley4Low>(engineParameters.sampleRate(),
             kMinCornerHz);
     m_high = std::make_unique<EngineFilterLinkwitzRiley4High>(engineParameters.sampleRate(),
@@ -113,13 +113,11 @@ void BalanceEffect::processChannel(
         midSide = static_cast<CSAMPLE_GAIN>(m_pMidSideParameter->value());
     }
 
-    CSAMPLE_GAIN balanceDelta = (balance - pGroupState->m_oldBalance) /
-            CSAMPLE_GAIN(engineParameters.framesPerBuffer());
-    CSAMPLE_GAIN midSideDelta = (midSide - pGroupState->m_oldMidSide) /
-            CSAMPLE_GAIN(engineParameters.framesPerBuffer());
-
-    CSAMPLE_GAIN balanceStart = pGroupState->m_oldBalance + balanceDelta;
-    CSAMPLE_GAIN midSideStart = pGroupState->m_oldMidSide + midSideDelta;
+    // The ramps reach the new values with the last frame
+    const auto balanceRamped = pGroupState->m_balance.rampTo(
+            balance, static_cast<int>(engineParameters.framesPerBuffer()));
+    const auto midSideRamped = pGroupState->m_midSide.rampTo(
+            midSide, static_cast<int>(engineParameters.framesPerBuffer()));
 
     double freq = pGroupState->m_freq;
     if (pGroupState->m_oldSampleRate != engineParameters.sampleRate() ||
@@ -150,13 +148,13 @@ void BalanceEffect::processChannel(
             CSAMPLE side = (pGroupState->m_pHighBuf[i * 2 + 1] -
                                    pGroupState->m_pHighBuf[i * 2]) /
                     2.0f;
-            CSAMPLE_GAIN currentMidSide = midSideStart + midSideDelta * i;
+            const CSAMPLE_GAIN currentMidSide = midSideRamped.getNth(static_cast<int>(i) + 1);
             if (currentMidSide > 0) {
                 mid *= (1 - currentMidSide);
             } else {
                 side *= (1 + currentMidSide);
             }
-            CSAMPLE_GAIN currentBalance = (balanceStart + balanceDelta * i);
+            const CSAMPLE_GAIN currentBalance = balanceRamped.getNth(static_cast<int>(i) + 1);
             if (currentBalance > 0) {
                 pOutput[i * 2] += (mid - side) * (1 - currentBalance);
                 pOutput[i * 2 + 1] += (mid + side);
@@ -172,13 +170,13 @@ void BalanceEffect::processChannel(
         for (SINT i = 0; i < engineParameters.samplesPerBuffer() / 2; ++i) {
             CSAMPLE mid = (pInput[i * 2] + pInput[i * 2 + 1]) / 2.0f;
             CSAMPLE side = (pInput[i * 2 + 1] - pInput[i * 2]) / 2.0f;
-            CSAMPLE_GAIN currentMidSide = midSideStart + midSideDelta * i;
+            const CSAMPLE_GAIN currentMidSide = midSideRamped.getNth(static_cast<int>(i) + 1);
             if (currentMidSide > 0) {
                 mid *= (1 - currentMidSide);
             } else {
                 side *= (1 + currentMidSide);
             }
-            CSAMPLE_GAIN currentBalance = (balanceStart + balanceDelta * i);
+            const CSAMPLE_GAIN currentBalance = balanceRamped.getNth(static_cast<int>(i) + 1);
             if (currentBalance > 0) {
                 pOutput[i * 2] = (mid - side) * (1 - currentBalance);
                 pOutput[i * 2 + 1] = (mid + side);
@@ -189,7 +187,5 @@ void BalanceEffect::processChannel(
         }
     }
 
-    pGroupState->m_oldBalance = balance;
-    pGroupState->m_oldMidSide = midSide;
     pGroupState->m_freq = freq;
 }
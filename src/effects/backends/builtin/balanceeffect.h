@@ -5,6 +5,7 @@
 #include "engine/effects/engineeffectparameter.h"
 #include "engine/filters/enginefilterlinkwitzriley4.h"
 #include "util/memory.h"
+#include "util/rampingvalue.h"
 #include "util/samplebuffer.h"
 
 class BalanceGroupState : public EffectState {
@@ -22,8 +23,8 @@ class BalanceGroupState : public EffectState {
     mixxx::audio::SampleRate m_oldSampleRate;
     double m_freq;
 
-    CSAMPLE m_oldBalance;
-    CSAMPLE m_oldMidSide;
+    SmoothedValue<CSAMPLE_GAIN> m_balance;
+    SmoothedValue<CSAMPLE_GAIN> m_midSide;
 };
 
 class BalanceEffect : public EffectProcessorImpl<BalanceGroupState> {
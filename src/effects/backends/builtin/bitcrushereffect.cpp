@@ -2,6 +2,13 @@
 
 #include "util/sample.h"
 
+namespace {
+
+// Quantization produces harmonics far above the Nyquist frequency
+constexpr int kOversamplingFactor = 4;
+
+} // anonymous namespace
+
 // static
 QString BitCrusherEffect::getId() {
     return "org.mixxx.effects.bitcrusher";
@@ -18,6 +25,7 @@ EffectManifestPointer BitCrusherEffect::getManifest() {
     pManifest->setDescription(QObject::tr(
             "Adds noise by the reducing the bit depth and sample rate"));
     pManifest->setEffectRampsFromDry(true);
+    pManifest->setOversamplingFactor(kOversamplingFactor);
 
     EffectManifestParameterPointer depth = pManifest->addParameter();
     depth->setId("bit_depth");
@@ -72,6 +80,11 @@ void BitCrusherEffect::processChannel(
 
     const auto downsample = static_cast<CSAMPLE>(
             m_pDownsampleParameter ? m_pDownsampleParameter->value() : 0.0);
+    // The downsampling is relative to the engine sample rate. Every
+    // oversampled frame is held if the signal is not downsampled.
+    const CSAMPLE holdIncrement = downsample >= 1.0f
+            ? 1.0f
+            : downsample / kOversamplingFactor;
 
     auto bit_depth = static_cast<CSAMPLE>(
             m_pBitDepthParameter ? m_pBitDepthParameter->value() : 16);
@@ -85,7 +98,7 @@ void BitCrusherEffect::processChannel(
     for (SINT i = 0;
             i < engineParameters.samplesPerBuffer();
             i += engineParameters.channelCount()) {
-        pState->accumulator += downsample;
+        pState->accumulator += holdIncrement;
 
         if (pState->accumulator >= 1.0) {
             pState->accumulator -= 1.0f;
@@ -0,0 +1,302 @@
+#include "effects/backends/builtin/convolutionreverbeffect.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace {
+
+constexpr int kFftSize = 2 * ConvolutionReverbGroupState::kPartitionFrames;
+constexpr int kBinCount = kFftSize / 2 + 1;
+
+// The impulse response decays by 60 dB within the decay time
+const double kLn1000 = std::log(1000.0);
+
+// Variance of uniformly distributed noise in [-1, 1]
+constexpr double kNoiseVariance = 1.0 / 3.0;
+
+// Different seeds decorrelate the tails of both channels
+constexpr std::minstd_rand::result_type kNoiseSeeds[] = {20210219, 19840427};
+
+} // anonymous namespace
+
+ConvolutionReverbGroupState::ConvolutionReverbGroupState(
+        const mixxx::EngineParameters& engineParameters)
+        : EffectState(engineParameters),
+          send(0),
+          m_partitionCount(math_max(1,
+                  static_cast<int>(std::ceil(kMaxDecaySeconds *
+                          engineParameters.sampleRate().toDouble() /
+                          kPartitionFrames)))),
+          m_fft(kFftSize),
+          m_fftTime(kFftSize),
+          m_fftReal(kFftSize),
+          m_fftImag(kFftSize),
+          m_blockPosition(0),
+          m_newestSpectrum(0),
+          m_validSpectra(0),
+          m_nextPartition(1),
+          m_activePartitions(0),
+          m_partitionDecay(0),
+          m_wetGain(0) {
+    // The impulse response is white noise with an exponentially decaying
+    // envelope. The envelope is applied per partition while processing,
+    // which allows to change the decay time without transforming the
+    // impulse response again.
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    for (int c = 0; c < 2; ++c) {
+        Channel& channel = m_channels[c];
+        channel.input.assign(kFftSize, 0);
+        channel.output.assign(kPartitionFrames, 0);
+        channel.irReal.resize(m_partitionCount * kBinCount);
+        channel.irImag.resize(m_partitionCount * kBinCount);
+        channel.inputReal.assign(m_partitionCount * kBinCount, 0);
+        channel.inputImag.assign(m_partitionCount * kBinCount, 0);
+        channel.accumulatorReal.assign(kBinCount, 0);
+        channel.accumulatorImag.assign(kBinCount, 0);
+
+        std::minstd_rand generator(kNoiseSeeds[c]);
+        for (int k = 0; k < m_partitionCount; ++k) {
+            // Each partition is zero-padded to the FFT size
+            for (int i = 0; i < kPartitionFrames; ++i) {
+                m_fftTime[i] = noise(generator);
+            }
+            std::fill(m_fftTime.begin() + kPartitionFrames, m_fftTime.end(), 0);
+            m_fft.forward(m_fftTime.data(), m_fftReal.data(), m_fftImag.data());
+            for (int b = 0; b < kBinCount; ++b) {
+                channel.irReal[k * kBinCount + b] = static_cast<float>(m_fftReal[b]);
+                channel.irImag[k * kBinCount + b] = static_cast<float>(m_fftImag[b]);
+            }
+        }
+    }
+}
+
+void ConvolutionReverbGroupState::clear() {
+    for (auto& channel : m_channels) {
+        std::fill(channel.input.begin(), channel.input.end(), 0);
+        std::fill(channel.output.begin(), channel.output.end(), 0);
+        std::fill(channel.accumulatorReal.begin(), channel.accumulatorReal.end(), 0);
+        std::fill(channel.accumulatorImag.begin(), channel.accumulatorImag.end(), 0);
+    }
+    // The stored input spectra are ignored instead of clearing them
+    m_validSpectra = 0;
+    m_blockPosition = 0;
+    send.reset(0);
+}
+
+void ConvolutionReverbGroupState::startBlock(double sampleRate, double decaySeconds) {
+    const double decayFrames = decaySeconds * sampleRate;
+    m_activePartitions = math_clamp(
+            static_cast<int>(std::ceil(decayFrames / kPartitionFrames)),
+            1,
+            m_partitionCount);
+    m_partitionDecay = std::exp(-kLn1000 * kPartitionFrames / decayFrames);
+    // Normalize the energy of the decaying impulse response
+    const double squaredDecay = m_partitionDecay * m_partitionDecay;
+    double energy = kNoiseVariance * kPartitionFrames;
+    if (squaredDecay < 1.0) {
+        energy *= (1.0 - std::pow(squaredDecay, m_activePartitions)) /
+                (1.0 - squaredDecay);
+    } else {
+        energy *= m_activePartitions;
+    }
+    m_wetGain = 1.0 / std::sqrt(energy);
+    m_nextPartition = 1;
+}
+
+void ConvolutionReverbGroupState::accumulatePartitions(int endPartition) {
+    // Partition k of the next output block is applied to the input block
+    // that was transformed k - 1 blocks ago.
+    endPartition = math_min(endPartition,
+            math_min(m_activePartitions, m_validSpectra + 1));
+    if (m_nextPartition >= endPartition) {
+        return;
+    }
+    double gain = m_wetGain * std::pow(m_partitionDecay, m_nextPartition);
+    for (int k = m_nextPartition; k < endPartition; ++k) {
+        int slot = m_newestSpectrum - (k - 1);
+        if (slot < 0) {
+            slot += m_partitionCount;
+        }
+        for (auto& channel : m_channels) {
+            const float* pIrReal = &channel.irReal[k * kBinCount];
+            const float* pIrImag = &channel.irImag[k * kBinCount];
+            const float* pInputReal = &channel.inputReal[slot * kBinCount];
+            const float* pInputImag = &channel.inputImag[slot * kBinCount];
+            double* pAccumulatorReal = channel.accumulatorReal.data();
+            double* pAccumulatorImag = channel.accumulatorImag.data();
+            for (int b = 0; b < kBinCount; ++b) {
+                pAccumulatorReal[b] += gain *
+                        (pInputReal[b] * pIrReal[b] - pInputImag[b] * pIrImag[b]);
+                pAccumulatorImag[b] += gain *
+                        (pInputReal[b] * pIrImag[b] + pInputImag[b] * pIrReal[b]);
+            }
+        }
+        gain *= m_partitionDecay;
+    }
+    m_nextPartition = endPartition;
+}
+
+void ConvolutionReverbGroupState::finishBlock() {
+    accumulatePartitions(m_activePartitions);
+
+    const int slot = (m_newestSpectrum + 1) % m_partitionCount;
+    for (auto& channel : m_channels) {
+        m_fft.forward(channel.input.data(), m_fftReal.data(), m_fftImag.data());
+        float* pInputReal = &channel.inputReal[slot * kBinCount];
+        float* pInputImag = &channel.inputImag[slot * kBinCount];
+        const float* pIrReal = &channel.irReal[0];
+        const float* pIrImag = &channel.irImag[0];
+        double* pAccumulatorReal = channel.accumulatorReal.data();
+        double* pAccumulatorImag = channel.accumulatorImag.data();
+        for (int b = 0; b < kBinCount; ++b) {
+            const double inputReal = m_fftReal[b];
+            const double inputImag = m_fftImag[b];
+            pInputReal[b] = static_cast<float>(inputReal);
+            pInputImag[b] = static_cast<float>(inputImag);
+            pAccumulatorReal[b] += m_wetGain *
+                    (inputReal * pIrReal[b] - inputImag * pIrImag[b]);
+            pAccumulatorImag[b] += m_wetGain *
+                    (inputReal * pIrImag[b] + inputImag * pIrReal[b]);
+        }
+
+        m_fft.inverse(pAccumulatorReal, pAccumulatorImag, m_fftTime.data());
+        // The first half contains the circular wrap-around of the previous
+        // block and is discarded
+        std::copy(m_fftTime.begin() + kPartitionFrames,
+                m_fftTime.end(),
+                channel.output.begin());
+        std::copy(channel.input.begin() + kPartitionFrames,
+                channel.input.end(),
+                channel.input.begin());
+        std::fill(channel.accumulatorReal.begin(), channel.accumulatorReal.end(), 0);
+        std::fill(channel.accumulatorImag.begin(), channel.accumulatorImag.end(), 0);
+    }
+    m_newestSpectrum = slot;
+    m_validSpectra = math_min(m_validSpectra + 1, m_partitionCount);
+}
+
+void ConvolutionReverbGroupState::process(const CSAMPLE* pInput,
+        CSAMPLE* pOutput,
+        SINT numFrames,
+        double sampleRate,
+        double decaySeconds,
+        CSAMPLE_GAIN sendCurrent) {
+    const auto sendRamped = send.rampTo(sendCurrent, static_cast<int>(numFrames));
+    SINT frame = 0;
+    while (frame < numFrames) {
+        if (m_blockPosition == 0) {
+            startBlock(sampleRate, decaySeconds);
+        }
+        const SINT chunkFrames = math_min(
+                numFrames - frame, static_cast<SINT>(kPartitionFrames - m_blockPosition));
+        for (SINT i = 0; i < chunkFrames; ++i) {
+            const CSAMPLE_GAIN sendGain = sendRamped.getNth(static_cast<int>(frame + i) + 1);
+            const SINT sample = (frame + i) * 2;
+            const int position = m_blockPosition + static_cast<int>(i);
+            for (int c = 0; c < 2; ++c) {
+                Channel& channel = m_channels[c];
+                channel.input[kPartitionFrames + position] = pInput[sample + c] * sendGain;
+                pOutput[sample + c] = static_cast<CSAMPLE>(channel.output[position]);
+            }
+        }
+        frame += chunkFrames;
+        m_blockPosition += static_cast<int>(chunkFrames);
+        if (m_blockPosition == kPartitionFrames) {
+            finishBlock();
+            m_blockPosition = 0;
+        } else {
+            // Spread the work for the next output block over all engine
+            // callbacks of the current block
+            accumulatePartitions(1 +
+                    (m_activePartitions - 1) * m_blockPosition / kPartitionFrames);
+        }
+    }
+}
+
+// static
+QString ConvolutionReverbEffect::getId() {
+    return "org.mixxx.effects.convolutionreverb";
+}
+
+// static
+EffectManifestPointer ConvolutionReverbEffect::getManifest() {
+    EffectManifestPointer pManifest(new EffectManifest());
+    pManifest->setAddDryToWet(true);
+    pManifest->setEffectRampsFromDry(true);
+
+    pManifest->setId(getId());
+    pManifest->setName(QObject::tr("Convolution Reverb"));
+    pManifest->setShortName(QObject::tr("Conv. Reverb"));
+    pManifest->setAuthor("The Mixxx Team");
+    pManifest->setVersion("1.0");
+    pManifest->setDescription(QObject::tr(
+            "Emulates the diffuse reflections of a room by convolving the "
+            "signal with a decaying impulse response"));
+
+    EffectManifestParameterPointer decay = pManifest->addParameter();
+    decay->setId("decay");
+    decay->setName(QObject::tr("Decay"));
+    decay->setShortName(QObject::tr("Decay"));
+    decay->setDescription(QObject::tr(
+            "Time in seconds until the reverberation has faded out by 60 dB"));
+    decay->setValueScaler(EffectManifestParameter::ValueScaler::Linear);
+    decay->setUnitsHint(EffectManifestParameter::UnitsHint::Time);
+    decay->setRange(0.2, 1.0, ConvolutionReverbGroupState::kMaxDecaySeconds);
+
+    EffectManifestParameterPointer send = pManifest->addParameter();
+    send->setId("send_amount");
+    send->setName(QObject::tr("Send"));
+    send->setShortName(QObject::tr("Send"));
+    send->setDescription(QObject::tr(
+            "How much of the signal to send in to the effect"));
+    send->setValueScaler(EffectManifestParameter::ValueScaler::Linear);
+    send->setUnitsHint(EffectManifestParameter::UnitsHint::Unknown);
+    send->setDefaultLinkType(EffectManifestParameter::LinkType::Linked);
+    send->setDefaultLinkInversion(EffectManifestParameter::LinkInversion::NotInverted);
+    send->setRange(0, 0, 1);
+
+    return pManifest;
+}
+
+void ConvolutionReverbEffect::loadEngineEffectParameters(
+        const QMap<QString, EngineEffectParameterPointer>& parameters) {
+    m_pDecayParameter = parameters.value("decay");
+    m_pSendParameter = parameters.value("send_amount");
+}
+
+void ConvolutionReverbEffect::processChannel(
+        ConvolutionReverbGroupState* pState,
+        const CSAMPLE* pInput,
+        CSAMPLE* pOutput,
+        const mixxx::EngineParameters& engineParameters,
+        const EffectEnableState enableState,
+        const GroupFeatureState& groupFeatures) {
+    Q_UNUSED(groupFeatures);
+    DEBUG_ASSERT(engineParameters.channelCount() == mixxx::kEngineChannelCount);
+
+    const auto sendCurrent = static_cast<CSAMPLE_GAIN>(m_pSendParameter->value());
+
+    // Don't replay the tail from the last time the effect was enabled
+    if (enableState == EffectEnableState::Enabling) {
+        pState->clear();
+    }
+
+    pState->process(pInput,
+            pOutput,
+            engineParameters.framesPerBuffer(),
+            engineParameters.sampleRate().toDouble(),
+            m_pDecayParameter->value(),
+            sendCurrent);
+
+    // The ramping of the send parameter handles ramping when enabling, so
+    // this effect must handle ramping to dry when disabling itself (instead
+    // of being handled by EngineEffect::process).
+    if (enableState == EffectEnableState::Disabling) {
+        SampleUtil::applyRampingGain(pOutput, 1.0, 0.0, engineParameters.samplesPerBuffer());
+        pState->send.reset(0);
+    }
+}
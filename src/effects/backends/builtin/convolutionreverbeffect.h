@@ -0,0 +1,125 @@
+#pragma once
+
+#include <dsp/transforms/FFT.h>
+
+#include <QMap>
+#include <vector>
+
+#include "effects/backends/effectprocessor.h"
+#include "engine/effects/engineeffect.h"
+#include "engine/effects/engineeffectparameter.h"
+#include "util/class.h"
+#include "util/defs.h"
+#include "util/rampingvalue.h"
+#include "util/types.h"
+
+/// Uniformly partitioned convolution of both channels with a synthetic
+/// impulse response, using the overlap-save method.
+///
+/// The impulse response is split into partitions of kPartitionFrames. The
+/// spectra of all partitions and of the most recent input blocks are kept,
+/// so each output block only costs one forward and one inverse FFT plus a
+/// complex multiply-accumulate per partition. The partitions that only
+/// depend on previous input blocks are accumulated in slices while the
+/// samples of the current block arrive. This keeps the work of each engine
+/// callback nearly constant, even if the engine buffer is much smaller
+/// than a partition.
+class ConvolutionReverbGroupState : public EffectState {
+  public:
+    /// Also determines the latency of the wet signal
+    static constexpr int kPartitionFrames = 256;
+    static constexpr int kMaxDecaySeconds = 2;
+
+    ConvolutionReverbGroupState(const mixxx::EngineParameters& engineParameters);
+
+    void clear();
+
+    /// Processes the interleaved stereo frames of numFrames and writes the
+    /// wet signal to pOutput. The input gain is ramped from the previous to
+    /// the current send amount.
+    void process(const CSAMPLE* pInput,
+            CSAMPLE* pOutput,
+            SINT numFrames,
+            double sampleRate,
+            double decaySeconds,
+            CSAMPLE_GAIN sendCurrent);
+
+    SmoothedValue<CSAMPLE_GAIN> send;
+
+  private:
+    struct Channel {
+        // kPartitionFrames of the previous block followed by the current block
+        std::vector<double> input;
+        // The output of the last complete block
+        std::vector<double> output;
+        // Spectra of the impulse response partitions
+        std::vector<float> irReal;
+        std::vector<float> irImag;
+        // Ring buffer with the spectra of the most recent input blocks
+        std::vector<float> inputReal;
+        std::vector<float> inputImag;
+        // Spectrum of the next output block
+        std::vector<double> accumulatorReal;
+        std::vector<double> accumulatorImag;
+    };
+
+    void startBlock(double sampleRate, double decaySeconds);
+    void accumulatePartitions(int endPartition);
+    void finishBlock();
+
+    const int m_partitionCount;
+    FFTReal m_fft;
+    std::vector<double> m_fftTime;
+    std::vector<double> m_fftReal;
+    std::vector<double> m_fftImag;
+    Channel m_channels[2];
+
+    // Position of the next frame within the current block
+    int m_blockPosition;
+    // Ring buffer index of the most recent input spectrum
+    int m_newestSpectrum;
+    // Number of input spectra since the last clear()
+    int m_validSpectra;
+    // Next partition that needs to be accumulated for the current block
+    int m_nextPartition;
+    // Partitions that are used for the current block
+    int m_activePartitions;
+    // Gain of each partition relative to the previous one
+    double m_partitionDecay;
+    // Gain of the first partition that normalizes the energy of the
+    // impulse response
+    double m_wetGain;
+};
+
+class ConvolutionReverbEffect : public EffectProcessorImpl<ConvolutionReverbGroupState> {
+  public:
+    ConvolutionReverbEffect() = default;
+
+    static QString getId();
+    static EffectManifestPointer getManifest();
+
+    void loadEngineEffectParameters(
+            const QMap<QString, EngineEffectParameterPointer>& parameters) override;
+
+    void processChannel(
+            ConvolutionReverbGroupState* pState,
+            const CSAMPLE* pInput,
+            CSAMPLE* pOutput,
+            const mixxx::EngineParameters& engineParameters,
+            const EffectEnableState enableState,
+            const GroupFeatureState& groupFeatures) override;
+
+    SINT getGroupDelayFrames() override {
+        return ConvolutionReverbGroupState::kPartitionFrames;
+    }
+
+  private:
+    QString debugString() const {
+        return getId();
+    }
+
+    EngineEffectParameterPointer m_pDecayParameter;
+    EngineEffectParameterPointer m_pSendParameter;
+
+    DISALLOW_COPY_AND_ASSIGN(ConvolutionReverbEffect);
+};
@@ -165,14 +165,12 @@ void EchoEffect::processChannel(
     int read_position = pGroupState->write_position;
     decrementRing(&read_position, delay_samples, pGroupState->delay_buf.size());
 
-    RampingValue<CSAMPLE_GAIN> send(send_current,
-            pGroupState->prev_send,
-            engineParameters.framesPerBuffer());
+    const auto send = pGroupState->send.rampTo(send_current,
+            static_cast<int>(engineParameters.framesPerBuffer()));
     // Feedback the delay buffer and then add the new input.
 
-    RampingValue<CSAMPLE_GAIN> feedback(feedback_current,
-            pGroupState->prev_feedback,
-            engineParameters.framesPerBuffer());
+    const auto feedback = pGroupState->feedback.rampTo(feedback_current,
+            static_cast<int>(engineParameters.framesPerBuffer()));
 
     int rampIndex = 0;
     //TODO: rewrite to remove assumption of stereo buffer
@@ -244,11 +242,8 @@ void EchoEffect::processChannel(
     if (enableState == EffectEnableState::Disabling) {
         SampleUtil::applyRampingGain(pOutput, 1.0, 0.0, engineParameters.samplesPerBuffer());
         pGroupState->delay_buf.clear();
-        pGroupState->prev_send = 0;
-    } else {
-        pGroupState->prev_send = send_current;
+        pGroupState->send.reset(0);
     }
 
-    pGroupState->prev_feedback = feedback_current;
     pGroupState->prev_delay_samples = delay_samples;
 }
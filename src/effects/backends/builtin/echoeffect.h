@@ -8,6 +8,7 @@
 #include "engine/engine.h"
 #include "util/class.h"
 #include "util/defs.h"
+#include "util/rampingvalue.h"
 #include "util/sample.h"
 #include "util/samplebuffer.h"
 
@@ -18,7 +19,9 @@ class EchoGroupState : public EffectState {
     static constexpr int kMaxDelaySeconds = 3;
 
     EchoGroupState(const mixxx::EngineParameters& engineParameters)
-            : EffectState(engineParameters) {
+            : EffectState(engineParameters),
+              send(0),
+              feedback(0) {
         audioParametersChanged(engineParameters);
         clear();
     }
@@ -31,16 +34,16 @@ class EchoGroupState : public EffectState {
 
     void clear() {
         delay_buf.clear();
-        prev_send = 0.0f;
-        prev_feedback = 0.0f;
+        send.reset(0);
+        feedback.reset(0);
         prev_delay_samples = 0;
         write_position = 0;
         ping_pong = 0;
     };
 
     mixxx::SampleBuffer delay_buf;
-    CSAMPLE_GAIN prev_send;
-    CSAMPLE_GAIN prev_feedback;
+    SmoothedValue<CSAMPLE_GAIN> send;
+    SmoothedValue<CSAMPLE_GAIN> feedback;
     int prev_delay_samples;
     int write_position;
     int ping_pong;
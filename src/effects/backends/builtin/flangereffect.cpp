@@ -148,14 +148,12 @@ void FlangerEffect::processChannel(
     // the number of channels.
 
     const auto mix = static_cast<CSAMPLE_GAIN>(m_pMixParameter->value());
-    RampingValue<CSAMPLE_GAIN> mixRamped(
-            pState->prev_mix, mix, engineParameters.framesPerBuffer());
-    pState->prev_mix = mix;
+    const auto mixRamped = pState->mix.rampTo(
+            mix, static_cast<int>(engineParameters.framesPerBuffer()));
 
     const auto regen = static_cast<CSAMPLE_GAIN>(m_pRegenParameter->value());
-    RampingValue<CSAMPLE_GAIN> regenRamped(
-            pState->prev_regen, regen, engineParameters.framesPerBuffer());
-    pState->prev_regen = regen;
+    const auto regenRamped = pState->regen.rampTo(
+            regen, static_cast<int>(engineParameters.framesPerBuffer()));
 
     // With and Manual is limited by amount of amplitude that remains from width
     // to kMaxDelayMs
@@ -165,13 +163,10 @@ void FlangerEffect::processChannel(
     double minManual = kCenterDelayMs - (kMaxLfoWidthMs - width) / 2;
     manual = math_clamp(manual, minManual, maxManual);
 
-    RampingValue<double> widthRamped(
-            pState->prev_width, width, engineParameters.framesPerBuffer());
-    pState->prev_width = static_cast<CSAMPLE_GAIN>(width);
-
-    RampingValue<double> manualRamped(
-            pState->prev_manual, manual, engineParameters.framesPerBuffer());
-    pState->prev_manual = static_cast<CSAMPLE_GAIN>(manual);
+    const auto widthRamped = pState->width.rampTo(
+            width, static_cast<int>(engineParameters.framesPerBuffer()));
+    const auto manualRamped = pState->manual.rampTo(
+            manual, static_cast<int>(engineParameters.framesPerBuffer()));
 
     CSAMPLE* delayLeft = pState->delayLeft;
     CSAMPLE* delayRight = pState->delayRight;
@@ -229,7 +224,7 @@ void FlangerEffect::processChannel(
         SampleUtil::clear(delayLeft, kBufferLenth);
         SampleUtil::clear(delayRight, kBufferLenth);
         pState->previousPeriodFrames = -1;
-        pState->prev_regen = 0;
-        pState->prev_mix = 0;
+        pState->regen.reset(0);
+        pState->mix.reset(0);
     }
 }
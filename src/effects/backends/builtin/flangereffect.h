@@ -28,10 +28,10 @@ struct FlangerGroupState : public EffectState {
               delayPos(0),
               lfoFrames(0),
               previousPeriodFrames(-1),
-              prev_regen(0),
-              prev_mix(0),
-              prev_width(0),
-              prev_manual(static_cast<CSAMPLE_GAIN>(kCenterDelayMs)) {
+              regen(0),
+              mix(0),
+              width(0),
+              manual(kCenterDelayMs) {
         SampleUtil::clear(delayLeft, kBufferLenth);
         SampleUtil::clear(delayRight, kBufferLenth);
     }
@@ -40,10 +40,10 @@ struct FlangerGroupState : public EffectState {
     unsigned int delayPos;
     unsigned int lfoFrames;
     double previousPeriodFrames;
-    CSAMPLE_GAIN prev_regen;
-    CSAMPLE_GAIN prev_mix;
-    CSAMPLE_GAIN prev_width;
-    CSAMPLE_GAIN prev_manual;
+    SmoothedValue<CSAMPLE_GAIN> regen;
+    SmoothedValue<CSAMPLE_GAIN> mix;
+    SmoothedValue<double> width;
+    SmoothedValue<double> manual;
 };
 
 class FlangerEffect : public EffectProcessorImpl<FlangerGroupState> {
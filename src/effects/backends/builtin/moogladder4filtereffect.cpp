@@ -4,6 +4,8 @@
 
 static constexpr double kMinCorner = 0.0003; // 13 Hz @ 44100
 static constexpr double kMaxCorner = 0.5;    // 22050 Hz @ 44100
+// The nonlinear ladder aliases with high resonance
+static constexpr int kOversamplingFactor = 2;
 
 // static
 QString MoogLadder4FilterEffect::getId() {
@@ -22,6 +24,7 @@ EffectManifestPointer MoogLadder4FilterEffect::getManifest() {
             QObject::tr("A 4-pole Moog ladder filter, based on Antti "
                         "Houvilainen's non linear digital implementation"));
     pManifest->setEffectRampsFromDry(true);
+    pManifest->setOversamplingFactor(kOversamplingFactor);
     pManifest->setMetaknobDefault(0.5);
 
     EffectManifestParameterPointer lpf = pManifest->addParameter();
@@ -66,11 +69,11 @@ MoogLadder4FilterGroupState::MoogLadder4FilterGroupState(
     m_pBuf = SampleUtil::alloc(engineParameters.samplesPerBuffer());
     m_pLowFilter = new EngineFilterMoogLadder4Low(
             engineParameters.sampleRate(),
-            m_loFreq * engineParameters.sampleRate(),
+            m_loFreq * engineParameters.sampleRate() / kOversamplingFactor,
             m_resonance);
     m_pHighFilter = new EngineFilterMoogLadder4High(
             engineParameters.sampleRate(),
-            m_hiFreq * engineParameters.sampleRate(),
+            m_hiFreq * engineParameters.sampleRate() / kOversamplingFactor,
             m_resonance);
 }
 
@@ -116,7 +119,8 @@ void MoogLadder4FilterEffect::processChannel(
             pState->m_resonance != resonance ||
             pState->m_samplerate != engineParameters.sampleRate()) {
         pState->m_pLowFilter->setParameter(engineParameters.sampleRate(),
-                static_cast<float>(lpf * engineParameters.sampleRate()),
+                static_cast<float>(lpf * engineParameters.sampleRate() /
+                        kOversamplingFactor),
                 static_cast<float>(resonance));
     }
 
@@ -124,7 +128,8 @@ void MoogLadder4FilterEffect::processChannel(
             pState->m_resonance != resonance ||
             pState->m_samplerate != engineParameters.sampleRate()) {
         pState->m_pHighFilter->setParameter(engineParameters.sampleRate(),
-                static_cast<float>(hpf * engineParameters.sampleRate()),
+                static_cast<float>(hpf * engineParameters.sampleRate() /
+                        kOversamplingFactor),
                 static_cast<float>(resonance));
     }
 
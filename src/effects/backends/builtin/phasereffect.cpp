@@ -166,9 +166,9 @@ void PhaserEffect::processChannel(
 
     CSAMPLE left = 0, right = 0;
 
-    CSAMPLE_GAIN oldDepth = pState->oldDepth;
-    const CSAMPLE_GAIN depthDelta = (depth - oldDepth) / engineParameters.framesPerBuffer();
-    const CSAMPLE_GAIN depthStart = oldDepth + depthDelta;
+    // The ramp reaches the new depth with the last frame
+    const auto depthRamped = pState->smoothedDepth.rampTo(
+            depth, static_cast<int>(engineParameters.framesPerBuffer()));
 
     const auto stereoCheck = static_cast<int>(m_pStereoParameter->value());
     int counter = 0;
@@ -206,12 +206,11 @@ void PhaserEffect::processChannel(
         left = processSample(left, oldInLeft, oldOutLeft, filterCoefLeft, stages);
         right = processSample(right, oldInRight, oldOutRight, filterCoefRight, stages);
 
-        const CSAMPLE_GAIN depth = depthStart + depthDelta * (i / engineParameters.channelCount());
+        const CSAMPLE_GAIN depth = depthRamped.getNth(
+                static_cast<int>(i / engineParameters.channelCount()) + 1);
 
         // Computing output combining the original and processed sample
         pOutput[i] = pInput[i] * (1.0f - 0.5f * depth) + left * depth * 0.5f;
         pOutput[i + 1] = pInput[i + 1] * (1.0f - 0.5f * depth) + right * depth * 0.5f;
     }
-
-    pState->oldDepth = depth;
 }
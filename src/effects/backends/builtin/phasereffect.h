@@ -5,6 +5,7 @@
 #include "engine/effects/engineeffectparameter.h"
 #include "util/class.h"
 #include "util/defs.h"
+#include "util/rampingvalue.h"
 #include "util/sample.h"
 #include "util/types.h"
 
@@ -13,14 +14,15 @@
 class PhaserGroupState final : public EffectState {
   public:
     PhaserGroupState(const mixxx::EngineParameters& engineParameters)
-            : EffectState(engineParameters) {
+            : EffectState(engineParameters),
+              smoothedDepth(0) {
         clear();
     }
 
     void clear() {
         leftPhase = 0;
         rightPhase = 0;
-        oldDepth = 0;
+        smoothedDepth.reset(0);
         SampleUtil::clear(oldInLeft, MAXSTAGES);
         SampleUtil::clear(oldOutLeft, MAXSTAGES);
         SampleUtil::clear(oldInRight, MAXSTAGES);
@@ -33,7 +35,7 @@ class PhaserGroupState final : public EffectState {
     CSAMPLE oldOutRight[MAXSTAGES];
     CSAMPLE leftPhase;
     CSAMPLE rightPhase;
-    CSAMPLE_GAIN oldDepth;
+    SmoothedValue<CSAMPLE_GAIN> smoothedDepth;
 };
 
 class PhaserEffect : public EffectProcessorImpl<PhaserGroupState> {
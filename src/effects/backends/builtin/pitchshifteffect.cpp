@@ -2,9 +2,26 @@
 
 #include "util/sample.h"
 
+namespace {
+
+std::unique_ptr<RubberBand::RubberBandStretcher> newRubberBand(
+        const mixxx::EngineParameters& engineParameters,
+        RubberBand::RubberBandStretcher::Options options) {
+    auto pRubberBand = std::make_unique<RubberBand::RubberBandStretcher>(
+            engineParameters.sampleRate(),
+            engineParameters.channelCount(),
+            RubberBand::RubberBandStretcher::OptionProcessRealTime | options);
+    pRubberBand->setMaxProcessSize(engineParameters.framesPerBuffer());
+    pRubberBand->setTimeRatio(1.0);
+    return pRubberBand;
+}
+
+} // anonymous namespace
+
 PitchShiftGroupState::PitchShiftGroupState(
         const mixxx::EngineParameters& engineParameters)
-        : EffectState(engineParameters) {
+        : EffectState(engineParameters),
+          m_lowLatency(false) {
     initializeBuffer(engineParameters);
     audioParametersChanged(engineParameters);
 }
@@ -24,13 +41,12 @@ void PitchShiftGroupState::initializeBuffer(
 
 void PitchShiftGroupState::audioParametersChanged(
         const mixxx::EngineParameters& engineParameters) {
-    m_pRubberBand = std::make_unique<RubberBand::RubberBandStretcher>(
-            engineParameters.sampleRate(),
-            engineParameters.channelCount(),
-            RubberBand::RubberBandStretcher::OptionProcessRealTime);
-
-    m_pRubberBand->setMaxProcessSize(engineParameters.framesPerBuffer());
-    m_pRubberBand->setTimeRatio(1.0);
+    m_pRubberBand = newRubberBand(engineParameters,
+            RubberBand::RubberBandStretcher::DefaultOptions);
+    // The short window reduces the latency at the cost of the quality,
+    // mostly of low frequencies.
+    m_pRubberBandLowLatency = newRubberBand(engineParameters,
+            RubberBand::RubberBandStretcher::OptionWindowShort);
 };
 
 // static
@@ -61,12 +77,23 @@ EffectManifestPointer PitchShiftEffect::getManifest() {
     pitch->setNeutralPointOnScale(0.0);
     pitch->setRange(-1.0, 0.0, 1.0);
 
+    EffectManifestParameterPointer lowLatency = pManifest->addParameter();
+    lowLatency->setId("low_latency");
+    lowLatency->setName(QObject::tr("Low Latency"));
+    lowLatency->setShortName(QObject::tr("Low Lat."));
+    lowLatency->setDescription(QObject::tr(
+            "Reduces the delay of the shifted sound at the cost of the quality."));
+    lowLatency->setValueScaler(EffectManifestParameter::ValueScaler::Toggle);
+    lowLatency->setUnitsHint(EffectManifestParameter::UnitsHint::Unknown);
+    lowLatency->setRange(0, 0, 1);
+
     return pManifest;
 }
 
 void PitchShiftEffect::loadEngineEffectParameters(
         const QMap<QString, EngineEffectParameterPointer>& parameters) {
     m_pPitchParameter = parameters.value("pitch");
+    m_pLowLatencyParameter = parameters.value("low_latency");
 }
 
 void PitchShiftEffect::processChannel(
@@ -77,7 +104,18 @@ void PitchShiftEffect::processChannel(
         const EffectEnableState enableState,
         const GroupFeatureState& groupFeatures) {
     Q_UNUSED(groupFeatures);
-    Q_UNUSED(enableState);
+
+    const bool lowLatency = m_pLowLatencyParameter->toBool();
+    RubberBand::RubberBandStretcher* pRubberBand = lowLatency
+            ? pState->m_pRubberBandLowLatency.get()
+            : pState->m_pRubberBand.get();
+    if (enableState == EffectEnableState::Enabling ||
+            lowLatency != pState->m_lowLatency) {
+        // Discard the audio that has been buffered before the effect
+        // has been disabled or by the stretcher of the other mode
+        pRubberBand->reset();
+        pState->m_lowLatency = lowLatency;
+    }
 
     const double pitchParameter = m_pPitchParameter->value();
 
@@ -89,23 +127,23 @@ void PitchShiftEffect::processChannel(
         }
     }();
 
-    pState->m_pRubberBand->setPitchScale(pitch);
+    pRubberBand->setPitchScale(pitch);
 
     SampleUtil::deinterleaveBuffer(
             pState->m_retrieveBuffer[0],
             pState->m_retrieveBuffer[1],
             pInput,
             engineParameters.framesPerBuffer());
-    pState->m_pRubberBand->process(
+    pRubberBand->process(
             pState->m_retrieveBuffer,
             engineParameters.framesPerBuffer(),
             false);
 
-    SINT framesAvailable = pState->m_pRubberBand->available();
+    SINT framesAvailable = pRubberBand->available();
     SINT framesToRead = math_min(
             framesAvailable,
             engineParameters.framesPerBuffer());
-    SINT receivedFrames = pState->m_pRubberBand->retrieve(
+    SINT receivedFrames = pRubberBand->retrieve(
             pState->m_retrieveBuffer,
             framesToRead);
 
@@ -113,4 +151,12 @@ void PitchShiftEffect::processChannel(
             pState->m_retrieveBuffer[0],
             pState->m_retrieveBuffer[1],
             receivedFrames);
+    // The stretcher has not produced enough output yet, e.g. directly
+    // after a reset
+    if (receivedFrames < engineParameters.framesPerBuffer()) {
+        SampleUtil::clear(
+                pOutput + engineParameters.channelCount() * receivedFrames,
+                engineParameters.channelCount() *
+                        (engineParameters.framesPerBuffer() - receivedFrames));
+    }
 }
@@ -25,6 +25,10 @@ class PitchShiftGroupState : public EffectState {
     void audioParametersChanged(const mixxx::EngineParameters& engineParameters);
 
     std::unique_ptr<RubberBand::RubberBandStretcher> m_pRubberBand;
+    // Both stretchers are created upfront, because switching the mode
+    // must not allocate memory in the audio thread.
+    std::unique_ptr<RubberBand::RubberBandStretcher> m_pRubberBandLowLatency;
+    bool m_lowLatency;
     CSAMPLE* m_retrieveBuffer[2];
 };
 
@@ -52,6 +56,7 @@ class PitchShiftEffect final : public EffectProcessorImpl<PitchShiftGroupState>
     }
 
     EngineEffectParameterPointer m_pPitchParameter;
+    EngineEffectParameterPointer m_pLowLatencyParameter;
 
     DISALLOW_COPY_AND_ASSIGN(PitchShiftEffect);
 };
@@ -51,13 +51,14 @@ void WhiteNoiseEffect::processChannel(
     WhiteNoiseGroupState& gs = *pState;
 
     CSAMPLE drywet = static_cast<CSAMPLE>(m_pDryWetParameter->value());
-    RampingValue<CSAMPLE_GAIN> drywet_ramping_value(
-            drywet, gs.previous_drywet, engineParameters.framesPerBuffer());
+    const auto drywet_ramping_value = gs.drywet.rampTo(
+            drywet, static_cast<int>(engineParameters.framesPerBuffer()));
 
     std::uniform_real_distribution<> r_distributor(0.0, 1.0);
 
     for (SINT i = 0; i < engineParameters.samplesPerBuffer(); i++) {
-        CSAMPLE_GAIN drywet_ramped = drywet_ramping_value.getNth(i);
+        CSAMPLE_GAIN drywet_ramped = drywet_ramping_value.getNth(
+                static_cast<int>(i / engineParameters.channelCount()));
 
         float noise = static_cast<float>(
                 r_distributor(gs.gen));
@@ -66,8 +67,6 @@ void WhiteNoiseEffect::processChannel(
     }
 
     if (enableState == EffectEnableState::Disabling) {
-        gs.previous_drywet = 0;
-    } else {
-        gs.previous_drywet = drywet;
+        gs.drywet.reset(0);
     }
 }
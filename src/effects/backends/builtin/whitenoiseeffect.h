@@ -8,6 +8,7 @@
 #include "engine/filters/enginefilterpansingle.h"
 #include "util/class.h"
 #include "util/defs.h"
+#include "util/rampingvalue.h"
 #include "util/sample.h"
 #include "util/samplebuffer.h"
 #include "util/types.h"
@@ -16,13 +17,13 @@ class WhiteNoiseGroupState final : public EffectState {
   public:
     WhiteNoiseGroupState(const mixxx::EngineParameters& engineParameters)
             : EffectState(engineParameters),
-              previous_drywet(0.0),
+              drywet(0),
               gen(rs()) {
     }
     ~WhiteNoiseGroupState() {
     }
 
-    CSAMPLE_GAIN previous_drywet;
+    SmoothedValue<CSAMPLE_GAIN> drywet;
     std::random_device rs;
     std::mt19937 gen;
 };
@@ -6,8 +6,10 @@
 #include <QtDebug>
 
 #include "effects/backends/effectmanifestparameter.h"
+#include "effects/backends/effectoversampler.h"
 #include "effects/backends/effectsbackend.h"
 #include "effects/defs.h"
+#include "util/assert.h"
 
 /// An EffectManifest is a description of the metadata associated with an effect
 /// (ID, display name, author, description) and all the parameters of the effect.
@@ -30,6 +32,7 @@ class EffectManifest {
               m_isMasterEQ(false),
               m_effectRampsFromDry(false),
               m_bAddDryToWet(false),
+              m_oversamplingFactor(1),
               m_metaknobDefault(0.0) {
     }
 
@@ -148,6 +151,22 @@ class EffectManifest {
         m_bAddDryToWet = addDryToWet;
     }
 
+    /// Nonlinear effects can be processed at 2 or 4 times the engine sample
+    /// rate to reduce aliasing. The EffectState and processChannel() of the
+    /// effect receive the oversampled EngineParameters. Parameters that are
+    /// relative to the sample rate must be scaled by the effect, and
+    /// getGroupDelayFrames() is counted in oversampled frames.
+    int oversamplingFactor() const {
+        return m_oversamplingFactor;
+    }
+    void setOversamplingFactor(int oversamplingFactor) {
+        VERIFY_OR_DEBUG_ASSERT(oversamplingFactor == 1 ||
+                EffectOversampler::isValidFactor(oversamplingFactor)) {
+            return;
+        }
+        m_oversamplingFactor = oversamplingFactor;
+    }
+
     double metaknobDefault() const {
         return m_metaknobDefault;
     }
@@ -187,5 +206,6 @@ class EffectManifest {
     QList<EffectManifestParameterPointer> m_parameters;
     bool m_effectRampsFromDry;
     bool m_bAddDryToWet;
+    int m_oversamplingFactor;
     double m_metaknobDefault;
 };
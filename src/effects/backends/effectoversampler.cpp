@@ -0,0 +1,211 @@
+#include "effects/backends/effectoversampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr int kChannelCount = 2;
+
+// Number of nonzero taps on each side of the center tap. The first stage
+// needs a steep transition between 20 kHz and the Nyquist frequency of
+// the engine. The content of the second stage is already band limited,
+// so a much shorter filter is sufficient.
+constexpr int kFirstStageHalfLength = 16;
+constexpr int kSecondStageHalfLength = 6;
+
+// About 80 dB stop band attenuation
+constexpr double kKaiserBeta = 8.0;
+
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/// Returns the nonzero taps at the odd distances 1, 3, 5, ... from the
+/// center tap of a windowed sinc half-band filter, scaled to a gain of
+/// gain at DC. The center tap is 0.5 * gain.
+std::vector<CSAMPLE> halfBandCoefficients(int halfLength, double gain) {
+    std::vector<double> taps(halfLength);
+    // The window ends one tap after the last nonzero tap
+    const double windowHalfLength = 2.0 * halfLength;
+    double sum = 0.0;
+    for (int j = 0; j < halfLength; ++j) {
+        const double distance = 2.0 * j + 1.0;
+        const double ratio = distance / windowHalfLength;
+        const double window = besselI0(kKaiserBeta * std::sqrt(1.0 - ratio * ratio)) /
+                besselI0(kKaiserBeta);
+        const double sinc = ((j % 2 == 0) ? 1.0 : -1.0) / (M_PI * distance);
+        taps[j] = window * sinc;
+        sum += 2.0 * taps[j];
+    }
+    // Both sides of the taps sum up to the same gain as the center tap,
+    // which also places a zero at the Nyquist frequency
+    std::vector<CSAMPLE> coefficients(halfLength);
+    for (int j = 0; j < halfLength; ++j) {
+        coefficients[j] = static_cast<CSAMPLE>(taps[j] * 0.5 * gain / sum);
+    }
+    return coefficients;
+}
+
+} // anonymous namespace
+
+EffectOversampler::UpsamplingStage::UpsamplingStage(
+        int halfLength, SINT maxFramesPerBuffer)
+        // Compensates the energy of the inserted zeros
+        : m_coefficients(halfBandCoefficients(halfLength, 2.0)),
+          m_historyFrames(2 * halfLength - 1),
+          m_input((m_historyFrames + maxFramesPerBuffer) * kChannelCount) {
+}
+
+void EffectOversampler::UpsamplingStage::process(
+        const CSAMPLE* pInput, CSAMPLE* pOutput, SINT numFrames) {
+    DEBUG_ASSERT(static_cast<SINT>(m_input.size()) >=
+            (m_historyFrames + numFrames) * kChannelCount);
+    std::copy(pInput,
+            pInput + numFrames * kChannelCount,
+            m_input.begin() + m_historyFrames * kChannelCount);
+
+    const SINT halfLength = m_coefficients.size();
+    for (SINT frame = 0; frame < numFrames; ++frame) {
+        // The current input frame, previous frames have negative offsets
+        const CSAMPLE* pFrame = &m_input[(m_historyFrames + frame) * kChannelCount];
+        CSAMPLE* pOutputFrames = &pOutput[2 * frame * kChannelCount];
+        for (int channel = 0; channel < kChannelCount; ++channel) {
+            CSAMPLE sum = 0;
+            for (SINT j = 0; j < halfLength; ++j) {
+                sum += m_coefficients[j] *
+                        (pFrame[(-halfLength - j) * kChannelCount + channel] +
+                                pFrame[(-halfLength + 1 + j) * kChannelCount + channel]);
+            }
+            pOutputFrames[channel] = sum;
+            // The center tap of the other phase
+            pOutputFrames[kChannelCount + channel] =
+                    pFrame[(-halfLength + 1) * kChannelCount + channel];
+        }
+    }
+
+    std::copy(m_input.begin() + numFrames * kChannelCount,
+            m_input.begin() + (numFrames + m_historyFrames) * kChannelCount,
+            m_input.begin());
+}
+
+void EffectOversampler::UpsamplingStage::clear() {
+    std::fill(m_input.begin(), m_input.end(), CSAMPLE_ZERO);
+}
+
+EffectOversampler::DownsamplingStage::DownsamplingStage(
+        int halfLength, SINT delayFrames, SINT maxFramesPerBuffer)
+        : m_coefficients(halfBandCoefficients(halfLength, 1.0)),
+          m_delayFrames(delayFrames),
+          m_historyFrames(4 * halfLength - 2 + delayFrames),
+          m_input((m_historyFrames + 2 * maxFramesPerBuffer) * kChannelCount) {
+}
+
+void EffectOversampler::DownsamplingStage::process(
+        const CSAMPLE* pInput, CSAMPLE* pOutput, SINT numFrames) {
+    const SINT numInputFrames = 2 * numFrames;
+    DEBUG_ASSERT(static_cast<SINT>(m_input.size()) >=
+            (m_historyFrames + numInputFrames) * kChannelCount);
+    std::copy(pInput,
+            pInput + numInputFrames * kChannelCount,
+            m_input.begin() + m_historyFrames * kChannelCount);
+
+    const SINT halfLength = m_coefficients.size();
+    for (SINT frame = 0; frame < numFrames; ++frame) {
+        // The first of the two input frames at the higher sample rate,
+        // delayed by m_delayFrames
+        const CSAMPLE* pFrame = &m_input[(m_historyFrames + 2 * frame - m_delayFrames) *
+                kChannelCount];
+        for (int channel = 0; channel < kChannelCount; ++channel) {
+            CSAMPLE sum = 0.5f * pFrame[(1 - 2 * halfLength) * kChannelCount + channel];
+            for (SINT j = 0; j < halfLength; ++j) {
+                sum += m_coefficients[j] *
+                        (pFrame[(-2 * halfLength - 2 * j) * kChannelCount + channel] +
+                                pFrame[(-2 * halfLength + 2 + 2 * j) * kChannelCount +
+                                        channel]);
+            }
+            pOutput[frame * kChannelCount + channel] = sum;
+        }
+    }
+
+    std::copy(m_input.begin() + numInputFrames * kChannelCount,
+            m_input.begin() + (numInputFrames + m_historyFrames) * kChannelCount,
+            m_input.begin());
+}
+
+void EffectOversampler::DownsamplingStage::clear() {
+    std::fill(m_input.begin(), m_input.end(), CSAMPLE_ZERO);
+}
+
+EffectOversampler::EffectOversampler(int factor, SINT maxFramesPerBuffer)
+        : m_factor(factor),
+          m_inputBuffer(factor * maxFramesPerBuffer * kChannelCount),
+          m_outputBuffer(factor * maxFramesPerBuffer * kChannelCount) {
+    DEBUG_ASSERT(isValidFactor(factor));
+    m_upsamplingStages.reserve(2);
+    m_downsamplingStages.reserve(2);
+    m_upsamplingStages.emplace_back(kFirstStageHalfLength, maxFramesPerBuffer);
+    if (factor == 4) {
+        m_upsamplingStages.emplace_back(kSecondStageHalfLength, 2 * maxFramesPerBuffer);
+        m_downsamplingStages.emplace_back(kSecondStageHalfLength, 0, 2 * maxFramesPerBuffer);
+        m_intermediateBuffer.resize(2 * maxFramesPerBuffer * kChannelCount);
+        // Each stage delays by an odd number of frames of its higher sample
+        // rate, the additional frame rounds the total up to engine frames
+        m_downsamplingStages.emplace_back(kFirstStageHalfLength, 1, maxFramesPerBuffer);
+    } else {
+        m_downsamplingStages.emplace_back(kFirstStageHalfLength, 0, maxFramesPerBuffer);
+    }
+}
+
+// static
+SINT EffectOversampler::latencyFrames(int factor) {
+    if (factor == 1) {
+        return 0;
+    }
+    // Upsampling and downsampling each delay by 2 * halfLength - 1 frames
+    // of the higher sample rate
+    SINT latency = 2 * kFirstStageHalfLength - 1;
+    if (factor == 4) {
+        latency += kSecondStageHalfLength;
+    }
+    return latency;
+}
+
+const CSAMPLE* EffectOversampler::upsample(const CSAMPLE* pInput, SINT numFrames) {
+    if (m_factor == 4) {
+        m_upsamplingStages[0].process(pInput, m_intermediateBuffer.data(), numFrames);
+        m_upsamplingStages[1].process(
+                m_intermediateBuffer.data(), m_inputBuffer.data(), 2 * numFrames);
+    } else {
+        m_upsamplingStages[0].process(pInput, m_inputBuffer.data(), numFrames);
+    }
+    return m_inputBuffer.data();
+}
+
+void EffectOversampler::downsample(CSAMPLE* pOutput, SINT numFrames) {
+    if (m_factor == 4) {
+        m_downsamplingStages[0].process(
+                m_outputBuffer.data(), m_intermediateBuffer.data(), 2 * numFrames);
+        m_downsamplingStages[1].process(m_intermediateBuffer.data(), pOutput, numFrames);
+    } else {
+        m_downsamplingStages[0].process(m_outputBuffer.data(), pOutput, numFrames);
+    }
+}
+
+void EffectOversampler::clear() {
+    for (auto& stage : m_upsamplingStages) {
+        stage.clear();
+    }
+    for (auto& stage : m_downsamplingStages) {
+        stage.clear();
+    }
+}
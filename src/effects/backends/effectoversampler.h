@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+
+#include "util/class.h"
+#include "util/types.h"
+
+/// Runs the processing of an effect at 2 or 4 times the engine sample rate
+/// to reduce the aliasing of nonlinear effects. Every factor of 2 is a stage
+/// with a linear phase half-band FIR filter in polyphase form: Half of the
+/// taps are 0 and skipped, and each stage only computes the samples that
+/// are kept. The cost per frame is constant and does not depend on the
+/// parameters of the effect.
+///
+/// The stages of a 4x oversampler are balanced so that the latency is a
+/// whole number of engine frames, which allows to compensate it exactly for
+/// the dry signal.
+///
+/// Processes interleaved stereo samples. Allocates all buffers in the
+/// constructor, so it can be created in the main thread and used in the
+/// audio thread.
+class EffectOversampler {
+  public:
+    /// factor must be 2 or 4
+    EffectOversampler(int factor, SINT maxFramesPerBuffer);
+
+    static bool isValidFactor(int factor) {
+        return factor == 2 || factor == 4;
+    }
+    /// Delay of the output after upsample() and downsample(), which is 0
+    /// for a factor of 1 without oversampling
+    static SINT latencyFrames(int factor);
+
+    int factor() const {
+        return m_factor;
+    }
+
+    /// Returns the numFrames * factor() frames of the oversampled input
+    const CSAMPLE* upsample(const CSAMPLE* pInput, SINT numFrames);
+    /// Buffer for the numFrames * factor() frames of the oversampled output
+    CSAMPLE* oversampledOutput() {
+        return m_outputBuffer.data();
+    }
+    /// Writes numFrames frames from the oversampled output to pOutput
+    void downsample(CSAMPLE* pOutput, SINT numFrames);
+
+    void clear();
+
+  private:
+    /// Doubles the sample rate
+    class UpsamplingStage {
+      public:
+        UpsamplingStage(int halfLength, SINT maxFramesPerBuffer);
+
+        void process(const CSAMPLE* pInput, CSAMPLE* pOutput, SINT numFrames);
+        void clear();
+
+      private:
+        const std::vector<CSAMPLE> m_coefficients;
+        const SINT m_historyFrames;
+        // Previous input frames followed by the current input
+        std::vector<CSAMPLE> m_input;
+    };
+
+    /// Halves the sample rate
+    class DownsamplingStage {
+      public:
+        /// The output is delayed by additional delayFrames frames
+        /// of the higher sample rate
+        DownsamplingStage(int halfLength, SINT delayFrames, SINT maxFramesPerBuffer);
+
+        void process(const CSAMPLE* pInput, CSAMPLE* pOutput, SINT numFrames);
+        void clear();
+
+      private:
+        const std::vector<CSAMPLE> m_coefficients;
+        const SINT m_delayFrames;
+        const SINT m_historyFrames;
+        // Previous input frames followed by the current input
+        std::vector<CSAMPLE> m_input;
+    };
+
+    const int m_factor;
+    std::vector<UpsamplingStage> m_upsamplingStages;
+    std::vector<DownsamplingStage> m_downsamplingStages;
+    // Output of the first upsampling stage and input of the last
+    // downsampling stage of a 4x oversampler
+    std::vector<CSAMPLE> m_intermediateBuffer;
+    std::vector<CSAMPLE> m_inputBuffer;
+    std::vector<CSAMPLE> m_outputBuffer;
+};
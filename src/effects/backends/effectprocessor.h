@@ -4,12 +4,15 @@
 #include <QHash>
 #include <QPair>
 #include <QString>
+#include <memory>
 
+#include "effects/backends/effectoversampler.h"
 #include "effects/defs.h"
 #include "engine/channelhandle.h"
 #include "engine/effects/groupfeaturestate.h"
 #include "engine/effects/message.h"
 #include "engine/engine.h"
+#include "util/metrics.h"
 #include "util/types.h"
 
 /// Effects are implemented as two separate classes, an EffectState subclass and
@@ -40,6 +43,8 @@
 /// state separately for the main mix and the headphone output allows effects to be
 /// processed postfader for the main mix and prefader for the headphone output in
 /// parallel so there is no need for a prefader/postfader toggle switch.
+/// Prefader effects are processed only once for all outputs, so their states
+/// are only allocated for the main mix.
 ///
 /// EffectStates allocated on the main thread are passed as pointers to the
 /// EffectProcessorImpl in the audio callback thread via the EffectsMessenger.
@@ -55,7 +60,31 @@ class EffectState {
         // Subclasses should call engineParametersChanged here.
         Q_UNUSED(engineParameters);
     };
-    virtual ~EffectState(){};
+    virtual ~EffectState() {
+        mixxx::metrics::effectStateBytes.add(-m_accountedBytes);
+    };
+
+    /// Called once by the EffectProcessorImpl that created the state with
+    /// the size of the subclass. The destructor undoes the accounting,
+    /// because states may also be deleted by the owner of an EffectStatesMap.
+    void setAccountedBytes(qint64 bytes) {
+        DEBUG_ASSERT(m_accountedBytes == 0);
+        m_accountedBytes = bytes;
+        mixxx::metrics::effectStateBytes.add(bytes);
+    }
+
+    /// Only set for effects that are oversampled, see
+    /// EffectManifest::oversamplingFactor()
+    EffectOversampler* oversampler() const {
+        return m_pOversampler.get();
+    }
+    void setOversampler(std::unique_ptr<EffectOversampler> pOversampler) {
+        m_pOversampler = std::move(pOversampler);
+    }
+
+  private:
+    std::unique_ptr<EffectOversampler> m_pOversampler;
+    qint64 m_accountedBytes = 0;
 };
 
 /// EffectProcessor is an abstract base class for interfacing with an EffectSlot
@@ -70,7 +99,8 @@ class EffectProcessor {
     virtual void initialize(
             const QSet<ChannelHandleAndGroup>& activeInputChannels,
             const QSet<ChannelHandleAndGroup>& registeredOutputChannels,
-            const mixxx::EngineParameters& engineParameters) = 0;
+            const mixxx::EngineParameters& engineParameters,
+            int oversamplingFactor) = 0;
     virtual void loadEngineEffectParameters(
             const QMap<QString, EngineEffectParameterPointer>& parameters) = 0;
     virtual EffectState* createState(const mixxx::EngineParameters& engineParameters) = 0;
@@ -119,7 +149,8 @@ class EffectProcessor {
 template<typename EffectSpecificState>
 class EffectProcessorImpl : public EffectProcessor {
   public:
-    EffectProcessorImpl() {
+    EffectProcessorImpl()
+            : m_oversamplingFactor(1) {
     }
     /// Subclasses should not implement their own destructor. All state should
     /// be stored in the EffectState subclass, not the EffectProcessorImpl subclass.
@@ -184,15 +215,36 @@ class EffectProcessorImpl : public EffectProcessor {
                            << "EffectState should have been preallocated in the"
                               "main thread.";
             }
-            pState = createSpecificState(engineParameters);
+            pState = createOversampledState(engineParameters);
             m_channelStateMatrix[inputHandle][outputHandle] = pState;
         }
-        processChannel(pState, pInput, pOutput, engineParameters, enableState, groupFeatures);
+        EffectOversampler* pOversampler = pState->oversampler();
+        if (!pOversampler) {
+            processChannel(pState, pInput, pOutput, engineParameters, enableState, groupFeatures);
+            return;
+        }
+        if (enableState == EffectEnableState::Enabling) {
+            // Discard the history from before the effect has been disabled
+            pOversampler->clear();
+        }
+        const SINT numFrames = engineParameters.framesPerBuffer();
+        const CSAMPLE* pOversampledInput = pOversampler->upsample(pInput, numFrames);
+        processChannel(pState,
+                pOversampledInput,
+                pOversampler->oversampledOutput(),
+                oversampledParameters(engineParameters),
+                enableState,
+                groupFeatures);
+        pOversampler->downsample(pOutput, numFrames);
     }
 
     void initialize(const QSet<ChannelHandleAndGroup>& activeInputChannels,
             const QSet<ChannelHandleAndGroup>& registeredOutputChannels,
-            const mixxx::EngineParameters& engineParameters) final {
+            const mixxx::EngineParameters& engineParameters,
+            int oversamplingFactor) final {
+        DEBUG_ASSERT(oversamplingFactor == 1 ||
+                EffectOversampler::isValidFactor(oversamplingFactor));
+        m_oversamplingFactor = oversamplingFactor;
         m_registeredOutputChannels = registeredOutputChannels;
 
         for (const ChannelHandleAndGroup& inputChannel : activeInputChannels) {
@@ -205,7 +257,7 @@ class EffectProcessorImpl : public EffectProcessor {
             for (const ChannelHandleAndGroup& outputChannel :
                     std::as_const(m_registeredOutputChannels)) {
                 outputChannelMap.insert(outputChannel.handle(),
-                        createSpecificState(engineParameters));
+                        createOversampledState(engineParameters));
                 if (kEffectDebugOutput) {
                     qDebug() << this << "EffectProcessorImpl::initialize "
                                         "registering output"
@@ -217,7 +269,7 @@ class EffectProcessorImpl : public EffectProcessor {
     };
 
     EffectState* createState(const mixxx::EngineParameters& engineParameters) final {
-        return createSpecificState(engineParameters);
+        return createOversampledState(engineParameters);
     };
 
     bool loadStatesForInputChannel(ChannelHandle inputChannel,
@@ -314,6 +366,33 @@ class EffectProcessorImpl : public EffectProcessor {
     };
 
   private:
+    mixxx::EngineParameters oversampledParameters(
+            const mixxx::EngineParameters& engineParameters) const {
+        return mixxx::EngineParameters(
+                mixxx::audio::SampleRate(
+                        engineParameters.sampleRate() * m_oversamplingFactor),
+                engineParameters.framesPerBuffer() * m_oversamplingFactor);
+    }
+
+    /// The state of an oversampled effect is created with the oversampled
+    /// EngineParameters
+    EffectSpecificState* createOversampledState(
+            const mixxx::EngineParameters& engineParameters) {
+        if (m_oversamplingFactor == 1) {
+            EffectSpecificState* pState = createSpecificState(engineParameters);
+            pState->setAccountedBytes(sizeof(EffectSpecificState));
+            return pState;
+        }
+        EffectSpecificState* pState = createSpecificState(
+                oversampledParameters(engineParameters));
+        pState->setAccountedBytes(sizeof(EffectSpecificState) +
+                sizeof(EffectOversampler));
+        pState->setOversampler(std::make_unique<EffectOversampler>(
+                m_oversamplingFactor, engineParameters.framesPerBuffer()));
+        return pState;
+    }
+
+    int m_oversamplingFactor;
     QSet<ChannelHandleAndGroup> m_registeredOutputChannels;
     ChannelHandleMap<ChannelHandleMap<EffectSpecificState*>> m_channelStateMatrix;
 };
@@ -8,6 +8,7 @@
 #include "effects/defs.h"
 
 class EffectProcessor;
+class EngineWorkerScheduler;
 
 /// EffectsBackend is an abstract base class that enumerates available effects
 /// which are identified by EffectManifests. EffectsBackends create an
@@ -36,6 +37,13 @@ class EffectsBackend {
     virtual std::unique_ptr<EffectProcessor> createProcessor(
             const EffectManifestPointer pManifest) const = 0;
 
+    /// Called once from the main thread after the engine has been created.
+    /// Backends that need to run non real-time work for their processors
+    /// register their EngineWorkers.
+    virtual void bindWorkers(EngineWorkerScheduler* pScheduler) {
+        Q_UNUSED(pScheduler);
+    }
+
     static EffectBackendType backendTypeFromString(const QString& typeName);
     static QString backendTypeToString(EffectBackendType backendType);
     /// Use this when showing the string in the GUI
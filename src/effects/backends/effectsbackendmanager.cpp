@@ -1,5 +1,7 @@
 #include "effects/backends/effectsbackendmanager.h"
 
+#include <QDir>
+
 #include "control/controlobject.h"
 #include "effects/backends/builtin/builtinbackend.h"
 #include "effects/backends/effectprocessor.h"
@@ -8,14 +10,17 @@
 #endif
 #include "effects/presets/effectpreset.h"
 
-EffectsBackendManager::EffectsBackendManager() {
+EffectsBackendManager::EffectsBackendManager(UserSettingsPointer pConfig) {
     m_pNumEffectsAvailable = std::make_unique<ControlObject>(
             ConfigKey("[Master]", "num_effectsavailable"));
     m_pNumEffectsAvailable->setReadOnly();
 
     addBackend(EffectsBackendPointer(new BuiltInBackend()));
 #ifdef __LILV__
-    addBackend(EffectsBackendPointer(new LV2Backend()));
+    addBackend(EffectsBackendPointer(new LV2Backend(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("lv2manifests.json")))));
+#else
+    Q_UNUSED(pConfig);
 #endif
 }
 
@@ -125,3 +130,9 @@ std::unique_ptr<EffectProcessor> EffectsBackendManager::createProcessor(
     }
     return pBackend->createProcessor(pManifest);
 }
+
+void EffectsBackendManager::bindWorkers(EngineWorkerScheduler* pScheduler) {
+    for (const auto& pBackend : std::as_const(m_effectsBackends)) {
+        pBackend->bindWorkers(pScheduler);
+    }
+}
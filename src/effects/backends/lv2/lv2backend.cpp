@@ -1,16 +1,97 @@
 #include "effects/backends/lv2/lv2backend.h"
 
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <algorithm>
+
 #include "effects/backends/lv2/lv2effectprocessor.h"
 #include "effects/backends/lv2/lv2manifest.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("LV2Backend");
+
+// Increment when the stored manifest format changes
+constexpr int kManifestCacheVersion = 1;
+
+const QString kVersionKey = QStringLiteral("version");
+const QString kPluginsKey = QStringLiteral("plugins");
+const QString kBundleKey = QStringLiteral("bundle");
+const QString kBundleModifiedKey = QStringLiteral("bundleModified");
+const QString kManifestKey = QStringLiteral("manifest");
+
+QString bundlePath(const LilvPlugin* plug) {
+    const LilvNode* pBundleUri = lilv_plugin_get_bundle_uri(plug);
+    char* pPath = lilv_file_uri_parse(lilv_node_as_uri(pBundleUri), nullptr);
+    if (!pPath) {
+        return QString();
+    }
+    const QString path = QString::fromLocal8Bit(pPath);
+    lilv_free(pPath);
+    return path;
+}
+
+/// The latest modification time of the bundle directory and its files, in
+/// milliseconds since the epoch
+qint64 bundleModified(const QString& path) {
+    const QDir bundleDir(path);
+    qint64 modified = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+    const QFileInfoList files = bundleDir.entryInfoList(
+            QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const auto& file : files) {
+        modified = std::max(modified, file.lastModified().toMSecsSinceEpoch());
+    }
+    return modified;
+}
+
+QJsonObject readManifestCache(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    const QJsonObject cache = QJsonDocument::fromJson(file.readAll()).object();
+    if (cache.value(kVersionKey).toInt() != kManifestCacheVersion) {
+        return QJsonObject();
+    }
+    return cache.value(kPluginsKey).toObject();
+}
 
-LV2Backend::LV2Backend() {
+void writeManifestCache(const QString& filePath, const QJsonObject& plugins) {
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning() << "Failed to write manifest cache" << filePath;
+        return;
+    }
+    const QJsonObject cache{
+            {kVersionKey, kManifestCacheVersion},
+            {kPluginsKey, plugins},
+    };
+    file.write(QJsonDocument(cache).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        kLogger.warning() << "Failed to write manifest cache" << filePath;
+    }
+}
+
+} // anonymous namespace
+
+LV2Backend::LV2Backend(const QString& manifestCacheFilePath)
+        : m_pInstanceCache(std::make_shared<LV2InstanceCache>()) {
     m_pWorld = lilv_world_new();
     initializeProperties();
+    // Only reads the manifest.ttl files of the bundles. The data of each
+    // plugin is loaded by lilv when it is accessed for the first time.
     lilv_world_load_all(m_pWorld);
-    enumeratePlugins();
+    enumeratePlugins(manifestCacheFilePath);
 }
 
 LV2Backend::~LV2Backend() {
+    // The cached instances must not outlive the plugins of the world
+    m_pInstanceCache->clear();
     for (LilvNode* node : std::as_const(m_properties)) {
         lilv_node_free(node);
     }
@@ -18,16 +99,54 @@ LV2Backend::~LV2Backend() {
     m_registeredEffects.clear();
 }
 
-void LV2Backend::enumeratePlugins() {
+void LV2Backend::enumeratePlugins(const QString& manifestCacheFilePath) {
+    const QJsonObject cachedPlugins = manifestCacheFilePath.isEmpty()
+            ? QJsonObject()
+            : readManifestCache(manifestCacheFilePath);
+    QJsonObject plugins;
+    QHash<QString, qint64> bundleModifiedByPath;
+    int numBuiltManifests = 0;
+
     const LilvPlugins* plugs = lilv_world_get_all_plugins(m_pWorld);
     LILV_FOREACH(plugins, i, plugs) {
         const LilvPlugin* plug = lilv_plugins_get(plugs, i);
         if (lilv_plugin_is_replaced(plug)) {
             continue;
         }
-        auto lv2Manifest = LV2EffectManifestPointer::create(plug, m_properties);
+        const QString uri = lilv_node_as_uri(lilv_plugin_get_uri(plug));
+        const QString bundle = bundlePath(plug);
+        auto modifiedIt = bundleModifiedByPath.constFind(bundle);
+        if (modifiedIt == bundleModifiedByPath.constEnd()) {
+            modifiedIt = bundleModifiedByPath.insert(bundle, bundleModified(bundle));
+        }
+
+        LV2EffectManifestPointer lv2Manifest;
+        const QJsonObject cachedPlugin = cachedPlugins.value(uri).toObject();
+        if (!bundle.isEmpty() &&
+                cachedPlugin.value(kBundleKey).toString() == bundle &&
+                cachedPlugin.value(kBundleModifiedKey).toString().toLongLong() ==
+                        modifiedIt.value()) {
+            lv2Manifest = LV2EffectManifestPointer::create(
+                    plug, cachedPlugin.value(kManifestKey).toObject());
+        } else {
+            lv2Manifest = LV2EffectManifestPointer::create(plug, m_properties);
+            ++numBuiltManifests;
+        }
         lv2Manifest->setBackendType(getType());
         m_registeredEffects.insert(lv2Manifest->id(), lv2Manifest);
+        plugins.insert(uri,
+                QJsonObject{
+                        {kBundleKey, bundle},
+                        // QJsonValue has no 64 bit integer type before Qt 6
+                        {kBundleModifiedKey, QString::number(modifiedIt.value())},
+                        {kManifestKey, lv2Manifest->toJson()},
+                });
+    }
+
+    kLogger.debug() << "Built" << numBuiltManifests << "of"
+                    << m_registeredEffects.size() << "manifests";
+    if (!manifestCacheFilePath.isEmpty() && plugins != cachedPlugins) {
+        writeManifestCache(manifestCacheFilePath, plugins);
     }
 }
 
@@ -87,7 +206,11 @@ std::unique_ptr<EffectProcessor> LV2Backend::createProcessor(
     VERIFY_OR_DEBUG_ASSERT(pLV2Manifest) {
         return nullptr;
     }
-    return std::make_unique<LV2EffectProcessor>(pLV2Manifest);
+    return std::make_unique<LV2EffectProcessor>(pLV2Manifest, m_pInstanceCache);
+}
+
+void LV2Backend::bindWorkers(EngineWorkerScheduler* pScheduler) {
+    m_pInstanceCache->bindWorkers(pScheduler);
 }
 
 LV2EffectManifestPointer LV2Backend::getLV2Manifest(const QString& effectId) const {
@@ -2,15 +2,25 @@
 
 #include <lilv/lilv.h>
 
+#include <memory>
+
 #include "effects/backends/effectsbackend.h"
+#include "effects/backends/lv2/lv2instancecache.h"
 #include "effects/backends/lv2/lv2manifest.h"
 #include "effects/defs.h"
 #include "preferences/usersettings.h"
 
 /// Refer to EffectsBackend for documentation
+///
+/// Building the manifests requires lilv to parse the data of all installed
+/// plugins, which takes a long time with many plugins. The manifests are
+/// stored in a cache file together with the modification time of their
+/// bundle, so only the manifests of new or changed bundles are built. The
+/// data of the other plugins is not loaded before they are instantiated.
 class LV2Backend : public EffectsBackend {
   public:
-    LV2Backend();
+    /// The cache is disabled if manifestCacheFilePath is empty.
+    explicit LV2Backend(const QString& manifestCacheFilePath = QString());
     virtual ~LV2Backend();
 
     EffectBackendType getType() const {
@@ -25,13 +35,15 @@ class LV2Backend : public EffectsBackend {
     std::unique_ptr<EffectProcessor> createProcessor(
             const EffectManifestPointer pManifest) const;
     bool canInstantiateEffect(const QString& effectId) const;
+    void bindWorkers(EngineWorkerScheduler* pScheduler) override;
 
   private:
-    void enumeratePlugins();
+    void enumeratePlugins(const QString& manifestCacheFilePath);
     void initializeProperties();
     LilvWorld* m_pWorld;
     QHash<QString, LilvNode*> m_properties;
     QHash<QString, LV2EffectManifestPointer> m_registeredEffects;
+    std::shared_ptr<LV2InstanceCache> m_pInstanceCache;
 
     QString debugString() const {
         return "LV2Backend";
@@ -3,8 +3,10 @@
 #include "util/defs.h"
 #include "util/sample.h"
 
-LV2EffectProcessor::LV2EffectProcessor(LV2EffectManifestPointer pManifest)
+LV2EffectProcessor::LV2EffectProcessor(LV2EffectManifestPointer pManifest,
+        std::shared_ptr<LV2InstanceCache> pInstanceCache)
         : m_pManifest(pManifest),
+          m_pInstanceCache(std::move(pInstanceCache)),
           m_pPlugin(pManifest->getPlugin()),
           m_audioPortIndices(pManifest->getAudioPortIndices()),
           m_controlPortIndices(pManifest->getControlPortIndices()) {
@@ -58,13 +60,18 @@ void LV2EffectProcessor::processChannel(
         m_inputR[i] = pInput[i * 2 + 1];
     }
 
-    LilvInstance* instance = channelState->lilvInstance(m_pPlugin, engineParameters);
+    LV2Instance* pInstance = channelState->instance();
+    if (!pInstance) {
+        // The plugin could not be instantiated
+        SampleUtil::copy(pOutput, pInput, engineParameters.samplesPerBuffer());
+        return;
+    }
 
     if (enableState == EffectEnableState::Enabling) {
-        lilv_instance_activate(instance);
+        pInstance->activate();
     }
 
-    lilv_instance_run(instance, framesPerBuffer);
+    pInstance->run(framesPerBuffer);
 
     // note: LOOP VECTORIZED.
     for (SINT i = 0; i < framesPerBuffer; ++i) {
@@ -73,14 +80,15 @@ void LV2EffectProcessor::processChannel(
     }
 
     if (enableState == EffectEnableState::Disabling) {
-        lilv_instance_deactivate(instance);
+        pInstance->deactivate();
     }
 }
 
 LV2EffectGroupState* LV2EffectProcessor::createSpecificState(
         const mixxx::EngineParameters& engineParameters) {
-    LV2EffectGroupState* pState = new LV2EffectGroupState(engineParameters);
-    LilvInstance* pInstance = pState->lilvInstance(m_pPlugin, engineParameters);
+    LV2EffectGroupState* pState = new LV2EffectGroupState(
+            engineParameters, m_pInstanceCache, m_pPlugin);
+    LV2Instance* pInstance = pState->instance();
     VERIFY_OR_DEBUG_ASSERT(pInstance) {
         return pState;
     }
@@ -89,20 +97,18 @@ LV2EffectGroupState* LV2EffectProcessor::createSpecificState(
         qDebug() << this << "LV2EffectProcessor creating LV2EffectGroupState" << pState;
     }
 
-    if (pInstance) {
-        for (int i = 0; i < m_engineEffectParameters.size(); i++) {
-            m_LV2parameters[i] = static_cast<float>(m_engineEffectParameters[i]->value());
-            lilv_instance_connect_port(pInstance,
-                    m_controlPortIndices[i],
-                    &m_LV2parameters[i]);
-        }
-
-        // We assume the audio ports are in the following order:
-        // input_left, input_right, output_left, output_right
-        lilv_instance_connect_port(pInstance, m_audioPortIndices[0], m_inputL);
-        lilv_instance_connect_port(pInstance, m_audioPortIndices[1], m_inputR);
-        lilv_instance_connect_port(pInstance, m_audioPortIndices[2], m_outputL);
-        lilv_instance_connect_port(pInstance, m_audioPortIndices[3], m_outputR);
+    // Cached instances are still connected to the buffers of the
+    // processor that used them before
+    for (int i = 0; i < m_engineEffectParameters.size(); i++) {
+        m_LV2parameters[i] = static_cast<float>(m_engineEffectParameters[i]->value());
+        pInstance->connectPort(m_controlPortIndices[i], &m_LV2parameters[i]);
     }
+
+    // We assume the audio ports are in the following order:
+    // input_left, input_right, output_left, output_right
+    pInstance->connectPort(m_audioPortIndices[0], m_inputL);
+    pInstance->connectPort(m_audioPortIndices[1], m_inputR);
+    pInstance->connectPort(m_audioPortIndices[2], m_outputL);
+    pInstance->connectPort(m_audioPortIndices[3], m_outputR);
     return pState;
 };
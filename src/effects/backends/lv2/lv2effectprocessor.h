@@ -2,7 +2,10 @@
 
 #include <lilv/lilv.h>
 
+#include <memory>
+
 #include "effects/backends/effectprocessor.h"
+#include "effects/backends/lv2/lv2instancecache.h"
 #include "effects/backends/lv2/lv2manifest.h"
 #include "effects/defs.h"
 #include "engine/effects/engineeffectparameter.h"
@@ -11,33 +14,35 @@
 // Refer to EffectProcessor for documentation
 class LV2EffectGroupState final : public EffectState {
   public:
-    LV2EffectGroupState(const mixxx::EngineParameters& engineParameters)
+    /// Called in main thread
+    LV2EffectGroupState(const mixxx::EngineParameters& engineParameters,
+            std::shared_ptr<LV2InstanceCache> pInstanceCache,
+            const LilvPlugin* pPlugin)
             : EffectState(engineParameters),
-              m_pInstance(nullptr) {
+              m_pInstanceCache(std::move(pInstanceCache)),
+              m_pInstance(m_pInstanceCache->acquire(
+                      pPlugin, engineParameters.sampleRate())) {
     }
+    /// Called in main thread
     ~LV2EffectGroupState() {
         if (m_pInstance) {
-            lilv_instance_deactivate(m_pInstance);
-            lilv_instance_free(m_pInstance);
+            m_pInstanceCache->release(std::move(m_pInstance));
         }
     }
 
-    LilvInstance* lilvInstance(const LilvPlugin* pPlugin,
-            const mixxx::EngineParameters& engineParameters) {
-        if (!m_pInstance) {
-            m_pInstance = lilv_plugin_instantiate(
-                    pPlugin, engineParameters.sampleRate(), nullptr);
-        }
-        return m_pInstance;
+    LV2Instance* instance() const {
+        return m_pInstance.get();
     }
 
   private:
-    LilvInstance* m_pInstance;
+    const std::shared_ptr<LV2InstanceCache> m_pInstanceCache;
+    std::unique_ptr<LV2Instance> m_pInstance;
 };
 
 class LV2EffectProcessor final : public EffectProcessorImpl<LV2EffectGroupState> {
   public:
-    LV2EffectProcessor(LV2EffectManifestPointer pManifest);
+    LV2EffectProcessor(LV2EffectManifestPointer pManifest,
+            std::shared_ptr<LV2InstanceCache> pInstanceCache);
     ~LV2EffectProcessor();
 
     void loadEngineEffectParameters(
@@ -56,6 +61,7 @@ class LV2EffectProcessor final : public EffectProcessorImpl<LV2EffectGroupState>
             const mixxx::EngineParameters& engineParameters) override;
 
     LV2EffectManifestPointer m_pManifest;
+    const std::shared_ptr<LV2InstanceCache> m_pInstanceCache;
     QList<EngineEffectParameterPointer> m_engineEffectParameters;
     float* m_inputL;
     float* m_inputR;
@@ -0,0 +1,81 @@
+#include "effects/backends/lv2/lv2instance.h"
+
+#include <vector>
+
+#include "util/assert.h"
+
+// static
+std::unique_ptr<LV2Instance> LV2Instance::create(
+        const LilvPlugin* pPlugin,
+        double sampleRate,
+        const LV2_Feature* const* pFeatures,
+        LV2Worker* pWorker) {
+    auto pSchedule = std::make_unique<LV2WorkerSchedule>(pWorker);
+
+    // The worker feature is specific for each instance
+    std::vector<const LV2_Feature*> features;
+    for (const LV2_Feature* const* ppFeature = pFeatures; *ppFeature; ++ppFeature) {
+        features.push_back(*ppFeature);
+    }
+    features.push_back(pSchedule->feature());
+    features.push_back(nullptr);
+
+    LilvInstance* pInstance = lilv_plugin_instantiate(
+            pPlugin, sampleRate, features.data());
+    if (!pInstance) {
+        return nullptr;
+    }
+    pSchedule->setInstance(pInstance);
+    return std::unique_ptr<LV2Instance>(new LV2Instance(
+            pPlugin, sampleRate, pInstance, pWorker, std::move(pSchedule)));
+}
+
+LV2Instance::LV2Instance(const LilvPlugin* pPlugin,
+        double sampleRate,
+        LilvInstance* pInstance,
+        LV2Worker* pWorker,
+        std::unique_ptr<LV2WorkerSchedule> pSchedule)
+        : m_pPlugin(pPlugin),
+          m_sampleRate(sampleRate),
+          m_pInstance(pInstance),
+          m_pWorker(pWorker),
+          m_pSchedule(std::move(pSchedule)),
+          m_active(false) {
+}
+
+LV2Instance::~LV2Instance() {
+    deactivate();
+    // The worker must not access the instance after it has been freed
+    m_pSchedule.reset();
+    lilv_instance_free(m_pInstance);
+}
+
+void LV2Instance::activate() {
+    if (m_active) {
+        return;
+    }
+    lilv_instance_activate(m_pInstance);
+    m_active = true;
+}
+
+void LV2Instance::deactivate() {
+    if (!m_active) {
+        return;
+    }
+    lilv_instance_deactivate(m_pInstance);
+    m_active = false;
+}
+
+void LV2Instance::run(uint32_t sampleCount) {
+    m_pSchedule->deliverResponses();
+    lilv_instance_run(m_pInstance, sampleCount);
+    m_pSchedule->endRun();
+}
+
+void LV2Instance::reset() {
+    deactivate();
+    // Responses are delivered synchronously instead of being dropped,
+    // because they might transfer the ownership of resources to the plugin
+    m_pWorker->finishWork(m_pSchedule.get());
+    m_pSchedule->deliverResponses();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <lilv/lilv.h>
+
+#include <memory>
+
+#include "effects/backends/lv2/lv2worker.h"
+#include "util/class.h"
+
+/// Owns an instantiated LV2 plugin together with its LV2 worker schedule.
+/// Instances are created and destroyed by the LV2InstanceCache in the main
+/// thread. activate(), deactivate() and run() are called in the audio thread.
+class LV2Instance {
+  public:
+    /// Returns nullptr if the plugin could not be instantiated
+    static std::unique_ptr<LV2Instance> create(
+            const LilvPlugin* pPlugin,
+            double sampleRate,
+            const LV2_Feature* const* pFeatures,
+            LV2Worker* pWorker);
+    ~LV2Instance();
+
+    const LilvPlugin* plugin() const {
+        return m_pPlugin;
+    }
+    double sampleRate() const {
+        return m_sampleRate;
+    }
+
+    void connectPort(uint32_t portIndex, void* pData) {
+        lilv_instance_connect_port(m_pInstance, portIndex, pData);
+    }
+
+    void activate();
+    void deactivate();
+    void run(uint32_t sampleCount);
+
+    /// Called in main thread when the instance is no longer used by the
+    /// audio thread. Deactivates the instance and finishes its pending work.
+    void reset();
+
+  private:
+    LV2Instance(const LilvPlugin* pPlugin,
+            double sampleRate,
+            LilvInstance* pInstance,
+            LV2Worker* pWorker,
+            std::unique_ptr<LV2WorkerSchedule> pSchedule);
+
+    const LilvPlugin* const m_pPlugin;
+    const double m_sampleRate;
+    LilvInstance* m_pInstance;
+    LV2Worker* m_pWorker;
+    std::unique_ptr<LV2WorkerSchedule> m_pSchedule;
+    bool m_active;
+
+    DISALLOW_COPY_AND_ASSIGN(LV2Instance);
+};
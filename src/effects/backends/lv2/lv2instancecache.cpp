@@ -0,0 +1,91 @@
+#include "effects/backends/lv2/lv2instancecache.h"
+
+#include <cstring>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+
+namespace {
+
+// Enough for a few effects on all channels, each instance may allocate
+// large buffers
+constexpr std::size_t kMaxCachedInstances = 32;
+
+} // anonymous namespace
+
+LV2InstanceCache::LV2InstanceCache()
+        : m_uridMap{this, &LV2InstanceCache::mapUri},
+          m_uridUnmap{this, &LV2InstanceCache::unmapUri},
+          m_uridMapFeature{LV2_URID__map, &m_uridMap},
+          m_uridUnmapFeature{LV2_URID__unmap, &m_uridUnmap},
+          m_features{&m_uridMapFeature, &m_uridUnmapFeature, nullptr} {
+}
+
+LV2InstanceCache::~LV2InstanceCache() {
+    clear();
+}
+
+// static
+bool LV2InstanceCache::isFeatureSupported(const char* uri) {
+    return std::strcmp(uri, LV2_URID__map) == 0 ||
+            std::strcmp(uri, LV2_URID__unmap) == 0 ||
+            std::strcmp(uri, LV2_WORKER__schedule) == 0;
+}
+
+void LV2InstanceCache::bindWorkers(EngineWorkerScheduler* pScheduler) {
+    m_worker.bind(pScheduler);
+}
+
+std::unique_ptr<LV2Instance> LV2InstanceCache::acquire(
+        const LilvPlugin* pPlugin, double sampleRate) {
+    // Prefer the most recently released instance
+    for (auto i = m_instances.rbegin(); i != m_instances.rend(); ++i) {
+        if ((*i)->plugin() == pPlugin && (*i)->sampleRate() == sampleRate) {
+            std::unique_ptr<LV2Instance> pInstance = std::move(*i);
+            m_instances.erase(std::next(i).base());
+            return pInstance;
+        }
+    }
+    return LV2Instance::create(pPlugin, sampleRate, m_features, &m_worker);
+}
+
+void LV2InstanceCache::release(std::unique_ptr<LV2Instance> pInstance) {
+    VERIFY_OR_DEBUG_ASSERT(pInstance) {
+        return;
+    }
+    pInstance->reset();
+    if (m_instances.size() >= kMaxCachedInstances) {
+        m_instances.erase(m_instances.begin());
+    }
+    m_instances.push_back(std::move(pInstance));
+}
+
+void LV2InstanceCache::clear() {
+    m_instances.clear();
+}
+
+// static
+LV2_URID LV2InstanceCache::mapUri(LV2_URID_Map_Handle handle, const char* uri) {
+    auto* pCache = static_cast<LV2InstanceCache*>(handle);
+    const QByteArray key(uri);
+    const auto locker = lockMutex(&pCache->m_uridMutex);
+    const auto i = pCache->m_uridsByUri.constFind(key);
+    if (i != pCache->m_uridsByUri.constEnd()) {
+        return i.value();
+    }
+    pCache->m_uris.append(key);
+    // 0 is reserved
+    const LV2_URID urid = static_cast<LV2_URID>(pCache->m_uris.size());
+    pCache->m_uridsByUri.insert(key, urid);
+    return urid;
+}
+
+// static
+const char* LV2InstanceCache::unmapUri(LV2_URID_Unmap_Handle handle, LV2_URID urid) {
+    auto* pCache = static_cast<LV2InstanceCache*>(handle);
+    const auto locker = lockMutex(&pCache->m_uridMutex);
+    if (urid == 0 || urid > static_cast<LV2_URID>(pCache->m_uris.size())) {
+        return nullptr;
+    }
+    return pCache->m_uris.at(urid - 1).constData();
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <lilv/lilv.h>
+#include <lv2/urid/urid.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <memory>
+#include <vector>
+
+#include "effects/backends/lv2/lv2instance.h"
+#include "effects/backends/lv2/lv2worker.h"
+#include "util/class.h"
+
+class EngineWorkerScheduler;
+
+/// Provides the LV2 host features and keeps instances of LV2 plugins that
+/// are no longer used by an effect. Loading an effect preset or enabling an
+/// effect for another channel creates new effect states, which reuse a
+/// cached instance of the same plugin instead of instantiating it again.
+/// Activating an instance resets it, so cached instances do not
+/// carry over any audio of their previous use.
+///
+/// All functions must be called from the main thread.
+class LV2InstanceCache {
+  public:
+    LV2InstanceCache();
+    ~LV2InstanceCache();
+
+    /// Returns true if the host feature with the URI is provided
+    static bool isFeatureSupported(const char* uri);
+
+    void bindWorkers(EngineWorkerScheduler* pScheduler);
+
+    /// Returns a deactivated instance or nullptr if the plugin could not
+    /// be instantiated
+    std::unique_ptr<LV2Instance> acquire(const LilvPlugin* pPlugin, double sampleRate);
+    /// Must only be called when the audio thread no longer uses the instance
+    void release(std::unique_ptr<LV2Instance> pInstance);
+
+    /// Frees all cached instances
+    void clear();
+
+  private:
+    static LV2_URID mapUri(LV2_URID_Map_Handle handle, const char* uri);
+    static const char* unmapUri(LV2_URID_Unmap_Handle handle, LV2_URID urid);
+
+    // Must outlive all instances
+    LV2Worker m_worker;
+
+    // Plugins might also map URIs in the worker thread
+    QMutex m_uridMutex;
+    QHash<QByteArray, LV2_URID> m_uridsByUri;
+    QList<QByteArray> m_uris;
+
+    LV2_URID_Map m_uridMap;
+    LV2_URID_Unmap m_uridUnmap;
+    LV2_Feature m_uridMapFeature;
+    LV2_Feature m_uridUnmapFeature;
+    const LV2_Feature* m_features[3];
+
+    // Ordered from least to most recently released
+    std::vector<std::unique_ptr<LV2Instance>> m_instances;
+
+    DISALLOW_COPY_AND_ASSIGN(LV2InstanceCache);
+};
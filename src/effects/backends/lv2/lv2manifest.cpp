@@ -1,8 +1,46 @@
 #include "effects/backends/lv2/lv2manifest.h"
 
+#include <QJsonArray>
+
 #include "effects/backends/effectmanifestparameter.h"
+#include "effects/backends/lv2/lv2instancecache.h"
 #include "util/fpclassify.h"
 
+namespace {
+
+const QString kIdKey = QStringLiteral("id");
+const QString kNameKey = QStringLiteral("name");
+const QString kAuthorKey = QStringLiteral("author");
+const QString kStatusKey = QStringLiteral("status");
+const QString kAudioPortIndicesKey = QStringLiteral("audioPortIndices");
+const QString kControlPortIndicesKey = QStringLiteral("controlPortIndices");
+const QString kParametersKey = QStringLiteral("parameters");
+const QString kUnitsHintKey = QStringLiteral("unitsHint");
+const QString kValueScalerKey = QStringLiteral("valueScaler");
+const QString kMinimumKey = QStringLiteral("minimum");
+const QString kDefaultKey = QStringLiteral("default");
+const QString kMaximumKey = QStringLiteral("maximum");
+const QString kStepsKey = QStringLiteral("steps");
+
+QJsonArray indicesToJson(const QList<int>& indices) {
+    QJsonArray array;
+    for (int index : indices) {
+        array.append(index);
+    }
+    return array;
+}
+
+QList<int> indicesFromJson(const QJsonValue& value) {
+    QList<int> indices;
+    const QJsonArray array = value.toArray();
+    for (const auto& index : array) {
+        indices.append(index.toInt());
+    }
+    return indices;
+}
+
+} // anonymous namespace
+
 LV2Manifest::LV2Manifest(const LilvPlugin* plug,
         QHash<QString, LilvNode*>& properties)
         : EffectManifest(),
@@ -146,14 +184,77 @@ LV2Manifest::LV2Manifest(const LilvPlugin* plug,
         m_status = IO_NOT_STEREO;
     }
 
-    // We don't support any features
+    // We only support the features provided by LV2InstanceCache
     LilvNodes* features = lilv_plugin_get_required_features(m_pLV2plugin);
-    if (lilv_nodes_size(features) > 0) {
-        m_status = HAS_REQUIRED_FEATURES;
+    LILV_FOREACH(nodes, i, features) {
+        const LilvNode* feature = lilv_nodes_get(features, i);
+        if (!LV2InstanceCache::isFeatureSupported(lilv_node_as_uri(feature))) {
+            m_status = HAS_REQUIRED_FEATURES;
+        }
     }
     lilv_nodes_free(features);
 }
 
+LV2Manifest::LV2Manifest(const LilvPlugin* plug, const QJsonObject& json)
+        : EffectManifest(),
+          m_pLV2plugin(plug),
+          audioPortIndices(indicesFromJson(json.value(kAudioPortIndicesKey))),
+          controlPortIndices(indicesFromJson(json.value(kControlPortIndicesKey))),
+          m_status(static_cast<Status>(json.value(kStatusKey).toInt())) {
+    setId(json.value(kIdKey).toString());
+    setName(json.value(kNameKey).toString());
+    setAuthor(json.value(kAuthorKey).toString());
+
+    const QJsonArray parameters = json.value(kParametersKey).toArray();
+    for (const auto& parameterValue : parameters) {
+        const QJsonObject parameter = parameterValue.toObject();
+        EffectManifestParameterPointer param = addParameter();
+        param->setName(parameter.value(kNameKey).toString());
+        param->setId(parameter.value(kIdKey).toString());
+        param->setUnitsHint(static_cast<EffectManifestParameter::UnitsHint>(
+                parameter.value(kUnitsHintKey).toInt()));
+        param->setValueScaler(static_cast<EffectManifestParameter::ValueScaler>(
+                parameter.value(kValueScalerKey).toInt()));
+        const QJsonArray steps = parameter.value(kStepsKey).toArray();
+        for (const auto& stepValue : steps) {
+            const QJsonArray step = stepValue.toArray();
+            param->appendStep(qMakePair(step.at(0).toString(), step.at(1).toDouble()));
+        }
+        param->setRange(parameter.value(kMinimumKey).toDouble(),
+                parameter.value(kDefaultKey).toDouble(),
+                parameter.value(kMaximumKey).toDouble());
+    }
+}
+
+QJsonObject LV2Manifest::toJson() const {
+    QJsonArray parameters;
+    for (const auto& pParameter : EffectManifest::parameters()) {
+        QJsonArray steps;
+        for (const auto& step : pParameter->getSteps()) {
+            steps.append(QJsonArray{step.first, step.second});
+        }
+        parameters.append(QJsonObject{
+                {kNameKey, pParameter->name()},
+                {kIdKey, pParameter->id()},
+                {kUnitsHintKey, static_cast<int>(pParameter->unitsHint())},
+                {kValueScalerKey, static_cast<int>(pParameter->valueScaler())},
+                {kMinimumKey, pParameter->getMinimum()},
+                {kDefaultKey, pParameter->getDefault()},
+                {kMaximumKey, pParameter->getMaximum()},
+                {kStepsKey, steps},
+        });
+    }
+    return QJsonObject{
+            {kIdKey, id()},
+            {kNameKey, name()},
+            {kAuthorKey, author()},
+            {kStatusKey, static_cast<int>(m_status)},
+            {kAudioPortIndicesKey, indicesToJson(audioPortIndices)},
+            {kControlPortIndicesKey, indicesToJson(controlPortIndices)},
+            {kParametersKey, parameters},
+    };
+}
+
 QList<int> LV2Manifest::getAudioPortIndices() {
     return audioPortIndices;
 }
@@ -2,6 +2,7 @@
 
 #include <lilv/lilv.h>
 
+#include <QJsonObject>
 #include <QSharedPointer>
 #include <vector>
 
@@ -18,6 +19,12 @@ class LV2Manifest : public EffectManifest {
     };
 
     LV2Manifest(const LilvPlugin* plug, QHash<QString, LilvNode*>& properties);
+    /// Restores a manifest that was stored with toJson() without accessing
+    /// the data of the plugin, which is only loaded by lilv once the plugin
+    /// is instantiated.
+    LV2Manifest(const LilvPlugin* plug, const QJsonObject& json);
+
+    QJsonObject toJson() const;
 
     QList<int> getAudioPortIndices();
     QList<int> getControlPortIndices();
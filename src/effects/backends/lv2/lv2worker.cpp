@@ -0,0 +1,198 @@
+#include "effects/backends/lv2/lv2worker.h"
+
+#include <cstring>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/math.h"
+
+namespace {
+
+// Each message is stored with a header that contains its size
+constexpr int kFifoSize = 16384;
+constexpr uint32_t kMaxMessageSize = 4096;
+
+void copyToRegions(char* pRegion1,
+        ring_buffer_size_t size1,
+        char* pRegion2,
+        int offset,
+        const void* pData,
+        int size) {
+    const char* pBytes = static_cast<const char*>(pData);
+    const int sizeInRegion1 = math_max(0, math_min(size, size1 - offset));
+    if (sizeInRegion1 > 0) {
+        std::memcpy(pRegion1 + offset, pBytes, sizeInRegion1);
+    }
+    if (sizeInRegion1 < size) {
+        std::memcpy(pRegion2 + math_max(0, offset - size1),
+                pBytes + sizeInRegion1,
+                size - sizeInRegion1);
+    }
+}
+
+/// Publishes the header and the data at once. Must only be called by
+/// a single thread for each FIFO.
+bool writeMessage(FIFO<char>* pFifo, uint32_t size, const void* pData) {
+    if (size > kMaxMessageSize) {
+        return false;
+    }
+    const int messageSize = static_cast<int>(sizeof(size) + size);
+    if (pFifo->writeAvailable() < messageSize) {
+        return false;
+    }
+    char* pRegion1;
+    ring_buffer_size_t size1;
+    char* pRegion2;
+    ring_buffer_size_t size2;
+    pFifo->aquireWriteRegions(messageSize, &pRegion1, &size1, &pRegion2, &size2);
+    copyToRegions(pRegion1, size1, pRegion2, 0, &size, sizeof(size));
+    copyToRegions(pRegion1, size1, pRegion2, sizeof(size), pData, size);
+    pFifo->releaseWriteRegions(messageSize);
+    return true;
+}
+
+bool readMessage(FIFO<char>* pFifo, std::vector<char>* pMessage, uint32_t* pSize) {
+    if (pFifo->readAvailable() < static_cast<int>(sizeof(*pSize))) {
+        return false;
+    }
+    pFifo->read(reinterpret_cast<char*>(pSize), sizeof(*pSize));
+    DEBUG_ASSERT(*pSize <= pMessage->size());
+    pFifo->read(pMessage->data(), *pSize);
+    return true;
+}
+
+} // anonymous namespace
+
+LV2Worker::LV2Worker()
+        : m_bound(false),
+          m_stop(0) {
+}
+
+LV2Worker::~LV2Worker() {
+    DEBUG_ASSERT(m_schedules.isEmpty());
+    m_stop = 1;
+    m_semaRun.release();
+    wait();
+}
+
+void LV2Worker::bind(EngineWorkerScheduler* pScheduler) {
+    VERIFY_OR_DEBUG_ASSERT(!isBound()) {
+        return;
+    }
+    setScheduler(pScheduler);
+    start(QThread::NormalPriority);
+    m_bound.store(true, std::memory_order_release);
+}
+
+void LV2Worker::addSchedule(LV2WorkerSchedule* pSchedule) {
+    const auto locker = lockMutex(&m_mutex);
+    m_schedules.append(pSchedule);
+}
+
+void LV2Worker::removeSchedule(LV2WorkerSchedule* pSchedule) {
+    const auto locker = lockMutex(&m_mutex);
+    m_schedules.removeOne(pSchedule);
+}
+
+void LV2Worker::finishWork(LV2WorkerSchedule* pSchedule) {
+    const auto locker = lockMutex(&m_mutex);
+    pSchedule->performWork();
+}
+
+void LV2Worker::run() {
+    while (true) {
+        m_semaRun.acquire();
+        if (m_stop.loadAcquire()) {
+            break;
+        }
+        const auto locker = lockMutex(&m_mutex);
+        for (LV2WorkerSchedule* pSchedule : std::as_const(m_schedules)) {
+            pSchedule->performWork();
+        }
+    }
+}
+
+LV2WorkerSchedule::LV2WorkerSchedule(LV2Worker* pWorker)
+        : m_pWorker(pWorker),
+          m_schedule{this, &LV2WorkerSchedule::scheduleWork},
+          m_feature{LV2_WORKER__schedule, &m_schedule},
+          m_pInstance(nullptr),
+          m_pInterface(nullptr),
+          m_requests(kFifoSize),
+          m_responses(kFifoSize),
+          m_requestMessage(kMaxMessageSize),
+          m_responseMessage(kMaxMessageSize) {
+}
+
+LV2WorkerSchedule::~LV2WorkerSchedule() {
+    if (m_pInterface) {
+        m_pWorker->removeSchedule(this);
+    }
+}
+
+void LV2WorkerSchedule::setInstance(LilvInstance* pInstance) {
+    DEBUG_ASSERT(!m_pInstance);
+    m_pInstance = pInstance;
+    m_pInterface = static_cast<const LV2_Worker_Interface*>(
+            lilv_instance_get_extension_data(pInstance, LV2_WORKER__interface));
+    if (m_pInterface) {
+        m_pWorker->addSchedule(this);
+    }
+}
+
+void LV2WorkerSchedule::deliverResponses() {
+    if (!m_pInterface || !m_pInterface->work_response) {
+        return;
+    }
+    uint32_t size;
+    while (readMessage(&m_responses, &m_responseMessage, &size)) {
+        m_pInterface->work_response(lilv_instance_get_handle(m_pInstance),
+                size,
+                m_responseMessage.data());
+    }
+}
+
+void LV2WorkerSchedule::endRun() {
+    if (m_pInterface && m_pInterface->end_run) {
+        m_pInterface->end_run(lilv_instance_get_handle(m_pInstance));
+    }
+}
+
+void LV2WorkerSchedule::performWork() {
+    uint32_t size;
+    while (readMessage(&m_requests, &m_requestMessage, &size)) {
+        m_pInterface->work(lilv_instance_get_handle(m_pInstance),
+                &LV2WorkerSchedule::respond,
+                this,
+                size,
+                m_requestMessage.data());
+    }
+}
+
+// static
+LV2_Worker_Status LV2WorkerSchedule::scheduleWork(
+        LV2_Worker_Schedule_Handle handle,
+        uint32_t size,
+        const void* pData) {
+    auto* pSchedule = static_cast<LV2WorkerSchedule*>(handle);
+    if (!pSchedule->m_pInterface || !pSchedule->m_pWorker->isBound()) {
+        return LV2_WORKER_ERR_UNKNOWN;
+    }
+    if (!writeMessage(&pSchedule->m_requests, size, pData)) {
+        return LV2_WORKER_ERR_NO_SPACE;
+    }
+    pSchedule->m_pWorker->workReady();
+    return LV2_WORKER_SUCCESS;
+}
+
+// static
+LV2_Worker_Status LV2WorkerSchedule::respond(
+        LV2_Worker_Respond_Handle handle,
+        uint32_t size,
+        const void* pData) {
+    auto* pSchedule = static_cast<LV2WorkerSchedule*>(handle);
+    if (!writeMessage(&pSchedule->m_responses, size, pData)) {
+        return LV2_WORKER_ERR_NO_SPACE;
+    }
+    return LV2_WORKER_SUCCESS;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <lilv/lilv.h>
+#include <lv2/worker/worker.h>
+
+#include <QAtomicInt>
+#include <QList>
+#include <QMutex>
+#include <atomic>
+#include <vector>
+
+#include "engine/engineworker.h"
+#include "util/class.h"
+#include "util/fifo.h"
+
+class LV2WorkerSchedule;
+
+/// Runs the non real-time work of all LV2 plugin instances that support the
+/// LV2 worker extension. The work that is scheduled by the plugins during
+/// the audio callback is performed after the callback by the
+/// EngineWorkerScheduler of the engine.
+class LV2Worker : public EngineWorker {
+  public:
+    LV2Worker();
+    ~LV2Worker() override;
+
+    /// Called in main thread once the engine has been created. Work can only
+    /// be scheduled afterwards.
+    void bind(EngineWorkerScheduler* pScheduler);
+    bool isBound() const {
+        return m_bound.load(std::memory_order_acquire);
+    }
+
+    /// Called in main thread
+    void addSchedule(LV2WorkerSchedule* pSchedule);
+    /// Called in main thread. Waits until the current work of the
+    /// schedule has been finished.
+    void removeSchedule(LV2WorkerSchedule* pSchedule);
+    /// Called in main thread. Performs the pending work of the schedule
+    /// synchronously.
+    void finishWork(LV2WorkerSchedule* pSchedule);
+
+    void run() override;
+
+  private:
+    std::atomic<bool> m_bound;
+    QAtomicInt m_stop;
+    QMutex m_mutex;
+    QList<LV2WorkerSchedule*> m_schedules;
+
+    DISALLOW_COPY_AND_ASSIGN(LV2Worker);
+};
+
+/// The LV2 worker feature of a single plugin instance. Requests from the
+/// audio thread and the responses of the worker thread are passed through
+/// lock-free FIFOs, so neither side blocks the other.
+class LV2WorkerSchedule {
+  public:
+    explicit LV2WorkerSchedule(LV2Worker* pWorker);
+    ~LV2WorkerSchedule();
+
+    /// Must be passed to the plugin when instantiating it
+    const LV2_Feature* feature() const {
+        return &m_feature;
+    }
+
+    /// Called in main thread after the plugin has been instantiated
+    void setInstance(LilvInstance* pInstance);
+
+    /// Called in audio thread before running the instance
+    void deliverResponses();
+    /// Called in audio thread after running the instance
+    void endRun();
+
+    /// Called by the LV2Worker with its mutex locked
+    void performWork();
+
+  private:
+    static LV2_Worker_Status scheduleWork(
+            LV2_Worker_Schedule_Handle handle,
+            uint32_t size,
+            const void* pData);
+    static LV2_Worker_Status respond(
+            LV2_Worker_Respond_Handle handle,
+            uint32_t size,
+            const void* pData);
+
+    LV2Worker* const m_pWorker;
+    LV2_Worker_Schedule m_schedule;
+    LV2_Feature m_feature;
+    LilvInstance* m_pInstance;
+    const LV2_Worker_Interface* m_pInterface;
+
+    // Written by the audio thread, read by the worker thread
+    FIFO<char> m_requests;
+    // Written by the worker thread, read by the audio thread
+    FIFO<char> m_responses;
+    std::vector<char> m_requestMessage;
+    std::vector<char> m_responseMessage;
+
+    DISALLOW_COPY_AND_ASSIGN(LV2WorkerSchedule);
+};
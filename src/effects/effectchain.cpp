@@ -152,6 +152,9 @@ EffectChain::EffectChain(const QString& group,
             true);
     m_pControlChainFocusedEffect->setButtonMode(ControlPushButton::TOGGLE);
 
+    // Updated by the engine
+    m_pControlCpuLoad = std::make_unique<ControlObject>(ConfigKey(m_group, "cpu_load"));
+
     addToEngine();
 }
 
@@ -165,10 +168,7 @@ void EffectChain::addToEngine() {
         return;
     }
 
-    m_pEngineEffectChain = new EngineEffectChain(
-            m_group,
-            m_pEffectsManager->registeredInputChannels(),
-            m_pEffectsManager->registeredOutputChannels());
+    m_pEngineEffectChain = new EngineEffectChain(m_group);
     EffectsRequest* pRequest = new EffectsRequest();
     pRequest->type = EffectsRequest::ADD_EFFECT_CHAIN;
     pRequest->AddEffectChain.signalProcessingStage = m_signalProcessingStage;
@@ -386,6 +386,25 @@ void EffectChain::slotPresetListUpdated() {
     m_pControlNumChainPresets->forceSet(numPresets());
 }
 
+QSet<ChannelHandleAndGroup> EffectChain::getOutputChannels() const {
+    const QSet<ChannelHandleAndGroup>& registeredOutputChannels =
+            m_pEffectsManager->registeredOutputChannels();
+    if (m_signalProcessingStage != SignalProcessingStage::Prefader) {
+        return registeredOutputChannels;
+    }
+    // Prefader effects are processed only once for all outputs and always
+    // with the master handle, so the states for any other output would
+    // never be used.
+    const ChannelHandle masterHandle = m_pEffectsManager->getMasterHandle();
+    QSet<ChannelHandleAndGroup> outputChannels;
+    for (const ChannelHandleAndGroup& outputChannel : registeredOutputChannels) {
+        if (outputChannel.handle() == masterHandle) {
+            outputChannels.insert(outputChannel);
+        }
+    }
+    return outputChannels;
+}
+
 void EffectChain::enableForInputChannel(const ChannelHandleAndGroup& handleGroup) {
     if (m_enabledInputChannels.contains(handleGroup)) {
         return;
@@ -56,6 +56,10 @@ class EffectChain : public QObject {
         return m_enabledInputChannels;
     }
 
+    /// The output channels for which the effects of this chain are processed.
+    /// EffectStates are only allocated for these outputs.
+    QSet<ChannelHandleAndGroup> getOutputChannels() const;
+
     double getSuperParameter() const;
     void setSuperParameter(double value, bool force = false);
 
@@ -134,6 +138,7 @@ class EffectChain : public QObject {
 
     std::unique_ptr<ControlPushButton> m_pControlClear;
     std::unique_ptr<ControlObject> m_pControlNumEffectSlots;
+    std::unique_ptr<ControlObject> m_pControlCpuLoad;
     std::unique_ptr<ControlPushButton> m_pControlChainEnabled;
     std::unique_ptr<ControlPushButton> m_pControlChainMixMode;
     std::unique_ptr<ControlObject> m_pControlLoadedChainPreset;
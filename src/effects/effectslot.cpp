@@ -41,6 +41,9 @@ EffectSlot::EffectSlot(const QString& group,
     m_pControlLoaded = std::make_unique<ControlObject>(ConfigKey(m_group, "loaded"));
     m_pControlLoaded->setReadOnly();
 
+    // Updated by the engine
+    m_pControlCpuLoad = std::make_unique<ControlObject>(ConfigKey(m_group, "cpu_load"));
+
     m_pControlNumParameters.insert(EffectParameterType::Knob,
             QSharedPointer<ControlObject>(
                     new ControlObject(ConfigKey(m_group, "num_parameters"))));
@@ -145,11 +148,11 @@ void EffectSlot::addToEngine() {
     }
 
     m_pEngineEffect = new EngineEffect(
+            m_group,
             m_pManifest,
             m_pBackendManager,
             m_pChain->getActiveChannels(),
-            m_pEffectsManager->registeredInputChannels(),
-            m_pEffectsManager->registeredOutputChannels());
+            m_pChain->getOutputChannels());
 
     EffectsRequest* request = new EffectsRequest();
     request->type = EffectsRequest::ADD_EFFECT_TO_CHAIN;
@@ -199,8 +202,9 @@ void EffectSlot::fillEffectStatesMap(EffectStatesMap* pStatesMap) const {
             MAX_BUFFER_LEN / mixxx::kEngineChannelCount);
 
     if (isLoaded()) {
-        for (const auto& outputChannel :
-                m_pEffectsManager->registeredOutputChannels()) {
+        const QSet<ChannelHandleAndGroup> outputChannels =
+                m_pChain->getOutputChannels();
+        for (const auto& outputChannel : outputChannels) {
             pStatesMap->insert(outputChannel.handle(),
                     m_pEngineEffect->createState(engineParameters));
         }
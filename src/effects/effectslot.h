@@ -184,6 +184,7 @@ class EffectSlot : public QObject {
     QMap<EffectParameterType, QList<EffectParameterSlotBasePointer>> m_parameterSlots;
 
     std::unique_ptr<ControlObject> m_pControlLoaded;
+    std::unique_ptr<ControlObject> m_pControlCpuLoad;
     // Apparently QHash doesn't work with std::unique_ptr
     QHash<EffectParameterType, QSharedPointer<ControlObject>> m_pControlNumParameters;
     QHash<EffectParameterType, QSharedPointer<ControlObject>> m_pControlNumParameterSlots;
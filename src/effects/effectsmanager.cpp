@@ -30,7 +30,7 @@ EffectsManager::EffectsManager(
           m_hiEqFreq(ConfigKey("[Mixer Profile]", "HiEQFrequency"), 0., 22040) {
     qRegisterMetaType<EffectChainMixMode>("EffectChainMixMode");
 
-    m_pBackendManager = EffectsBackendManagerPointer(new EffectsBackendManager());
+    m_pBackendManager = EffectsBackendManagerPointer(new EffectsBackendManager(pConfig));
 
     QPair<EffectsRequestPipe*, EffectsResponsePipe*> requestPipes =
             TwoWayMessagePipe<EffectsRequest*, EffectsResponse>::makeTwoWayMessagePipe(
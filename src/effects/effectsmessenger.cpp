@@ -37,16 +37,46 @@ bool EffectsMessenger::writeRequest(EffectsRequest* request) {
     // with responses when writing new requests.
     processEffectsResponses();
 
+    if (request->type == EffectsRequest::SET_PARAMETER_PARAMETERS &&
+            coalesceParameterRequest(*request)) {
+        // Controllers send a new value for each step of a knob twist
+        delete request;
+        return true;
+    }
+
     request->request_id = m_nextRequestId++;
-    // TODO(XXX) use preallocated requests to avoid delete calls from engine
     if (m_pRequestPipe->writeMessage(request)) {
         m_activeRequests[request->request_id] = request;
+        if (request->type == EffectsRequest::SET_PARAMETER_PARAMETERS) {
+            m_activeParameterRequests.insert(
+                    qMakePair(request->pTargetEffect,
+                            request->SetParameterParameters.iParameter),
+                    request);
+        }
         return true;
     }
     delete request;
     return false;
 }
 
+bool EffectsMessenger::coalesceParameterRequest(const EffectsRequest& request) {
+    const auto it = m_activeParameterRequests.constFind(
+            qMakePair(request.pTargetEffect,
+                    request.SetParameterParameters.iParameter));
+    if (it == m_activeParameterRequests.constEnd()) {
+        return false;
+    }
+    EffectsRequest* pQueuedRequest = it.value();
+    if (pQueuedRequest->consumed.load()) {
+        return false;
+    }
+    pQueuedRequest->value.store(request.value.load());
+    // The audio thread marks the request as consumed before reading the
+    // value. If it has done so in the meantime, it is unknown which value
+    // it has read and the new value needs to be sent again.
+    return !pQueuedRequest->consumed.load();
+}
+
 void EffectsMessenger::processEffectsResponses() {
     if (m_pRequestPipe.isNull()) {
         return;
@@ -73,6 +103,15 @@ void EffectsMessenger::processEffectsResponses() {
 
             collectGarbage(pRequest);
 
+            if (pRequest->type == EffectsRequest::SET_PARAMETER_PARAMETERS) {
+                const auto key = qMakePair(pRequest->pTargetEffect,
+                        pRequest->SetParameterParameters.iParameter);
+                const auto parameterIt = m_activeParameterRequests.find(key);
+                if (parameterIt != m_activeParameterRequests.end() &&
+                        parameterIt.value() == pRequest) {
+                    m_activeParameterRequests.erase(parameterIt);
+                }
+            }
             delete pRequest;
             it = m_activeRequests.erase(it);
         }
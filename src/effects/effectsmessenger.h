@@ -24,6 +24,9 @@ class EffectsMessenger {
     void processEffectsResponses();
 
   private:
+    /// Replaces the value of a queued SET_PARAMETER_PARAMETERS request for
+    /// the same parameter. Returns false if a new request needs to be sent.
+    bool coalesceParameterRequest(const EffectsRequest& request);
     void collectGarbage(const EffectsRequest* pRequest);
 
     QString debugString() const {
@@ -36,4 +39,7 @@ class EffectsMessenger {
     QScopedPointer<EffectsResponsePipe> m_pResponsePipe;
     qint64 m_nextRequestId;
     QHash<qint64, EffectsRequest*> m_activeRequests;
+    // The latest SET_PARAMETER_PARAMETERS request of each parameter
+    // until it has been answered by the audio thread
+    QHash<QPair<EngineEffect*, int>, EffectsRequest*> m_activeParameterRequests;
 };
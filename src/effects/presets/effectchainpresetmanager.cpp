@@ -4,6 +4,7 @@
 #include <QFileDialog>
 #include <QInputDialog>
 #include <QMessageBox>
+#include <QtConcurrentMap>
 
 #include "effects/backends/builtin/filtereffect.h"
 #include "effects/effectchain.h"
@@ -35,6 +36,13 @@ EffectChainPresetPointer loadPresetFromFile(const QString& filePath) {
     return pEffectChainPreset;
 }
 
+/// The XML files of all chain presets are parsed concurrently at startup.
+/// The results are in the order of the file paths.
+QList<EffectChainPresetPointer> loadPresetsFromFiles(const QStringList& filePaths) {
+    return QtConcurrent::blockingMapped<QList<EffectChainPresetPointer>>(
+            filePaths, loadPresetFromFile);
+}
+
 } // anonymous namespace
 
 EffectChainPresetManager::EffectChainPresetManager(UserSettingsPointer pConfig,
@@ -440,9 +448,13 @@ void EffectChainPresetManager::importUserPresets() {
     }
     savedPresetsDir.setFilter(QDir::Files | QDir::Readable);
     const QStringList fileList = savedPresetsDir.entryList();
-    for (const auto& filePath : fileList) {
-        EffectChainPresetPointer pEffectChainPreset = loadPresetFromFile(
-                savedPresetsPath + kFolderDelimiter + filePath);
+    QStringList filePaths;
+    filePaths.reserve(fileList.size());
+    for (const auto& fileName : fileList) {
+        filePaths.append(savedPresetsPath + kFolderDelimiter + fileName);
+    }
+    const auto presets = loadPresetsFromFiles(filePaths);
+    for (const auto& pEffectChainPreset : presets) {
         if (pEffectChainPreset && !pEffectChainPreset->isEmpty()) {
             m_effectChainPresets.insert(
                     pEffectChainPreset->name(), pEffectChainPreset);
@@ -458,6 +470,8 @@ void EffectChainPresetManager::importDefaultPresets() {
     QDir defaultChainPresetsDir(defaultPresetsPath);
     defaultChainPresetsDir.setFilter(QDir::Files | QDir::Readable);
     const auto& fileNames = defaultChainPresetsDir.entryList();
+    QStringList copiedFileNames;
+    copiedFileNames.reserve(fileNames.size());
     for (const auto& fileName : fileNames) {
         QString copiedFileName = savedPresetsPath + kFolderDelimiter + fileName;
         QFileInfo copiedFileInfo(copiedFileName);
@@ -468,13 +482,18 @@ void EffectChainPresetManager::importDefaultPresets() {
                 continue;
             }
         }
+        copiedFileNames.append(copiedFileName);
+    }
 
-        EffectChainPresetPointer pEffectChainPreset = loadPresetFromFile(copiedFileName);
+    const auto presets = loadPresetsFromFiles(copiedFileNames);
+    for (int i = 0; i < presets.size(); ++i) {
+        const EffectChainPresetPointer& pEffectChainPreset = presets.at(i);
         if (pEffectChainPreset && !pEffectChainPreset->isEmpty()) {
             m_effectChainPresets.insert(pEffectChainPreset->name(), pEffectChainPreset);
             m_effectChainPresetsSorted.append(pEffectChainPreset);
         } else {
-            qWarning() << "Could not load default effect chain preset" << copiedFileName;
+            qWarning() << "Could not load default effect chain preset"
+                       << copiedFileNames.at(i);
         }
     }
 }
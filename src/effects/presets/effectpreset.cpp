@@ -34,8 +34,7 @@ EffectPreset::EffectPreset(const QDomElement& effectElement)
         QDomNode parameterNode = parametersList.at(i);
         if (parameterNode.isElement()) {
             QDomElement parameterElement = parameterNode.toElement();
-            EffectParameterPreset parameterPreset(parameterElement);
-            m_effectParameterPresets.append(parameterElement);
+            m_effectParameterPresets.append(EffectParameterPreset(parameterElement));
         }
     }
 }
@@ -1,6 +1,7 @@
 #include "effects/presets/effectpresetmanager.h"
 
 #include <QDir>
+#include <QtConcurrentMap>
 
 #include "effects/backends/effectsbackendmanager.h"
 #include "effects/presets/effectxmlelements.h"
@@ -8,7 +9,19 @@
 
 namespace {
 const QString kEffectDefaultsDirectory = "/effects/defaults";
+
+EffectPresetPointer loadPresetFromFile(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    QDomDocument doc;
+    if (!doc.setContent(&file)) {
+        return nullptr;
+    }
+    return EffectPresetPointer(new EffectPreset(doc.documentElement()));
 }
+} // anonymous namespace
 
 EffectPresetManager::EffectPresetManager(UserSettingsPointer pConfig,
         EffectsBackendManagerPointer pBackendManager)
@@ -29,25 +42,22 @@ void EffectPresetManager::loadDefaultEffectPresets() {
     QDir effectsDefaultsDir(dirPath);
     effectsDefaultsDir.setFilter(QDir::Files | QDir::Readable);
     const auto& fileNames = effectsDefaultsDir.entryList();
-    for (const auto& filePath : fileNames) {
-        QFile file(dirPath + "/" + filePath);
-        if (!file.open(QIODevice::ReadOnly)) {
-            continue;
-        }
-        QDomDocument doc;
-        if (!doc.setContent(&file)) {
-            file.close();
-            continue;
-        }
-        EffectPresetPointer pEffectPreset(new EffectPreset(doc.documentElement()));
-        if (!pEffectPreset->isEmpty()) {
+    QStringList filePaths;
+    filePaths.reserve(fileNames.size());
+    for (const auto& fileName : fileNames) {
+        filePaths.append(dirPath + "/" + fileName);
+    }
+    // Only the parsing is done concurrently, the manifests are looked up here
+    const auto presets = QtConcurrent::blockingMapped<QList<EffectPresetPointer>>(
+            filePaths, loadPresetFromFile);
+    for (const auto& pEffectPreset : presets) {
+        if (pEffectPreset && !pEffectPreset->isEmpty()) {
             EffectManifestPointer pManifest = m_pBackendManager->getManifest(
                     pEffectPreset->id(), pEffectPreset->backendType());
             if (pManifest) {
                 m_defaultPresets.insert(pManifest, pEffectPreset);
             }
         }
-        file.close();
     }
 
     // If no preset was found, generate one from the manifest
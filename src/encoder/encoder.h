@@ -38,6 +38,11 @@ class Encoder {
     virtual void updateMetaData(const QString& artist, const QString& title, const QString& album) = 0;
     // called at the end when encoding is finished
     virtual void flush() = 0;
+    // Called regularly while recording to update the header of the file with
+    // the amount of audio data written so far. Then the file remains valid
+    // if the recording is interrupted.
+    virtual void updateHeader() {
+    }
     // Setup the encoder with the specific settings
     virtual void setEncoderSettings(const EncoderSettings& settings) = 0;
 };
@@ -4,6 +4,7 @@
 
 #include "encoder/encodervorbis.h"
 #include "encoder/encodercallback.h"
+#include "util/sample.h"
 
 // Automatic thresholds for switching the encoder to mono
 // They have been chosen by testing and to keep the same number
@@ -136,10 +137,7 @@ void EncoderVorbis::encodeBuffer(const CSAMPLE *samples, const int size) {
     // and libvorbis expects samples in the range [-1.0, 1.0] so no conversion
     // is required.
     if (m_channels == 2) {
-        for (int i = 0; i < size/2; ++i) {
-            buffer[0][i] = samples[i*2];
-            buffer[1][i] = samples[i*2+1];
-        }
+        SampleUtil::deinterleaveBuffer(buffer[0], buffer[1], samples, size / 2);
     }
     else {
         for (int i = 0; i < size/2; ++i) {
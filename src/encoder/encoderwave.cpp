@@ -137,6 +137,12 @@ void EncoderWave::flush() {
 }
 
 
+void EncoderWave::updateHeader() {
+    // The header is written at the beginning of the file before seeking
+    // back to the end
+    sf_command(m_pSndfile, SFC_UPDATE_HEADER_NOW, nullptr, 0);
+}
+
 void EncoderWave::encodeBuffer(const CSAMPLE *pBuffer, const int iBufferSize) {
     sf_write_float(m_pSndfile, pBuffer, iBufferSize);
 }
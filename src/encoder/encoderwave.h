@@ -25,6 +25,7 @@ class EncoderWave : public Encoder {
     void encodeBuffer(const CSAMPLE *samples, const int size) override;
     void updateMetaData(const QString& artist, const QString& title, const QString& album) override;
     void flush() override;
+    void updateHeader() override;
     void setEncoderSettings(const EncoderSettings& settings) override;
 
   protected:
@@ -1,12 +1,117 @@
 #include "engine/bufferscalers/enginebufferscalelinear.h"
 
 #include <QtDebug>
+#include <cstring>
 
 #include "track/keyutils.h"
 #include "util/assert.h"
 #include "util/math.h"
 #include "util/sample.h"
 
+namespace {
+
+// The frames before the interpolated position that are needed by the
+// longest kernel. They are kept when m_kernelBuffer is refilled.
+constexpr SINT kKernelLookbackFrames = 3;
+// m_kernelBuffer is filled up to this size. The same amount is left free
+// for the frames that are read again when the direction changes.
+constexpr SINT kKernelBufferSize = kiLinearScaleReadAheadLength;
+
+constexpr int kCubicTaps = 4;
+constexpr int kSincTaps = 8;
+// The resolution of the precomputed sinc kernel in fractions of a frame
+constexpr int kSincPhases = 256;
+
+static_assert(kSincTaps / 2 - 1 <= kKernelLookbackFrames);
+static_assert(kCubicTaps / 2 - 1 <= kKernelLookbackFrames);
+
+double sinc(double x) {
+    if (x == std::round(x)) {
+        // Exact for the taps at whole frames, so the interpolation is
+        // sample perfect at unity rate
+        return x == 0.0 ? 1.0 : 0.0;
+    }
+    return std::sin(M_PI * x) / (M_PI * x);
+}
+
+// The weights of the windowed sinc kernel for all phases between two
+// frames. The weights are duplicated for both channels, to match the
+// interleaved samples.
+class SincKernel {
+  public:
+    SincKernel() {
+        for (int phase = 0; phase <= kSincPhases; ++phase) {
+            const double frac = static_cast<double>(phase) / kSincPhases;
+            double weights[kSincTaps];
+            double sum = 0.0;
+            for (int tap = 0; tap < kSincTaps; ++tap) {
+                // The distance between the tap and the interpolated position
+                const double x = tap - (kSincTaps / 2 - 1) - frac;
+                const double window = 0.42 +
+                        0.5 * std::cos(2 * M_PI * x / kSincTaps) +
+                        0.08 * std::cos(4 * M_PI * x / kSincTaps);
+                weights[tap] = sinc(x) * window;
+                sum += weights[tap];
+            }
+            for (int tap = 0; tap < kSincTaps; ++tap) {
+                // Normalized to unity gain for DC
+                const auto weight = static_cast<CSAMPLE>(weights[tap] / sum);
+                m_weights[phase][2 * tap] = weight;
+                m_weights[phase][2 * tap + 1] = weight;
+            }
+        }
+    }
+
+    const CSAMPLE* weights(CSAMPLE frac) const {
+        return m_weights[static_cast<int>(frac * kSincPhases + 0.5f)];
+    }
+
+  private:
+    alignas(16) CSAMPLE m_weights[kSincPhases + 1][2 * kSincTaps];
+};
+
+const SincKernel& sincKernel() {
+    static const SincKernel s_kernel;
+    return s_kernel;
+}
+
+// laurent de soras - punked from musicdsp.org (mad props)
+// The 4-point Hermite interpolation, written as the weights of the four
+// frames. They are duplicated for both channels like the sinc kernel.
+inline void hermite4Weights(CSAMPLE frac, CSAMPLE* pWeights) {
+    const CSAMPLE frac2 = frac * frac;
+    const CSAMPLE frac3 = frac2 * frac;
+    const CSAMPLE weights[kCubicTaps] = {
+            -0.5f * frac3 + frac2 - 0.5f * frac,
+            1.5f * frac3 - 2.5f * frac2 + 1.0f,
+            -1.5f * frac3 + 2.0f * frac2 + 0.5f * frac,
+            0.5f * frac3 - 0.5f * frac2};
+    for (int tap = 0; tap < kCubicTaps; ++tap) {
+        pWeights[2 * tap] = weights[tap];
+        pWeights[2 * tap + 1] = weights[tap];
+    }
+}
+
+// Interpolates a stereo frame from numTaps interleaved frames. The four
+// independent sums allow the compiler to vectorize the loop without
+// reordering the floating point additions.
+template<int numTaps>
+inline void interpolateFrame(CSAMPLE* M_RESTRICT pFrame,
+        const CSAMPLE* M_RESTRICT pSamples,
+        const CSAMPLE* M_RESTRICT pWeights) {
+    static_assert(numTaps % 2 == 0);
+    CSAMPLE sums[4] = {};
+    for (int i = 0; i < 2 * numTaps; i += 4) {
+        for (int j = 0; j < 4; ++j) {
+            sums[j] += pSamples[i + j] * pWeights[i + j];
+        }
+    }
+    pFrame[0] = sums[0] + sums[2];
+    pFrame[1] = sums[1] + sums[3];
+}
+
+} // anonymous namespace
+
 EngineBufferScaleLinear::EngineBufferScaleLinear(ReadAheadManager *pReadAheadManager)
     : m_pReadAheadManager(pReadAheadManager),
       m_bufferInt(SampleUtil::alloc(kiLinearScaleReadAheadLength)),
@@ -15,14 +120,27 @@ EngineBufferScaleLinear::EngineBufferScaleLinear(ReadAheadManager *pReadAheadMan
       m_dRate(1.0),
       m_dOldRate(1.0),
       m_dCurrentFrame(0.0),
-      m_dNextFrame(0.0) {
+      m_dNextFrame(0.0),
+      m_requestedInterpolationMode(kDefaultInterpolationMode),
+      m_interpolationMode(kDefaultInterpolationMode),
+      m_kernelBuffer(SampleUtil::alloc(2 * kKernelBufferSize)),
+      m_kernelBufferFrames(0),
+      m_dKernelFrame(0.0) {
     m_floorSampleOld[0] = 0.0;
     m_floorSampleOld[1] = 0.0;
     SampleUtil::clear(m_bufferInt, kiLinearScaleReadAheadLength);
+    clearKernelBuffer();
+    // Computes the kernel now instead of in the engine thread
+    sincKernel();
 }
 
 EngineBufferScaleLinear::~EngineBufferScaleLinear() {
     SampleUtil::free(m_bufferInt);
+    SampleUtil::free(m_kernelBuffer);
+}
+
+void EngineBufferScaleLinear::setInterpolationMode(InterpolationMode mode) {
+    m_requestedInterpolationMode.store(mode, std::memory_order_relaxed);
 }
 
 void EngineBufferScaleLinear::setScaleParameters(double base_rate,
@@ -41,17 +159,15 @@ void EngineBufferScaleLinear::clear() {
     m_dNextFrame = 0;
     m_floorSampleOld[0] = 0;
     m_floorSampleOld[1] = 0;
+    clearKernelBuffer();
 }
 
-// laurent de soras - punked from musicdsp.org (mad props)
-inline float hermite4(float frac_pos, float xm1, float x0, float x1, float x2)
-{
-    const float c = (x1 - xm1) * 0.5f;
-    const float v = x0 - x1;
-    const float w = c + v;
-    const float a = w + v + (x2 - x0) * 0.5f;
-    const float b_neg = w + a;
-    return ((((a * frac_pos) - b_neg) * frac_pos + c) * frac_pos + x0);
+void EngineBufferScaleLinear::clearKernelBuffer() {
+    // Silence before the first frame
+    SampleUtil::clear(m_kernelBuffer,
+            getOutputSignal().frames2samples(kKernelLookbackFrames));
+    m_kernelBufferFrames = kKernelLookbackFrames;
+    m_dKernelFrame = kKernelLookbackFrames;
 }
 
 // Determine if we're changing directions (scratching) and then perform
@@ -63,10 +179,22 @@ double EngineBufferScaleLinear::scaleBuffer(
         return 0.0;
     }
 
+    const auto interpolationMode =
+            m_requestedInterpolationMode.load(std::memory_order_relaxed);
+    if (interpolationMode != m_interpolationMode) {
+        // The buffered frames of the previous mode are dropped
+        m_interpolationMode = interpolationMode;
+        clear();
+    }
+
     if (m_bClear) {
         m_dOldRate = m_dRate;  // If cleared, don't interpolate rate.
         m_bClear = false;
     }
+    if (m_interpolationMode != InterpolationMode::Linear) {
+        return scaleBufferKernel(pOutputBuffer, iOutputBufferSize);
+    }
+
     double rate_add_old = m_dOldRate; // Smoothly interpolate to new playback rate
     double rate_add_new = m_dRate;
     SINT frames_read = 0;
@@ -346,3 +474,186 @@ SINT EngineBufferScaleLinear::do_scale(CSAMPLE* buf, SINT buf_size) {
 
     return frames_read;
 }
+
+double EngineBufferScaleLinear::scaleBufferKernel(
+        CSAMPLE* pOutputBuffer,
+        SINT iOutputBufferSize) {
+    const double rate_old = m_dOldRate;
+    const double rate_new = m_dRate;
+    if (rate_new * rate_old >= 0) {
+        return do_scale_kernel(pOutputBuffer, iOutputBufferSize);
+    }
+
+    // Direction has changed! Like above, the first half of the buffer
+    // goes from the old rate to zero and the second half from zero to the
+    // new rate.
+    const SINT frameOffset = getOutputSignal().samples2frames(iOutputBufferSize) / 2;
+    const SINT sampleOffset = getOutputSignal().frames2samples(frameOffset);
+    SINT frames_read = 0;
+    m_dRate = 0.0;
+    frames_read += do_scale_kernel(pOutputBuffer, sampleOffset);
+    frames_read += reverseKernelBuffer(rate_new);
+    m_dOldRate = 0.0;
+    m_dRate = rate_new;
+    frames_read += do_scale_kernel(pOutputBuffer + sampleOffset,
+            iOutputBufferSize - sampleOffset);
+    return frames_read;
+}
+
+// Turns the buffered frames around for the new direction. Returns the
+// frames that were read to move back the RAMAN.
+SINT EngineBufferScaleLinear::reverseKernelBuffer(double rate) {
+    const mixxx::audio::SignalInfo& signal = getOutputSignal();
+    // The RAMAN is behind the last buffered frame. Reading the buffered
+    // frames again in the new direction moves it in front of the first one,
+    // so the next read continues the reversed buffer. The frames are
+    // discarded, the free space of m_kernelBuffer is used as scratch space.
+    CSAMPLE* pScratch = &m_kernelBuffer[signal.frames2samples(m_kernelBufferFrames)];
+    const SINT scratchSize = 2 * kKernelBufferSize -
+            signal.frames2samples(m_kernelBufferFrames);
+    SINT samples_needed = signal.frames2samples(m_kernelBufferFrames);
+    int read_failed_count = 0;
+    while (samples_needed > 0) {
+        const SINT read_size = m_pReadAheadManager->getNextSamples(
+                rate, pScratch, math_min(samples_needed, scratchSize));
+        if (read_size == 0) {
+            if (++read_failed_count > 1) {
+                break;
+            } else {
+                continue;
+            }
+        }
+        samples_needed -= read_size;
+    }
+    const SINT frames_read = m_kernelBufferFrames -
+            signal.samples2frames(samples_needed);
+
+    SampleUtil::reverse(m_kernelBuffer, signal.frames2samples(m_kernelBufferFrames));
+    m_dKernelFrame = (m_kernelBufferFrames - 1) - m_dKernelFrame;
+
+    const SINT padFrames = kKernelLookbackFrames - static_cast<SINT>(m_dKernelFrame);
+    if (padFrames > 0) {
+        // The frames before the position in the new direction are the ones
+        // behind the last frame in the old direction, which were never
+        // read. They are replaced by the first frame.
+        memmove(&m_kernelBuffer[signal.frames2samples(padFrames)],
+                m_kernelBuffer,
+                signal.frames2samples(m_kernelBufferFrames) * sizeof(CSAMPLE));
+        for (SINT frame = 0; frame < padFrames; ++frame) {
+            m_kernelBuffer[signal.frames2samples(frame)] =
+                    m_kernelBuffer[signal.frames2samples(padFrames)];
+            m_kernelBuffer[signal.frames2samples(frame) + 1] =
+                    m_kernelBuffer[signal.frames2samples(padFrames) + 1];
+        }
+        m_kernelBufferFrames += padFrames;
+        m_dKernelFrame += padFrames;
+    }
+    return frames_read;
+}
+
+// Stretch a specified buffer worth of audio using cubic or sinc
+// interpolation
+SINT EngineBufferScaleLinear::do_scale_kernel(CSAMPLE* buf, SINT buf_size) {
+    double rate_old = m_dOldRate;
+    const double rate_new = m_dRate;
+    const double rate_diff = rate_new - rate_old;
+    m_dOldRate = m_dRate;
+
+    // We special case direction change in the calling function, so this
+    // shouldn't happen
+    VERIFY_OR_DEBUG_ASSERT(rate_new * rate_old >= 0) {
+        qDebug() << "EBSL::do_scale_kernel() can't change direction";
+        rate_old = 0;
+    }
+
+    const mixxx::audio::SignalInfo& signal = getOutputSignal();
+    const SINT bufferSizeFrames = signal.samples2frames(buf_size);
+    if (bufferSizeFrames == 0) {
+        return 0;
+    }
+    const double rate_delta = rate_diff / bufferSizeFrames;
+    // The frames that the position advances in this buffer, see do_scale()
+    double frames_remaining = (bufferSizeFrames - 1) * bufferSizeFrames / 2.0;
+    frames_remaining *= rate_delta;
+    frames_remaining += rate_old * bufferSizeFrames;
+    frames_remaining = fabs(frames_remaining);
+
+    const double read_rate = rate_new == 0 ? rate_old : rate_new;
+    const bool sinc = m_interpolationMode == InterpolationMode::Sinc;
+    const SINT tapsBefore = (sinc ? kSincTaps : kCubicTaps) / 2 - 1;
+    const SINT tapsAfter = (sinc ? kSincTaps : kCubicTaps) / 2;
+    const SINT maxBufferFrames = signal.samples2frames(kKernelBufferSize);
+
+    double rate_add = fabs(rate_old);
+    const double rate_delta_abs =
+            rate_old < 0 || rate_new < 0 ? -rate_delta : rate_delta;
+
+    CSAMPLE cubicWeights[2 * kCubicTaps];
+    SINT frames_read = 0;
+    int read_failed_count = 0;
+    SINT i = 0;
+
+    // Hot frame loop
+    while (i < buf_size) {
+        SINT currentFrameFloor = static_cast<SINT>(m_dKernelFrame);
+        while (currentFrameFloor + tapsAfter >= m_kernelBufferFrames) {
+            // Drop the frames that are no longer needed
+            const SINT dropFrames = math_min(
+                    currentFrameFloor - kKernelLookbackFrames, m_kernelBufferFrames);
+            if (dropFrames > 0) {
+                memmove(m_kernelBuffer,
+                        &m_kernelBuffer[signal.frames2samples(dropFrames)],
+                        signal.frames2samples(m_kernelBufferFrames - dropFrames) *
+                                sizeof(CSAMPLE));
+                m_kernelBufferFrames -= dropFrames;
+                m_dKernelFrame -= dropFrames;
+                currentFrameFloor -= dropFrames;
+            }
+
+            // Read the frames for the rest of this buffer at once
+            const SINT framesNeeded =
+                    static_cast<SINT>(m_dKernelFrame + frames_remaining) +
+                    tapsAfter + 1 - m_kernelBufferFrames;
+            const SINT framesToRead = math_clamp<SINT>(framesNeeded,
+                    1,
+                    maxBufferFrames - m_kernelBufferFrames);
+            const SINT read_size = m_pReadAheadManager->getNextSamples(read_rate,
+                    &m_kernelBuffer[signal.frames2samples(m_kernelBufferFrames)],
+                    signal.frames2samples(framesToRead));
+            if (read_size == 0) {
+                if (++read_failed_count > 1) {
+                    break;
+                } else {
+                    continue;
+                }
+            }
+            m_kernelBufferFrames += signal.samples2frames(read_size);
+            frames_read += signal.samples2frames(read_size);
+        }
+
+        if (read_failed_count > 1) {
+            break;
+        }
+
+        const auto frac = static_cast<CSAMPLE>(m_dKernelFrame - currentFrameFloor);
+        const CSAMPLE* pSamples =
+                &m_kernelBuffer[signal.frames2samples(currentFrameFloor - tapsBefore)];
+        if (sinc) {
+            interpolateFrame<kSincTaps>(&buf[i], pSamples, sincKernel().weights(frac));
+        } else {
+            hermite4Weights(frac, cubicWeights);
+            interpolateFrame<kCubicTaps>(&buf[i], pSamples, cubicWeights);
+        }
+
+        m_dKernelFrame += rate_add;
+        frames_remaining -= rate_add;
+        // Smooth any changes in the playback rate over one buf_size
+        // samples, like do_scale()
+        rate_add += rate_delta_abs;
+        i += signal.getChannelCount();
+    }
+
+    SampleUtil::clear(&buf[i], buf_size - i);
+
+    return frames_read;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "engine/bufferscalers/enginebufferscale.h"
 #include "engine/readaheadmanager.h"
 
@@ -10,6 +12,19 @@ constexpr int kiLinearScaleReadAheadLength = 10240;
 class EngineBufferScaleLinear : public EngineBufferScale  {
     Q_OBJECT
   public:
+    /// The interpolation between the frames of the track. The values are
+    /// stored in [Master],scaler_interpolation.
+    enum class InterpolationMode {
+        /// The cheapest, but it aliases noticeably at high rates
+        Linear = 0,
+        /// 4-point cubic Hermite (Catmull-Rom) spline
+        Cubic = 1,
+        /// 8-point Blackman windowed sinc
+        Sinc = 2,
+    };
+    static constexpr InterpolationMode kDefaultInterpolationMode =
+            InterpolationMode::Linear;
+
     explicit EngineBufferScaleLinear(
             ReadAheadManager *pReadAheadManager);
     ~EngineBufferScaleLinear() override;
@@ -23,12 +38,25 @@ class EngineBufferScaleLinear : public EngineBufferScale  {
                             double* pTempoRatio,
                              double* pPitchRatio) override;
 
+    /// May be called from any thread, the mode is switched with the next
+    /// call of scaleBuffer()
+    void setInterpolationMode(InterpolationMode mode);
+    InterpolationMode getInterpolationMode() const {
+        return m_requestedInterpolationMode.load(std::memory_order_relaxed);
+    }
+
   private:
     void onSampleRateChanged() override {}
 
     SINT do_scale(CSAMPLE* buf, SINT buf_size);
     SINT do_copy(CSAMPLE* buf, SINT buf_size);
 
+    // The cubic and sinc modes interpolate from the frames in m_kernelBuffer
+    double scaleBufferKernel(CSAMPLE* pOutputBuffer, SINT iOutputBufferSize);
+    SINT do_scale_kernel(CSAMPLE* buf, SINT buf_size);
+    SINT reverseKernelBuffer(double rate);
+    void clearKernelBuffer();
+
     // The read-ahead manager that we use to fetch samples
     ReadAheadManager* m_pReadAheadManager;
 
@@ -44,4 +72,15 @@ class EngineBufferScaleLinear : public EngineBufferScale  {
 
     double m_dCurrentFrame;
     double m_dNextFrame;
+
+    std::atomic<InterpolationMode> m_requestedInterpolationMode;
+    InterpolationMode m_interpolationMode;
+
+    // The frames read from the ReadAheadManager for the cubic and sinc
+    // modes, starting with the frames before the current position that
+    // are needed by the kernels
+    CSAMPLE* m_kernelBuffer;
+    SINT m_kernelBufferFrames;
+    // Position of the next output frame in m_kernelBuffer
+    double m_dKernelFrame;
 };
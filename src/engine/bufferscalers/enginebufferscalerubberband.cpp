@@ -2,7 +2,9 @@
 
 #include <rubberband/RubberBandStretcher.h>
 
+#include <QThread>
 #include <QtDebug>
+#include <cmath>
 
 #include "control/controlobject.h"
 #include "engine/readaheadmanager.h"
@@ -10,7 +12,10 @@
 #include "track/keyutils.h"
 #include "util/counter.h"
 #include "util/defs.h"
+#include "util/denormalsarezero.h"
 #include "util/math.h"
+#include "util/realtimeprofile.h"
+#include "util/rtsemaphore.h"
 #include "util/sample.h"
 
 using RubberBand::RubberBandStretcher;
@@ -24,14 +29,105 @@ size_t kRubberBandBlockSize = 256;
 
 #define RUBBERBANDV3 (RUBBERBAND_API_MAJOR_VERSION >= 2 && RUBBERBAND_API_MINOR_VERSION >= 7)
 
+// The extremes that RubberBand is configured for before playback, which
+// covers rates down to 0.25 and pitch shifts of an octave
+constexpr double kPreallocationTimeRatio = 4.0;
+constexpr double kPreallocationPitchScale = 2.0;
+
+// The input that is read ahead for the worker may need a multiple of the
+// output buffer at high rates
+constexpr SINT kInputBufferSize = 2 * MAX_BUFFER_LEN;
+
+// The number of busy-wait iterations before yielding the CPU while waiting
+// for the worker, which usually has finished long before
+constexpr int kSpinIterationsBeforeYield = 1024;
+
+std::atomic<int> s_workerCount(0);
+
 }  // namespace
 
+/// Processes the stretcher of a single deck one buffer ahead. The engine
+/// thread starts a job after it has taken the output of the previous job
+/// and waits until the job is done before it touches the stretcher again,
+/// i.e. they never access the stretcher or the buffers at the same time.
+class EngineBufferScaleRubberBand::Worker final : public QThread {
+  public:
+    explicit Worker(EngineBufferScaleRubberBand* pScale)
+            : m_pScale(pScale),
+              m_frames(0),
+              m_busy(false),
+              m_quit(false) {
+        setObjectName(QStringLiteral("RubberBand %1").arg(++s_workerCount));
+    }
+
+    ~Worker() override {
+        m_quit.store(true);
+        m_semaRun.release();
+        wait();
+    }
+
+    /// Called from the engine thread
+    void startJob(SINT frames) {
+        m_frames = frames;
+        m_busy.store(true, std::memory_order_release);
+        m_semaRun.release();
+    }
+
+    /// Called from the engine thread
+    void waitUntilIdle() {
+        int spinIterations = 0;
+        while (m_busy.load(std::memory_order_acquire)) {
+            if (++spinIterations >= kSpinIterationsBeforeYield) {
+                spinIterations = 0;
+                QThread::yieldCurrentThread();
+            }
+        }
+    }
+
+  protected:
+    void run() override {
+        mixxx::RealtimeProfile::applyToCurrentThread(
+                mixxx::RealtimeProfile::Role::EngineWorker, objectName());
+#ifdef __SSE__
+        // Same floating point environment as the callback thread
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+#endif
+        while (true) {
+            m_semaRun.acquire();
+            if (m_quit.load()) {
+                break;
+            }
+            m_pScale->processAhead(m_frames, false);
+            m_busy.store(false, std::memory_order_release);
+        }
+        mixxx::RealtimeProfile::removeThread(objectName());
+    }
+
+  private:
+    EngineBufferScaleRubberBand* const m_pScale;
+    RtSemaphore m_semaRun;
+    // Written before m_busy is set
+    SINT m_frames;
+    std::atomic<bool> m_busy;
+    std::atomic<bool> m_quit;
+};
+
 EngineBufferScaleRubberBand::EngineBufferScaleRubberBand(
         ReadAheadManager* pReadAheadManager)
         : m_pReadAheadManager(pReadAheadManager),
+          m_pRubberBand(nullptr),
+          m_remainingPaddingInOutput(0),
           m_buffer_back(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_bBackwards(false),
-          m_useEngineFiner(false) {
+          m_useEngineFiner(false),
+          m_multiThreadedRequested(false),
+          m_multiThreaded(false),
+          m_workerBusy(false),
+          m_inputOffset(0),
+          m_inputFrames(0),
+          m_aheadFrames(0),
+          m_aheadFramesRead(0.0) {
     m_retrieve_buffer[0] = SampleUtil::alloc(MAX_BUFFER_LEN);
     m_retrieve_buffer[1] = SampleUtil::alloc(MAX_BUFFER_LEN);
     // Initialize the internal buffers to prevent re-allocations
@@ -40,6 +136,8 @@ EngineBufferScaleRubberBand::EngineBufferScaleRubberBand(
 }
 
 EngineBufferScaleRubberBand::~EngineBufferScaleRubberBand() {
+    // The worker must not access the buffers anymore
+    m_pWorker.reset();
     SampleUtil::free(m_buffer_back);
     SampleUtil::free(m_retrieve_buffer[0]);
     SampleUtil::free(m_retrieve_buffer[1]);
@@ -48,6 +146,8 @@ EngineBufferScaleRubberBand::~EngineBufferScaleRubberBand() {
 void EngineBufferScaleRubberBand::setScaleParameters(double base_rate,
                                                      double* pTempoRatio,
                                                      double* pPitchRatio) {
+    waitForWorker();
+
     // Negative speed means we are going backwards. pitch does not affect
     // the playback direction.
     m_bBackwards = *pTempoRatio < 0;
@@ -113,42 +213,295 @@ void EngineBufferScaleRubberBand::onSampleRateChanged() {
     // TODO: Resetting the sample rate will cause internal
     // memory allocations that may block the real-time thread.
     // When is this function actually invoked??
+    waitForWorker();
+    discardAhead();
+    m_pRubberBand = nullptr;
     if (!getOutputSignal().isValid()) {
-        m_pRubberBand.reset();
+        m_pRubberBandFaster.reset();
+        m_pRubberBandFiner.reset();
         return;
     }
+    // Both engines are kept, so switching between them neither allocates
+    // nor needs to wait until a new stretcher has been created
+    m_pRubberBandFaster = createStretcher(false);
+    if (isEngineFinerAvailable()) {
+        m_pRubberBandFiner = createStretcher(true);
+    }
+    m_pRubberBand = m_useEngineFiner.load(std::memory_order_acquire) && m_pRubberBandFiner
+            ? m_pRubberBandFiner.get()
+            : m_pRubberBandFaster.get();
+    resetStretcher();
+}
+
+std::unique_ptr<RubberBandStretcher> EngineBufferScaleRubberBand::createStretcher(
+        bool engineFiner) const {
     RubberBandStretcher::Options rubberbandOptions =
             RubberBandStretcher::OptionProcessRealTime;
 #if RUBBERBANDV3
-    if (m_useEngineFiner) {
+    if (engineFiner) {
         rubberbandOptions |= RubberBandStretcher::OptionEngineFiner;
     }
+#else
+    Q_UNUSED(engineFiner);
 #endif
 
-    m_pRubberBand = std::make_unique<RubberBandStretcher>(
+    auto pRubberBand = std::make_unique<RubberBandStretcher>(
             getOutputSignal().getSampleRate(),
             getOutputSignal().getChannelCount(),
             rubberbandOptions);
     // TODO (XXX): we should always be able to provide rubberband as
     // many samples as it wants. So remove this.
-    m_pRubberBand->setMaxProcessSize(kRubberBandBlockSize);
-    // Setting the time ratio to a very high value will cause RubberBand
-    // to preallocate buffers large enough to (almost certainly)
-    // avoid memory reallocations during playback.
-    m_pRubberBand->setTimeRatio(2.0);
-    m_pRubberBand->setTimeRatio(1.0);
+    pRubberBand->setMaxProcessSize(kRubberBandBlockSize);
+    // Setting the time ratio and the pitch scale to very high values will
+    // cause RubberBand to preallocate buffers large enough to (almost
+    // certainly) avoid memory reallocations during playback, including the
+    // resamplers for pitch shifting that are otherwise created on the first
+    // pitch change.
+    pRubberBand->setTimeRatio(kPreallocationTimeRatio);
+    pRubberBand->setPitchScale(kPreallocationPitchScale);
+    pRubberBand->setPitchScale(1.0 / kPreallocationPitchScale);
+    pRubberBand->setPitchScale(1.0);
+    pRubberBand->setTimeRatio(1.0);
+    return pRubberBand;
+}
+
+void EngineBufferScaleRubberBand::resetStretcher() {
+    m_pRubberBand->reset();
+    // RubberBand fades in the first input frames unless it is primed with
+    // some silence ahead, and the output is delayed by its start delay.
+    // This makes the first buffer after a seek or after switching the
+    // scaler or the engine start without a gap.
+    // https://breakfastquay.com/rubberband/integration.html#faqs
+    SINT remainingPadding = static_cast<SINT>(getPreferredStartPad());
+    const SINT blockFrames = math_min(remainingPadding, static_cast<SINT>(kRubberBandBlockSize));
+    SampleUtil::clear(m_retrieve_buffer[0], blockFrames);
+    SampleUtil::clear(m_retrieve_buffer[1], blockFrames);
+    while (remainingPadding > 0) {
+        const SINT paddingFrames = math_min(remainingPadding, blockFrames);
+        m_pRubberBand->process(m_retrieve_buffer, paddingFrames, false);
+        remainingPadding -= paddingFrames;
+    }
+    m_remainingPaddingInOutput = static_cast<SINT>(getStartDelay());
+}
+
+size_t EngineBufferScaleRubberBand::getPreferredStartPad() const {
+#if RUBBERBANDV3
+    return m_pRubberBand->getPreferredStartPad();
+#else
+    // getPreferredStartPad() of newer versions is half of the window size,
+    // getLatency() is that divided by the pitch scale
+    return static_cast<size_t>(std::ceil(
+            m_pRubberBand->getLatency() * m_pRubberBand->getPitchScale()));
+#endif
+}
+
+size_t EngineBufferScaleRubberBand::getStartDelay() const {
+#if RUBBERBANDV3
+    return m_pRubberBand->getStartDelay();
+#else
+    return m_pRubberBand->getLatency();
+#endif
 }
 
 void EngineBufferScaleRubberBand::clear() {
+    waitForWorker();
+    discardAhead();
     VERIFY_OR_DEBUG_ASSERT(m_pRubberBand) {
         return;
     }
-    m_pRubberBand->reset();
+    if (isEngineChangePending()) {
+        m_pRubberBand = m_pRubberBand == m_pRubberBandFiner.get()
+                ? m_pRubberBandFaster.get()
+                : m_pRubberBandFiner.get();
+    }
+    resetStretcher();
+}
+
+bool EngineBufferScaleRubberBand::isEngineChangePending() const {
+    if (!m_pRubberBand || !m_pRubberBandFiner) {
+        return false;
+    }
+    const bool useEngineFiner = m_useEngineFiner.load(std::memory_order_acquire);
+    return useEngineFiner != (m_pRubberBand == m_pRubberBandFiner.get());
+}
+
+void EngineBufferScaleRubberBand::setMultiThreaded(bool enable) {
+    if (enable && !m_pWorker) {
+        // Allocated before the engine thread can use them
+        m_input = mixxx::SampleBuffer(kInputBufferSize);
+        m_ahead = mixxx::SampleBuffer(MAX_BUFFER_LEN);
+        m_pWorker = std::make_unique<Worker>(this);
+        m_pWorker->start(QThread::TimeCriticalPriority);
+    }
+    m_multiThreadedRequested.store(enable, std::memory_order_release);
+}
+
+void EngineBufferScaleRubberBand::waitForWorker() {
+    if (m_workerBusy.load(std::memory_order_acquire)) {
+        m_pWorker->waitUntilIdle();
+        m_workerBusy.store(false, std::memory_order_relaxed);
+    }
+}
+
+void EngineBufferScaleRubberBand::applyMultiThreaded() {
+    const bool multiThreaded = m_multiThreadedRequested.load(std::memory_order_acquire);
+    if (multiThreaded == m_multiThreaded) {
+        return;
+    }
+    m_multiThreaded = multiThreaded;
+    // The input that has been read ahead and the output that has been
+    // processed ahead would be lost when switching to the synchronous
+    // processing, so start over in both directions
+    discardAhead();
+    if (m_pRubberBand) {
+        resetStretcher();
+    }
+}
+
+void EngineBufferScaleRubberBand::discardAhead() {
+    m_inputOffset = 0;
+    m_inputFrames = 0;
+    m_aheadFrames = 0;
+    m_aheadFramesRead = 0.0;
+}
+
+void EngineBufferScaleRubberBand::readInput(SINT minFrames) {
+    const SINT channelCount = getOutputSignal().getChannelCount();
+    // Move the unprocessed frames to the front
+    if (m_inputOffset > 0) {
+        const SINT unprocessedFrames = m_inputFrames - m_inputOffset;
+        std::copy(m_input.data(m_inputOffset * channelCount),
+                m_input.data(m_inputFrames * channelCount),
+                m_input.data());
+        m_inputOffset = 0;
+        m_inputFrames = unprocessedFrames;
+    }
+    const SINT capacityFrames = m_input.size() / channelCount;
+    minFrames = math_min(minFrames, capacityFrames);
+    while (m_inputFrames < minFrames) {
+        const SINT samples = m_pReadAheadManager->getNextSamples(
+                // The value doesn't matter here. All that matters is we
+                // are going forward or backward.
+                (m_bBackwards ? -1.0 : 1.0) * m_dBaseRate * m_dTempoRatio,
+                m_input.data(m_inputFrames * channelCount),
+                (minFrames - m_inputFrames) * channelCount);
+        if (samples <= 0) {
+            break;
+        }
+        m_inputFrames += samples / channelCount;
+    }
+}
+
+void EngineBufferScaleRubberBand::processAhead(SINT frames, bool readMissingInput) {
+    const SINT channelCount = getOutputSignal().getChannelCount();
+    const double framesReadPerFrame = m_dBaseRate * m_dTempoRatio;
+    frames = math_min(frames, m_ahead.size() / channelCount);
+    while (m_aheadFrames < frames) {
+        if (m_pRubberBand->available() > 0) {
+            const SINT receivedFrames = retrieveAndDeinterleave(
+                    m_ahead.data(m_aheadFrames * channelCount),
+                    frames - m_aheadFrames);
+            if (receivedFrames <= 0) {
+                if (m_pRubberBand->available() <= 0) {
+                    // Only the padding has been dropped
+                    continue;
+                }
+                break;
+            }
+            m_aheadFrames += receivedFrames;
+            m_aheadFramesRead += framesReadPerFrame * receivedFrames;
+            continue;
+        }
+        SINT requiredFrames = static_cast<SINT>(m_pRubberBand->getSamplesRequired());
+        if (requiredFrames == 0) {
+            // See the RubberBand 1.3 workaround in scaleBuffer()
+            requiredFrames = kRubberBandBlockSize;
+        }
+        if (m_inputFrames - m_inputOffset < requiredFrames && readMissingInput) {
+            readInput(requiredFrames);
+        }
+        const SINT inputFrames = math_min(requiredFrames, m_inputFrames - m_inputOffset);
+        if (inputFrames <= 0) {
+            // The worker could not get enough input, the engine thread
+            // processes the missing frames when it takes them
+            break;
+        }
+        deinterleaveAndProcess(m_input.data(m_inputOffset * channelCount), inputFrames, false);
+        m_inputOffset += inputFrames;
+    }
+}
+
+SINT EngineBufferScaleRubberBand::takeAhead(
+        CSAMPLE* pBuffer, SINT frames, double* pFramesRead) {
+    const SINT channelCount = getOutputSignal().getChannelCount();
+    const SINT takenFrames = math_min(frames, m_aheadFrames);
+    if (takenFrames <= 0) {
+        return 0;
+    }
+    SampleUtil::copy(pBuffer, m_ahead.data(), takenFrames * channelCount);
+    const double takenFramesRead = m_aheadFramesRead * takenFrames / m_aheadFrames;
+    *pFramesRead += takenFramesRead;
+    m_aheadFramesRead -= takenFramesRead;
+    m_aheadFrames -= takenFrames;
+    if (m_aheadFrames > 0) {
+        std::copy(m_ahead.data(takenFrames * channelCount),
+                m_ahead.data((takenFrames + m_aheadFrames) * channelCount),
+                m_ahead.data());
+    }
+    return takenFrames;
+}
+
+double EngineBufferScaleRubberBand::scaleBufferAhead(
+        CSAMPLE* pOutputBuffer,
+        SINT iOutputBufferSize) {
+    const SINT frames = getOutputSignal().samples2frames(iOutputBufferSize);
+    if (m_aheadFrames < frames) {
+        // Nothing has been processed ahead after clear(), or the worker
+        // was short of input or the buffer has grown. Process the missing
+        // frames synchronously.
+        processAhead(frames, true);
+    }
+    double framesRead = 0.0;
+    const SINT receivedFrames = takeAhead(pOutputBuffer, frames, &framesRead);
+    if (receivedFrames < frames) {
+        SampleUtil::clear(pOutputBuffer + getOutputSignal().frames2samples(receivedFrames),
+                getOutputSignal().frames2samples(frames - receivedFrames));
+        Counter counter("EngineBufferScaleRubberBand::getScaled underflow");
+        counter.increment();
+    }
+
+    // Read the input for the next buffer with some headroom, because the
+    // worker cannot read from the ReadAheadManager. The stretcher takes
+    // its input in blocks of getSamplesRequired() frames.
+    const SINT requiredFrames = math_max(
+            static_cast<SINT>(m_pRubberBand->getSamplesRequired()),
+            static_cast<SINT>(kRubberBandBlockSize));
+    readInput(static_cast<SINT>(std::ceil(frames * m_dBaseRate * m_dTempoRatio)) +
+            requiredFrames + static_cast<SINT>(kRubberBandBlockSize));
+    m_pWorker->startJob(frames);
+    m_workerBusy.store(true, std::memory_order_release);
+
+    // The unstretched frames of the output buffer, not of the input that
+    // has been read ahead, so the play position follows the audio output
+    return framesRead;
 }
 
 SINT EngineBufferScaleRubberBand::retrieveAndDeinterleave(
         CSAMPLE* pBuffer,
         SINT frames) {
+    // Drop the start delay of the padding from resetStretcher()
+    while (m_remainingPaddingInOutput > 0) {
+        const SINT paddingFrames = math_min(
+                math_min(m_remainingPaddingInOutput,
+                        static_cast<SINT>(m_pRubberBand->available())),
+                static_cast<SINT>(MAX_BUFFER_LEN));
+        if (paddingFrames <= 0) {
+            return 0;
+        }
+        m_remainingPaddingInOutput -= static_cast<SINT>(
+                m_pRubberBand->retrieve(m_retrieve_buffer, paddingFrames));
+    }
+
     SINT frames_available = m_pRubberBand->available();
     SINT frames_to_read = math_min(frames_available, frames);
     SINT received_frames = static_cast<SINT>(m_pRubberBand->retrieve(
@@ -175,6 +528,9 @@ void EngineBufferScaleRubberBand::deinterleaveAndProcess(
 double EngineBufferScaleRubberBand::scaleBuffer(
         CSAMPLE* pOutputBuffer,
         SINT iOutputBufferSize) {
+    waitForWorker();
+    applyMultiThreaded();
+
     if (m_dBaseRate == 0.0 || m_dTempoRatio == 0.0) {
         SampleUtil::clear(pOutputBuffer, iOutputBufferSize);
         // No actual samples/frames have been read from the
@@ -182,6 +538,10 @@ double EngineBufferScaleRubberBand::scaleBuffer(
         return 0.0;
     }
 
+    if (m_multiThreaded) {
+        return scaleBufferAhead(pOutputBuffer, iOutputBufferSize);
+    }
+
     SINT total_received_frames = 0;
 
     SINT remaining_frames = getOutputSignal().samples2frames(iOutputBufferSize);
@@ -203,7 +563,7 @@ double EngineBufferScaleRubberBand::scaleBuffer(
             //qDebug() << "break_out_after_retrieve_and_reset_rubberband";
             // If we break out early then we have flushed RubberBand and need to
             // reset it.
-            m_pRubberBand->reset();
+            resetStretcher();
             break;
         }
 
@@ -275,8 +635,7 @@ bool EngineBufferScaleRubberBand::isEngineFinerAvailable() {
 
 void EngineBufferScaleRubberBand::useEngineFiner(bool enable) {
     if (isEngineFinerAvailable()) {
-        m_useEngineFiner = enable;
-        onSampleRateChanged();
+        m_useEngineFiner.store(enable, std::memory_order_release);
     }
 }
 
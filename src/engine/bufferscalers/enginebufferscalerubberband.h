@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
+
 #include "engine/bufferscalers/enginebufferscale.h"
 #include "util/memory.h"
+#include "util/samplebuffer.h"
 
 namespace RubberBand {
 class RubberBandStretcher;
@@ -20,9 +23,23 @@ class EngineBufferScaleRubberBand : public EngineBufferScale {
     // Let EngineBuffer know if engine v3 is available
     static bool isEngineFinerAvailable();
 
-    // Enable engine v3 if available
+    // Enable engine v3 if available. Both engines are allocated up front,
+    // so this does not allocate. Called from the main thread, the engine
+    // thread switches at the next clear().
     void useEngineFiner(bool enable);
 
+    // Whether useEngineFiner() has selected the other engine, which is
+    // used after the next clear(). Called from the engine thread.
+    bool isEngineChangePending() const;
+
+    /// Runs the stretcher on a dedicated thread one buffer ahead of the
+    /// engine, so the stretchers of all decks run in parallel with each
+    /// other and with the rest of the engine. Rate and pitch changes are
+    /// heard one buffer later, the play position follows the audio that
+    /// has actually been output. Called from the main thread, takes effect
+    /// with the next buffer after a short dropout.
+    void setMultiThreaded(bool enable);
+
     void setScaleParameters(double base_rate,
                             double* pTempoRatio,
                             double* pPitchRatio) override;
@@ -35,18 +52,50 @@ class EngineBufferScaleRubberBand : public EngineBufferScale {
     void clear() override;
 
   private:
+    class Worker;
+
     // Reset RubberBand library with new audio signal
     void onSampleRateChanged() override;
 
     int runningEngineVersion();
 
+    std::unique_ptr<RubberBand::RubberBandStretcher> createStretcher(bool engineFiner) const;
+    // Resets the stretcher and primes it with the padding RubberBand asks
+    // for, so the output starts with the first input frame instead of a
+    // fade-in after the latency of the stretcher
+    void resetStretcher();
+    size_t getPreferredStartPad() const;
+    size_t getStartDelay() const;
+
     void deinterleaveAndProcess(const CSAMPLE* pBuffer, SINT frames, bool flush);
     SINT retrieveAndDeinterleave(CSAMPLE* pBuffer, SINT frames);
 
+    // Must be called before the stretcher or the buffers of the worker
+    // are accessed from the engine thread
+    void waitForWorker();
+    void applyMultiThreaded();
+    void discardAhead();
+    double scaleBufferAhead(CSAMPLE* pOutputBuffer, SINT iOutputBufferSize);
+    // Reads from the ReadAheadManager until m_input holds at least
+    // minFrames unprocessed frames. Only called from the engine thread.
+    void readInput(SINT minFrames);
+    // Processes the frames in m_input until m_ahead holds at least frames
+    // frames. May run on the worker thread unless readMissingInput is set.
+    void processAhead(SINT frames, bool readMissingInput);
+    // Moves up to frames frames from m_ahead to pBuffer and returns them,
+    // adds the corresponding unstretched frames to pFramesRead
+    SINT takeAhead(CSAMPLE* pBuffer, SINT frames, double* pFramesRead);
+
     // The read-ahead manager that we use to fetch samples
     ReadAheadManager* m_pReadAheadManager;
 
-    std::unique_ptr<RubberBand::RubberBandStretcher> m_pRubberBand;
+    std::unique_ptr<RubberBand::RubberBandStretcher> m_pRubberBandFaster;
+    // Only allocated if the finer engine is available
+    std::unique_ptr<RubberBand::RubberBandStretcher> m_pRubberBandFiner;
+    // The stretcher that is used, one of the above
+    RubberBand::RubberBandStretcher* m_pRubberBand;
+    // Output frames of the padding that are still to be dropped
+    SINT m_remainingPaddingInOutput;
 
     CSAMPLE* m_retrieve_buffer[2];
     CSAMPLE* m_buffer_back;
@@ -54,5 +103,24 @@ class EngineBufferScaleRubberBand : public EngineBufferScale {
     // Holds the playback direction
     bool m_bBackwards;
 
-    bool m_useEngineFiner;
+    std::atomic<bool> m_useEngineFiner;
+
+    // Only created and allocated when multi-threading is enabled for the
+    // first time
+    std::unique_ptr<Worker> m_pWorker;
+    std::atomic<bool> m_multiThreadedRequested;
+    // The current mode of the engine thread
+    bool m_multiThreaded;
+    // Also read by the main thread before it recreates the stretcher
+    std::atomic<bool> m_workerBusy;
+    // Interleaved input that has been read ahead, m_inputOffset frames of
+    // the first m_inputFrames frames have been processed
+    mixxx::SampleBuffer m_input;
+    SINT m_inputOffset;
+    SINT m_inputFrames;
+    // Interleaved output for the next buffer
+    mixxx::SampleBuffer m_ahead;
+    SINT m_aheadFrames;
+    // The unstretched frames that correspond to the frames in m_ahead
+    double m_aheadFramesRead;
 };
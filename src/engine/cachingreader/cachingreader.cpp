@@ -2,8 +2,10 @@
 
 #include <QFileInfo>
 #include <QtDebug>
+#include <algorithm>
 
 #include "control/controlobject.h"
+#include "mixer/playermanager.h"
 #include "moc_cachingreader.cpp"
 #include "track/track.h"
 #include "util/assert.h"
@@ -11,6 +13,8 @@
 #include "util/counter.h"
 #include "util/logger.h"
 #include "util/math.h"
+#include "util/metrics.h"
+#include "util/realtimeprofile.h"
 #include "util/sample.h"
 
 namespace {
@@ -33,17 +37,100 @@ constexpr SINT kDefaultHintFrames = 1024;
 // CachingReader must be multiplied by the number of decks to calculate
 // the total amount!
 //
+// The number of chunks per deck can be configured, e.g. to keep more
+// chunks around the hot cues of long tracks in memory.
+//
 // NOTE(uklotzde, 2019-09-05): Reduce this number to just few chunks
-// (kNumberOfCachedChunksInMemory = 1, 2, 3, ...) for testing purposes
+// (kDefaultNumberOfCachedChunksInMemory = 1, 2, 3, ...) for testing purposes
 // to verify that the MRU/LRU cache works as expected. Even though
 // massive drop outs are expected to occur Mixxx should run reliably!
-constexpr SINT kNumberOfCachedChunksInMemory = 80;
+constexpr SINT kDefaultNumberOfCachedChunksInMemory = 80;
+constexpr SINT kMinNumberOfCachedChunksInMemory = 1;
+// 4096 chunks -> 256 MB
+constexpr SINT kMaxNumberOfCachedChunksInMemory = 4096;
+
+const ConfigKey kNumberOfCachedChunksConfigKey(
+        QStringLiteral("[Master]"),
+        QStringLiteral("cached_chunks_per_deck"));
+
+const ConfigKey kPinCueChunksConfigKey(
+        QStringLiteral("[Master]"),
+        QStringLiteral("cached_chunks_pin_cues"));
+
+// Tracks up to this duration are preloaded into memory. 30 s of stereo
+// samples at 48 kHz consume about 11 MB.
+const ConfigKey kPreloadMaxSecondsConfigKey(
+        QStringLiteral("[Master]"),
+        QStringLiteral("preload_max_seconds"));
+constexpr int kDefaultPreloadMaxSeconds = 15;
+constexpr int kMaxPreloadMaxSeconds = 30;
+
+// Preload the tracks of samplers up to the maximum duration, because
+// their samples are typically triggered instantly after being idle.
+const ConfigKey kPreloadSamplersConfigKey(
+        QStringLiteral("[Master]"),
+        QStringLiteral("preload_samplers"));
+
+mixxx::Duration preloadMaxDuration(
+        const QString& group,
+        const UserSettingsPointer& pConfig) {
+    if (PlayerManager::isSamplerGroup(group) &&
+            (!pConfig || pConfig->getValue<bool>(kPreloadSamplersConfigKey, true))) {
+        return mixxx::Duration::fromSeconds(kMaxPreloadMaxSeconds);
+    }
+    if (!pConfig) {
+        return mixxx::Duration::fromSeconds(kDefaultPreloadMaxSeconds);
+    }
+    return mixxx::Duration::fromSeconds(math_clamp(
+            pConfig->getValue<int>(kPreloadMaxSecondsConfigKey, kDefaultPreloadMaxSeconds),
+            0,
+            kMaxPreloadMaxSeconds));
+}
+
+// At least half of the chunks must remain available for the MRU/LRU
+// cache, i.e. for reading around the play position.
+constexpr SINT kMaxPinnedChunksDivisor = 2;
+
+// Hints for positions the user is likely to jump to, but that are not
+// played right now.
+bool isPinnableHint(Hint::Type type) {
+    switch (type) {
+    case Hint::Type::MainCue:
+    case Hint::Type::HotCue:
+    case Hint::Type::LoopStartEnabled:
+    case Hint::Type::LoopEndEnabled:
+    case Hint::Type::LoopStart:
+    case Hint::Type::IntroStart:
+    case Hint::Type::IntroEnd:
+    case Hint::Type::OutroStart:
+        return true;
+    default:
+        return false;
+    }
+}
 
 } // anonymous namespace
 
+// static
+SINT CachingReader::configuredNumberOfCachedChunks(
+        const UserSettingsPointer& pConfig) {
+    if (!pConfig) {
+        return kDefaultNumberOfCachedChunksInMemory;
+    }
+    return math_clamp(
+            static_cast<SINT>(pConfig->getValue<int>(
+                    kNumberOfCachedChunksConfigKey,
+                    static_cast<int>(kDefaultNumberOfCachedChunksInMemory))),
+            kMinNumberOfCachedChunksInMemory,
+            kMaxNumberOfCachedChunksInMemory);
+}
+
 CachingReader::CachingReader(const QString& group,
-        UserSettingsPointer config)
+        UserSettingsPointer config,
+        CachingReaderSharedCache* pSharedCache,
+        CachingReaderDiskCache* pDiskCache)
         : m_pConfig(config),
+          m_numberOfCachedChunks(configuredNumberOfCachedChunks(config)),
           // Limit the number of in-flight requests to the worker. This should
           // prevent to overload the worker when it is not able to fetch those
           // requests from the FIFO timely. Otherwise outdated requests pile up
@@ -53,21 +140,54 @@ CachingReader::CachingReader(const QString& group,
           // buffer, where new requests replace old requests when full. Those
           // old requests need to be returned immediately to the CachingReader
           // that must take ownership and free them!!!
-          m_chunkReadRequestFIFO(kNumberOfCachedChunksInMemory / 4),
+          m_chunkReadRequestFIFO(static_cast<int>(m_numberOfCachedChunks / 4)),
           // The capacity of the back channel must be equal to the number of
           // allocated chunks, because the worker use writeBlocking(). Otherwise
           // the worker could get stuck in a hot loop!!!
-          m_readerStatusUpdateFIFO(kNumberOfCachedChunksInMemory),
+          m_readerStatusUpdateFIFO(static_cast<int>(m_numberOfCachedChunks)),
           m_state(STATE_IDLE),
+          m_allocatedCachingReaderChunks(m_numberOfCachedChunks),
           m_mruCachingReaderChunk(nullptr),
           m_lruCachingReaderChunk(nullptr),
-          m_sampleBuffer(CachingReaderChunk::kSamples * kNumberOfCachedChunksInMemory),
-          m_worker(group, &m_chunkReadRequestFIFO, &m_readerStatusUpdateFIFO) {
-    m_allocatedCachingReaderChunks.reserve(kNumberOfCachedChunksInMemory);
+          m_pinCueChunks(!config || config->getValue<bool>(kPinCueChunksConfigKey, true)),
+          m_maxPinnedChunks(m_numberOfCachedChunks / kMaxPinnedChunksDivisor),
+          m_pinGeneration(0),
+          m_sampleBuffer(CachingReaderChunk::kSamples * m_numberOfCachedChunks),
+          m_pPreloadedSamples(nullptr),
+          m_worker(group,
+                  &m_chunkReadRequestFIFO,
+                  &m_readerStatusUpdateFIFO,
+                  pSharedCache,
+                  pDiskCache,
+                  preloadMaxDuration(group, config),
+                  config),
+          m_cacheHits(0),
+          m_cacheMisses(0),
+          m_pCacheHits(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("cache_hits")))),
+          m_pCacheMisses(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("cache_misses")))),
+          m_pSharedCacheHits(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("cache_shared_hits")))),
+          m_pDiskCacheHits(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("cache_disk_hits")))) {
+    m_pCacheHits->setReadOnly();
+    m_pCacheMisses->setReadOnly();
+    m_pSharedCacheHits->setReadOnly();
+    m_pDiskCacheHits->setReadOnly();
+
+    m_pinnedChunks.reserve(m_maxPinnedChunks);
+    mixxx::metrics::cachingReaderBytes.add(
+            static_cast<qint64>(m_sampleBuffer.size() * sizeof(CSAMPLE)));
+
+    // The callback reads the chunks directly
+    mixxx::RealtimeProfile::lockMemory(
+            m_sampleBuffer.data(), m_sampleBuffer.size() * sizeof(CSAMPLE));
+
     // Divide up the allocated raw memory buffer into total_chunks
     // chunks. Initialize each chunk to hold nothing and add it to the free
     // list.
-    for (SINT i = 0; i < kNumberOfCachedChunksInMemory; ++i) {
+    for (SINT i = 0; i < m_numberOfCachedChunks; ++i) {
         CachingReaderChunkForOwner* c =
                 new CachingReaderChunkForOwner(
                         mixxx::SampleBuffer::WritableSlice(
@@ -88,6 +208,11 @@ CachingReader::CachingReader(const QString& group,
     connect(&m_worker, &CachingReaderWorker::trackLoadFailed,
             this, &CachingReader::trackLoadFailed,
             Qt::DirectConnection);
+    connect(&m_worker,
+            &CachingReaderWorker::provisionalReplayGainChanged,
+            this,
+            &CachingReader::provisionalReplayGainChanged,
+            Qt::DirectConnection);
 
     m_worker.start(QThread::HighPriority);
 }
@@ -95,9 +220,16 @@ CachingReader::CachingReader(const QString& group,
 CachingReader::~CachingReader() {
     m_worker.quitWait();
     qDeleteAll(m_chunks);
+    mixxx::metrics::cachingReaderBytes.add(
+            -static_cast<qint64>(m_sampleBuffer.size() * sizeof(CSAMPLE)));
 }
 
 void CachingReader::freeChunkFromList(CachingReaderChunkForOwner* pChunk) {
+    if (pChunk->isPinned()) {
+        const auto it = std::find(m_pinnedChunks.begin(), m_pinnedChunks.end(), pChunk);
+        DEBUG_ASSERT(it != m_pinnedChunks.end());
+        m_pinnedChunks.erase(it);
+    }
     pChunk->removeFromList(
             &m_mruCachingReaderChunk,
             &m_lruCachingReaderChunk);
@@ -132,10 +264,54 @@ void CachingReader::freeAllChunks() {
     }
     DEBUG_ASSERT(!m_mruCachingReaderChunk);
     DEBUG_ASSERT(!m_lruCachingReaderChunk);
+    DEBUG_ASSERT(m_pinnedChunks.empty());
 
     m_allocatedCachingReaderChunks.clear();
 }
 
+bool CachingReader::pinChunk(CachingReaderChunkForOwner* pChunk) {
+    DEBUG_ASSERT(pChunk);
+    DEBUG_ASSERT(pChunk->getState() == CachingReaderChunkForOwner::READY);
+    DEBUG_ASSERT(m_pinGeneration != 0);
+    if (!pChunk->isPinned()) {
+        if (static_cast<SINT>(m_pinnedChunks.size()) >= m_maxPinnedChunks) {
+            return false;
+        }
+        pChunk->removeFromList(
+                &m_mruCachingReaderChunk,
+                &m_lruCachingReaderChunk);
+        // Never exceeds the reserved capacity, i.e. doesn't allocate
+        m_pinnedChunks.push_back(pChunk);
+    }
+    pChunk->setPinGeneration(m_pinGeneration);
+    return true;
+}
+
+void CachingReader::unpinChunk(CachingReaderChunkForOwner* pChunk) {
+    DEBUG_ASSERT(pChunk->isPinned());
+    pChunk->setPinGeneration(0);
+    // Reinsert as new head of MRU list
+    pChunk->insertIntoListBefore(
+            &m_mruCachingReaderChunk,
+            &m_lruCachingReaderChunk,
+            m_mruCachingReaderChunk);
+}
+
+void CachingReader::unpinStaleChunks() {
+    auto it = m_pinnedChunks.begin();
+    while (it != m_pinnedChunks.end()) {
+        auto* const pChunk = *it;
+        if (pChunk->getPinGeneration() == m_pinGeneration) {
+            ++it;
+            continue;
+        }
+        unpinChunk(pChunk);
+        // Order doesn't matter, swap with the last element
+        *it = m_pinnedChunks.back();
+        m_pinnedChunks.pop_back();
+    }
+}
+
 CachingReaderChunkForOwner* CachingReader::allocateChunk(SINT chunkIndex) {
     if (m_freeChunks.empty()) {
         return nullptr;
@@ -145,7 +321,10 @@ CachingReaderChunkForOwner* CachingReader::allocateChunk(SINT chunkIndex) {
 
     pChunk->init(chunkIndex);
 
-    m_allocatedCachingReaderChunks.insert(chunkIndex, pChunk);
+    const bool inserted = m_allocatedCachingReaderChunks.insert(chunkIndex, pChunk);
+    Q_UNUSED(inserted); // only used in DEBUG_ASSERT
+    // The index has been sized for all chunks
+    DEBUG_ASSERT(inserted);
 
     return pChunk;
 }
@@ -167,8 +346,8 @@ CachingReaderChunkForOwner* CachingReader::allocateChunkExpireLRU(SINT chunkInde
 }
 
 CachingReaderChunkForOwner* CachingReader::lookupChunk(SINT chunkIndex) {
-    // Defaults to nullptr if it's not in the hash.
-    auto* pChunk = m_allocatedCachingReaderChunks.value(chunkIndex, nullptr);
+    // Defaults to nullptr if it's not in the index.
+    auto* pChunk = m_allocatedCachingReaderChunks.find(chunkIndex);
     DEBUG_ASSERT(!pChunk || pChunk->getIndex() == chunkIndex);
     return pChunk;
 }
@@ -176,6 +355,10 @@ CachingReaderChunkForOwner* CachingReader::lookupChunk(SINT chunkIndex) {
 void CachingReader::freshenChunk(CachingReaderChunkForOwner* pChunk) {
     DEBUG_ASSERT(pChunk);
     DEBUG_ASSERT(pChunk->getState() == CachingReaderChunkForOwner::READY);
+    if (pChunk->isPinned()) {
+        // Pinned chunks are not referenced by the MRU/LRU list
+        return;
+    }
     if (kLogger.traceEnabled()) {
         kLogger.trace()
                 << "freshenChunk()"
@@ -267,17 +450,21 @@ void CachingReader::process() {
                 // TRACK_LOADED without a chunk in between, assert this here.
                 DEBUG_ASSERT(atomicLoadRelaxed(m_state) == STATE_TRACK_LOADING ||
                         (atomicLoadRelaxed(m_state) == STATE_TRACK_LOADED &&
-                                !m_mruCachingReaderChunk && !m_lruCachingReaderChunk));
+                                !m_mruCachingReaderChunk && !m_lruCachingReaderChunk &&
+                                m_pinnedChunks.empty()));
                 // now purge also the recently used chunk list from the old track.
-                if (m_mruCachingReaderChunk || m_lruCachingReaderChunk) {
+                if (m_mruCachingReaderChunk || m_lruCachingReaderChunk ||
+                        !m_pinnedChunks.empty()) {
                     DEBUG_ASSERT(atomicLoadRelaxed(m_state) == STATE_TRACK_LOADING);
                     freeAllChunks();
                 }
                 // Reset the readable frame index range
                 m_readableFrameIndexRange = update.readableFrameIndexRange();
+                m_pPreloadedSamples = update.preloadedSamples();
                 m_state.storeRelease(STATE_TRACK_LOADED);
             } else {
                 DEBUG_ASSERT(update.status == TRACK_UNLOADED);
+                m_pPreloadedSamples = nullptr;
                 // This message could be processed later when a new
                 // track is already loading! In this case the TRACK_LOADED will
                 // be the very next status update.
@@ -333,6 +520,10 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
     // the first chunk and to update m_readableFrameIndexRange
     process();
 
+    if (m_pPreloadedSamples) {
+        return readPreloadedSamples(sample, numSamples, reverse, buffer);
+    }
+
     auto remainingFrameIndexRange =
             mixxx::IndexRange::forward(
                     CachingReaderChunk::samples2frames(sample),
@@ -423,6 +614,8 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
                 mixxx::IndexRange bufferedFrameIndexRange;
                 const CachingReaderChunkForOwner* const pChunk = lookupChunkAndFreshen(chunkIndex);
                 if (pChunk && (pChunk->getState() == CachingReaderChunkForOwner::READY)) {
+                    ++m_cacheHits;
+                    mixxx::metrics::cachingReaderHits.increment();
                     if (reverse) {
                         bufferedFrameIndexRange =
                                 pChunk->readBufferedSampleFramesReverse(
@@ -441,6 +634,8 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
                     DEBUG_ASSERT(!pChunk ||
                             (pChunk->getState() == CachingReaderChunkForOwner::READ_PENDING));
                     Counter("CachingReader::read(): Failed to read chunk on cache miss")++;
+                    ++m_cacheMisses;
+                    mixxx::metrics::cachingReaderMisses.increment();
                     if (kLogger.traceEnabled()) {
                         kLogger.trace()
                                 << "Cache miss for chunk with index"
@@ -506,23 +701,106 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
     return result;
 }
 
+CachingReader::ReadResult CachingReader::readPreloadedSamples(
+        SINT sample, SINT numSamples, bool reverse, CSAMPLE* buffer) {
+    DEBUG_ASSERT(m_pPreloadedSamples);
+    const auto frameIndexRange =
+            mixxx::IndexRange::forward(
+                    CachingReaderChunk::samples2frames(sample),
+                    CachingReaderChunk::samples2frames(numSamples));
+    const auto readableFrameIndexRange =
+            intersect(frameIndexRange, m_readableFrameIndexRange);
+    if (readableFrameIndexRange.empty()) {
+        SampleUtil::clear(buffer, numSamples);
+        return ReadResult::PARTIALLY_AVAILABLE;
+    }
+    ++m_cacheHits;
+    mixxx::metrics::cachingReaderHits.increment();
+
+    // The samples before and after the readable range, e.g. in preroll,
+    // are filled with silence
+    SINT leadingSamples = CachingReaderChunk::frames2samples(
+            readableFrameIndexRange.start() - frameIndexRange.start());
+    SINT trailingSamples = CachingReaderChunk::frames2samples(
+            frameIndexRange.end() - readableFrameIndexRange.end());
+    const SINT readableSamples =
+            CachingReaderChunk::frames2samples(readableFrameIndexRange.length());
+    const CSAMPLE* pSrc = m_pPreloadedSamples +
+            CachingReaderChunk::frames2samples(
+                    readableFrameIndexRange.start() - m_readableFrameIndexRange.start());
+    if (reverse) {
+        std::swap(leadingSamples, trailingSamples);
+        SampleUtil::copyReverse(&buffer[leadingSamples], pSrc, readableSamples);
+    } else {
+        SampleUtil::copy(&buffer[leadingSamples], pSrc, readableSamples);
+    }
+    if (leadingSamples > 0) {
+        SampleUtil::clear(buffer, leadingSamples);
+    }
+    if (trailingSamples > 0) {
+        SampleUtil::clear(&buffer[leadingSamples + readableSamples], trailingSamples);
+    }
+    return (readableSamples == numSamples)
+            ? ReadResult::AVAILABLE
+            : ReadResult::PARTIALLY_AVAILABLE;
+}
+
+bool CachingReader::isFrameRangeCached(SINT frame, SINT frameCount) {
+    if (atomicLoadRelaxed(m_state) != STATE_TRACK_LOADED || m_pPreloadedSamples) {
+        return true;
+    }
+    const auto readableFrameIndexRange = intersect(
+            m_readableFrameIndexRange,
+            mixxx::IndexRange::forward(frame, frameCount));
+    if (readableFrameIndexRange.empty()) {
+        return true;
+    }
+    const int firstChunkIndex =
+            CachingReaderChunk::indexForFrame(readableFrameIndexRange.start());
+    const int lastChunkIndex =
+            CachingReaderChunk::indexForFrame(readableFrameIndexRange.end() - 1);
+    for (int chunkIndex = firstChunkIndex; chunkIndex <= lastChunkIndex; ++chunkIndex) {
+        const CachingReaderChunkForOwner* pChunk = lookupChunk(chunkIndex);
+        if (!pChunk || pChunk->getState() != CachingReaderChunkForOwner::READY) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
     // If no file is loaded, skip.
     if (atomicLoadRelaxed(m_state) != STATE_TRACK_LOADED) {
         return;
     }
 
+    // Preloaded tracks are available completely without reading any chunks
+    if (m_pPreloadedSamples) {
+        updateCacheStatistics();
+        return;
+    }
+
     // For every chunk that the hints indicated, check if it is in the cache. If
     // any are not, then wake.
     bool shouldWake = false;
 
+    // All pinned chunks that are not hinted again are unpinned afterwards.
+    // The generation 0 is reserved for unpinned chunks.
+    if (++m_pinGeneration == 0) {
+        ++m_pinGeneration;
+    }
+
     for (const auto& hint: hintList) {
         SINT hintFrame = hint.frame;
         SINT hintFrameCount = hint.frameCount;
+        const bool pinHint = m_pinCueChunks && isPinnableHint(hint.type);
 
         // Handle some special length values
         if (hintFrameCount == Hint::kFrameCountForward) {
-        	hintFrameCount = kDefaultHintFrames;
+            // Prefetch a whole chunk after a cue to bridge the time until
+            // the chunks following the new play position have been read
+            // after a jump.
+            hintFrameCount = pinHint ? CachingReaderChunk::kFrames : kDefaultHintFrames;
         } else if (hintFrameCount == Hint::kFrameCountBackward) {
         	hintFrame -= kDefaultHintFrames;
         	hintFrameCount = kDefaultHintFrames;
@@ -579,15 +857,40 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
                     freeChunk(pChunk);
                 }
             } else if (pChunk->getState() == CachingReaderChunkForOwner::READY) {
-                // This will cause the chunk to be 'freshened' in the cache. The
-                // chunk will be moved to the end of the LRU list.
-                freshenChunk(pChunk);
+                if (!pinHint || !pinChunk(pChunk)) {
+                    // This will cause the chunk to be 'freshened' in the cache. The
+                    // chunk will be moved to the end of the LRU list.
+                    freshenChunk(pChunk);
+                }
             }
         }
     }
 
+    unpinStaleChunks();
+
     // If there are chunks to be read, wake up.
     if (shouldWake) {
         m_worker.workReady();
     }
+
+    updateCacheStatistics();
+}
+
+void CachingReader::updateCacheStatistics() {
+    // Only touch the controls on changes to avoid needless
+    // notifications of all listeners
+    if (m_pCacheHits->get() != m_cacheHits) {
+        m_pCacheHits->forceSet(m_cacheHits);
+    }
+    if (m_pCacheMisses->get() != m_cacheMisses) {
+        m_pCacheMisses->forceSet(m_cacheMisses);
+    }
+    const int sharedCacheHits = m_worker.sharedCacheHits();
+    if (m_pSharedCacheHits->get() != sharedCacheHits) {
+        m_pSharedCacheHits->forceSet(sharedCacheHits);
+    }
+    const int diskCacheHits = m_worker.diskCacheHits();
+    if (m_pDiskCacheHits->get() != diskCacheHits) {
+        m_pDiskCacheHits->forceSet(diskCacheHits);
+    }
 }
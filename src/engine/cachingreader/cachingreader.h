@@ -1,12 +1,14 @@
 #pragma once
 
 #include <QAtomicInt>
-#include <QHash>
 #include <QList>
 #include <QVarLengthArray>
 #include <QVector>
 #include <list>
+#include <memory>
+#include <vector>
 
+#include "engine/cachingreader/cachingreaderchunkindex.h"
 #include "engine/cachingreader/cachingreaderworker.h"
 #include "engine/engineworker.h"
 #include "preferences/usersettings.h"
@@ -60,6 +62,10 @@ typedef struct Hint {
 //    replace it without realizing.
 typedef QVarLengthArray<Hint, 512> HintVector;
 
+class CachingReaderDiskCache;
+class CachingReaderSharedCache;
+class ControlObject;
+
 // CachingReader provides a layer on top of a SoundSource for reading samples
 // from a file. Since we cannot do file I/O in the audio callback thread
 // CachingReader and CachingReaderWorker (a worker thread) work in concert to
@@ -77,13 +83,30 @@ typedef QVarLengthArray<Hint, 512> HintVector;
 // least-recently-used list. When a chunk needs to be allocated and there are no
 // free chunks then the least recently used chunk is free'd (see
 // allocateChunkExpireLRU).
+//
+// Optionally the chunks around the cue and loop positions that are hinted
+// are pinned, i.e. removed from the MRU/LRU list until they are no longer
+// hinted. This ensures that jumps to those positions don't cause cache
+// misses even if the reader has been busy with reading other chunks.
+//
+// The number of chunks per reader is read from the configuration when the
+// reader is created. An optional CachingReaderSharedCache provides a second,
+// larger tier of decoded chunks that is shared between the workers of all
+// readers. An optional CachingReaderDiskCache persists decoded chunks in
+// memory-mapped files.
+//
+// Short tracks and the tracks of samplers are decoded completely into memory
+// by the worker while loading them if they don't exceed the configured
+// duration. The engine then reads them directly, bypassing the chunks.
 class CachingReader : public QObject {
     Q_OBJECT
 
   public:
     // Construct a CachingReader with the given group.
     CachingReader(const QString& group,
-            UserSettingsPointer _config);
+            UserSettingsPointer _config,
+            CachingReaderSharedCache* pSharedCache = nullptr,
+            CachingReaderDiskCache* pDiskCache = nullptr);
     ~CachingReader() override;
 
     void process();
@@ -109,6 +132,12 @@ class CachingReader : public QObject {
     // from the engine callback.
     void hintAndMaybeWake(const HintVector& hintList);
 
+    // True if the frames can be read without a cache miss, i.e. all chunks
+    // covering them have been read. Also true if no track is loaded, because
+    // there is nothing to wait for then. Must only be called from the engine
+    // callback.
+    bool isFrameRangeCached(SINT frame, SINT frameCount);
+
     // Request that the CachingReader load a new track. These requests are
     // processed in the work thread, so the reader must be woken up via wake()
     // for this to take effect.
@@ -118,15 +147,37 @@ class CachingReader : public QObject {
         m_worker.setScheduler(pScheduler);
     }
 
+    // True if no track is being loaded and all chunks that have been
+    // requested so far have been read, e.g. to wait for the reader when
+    // rendering offline. Must only be called from the engine thread.
+    bool isIdle() const {
+        return m_chunkReadRequestFIFO.readAvailable() == 0 && m_worker.isIdle();
+    }
+
+    // Prioritizes the reads of a deck that is playing or loading a track.
+    // Must only be called from the engine callback.
+    void setUrgent(bool urgent) {
+        m_worker.setUrgent(urgent);
+    }
+
   signals:
     // Emitted once a new track is loaded and ready to be read from.
     void trackLoading();
     void trackLoaded(TrackPointer pTrack, int iSampleRate, int iNumSamples);
     void trackLoadFailed(TrackPointer pTrack, const QString& reason);
+    // Emitted from the worker thread with a loudness estimate of the chunks
+    // that have been read so far, for tracks without ReplayGain.
+    void provisionalReplayGainChanged(TrackPointer pTrack, double ratio);
+
+    // The number of chunks per reader that are configured by the user
+    static SINT configuredNumberOfCachedChunks(
+            const UserSettingsPointer& pConfig);
 
   private:
     const UserSettingsPointer m_pConfig;
 
+    const SINT m_numberOfCachedChunks;
+
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
     FIFO<CachingReaderChunkReadRequest> m_chunkReadRequestFIFO;
@@ -151,6 +202,19 @@ class CachingReader : public QObject {
     // Returns all allocated chunks to the free list
     void freeAllChunks();
 
+    // Reads from the samples of a preloaded track, starting with the first
+    // sample in forward direction independent of reverse.
+    ReadResult readPreloadedSamples(SINT sample, SINT numSamples, bool reverse, CSAMPLE* buffer);
+
+    // Removes the chunk from the MRU/LRU list until it is no longer hinted.
+    // Returns false if the maximum number of pinned chunks has been exceeded.
+    bool pinChunk(CachingReaderChunkForOwner* pChunk);
+    void unpinChunk(CachingReaderChunkForOwner* pChunk);
+
+    // Unpins all chunks that have not been hinted again with
+    // the current pin generation
+    void unpinStaleChunks();
+
     // Gets a chunk from the free list. Returns nullptr if none available.
     CachingReaderChunkForOwner* allocateChunk(SINT chunkIndex);
 
@@ -174,17 +238,39 @@ class CachingReader : public QObject {
 
     // Keeps track of what CachingReaderChunks we've allocated and indexes them based on what
     // chunk number they are allocated to.
-    QHash<int, CachingReaderChunkForOwner*> m_allocatedCachingReaderChunks;
+    CachingReaderChunkIndex m_allocatedCachingReaderChunks;
 
     // The linked list of recently-used chunks.
     CachingReaderChunkForOwner* m_mruCachingReaderChunk;
     CachingReaderChunkForOwner* m_lruCachingReaderChunk;
 
+    // Chunks that are not referenced by the MRU/LRU list.
+    // Preallocated with a capacity of m_maxPinnedChunks.
+    const bool m_pinCueChunks;
+    const SINT m_maxPinnedChunks;
+    std::vector<CachingReaderChunkForOwner*> m_pinnedChunks;
+    unsigned int m_pinGeneration;
+
     // The raw memory buffer which is divided up into chunks.
     mixxx::SampleBuffer m_sampleBuffer;
 
     // The readable frame index range as reported by the worker.
     mixxx::IndexRange m_readableFrameIndexRange;
 
+    // All samples of m_readableFrameIndexRange if the track has been
+    // decoded completely when loading, owned by the worker. No chunks
+    // are read for preloaded tracks.
+    const CSAMPLE* m_pPreloadedSamples;
+
     CachingReaderWorker m_worker;
+
+    // Publishes the cache statistics to the corresponding controls
+    void updateCacheStatistics();
+
+    int m_cacheHits;
+    int m_cacheMisses;
+    std::unique_ptr<ControlObject> m_pCacheHits;
+    std::unique_ptr<ControlObject> m_pCacheMisses;
+    std::unique_ptr<ControlObject> m_pSharedCacheHits;
+    std::unique_ptr<ControlObject> m_pDiskCacheHits;
 };
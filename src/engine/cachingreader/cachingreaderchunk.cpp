@@ -79,6 +79,38 @@ mixxx::IndexRange CachingReaderChunk::bufferSampleFrames(
     return m_bufferedSampleFrames.frameIndexRange();
 }
 
+mixxx::IndexRange CachingReaderChunk::copySampleFrames(
+        const mixxx::IndexRange& frameIndexRange,
+        const CSAMPLE* pSamples) {
+    DEBUG_ASSERT(m_index != kInvalidChunkIndex);
+    const SINT sampleCount = frames2samples(frameIndexRange.length());
+    VERIFY_OR_DEBUG_ASSERT(sampleCount <= m_sampleBuffer.length()) {
+        m_bufferedSampleFrames = mixxx::ReadableSampleFrames();
+        return mixxx::IndexRange();
+    }
+    SampleUtil::copy(m_sampleBuffer.data(), pSamples, sampleCount);
+    m_bufferedSampleFrames = mixxx::ReadableSampleFrames(
+            frameIndexRange,
+            mixxx::SampleBuffer::ReadableSlice(m_sampleBuffer.data(), sampleCount));
+    return m_bufferedSampleFrames.frameIndexRange();
+}
+
+mixxx::IndexRange CachingReaderChunk::copySampleFrames(
+        const mixxx::IndexRange& frameIndexRange,
+        const SAMPLE* pSamples) {
+    DEBUG_ASSERT(m_index != kInvalidChunkIndex);
+    const SINT sampleCount = frames2samples(frameIndexRange.length());
+    VERIFY_OR_DEBUG_ASSERT(sampleCount <= m_sampleBuffer.length()) {
+        m_bufferedSampleFrames = mixxx::ReadableSampleFrames();
+        return mixxx::IndexRange();
+    }
+    SampleUtil::convertS16ToFloat32(m_sampleBuffer.data(), pSamples, sampleCount);
+    m_bufferedSampleFrames = mixxx::ReadableSampleFrames(
+            frameIndexRange,
+            mixxx::SampleBuffer::ReadableSlice(m_sampleBuffer.data(), sampleCount));
+    return m_bufferedSampleFrames.frameIndexRange();
+}
+
 mixxx::IndexRange CachingReaderChunk::readBufferedSampleFrames(
         CSAMPLE* sampleBuffer,
         const mixxx::IndexRange& frameIndexRange) const {
@@ -123,6 +155,7 @@ CachingReaderChunkForOwner::CachingReaderChunkForOwner(
         mixxx::SampleBuffer::WritableSlice sampleBuffer)
         : CachingReaderChunk(std::move(sampleBuffer)),
           m_state(FREE),
+          m_pinGeneration(0),
           m_pPrev(nullptr),
           m_pNext(nullptr) {
 }
@@ -136,6 +169,7 @@ void CachingReaderChunkForOwner::init(SINT index) {
 
     CachingReaderChunk::init(index);
     m_state = READY;
+    m_pinGeneration = 0;
 }
 
 void CachingReaderChunkForOwner::free() {
@@ -147,6 +181,7 @@ void CachingReaderChunkForOwner::free() {
 
     CachingReaderChunk::init(kInvalidChunkIndex);
     m_state = FREE;
+    m_pinGeneration = 0;
 }
 
 void CachingReaderChunkForOwner::insertIntoListBefore(
@@ -56,6 +56,23 @@ public:
             const mixxx::AudioSourcePointer& pAudioSource,
             mixxx::SampleBuffer::WritableSlice tempOutputBuffer);
 
+    // Fill the chunk with a copy of sample frames that have been decoded
+    // before, e.g. by another reader, instead of reading them from the
+    // audio source. Returns the range of frames that have been copied.
+    mixxx::IndexRange copySampleFrames(
+            const mixxx::IndexRange& frameIndexRange,
+            const CSAMPLE* pSamples);
+    // Same as above for samples that are stored as 16-bit integers,
+    // e.g. by a compact cache.
+    mixxx::IndexRange copySampleFrames(
+            const mixxx::IndexRange& frameIndexRange,
+            const SAMPLE* pSamples);
+
+    // The sample frames that have been buffered by the worker thread
+    const mixxx::ReadableSampleFrames& bufferedSampleFrames() const {
+        return m_bufferedSampleFrames;
+    }
+
     mixxx::IndexRange readBufferedSampleFrames(
             CSAMPLE* sampleBuffer,
             const mixxx::IndexRange& frameIndexRange) const;
@@ -105,6 +122,24 @@ public:
         return m_state;
     }
 
+    // Pinned chunks are not referenced in the MRU/LRU list and will
+    // never be expired. The pin generation identifies the last round
+    // of hints that requested to keep the chunk pinned. A chunk is
+    // unpinned if the generation is 0.
+    bool isPinned() const {
+        return m_pinGeneration != 0;
+    }
+    unsigned int getPinGeneration() const {
+        return m_pinGeneration;
+    }
+    void setPinGeneration(unsigned int pinGeneration) {
+        // Must not be referenced in MRU/LRU list!
+        DEBUG_ASSERT(!m_pPrev);
+        DEBUG_ASSERT(!m_pNext);
+        DEBUG_ASSERT(m_state == READY);
+        m_pinGeneration = pinGeneration;
+    }
+
     // The state is controlled by the cache as the owner of each chunk!
     void giveToWorker() {
         // Must not be referenced in MRU/LRU list!
@@ -137,6 +172,7 @@ public:
 
 private:
     State m_state;
+    unsigned int m_pinGeneration;
 
     CachingReaderChunkForOwner* m_pPrev; // previous item in double-linked list
     CachingReaderChunkForOwner* m_pNext; // next item in double-linked list
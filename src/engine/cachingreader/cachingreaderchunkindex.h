@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "util/assert.h"
+#include "util/math.h"
+#include "util/types.h"
+
+class CachingReaderChunkForOwner;
+
+// A fixed capacity index that maps chunk indices to the chunks that are
+// currently allocated by the CachingReader.
+//
+// All memory is allocated upfront during construction. Lookups, insertions
+// and removals never allocate and are safe to be used from the engine thread.
+// This is an open-addressing hash table with linear probing. Entries are
+// removed by backward shifting the following entries of the same cluster,
+// i.e. there are no tombstones and lookups never degrade over time.
+//
+// The class is not thread-safe. It is only accessed by the CachingReader
+// as the owner of all chunks.
+class CachingReaderChunkIndex final {
+  public:
+    explicit CachingReaderChunkIndex(SINT maxSize)
+            : m_maxSize(maxSize),
+              // Keep the load factor <= 0.5 to keep the probe sequences short
+              m_mask(static_cast<SINT>(roundUpToPowerOf2(
+                             static_cast<unsigned int>(math_max(maxSize, SINT(1)) * 2))) -
+                      1),
+              m_size(0),
+              m_slots(m_mask + 1) {
+        DEBUG_ASSERT(m_maxSize >= 0);
+    }
+
+    SINT size() const {
+        return m_size;
+    }
+    SINT maxSize() const {
+        return m_maxSize;
+    }
+
+    // Returns nullptr if no chunk has been inserted for this index
+    CachingReaderChunkForOwner* find(SINT chunkIndex) const {
+        DEBUG_ASSERT(chunkIndex != kEmptyKey);
+        for (SINT pos = slotForKey(chunkIndex);; pos = nextSlot(pos)) {
+            const Slot& slot = m_slots[pos];
+            if (slot.chunkIndex == chunkIndex) {
+                return slot.pChunk;
+            }
+            if (slot.chunkIndex == kEmptyKey) {
+                return nullptr;
+            }
+        }
+    }
+
+    // Inserts or replaces the chunk for the given index. Returns false
+    // if the maximum size has been exceeded.
+    bool insert(SINT chunkIndex, CachingReaderChunkForOwner* pChunk) {
+        DEBUG_ASSERT(chunkIndex != kEmptyKey);
+        DEBUG_ASSERT(pChunk);
+        SINT pos = slotForKey(chunkIndex);
+        for (; m_slots[pos].chunkIndex != kEmptyKey; pos = nextSlot(pos)) {
+            if (m_slots[pos].chunkIndex == chunkIndex) {
+                m_slots[pos].pChunk = pChunk;
+                return true;
+            }
+        }
+        VERIFY_OR_DEBUG_ASSERT(m_size < m_maxSize) {
+            return false;
+        }
+        m_slots[pos].chunkIndex = chunkIndex;
+        m_slots[pos].pChunk = pChunk;
+        ++m_size;
+        return true;
+    }
+
+    // Returns the number of removed entries, i.e. either 0 or 1
+    int remove(SINT chunkIndex) {
+        DEBUG_ASSERT(chunkIndex != kEmptyKey);
+        SINT pos = slotForKey(chunkIndex);
+        while (m_slots[pos].chunkIndex != chunkIndex) {
+            if (m_slots[pos].chunkIndex == kEmptyKey) {
+                return 0;
+            }
+            pos = nextSlot(pos);
+        }
+        // Backward shift deletion: Move all subsequent entries of the
+        // cluster that would not be found anymore into the hole.
+        SINT hole = pos;
+        for (SINT next = nextSlot(hole); m_slots[next].chunkIndex != kEmptyKey;
+                next = nextSlot(next)) {
+            const SINT home = slotForKey(m_slots[next].chunkIndex);
+            // Distance of the hole and the next entry from the home
+            // slot of the next entry, modulo the capacity
+            const SINT holeDist = (hole - home) & m_mask;
+            const SINT nextDist = (next - home) & m_mask;
+            if (holeDist < nextDist) {
+                m_slots[hole] = m_slots[next];
+                hole = next;
+            }
+        }
+        m_slots[hole] = Slot();
+        --m_size;
+        return 1;
+    }
+
+    void clear() {
+        if (m_size == 0) {
+            return;
+        }
+        for (auto& slot : m_slots) {
+            slot = Slot();
+        }
+        m_size = 0;
+    }
+
+  private:
+    static constexpr SINT kEmptyKey = -1;
+
+    struct Slot {
+        SINT chunkIndex = kEmptyKey;
+        CachingReaderChunkForOwner* pChunk = nullptr;
+    };
+
+    SINT slotForKey(SINT chunkIndex) const {
+        // Fibonacci hashing spreads the mostly consecutive chunk
+        // indices around a track position across the table
+        return static_cast<SINT>(
+                       (static_cast<std::uint64_t>(chunkIndex) * 11400714819323198485ull) >> 32) &
+                m_mask;
+    }
+    SINT nextSlot(SINT pos) const {
+        return (pos + 1) & m_mask;
+    }
+
+    const SINT m_maxSize;
+    const SINT m_mask;
+    SINT m_size;
+    std::vector<Slot> m_slots;
+};
@@ -0,0 +1,306 @@
+#include "engine/cachingreader/cachingreaderdiskcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QtConcurrentRun>
+#include <algorithm>
+#include <cstring>
+
+#include "track/track.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/sample.h"
+
+namespace {
+
+const mixxx::Logger kLogger("CachingReaderDiskCache");
+
+const QString kFolderName = QStringLiteral("pcmcache");
+const QString kFileSuffix = QStringLiteral(".pcm");
+
+constexpr char kMagic[8] = {'M', 'X', 'X', 'X', 'P', 'C', 'M', '1'};
+
+constexpr qint64 kBytesPerMB = 1024 * 1024;
+
+// Sample data starts at a page boundary
+constexpr qint64 kDataAlignment = 4096;
+
+struct FileHeader {
+    char magic[8];
+    qint32 channelCount;
+    qint32 sampleRate;
+    qint32 chunkFrames;
+    qint32 chunkCount;
+    qint64 frameIndexMin;
+    qint64 frameIndexMax;
+};
+
+qint64 alignedDataOffset(SINT chunkCount, qint64 chunkEntrySize) {
+    const qint64 tableEnd =
+            static_cast<qint64>(sizeof(FileHeader)) + chunkCount * chunkEntrySize;
+    return ((tableEnd + kDataAlignment - 1) / kDataAlignment) * kDataAlignment;
+}
+
+QString cacheFileName(
+        const TrackPointer& pTrack) {
+    const auto fileInfo = pTrack->getFileInfo();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(fileInfo.location().toUtf8());
+    hash.addData(QByteArray::number(fileInfo.sizeInBytes()));
+    hash.addData(QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()));
+    const TrackId trackId = pTrack->getId();
+    return (trackId.isValid() ? trackId.toString() : QStringLiteral("0")) +
+            QChar('_') +
+            QString::fromLatin1(hash.result().toHex().left(16)) +
+            kFileSuffix;
+}
+
+} // anonymous namespace
+
+// Frame index range of the samples that have been stored for a chunk.
+// Both values are equal for chunks that have not been stored yet.
+struct CachingReaderDiskCacheFile::ChunkEntry {
+    qint64 frameIndexStart;
+    qint64 frameIndexEnd;
+};
+
+CachingReaderDiskCacheFile::CachingReaderDiskCacheFile(
+        CachingReaderDiskCache* pOwner,
+        const QString& filePath)
+        : m_pOwner(pOwner),
+          m_file(filePath),
+          m_pMapped(nullptr),
+          m_frameIndexMin(0),
+          m_chunkCount(0),
+          m_dataOffset(0) {
+}
+
+CachingReaderDiskCacheFile::~CachingReaderDiskCacheFile() {
+    if (m_pMapped) {
+        m_file.unmap(m_pMapped);
+    }
+    m_file.close();
+    m_pOwner->closeFile(m_file.fileName());
+}
+
+bool CachingReaderDiskCacheFile::open(
+        const mixxx::AudioSourcePointer& pAudioSource) {
+    const auto frameIndexRange = pAudioSource->frameIndexRange();
+    DEBUG_ASSERT(!frameIndexRange.empty());
+    m_frameIndexMin = frameIndexRange.start();
+    m_chunkCount = CachingReaderChunk::indexForFrame(frameIndexRange.length() - 1) + 1;
+    m_dataOffset = alignedDataOffset(m_chunkCount, sizeof(ChunkEntry));
+    const qint64 fileSize = m_dataOffset +
+            m_chunkCount * CachingReaderChunk::kSamples *
+                    static_cast<qint64>(sizeof(CSAMPLE));
+
+    FileHeader expectedHeader;
+    std::memcpy(expectedHeader.magic, kMagic, sizeof(kMagic));
+    expectedHeader.channelCount = CachingReaderChunk::kChannels;
+    expectedHeader.sampleRate = pAudioSource->getSignalInfo().getSampleRate();
+    expectedHeader.chunkFrames = static_cast<qint32>(CachingReaderChunk::kFrames);
+    expectedHeader.chunkCount = static_cast<qint32>(m_chunkCount);
+    expectedHeader.frameIndexMin = frameIndexRange.start();
+    expectedHeader.frameIndexMax = frameIndexRange.end();
+
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        kLogger.warning()
+                << "Failed to open cache file"
+                << m_file.fileName()
+                << m_file.errorString();
+        return false;
+    }
+    bool reuseContents = false;
+    if (m_file.size() == fileSize) {
+        FileHeader header;
+        reuseContents = m_file.read(reinterpret_cast<char*>(&header), sizeof(header)) ==
+                        static_cast<qint64>(sizeof(header)) &&
+                std::memcmp(&header, &expectedHeader, sizeof(header)) == 0;
+    }
+    if (!reuseContents) {
+        // Discard outdated or corrupt contents. Resizing creates a sparse
+        // file on most file systems that is filled with zeros, i.e. all
+        // chunk entries are initially empty.
+        if (!m_file.resize(0) ||
+                !m_file.resize(fileSize) ||
+                !m_file.seek(0) ||
+                m_file.write(reinterpret_cast<const char*>(&expectedHeader),
+                        sizeof(expectedHeader)) !=
+                        static_cast<qint64>(sizeof(expectedHeader))) {
+            kLogger.warning()
+                    << "Failed to initialize cache file"
+                    << m_file.fileName()
+                    << m_file.errorString();
+            return false;
+        }
+        m_file.flush();
+    }
+    m_pMapped = m_file.map(0, fileSize);
+    if (!m_pMapped) {
+        kLogger.warning()
+                << "Failed to map cache file"
+                << m_file.fileName()
+                << m_file.errorString();
+        return false;
+    }
+    // Update the modification time for the LRU eviction
+    m_file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    return true;
+}
+
+CachingReaderDiskCacheFile::ChunkEntry* CachingReaderDiskCacheFile::chunkEntry(
+        SINT chunkIndex) const {
+    DEBUG_ASSERT(m_pMapped);
+    DEBUG_ASSERT(chunkIndex >= 0);
+    DEBUG_ASSERT(chunkIndex < m_chunkCount);
+    return reinterpret_cast<ChunkEntry*>(
+                   m_pMapped + sizeof(FileHeader)) +
+            chunkIndex;
+}
+
+CSAMPLE* CachingReaderDiskCacheFile::chunkSamples(SINT chunkIndex) const {
+    DEBUG_ASSERT(m_pMapped);
+    DEBUG_ASSERT(chunkIndex >= 0);
+    DEBUG_ASSERT(chunkIndex < m_chunkCount);
+    return reinterpret_cast<CSAMPLE*>(m_pMapped + m_dataOffset) +
+            chunkIndex * CachingReaderChunk::kSamples;
+}
+
+mixxx::IndexRange CachingReaderDiskCacheFile::restoreChunk(
+        CachingReaderChunk* pChunk) const {
+    DEBUG_ASSERT(pChunk);
+    const SINT chunkIndex = pChunk->getIndex();
+    if (chunkIndex < 0 || chunkIndex >= m_chunkCount) {
+        return mixxx::IndexRange();
+    }
+    const ChunkEntry* pEntry = chunkEntry(chunkIndex);
+    const auto frameIndexRange = mixxx::IndexRange::between(
+            static_cast<SINT>(pEntry->frameIndexStart),
+            static_cast<SINT>(pEntry->frameIndexEnd));
+    if (frameIndexRange.empty() ||
+            frameIndexRange.length() > CachingReaderChunk::kFrames) {
+        return mixxx::IndexRange();
+    }
+    return pChunk->copySampleFrames(frameIndexRange, chunkSamples(chunkIndex));
+}
+
+void CachingReaderDiskCacheFile::storeChunk(const CachingReaderChunk& chunk) {
+    const SINT chunkIndex = chunk.getIndex();
+    const auto& sampleFrames = chunk.bufferedSampleFrames();
+    if (chunkIndex < 0 ||
+            chunkIndex >= m_chunkCount ||
+            sampleFrames.frameIndexRange().empty()) {
+        return;
+    }
+    const SINT sampleCount = CachingReaderChunk::frames2samples(
+            sampleFrames.frameIndexRange().length());
+    VERIFY_OR_DEBUG_ASSERT(sampleCount <= CachingReaderChunk::kSamples &&
+            sampleCount <= sampleFrames.readableLength()) {
+        return;
+    }
+    // Write the samples before publishing the frame index range
+    SampleUtil::copy(chunkSamples(chunkIndex), sampleFrames.readableData(), sampleCount);
+    ChunkEntry* pEntry = chunkEntry(chunkIndex);
+    pEntry->frameIndexStart = sampleFrames.frameIndexRange().start();
+    pEntry->frameIndexEnd = sampleFrames.frameIndexRange().end();
+}
+
+// static
+const ConfigKey CachingReaderDiskCache::kMaxSizeMBConfigKey =
+        ConfigKey(QStringLiteral("[Master]"), QStringLiteral("decoded_audio_cache_mb"));
+
+CachingReaderDiskCache::CachingReaderDiskCache(UserSettingsPointer pConfig)
+        : m_pConfig(pConfig),
+          m_dir(pConfig->getSettingsPath() + QChar('/') + kFolderName) {
+}
+
+CachingReaderDiskCache::~CachingReaderDiskCache() {
+    m_evictionFuture.waitForFinished();
+}
+
+qint64 CachingReaderDiskCache::maxSizeInBytes() const {
+    return m_pConfig->getValue<int>(kMaxSizeMBConfigKey, 0) * kBytesPerMB;
+}
+
+std::unique_ptr<CachingReaderDiskCacheFile> CachingReaderDiskCache::openFile(
+        const TrackPointer& pTrack,
+        const mixxx::AudioSourcePointer& pAudioSource) {
+    if (!pTrack || !pAudioSource || maxSizeInBytes() <= 0) {
+        return nullptr;
+    }
+    if (!m_dir.exists() && !QDir().mkpath(m_dir.absolutePath())) {
+        kLogger.warning()
+                << "Failed to create cache folder"
+                << m_dir.absolutePath();
+        return nullptr;
+    }
+    const QString filePath = m_dir.absoluteFilePath(cacheFileName(pTrack));
+    {
+        const auto locker = lockMutex(&m_openFilesMutex);
+        if (m_openFiles.contains(filePath)) {
+            // The same track is loaded into another deck and the file
+            // is exclusively owned by the corresponding worker.
+            return nullptr;
+        }
+        m_openFiles.insert(filePath);
+    }
+    // The constructor is private and not accessible for std::make_unique
+    auto pFile = std::unique_ptr<CachingReaderDiskCacheFile>(
+            new CachingReaderDiskCacheFile(this, filePath));
+    if (!pFile->open(pAudioSource)) {
+        pFile.reset();
+        QFile::remove(filePath);
+        return nullptr;
+    }
+    scheduleEviction();
+    return pFile;
+}
+
+void CachingReaderDiskCache::closeFile(const QString& filePath) {
+    const auto locker = lockMutex(&m_openFilesMutex);
+    m_openFiles.remove(filePath);
+}
+
+void CachingReaderDiskCache::scheduleEviction() {
+    if (!m_evictionPending.testAndSetAcquire(0, 1)) {
+        return;
+    }
+    const auto locker = lockMutex(&m_openFilesMutex);
+    m_evictionFuture = QtConcurrent::run([this] {
+        evictFiles();
+        m_evictionPending.storeRelease(0);
+    });
+}
+
+void CachingReaderDiskCache::evictFiles() {
+    const qint64 maxSize = maxSizeInBytes();
+    // Least recently used files last
+    QFileInfoList fileInfos = m_dir.entryInfoList(
+            QStringList{QChar('*') + kFileSuffix},
+            QDir::Files,
+            QDir::Time);
+    qint64 totalSize = 0;
+    for (const auto& fileInfo : qAsConst(fileInfos)) {
+        totalSize += fileInfo.size();
+    }
+    while (totalSize > maxSize && !fileInfos.isEmpty()) {
+        const QFileInfo fileInfo = fileInfos.takeLast();
+        {
+            const auto locker = lockMutex(&m_openFilesMutex);
+            if (m_openFiles.contains(fileInfo.absoluteFilePath())) {
+                continue;
+            }
+        }
+        if (QFile::remove(fileInfo.absoluteFilePath())) {
+            kLogger.debug()
+                    << "Evicted cache file"
+                    << fileInfo.absoluteFilePath();
+            totalSize -= fileInfo.size();
+        } else {
+            kLogger.warning()
+                    << "Failed to evict cache file"
+                    << fileInfo.absoluteFilePath();
+        }
+    }
+}
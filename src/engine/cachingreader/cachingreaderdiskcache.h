@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QDir>
+#include <QFile>
+#include <QFuture>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <memory>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+#include "preferences/usersettings.h"
+#include "track/track_decl.h"
+
+class CachingReaderDiskCache;
+
+// A memory-mapped file with the decoded sample data of a single track.
+//
+// The file is created with the full size of all decoded samples. Chunks
+// are stored lazily when they have been decoded for the first time and
+// are restored by simply copying them from the mapped memory, i.e. reading
+// them from the file system cache instead of invoking the decoder.
+//
+// Each instance is exclusively owned by a single CachingReaderWorker.
+class CachingReaderDiskCacheFile final {
+  public:
+    ~CachingReaderDiskCacheFile();
+
+    // Fills the chunk with the sample frames from the file. Returns the
+    // restored frame index range or an empty range if the chunk has not
+    // been stored yet.
+    mixxx::IndexRange restoreChunk(CachingReaderChunk* pChunk) const;
+
+    // Stores a copy of the sample frames that have been buffered by the
+    // chunk.
+    void storeChunk(const CachingReaderChunk& chunk);
+
+  private:
+    friend class CachingReaderDiskCache;
+
+    struct ChunkEntry;
+
+    CachingReaderDiskCacheFile(
+            CachingReaderDiskCache* pOwner,
+            const QString& filePath);
+
+    bool open(const mixxx::AudioSourcePointer& pAudioSource);
+
+    ChunkEntry* chunkEntry(SINT chunkIndex) const;
+    CSAMPLE* chunkSamples(SINT chunkIndex) const;
+
+    CachingReaderDiskCache* const m_pOwner;
+    QFile m_file;
+    uchar* m_pMapped;
+    SINT m_frameIndexMin;
+    SINT m_chunkCount;
+    qint64 m_dataOffset;
+};
+
+// An optional on-disk cache of decoded sample data that sits between
+// the CachingReaderWorkers and the AudioSources. The cache is disabled if
+// the configured size limit is 0.
+//
+// Each track is stored in a separate file in the folder "pcmcache" of the
+// settings directory. Files are identified by the track id and a hash of
+// the file's location, size and modification time, i.e. modified files
+// will never be restored from outdated cache files.
+//
+// If the total size exceeds the configured limit, the least recently used
+// files are deleted on a background thread.
+//
+// All public functions are thread-safe.
+class CachingReaderDiskCache final {
+  public:
+    explicit CachingReaderDiskCache(UserSettingsPointer pConfig);
+    ~CachingReaderDiskCache();
+
+    static const ConfigKey kMaxSizeMBConfigKey;
+
+    // Opens or creates the cache file for the audio source of the track.
+    // Returns nullptr if the cache is disabled or on failure.
+    std::unique_ptr<CachingReaderDiskCacheFile> openFile(
+            const TrackPointer& pTrack,
+            const mixxx::AudioSourcePointer& pAudioSource);
+
+  private:
+    friend class CachingReaderDiskCacheFile;
+
+    qint64 maxSizeInBytes() const;
+
+    void closeFile(const QString& filePath);
+
+    // Starts the eviction on a background thread unless already running
+    void scheduleEviction();
+    void evictFiles();
+
+    const UserSettingsPointer m_pConfig;
+    const QDir m_dir;
+
+    // The paths of all files that are currently in use and must not be
+    // deleted by the eviction.
+    QMutex m_openFilesMutex;
+    QSet<QString> m_openFiles;
+
+    QAtomicInt m_evictionPending;
+    QFuture<void> m_evictionFuture;
+};
@@ -0,0 +1,155 @@
+#include "engine/cachingreader/cachingreadersharedcache.h"
+
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/metrics.h"
+#include "util/sample.h"
+
+namespace {
+
+mixxx::Logger kLogger("CachingReaderSharedCache");
+
+} // anonymous namespace
+
+CachingReaderSharedCache::CachingReaderSharedCache(
+        SINT maxChunks,
+        bool compact)
+        : m_compact(compact),
+          m_sampleBuffer(compact ? 0 : CachingReaderChunk::kSamples * maxChunks),
+          m_compactSampleBuffer(compact ? CachingReaderChunk::kSamples * maxChunks : 0),
+          m_slots(maxChunks) {
+    DEBUG_ASSERT(maxChunks >= 0);
+    m_slotsByKey.reserve(static_cast<int>(maxChunks));
+    m_freeSlots.reserve(maxChunks);
+    // Pop free slots from the back in ascending order
+    for (int i = static_cast<int>(maxChunks) - 1; i >= 0; --i) {
+        m_freeSlots.push_back(i);
+    }
+    mixxx::metrics::cachingReaderBytes.add(sampleBufferBytes());
+    kLogger.debug()
+            << "Allocated"
+            << maxChunks
+            << (m_compact ? "compact shared chunks" : "shared chunks");
+}
+
+CachingReaderSharedCache::~CachingReaderSharedCache() {
+    mixxx::metrics::cachingReaderBytes.add(-sampleBufferBytes());
+}
+
+qint64 CachingReaderSharedCache::sampleBufferBytes() const {
+    return static_cast<qint64>(m_sampleBuffer.size() * sizeof(CSAMPLE) +
+            m_compactSampleBuffer.size() * sizeof(SAMPLE));
+}
+
+mixxx::IndexRange CachingReaderSharedCache::restoreChunk(
+        const QString& trackLocation,
+        CachingReaderChunk* pChunk) {
+    DEBUG_ASSERT(pChunk);
+    if (m_slots.empty() || trackLocation.isEmpty()) {
+        return mixxx::IndexRange();
+    }
+    const auto locker = lockMutex(&m_mutex);
+    const auto it = m_slotsByKey.constFind(ChunkKey(trackLocation, pChunk->getIndex()));
+    if (it == m_slotsByKey.constEnd()) {
+        return mixxx::IndexRange();
+    }
+    Slot& slot = m_slots[it.value()];
+    // Move to the MRU position
+    m_lruSlots.splice(m_lruSlots.begin(), m_lruSlots, slot.lruPos);
+    if (m_compact) {
+        return pChunk->copySampleFrames(
+                slot.frameIndexRange,
+                m_compactSampleBuffer.data() + CachingReaderChunk::kSamples * it.value());
+    }
+    return pChunk->copySampleFrames(
+            slot.frameIndexRange,
+            m_sampleBuffer.data(CachingReaderChunk::kSamples * it.value()));
+}
+
+void CachingReaderSharedCache::storeChunk(
+        const QString& trackLocation,
+        const CachingReaderChunk& chunk) {
+    const auto& sampleFrames = chunk.bufferedSampleFrames();
+    if (m_slots.empty() ||
+            trackLocation.isEmpty() ||
+            sampleFrames.frameIndexRange().empty()) {
+        return;
+    }
+    const SINT sampleCount = CachingReaderChunk::frames2samples(
+            sampleFrames.frameIndexRange().length());
+    VERIFY_OR_DEBUG_ASSERT(sampleCount <= CachingReaderChunk::kSamples &&
+            sampleCount <= sampleFrames.readableLength()) {
+        return;
+    }
+    const auto key = ChunkKey(trackLocation, chunk.getIndex());
+    const auto locker = lockMutex(&m_mutex);
+    int slotIndex;
+    const auto it = m_slotsByKey.constFind(key);
+    if (it != m_slotsByKey.constEnd()) {
+        // Replace the contents of the existing slot
+        slotIndex = it.value();
+        m_lruSlots.splice(m_lruSlots.begin(), m_lruSlots, m_slots[slotIndex].lruPos);
+    } else {
+        if (m_freeSlots.empty()) {
+            // Expire the least recently used chunk
+            DEBUG_ASSERT(!m_lruSlots.empty());
+            slotIndex = m_lruSlots.back();
+            m_lruSlots.pop_back();
+            m_slotsByKey.remove(m_slots[slotIndex].key);
+        } else {
+            slotIndex = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        m_lruSlots.push_front(slotIndex);
+        m_slots[slotIndex].lruPos = m_lruSlots.begin();
+        m_slots[slotIndex].key = key;
+        m_slotsByKey.insert(key, slotIndex);
+    }
+    m_slots[slotIndex].frameIndexRange = sampleFrames.frameIndexRange();
+    if (m_compact) {
+        SampleUtil::convertFloat32ToS16(
+                m_compactSampleBuffer.data() + CachingReaderChunk::kSamples * slotIndex,
+                sampleFrames.readableData(),
+                sampleCount);
+        return;
+    }
+    SampleUtil::copy(
+            m_sampleBuffer.data(CachingReaderChunk::kSamples * slotIndex),
+            sampleFrames.readableData(),
+            sampleCount);
+}
+
+CachingReaderPreloadedSamplesPointer CachingReaderSharedCache::findPreloadedSamples(
+        const QString& trackLocation,
+        mixxx::IndexRange sourceFrameIndexRange) {
+    if (trackLocation.isEmpty()) {
+        return nullptr;
+    }
+    const auto locker = lockMutex(&m_mutex);
+    const auto pPreloadedSamples = m_preloadedSamples.value(trackLocation).lock();
+    if (!pPreloadedSamples ||
+            pPreloadedSamples->sourceFrameIndexRange != sourceFrameIndexRange) {
+        return nullptr;
+    }
+    return pPreloadedSamples;
+}
+
+void CachingReaderSharedCache::addPreloadedSamples(
+        const QString& trackLocation,
+        const CachingReaderPreloadedSamplesPointer& pPreloadedSamples) {
+    DEBUG_ASSERT(pPreloadedSamples);
+    if (trackLocation.isEmpty()) {
+        return;
+    }
+    const auto locker = lockMutex(&m_mutex);
+    // Forget the samples of tracks that are not loaded anymore
+    auto it = m_preloadedSamples.begin();
+    while (it != m_preloadedSamples.end()) {
+        if (it.value().expired()) {
+            it = m_preloadedSamples.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_preloadedSamples.insert(trackLocation, pPreloadedSamples);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+#include "util/samplebuffer.h"
+
+// The decoded samples of a track that has been preloaded completely.
+// They are never modified after preloading and may be shared by all
+// workers that load the same file.
+struct CachingReaderPreloadedSamples {
+    // The frame index range of the audio source they were decoded from
+    mixxx::IndexRange sourceFrameIndexRange;
+    // The decoded frame index range, which is shorter after read errors
+    mixxx::IndexRange frameIndexRange;
+    mixxx::SampleBuffer buffer;
+};
+
+typedef std::shared_ptr<const CachingReaderPreloadedSamples>
+        CachingReaderPreloadedSamplesPointer;
+
+// A second, larger tier of decoded chunks that is shared by the
+// CachingReaderWorkers of all decks.
+//
+// Chunks that have been decoded by any worker are copied into this
+// cache. Before decoding a chunk from the audio source the worker first
+// checks if the same chunk of the same file is still available here,
+// e.g. if the same track is loaded into multiple decks or if a track is
+// reloaded shortly after it has been ejected.
+//
+// The memory for all chunks is allocated upfront during construction.
+// The least recently used chunk is replaced when the cache is full.
+//
+// Tracks that are preloaded completely are not split into chunks. Their
+// samples are shared instead, as long as any worker still holds them,
+// so a cloned sampler or deck does not decode the file again.
+//
+// A compact cache stores the samples as 16-bit integers instead of
+// floats. This halves the memory per chunk at the cost of the precision
+// of sources with a higher bit depth. The samples are converted by the
+// worker threads when storing and restoring chunks.
+//
+// The cache is only accessed by worker threads and never from the engine
+// thread. All operations are thread-safe.
+class CachingReaderSharedCache final {
+  public:
+    explicit CachingReaderSharedCache(
+            SINT maxChunks,
+            bool compact = false);
+    ~CachingReaderSharedCache();
+
+    SINT maxChunks() const {
+        return static_cast<SINT>(m_slots.size());
+    }
+
+    bool isCompact() const {
+        return m_compact;
+    }
+
+    // Fills the chunk with the cached sample frames of the track's
+    // file. Returns the restored frame index range or an empty range
+    // on a cache miss.
+    mixxx::IndexRange restoreChunk(
+            const QString& trackLocation,
+            CachingReaderChunk* pChunk);
+
+    // Stores a copy of the sample frames that have been buffered by
+    // the chunk.
+    void storeChunk(
+            const QString& trackLocation,
+            const CachingReaderChunk& chunk);
+
+    // Returns the preloaded samples of the track's file, if they are still
+    // held by any worker and have been decoded from an audio source with
+    // the same frame index range.
+    CachingReaderPreloadedSamplesPointer findPreloadedSamples(
+            const QString& trackLocation,
+            mixxx::IndexRange sourceFrameIndexRange);
+
+    void addPreloadedSamples(
+            const QString& trackLocation,
+            const CachingReaderPreloadedSamplesPointer& pPreloadedSamples);
+
+  private:
+    typedef QPair<QString, SINT> ChunkKey;
+
+    qint64 sampleBufferBytes() const;
+
+    struct Slot {
+        ChunkKey key;
+        mixxx::IndexRange frameIndexRange;
+        std::list<int>::iterator lruPos;
+    };
+
+    const bool m_compact;
+
+    QMutex m_mutex;
+
+    // Only one of the buffers is allocated
+    mixxx::SampleBuffer m_sampleBuffer;
+    std::vector<SAMPLE> m_compactSampleBuffer;
+
+    std::vector<Slot> m_slots;
+
+    QHash<ChunkKey, int> m_slotsByKey;
+
+    // Indices of all used slots, ordered from the most recently
+    // used (front) to the least recently used (back).
+    std::list<int> m_lruSlots;
+
+    std::vector<int> m_freeSlots;
+
+    QHash<QString, std::weak_ptr<const CachingReaderPreloadedSamples>> m_preloadedSamples;
+};
@@ -3,31 +3,54 @@
 #include <QAtomicInt>
 #include <QFileInfo>
 #include <QtDebug>
+#include <algorithm>
 
+#include "analyzer/analyzerebur128.h"
 #include "control/controlobject.h"
+#include "engine/cachingreader/cachingreaderdiskcache.h"
+#include "engine/cachingreader/cachingreadersharedcache.h"
 #include "moc_cachingreaderworker.cpp"
+#include "sources/audiosourcestereoproxy.h"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
 #include "util/compatibility/qmutex.h"
 #include "util/event.h"
 #include "util/logger.h"
+#include "util/realtimeprofile.h"
 
 namespace {
 
 mixxx::Logger kLogger("CachingReaderWorker");
 
+// The decoded audio that is needed for a first loudness estimate and for
+// each refinement of it
+constexpr double kLoudnessSecondsPerUpdate = 5.0;
+
 } // anonymous namespace
 
 CachingReaderWorker::CachingReaderWorker(
         const QString& group,
         FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
-        FIFO<ReaderStatusUpdate>* pReaderStatusFIFO)
+        FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
+        CachingReaderSharedCache* pSharedCache,
+        CachingReaderDiskCache* pDiskCache,
+        mixxx::Duration preloadMaxDuration,
+        UserSettingsPointer pConfig)
         : m_group(group),
           m_tag(QString("CachingReaderWorker %1").arg(m_group)),
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
-          m_pReaderStatusFIFO(pReaderStatusFIFO) {
+          m_pReaderStatusFIFO(pReaderStatusFIFO),
+          m_pSharedCache(pSharedCache),
+          m_pDiskCache(pDiskCache),
+          m_preloadMaxDuration(preloadMaxDuration),
+          m_pConfig(pConfig),
+          m_loudnessFramesSinceUpdate(0),
+          m_loudnessFramesPerUpdate(0) {
 }
 
+// Required for the forward declaration of CachingReaderDiskCacheFile
+CachingReaderWorker::~CachingReaderWorker() = default;
+
 ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         const CachingReaderChunkReadRequest& request) {
     CachingReaderChunk* pChunk = request.chunk;
@@ -45,6 +68,32 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         return result;
     }
 
+    // Samples that have already been decoded by any reader are copied
+    // from the shared cache
+    if (m_pSharedCache &&
+            m_pSharedCache->restoreChunk(m_trackLocation, pChunk) ==
+                    chunkFrameIndexRange) {
+        m_sharedCacheHits.fetchAndAddRelaxed(1);
+        estimateLoudness(*pChunk);
+        ReaderStatusUpdate result;
+        result.init(CHUNK_READ_SUCCESS, pChunk, m_pAudioSource->frameIndexRange());
+        return result;
+    }
+
+    // Samples that have been decoded before are read from the
+    // memory-mapped file on disk
+    if (m_pDiskCacheFile &&
+            m_pDiskCacheFile->restoreChunk(pChunk) == chunkFrameIndexRange) {
+        m_diskCacheHits.fetchAndAddRelaxed(1);
+        if (m_pSharedCache) {
+            m_pSharedCache->storeChunk(m_trackLocation, *pChunk);
+        }
+        estimateLoudness(*pChunk);
+        ReaderStatusUpdate result;
+        result.init(CHUNK_READ_SUCCESS, pChunk, m_pAudioSource->frameIndexRange());
+        return result;
+    }
+
     // Try to read the data required for the chunk from the audio source
     const mixxx::IndexRange bufferedFrameIndexRange = pChunk->bufferSampleFrames(
             m_pAudioSource,
@@ -66,6 +115,17 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         if (bufferedFrameIndexRange.empty()) {
             status = CHUNK_READ_INVALID; // overwrite EOF (see above)
         }
+    } else {
+        // Only complete chunks are shared with other readers
+        if (m_pSharedCache) {
+            m_pSharedCache->storeChunk(m_trackLocation, *pChunk);
+        }
+        if (m_pDiskCacheFile) {
+            m_pDiskCacheFile->storeChunk(*pChunk);
+        }
+    }
+    if (status == CHUNK_READ_SUCCESS) {
+        estimateLoudness(*pChunk);
     }
 
     ReaderStatusUpdate result;
@@ -73,6 +133,141 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
     return result;
 }
 
+CachingReaderPreloadedSamplesPointer CachingReaderWorker::preloadTrack() {
+    DEBUG_ASSERT(m_pAudioSource);
+    const auto frameIndexRange = m_pAudioSource->frameIndexRange();
+    if (m_pSharedCache) {
+        // The same file is loaded in another deck, e.g. when cloning
+        auto pSharedSamples = m_pSharedCache->findPreloadedSamples(
+                m_trackLocation, frameIndexRange);
+        if (pSharedSamples) {
+            kLogger.debug()
+                    << m_group
+                    << "Sharing the preloaded samples of another deck";
+            return pSharedSamples;
+        }
+    }
+    auto pPreloadedSamples = std::make_shared<CachingReaderPreloadedSamples>();
+    pPreloadedSamples->sourceFrameIndexRange = frameIndexRange;
+    const SINT sampleCount = CachingReaderChunk::frames2samples(frameIndexRange.length());
+    mixxx::SampleBuffer(sampleCount).swap(pPreloadedSamples->buffer);
+    mixxx::AudioSourceStereoProxy audioSourceProxy(
+            m_pAudioSource,
+            mixxx::SampleBuffer::WritableSlice(m_tempReadBuffer));
+    // Decode chunk by chunk, because the temporary buffer for reading
+    // all channels of the audio source only holds a single chunk
+    SINT preloadedFrames = 0;
+    while (preloadedFrames < frameIndexRange.length()) {
+        const auto readFrameIndexRange = mixxx::IndexRange::forward(
+                frameIndexRange.start() + preloadedFrames,
+                std::min(CachingReaderChunk::kFrames,
+                        frameIndexRange.length() - preloadedFrames));
+        const auto readableSampleFrames = audioSourceProxy.readSampleFrames(
+                mixxx::WritableSampleFrames(
+                        readFrameIndexRange,
+                        mixxx::SampleBuffer::WritableSlice(
+                                pPreloadedSamples->buffer,
+                                CachingReaderChunk::frames2samples(preloadedFrames),
+                                CachingReaderChunk::frames2samples(
+                                        readFrameIndexRange.length()))));
+        if (readableSampleFrames.frameIndexRange() != readFrameIndexRange) {
+            kLogger.warning()
+                    << m_group
+                    << "Failed to preload track samples for frame index range:"
+                    << "expected =" << readFrameIndexRange
+                    << ", actual =" << readableSampleFrames.frameIndexRange();
+            break;
+        }
+        preloadedFrames += readFrameIndexRange.length();
+    }
+    if (preloadedFrames == 0) {
+        return nullptr;
+    }
+    pPreloadedSamples->frameIndexRange =
+            mixxx::IndexRange::forward(frameIndexRange.start(), preloadedFrames);
+    if (m_pSharedCache) {
+        m_pSharedCache->addPreloadedSamples(m_trackLocation, pPreloadedSamples);
+    }
+    return pPreloadedSamples;
+}
+
+void CachingReaderWorker::startLoudnessEstimation(const TrackPointer& pTrack) {
+    DEBUG_ASSERT(m_pAudioSource);
+    DEBUG_ASSERT(!m_pLoudnessTrack);
+    if (!m_pConfig) {
+        return;
+    }
+    if (!m_pLoudnessAnalyzer) {
+        m_pLoudnessAnalyzer = std::make_unique<AnalyzerEbur128>(m_pConfig);
+    }
+    const auto& signalInfo = m_pAudioSource->getSignalInfo();
+    // Skipped for tracks with ReplayGain and if another analyzer is used
+    if (!m_pLoudnessAnalyzer->initialize(pTrack,
+                signalInfo.getSampleRate(),
+                static_cast<int>(CachingReaderChunk::frames2samples(
+                        m_pAudioSource->frameLength())))) {
+        return;
+    }
+    m_pLoudnessTrack = pTrack;
+    m_loudnessEstimatedChunks.assign(
+            CachingReaderChunk::indexForFrame(m_pAudioSource->frameIndexRange().end() - 1) + 1,
+            false);
+    m_loudnessFramesSinceUpdate = 0;
+    m_loudnessFramesPerUpdate = static_cast<SINT>(
+            kLoudnessSecondsPerUpdate * signalInfo.getSampleRate());
+}
+
+void CachingReaderWorker::stopLoudnessEstimation() {
+    if (!m_pLoudnessTrack) {
+        return;
+    }
+    m_pLoudnessAnalyzer->cleanup();
+    m_pLoudnessTrack.reset();
+    m_loudnessEstimatedChunks.clear();
+}
+
+void CachingReaderWorker::estimateLoudness(const CachingReaderChunk& chunk) {
+    if (!m_pLoudnessTrack) {
+        return;
+    }
+    const SINT index = chunk.getIndex();
+    VERIFY_OR_DEBUG_ASSERT(index >= 0 &&
+            index < static_cast<SINT>(m_loudnessEstimatedChunks.size())) {
+        return;
+    }
+    // Chunks are decoded again after they have been evicted from the cache,
+    // but must only be counted once
+    if (m_loudnessEstimatedChunks[index]) {
+        return;
+    }
+    m_loudnessEstimatedChunks[index] = true;
+    const auto& sampleFrames = chunk.bufferedSampleFrames();
+    estimateLoudness(sampleFrames.readableData(),
+            CachingReaderChunk::samples2frames(sampleFrames.readableLength()));
+}
+
+void CachingReaderWorker::estimateLoudness(const CSAMPLE* pSamples, SINT frameCount) {
+    DEBUG_ASSERT(m_pLoudnessTrack);
+    // The chunks are decoded in the order of playback and seeks, so the
+    // gating blocks at the boundaries of non-adjacent chunks are slightly
+    // off. This doesn't matter for the estimate, because the full analysis
+    // replaces it eventually.
+    if (!m_pLoudnessAnalyzer->processSamples(pSamples,
+                static_cast<int>(CachingReaderChunk::frames2samples(frameCount)))) {
+        stopLoudnessEstimation();
+        return;
+    }
+    m_loudnessFramesSinceUpdate += frameCount;
+    if (m_loudnessFramesSinceUpdate < m_loudnessFramesPerUpdate) {
+        return;
+    }
+    m_loudnessFramesSinceUpdate = 0;
+    const double ratio = m_pLoudnessAnalyzer->replayGainRatio();
+    if (ratio > 0.0) {
+        emit provisionalReplayGainChanged(m_pLoudnessTrack, ratio);
+    }
+}
+
 // WARNING: Always called from a different thread (GUI)
 void CachingReaderWorker::newTrack(TrackPointer pTrack) {
     {
@@ -87,8 +282,10 @@ void CachingReaderWorker::run() {
     // the id of this thread, for debugging purposes
     static auto lastId = QAtomicInt(0);
     const auto id = lastId.fetchAndAddRelaxed(1) + 1;
-    QThread::currentThread()->setObjectName(
-            QStringLiteral("CachingReaderWorker ") + QString::number(id));
+    const QString name = QStringLiteral("CachingReaderWorker ") + QString::number(id);
+    QThread::currentThread()->setObjectName(name);
+    mixxx::RealtimeProfile::applyToCurrentThread(
+            mixxx::RealtimeProfile::Role::ReaderWorker, name);
 
     Event::start(m_tag);
     while (!m_stop.loadAcquire()) {
@@ -115,10 +312,14 @@ void CachingReaderWorker::run() {
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
         } else {
             Event::end(m_tag);
+            m_idle.storeRelease(1);
             m_semaRun.acquire();
+            m_idle.storeRelease(0);
+            updatePriority();
             Event::start(m_tag);
         }
     }
+    mixxx::RealtimeProfile::removeThread(name);
 }
 
 void CachingReaderWorker::discardAllPendingRequests() {
@@ -137,6 +338,12 @@ void CachingReaderWorker::closeAudioSource() {
         m_pAudioSource->close();
         m_pAudioSource.reset();
     }
+    m_trackLocation.clear();
+    m_pDiskCacheFile.reset();
+    stopLoudnessEstimation();
+    // The engine doesn't access the preloaded samples of the previous
+    // track anymore
+    m_pPreloadedSamples.reset();
 
     // This function has to be called with the engine stopped only
     // to avoid collecting new requests for the old track
@@ -186,6 +393,8 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         return;
     }
 
+    m_trackLocation = pTrack->getLocation();
+
     // Initially assume that the complete content offered by audio source
     // is available for reading. Later if read errors occur this value will
     // be decreased to avoid repeated reading of corrupt audio data.
@@ -203,6 +412,12 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         return;
     }
 
+    if (m_pDiskCache) {
+        m_pDiskCacheFile = m_pDiskCache->openFile(pTrack, m_pAudioSource);
+    }
+
+    startLoudnessEstimation(pTrack);
+
     // Adjust the internal buffer
     const SINT tempReadBufferSize =
             m_pAudioSource->getSignalInfo().frames2samples(
@@ -211,9 +426,33 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         mixxx::SampleBuffer(tempReadBufferSize).swap(m_tempReadBuffer);
     }
 
+    auto readableFrameIndexRange = m_pAudioSource->frameIndexRange();
+    const CSAMPLE* pPreloadedSamples = nullptr;
+    const auto duration = mixxx::Duration::fromSeconds(
+            m_pAudioSource->getSignalInfo().frames2secs(
+                    m_pAudioSource->frameLength()));
+    if (duration <= m_preloadMaxDuration) {
+        // Short tracks are decoded completely into memory before finishing
+        // the load. The engine reads their samples directly, which avoids
+        // any cache misses, e.g. when triggering samples after being idle.
+        // Falls back to reading chunks on demand if it fails
+        m_pPreloadedSamples = preloadTrack();
+        if (m_pPreloadedSamples) {
+            kLogger.debug()
+                    << m_group
+                    << "Preloaded"
+                    << m_pPreloadedSamples->frameIndexRange.length()
+                    << "frames into memory";
+            // Like for chunks, frames after a read error are not readable
+            readableFrameIndexRange = m_pPreloadedSamples->frameIndexRange;
+            pPreloadedSamples = m_pPreloadedSamples->buffer.data();
+        }
+    }
+
     const auto update =
             ReaderStatusUpdate::trackLoaded(
-                    m_pAudioSource->frameIndexRange());
+                    readableFrameIndexRange,
+                    pPreloadedSamples);
     m_pReaderStatusFIFO->writeBlocking(&update, 1);
 
     // Emit that the track is loaded.
@@ -229,6 +468,13 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
             pTrack,
             m_pAudioSource->getSignalInfo().getSampleRate(),
             sampleCount);
+
+    if (pPreloadedSamples && m_pLoudnessTrack) {
+        // No chunks will be decoded, the whole track is available at once
+        m_loudnessFramesSinceUpdate = m_loudnessFramesPerUpdate;
+        estimateLoudness(pPreloadedSamples, readableFrameIndexRange.length());
+        stopLoudnessEstimation();
+    }
 }
 
 void CachingReaderWorker::quitWait() {
@@ -5,13 +5,22 @@
 #include <QString>
 #include <QThread>
 #include <QtDebug>
+#include <memory>
+#include <vector>
 
 #include "engine/cachingreader/cachingreaderchunk.h"
+#include "engine/cachingreader/cachingreadersharedcache.h"
 #include "engine/engineworker.h"
+#include "preferences/usersettings.h"
 #include "sources/audiosource.h"
 #include "track/track_decl.h"
+#include "util/compatibility/qatomic.h"
+#include "util/duration.h"
 #include "util/fifo.h"
 
+class CachingReaderDiskCache;
+class CachingReaderDiskCacheFile;
+
 // POD with trivial ctor/dtor/copy for passing through FIFO
 typedef struct CachingReaderChunkReadRequest {
     CachingReaderChunk* chunk;
@@ -38,6 +47,7 @@ typedef struct ReaderStatusUpdate {
     CachingReaderChunk* chunk;
     SINT readableFrameIndexRangeStart;
     SINT readableFrameIndexRangeEnd;
+    const CSAMPLE* pPreloadedSamples;
 
   public:
     ReaderStatus status;
@@ -50,6 +60,7 @@ typedef struct ReaderStatusUpdate {
         chunk = chunkArg;
         readableFrameIndexRangeStart = readableFrameIndexRangeArg.start();
         readableFrameIndexRangeEnd = readableFrameIndexRangeArg.end();
+        pPreloadedSamples = nullptr;
     }
 
     static ReaderStatusUpdate readDiscarded(
@@ -60,10 +71,12 @@ typedef struct ReaderStatusUpdate {
     }
 
     static ReaderStatusUpdate trackLoaded(
-            const mixxx::IndexRange& readableFrameIndexRange) {
+            const mixxx::IndexRange& readableFrameIndexRange,
+            const CSAMPLE* pPreloadedSamples = nullptr) {
         DEBUG_ASSERT(!readableFrameIndexRange.empty());
         ReaderStatusUpdate update;
         update.init(TRACK_LOADED, nullptr, readableFrameIndexRange);
+        update.pPreloadedSamples = pPreloadedSamples;
         return update;
     }
 
@@ -89,8 +102,18 @@ typedef struct ReaderStatusUpdate {
                 readableFrameIndexRangeStart,
                 readableFrameIndexRangeEnd);
     }
+
+    // The decoded stereo samples of the whole readable frame index range
+    // if the track has been preloaded, otherwise nullptr. Only set for
+    // TRACK_LOADED. The samples are owned by the worker and remain valid
+    // until the next track is loaded or unloaded.
+    const CSAMPLE* preloadedSamples() const {
+        return pPreloadedSamples;
+    }
 } ReaderStatusUpdate;
 
+class AnalyzerEbur128;
+
 class CachingReaderWorker : public EngineWorker {
     Q_OBJECT
 
@@ -98,23 +121,50 @@ class CachingReaderWorker : public EngineWorker {
     // Construct a CachingReader with the given group.
     CachingReaderWorker(const QString& group,
             FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
-            FIFO<ReaderStatusUpdate>* pReaderStatusFIFO);
-    ~CachingReaderWorker() override = default;
+            FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
+            CachingReaderSharedCache* pSharedCache = nullptr,
+            CachingReaderDiskCache* pDiskCache = nullptr,
+            mixxx::Duration preloadMaxDuration = mixxx::Duration::empty(),
+            UserSettingsPointer pConfig = UserSettingsPointer());
+    ~CachingReaderWorker() override;
 
     // Request to load a new track. wake() must be called afterwards.
     void newTrack(TrackPointer pTrack);
 
-    // Run upkeep operations like loading tracks and reading from file. Run by a
-    // thread pool via the EngineWorkerScheduler.
+    // Run upkeep operations like loading tracks and reading from file. Woken
+    // by the EngineWorkerScheduler.
     void run() override;
 
     void quitWait();
 
+    // The number of chunk read requests that have been served from
+    // the shared cache instead of decoding them. Thread-safe.
+    int sharedCacheHits() const {
+        return atomicLoadRelaxed(m_sharedCacheHits);
+    }
+
+    // The number of chunk read requests that have been served from
+    // the disk cache instead of decoding them. Thread-safe.
+    int diskCacheHits() const {
+        return atomicLoadRelaxed(m_diskCacheHits);
+    }
+
+    // True while the worker waits for work and no new track is pending.
+    // Read requests that are still queued must be checked separately.
+    // Thread-safe.
+    bool isIdle() const {
+        return m_idle.loadAcquire() && !m_newTrackAvailable.loadAcquire();
+    }
+
   signals:
     // Emitted once a new track is loaded and ready to be read from.
     void trackLoading();
     void trackLoaded(TrackPointer pTrack, int iSampleRate, int iNumSamples);
     void trackLoadFailed(TrackPointer pTrack, const QString& reason);
+    // Emitted for a track without ReplayGain with a loudness estimate of
+    // the chunks that have been decoded so far, which is refined while
+    // more chunks are decoded.
+    void provisionalReplayGainChanged(TrackPointer pTrack, double ratio);
 
   private:
     const QString m_group;
@@ -147,12 +197,52 @@ class CachingReaderWorker : public EngineWorker {
     ReaderStatusUpdate processReadRequest(
             const CachingReaderChunkReadRequest& request);
 
+    /// Decodes the whole track or takes its samples from another worker
+    /// via the shared cache. The samples start at the first frame of the
+    /// audio source, decoding stops at the first read error. Returns
+    /// nullptr if no frames could be decoded.
+    CachingReaderPreloadedSamplesPointer preloadTrack();
+
+    /// Starts estimating the loudness of the track while its chunks are
+    /// decoded, if the track has no ReplayGain yet.
+    void startLoudnessEstimation(const TrackPointer& pTrack);
+    void stopLoudnessEstimation();
+    /// Adds the samples of a chunk that has not been estimated before
+    void estimateLoudness(const CachingReaderChunk& chunk);
+    void estimateLoudness(const CSAMPLE* pSamples, SINT frameCount);
+
     // The current audio source of the track loaded
     mixxx::AudioSourcePointer m_pAudioSource;
 
+    // The location of the track that is loaded, used as the key for
+    // the shared cache
+    QString m_trackLocation;
+
+    CachingReaderSharedCache* const m_pSharedCache;
+    QAtomicInt m_sharedCacheHits;
+
+    CachingReaderDiskCache* const m_pDiskCache;
+    // The file of the track that is loaded, if cached on disk
+    std::unique_ptr<CachingReaderDiskCacheFile> m_pDiskCacheFile;
+    QAtomicInt m_diskCacheHits;
+
     // Temporary buffer for reading samples from all channels
     // before conversion to a stereo signal.
     mixxx::SampleBuffer m_tempReadBuffer;
 
+    // Tracks up to this duration are decoded completely into
+    // m_pPreloadedSamples when loading instead of reading chunks on demand
+    const mixxx::Duration m_preloadMaxDuration;
+    CachingReaderPreloadedSamplesPointer m_pPreloadedSamples;
+
+    const UserSettingsPointer m_pConfig;
+    std::unique_ptr<AnalyzerEbur128> m_pLoudnessAnalyzer;
+    // The track whose loudness is estimated, null if none
+    TrackPointer m_pLoudnessTrack;
+    std::vector<bool> m_loudnessEstimatedChunks;
+    SINT m_loudnessFramesSinceUpdate;
+    SINT m_loudnessFramesPerUpdate;
+
     QAtomicInt m_stop;
+    QAtomicInt m_idle;
 };
@@ -5,6 +5,7 @@
 #include <QVarLengthArray>
 #include <QtDebug>
 #include <memory>
+#include <vector>
 
 #include "util/assert.h"
 #include "util/compatibility/qhash.h"
@@ -240,3 +241,89 @@ class ChannelHandleMap {
     container_type m_data;
     T m_dummy;
 };
+
+// A dense matrix of T for each pair of ChannelHandles, e.g. the routing state
+// of an effect for each input and output channel. All cells are allocated on
+// construction, so accessing a cell from the engine thread never allocates
+// and is a single index into an array instead of a lookup in two nested
+// ChannelHandleMaps.
+template<class T>
+class ChannelHandleMatrix {
+  public:
+    // Enough for all channels of the engine, i.e. 4 decks, 64 samplers,
+    // the preview deck, 4 microphones, 4 auxiliaries and the outputs and
+    // buses of EngineMaster.
+    static constexpr int kMaxHandles = 128;
+
+    // A row of the matrix, i.e. the cells of all output channels for an
+    // input channel.
+    class Row {
+      public:
+        Row(T* pBegin, T* pEnd)
+                : m_pBegin(pBegin),
+                  m_pEnd(pEnd) {
+        }
+        T* begin() const {
+            return m_pBegin;
+        }
+        T* end() const {
+            return m_pEnd;
+        }
+
+      private:
+        T* m_pBegin;
+        T* m_pEnd;
+    };
+
+    ChannelHandleMatrix()
+            : m_data(kMaxHandles * kMaxHandles),
+              m_dummy{} {
+    }
+
+    // Returns a dummy cell for invalid handles
+    T& operator()(const ChannelHandle& input, const ChannelHandle& output) {
+        if (!isInRange(input) || !isInRange(output)) {
+            return m_dummy;
+        }
+        return m_data[input.handle() * kMaxHandles + output.handle()];
+    }
+
+    const T& at(const ChannelHandle& input, const ChannelHandle& output) const {
+        if (!isInRange(input) || !isInRange(output)) {
+            return m_dummy;
+        }
+        return m_data[input.handle() * kMaxHandles + output.handle()];
+    }
+
+    // Returns an empty row for invalid handles
+    Row row(const ChannelHandle& input) {
+        if (!isInRange(input)) {
+            return Row(nullptr, nullptr);
+        }
+        T* pBegin = m_data.data() + input.handle() * kMaxHandles;
+        return Row(pBegin, pBegin + kMaxHandles);
+    }
+
+    // Iterates over all cells
+    typename std::vector<T>::iterator begin() {
+        return m_data.begin();
+    }
+
+    typename std::vector<T>::iterator end() {
+        return m_data.end();
+    }
+
+  private:
+    static bool isInRange(const ChannelHandle& handle) {
+        if (!handle.valid()) {
+            return false;
+        }
+        VERIFY_OR_DEBUG_ASSERT(handle.handle() < kMaxHandles) {
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<T> m_data;
+    T m_dummy;
+};
@@ -1,8 +1,27 @@
 #include "engine/channelmixer.h"
 
+#include "util/assert.h"
 #include "util/sample.h"
 #include "util/timer.h"
 
+namespace {
+
+CSAMPLE_GAIN updateGainCache(EngineMaster::GainCache* pGainCache,
+        const EngineMaster::GainCalculator& gainCalculator,
+        EngineMaster::ChannelInfo* pChannelInfo) {
+    CSAMPLE_GAIN newGain;
+    if (pGainCache->m_fadeout) {
+        newGain = 0;
+        pGainCache->m_fadeout = false;
+    } else {
+        newGain = gainCalculator.getGain(pChannelInfo);
+    }
+    pGainCache->m_gain = newGain;
+    return newGain;
+}
+
+} // anonymous namespace
+
 // static
 void ChannelMixer::applyEffectsAndMixChannels(const EngineMaster::GainCalculator& gainCalculator,
         const QVarLengthArray<EngineMaster::ChannelInfo*, kPreallocatedChannels>& activeChannels,
@@ -25,15 +44,8 @@ void ChannelMixer::applyEffectsAndMixChannels(const EngineMaster::GainCalculator
     ScopedTimer t("EngineMaster::applyEffectsAndMixChannels");
     for (auto* pChannelInfo : activeChannels) {
         EngineMaster::GainCache& gainCache = (*channelGainCache)[pChannelInfo->m_index];
-        CSAMPLE_GAIN oldGain = gainCache.m_gain;
-        CSAMPLE_GAIN newGain;
-        if (gainCache.m_fadeout) {
-            newGain = 0;
-            gainCache.m_fadeout = false;
-        } else {
-            newGain = gainCalculator.getGain(pChannelInfo);
-        }
-        gainCache.m_gain = newGain;
+        const CSAMPLE_GAIN oldGain = gainCache.m_gain;
+        const CSAMPLE_GAIN newGain = updateGainCache(&gainCache, gainCalculator, pChannelInfo);
         pEngineEffectsManager->processPostFaderAndMix(pChannelInfo->m_handle,
                 outputHandle,
                 pChannelInfo->m_pBuffer,
@@ -67,15 +79,8 @@ void ChannelMixer::applyEffectsInPlaceAndMixChannels(
     SampleUtil::clear(pOutput, iBufferSize);
     for (auto* pChannelInfo : activeChannels) {
         EngineMaster::GainCache& gainCache = (*channelGainCache)[pChannelInfo->m_index];
-        CSAMPLE_GAIN oldGain = gainCache.m_gain;
-        CSAMPLE_GAIN newGain;
-        if (gainCache.m_fadeout) {
-            newGain = 0;
-            gainCache.m_fadeout = false;
-        } else {
-            newGain = gainCalculator.getGain(pChannelInfo);
-        }
-        gainCache.m_gain = newGain;
+        const CSAMPLE_GAIN oldGain = gainCache.m_gain;
+        const CSAMPLE_GAIN newGain = updateGainCache(&gainCache, gainCalculator, pChannelInfo);
         pEngineEffectsManager->processPostFaderInPlace(pChannelInfo->m_handle,
                 outputHandle,
                 pChannelInfo->m_pBuffer,
@@ -87,3 +92,78 @@ void ChannelMixer::applyEffectsInPlaceAndMixChannels(
         SampleUtil::add(pOutput, pChannelInfo->m_pBuffer, iBufferSize);
     }
 }
+
+// static
+void ChannelMixer::mixChannelsInSinglePass(
+        const EngineMaster::GainCalculator& busGainCalculator,
+        const EngineMaster::GainCalculator& headphoneGainCalculator,
+        const QVarLengthArray<EngineMaster::ChannelInfo*, kPreallocatedChannels>&
+                activeChannels,
+        QVarLengthArray<EngineMaster::GainCache, kPreallocatedChannels>*
+                channelBusGainCache,
+        QVarLengthArray<EngineMaster::GainCache, kPreallocatedChannels>*
+                channelHeadphoneGainCache,
+        CSAMPLE* const* pBusOutputs,
+        CSAMPLE* pHeadphoneOutput,
+        const SampleUtil::BufferSizeKernels& bufferSizeKernels,
+        unsigned int iRampStart) {
+    // Without post fader effects the gain is the only processing, so
+    // instead of applying it to the channel buffer in place and adding the
+    // result to the bus in a second pass, the samples are read once and
+    // added to each output with its own gain ramp.
+    // The old gains are kept until iRampStart, e.g. to place a crossfader
+    // cut precisely within the buffer.
+    const auto iBufferSize = static_cast<unsigned int>(bufferSizeKernels.numSamples);
+    DEBUG_ASSERT(iRampStart <= iBufferSize && iRampStart % 2 == 0);
+    ScopedTimer t("EngineMaster::mixChannelsInSinglePass");
+    for (auto* pChannelInfo : activeChannels) {
+        EngineMaster::GainCache& busGainCache =
+                (*channelBusGainCache)[pChannelInfo->m_index];
+        const CSAMPLE_GAIN oldBusGain = busGainCache.m_gain;
+        const CSAMPLE_GAIN newBusGain = updateGainCache(
+                &busGainCache, busGainCalculator, pChannelInfo);
+        CSAMPLE* pBusOutput = pBusOutputs[pChannelInfo->m_pChannel->getOrientation()];
+
+        CSAMPLE* pHeadphone = nullptr;
+        CSAMPLE_GAIN oldHeadphoneGain = 0;
+        CSAMPLE_GAIN newHeadphoneGain = 0;
+        if (pHeadphoneOutput && pChannelInfo->m_singlePassHeadphones) {
+            EngineMaster::GainCache& headphoneGainCache =
+                    (*channelHeadphoneGainCache)[pChannelInfo->m_index];
+            oldHeadphoneGain = headphoneGainCache.m_gain;
+            newHeadphoneGain = updateGainCache(
+                    &headphoneGainCache, headphoneGainCalculator, pChannelInfo);
+            pHeadphone = pHeadphoneOutput;
+        }
+
+        if (iRampStart > 0) {
+            SampleUtil::addToBothWithRampingGain(pBusOutput,
+                    oldBusGain,
+                    oldBusGain,
+                    pHeadphone,
+                    oldHeadphoneGain,
+                    oldHeadphoneGain,
+                    pChannelInfo->m_pBuffer,
+                    iRampStart);
+        }
+        if (iRampStart == 0) {
+            bufferSizeKernels.addToBothWithRampingGain(pBusOutput,
+                    oldBusGain,
+                    newBusGain,
+                    pHeadphone,
+                    oldHeadphoneGain,
+                    newHeadphoneGain,
+                    pChannelInfo->m_pBuffer,
+                    iBufferSize);
+        } else if (iRampStart < iBufferSize) {
+            SampleUtil::addToBothWithRampingGain(pBusOutput + iRampStart,
+                    oldBusGain,
+                    newBusGain,
+                    pHeadphone ? pHeadphone + iRampStart : nullptr,
+                    oldHeadphoneGain,
+                    newHeadphoneGain,
+                    pChannelInfo->m_pBuffer + iRampStart,
+                    iBufferSize - iRampStart);
+        }
+    }
+}
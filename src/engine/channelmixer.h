@@ -2,6 +2,7 @@
 
 #include <QVarLengthArray>
 
+#include "util/sample.h"
 #include "util/types.h"
 #include "engine/enginemaster.h"
 #include "effects/engineeffectsmanager.h"
@@ -34,4 +35,24 @@ class ChannelMixer {
             unsigned int iBufferSize,
             unsigned int iSampleRate,
             EngineEffectsManager* pEngineEffectsManager);
+    // Mixes channels without post fader effects into the crossfader
+    // orientation buses and the headphone bus at once, which reads each
+    // channel buffer only once and does not modify it. pBusOutputs is
+    // indexed by EngineChannel::ChannelOrientation. Only channels with
+    // m_singlePassHeadphones set are mixed into pHeadphoneOutput, which is
+    // nullptr if the headphone output is disabled. The output buffers are
+    // not cleared. The buffer size is the one of bufferSizeKernels.
+    static void mixChannelsInSinglePass(
+            const EngineMaster::GainCalculator& busGainCalculator,
+            const EngineMaster::GainCalculator& headphoneGainCalculator,
+            const QVarLengthArray<EngineMaster::ChannelInfo*,
+                    kPreallocatedChannels>& activeChannels,
+            QVarLengthArray<EngineMaster::GainCache, kPreallocatedChannels>*
+                    channelBusGainCache,
+            QVarLengthArray<EngineMaster::GainCache, kPreallocatedChannels>*
+                    channelHeadphoneGainCache,
+            CSAMPLE* const* pBusOutputs,
+            CSAMPLE* pHeadphoneOutput,
+            const SampleUtil::BufferSizeKernels& bufferSizeKernels,
+            unsigned int iRampStart = 0);
 };
@@ -67,6 +67,7 @@ void EngineDeck::process(CSAMPLE* pOut, const int iBufferSize) {
         // Process the raw audio
         m_pBuffer->process(pOut, iBufferSize);
         m_pPregain->setSpeedAndScratching(m_pBuffer->getSpeed(), m_pBuffer->getScratching());
+        m_pPregain->setShortStartStopRamps(m_pBuffer->isPadModeEnabled());
         m_bPassthroughWasActive = false;
     }
 
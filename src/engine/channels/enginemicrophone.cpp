@@ -6,6 +6,7 @@
 #include "control/controlaudiotaperpot.h"
 #include "effects/effectsmanager.h"
 #include "engine/effects/engineeffectsmanager.h"
+#include "engine/enginemaster.h"
 #include "moc_enginemicrophone.cpp"
 #include "preferences/usersettings.h"
 #include "util/sample.h"
@@ -17,6 +18,7 @@ EngineMicrophone::EngineMicrophone(const ChannelHandleAndGroup& handleGroup,
                   /*isPrimaryDeck*/ false),
           m_pInputConfigured(new ControlObject(ConfigKey(getGroup(), "input_configured"))),
           m_pPregain(new ControlAudioTaperPot(ConfigKey(getGroup(), "pregain"), -12, 12, 0.5)),
+          m_micMonitorMode("[Master]", "talkover_mix"),
           m_wasActive(false) {
     // Make input_configured read-only.
     m_pInputConfigured->setReadOnly();
@@ -61,6 +63,15 @@ void EngineMicrophone::onInputUnconfigured(const AudioInput& input) {
     m_pInputConfigured->forceSet(0.0);
 }
 
+CSAMPLE_GAIN EngineMicrophone::getDirectMonitorGain() const {
+    if (static_cast<int>(m_micMonitorMode.get()) !=
+                    static_cast<int>(EngineMaster::MicMonitorMode::SOFTWARE_DIRECT_MONITOR) ||
+            !isTalkoverEnabled()) {
+        return CSAMPLE_GAIN_ZERO;
+    }
+    return static_cast<CSAMPLE_GAIN>(m_pPregain->get());
+}
+
 void EngineMicrophone::receiveBuffer(
         const AudioInput& input, const CSAMPLE* pBuffer, unsigned int nFrames) {
     Q_UNUSED(input);
@@ -45,12 +45,18 @@ class EngineMicrophone : public EngineChannel, public AudioDestination {
     // a soundcard input.
     virtual void onInputUnconfigured(const AudioInput& input);
 
+    // Returns the pregain while talkover is enabled and the microphones are
+    // monitored by the sound devices, see
+    // EngineMaster::MicMonitorMode::SOFTWARE_DIRECT_MONITOR
+    CSAMPLE_GAIN getDirectMonitorGain() const override;
+
     bool isSolo();
     double getSoloDamping();
 
   private:
     QScopedPointer<ControlObject> m_pInputConfigured;
     ControlAudioTaperPot* m_pPregain;
+    PollingControlProxy m_micMonitorMode;
 
     bool m_wasActive;
 };
@@ -1,5 +1,7 @@
 #include "engine/controls/cuecontrol.h"
 
+#include <algorithm>
+
 #include "control/controlindicator.h"
 #include "control/controlobject.h"
 #include "control/controlpushbutton.h"
@@ -452,6 +454,7 @@ void CueControl::trackLoaded(TrackPointer pNewTrack) {
         setHotcueFocusIndex(Cue::kNoHotCue);
         m_pLoadedTrack.reset();
         m_usedSeekOnLoadPosition.setValue(mixxx::audio::kStartFramePos);
+        updateCueHintIndex();
     }
 
     if (!pNewTrack) {
@@ -623,6 +626,7 @@ void CueControl::loadCuesFromTrack() {
             detachCue(pControl);
         }
     }
+    updateCueHintIndex();
 
     if (pIntroCue) {
         const auto startPosition = quantizeCuePoint(pIntroCue->getPosition());
@@ -846,6 +850,7 @@ void CueControl::hotcueSet(HotcueControl* pControl, double value, HotcueSetMode
 
     // TODO(XXX) deal with spurious signals
     attachCue(pCue, pControl);
+    updateCueHintIndex();
 
     if (cueType == mixxx::CueType::Loop) {
         ConfigKey autoLoopColorsKey("[Controls]", "auto_loop_colors");
@@ -1122,6 +1127,7 @@ void CueControl::hotcueClear(HotcueControl* pControl, double value) {
         return;
     }
     detachCue(pControl);
+    updateCueHintIndex();
     m_pLoadedTrack->removeCue(pCue);
     setHotcueFocusIndex(Cue::kNoHotCue);
 }
@@ -1142,6 +1148,7 @@ void CueControl::hotcuePositionChanged(
     // Setting the position to Cue::kNoPosition is the same as calling hotcue_x_clear
     if (!newPosition.isValid()) {
         detachCue(pControl);
+        updateCueHintIndex();
         return;
     }
 
@@ -1186,18 +1193,13 @@ void CueControl::hintReader(gsl::not_null<HintVector*> pHintList) {
     appendCueHint(pHintList, m_pCuePoint->get(), Hint::Type::MainCue);
 
     // this is called from the engine thread
-    // it is no locking required, because m_hotcueControl is filled during the
-    // constructor and getPosition()->get() is a ControlObject
-    for (const auto& pControl : qAsConst(m_hotcueControls)) {
-        appendCueHint(pHintList, pControl->getPosition(), Hint::Type::HotCue);
-    }
-
-    CuePointer pAudibleSound =
-            m_pLoadedTrack->findCueByType(mixxx::CueType::AudibleSound);
-    if (pAudibleSound) {
-        const mixxx::audio::FramePos frame = pAudibleSound->getPosition();
-        appendCueHint(pHintList, frame, Hint::Type::FirstSound);
+    // no locking is required, because the index is a wait-free snapshot
+    // that is replaced whenever the cues of the track change
+    const CueHintIndex cueHintIndex = m_cueHintIndex.getValue();
+    for (int i = 0; i < cueHintIndex.hotcueCount; ++i) {
+        appendCueHint(pHintList, cueHintIndex.hotcuePositions[i], Hint::Type::HotCue);
     }
+    appendCueHint(pHintList, cueHintIndex.audibleSoundPosition, Hint::Type::FirstSound);
 
     appendCueHint(pHintList, m_pIntroStartPosition->get(), Hint::Type::IntroStart);
     appendCueHint(pHintList, m_pIntroEndPosition->get(), Hint::Type::IntroEnd);
@@ -2355,6 +2357,27 @@ int CueControl::getHotcueFocusIndex() const {
     return hotcueNumberToHotcueIndex(static_cast<int>(m_pHotcueFocus->get()));
 }
 
+void CueControl::updateCueHintIndex() {
+    auto lock = lockMutex(&m_trackMutex);
+    CueHintIndex cueHintIndex;
+    for (const auto& pControl : qAsConst(m_hotcueControls)) {
+        const auto position = pControl->getPosition();
+        if (position.isValid()) {
+            cueHintIndex.hotcuePositions[cueHintIndex.hotcueCount++] = position;
+        }
+    }
+    std::sort(cueHintIndex.hotcuePositions.begin(),
+            cueHintIndex.hotcuePositions.begin() + cueHintIndex.hotcueCount);
+    if (m_pLoadedTrack) {
+        CuePointer pAudibleSound =
+                m_pLoadedTrack->findCueByType(mixxx::CueType::AudibleSound);
+        if (pAudibleSound) {
+            cueHintIndex.audibleSoundPosition = pAudibleSound->getPosition();
+        }
+    }
+    m_cueHintIndex.setValue(cueHintIndex);
+}
+
 ConfigKey HotcueControl::keyForControl(const QString& name) {
     ConfigKey key;
     key.group = m_group;
@@ -5,8 +5,10 @@
 #include <QAtomicInt>
 #include <QAtomicPointer>
 #include <QList>
+#include <array>
 
 #include "control/controlproxy.h"
+#include "control/controlvalue.h"
 #include "engine/controls/enginecontrol.h"
 #include "preferences/colorpalettesettings.h"
 #include "preferences/usersettings.h"
@@ -282,6 +284,7 @@ class CueControl : public EngineControl {
     void seekOnLoad(mixxx::audio::FramePos seekOnLoadPosition);
     void setHotcueFocusIndex(int hotcueIndex);
     int getHotcueFocusIndex() const;
+    void updateCueHintIndex();
 
     UserSettingsPointer m_pConfig;
     ColorPaletteSettings m_colorPaletteSettings;
@@ -301,6 +304,18 @@ class CueControl : public EngineControl {
     const int m_iNumHotCues;
     QList<HotcueControl*> m_hotcueControls;
 
+    /// The cue positions that are hinted to the reader in every callback.
+    /// They are collected whenever the cues of the track change, so that
+    /// the engine thread neither reads all hot cue controls nor locks the
+    /// track to look up the first sound.
+    struct CueHintIndex {
+        /// The valid hot cue positions in ascending order
+        std::array<mixxx::audio::FramePos, NUM_HOT_CUES> hotcuePositions;
+        int hotcueCount = 0;
+        mixxx::audio::FramePos audibleSoundPosition;
+    };
+    ControlValueAtomic<CueHintIndex> m_cueHintIndex;
+
     ControlObject* m_pTrackSamples;
     ControlObject* m_pCuePoint;
     ControlObject* m_pCueMode;
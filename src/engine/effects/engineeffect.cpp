@@ -4,13 +4,17 @@
 #include "util/defs.h"
 #include "util/sample.h"
 
-EngineEffect::EngineEffect(EffectManifestPointer pManifest,
+EngineEffect::EngineEffect(const QString& group,
+        EffectManifestPointer pManifest,
         EffectsBackendManagerPointer pBackendManager,
         const QSet<ChannelHandleAndGroup>& activeInputChannels,
-        const QSet<ChannelHandleAndGroup>& registeredInputChannels,
         const QSet<ChannelHandleAndGroup>& registeredOutputChannels)
         : m_pManifest(pManifest),
           m_pProcessor(pBackendManager->createProcessor(pManifest)),
+          m_oversamplingFactor(pManifest->oversamplingFactor()),
+          m_oversamplingLatencyFrames(
+                  EffectOversampler::latencyFrames(m_oversamplingFactor)),
+          m_cpuLoad(ConfigKey(group, QStringLiteral("cpu_load"))),
           m_parameters(pManifest->parameters().size()) {
     const QList<EffectManifestParameterPointer>& parameters = m_pManifest->parameters();
     for (int i = 0; i < parameters.size(); ++i) {
@@ -20,21 +24,16 @@ EngineEffect::EngineEffect(EffectManifestPointer pManifest,
         m_parametersById[param->id()] = pParameter;
     }
 
-    for (const ChannelHandleAndGroup& inputChannel : registeredInputChannels) {
-        ChannelHandleMap<EffectEnableState> outputChannelMap;
-        for (const ChannelHandleAndGroup& outputChannel : registeredOutputChannels) {
-            outputChannelMap.insert(outputChannel.handle(), EffectEnableState::Disabled);
-        }
-        m_effectEnableStateForChannelMatrix.insert(inputChannel.handle(), outputChannelMap);
-    }
-
     m_pProcessor->loadEngineEffectParameters(m_parametersById);
 
     //TODO: get actual configuration of engine
     const mixxx::EngineParameters engineParameters(
             mixxx::audio::SampleRate(96000),
             MAX_BUFFER_LEN / mixxx::kEngineChannelCount);
-    m_pProcessor->initialize(activeInputChannels, registeredOutputChannels, engineParameters);
+    m_pProcessor->initialize(activeInputChannels,
+            registeredOutputChannels,
+            engineParameters,
+            m_oversamplingFactor);
     m_effectRampsFromDry = pManifest->effectRampsFromDry();
 }
 
@@ -78,21 +77,19 @@ bool EngineEffect::processEffectsRequest(EffectsRequest& message,
                      << "enabled" << message.SetEffectParameters.enabled;
         }
 
-        for (auto& outputMap : m_effectEnableStateForChannelMatrix) {
-            for (auto& enableState : outputMap) {
-                if (enableState != EffectEnableState::Disabled &&
-                        !message.SetEffectParameters.enabled) {
-                    enableState = EffectEnableState::Disabling;
-                    // If an input is not routed to the chain, and the effect gets
-                    // a message to disable, then the effect gets the message to enable,
-                    // process() will not have executed, so the enableState will still be
-                    // DISABLING instead of DISABLED.
-                } else if ((enableState == EffectEnableState::Disabled ||
-                                   enableState ==
-                                           EffectEnableState::Disabling) &&
-                        message.SetEffectParameters.enabled) {
-                    enableState = EffectEnableState::Enabling;
-                }
+        for (auto& enableState : m_effectEnableStateForChannelMatrix) {
+            if (enableState != EffectEnableState::Disabled &&
+                    !message.SetEffectParameters.enabled) {
+                enableState = EffectEnableState::Disabling;
+                // If an input is not routed to the chain, and the effect gets
+                // a message to disable, then the effect gets the message to enable,
+                // process() will not have executed, so the enableState will still be
+                // DISABLING instead of DISABLED.
+            } else if ((enableState == EffectEnableState::Disabled ||
+                               enableState ==
+                                       EffectEnableState::Disabling) &&
+                    message.SetEffectParameters.enabled) {
+                enableState = EffectEnableState::Enabling;
             }
         }
 
@@ -104,12 +101,15 @@ bool EngineEffect::processEffectsRequest(EffectsRequest& message,
         if (kEffectDebugOutput) {
             qDebug() << debugString() << "SET_PARAMETER_PARAMETERS"
                      << "parameter" << message.SetParameterParameters.iParameter
-                     << "value" << message.value;
+                     << "value" << message.value.load();
         }
         pParameter = m_parameters.value(
                 message.SetParameterParameters.iParameter, EngineEffectParameterPointer());
+        // The value must not be read before the request has been consumed,
+        // otherwise a value that is replaced by EffectsMessenger might get lost
+        message.consumed.store(true);
         if (pParameter) {
-            pParameter->setValue(message.value);
+            pParameter->setValue(message.value.load());
             response.success = true;
         } else {
             response.success = false;
@@ -148,7 +148,7 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
     // internal buffer for the channel when it gets the intermediate disabling signal.
 
     EffectEnableState effectiveEffectEnableState =
-            m_effectEnableStateForChannelMatrix[inputHandle][outputHandle];
+            m_effectEnableStateForChannelMatrix(inputHandle, outputHandle);
 
     // If the EngineEffect is fully disabled, do not let
     // intermediate enabling/disabling signals from the chain override
@@ -182,6 +182,7 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
                 mixxx::audio::SampleRate(sampleRate),
                 numSamples / mixxx::kEngineChannelCount);
 
+        m_cpuLoad.startMeasurement();
         m_pProcessor->process(inputHandle,
                 outputHandle,
                 pInput,
@@ -189,6 +190,7 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
                 engineParameters,
                 effectiveEffectEnableState,
                 groupFeatures);
+        m_cpuLoad.stopMeasurement();
 
         processingOccured = true;
 
@@ -214,7 +216,7 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
 
     // Now that the EffectProcessor has been sent the intermediate enabling/disabling
     // signal, set the channel state to fully enabled/disabled for the next engine callback.
-    EffectEnableState& effectOnChannelState = m_effectEnableStateForChannelMatrix[inputHandle][outputHandle];
+    EffectEnableState& effectOnChannelState = m_effectEnableStateForChannelMatrix(inputHandle, outputHandle);
     if (effectOnChannelState == EffectEnableState::Disabling) {
         effectOnChannelState = EffectEnableState::Disabled;
     } else if (effectOnChannelState == EffectEnableState::Enabling) {
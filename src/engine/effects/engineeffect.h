@@ -11,6 +11,7 @@
 #include "effects/backends/effectprocessor.h"
 #include "effects/effectsmanager.h"
 #include "engine/channelhandle.h"
+#include "engine/effects/engineeffectcpuload.h"
 #include "engine/effects/engineeffectparameter.h"
 #include "engine/effects/groupfeaturestate.h"
 #include "engine/effects/message.h"
@@ -24,10 +25,10 @@
 class EngineEffect final : public EffectsRequestHandler {
   public:
     /// Called in main thread by EffectSlot
-    EngineEffect(EffectManifestPointer pManifest,
+    EngineEffect(const QString& group,
+            EffectManifestPointer pManifest,
             EffectsBackendManagerPointer pBackendManager,
             const QSet<ChannelHandleAndGroup>& activeInputChannels,
-            const QSet<ChannelHandleAndGroup>& registeredInputChannels,
             const QSet<ChannelHandleAndGroup>& registeredOutputChannels);
     /// Called in main thread by EffectSlot
     ~EngineEffect();
@@ -65,7 +66,15 @@ class EngineEffect final : public EffectsRequestHandler {
     }
 
     SINT getGroupDelayFrames() {
-        return m_pProcessor->getGroupDelayFrames();
+        // The delay of oversampled effects is counted in oversampled frames
+        return m_pProcessor->getGroupDelayFrames() / m_oversamplingFactor +
+                m_oversamplingLatencyFrames;
+    }
+
+    /// Called in audio thread once per callback, even if the effect
+    /// has not been processed
+    void updateCpuLoad() {
+        m_cpuLoad.update();
     }
 
   private:
@@ -75,8 +84,11 @@ class EngineEffect final : public EffectsRequestHandler {
 
     EffectManifestPointer m_pManifest;
     std::unique_ptr<EffectProcessor> m_pProcessor;
-    ChannelHandleMap<ChannelHandleMap<EffectEnableState>> m_effectEnableStateForChannelMatrix;
+    ChannelHandleMatrix<EffectEnableState> m_effectEnableStateForChannelMatrix;
     bool m_effectRampsFromDry;
+    const int m_oversamplingFactor;
+    const SINT m_oversamplingLatencyFrames;
+    EngineEffectCpuLoad m_cpuLoad;
     // Must not be modified after construction.
     QVector<EngineEffectParameterPointer> m_parameters;
     QMap<QString, EngineEffectParameterPointer> m_parametersById;
@@ -4,25 +4,16 @@
 #include "util/defs.h"
 #include "util/sample.h"
 
-EngineEffectChain::EngineEffectChain(const QString& group,
-        const QSet<ChannelHandleAndGroup>& registeredInputChannels,
-        const QSet<ChannelHandleAndGroup>& registeredOutputChannels)
+EngineEffectChain::EngineEffectChain(const QString& group)
         : m_group(group),
           m_enableState(EffectEnableState::Enabled),
           m_mixMode(EffectChainMixMode::DrySlashWet),
           m_dMix(0),
           m_buffer1(MAX_BUFFER_LEN),
-          m_buffer2(MAX_BUFFER_LEN) {
+          m_buffer2(MAX_BUFFER_LEN),
+          m_cpuLoad(ConfigKey(group, QStringLiteral("cpu_load"))) {
     // Try to prevent memory allocation.
     m_effects.reserve(256);
-
-    for (const ChannelHandleAndGroup& inputChannel : registeredInputChannels) {
-        ChannelHandleMap<ChannelStatus> outputChannelMap;
-        for (const ChannelHandleAndGroup& outputChannel : registeredOutputChannels) {
-            outputChannelMap.insert(outputChannel.handle(), ChannelStatus());
-        }
-        m_chainStatusForChannelMatrix.insert(inputChannel.handle(), outputChannelMap);
-    }
 }
 
 EngineEffectChain::~EngineEffectChain() {
@@ -151,7 +142,7 @@ bool EngineEffectChain::enableForInputChannel(ChannelHandle inputHandle,
     if (kEffectDebugOutput) {
         qDebug() << "EngineEffectChain::enableForInputChannel" << this << inputHandle;
     }
-    auto& outputMap = m_chainStatusForChannelMatrix[inputHandle];
+    auto outputMap = m_chainStatusForChannelMatrix.row(inputHandle);
     for (auto&& outputChannelStatus : outputMap) {
         VERIFY_OR_DEBUG_ASSERT(outputChannelStatus.enableState !=
                 EffectEnableState::Enabled) {
@@ -181,7 +172,7 @@ bool EngineEffectChain::enableForInputChannel(ChannelHandle inputHandle,
 }
 
 bool EngineEffectChain::disableForInputChannel(ChannelHandle inputHandle) {
-    auto& outputMap = m_chainStatusForChannelMatrix[inputHandle];
+    auto outputMap = m_chainStatusForChannelMatrix.row(inputHandle);
     for (auto&& outputChannelStatus : outputMap) {
         if (outputChannelStatus.enableState != EffectEnableState::Disabled) {
             outputChannelStatus.enableState = EffectEnableState::Disabling;
@@ -204,12 +195,11 @@ void EngineEffectChain::deleteStatesForInputChannel(const ChannelHandle inputCha
     // EffectProcessorImpl::processChannel will try to run
     // with an EffectState that has already been deleted and cause a crash.
     // Refer to https://bugs.launchpad.net/mixxx/+bug/1741213
-    // NOTE: ChannelHandleMap is like a map in that it associates an object with
-    // a ChannelHandle key, but it actually backed by a QVarLengthArray, not a
-    // QMap. So it is okay that m_chainStatusForChannelMatrix may be
+    // NOTE: ChannelHandleMatrix is backed by an array that is allocated on
+    // construction. So it is okay that m_chainStatusForChannelMatrix may be
     // accessed concurrently in the audio engine thread in process(),
     // enableForInputChannel(), or disableForInputChannel().
-    auto& outputMap = m_chainStatusForChannelMatrix[inputChannel];
+    auto outputMap = m_chainStatusForChannelMatrix.row(inputChannel);
     for (auto&& outputChannelStatus : outputMap) {
         outputChannelStatus.enableState = EffectEnableState::Disabled;
     }
@@ -223,10 +213,21 @@ void EngineEffectChain::deleteStatesForInputChannel(const ChannelHandle inputCha
 EngineEffectChain::ChannelStatus& EngineEffectChain::getChannelStatus(
         const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle) {
-    ChannelStatus& status = m_chainStatusForChannelMatrix[inputHandle][outputHandle];
+    ChannelStatus& status = m_chainStatusForChannelMatrix(inputHandle, outputHandle);
     return status;
 }
 
+bool EngineEffectChain::isEnabledForChannel(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) {
+    return getChannelStatus(inputHandle, outputHandle).enableState !=
+            EffectEnableState::Disabled;
+}
+
+SINT EngineEffectChain::getGroupDelayFrames(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) {
+    return getChannelStatus(inputHandle, outputHandle).groupDelayFrames;
+}
+
 bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle,
         CSAMPLE* pIn,
@@ -242,7 +243,7 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
     // appropriately, for example the Echo effect clears its internal buffer for the channel
     // when it gets the intermediate disabling signal.
 
-    ChannelStatus& channelStatus = m_chainStatusForChannelMatrix[inputHandle][outputHandle];
+    ChannelStatus& channelStatus = m_chainStatusForChannelMatrix(inputHandle, outputHandle);
     EffectEnableState effectiveChainEnableState = channelStatus.enableState;
 
     // If the channel is fully disabled, do not let intermediate
@@ -258,14 +259,16 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
     CSAMPLE lastCallbackMixKnob = channelStatus.oldMixKnob;
 
     bool processingOccured = false;
+    SINT effectChainGroupDelayFrames = 0;
     if (effectiveChainEnableState != EffectEnableState::Disabled) {
+        m_cpuLoad.startMeasurement();
+
         // Ramping code inside the effects need to access the original samples
         // after writing to the output buffer. This requires not to use the same buffer
         // for in and output: Also, ChannelMixer::applyEffectsAndMixChannels
         // requires that the input buffer does not get modified.
         CSAMPLE* pIntermediateInput = pIn;
         CSAMPLE* pIntermediateOutput;
-        SINT effectChainGroupDelayFrames = 0;
         bool firstAddDryToWetEffectProcessed = false;
 
         for (EngineEffect* pEffect : qAsConst(m_effects)) {
@@ -347,9 +350,20 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
                         numSamples);
             }
         }
+
+        m_cpuLoad.stopMeasurement();
+    }
+
+    // The load must also decay if nothing has been processed
+    m_cpuLoad.update();
+    for (EngineEffect* pEffect : qAsConst(m_effects)) {
+        if (pEffect != nullptr) {
+            pEffect->updateCpuLoad();
+        }
     }
 
     channelStatus.oldMixKnob = currentMixKnob;
+    channelStatus.groupDelayFrames = effectChainGroupDelayFrames;
 
     // If the EffectProcessors have been sent a signal for the intermediate
     // enabling/disabling state, set the channel state or chain state
@@ -4,6 +4,7 @@
 #include <QString>
 
 #include "engine/channelhandle.h"
+#include "engine/effects/engineeffectcpuload.h"
 #include "engine/effects/engineeffectsdelay.h"
 #include "engine/effects/groupfeaturestate.h"
 #include "engine/effects/message.h"
@@ -25,9 +26,7 @@ class EngineEffect;
 class EngineEffectChain final : public EffectsRequestHandler {
   public:
     /// called from main thread
-    EngineEffectChain(const QString& group,
-            const QSet<ChannelHandleAndGroup>& registeredInputChannels,
-            const QSet<ChannelHandleAndGroup>& registeredOutputChannels);
+    explicit EngineEffectChain(const QString& group);
     /// called from main thread
     ~EngineEffectChain();
 
@@ -45,6 +44,20 @@ class EngineEffectChain final : public EffectsRequestHandler {
             const unsigned int sampleRate,
             const GroupFeatureState& groupFeatures);
 
+    /// called from audio thread
+    /// Returns false if process() would leave the samples of the input
+    /// channel unchanged for this output, including the intermediate
+    /// enabling and disabling states.
+    bool isEnabledForChannel(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle);
+
+    /// called from audio thread
+    /// Returns the group delay of the effects that were processed for the
+    /// channel and output in the last callback, which the chain compensates
+    /// for its dry signal only.
+    SINT getGroupDelayFrames(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle);
+
     /// called from main thread
     void deleteStatesForInputChannel(const ChannelHandle channel);
 
@@ -52,10 +65,12 @@ class EngineEffectChain final : public EffectsRequestHandler {
     struct ChannelStatus {
         ChannelStatus()
                 : oldMixKnob(0),
-                  enableState(EffectEnableState::Disabled) {
+                  enableState(EffectEnableState::Disabled),
+                  groupDelayFrames(0) {
         }
         CSAMPLE oldMixKnob;
         EffectEnableState enableState;
+        SINT groupDelayFrames;
     };
 
     QString debugString() const {
@@ -69,8 +84,8 @@ class EngineEffectChain final : public EffectsRequestHandler {
             EffectStatesMapArray* statesForEffectsInChain);
     bool disableForInputChannel(ChannelHandle inputHandle);
 
-    // Gets or creates a ChannelStatus entry in m_channelStatus for the provided
-    // handle.
+    // Gets the ChannelStatus entry in m_chainStatusForChannelMatrix for the
+    // provided handles.
     ChannelStatus& getChannelStatus(const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle);
 
@@ -81,8 +96,10 @@ class EngineEffectChain final : public EffectsRequestHandler {
     QList<EngineEffect*> m_effects;
     mixxx::SampleBuffer m_buffer1;
     mixxx::SampleBuffer m_buffer2;
-    ChannelHandleMap<ChannelHandleMap<ChannelStatus>> m_chainStatusForChannelMatrix;
+    ChannelHandleMatrix<ChannelStatus> m_chainStatusForChannelMatrix;
     EngineEffectsDelay m_effectsDelay;
+    // Includes the processing of the effects and the mixing of the chain
+    EngineEffectCpuLoad m_cpuLoad;
 
     DISALLOW_COPY_AND_ASSIGN(EngineEffectChain);
 };
@@ -0,0 +1,23 @@
+#include "engine/effects/engineeffectcpuload.h"
+
+namespace {
+
+// Fits the frame rate of widgets that display the load
+constexpr mixxx::Duration kUpdateInterval = mixxx::Duration::fromMillis(33);
+
+} // anonymous namespace
+
+EngineEffectCpuLoad::EngineEffectCpuLoad(const ConfigKey& key)
+        : m_cpuLoad(key) {
+    m_updateTimer.start();
+}
+
+void EngineEffectCpuLoad::update() {
+    const mixxx::Duration interval = m_updateTimer.elapsed();
+    if (interval < kUpdateInterval) {
+        return;
+    }
+    m_cpuLoad.set(m_processingTime.toDoubleSeconds() / interval.toDoubleSeconds());
+    m_processingTime = mixxx::Duration::empty();
+    m_updateTimer.start();
+}
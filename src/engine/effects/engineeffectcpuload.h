@@ -0,0 +1,39 @@
+#pragma once
+
+#include "control/pollingcontrolproxy.h"
+#include "preferences/configobject.h"
+#include "util/duration.h"
+#include "util/performancetimer.h"
+
+/// Measures the share of the real time that is spent for processing an
+/// EngineEffect or EngineEffectChain and publishes it in the control with
+/// the given key, e.g. [EffectRack1_EffectUnit1_Effect1],cpu_load. A value
+/// of 1.0 means that the processing takes as long as the audio it produces.
+///
+/// The measurement is always enabled. Each measured section only costs two
+/// reads of the monotonic clock.
+///
+/// Constructed in the main thread, used in the audio thread.
+class EngineEffectCpuLoad {
+  public:
+    explicit EngineEffectCpuLoad(const ConfigKey& key);
+
+    void startMeasurement() {
+        m_measurementTimer.start();
+    }
+
+    void stopMeasurement() {
+        m_processingTime += m_measurementTimer.elapsed();
+    }
+
+    /// Publishes the load of all measurements since the last update if
+    /// the update interval has passed. Must also be invoked when nothing
+    /// is measured so that the load decays to 0.
+    void update();
+
+  private:
+    PollingControlProxy m_cpuLoad;
+    PerformanceTimer m_measurementTimer;
+    PerformanceTimer m_updateTimer;
+    mixxx::Duration m_processingTime;
+};
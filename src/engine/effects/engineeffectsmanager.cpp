@@ -5,6 +5,14 @@
 #include "util/defs.h"
 #include "util/sample.h"
 
+namespace {
+
+// Limits the time spent in a single callback, e.g. when loading a chain
+// preset. Remaining requests are processed in the next callbacks.
+constexpr int kMaxRequestsPerCallback = 64;
+
+} // anonymous namespace
+
 EngineEffectsManager::EngineEffectsManager(EffectsResponsePipe* pResponsePipe)
         : m_pResponsePipe(pResponsePipe),
           m_buffer1(MAX_BUFFER_LEN),
@@ -18,7 +26,10 @@ EngineEffectsManager::~EngineEffectsManager() {
 
 void EngineEffectsManager::onCallbackStart() {
     EffectsRequest* request = nullptr;
-    while (m_pResponsePipe->readMessage(&request)) {
+    int requestCount = 0;
+    while (requestCount < kMaxRequestsPerCallback &&
+            m_pResponsePipe->readMessage(&request)) {
+        ++requestCount;
         EffectsResponse response(*request);
         bool processed = false;
         switch (request->type) {
@@ -155,6 +166,47 @@ void EngineEffectsManager::processPostFaderAndMix(
             newGain);
 }
 
+bool EngineEffectsManager::hasPostFaderEffects(
+        const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) {
+    const auto chainsIt = m_chainsByStage.constFind(SignalProcessingStage::Postfader);
+    if (chainsIt == m_chainsByStage.constEnd()) {
+        return false;
+    }
+    for (EngineEffectChain* pChain : chainsIt.value()) {
+        if (pChain && pChain->isEnabledForChannel(inputHandle, outputHandle)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SINT EngineEffectsManager::getGroupDelayFrames(
+        const ChannelHandle& inputHandle,
+        const ChannelHandle& prefaderOutputHandle,
+        const ChannelHandle& outputHandle) {
+    SINT groupDelayFrames = 0;
+    const auto prefaderChainsIt = m_chainsByStage.constFind(SignalProcessingStage::Prefader);
+    if (prefaderChainsIt != m_chainsByStage.constEnd()) {
+        for (EngineEffectChain* pChain : prefaderChainsIt.value()) {
+            if (pChain) {
+                groupDelayFrames += pChain->getGroupDelayFrames(
+                        inputHandle, prefaderOutputHandle);
+            }
+        }
+    }
+    const auto postfaderChainsIt = m_chainsByStage.constFind(SignalProcessingStage::Postfader);
+    if (postfaderChainsIt != m_chainsByStage.constEnd()) {
+        for (EngineEffectChain* pChain : postfaderChainsIt.value()) {
+            if (pChain) {
+                groupDelayFrames += pChain->getGroupDelayFrames(
+                        inputHandle, outputHandle);
+            }
+        }
+    }
+    return groupDelayFrames;
+}
+
 void EngineEffectsManager::processInner(
         const SignalProcessingStage stage,
         const ChannelHandle& inputHandle,
@@ -166,7 +218,18 @@ void EngineEffectsManager::processInner(
         const GroupFeatureState& groupFeatures,
         const CSAMPLE_GAIN oldGain,
         const CSAMPLE_GAIN newGain) {
-    const QList<EngineEffectChain*>& chains = m_chainsByStage.value(stage);
+    // Don't copy the list, which would modify its shared reference count
+    // for every channel in each callback
+    const auto chainsIt = m_chainsByStage.constFind(stage);
+    if (chainsIt == m_chainsByStage.constEnd()) {
+        if (pIn == pOut) {
+            SampleUtil::applyRampingGain(pIn, oldGain, newGain, numSamples);
+        } else {
+            SampleUtil::addWithRampingGain(pOut, pIn, oldGain, newGain, numSamples);
+        }
+        return;
+    }
+    const QList<EngineEffectChain*>& chains = chainsIt.value();
 
     if (pIn == pOut) {
         // Gain and effects are applied to the buffer in place,
@@ -174,14 +237,13 @@ void EngineEffectsManager::processInner(
         SampleUtil::applyRampingGain(pIn, oldGain, newGain, numSamples);
         for (EngineEffectChain* pChain : chains) {
             if (pChain) {
-                if (pChain->process(inputHandle,
-                            outputHandle,
-                            pIn,
-                            pOut,
-                            numSamples,
-                            sampleRate,
-                            groupFeatures)) {
-                }
+                pChain->process(inputHandle,
+                        outputHandle,
+                        pIn,
+                        pOut,
+                        numSamples,
+                        sampleRate,
+                        groupFeatures);
             }
         }
     } else {
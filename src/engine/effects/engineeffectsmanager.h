@@ -64,6 +64,21 @@ class EngineEffectsManager final : public EffectsRequestHandler {
             const CSAMPLE_GAIN oldGain = CSAMPLE_GAIN_ONE,
             const CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE);
 
+    /// Returns false if none of the postfader EngineEffectChains processes
+    /// the input channel for the output, i.e. if the post fader processing
+    /// only applies the gain.
+    bool hasPostFaderEffects(
+            const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle);
+
+    /// Returns the group delay of all prefader and postfader EngineEffectChains
+    /// that processed the input channel for the output in the last callback.
+    /// The prefader chains are always processed for the main output.
+    SINT getGroupDelayFrames(
+            const ChannelHandle& inputHandle,
+            const ChannelHandle& prefaderOutputHandle,
+            const ChannelHandle& outputHandle);
+
     bool processEffectsRequest(
             EffectsRequest& message,
             EffectsResponsePipe* pResponsePipe) override;
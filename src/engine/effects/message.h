@@ -3,6 +3,7 @@
 #include <QString>
 #include <QVariant>
 #include <QtGlobal>
+#include <atomic>
 
 #include "effects/defs.h"
 #include "effects/effectchainmixmode.h"
@@ -39,7 +40,8 @@ struct EffectsRequest {
     EffectsRequest()
             : type(NUM_REQUEST_TYPES),
               request_id(-1),
-              value(0.0) {
+              value(0.0),
+              consumed(false) {
         pTargetChain = nullptr;
         pTargetEffect = nullptr;
     }
@@ -113,8 +115,12 @@ struct EffectsRequest {
         } SetParameterParameters;
     };
 
-    // Used by SET_EFFECT_PARAMETER.
-    double value;
+    // Used by SET_PARAMETER_PARAMETERS. EffectsMessenger replaces the value
+    // of a queued request instead of sending a new request as long as the
+    // request has not been consumed by the audio thread.
+    std::atomic<double> value;
+    // Set by the audio thread before reading the value
+    std::atomic<bool> consumed;
 };
 
 struct EffectsResponse {
@@ -21,6 +21,7 @@
 #include "engine/controls/quantizecontrol.h"
 #include "engine/controls/ratecontrol.h"
 #include "engine/enginemaster.h"
+#include "engine/enginestagetimings.h"
 #include "engine/engineworkerscheduler.h"
 #include "engine/readaheadmanager.h"
 #include "engine/sync/enginesync.h"
@@ -33,6 +34,7 @@
 #include "util/compatibility/qatomic.h"
 #include "util/defs.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "waveform/visualplayposition.h"
@@ -62,6 +64,34 @@ constexpr SINT kSamplesPerFrame = 2; // Engine buffer uses Stereo frames only
 // Rate at which the playpos slider is updated
 constexpr int kPlaypositionUpdateRate = 15; // updates per second
 
+// The number of callbacks a seek waits for the audio at its target to be
+// read, instead of playing silence after the jump. 0 disables waiting.
+const ConfigKey kSeekDeferralCallbacksConfigKey(
+        QStringLiteral("[Master]"),
+        QStringLiteral("seek_deferral_callbacks"));
+constexpr int kDefaultSeekDeferralCallbacks = 1;
+constexpr int kMaxSeekDeferralCallbacks = 8;
+
+// The frames after the target of a seek that need to be cached to play it
+// without a drop out, which is the size of a chunk to bridge the time until
+// the following chunks have been read.
+constexpr SINT kSeekPrefetchFrames = 8192;
+
+// The frames over which the audio before a seek is crossfaded with the
+// audio after it in pad mode. This is short enough to keep the attack of a
+// retriggered sample and long enough to avoid a click.
+constexpr SINT kPadModeCrossfadeFrames = 32;
+
+int configuredSeekDeferralCallbacks(const UserSettingsPointer& pConfig) {
+    if (!pConfig) {
+        return kDefaultSeekDeferralCallbacks;
+    }
+    return math_clamp(pConfig->getValue<int>(kSeekDeferralCallbacksConfigKey,
+                              kDefaultSeekDeferralCallbacks),
+            0,
+            kMaxSeekDeferralCallbacks);
+}
+
 } // anonymous namespace
 
 EngineBuffer::EngineBuffer(const QString& group,
@@ -97,6 +127,8 @@ EngineBuffer::EngineBuffer(const QString& group,
           m_iSeekPhaseQueued(0),
           m_iEnableSyncQueued(SYNC_REQUEST_NONE),
           m_iSyncModeQueued(static_cast<int>(SyncMode::Invalid)),
+          m_bSyncRequestsDeferred(false),
+          m_maxSeekDeferralCallbacks(configuredSeekDeferralCallbacks(pConfig)),
           m_bPlayAfterLoading(false),
           m_pCrossfadeBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_bCrossfadeReady(false),
@@ -109,7 +141,10 @@ EngineBuffer::EngineBuffer(const QString& group,
     // zero out crossfade buffer
     SampleUtil::clear(m_pCrossfadeBuffer, MAX_BUFFER_LEN);
 
-    m_pReader = new CachingReader(group, pConfig);
+    m_pReader = new CachingReader(group,
+            pConfig,
+            pMixingEngine ? pMixingEngine->getCachingReaderSharedCache() : nullptr,
+            pMixingEngine ? pMixingEngine->getCachingReaderDiskCache() : nullptr);
     connect(m_pReader, &CachingReader::trackLoading,
             this, &EngineBuffer::slotTrackLoading,
             Qt::DirectConnection);
@@ -119,6 +154,11 @@ EngineBuffer::EngineBuffer(const QString& group,
     connect(m_pReader, &CachingReader::trackLoadFailed,
             this, &EngineBuffer::slotTrackLoadFailed,
             Qt::DirectConnection);
+    connect(m_pReader,
+            &CachingReader::provisionalReplayGainChanged,
+            this,
+            &EngineBuffer::provisionalReplayGainChanged,
+            Qt::DirectConnection);
 
     // Play button
     m_playButton = new ControlPushButton(ConfigKey(m_group, "play"));
@@ -173,6 +213,11 @@ EngineBuffer::EngineBuffer(const QString& group,
     m_pRepeat = new ControlPushButton(ConfigKey(m_group, "repeat"));
     m_pRepeat->setButtonMode(ControlPushButton::TOGGLE);
 
+    // Pad mode starts the playback and plays the audio after seeks without
+    // fading it in over the whole buffer, for triggering samplers
+    m_pPadMode = new ControlPushButton(ConfigKey(m_group, "pad_mode"));
+    m_pPadMode->setButtonMode(ControlPushButton::TOGGLE);
+
     m_pSampleRate = new ControlProxy("[Master]", "samplerate", this);
 
     m_pTrackSamples = new ControlObject(ConfigKey(m_group, "track_samples"));
@@ -196,6 +241,8 @@ EngineBuffer::EngineBuffer(const QString& group,
     addControl(m_pLoopingControl);
 
     m_pEngineSync = pMixingEngine->getEngineSync();
+    m_pScalerTime = pMixingEngine->getStageTimings()->addStage(
+            group, QStringLiteral("scaler"));
 
     m_pSyncControl = new SyncControl(group, pConfig, pChannel, m_pEngineSync);
 
@@ -269,6 +316,16 @@ EngineBuffer::EngineBuffer(const QString& group,
     m_pScaleST = new EngineBufferScaleST(m_pReadAheadManager);
     m_pScaleRB = new EngineBufferScaleRubberBand(m_pReadAheadManager);
     slotKeylockEngineChanged(m_pKeylockEngine->get());
+    m_pKeylockMultiThreading = new ControlProxy("[Master]", "keylock_multithreading", this);
+    m_pKeylockMultiThreading->connectValueChanged(this,
+            &EngineBuffer::slotKeylockMultiThreadingChanged,
+            Qt::DirectConnection);
+    slotKeylockMultiThreadingChanged(m_pKeylockMultiThreading->get());
+    m_pScalerInterpolation = new ControlProxy("[Master]", "scaler_interpolation", this);
+    m_pScalerInterpolation->connectValueChanged(this,
+            &EngineBuffer::slotScalerInterpolationChanged,
+            Qt::DirectConnection);
+    slotScalerInterpolationChanged(m_pScalerInterpolation->get());
     m_pScaleVinyl = m_pScaleLinear;
     m_pScale = m_pScaleVinyl;
     m_pScale->clear();
@@ -310,6 +367,7 @@ EngineBuffer::~EngineBuffer() {
 
     delete m_pSlipButton;
     delete m_pRepeat;
+    delete m_pPadMode;
     delete m_pSampleRate;
 
     delete m_pTrackLoaded;
@@ -512,6 +570,10 @@ bool EngineBuffer::isReverse() const {
     return m_reverse_old;
 }
 
+bool EngineBuffer::isPadModeEnabled() const {
+    return m_pPadMode->toBool();
+}
+
 // WARNING: Always called from the EngineWorker thread pool
 void EngineBuffer::slotTrackLoading() {
     // Pause EngineBuffer from processing frames
@@ -818,6 +880,26 @@ void EngineBuffer::slotKeylockEngineChanged(double dIndex) {
     }
 }
 
+void EngineBuffer::slotKeylockMultiThreadingChanged(double value) {
+    m_pScaleRB->setMultiThreaded(value > 0.0);
+}
+
+void EngineBuffer::slotScalerInterpolationChanged(double value) {
+    const auto mode = static_cast<EngineBufferScaleLinear::InterpolationMode>(
+            static_cast<int>(value));
+    switch (mode) {
+    case EngineBufferScaleLinear::InterpolationMode::Linear:
+    case EngineBufferScaleLinear::InterpolationMode::Cubic:
+    case EngineBufferScaleLinear::InterpolationMode::Sinc:
+        m_pScaleLinear->setInterpolationMode(mode);
+        break;
+    default:
+        m_pScaleLinear->setInterpolationMode(
+                EngineBufferScaleLinear::kDefaultInterpolationMode);
+        break;
+    }
+}
+
 void EngineBuffer::processTrackLocked(
         CSAMPLE* pOutput, const int iBufferSize, mixxx::audio::SampleRate sampleRate) {
     ScopedTimer t("EngineBuffer::process_pauselock");
@@ -915,6 +997,16 @@ void EngineBuffer::processTrackLocked(
         }
     }
 
+    if (m_pScaleRB->isEngineChangePending()) {
+        // The other RubberBand engine is preallocated and primed by clear(),
+        // so it is crossfaded like a change of the scaler
+        if (m_pScale == m_pScaleRB && m_speed_old != 0.0) {
+            readToCrossfadeBuffer(iBufferSize);
+        }
+        m_pScaleRB->clear();
+        m_bScalerChanged = true;
+    }
+
     if (speed != 0.0) {
         // Do not switch scaler when we have no transport
         enableIndependentPitchTempoScaling(useIndependentPitchAndTempoScaling,
@@ -1037,7 +1129,11 @@ void EngineBuffer::processTrackLocked(
     // If the buffer is not paused, then scale the audio.
     if (!bCurBufferPaused) {
         // Perform scaling of Reader buffer into buffer.
-        const auto framesRead = m_pScale->scaleBuffer(pOutput, iBufferSize);
+        double framesRead;
+        {
+            ScopedStageTimer scalerTimer(m_pScalerTime);
+            framesRead = m_pScale->scaleBuffer(pOutput, iBufferSize);
+        }
 
         // TODO(XXX): The result framesRead might not be an integer value.
         // Converting to samples here does not make sense. All positional
@@ -1060,8 +1156,12 @@ void EngineBuffer::processTrackLocked(
         if (m_bCrossfadeReady) {
             // Bring pOutput with the new parameters in and fade out the old one,
             // stored with the old parameters in m_pCrossfadeBuffer
+            const int crossfadeSamples = m_pPadMode->toBool()
+                    ? math_min(iBufferSize,
+                              static_cast<int>(kPadModeCrossfadeFrames * kSamplesPerFrame))
+                    : iBufferSize;
             SampleUtil::linearCrossfadeBuffersIn(
-                    pOutput, m_pCrossfadeBuffer, iBufferSize);
+                    pOutput, m_pCrossfadeBuffer, crossfadeSamples);
         }
         // Note: we do not fade here if we pass the end or the start of
         // the track in reverse direction
@@ -1174,6 +1274,10 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
 
     m_pSyncControl->updateAudible();
 
+    // The reader of a moving deck must keep up with the playback, a new
+    // track should be loaded as soon as possible
+    m_pReader->setUrgent(bTrackLoading || m_rate_old != 0);
+
     m_iLastBufferSize = iBufferSize;
     m_bCrossfadeReady = false;
 }
@@ -1208,7 +1312,18 @@ void EngineBuffer::processSlip(int iBufferSize) {
     }
 }
 
+bool EngineBuffer::isSyncIndependent() const {
+    return m_pSyncControl->getSyncMode() == SyncMode::None &&
+            atomicLoadRelaxed(m_iEnableSyncQueued) == SYNC_REQUEST_NONE &&
+            atomicLoadRelaxed(m_iSyncModeQueued) == static_cast<int>(SyncMode::Invalid) &&
+            atomicLoadRelaxed(m_iSeekPhaseQueued) == 0 &&
+            atomicLoadRelaxed(m_pChannelToCloneFrom) == nullptr;
+}
+
 void EngineBuffer::processSyncRequests() {
+    if (m_bSyncRequestsDeferred) {
+        return;
+    }
     SyncRequestQueued enable_request =
             static_cast<SyncRequestQueued>(
                     m_iEnableSyncQueued.fetchAndStoreRelease(SYNC_REQUEST_NONE));
@@ -1238,7 +1353,11 @@ void EngineBuffer::processSyncRequests() {
 void EngineBuffer::processSeek(bool paused) {
     m_previousBufferSeek = false;
     // Check if we are cloning another channel before doing any seeking.
-    EngineChannel* pChannel = m_pChannelToCloneFrom.fetchAndStoreRelaxed(nullptr);
+    // Cloning and phase seeks access other decks and are deferred while
+    // processed concurrently.
+    EngineChannel* pChannel = m_bSyncRequestsDeferred
+            ? nullptr
+            : m_pChannelToCloneFrom.fetchAndStoreRelaxed(nullptr);
     if (pChannel) {
         seekCloneBuffer(pChannel->getEngineBuffer());
     }
@@ -1249,12 +1368,16 @@ void EngineBuffer::processSeek(bool paused) {
     mixxx::audio::FramePos position = queuedSeek.position;
 
     // Add SEEK_PHASE bit, if any
-    if (m_iSeekPhaseQueued.fetchAndStoreRelease(0)) {
+    const bool phaseSeekQueued = !m_bSyncRequestsDeferred &&
+            m_iSeekPhaseQueued.fetchAndStoreRelease(0);
+    if (phaseSeekQueued) {
         seekType |= SEEK_PHASE;
     }
 
     switch (seekType) {
         case SEEK_NONE:
+            m_seekDeferralCallbacks = 0;
+            m_deferredSeekPosition = mixxx::audio::kInvalidFramePos;
             return;
         case SEEK_PHASE:
             // only adjust phase
@@ -1297,6 +1420,18 @@ void EngineBuffer::processSeek(bool paused) {
                     << "->" << position;
         }
     }
+    // In pad mode the trigger is never delayed. The reader keeps the audio
+    // at the hotcues cached anyway.
+    if (position != m_playPosition && !paused && seekType != SEEK_PHASE &&
+            !m_pPadMode->toBool() && deferSeekUntilCached(position)) {
+        // Retry with the queued seek during the next callback
+        if (phaseSeekQueued) {
+            m_iSeekPhaseQueued = 1;
+        }
+        return;
+    }
+    m_seekDeferralCallbacks = 0;
+    m_deferredSeekPosition = mixxx::audio::kInvalidFramePos;
     if (position != m_playPosition) {
         if (kLogger.traceEnabled()) {
             kLogger.trace() << "EngineBuffer::processSeek" << getGroup() << "Seek to" << position;
@@ -1310,6 +1445,26 @@ void EngineBuffer::processSeek(bool paused) {
     m_queuedSeek.setValue(kNoQueuedSeek);
 }
 
+bool EngineBuffer::deferSeekUntilCached(mixxx::audio::FramePos position) {
+    if (m_seekDeferralCallbacks >= m_maxSeekDeferralCallbacks) {
+        return false;
+    }
+    SINT frame = static_cast<SINT>(position.toLowerFrameBoundary().value());
+    if (m_reverse_old) {
+        frame -= kSeekPrefetchFrames;
+    }
+    if (m_pReader->isFrameRangeCached(frame, kSeekPrefetchFrames)) {
+        return false;
+    }
+    if (kLogger.traceEnabled()) {
+        kLogger.trace() << "EngineBuffer::processSeek" << getGroup()
+                        << "Waiting for the seek target" << position << "to be read";
+    }
+    ++m_seekDeferralCallbacks;
+    m_deferredSeekPosition = position;
+    return true;
+}
+
 void EngineBuffer::postProcess(const int iBufferSize) {
     // The order of events here is very delicate.  It's necessary to update
     // some values before others, because the later updates may require
@@ -1326,7 +1481,8 @@ void EngineBuffer::postProcess(const int iBufferSize) {
         m_pSyncControl->setLocalBpm(localBpm);
         m_pSyncControl->reportPlayerSpeed(m_speed_old, m_scratching_old);
         if (isLeader(mode)) {
-            m_pEngineSync->notifyBeatDistanceChanged(m_pSyncControl, beatDistance);
+            m_pEngineSync->notifyBeatDistanceChanged(m_pSyncControl,
+                    m_pSyncControl->compensateOutputLatency(beatDistance));
         } else if (isFollower(mode)) {
             m_pSyncControl->updateTargetBeatDistance();
         }
@@ -1435,6 +1591,18 @@ void EngineBuffer::hintReader(const double dRate) {
         m_hintList.append(hint);
     }
 
+    // Read the target of a deferred seek before jumping there
+    if (m_deferredSeekPosition.isValid()) {
+        Hint hint;
+        hint.frame = static_cast<SINT>(m_deferredSeekPosition.toLowerFrameBoundary().value());
+        if (m_reverse_old) {
+            hint.frame -= kSeekPrefetchFrames;
+        }
+        hint.frameCount = kSeekPrefetchFrames;
+        hint.type = Hint::Type::CurrentPosition;
+        m_hintList.append(hint);
+    }
+
     for (const auto& pControl: qAsConst(m_engineControls)) {
         pControl->hintReader(&m_hintList);
     }
@@ -1467,6 +1635,14 @@ bool EngineBuffer::isTrackLoaded() const {
     return false;
 }
 
+bool EngineBuffer::isPlaying() const {
+    return m_playButton->toBool();
+}
+
+bool EngineBuffer::isReaderIdle() const {
+    return m_pReader->isIdle();
+}
+
 TrackPointer EngineBuffer::getLoadedTrack() const {
     return m_pCurrentTrack;
 }
@@ -48,6 +48,9 @@ class EngineSync;
 class EngineWorkerScheduler;
 class VisualPlayPosition;
 class EngineMaster;
+namespace mixxx {
+class DurationHistogram;
+} // namespace mixxx
 
 class EngineBuffer : public EngineObject {
      Q_OBJECT
@@ -102,6 +105,9 @@ class EngineBuffer : public EngineObject {
     double getSpeed() const;
     bool getScratching() const;
     bool isReverse() const;
+    /// Pad mode skips the fades over the whole buffer when starting or
+    /// retriggering the playback
+    bool isPadModeEnabled() const;
     /// Returns current bpm value (not thread-safe)
     mixxx::Bpm getBpm() const;
     /// Returns the BPM of the loaded track around the current position (not thread-safe)
@@ -122,6 +128,16 @@ class EngineBuffer : public EngineObject {
     void requestSyncMode(SyncMode mode);
     void requestClonePosition(EngineChannel* pChannel);
 
+    /// Returns true if the next process() call neither accesses EngineSync
+    /// nor any other deck, i.e. if sync is disabled and no sync, phase or
+    /// clone requests are pending. Such decks can be processed in parallel.
+    bool isSyncIndependent() const;
+    /// While deferred, new sync requests that arrive during concurrent
+    /// processing are kept queued until the next callback.
+    void setSyncRequestsDeferred(bool deferred) {
+        m_bSyncRequestsDeferred = deferred;
+    }
+
     // The process methods all run in the audio callback.
     void process(CSAMPLE* pOut, const int iBufferSize);
     void processSlip(int iBufferSize);
@@ -132,6 +148,9 @@ class EngineBuffer : public EngineObject {
     mixxx::audio::FramePos queuedSeekPosition() const;
 
     bool isTrackLoaded() const;
+    bool isPlaying() const;
+    // See CachingReader::isIdle()
+    bool isReaderIdle() const;
     TrackPointer getLoadedTrack() const;
     void ejectTrack();
 
@@ -207,10 +226,15 @@ class EngineBuffer : public EngineObject {
     void slotControlEnd(double);
     void slotControlSeek(double);
     void slotKeylockEngineChanged(double);
+    void slotKeylockMultiThreadingChanged(double);
+    void slotScalerInterpolationChanged(double);
 
   signals:
     void trackLoaded(TrackPointer pNewTrack, TrackPointer pOldTrack);
     void trackLoadFailed(TrackPointer pTrack, const QString& reason);
+    // A loudness estimate for a track without ReplayGain, emitted from the
+    // reader thread
+    void provisionalReplayGainChanged(TrackPointer pTrack, double ratio);
 
   private slots:
     void slotTrackLoading();
@@ -239,6 +263,11 @@ class EngineBuffer : public EngineObject {
 
     void hintReader(const double rate);
 
+    // Returns true if the seek to position is postponed, because the audio
+    // at the position has not been read yet. The old position continues to
+    // play meanwhile, while the reader is hinted to read the new one.
+    bool deferSeekUntilCached(mixxx::audio::FramePos position);
+
     double fractionalPlayposFromAbsolute(mixxx::audio::FramePos position);
 
     void doSeekFractional(double fractionalPos, enum SeekRequest seekType);
@@ -374,6 +403,8 @@ class EngineBuffer : public EngineObject {
     ControlPotmeter* m_playposSlider;
     ControlProxy* m_pSampleRate;
     ControlProxy* m_pKeylockEngine;
+    ControlProxy* m_pKeylockMultiThreading;
+    ControlProxy* m_pScalerInterpolation;
     ControlPushButton* m_pKeylock;
 
     // This ControlProxys is created as parent to this and deleted by
@@ -385,6 +416,7 @@ class EngineBuffer : public EngineObject {
 
     // Whether or not to repeat the track when at the end
     ControlPushButton* m_pRepeat;
+    ControlPushButton* m_pPadMode;
 
     // Fwd and back controls, start and end of track control
     ControlPushButton* m_startButton;
@@ -393,6 +425,8 @@ class EngineBuffer : public EngineObject {
     // Object used to perform waveform scaling (sample rate conversion).  These
     // three pointers may be reassigned depending on configuration and tests.
     EngineBufferScale* m_pScale;
+    // Owned by the EngineStageTimings of the EngineMaster
+    mixxx::DurationHistogram* m_pScalerTime;
     FRIEND_TEST(EngineBufferTest, SlowRubberBand);
     FRIEND_TEST(EngineBufferTest, ResetPitchAdjustUsesLinear);
     FRIEND_TEST(EngineBufferTest, VinylScalerRampZero);
@@ -418,8 +452,14 @@ class EngineBuffer : public EngineObject {
     QAtomicInt m_iSeekPhaseQueued;
     QAtomicInt m_iEnableSyncQueued;
     QAtomicInt m_iSyncModeQueued;
+    bool m_bSyncRequestsDeferred;
     ControlValueAtomic<QueuedSeek> m_queuedSeek;
     bool m_previousBufferSeek = false;
+    // The maximum number of callbacks a seek waits for its target to be read
+    const int m_maxSeekDeferralCallbacks;
+    int m_seekDeferralCallbacks = 0;
+    // The target of a deferred seek that is hinted to the reader
+    mixxx::audio::FramePos m_deferredSeekPosition;
 
     /// Indicates that no seek is queued
     static constexpr QueuedSeek kNoQueuedSeek = {mixxx::audio::kInvalidFramePos, SEEK_NONE};
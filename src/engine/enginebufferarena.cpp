@@ -0,0 +1,95 @@
+#include "engine/enginebufferarena.h"
+
+#include <cstdlib>
+
+#if defined(__LINUX__)
+#include <sys/mman.h>
+#elif defined(__WINDOWS__)
+#include <malloc.h>
+#endif
+
+#include "util/assert.h"
+#include "util/defs.h"
+#include "util/realtimeprofile.h"
+#include "util/sample.h"
+
+namespace {
+
+// The cache line size of current CPUs, which also satisfies the alignment
+// of all vector instruction sets used by SampleUtil
+constexpr std::size_t kBufferAlignment = 64;
+
+constexpr std::size_t kBufferBytes = MAX_BUFFER_LEN * sizeof(CSAMPLE);
+static_assert(kBufferBytes % kBufferAlignment == 0,
+        "The buffers of a block must stay aligned");
+
+#if defined(__LINUX__)
+constexpr std::size_t kHugePageBytes = 2 * 1024 * 1024;
+#endif
+
+CSAMPLE* allocateBlock(std::size_t bytes) {
+    void* pBlock = nullptr;
+#if defined(__LINUX__)
+    const std::size_t alignedBytes =
+            (bytes + kHugePageBytes - 1) / kHugePageBytes * kHugePageBytes;
+    if (posix_memalign(&pBlock, kHugePageBytes, alignedBytes) != 0) {
+        return nullptr;
+    }
+    // Fails harmlessly if transparent huge pages are disabled
+    madvise(pBlock, alignedBytes, MADV_HUGEPAGE);
+#elif defined(__WINDOWS__)
+    pBlock = _aligned_malloc(bytes, kBufferAlignment);
+#else
+    if (posix_memalign(&pBlock, kBufferAlignment, bytes) != 0) {
+        return nullptr;
+    }
+#endif
+    return static_cast<CSAMPLE*>(pBlock);
+}
+
+void freeBlock(CSAMPLE* pBlock) {
+#if defined(__WINDOWS__)
+    _aligned_free(pBlock);
+#else
+    std::free(pBlock);
+#endif
+}
+
+} // anonymous namespace
+
+EngineBufferArena::EngineBufferArena(int buffersPerBlock)
+        : m_buffersPerBlock(buffersPerBlock),
+          m_buffersInLastBlock(buffersPerBlock) {
+    DEBUG_ASSERT(m_buffersPerBlock > 0);
+}
+
+EngineBufferArena::~EngineBufferArena() {
+    for (CSAMPLE* pBlock : m_blocks) {
+        freeBlock(pBlock);
+    }
+    for (CSAMPLE* pBuffer : m_separateBuffers) {
+        SampleUtil::free(pBuffer);
+    }
+}
+
+CSAMPLE* EngineBufferArena::allocate() {
+    if (m_buffersInLastBlock >= m_buffersPerBlock) {
+        const std::size_t blockBytes = kBufferBytes * m_buffersPerBlock;
+        CSAMPLE* pBlock = allocateBlock(blockBytes);
+        VERIFY_OR_DEBUG_ASSERT(pBlock) {
+            // Fall back to a buffer of its own
+            CSAMPLE* pBuffer = SampleUtil::alloc(MAX_BUFFER_LEN);
+            SampleUtil::clear(pBuffer, MAX_BUFFER_LEN);
+            mixxx::RealtimeProfile::lockMemory(pBuffer, kBufferBytes);
+            m_separateBuffers.push_back(pBuffer);
+            return pBuffer;
+        }
+        SampleUtil::clear(pBlock, MAX_BUFFER_LEN * m_buffersPerBlock);
+        mixxx::RealtimeProfile::lockMemory(pBlock, blockBytes);
+        m_blocks.push_back(pBlock);
+        m_buffersInLastBlock = 0;
+    }
+    CSAMPLE* pBuffer = m_blocks.back() + MAX_BUFFER_LEN * m_buffersInLastBlock;
+    ++m_buffersInLastBlock;
+    return pBuffer;
+}
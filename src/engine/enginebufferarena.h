@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "util/class.h"
+#include "util/types.h"
+
+/// Allocates the sample buffers that the engine processes in every callback
+/// from a few large blocks instead of scattering them over the heap. The
+/// buffers are aligned to cache lines and allocated one after another, so
+/// buffers that are allocated together, e.g. the bus buffers and the channel
+/// buffers of EngineMaster, are adjacent in memory.
+///
+/// On Linux the blocks are aligned to huge pages and backed by transparent
+/// huge pages if the kernel allows them, which reduces the TLB misses of
+/// the callback. The blocks are locked by RealtimeProfile like all other
+/// engine buffers.
+class EngineBufferArena final {
+  public:
+    /// Every block holds buffersPerBlock buffers of MAX_BUFFER_LEN samples
+    explicit EngineBufferArena(int buffersPerBlock);
+    ~EngineBufferArena();
+
+    /// Returns a cleared buffer of MAX_BUFFER_LEN samples that is valid
+    /// until the arena is destroyed. Allocates a new block if the last one
+    /// is full, so this must not be called from the audio callback.
+    CSAMPLE* allocate();
+
+  private:
+    const int m_buffersPerBlock;
+    std::vector<CSAMPLE*> m_blocks;
+    int m_buffersInLastBlock;
+    // Allocated individually if a block could not be allocated
+    std::vector<CSAMPLE*> m_separateBuffers;
+
+    DISALLOW_COPY_AND_ASSIGN(EngineBufferArena);
+};
@@ -0,0 +1,196 @@
+#include "engine/enginechannelprocessorpool.h"
+
+#include <QThread>
+#include <algorithm>
+
+#ifdef __LINUX__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "engine/channels/enginechannel.h"
+#include "engine/effects/groupfeaturestate.h"
+#include "engine/enginestagetimings.h"
+#include "util/assert.h"
+#include "util/denormalsarezero.h"
+#include "util/logger.h"
+#include "util/realtimeprofile.h"
+#include "util/rtsafety.h"
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+namespace {
+
+const mixxx::Logger kLogger("EngineChannelProcessorPool");
+
+// The number of busy-wait iterations before yielding the CPU to other
+// threads of the same priority while waiting for the next callback.
+constexpr int kSpinIterationsBeforeYield = 4096;
+
+constexpr std::uint64_t kGenerationShift = 32;
+constexpr std::uint64_t kNumJobsShift = 16;
+constexpr std::uint64_t kIndexMask = 0xFFFF;
+
+inline std::uint32_t generationOf(std::uint64_t state) {
+    return static_cast<std::uint32_t>(state >> kGenerationShift);
+}
+
+inline int numJobsOf(std::uint64_t state) {
+    return static_cast<int>((state >> kNumJobsShift) & kIndexMask);
+}
+
+inline int nextJobOf(std::uint64_t state) {
+    return static_cast<int>(state & kIndexMask);
+}
+
+inline void spinPause() {
+#ifdef __SSE__
+    _mm_pause();
+#endif
+}
+
+} // anonymous namespace
+
+class EngineChannelProcessorPool::WorkerThread final : public QThread {
+  public:
+    WorkerThread(EngineChannelProcessorPool* pPool, int cpu)
+            : m_pPool(pPool),
+              m_cpu(cpu) {
+        setObjectName(QStringLiteral("EngineChannel %1").arg(cpu));
+    }
+
+  protected:
+    void run() override {
+#ifdef __LINUX__
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(m_cpu, &cpuSet);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0) {
+            kLogger.warning() << "Failed to pin" << objectName() << "to CPU" << m_cpu;
+        }
+#endif
+        // Pins to the CPUs of the profile instead, if configured
+        mixxx::RealtimeProfile::applyToCurrentThread(
+                mixxx::RealtimeProfile::Role::EngineWorker, objectName());
+#ifdef __SSE__
+        // Same floating point environment as the callback thread, see
+        // SoundDevicePortAudio::callbackProcessClkRef()
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+#endif
+        std::uint32_t lastGeneration = generationOf(
+                m_pPool->m_state.load(std::memory_order_acquire));
+        int spinIterations = 0;
+        while (!m_pPool->m_quit.load(std::memory_order_relaxed)) {
+            const std::uint32_t generation = generationOf(
+                    m_pPool->m_state.load(std::memory_order_acquire));
+            if (generation == lastGeneration) {
+                if (++spinIterations < kSpinIterationsBeforeYield) {
+                    spinPause();
+                } else {
+                    spinIterations = 0;
+                    QThread::yieldCurrentThread();
+                }
+                continue;
+            }
+            lastGeneration = generation;
+            spinIterations = 0;
+            m_pPool->runJobs();
+        }
+        mixxx::RealtimeProfile::removeThread(objectName());
+    }
+
+  private:
+    EngineChannelProcessorPool* const m_pPool;
+    const int m_cpu;
+};
+
+EngineChannelProcessorPool::EngineChannelProcessorPool(int numThreads)
+        : m_jobs{},
+          m_iBufferSize(0),
+          m_state(0),
+          m_unfinishedJobs(0),
+          m_quit(false) {
+    DEBUG_ASSERT(numThreads >= 0);
+    DEBUG_ASSERT(numThreads <= maxNumThreads());
+    const int numCpus = QThread::idealThreadCount();
+    m_threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        // CPU 0 is left for the callback thread and the OS
+        auto pThread = std::make_unique<WorkerThread>(this, (i + 1) % std::max(numCpus, 1));
+        pThread->start(QThread::TimeCriticalPriority);
+        m_threads.push_back(std::move(pThread));
+    }
+    kLogger.info() << "Started" << numThreads << "worker threads";
+}
+
+EngineChannelProcessorPool::~EngineChannelProcessorPool() {
+    m_quit.store(true);
+    for (const auto& pThread : m_threads) {
+        pThread->wait();
+    }
+}
+
+// static
+int EngineChannelProcessorPool::maxNumThreads() {
+    // Leave one CPU for the callback thread
+    return std::max(QThread::idealThreadCount() - 1, 0);
+}
+
+void EngineChannelProcessorPool::process(
+        const Job* pJobs, int numJobs, int iBufferSize) {
+    VERIFY_OR_DEBUG_ASSERT(numJobs <= kMaxJobs) {
+        numJobs = kMaxJobs;
+    }
+    if (numJobs <= 0) {
+        return;
+    }
+    DEBUG_ASSERT(m_unfinishedJobs.load(std::memory_order_relaxed) == 0);
+    std::copy(pJobs, pJobs + numJobs, m_jobs.begin());
+    m_iBufferSize = iBufferSize;
+    m_unfinishedJobs.store(numJobs, std::memory_order_relaxed);
+
+    // Publish the new generation with all jobs unclaimed
+    const std::uint32_t generation =
+            generationOf(m_state.load(std::memory_order_relaxed)) + 1;
+    m_state.store((static_cast<std::uint64_t>(generation) << kGenerationShift) |
+                    (static_cast<std::uint64_t>(numJobs) << kNumJobsShift),
+            std::memory_order_release);
+
+    // The callback thread does not idle while waiting for the workers
+    runJobs();
+    while (m_unfinishedJobs.load(std::memory_order_acquire) > 0) {
+        spinPause();
+    }
+}
+
+void EngineChannelProcessorPool::runJobs() {
+    std::uint64_t state = m_state.load(std::memory_order_acquire);
+    while (nextJobOf(state) < numJobsOf(state)) {
+        if (m_state.compare_exchange_weak(state,
+                    state + 1,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire)) {
+            runJob(nextJobOf(state));
+            state = m_state.load(std::memory_order_acquire);
+        }
+    }
+}
+
+void EngineChannelProcessorPool::runJob(int jobIndex) {
+    const Job& job = m_jobs[jobIndex];
+    {
+        // Part of the audio callback, also in the worker threads
+        mixxx::RtSafety::ScopedRealtimeSection realtimeSection;
+        ScopedStageTimer timer(job.pProcessTime);
+        job.pChannel->process(job.pBuffer, m_iBufferSize);
+        if (job.pFeatures) {
+            GroupFeatureState features;
+            job.pChannel->collectFeatures(&features);
+            *job.pFeatures = features;
+        }
+    }
+    m_unfinishedJobs.fetch_sub(1, std::memory_order_release);
+}
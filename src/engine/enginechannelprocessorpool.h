@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "util/types.h"
+
+class EngineChannel;
+struct GroupFeatureState;
+namespace mixxx {
+class DurationHistogram;
+} // namespace mixxx
+
+/// A pool of real-time worker threads that process independent
+/// EngineChannels in parallel within a single audio callback.
+///
+/// The workers are started with time critical priority and pinned to
+/// separate CPU cores if supported by the OS. While waiting for the next
+/// callback they spin and never block, allocate memory or lock a mutex.
+/// The callback thread takes part in the processing and returns from
+/// process() after all jobs have been finished, i.e. the subsequent
+/// mixing and effects processing is done on the callback thread as before.
+///
+/// Only EngineChannel::process() and EngineChannel::collectFeatures() are
+/// invoked in parallel. Both must not access any state that is shared with
+/// other channels.
+class EngineChannelProcessorPool final {
+  public:
+    struct Job {
+        EngineChannel* pChannel;
+        CSAMPLE* pBuffer;
+        // Optional, nullptr if features are not needed
+        GroupFeatureState* pFeatures;
+        // Optional, nullptr if the processing time is not recorded
+        mixxx::DurationHistogram* pProcessTime;
+    };
+
+    static constexpr int kMaxJobs = 64;
+
+    explicit EngineChannelProcessorPool(int numThreads);
+    ~EngineChannelProcessorPool();
+
+    /// The number of additional threads, excluding the callback thread
+    int numThreads() const {
+        return static_cast<int>(m_threads.size());
+    }
+
+    /// The maximum reasonable number of threads on this machine
+    static int maxNumThreads();
+
+    /// Processes all jobs and returns after all of them have been
+    /// finished. Must only be called from the engine callback.
+    void process(const Job* pJobs, int numJobs, int iBufferSize);
+
+  private:
+    class WorkerThread;
+
+    // Claims and runs jobs of the current generation until none are left
+    void runJobs();
+
+    void runJob(int jobIndex);
+
+    std::vector<std::unique_ptr<WorkerThread>> m_threads;
+
+    // Only written by the callback thread while no jobs are pending
+    std::array<Job, kMaxJobs> m_jobs;
+    int m_iBufferSize;
+
+    // Combines the generation (upper 32 bits), the number of jobs
+    // (bits 16-31) and the index of the next unclaimed job (bits 0-15).
+    // Workers claim jobs with a compare-and-swap, which guarantees that a
+    // job is never claimed for an outdated generation.
+    alignas(64) std::atomic<std::uint64_t> m_state;
+    alignas(64) std::atomic<int> m_unfinishedJobs;
+    alignas(64) std::atomic<bool> m_quit;
+};
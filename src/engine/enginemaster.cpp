@@ -8,11 +8,16 @@
 #include "control/controlpotmeter.h"
 #include "control/controlpushbutton.h"
 #include "effects/effectsmanager.h"
+#include "engine/bufferscalers/enginebufferscalelinear.h"
+#include "engine/cachingreader/cachingreaderdiskcache.h"
+#include "engine/cachingreader/cachingreadersharedcache.h"
 #include "engine/channelmixer.h"
 #include "engine/channels/enginechannel.h"
 #include "engine/channels/enginedeck.h"
+#include "engine/effects/engineeffectsdelay.h"
 #include "engine/effects/engineeffectsmanager.h"
 #include "engine/enginebuffer.h"
+#include "engine/enginebufferarena.h"
 #include "engine/enginedelay.h"
 #include "engine/enginetalkoverducking.h"
 #include "engine/enginevumeter.h"
@@ -24,10 +29,25 @@
 #include "moc_enginemaster.cpp"
 #include "preferences/usersettings.h"
 #include "util/defs.h"
+#include "util/math.h"
+#include "util/rtsafety.h"
 #include "util/sample.h"
+#include "util/time.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
+namespace {
+
+// The number of decoded chunks that are shared by the readers of all decks.
+// 256 chunks -> 16 MB. The shared cache is disabled if set to 0.
+constexpr int kDefaultNumberOfSharedCachedChunks = 256;
+
+// The 9 bus buffers and the first channels, e.g. 4 decks and 4 samplers,
+// share the first block. 17 buffers -> 10.9 MB per block.
+constexpr int kBuffersPerArenaBlock = 17;
+
+} // anonymous namespace
+
 EngineMaster::EngineMaster(
         UserSettingsPointer pConfig,
         const QString& group,
@@ -36,6 +56,8 @@ EngineMaster::EngineMaster(
         bool bEnableSidechain)
         : m_pChannelHandleFactory(pChannelHandleFactory),
           m_pEngineEffectsManager(pEffectsManager->getEngineEffectsManager()),
+          m_pActiveChannelProcessorPool(nullptr),
+          m_channelProcessorPoolInUse(false),
           m_masterGainOld(0.0),
           m_boothGainOld(0.0),
           m_headphoneMasterGainOld(0.0),
@@ -63,8 +85,10 @@ EngineMaster::EngineMaster(
     m_bBusOutputConnected[EngineChannel::CENTER] = false;
     m_bBusOutputConnected[EngineChannel::RIGHT] = false;
     m_bExternalRecordBroadcastInputConnected = false;
-    m_pWorkerScheduler = new EngineWorkerScheduler(this);
-    m_pWorkerScheduler->start(QThread::HighPriority);
+    m_iBufferSize = 0;
+    m_bufferSizeKernels = SampleUtil::bufferSizeKernels(m_iBufferSize);
+    m_pWorkerScheduler = new EngineWorkerScheduler();
+    pEffectsManager->getBackendManager()->bindWorkers(m_pWorkerScheduler);
 
     // Master sample rate
     m_pMasterSampleRate = new ControlObject(ConfigKey(group, "samplerate"), true, true);
@@ -72,6 +96,8 @@ EngineMaster::EngineMaster(
 
     // Latency control
     m_pMasterLatency = new ControlObject(ConfigKey(group, "latency"), true, true);
+    m_pEffectsLatency = new ControlObject(ConfigKey(group, "effects_latency"), true, true);
+    m_pEffectsLatency->setReadOnly();
     m_pMasterAudioBufferSize = new ControlObject(ConfigKey(group, "audio_buffer_size"));
     m_pAudioLatencyOverloadCount = new ControlObject(ConfigKey(group, "audio_latency_overload_count"), true, true);
     m_pAudioLatencyUsage = new ControlPotmeter(ConfigKey(group, "audio_latency_usage"), 0.0, 0.25);
@@ -87,6 +113,17 @@ EngineMaster::EngineMaster(
 
     // Crossfader
     m_pCrossfader = new ControlPotmeter(ConfigKey(group, "crossfader"), -1., 1.);
+    m_bPreciseCrossfader = pConfig->getValue(
+            ConfigKey("[Mixer Profile]", "PreciseCrossfader"), false);
+    m_crossfaderChangeNanos = 0;
+    m_lastCallbackNanos = 0;
+    if (m_bPreciseCrossfader) {
+        connect(m_pCrossfader,
+                &ControlObject::valueChanged,
+                this,
+                &EngineMaster::slotCrossfaderChanged,
+                Qt::DirectConnection);
+    }
 
     // Balance
     m_pBalance = new ControlPotmeter(ConfigKey(group, "balance"), -1., 1.);
@@ -133,23 +170,17 @@ EngineMaster::EngineMaster(
     m_pTalkoverDucking = new EngineTalkoverDucking(pConfig, group);
 
     // Allocate buffers
-    m_pHead = SampleUtil::alloc(MAX_BUFFER_LEN);
-    m_pMaster = SampleUtil::alloc(MAX_BUFFER_LEN);
-    m_pBooth = SampleUtil::alloc(MAX_BUFFER_LEN);
-    m_pTalkover = SampleUtil::alloc(MAX_BUFFER_LEN);
-    m_pTalkoverHeadphones = SampleUtil::alloc(MAX_BUFFER_LEN);
-    m_pSidechainMix = SampleUtil::alloc(MAX_BUFFER_LEN);
-    SampleUtil::clear(m_pHead, MAX_BUFFER_LEN);
-    SampleUtil::clear(m_pMaster, MAX_BUFFER_LEN);
-    SampleUtil::clear(m_pBooth, MAX_BUFFER_LEN);
-    SampleUtil::clear(m_pTalkover, MAX_BUFFER_LEN);
-    SampleUtil::clear(m_pTalkoverHeadphones, MAX_BUFFER_LEN);
-    SampleUtil::clear(m_pSidechainMix, MAX_BUFFER_LEN);
+    m_pBufferArena = std::make_unique<EngineBufferArena>(kBuffersPerArenaBlock);
+    m_pHead = m_pBufferArena->allocate();
+    m_pMaster = m_pBufferArena->allocate();
+    m_pBooth = m_pBufferArena->allocate();
+    m_pTalkover = m_pBufferArena->allocate();
+    m_pTalkoverHeadphones = m_pBufferArena->allocate();
+    m_pSidechainMix = m_pBufferArena->allocate();
 
     // Setup the output buses
     for (int o = EngineChannel::LEFT; o <= EngineChannel::RIGHT; ++o) {
-        m_pOutputBusBuffers[o] = SampleUtil::alloc(MAX_BUFFER_LEN);
-        SampleUtil::clear(m_pOutputBusBuffers[o], MAX_BUFFER_LEN);
+        m_pOutputBusBuffers[o] = m_pBufferArena->allocate();
     }
 
     // Starts a thread for recording and broadcast
@@ -175,6 +206,55 @@ EngineMaster::EngineMaster(
     m_pKeylockEngine = new ControlObject(ConfigKey(group, "keylock_engine"), true, false, true);
     m_pKeylockEngine->set(pConfig->getValue(ConfigKey(group, "keylock_engine"),
             static_cast<double>(EngineBuffer::defaultKeylockEngine())));
+    // Disabled by default, i.e. the stretchers run on the callback thread
+    m_pKeylockMultiThreading = new ControlObject(
+            ConfigKey(group, "keylock_multithreading"), true, false, true);
+    m_pKeylockMultiThreading->set(pConfig->getValue(
+            ConfigKey(group, "keylock_multithreading"), 0.0));
+    m_pScalerInterpolation = new ControlObject(
+            ConfigKey(group, "scaler_interpolation"), true, false, true);
+    m_pScalerInterpolation->set(pConfig->getValue(ConfigKey(group, "scaler_interpolation"),
+            static_cast<double>(EngineBufferScaleLinear::kDefaultInterpolationMode)));
+
+    // Disabled by default, i.e. all channels are processed by the callback thread
+    m_pChannelProcessingThreads = new ControlObject(
+            ConfigKey(group, "channel_processing_threads"), true, false, true);
+    m_pChannelProcessingThreads->set(pConfig->getValue(
+            ConfigKey(group, "channel_processing_threads"), 0.0));
+    connect(m_pChannelProcessingThreads,
+            &ControlObject::valueChanged,
+            this,
+            &EngineMaster::slotChannelProcessingThreadsChanged);
+    slotChannelProcessingThreadsChanged(m_pChannelProcessingThreads->get());
+
+    m_pStageTimings = std::make_unique<EngineStageTimings>();
+    m_pProcessTime = m_pStageTimings->addStage(group, QStringLiteral("process"));
+    m_pChannelsTime = m_pStageTimings->addStage(group, QStringLiteral("channels"));
+    m_pHeadphoneMixTime = m_pStageTimings->addStage(group, QStringLiteral("headphone_mix"));
+    m_pTalkoverMixTime = m_pStageTimings->addStage(group, QStringLiteral("talkover_mix"));
+    m_pBusMixTime = m_pStageTimings->addStage(group, QStringLiteral("bus_mix"));
+    m_pHeadphoneEffectsTime = m_pStageTimings->addStage(
+            group, QStringLiteral("headphone_effects"));
+    m_pMasterEffectsTime = m_pStageTimings->addStage(group, QStringLiteral("master_effects"));
+    m_pMasterOutputTime = m_pStageTimings->addStage(group, QStringLiteral("master_output"));
+    m_pSidechainTime = m_pStageTimings->addStage(group, QStringLiteral("sidechain"));
+    m_pOutputDelayTime = m_pStageTimings->addStage(group, QStringLiteral("output_delay"));
+
+    const int numberOfSharedCachedChunks = pConfig->getValue<int>(
+            ConfigKey(group, "cached_chunks_shared"),
+            kDefaultNumberOfSharedCachedChunks);
+    if (numberOfSharedCachedChunks > 0) {
+        // Compact chunks only need half of the memory, i.e. twice as many
+        // chunks could be cached with the same amount of memory.
+        const bool compactSharedCachedChunks = pConfig->getValue<bool>(
+                ConfigKey(group, "cached_chunks_shared_compact"),
+                false);
+        m_pCachingReaderSharedCache = std::make_unique<CachingReaderSharedCache>(
+                numberOfSharedCachedChunks,
+                compactSharedCachedChunks);
+    }
+    // Enabled or disabled by the configured size limit on each track load
+    m_pCachingReaderDiskCache = std::make_unique<CachingReaderDiskCache>(pConfig);
 
     // TODO: Make this read only and make EngineMaster decide whether
     // processing the master mix is necessary.
@@ -189,11 +269,20 @@ EngineMaster::EngineMaster(
     m_pHeadphoneEnabled = new ControlObject(ConfigKey(group, "headEnabled"));
     m_pHeadphoneEnabled->setReadOnly();
 
+    // Armed by Auto DJ with the 1-based numbers of the decks
+    m_pTransitionFromDeck = new ControlObject(ConfigKey("[AutoDJ]", "transition_from_deck"));
+    m_pTransitionToDeck = new ControlObject(ConfigKey("[AutoDJ]", "transition_to_deck"));
+    m_pTransitionPosition = new ControlObject(ConfigKey("[AutoDJ]", "transition_position"));
+
     // Note: the EQ Rack is set in EffectsManager::setupDefaults();
 }
 
 EngineMaster::~EngineMaster() {
     //qDebug() << "in ~EngineMaster()";
+    slotChannelProcessingThreadsChanged(0.0);
+    delete m_pChannelProcessingThreads;
+    delete m_pKeylockMultiThreading;
+    delete m_pScalerInterpolation;
     delete m_pKeylockEngine;
     delete m_pCrossfader;
     delete m_pBalance;
@@ -219,6 +308,7 @@ EngineMaster::~EngineMaster() {
     delete m_pEngineSync;
     delete m_pMasterSampleRate;
     delete m_pMasterLatency;
+    delete m_pEffectsLatency;
     delete m_pMasterAudioBufferSize;
     delete m_pAudioLatencyOverloadCount;
     delete m_pAudioLatencyUsage;
@@ -228,26 +318,19 @@ EngineMaster::~EngineMaster() {
     delete m_pBoothEnabled;
     delete m_pMasterMonoMixdown;
     delete m_pMicMonitorMode;
+    delete m_pTransitionFromDeck;
+    delete m_pTransitionToDeck;
+    delete m_pTransitionPosition;
     delete m_pHeadphoneEnabled;
 
-    SampleUtil::free(m_pHead);
-    SampleUtil::free(m_pMaster);
-    SampleUtil::free(m_pBooth);
-    SampleUtil::free(m_pTalkover);
-    SampleUtil::free(m_pTalkoverHeadphones);
-    SampleUtil::free(m_pSidechainMix);
-    for (int o = EngineChannel::LEFT; o <= EngineChannel::RIGHT; o++) {
-        SampleUtil::free(m_pOutputBusBuffers[o]);
-    }
-
     delete m_pWorkerScheduler;
 
     for (int i = 0; i < m_channels.size(); ++i) {
         ChannelInfo* pChannelInfo = m_channels[i];
-        SampleUtil::free(pChannelInfo->m_pBuffer);
         delete pChannelInfo->m_pChannel;
         delete pChannelInfo->m_pVolumeControl;
         delete pChannelInfo->m_pMuteControl;
+        delete pChannelInfo->m_pEffectsDelay;
         delete pChannelInfo;
     }
 }
@@ -268,6 +351,53 @@ const CSAMPLE* EngineMaster::getSidechainBuffer() const {
     return m_pSidechainMix;
 }
 
+void EngineMaster::slotChannelProcessingThreadsChanged(double value) {
+    const int numThreads = math_clamp(static_cast<int>(value),
+            0,
+            EngineChannelProcessorPool::maxNumThreads());
+    if (m_pChannelProcessorPool && m_pChannelProcessorPool->numThreads() == numThreads) {
+        return;
+    }
+    if (!m_pChannelProcessorPool && numThreads == 0) {
+        return;
+    }
+    // Detach the current pool from the callback and wait until it is no
+    // longer used. Both atomics are sequentially consistent, i.e. either
+    // the callback sees the detached pool or we see that it is in use.
+    m_pActiveChannelProcessorPool.store(nullptr);
+    while (m_channelProcessorPoolInUse.load()) {
+        QThread::yieldCurrentThread();
+    }
+    m_pChannelProcessorPool.reset();
+    if (numThreads > 0) {
+        m_pChannelProcessorPool = std::make_unique<EngineChannelProcessorPool>(numThreads);
+        m_pActiveChannelProcessorPool.store(m_pChannelProcessorPool.get());
+    }
+}
+
+void EngineMaster::slotCrossfaderChanged(double value) {
+    Q_UNUSED(value);
+    m_crossfaderChangeNanos.store(mixxx::Time::elapsed().toIntegerNanos(),
+            std::memory_order_relaxed);
+}
+
+unsigned int EngineMaster::crossfaderChangeFrame(unsigned int iFrames) {
+    const qint64 nowNanos = mixxx::Time::elapsed().toIntegerNanos();
+    const qint64 lastCallbackNanos = m_lastCallbackNanos;
+    m_lastCallbackNanos = nowNanos;
+    if (!m_bPreciseCrossfader) {
+        return 0;
+    }
+    const qint64 changeNanos = m_crossfaderChangeNanos.load(std::memory_order_relaxed);
+    if (changeNanos <= lastCallbackNanos || nowNanos <= lastCallbackNanos) {
+        // Not moved during the previous buffer period
+        return 0;
+    }
+    const double position = static_cast<double>(changeNanos - lastCallbackNanos) /
+            (nowNanos - lastCallbackNanos);
+    return math_min(static_cast<unsigned int>(position * iFrames), iFrames);
+}
+
 void EngineMaster::processChannels(int iBufferSize) {
     // Update internal sync lock rate.
     m_pEngineSync->onCallbackStart(m_sampleRate, m_iBufferSize);
@@ -351,11 +481,33 @@ void EngineMaster::processChannels(int iBufferSize) {
         }
     }
 
+    m_channelProcessorPoolInUse.store(true);
+    EngineChannelProcessorPool* pPool = m_pActiveChannelProcessorPool.load();
+    m_parallelChannelJobs.clear();
+
     // Now that the list is built and ordered, do the processing.
     for (int i = activeChannelsStartIndex;
              i < m_activeChannels.size(); ++i) {
         ChannelInfo* pChannelInfo = m_activeChannels[i];
         EngineChannel* pChannel = pChannelInfo->m_pChannel;
+        // The leader and all synchronized decks access the shared state of
+        // EngineSync and are always processed by the callback thread.
+        if (pPool && i > 0 &&
+                m_parallelChannelJobs.size() < EngineChannelProcessorPool::kMaxJobs) {
+            EngineBuffer* pEngineBuffer = pChannel->getEngineBuffer();
+            if (!pEngineBuffer || pEngineBuffer->isSyncIndependent()) {
+                if (pEngineBuffer) {
+                    pEngineBuffer->setSyncRequestsDeferred(true);
+                }
+                m_parallelChannelJobs.append(EngineChannelProcessorPool::Job{
+                        pChannel,
+                        pChannelInfo->m_pBuffer,
+                        m_pEngineEffectsManager ? &pChannelInfo->m_features : nullptr,
+                        pChannelInfo->m_pProcessTime});
+                continue;
+            }
+        }
+        ScopedStageTimer channelTimer(pChannelInfo->m_pProcessTime);
         pChannel->process(pChannelInfo->m_pBuffer, iBufferSize);
 
         // Collect metadata for effects
@@ -366,6 +518,21 @@ void EngineMaster::processChannels(int iBufferSize) {
         }
     }
 
+    // Process all independent channels in parallel. The mixing and the effects
+    // processing are done afterwards on the callback thread.
+    if (pPool && !m_parallelChannelJobs.isEmpty()) {
+        pPool->process(m_parallelChannelJobs.constData(),
+                m_parallelChannelJobs.size(),
+                iBufferSize);
+        for (const auto& job : qAsConst(m_parallelChannelJobs)) {
+            EngineBuffer* pEngineBuffer = job.pChannel->getEngineBuffer();
+            if (pEngineBuffer) {
+                pEngineBuffer->setSyncRequestsDeferred(false);
+            }
+        }
+    }
+    m_channelProcessorPoolInUse.store(false);
+
     // Do internal sync lock post-processing before the other
     // channels.
     // Note, because we call this on the internal clock first,
@@ -383,6 +550,126 @@ void EngineMaster::processChannels(int iBufferSize) {
     }
 }
 
+void EngineMaster::selectSinglePassChannels(bool headphoneEnabled) {
+    m_activeSinglePassChannels.clear();
+    for (int o = EngineChannel::LEFT; o <= EngineChannel::RIGHT; ++o) {
+        auto& busChannels = m_activeBusChannels[o];
+        int numKept = 0;
+        for (ChannelInfo* pChannelInfo : busChannels) {
+            const bool headphones = headphoneEnabled &&
+                    m_activeHeadphoneChannels.contains(pChannelInfo);
+            // The talkover mix applies its gain to the channel buffer in place
+            bool singlePass = !m_activeTalkoverChannels.contains(pChannelInfo);
+            if (singlePass && m_pEngineEffectsManager) {
+                singlePass = !m_pEngineEffectsManager->hasPostFaderEffects(
+                                     pChannelInfo->m_handle, m_masterHandle.handle()) &&
+                        !(headphones &&
+                                m_pEngineEffectsManager->hasPostFaderEffects(
+                                        pChannelInfo->m_handle,
+                                        m_headphoneHandle.handle()));
+            }
+            if (singlePass) {
+                pChannelInfo->m_singlePassHeadphones = headphones;
+                m_activeSinglePassChannels.append(pChannelInfo);
+            } else {
+                busChannels[numKept++] = pChannelInfo;
+            }
+        }
+        busChannels.resize(numKept);
+    }
+
+    int numKept = 0;
+    for (ChannelInfo* pChannelInfo : m_activeHeadphoneChannels) {
+        if (!pChannelInfo->m_singlePassHeadphones ||
+                !m_activeSinglePassChannels.contains(pChannelInfo)) {
+            m_activeHeadphoneChannels[numKept++] = pChannelInfo;
+        }
+    }
+    m_activeHeadphoneChannels.resize(numKept);
+}
+
+void EngineMaster::processTransitionTrigger() {
+    const int fromDeck = static_cast<int>(m_pTransitionFromDeck->get());
+    if (fromDeck <= 0) {
+        return;
+    }
+    const int toDeck = static_cast<int>(m_pTransitionToDeck->get());
+    EngineBuffer* pFromBuffer = nullptr;
+    EngineBuffer* pToBuffer = nullptr;
+    int deck = 0;
+    for (int i = 0; i < m_channels.size(); ++i) {
+        EngineChannel* pChannel = m_channels[i]->m_pChannel;
+        if (!pChannel->isPrimaryDeck()) {
+            continue;
+        }
+        ++deck;
+        if (deck == fromDeck) {
+            pFromBuffer = pChannel->getEngineBuffer();
+        } else if (deck == toDeck) {
+            pToBuffer = pChannel->getEngineBuffer();
+        }
+    }
+    if (!pFromBuffer || !pToBuffer) {
+        return;
+    }
+    // Like Auto DJ, do not start the transition on a seek while paused
+    if (pFromBuffer->isPlaying() &&
+            pFromBuffer->getVisualPlayPos() >= m_pTransitionPosition->get()) {
+        m_pTransitionFromDeck->set(0.0);
+        if (!pToBuffer->isPlaying()) {
+            pToBuffer->slotControlPlayRequest(1.0);
+        }
+    }
+}
+
+void EngineMaster::compensateEffectsLatency() {
+    if (!m_pEngineEffectsManager) {
+        return;
+    }
+    const ChannelHandle& masterHandle = m_masterHandle.handle();
+    SINT maxGroupDelayFrames = 0;
+    // The first entry is null if there is no sync leader, see processChannels()
+    for (ChannelInfo* pChannelInfo : qAsConst(m_activeChannels)) {
+        if (!pChannelInfo) {
+            continue;
+        }
+        maxGroupDelayFrames = math_max(maxGroupDelayFrames,
+                m_pEngineEffectsManager->getGroupDelayFrames(
+                        pChannelInfo->m_handle, masterHandle, masterHandle));
+    }
+    for (ChannelInfo* pChannelInfo : qAsConst(m_activeChannels)) {
+        if (!pChannelInfo) {
+            continue;
+        }
+        const SINT groupDelayFrames = m_pEngineEffectsManager->getGroupDelayFrames(
+                pChannelInfo->m_handle, masterHandle, masterHandle);
+        // The delay is always processed to keep its buffer filled with the
+        // latest samples for the next change
+        pChannelInfo->m_pEffectsDelay->setDelayFrames(
+                maxGroupDelayFrames - groupDelayFrames);
+        pChannelInfo->m_pEffectsDelay->process(pChannelInfo->m_pBuffer, m_iBufferSize);
+    }
+    const double effectsLatencyMillis = m_sampleRate.isValid()
+            ? maxGroupDelayFrames * 1000.0 / m_sampleRate.value()
+            : 0.0;
+    if (m_pEffectsLatency->get() != effectsLatencyMillis) {
+        m_pEffectsLatency->forceSet(effectsLatencyMillis);
+    }
+}
+
+bool EngineMaster::wakeWorkersAndCheckReadersIdle() {
+    // Tracks are loaded from the main thread, which only marks the worker
+    // as ready until the next callback
+    m_pWorkerScheduler->runWorkers();
+    for (int i = 0; i < m_channels.size(); ++i) {
+        EngineBuffer* pBuffer = m_channels[i]->m_pChannel->getEngineBuffer();
+        if (pBuffer && !pBuffer->isReaderIdle()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void EngineMaster::process(const int iBufferSize) {
     static bool haveSetName = false;
     if (!haveSetName) {
@@ -390,13 +677,18 @@ void EngineMaster::process(const int iBufferSize) {
         haveSetName = true;
     }
     //Trace t("EngineMaster::process");
+    mixxx::RtSafety::ScopedRealtimeSection realtimeSection;
+    ScopedStageTimer processTimer(m_pProcessTime);
 
     bool masterEnabled = m_pMasterEnabled->toBool();
     bool boothEnabled = m_pBoothEnabled->toBool();
     bool headphoneEnabled = m_pHeadphoneEnabled->toBool();
 
     m_sampleRate = mixxx::audio::SampleRate::fromDouble(m_pMasterSampleRate->get());
-    m_iBufferSize = iBufferSize;
+    if (iBufferSize != m_iBufferSize) {
+        m_iBufferSize = iBufferSize;
+        m_bufferSizeKernels = SampleUtil::bufferSizeKernels(m_iBufferSize);
+    }
     // TODO: remove assumption of stereo buffer
     constexpr unsigned int kChannels = 2;
     const unsigned int iFrames = iBufferSize / kChannels;
@@ -406,7 +698,19 @@ void EngineMaster::process(const int iBufferSize) {
     }
 
     // Prepare all channels for output
-    processChannels(m_iBufferSize);
+    {
+        ScopedStageTimer stageTimer(m_pChannelsTime);
+        processChannels(m_iBufferSize);
+        compensateEffectsLatency();
+    }
+    processTransitionTrigger();
+
+    // If there is only one channel in the headphone mix, its features are
+    // used for the headphone effects, see below
+    const ChannelInfo* pSoleHeadphoneChannel = m_activeHeadphoneChannels.size() == 1
+            ? m_activeHeadphoneChannels.at(0)
+            : nullptr;
+    selectSinglePassChannels(headphoneEnabled);
 
     // Compute headphone mix
     // Head phone left/right mix
@@ -424,9 +728,11 @@ void EngineMaster::process(const int iBufferSize) {
     m_headphoneGain.setGain(pflMixGainInHeadphones);
 
     if (headphoneEnabled) {
+        ScopedStageTimer stageTimer(m_pHeadphoneMixTime);
         // Process effects and mix PFL channels together for the headphones.
         // Effects will be reprocessed post-fader for the crossfader buses
         // and master mix, so the channel input buffers cannot be modified here.
+        // The single pass channels are mixed in together with the buses.
         ChannelMixer::applyEffectsAndMixChannels(
                 m_headphoneGain,
                 m_activeHeadphoneChannels,
@@ -436,52 +742,35 @@ void EngineMaster::process(const int iBufferSize) {
                 m_iBufferSize,
                 static_cast<int>(m_sampleRate.value()),
                 m_pEngineEffectsManager);
-
-        // Process headphone channel effects
-        if (m_pEngineEffectsManager) {
-            GroupFeatureState headphoneFeatures;
-            // If there is only one channel in the headphone mix, use its features
-            // for effects processing. This allows for previewing how an effect will
-            // sound on a playing deck before turning up the dry/wet knob to make it
-            // audible on the master mix. Without this, the effect would sound different
-            // in headphones than how it would sound if it was enabled on the deck,
-            // for example with tempo synced effects.
-            if (m_activeHeadphoneChannels.size() == 1) {
-                headphoneFeatures = m_activeHeadphoneChannels.at(0)->m_features;
-            }
-            m_pEngineEffectsManager->processPostFaderInPlace(
-                    m_headphoneHandle.handle(),
-                    m_headphoneHandle.handle(),
-                    m_pHead,
-                    m_iBufferSize,
-                    static_cast<int>(m_sampleRate.value()),
-                    headphoneFeatures);
-        }
     }
 
-    // Mix all the talkover enabled channels together.
-    // Effects processing is done in place to avoid unnecessary buffer copying.
-    ChannelMixer::applyEffectsInPlaceAndMixChannels(
-            m_talkoverGain,
-            m_activeTalkoverChannels,
-            &m_channelTalkoverGainCache,
-            m_pTalkover,
-            m_masterHandle.handle(),
-            m_iBufferSize,
-            static_cast<int>(m_sampleRate.value()),
-            m_pEngineEffectsManager);
-
-    // Process effects on all microphones mixed together
     // We have no metadata for mixed effect buses, so use an empty GroupFeatureState.
     GroupFeatureState busFeatures;
-    if (m_pEngineEffectsManager) {
-        m_pEngineEffectsManager->processPostFaderInPlace(
-                m_busTalkoverHandle.handle(),
-                m_masterHandle.handle(),
+
+    {
+        ScopedStageTimer stageTimer(m_pTalkoverMixTime);
+        // Mix all the talkover enabled channels together.
+        // Effects processing is done in place to avoid unnecessary buffer copying.
+        ChannelMixer::applyEffectsInPlaceAndMixChannels(
+                m_talkoverGain,
+                m_activeTalkoverChannels,
+                &m_channelTalkoverGainCache,
                 m_pTalkover,
+                m_masterHandle.handle(),
                 m_iBufferSize,
                 static_cast<int>(m_sampleRate.value()),
-                busFeatures);
+                m_pEngineEffectsManager);
+
+        // Process effects on all microphones mixed together
+        if (m_pEngineEffectsManager) {
+            m_pEngineEffectsManager->processPostFaderInPlace(
+                    m_busTalkoverHandle.handle(),
+                    m_masterHandle.handle(),
+                    m_pTalkover,
+                    m_iBufferSize,
+                    static_cast<int>(m_sampleRate.value()),
+                    busFeatures);
+        }
     }
 
     switch (m_pTalkoverDucking->getMode()) {
@@ -500,6 +789,8 @@ void EngineMaster::process(const int iBufferSize) {
         break;
     }
 
+    const unsigned int crossfaderChangeFrames = crossfaderChangeFrame(iFrames);
+
     // Calculate the crossfader gains for left and right side of the crossfader
     CSAMPLE_GAIN crossfaderLeftGain, crossfaderRightGain;
     EngineXfader::getXfadeGains(m_pCrossfader->get(), m_pXFaderCurve->get(),
@@ -517,40 +808,75 @@ void EngineMaster::process(const int iBufferSize) {
             crossfaderRightGain,
             m_pTalkoverDucking->getGain(m_iBufferSize / 2));
 
-    for (int o = EngineChannel::LEFT; o <= EngineChannel::RIGHT; o++) {
-        ChannelMixer::applyEffectsInPlaceAndMixChannels(m_masterGain,
-                m_activeBusChannels[o],
-                &m_channelMasterGainCache, // no [o] because the old gain follows an orientation switch
-                m_pOutputBusBuffers[o],
-                m_masterHandle.handle(),
-                m_iBufferSize,
-                static_cast<int>(m_sampleRate.value()),
-                m_pEngineEffectsManager);
+    {
+        ScopedStageTimer stageTimer(m_pBusMixTime);
+        for (int o = EngineChannel::LEFT; o <= EngineChannel::RIGHT; o++) {
+            ChannelMixer::applyEffectsInPlaceAndMixChannels(m_masterGain,
+                    m_activeBusChannels[o],
+                    &m_channelMasterGainCache, // no [o] because the old gain follows an orientation switch
+                    m_pOutputBusBuffers[o],
+                    m_masterHandle.handle(),
+                    m_iBufferSize,
+                    static_cast<int>(m_sampleRate.value()),
+                    m_pEngineEffectsManager);
+        }
+        ChannelMixer::mixChannelsInSinglePass(m_masterGain,
+                m_headphoneGain,
+                m_activeSinglePassChannels,
+                &m_channelMasterGainCache,
+                &m_channelHeadphoneGainCache,
+                m_pOutputBusBuffers,
+                headphoneEnabled ? m_pHead : nullptr,
+                m_bufferSizeKernels,
+                crossfaderChangeFrames * kChannels);
+
+        // Process crossfader orientation bus channel effects
+        if (m_pEngineEffectsManager) {
+            m_pEngineEffectsManager->processPostFaderInPlace(
+                    m_busCrossfaderLeftHandle.handle(),
+                    m_masterHandle.handle(),
+                    m_pOutputBusBuffers[EngineChannel::LEFT],
+                    m_iBufferSize,
+                    static_cast<int>(m_sampleRate.value()),
+                    busFeatures);
+            m_pEngineEffectsManager->processPostFaderInPlace(
+                    m_busCrossfaderCenterHandle.handle(),
+                    m_masterHandle.handle(),
+                    m_pOutputBusBuffers[EngineChannel::CENTER],
+                    m_iBufferSize,
+                    static_cast<int>(m_sampleRate.value()),
+                    busFeatures);
+            m_pEngineEffectsManager->processPostFaderInPlace(
+                    m_busCrossfaderRightHandle.handle(),
+                    m_masterHandle.handle(),
+                    m_pOutputBusBuffers[EngineChannel::RIGHT],
+                    m_iBufferSize,
+                    static_cast<int>(m_sampleRate.value()),
+                    busFeatures);
+        }
     }
 
-    // Process crossfader orientation bus channel effects
-    if (m_pEngineEffectsManager) {
-        m_pEngineEffectsManager->processPostFaderInPlace(
-                m_busCrossfaderLeftHandle.handle(),
-                m_masterHandle.handle(),
-                m_pOutputBusBuffers[EngineChannel::LEFT],
-                m_iBufferSize,
-                static_cast<int>(m_sampleRate.value()),
-                busFeatures);
-        m_pEngineEffectsManager->processPostFaderInPlace(
-                m_busCrossfaderCenterHandle.handle(),
-                m_masterHandle.handle(),
-                m_pOutputBusBuffers[EngineChannel::CENTER],
-                m_iBufferSize,
-                static_cast<int>(m_sampleRate.value()),
-                busFeatures);
+    // Process headphone channel effects after all channels have been mixed
+    // into the headphone bus
+    if (headphoneEnabled && m_pEngineEffectsManager) {
+        ScopedStageTimer stageTimer(m_pHeadphoneEffectsTime);
+        GroupFeatureState headphoneFeatures;
+        // If there is only one channel in the headphone mix, use its features
+        // for effects processing. This allows for previewing how an effect will
+        // sound on a playing deck before turning up the dry/wet knob to make it
+        // audible on the master mix. Without this, the effect would sound different
+        // in headphones than how it would sound if it was enabled on the deck,
+        // for example with tempo synced effects.
+        if (pSoleHeadphoneChannel) {
+            headphoneFeatures = pSoleHeadphoneChannel->m_features;
+        }
         m_pEngineEffectsManager->processPostFaderInPlace(
-                m_busCrossfaderRightHandle.handle(),
-                m_masterHandle.handle(),
-                m_pOutputBusBuffers[EngineChannel::RIGHT],
+                m_headphoneHandle.handle(),
+                m_headphoneHandle.handle(),
+                m_pHead,
                 m_iBufferSize,
                 static_cast<int>(m_sampleRate.value()),
-                busFeatures);
+                headphoneFeatures);
     }
 
     if (masterEnabled) {
@@ -583,9 +909,11 @@ void EngineMaster::process(const int iBufferSize) {
             // talkover with master mix
             if (boothEnabled) {
                 CSAMPLE_GAIN boothGain = static_cast<CSAMPLE_GAIN>(m_pBoothGain->get());
-                SampleUtil::copyWithRampingGain(m_pBooth, m_pMaster,
-                                                m_boothGainOld, boothGain,
-                                                m_iBufferSize);
+                m_bufferSizeKernels.copyWithRampingGain(m_pBooth,
+                        m_pMaster,
+                        m_boothGainOld,
+                        boothGain,
+                        m_iBufferSize);
                 m_boothGainOld = boothGain;
             }
 
@@ -596,8 +924,10 @@ void EngineMaster::process(const int iBufferSize) {
 
             // Apply master gain
             CSAMPLE_GAIN master_gain = static_cast<CSAMPLE_GAIN>(m_pMasterGain->get());
-            SampleUtil::applyRampingGain(m_pMaster, m_masterGainOld,
-                                         master_gain, m_iBufferSize);
+            m_bufferSizeKernels.applyRampingGain(m_pMaster,
+                    m_masterGainOld,
+                    master_gain,
+                    m_iBufferSize);
             m_masterGainOld = master_gain;
 
             // Record/broadcast signal is the same as the master output
@@ -625,34 +955,42 @@ void EngineMaster::process(const int iBufferSize) {
             // Copy master mix (with talkover mixed in) to booth output with booth gain
             if (boothEnabled) {
                 CSAMPLE_GAIN boothGain = static_cast<CSAMPLE_GAIN>(m_pBoothGain->get());
-                SampleUtil::copyWithRampingGain(m_pBooth, m_pMaster,
-                                                m_boothGainOld, boothGain,
-                                                m_iBufferSize);
+                m_bufferSizeKernels.copyWithRampingGain(m_pBooth,
+                        m_pMaster,
+                        m_boothGainOld,
+                        boothGain,
+                        m_iBufferSize);
                 m_boothGainOld = boothGain;
             }
 
             // Apply master gain
             CSAMPLE_GAIN master_gain = static_cast<CSAMPLE_GAIN>(m_pMasterGain->get());
-            SampleUtil::applyRampingGain(m_pMaster, m_masterGainOld,
-                                         master_gain, m_iBufferSize);
+            m_bufferSizeKernels.applyRampingGain(m_pMaster,
+                    m_masterGainOld,
+                    master_gain,
+                    m_iBufferSize);
             m_masterGainOld = master_gain;
 
             // Record/broadcast signal is the same as the master output
             if (sidechainMixRequired()) {
                 SampleUtil::copy(m_pSidechainMix, m_pMaster, m_iBufferSize);
             }
-        } else if (configuredMicMonitorMode == MicMonitorMode::DIRECT_MONITOR) {
+        } else if (configuredMicMonitorMode == MicMonitorMode::DIRECT_MONITOR ||
+                configuredMicMonitorMode == MicMonitorMode::SOFTWARE_DIRECT_MONITOR) {
             // Skip mixing talkover with the master and booth outputs
             // if using direct monitoring because it is being mixed in hardware
-            // without the latency of sending the signal into Mixxx for processing.
+            // or by the sound device callback without the latency of sending
+            // the signal through the engine for processing.
             // However, include the talkover mix in the record/broadcast signal.
 
             // Copy master mix to booth output with booth gain
             if (boothEnabled) {
                 CSAMPLE_GAIN boothGain = static_cast<CSAMPLE_GAIN>(m_pBoothGain->get());
-                SampleUtil::copyWithRampingGain(m_pBooth, m_pMaster,
-                                                m_boothGainOld, boothGain,
-                                                m_iBufferSize);
+                m_bufferSizeKernels.copyWithRampingGain(m_pBooth,
+                        m_pMaster,
+                        m_boothGainOld,
+                        boothGain,
+                        m_iBufferSize);
                 m_boothGainOld = boothGain;
             }
 
@@ -668,8 +1006,10 @@ void EngineMaster::process(const int iBufferSize) {
 
             // Apply master gain
             CSAMPLE_GAIN master_gain = static_cast<CSAMPLE_GAIN>(m_pMasterGain->get());
-            SampleUtil::applyRampingGain(m_pMaster, m_masterGainOld,
-                                         master_gain, m_iBufferSize);
+            m_bufferSizeKernels.applyRampingGain(m_pMaster,
+                    m_masterGainOld,
+                    master_gain,
+                    m_iBufferSize);
             m_masterGainOld = master_gain;
             if (sidechainMixRequired()) {
                 SampleUtil::copy(m_pSidechainMix, m_pMaster, m_iBufferSize);
@@ -707,9 +1047,12 @@ void EngineMaster::process(const int iBufferSize) {
         // EngineSideChain::receiveBuffer has copied the input buffer to m_pSidechainMix
         // via before (called by SoundManager::pushInputBuffers())
         if (m_pEngineSideChain) {
+            ScopedStageTimer stageTimer(m_pSidechainTime);
             m_pEngineSideChain->writeSamples(m_pSidechainMix, iFrames);
         }
 
+        ScopedStageTimer masterOutputTimer(m_pMasterOutputTime);
+
         // Process effects that apply to master hardware output only but not
         // record/broadcast signal
         if (m_pEngineEffectsManager) {
@@ -753,16 +1096,19 @@ void EngineMaster::process(const int iBufferSize) {
         SampleUtil::mixStereoToMono(m_pMaster, m_iBufferSize);
     }
 
-    if (masterEnabled) {
-        m_pMasterDelay->process(m_pMaster, m_iBufferSize);
-    } else {
-        SampleUtil::clear(m_pMaster, m_iBufferSize);
-    }
-    if (headphoneEnabled) {
-        m_pHeadDelay->process(m_pHead, m_iBufferSize);
-    }
-    if (boothEnabled) {
-        m_pBoothDelay->process(m_pBooth, m_iBufferSize);
+    {
+        ScopedStageTimer stageTimer(m_pOutputDelayTime);
+        if (masterEnabled) {
+            m_pMasterDelay->process(m_pMaster, m_iBufferSize);
+        } else {
+            SampleUtil::clear(m_pMaster, m_iBufferSize);
+        }
+        if (headphoneEnabled) {
+            m_pHeadDelay->process(m_pHead, m_iBufferSize);
+        }
+        if (boothEnabled) {
+            m_pBoothDelay->process(m_pBooth, m_iBufferSize);
+        }
     }
 
     // We're close to the end of the callback. Wake up the engine worker
@@ -773,6 +1119,7 @@ void EngineMaster::process(const int iBufferSize) {
 void EngineMaster::applyMasterEffects() {
     // Apply master effects
     if (m_pEngineEffectsManager) {
+        ScopedStageTimer stageTimer(m_pMasterEffectsTime);
         GroupFeatureState masterFeatures;
         masterFeatures.has_gain = true;
         masterFeatures.gain = m_pMasterGain->get();
@@ -787,9 +1134,11 @@ void EngineMaster::applyMasterEffects() {
 
 void EngineMaster::processHeadphones(const CSAMPLE_GAIN masterMixGainInHeadphones) {
     // Add master mix to headphones
-    SampleUtil::addWithRampingGain(m_pHead, m_pMaster,
-                                   m_headphoneMasterGainOld,
-                                   masterMixGainInHeadphones, m_iBufferSize);
+    m_bufferSizeKernels.addWithRampingGain(m_pHead,
+            m_pMaster,
+            m_headphoneMasterGainOld,
+            masterMixGainInHeadphones,
+            m_iBufferSize);
     m_headphoneMasterGainOld = masterMixGainInHeadphones;
 
     // If Head Split is enabled, replace the left channel of the pfl buffer
@@ -805,8 +1154,10 @@ void EngineMaster::processHeadphones(const CSAMPLE_GAIN masterMixGainInHeadphone
 
     // Apply headphone gain
     CSAMPLE_GAIN headphoneGain = static_cast<CSAMPLE_GAIN>(m_pHeadGain->get());
-    SampleUtil::applyRampingGain(m_pHead, m_headphoneGainOld,
-                                 headphoneGain, m_iBufferSize);
+    m_bufferSizeKernels.applyRampingGain(m_pHead,
+            m_headphoneGainOld,
+            headphoneGain,
+            m_iBufferSize);
     m_headphoneGainOld = headphoneGain;
 }
 
@@ -823,8 +1174,10 @@ void EngineMaster::addChannel(EngineChannel* pChannel) {
     pChannelInfo->m_pMuteControl = new ControlPushButton(
             ConfigKey(group, "mute"));
     pChannelInfo->m_pMuteControl->setButtonMode(ControlPushButton::POWERWINDOW);
-    pChannelInfo->m_pBuffer = SampleUtil::alloc(MAX_BUFFER_LEN);
-    SampleUtil::clear(pChannelInfo->m_pBuffer, MAX_BUFFER_LEN);
+    pChannelInfo->m_pBuffer = m_pBufferArena->allocate();
+    pChannelInfo->m_pProcessTime = m_pStageTimings->addStage(
+            group, QStringLiteral("process"));
+    pChannelInfo->m_pEffectsDelay = new EngineEffectsDelay();
     m_channels.append(pChannelInfo);
     constexpr GainCache gainCacheDefault = {0, false};
     m_channelHeadphoneGainCache.append(gainCacheDefault);
@@ -840,6 +1193,7 @@ void EngineMaster::addChannel(EngineChannel* pChannel) {
     m_activeBusChannels[EngineChannel::RIGHT].reserve(m_channels.size());
     m_activeHeadphoneChannels.reserve(m_channels.size());
     m_activeTalkoverChannels.reserve(m_channels.size());
+    m_activeSinglePassChannels.reserve(m_channels.size());
 
     EngineBuffer* pBuffer = pChannelInfo->m_pChannel->getEngineBuffer();
     if (pBuffer != nullptr) {
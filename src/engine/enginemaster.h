@@ -2,20 +2,27 @@
 
 #include <QObject>
 #include <QVarLengthArray>
+#include <atomic>
+#include <memory>
 
 #include "audio/types.h"
 #include "control/controlobject.h"
 #include "control/controlpushbutton.h"
 #include "engine/channelhandle.h"
 #include "engine/channels/enginechannel.h"
+#include "engine/enginechannelprocessorpool.h"
 #include "engine/engineobject.h"
+#include "engine/enginestagetimings.h"
 #include "preferences/usersettings.h"
 #include "recording/recordingmanager.h"
 #include "soundio/soundmanager.h"
 #include "soundio/soundmanagerutil.h"
+#include "util/sample.h"
 
 class EngineWorkerScheduler;
 class EngineBuffer;
+class CachingReaderDiskCache;
+class CachingReaderSharedCache;
 class EngineChannel;
 class EngineDeck;
 class EngineFlanger;
@@ -29,7 +36,9 @@ class SyncWorker;
 class GuiTick;
 class EngineSync;
 class EngineTalkoverDucking;
+class EngineBufferArena;
 class EngineDelay;
+class EngineEffectsDelay;
 
 // The number of channels to pre-allocate in various structures in the
 // engine. Prevents memory allocation in EngineMaster::addChannel.
@@ -69,6 +78,13 @@ class EngineMaster : public QObject, public AudioSource {
 
     void process(const int iBufferSize);
 
+    // For driving the engine without a sound device: Wakes the engine
+    // workers that have work ready without waiting for the next process()
+    // and returns false while the reader of a deck still loads a track or
+    // reads requested chunks. Must be called from the thread that calls
+    // process().
+    bool wakeWorkersAndCheckReadersIdle();
+
     // Add an EngineChannel to the mixing engine. This is not thread safe --
     // only call it before the engine has started mixing.
     void addChannel(EngineChannel* pChannel);
@@ -93,6 +109,17 @@ class EngineMaster : public QObject, public AudioSource {
         return m_pEngineSync;
     }
 
+    // The cache of decoded chunks that is shared by the readers of all decks.
+    // Returns nullptr if disabled.
+    CachingReaderSharedCache* getCachingReaderSharedCache() const {
+        return m_pCachingReaderSharedCache.get();
+    }
+
+    // The optional cache of decoded chunks on disk
+    CachingReaderDiskCache* getCachingReaderDiskCache() const {
+        return m_pCachingReaderDiskCache.get();
+    }
+
     // These are really only exposed for tests to use.
     const CSAMPLE* getMasterBuffer() const;
     const CSAMPLE* getBoothBuffer() const;
@@ -106,6 +133,11 @@ class EngineMaster : public QObject, public AudioSource {
         return m_pEngineSideChain;
     }
 
+    /// The processing times of the engine stages, see EngineStageTimings
+    EngineStageTimings* getStageTimings() const {
+        return m_pStageTimings.get();
+    }
+
     CSAMPLE_GAIN getMasterGain(int channelIndex) const;
 
     struct ChannelInfo {
@@ -114,7 +146,10 @@ class EngineMaster : public QObject, public AudioSource {
                   m_pBuffer(NULL),
                   m_pVolumeControl(NULL),
                   m_pMuteControl(NULL),
-                  m_index(index) {
+                  m_pProcessTime(nullptr),
+                  m_pEffectsDelay(nullptr),
+                  m_index(index),
+                  m_singlePassHeadphones(false) {
         }
         ChannelHandle m_handle;
         EngineChannel* m_pChannel;
@@ -122,7 +157,14 @@ class EngineMaster : public QObject, public AudioSource {
         ControlObject* m_pVolumeControl;
         ControlPushButton* m_pMuteControl;
         GroupFeatureState m_features;
+        mixxx::DurationHistogram* m_pProcessTime;
+        // Aligns the channel with the channel that has the highest effect
+        // latency, see compensateEffectsLatency()
+        EngineEffectsDelay* m_pEffectsDelay;
         int m_index;
+        // Whether the single pass mix of the channel includes the
+        // headphone bus, see ChannelMixer::mixChannelsInSinglePass()
+        bool m_singlePassHeadphones;
     };
 
     struct GainCache {
@@ -198,7 +240,11 @@ class EngineMaster : public QObject, public AudioSource {
         // the MASTER_AND_BOOTH mode.
         MASTER = 0,
         DIRECT_MONITOR,
-        MASTER_AND_BOOTH
+        MASTER_AND_BOOTH,
+        // Like DIRECT_MONITOR, but the sound devices mix the microphone inputs
+        // into their own main and booth outputs in their callbacks, see
+        // SoundDevice::mixDirectMonitorInputs()
+        SOFTWARE_DIRECT_MONITOR
     };
 
     template<typename T, unsigned int CAPACITY>
@@ -254,14 +300,50 @@ class EngineMaster : public QObject, public AudioSource {
     ControlObject* m_pHeadphoneEnabled;
     ControlObject* m_pBoothEnabled;
 
+  private slots:
+    void slotChannelProcessingThreadsChanged(double value);
+    // Directly invoked in the thread that moved the crossfader
+    void slotCrossfaderChanged(double value);
+
   private:
+    // Returns the frame of the current buffer, from which on the new
+    // crossfader position is applied. The crossfader changes of the
+    // previous buffer period are applied at the same relative position in
+    // the current buffer, i.e. a fast cut is delayed by a constant buffer
+    // instead of being quantized to the buffer boundaries.
+    unsigned int crossfaderChangeFrame(unsigned int iFrames);
+
     // Processes active channels. The sync lock channel (if any) is processed
-    // first and all others are processed after. Populates m_activeChannels,
+    // first and all others are processed after. Channels that are
+    // independent of each other are processed in parallel if the pool of
+    // channel processing threads is enabled. Populates m_activeChannels,
     // m_activeBusChannels, m_activeHeadphoneChannels, and
     // m_activeTalkoverChannels with each channel that is active for the
     // respective output.
     void processChannels(int iBufferSize);
 
+    // Moves the bus channels that only need their gain applied before
+    // mixing from m_activeBusChannels and m_activeHeadphoneChannels to
+    // m_activeSinglePassChannels. Channels that are also mixed into the
+    // talkover bus or have post fader effects for any of their outputs
+    // are left where they are.
+    void selectSinglePassChannels(bool headphoneEnabled);
+
+    // Starts the playback of the deck that Auto DJ transitions to, as soon as
+    // the deck it transitions from reaches the transition position. This
+    // keeps the transition on time while the main thread is busy, which
+    // handles the crossfader and everything else once it receives the
+    // position update.
+    void processTransitionTrigger();
+
+    // Delays the buffers of the active channels by the difference between
+    // their effect latency and the highest effect latency of all active
+    // channels, so the channels stay aligned in all mixes when effects
+    // with a group delay are toggled. The latencies are those of the last
+    // callback, because the postfader effects are only processed during
+    // mixing. Delay changes are crossfaded by EngineEffectsDelay.
+    void compensateEffectsLatency();
+
     ChannelHandleFactoryPointer m_pChannelHandleFactory;
     void applyMasterEffects();
     void processHeadphones(const CSAMPLE_GAIN masterMixGainInHeadphones);
@@ -283,9 +365,12 @@ class EngineMaster : public QObject, public AudioSource {
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeBusChannels[3];
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeHeadphoneChannels;
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeTalkoverChannels;
+    QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeSinglePassChannels;
 
     mixxx::audio::SampleRate m_sampleRate;
     unsigned int m_iBufferSize;
+    // Selected when m_iBufferSize changes
+    SampleUtil::BufferSizeKernels m_bufferSizeKernels;
 
     // Mixing buffers for each output.
     CSAMPLE* m_pOutputBusBuffers[3];
@@ -298,11 +383,44 @@ class EngineMaster : public QObject, public AudioSource {
     EngineWorkerScheduler* m_pWorkerScheduler;
     EngineSync* m_pEngineSync;
 
+    // Owned by the main thread. The callback only uses the active pool
+    // and signals while it is in use, see slotChannelProcessingThreadsChanged().
+    std::unique_ptr<EngineChannelProcessorPool> m_pChannelProcessorPool;
+    std::atomic<EngineChannelProcessorPool*> m_pActiveChannelProcessorPool;
+    std::atomic<bool> m_channelProcessorPoolInUse;
+    QVarLengthArray<EngineChannelProcessorPool::Job, kPreallocatedChannels>
+            m_parallelChannelJobs;
+    ControlObject* m_pChannelProcessingThreads;
+
+    // Created before any channel is added. The histograms are owned by
+    // m_pStageTimings and filled by the callback.
+    std::unique_ptr<EngineStageTimings> m_pStageTimings;
+    mixxx::DurationHistogram* m_pProcessTime;
+    mixxx::DurationHistogram* m_pChannelsTime;
+    mixxx::DurationHistogram* m_pHeadphoneMixTime;
+    mixxx::DurationHistogram* m_pTalkoverMixTime;
+    mixxx::DurationHistogram* m_pBusMixTime;
+    mixxx::DurationHistogram* m_pHeadphoneEffectsTime;
+    mixxx::DurationHistogram* m_pMasterEffectsTime;
+    mixxx::DurationHistogram* m_pMasterOutputTime;
+    mixxx::DurationHistogram* m_pSidechainTime;
+    mixxx::DurationHistogram* m_pOutputDelayTime;
+
+    // Holds the bus buffers followed by the channel buffers to keep the
+    // working set of the callback together
+    std::unique_ptr<EngineBufferArena> m_pBufferArena;
+
+    // Must outlive all channels, i.e. the CachingReaderWorkers of all decks
+    std::unique_ptr<CachingReaderSharedCache> m_pCachingReaderSharedCache;
+    std::unique_ptr<CachingReaderDiskCache> m_pCachingReaderDiskCache;
+
     ControlObject* m_pMasterGain;
     ControlObject* m_pBoothGain;
     ControlObject* m_pHeadGain;
     ControlObject* m_pMasterSampleRate;
     ControlObject* m_pMasterLatency;
+    // The effect latency that is compensated for all channels in ms
+    ControlObject* m_pEffectsLatency;
     ControlObject* m_pMasterAudioBufferSize;
     ControlObject* m_pAudioLatencyOverloadCount;
     ControlObject* m_pNumMicsConfigured;
@@ -318,6 +436,10 @@ class EngineMaster : public QObject, public AudioSource {
     EngineSideChain* m_pEngineSideChain;
 
     ControlPotmeter* m_pCrossfader;
+    // Precise crossfader cuts, see crossfaderChangeFrame()
+    bool m_bPreciseCrossfader;
+    std::atomic<qint64> m_crossfaderChangeNanos;
+    qint64 m_lastCallbackNanos;
     ControlPotmeter* m_pHeadMix;
     ControlPotmeter* m_pBalance;
     ControlPushButton* m_pXFaderMode;
@@ -326,6 +448,8 @@ class EngineMaster : public QObject, public AudioSource {
     ControlPushButton* m_pXFaderReverse;
     ControlPushButton* m_pHeadSplitEnabled;
     ControlObject* m_pKeylockEngine;
+    ControlObject* m_pKeylockMultiThreading;
+    ControlObject* m_pScalerInterpolation;
 
     PflGainCalculator m_headphoneGain;
     TalkoverGainCalculator m_talkoverGain;
@@ -348,6 +472,10 @@ class EngineMaster : public QObject, public AudioSource {
     ControlObject* m_pMasterMonoMixdown;
     ControlObject* m_pMicMonitorMode;
 
+    ControlObject* m_pTransitionFromDeck;
+    ControlObject* m_pTransitionToDeck;
+    ControlObject* m_pTransitionPosition;
+
     volatile bool m_bBusOutputConnected[3];
     bool m_bExternalRecordBroadcastInputConnected;
 };
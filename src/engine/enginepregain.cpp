@@ -18,6 +18,9 @@ constexpr float kSpeedGainMultiplier = 4.0f;
 constexpr float kMaxTotalGainBySpeed = 0.9f;
 // value to normalize gain to 1 at speed one
 const float kSpeedOneDiv = std::log10((1 * kSpeedGainMultiplier) + 1);
+// The frames over which the volume is faded when starting or stopping with
+// short ramps, which is just enough to avoid a click
+constexpr int kShortStartStopRampFrames = 32;
 } // anonymous namespace
 
 ControlPotmeter* EnginePregain::s_pReplayGainBoost = nullptr;
@@ -29,6 +32,7 @@ EnginePregain::EnginePregain(const QString& group)
           m_dOldSpeed(1.0),
           m_dNonScratchSpeed(1.0),
           m_scratching(false),
+          m_shortStartStopRamps(false),
           m_fPrevGain(1.0),
           m_bSmoothFade(false) {
     m_pPotmeterPregain = new ControlAudioTaperPot(ConfigKey(group, "pregain"), -12, 12, 0.5);
@@ -152,6 +156,12 @@ void EnginePregain::process(CSAMPLE* pInOut, const int iBufferSize) {
         // direction changed, go though zero if scratching
         SampleUtil::applyRampingGain(&pInOut[0], m_fPrevGain, 0, iBufferSize / 2);
         SampleUtil::applyRampingGain(&pInOut[iBufferSize / 2], 0, totalGain, iBufferSize / 2);
+    } else if (m_shortStartStopRamps && totalGain != m_fPrevGain &&
+            (m_fPrevGain == 0 || totalGain == 0)) {
+        // Start or stop with only a short fade
+        const int rampSamples = math_min(iBufferSize, kShortStartStopRampFrames * 2);
+        SampleUtil::applyRampingGain(pInOut, m_fPrevGain, totalGain, rampSamples);
+        SampleUtil::applyGain(&pInOut[rampSamples], totalGain, iBufferSize - rampSamples);
     } else if (totalGain != m_fPrevGain) {
         // Prevent sound wave discontinuities by interpolating from old to new gain.
         SampleUtil::applyRampingGain(pInOut, m_fPrevGain, totalGain, iBufferSize);
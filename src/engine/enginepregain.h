@@ -24,6 +24,13 @@ class EnginePregain : public EngineObject {
     // reversed without a ramp to zero.
     void setSpeedAndScratching(double speed, bool scratching);
 
+    // Starting and stopping the playback fades the volume in and out over
+    // the whole buffer by default. With short ramps only the first frames
+    // are faded, which keeps the attack of triggered samples.
+    void setShortStartStopRamps(bool shortRamps) {
+        m_shortStartStopRamps = shortRamps;
+    }
+
     void process(CSAMPLE* pInOut, const int iBufferSize) override;
 
     void collectFeatures(GroupFeatureState* pGroupFeatures) const override;
@@ -33,6 +40,7 @@ class EnginePregain : public EngineObject {
     double m_dOldSpeed;
     double m_dNonScratchSpeed;
     bool m_scratching;
+    bool m_shortStartStopRamps;
     CSAMPLE_GAIN m_fPrevGain;
     ControlAudioTaperPot* m_pPotmeterPregain;
     ControlObject* m_pTotalGain;
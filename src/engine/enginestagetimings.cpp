@@ -0,0 +1,81 @@
+#include "engine/enginestagetimings.h"
+
+#include "control/controlobject.h"
+#include "moc_enginestagetimings.cpp"
+#include "util/stat.h"
+#include "util/timer.h"
+
+namespace {
+
+constexpr int kPublishIntervalMillis = 1000;
+
+ControlObject* createReadOnlyControl(const QString& group, const QString& item) {
+    auto* pControl = new ControlObject(ConfigKey(group, item));
+    pControl->setReadOnly();
+    return pControl;
+}
+
+} // anonymous namespace
+
+struct EngineStageTimings::Stage {
+    Stage(const QString& group, const QString& name)
+            : p50Tag(group + QChar(',') + name + QStringLiteral(" p50")),
+              p99Tag(group + QChar(',') + name + QStringLiteral(" p99")),
+              maxTag(group + QChar(',') + name + QStringLiteral(" max")),
+              pP50(createReadOnlyControl(group, name + QStringLiteral("_time_p50"))),
+              pP99(createReadOnlyControl(group, name + QStringLiteral("_time_p99"))),
+              pMax(createReadOnlyControl(group, name + QStringLiteral("_time_max"))) {
+    }
+
+    mixxx::DurationHistogram histogram;
+    // The tags are allocated once, see Stat::track()
+    const QString p50Tag;
+    const QString p99Tag;
+    const QString maxTag;
+    const std::unique_ptr<ControlObject> pP50;
+    const std::unique_ptr<ControlObject> pP99;
+    const std::unique_ptr<ControlObject> pMax;
+};
+
+EngineStageTimings::EngineStageTimings(QObject* pParent)
+        : QObject(pParent) {
+    connect(&m_publishTimer,
+            &QTimer::timeout,
+            this,
+            &EngineStageTimings::slotPublish);
+    m_publishTimer.start(kPublishIntervalMillis);
+}
+
+EngineStageTimings::~EngineStageTimings() = default;
+
+mixxx::DurationHistogram* EngineStageTimings::addStage(
+        const QString& group, const QString& name) {
+    m_stages.push_back(std::make_unique<Stage>(group, name));
+    return &m_stages.back()->histogram;
+}
+
+void EngineStageTimings::slotPublish() {
+    for (const auto& pStage : m_stages) {
+        const auto summary = pStage->histogram.takeSummary();
+        if (summary.count == 0) {
+            // Keep the last values of stages that are currently not processed
+            continue;
+        }
+        pStage->pP50->forceSet(summary.p50.toDoubleMicros());
+        pStage->pP99->forceSet(summary.p99.toDoubleMicros());
+        pStage->pMax->forceSet(summary.max.toDoubleMicros());
+
+        Stat::track(pStage->p50Tag,
+                Stat::DURATION_NANOSEC,
+                kDefaultComputeFlags,
+                static_cast<double>(summary.p50.toIntegerNanos()));
+        Stat::track(pStage->p99Tag,
+                Stat::DURATION_NANOSEC,
+                kDefaultComputeFlags,
+                static_cast<double>(summary.p99.toIntegerNanos()));
+        Stat::track(pStage->maxTag,
+                Stat::DURATION_NANOSEC,
+                kDefaultComputeFlags,
+                static_cast<double>(summary.max.toIntegerNanos()));
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <memory>
+#include <vector>
+
+#include "util/durationhistogram.h"
+#include "util/performancetimer.h"
+
+class ControlObject;
+
+/// Collects the processing times of the individual stages of the engine
+/// callback, e.g. the channel processing, the effects or the scaler of each
+/// deck, in lock-free histograms.
+///
+/// Once per second the median, the 99th percentile and the maximum of each
+/// stage are published in microseconds as read-only controls, e.g.
+/// [Master],process_time_p99 or [Channel1],scaler_time_max. In developer
+/// mode they are also reported to the StatsManager.
+class EngineStageTimings : public QObject {
+    Q_OBJECT
+  public:
+    explicit EngineStageTimings(QObject* pParent = nullptr);
+    ~EngineStageTimings() override;
+
+    /// Registers a new stage and the controls
+    /// [group],<name>_time_p50, [group],<name>_time_p99 and
+    /// [group],<name>_time_max.
+    ///
+    /// Must be called from the main thread before the returned histogram
+    /// is used by the engine. The histogram is owned by this object.
+    mixxx::DurationHistogram* addStage(const QString& group, const QString& name);
+
+  private slots:
+    void slotPublish();
+
+  private:
+    struct Stage;
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    QTimer m_publishTimer;
+};
+
+/// Records the time between construction and destruction in a
+/// histogram. Does nothing if the histogram is nullptr.
+class ScopedStageTimer final {
+  public:
+    explicit ScopedStageTimer(mixxx::DurationHistogram* pHistogram)
+            : m_pHistogram(pHistogram) {
+        if (m_pHistogram) {
+            m_timer.start();
+        }
+    }
+    ~ScopedStageTimer() {
+        if (m_pHistogram) {
+            m_pHistogram->record(m_timer.elapsed());
+        }
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+  private:
+    mixxx::DurationHistogram* const m_pHistogram;
+    PerformanceTimer m_timer;
+};
@@ -1,8 +1,10 @@
 #include "engine/enginevumeter.h"
 
+#include "control/controlobject.h"
 #include "control/controlpotmeter.h"
 #include "control/controlproxy.h"
 #include "moc_enginevumeter.cpp"
+#include "util/math.h"
 #include "util/sample.h"
 
 namespace {
@@ -19,23 +21,37 @@ constexpr CSAMPLE kDecaySmoothing = 0.1f;  //.16//.4
 } // namespace
 
 EngineVuMeter::EngineVuMeter(const QString& group)
-        : m_sampleRate("[Master]", "samplerate") {
-    // The VUmeter widget is controlled via a controlpotmeter, which means
-    // that it should react on the setValue(int) signal.
-    m_ctrlVuMeter = new ControlPotmeter(ConfigKey(group, "VuMeter"), 0., 1.);
-    // left channel VU meter
-    m_ctrlVuMeterL = new ControlPotmeter(ConfigKey(group, "VuMeterL"), 0., 1.);
-    // right channel VU meter
-    m_ctrlVuMeterR = new ControlPotmeter(ConfigKey(group, "VuMeterR"), 0., 1.);
-
-    // Used controlpotmeter as the example used it :/ perhaps someone with more
-    // knowledge could use something more suitable...
-    m_ctrlPeakIndicator = new ControlPotmeter(ConfigKey(group, "PeakIndicator"),
-                                              0., 1.);
-    m_ctrlPeakIndicatorL = new ControlPotmeter(ConfigKey(group, "PeakIndicatorL"),
-                                              0., 1.);
-    m_ctrlPeakIndicatorR = new ControlPotmeter(ConfigKey(group, "PeakIndicatorR"),
-                                              0., 1.);
+        // The VUmeter widget is controlled via a controlpotmeter, which means
+        // that it should react on the setValue(int) signal.
+        : m_ctrlVuMeter(new ControlPotmeter(ConfigKey(group, "VuMeter"), 0., 1.)),
+          // left channel VU meter
+          m_ctrlVuMeterL(new ControlPotmeter(ConfigKey(group, "VuMeterL"), 0., 1.)),
+          // right channel VU meter
+          m_ctrlVuMeterR(new ControlPotmeter(ConfigKey(group, "VuMeterR"), 0., 1.)),
+          // Used controlpotmeter as the example used it :/ perhaps someone with more
+          // knowledge could use something more suitable...
+          m_ctrlPeakIndicator(new ControlPotmeter(ConfigKey(group, "PeakIndicator"), 0., 1.)),
+          m_ctrlPeakIndicatorL(new ControlPotmeter(ConfigKey(group, "PeakIndicatorL"), 0., 1.)),
+          m_ctrlPeakIndicatorR(new ControlPotmeter(ConfigKey(group, "PeakIndicatorR"), 0., 1.)),
+          m_ctrlPeakLevelL(new ControlObject(ConfigKey(group, "PeakLevelL"))),
+          m_ctrlPeakLevelR(new ControlObject(ConfigKey(group, "PeakLevelR"))),
+          m_ctrlRmsLevelL(new ControlObject(ConfigKey(group, "RmsLevelL"))),
+          m_ctrlRmsLevelR(new ControlObject(ConfigKey(group, "RmsLevelR"))),
+          m_vuMeter(group, "VuMeter"),
+          m_vuMeterL(group, "VuMeterL"),
+          m_vuMeterR(group, "VuMeterR"),
+          m_peakIndicator(group, "PeakIndicator"),
+          m_peakIndicatorL(group, "PeakIndicatorL"),
+          m_peakIndicatorR(group, "PeakIndicatorR"),
+          m_peakLevelL(group, "PeakLevelL"),
+          m_peakLevelR(group, "PeakLevelR"),
+          m_rmsLevelL(group, "RmsLevelL"),
+          m_rmsLevelR(group, "RmsLevelR"),
+          m_sampleRate("[Master]", "samplerate") {
+    m_ctrlPeakLevelL->setReadOnly();
+    m_ctrlPeakLevelR->setReadOnly();
+    m_ctrlRmsLevelL->setReadOnly();
+    m_ctrlRmsLevelR->setReadOnly();
     // Initialize the calculation:
     reset();
 }
@@ -48,17 +64,27 @@ EngineVuMeter::~EngineVuMeter()
     delete m_ctrlPeakIndicator;
     delete m_ctrlPeakIndicatorL;
     delete m_ctrlPeakIndicatorR;
+    delete m_ctrlPeakLevelL;
+    delete m_ctrlPeakLevelR;
+    delete m_ctrlRmsLevelL;
+    delete m_ctrlRmsLevelR;
 }
 
 void EngineVuMeter::process(CSAMPLE* pIn, const int iBufferSize) {
-    CSAMPLE fVolSumL, fVolSumR;
+    SampleUtil::ChannelLevels levelsL;
+    SampleUtil::ChannelLevels levelsR;
 
     int sampleRate = static_cast<int>(m_sampleRate.get());
 
-    SampleUtil::CLIP_STATUS clipped = SampleUtil::sumAbsPerChannel(&fVolSumL,
-            &fVolSumR, pIn, iBufferSize);
-    m_fRMSvolumeSumL += fVolSumL;
-    m_fRMSvolumeSumR += fVolSumR;
+    // All levels are measured in a single pass over the buffer
+    SampleUtil::CLIP_STATUS clipped = SampleUtil::measureLevelsPerChannel(
+            &levelsL, &levelsR, pIn, iBufferSize);
+    m_fRMSvolumeSumL += levelsL.sumAbs;
+    m_fRMSvolumeSumR += levelsR.sumAbs;
+    m_fSumSquaresL += levelsL.sumSquares;
+    m_fSumSquaresR += levelsR.sumSquares;
+    m_fPeakL = math_max(m_fPeakL, levelsL.peak);
+    m_fPeakR = math_max(m_fPeakR, levelsR.peak);
 
     m_iSamplesCalculated += iBufferSize / 2;
 
@@ -72,47 +98,58 @@ void EngineVuMeter::process(CSAMPLE* pIn, const int iBufferSize) {
         const double epsilon = .0001;
 
         // Since VU meters are a rolling sum of audio, the no-op checks in
-        // ControlObject will not prevent us from causing tons of extra
+        // RealtimeControl will not prevent us from causing tons of extra
         // work. Because of this, we use an epsilon here to be gentle on the GUI
         // and MIDI controllers.
-        if (fabs(m_fRMSvolumeL - m_ctrlVuMeterL->get()) > epsilon) {
-            m_ctrlVuMeterL->set(m_fRMSvolumeL);
+        if (fabs(m_fRMSvolumeL - m_vuMeterL.get()) > epsilon) {
+            m_vuMeterL.set(m_fRMSvolumeL);
         }
-        if (fabs(m_fRMSvolumeR - m_ctrlVuMeterR->get()) > epsilon) {
-            m_ctrlVuMeterR->set(m_fRMSvolumeR);
+        if (fabs(m_fRMSvolumeR - m_vuMeterR.get()) > epsilon) {
+            m_vuMeterR.set(m_fRMSvolumeR);
         }
 
         double fRMSvolume = (m_fRMSvolumeL + m_fRMSvolumeR) / 2.0;
-        if (fabs(fRMSvolume - m_ctrlVuMeter->get()) > epsilon) {
-            m_ctrlVuMeter->set(fRMSvolume);
+        if (fabs(fRMSvolume - m_vuMeter.get()) > epsilon) {
+            m_vuMeter.set(fRMSvolume);
         }
 
+        // Peak and RMS are published once per update interval like the
+        // VU meters, so the listeners are notified at most at display rate.
+        m_peakLevelL.set(m_fPeakL);
+        m_peakLevelR.set(m_fPeakR);
+        m_rmsLevelL.set(std::sqrt(m_fSumSquaresL / m_iSamplesCalculated));
+        m_rmsLevelR.set(std::sqrt(m_fSumSquaresR / m_iSamplesCalculated));
+
         // Reset calculation:
         m_iSamplesCalculated = 0;
         m_fRMSvolumeSumL = 0;
         m_fRMSvolumeSumR = 0;
+        m_fSumSquaresL = 0;
+        m_fSumSquaresR = 0;
+        m_fPeakL = 0;
+        m_fPeakR = 0;
     }
 
     if (clipped & SampleUtil::CLIPPING_LEFT) {
-        m_ctrlPeakIndicatorL->set(1.);
+        m_peakIndicatorL.set(1.);
         m_peakDurationL = kPeakDuration * sampleRate / iBufferSize / 2000;
     } else if (m_peakDurationL <= 0) {
-        m_ctrlPeakIndicatorL->set(0.);
+        m_peakIndicatorL.set(0.);
     } else {
         --m_peakDurationL;
     }
 
     if (clipped & SampleUtil::CLIPPING_RIGHT) {
-        m_ctrlPeakIndicatorR->set(1.);
+        m_peakIndicatorR.set(1.);
         m_peakDurationR = kPeakDuration * sampleRate / iBufferSize / 2000;
     } else if (m_peakDurationR <= 0) {
-        m_ctrlPeakIndicatorR->set(0.);
+        m_peakIndicatorR.set(0.);
     } else {
         --m_peakDurationR;
     }
 
-    m_ctrlPeakIndicator->set(
-            (m_ctrlPeakIndicatorR->toBool() || m_ctrlPeakIndicatorL->toBool())
+    m_peakIndicator.set(
+            (m_peakIndicatorR.toBool() || m_peakIndicatorL.toBool())
                     ? 1.0
                     : 0.0);
 }
@@ -133,18 +170,26 @@ void EngineVuMeter::doSmooth(CSAMPLE &currentVolume, CSAMPLE newVolume)
 }
 
 void EngineVuMeter::reset() {
-    m_ctrlVuMeter->set(0);
-    m_ctrlVuMeterL->set(0);
-    m_ctrlVuMeterR->set(0);
-    m_ctrlPeakIndicator->set(0);
-    m_ctrlPeakIndicatorL->set(0);
-    m_ctrlPeakIndicatorR->set(0);
+    m_vuMeter.set(0);
+    m_vuMeterL.set(0);
+    m_vuMeterR.set(0);
+    m_peakIndicator.set(0);
+    m_peakIndicatorL.set(0);
+    m_peakIndicatorR.set(0);
+    m_peakLevelL.set(0);
+    m_peakLevelR.set(0);
+    m_rmsLevelL.set(0);
+    m_rmsLevelR.set(0);
 
     m_iSamplesCalculated = 0;
     m_fRMSvolumeL = 0;
     m_fRMSvolumeSumL = 0;
     m_fRMSvolumeR = 0;
     m_fRMSvolumeSumR = 0;
+    m_fSumSquaresL = 0;
+    m_fSumSquaresR = 0;
+    m_fPeakL = 0;
+    m_fPeakR = 0;
     m_peakDurationL = 0;
     m_peakDurationR = 0;
 }
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "control/pollingcontrolproxy.h"
+#include "control/realtimecontrol.h"
 #include "engine/engineobject.h"
 
+class ControlObject;
 class ControlPotmeter;
 
 class EngineVuMeter : public EngineObject {
@@ -25,11 +27,34 @@ class EngineVuMeter : public EngineObject {
     CSAMPLE m_fRMSvolumeSumL;
     CSAMPLE m_fRMSvolumeR;
     CSAMPLE m_fRMSvolumeSumR;
+    CSAMPLE m_fSumSquaresL;
+    CSAMPLE m_fSumSquaresR;
+    CSAMPLE m_fPeakL;
+    CSAMPLE m_fPeakR;
     int m_iSamplesCalculated;
 
     ControlPotmeter* m_ctrlPeakIndicator;
     ControlPotmeter* m_ctrlPeakIndicatorL;
     ControlPotmeter* m_ctrlPeakIndicatorR;
+    // Linear sample peak and RMS of each update interval, e.g. for
+    // controllers with level meters in dBFS
+    ControlObject* m_ctrlPeakLevelL;
+    ControlObject* m_ctrlPeakLevelR;
+    ControlObject* m_ctrlRmsLevelL;
+    ControlObject* m_ctrlRmsLevelR;
+
+    // The engine thread only accesses the controls above through these
+    RealtimeControl m_vuMeter;
+    RealtimeControl m_vuMeterL;
+    RealtimeControl m_vuMeterR;
+    RealtimeControl m_peakIndicator;
+    RealtimeControl m_peakIndicatorL;
+    RealtimeControl m_peakIndicatorR;
+    RealtimeControl m_peakLevelL;
+    RealtimeControl m_peakLevelR;
+    RealtimeControl m_rmsLevelL;
+    RealtimeControl m_rmsLevelR;
+
     int m_peakDurationL;
     int m_peakDurationR;
 
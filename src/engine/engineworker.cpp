@@ -2,9 +2,12 @@
 
 #include "engine/engineworkerscheduler.h"
 #include "moc_engineworker.cpp"
+#include "util/realtimeprofile.h"
 
 EngineWorker::EngineWorker()
-    : m_pScheduler(nullptr) {
+    : m_pScheduler(nullptr),
+      m_urgent(false),
+      m_boosted(false) {
     m_notReady.test_and_set();
 }
 
@@ -33,3 +36,13 @@ void EngineWorker::wakeIfReady() {
         m_semaRun.release();
     }
 }
+
+void EngineWorker::updatePriority() {
+    const bool urgent = isUrgent();
+    if (urgent == m_boosted) {
+        return;
+    }
+    m_boosted = urgent;
+    mixxx::RealtimeProfile::setCurrentThreadBoosted(
+            mixxx::RealtimeProfile::Role::ReaderWorker, urgent);
+}
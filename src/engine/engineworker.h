@@ -2,13 +2,17 @@
 
 #include <atomic>
 #include <QObject>
-#include <QSemaphore>
 #include <QThread>
 
+#include "util/rtsemaphore.h"
+
 // EngineWorker is an interface for running background processing work when the
 // audio callback is not active. While the audio callback is active, an
 // EngineWorker can emit its workReady signal, and an EngineWorkerManager will
 // schedule it for running after the audio callback has completed.
+//
+// Each worker runs in its own thread, so a slow worker never delays the
+// others. The scheduler wakes them directly from the audio callback.
 
 class EngineWorkerScheduler;
 
@@ -24,10 +28,28 @@ class EngineWorker : public QThread {
     void workReady();
     void wakeIfReady();
 
+    // Marks the work of this worker as needed for the audio that is played
+    // next, e.g. the reader of a playing deck. Urgent workers are woken
+    // first and may boost the priority of their thread. Called from the
+    // engine callback.
+    void setUrgent(bool urgent) {
+        m_urgent.store(urgent, std::memory_order_relaxed);
+    }
+    bool isUrgent() const {
+        return m_urgent.load(std::memory_order_relaxed);
+    }
+
   protected:
-    QSemaphore m_semaRun;
+    // Boosts the priority of the calling worker thread while the worker is
+    // urgent. Must be called from run().
+    void updatePriority();
+
+    RtSemaphore m_semaRun;
 
   private:
     EngineWorkerScheduler* m_pScheduler;
     std::atomic_flag m_notReady;
+    std::atomic<bool> m_urgent;
+    // Only accessed from the worker thread
+    bool m_boosted;
 };
@@ -3,59 +3,53 @@
 #include <QtDebug>
 
 #include "engine/engineworker.h"
-#include "moc_engineworkerscheduler.cpp"
-#include "util/compatibility/qmutex.h"
-#include "util/event.h"
+#include "util/assert.h"
 
-EngineWorkerScheduler::EngineWorkerScheduler(QObject* pParent)
+EngineWorkerScheduler::EngineWorkerScheduler()
         : m_bWakeScheduler(false),
-          m_bQuit(false) {
-    Q_UNUSED(pParent);
-}
-
-EngineWorkerScheduler::~EngineWorkerScheduler() {
-    m_bQuit = true;
-    m_waitCondition.wakeAll();
-    wait();
+          m_workerCount(0) {
+    for (auto& pWorker : m_workers) {
+        pWorker.store(nullptr, std::memory_order_relaxed);
+    }
 }
 
 void EngineWorkerScheduler::workerReady() {
-    m_bWakeScheduler = true;
+    m_bWakeScheduler.store(true, std::memory_order_relaxed);
 }
 
 void EngineWorkerScheduler::addWorker(EngineWorker* pWorker) {
     DEBUG_ASSERT(pWorker);
-    const auto locker = lockMutex(&m_mutex);
-    m_workers.push_back(pWorker);
+    // Only called from the main thread, so there is a single writer
+    const int index = m_workerCount.load(std::memory_order_relaxed);
+    VERIFY_OR_DEBUG_ASSERT(index < MAX_ENGINE_WORKERS) {
+        qWarning() << "EngineWorkerScheduler: Too many workers";
+        return;
+    }
+    m_workers[index].store(pWorker, std::memory_order_relaxed);
+    m_workerCount.store(index + 1, std::memory_order_release);
 }
 
 void EngineWorkerScheduler::runWorkers() {
-    // Wake the scheduler if we have written a worker-ready message to the
-    // scheduler. There is no race condition in accessing this boolean because
-    // both workerReady and runWorkers are called from the callback thread.
-    if (m_bWakeScheduler) {
-        m_bWakeScheduler = false;
-        m_waitCondition.wakeAll();
+    // Wake the workers if we have written a worker-ready message to the
+    // scheduler. workerReady might be called concurrently by the threads that
+    // process channels in parallel, but all of them have finished before the
+    // callback thread calls runWorkers.
+    if (!m_bWakeScheduler.exchange(false, std::memory_order_relaxed)) {
+        return;
     }
-}
-
-void EngineWorkerScheduler::run() {
-    static const QString tag("EngineWorkerScheduler");
-    while (!m_bQuit) {
-        Event::start(tag);
-        {
-            const auto locker = lockMutex(&m_mutex);
-            for(const auto& pWorker: m_workers) {
-                pWorker->wakeIfReady();
-            }
+    const int workerCount = m_workerCount.load(std::memory_order_acquire);
+    // Wake the urgent workers first, their threads are scheduled before
+    // the others when there are not enough free CPUs
+    for (int i = 0; i < workerCount; ++i) {
+        EngineWorker* pWorker = m_workers[i].load(std::memory_order_relaxed);
+        if (pWorker->isUrgent()) {
+            pWorker->wakeIfReady();
         }
-        Event::end(tag);
-        {
-            const auto lock = lockMutex(&m_mutex);
-            if (!m_bQuit) {
-                // Wait for next runWorkers() call
-                m_waitCondition.wait(&m_mutex); // unlock mutex and wait
-            }
+    }
+    for (int i = 0; i < workerCount; ++i) {
+        EngineWorker* pWorker = m_workers[i].load(std::memory_order_relaxed);
+        if (!pWorker->isUrgent()) {
+            pWorker->wakeIfReady();
         }
     }
 }
@@ -1,10 +1,9 @@
 #pragma once
 
-#include <QMutex>
-#include <QThreadPool>
-#include <QWaitCondition>
+#include <array>
+#include <atomic>
 
-#include "util/fifo.h"
+#include "util/class.h"
 
 // The max engine workers that can be expected to run within a callback
 // (e.g. the max that we will schedule). Must be a power of 2.
@@ -12,27 +11,30 @@
 
 class EngineWorker;
 
-class EngineWorkerScheduler : public QThread {
-    Q_OBJECT
+// Wakes the EngineWorkers that have work ready at the end of the engine
+// callback. Each worker waits on its own RtSemaphore in its own thread, so
+// the callback releases them directly instead of waking an intermediate
+// scheduler thread through a QWaitCondition, which locks a mutex.
+class EngineWorkerScheduler {
   public:
-    EngineWorkerScheduler(QObject* pParent=NULL);
-    virtual ~EngineWorkerScheduler();
+    EngineWorkerScheduler();
 
+    // Workers can be added while the engine is running, but not removed
     void addWorker(EngineWorker* pWorker);
+    // Called from the engine callback
     void runWorkers();
     void workerReady();
 
-  protected:
-    void run();
-
   private:
     // Indicates whether workerReady has been called since the last time
-    // runWorkers was run. This should only be touched from the engine callback.
-    bool m_bWakeScheduler;
+    // runWorkers was run. This should only be touched from the engine callback
+    // and the threads that process channels in parallel during the callback.
+    std::atomic<bool> m_bWakeScheduler;
 
-    std::vector<EngineWorker*> m_workers;
+    // Written from the main thread, read from the engine callback without
+    // locking. A worker is published by incrementing m_workerCount.
+    std::array<std::atomic<EngineWorker*>, MAX_ENGINE_WORKERS> m_workers;
+    std::atomic<int> m_workerCount;
 
-    QWaitCondition m_waitCondition;
-    QMutex m_mutex;
-    volatile bool m_bQuit;
+    DISALLOW_COPY_AND_ASSIGN(EngineWorkerScheduler);
 };
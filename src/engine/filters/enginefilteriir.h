@@ -25,6 +25,47 @@ enum IIRPass {
     IIR_HP2,
 };
 
+// The left and right samples of a frame are filtered together. Both
+// lanes are calculated with the same operations in the same order as
+// a single channel, which allows the compiler to use packed SIMD
+// instructions without changing the results.
+struct IIRStereoSample {
+    double left;
+    double right;
+};
+
+inline IIRStereoSample operator+(IIRStereoSample a, IIRStereoSample b) {
+    return {a.left + b.left, a.right + b.right};
+}
+
+inline IIRStereoSample operator-(IIRStereoSample a, IIRStereoSample b) {
+    return {a.left - b.left, a.right - b.right};
+}
+
+inline IIRStereoSample operator-(IIRStereoSample a) {
+    return {-a.left, -a.right};
+}
+
+inline IIRStereoSample operator*(IIRStereoSample a, double b) {
+    return {a.left * b, a.right * b};
+}
+
+inline IIRStereoSample operator*(double a, IIRStereoSample b) {
+    return {a * b.left, a * b.right};
+}
+
+inline IIRStereoSample& operator+=(IIRStereoSample& a, IIRStereoSample b) {
+    a.left += b.left;
+    a.right += b.right;
+    return a;
+}
+
+inline IIRStereoSample& operator-=(IIRStereoSample& a, IIRStereoSample b) {
+    a.left -= b.left;
+    a.right -= b.right;
+    return a;
+}
+
 
 class EngineFilterIIRBase : public EngineObjectConstIn {
   public:
@@ -83,11 +124,9 @@ class EngineFilterIIR : public EngineFilterIIRBase {
 
     void initBuffers() {
         // Copy the current buffers into the old buffers
-        memcpy(m_oldBuf1, m_buf1, sizeof(m_buf1));
-        memcpy(m_oldBuf2, m_buf2, sizeof(m_buf2));
+        memcpy(m_oldBuf, m_buf, sizeof(m_buf));
         // Set the current buffers to 0
-        memset(m_buf1, 0, sizeof(m_buf1));
-        memset(m_buf2, 0, sizeof(m_buf2));
+        memset(m_buf, 0, sizeof(m_buf));
         m_doRamping = true;
     }
 
@@ -232,63 +271,71 @@ class EngineFilterIIR : public EngineFilterIIRBase {
                          const int iBufferSize) {
         if (!m_doRamping) {
             for (int i = 0; i < iBufferSize; i += 2) {
-                pOutput[i] = static_cast<CSAMPLE>(processSample(m_coef, m_buf1, pIn[i]));
-                pOutput[i + 1] = static_cast<CSAMPLE>(processSample(m_coef, m_buf2, pIn[i + 1]));
+                const IIRStereoSample out = processSample(
+                        m_coef, m_buf, IIRStereoSample{pIn[i], pIn[i + 1]});
+                pOutput[i] = static_cast<CSAMPLE>(out.left);
+                pOutput[i + 1] = static_cast<CSAMPLE>(out.right);
             }
-        } else {
-            double cross_mix = 0.0;
-            double cross_inc = 4.0 / static_cast<double>(iBufferSize);
-            for (int i = 0; i < iBufferSize; i += 2) {
-                // Do a linear cross fade between the output of the old
-                // Filter and the new filter.
-                // The new filter is settled for Input = 0 and it sees
-                // all frequencies of the rectangular start impulse.
-                // Since the group delay, after which the start impulse
-                // has passed is unknown here, we just what the half
-                // iBufferSize until we use the samples of the new filter.
-                // In one of the previous version we have faded the Input
-                // of the new filter but it turns out that this produces
-                // a gain drop due to the filter delay which is more
-                // conspicuous than the settling noise.
-                double old1;
-                double old2;
-                if (!m_doStart) {
-                    // Process old filter, but only if we do not do a fresh start
-                    old1 = static_cast<CSAMPLE>(processSample(m_oldCoef, m_oldBuf1, pIn[i]));
-                    old2 = static_cast<CSAMPLE>(processSample(m_oldCoef, m_oldBuf2, pIn[i + 1]));
-                } else {
-                    if (m_startFromDry) {
-                        old1 = pIn[i];
-                        old2 = pIn[i + 1];
-                    } else {
-                        old1 = 0;
-                        old2 = 0;
-                    }
-                }
-                double new1 = static_cast<CSAMPLE>(processSample(m_coef, m_buf1, pIn[i]));
-                double new2 = static_cast<CSAMPLE>(processSample(m_coef, m_buf2, pIn[i + 1]));
-
-                if (i < iBufferSize / 2) {
-                    pOutput[i] = static_cast<CSAMPLE>(old1);
-                    pOutput[i + 1] = static_cast<CSAMPLE>(old2);
-                } else {
-                    pOutput[i] = static_cast<CSAMPLE>(new1 * cross_mix + old1 * (1.0 - cross_mix));
-                    pOutput[i + 1] = static_cast<CSAMPLE>(
-                            new2 * cross_mix + old2 * (1.0 - cross_mix));
-                    cross_mix += cross_inc;
-                }
+            return;
+        }
+
+        // Do a linear cross fade between the output of the old
+        // Filter and the new filter.
+        // The new filter is settled for Input = 0 and it sees
+        // all frequencies of the rectangular start impulse.
+        // Since the group delay, after which the start impulse
+        // has passed is unknown here, we just what the half
+        // iBufferSize until we use the samples of the new filter.
+        // In one of the previous version we have faded the Input
+        // of the new filter but it turns out that this produces
+        // a gain drop due to the filter delay which is more
+        // conspicuous than the settling noise.
+        const bool processOld = !m_doStart;
+        const bool startFromDry = m_startFromDry;
+        const auto processOldSample = [this, processOld, startFromDry](
+                                              IIRStereoSample in) {
+            if (processOld) {
+                // Process old filter, but only if we do not do a fresh start
+                return processSample(m_oldCoef, m_oldBuf, in);
+            }
+            if (startFromDry) {
+                return in;
             }
-            m_doRamping = false;
-            m_doStart = false;
+            return IIRStereoSample{0, 0};
+        };
+
+        int i = 0;
+        // The output of the new filter is discarded for the first half
+        for (; i < iBufferSize / 2; i += 2) {
+            const IIRStereoSample in{pIn[i], pIn[i + 1]};
+            const IIRStereoSample old = processOldSample(in);
+            processSample(m_coef, m_buf, in);
+            pOutput[i] = static_cast<CSAMPLE>(old.left);
+            pOutput[i + 1] = static_cast<CSAMPLE>(old.right);
+        }
+        double cross_mix = 0.0;
+        const double cross_inc = 4.0 / static_cast<double>(iBufferSize);
+        for (; i < iBufferSize; i += 2) {
+            const IIRStereoSample in{pIn[i], pIn[i + 1]};
+            const IIRStereoSample old = processOldSample(in);
+            const IIRStereoSample out = processSample(m_coef, m_buf, in);
+            // Both outputs are mixed with full precision and rounded once
+            pOutput[i] = static_cast<CSAMPLE>(
+                    out.left * cross_mix + old.left * (1.0 - cross_mix));
+            pOutput[i + 1] = static_cast<CSAMPLE>(
+                    out.right * cross_mix + old.right * (1.0 - cross_mix));
+            cross_mix += cross_inc;
         }
+        m_doRamping = false;
+        m_doStart = false;
     }
 
   protected:
-    inline double processSample(double* coef, double* buf, double val);
+    inline IIRStereoSample processSample(
+            const double* coef, IIRStereoSample* buf, IIRStereoSample val);
     inline void pauseFilterInner() {
         // Set the current buffers to 0
-        memset(m_buf1, 0, sizeof(m_buf1));
-        memset(m_buf2, 0, sizeof(m_buf2));
+        memset(m_buf, 0, sizeof(m_buf));
         m_doRamping = true;
         m_doStart = true;
     }
@@ -297,15 +344,10 @@ class EngineFilterIIR : public EngineFilterIIRBase {
     // Old coefficients needed for ramping
     double m_oldCoef[SIZE + 1];
 
-    // Channel 1 state
-    double m_buf1[SIZE];
-    // Old channel 1 buffer needed for ramping
-    double m_oldBuf1[SIZE];
-
-    // Channel 2 state
-    double m_buf2[SIZE];
-    // Old channel 2 buffer needed for ramping
-    double m_oldBuf2[SIZE];
+    // State of both channels
+    IIRStereoSample m_buf[SIZE];
+    // Old state needed for ramping
+    IIRStereoSample m_oldBuf[SIZE];
 
     // Flag set to true if ramping needs to be done
     bool m_doRamping;
@@ -316,10 +358,9 @@ class EngineFilterIIR : public EngineFilterIIRBase {
 };
 
 template<>
-inline double EngineFilterIIR<2, IIR_LP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<2, IIR_LP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -330,10 +371,9 @@ inline double EngineFilterIIR<2, IIR_LP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<2, IIR_BP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<2, IIR_BP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = -tmp;
@@ -344,10 +384,9 @@ inline double EngineFilterIIR<2, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<2, IIR_HP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<2, IIR_HP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -358,10 +397,9 @@ inline double EngineFilterIIR<2, IIR_HP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<4, IIR_LP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<4, IIR_LP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -377,10 +415,9 @@ inline double EngineFilterIIR<4, IIR_LP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<8, IIR_BP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<8, IIR_BP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     iir = val * coef[0];
@@ -407,10 +444,9 @@ inline double EngineFilterIIR<8, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<4, IIR_HP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<4, IIR_HP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     iir= val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -426,10 +462,9 @@ inline double EngineFilterIIR<4, IIR_HP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<8, IIR_LP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<8, IIR_LP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     iir = val * coef[0];
@@ -456,10 +491,9 @@ inline double EngineFilterIIR<8, IIR_LP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<16, IIR_BP>::processSample(double* coef,
-                                                         double* buf,
-                                                         double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<16, IIR_BP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     buf[7] = buf[8]; buf[8] = buf[9]; buf[9] = buf[10]; buf[10] = buf[11];
@@ -508,10 +542,9 @@ inline double EngineFilterIIR<16, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<8, IIR_HP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<8, IIR_HP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     iir = val * coef[0];
@@ -539,10 +572,9 @@ inline double EngineFilterIIR<8, IIR_HP>::processSample(double* coef,
 
 // IIR_LP and IIR_HP use the same processSample routine
 template<>
-inline double EngineFilterIIR<5, IIR_BP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<5, IIR_BP>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = coef[2] * tmp;
@@ -553,10 +585,9 @@ inline double EngineFilterIIR<5, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<4, IIR_LPMO>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-   double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<4, IIR_LPMO>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+   IIRStereoSample tmp, fir, iir;
    tmp= buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
    iir= val * coef[0];
    iir -= coef[1]*tmp; fir= tmp;
@@ -579,10 +610,9 @@ inline double EngineFilterIIR<4, IIR_LPMO>::processSample(double* coef,
 
 
 template<>
-inline double EngineFilterIIR<4, IIR_HPMO>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-   double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<4, IIR_HPMO>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+   IIRStereoSample tmp, fir, iir;
    tmp= buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
    iir= val * coef[0];
    iir -= coef[1]*tmp; fir= -tmp;
@@ -604,10 +634,9 @@ inline double EngineFilterIIR<4, IIR_HPMO>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<2, IIR_LP2>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<2, IIR_LP2>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -625,10 +654,9 @@ inline double EngineFilterIIR<2, IIR_LP2>::processSample(double* coef,
 
 
 template<>
-inline double EngineFilterIIR<2, IIR_HP2>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+inline IIRStereoSample EngineFilterIIR<2, IIR_HP2>::processSample(
+        const double* coef, IIRStereoSample* buf, IIRStereoSample val) {
+    IIRStereoSample tmp, fir, iir;
     tmp = buf[0];
     iir = val * -coef[0]; // swap gain to be in phase with LP2
     iir -= coef[1] * tmp; fir = -tmp;
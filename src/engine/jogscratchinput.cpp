@@ -0,0 +1,191 @@
+#include "engine/jogscratchinput.h"
+
+#include <QMutexLocker>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace {
+
+// At up to ~3000 MIDI messages per second this holds the movements of more
+// than the longest audio buffer.
+constexpr int kEventFifoSize = 1024;
+
+} // anonymous namespace
+
+// static
+QMutex JogScratchInput::s_instancesMutex;
+// static
+QMap<QString, QWeakPointer<JogScratchInput>> JogScratchInput::s_instances;
+
+// static
+QSharedPointer<JogScratchInput> JogScratchInput::getJogScratchInput(const QString& group) {
+    const QMutexLocker lock(&s_instancesMutex);
+    QSharedPointer<JogScratchInput> pInput = s_instances.value(group);
+    if (pInput.isNull()) {
+        pInput = QSharedPointer<JogScratchInput>(new JogScratchInput());
+        s_instances.insert(group, pInput);
+    }
+    return pInput;
+}
+
+JogScratchInput::JogScratchInput()
+        : m_events(kEventFifoSize),
+          m_firstPoint(0),
+          m_numPoints(0),
+          m_position(0),
+          m_lastEvaluationTime(0),
+          m_lastEvaluatedPosition(0),
+          m_disableTime(0),
+          m_enabled(false),
+          m_disablePending(false),
+          m_rampOnRelease(false),
+          m_evaluationStarted(false) {
+}
+
+void JogScratchInput::enable(mixxx::Duration timestamp) {
+    postEvent(EventType::Enable, 0, timestamp);
+}
+
+void JogScratchInput::move(double seconds, mixxx::Duration timestamp) {
+    postEvent(EventType::Move, seconds, timestamp);
+}
+
+void JogScratchInput::disable(mixxx::Duration timestamp, bool ramp) {
+    postEvent(ramp ? EventType::DisableWithRamp : EventType::Disable, 0, timestamp);
+}
+
+void JogScratchInput::postEvent(EventType type, double seconds, mixxx::Duration timestamp) {
+    const Event event = {type, seconds, timestamp.toIntegerNanos()};
+    // The engine drains the FIFO every callback, it can only run full if the
+    // engine is not running. Dropping movements is fine then.
+    m_events.write(&event, 1);
+}
+
+bool JogScratchInput::process(mixxx::Duration now, double bufferSeconds, double* pRate) {
+    Event event;
+    while (m_events.read(&event, 1) == 1) {
+        applyEvent(event);
+    }
+    if (!m_enabled) {
+        return false;
+    }
+    VERIFY_OR_DEBUG_ASSERT(bufferSeconds > 0) {
+        return false;
+    }
+
+    const double evaluationTime = now.toDoubleSeconds() - kEvaluationDelaySeconds;
+    if (!m_evaluationStarted) {
+        m_lastEvaluationTime = evaluationTime - bufferSeconds;
+        m_evaluationStarted = true;
+    }
+
+    // Using the distance since the last evaluated position, instead of the
+    // position at the last evaluation time, makes sure that movements which
+    // arrive too late for their time span are played in this buffer rather
+    // than being lost.
+    const double position = positionAt(evaluationTime);
+    *pRate = (position - m_lastEvaluatedPosition) / bufferSeconds;
+    m_lastEvaluatedPosition = position;
+    m_lastEvaluationTime = math_max(m_lastEvaluationTime, evaluationTime);
+    dropPointsBefore(m_lastEvaluationTime);
+
+    if (m_disablePending && m_lastEvaluationTime >= m_disableTime) {
+        m_enabled = false;
+        m_disablePending = false;
+    }
+    return true;
+}
+
+void JogScratchInput::applyEvent(const Event& event) {
+    const double time = mixxx::Duration::fromNanos(event.timestampNanos).toDoubleSeconds();
+    switch (event.type) {
+    case EventType::Enable:
+        if (m_enabled) {
+            // Touched again before the release has been played
+            m_disablePending = false;
+            return;
+        }
+        m_enabled = true;
+        m_disablePending = false;
+        m_evaluationStarted = false;
+        m_firstPoint = 0;
+        m_numPoints = 0;
+        m_position = 0;
+        m_lastEvaluatedPosition = 0;
+        addPoint(time, m_position);
+        return;
+    case EventType::Move: {
+        if (!m_enabled) {
+            return;
+        }
+        if (m_numPoints > 0) {
+            const double lastTime = m_points[(m_firstPoint + m_numPoints - 1) % kMaxPoints].time;
+            const double startTime = time - kMaxMovementSeconds;
+            if (startTime > lastTime) {
+                addPoint(startTime, m_position);
+            }
+        }
+        m_position += event.seconds;
+        addPoint(time, m_position);
+        return;
+    }
+    case EventType::Disable:
+    case EventType::DisableWithRamp:
+        if (!m_enabled) {
+            return;
+        }
+        m_disablePending = true;
+        m_disableTime = time;
+        m_rampOnRelease = event.type == EventType::DisableWithRamp;
+        return;
+    }
+    DEBUG_ASSERT(!"unhandled jog scratch event type");
+}
+
+void JogScratchInput::addPoint(double time, double position) {
+    if (m_numPoints > 0) {
+        // Keep the points sorted in case timestamps of different sources
+        // are slightly out of order.
+        const Point& lastPoint = m_points[(m_firstPoint + m_numPoints - 1) % kMaxPoints];
+        time = math_max(time, lastPoint.time);
+    }
+    if (m_numPoints == kMaxPoints) {
+        // Drop the oldest point, it is long in the past
+        m_firstPoint = (m_firstPoint + 1) % kMaxPoints;
+        --m_numPoints;
+    }
+    m_points[(m_firstPoint + m_numPoints) % kMaxPoints] = {time, position};
+    ++m_numPoints;
+}
+
+double JogScratchInput::positionAt(double time) const {
+    if (m_numPoints == 0) {
+        return m_position;
+    }
+    const Point* pPrevious = &m_points[m_firstPoint];
+    if (time <= pPrevious->time) {
+        return pPrevious->position;
+    }
+    for (int i = 1; i < m_numPoints; ++i) {
+        const Point& point = m_points[(m_firstPoint + i) % kMaxPoints];
+        if (time < point.time) {
+            // Interpolate linearly, the platter moved steadily between the
+            // two messages.
+            const double fraction = (time - pPrevious->time) / (point.time - pPrevious->time);
+            return pPrevious->position + fraction * (point.position - pPrevious->position);
+        }
+        pPrevious = &point;
+    }
+    // Hold the position of the last movement
+    return pPrevious->position;
+}
+
+void JogScratchInput::dropPointsBefore(double time) {
+    // Keep the last point before the time, it starts the segment containing it
+    while (m_numPoints > 1 &&
+            m_points[(m_firstPoint + 1) % kMaxPoints].time <= time) {
+        m_firstPoint = (m_firstPoint + 1) % kMaxPoints;
+        --m_numPoints;
+    }
+}
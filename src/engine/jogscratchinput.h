@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QMap>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <array>
+
+#include "util/duration.h"
+#include "util/fifo.h"
+
+/// JogScratchInput passes timestamped jog wheel movements from the controller
+/// thread to the engine thread of a deck.
+///
+/// The controller side reports every movement together with the timestamp of
+/// the MIDI message that caused it. The engine side reconstructs the platter
+/// position over time from these and evaluates it a short, constant delay
+/// behind the audio callback clock. The speed of each buffer is the traveled
+/// distance within the buffer's time span, which makes the audio follow the
+/// platter without the jitter of the controller thread and polling intervals.
+///
+/// Positions are measured in seconds of audio at normal playback speed, so the
+/// resulting rate is independent of the track and output sample rates.
+class JogScratchInput {
+  public:
+    /// Returns the shared instance for the group, creating it if needed.
+    /// Can be called from any thread.
+    static QSharedPointer<JogScratchInput> getJogScratchInput(const QString& group);
+
+    // Controller thread
+
+    void enable(mixxx::Duration timestamp);
+    /// Report a movement of the platter by the given number of seconds of
+    /// audio at normal playback speed since the last movement.
+    void move(double seconds, mixxx::Duration timestamp);
+    /// Stop following the platter once all movements up to the timestamp have
+    /// been played. With ramp the remaining speed is thrown like a released
+    /// record.
+    void disable(mixxx::Duration timestamp, bool ramp);
+
+    // Engine thread
+
+    /// Evaluates the platter movement for one buffer of the given duration.
+    /// Returns false if jog scratching is disabled, in which case the rate is
+    /// not touched.
+    bool process(mixxx::Duration now, double bufferSeconds, double* pRate);
+    /// True if the last disable request asked for a throw
+    bool rampOnRelease() const {
+        return m_rampOnRelease;
+    }
+
+    /// The delay behind the callback clock at which the platter position is
+    /// evaluated. It covers the jitter between the MIDI timestamp and the
+    /// arrival of the movement in the engine.
+    static constexpr double kEvaluationDelaySeconds = 0.005;
+    /// A movement is spread over at most this time span before its timestamp.
+    /// This prevents the first tick after a pause from being stretched over
+    /// the time the platter was standing still.
+    static constexpr double kMaxMovementSeconds = 0.02;
+
+  private:
+    JogScratchInput();
+
+    enum class EventType {
+        Enable,
+        Move,
+        Disable,
+        DisableWithRamp,
+    };
+
+    struct Event {
+        EventType type;
+        double seconds;
+        qint64 timestampNanos;
+    };
+
+    struct Point {
+        double time;
+        double position;
+    };
+
+    void postEvent(EventType type, double seconds, mixxx::Duration timestamp);
+    void applyEvent(const Event& event);
+    void addPoint(double time, double position);
+    double positionAt(double time) const;
+    void dropPointsBefore(double time);
+
+    FIFO<Event> m_events;
+
+    // Engine thread state
+    static constexpr int kMaxPoints = 256;
+    std::array<Point, kMaxPoints> m_points;
+    int m_firstPoint;
+    int m_numPoints;
+    double m_position;
+    double m_lastEvaluationTime;
+    double m_lastEvaluatedPosition;
+    double m_disableTime;
+    bool m_enabled;
+    bool m_disablePending;
+    bool m_rampOnRelease;
+    bool m_evaluationStarted;
+
+    static QMutex s_instancesMutex;
+    static QMap<QString, QWeakPointer<JogScratchInput>> s_instances;
+};
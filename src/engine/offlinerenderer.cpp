@@ -0,0 +1,179 @@
+#include "engine/offlinerenderer.h"
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+
+#include "control/controlobject.h"
+#include "encoder/encoder.h"
+#include "engine/enginemaster.h"
+#include "util/assert.h"
+#include "util/defs.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+const mixxx::Logger kLogger("OfflineRenderer");
+
+constexpr int kChannelCount = 2;
+
+const ConfigKey kSampleRateConfigKey(QStringLiteral("[Master]"), QStringLiteral("samplerate"));
+
+// The readers decode a few chunks ahead of the play position, which
+// usually takes a few milliseconds. Rendering continues with the chunks
+// that are available after this time, e.g. if a file is not readable.
+const mixxx::Duration kMaxReaderWaitTime = mixxx::Duration::fromSeconds(10);
+
+} // anonymous namespace
+
+// static
+bool OfflineRenderer::parseTimeline(const QString& text,
+        mixxx::audio::SampleRate sampleRate,
+        Timeline* pTimeline,
+        QString* pErrorMessage) {
+    DEBUG_ASSERT(pTimeline);
+    VERIFY_OR_DEBUG_ASSERT(sampleRate.isValid()) {
+        return false;
+    }
+    Timeline timeline;
+    const QStringList lines = text.split(QChar('\n'));
+    for (int i = 0; i < lines.size(); ++i) {
+        const QString line = lines.at(i).trimmed();
+        if (line.isEmpty() || line.startsWith(QChar('#'))) {
+            continue;
+        }
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+        const QStringList fields = line.split(QChar(' '), Qt::SkipEmptyParts);
+#else
+        const QStringList fields = line.split(QChar(' '), QString::SkipEmptyParts);
+#endif
+        bool secondsValid = false;
+        bool valueValid = false;
+        const double seconds = fields.size() == 4 ? fields.at(0).toDouble(&secondsValid) : 0.0;
+        const double value = fields.size() == 4 ? fields.at(3).toDouble(&valueValid) : 0.0;
+        if (!secondsValid || !valueValid || seconds < 0.0) {
+            if (pErrorMessage) {
+                *pErrorMessage = QStringLiteral(
+                        "Line %1: Expected \"<seconds> <group> <item> <value>\"")
+                                         .arg(i + 1);
+            }
+            return false;
+        }
+        Event event;
+        event.frame = static_cast<SINT>(std::round(seconds * sampleRate.value()));
+        event.key = ConfigKey(fields.at(1), fields.at(2));
+        event.value = value;
+        timeline.append(event);
+    }
+    std::stable_sort(timeline.begin(), timeline.end(), [](const Event& lhs, const Event& rhs) {
+        return lhs.frame < rhs.frame;
+    });
+    *pTimeline = timeline;
+    return true;
+}
+
+OfflineRenderer::OfflineRenderer(EngineMaster* pEngineMaster, SINT maxFramesPerBuffer)
+        : m_pEngineMaster(pEngineMaster),
+          m_maxFramesPerBuffer(math_min(maxFramesPerBuffer,
+                  static_cast<SINT>(MAX_BUFFER_LEN / kChannelCount))),
+          m_nextEvent(0),
+          m_renderedFrames(0) {
+    DEBUG_ASSERT(m_pEngineMaster);
+    DEBUG_ASSERT(m_maxFramesPerBuffer > 0);
+}
+
+void OfflineRenderer::setTimeline(Timeline timeline) {
+    m_timeline = std::move(timeline);
+    m_nextEvent = 0;
+    m_renderedFrames = 0;
+    m_renderDuration = mixxx::Duration();
+}
+
+SINT OfflineRenderer::renderBuffer(SINT maxFrames) {
+    applyDueEvents();
+    SINT frames = math_min(maxFrames, m_maxFramesPerBuffer);
+    if (m_nextEvent < m_timeline.size()) {
+        frames = math_min(frames, m_timeline.at(m_nextEvent).frame - m_renderedFrames);
+    }
+    VERIFY_OR_DEBUG_ASSERT(frames > 0) {
+        return 0;
+    }
+    waitForReaders();
+    m_pEngineMaster->process(static_cast<int>(frames * kChannelCount));
+    m_renderedFrames += frames;
+    processMainThreadEvents();
+    return frames;
+}
+
+const CSAMPLE* OfflineRenderer::output() const {
+    return m_pEngineMaster->getMasterBuffer();
+}
+
+void OfflineRenderer::render(SINT frameCount, Encoder* pEncoder) {
+    PerformanceTimer timer;
+    timer.start();
+    SINT remainingFrames = frameCount;
+    while (remainingFrames > 0) {
+        const SINT frames = renderBuffer(remainingFrames);
+        if (frames <= 0) {
+            break;
+        }
+        if (pEncoder) {
+            pEncoder->encodeBuffer(output(), static_cast<int>(frames * kChannelCount));
+        }
+        remainingFrames -= frames;
+    }
+    if (pEncoder) {
+        pEncoder->flush();
+    }
+    m_renderDuration += timer.elapsed();
+    kLogger.info() << "Rendered" << (frameCount - remainingFrames) << "frames in"
+                   << m_renderDuration.formatMillisWithUnit() << "at"
+                   << realtimeFactor() << "x realtime";
+}
+
+double OfflineRenderer::realtimeFactor() const {
+    const double sampleRate = ControlObject::get(kSampleRateConfigKey);
+    const double renderSeconds = m_renderDuration.toDoubleSeconds();
+    if (sampleRate <= 0.0 || renderSeconds <= 0.0) {
+        return 0.0;
+    }
+    return m_renderedFrames / sampleRate / renderSeconds;
+}
+
+void OfflineRenderer::applyDueEvents() {
+    while (m_nextEvent < m_timeline.size() &&
+            m_timeline.at(m_nextEvent).frame <= m_renderedFrames) {
+        const Event& event = m_timeline.at(m_nextEvent++);
+        ControlObject* pControl = ControlObject::getControl(
+                event.key, ControlFlag::AllowMissingOrInvalid);
+        if (!pControl) {
+            kLogger.warning() << "Ignoring event for unknown control" << event.key;
+            continue;
+        }
+        pControl->set(event.value);
+    }
+}
+
+void OfflineRenderer::waitForReaders() {
+    PerformanceTimer timer;
+    timer.start();
+    while (!m_pEngineMaster->wakeWorkersAndCheckReadersIdle()) {
+        if (timer.elapsed() > kMaxReaderWaitTime) {
+            kLogger.warning() << "Timeout while waiting for the readers";
+            return;
+        }
+        QThread::usleep(100);
+    }
+}
+
+void OfflineRenderer::processMainThreadEvents() {
+    QCoreApplication* pApp = QCoreApplication::instance();
+    if (pApp && pApp->thread() == QThread::currentThread()) {
+        QCoreApplication::processEvents();
+    }
+}
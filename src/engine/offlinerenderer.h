@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+#include "audio/types.h"
+#include "preferences/configobject.h"
+#include "util/class.h"
+#include "util/duration.h"
+#include "util/types.h"
+
+class Encoder;
+class EngineMaster;
+
+/// Renders the main mix of an EngineMaster without a sound device as fast
+/// as the CPU allows, e.g. to export a recorded set, to measure the
+/// performance of the whole signal path or to generate reference buffers.
+///
+/// The engine is automated by a timeline of control changes, which are
+/// applied at their exact frame by splitting the buffers. Before each
+/// buffer the renderer waits until the readers of all decks have read the
+/// hinted chunks, so the output neither depends on the speed of the disk
+/// nor on the CPU load and is reproducible.
+///
+/// When rendering from the main thread, its pending events are processed
+/// between the buffers, which runs controller scripts and AutoDJ. Their
+/// timers are based on the wall clock and fire far less often per rendered
+/// second than during realtime playback.
+///
+/// No sound device must process the engine at the same time, i.e. the
+/// devices of the SoundManager must be closed while rendering.
+class OfflineRenderer {
+  public:
+    struct Event {
+        /// Frame of the output at which the control is set
+        SINT frame;
+        ConfigKey key;
+        double value;
+    };
+    /// Sorted by frame
+    typedef QList<Event> Timeline;
+
+    static constexpr SINT kDefaultMaxFramesPerBuffer = 1024;
+
+    /// Parses a timeline with one event per line, e.g.
+    /// "12.5 [Channel1] play 1" sets the play control of deck 1 after
+    /// 12.5 seconds. Empty lines and lines starting with # are ignored.
+    /// The events are sorted by time, events at the same time keep their
+    /// order.
+    static bool parseTimeline(const QString& text,
+            mixxx::audio::SampleRate sampleRate,
+            Timeline* pTimeline,
+            QString* pErrorMessage);
+
+    explicit OfflineRenderer(EngineMaster* pEngineMaster,
+            SINT maxFramesPerBuffer = kDefaultMaxFramesPerBuffer);
+
+    /// Restarts at frame 0 with a new timeline
+    void setTimeline(Timeline timeline);
+
+    /// Renders the next buffer of up to maxFrames frames and returns the
+    /// number of frames. The buffer ends before the next event of the
+    /// timeline. The stereo output is available from output() until the
+    /// next buffer is rendered.
+    SINT renderBuffer(SINT maxFrames);
+    const CSAMPLE* output() const;
+
+    /// Renders frameCount frames and passes them to the encoder, which
+    /// must have been initialized with the sample rate of the engine.
+    /// The encoder is flushed afterwards. pEncoder may be nullptr, e.g.
+    /// for measuring the performance of the engine.
+    void render(SINT frameCount, Encoder* pEncoder);
+
+    SINT renderedFrames() const {
+        return m_renderedFrames;
+    }
+    /// The time spent in render() including waiting for the readers
+    mixxx::Duration renderDuration() const {
+        return m_renderDuration;
+    }
+    /// Rendered time divided by renderDuration(), 0 before rendering
+    double realtimeFactor() const;
+
+  private:
+    void applyDueEvents();
+    void waitForReaders();
+    void processMainThreadEvents();
+
+    EngineMaster* const m_pEngineMaster;
+    const SINT m_maxFramesPerBuffer;
+    Timeline m_timeline;
+    int m_nextEvent;
+    SINT m_renderedFrames;
+    mixxx::Duration m_renderDuration;
+
+    DISALLOW_COPY_AND_ASSIGN(OfflineRenderer);
+};
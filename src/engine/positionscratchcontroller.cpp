@@ -2,7 +2,17 @@
 
 #include "engine/positionscratchcontroller.h"
 #include "engine/bufferscalers/enginebufferscale.h" // for MIN_SEEK_SPEED
+#include "engine/jogscratchinput.h"
 #include "util/math.h"
+#include "util/time.h"
+
+namespace {
+
+// The rate threshold above which disabling position scratching will enable
+// an 'inertia' mode.
+constexpr double kThrowThreshold = 2.5;
+
+} // anonymous namespace
 
 class VelocityController {
   public:
@@ -66,6 +76,7 @@ PositionScratchController::PositionScratchController(const QString& group)
         : m_group(group),
           m_bScratching(false),
           m_bEnableInertia(false),
+          m_bJogScratching(false),
           m_dLastPlaypos(0),
           m_dPositionDeltaSum(0),
           m_dTargetDelta(0),
@@ -76,6 +87,7 @@ PositionScratchController::PositionScratchController(const QString& group)
     m_pScratchEnable = new ControlObject(ConfigKey(group, "scratch_position_enable"));
     m_pScratchPosition = new ControlObject(ConfigKey(group, "scratch_position"));
     m_pMasterSampleRate = ControlObject::getControl(ConfigKey("[Master]", "samplerate"));
+    m_pJogScratchInput = JogScratchInput::getJogScratchInput(group);
     m_pVelocityController = new VelocityController();
     m_pRateIIFilter = new RateIIFilter;
 }
@@ -95,16 +107,37 @@ void PositionScratchController::process(double currentSample, double releaseRate
         int iBufferSize, double baserate) {
     bool scratchEnable = m_pScratchEnable->get() != 0;
 
+    // The latency or time difference between process calls.
+    const double dt = static_cast<double>(iBufferSize)
+            / m_pMasterSampleRate->get() / 2;
+
+    // Timestamped jog wheel movements from a controller take precedence,
+    // the audio follows the platter directly without the PD controller.
+    double jogRate;
+    if (m_pJogScratchInput->process(mixxx::Time::elapsed(), dt, &jogRate)) {
+        m_bScratching = true;
+        m_bEnableInertia = false;
+        m_bJogScratching = true;
+        m_dRate = jogRate;
+        m_dLastPlaypos = currentSample;
+        return;
+    }
+    if (m_bJogScratching) {
+        // The platter has been released, throw the record or stop scratching
+        m_bJogScratching = false;
+        if (m_pJogScratchInput->rampOnRelease() && fabs(m_dRate) > kThrowThreshold) {
+            m_bEnableInertia = true;
+        } else {
+            m_bScratching = false;
+        }
+    }
+
     if (!m_bScratching && !scratchEnable) {
         // We were not previously in scratch mode are still not in scratch
         // mode. Do nothing
         return;
     }
 
-    // The latency or time difference between process calls.
-    const double dt = static_cast<double>(iBufferSize)
-            / m_pMasterSampleRate->get() / 2;
-
     // Sample Mouse with fixed timing intervals to iron out significant jitters
     // that are added on the way from mouse to engine thread
     // Normally the Mouse is sampled every 8 ms so with this 16 ms window we
@@ -237,10 +270,6 @@ void PositionScratchController::process(double currentSample, double releaseRate
             // mode. Disable everything, or optionally enable inertia mode if
             // the previous rate was high enough to count as a 'throw'
 
-            // The rate threshold above which disabling position scratching will enable
-            // an 'inertia' mode.
-            constexpr double kThrowThreshold = 2.5;
-
             if (fabs(m_dRate) > kThrowThreshold) {
                 m_bEnableInertia = true;
             } else {
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QString>
 
 #include "audio/frame.h"
 #include "control/controlobject.h"
 
+class JogScratchInput;
 class VelocityController;
 class RateIIFilter;
 
@@ -26,10 +28,12 @@ class PositionScratchController : public QObject {
     ControlObject* m_pScratchEnable;
     ControlObject* m_pScratchPosition;
     ControlObject* m_pMasterSampleRate;
+    QSharedPointer<JogScratchInput> m_pJogScratchInput;
     VelocityController* m_pVelocityController;
     RateIIFilter* m_pRateIIFilter;
     bool m_bScratching;
     bool m_bEnableInertia;
+    bool m_bJogScratching;
     double m_dLastPlaypos;
     double m_dPositionDeltaSum;
     double m_dTargetDelta;
@@ -12,6 +12,8 @@ static constexpr int kNumChannels = 2;
 ReadAheadManager::ReadAheadManager()
         : m_pLoopingControl(nullptr),
           m_pRateControl(nullptr),
+          m_readAheadLogFront(0),
+          m_readAheadLogSize(0),
           m_currentPosition(0),
           m_pReader(nullptr),
           m_pCrossFadeBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
@@ -23,6 +25,8 @@ ReadAheadManager::ReadAheadManager(CachingReader* pReader,
         LoopingControl* pLoopingControl)
         : m_pLoopingControl(pLoopingControl),
           m_pRateControl(nullptr),
+          m_readAheadLogFront(0),
+          m_readAheadLogSize(0),
           m_currentPosition(0),
           m_pReader(pReader),
           m_pCrossFadeBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
@@ -177,7 +181,8 @@ void ReadAheadManager::addRateControl(RateControl* pRateControl) {
 void ReadAheadManager::notifySeek(double seekPosition) {
     m_currentPosition = seekPosition;
     m_cacheMissHappened = false;
-    m_readAheadLog.clear();
+    m_readAheadLogFront = 0;
+    m_readAheadLogSize = 0;
 
     // TODO(XXX) notifySeek on the engine controls. EngineBuffer currently does
     // a fine job of this so it isn't really necessary but eventually I think
@@ -225,13 +230,22 @@ void ReadAheadManager::addReadLogEntry(double virtualPlaypositionStart,
                                        double virtualPlaypositionEndNonInclusive) {
     ReadLogEntry newEntry(virtualPlaypositionStart,
                           virtualPlaypositionEndNonInclusive);
-    if (m_readAheadLog.size() > 0) {
-        ReadLogEntry& last = m_readAheadLog.back();
+    if (m_readAheadLogSize > 0) {
+        ReadLogEntry& last = m_readAheadLog[
+                (m_readAheadLogFront + m_readAheadLogSize - 1) % kReadLogCapacity];
         if (last.merge(newEntry)) {
             return;
         }
     }
-    m_readAheadLog.push_back(newEntry);
+    if (m_readAheadLogSize == kReadLogCapacity) {
+        // Only happens with extremely short loops. Drop the oldest entry,
+        // which only affects the reported play position until the log has
+        // been consumed.
+        m_readAheadLogFront = (m_readAheadLogFront + 1) % kReadLogCapacity;
+        --m_readAheadLogSize;
+    }
+    m_readAheadLog[(m_readAheadLogFront + m_readAheadLogSize) % kReadLogCapacity] = newEntry;
+    ++m_readAheadLogSize;
 }
 
 // Not thread-save, call from engine thread only
@@ -242,7 +256,7 @@ double ReadAheadManager::getFilePlaypositionFromLog(
         return currentFilePlayposition;
     }
 
-    if (m_readAheadLog.size() == 0) {
+    if (m_readAheadLogSize == 0) {
         // No log entries to read from.
         qDebug() << this << "No read ahead log entries to read from. Case not currently handled.";
         // TODO(rryan) log through a stats pipe eventually
@@ -251,8 +265,8 @@ double ReadAheadManager::getFilePlaypositionFromLog(
 
     double filePlayposition = 0;
     bool shouldNotifySeek = false;
-    while (m_readAheadLog.size() > 0 && numConsumedSamples > 0) {
-        ReadLogEntry& entry = m_readAheadLog.front();
+    while (m_readAheadLogSize > 0 && numConsumedSamples > 0) {
+        ReadLogEntry& entry = m_readAheadLog[m_readAheadLogFront];
 
         // Notify EngineControls that we have taken a seek.
         // Every new entry start with a seek
@@ -272,7 +286,8 @@ double ReadAheadManager::getFilePlaypositionFromLog(
 
         if (entry.length() == 0) {
             // This entry is empty now.
-            m_readAheadLog.pop_front();
+            m_readAheadLogFront = (m_readAheadLogFront + 1) % kReadLogCapacity;
+            --m_readAheadLogSize;
         }
         shouldNotifySeek = true;
     }
@@ -2,8 +2,8 @@
 
 #include <QList>
 #include <QPair>
+#include <array>
 #include <gsl/pointers>
-#include <list>
 
 #include "audio/frame.h"
 #include "engine/cachingreader/cachingreader.h"
@@ -70,6 +70,11 @@ class ReadAheadManager {
         double virtualPlaypositionStart;
         double virtualPlaypositionEndNonInclusive;
 
+        ReadLogEntry()
+                : virtualPlaypositionStart(0),
+                  virtualPlaypositionEndNonInclusive(0) {
+        }
+
         ReadLogEntry(double virtualPlaypositionStart,
                      double virtualPlaypositionEndNonInclusive) {
             this->virtualPlaypositionStart = virtualPlaypositionStart;
@@ -121,7 +126,16 @@ class ReadAheadManager {
 
     LoopingControl* m_pLoopingControl;
     RateControl* m_pRateControl;
-    std::list<ReadLogEntry> m_readAheadLog;
+    /// The read log is a ring of entries, because it is modified in the
+    /// audio callback, which must not allocate memory. Each loop wrap or
+    /// direction change adds an entry that can't be merged with the previous
+    /// one, and all entries are consumed after each callback, so a few
+    /// entries are sufficient.
+    static constexpr int kReadLogCapacity = 64;
+    std::array<ReadLogEntry, kReadLogCapacity> m_readAheadLog;
+    /// Index of the oldest entry
+    int m_readAheadLogFront;
+    int m_readAheadLogSize;
     double m_currentPosition;
     CachingReader* m_pReader;
     CSAMPLE* m_pCrossFadeBuffer;
@@ -1,10 +1,14 @@
 #include "engine/sidechain/enginenetworkstream.h"
 
+#include <QThread>
+
 #ifdef __WINDOWS__
 #include <windows.h>
 #include "util/performancetimer.h"
 #else
+#include <errno.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 #endif
 
@@ -129,6 +133,28 @@ qint64 EngineNetworkStream::getInputStreamTimeUs() {
     return getNetworkTimeUs() - m_inputStreamStartTimeUs;
 }
 
+void EngineNetworkStream::sleepUntilInputStreamTimeUs(qint64 streamTimeUs) {
+#if defined(__WINDOWS__) || defined(__APPLE__)
+    // The network time of these platforms is not based on a clock that
+    // supports absolute deadlines
+    const qint64 sleepUs = streamTimeUs - getInputStreamTimeUs();
+    if (sleepUs > 0) {
+        QThread::usleep(static_cast<unsigned long>(sleepUs));
+    }
+#else
+    // Sleeping until an absolute deadline of the same clock as
+    // getNetworkTimeUs() does not add the time spent in the callback
+    // or the wakeup latency of the previous cycle to the next one
+    const qint64 deadlineUs = m_inputStreamStartTimeUs + streamTimeUs;
+    struct timespec deadline;
+    deadline.tv_sec = static_cast<time_t>(deadlineUs / 1000000);
+    deadline.tv_nsec = static_cast<long>((deadlineUs % 1000000) * 1000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+        // Interrupted by a signal, continue sleeping
+    }
+#endif
+}
+
 // static
 qint64 EngineNetworkStream::getNetworkTimeUs() {
     // This matches the GPL2 implementation found in
@@ -20,6 +20,9 @@ class EngineNetworkStream {
     void read(CSAMPLE* buffer, int frames);
 
     qint64 getInputStreamTimeUs();
+    // Blocks the calling thread until the input stream time has reached
+    // the given time, as precisely as the platform allows
+    void sleepUntilInputStreamTimeUs(qint64 streamTimeUs);
     qint64 getInputStreamTimeFrames();
 
     int getNumOutputChannels() {
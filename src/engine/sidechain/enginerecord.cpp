@@ -1,5 +1,7 @@
 #include "engine/sidechain/enginerecord.h"
 
+#include <QFileInfo>
+
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
 #include "encoder/encoder.h"
@@ -7,11 +9,106 @@
 #include "moc_enginerecord.cpp"
 #include "preferences/usersettings.h"
 #include "recording/defs_recording.h"
+#include "recording/recordingwriter.h"
 #include "track/track.h"
 #include "util/event.h"
 
 constexpr int kMetaDataLifeTimeout = 16;
 
+// The header of the file is updated regularly, so that the recording
+// remains valid if Mixxx crashes or the power fails.
+constexpr quint64 kHeaderUpdateIntervalSeconds = 10;
+
+// Comma separated internal names of the formats, in which the recording is
+// encoded in addition to the selected one, e.g. "MP3,Opus"
+const ConfigKey kAdditionalEncodingsConfigKey =
+        ConfigKey(QStringLiteral(RECORDING_PREF_KEY), QStringLiteral("AdditionalEncodings"));
+
+// Encodes the recorded audio in an additional format into its own file.
+// The encoders run one after the other on the side chain thread, because
+// they are cheap compared to the disk I/O, which is done by the writer
+// thread of each target.
+class EngineRecord::AdditionalTarget : public EncoderCallback {
+  public:
+    explicit AdditionalTarget(const QString& fileName)
+            : m_writer(fileName) {
+    }
+
+    bool open(const Encoder::Format& format,
+            UserSettingsPointer pConfig,
+            mixxx::audio::SampleRate sampleRate,
+            const QString& author,
+            const QString& title,
+            const QString& album) {
+        m_pEncoder = EncoderFactory::getFactory().createRecordingEncoder(
+                format, pConfig, this);
+        if (!m_pEncoder) {
+            return false;
+        }
+        m_pEncoder->updateMetaData(author, title, album);
+        QString userErrorMsg;
+        if (m_pEncoder->initEncoder(sampleRate, &userErrorMsg) < 0) {
+            qWarning() << "Failed to initialize the" << format.label
+                       << "encoder:" << userErrorMsg;
+            m_pEncoder.reset();
+            return false;
+        }
+        if (!m_writer.open()) {
+            m_pEncoder.reset();
+            return false;
+        }
+        return true;
+    }
+
+    // Flushes the encoder and lets the writer finish without waiting
+    void requestClose() {
+        if (m_pEncoder) {
+            m_pEncoder->flush();
+            m_pEncoder.reset();
+        }
+        m_writer.requestClose();
+    }
+
+    void encodeBuffer(const CSAMPLE* pBuffer, const int iBufferSize) {
+        if (m_pEncoder && !m_writer.hasError()) {
+            m_pEncoder->encodeBuffer(pBuffer, iBufferSize);
+        }
+    }
+
+    void updateHeader() {
+        if (m_pEncoder) {
+            m_pEncoder->updateHeader();
+        }
+    }
+
+    bool hasError() const {
+        return m_writer.hasError();
+    }
+
+    void write(const unsigned char* header,
+            const unsigned char* body,
+            int headerLen,
+            int bodyLen) override {
+        if (headerLen > 0) {
+            m_writer.write(reinterpret_cast<const char*>(header), headerLen);
+        }
+        m_writer.write(reinterpret_cast<const char*>(body), bodyLen);
+    }
+    int tell() override {
+        return static_cast<int>(m_writer.pos());
+    }
+    void seek(int pos) override {
+        m_writer.seek(static_cast<qint64>(pos));
+    }
+    int filelen() override {
+        return static_cast<int>(m_writer.size());
+    }
+
+  private:
+    EncoderPointer m_pEncoder;
+    RecordingWriter m_writer;
+};
+
 EngineRecord::EngineRecord(UserSettingsPointer pConfig)
         : m_pConfig(pConfig),
           m_frames(0),
@@ -28,6 +125,8 @@ EngineRecord::EngineRecord(UserSettingsPointer pConfig)
 EngineRecord::~EngineRecord() {
     closeCueFile();
     closeFile();
+    // Wait for the writers of the additional formats before they are destroyed
+    m_closingAdditionalTargets.clear();
     delete m_pRecReady;
     delete m_pSamplerate;
 }
@@ -199,10 +298,37 @@ void EngineRecord::process(const CSAMPLE* pBuffer, const int iBufferSize) {
 
     // Checking again from m_pRecReady since its status might have changed
     // in the previous "if" blocks.
+    if (m_pRecReady->get() == RECORD_ON && m_pWriter->hasError()) {
+        // The disk is full or too slow
+        qWarning() << "Failed to write" << m_fileName;
+        Event::end(tag);
+        closeFile();
+        if (m_bCueIsEnabled) {
+            closeCueFile();
+        }
+        m_pRecReady->set(RECORD_OFF);
+        emit isRecording(false, true);
+    }
+
     if (m_pRecReady->get() == RECORD_ON) {
+        // A failing additional format must not stop the main recording
+        for (auto it = m_additionalTargets.begin(); it != m_additionalTargets.end();) {
+            if ((*it)->hasError()) {
+                qWarning() << "Stopped writing an additional recording format";
+                (*it)->requestClose();
+                m_closingAdditionalTargets.push_back(std::move(*it));
+                it = m_additionalTargets.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
         // Compress audio. Encoder will call method 'write()' below to
         // write a file stream and emit bytesRecorded.
         m_pEncoder->encodeBuffer(pBuffer, iBufferSize);
+        for (const auto& pTarget : m_additionalTargets) {
+            pTarget->encodeBuffer(pBuffer, iBufferSize);
+        }
 
         //Writing cueLine before updating the time counter since we prefer to be ahead
         //rather than late.
@@ -221,6 +347,12 @@ void EngineRecord::process(const CSAMPLE* pBuffer, const int iBufferSize) {
         // by RecordingManager to update the label besides start/stop button
         if (lastDuration != m_recordedDuration) {
             emit durationRecorded(m_recordedDuration);
+            if (m_recordedDuration % kHeaderUpdateIntervalSeconds == 0) {
+                m_pEncoder->updateHeader();
+                for (const auto& pTarget : m_additionalTargets) {
+                    pTarget->updateHeader();
+                }
+            }
         }
     }
 }
@@ -269,10 +401,10 @@ void EngineRecord::write(const unsigned char *header, const unsigned char *body,
     }
     // Relevant for OGG
     if (headerLen > 0) {
-        m_dataStream.writeRawData((const char*) header, headerLen);
+        m_pWriter->write(reinterpret_cast<const char*>(header), headerLen);
     }
     // Always write body
-    m_dataStream.writeRawData((const char*) body, bodyLen);
+    m_pWriter->write(reinterpret_cast<const char*>(body), bodyLen);
     emit bytesRecorded((headerLen+bodyLen));
 
 }
@@ -281,43 +413,86 @@ int EngineRecord::tell() {
     if (!fileOpen()) {
         return -1;
     }
-    return m_dataStream.device()->pos();
+    return static_cast<int>(m_pWriter->pos());
 }
 // Encoder calls this method to write compressed audio
 void EngineRecord::seek(int pos) {
     if (!fileOpen()) {
         return;
     }
-    m_dataStream.device()->seek(static_cast<qint64>(pos));
+    m_pWriter->seek(static_cast<qint64>(pos));
 }
 // These are not used for streaming, but the interface requires them
 int EngineRecord::filelen() {
     if (!fileOpen()) {
         return 0;
     }
-    return m_dataStream.device()->size();
+    return static_cast<int>(m_pWriter->size());
 }
 
 bool EngineRecord::fileOpen() {
-    return (m_file.handle() != -1);
+    return m_pWriter && m_pWriter->isOpen();
 }
 
 bool EngineRecord::openFile() {
-    // We can use a QFile to write compressed audio.
     if (m_pEncoder) {
-        m_file.setFileName(m_fileName);
-        if (!m_file.open(QIODevice::WriteOnly)) {
+        m_pWriter = std::make_unique<RecordingWriter>(m_fileName);
+        if (!m_pWriter->open()) {
+            m_pWriter.reset();
             return false;
         }
-        if (m_file.handle() != -1) {
-            m_dataStream.setDevice(&m_file);
-        }
     } else {
         return false;
     }
 
-    // Return whether the file is really open.
-    return fileOpen();
+    if (!fileOpen()) {
+        return false;
+    }
+    openAdditionalTargets();
+    return true;
+}
+
+void EngineRecord::openAdditionalTargets() {
+    const QStringList encodings =
+            m_pConfig->getValueString(kAdditionalEncodingsConfigKey)
+                    .split(QChar(','), Qt::SkipEmptyParts);
+    if (encodings.isEmpty()) {
+        return;
+    }
+    const QFileInfo fileInfo(m_fileName);
+    const QString baseName = fileInfo.path() + QChar('/') + fileInfo.completeBaseName();
+    QStringList openedEncodings{m_encoding};
+    for (const auto& encoding : encodings) {
+        const QString internalName = encoding.trimmed();
+        if (openedEncodings.contains(internalName)) {
+            continue;
+        }
+        // getFormatFor() falls back to the first format for unknown names
+        const Encoder::Format format = EncoderFactory::getFactory().getFormatFor(internalName);
+        if (format.internalName != internalName) {
+            qWarning() << "Ignoring unknown additional recording format" << internalName;
+            continue;
+        }
+        const QString fileName = baseName + QChar('.') + format.fileExtension;
+        auto pTarget = std::make_unique<AdditionalTarget>(fileName);
+        if (!pTarget->open(format, m_pConfig, m_sampleRate, m_baAuthor, m_baTitle, m_baAlbum)) {
+            qWarning() << "Could not open" << fileName << "for writing.";
+            continue;
+        }
+        qDebug() << "Recording additionally to" << fileName;
+        openedEncodings.append(internalName);
+        m_additionalTargets.push_back(std::move(pTarget));
+    }
+}
+
+void EngineRecord::closeAdditionalTargets() {
+    for (const auto& pTarget : m_additionalTargets) {
+        pTarget->requestClose();
+    }
+    // As for the main file, the previous targets are only destroyed and
+    // waited for when the next files are closed.
+    m_closingAdditionalTargets = std::move(m_additionalTargets);
+    m_additionalTargets.clear();
 }
 
 bool EngineRecord::openCueFile() {
@@ -363,14 +538,19 @@ bool EngineRecord::openCueFile() {
 }
 
 void EngineRecord::closeFile() {
-    if (m_file.handle() != -1) {
-        // Close QFile and encoder, if open.
+    if (fileOpen()) {
+        // Close encoder, if open, and write all pending data.
         if (m_pEncoder) {
             m_pEncoder->flush();
             m_pEncoder.reset();
         }
-        m_file.close();
+        // Don't wait until the pending data has been written. The
+        // previous writer is destroyed when the next file is closed.
+        m_pWriter->requestClose();
+        m_pClosingWriter = std::move(m_pWriter);
     }
+    closeAdditionalTargets();
+    m_pWriter.reset();
 }
 
 void EngineRecord::closeCueFile() {
@@ -1,7 +1,8 @@
 #pragma once
 
-#include <QDataStream>
 #include <QFile>
+#include <memory>
+#include <vector>
 
 #include "audio/types.h"
 #include "encoder/encoder.h"
@@ -12,6 +13,7 @@
 
 class ConfigKey;
 class ControlProxy;
+class RecordingWriter;
 
 class EngineRecord : public QObject, public EncoderCallback, public SideChainWorker {
     Q_OBJECT
@@ -52,6 +54,13 @@ class EngineRecord : public QObject, public EncoderCallback, public SideChainWor
     void durationRecorded(quint64 durationInt);
 
   private:
+    class AdditionalTarget;
+
+    // Opens the files of the additional formats next to the main file.
+    // A format that fails is skipped, the main recording continues.
+    void openAdditionalTargets();
+    void closeAdditionalTargets();
+
     int getActiveTracks();
     // Check if the metadata has changed since the previous check. We also check
     // when was the last check performed to avoid using too much CPU and as well
@@ -68,9 +77,14 @@ class EngineRecord : public QObject, public EncoderCallback, public SideChainWor
     QString m_baAuthor;
     QString m_baAlbum;
 
-    QFile m_file;
+    // Writes the file on its own thread
+    std::unique_ptr<RecordingWriter> m_pWriter;
+    // Still writes the pending data of the previous file after splitting
+    std::unique_ptr<RecordingWriter> m_pClosingWriter;
+    // The same audio encoded in other formats, each with its own writer
+    std::vector<std::unique_ptr<AdditionalTarget>> m_additionalTargets;
+    std::vector<std::unique_ptr<AdditionalTarget>> m_closingAdditionalTargets;
     QFile m_cueFile;
-    QDataStream m_dataStream;
 
     ControlProxy* m_pRecReady;
     ControlProxy* m_pSamplerate;
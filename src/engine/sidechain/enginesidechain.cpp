@@ -1,41 +1,118 @@
 // This class provides a way to do audio processing that does not need
 // to be executed in real-time. For example, broadcast encoding
-// and recording encoding can be done here. This class uses double-buffering
-// to increase the amount of time the CPU has to do whatever work needs to
-// be done, and that work is executed in a separate thread. (Threading
-// allows the next buffer to be filled while processing a buffer that's is
-// already full.)
+// and recording encoding can be done here. The engine writes its samples
+// once into a ring buffer, and every worker reads them with its own read
+// position in a separate thread. (Threading allows the next buffer to be
+// filled while processing a buffer that's is already full, and a worker
+// that falls behind does not stall the others.)
 
 #include "engine/sidechain/enginesidechain.h"
 
+#include <QThread>
 #include <QtDebug>
 
 #include "engine/engine.h"
 #include "engine/sidechain/sidechainworker.h"
-#include "moc_enginesidechain.cpp"
 #include "util/counter.h"
 #include "util/event.h"
+#include "util/metrics.h"
+#include "util/realtimeprofile.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
-#define SIDECHAIN_BUFFER_SIZE 65536
+namespace {
+
+// Gives each worker a few seconds of slack before it loses samples
+constexpr int kRingBufferSize = 4 * EngineSideChain::SIDECHAIN_BUFFER_SIZE;
+// The engine writes at most this number of samples at once, which
+// determines how many samples a reader can no longer read safely
+constexpr int kMaxWriteChunkSize = 4096;
+// Wake up the workers when about as many samples are available as
+// the former shared FIFO contained before it signaled the sidechain thread
+constexpr int kWakeupThreshold = EngineSideChain::SIDECHAIN_BUFFER_SIZE * 4 / 5;
+
+} // anonymous namespace
+
+class EngineSideChain::WorkerThread : public QThread {
+  public:
+    WorkerThread(EngineSideChain* pSideChain, SideChainWorker* pWorker, int id)
+            : m_pSideChain(pSideChain),
+              m_pWorker(pWorker),
+              m_id(id),
+              m_reader(&pSideChain->m_sampleBuffer),
+              m_pWorkBuffer(SampleUtil::alloc(SIDECHAIN_BUFFER_SIZE)) {
+    }
+    ~WorkerThread() override {
+        SampleUtil::free(m_pWorkBuffer);
+    }
+
+    SideChainWorker* worker() const {
+        return m_pWorker;
+    }
+
+  protected:
+    void run() override;
+
+  private:
+    EngineSideChain* const m_pSideChain;
+    SideChainWorker* const m_pWorker;
+    const int m_id;
+    SideChainRingBuffer::Reader m_reader;
+    CSAMPLE* const m_pWorkBuffer;
+};
+
+void EngineSideChain::WorkerThread::run() {
+    const QString name = QString("EngineSideChain %1").arg(m_id);
+    QThread::currentThread()->setObjectName(name);
+    mixxx::RealtimeProfile::applyToCurrentThread(
+            mixxx::RealtimeProfile::Role::SideChainWorker, name);
+    static const QString tag("EngineSideChain");
+    Event::start(tag);
+    while (!m_pSideChain->m_bStopThread) {
+        // Sleep until samples are available.
+        m_pSideChain->m_waitLock.lock();
+
+        Event::end(tag);
+        if (!m_pSideChain->m_bStopThread) {
+            m_pSideChain->m_waitForSamples.wait(&m_pSideChain->m_waitLock);
+        }
+        m_pSideChain->m_waitLock.unlock();
+        Event::start(tag);
+
+        // Check to see if we're supposed to exit/stop this thread.
+        if (m_pSideChain->m_bStopThread) {
+            break;
+        }
+
+        int samples_read;
+        qint64 backlogSamples = 0;
+        while ((samples_read = m_reader.read(m_pWorkBuffer, SIDECHAIN_BUFFER_SIZE)) > 0) {
+            Trace process("EngineSideChain::process");
+            m_pWorker->process(m_pWorkBuffer, samples_read);
+            backlogSamples += samples_read;
+        }
+        mixxx::metrics::sideChainBacklogSamples.set(backlogSamples);
+
+        const qint64 lostSamples = m_reader.takeLostSamples();
+        if (lostSamples > 0) {
+            mixxx::metrics::sideChainLostSamples.increment(lostSamples);
+            qWarning() << "EngineSideChain: worker" << m_id
+                       << "fell behind and lost" << lostSamples << "samples";
+            Counter("EngineSideChain::process buffer overrun").increment();
+        }
+    }
+    mixxx::RealtimeProfile::removeThread(name);
+}
 
 EngineSideChain::EngineSideChain(
         UserSettingsPointer pConfig,
         CSAMPLE* sidechainMix)
         : m_pConfig(pConfig),
           m_bStopThread(false),
-          m_sampleFifo(SIDECHAIN_BUFFER_SIZE),
-          m_pWorkBuffer(SampleUtil::alloc(SIDECHAIN_BUFFER_SIZE)),
-          m_pSidechainMix(sidechainMix) {
-    // We use HighPriority to prevent starvation by lower-priority processes (Qt
-    // main thread, analysis, etc.). This used to be LowPriority but that is not
-    // a suitable choice since we do semi-realtime tasks
-    // in the sidechain thread. To get reliable timing, it's important
-    // that this work be prioritized over the GUI and non-realtime tasks. See
-    // discussion on Bug #1270583 and Bug #1194543.
-    start(QThread::HighPriority);
+          m_sampleBuffer(kRingBufferSize, kMaxWriteChunkSize),
+          m_pSidechainMix(sidechainMix),
+          m_samplesSinceWakeup(0) {
 }
 
 EngineSideChain::~EngineSideChain() {
@@ -44,23 +121,32 @@ EngineSideChain::~EngineSideChain() {
     m_waitForSamples.wakeAll();
     m_waitLock.unlock();
 
-    // Wait until the thread has finished.
-    wait();
-
     MMutexLocker locker(&m_workerLock);
-    while (!m_workers.empty()) {
-        SideChainWorker* pWorker = m_workers.takeLast();
+    // Wait until all threads have finished.
+    for (const auto& pThread : m_workerThreads) {
+        pThread->wait();
+    }
+    while (!m_workerThreads.empty()) {
+        SideChainWorker* pWorker = m_workerThreads.back()->worker();
+        m_workerThreads.pop_back();
         pWorker->shutdown();
         delete pWorker;
     }
     locker.unlock();
-
-    SampleUtil::free(m_pWorkBuffer);
 }
 
 void EngineSideChain::addSideChainWorker(SideChainWorker* pWorker) {
     MMutexLocker locker(&m_workerLock);
-    m_workers.append(pWorker);
+    auto pThread = std::make_unique<WorkerThread>(
+            this, pWorker, static_cast<int>(m_workerThreads.size()) + 1);
+    // We use HighPriority to prevent starvation by lower-priority processes (Qt
+    // main thread, analysis, etc.). This used to be LowPriority but that is not
+    // a suitable choice since we do semi-realtime tasks
+    // in the sidechain thread. To get reliable timing, it's important
+    // that this work be prioritized over the GUI and non-realtime tasks. See
+    // discussion on Bug #1270583 and Bug #1194543.
+    pThread->start(QThread::HighPriority);
+    m_workerThreads.push_back(std::move(pThread));
 }
 
 void EngineSideChain::receiveBuffer(const AudioInput& input,
@@ -80,48 +166,15 @@ void EngineSideChain::writeSamples(const CSAMPLE* pBuffer, int iFrames) {
     // TODO: remove assumption of stereo buffer
     constexpr int kChannels = 2;
     const int iSamples = iFrames * kChannels;
-    int samples_written = m_sampleFifo.write(pBuffer, iSamples);
-
-    if (samples_written != iSamples) {
-        Counter("EngineSideChain::writeSamples buffer overrun").increment();
-    }
-
-    if (m_sampleFifo.writeAvailable() < SIDECHAIN_BUFFER_SIZE / 5) {
-        // Signal to the sidechain that samples are available.
+    // The samples are written once for all workers. Workers that fall
+    // behind skip samples on their own without blocking the engine.
+    m_sampleBuffer.write(pBuffer, iSamples);
+
+    m_samplesSinceWakeup += iSamples;
+    if (m_samplesSinceWakeup >= kWakeupThreshold) {
+        m_samplesSinceWakeup = 0;
+        // Signal to the workers that samples are available.
         Trace wakeup("EngineSideChain::writeSamples wake up");
         m_waitForSamples.wakeAll();
     }
 }
-
-void EngineSideChain::run() {
-    // the id of this thread, for debugging purposes //XXX copypasta (should
-    // factor this out somehow), -kousu 2/2009
-    unsigned static id = 0;
-    QThread::currentThread()->setObjectName(QString("EngineSideChain %1").arg(++id));
-    static const QString tag("EngineSideChain");
-    Event::start(tag);
-    while (!m_bStopThread) {
-        // Sleep until samples are available.
-        m_waitLock.lock();
-
-        Event::end(tag);
-        m_waitForSamples.wait(&m_waitLock);
-        m_waitLock.unlock();
-        Event::start(tag);
-
-        int samples_read;
-        while ((samples_read = m_sampleFifo.read(m_pWorkBuffer,
-                                                 SIDECHAIN_BUFFER_SIZE))) {
-            Trace process("EngineSideChain::process");
-            MMutexLocker locker(&m_workerLock);
-            foreach (SideChainWorker* pWorker, m_workers) {
-                pWorker->process(m_pWorkBuffer, samples_read);
-            }
-        }
-
-        // Check to see if we're supposed to exit/stop this thread.
-        if (m_bStopThread) {
-            return;
-        }
-    }
-}
@@ -1,19 +1,23 @@
 #pragma once
 
-#include <QThread>
 #include <QMutex>
 #include <QWaitCondition>
-#include <QList>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include "preferences/usersettings.h"
+#include "engine/sidechain/sidechainringbuffer.h"
 #include "engine/sidechain/sidechainworker.h"
 #include "soundio/soundmanagerutil.h"
-#include "util/fifo.h"
 #include "util/mutex.h"
 #include "util/types.h"
 
-class EngineSideChain : public QThread, public AudioDestination {
-    Q_OBJECT
+/// Distributes the samples of the engine to the registered sidechain
+/// workers. Each worker runs in its own thread and reads from a shared
+/// ring buffer, so a slow worker neither delays the other workers nor the
+/// engine callback.
+class EngineSideChain : public AudioDestination {
   public:
     EngineSideChain(UserSettingsPointer pConfig, CSAMPLE* sidechainMix);
     ~EngineSideChain() override;
@@ -29,28 +33,30 @@ class EngineSideChain : public QThread, public AudioDestination {
             const CSAMPLE* pBuffer,
             unsigned int iFrames) override;
 
-    // Thread-safe, blocking.
+    // Thread-safe, blocking. Starts a thread for the worker, which is
+    // shut down and deleted together with the sidechain.
     void addSideChainWorker(SideChainWorker* pWorker);
 
     static constexpr int SIDECHAIN_BUFFER_SIZE = 65536;
 
   private:
-    void run() override;
+    class WorkerThread;
 
     UserSettingsPointer m_pConfig;
-    // Indicates that the thread should exit.
-    volatile bool m_bStopThread;
+    // Indicates that the worker threads should exit.
+    std::atomic<bool> m_bStopThread;
 
-    FIFO<CSAMPLE> m_sampleFifo;
-    CSAMPLE* m_pWorkBuffer;
+    SideChainRingBuffer m_sampleBuffer;
     CSAMPLE* m_pSidechainMix;
+    // Only accessed by the writer thread
+    int m_samplesSinceWakeup;
 
     // Provides thread safety around the wait condition below.
     QMutex m_waitLock;
-    // Allows sleeping until we have samples to process.
+    // Allows the worker threads to sleep until we have samples to process.
     QWaitCondition m_waitForSamples;
 
-    // Sidechain workers registered with EngineSideChain.
+    // Threads of the sidechain workers registered with EngineSideChain.
     MMutex m_workerLock;
-    QList<SideChainWorker*> m_workers GUARDED_BY(m_workerLock);
+    std::vector<std::unique_ptr<WorkerThread>> m_workerThreads GUARDED_BY(m_workerLock);
 };
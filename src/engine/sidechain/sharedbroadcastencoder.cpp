@@ -0,0 +1,155 @@
+#include "engine/sidechain/sharedbroadcastencoder.h"
+
+#include "recording/defs_recording.h"
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace {
+
+// Same limit as the network cache of a connection, 10 s mp3 @ 192 kbit/s.
+// A subscriber that does not send its data in time loses it.
+constexpr int kMaxQueuedBytes = 491520;
+
+const mixxx::Logger kLogger("SharedBroadcastEncoder");
+
+QString sharingKey(const EncoderSettings& settings, mixxx::audio::SampleRate sampleRate) {
+    return QStringLiteral("%1/%2/%3/%4")
+            .arg(settings.getFormat(),
+                    QString::number(settings.getQuality()),
+                    QString::number(static_cast<int>(settings.getChannelMode())),
+                    QString::number(sampleRate.value()));
+}
+
+} // anonymous namespace
+
+// static
+std::shared_ptr<SharedBroadcastEncoder> SharedBroadcastEncoder::create(
+        const EncoderSettingsPointer& pSettings,
+        mixxx::audio::SampleRate sampleRate,
+        QString* pUserErrorMessage) {
+    auto pSharedEncoder = std::shared_ptr<SharedBroadcastEncoder>(new SharedBroadcastEncoder());
+    pSharedEncoder->m_pEncoder = EncoderFactory::getFactory().createEncoder(
+            pSettings, pSharedEncoder.get());
+    if (!pSharedEncoder->m_pEncoder ||
+            pSharedEncoder->m_pEncoder->initEncoder(sampleRate, pUserErrorMessage) < 0) {
+        return nullptr;
+    }
+    return pSharedEncoder;
+}
+
+SharedBroadcastEncoder::~SharedBroadcastEncoder() {
+    DEBUG_ASSERT(m_subscribers.isEmpty());
+    // Deleting the encoder may flush it into write(), which drops the data
+    // without subscribers
+    m_pEncoder.reset();
+}
+
+void SharedBroadcastEncoder::subscribe(ShoutConnection* pConnection) {
+    const auto locker = lockMutex(&m_mutex);
+    for (const Subscriber& subscriber : std::as_const(m_subscribers)) {
+        VERIFY_OR_DEBUG_ASSERT(subscriber.pConnection != pConnection) {
+            return;
+        }
+    }
+    m_subscribers.append(Subscriber{pConnection, QByteArray()});
+}
+
+void SharedBroadcastEncoder::unsubscribe(ShoutConnection* pConnection) {
+    const auto locker = lockMutex(&m_mutex);
+    for (int i = 0; i < m_subscribers.size(); ++i) {
+        if (m_subscribers[i].pConnection == pConnection) {
+            m_subscribers.remove(i);
+            return;
+        }
+    }
+}
+
+void SharedBroadcastEncoder::encodeBuffer(
+        ShoutConnection* pConnection, const CSAMPLE* pBuffer, int iBufferSize) {
+    const auto locker = lockMutex(&m_mutex);
+    if (m_subscribers.isEmpty() || m_subscribers.first().pConnection != pConnection) {
+        return;
+    }
+    // The encoded frames are received by the write() callback
+    m_pEncoder->encodeBuffer(pBuffer, iBufferSize);
+}
+
+QByteArray SharedBroadcastEncoder::takeEncoded(ShoutConnection* pConnection) {
+    const auto locker = lockMutex(&m_mutex);
+    for (Subscriber& subscriber : m_subscribers) {
+        if (subscriber.pConnection == pConnection) {
+            QByteArray encoded;
+            encoded.swap(subscriber.encoded);
+            return encoded;
+        }
+    }
+    return QByteArray();
+}
+
+// Called by the encoder while m_mutex is locked in encodeBuffer(), or from
+// the destructor when there are no subscribers left
+void SharedBroadcastEncoder::write(const unsigned char* header,
+        const unsigned char* body,
+        int headerLen,
+        int bodyLen) {
+    for (Subscriber& subscriber : m_subscribers) {
+        if (subscriber.encoded.size() + headerLen + bodyLen > kMaxQueuedBytes) {
+            kLogger.warning() << "Dropping encoded data of a stalled connection";
+            subscriber.encoded.clear();
+        }
+        if (headerLen > 0) {
+            subscriber.encoded.append(reinterpret_cast<const char*>(header), headerLen);
+        }
+        if (bodyLen > 0) {
+            subscriber.encoded.append(reinterpret_cast<const char*>(body), bodyLen);
+        }
+    }
+}
+
+// These are not used for streaming, but the interface requires them
+int SharedBroadcastEncoder::tell() {
+    return -1;
+}
+
+// These are not used for streaming, but the interface requires them
+void SharedBroadcastEncoder::seek(int pos) {
+    Q_UNUSED(pos);
+}
+
+// These are not used for streaming, but the interface requires them
+int SharedBroadcastEncoder::filelen() {
+    return 0;
+}
+
+// static
+bool BroadcastEncoderPool::canShare(const EncoderSettings& settings) {
+    const QString format = settings.getFormat();
+    return format == ENCODING_MP3 ||
+            format == ENCODING_AAC ||
+            format == ENCODING_HEAAC ||
+            format == ENCODING_HEAACV2;
+}
+
+std::shared_ptr<SharedBroadcastEncoder> BroadcastEncoderPool::acquire(
+        const EncoderSettingsPointer& pSettings,
+        mixxx::audio::SampleRate sampleRate,
+        QString* pUserErrorMessage) {
+    VERIFY_OR_DEBUG_ASSERT(canShare(*pSettings)) {
+        return nullptr;
+    }
+    const QString key = sharingKey(*pSettings, sampleRate);
+    const auto locker = lockMutex(&m_mutex);
+    std::shared_ptr<SharedBroadcastEncoder> pSharedEncoder = m_encoders.value(key).lock();
+    if (pSharedEncoder) {
+        kLogger.debug() << "Sharing the encoder" << key;
+        return pSharedEncoder;
+    }
+    pSharedEncoder = SharedBroadcastEncoder::create(pSettings, sampleRate, pUserErrorMessage);
+    if (pSharedEncoder) {
+        m_encoders.insert(key, pSharedEncoder);
+    } else {
+        m_encoders.remove(key);
+    }
+    return pSharedEncoder;
+}
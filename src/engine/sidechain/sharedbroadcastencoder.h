@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+#include "audio/types.h"
+#include "encoder/encoder.h"
+#include "encoder/encodercallback.h"
+#include "encoder/encodersettings.h"
+#include "util/class.h"
+#include "util/types.h"
+
+class ShoutConnection;
+
+/// Encodes the stream once for all connected broadcast connections that use
+/// identical encoder settings. The first subscribed connection feeds its
+/// samples to the encoder, and the compressed output is queued for every
+/// subscriber, which sends it from its own thread. If the feeding connection
+/// unsubscribes, the next subscriber takes over without restarting the
+/// encoder.
+class SharedBroadcastEncoder : public EncoderCallback {
+  public:
+    /// Returns nullptr and sets pUserErrorMessage if the encoder could not
+    /// be initialized
+    static std::shared_ptr<SharedBroadcastEncoder> create(
+            const EncoderSettingsPointer& pSettings,
+            mixxx::audio::SampleRate sampleRate,
+            QString* pUserErrorMessage);
+    ~SharedBroadcastEncoder() override;
+
+    void subscribe(ShoutConnection* pConnection);
+    void unsubscribe(ShoutConnection* pConnection);
+
+    /// Only encodes the samples if pConnection is the subscriber that
+    /// currently feeds the encoder. The samples of the other subscribers
+    /// are identical and dropped.
+    void encodeBuffer(ShoutConnection* pConnection, const CSAMPLE* pBuffer, int iBufferSize);
+    /// Returns the compressed data that has been queued for pConnection
+    /// since the last call
+    QByteArray takeEncoded(ShoutConnection* pConnection);
+
+    void write(const unsigned char* header,
+            const unsigned char* body,
+            int headerLen,
+            int bodyLen) override;
+    int tell() override;
+    void seek(int pos) override;
+    int filelen() override;
+
+  private:
+    SharedBroadcastEncoder() = default;
+
+    struct Subscriber {
+        ShoutConnection* pConnection;
+        QByteArray encoded;
+    };
+
+    QMutex m_mutex;
+    EncoderPointer m_pEncoder;
+    // The first subscriber feeds the encoder
+    QVector<Subscriber> m_subscribers;
+
+    DISALLOW_COPY_AND_ASSIGN(SharedBroadcastEncoder);
+};
+
+/// Hands out the same SharedBroadcastEncoder to all connections with
+/// identical encoder settings while at least one of them holds it.
+class BroadcastEncoderPool {
+  public:
+    BroadcastEncoderPool() = default;
+
+    /// Only streams that can be joined at any position are shared. Ogg
+    /// streams start with header pages that a connection joining later
+    /// would miss, so they keep an encoder per connection.
+    static bool canShare(const EncoderSettings& settings);
+
+    std::shared_ptr<SharedBroadcastEncoder> acquire(
+            const EncoderSettingsPointer& pSettings,
+            mixxx::audio::SampleRate sampleRate,
+            QString* pUserErrorMessage);
+
+  private:
+    QMutex m_mutex;
+    QHash<QString, std::weak_ptr<SharedBroadcastEncoder>> m_encoders;
+
+    DISALLOW_COPY_AND_ASSIGN(BroadcastEncoderPool);
+};
@@ -1,3 +1,4 @@
+#include <QRandomGenerator>
 #include <QUrl>
 
 // These includes are only required by ignoreSigpipe, which is unix-only
@@ -29,12 +30,23 @@
 #include "recording/defs_recording.h"
 #include "track/track.h"
 #include "util/compatibility/qatomic.h"
+#include "util/counter.h"
 #include "util/logger.h"
+#include "util/math.h"
+#include "util/metrics.h"
+#include "util/time.h"
 
 namespace {
 
 constexpr int kConnectRetries = 30;
 constexpr int kMaxNetworkCache = 491520; // 10 s mp3 @ 192 kbit/s
+// Encoded packets that could not be sent within this time are dropped to
+// keep the latency of the stream bounded
+constexpr mixxx::Duration kMaxPacketAge = mixxx::Duration::fromSeconds(5);
+// Reconnect if libshout could not send anything for this time
+constexpr mixxx::Duration kMaxSendStall = mixxx::Duration::fromSeconds(10);
+// Spreads the reconnects of multiple connections to the same server
+constexpr double kReconnectJitter = 0.2;
 // Shoutcast default receive buffer 1048576 and autodumpsourcetime 30 s
 // http://wiki.shoutcast.com/wiki/SHOUTcast_DNAS_Server_2
 constexpr int kMaxShoutFailures = 3;
@@ -47,7 +59,8 @@ const mixxx::Logger kLogger("ShoutConnection");
 } // namespace
 
 ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
-        UserSettingsPointer pConfig)
+        UserSettingsPointer pConfig,
+        std::shared_ptr<BroadcastEncoderPool> pEncoderPool)
         : m_pTextCodec(nullptr),
           m_pMetaData(),
           m_pShout(nullptr),
@@ -58,6 +71,7 @@ ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
           m_pConfig(pConfig),
           m_pProfile(profile),
           m_encoder(nullptr),
+          m_pEncoderPool(std::move(pEncoderPool)),
           m_masterSamplerate("[Master]", "samplerate"),
           m_broadcastEnabled(BROADCAST_PREF_KEY, "enabled"),
           m_custom_metadata(false),
@@ -71,6 +85,10 @@ ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
           m_protocol_is_shoutcast(false),
           m_ogg_dynamic_update(false),
           m_threadWaiting(false),
+          m_sendQueueBytes(0),
+          m_sendStalled(false),
+          m_sendQueueBytesPublished(0),
+          m_droppedPackets(0),
           m_retryCount(0),
           m_reconnectFirstDelay(0.0),
           m_reconnectPeriod(5.0),
@@ -127,6 +145,10 @@ ShoutConnection::~ShoutConnection() {
        qWarning() << "ShoutOutput::~ShoutOutput(): Thread didn't die.\
        Ignored but file a bug report if problems rise!";
     }
+    // Remove the remaining bytes of this connection from the total
+    publishSendQueueBytes(0);
+
+    resetEncoder();
 }
 
 bool ShoutConnection::isConnected() {
@@ -190,7 +212,7 @@ void ShoutConnection::updateFromPreferences() {
     // Delete m_encoder if it has been initialized (with maybe) different bitrate.
     // delete m_encoder calls write() check if it will be exit early
     DEBUG_ASSERT(m_iShoutStatus != SHOUTERR_CONNECTED);
-    m_encoder.reset();
+    resetEncoder();
 
     m_format_is_mp3 = false;
     m_format_is_ov = false;
@@ -454,23 +476,30 @@ void ShoutConnection::updateFromPreferences() {
         return;
     }
 
-    // Initialize m_encoder
+    // Initialize m_encoder or share the encoder of other connections
     EncoderSettingsPointer pBroadcastSettings =
             std::make_shared<EncoderBroadcastSettings>(m_pProfile);
-    m_encoder = EncoderFactory::getFactory().createEncoder(
-                    pBroadcastSettings, this);
-
     QString userErrorMsg;
     int ret = -1;
-    if (m_encoder) {
-        ret = m_encoder->initEncoder(masterSamplerate, &userErrorMsg);
+    if (m_pEncoderPool && BroadcastEncoderPool::canShare(*pBroadcastSettings)) {
+        m_pSharedEncoder = m_pEncoderPool->acquire(
+                pBroadcastSettings, masterSamplerate, &userErrorMsg);
+        if (m_pSharedEncoder) {
+            ret = 0;
+        }
+    } else {
+        m_encoder = EncoderFactory::getFactory().createEncoder(
+                pBroadcastSettings, this);
+        if (m_encoder) {
+            ret = m_encoder->initEncoder(masterSamplerate, &userErrorMsg);
+        }
     }
 
     // TODO(XXX): Use mixxx::audio::SampleRate instead of int in initEncoder
     if (ret < 0) {
         // delete m_encoder calls write() make sure it will be exit early
         DEBUG_ASSERT(m_iShoutStatus != SHOUTERR_CONNECTED);
-        m_encoder.reset();
+        resetEncoder();
 
         setState(NETWORKSTREAMWORKER_STATE_ERROR);
 
@@ -503,7 +532,7 @@ bool ShoutConnection::processConnect() {
     // Make sure that we call updateFromPreferences always
     updateFromPreferences();
 
-    if (!m_encoder) {
+    if (!m_encoder && !m_pSharedEncoder) {
         // updateFromPreferences failed
         setStatus(BroadcastProfile::STATUS_FAILURE);
         kLogger.warning() << "ShoutOutput::processConnect() returning false";
@@ -600,6 +629,11 @@ bool ShoutConnection::processConnect() {
             	m_pOutputFifo->flushReadData(m_pOutputFifo->readAvailable());
             }
             m_threadWaiting = true;
+            clearSendQueue();
+            if (m_pSharedEncoder) {
+                // Only connected connections receive the shared stream
+                m_pSharedEncoder->subscribe(this);
+            }
 
             setStatus(BroadcastProfile::STATUS_CONNECTED);
             emit broadcastConnected();
@@ -623,7 +657,7 @@ bool ShoutConnection::processConnect() {
     shout_close(m_pShout);
     // delete m_encoder calls write() check if it will be exit early
     DEBUG_ASSERT(m_iShoutStatus != SHOUTERR_CONNECTED);
-    m_encoder.reset();
+    resetEncoder();
     if (m_pProfile->getEnabled()) {
         setStatus(BroadcastProfile::STATUS_FAILURE);
     } else {
@@ -646,12 +680,21 @@ bool ShoutConnection::processDisconnect() {
         emit broadcastDisconnected();
         disconnected = true;
     }
+    clearSendQueue();
     // delete m_encoder calls write() check if it will be exit early
     DEBUG_ASSERT(m_iShoutStatus != SHOUTERR_CONNECTED);
-    m_encoder.reset();
+    resetEncoder();
     return disconnected;
 }
 
+void ShoutConnection::resetEncoder() {
+    m_encoder.reset();
+    if (m_pSharedEncoder) {
+        m_pSharedEncoder->unsubscribe(this);
+        m_pSharedEncoder.reset();
+    }
+}
+
 void ShoutConnection::write(const unsigned char* header, const unsigned char* body,
                             int headerLen, int bodyLen) {
     setFunctionCode(7);
@@ -661,26 +704,106 @@ void ShoutConnection::write(const unsigned char* header, const unsigned char* bo
         return;
     }
 
-    // Send header if there is one
+    // The packets are sent by process() after encoding, without blocking
+    // the encoder while the server is slow
+    enqueuePacket(header, headerLen, body, bodyLen);
+}
+
+void ShoutConnection::enqueuePacket(const unsigned char* header,
+        int headerLen,
+        const unsigned char* body,
+        int bodyLen) {
+    EncodedPacket packet;
+    packet.data.reserve(math_max(headerLen, 0) + math_max(bodyLen, 0));
     if (headerLen > 0) {
-        if(!writeSingle(header, headerLen)) {
-            return;
-        }
+        packet.data.append(reinterpret_cast<const char*>(header), headerLen);
+    }
+    if (bodyLen > 0) {
+        packet.data.append(reinterpret_cast<const char*>(body), bodyLen);
+    }
+    if (packet.data.isEmpty()) {
+        return;
+    }
+    packet.timestamp = mixxx::Time::elapsed();
+
+    // Prefer the latest packets to keep the latency low
+    while (!m_sendQueue.isEmpty() &&
+            m_sendQueueBytes + packet.data.size() > kMaxNetworkCache) {
+        dropOldestPacket();
+    }
+    m_sendQueueBytes += packet.data.size();
+    m_sendQueue.enqueue(std::move(packet));
+}
+
+void ShoutConnection::sendQueuedPackets() {
+    const mixxx::Duration now = mixxx::Time::elapsed();
+    while (!m_sendQueue.isEmpty() &&
+            now - m_sendQueue.head().timestamp > kMaxPacketAge) {
+        dropOldestPacket();
     }
 
-    if(!writeSingle(body, bodyLen)) {
+    while (!m_sendQueue.isEmpty()) {
+        if (shout_queuelen(m_pShout) > 0) {
+            // Try to flush the queue of libshout first
+            (void)shout_send_raw(m_pShout, nullptr, 0);
+            if (shout_queuelen(m_pShout) > 0) {
+                break;
+            }
+        }
+        const EncodedPacket packet = m_sendQueue.dequeue();
+        m_sendQueueBytes -= packet.data.size();
+        if (!writeSingle(reinterpret_cast<const unsigned char*>(packet.data.constData()),
+                    packet.data.size())) {
+            break;
+        }
+    }
+    if (m_iShoutStatus != SHOUTERR_CONNECTED) {
+        // writeSingle() has failed and tried to reconnect
         return;
     }
 
-    ssize_t queuelen = shout_queuelen(m_pShout);
+    const ssize_t queuelen = shout_queuelen(m_pShout);
     if (queuelen > 0) {
-        kLogger.debug() << "shout_queuelen" << queuelen;
-        if (queuelen > kMaxNetworkCache) {
+        if (!m_sendStalled) {
+            m_sendStalled = true;
+            m_sendStallStart = now;
+        } else if (now - m_sendStallStart > kMaxSendStall) {
+            kLogger.warning() << "sendQueuedPackets() stalled with"
+                              << queuelen << "bytes in the queue of libshout";
+            m_sendStalled = false;
             m_lastErrorStr = tr("Network cache overflow");
             tryReconnect();
+            return;
         }
+    } else {
+        m_sendStalled = false;
     }
+    publishSendQueueBytes(
+            m_sendQueueBytes + static_cast<int>(math_max<ssize_t>(queuelen, 0)));
+}
+
+void ShoutConnection::dropOldestPacket() {
+    const EncodedPacket packet = m_sendQueue.dequeue();
+    m_sendQueueBytes -= packet.data.size();
+    m_droppedPackets.fetchAndAddRelaxed(1);
+    mixxx::metrics::broadcastDroppedPackets.increment();
+    Counter("ShoutConnection::sendQueuedPackets dropped packets").increment();
+}
+
+void ShoutConnection::clearSendQueue() {
+    m_sendQueue.clear();
+    m_sendQueueBytes = 0;
+    m_sendStalled = false;
+    publishSendQueueBytes(0);
 }
+
+void ShoutConnection::publishSendQueueBytes(int bytes) {
+    // Only this thread writes the published value
+    const int previousBytes = atomicLoadRelaxed(m_sendQueueBytesPublished);
+    atomicStoreRelaxed(m_sendQueueBytesPublished, bytes);
+    mixxx::metrics::broadcastQueueBytes.add(bytes - previousBytes);
+}
+
 // These are not used for streaming, but the interface requires them
 int ShoutConnection::tell() {
     if (!m_pShout) {
@@ -702,12 +825,9 @@ bool ShoutConnection::writeSingle(const unsigned char* data, size_t len) {
     setFunctionCode(8);
     int ret = shout_send_raw(m_pShout, data, len);
     if (ret == SHOUTERR_BUSY) {
-        // in case of busy, frames are queued
-        // try to flush queue after a short sleep
-        kLogger.warning() << "writeSingle() SHOUTERR_BUSY, trying again";
-        usleep(10000); // wait 10 ms until "busy" is over. TODO() tweak for an optimum.
-        // if this fails, the queue is transmitted after the next regular shout_send_raw()
-        (void)shout_send_raw(m_pShout, nullptr, 0);
+        // In case of busy, the data is queued by libshout and transmitted
+        // with the next call of shout_send_raw() in sendQueuedPackets()
+        kLogger.debug() << "writeSingle() SHOUTERR_BUSY";
     } else if (ret < SHOUTERR_SUCCESS) {
         m_lastErrorStr = shout_get_error(m_pShout);
         kLogger.warning()
@@ -740,13 +860,27 @@ void ShoutConnection::process(const CSAMPLE* pBuffer, const int iBufferSize) {
     // to prevent race conditions when resetting the member
     // pointer while disconnecting in the worker thread!
     const EncoderPointer pEncoder = m_encoder;
+    const std::shared_ptr<SharedBroadcastEncoder> pSharedEncoder = m_pSharedEncoder;
 
     // If we are connected, encode the samples.
     if (iBufferSize > 0 && pEncoder) {
         setFunctionCode(6);
         pEncoder->encodeBuffer(pBuffer, iBufferSize);
         // the encoded frames are received by the write() callback.
+    } else if (iBufferSize > 0 && pSharedEncoder) {
+        setFunctionCode(6);
+        // Only one of the sharing connections actually encodes the samples,
+        // all of them send the encoded frames.
+        pSharedEncoder->encodeBuffer(this, pBuffer, iBufferSize);
+        const QByteArray encoded = pSharedEncoder->takeEncoded(this);
+        if (!encoded.isEmpty()) {
+            write(nullptr,
+                    reinterpret_cast<const unsigned char*>(encoded.constData()),
+                    0,
+                    encoded.size());
+        }
     }
+    sendQueuedPackets();
 
     // Check if track metadata has changed and if so, update.
     if (metaDataHasChanged()) {
@@ -938,6 +1072,9 @@ bool ShoutConnection::waitForRetry() {
     }
 
     if (delay > 0) {
+        delay *= 1.0 +
+                kReconnectJitter *
+                        (2.0 * QRandomGenerator::global()->generateDouble() - 1.0);
         m_enabledMutex.lock();
         m_waitEnabled.wait(&m_enabledMutex, static_cast<unsigned long>(delay * 1000));
         m_enabledMutex.unlock();
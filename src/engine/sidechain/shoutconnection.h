@@ -3,8 +3,10 @@
 #include <engine/sidechain/networkoutputstreamworker.h>
 
 #include <QMessageBox>
+#include <QByteArray>
 #include <QMutex>
 #include <QObject>
+#include <QQueue>
 #include <QSemaphore>
 #include <QSharedPointer>
 #include <QTextCodec>
@@ -16,10 +18,13 @@
 #include "control/pollingcontrolproxy.h"
 #include "encoder/encoder.h"
 #include "encoder/encodercallback.h"
+#include "engine/sidechain/sharedbroadcastencoder.h"
 #include "errordialoghandler.h"
 #include "preferences/broadcastprofile.h"
 #include "preferences/usersettings.h"
 #include "track/track_decl.h"
+#include "util/compatibility/qatomic.h"
+#include "util/duration.h"
 #include "util/fifo.h"
 
 // Forward declare libshout structures to prevent leaking shout.h definitions
@@ -33,7 +38,9 @@ class ShoutConnection
         : public QThread, public EncoderCallback, public NetworkOutputStreamWorker {
     Q_OBJECT
   public:
-    ShoutConnection(BroadcastProfilePtr profile, UserSettingsPointer pConfig);
+    ShoutConnection(BroadcastProfilePtr profile,
+            UserSettingsPointer pConfig,
+            std::shared_ptr<BroadcastEncoderPool> pEncoderPool);
     ~ShoutConnection() override;
 
     // This is called by the Engine implementation for each sample. Encode and
@@ -76,6 +83,16 @@ class ShoutConnection
         return m_pProfile->connectionStatus();
     }
 
+    // Thread-safe. Number of encoded bytes that wait to be sent.
+    int sendQueueBytes() const {
+        return atomicLoadRelaxed(m_sendQueueBytesPublished);
+    }
+    // Thread-safe. Number of encoded packets that have been dropped because
+    // they could not be sent in time.
+    int droppedPackets() const {
+        return atomicLoadRelaxed(m_droppedPackets);
+    }
+
   signals:
     void broadcastDisconnected();
     void broadcastConnected();
@@ -83,6 +100,8 @@ class ShoutConnection
   private:
     bool processConnect();
     bool processDisconnect();
+    // Deletes the own encoder or leaves the shared encoder
+    void resetEncoder();
 
     // Update the libshout struct with info from the current broadcast profile.
     void updateFromPreferences();
@@ -108,6 +127,20 @@ class ShoutConnection
 
     bool writeSingle(const unsigned char *data, size_t len);
 
+    // Queues an encoded packet without sending it. Drops the oldest packets
+    // if the queue is full.
+    void enqueuePacket(const unsigned char* header,
+            int headerLen,
+            const unsigned char* body,
+            int bodyLen);
+    // Sends as many queued packets as possible without blocking and drops
+    // the packets that are too old
+    void sendQueuedPackets();
+    void dropOldestPacket();
+    void clearSendQueue();
+    // Publishes the number of bytes waiting to be sent in all queues
+    void publishSendQueueBytes(int bytes);
+
     QByteArray encodeString(const QString& string);
 
     bool waitForRetry();
@@ -125,6 +158,10 @@ class ShoutConnection
     UserSettingsPointer m_pConfig;
     BroadcastProfilePtr m_pProfile;
     EncoderPointer m_encoder;
+    // Connections with identical encoder settings share a single encoder
+    // instead of m_encoder, see BroadcastEncoderPool::canShare()
+    std::shared_ptr<BroadcastEncoderPool> m_pEncoderPool;
+    std::shared_ptr<SharedBroadcastEncoder> m_pSharedEncoder;
     PollingControlProxy m_masterSamplerate;
     PollingControlProxy m_broadcastEnabled;
     // static metadata according to prefereneces
@@ -149,6 +186,21 @@ class ShoutConnection
     QSemaphore m_readSema;
     QSharedPointer<FIFO<CSAMPLE>> m_pOutputFifo;
 
+    struct EncodedPacket {
+        QByteArray data;
+        mixxx::Duration timestamp;
+    };
+    // Encoded packets that have not been handed to libshout yet. They are
+    // only handed over when libshout has sent its own queue, so that the
+    // packets which can not be sent in time are still droppable.
+    QQueue<EncodedPacket> m_sendQueue;
+    int m_sendQueueBytes;
+    // Set while libshout could not send its queue since m_sendStallStart
+    bool m_sendStalled;
+    mixxx::Duration m_sendStallStart;
+    QAtomicInt m_sendQueueBytesPublished;
+    QAtomicInt m_droppedPackets;
+
     QString m_lastErrorStr;
     int m_retryCount;
 
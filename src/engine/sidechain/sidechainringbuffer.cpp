@@ -0,0 +1,87 @@
+#include "engine/sidechain/sidechainringbuffer.h"
+
+#include <algorithm>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+SideChainRingBuffer::SideChainRingBuffer(int capacity, int maxChunkSize)
+        : m_samples(roundUpToPowerOf2(capacity)),
+          m_mask(static_cast<qint64>(m_samples.size()) - 1),
+          m_maxChunkSize(maxChunkSize),
+          m_readableSize(static_cast<qint64>(m_samples.size()) - maxChunkSize),
+          m_writePosition(0) {
+    DEBUG_ASSERT(maxChunkSize > 0);
+    DEBUG_ASSERT(m_readableSize > 0);
+}
+
+void SideChainRingBuffer::write(const CSAMPLE* pBuffer, int count) {
+    qint64 writePosition = m_writePosition.load(std::memory_order_relaxed);
+    while (count > 0) {
+        const int chunkSize = math_min(count, m_maxChunkSize);
+        const qint64 offset = writePosition & m_mask;
+        const int sizeUntilEnd = static_cast<int>(
+                math_min<qint64>(chunkSize, m_samples.size() - offset));
+        std::copy(pBuffer, pBuffer + sizeUntilEnd, m_samples.begin() + offset);
+        std::copy(pBuffer + sizeUntilEnd, pBuffer + chunkSize, m_samples.begin());
+        writePosition += chunkSize;
+        // Publishes the chunk. Readers no longer accept the oldest samples
+        // that are overwritten by the next chunk.
+        m_writePosition.store(writePosition, std::memory_order_release);
+        pBuffer += chunkSize;
+        count -= chunkSize;
+    }
+}
+
+SideChainRingBuffer::Reader::Reader(const SideChainRingBuffer* pBuffer)
+        : m_pBuffer(pBuffer),
+          m_readPosition(pBuffer->m_writePosition.load(std::memory_order_acquire)),
+          m_lostSamples(0) {
+}
+
+void SideChainRingBuffer::Reader::skipOverwrittenSamples(qint64 writePosition) {
+    if (m_readPosition >= writePosition - m_pBuffer->m_readableSize) {
+        return;
+    }
+    // Continue in the middle of the readable samples to give the reader
+    // some time to catch up before it is overrun again. The distance is
+    // kept even to stay aligned to stereo frames.
+    const qint64 distance = (m_pBuffer->m_readableSize / 2) & ~static_cast<qint64>(1);
+    const qint64 readPosition = writePosition - distance;
+    m_lostSamples += readPosition - m_readPosition;
+    m_readPosition = readPosition;
+}
+
+int SideChainRingBuffer::Reader::read(CSAMPLE* pBuffer, int maxCount) {
+    const std::vector<CSAMPLE>& samples = m_pBuffer->m_samples;
+    while (true) {
+        const qint64 writePosition =
+                m_pBuffer->m_writePosition.load(std::memory_order_acquire);
+        skipOverwrittenSamples(writePosition);
+        const int count = static_cast<int>(
+                math_min<qint64>(maxCount, writePosition - m_readPosition));
+        if (count <= 0) {
+            return 0;
+        }
+        const qint64 offset = m_readPosition & m_pBuffer->m_mask;
+        const int sizeUntilEnd = static_cast<int>(
+                math_min<qint64>(count, samples.size() - offset));
+        std::copy(samples.begin() + offset,
+                samples.begin() + offset + sizeUntilEnd,
+                pBuffer);
+        std::copy(samples.begin(),
+                samples.begin() + (count - sizeUntilEnd),
+                pBuffer + sizeUntilEnd);
+
+        // The writer may have continued while copying. The copy is only
+        // valid if none of the samples have been overwritten meanwhile.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const qint64 currentWritePosition =
+                m_pBuffer->m_writePosition.load(std::memory_order_relaxed);
+        if (m_readPosition >= currentWritePosition - m_pBuffer->m_readableSize) {
+            m_readPosition += count;
+            return count;
+        }
+        skipOverwrittenSamples(currentWritePosition);
+    }
+}
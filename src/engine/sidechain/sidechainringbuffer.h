@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QtGlobal>
+#include <atomic>
+#include <vector>
+
+#include "util/class.h"
+#include "util/types.h"
+
+/// Ring buffer of samples with a single writer and any number of readers
+/// that each have their own read position. The samples are only written
+/// once, independent of the number of readers.
+///
+/// The writer never waits for the readers. A reader that falls behind by
+/// more than the capacity loses samples without affecting the other
+/// readers. Readers validate the copied samples against the write position
+/// afterwards, so they never return samples that have been overwritten
+/// while copying.
+class SideChainRingBuffer {
+  public:
+    /// capacity is rounded up to a power of 2. Each write is split into
+    /// chunks of at most maxChunkSize samples. Both must be a multiple of
+    /// the channel count to keep the readers aligned to frames.
+    SideChainRingBuffer(int capacity, int maxChunkSize);
+
+    /// Wait-free, must only be called from a single writer thread
+    void write(const CSAMPLE* pBuffer, int count);
+
+    class Reader {
+      public:
+        /// Starts reading at the current write position
+        explicit Reader(const SideChainRingBuffer* pBuffer);
+
+        /// Copies up to maxCount samples and returns the number of samples
+        /// that have been copied. Must only be called from a single
+        /// reader thread.
+        int read(CSAMPLE* pBuffer, int maxCount);
+
+        /// Number of samples that have been lost since the last call
+        qint64 takeLostSamples() {
+            const qint64 lostSamples = m_lostSamples;
+            m_lostSamples = 0;
+            return lostSamples;
+        }
+
+      private:
+        void skipOverwrittenSamples(qint64 writePosition);
+
+        const SideChainRingBuffer* const m_pBuffer;
+        qint64 m_readPosition;
+        qint64 m_lostSamples;
+    };
+
+  private:
+    std::vector<CSAMPLE> m_samples;
+    const qint64 m_mask;
+    const int m_maxChunkSize;
+    // Samples before this distance to the write position are stable
+    // while the next chunk is written
+    const qint64 m_readableSize;
+    // Total number of samples that have been written
+    std::atomic<qint64> m_writePosition;
+
+    DISALLOW_COPY_AND_ASSIGN(SideChainRingBuffer);
+};
@@ -20,6 +20,10 @@ const double SyncControl::kBpmDouble = 2.0;
 
 namespace {
 const mixxx::Logger kLogger("SyncControl");
+
+double wrapBeatDistance(double beatDistance) {
+    return beatDistance - floor(beatDistance);
+}
 } // namespace
 
 SyncControl::SyncControl(const QString& group,
@@ -92,6 +96,11 @@ SyncControl::SyncControl(const QString& group,
     m_pBeatDistance.reset(
             new ControlObject(ConfigKey(group, "beat_distance")));
 
+    // Set by SoundManager if the deck is routed to an output of another sound
+    // device than the clock reference, e.g. when using an external mixer.
+    m_pOutputLatency.reset(
+            new ControlObject(ConfigKey(group, "sync_output_latency")));
+
     m_pPassthroughEnabled = new ControlProxy(group, "passthrough", this);
     m_pPassthroughEnabled->connectValueChanged(this,
             &SyncControl::slotPassthroughChanged,
@@ -224,8 +233,19 @@ double SyncControl::adjustSyncBeatDistance(double beatDistance) const {
     return beatDistance;
 }
 
+double SyncControl::compensateOutputLatency(double beatDistance) const {
+    const double latencyMillis = m_pOutputLatency->get();
+    if (latencyMillis == 0.0 || !m_pBpm) {
+        return beatDistance;
+    }
+    // This deck is heard later, so the beat distance that is heard while the
+    // clock reference output plays the current buffer lies in the past.
+    const double latencyBeats = latencyMillis / 1000.0 * m_pBpm->get() / 60.0;
+    return wrapBeatDistance(beatDistance - latencyBeats);
+}
+
 double SyncControl::getBeatDistance() const {
-    double beatDistance = m_pBeatDistance->get();
+    double beatDistance = compensateOutputLatency(m_pBeatDistance->get());
     return adjustSyncBeatDistance(beatDistance);
 }
 
@@ -332,6 +352,13 @@ void SyncControl::updateTargetBeatDistance(mixxx::audio::FramePos refPosition) {
             targetDistance += 0.5;
         }
     }
+    // Inverse of compensateOutputLatency(): to be heard in phase, a deck with
+    // a later output must play ahead of the leader.
+    const double latencyMillis = m_pOutputLatency->get();
+    if (latencyMillis != 0.0) {
+        targetDistance = wrapBeatDistance(
+                targetDistance + latencyMillis / 1000.0 * m_pBpm->get() / 60.0);
+    }
     if (kLogger.traceEnabled()) {
         kLogger.trace()
                 << getGroup()
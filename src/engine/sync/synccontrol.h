@@ -44,6 +44,10 @@ class SyncControl : public EngineControl, public Syncable {
     bool isQuantized() const override;
 
     double adjustSyncBeatDistance(double beatDistance) const;
+    /// Converts the beat distance of this deck to the beat distance that is
+    /// heard at the same time on the clock reference output, if this deck has
+    /// its own output with a different latency.
+    double compensateOutputLatency(double beatDistance) const;
     double getBeatDistance() const override;
     /// updateTargetBeatDistance calculates the correct beat distance that
     /// we should sync against.  This may be different from the leader's
@@ -140,6 +144,8 @@ class SyncControl : public EngineControl, public Syncable {
     QScopedPointer<ControlPushButton> m_pSyncLeaderEnabled;
     QScopedPointer<ControlPushButton> m_pSyncEnabled;
     QScopedPointer<ControlObject> m_pBeatDistance;
+    // How many ms later than the clock reference output this deck is heard
+    QScopedPointer<ControlObject> m_pOutputLatency;
 
     // Button for sync'ing with the other EngineBuffer
     ControlPushButton* m_pButtonSync;
@@ -40,6 +40,11 @@ AnalyzerModeFlags getAnalyzerModeFlags(
     if (pConfig->getValue<bool>(ConfigKey("[Library]", "EnableWaveformGenerationWithAnalysis"), true)) {
         modeFlags |= AnalyzerModeFlags::WithWaveform;
     }
+    // Adjust the number of active threads depending on the bottleneck
+    // (disk vs. CPU) and back off while decks are playing
+    if (pConfig->getValue<bool>(ConfigKey("[Library]", "AnalysisAdaptiveThreads"), true)) {
+        modeFlags |= AnalyzerModeFlags::AdaptiveThreads;
+    }
     return static_cast<AnalyzerModeFlags>(modeFlags);
 }
 
@@ -18,6 +18,7 @@
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
 #include "util/dnd.h"
+#include "util/fileinfo.h"
 #include "widget/wlibrary.h"
 #include "widget/wlibrarysidebar.h"
 
@@ -235,9 +236,10 @@ void AutoDJFeature::slotCrateChanged(CrateId crateId) {
 
 void AutoDJFeature::slotAddRandomTrack() {
     if (m_iAutoDJPlaylistId >= 0) {
-        TrackPointer pRandomTrack;
+        TrackId addTrackId;
         for (int failedRetrieveAttempts = 0;
-                !pRandomTrack && (failedRetrieveAttempts < 2 * kMaxRetrieveAttempts); // 2 rounds
+                !addTrackId.isValid() &&
+                (failedRetrieveAttempts < 2 * kMaxRetrieveAttempts); // 2 rounds
                 ++failedRetrieveAttempts) {
             TrackId randomTrackId;
             if (m_crateList.isEmpty()) {
@@ -252,23 +254,30 @@ void AutoDJFeature::slotAddRandomTrack() {
             }
 
             if (randomTrackId.isValid()) {
-                pRandomTrack = m_pLibrary->trackCollectionManager()->getTrackById(randomTrackId);
-                VERIFY_OR_DEBUG_ASSERT(pRandomTrack) {
+                // Only the location is needed for checking if the file
+                // exists, no need to load and populate a Track object.
+                const auto trackSummaries =
+                        m_pTrackCollection->getTrackDAO().getTrackSummariesByIds(
+                                {randomTrackId});
+                VERIFY_OR_DEBUG_ASSERT(!trackSummaries.isEmpty()) {
                     qWarning() << "Track does not exist:"
                             << randomTrackId;
                     continue;
                 }
-                if (!pRandomTrack->getFileInfo().checkFileExists()) {
+                const auto& trackSummary = trackSummaries.first();
+                if (!mixxx::FileInfo(trackSummary.location).checkFileExists()) {
                     qWarning() << "Track does not exist:"
-                               << pRandomTrack->getInfo()
-                               << pRandomTrack->getFileInfo();
-                    pRandomTrack.reset();
+                               << trackSummary.artist
+                               << trackSummary.title
+                               << trackSummary.location;
+                    continue;
                 }
+                addTrackId = randomTrackId;
             }
         }
-        if (pRandomTrack) {
+        if (addTrackId.isValid()) {
             m_pTrackCollection->getPlaylistDAO().appendTrackToPlaylist(
-                    pRandomTrack->getId(), m_iAutoDJPlaylistId);
+                    addTrackId, m_iAutoDJPlaylistId);
             m_pAutoDJView->onShow();
             return; // success
         }
@@ -1,5 +1,8 @@
 #include "library/autodj/autodjprocessor.h"
 
+#include <QtConcurrentRun>
+
+#include "analyzer/analyzersilence.h"
 #include "control/controlproxy.h"
 #include "control/controlpushbutton.h"
 #include "engine/engine.h"
@@ -169,6 +172,18 @@ AutoDJProcessor::AutoDJProcessor(
 
     m_pCOCrossfader = new ControlProxy("[Master]", "crossfader");
     m_pCOCrossfaderReverse = new ControlProxy("[Mixer Profile]", "xFaderReverse");
+    m_pCOTransitionFromDeck = new ControlProxy("[AutoDJ]",
+            "transition_from_deck",
+            nullptr,
+            ControlFlag::AllowMissingOrInvalid);
+    m_pCOTransitionToDeck = new ControlProxy("[AutoDJ]",
+            "transition_to_deck",
+            nullptr,
+            ControlFlag::AllowMissingOrInvalid);
+    m_pCOTransitionPosition = new ControlProxy("[AutoDJ]",
+            "transition_position",
+            nullptr,
+            ControlFlag::AllowMissingOrInvalid);
 
     QString str_autoDjTransition = m_pConfig->getValueString(
             ConfigKey(kConfigKey, kTransitionPreferenceName));
@@ -187,6 +202,9 @@ AutoDJProcessor::~AutoDJProcessor() {
     m_decks.clear();
     delete m_pCOCrossfader;
     delete m_pCOCrossfaderReverse;
+    delete m_pCOTransitionFromDeck;
+    delete m_pCOTransitionToDeck;
+    delete m_pCOTransitionPosition;
 
     delete m_pSkipNext;
     delete m_pAddRandomTrack;
@@ -568,6 +586,7 @@ AutoDJProcessor::AutoDJError AutoDJProcessor::toggleAutoDJ(bool enable) {
         m_pEnabledAutoDJ->set(0.0);
         qDebug() << "Auto DJ disabled";
         m_eState = ADJ_DISABLED;
+        disarmTransitionTrigger();
         disconnect(m_pCOCrossfader,
                 &ControlProxy::valueChanged,
                 this,
@@ -776,6 +795,9 @@ void AutoDJProcessor::playerPositionChanged(DeckAttributes* pAttributes,
             calculateTransition(otherDeck, thisDeck, false);
         } else if (thisDeck->isRepeat()) {
             // repeat pauses auto DJ
+            if (thisDeck->isFromDeck) {
+                disarmTransitionTrigger();
+            }
             return;
         }
     }
@@ -790,6 +812,7 @@ void AutoDJProcessor::playerPositionChanged(DeckAttributes* pAttributes,
                 // Set the state as FADING.
                 m_eState = thisDeck->isLeft() ? ADJ_LEFT_FADING : ADJ_RIGHT_FADING;
                 m_transitionProgress = 0.0;
+                disarmTransitionTrigger();
                 emitAutoDJStateChanged(m_eState);
 
                 const double toDeckFadeDistance =
@@ -902,6 +925,7 @@ TrackPointer AutoDJProcessor::getNextTrackFromQueue() {
 }
 
 bool AutoDJProcessor::loadNextTrackFromQueue(const DeckAttributes& deck, bool play) {
+    disarmTransitionTrigger();
     TrackPointer nextTrack = getNextTrackFromQueue();
 
     // We ran out of tracks in the queue.
@@ -914,6 +938,13 @@ bool AutoDJProcessor::loadNextTrackFromQueue(const DeckAttributes& deck, bool pl
         return false;
     }
 
+    // The transition is calculated from the first and last sound. Find
+    // them for unanalyzed tracks long before the full analysis of the deck
+    // has finished, the transition is updated when the cues change.
+    QtConcurrent::run([nextTrack, pConfig = m_pConfig] {
+        AnalyzerSilence::scanFirstAndLastSound(nextTrack, pConfig);
+    });
+
     emitLoadTrackToPlayer(nextTrack, deck.group, play);
     return true;
 }
@@ -1432,6 +1463,7 @@ void AutoDJProcessor::calculateTransition(DeckAttributes* pFromDeck,
     VERIFY_OR_DEBUG_ASSERT(pFromDeck->fadeBeginPos <= 1) {
         pFromDeck->fadeBeginPos = 1;
     }
+    armTransitionTrigger(*pFromDeck, *pToDeck);
 
     if constexpr (sDebug) {
         qDebug() << this << "calculateTransition" << pFromDeck->group
@@ -1440,6 +1472,18 @@ void AutoDJProcessor::calculateTransition(DeckAttributes* pFromDeck,
     }
 }
 
+void AutoDJProcessor::armTransitionTrigger(
+        const DeckAttributes& fromDeck, const DeckAttributes& toDeck) {
+    m_pCOTransitionPosition->set(fromDeck.fadeBeginPos);
+    m_pCOTransitionToDeck->set(toDeck.index + 1);
+    // Arms the trigger, so it is set last
+    m_pCOTransitionFromDeck->set(fromDeck.index + 1);
+}
+
+void AutoDJProcessor::disarmTransitionTrigger() {
+    m_pCOTransitionFromDeck->set(0.0);
+}
+
 void AutoDJProcessor::useFixedFadeTime(
         DeckAttributes* pFromDeck,
         DeckAttributes* pToDeck,
@@ -267,6 +267,11 @@ class AutoDJProcessor : public QObject {
     DeckAttributes* getLeftDeck();
     DeckAttributes* getRightDeck();
     DeckAttributes* getOtherDeck(const DeckAttributes* pThisDeck);
+
+    // The engine starts the toDeck at the fadeBeginPos of the fromDeck, even
+    // if the main thread is blocked at that time
+    void armTransitionTrigger(const DeckAttributes& fromDeck, const DeckAttributes& toDeck);
+    void disarmTransitionTrigger();
     DeckAttributes* getFromDeck();
 
     // Removes the track loaded to the player group from the top of the AutoDJ
@@ -289,6 +294,9 @@ class AutoDJProcessor : public QObject {
 
     ControlProxy* m_pCOCrossfader;
     ControlProxy* m_pCOCrossfaderReverse;
+    ControlProxy* m_pCOTransitionFromDeck;
+    ControlProxy* m_pCOTransitionToDeck;
+    ControlProxy* m_pCOTransitionPosition;
 
     ControlPushButton* m_pSkipNext;
     ControlPushButton* m_pAddRandomTrack;
@@ -133,6 +133,9 @@ void BansheePlaylistModel::setTableModel(int playlistId) {
 
         if (!list.isEmpty()) {
             beginInsertRows(QModelIndex(), 0, list.size() - 1);
+            // Copy all entries in a single transaction instead of
+            // committing each row separately
+            ScopedTransaction transaction(m_database);
 
             foreach (struct BansheeDbConnection::PlaylistEntry entry, list) {
                 query.bindValue(":" CLM_TRACK_ID, entry.trackId);
@@ -164,6 +167,7 @@ void BansheePlaylistModel::setTableModel(int playlistId) {
                 }
                 // qDebug() << "-----" << entry.pTrack->title << query.executedQuery();
             }
+            transaction.commit();
 
             endInsertRows();
         }
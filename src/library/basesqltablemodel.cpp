@@ -1,6 +1,7 @@
 #include "library/basesqltablemodel.h"
 
 #include <QUrl>
+#include <QtConcurrentRun>
 #include <QtDebug>
 #include <algorithm>
 
@@ -17,6 +18,8 @@
 #include "util/assert.h"
 #include "util/datetime.h"
 #include "util/db/dbconnection.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/db/dbconnectionpooler.h"
 #include "util/duration.h"
 #include "util/performancetimer.h"
 #include "util/platform.h"
@@ -31,6 +34,10 @@ const bool sDebug = false;
 constexpr int kIdColumn = 0;
 constexpr int kMaxSortColumns = 3;
 
+// Cancellation of a pending selection is checked
+// while reading each page of rows
+constexpr int kSelectPageSize = 1000;
+
 // Constant for getModelSetting(name)
 const QString COLUMNS_SORTING = QStringLiteral("ColumnsSorting");
 
@@ -45,10 +52,13 @@ BaseSqlTableModel::BaseSqlTableModel(
         : BaseTrackTableModel(parent, pTrackCollectionManager, settingsNamespace),
           m_pTrackCollectionManager(pTrackCollectionManager),
           m_database(pTrackCollectionManager->internalCollection()->database()),
+          m_pDbConnectionPool(pTrackCollectionManager->dbConnectionPool()),
+          m_pPendingSelectWatcher(nullptr),
           m_bInitialized(false) {
 }
 
 BaseSqlTableModel::~BaseSqlTableModel() {
+    cancelPendingSelect();
 }
 
 void BaseSqlTableModel::initHeaderProperties() {
@@ -192,10 +202,144 @@ void BaseSqlTableModel::replaceRows(
     }
 }
 
+QString BaseSqlTableModel::queryString() const {
+    // Prepare query for id and all columns not in m_trackSource
+    return QString("SELECT %1 FROM %2 %3")
+            .arg(m_tableColumns.join(","), m_tableName, m_tableOrderBy);
+}
+
+QString BaseSqlTableModel::createTemporaryViewStatement() const {
+    // Temporary views only exist for the connection that has created them
+    // and need to be recreated for the connection of the worker thread
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral(
+            "SELECT sql FROM sqlite_temp_master WHERE type='view' AND name=:name"));
+    query.bindValue(":name", m_tableName);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return QString();
+    }
+    if (!query.next()) {
+        // Not a temporary view
+        return QString();
+    }
+    // SQLite stores a normalized statement without the TEMPORARY keyword
+    const QString kCreateView = QStringLiteral("CREATE VIEW ");
+    QString statement = query.value(0).toString();
+    VERIFY_OR_DEBUG_ASSERT(statement.startsWith(kCreateView, Qt::CaseInsensitive)) {
+        return QString();
+    }
+    statement.replace(0, kCreateView.size(), QStringLiteral("CREATE TEMPORARY VIEW "));
+    return statement;
+}
+
+// static
+bool BaseSqlTableModel::readRows(
+        QSqlQuery* pQuery,
+        const QString& idColumn,
+        int columnCount,
+        const std::atomic<bool>* pCanceled,
+        QVector<RowInfo>* pRowInfos,
+        QSet<TrackId>* pTrackIds) {
+    // The size of the result set is not known in advance for a
+    // forward-only query, so we cannot reserve memory for rows
+    // in advance.
+    int idColumnIndex = -1;
+    while (pQuery->next()) {
+        if (pCanceled &&
+                pRowInfos->size() % kSelectPageSize == 0 &&
+                pCanceled->load()) {
+            return false;
+        }
+        QSqlRecord sqlRecord = pQuery->record();
+
+        if (idColumnIndex < 0) {
+            idColumnIndex = sqlRecord.indexOf(idColumn);
+        }
+
+        // TODO(XXX): Can we get rid of the hard-coded assumption that
+        // the the first column always contains the id?
+        DEBUG_ASSERT(idColumnIndex == kIdColumn);
+
+        VERIFY_OR_DEBUG_ASSERT(idColumnIndex >= 0) {
+            qCritical()
+                    << "ID column not available in database query results:"
+                    << idColumn;
+            return false;
+        }
+
+        TrackId trackId(sqlRecord.value(idColumnIndex));
+        pTrackIds->insert(trackId);
+
+        RowInfo rowInfo;
+        rowInfo.trackId = trackId;
+        // current position defines the ordering
+        rowInfo.order = pRowInfos->size();
+        rowInfo.metadata.reserve(sqlRecord.count());
+        for (int i = 0; i < columnCount; ++i) {
+            rowInfo.metadata.push_back(sqlRecord.value(i));
+        }
+        pRowInfos->push_back(rowInfo);
+    }
+    return true;
+}
+
+// static
+BaseSqlTableModel::SelectResult BaseSqlTableModel::selectRowsInBackground(
+        const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
+        const QString& createViewStatement,
+        const QString& queryString,
+        const QString& idColumn,
+        int columnCount,
+        const std::atomic<bool>& canceled) {
+    SelectResult result;
+    // The thread-local connection and all temporary views
+    // are discarded when leaving this scope
+    const mixxx::DbConnectionPooler dbConnectionPooler(pDbConnectionPool);
+    if (!dbConnectionPooler.isPooling()) {
+        return result;
+    }
+    const QSqlDatabase database = mixxx::DbConnectionPooled(pDbConnectionPool);
+    if (!createViewStatement.isEmpty()) {
+        QSqlQuery query(database);
+        if (!query.exec(createViewStatement)) {
+            LOG_FAILED_QUERY(query);
+            return result;
+        }
+    }
+    if (canceled.load()) {
+        return result;
+    }
+
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    if (!query.prepare(queryString)) {
+        LOG_FAILED_QUERY(query);
+        return result;
+    }
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return result;
+    }
+    result.succeeded = readRows(&query,
+            idColumn,
+            columnCount,
+            &canceled,
+            &result.rowInfos,
+            &result.trackIds);
+    return result;
+}
+
 void BaseSqlTableModel::select() {
     if (!m_bInitialized) {
         return;
     }
+    cancelPendingSelect();
+    selectRows();
+    emit selectFinished();
+}
+
+void BaseSqlTableModel::selectRows() {
     // We should be able to detect when a select() would be a no-op. The DAO's
     // do not currently broadcast signals for when common things happen. In the
     // future, we can turn this check on and avoid a lot of needless
@@ -214,9 +358,7 @@ void BaseSqlTableModel::select() {
     PerformanceTimer time;
     time.start();
 
-    // Prepare query for id and all columns not in m_trackSource
-    QString queryString = QString("SELECT %1 FROM %2 %3")
-                                  .arg(m_tableColumns.join(","), m_tableName, m_tableOrderBy);
+    const QString queryString = this->queryString();
 
     if (sDebug) {
         qDebug() << this << "select() executing:" << queryString;
@@ -235,53 +377,111 @@ void BaseSqlTableModel::select() {
         return;
     }
 
-    // Remove all the rows from the table after(!) the query has been
-    // executed successfully. See Bug #1090888.
-    // TODO(rryan) we could edit the table in place instead of clearing it?
-    clearRows();
-
-    // The size of the result set is not known in advance for a
-    // forward-only query, so we cannot reserve memory for rows
-    // in advance.
     QVector<RowInfo> rowInfos;
     QSet<TrackId> trackIds;
-    int idColumn = -1;
-    while (query.next()) {
-        QSqlRecord sqlRecord = query.record();
+    if (!readRows(&query,
+                m_idColumn,
+                m_tableColumns.size(),
+                nullptr,
+                &rowInfos,
+                &trackIds)) {
+        return;
+    }
 
-        if (idColumn < 0) {
-            idColumn = sqlRecord.indexOf(m_idColumn);
-        }
+    applySelectedRows(std::move(rowInfos), trackIds);
 
-        // TODO(XXX): Can we get rid of the hard-coded assumption that
-        // the the first column always contains the id?
-        DEBUG_ASSERT(idColumn == kIdColumn);
+    qDebug() << this << "select() took" << time.elapsed().debugMillisWithUnit()
+             << m_rowInfo.size();
+}
 
-        VERIFY_OR_DEBUG_ASSERT(idColumn >= 0) {
-            qCritical()
-                    << "ID column not available in database query results:"
-                    << m_idColumn;
-            return;
-        }
+void BaseSqlTableModel::selectAsync() {
+    if (!m_bInitialized) {
+        return;
+    }
+    cancelPendingSelect();
+    VERIFY_OR_DEBUG_ASSERT(m_pDbConnectionPool) {
+        select();
+        return;
+    }
 
-        TrackId trackId(sqlRecord.value(idColumn));
-        trackIds.insert(trackId);
+    if (sDebug) {
+        qDebug() << this << "selectAsync()";
+    }
 
-        RowInfo rowInfo;
-        rowInfo.trackId = trackId;
-        // current position defines the ordering
-        rowInfo.order = rowInfos.size();
-        rowInfo.metadata.reserve(sqlRecord.count());
-        for (int i = 0; i < m_tableColumns.size(); ++i) {
-            rowInfo.metadata.push_back(sqlRecord.value(i));
-        }
-        rowInfos.push_back(rowInfo);
+    const auto pCanceled = std::make_shared<std::atomic<bool>>(false);
+    m_pPendingSelectCanceled = pCanceled;
+    // The watcher will be deleted in slotSelectRowsFinished()
+    m_pPendingSelectWatcher = new QFutureWatcher<SelectResult>(this);
+    connect(m_pPendingSelectWatcher,
+            &QFutureWatcher<SelectResult>::finished,
+            this,
+            &BaseSqlTableModel::slotSelectRowsFinished);
+    // Only copies are passed to the worker thread that might
+    // outlive this model
+    m_pPendingSelectWatcher->setFuture(QtConcurrent::run(
+            [pDbConnectionPool = m_pDbConnectionPool,
+                    createViewStatement = createTemporaryViewStatement(),
+                    queryString = queryString(),
+                    idColumn = m_idColumn,
+                    columnCount = m_tableColumns.size(),
+                    pCanceled] {
+                return selectRowsInBackground(
+                        pDbConnectionPool,
+                        createViewStatement,
+                        queryString,
+                        idColumn,
+                        columnCount,
+                        *pCanceled);
+            }));
+}
+
+void BaseSqlTableModel::slotSelectRowsFinished() {
+    auto* pFutureWatcher = static_cast<QFutureWatcher<SelectResult>*>(sender());
+    VERIFY_OR_DEBUG_ASSERT(pFutureWatcher) {
+        return;
+    }
+    pFutureWatcher->deleteLater();
+    if (pFutureWatcher != m_pPendingSelectWatcher) {
+        // Canceled or superseded by a subsequent selection
+        return;
     }
+    m_pPendingSelectWatcher = nullptr;
+    m_pPendingSelectCanceled.reset();
 
+    SelectResult result = pFutureWatcher->result();
+    if (result.succeeded) {
+        applySelectedRows(std::move(result.rowInfos), result.trackIds);
+    } else {
+        // e.g. if the view could not be recreated for the worker
+        qWarning() << this << "Selecting rows in the background failed";
+        selectRows();
+    }
+    emit selectFinished();
+}
+
+void BaseSqlTableModel::cancelPendingSelect() {
+    if (!m_pPendingSelectWatcher) {
+        return;
+    }
+    DEBUG_ASSERT(m_pPendingSelectCanceled);
+    m_pPendingSelectCanceled->store(true);
+    m_pPendingSelectCanceled.reset();
+    // The watcher is deleted when the worker has finished
+    m_pPendingSelectWatcher = nullptr;
+}
+
+void BaseSqlTableModel::applySelectedRows(
+        QVector<RowInfo>&& rowInfos,
+        const QSet<TrackId>& trackIds) {
     if (sDebug) {
         qDebug() << "Rows actually received:" << rowInfos.size();
     }
 
+    // Remove all the rows from the table after(!) the query has been
+    // executed successfully. See Bug #1090888.
+    // TODO(rryan) we could edit the table in place instead of clearing it?
+    clearRows();
+
     if (m_trackSource) {
         m_trackSource->filterAndSort(trackIds,
                 m_currentSearch,
@@ -336,9 +536,6 @@ void BaseSqlTableModel::select() {
             std::move(trackIdToRows));
     // Both rowInfo and trackIdToRows (might) have been moved and
     // must not be used afterwards!
-
-    qDebug() << this << "select() took" << time.elapsed().debugMillisWithUnit()
-             << m_rowInfo.size();
 }
 
 void BaseSqlTableModel::setTable(const QString& tableName,
@@ -419,7 +616,7 @@ void BaseSqlTableModel::search(const QString& searchText, const QString& extraFi
         qDebug() << this << "search" << searchText;
     }
     setSearch(searchText, extraFilter);
-    select();
+    selectAsync();
 }
 
 void BaseSqlTableModel::setSort(int column, Qt::SortOrder order) {
@@ -564,7 +761,7 @@ void BaseSqlTableModel::sort(int column, Qt::SortOrder order) {
         qDebug() << this << "sort()" << column << order;
     }
     setSort(column, order);
-    select();
+    selectAsync();
 }
 
 int BaseSqlTableModel::rowCount(const QModelIndex& parent) const {
@@ -832,16 +1029,33 @@ void BaseSqlTableModel::tracksChanged(const QSet<TrackId>& trackIds) {
         qDebug() << this << "trackChanged" << trackIds.size();
     }
 
-    const int numColumns = columnCount();
+    QVector<int> rows;
     for (const auto& trackId : trackIds) {
-        const auto rows = getTrackRows(trackId);
-        for (int row : rows) {
-            //qDebug() << "Row in this result set was updated. Signalling update. track:" << trackId << "row:" << row;
-            QModelIndex topLeft = index(row, 0);
-            QModelIndex bottomRight = index(row, numColumns);
-            emit dataChanged(topLeft, bottomRight);
+        rows += getTrackRows(trackId);
+    }
+    if (rows.isEmpty()) {
+        return;
+    }
+    std::sort(rows.begin(), rows.end());
+
+    // Signal each stride of adjacent rows at once instead of each row
+    // separately. Every signal makes the views update their editors and
+    // schedule a repaint of the viewport.
+    const int lastColumn = columnCount() - 1;
+    int beginRow = rows.first();
+    int endRow = beginRow + 1;
+    for (int row : qAsConst(rows)) {
+        if (row < endRow) {
+            // Skip duplicates
+            continue;
+        }
+        if (row > endRow) {
+            emit dataChanged(index(beginRow, 0), index(endRow - 1, lastColumn));
+            beginRow = row;
         }
+        endRow = row + 1;
     }
+    emit dataChanged(index(beginRow, 0), index(endRow - 1, lastColumn));
 }
 
 void BaseSqlTableModel::hideTracks(const QModelIndexList& indices) {
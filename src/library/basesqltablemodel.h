@@ -1,13 +1,17 @@
 #pragma once
 
+#include <QFutureWatcher>
 #include <QHash>
 #include <QtSql>
+#include <atomic>
+#include <memory>
 
 #include "library/basetrackcache.h"
 #include "library/dao/trackdao.h"
 #include "library/basetracktablemodel.h"
 #include "library/columncache.h"
 #include "util/class.h"
+#include "util/db/dbconnectionpool.h"
 
 class TrackCollectionManager;
 
@@ -67,6 +71,15 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     void select() override;
 
+    /// Selects the rows on a worker thread. The current rows remain
+    /// visible until the new rows are available. A pending selection is
+    /// canceled by any subsequent selection.
+    void selectAsync();
+
+    bool isSelectPending() const {
+        return m_pPendingSelectWatcher != nullptr;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Inherited from BaseTrackTableModel
     ///////////////////////////////////////////////////////////////////////////
@@ -106,8 +119,14 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     int m_columnIndexBySortColumnId[static_cast<int>(TrackModel::SortColumnId::IdMax)];
     QMap<int, TrackModel::SortColumnId> m_sortColumnIdByColumnIndex;
 
+  signals:
+    /// Emitted after each selection, both synchronous
+    /// and asynchronous, even if it has failed
+    void selectFinished();
+
   private slots:
     void tracksChanged(const QSet<TrackId>& trackIds);
+    void slotSelectRowsFinished();
 
   private:
     void setTrackValueForColumn(
@@ -136,6 +155,36 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     typedef QHash<TrackId, QVector<int>> TrackId2Rows;
 
+    struct SelectResult {
+        bool succeeded = false;
+        QVector<RowInfo> rowInfos;
+        QSet<TrackId> trackIds;
+    };
+
+    QString queryString() const;
+    QString createTemporaryViewStatement() const;
+
+    static bool readRows(
+            QSqlQuery* pQuery,
+            const QString& idColumn,
+            int columnCount,
+            const std::atomic<bool>* pCanceled,
+            QVector<RowInfo>* pRowInfos,
+            QSet<TrackId>* pTrackIds);
+    static SelectResult selectRowsInBackground(
+            const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
+            const QString& createViewStatement,
+            const QString& queryString,
+            const QString& idColumn,
+            int columnCount,
+            const std::atomic<bool>& canceled);
+
+    void selectRows();
+    void applySelectedRows(
+            QVector<RowInfo>&& rowInfos,
+            const QSet<TrackId>& trackIds);
+    void cancelPendingSelect();
+
     void clearRows();
     void replaceRows(
             QVector<RowInfo>&& rows,
@@ -143,6 +192,10 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     QVector<RowInfo> m_rowInfo;
 
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    QFutureWatcher<SelectResult>* m_pPendingSelectWatcher;
+    std::shared_ptr<std::atomic<bool>> m_pPendingSelectCanceled;
+
     QString m_idColumn;
     QSharedPointer<BaseTrackCache> m_trackSource;
     QStringList m_tableColumns;
@@ -1,5 +1,8 @@
 #include "library/basetrackcache.h"
 
+#include <algorithm>
+
+#include "library/dao/trackschema.h"
 #include "library/queryutil.h"
 #include "library/searchqueryparser.h"
 #include "library/trackcollection.h"
@@ -7,12 +10,38 @@
 #include "track/globaltrackcache.h"
 #include "track/keyutils.h"
 #include "track/track.h"
+#include "util/metrics.h"
 #include "util/performancetimer.h"
 
 namespace {
 
 constexpr bool sDebug = false;
 
+// The number of search results that are kept up to date
+constexpr std::size_t kMaxMaterializedQueries = 8;
+
+QStringList searchIndexColumns(const ColumnCache& columnCache) {
+    const QStringList columns = {
+            LIBRARYTABLE_ARTIST,
+            LIBRARYTABLE_ALBUMARTIST,
+            LIBRARYTABLE_ALBUM,
+            LIBRARYTABLE_TITLE,
+            LIBRARYTABLE_GENRE,
+            LIBRARYTABLE_COMPOSER,
+            LIBRARYTABLE_GROUPING,
+            LIBRARYTABLE_COMMENT,
+            TRACKLOCATIONSTABLE_LOCATION,
+    };
+    // Only the columns that are available in this table
+    QStringList indexedColumns;
+    for (const auto& column : columns) {
+        if (columnCache.fieldIndex(column) >= 0) {
+            indexedColumns.append(column);
+        }
+    }
+    return indexedColumns;
+}
+
 }  // namespace
 
 BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
@@ -28,7 +57,14 @@ BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
           m_pQueryParser(new SearchQueryParser(pTrackCollection)),
           m_bIndexBuilt(false),
           m_bIsCaching(isCaching),
+          m_trackInfo(columns.size()),
+          m_accountedBytes(0),
+          m_searchIndex(searchIndexColumns(m_columnCache)),
           m_database(pTrackCollection->database()) {
+    for (const auto& column : m_searchIndex.columns()) {
+        m_searchIndexFieldIndices.append(m_columnCache.fieldIndex(column));
+    }
+
     m_searchColumns << "artist"
                     << "album"
                     << "album_artist"
@@ -48,8 +84,9 @@ BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
 }
 
 BaseTrackCache::~BaseTrackCache() {
-    // Required to allow forward declarations of (managed pointer) members
-    // in header file
+    // Defined here to allow forward declarations of (managed pointer)
+    // members in header file
+    mixxx::metrics::trackCacheBytes.add(-m_accountedBytes);
 }
 
 int BaseTrackCache::columnCount() const {
@@ -91,9 +128,14 @@ void BaseTrackCache::slotTracksRemoved(const QSet<TrackId>& trackIds) {
         qDebug() << this << "slotTracksRemoved" << trackIds.size();
     }
     for (const auto& trackId : qAsConst(trackIds)) {
-        m_trackInfo.remove(trackId);
+        m_trackInfo.removeRow(trackId);
+        m_searchIndex.removeTrack(trackId);
         m_dirtyTracks.remove(trackId);
     }
+    for (const auto& pMaterializedQuery : m_materializedQueries) {
+        pMaterializedQuery->matchingTrackIds.subtract(trackIds);
+    }
+    updateAccountedBytes();
 }
 
 void BaseTrackCache::slotTrackDirty(TrackId trackId) {
@@ -126,6 +168,7 @@ void BaseTrackCache::ensureCached(const QSet<TrackId>& trackIds) {
 
 void BaseTrackCache::setSearchColumns(const QStringList& columns) {
     m_searchColumns = columns;
+    m_materializedQueries.clear();
 }
 
 const TrackPointer& BaseTrackCache::getRecentTrack(TrackId trackId) const {
@@ -218,14 +261,19 @@ bool BaseTrackCache::updateTrackInIndex(
 
     TrackId trackId = pTrack->getId();
     if (trackId.isValid()) {
-        // m_trackInfo[id] will insert a QVector<QVariant> into the
-        // m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        // preallocate memory for all columns at once
-        record.resize(numColumns);
+        const int row = m_trackInfo.insertRow(trackId);
         for (int i = 0; i < numColumns; ++i) {
-            getTrackValueForColumn(pTrack, i, record[i]);
+            QVariant trackValue;
+            getTrackValueForColumn(pTrack, i, trackValue);
+            // Columns that are not available from the track object
+            // keep their current value
+            if (trackValue.isValid()) {
+                m_trackInfo.setValue(row, i, trackValue);
+            }
         }
+        updateSearchIndex(trackId, row);
+        updateAccountedBytes();
+        updateMaterializedQueries(pTrack);
         if (m_bIsCaching) {
             replaceRecentTrack(std::move(trackId), std::move(pTrack));
         }
@@ -266,22 +314,20 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
     while (query.next()) {
         TrackId trackId(query.value(idColumn));
 
-        //m_trackInfo[id] will insert a QVector<QVariant> into the
-        //m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        record.resize(numColumns);
-
+        const int row = m_trackInfo.insertRow(trackId);
         for (int i = 0; i < numColumns; ++i) {
             if (fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION) == i) {
                 // Database stores all locations with Qt separators: "/"
                 // Here we want to cache the display string with native separators.
                 QString location = query.value(i).toString();
-                record[i] = QDir::toNativeSeparators(location);
+                m_trackInfo.setValue(row, i, QDir::toNativeSeparators(location));
             } else {
-                record[i] = query.value(i);
+                m_trackInfo.setValue(row, i, query.value(i));
             }
         }
+        updateSearchIndex(trackId, row);
     }
+    updateAccountedBytes();
 
     qDebug() << this << "updateIndexWithQuery took" << timer.elapsed().debugMillisWithUnit();
     return true;
@@ -303,6 +349,9 @@ void BaseTrackCache::buildIndex() {
     // clear the table, and keep track of what IDs we see, then delete the ones
     // we don't see.
     m_trackInfo.clear();
+    m_searchIndex.clear();
+    m_materializedQueries.clear();
+    updateAccountedBytes();
 
     if (!updateIndexWithQuery(queryString)) {
         qDebug() << "buildIndex failed!";
@@ -338,9 +387,135 @@ void BaseTrackCache::updateTracksInIndex(const QSet<TrackId>& trackIds) {
         qDebug() << "updateTracksInIndex failed!";
         return;
     }
+    updateMaterializedQueries(trackIds);
     emit tracksChanged(trackIds);
 }
 
+const BaseTrackCache::MaterializedQuery* BaseTrackCache::materializeQuery(
+        const QString& searchQuery) {
+    const auto it = std::find_if(m_materializedQueries.begin(),
+            m_materializedQueries.end(),
+            [&searchQuery](const auto& pMaterializedQuery) {
+                return pMaterializedQuery->searchQuery == searchQuery;
+            });
+    if (it != m_materializedQueries.end()) {
+        // Move to the front
+        std::rotate(m_materializedQueries.begin(), it, it + 1);
+        return m_materializedQueries.front().get();
+    }
+
+    auto pMaterializedQuery = std::make_unique<MaterializedQuery>();
+    pMaterializedQuery->searchQuery = searchQuery;
+    pMaterializedQuery->pQuery = m_pQueryParser->parseQuery(
+            searchQuery,
+            m_searchColumns,
+            QString());
+    if (!pMaterializedQuery->pQuery->matchesTrackValuesOnly()) {
+        // Could not be updated incrementally
+        return nullptr;
+    }
+    if (!selectMatchingTracks(*pMaterializedQuery->pQuery,
+                QString(),
+                &pMaterializedQuery->matchingTrackIds)) {
+        return nullptr;
+    }
+    if (m_materializedQueries.size() >= kMaxMaterializedQueries) {
+        m_materializedQueries.pop_back();
+    }
+    m_materializedQueries.insert(
+            m_materializedQueries.begin(), std::move(pMaterializedQuery));
+    return m_materializedQueries.front().get();
+}
+
+bool BaseTrackCache::selectMatchingTracks(const QueryNode& query,
+        const QString& idFilter,
+        QSet<TrackId>* pTrackIds) const {
+    QStringList queryFragments;
+    const QString searchFilter = query.toSql();
+    if (!searchFilter.isEmpty()) {
+        queryFragments << QString("(%1)").arg(searchFilter);
+    }
+    if (!idFilter.isEmpty()) {
+        queryFragments << QString("(%1)").arg(idFilter);
+    }
+    QString filter = queryFragments.join(" AND ");
+    if (!filter.isEmpty()) {
+        filter.prepend("WHERE ");
+    }
+    QSqlQuery sqlQuery(m_database);
+    sqlQuery.setForwardOnly(true);
+    sqlQuery.prepare(QString("SELECT %1 FROM %2 %3")
+                             .arg(m_idColumn, m_tableName, filter));
+    if (!sqlQuery.exec()) {
+        LOG_FAILED_QUERY(sqlQuery);
+        return false;
+    }
+    while (sqlQuery.next()) {
+        pTrackIds->insert(TrackId(sqlQuery.value(0)));
+    }
+    return true;
+}
+
+void BaseTrackCache::updateMaterializedQueries(const QSet<TrackId>& trackIds) {
+    if (m_materializedQueries.empty()) {
+        return;
+    }
+    QStringList idStrings;
+    idStrings.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        idStrings << trackId.toString();
+    }
+    const QString idFilter = QString("%1 in (%2)")
+                                     .arg(m_idColumn, idStrings.join(","));
+    for (const auto& pMaterializedQuery : m_materializedQueries) {
+        // Only the modified tracks are evaluated again
+        QSet<TrackId> matchingTrackIds;
+        if (!selectMatchingTracks(*pMaterializedQuery->pQuery,
+                    idFilter,
+                    &matchingTrackIds)) {
+            // The results are outdated now
+            m_materializedQueries.clear();
+            return;
+        }
+        pMaterializedQuery->matchingTrackIds.subtract(trackIds);
+        pMaterializedQuery->matchingTrackIds.unite(matchingTrackIds);
+    }
+}
+
+void BaseTrackCache::updateMaterializedQueries(const TrackPointer& pTrack) {
+    const TrackId trackId = pTrack->getId();
+    for (const auto& pMaterializedQuery : m_materializedQueries) {
+        if (pMaterializedQuery->pQuery->match(pTrack)) {
+            pMaterializedQuery->matchingTrackIds.insert(trackId);
+        } else {
+            pMaterializedQuery->matchingTrackIds.remove(trackId);
+        }
+    }
+}
+
+void BaseTrackCache::updateSearchIndex(TrackId trackId, int row) {
+    const int locationFieldIndex =
+            fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION);
+    QStringList values;
+    values.reserve(m_searchIndexFieldIndices.size());
+    for (const int i : qAsConst(m_searchIndexFieldIndices)) {
+        if (i == locationFieldIndex) {
+            // The SQL query matches the location with Qt separators
+            values.append(QDir::fromNativeSeparators(
+                    m_trackInfo.value(row, i).toString()));
+        } else {
+            values.append(m_trackInfo.value(row, i).toString());
+        }
+    }
+    m_searchIndex.updateTrack(trackId, values);
+}
+
+void BaseTrackCache::updateAccountedBytes() {
+    const qint64 bytes = m_trackInfo.memoryUsage();
+    mixxx::metrics::trackCacheBytes.add(bytes - m_accountedBytes);
+    m_accountedBytes = bytes;
+}
+
 void BaseTrackCache::getTrackValueForColumn(TrackPointer pTrack,
                                             int column,
                                             QVariant& trackValue) const {
@@ -352,73 +527,79 @@ void BaseTrackCache::getTrackValueForColumn(TrackPointer pTrack,
         replaceRecentTrack(pTrack);
     }
 
+    // Read all properties from a single snapshot instead of locking the
+    // track for each of them.
+    const auto pRecord = pTrack->getRecordSnapshot();
+    const auto& trackMetadata = pRecord->getMetadata();
+    const auto& trackInfo = trackMetadata.getTrackInfo();
+
     // TODO(XXX) Qt properties could really help here.
     // TODO(rryan) this is all TrackDAO specific. What about iTunes/RB/etc.?
     if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ARTIST) == column) {
-        trackValue.setValue(pTrack->getArtist());
+        trackValue.setValue(trackInfo.getArtist());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TITLE) == column) {
-        trackValue.setValue(pTrack->getTitle());
+        trackValue.setValue(trackInfo.getTitle());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ALBUM) == column) {
-        trackValue.setValue(pTrack->getAlbum());
+        trackValue.setValue(trackMetadata.getAlbumInfo().getTitle());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ALBUMARTIST) == column) {
-        trackValue.setValue(pTrack->getAlbumArtist());
+        trackValue.setValue(trackMetadata.getAlbumInfo().getArtist());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR) == column) {
-        trackValue.setValue(pTrack->getYear());
+        trackValue.setValue(trackInfo.getYear());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DATETIMEADDED) == column) {
-        trackValue.setValue(pTrack->getDateAdded());
+        trackValue.setValue(pRecord->getDateAdded());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_LAST_PLAYED_AT) == column) {
-        trackValue.setValue(pTrack->getLastPlayedAt());
+        trackValue.setValue(pRecord->getPlayCounter().getLastPlayedAt());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_GENRE) == column) {
-        trackValue.setValue(pTrack->getGenre());
+        trackValue.setValue(trackInfo.getGenre());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COMPOSER) == column) {
-        trackValue.setValue(pTrack->getComposer());
+        trackValue.setValue(trackInfo.getComposer());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_GROUPING) == column) {
-        trackValue.setValue(pTrack->getGrouping());
+        trackValue.setValue(trackInfo.getGrouping());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_FILETYPE) == column) {
-        trackValue.setValue(pTrack->getType());
+        trackValue.setValue(pRecord->getFileType());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER) == column) {
-        trackValue.setValue(pTrack->getTrackNumber());
+        trackValue.setValue(trackInfo.getTrackNumber());
     } else if (fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION) == column) {
         trackValue.setValue(QDir::toNativeSeparators(pTrack->getLocation()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COMMENT) == column) {
-        trackValue.setValue(pTrack->getComment());
+        trackValue.setValue(trackInfo.getComment());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DURATION) == column) {
-        trackValue.setValue(pTrack->getDuration());
+        trackValue.setValue(trackMetadata.getStreamInfo().getDuration().toDoubleSeconds());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BITRATE) == column) {
-        trackValue.setValue(pTrack->getBitrate());
+        trackValue.setValue(static_cast<int>(trackMetadata.getStreamInfo().getBitrate()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM) == column) {
         trackValue.setValue(pTrack->getBpm());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_REPLAYGAIN) == column) {
-        trackValue.setValue(pTrack->getReplayGain().getRatio());
+        trackValue.setValue(trackInfo.getReplayGain().getRatio());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_PLAYED) == column) {
-        trackValue.setValue(pTrack->getPlayCounter().isPlayed());
+        trackValue.setValue(pRecord->getPlayCounter().isPlayed());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED) == column) {
-        trackValue.setValue(pTrack->getPlayCounter().getTimesPlayed());
+        trackValue.setValue(pRecord->getPlayCounter().getTimesPlayed());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_RATING) == column) {
-        trackValue.setValue(pTrack->getRating());
+        trackValue.setValue(pRecord->getRating());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY) == column) {
-        trackValue.setValue(pTrack->getKeyText());
+        trackValue.setValue(pRecord->getGlobalKeyText());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY_ID) == column) {
-        trackValue.setValue(static_cast<int>(pTrack->getKey()));
+        trackValue.setValue(static_cast<int>(pRecord->getGlobalKey()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM_LOCK) == column) {
-        trackValue.setValue(pTrack->isBpmLocked());
+        trackValue.setValue(pRecord->getBpmLocked());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COLOR) == column) {
-        trackValue.setValue(mixxx::RgbColor::toQVariant(pTrack->getColor()));
+        trackValue.setValue(mixxx::RgbColor::toQVariant(pRecord->getColor()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_LOCATION) == column) {
-        trackValue.setValue(pTrack->getCoverInfo().coverLocation);
+        trackValue.setValue(pRecord->getCoverInfo().coverLocation);
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_HASH) == column ||
             fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART) == column) {
         // For sorting, we give COLUMN_LIBRARYTABLE_COVERART the same value as
         // the cover digest.
-        trackValue.setValue(pTrack->getCoverInfo().imageDigest());
+        trackValue.setValue(pRecord->getCoverInfo().imageDigest());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_COLOR) == column) {
-        trackValue.setValue(mixxx::RgbColor::toQVariant(pTrack->getCoverInfo().color));
+        trackValue.setValue(mixxx::RgbColor::toQVariant(pRecord->getCoverInfo().color));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_DIGEST) == column) {
-        trackValue.setValue(pTrack->getCoverInfo().imageDigest());
+        trackValue.setValue(pRecord->getCoverInfo().imageDigest());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_SOURCE) == column) {
-        trackValue.setValue(static_cast<int>(pTrack->getCoverInfo().source));
+        trackValue.setValue(static_cast<int>(pRecord->getCoverInfo().source));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_TYPE) == column) {
-        trackValue.setValue(static_cast<int>(pTrack->getCoverInfo().type));
+        trackValue.setValue(static_cast<int>(pRecord->getCoverInfo().type));
     }
 }
 
@@ -445,10 +626,9 @@ QVariant BaseTrackCache::data(TrackId trackId, int column) const {
     // metadata. Currently the upper-levels will not delegate row-specific
     // columns to this method, but there should still be a check here I think.
     if (!result.isValid()) {
-        auto it = m_trackInfo.constFind(trackId);
-        if (it != m_trackInfo.constEnd()) {
-            const QVector<QVariant>& fields = it.value();
-            result = fields.value(column, result);
+        const int row = m_trackInfo.rowOf(trackId);
+        if (row >= 0) {
+            result = m_trackInfo.value(row, column);
         }
     }
     return result;
@@ -470,12 +650,49 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         buildIndex();
     }
 
+    const std::unique_ptr<QueryNode> pQuery =
+            m_pQueryParser->parseQuery(
+                    searchQuery,
+                    m_searchColumns,
+                    QString());
+
+    // Evaluate the search query in memory if possible. Only the remaining
+    // tracks are then passed to the SQL query for applying the extra
+    // filter and sorting.
+    std::optional<QSet<TrackId>> indexMatches;
+    if (!searchQuery.isEmpty() && m_searchIndex.size() > 0) {
+        bool allTracksIndexed = true;
+        for (const auto& trackId : trackIds) {
+            if (!m_searchIndex.contains(trackId)) {
+                allTracksIndexed = false;
+                break;
+            }
+        }
+        if (allTracksIndexed) {
+            indexMatches = pQuery->matchIndex(m_searchIndex, trackIds);
+        }
+    }
+    // Materializing the search query for the whole table only pays off
+    // when (almost) all tracks are filtered, e.g. in the library view
+    if (!indexMatches && !searchQuery.isEmpty() &&
+            trackIds.size() * 2 >= m_searchIndex.size()) {
+        const MaterializedQuery* pMaterializedQuery = materializeQuery(searchQuery);
+        if (pMaterializedQuery) {
+            indexMatches = QSet<TrackId>(trackIds).intersect(
+                    pMaterializedQuery->matchingTrackIds);
+        }
+    }
+    const QSet<TrackId>& selectedTrackIds = indexMatches ? *indexMatches : trackIds;
+
     QStringList idStrings;
+    idStrings.reserve(selectedTrackIds.size());
+    for (const auto& trackId : selectedTrackIds) {
+        idStrings << trackId.toString();
+    }
     // TODO(rryan) consider making this the data passed in and a separate
     // QVector for output
     QSet<TrackId> dirtyTracks;
     for (const auto& trackId: trackIds) {
-        idStrings << trackId.toString();
         if (m_dirtyTracks.contains(trackId)) {
             dirtyTracks.insert(trackId);
         }
@@ -485,18 +702,19 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
     if (!extraFilter.isNull() && extraFilter != "") {
         queryFragments << QString("(%1)").arg(extraFilter);
     }
-    if (idStrings.size() > 0) {
+    if (idStrings.size() > 0 || indexMatches) {
+        // An empty list is valid and matches no tracks
         queryFragments << QString("%1 in (%2)")
                 .arg(m_idColumn, idStrings.join(","));
     }
+    if (!indexMatches) {
+        const QString searchFilter = pQuery->toSql();
+        if (!searchFilter.isEmpty()) {
+            queryFragments << QString("(%1)").arg(searchFilter);
+        }
+    }
 
-    const std::unique_ptr<QueryNode> pQuery =
-            m_pQueryParser->parseQuery(
-                    searchQuery,
-                    m_searchColumns,
-                    queryFragments.join(" AND "));
-
-    QString filter = pQuery->toSql();
+    QString filter = queryFragments.join(" AND ");
     if (!filter.isEmpty()) {
         filter.prepend("WHERE ");
     }
@@ -617,13 +835,24 @@ int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
         const QList<SortColumn>& sortColumns,
         const int columnOffset,
         const QVector<TrackId>& trackIds) const {
-    QList<QVariant> trackValues;
     if (sortColumns.isEmpty()) {
         return 0;
     }
+    // The values of the track are compared repeatedly against the cached
+    // values of other tracks. Strings are compared by their collation sort
+    // keys that are calculated only once.
+    QList<QVariant> trackValues;
+    QList<std::optional<QCollatorSortKey>> trackSortKeys;
     for (const auto& sc: sortColumns) {
+        const int column = sc.m_column - columnOffset;
         QVariant trackValue;
-        getTrackValueForColumn(pTrack, sc.m_column - columnOffset, trackValue);
+        getTrackValueForColumn(pTrack, column, trackValue);
+        if (isNumericSortColumn(column) ||
+                column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY)) {
+            trackSortKeys.append(std::nullopt);
+        } else {
+            trackSortKeys.append(m_trackInfo.sortKeyOf(trackValue.toString()));
+        }
         trackValues.append(trackValue);
     }
 
@@ -641,23 +870,33 @@ int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
         int mid = min + (max - min) / 2;
         TrackId otherTrackId(trackIds[mid]);
 
+        const int otherRow = m_trackInfo.rowOf(otherTrackId);
         // This should not happen, but it's a recoverable error so we should
         // only log it.
-        if (!m_trackInfo.contains(otherTrackId)) {
+        if (otherRow < 0) {
             qDebug() << "WARNING: track" << otherTrackId << "was not in index";
-            //updateTrackInIndex(otherTrackId);
         }
 
         int compare = 0;
         for (int i = 0; i < sortColumns.count(); i++) {
-            QVariant tableValue =
-                    data(otherTrackId, sortColumns[i].m_column - columnOffset);
-
-            compare = compareColumnValues(
-                    sortColumns[i].m_column - columnOffset,
-                    sortColumns[i].m_order,
-                    trackValues[i],
-                    tableValue);
+            const int column = sortColumns[i].m_column - columnOffset;
+            if (otherRow < 0) {
+                compare = compareColumnValues(column,
+                        sortColumns[i].m_order,
+                        trackValues[i],
+                        QVariant());
+            } else if (trackSortKeys[i]) {
+                compare = trackSortKeys[i]->compare(
+                        m_trackInfo.sortKey(otherRow, column));
+                if (sortColumns[i].m_order == Qt::DescendingOrder) {
+                    compare = -compare;
+                }
+            } else {
+                compare = compareColumnValues(column,
+                        sortColumns[i].m_order,
+                        trackValues[i],
+                        m_trackInfo.value(otherRow, column));
+            }
 
             if (compare != 0) {
                 break;
@@ -678,13 +917,8 @@ int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
     return min;
 }
 
-int BaseTrackCache::compareColumnValues(int sortColumn,
-        Qt::SortOrder sortOrder,
-        const QVariant& val1,
-        const QVariant& val2) const {
-    int result = 0;
-
-    if (sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR) ||
+bool BaseTrackCache::isNumericSortColumn(int sortColumn) const {
+    return sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR) ||
             sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER) ||
             sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DURATION) ||
             sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BITRATE) ||
@@ -694,8 +928,16 @@ int BaseTrackCache::compareColumnValues(int sortColumn,
             sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_CHANNELS) ||
             sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED) ||
             sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_RATING) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION)
-    ) {
+            sortColumn == fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
+}
+
+int BaseTrackCache::compareColumnValues(int sortColumn,
+        Qt::SortOrder sortOrder,
+        const QVariant& val1,
+        const QVariant& val2) const {
+    int result = 0;
+
+    if (isNumericSortColumn(sortColumn)) {
         // Sort as floats.
         double delta = val1.toDouble() - val2.toDouble();
 
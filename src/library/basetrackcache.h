@@ -9,13 +9,17 @@
 #include <QStringList>
 #include <QVector>
 #include <memory>
+#include <vector>
 
 #include "library/columncache.h"
+#include "library/trackcolumnstore.h"
+#include "library/tracksearchindex.h"
 #include "track/track_decl.h"
 #include "track/trackid.h"
 #include "util/class.h"
 #include "util/string.h"
 
+class QueryNode;
 class SearchQueryParser;
 class TrackCollection;
 
@@ -92,17 +96,36 @@ class BaseTrackCache : public QObject {
     void replaceRecentTrack(TrackId trackId, TrackPointer pTrack) const;
     void resetRecentTrack() const;
 
+    struct MaterializedQuery {
+        QString searchQuery;
+        std::unique_ptr<QueryNode> pQuery;
+        QSet<TrackId> matchingTrackIds;
+    };
+
+    // Returns nullptr if the search query cannot be materialized
+    const MaterializedQuery* materializeQuery(const QString& searchQuery);
+    bool selectMatchingTracks(const QueryNode& query,
+            const QString& idFilter,
+            QSet<TrackId>* pTrackIds) const;
+    void updateMaterializedQueries(const QSet<TrackId>& trackIds);
+    void updateMaterializedQueries(const TrackPointer& pTrack);
+
     bool updateIndexWithQuery(const QString& query);
     void updateTrackInIndex(TrackId trackId);
     bool updateTrackInIndex(const TrackPointer& pTrack);
     void updateTracksInIndex(const QSet<TrackId>& trackIds);
     void getTrackValueForColumn(TrackPointer pTrack, int column,
                                 QVariant& trackValue) const;
+    void updateSearchIndex(TrackId trackId, int row);
+    // Publishes the changed memory usage of m_trackInfo
+    void updateAccountedBytes();
 
     int findSortInsertionPoint(TrackPointer pTrack,
                                const QList<SortColumn>& sortColumns,
                                const int columnOffset,
                                const QVector<TrackId>& trackIds) const;
+    // Numeric columns are not sorted by collating strings
+    bool isNumericSortColumn(int sortColumn) const;
     int compareColumnValues(int sortColumn,
             Qt::SortOrder sortOrder,
             const QVariant& val1,
@@ -147,7 +170,18 @@ class BaseTrackCache : public QObject {
 
     bool m_bIndexBuilt;
     bool m_bIsCaching;
-    QHash<TrackId, QVector<QVariant>> m_trackInfo;
+    TrackColumnStore m_trackInfo;
+    qint64 m_accountedBytes;
+    // Evaluates text searches in memory instead of scanning
+    // the SQL table
+    TrackSearchIndex m_searchIndex;
+    QVector<int> m_searchIndexFieldIndices;
+    // The tracks that match recent search queries, which cannot be
+    // evaluated with the search index. Opening the same search again,
+    // e.g. the saved search of a smart crate, doesn't need to run the
+    // search query on the whole table again. The results are updated
+    // incrementally for modified tracks only. Most recently used first.
+    std::vector<std::unique_ptr<MaterializedQuery>> m_materializedQueries;
     QSqlDatabase m_database;
 
     DISALLOW_COPY_AND_ASSIGN(BaseTrackCache);
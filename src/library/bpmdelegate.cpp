@@ -84,11 +84,32 @@ void BPMDelegate::paintItem(QPainter* painter,const QStyleOptionViewItem &option
     QStyleOptionViewItem opt = option;
     initStyleOption(&opt, index);
 
-    if (m_pTableView != nullptr) {
-        QStyle* style = m_pTableView->style();
-        if (style != nullptr) {
-            style->drawControl(QStyle::CE_ItemViewItem, &opt, painter,
-                               m_pCheckBox);
-        }
+    if (m_pTableView == nullptr) {
+        return;
     }
+    QStyle* style = m_pTableView->style();
+    if (style == nullptr) {
+        return;
+    }
+
+    // Resolving the style sheet rules is expensive, so the rendered cells are
+    // cached by everything that affects the style of the cell.
+    const QString key = QStringLiteral("bpm|") + opt.text + QChar('|') +
+            QString::number(opt.checkState) + QChar('|') +
+            QString::number(static_cast<int>(opt.state)) + QChar('|') +
+            QString::number(static_cast<int>(opt.features)) + QChar('|') +
+            QString::number(opt.viewItemPosition) + QChar('|') +
+            QString::number(opt.backgroundBrush.style()) + QChar('|') +
+            QString::number(opt.backgroundBrush.color().rgba(), 16);
+    drawCachedCellPixmap(painter,
+            opt.rect,
+            key,
+            [this, style, &opt](QPainter* pPixmapPainter, const QRect& rect) {
+                QStyleOptionViewItem pixmapOpt = opt;
+                pixmapOpt.rect = rect;
+                style->drawControl(QStyle::CE_ItemViewItem,
+                        &pixmapOpt,
+                        pPixmapPainter,
+                        m_pCheckBox);
+            });
 }
@@ -1,17 +1,46 @@
 #include "library/browse/browsethread.h"
 
+#include <QDataStream>
 #include <QDateTime>
+#include <QDir>
 #include <QDirIterator>
+#include <QFile>
+#include <QFuture>
+#include <QQueue>
+#include <QSaveFile>
 #include <QStringList>
+#include <QtConcurrentRun>
 #include <QtDebug>
+#include <algorithm>
 
 #include "library/browse/browsetablemodel.h"
 #include "moc_browsethread.cpp"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
+#include "util/cmdlineargs.h"
 #include "util/datetime.h"
 #include "util/trace.h"
 
+namespace {
+
+constexpr int kMaxMetadataReaderThreads = 4;
+
+// Bounds the number of files that are read ahead of the
+// rows that have been appended
+constexpr int kMaxPendingFiles = 4 * kMaxMetadataReaderThreads;
+
+constexpr int kMaxRowsPerBatch = 50;
+
+constexpr int kMaxCachedFiles = 50000;
+
+const QString kMetadataCacheFileName = QStringLiteral("browse_metadata.cache");
+
+// Must be incremented when changing the serialized fields
+constexpr qint32 kMetadataCacheVersion = 1;
+constexpr QDataStream::Version kMetadataCacheStreamVersion = QDataStream::Qt_5_12;
+
+} // anonymous namespace
+
 QWeakPointer<BrowseThread> BrowseThread::m_weakInstanceRef;
 static QMutex s_Mutex;
 
@@ -27,9 +56,12 @@ static QMutex s_Mutex;
  * make sense to use this class in non-GUI threads
  */
 BrowseThread::BrowseThread(QObject *parent)
-        : QThread(parent) {
+        : QThread(parent),
+          m_metadataCacheModified(false) {
     m_bStopThread = false;
     m_model_observer = nullptr;
+    m_metadataReaderPool.setMaxThreadCount(
+            std::min(QThread::idealThreadCount(), kMaxMetadataReaderThreads));
     //start Thread
     start(QThread::LowPriority);
 
@@ -71,6 +103,7 @@ void BrowseThread::executePopulation(mixxx::FileAccess path, BrowseTableModel* c
 
 void BrowseThread::run() {
     QThread::currentThread()->setObjectName("BrowseThread");
+    loadMetadataCache();
     m_mutex.lock();
 
     while (!m_bStopThread) {
@@ -84,8 +117,11 @@ void BrowseThread::run() {
         }
         // Populate the model
         populateModel();
+        saveMetadataCache();
     }
     m_mutex.unlock();
+    // Abandoned reads of a previous location might still be running
+    m_metadataReaderPool.waitForDone();
 }
 
 namespace {
@@ -108,7 +144,260 @@ public:
   }
 };
 
-} // namespace
+mixxx::TrackMetadata readTrackMetadata(const mixxx::FileAccess& fileAccess) {
+    mixxx::TrackMetadata trackMetadata;
+    // Both resetMissingTagMetadata = false/true have the same effect
+    constexpr auto resetMissingTagMetadata = false;
+    SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
+            fileAccess,
+            &trackMetadata,
+            nullptr,
+            resetMissingTagMetadata);
+    return trackMetadata;
+}
+
+QList<QStandardItem*> createRowItems(
+        const mixxx::FileAccess& fileAccess,
+        const mixxx::TrackMetadata& trackMetadata) {
+    QList<QStandardItem*> row_data;
+
+    QStandardItem* item = new QStandardItem("0");
+    item->setData("0", Qt::UserRole);
+    row_data.insert(COLUMN_PREVIEW, item);
+
+    item = new QStandardItem(fileAccess.info().fileName());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_FILENAME, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getArtist());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ARTIST, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getTitle());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_TITLE, item);
+
+    item = new QStandardItem(trackMetadata.getAlbumInfo().getTitle());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ALBUM, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getTrackNumber());
+    item->setToolTip(item->text());
+    item->setData(item->text().toInt(), Qt::UserRole);
+    row_data.insert(COLUMN_TRACK_NUMBER, item);
+
+    const QString year(trackMetadata.getTrackInfo().getYear());
+    item = new YearItem(year);
+    item->setToolTip(year);
+    // The year column is sorted according to the numeric calendar year
+    item->setData(mixxx::TrackMetadata::parseCalendarYear(year), Qt::UserRole);
+    row_data.insert(COLUMN_YEAR, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getGenre());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_GENRE, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getComposer());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_COMPOSER, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getComment());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_COMMENT, item);
+
+    QString duration = trackMetadata.getDurationText(
+            mixxx::Duration::Precision::SECONDS);
+    item = new QStandardItem(duration);
+    item->setToolTip(item->text());
+    item->setData(trackMetadata.getStreamInfo()
+                          .getDuration()
+                          .toDoubleSeconds(),
+            Qt::UserRole);
+    row_data.insert(COLUMN_DURATION, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getBpmText());
+    item->setToolTip(item->text());
+    const mixxx::Bpm bpm = trackMetadata.getTrackInfo().getBpm();
+    item->setData(bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined, Qt::UserRole);
+    row_data.insert(COLUMN_BPM, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getKey());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_KEY, item);
+
+    item = new QStandardItem(fileAccess.info().suffix());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_TYPE, item);
+
+    item = new QStandardItem(trackMetadata.getBitrateText());
+    item->setToolTip(item->text());
+    item->setData(
+            static_cast<qlonglong>(
+                    trackMetadata.getStreamInfo().getBitrate().value()),
+            Qt::UserRole);
+    row_data.insert(COLUMN_BITRATE, item);
+
+    QString location = fileAccess.info().location();
+    QString nativeLocation = QDir::toNativeSeparators(location);
+    item = new QStandardItem(nativeLocation);
+    item->setToolTip(nativeLocation);
+    item->setData(location, Qt::UserRole);
+    row_data.insert(COLUMN_NATIVELOCATION, item);
+
+    item = new QStandardItem(trackMetadata.getAlbumInfo().getArtist());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ALBUMARTIST, item);
+
+    item = new QStandardItem(trackMetadata.getTrackInfo().getGrouping());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_GROUPING, item);
+
+    const auto fileLastModified =
+            fileAccess.info().lastModified();
+    item = new QStandardItem(
+            mixxx::displayLocalDateTime(fileLastModified));
+    item->setToolTip(item->text());
+    item->setData(fileLastModified, Qt::UserRole);
+    row_data.insert(COLUMN_FILE_MODIFIED_TIME, item);
+
+    const auto fileCreated =
+            fileAccess.info().birthTime();
+    item = new QStandardItem(
+            mixxx::displayLocalDateTime(fileCreated));
+    item->setToolTip(item->text());
+    item->setData(fileCreated, Qt::UserRole);
+    row_data.insert(COLUMN_FILE_CREATION_TIME, item);
+
+    const mixxx::ReplayGain replayGain(trackMetadata.getTrackInfo().getReplayGain());
+    item = new QStandardItem(
+            mixxx::ReplayGain::ratioToString(replayGain.getRatio()));
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_REPLAYGAIN, item);
+
+    return row_data;
+}
+
+// Only the properties that are displayed in the browse view are cached
+void writeCachedTrackMetadata(QDataStream* pStream, const mixxx::TrackMetadata& trackMetadata) {
+    const mixxx::TrackInfo& trackInfo = trackMetadata.getTrackInfo();
+    const mixxx::AlbumInfo& albumInfo = trackMetadata.getAlbumInfo();
+    const mixxx::Bpm bpm = trackInfo.getBpm();
+    *pStream << trackInfo.getArtist()
+             << trackInfo.getTitle()
+             << albumInfo.getTitle()
+             << trackInfo.getTrackNumber()
+             << trackInfo.getYear()
+             << trackInfo.getGenre()
+             << trackInfo.getComposer()
+             << trackInfo.getComment()
+             << trackInfo.getKey()
+             << albumInfo.getArtist()
+             << trackInfo.getGrouping()
+             << (bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined)
+             << trackInfo.getReplayGain().getRatio()
+             << trackMetadata.getStreamInfo().getDuration().toDoubleSeconds()
+             << static_cast<quint32>(trackMetadata.getStreamInfo().getBitrate().value());
+}
+
+void readCachedTrackMetadata(QDataStream* pStream, mixxx::TrackMetadata* pTrackMetadata) {
+    QString artist, title, album, trackNumber, year, genre, composer, comment,
+            key, albumArtist, grouping;
+    double bpm;
+    double replayGainRatio;
+    double durationSeconds;
+    quint32 bitrate;
+    *pStream >> artist >> title >> album >> trackNumber >> year >> genre >>
+            composer >> comment >> key >> albumArtist >> grouping >> bpm >>
+            replayGainRatio >> durationSeconds >> bitrate;
+    mixxx::TrackInfo* pTrackInfo = pTrackMetadata->ptrTrackInfo();
+    pTrackInfo->setArtist(artist);
+    pTrackInfo->setTitle(title);
+    pTrackInfo->setTrackNumber(trackNumber);
+    pTrackInfo->setYear(year);
+    pTrackInfo->setGenre(genre);
+    pTrackInfo->setComposer(composer);
+    pTrackInfo->setComment(comment);
+    pTrackInfo->setKey(key);
+    pTrackInfo->setGrouping(grouping);
+    pTrackInfo->setBpm(mixxx::Bpm(bpm));
+    pTrackInfo->setReplayGain(mixxx::ReplayGain(
+            replayGainRatio, mixxx::ReplayGain::kPeakUndefined));
+    mixxx::AlbumInfo* pAlbumInfo = pTrackMetadata->ptrAlbumInfo();
+    pAlbumInfo->setTitle(album);
+    pAlbumInfo->setArtist(albumArtist);
+    mixxx::audio::StreamInfo* pStreamInfo = pTrackMetadata->ptrStreamInfo();
+    pStreamInfo->setDuration(mixxx::Duration::fromSeconds(durationSeconds));
+    pStreamInfo->setBitrate(mixxx::audio::Bitrate(bitrate));
+}
+
+QString metadataCacheFilePath() {
+    return QDir(CmdlineArgs::Instance().getSettingsPath())
+            .filePath(kMetadataCacheFileName);
+}
+
+} // anonymous namespace
+
+void BrowseThread::loadMetadataCache() {
+    QFile file(metadataCacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(kMetadataCacheStreamVersion);
+    qint32 version = 0;
+    qint32 count = 0;
+    stream >> version >> count;
+    if (version != kMetadataCacheVersion) {
+        qInfo() << "Discarding browse metadata cache with version" << version;
+        return;
+    }
+    m_metadataCache.reserve(std::min(count, kMaxCachedFiles));
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString location;
+        CachedMetadata cachedMetadata;
+        stream >> location >> cachedMetadata.fileLastModified;
+        readCachedTrackMetadata(&stream, &cachedMetadata.trackMetadata);
+        m_metadataCache.insert(location, cachedMetadata);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Failed to read browse metadata cache" << file.fileName();
+        m_metadataCache.clear();
+    }
+}
+
+void BrowseThread::saveMetadataCache() {
+    if (!m_metadataCacheModified) {
+        return;
+    }
+    m_metadataCacheModified = false;
+    QSaveFile file(metadataCacheFilePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write browse metadata cache" << file.fileName();
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(kMetadataCacheStreamVersion);
+    stream << kMetadataCacheVersion << static_cast<qint32>(m_metadataCache.size());
+    for (auto i = m_metadataCache.constBegin(); i != m_metadataCache.constEnd(); ++i) {
+        stream << i.key() << i.value().fileLastModified;
+        writeCachedTrackMetadata(&stream, i.value().trackMetadata);
+    }
+    if (!file.commit()) {
+        qWarning() << "Failed to write browse metadata cache" << file.fileName();
+    }
+}
 
 void BrowseThread::populateModel() {
     m_path_mutex.lock();
@@ -134,11 +423,20 @@ void BrowseThread::populateModel() {
     // see signal/slot connection in BrowseTableModel
     emit clearModel(thisModelObserver);
 
+    // The files are read in parallel, but appended in the order
+    // of the directory listing. Cached files are ready immediately.
+    struct PendingFile {
+        mixxx::FileAccess fileAccess;
+        QDateTime fileLastModified;
+        bool cached;
+        mixxx::TrackMetadata trackMetadata;
+        QFuture<mixxx::TrackMetadata> future;
+    };
+    QQueue<PendingFile> pendingFiles;
+
     QList<QList<QStandardItem*>> rows;
 
-    int row = 0;
-    // Iterate over the files
-    while (fileIt.hasNext()) {
+    while (fileIt.hasNext() || !pendingFiles.isEmpty()) {
         // If a user quickly jumps through the folders
         // the current task becomes "dirty"
         m_path_mutex.lock();
@@ -147,164 +445,62 @@ void BrowseThread::populateModel() {
 
         if (thisPath.info() != newPath.info()) {
             qDebug() << "Abort populateModel()";
+            for (const auto& row : qAsConst(rows)) {
+                qDeleteAll(row);
+            }
+            // Pending reads are abandoned and finish in the background
             populateModel();
             return;
         }
 
-        QList<QStandardItem*> row_data;
-
-        QStandardItem* item = new QStandardItem("0");
-        item->setData("0", Qt::UserRole);
-        row_data.insert(COLUMN_PREVIEW, item);
-
-        const auto fileAccess = mixxx::FileAccess(
-                mixxx::FileInfo(fileIt.next()),
-                thisPath.token());
-        {
-            mixxx::TrackMetadata trackMetadata;
-            // Both resetMissingTagMetadata = false/true have the same effect
-            constexpr auto resetMissingTagMetadata = false;
-            SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
-                    fileAccess,
-                    &trackMetadata,
-                    nullptr,
-                    resetMissingTagMetadata);
-
-            item = new QStandardItem(fileAccess.info().fileName());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_FILENAME, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getArtist());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ARTIST, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getTitle());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_TITLE, item);
-
-            item = new QStandardItem(trackMetadata.getAlbumInfo().getTitle());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ALBUM, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getTrackNumber());
-            item->setToolTip(item->text());
-            item->setData(item->text().toInt(), Qt::UserRole);
-            row_data.insert(COLUMN_TRACK_NUMBER, item);
-
-            const QString year(trackMetadata.getTrackInfo().getYear());
-            item = new YearItem(year);
-            item->setToolTip(year);
-            // The year column is sorted according to the numeric calendar year
-            item->setData(mixxx::TrackMetadata::parseCalendarYear(year), Qt::UserRole);
-            row_data.insert(COLUMN_YEAR, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getGenre());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_GENRE, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getComposer());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_COMPOSER, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getComment());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_COMMENT, item);
-
-            QString duration = trackMetadata.getDurationText(
-                    mixxx::Duration::Precision::SECONDS);
-            item = new QStandardItem(duration);
-            item->setToolTip(item->text());
-            item->setData(trackMetadata.getStreamInfo()
-                                  .getDuration()
-                                  .toDoubleSeconds(),
-                    Qt::UserRole);
-            row_data.insert(COLUMN_DURATION, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getBpmText());
-            item->setToolTip(item->text());
-            const mixxx::Bpm bpm = trackMetadata.getTrackInfo().getBpm();
-            item->setData(bpm.isValid() ? bpm.value() : mixxx::Bpm::kValueUndefined, Qt::UserRole);
-            row_data.insert(COLUMN_BPM, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getKey());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_KEY, item);
-
-            item = new QStandardItem(fileAccess.info().suffix());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_TYPE, item);
-
-            item = new QStandardItem(trackMetadata.getBitrateText());
-            item->setToolTip(item->text());
-            item->setData(
-                    static_cast<qlonglong>(
-                            trackMetadata.getStreamInfo().getBitrate().value()),
-                    Qt::UserRole);
-            row_data.insert(COLUMN_BITRATE, item);
-
-            QString location = fileAccess.info().location();
-            QString nativeLocation = QDir::toNativeSeparators(location);
-            item = new QStandardItem(nativeLocation);
-            item->setToolTip(nativeLocation);
-            item->setData(location, Qt::UserRole);
-            row_data.insert(COLUMN_NATIVELOCATION, item);
-
-            item = new QStandardItem(trackMetadata.getAlbumInfo().getArtist());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ALBUMARTIST, item);
-
-            item = new QStandardItem(trackMetadata.getTrackInfo().getGrouping());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_GROUPING, item);
-
-            const auto fileLastModified =
-                    fileAccess.info().lastModified();
-            item = new QStandardItem(
-                    mixxx::displayLocalDateTime(fileLastModified));
-            item->setToolTip(item->text());
-            item->setData(fileLastModified, Qt::UserRole);
-            row_data.insert(COLUMN_FILE_MODIFIED_TIME, item);
-
-            const auto fileCreated =
-                    fileAccess.info().birthTime();
-            item = new QStandardItem(
-                    mixxx::displayLocalDateTime(fileCreated));
-            item->setToolTip(item->text());
-            item->setData(fileCreated, Qt::UserRole);
-            row_data.insert(COLUMN_FILE_CREATION_TIME, item);
-
-            const mixxx::ReplayGain replayGain(trackMetadata.getTrackInfo().getReplayGain());
-            item = new QStandardItem(
-                    mixxx::ReplayGain::ratioToString(replayGain.getRatio()));
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_REPLAYGAIN, item);
+        while (fileIt.hasNext() && pendingFiles.size() < kMaxPendingFiles) {
+            PendingFile pendingFile;
+            pendingFile.fileAccess = mixxx::FileAccess(
+                    mixxx::FileInfo(fileIt.next()),
+                    thisPath.token());
+            pendingFile.fileLastModified = pendingFile.fileAccess.info().lastModified();
+            const auto cached = m_metadataCache.constFind(
+                    pendingFile.fileAccess.info().location());
+            pendingFile.cached = cached != m_metadataCache.constEnd() &&
+                    cached->fileLastModified == pendingFile.fileLastModified;
+            if (pendingFile.cached) {
+                pendingFile.trackMetadata = cached->trackMetadata;
+            } else {
+                pendingFile.future = QtConcurrent::run(&m_metadataReaderPool,
+                        [fileAccess = pendingFile.fileAccess] {
+                            return readTrackMetadata(fileAccess);
+                        });
+            }
+            pendingFiles.enqueue(std::move(pendingFile));
         }
 
-        rows.append(row_data);
-        ++row;
-        // If 10 tracks have been analyzed, send it to GUI
-        // Will limit GUI freezing
-        if (row % 10 == 0) {
+        PendingFile pendingFile = pendingFiles.dequeue();
+        if (!pendingFile.cached) {
+            pendingFile.trackMetadata = pendingFile.future.result();
+            if (m_metadataCache.size() >= kMaxCachedFiles) {
+                m_metadataCache.erase(m_metadataCache.begin());
+            }
+            m_metadataCache.insert(pendingFile.fileAccess.info().location(),
+                    CachedMetadata{pendingFile.fileLastModified,
+                            pendingFile.trackMetadata});
+            m_metadataCacheModified = true;
+        }
+        rows.append(createRowItems(pendingFile.fileAccess, pendingFile.trackMetadata));
+
+        // Send the rows to the GUI in batches, but without waiting
+        // for files that are still being read
+        const bool nextFileReady = pendingFiles.isEmpty() ||
+                pendingFiles.head().cached ||
+                pendingFiles.head().future.isFinished();
+        if (rows.size() >= kMaxRowsPerBatch || !nextFileReady) {
             // this is a blocking operation
             emit rowsAppended(rows, thisModelObserver);
             qDebug() << "Append" << rows.count() << "tracks from "
                      << thisPath.info().locationPath();
             rows.clear();
+            // Sleep additionally for 20ms which prevents us from GUI freezes
+            msleep(20);
         }
-        // Sleep additionally for 20ms which prevents us from GUI freezes
-        msleep(20);
     }
     emit rowsAppended(rows, thisModelObserver);
     qDebug() << "Append last" << rows.count() << "tracks from" << thisPath.info().locationPath();
@@ -4,14 +4,18 @@
 
 #pragma once
 
+#include <QDateTime>
+#include <QHash>
 #include <QList>
 #include <QMutex>
 #include <QSharedPointer>
 #include <QStandardItem>
 #include <QThread>
+#include <QThreadPool>
 #include <QWaitCondition>
 #include <QWeakPointer>
 
+#include "track/trackmetadata.h"
 #include "util/fileaccess.h"
 
 // This class is a singleton and represents a thread
@@ -43,6 +47,16 @@ class BrowseThread : public QThread {
 
     void populateModel();
 
+    // The metadata of files that have been browsed before is cached
+    // by location and only read again if the file has been modified.
+    // The cache is persisted in the settings directory.
+    struct CachedMetadata {
+        QDateTime fileLastModified;
+        mixxx::TrackMetadata trackMetadata;
+    };
+    void loadMetadataCache();
+    void saveMetadataCache();
+
     QMutex m_mutex;
     QWaitCondition m_locationUpdated;
     volatile bool m_bStopThread;
@@ -52,5 +66,13 @@ class BrowseThread : public QThread {
     mixxx::FileAccess m_path;
     BrowseTableModel* m_model_observer;
 
+    // Only accessed by this thread
+    QHash<QString, CachedMetadata> m_metadataCache;
+    bool m_metadataCacheModified;
+
+    // Reads the metadata of multiple files in parallel, which
+    // hides the latency of network storage
+    QThreadPool m_metadataReaderPool;
+
     static QWeakPointer<BrowseThread> m_weakInstanceRef;
 };
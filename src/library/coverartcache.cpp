@@ -1,7 +1,10 @@
 #include "library/coverartcache.h"
 
+#include <QDir>
 #include <QFutureWatcher>
+#include <QImageReader>
 #include <QPixmapCache>
+#include <QSaveFile>
 #include <QtConcurrentRun>
 #include <QtDebug>
 
@@ -37,12 +40,85 @@ inline QImage resizeImageWidth(const QImage& image, int width) {
     return image.scaledToWidth(width, kTransformationMode);
 }
 
+// Covers are decoded on a few threads of the global thread pool
+// at the same time, leaving the other threads for analysis and
+// loading tracks
+constexpr int kMaxLoadingCount = 2;
+
+// Downscaled covers are stored with a limited number of widths, i.e.
+// requests for similar sizes share the same file
+constexpr int kThumbnailWidths[] = {64, 128, 256, 512};
+
+const char* const kThumbnailFormat = "JPG";
+constexpr int kThumbnailQuality = 90;
+
+// Returns 0 if the width is too large for a thumbnail
+int thumbnailBucketWidth(int desiredWidth) {
+    for (const int width : kThumbnailWidths) {
+        if (desiredWidth <= width) {
+            return width;
+        }
+    }
+    return 0;
+}
+
+QString thumbnailFilePath(
+        const QString& thumbnailDirectory,
+        const QByteArray& imageDigest,
+        int bucketWidth) {
+    return QDir(thumbnailDirectory)
+            .filePath(QString::fromLatin1(imageDigest.toHex()) +
+                    QChar('_') + QString::number(bucketWidth) +
+                    QStringLiteral(".jpg"));
+}
+
+void saveThumbnail(const QString& filePath, const QImage& image) {
+    // Other threads never read partially written files
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) ||
+            !image.save(&file, kThumbnailFormat, kThumbnailQuality) ||
+            !file.commit()) {
+        kLogger.warning()
+                << "Failed to save thumbnail"
+                << filePath
+                << file.errorString();
+    }
+}
+
 } // anonymous namespace
 
-CoverArtCache::CoverArtCache() {
+CoverArtCache::CoverArtCache()
+        : m_loadingCount(0) {
     QPixmapCache::setCacheLimit(kPixmapCacheLimit);
 }
 
+void CoverArtCache::setThumbnailDirectory(const QString& thumbnailDirectory) {
+    DEBUG_ASSERT(m_runningRequests.isEmpty());
+    if (!QDir().mkpath(thumbnailDirectory)) {
+        kLogger.warning()
+                << "Failed to create thumbnail directory"
+                << thumbnailDirectory;
+        m_thumbnailDirectory = QString();
+        return;
+    }
+    m_thumbnailDirectory = thumbnailDirectory;
+}
+
+void CoverArtCache::abortPendingRequests(
+        const QObject* pRequestor,
+        const QSet<mixxx::cache_key_t>& retainedCacheKeys) {
+    auto i = m_pendingRequests.begin();
+    while (i != m_pendingRequests.end()) {
+        const auto cacheKey = i->coverInfo.cacheKey();
+        if (i->pRequestor == pRequestor && !retainedCacheKeys.contains(cacheKey)) {
+            m_runningRequests.remove(qMakePair(pRequestor, cacheKey));
+            i = m_pendingRequests.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
 //static
 void CoverArtCache::requestCover(
         const QObject* pRequestor,
@@ -140,21 +216,47 @@ QPixmap CoverArtCache::tryLoadCover(
                 << coverInfo;
     }
     m_runningRequests.insert(requestId);
-    // The watcher will be deleted in coverLoaded()
-    QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
-    QFuture<FutureResult> future = QtConcurrent::run(
-            &CoverArtCache::loadCover,
+    PendingRequest request{
             pRequestor,
             pTrack,
             coverInfo,
             desiredWidth,
-            loading == Loading::Default);
+            loading == Loading::Default};
+    if (m_loadingCount < kMaxLoadingCount) {
+        startLoading(std::move(request));
+    } else {
+        m_pendingRequests.append(std::move(request));
+    }
+    return QPixmap();
+}
+
+void CoverArtCache::startLoading(PendingRequest request) {
+    ++m_loadingCount;
+    // The watcher will be deleted in coverLoaded()
+    QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
+    QFuture<FutureResult> future = QtConcurrent::run(
+            [request = std::move(request), thumbnailDirectory = m_thumbnailDirectory] {
+                return CoverArtCache::loadCover(
+                        request.pRequestor,
+                        request.pTrack,
+                        request.coverInfo,
+                        request.desiredWidth,
+                        request.signalWhenDone,
+                        thumbnailDirectory);
+            });
     connect(watcher,
             &QFutureWatcher<FutureResult>::finished,
             this,
             &CoverArtCache::coverLoaded);
     watcher->setFuture(future);
-    return QPixmap();
+}
+
+void CoverArtCache::startPendingRequests() {
+    while (m_loadingCount < kMaxLoadingCount && !m_pendingRequests.isEmpty()) {
+        // The most recent requests are most likely for covers
+        // that are still visible
+        startLoading(m_pendingRequests.takeLast());
+    }
 }
 
 //static
@@ -163,7 +265,8 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
         TrackPointer pTrack,
         CoverInfo coverInfo,
         int desiredWidth,
-        bool signalWhenDone) {
+        bool signalWhenDone,
+        const QString& thumbnailDirectory) {
     if (kLogger.traceEnabled()) {
         kLogger.trace()
                 << "loadCover"
@@ -180,6 +283,27 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
             signalWhenDone);
     DEBUG_ASSERT(!res.coverInfoUpdated);
 
+    // The digest of the original image identifies the thumbnail
+    const int bucketWidth = (thumbnailDirectory.isEmpty() || desiredWidth <= 0)
+            ? 0
+            : thumbnailBucketWidth(desiredWidth);
+    if (bucketWidth > 0 && !coverInfo.imageDigest().isEmpty()) {
+        const QString filePath = thumbnailFilePath(
+                thumbnailDirectory, coverInfo.imageDigest(), bucketWidth);
+        QImageReader reader(filePath, kThumbnailFormat);
+        QImage thumbnail = reader.read();
+        if (!thumbnail.isNull()) {
+            CoverInfo::LoadedImage loadedImage(CoverInfo::LoadedImage::Result::Ok);
+            loadedImage.image = resizeImageWidth(thumbnail, desiredWidth);
+            loadedImage.location = filePath;
+            res.coverArt = CoverArt(
+                    std::move(coverInfo),
+                    std::move(loadedImage),
+                    desiredWidth);
+            return res;
+        }
+    }
+
     auto loadedImage = coverInfo.loadImage(
             pTrack ? pTrack->getFileAccess().token() : SecurityTokenPointer());
     if (!loadedImage.image.isNull()) {
@@ -192,6 +316,20 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
             pTrack->setCoverInfo(coverInfo);
         }
 
+        if (bucketWidth > 0 && !coverInfo.imageDigest().isEmpty()) {
+            // Decode the downscaled image next time, and resize this
+            // one instead of the original image
+            if (loadedImage.image.width() > bucketWidth) {
+                loadedImage.image = resizeImageWidth(loadedImage.image, bucketWidth);
+            }
+            saveThumbnail(
+                    thumbnailFilePath(
+                            thumbnailDirectory,
+                            coverInfo.imageDigest(),
+                            bucketWidth),
+                    loadedImage.image);
+        }
+
         // Resize image to requested size
         if (desiredWidth > 0) {
             // Adjust the cover size according to the request
@@ -219,6 +357,9 @@ void CoverArtCache::coverLoaded() {
         res = pFutureWatcher->result();
         pFutureWatcher->deleteLater();
     }
+    DEBUG_ASSERT(m_loadingCount > 0);
+    --m_loadingCount;
+    startPendingRequests();
 
     if (kLogger.traceEnabled()) {
         kLogger.trace() << "coverLoaded" << res.coverArt;
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <QObject>
+#include <QList>
 #include <QPair>
 #include <QPixmap>
 #include <QSet>
+#include <QString>
 #include <QtDebug>
 
 #include "library/coverart.h"
@@ -52,6 +54,17 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
                 loading);
     }
 
+    /// Enables the persistent cache of downscaled covers. Must be invoked
+    /// before the first request.
+    void setThumbnailDirectory(const QString& thumbnailDirectory);
+
+    /// Drops the requests of pRequestor that have been queued, but not
+    /// started yet, unless the covers are still needed, e.g. for rows that
+    /// are still visible.
+    void abortPendingRequests(
+            const QObject* pRequestor,
+            const QSet<mixxx::cache_key_t>& retainedCacheKeys);
+
     // Only public for testing
     struct FutureResult {
         FutureResult()
@@ -84,7 +97,8 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             TrackPointer pTrack,
             CoverInfo coverInfo,
             int desiredWidth,
-            bool emitSignals);
+            bool emitSignals,
+            const QString& thumbnailDirectory = QString());
 
   private slots:
     // Called when loadCover is complete in the main thread.
@@ -116,7 +130,22 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             int desiredWidth,
             Loading loading);
 
+    struct PendingRequest {
+        const QObject* pRequestor;
+        TrackPointer pTrack;
+        CoverInfo coverInfo;
+        int desiredWidth;
+        bool signalWhenDone;
+    };
+    void startLoading(PendingRequest request);
+    void startPendingRequests();
+
+    QString m_thumbnailDirectory;
+
+    // Requests that are either loading or waiting in m_pendingRequests
     QSet<QPair<const QObject*, mixxx::cache_key_t>> m_runningRequests;
+    QList<PendingRequest> m_pendingRequests;
+    int m_loadingCount;
 };
 
 inline
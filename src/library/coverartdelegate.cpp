@@ -14,6 +14,10 @@ namespace {
 
 const mixxx::Logger kLogger("CoverArtDelegate");
 
+// Covers of the rows above and below the visible rows are loaded
+// in advance after scrolling has stopped
+constexpr int kPrefetchMarginRows = 16;
+
 inline TrackModel* asTrackModel(
         QTableView* pTableView) {
     auto* pTrackModel =
@@ -28,7 +32,8 @@ CoverArtDelegate::CoverArtDelegate(QTableView* parent)
         : TableItemDelegate(parent),
           m_pTrackModel(asTrackModel(parent)),
           m_pCache(CoverArtCache::instance()),
-          m_inhibitLazyLoading(false) {
+          m_inhibitLazyLoading(false),
+          m_column(-1) {
     if (m_pCache) {
         connect(m_pCache,
                 &CoverArtCache::coverFound,
@@ -57,7 +62,7 @@ void CoverArtDelegate::emitRowsChanged(
 void CoverArtDelegate::slotInhibitLazyLoading(
         bool inhibitLazyLoading) {
     m_inhibitLazyLoading = inhibitLazyLoading;
-    if (m_inhibitLazyLoading || m_cacheMissRows.isEmpty()) {
+    if (m_inhibitLazyLoading) {
         return;
     }
     // If we can request non-cache covers now, request updates
@@ -67,9 +72,103 @@ void CoverArtDelegate::slotInhibitLazyLoading(
     // in turn may trigger new signals for CoverArtDelegate!
     QList<int> staleRows = std::move(m_cacheMissRows);
     DEBUG_ASSERT(m_cacheMissRows.isEmpty());
+    int firstRow;
+    int lastRow;
+    if (visibleRows(&firstRow, &lastRow)) {
+        // Rows that have been scrolled out of view while lazy loading
+        // was inhibited are not painted and don't need to be refreshed
+        staleRows.erase(
+                std::remove_if(staleRows.begin(),
+                        staleRows.end(),
+                        [firstRow, lastRow](int row) {
+                            return row < firstRow || row > lastRow;
+                        }),
+                staleRows.end());
+        abortPendingRequests(firstRow - kPrefetchMarginRows, lastRow + kPrefetchMarginRows);
+        prefetchCovers(firstRow - kPrefetchMarginRows, firstRow - 1);
+        prefetchCovers(lastRow + 1, lastRow + kPrefetchMarginRows);
+    }
     emitRowsChanged(std::move(staleRows));
 }
 
+bool CoverArtDelegate::visibleRows(int* pFirstRow, int* pLastRow) const {
+    const auto* pTableView = qobject_cast<QTableView*>(parent());
+    VERIFY_OR_DEBUG_ASSERT(pTableView && pTableView->model()) {
+        return false;
+    }
+    const int firstRow = pTableView->rowAt(0);
+    if (firstRow < 0) {
+        return false;
+    }
+    int lastRow = pTableView->rowAt(pTableView->viewport()->height() - 1);
+    if (lastRow < 0) {
+        // The last row ends before the bottom of the viewport
+        lastRow = pTableView->model()->rowCount() - 1;
+    }
+    *pFirstRow = firstRow;
+    *pLastRow = lastRow;
+    return true;
+}
+
+void CoverArtDelegate::prefetchCovers(int firstRow, int lastRow) {
+    // The column is only known after painting
+    if (m_column < 0 || !m_pCache) {
+        return;
+    }
+    const auto* pTableView = qobject_cast<QTableView*>(parent());
+    VERIFY_OR_DEBUG_ASSERT(pTableView && pTableView->model()) {
+        return;
+    }
+    const QAbstractItemModel* pModel = pTableView->model();
+    firstRow = std::max(firstRow, 0);
+    lastRow = std::min(lastRow, pModel->rowCount() - 1);
+    const int desiredWidth = static_cast<int>(
+            pTableView->columnWidth(m_column) * pTableView->devicePixelRatioF());
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const CoverInfo coverInfo =
+                m_pTrackModel->getCoverInfo(pModel->index(row, m_column));
+        if (!coverInfo.hasImage()) {
+            continue;
+        }
+        // Loaded covers are kept in the pixmap cache that evicts the
+        // least recently used covers. The rows are not recorded as
+        // pending, because they don't need to be repainted.
+        m_pCache->tryLoadCover(this,
+                coverInfo,
+                desiredWidth,
+                CoverArtCache::Loading::Default);
+    }
+}
+
+void CoverArtDelegate::abortPendingRequests(int firstRow, int lastRow) {
+    if (m_column < 0 || !m_pCache) {
+        return;
+    }
+    const auto* pTableView = qobject_cast<QTableView*>(parent());
+    VERIFY_OR_DEBUG_ASSERT(pTableView && pTableView->model()) {
+        return;
+    }
+    const QAbstractItemModel* pModel = pTableView->model();
+    firstRow = std::max(firstRow, 0);
+    lastRow = std::min(lastRow, pModel->rowCount() - 1);
+    QSet<mixxx::cache_key_t> retainedCacheKeys;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        retainedCacheKeys.insert(
+                m_pTrackModel->getCoverInfo(pModel->index(row, m_column)).cacheKey());
+    }
+    // Covers of rows that have been scrolled out of view are requested
+    // again when the rows become visible
+    m_pCache->abortPendingRequests(this, retainedCacheKeys);
+    auto i = m_pendingCacheRows.begin();
+    while (i != m_pendingCacheRows.end()) {
+        if (retainedCacheKeys.contains(i.key())) {
+            ++i;
+        } else {
+            i = m_pendingCacheRows.erase(i);
+        }
+    }
+}
+
 void CoverArtDelegate::slotCoverFound(
         const QObject* pRequestor,
         const CoverInfo& coverInfo,
@@ -115,6 +214,7 @@ void CoverArtDelegate::paintItem(
         const QStyleOptionViewItem& option,
         const QModelIndex& index) const {
     paintItemBackground(painter, option, index);
+    m_column = index.column();
 
     CoverInfo coverInfo = m_pTrackModel->getCoverInfo(index);
     VERIFY_OR_DEBUG_ASSERT(m_pTrackModel) {
@@ -62,6 +62,16 @@ class CoverArtDelegate : public TableItemDelegate {
     TrackPointer loadTrackByLocation(
             const QString& trackLocation) const;
 
+    // Returns false if no rows are visible
+    bool visibleRows(int* pFirstRow, int* pLastRow) const;
+
+    // Starts loading the covers of rows that are not visible yet
+    void prefetchCovers(int firstRow, int lastRow);
+
+    // Drops queued requests for covers that are not needed for the rows
+    // between firstRow and lastRow
+    void abortPendingRequests(int firstRow, int lastRow);
+
     CoverArtCache* const m_pCache;
     bool m_inhibitLazyLoading;
 
@@ -69,4 +79,5 @@ class CoverArtDelegate : public TableItemDelegate {
     // these are marked mutable.
     mutable QList<int> m_cacheMissRows;
     mutable QMultiHash<mixxx::cache_key_t, int> m_pendingCacheRows;
+    mutable int m_column;
 };
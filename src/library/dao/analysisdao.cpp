@@ -1,3 +1,6 @@
+#include <QCryptographicHash>
+#include <QFile>
+#include <QSet>
 #include <QSqlQuery>
 #include <QSqlResult>
 #include <QSqlError>
@@ -84,7 +87,21 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
         int checksum = query->value(dataChecksumColumn).toInt();
         QString dataPath = analysisPath.absoluteFilePath(
             QString::number(info.analysisId));
-        const QByteArray compressedData = loadDataFromFile(dataPath);
+        // The compressed data is read from the mapped file without copying
+        // it, the file is unmapped when it is closed after uncompressing.
+        QFile file(dataPath);
+        QByteArray compressedData;
+        if (file.open(QIODevice::ReadOnly)) {
+            const qint64 size = file.size();
+            const uchar* pMapped = size > 0 ? file.map(0, size) : nullptr;
+            if (pMapped) {
+                compressedData = QByteArray::fromRawData(
+                        reinterpret_cast<const char*>(pMapped),
+                        static_cast<int>(size));
+            } else {
+                compressedData = file.readAll();
+            }
+        }
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
         const int file_checksum = qChecksum(
                 compressedData);
@@ -262,17 +279,6 @@ QDir AnalysisDao::getAnalysisStoragePath() const {
     return dir.absolutePath().append("/");
 }
 
-QByteArray AnalysisDao::loadDataFromFile(const QString& filename) const {
-    QFile file(filename);
-    if (!file.exists()) {
-        return QByteArray();
-    }
-    if (!file.open(QIODevice::ReadOnly)) {
-        return QByteArray();
-    }
-    return file.readAll();
-}
-
 bool AnalysisDao::deleteFile(const QString& fileName) const {
     QFile file(fileName);
     return file.remove();
@@ -366,6 +372,130 @@ void AnalysisDao::saveTrackAnalyses(
              << "analysisId" << analysis.analysisId;
 }
 
+bool AnalysisDao::saveAnalysisCheckpoint(
+        TrackId trackId,
+        const QString& version,
+        const QByteArray& data) {
+    return saveSingleAnalysis(trackId,
+            TYPE_CHECKPOINT,
+            QStringLiteral("checkpoint"),
+            version,
+            data);
+}
+
+QByteArray AnalysisDao::loadAnalysisCheckpoint(
+        TrackId trackId,
+        const QString& version) {
+    return loadSingleAnalysis(trackId, TYPE_CHECKPOINT, version);
+}
+
+void AnalysisDao::deleteAnalysisCheckpoint(TrackId trackId) {
+    const QList<int> analysisIds =
+            getAnalysisIdsForTrackByType(trackId, TYPE_CHECKPOINT);
+    for (const int analysisId : analysisIds) {
+        deleteAnalysis(analysisId);
+    }
+}
+
+bool AnalysisDao::saveAnalysisFingerprint(
+        TrackId trackId,
+        const QString& version,
+        const QByteArray& fingerprint) {
+    if (!saveSingleAnalysis(trackId,
+                TYPE_FINGERPRINT,
+                QStringLiteral("acoustid"),
+                version,
+                fingerprint)) {
+        return false;
+    }
+    QSqlQuery query(m_database);
+    query.prepare(QString(
+            "UPDATE %1 SET data_key=:data_key "
+            "WHERE track_id=:trackId AND type=:type")
+                          .arg(s_analysisTableName));
+    query.bindValue(":data_key",
+            QString::fromLatin1(QCryptographicHash::hash(
+                    fingerprint, QCryptographicHash::Sha1)
+                                        .toHex()));
+    query.bindValue(":trackId", trackId.toVariant());
+    query.bindValue(":type", TYPE_FINGERPRINT);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't save fingerprint key";
+        return false;
+    }
+    return true;
+}
+
+QByteArray AnalysisDao::loadAnalysisFingerprint(
+        TrackId trackId,
+        const QString& version) {
+    return loadSingleAnalysis(trackId, TYPE_FINGERPRINT, version);
+}
+
+bool AnalysisDao::saveSingleAnalysis(
+        TrackId trackId,
+        AnalysisType type,
+        const QString& description,
+        const QString& version,
+        const QByteArray& data) {
+    const QList<int> analysisIds =
+            getAnalysisIdsForTrackByType(trackId, type);
+    AnalysisDao::AnalysisInfo analysis;
+    analysis.trackId = trackId;
+    analysis.type = type;
+    analysis.description = description;
+    analysis.version = version;
+    analysis.data = data;
+    // Overwrite the existing analysis
+    for (int i = 0; i < analysisIds.size(); ++i) {
+        if (i == 0) {
+            analysis.analysisId = analysisIds.at(i);
+        } else {
+            deleteAnalysis(analysisIds.at(i));
+        }
+    }
+    return saveAnalysis(&analysis);
+}
+
+QByteArray AnalysisDao::loadSingleAnalysis(
+        TrackId trackId,
+        AnalysisType type,
+        const QString& version) {
+    const QList<AnalysisInfo> analyses =
+            getAnalysesForTrackByType(trackId, type);
+    for (const auto& analysis : analyses) {
+        if (analysis.version == version) {
+            return analysis.data;
+        }
+    }
+    return QByteArray();
+}
+
+QList<int> AnalysisDao::getAnalysisIdsForTrackByType(
+        TrackId trackId, AnalysisType type) {
+    QList<int> analysisIds;
+    if (!m_database.isOpen() || !trackId.isValid()) {
+        return analysisIds;
+    }
+
+    QSqlQuery query(m_database);
+    query.prepare(QString(
+        "SELECT id FROM %1 "
+        "WHERE track_id=:trackId AND type=:type").arg(s_analysisTableName));
+    query.bindValue(":trackId", trackId.toVariant());
+    query.bindValue(":type", type);
+
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't get analyses for track" << trackId;
+        return analysisIds;
+    }
+    const int idColumn = query.record().indexOf("id");
+    while (query.next()) {
+        analysisIds.append(query.value(idColumn).toInt());
+    }
+    return analysisIds;
+}
+
 size_t AnalysisDao::getDiskUsageInBytes(
         const QSqlDatabase& database,
         AnalysisType type) const {
@@ -416,3 +546,58 @@ bool AnalysisDao::deleteAnalysesByType(
 
     return true;
 }
+
+void AnalysisDao::deleteOrphanedAnalyses(const QSqlDatabase& database) const {
+    PerformanceTimer time;
+    time.start();
+
+    QDir analysisPath(getAnalysisStoragePath());
+    QSqlQuery query(database);
+    query.prepare(QString("SELECT id FROM %1 WHERE track_id NOT IN "
+                          "(SELECT id FROM track_locations)")
+                          .arg(s_analysisTableName));
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't get orphaned analyses";
+        return;
+    }
+    int idColumn = query.record().indexOf("id");
+    int deletedRows = 0;
+    while (query.next()) {
+        deleteFile(analysisPath.absoluteFilePath(query.value(idColumn).toString()));
+        ++deletedRows;
+    }
+    if (deletedRows > 0) {
+        query.prepare(QString("DELETE FROM %1 WHERE track_id NOT IN "
+                              "(SELECT id FROM track_locations)")
+                              .arg(s_analysisTableName));
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query) << "couldn't delete orphaned analyses";
+            return;
+        }
+    }
+
+    // Files without an analysis are left over from failed deletions
+    // or from interrupted writes of temporary files.
+    query.prepare(QString("SELECT id FROM %1").arg(s_analysisTableName));
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't get analyses";
+        return;
+    }
+    idColumn = query.record().indexOf("id");
+    QSet<QString> fileNames;
+    while (query.next()) {
+        fileNames.insert(query.value(idColumn).toString());
+    }
+    int deletedFiles = 0;
+    const QStringList entries = analysisPath.entryList(QDir::Files);
+    for (const auto& entry : entries) {
+        if (!fileNames.contains(entry) &&
+                deleteFile(analysisPath.absoluteFilePath(entry))) {
+            ++deletedFiles;
+        }
+    }
+
+    qDebug() << "AnalysisDAO deleted" << deletedRows << "orphaned analyses and"
+             << deletedFiles << "orphaned files in"
+             << time.elapsed().debugMillisWithUnit();
+}
@@ -16,7 +16,11 @@ class AnalysisDao : public DAO {
     enum AnalysisType {
         TYPE_UNKNOWN = 0,
         TYPE_WAVEFORM,
-        TYPE_WAVESUMMARY
+        TYPE_WAVESUMMARY,
+        // Intermediate state of an interrupted analysis
+        TYPE_CHECKPOINT,
+        // Encoded AcoustID fingerprint of the beginning of the track
+        TYPE_FINGERPRINT
     };
 
     struct AnalysisInfo {
@@ -44,6 +48,10 @@ class AnalysisDao : public DAO {
     size_t getDiskUsageInBytes(
             const QSqlDatabase& database,
             AnalysisType type) const;
+    // Deletes the analyses of tracks that no longer exist and all
+    // files in the storage path that don't belong to an analysis.
+    void deleteOrphanedAnalyses(
+            const QSqlDatabase& database) const;
 
     QList<AnalysisInfo> getAnalysesForTrackByType(TrackId trackId, AnalysisType type);
     QList<AnalysisInfo> getAnalysesForTrack(TrackId trackId);
@@ -57,12 +65,45 @@ class AnalysisDao : public DAO {
             ConstWaveformPointer pWaveform,
             ConstWaveformPointer pWaveSummary);
 
+    // At most a single checkpoint is stored per track. Checkpoints
+    // with a different version are ignored when loading.
+    bool saveAnalysisCheckpoint(
+            TrackId trackId,
+            const QString& version,
+            const QByteArray& data);
+    QByteArray loadAnalysisCheckpoint(
+            TrackId trackId,
+            const QString& version);
+    void deleteAnalysisCheckpoint(TrackId trackId);
+
+    // At most a single fingerprint is stored per track. Fingerprints
+    // with a different version are ignored when loading. The hash of
+    // the fingerprint is stored in the database for finding tracks
+    // with identical audio.
+    bool saveAnalysisFingerprint(
+            TrackId trackId,
+            const QString& version,
+            const QByteArray& fingerprint);
+    QByteArray loadAnalysisFingerprint(
+            TrackId trackId,
+            const QString& version);
+
   private:
     QDir getAnalysisStoragePath() const;
-    QByteArray loadDataFromFile(const QString& fileName) const;
     bool saveDataToFile(const QString& fileName, const QByteArray& data) const;
     bool deleteFile(const QString& filename) const;
     QList<AnalysisInfo> loadAnalysesFromQuery(TrackId trackId, QSqlQuery* query);
+    QList<int> getAnalysisIdsForTrackByType(TrackId trackId, AnalysisType type);
+    bool saveSingleAnalysis(
+            TrackId trackId,
+            AnalysisType type,
+            const QString& description,
+            const QString& version,
+            const QByteArray& data);
+    QByteArray loadSingleAnalysis(
+            TrackId trackId,
+            AnalysisType type,
+            const QString& version);
 
     const UserSettingsPointer m_pConfig;
 };
@@ -178,6 +178,26 @@ void AutoDJCratesDAO::createAndConnectAutoDjCratesDatabase() {
         return;
     }
 
+    // Index the table in the order of the active-tracks view. Picking a
+    // random track then only walks the index up to the chosen offset
+    // instead of sorting all tracks, and counting the unplayed tracks
+    // doesn't need to scan the whole table.
+    // CREATE INDEX temp_autodj_crates_active ON temp_autodj_crates (autodjrefs, timesplayed, lastplayed);
+    // CREATE INDEX temp_autodj_crates_lastplayed ON temp_autodj_crates (autodjrefs, lastplayed);
+    oQuery.prepare(QStringLiteral("CREATE INDEX " AUTODJCRATES_TABLE "_active ON " AUTODJCRATES_TABLE
+            " (" AUTODJCRATESTABLE_AUTODJREFS "," AUTODJCRATESTABLE_TIMESPLAYED
+            "," AUTODJCRATESTABLE_LASTPLAYED ")"));
+    if (!oQuery.exec()) {
+        LOG_FAILED_QUERY(oQuery);
+        return;
+    }
+    oQuery.prepare(QStringLiteral("CREATE INDEX " AUTODJCRATES_TABLE "_lastplayed ON " AUTODJCRATES_TABLE
+            " (" AUTODJCRATESTABLE_AUTODJREFS "," AUTODJCRATESTABLE_LASTPLAYED ")"));
+    if (!oQuery.exec()) {
+        LOG_FAILED_QUERY(oQuery);
+        return;
+    }
+
     // Fill out the number of auto-DJ-playlist references.
     if (!updateAutoDjPlaylistReferences()) {
         return;
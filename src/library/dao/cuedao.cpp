@@ -63,6 +63,14 @@ CuePointer cueFromRow(const QSqlRecord& row) {
 
 } // namespace
 
+CueDAO::~CueDAO() = default;
+
+void CueDAO::finish() {
+    m_pQueryCueInsert.reset();
+    m_pQueryCueUpdate.reset();
+    m_storedCueIds.clear();
+}
+
 QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
     //qDebug() << "CueDAO::getCuesForTrack" << QThread::currentThread() << m_database.connectionName();
     QList<CuePointer> cues;
@@ -81,11 +89,14 @@ QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
         return cues;
     }
     QMap<int, CuePointer> hotCuesByNumber;
+    QSet<DbId> storedCueIds;
     while (query.next()) {
         CuePointer pCue = cueFromRow(query.record());
         VERIFY_OR_DEBUG_ASSERT(pCue) {
             continue;
         }
+        // Dropped duplicates are stored, too, and deleted on the next save
+        storedCueIds.insert(pCue->getId());
         int hotCueNumber = pCue->getHotCue();
         if (hotCueNumber != Cue::kNoHotCue) {
             const auto pDuplicateCue = hotCuesByNumber.take(hotCueNumber);
@@ -101,6 +112,7 @@ QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
         }
         cues.push_back(pCue);
     }
+    m_storedCueIds.insert(trackId, storedCueIds);
     return cues;
 }
 
@@ -109,6 +121,7 @@ bool CueDAO::deleteCuesForTrack(TrackId trackId) const {
     QSqlQuery query(m_database);
     query.prepare(QStringLiteral("DELETE FROM " CUE_TABLE " WHERE track_id=:track_id"));
     query.bindValue(":track_id", trackId.toVariant());
+    m_storedCueIds.remove(trackId);
     if (query.exec()) {
         return true;
     } else {
@@ -123,6 +136,7 @@ bool CueDAO::deleteCuesForTracks(const QList<TrackId>& trackIds) const {
     QStringList idList;
     for (const auto& trackId: trackIds) {
         idList << trackId.toString();
+        m_storedCueIds.remove(trackId);
     }
 
     QSqlQuery query(m_database);
@@ -143,26 +157,31 @@ bool CueDAO::saveCue(TrackId trackId, Cue* cue) const {
     }
 
     // Prepare query
-    QSqlQuery query(m_database);
-    if (cue->getId().isValid()) {
-        // Update cue
-        query.prepare(QStringLiteral("UPDATE " CUE_TABLE " SET "
-                        "track_id=:track_id,"
-                        "type=:type,"
-                        "position=:position,"
-                        "length=:length,"
-                        "hotcue=:hotcue,"
-                        "label=:label,"
-                        "color=:color"
-                        " WHERE id=:id"));
+    const bool isNewCue = !cue->getId().isValid();
+    std::unique_ptr<QSqlQuery>& pQuery =
+            isNewCue ? m_pQueryCueInsert : m_pQueryCueUpdate;
+    if (!pQuery) {
+        pQuery = std::make_unique<QSqlQuery>(m_database);
+        if (isNewCue) {
+            pQuery->prepare(QStringLiteral("INSERT INTO " CUE_TABLE
+                    " (track_id, type, position, length, hotcue, "
+                    "label, color) VALUES (:track_id, :type, "
+                    ":position, :length, :hotcue, :label, :color)"));
+        } else {
+            pQuery->prepare(QStringLiteral("UPDATE " CUE_TABLE " SET "
+                    "track_id=:track_id,"
+                    "type=:type,"
+                    "position=:position,"
+                    "length=:length,"
+                    "hotcue=:hotcue,"
+                    "label=:label,"
+                    "color=:color"
+                    " WHERE id=:id"));
+        }
+    }
+    QSqlQuery& query = *pQuery;
+    if (!isNewCue) {
         query.bindValue(":id", cue->getId().toVariant());
-    } else {
-        // New cue
-        query.prepare(
-                QStringLiteral("INSERT INTO " CUE_TABLE
-                               " (track_id, type, position, length, hotcue, "
-                               "label, color) VALUES (:track_id, :type, "
-                               ":position, :length, :hotcue, :label, :color)"));
     }
 
     // Bind values and execute query
@@ -178,8 +197,7 @@ bool CueDAO::saveCue(TrackId trackId, Cue* cue) const {
         return false;
     }
 
-    if (!cue->getId().isValid()) {
-        // New cue
+    if (isNewCue) {
         const auto newId = DbId(query.lastInsertId());
         DEBUG_ASSERT(newId.isValid());
         cue->setId(newId);
@@ -189,14 +207,14 @@ bool CueDAO::saveCue(TrackId trackId, Cue* cue) const {
     return true;
 }
 
-bool CueDAO::deleteCue(Cue* cue) const {
+bool CueDAO::deleteCue(DbId cueId) const {
     //qDebug() << "CueDAO::deleteCue" << QThread::currentThread() << m_database.connectionName();
-    if (!cue->getId().isValid()) {
+    if (!cueId.isValid()) {
         return false;
     }
     QSqlQuery query(m_database);
     query.prepare(QStringLiteral("DELETE FROM " CUE_TABLE " WHERE id=:id"));
-    query.bindValue(":id", cue->getId().toVariant());
+    query.bindValue(":id", cueId.toVariant());
     if (!query.exec()) {
         LOG_FAILED_QUERY(query);
         return false;
@@ -208,7 +226,7 @@ void CueDAO::saveTrackCues(
         TrackId trackId,
         const QList<CuePointer>& cueList) const {
     DEBUG_ASSERT(trackId.isValid());
-    QStringList cueIds;
+    QSet<DbId> cueIds;
     cueIds.reserve(cueList.size());
     for (const auto& pCue : cueList) {
         // New cues (without an id) must always be marked as dirty
@@ -221,14 +239,39 @@ void CueDAO::saveTrackCues(
         VERIFY_OR_DEBUG_ASSERT(pCue->getId().isValid()) {
             continue;
         }
-        cueIds.append(pCue->getId().toString());
+        cueIds.insert(pCue->getId());
+    }
+
+    const auto storedCueIds = m_storedCueIds.constFind(trackId);
+    if (storedCueIds != m_storedCueIds.constEnd()) {
+        // Only delete the cues that have been removed from the track
+        int deletedCues = 0;
+        for (const auto& cueId : *storedCueIds) {
+            if (!cueIds.contains(cueId) && deleteCue(cueId)) {
+                ++deletedCues;
+            }
+        }
+        if (deletedCues > 0) {
+            kLogger.debug()
+                    << "Deleted"
+                    << deletedCues
+                    << "removed cue(s) of track"
+                    << trackId;
+        }
+        m_storedCueIds.insert(trackId, cueIds);
+        return;
     }
 
     // Delete orphaned cues
+    QStringList cueIdList;
+    cueIdList.reserve(cueIds.size());
+    for (const auto& cueId : std::as_const(cueIds)) {
+        cueIdList.append(cueId.toString());
+    }
     FwdSqlQuery query(
             m_database,
             QStringLiteral("DELETE FROM " CUE_TABLE " WHERE track_id=:track_id AND id NOT IN (%1)")
-                    .arg(cueIds.join(QChar(','))));
+                    .arg(cueIdList.join(QChar(','))));
     DEBUG_ASSERT(
             query.isPrepared() &&
             !query.hasError());
@@ -246,4 +289,5 @@ void CueDAO::saveTrackCues(
                 << "orphaned cue(s) of track"
                 << trackId;
     }
+    m_storedCueIds.insert(trackId, cueIds);
 }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <QHash>
+#include <QSet>
 #include <QSqlDatabase>
+#include <memory>
 
 #include "library/dao/dao.h"
 #include "track/cue.h"
@@ -9,10 +12,14 @@
 #define CUE_TABLE "cues"
 
 class Cue;
+class QSqlQuery;
 
 class CueDAO : public DAO {
   public:
-    ~CueDAO() override = default;
+    ~CueDAO() override;
+
+    /// Releases the prepared statements before the database is closed.
+    void finish();
 
     QList<CuePointer> getCuesForTrack(TrackId trackId) const;
 
@@ -22,5 +29,14 @@ class CueDAO : public DAO {
 
   private:
     bool saveCue(TrackId trackId, Cue* pCue) const;
-    bool deleteCue(Cue* pCue) const;
+    bool deleteCue(DbId cueId) const;
+
+    /// The ids of all cues in the database of each track that has been
+    /// loaded or saved. Only the cues that have been removed since then
+    /// need to be deleted when saving the track again.
+    mutable QHash<TrackId, QSet<DbId>> m_storedCueIds;
+
+    // The prepared statements are reused for all saved cues
+    mutable std::unique_ptr<QSqlQuery> m_pQueryCueInsert;
+    mutable std::unique_ptr<QSqlQuery> m_pQueryCueUpdate;
 };
@@ -5,6 +5,7 @@
 #include <QRandomGenerator>
 #include <QtDebug>
 #include <QtSql>
+#include <algorithm>
 
 #include "library/autodj/autodjprocessor.h"
 #include "library/queryutil.h"
@@ -427,6 +428,32 @@ int PlaylistDAO::getPlaylistId(const int index) const {
     return -1;
 }
 
+QList<PlaylistDAO::PlaylistInfo> PlaylistDAO::getPlaylistInfos(HiddenType hidden) const {
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral(
+            "SELECT id, name, locked FROM Playlists WHERE hidden = :hidden"));
+    query.bindValue(":hidden", static_cast<int>(hidden));
+
+    QList<PlaylistInfo> playlistInfos;
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return playlistInfos;
+    }
+    while (query.next()) {
+        playlistInfos.append(PlaylistInfo{
+                query.value(0).toInt(),
+                query.value(1).toString(),
+                query.value(2).toInt() == 1});
+    }
+    // Sorted like QString, which differs from the collation of SQLite
+    std::sort(playlistInfos.begin(),
+            playlistInfos.end(),
+            [](const PlaylistInfo& lhs, const PlaylistInfo& rhs) {
+                return lhs.name < rhs.name;
+            });
+    return playlistInfos;
+}
+
 PlaylistDAO::HiddenType PlaylistDAO::getHiddenType(const int playlistId) const {
     // qDebug() << "PlaylistDAO::getHiddenType"
     //          << QThread::currentThread() << m_database.connectionName();
@@ -643,7 +670,6 @@ int PlaylistDAO::insertTracksIntoPlaylist(const QList<TrackId>& trackIds,
         return 0;
     }
 
-    int tracksAdded = 0;
     ScopedTransaction transaction(m_database);
 
     int max_position = getMaxPosition(playlistId) + 1;
@@ -652,51 +678,72 @@ int PlaylistDAO::insertTracksIntoPlaylist(const QList<TrackId>& trackIds,
         position = max_position;
     }
 
+    QList<TrackId> validTrackIds;
+    validTrackIds.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        if (trackId.isValid()) {
+            validTrackIds.append(trackId);
+        }
+    }
+    if (validTrackIds.isEmpty()) {
+        return 0;
+    }
+
+    // Make room for all tracks at once, instead of moving the following
+    // tracks once per inserted track.
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral(
+            "UPDATE PlaylistTracks SET position=position+:count "
+            "WHERE position>=:position AND "
+            "playlist_id=:id"));
+    query.bindValue(":count", validTrackIds.size());
+    query.bindValue(":id", playlistId);
+    query.bindValue(":position", position);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return 0;
+    }
+
     QSqlQuery insertQuery(m_database);
     insertQuery.prepare(QStringLiteral(
             "INSERT INTO PlaylistTracks (playlist_id, track_id, position)"
             "VALUES (:playlist_id, :track_id, :position)"));
-    QSqlQuery query(m_database);
-    int insertPositon = position;
-    for (const auto& trackId : trackIds) {
-        if (!trackId.isValid()) {
+    QList<TrackId> addedTrackIds;
+    addedTrackIds.reserve(validTrackIds.size());
+    for (const auto& trackId : qAsConst(validTrackIds)) {
+        // Insert the track at the given position
+        insertQuery.bindValue(":playlist_id", playlistId);
+        insertQuery.bindValue(":track_id", trackId.toVariant());
+        insertQuery.bindValue(":position", position + addedTrackIds.size());
+        if (!insertQuery.exec()) {
+            LOG_FAILED_QUERY(insertQuery);
             continue;
         }
-        // Move all tracks in playlist up by 1.
-        // TODO(XXX) We could do this in one query before the for loop.
+        addedTrackIds.append(trackId);
+    }
+    const int tracksAdded = addedTrackIds.size();
+
+    if (tracksAdded < validTrackIds.size()) {
+        // Close the gap left by the tracks that failed to insert
         query.prepare(QStringLiteral(
-                "UPDATE PlaylistTracks SET position=position+1 "
+                "UPDATE PlaylistTracks SET position=position-:count "
                 "WHERE position>=:position AND "
                 "playlist_id=:id"));
+        query.bindValue(":count", validTrackIds.size() - tracksAdded);
         query.bindValue(":id", playlistId);
-        query.bindValue(":position", insertPositon);
-
+        query.bindValue(":position", position + validTrackIds.size());
         if (!query.exec()) {
             LOG_FAILED_QUERY(query);
-            continue;
-        }
-
-        // Insert the track at the given position
-        insertQuery.bindValue(":playlist_id", playlistId);
-        insertQuery.bindValue(":track_id", trackId.toVariant());
-        insertQuery.bindValue(":position", insertPositon);
-        if (!insertQuery.exec()) {
-            LOG_FAILED_QUERY(insertQuery);
-            continue;
+            return 0;
         }
-
-        // Increment the insert position for the track.
-        ++insertPositon;
-        ++tracksAdded;
     }
 
     transaction.commit();
 
-    insertPositon = position;
-    for (const auto& trackId : trackIds) {
+    int insertPosition = position;
+    for (const auto& trackId : qAsConst(addedTrackIds)) {
         m_playlistsTrackIsIn.insert(trackId, playlistId);
-        // TODO(XXX) The position is wrong if any track failed to insert.
-        emit trackAdded(playlistId, trackId, insertPositon++);
+        emit trackAdded(playlistId, trackId, insertPosition++);
     }
     emit tracksChanged(QSet<int>{playlistId});
     return tracksAdded;
@@ -877,67 +924,29 @@ int PlaylistDAO::tracksInPlaylist(const int playlistId) const {
 }
 
 void PlaylistDAO::moveTrack(const int playlistId, const int oldPosition, const int newPosition) {
-    ScopedTransaction transaction(m_database);
-    QSqlQuery query(m_database);
-
-    // Algorithm for code below
-    // Case 1: destination < source (newPositon < oldPosition)
-    //    1) Set position = -1 where pos=source -- Gives that track a dummy index to keep stuff simple.
-    //    2) Decrement position where pos >= dest AND pos < source
-    //    3) Set position = dest where pos=-1 -- Move track from dummy pos to final destination.
-
-    // Case 2: destination > source (newPos > oldPos)
-    //   1) Set position=-1 where pos=source -- Give track a dummy index again.
-    //   2) Decrement position where pos > source AND pos <= dest
-    //   3) Set position=dest where pos=-1 -- Move that track from dummy pos to final destination
-
-    // Move moved track to dummy position -1
-    query.prepare(QStringLiteral(
-            "UPDATE PlaylistTracks SET position=-1 "
-            "WHERE position=:position AND "
-            "playlist_id=:id"));
-    query.bindValue(":position", oldPosition);
-    query.bindValue(":id", playlistId);
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-    }
-
-    if (newPosition < oldPosition) {
-        query.prepare(QStringLiteral(
-                "UPDATE PlaylistTracks SET position=position+1 "
-                "WHERE position >= :new_position AND position < :old_position AND "
-                "playlist_id=:id"));
-        query.bindValue(":new_position", newPosition);
-        query.bindValue(":old_position", oldPosition);
-        query.bindValue(":id", playlistId);
-    } else {
-        query.prepare(QStringLiteral(
-                "UPDATE PlaylistTracks SET position=position-1 "
-                "WHERE position > :old_position AND position <= :new_position AND "
-                "playlist_id=:id"));
-        query.bindValue(":new_position", newPosition);
-        query.bindValue(":old_position", oldPosition);
-        query.bindValue(":id", playlistId);
-    }
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
+    if (oldPosition == newPosition) {
+        return;
     }
 
+    // The moved track gets its destination and the tracks between source and
+    // destination are shifted by one towards the source, all in a single
+    // statement that only touches the rows in between.
+    QSqlQuery query(m_database);
     query.prepare(QStringLiteral(
-            "UPDATE PlaylistTracks SET position=:new_position "
-            "WHERE position=-1 AND "
+            "UPDATE PlaylistTracks SET position=CASE "
+            "WHEN position=:old_position THEN :new_position "
+            "ELSE position+:shift END "
+            "WHERE position>=:first_position AND position<=:last_position AND "
             "playlist_id=:id"));
+    query.bindValue(":old_position", oldPosition);
     query.bindValue(":new_position", newPosition);
+    query.bindValue(":shift", newPosition < oldPosition ? 1 : -1);
+    query.bindValue(":first_position", std::min(oldPosition, newPosition));
+    query.bindValue(":last_position", std::max(oldPosition, newPosition));
     query.bindValue(":id", playlistId);
     if (!query.exec()) {
         LOG_FAILED_QUERY(query);
-    }
-
-    transaction.commit();
-
-    // Print out any SQL error, if there was one.
-    if (query.lastError().isValid()) {
-        qDebug() << query.lastError();
+        return;
     }
 
     emit tracksChanged(QSet<int>{playlistId});
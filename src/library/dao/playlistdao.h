@@ -44,6 +44,12 @@ class PlaylistDAO : public QObject, public virtual DAO {
         REPLACE,
     };
 
+    struct PlaylistInfo {
+        int id;
+        QString name;
+        bool locked;
+    };
+
     PlaylistDAO();
     ~PlaylistDAO() override = default;
 
@@ -80,6 +86,9 @@ class PlaylistDAO : public QObject, public virtual DAO {
     // position in the database table, not the display order position column
     // stored in the database.
     int getPlaylistId(const int index) const;
+    // Get the id, name and lock state of all playlists with the HiddenType
+    // hidden in a single query, sorted by name.
+    QList<PlaylistInfo> getPlaylistInfos(HiddenType hidden) const;
     QList<TrackId> getTrackIds(const int playlistId) const;
     // Returns true if the playlist with playlistId is hidden
     bool isHidden(const int playlistId) const;
@@ -5,8 +5,11 @@
 #include <QDirIterator>
 #include <QFileInfo>
 #include <QImage>
+#include <QtConcurrentMap>
 #include <QtDebug>
 #include <QtSql>
+#include <memory>
+#include <optional>
 
 #ifdef __SQLITE3__
 #include <sqlite3.h>
@@ -36,10 +39,12 @@
 #include "util/db/sqlite.h"
 #include "util/db/sqlstringformatter.h"
 #include "util/db/sqltransaction.h"
+#include "util/db/sqlwritebatch.h"
 #include "util/fileinfo.h"
 #include "util/logger.h"
 #include "util/math.h"
 #include "util/qt.h"
+#include "util/taskmonitor.h"
 #include "util/timer.h"
 
 namespace {
@@ -48,6 +53,25 @@ mixxx::Logger kLogger("TrackDAO");
 
 enum { UndefinedRecordIndex = -2 };
 
+// The metadata of missing tracks is read from their files in parallel
+// in batches of this size before adding them to the library
+constexpr int kImportMetadataBatchSize = 64;
+
+/// Allows to abort adding missing tracks from the progress dialog.
+class AddMissingTracksTask : public mixxx::Task {
+  public:
+    bool isAborted() const {
+        return m_aborted;
+    }
+
+    void slotAbortTask() override {
+        m_aborted = true;
+    }
+
+  private:
+    bool m_aborted = false;
+};
+
 void markTrackLocationsAsDeleted(const QSqlDatabase& database, const QString& directory) {
     //qDebug() << "TrackDAO::markTrackLocationsAsDeleted" << QThread::currentThread() << m_database.connectionName();
     QSqlQuery query(database);
@@ -116,6 +140,16 @@ TrackDAO::~TrackDAO() {
 void TrackDAO::finish() {
     qDebug() << "TrackDAO::finish()";
 
+    // Commit all tracks that have been saved recently
+    if (SqlWriteBatch::isPending(m_database)) {
+        if (SqlWriteBatch::flush(m_database)) {
+            qDebug() << "Committed pending track updates";
+        } else {
+            qWarning() << "Failed to commit pending track updates";
+        }
+    }
+    m_pQueryTrackUpdate.reset();
+
     // clear out played information on exit
     // crash prevention: if mixxx crashes, played information will be maintained
     qDebug() << "Clearing played information for this session";
@@ -183,40 +217,40 @@ QList<TrackId> TrackDAO::resolveTrackIds(
         return trackIds;
     }
 
-    QStringList pathList;
-    pathList.reserve(fileInfos.size());
-    for (const auto& fileInfo : fileInfos) {
-        pathList << "(" + SqlStringFormatter::format(m_database, fileInfo.location()) + ")";
-    }
-
-    // Add all the track paths temporary to this database.
-    query.prepare(
-            "INSERT INTO playlist_import (location) "
-            "VALUES " + pathList.join(','));
-    VERIFY_OR_DEBUG_ASSERT(query.exec()) {
-        LOG_FAILED_QUERY(query);
+    // Add all the track paths temporary to this database. The statement
+    // is prepared once instead of formatting all paths into a single
+    // statement that might exceed the maximum length of SQL statements.
+    {
+        SqlTransaction transaction(m_database);
+        query.prepare(
+                "INSERT INTO playlist_import (location) "
+                "VALUES (:location)");
+        for (const auto& fileInfo : fileInfos) {
+            query.bindValue(":location", fileInfo.location());
+            VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+                LOG_FAILED_QUERY(query);
+                break;
+            }
+        }
+        transaction.commit();
     }
 
     if (flags & ResolveTrackIdFlag::AddMissing) {
-        // Prepare to add tracks to the database.
-        // This also begins an SQL transaction.
-        addTracksPrepare();
-
         // Any tracks not already in the database need to be added.
-        query.prepare("SELECT location FROM playlist_import "
+        query.prepare("SELECT DISTINCT location FROM playlist_import "
                 "WHERE NOT EXISTS (SELECT location FROM track_locations "
                 "WHERE playlist_import.location = track_locations.location)");
         VERIFY_OR_DEBUG_ASSERT(query.exec()) {
             LOG_FAILED_QUERY(query);
         }
+        QList<QString> missingLocations;
         const int locationColumn = query.record().indexOf("location");
         while (query.next()) {
-            QString location = query.value(locationColumn).toString();
-            addTracksAddFile(location, true);
+            missingLocations.append(query.value(locationColumn).toString());
+        }
+        if (!missingLocations.isEmpty()) {
+            addMissingTracks(missingLocations);
         }
-
-        // Finish adding tracks to the database.
-        addTracksFinish();
     }
 
     query.prepare(
@@ -260,6 +294,56 @@ QList<TrackId> TrackDAO::resolveTrackIds(
     return trackIds;
 }
 
+void TrackDAO::addMissingTracks(const QList<QString>& locations) {
+    const bool resetMissingTagMetadata =
+            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig)
+                    .resetMissingTagMetadataOnImport;
+
+    AddMissingTracksTask task;
+    mixxx::TaskMonitor taskMonitor(tr("Adding tracks to the library"));
+    taskMonitor.registerTask(&task);
+
+    // Prepare to add tracks to the database.
+    // This also begins an SQL transaction.
+    addTracksPrepare();
+    for (int offset = 0; offset < locations.size(); offset += kImportMetadataBatchSize) {
+        if (task.isAborted()) {
+            kLogger.info()
+                    << "Aborted adding tracks after"
+                    << offset
+                    << "of"
+                    << locations.size();
+            break;
+        }
+        // Reading the files takes much longer than adding them
+        const QList<QString> batch = locations.mid(offset, kImportMetadataBatchSize);
+        const QList<std::shared_ptr<const SoundSourceProxy::ImportedTrackMetadata>>
+                importedTrackMetadata = QtConcurrent::blockingMapped(batch,
+                        [resetMissingTagMetadata](const QString& location) {
+                            return SoundSourceProxy::
+                                    importNewTrackMetadataAndCoverImageFromFile(
+                                            mixxx::FileAccess(mixxx::FileInfo(location)),
+                                            resetMissingTagMetadata);
+                        });
+        for (int i = 0; i < batch.size(); ++i) {
+            addTracksAddFile(
+                    mixxx::FileAccess(mixxx::FileInfo(batch.at(i))),
+                    true,
+                    importedTrackMetadata.at(i).get());
+        }
+        taskMonitor.reportTaskProgress(&task,
+                mixxx::kPercentageOfCompletionMin +
+                        (mixxx::kPercentageOfCompletionMax -
+                                mixxx::kPercentageOfCompletionMin) *
+                                (offset + batch.size()) /
+                                static_cast<mixxx::PercentageOfCompletion>(
+                                        locations.size()));
+    }
+    // Finish adding tracks to the database.
+    addTracksFinish();
+    taskMonitor.unregisterTask(&task);
+}
+
 QSet<QString> TrackDAO::getAllTrackLocations() const {
     QSet<QString> locations;
     QSqlQuery query(m_database);
@@ -276,6 +360,27 @@ QSet<QString> TrackDAO::getAllTrackLocations() const {
     return locations;
 }
 
+QHash<QString, qint64> TrackDAO::getAllTrackSourceSynchronizedMillis() const {
+    QHash<QString, qint64> sourceSynchronizedMillis;
+    QSqlQuery query(m_database);
+    query.prepare("SELECT track_locations.location, library.source_synchronized_ms "
+                  "FROM track_locations "
+                  "INNER JOIN library on library.location = track_locations.id "
+                  "WHERE library.source_synchronized_ms IS NOT NULL");
+    VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+
+    int locationColumn = query.record().indexOf("location");
+    int sourceSynchronizedColumn = query.record().indexOf("source_synchronized_ms");
+    while (query.next()) {
+        sourceSynchronizedMillis.insert(
+                query.value(locationColumn).toString(),
+                query.value(sourceSynchronizedColumn).toLongLong());
+    }
+    return sourceSynchronizedMillis;
+}
+
 // Some code (eg. drag and drop) needs to just get a track's location, and it's
 // not worth retrieving a whole Track.
 QString TrackDAO::getTrackLocation(TrackId trackId) const {
@@ -817,7 +922,8 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
 
 TrackPointer TrackDAO::addTracksAddFile(
         const mixxx::FileAccess& fileAccess,
-        bool unremove) {
+        bool unremove,
+        const SoundSourceProxy::ImportedTrackMetadata* pImportedTrackMetadata) {
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
     // the track is already in the library. A refactoring is
@@ -867,7 +973,8 @@ TrackPointer TrackDAO::addTracksAddFile(
     // from the file.
     SoundSourceProxy(pTrack).updateTrackFromSource(
             SoundSourceProxy::UpdateTrackFromSourceMode::Once,
-            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
+            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig),
+            pImportedTrackMetadata);
     if (!pTrack->checkSourceSynchronized()) {
         qWarning() << "TrackDAO::addTracksAddFile:"
                 << "Failed to parse track metadata from file"
@@ -895,6 +1002,16 @@ TrackPointer TrackDAO::addTracksAddFile(
     // m_tracksAddedSet and will keep their dirty flag unchanged.
     if (m_tracksAddedSet.contains(newTrackId)) {
         pTrack->markClean();
+        if (pImportedTrackMetadata && !pImportedTrackMetadata->audioDigest.isEmpty()) {
+            QSqlQuery query(m_database);
+            query.prepare(QStringLiteral(
+                    "UPDATE library SET audio_digest=:audioDigest WHERE id=:id"));
+            query.bindValue(":audioDigest", pImportedTrackMetadata->audioDigest);
+            query.bindValue(":id", newTrackId.toVariant());
+            VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+                LOG_FAILED_QUERY(query);
+            }
+        }
     }
     return pTrack;
 }
@@ -1323,6 +1440,87 @@ struct ColumnPopulator {
     TrackPopulatorFn populator;
 };
 
+constexpr ColumnPopulator kTrackColumns[] = {
+        // Location must be first and is populated manually!
+        {"track_locations.location", nullptr},
+        {"artist", setTrackArtist},
+        {"title", setTrackTitle},
+        {"album", setTrackAlbum},
+        {"album_artist", setTrackAlbumArtist},
+        {"year", setTrackYear},
+        {"genre", setTrackGenre},
+        {"composer", setTrackComposer},
+        {"grouping", setTrackGrouping},
+        {"tracknumber", setTrackNumber},
+        {"tracktotal", setTrackTotal},
+        {"filetype", setTrackFiletype},
+        {"rating", setTrackRating},
+        {"color", setTrackColor},
+        {"comment", setTrackComment},
+        {"url", setTrackUrl},
+        {"cuepoint", setTrackCuePoint},
+        {"replaygain", setTrackReplayGainRatio},
+        {"replaygain_peak", setTrackReplayGainPeak},
+        {"timesplayed", setTrackTimesPlayed},
+        {"last_played_at", setTrackLastPlayedAt},
+        {"played", setTrackPlayed},
+        {"datetime_added", setTrackDateAdded},
+        {"header_parsed", setTrackHeaderParsed},
+        {"source_synchronized_ms", setTrackSourceSynchronizedAt},
+
+        // Audio properties are set together at once. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"channels", setTrackAudioProperties},
+        {"samplerate", nullptr},
+        {"bitrate", nullptr},
+        {"duration", nullptr},
+
+        // Beat detection columns are handled by setTrackBeats. Do not change
+        // the ordering of these columns or put other columns in between them!
+        {"bpm", setTrackBeats},
+        {"beats_version", nullptr},
+        {"beats_sub_version", nullptr},
+        {"beats", nullptr},
+        {"bpm_lock", nullptr},
+
+        // Beat detection columns are handled by setTrackKey. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"key", setTrackKey},
+        {"keys_version", nullptr},
+        {"keys_sub_version", nullptr},
+        {"keys", nullptr},
+
+        // Cover art columns are handled by setTrackCoverInfo. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"coverart_source", setTrackCoverInfo},
+        {"coverart_type", nullptr},
+        {"coverart_location", nullptr},
+        {"coverart_color", nullptr},
+        {"coverart_digest", nullptr},
+        {"coverart_hash", nullptr},
+};
+constexpr int kTrackColumnsCount = static_cast<int>(std::size(kTrackColumns));
+
+QString selectTrackByIdQueryString() {
+    QString columnsStr;
+    int columnsSize = 0;
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        columnsSize += qstrlen(kTrackColumns[i].name) + 1;
+    }
+    columnsStr.reserve(columnsSize);
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        if (i > 0) {
+            columnsStr.append(QChar(','));
+        }
+        columnsStr.append(kTrackColumns[i].name);
+    }
+    return QStringLiteral(
+            "SELECT %1 FROM Library "
+            "INNER JOIN track_locations ON library.location = track_locations.id "
+            "WHERE library.id=:id")
+            .arg(columnsStr);
+}
+
 }  // namespace
 
 TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
@@ -1336,66 +1534,93 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         return pTrack;
     }
 
-    constexpr ColumnPopulator columns[] = {
-            // Location must be first and is populated manually!
-            {"track_locations.location", nullptr},
-            {"artist", setTrackArtist},
-            {"title", setTrackTitle},
-            {"album", setTrackAlbum},
-            {"album_artist", setTrackAlbumArtist},
-            {"year", setTrackYear},
-            {"genre", setTrackGenre},
-            {"composer", setTrackComposer},
-            {"grouping", setTrackGrouping},
-            {"tracknumber", setTrackNumber},
-            {"tracktotal", setTrackTotal},
-            {"filetype", setTrackFiletype},
-            {"rating", setTrackRating},
-            {"color", setTrackColor},
-            {"comment", setTrackComment},
-            {"url", setTrackUrl},
-            {"cuepoint", setTrackCuePoint},
-            {"replaygain", setTrackReplayGainRatio},
-            {"replaygain_peak", setTrackReplayGainPeak},
-            {"timesplayed", setTrackTimesPlayed},
-            {"last_played_at", setTrackLastPlayedAt},
-            {"played", setTrackPlayed},
-            {"datetime_added", setTrackDateAdded},
-            {"header_parsed", setTrackHeaderParsed},
-            {"source_synchronized_ms", setTrackSourceSynchronizedAt},
-
-            // Audio properties are set together at once. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"channels", setTrackAudioProperties},
-            {"samplerate", nullptr},
-            {"bitrate", nullptr},
-            {"duration", nullptr},
-
-            // Beat detection columns are handled by setTrackBeats. Do not change
-            // the ordering of these columns or put other columns in between them!
-            {"bpm", setTrackBeats},
-            {"beats_version", nullptr},
-            {"beats_sub_version", nullptr},
-            {"beats", nullptr},
-            {"bpm_lock", nullptr},
-
-            // Beat detection columns are handled by setTrackKey. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"key", setTrackKey},
-            {"keys_version", nullptr},
-            {"keys_sub_version", nullptr},
-            {"keys", nullptr},
-
-            // Cover art columns are handled by setTrackCoverInfo. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"coverart_source", setTrackCoverInfo},
-            {"coverart_type", nullptr},
-            {"coverart_location", nullptr},
-            {"coverart_color", nullptr},
-            {"coverart_digest", nullptr},
-            {"coverart_hash", nullptr},
-    };
-    constexpr int columnsCount = static_cast<int>(std::size(columns));
+    QSqlQuery query(m_database);
+    query.prepare(selectTrackByIdQueryString());
+    return loadTrackById(&query, trackId);
+}
+
+QList<TrackPointer> TrackDAO::getTracksByIds(
+        const QList<TrackId>& trackIds) const {
+    QList<TrackPointer> tracks;
+    tracks.reserve(trackIds.size());
+    // The query is only prepared once on demand and then reused for
+    // all tracks that are not cached yet.
+    std::optional<QSqlQuery> query;
+    for (const auto& trackId : trackIds) {
+        if (!trackId.isValid()) {
+            continue;
+        }
+        // The GlobalTrackCache is only locked while executing the following line.
+        TrackPointer pTrack = GlobalTrackCacheLocker().lookupTrackById(trackId);
+        if (!pTrack) {
+            if (!query) {
+                query.emplace(m_database);
+                query->prepare(selectTrackByIdQueryString());
+            }
+            pTrack = loadTrackById(&*query, trackId);
+        }
+        if (pTrack) {
+            tracks.append(std::move(pTrack));
+        }
+    }
+    return tracks;
+}
+
+QList<TrackDAO::TrackSummary> TrackDAO::getTrackSummariesByIds(
+        const QList<TrackId>& trackIds) const {
+    QSet<TrackId> validTrackIds;
+    validTrackIds.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        if (trackId.isValid()) {
+            validTrackIds.insert(trackId);
+        }
+    }
+    if (validTrackIds.isEmpty()) {
+        return {};
+    }
+
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral(
+            "SELECT library.id,track_locations.location,artist,title,duration,timesplayed "
+            "FROM library "
+            "INNER JOIN track_locations ON library.location=track_locations.id "
+            "WHERE library.id IN (%1)")
+                          .arg(joinTrackIdList(validTrackIds)));
+    VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return {};
+    }
+
+    QHash<TrackId, TrackSummary> summariesById;
+    summariesById.reserve(validTrackIds.size());
+    while (query.next()) {
+        TrackSummary summary;
+        summary.id = TrackId(query.value(0));
+        summary.location = query.value(1).toString();
+        summary.artist = query.value(2).toString();
+        summary.title = query.value(3).toString();
+        summary.durationSeconds = query.value(4).toDouble();
+        summary.timesPlayed = query.value(5).toInt();
+        summariesById.insert(summary.id, summary);
+    }
+
+    // Preserve the order of the requested ids
+    QList<TrackSummary> summaries;
+    summaries.reserve(summariesById.size());
+    for (const auto& trackId : trackIds) {
+        const auto i = summariesById.constFind(trackId);
+        if (i != summariesById.constEnd()) {
+            summaries.append(i.value());
+        }
+    }
+    return summaries;
+}
+
+TrackPointer TrackDAO::loadTrackById(
+        QSqlQuery* pSelectQuery,
+        TrackId trackId) const {
+    DEBUG_ASSERT(pSelectQuery);
+    DEBUG_ASSERT(trackId.isValid());
 
     // Accessing the database is a time consuming operation that should not
     // be executed with a lock on the GlobalTrackCache. The GlobalTrackCache
@@ -1405,40 +1630,25 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
 
     QSqlRecord queryRecord;
     {
-        QString columnsStr;
-        int columnsSize = 0;
-        for (int i = 0; i < columnsCount; ++i) {
-            columnsSize += qstrlen(columns[i].name) + 1;
-        }
-        columnsStr.reserve(columnsSize);
-        for (int i = 0; i < columnsCount; ++i) {
-            if (i > 0) {
-                columnsStr.append(QChar(','));
-            }
-            columnsStr.append(columns[i].name);
-        }
-
-        QSqlQuery query(m_database);
-        query.prepare(QString(
-                "SELECT %1 FROM Library "
-                "INNER JOIN track_locations ON library.location = track_locations.id "
-                "WHERE library.id = %2")
-                              .arg(columnsStr, trackId.toString()));
-        VERIFY_OR_DEBUG_ASSERT(query.exec()) {
-            LOG_FAILED_QUERY(query)
+        pSelectQuery->bindValue(QStringLiteral(":id"), trackId.toVariant());
+        VERIFY_OR_DEBUG_ASSERT(pSelectQuery->exec()) {
+            LOG_FAILED_QUERY(*pSelectQuery)
                     << QString("getTrack(%1)").arg(trackId.toString());
             return nullptr;
         }
 
-        if (!query.next()) {
+        if (!pSelectQuery->next()) {
             qDebug() << "Track with id =" << trackId << "not found";
             return nullptr;
         }
-        queryRecord = query.record();
+        queryRecord = pSelectQuery->record();
         // Only a single record is expected
-        DEBUG_ASSERT(!query.next());
+        DEBUG_ASSERT(!pSelectQuery->next());
+        // Release the result set before the query is reused
+        pSelectQuery->finish();
     }
 
+    TrackPointer pTrack;
     {
         // Location is the first column.
         DEBUG_ASSERT(queryRecord.count() > 0);
@@ -1501,11 +1711,11 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     bool shouldDirty = false;
     {
         int recordCount = queryRecord.count();
-        VERIFY_OR_DEBUG_ASSERT(recordCount == columnsCount) {
-            recordCount = math_min(recordCount, columnsCount);
+        VERIFY_OR_DEBUG_ASSERT(recordCount == kTrackColumnsCount) {
+            recordCount = math_min(recordCount, kTrackColumnsCount);
         }
         for (int i = 0; i < recordCount; ++i) {
-            TrackPopulatorFn populator = columns[i].populator;
+            TrackPopulatorFn populator = kTrackColumns[i].populator;
             if (populator && (*populator)(queryRecord, i, pTrack.get())) {
                 // If any populator says the track should be dirty then we dirty it.
                 shouldDirty = true;
@@ -1649,60 +1859,69 @@ bool TrackDAO::updateTrack(const Track& track) const {
              << trackId
              << track.getFileInfo();
 
-    SqlTransaction transaction(m_database);
+    // Subsequent updates, e.g. after analyzing or importing many tracks,
+    // are committed together. All statements of this function are only
+    // executed in a transaction of their own if batching is not available.
+    std::optional<SqlTransaction> transaction;
+    if (!SqlWriteBatch::join(m_database)) {
+        transaction.emplace(m_database);
+    }
     // PerformanceTimer time;
     // time.start();
 
-    QSqlQuery query(m_database);
-
-    // Update everything but "location", since that's what we identify the track by.
-    query.prepare(
-            "UPDATE library SET "
-            "artist=:artist,"
-            "title=:title,"
-            "album=:album,"
-            "album_artist=:album_artist,"
-            "year=:year,"
-            "genre=:genre,"
-            "composer=:composer,"
-            "grouping=:grouping,"
-            "filetype=:filetype,"
-            "tracknumber=:tracknumber,"
-            "tracktotal=:tracktotal,"
-            "color=:color,"
-            "comment=:comment,"
-            "url=:url,"
-            "rating=:rating,"
-            "key=:key,"
-            "key_id=:key_id,"
-            "cuepoint=:cuepoint,"
-            "bpm=:bpm,"
-            "replaygain=:replaygain,"
-            "replaygain_peak=:replaygain_peak,"
-            "timesplayed=:timesplayed,"
-            "last_played_at=:last_played_at,"
-            "played=:played,"
-            "header_parsed=:header_parsed,"
-            "source_synchronized_ms=:source_synchronized_ms,"
-            "channels=:channels,"
-            "bitrate=:bitrate,"
-            "samplerate=:samplerate,"
-            "bitrate=:bitrate,"
-            "duration=:duration,"
-            "beats_version=:beats_version,"
-            "beats_sub_version=:beats_sub_version,"
-            "beats=:beats,"
-            "bpm_lock=:bpm_lock,"
-            "keys_version=:keys_version,"
-            "keys_sub_version=:keys_sub_version,"
-            "keys=:keys,"
-            "coverart_source=:coverart_source,"
-            "coverart_type=:coverart_type,"
-            "coverart_location=:coverart_location,"
-            "coverart_color=:coverart_color,"
-            "coverart_digest=:coverart_digest,"
-            "coverart_hash=:coverart_hash "
-            "WHERE id=:track_id");
+    // The prepared statement is reused for all updates
+    if (!m_pQueryTrackUpdate) {
+        m_pQueryTrackUpdate = std::make_unique<QSqlQuery>(m_database);
+        // Update everything but "location", since that's what we identify the track by.
+        m_pQueryTrackUpdate->prepare(
+                "UPDATE library SET "
+                "artist=:artist,"
+                "title=:title,"
+                "album=:album,"
+                "album_artist=:album_artist,"
+                "year=:year,"
+                "genre=:genre,"
+                "composer=:composer,"
+                "grouping=:grouping,"
+                "filetype=:filetype,"
+                "tracknumber=:tracknumber,"
+                "tracktotal=:tracktotal,"
+                "color=:color,"
+                "comment=:comment,"
+                "url=:url,"
+                "rating=:rating,"
+                "key=:key,"
+                "key_id=:key_id,"
+                "cuepoint=:cuepoint,"
+                "bpm=:bpm,"
+                "replaygain=:replaygain,"
+                "replaygain_peak=:replaygain_peak,"
+                "timesplayed=:timesplayed,"
+                "last_played_at=:last_played_at,"
+                "played=:played,"
+                "header_parsed=:header_parsed,"
+                "source_synchronized_ms=:source_synchronized_ms,"
+                "channels=:channels,"
+                "bitrate=:bitrate,"
+                "samplerate=:samplerate,"
+                "bitrate=:bitrate,"
+                "duration=:duration,"
+                "beats_version=:beats_version,"
+                "beats_sub_version=:beats_sub_version,"
+                "beats=:beats,"
+                "bpm_lock=:bpm_lock,"
+                "keys_version=:keys_version,"
+                "keys_sub_version=:keys_sub_version,"
+                "keys=:keys,"
+                "coverart_source=:coverart_source,"
+                "coverart_type=:coverart_type,"
+                "coverart_location=:coverart_location,"
+                "coverart_color=:coverart_color,"
+                "coverart_digest=:coverart_digest,"
+                "coverart_hash=:coverart_hash "
+                "WHERE id=:track_id");
+    }
+    QSqlQuery& query = *m_pQueryTrackUpdate;
 
     query.bindValue(":track_id", trackId.toVariant());
 
@@ -1730,7 +1949,9 @@ bool TrackDAO::updateTrack(const Track& track) const {
             track.getWaveformSummary());
     m_cueDao.saveTrackCues(
             trackId, track.getCuePoints());
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     //qDebug() << "Update track in database took: " << time.elapsed().formatMillisWithUnit();
     //time.start();
@@ -1842,6 +2063,59 @@ bool TrackDAO::detectMovedTracks(
         return true;
     }
 
+    // Successors with the same audio digest are preferred. They are
+    // identified by a single join, independent of their filename.
+    struct Successor {
+        TrackId trackId;
+        DbId locationId;
+        QString location;
+        int suffixMatch = 0;
+    };
+    QHash<TrackId, Successor> successorsByDigest;
+    {
+        QSqlQuery digestQuery(m_database);
+        digestQuery.prepare(QString(
+                "SELECT old_library.id AS old_track_id, "
+                "old_locations.location AS old_location, "
+                "new_library.id AS new_track_id, "
+                "new_locations.id AS new_location_id, "
+                "new_locations.location AS new_location "
+                "FROM library AS old_library "
+                "INNER JOIN track_locations AS old_locations "
+                "ON old_library.location=old_locations.id "
+                "INNER JOIN library AS new_library "
+                "ON new_library.audio_digest=old_library.audio_digest "
+                "INNER JOIN track_locations AS new_locations "
+                "ON new_library.location=new_locations.id "
+                "WHERE old_locations.fs_deleted=1 AND "
+                "new_locations.fs_deleted=0 AND "
+                "new_locations.location IN (%1)")
+                                    .arg(SqlStringFormatter::formatList(
+                                            m_database, addedTracks)));
+        VERIFY_OR_DEBUG_ASSERT(digestQuery.exec()) {
+            LOG_FAILED_QUERY(digestQuery);
+        }
+        while (digestQuery.next()) {
+            const auto oldTrackId = TrackId(digestQuery.value(0));
+            Successor successor;
+            successor.trackId = TrackId(digestQuery.value(2));
+            successor.locationId = DbId(digestQuery.value(3));
+            successor.location = digestQuery.value(4).toString();
+            successor.suffixMatch = matchStringSuffix(
+                    successor.location, digestQuery.value(1).toString());
+            // Identical files, e.g. copies, are disambiguated by their path
+            auto i = successorsByDigest.find(oldTrackId);
+            if (i == successorsByDigest.end()) {
+                successorsByDigest.insert(oldTrackId, successor);
+            } else if (i->suffixMatch < successor.suffixMatch) {
+                *i = successor;
+            }
+        }
+    }
+    // The successors by digest have been selected in advance and
+    // must not be used twice
+    QSet<TrackId> relocatedTrackIds;
+
     // Query possible successors
     // NOTE: Successors are identified by filename and duration (in seconds).
     // Since duration is stored as double-precision floating-point and since it
@@ -1849,7 +2123,7 @@ bool TrackDAO::detectMovedTracks(
     QSqlQuery newTrackQuery(m_database);
     newTrackQuery.prepare(QString(
             "SELECT library.id as track_id, track_locations.id as location_id, "
-            "track_locations.location "
+            "track_locations.location, library.audio_digest "
             "FROM library INNER JOIN track_locations ON library.location=track_locations.id "
             "WHERE track_locations.location IN (%1) AND "
             "filename=:filename AND "
@@ -1890,36 +2164,51 @@ bool TrackDAO::detectMovedTracks(
                 << "Looking for substitute of missing track location"
                 << oldTrackLocation;
 
-        newTrackQuery.bindValue(":filename", filename);
-        newTrackQuery.bindValue(":duration", duration);
-        VERIFY_OR_DEBUG_ASSERT(newTrackQuery.exec()) {
-            LOG_FAILED_QUERY(newTrackQuery);
-            continue;
-        }
-        const auto newTrackIdColumn = newTrackQuery.record().indexOf("track_id");
-        const auto newTrackLocationIdColumn = newTrackQuery.record().indexOf("location_id");
-        const auto newTrackLocationColumn = newTrackQuery.record().indexOf("location");
-        int newTrackLocationSuffixMatch = 0;
         TrackId newTrackId;
         DbId newTrackLocationId;
         QString newTrackLocation;
-        while (newTrackQuery.next()) {
-            const auto nextTrackLocation =
-                    newTrackQuery.value(newTrackLocationColumn).toString();
-            VERIFY_OR_DEBUG_ASSERT(nextTrackLocation != oldTrackLocation) {
+        QVariant newAudioDigest;
+        const auto successorByDigest = successorsByDigest.constFind(
+                TrackId(oldTrackQuery.value(oldTrackIdColumn)));
+        if (successorByDigest != successorsByDigest.constEnd() &&
+                !relocatedTrackIds.contains(successorByDigest->trackId)) {
+            kLogger.info()
+                    << "Found moved track location with the same audio digest:"
+                    << successorByDigest->location;
+            newTrackId = successorByDigest->trackId;
+            newTrackLocationId = successorByDigest->locationId;
+            newTrackLocation = successorByDigest->location;
+        } else {
+            newTrackQuery.bindValue(":filename", filename);
+            newTrackQuery.bindValue(":duration", duration);
+            VERIFY_OR_DEBUG_ASSERT(newTrackQuery.exec()) {
+                LOG_FAILED_QUERY(newTrackQuery);
                 continue;
             }
-            kLogger.info()
-                    << "Found potential moved track location:"
-                    << nextTrackLocation;
-            const auto nextSuffixMatch =
-                    matchStringSuffix(nextTrackLocation, oldTrackLocation);
-            DEBUG_ASSERT(nextSuffixMatch >= filename.length());
-            if (newTrackLocationSuffixMatch < nextSuffixMatch) {
-                newTrackLocationSuffixMatch = nextSuffixMatch;
-                newTrackId = TrackId(newTrackQuery.value(newTrackIdColumn));
-                newTrackLocationId = DbId(newTrackQuery.value(newTrackLocationIdColumn));
-                newTrackLocation = nextTrackLocation;
+            const auto newTrackIdColumn = newTrackQuery.record().indexOf("track_id");
+            const auto newTrackLocationIdColumn = newTrackQuery.record().indexOf("location_id");
+            const auto newTrackLocationColumn = newTrackQuery.record().indexOf("location");
+            const auto newAudioDigestColumn = newTrackQuery.record().indexOf("audio_digest");
+            int newTrackLocationSuffixMatch = 0;
+            while (newTrackQuery.next()) {
+                const auto nextTrackLocation =
+                        newTrackQuery.value(newTrackLocationColumn).toString();
+                VERIFY_OR_DEBUG_ASSERT(nextTrackLocation != oldTrackLocation) {
+                    continue;
+                }
+                kLogger.info()
+                        << "Found potential moved track location:"
+                        << nextTrackLocation;
+                const auto nextSuffixMatch =
+                        matchStringSuffix(nextTrackLocation, oldTrackLocation);
+                DEBUG_ASSERT(nextSuffixMatch >= filename.length());
+                if (newTrackLocationSuffixMatch < nextSuffixMatch) {
+                    newTrackLocationSuffixMatch = nextSuffixMatch;
+                    newTrackId = TrackId(newTrackQuery.value(newTrackIdColumn));
+                    newTrackLocationId = DbId(newTrackQuery.value(newTrackLocationIdColumn));
+                    newTrackLocation = nextTrackLocation;
+                    newAudioDigest = newTrackQuery.value(newAudioDigestColumn);
+                }
             }
         }
         if (newTrackLocation.isEmpty()) {
@@ -1976,8 +2265,12 @@ bool TrackDAO::detectMovedTracks(
         // table.
         {
             QSqlQuery query(m_database);
-            query.prepare("UPDATE library SET location=:newloc WHERE id=:oldid");
+            // The digest of the new file is kept, unless it is unknown
+            query.prepare(
+                    "UPDATE library SET location=:newloc, "
+                    "audio_digest=IFNULL(:digest,audio_digest) WHERE id=:oldid");
             query.bindValue(":newloc", newTrackLocationId.toVariant());
+            query.bindValue(":digest", newAudioDigest);
             query.bindValue(":oldid", relocatedTrack.updatedTrackRef().getId().toVariant());
             VERIFY_OR_DEBUG_ASSERT(query.exec()) {
                 LOG_FAILED_QUERY(query);
@@ -1994,6 +2287,7 @@ bool TrackDAO::detectMovedTracks(
             }
         }
 
+        relocatedTrackIds.insert(relocatedTrack.deletedTrackId());
         if (pRelocatedTracks) {
             pRelocatedTracks->append(std::move(relocatedTrack));
         }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QFileInfo>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QSet>
@@ -10,11 +11,13 @@
 #include "library/dao/dao.h"
 #include "library/relocatedtrack.h"
 #include "preferences/usersettings.h"
+#include "sources/soundsourceproxy.h"
 #include "track/globaltrackcache.h"
 #include "util/class.h"
 #include "util/memory.h"
 
 class FwdSqlQuery;
+class QSqlQuery;
 class SqlTransaction;
 class PlaylistDAO;
 class AnalysisDao;
@@ -65,8 +68,29 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
 
     // Returns a set of all track locations in the library.
     QSet<QString> getAllTrackLocations() const;
+    /// The source synchronization time stamps (milliseconds since epoch)
+    /// of all tracks in the library that have been synchronized with
+    /// their file
+    QHash<QString, qint64> getAllTrackSourceSynchronizedMillis() const;
     QString getTrackLocation(TrackId trackId) const;
 
+    /// A lightweight projection of the most commonly needed columns of
+    /// a track for callers that don't need a fully populated Track object.
+    struct TrackSummary {
+        TrackId id;
+        QString location;
+        QString artist;
+        QString title;
+        double durationSeconds = 0.0;
+        int timesPlayed = 0;
+    };
+    /// Reads the summaries of multiple tracks with a single query in the
+    /// order of the given ids, skipping those that don't exist. The values
+    /// are read directly from the database and do not reflect pending
+    /// modifications of cached Track objects that have not been saved yet.
+    QList<TrackSummary> getTrackSummariesByIds(
+            const QList<TrackId>& trackIds) const;
+
     // Only used by friend class LibraryScanner, but public for testing!
     bool detectMovedTracks(
             QList<RelocatedTrack>* pRelocatedTracks,
@@ -137,6 +161,14 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             const QString& location) const;
     TrackPointer getTrackById(
             TrackId trackId) const;
+    /// Loads the tracks with the given ids in that order, skipping those
+    /// that don't exist. Tracks that are not cached yet are loaded by
+    /// reusing a single prepared query.
+    QList<TrackPointer> getTracksByIds(
+            const QList<TrackId>& trackIds) const;
+    TrackPointer loadTrackById(
+            QSqlQuery* pSelectQuery,
+            TrackId trackId) const;
 
     // Loads a track from the database (by id if available, otherwise by location)
     // or adds it if not found in case the location is known. The (optional) out
@@ -148,18 +180,26 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             bool* pAlreadyInLibrary = nullptr);
 
     void addTracksPrepare();
+    /// Reads the metadata of the files in parallel and adds them in
+    /// batches while showing the progress.
+    void addMissingTracks(const QList<QString>& locations);
     TrackId addTracksAddTrack(
             const TrackPointer& pTrack,
             bool unremove);
+    /// The metadata of the file might optionally have been imported
+    /// in advance, e.g. on a different thread.
     TrackPointer addTracksAddFile(
             const mixxx::FileAccess& fileAccess,
-            bool unremove);
+            bool unremove,
+            const SoundSourceProxy::ImportedTrackMetadata* pImportedTrackMetadata = nullptr);
     TrackPointer addTracksAddFile(
             const QString& filePath,
-            bool unremove) {
+            bool unremove,
+            const SoundSourceProxy::ImportedTrackMetadata* pImportedTrackMetadata = nullptr) {
         return addTracksAddFile(
                 mixxx::FileAccess(mixxx::FileInfo(filePath)),
-                unremove);
+                unremove,
+                pImportedTrackMetadata);
     }
     void addTracksFinish(bool rollback = false);
 
@@ -212,6 +252,7 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     std::unique_ptr<QSqlQuery> m_pQueryLibraryInsert;
     std::unique_ptr<QSqlQuery> m_pQueryLibraryUpdate;
     std::unique_ptr<QSqlQuery> m_pQueryLibrarySelect;
+    mutable std::unique_ptr<QSqlQuery> m_pQueryTrackUpdate;
     std::unique_ptr<SqlTransaction> m_pTransaction;
     int m_trackLocationIdColumn;
     int m_queryLibraryIdColumn;
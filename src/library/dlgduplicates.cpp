@@ -0,0 +1,107 @@
+#include "library/dlgduplicates.h"
+
+#include "library/duplicatestablemodel.h"
+#include "library/trackcollectionmanager.h"
+#include "moc_dlgduplicates.cpp"
+#include "util/assert.h"
+#include "widget/wlibrary.h"
+#include "widget/wtracktableview.h"
+
+DlgDuplicates::DlgDuplicates(
+        WLibrary* parent,
+        UserSettingsPointer pConfig,
+        Library* pLibrary,
+        KeyboardEventFilter* pKeyboard)
+        : QWidget(parent),
+          Ui::DlgDuplicates(),
+          m_pTrackTableView(
+                  new WTrackTableView(
+                          this,
+                          pConfig,
+                          pLibrary,
+                          parent->getTrackTableBackgroundColorOpacity(),
+                          true)) {
+    setupUi(this);
+    m_pTrackTableView->installEventFilter(pKeyboard);
+
+    // Install our own trackTable
+    QBoxLayout* box = qobject_cast<QBoxLayout*>(layout());
+    VERIFY_OR_DEBUG_ASSERT(box) { //Assumes the form layout is a QVBox/QHBoxLayout!
+    } else {
+        box->removeWidget(m_pTrackTablePlaceholder);
+        m_pTrackTablePlaceholder->hide();
+        box->insertWidget(1, m_pTrackTableView);
+    }
+
+    m_pDuplicatesTableModel = new DuplicatesTableModel(this, pLibrary->trackCollectionManager());
+    m_pTrackTableView->loadTrackModel(m_pDuplicatesTableModel);
+
+    connect(btnHide, &QPushButton::clicked, m_pTrackTableView, &WTrackTableView::slotHide);
+    connect(btnHide, &QPushButton::clicked, this, &DlgDuplicates::clicked);
+    connect(btnSelect, &QPushButton::clicked, this, &DlgDuplicates::selectAll);
+    connect(m_pTrackTableView->selectionModel(),
+            &QItemSelectionModel::selectionChanged,
+            this,
+            &DlgDuplicates::selectionChanged);
+    connect(m_pTrackTableView, &WTrackTableView::trackSelected, this, &DlgDuplicates::trackSelected);
+
+    connect(pLibrary, &Library::setTrackTableFont, m_pTrackTableView, &WTrackTableView::setTrackTableFont);
+    connect(pLibrary, &Library::setTrackTableRowHeight, m_pTrackTableView, &WTrackTableView::setTrackTableRowHeight);
+    connect(pLibrary, &Library::setSelectedClick, m_pTrackTableView, &WTrackTableView::setSelectedClick);
+}
+
+DlgDuplicates::~DlgDuplicates() {
+    // Delete m_pTrackTableView before the table model. This is because the
+    // table view saves the header state using the model.
+    delete m_pTrackTableView;
+    delete m_pDuplicatesTableModel;
+}
+
+void DlgDuplicates::onShow() {
+    m_pDuplicatesTableModel->select();
+    activateButtons(false);
+}
+
+void DlgDuplicates::clicked() {
+    // Hidden tracks are not listed anymore and their duplicates might
+    // have become unique
+    onShow();
+}
+
+void DlgDuplicates::onSearch(const QString& text) {
+    m_pDuplicatesTableModel->search(text);
+}
+
+QString DlgDuplicates::currentSearch() {
+    return m_pDuplicatesTableModel->currentSearch();
+}
+
+void DlgDuplicates::selectAll() {
+    m_pTrackTableView->selectAll();
+}
+
+void DlgDuplicates::activateButtons(bool enable) {
+    btnHide->setEnabled(enable);
+}
+
+void DlgDuplicates::selectionChanged(const QItemSelection& selected,
+        const QItemSelection& deselected) {
+    Q_UNUSED(deselected);
+    activateButtons(!selected.indexes().isEmpty());
+}
+
+bool DlgDuplicates::hasFocus() const {
+    return m_pTrackTableView->hasFocus();
+}
+
+void DlgDuplicates::saveCurrentViewState() {
+    m_pTrackTableView->saveCurrentViewState();
+};
+
+bool DlgDuplicates::restoreCurrentViewState() {
+    return m_pTrackTableView->restoreCurrentViewState();
+};
+
+void DlgDuplicates::setFocus() {
+    m_pTrackTableView->setFocus();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QItemSelection>
+
+#include "controllers/keyboard/keyboardeventfilter.h"
+#include "library/library.h"
+#include "library/libraryview.h"
+#include "library/ui_dlgduplicates.h"
+#include "preferences/usersettings.h"
+
+class WLibrary;
+class WTrackTableView;
+class DuplicatesTableModel;
+
+class DlgDuplicates : public QWidget, public Ui::DlgDuplicates, public LibraryView {
+    Q_OBJECT
+
+  public:
+    DlgDuplicates(WLibrary* parent,
+            UserSettingsPointer pConfig,
+            Library* pLibrary,
+            KeyboardEventFilter* pKeyboard);
+    ~DlgDuplicates() override;
+
+    void onShow() override;
+    bool hasFocus() const override;
+    void setFocus() override;
+    void onSearch(const QString& text) override;
+    QString currentSearch();
+    void saveCurrentViewState() override;
+    bool restoreCurrentViewState() override;
+
+  public slots:
+    void clicked();
+    void selectAll();
+    void selectionChanged(const QItemSelection&, const QItemSelection&);
+
+  signals:
+    void trackSelected(TrackPointer pTrack);
+
+  private:
+    void activateButtons(bool enable);
+    WTrackTableView* m_pTrackTableView;
+    DuplicatesTableModel* m_pDuplicatesTableModel;
+};
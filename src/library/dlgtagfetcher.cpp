@@ -4,7 +4,9 @@
 #include <QtDebug>
 
 #include "defs_urls.h"
+#include "library/dao/analysisdao.h"
 #include "moc_dlgtagfetcher.cpp"
+#include "musicbrainz/chromaprinter.h"
 #include "track/track.h"
 #include "track/tracknumbers.h"
 
@@ -57,11 +59,13 @@ void addTrack(
 } // anonymous namespace
 
 DlgTagFetcher::DlgTagFetcher(
-        const TrackModel* pTrackModel)
+        const TrackModel* pTrackModel,
+        AnalysisDao* pAnalysisDao)
         // No parent because otherwise it inherits the style parent's
         // style which can make it unreadable. Bug #673411
         : QDialog(nullptr),
           m_pTrackModel(pTrackModel),
+          m_pAnalysisDao(pAnalysisDao),
           m_tagFetcher(this),
           m_networkResult(NetworkResult::Ok) {
     init();
@@ -124,7 +128,12 @@ void DlgTagFetcher::loadTrackInternal(const TrackPointer& track) {
             this,
             &DlgTagFetcher::slotTrackChanged);
 
-    m_tagFetcher.startFetch(m_track);
+    QString fingerprint;
+    if (m_pAnalysisDao) {
+        fingerprint = QString::fromLatin1(m_pAnalysisDao->loadAnalysisFingerprint(
+                m_track->getId(), ChromaPrinter::fingerprintVersion()));
+    }
+    m_tagFetcher.startFetch(m_track, fingerprint);
 
     updateStack();
 }
@@ -9,6 +9,8 @@
 #include "musicbrainz/tagfetcher.h"
 #include "track/track_decl.h"
 
+class AnalysisDao;
+
 /// A dialog box to fetch track metadata from MusicBrainz.
 /// Use TrackPointer to load a track into the dialog or
 /// QModelIndex along with TrackModel to enable previous and next buttons
@@ -18,8 +20,11 @@ class DlgTagFetcher : public QDialog, public Ui::DlgTagFetcher {
 
   public:
     // TODO: Remove dependency on TrackModel
+    /// Fingerprints that have been stored by the analysis are loaded
+    /// from the optional AnalysisDao.
     explicit DlgTagFetcher(
-            const TrackModel* pTrackModel = nullptr);
+            const TrackModel* pTrackModel = nullptr,
+            AnalysisDao* pAnalysisDao = nullptr);
     ~DlgTagFetcher() override = default;
 
     void init();
@@ -51,6 +56,7 @@ class DlgTagFetcher : public QDialog, public Ui::DlgTagFetcher {
     void addDivider(const QString& text, QTreeWidget* parent) const;
 
     const TrackModel* const m_pTrackModel;
+    AnalysisDao* const m_pAnalysisDao;
 
     TagFetcher m_tagFetcher;
 
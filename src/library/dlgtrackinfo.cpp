@@ -39,12 +39,14 @@ const mixxx::Duration kMaxInterval = mixxx::Duration::fromMillis(
 
 DlgTrackInfo::DlgTrackInfo(
         UserSettingsPointer pUserSettings,
-        const TrackModel* trackModel)
+        const TrackModel* trackModel,
+        AnalysisDao* pAnalysisDao)
         // No parent because otherwise it inherits the style parent's
         // style which can make it unreadable. Bug #673411
         : QDialog(nullptr),
           m_pUserSettings(std::move(pUserSettings)),
           m_pTrackModel(trackModel),
+          m_pAnalysisDao(pAnalysisDao),
           m_tapFilter(this, kFilterLength, kMaxInterval),
           m_pWCoverArtMenu(make_parented<WCoverArtMenu>(this)),
           m_pWCoverArtLabel(make_parented<WCoverArtLabel>(this, m_pWCoverArtMenu)),
@@ -703,7 +705,7 @@ void DlgTrackInfo::slotTrackChanged(TrackId trackId) {
 void DlgTrackInfo::slotImportMetadataFromMusicBrainz() {
     if (!m_pDlgTagFetcher) {
         m_pDlgTagFetcher = std::make_unique<DlgTagFetcher>(
-                m_pTrackModel);
+                m_pTrackModel, m_pAnalysisDao);
         connect(m_pDlgTagFetcher.get(),
                 &QDialog::finished,
                 this,
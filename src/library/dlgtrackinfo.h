@@ -14,6 +14,8 @@
 #include "util/parented_ptr.h"
 #include "util/tapfilter.h"
 
+class AnalysisDao;
+
 class TrackModel;
 class DlgTagFetcher;
 class WCoverArtLabel;
@@ -30,7 +32,8 @@ class DlgTrackInfo : public QDialog, public Ui::DlgTrackInfo {
     // TODO: Remove dependency on TrackModel
     explicit DlgTrackInfo(
             UserSettingsPointer pUserSettings,
-            const TrackModel* trackModel = nullptr);
+            const TrackModel* trackModel = nullptr,
+            AnalysisDao* pAnalysisDao = nullptr);
     ~DlgTrackInfo() override = default;
 
   public slots:
@@ -106,6 +109,7 @@ class DlgTrackInfo : public QDialog, public Ui::DlgTrackInfo {
     const UserSettingsPointer m_pUserSettings;
 
     const TrackModel* const m_pTrackModel;
+    AnalysisDao* const m_pAnalysisDao;
 
     TrackPointer m_pLoadedTrack;
 
@@ -0,0 +1,121 @@
+#include "library/duplicatestablemodel.h"
+
+#include "library/dao/analysisdao.h"
+#include "library/dao/trackschema.h"
+#include "library/queryutil.h"
+#include "library/trackcollection.h"
+#include "library/trackcollectionmanager.h"
+#include "moc_duplicatestablemodel.cpp"
+
+namespace {
+
+const QString kModelName = "duplicates:";
+
+// Different encodings of the same recording might differ in length,
+// e.g. due to encoder delay or padding
+constexpr int kMaxDurationDifferenceSeconds = 2;
+
+} // anonymous namespace
+
+DuplicatesTableModel::DuplicatesTableModel(QObject* parent,
+        TrackCollectionManager* pTrackCollectionManager)
+        : BaseSqlTableModel(parent, pTrackCollectionManager, "mixxx.db.model.duplicates") {
+    setTableModel();
+}
+
+DuplicatesTableModel::~DuplicatesTableModel() {
+}
+
+void DuplicatesTableModel::setTableModel() {
+    const QString tableName("duplicate_songs");
+
+    QStringList columns;
+    columns << "library." + LIBRARYTABLE_ID;
+
+    // The expressions for comparing artist and title must match those of
+    // the index idx_library_artist_title exactly.
+    QSqlQuery query(m_database);
+    query.prepare(
+            QStringLiteral(
+                    "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS "
+                    "SELECT %2 FROM library "
+                    "INNER JOIN track_locations "
+                    "ON library.location=track_locations.id "
+                    "WHERE library.mixxx_deleted=0 AND ("
+                    "(trim(library.title)<>'' AND EXISTS ("
+                    "SELECT 1 FROM library AS other "
+                    "WHERE lower(trim(other.artist))=lower(trim(library.artist)) "
+                    "AND lower(trim(other.title))=lower(trim(library.title)) "
+                    "AND other.id<>library.id "
+                    "AND other.mixxx_deleted=0 "
+                    "AND abs(other.duration-library.duration)<=%3)) "
+                    "OR EXISTS ("
+                    "SELECT 1 FROM %4 AS fingerprint "
+                    "INNER JOIN %4 AS other "
+                    "ON other.type=fingerprint.type "
+                    "AND other.data_key=fingerprint.data_key "
+                    "AND other.track_id<>fingerprint.track_id "
+                    "INNER JOIN library AS other_library "
+                    "ON other_library.id=other.track_id "
+                    "AND other_library.mixxx_deleted=0 "
+                    "WHERE fingerprint.track_id=library.id "
+                    "AND fingerprint.type=%5 "
+                    "AND fingerprint.data_key IS NOT NULL))")
+                    .arg(tableName,
+                            columns.join(","),
+                            QString::number(kMaxDurationDifferenceSeconds),
+                            AnalysisDao::s_analysisTableName,
+                            QString::number(AnalysisDao::TYPE_FINGERPRINT)));
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+
+    QStringList tableColumns;
+    tableColumns << LIBRARYTABLE_ID;
+    setTable(tableName,
+            LIBRARYTABLE_ID,
+            tableColumns,
+            m_pTrackCollectionManager->internalCollection()->getTrackSource());
+    // Duplicates are listed next to each other
+    setDefaultSort(fieldIndex("title"), Qt::AscendingOrder);
+    setSearch("");
+}
+
+bool DuplicatesTableModel::isColumnInternal(int column) {
+    return column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ID) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_PLAYED) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM_LOCK) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_MIXXXDELETED) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY_ID) ||
+            column == fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_FSDELETED) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_SOURCE) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_TYPE) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_LOCATION) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_COLOR) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_DIGEST) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_HASH);
+}
+
+// Override flags from BaseSqlModel since we don't want edit this model
+Qt::ItemFlags DuplicatesTableModel::flags(const QModelIndex& index) const {
+    return readOnlyFlags(index);
+}
+
+TrackModel::Capabilities DuplicatesTableModel::getCapabilities() const {
+    return Capability::AddToTrackSet |
+            Capability::AddToAutoDJ |
+            Capability::LoadToDeck |
+            Capability::LoadToSampler |
+            Capability::LoadToPreviewDeck |
+            Capability::Hide |
+            Capability::RemoveFromDisk;
+}
+
+QString DuplicatesTableModel::modelKey(bool noSearch) const {
+    if (noSearch) {
+        return kModelName + m_tableName;
+    }
+    return kModelName + m_tableName +
+            QStringLiteral("#") +
+            currentSearch();
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "library/basesqltablemodel.h"
+#include "library/trackmodel.h"
+
+/// Lists all visible tracks that have at least one duplicate in the
+/// library, i.e. another track with the same artist and title and nearly
+/// the same duration, or with the same audio fingerprint.
+/// Both criteria are looked up through indices, so refreshing the list
+/// doesn't need to compare all pairs of tracks.
+class DuplicatesTableModel final : public BaseSqlTableModel {
+    Q_OBJECT
+  public:
+    DuplicatesTableModel(QObject* parent, TrackCollectionManager* pTrackCollectionManager);
+    ~DuplicatesTableModel() final;
+
+    void setTableModel();
+
+    bool isColumnInternal(int column) final;
+    Qt::ItemFlags flags(const QModelIndex& index) const final;
+    Capabilities getCapabilities() const final;
+
+    QString modelKey(bool noSearch) const override;
+};
@@ -2,7 +2,10 @@
 
 #include <QHash>
 #include <QMetaMethod>
+#include <QScopeGuard>
 #include <QStringList>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 #include <QtGlobal>
 #include <array>
 #include <chrono>
@@ -74,8 +77,29 @@ std::optional<djinterop::musical_key> toDjinteropKey(
     return keyMap[key];
 }
 
+// Copying to the typically slow removable destination is I/O bound. A second
+// copy keeps the device busy while the next source file is being opened.
+constexpr int kMaxConcurrentFileCopies = 2;
+
+bool copyFile(const QString& srcPath, const QString& dstPath) {
+    // QFile::copy() never overwrites an existing file
+    if (QFile::exists(dstPath) && !QFile::remove(dstPath)) {
+        qWarning() << "Failed to remove outdated file" << dstPath;
+        return false;
+    }
+    if (!QFile::copy(srcPath, dstPath)) {
+        qWarning() << "Failed to copy" << srcPath << "to" << dstPath;
+        return false;
+    }
+    return true;
+}
+
+/// Returns the path of the exported file relative to the database. The file
+/// is copied on the thread pool and the copy is appended to pCopies.
 QString exportFile(const QSharedPointer<EnginePrimeExportRequest> pRequest,
-        TrackPointer pTrack) {
+        TrackPointer pTrack,
+        QThreadPool* pCopyThreadPool,
+        QList<QFuture<bool>>* pCopies) {
     if (!pRequest->engineLibraryDbDir.exists()) {
         const auto msg = QStringLiteral(
                 "Engine Library DB directory %1 has been removed from disk!")
@@ -96,10 +120,14 @@ QString exportFile(const QSharedPointer<EnginePrimeExportRequest> pRequest,
     const auto trackId = pTrack->getId().value();
     QString dstFilename = QString::number(trackId) + " - " + srcFileInfo.fileName();
     QString dstPath = pRequest->musicFilesDir.filePath(dstFilename);
-    if (!QFile::exists(dstPath) ||
-            srcFileInfo.lastModified() > QFileInfo{dstPath}.lastModified()) {
+    const QFileInfo dstFileInfo{dstPath};
+    if (!dstFileInfo.exists() ||
+            srcFileInfo.sizeInBytes() != dstFileInfo.size() ||
+            srcFileInfo.lastModified() > dstFileInfo.lastModified()) {
         const auto srcPath = srcFileInfo.location();
-        QFile::copy(srcPath, dstPath);
+        pCopies->append(QtConcurrent::run(pCopyThreadPool, [srcPath, dstPath] {
+            return copyFile(srcPath, dstPath);
+        }));
     }
 
     return pRequest->engineLibraryDbDir.relativeFilePath(dstPath);
@@ -341,7 +369,9 @@ void exportTrack(
         djinterop::database* pDatabase,
         QHash<TrackId, int64_t>* pMixxxToEnginePrimeTrackIdMap,
         const TrackPointer pTrack,
-        const Waveform* pWaveform) {
+        const Waveform* pWaveform,
+        QThreadPool* pCopyThreadPool,
+        QList<QFuture<bool>>* pCopies) {
     // Only export supported file types.
     if (!kSupportedFileTypes.contains(pTrack->getType())) {
         qInfo() << "Skipping file" << pTrack->getFileInfo().fileName()
@@ -351,7 +381,8 @@ void exportTrack(
     }
 
     // Copy the file, if required.
-    const auto musicFileRelativePath = exportFile(pRequest, pTrack);
+    const auto musicFileRelativePath = exportFile(
+            pRequest, pTrack, pCopyThreadPool, pCopies);
 
     // Export meta-data.
     exportMetadata(pDatabase,
@@ -539,6 +570,16 @@ void EnginePrimeExportJob::run() {
     // We will build up a map from Mixxx track id to EL track id during export.
     QHash<TrackId, int64_t> mixxxToEnginePrimeTrackIdMap;
 
+    // The music files are copied in the background, while the metadata of
+    // the following tracks is exported.
+    QThreadPool copyThreadPool;
+    copyThreadPool.setMaxThreadCount(kMaxConcurrentFileCopies);
+    QList<QFuture<bool>> copies;
+    // Do not start any pending copies when returning early
+    const auto cancelCopies = qScopeGuard([&copyThreadPool] {
+        copyThreadPool.clear();
+    });
+
     for (const auto& trackRef : qAsConst(m_trackRefs)) {
         // Load each track.
         // Note that loading must happen on the same thread as the track collection
@@ -563,7 +604,9 @@ void EnginePrimeExportJob::run() {
                     pDb.get(),
                     &mixxxToEnginePrimeTrackIdMap,
                     m_pLastLoadedTrack,
-                    m_pLastLoadedWaveform.get());
+                    m_pLastLoadedWaveform.get(),
+                    &copyThreadPool,
+                    &copies);
         } catch (std::exception& e) {
             qWarning() << "Failed to export track"
                        << m_pLastLoadedTrack->getId().value() << ":"
@@ -654,6 +697,18 @@ void EnginePrimeExportJob::run() {
         emit jobProgress(currProgress);
     }
 
+    for (auto& copy : copies) {
+        if (m_cancellationRequested.loadAcquire() != 0) {
+            qInfo() << "Cancelling export";
+            return;
+        }
+        if (!copy.result()) {
+            m_lastErrorMessage = tr("Failed to copy a music file to the export directory");
+            emit failed(m_lastErrorMessage);
+            return;
+        }
+    }
+
     qInfo() << "Engine Prime Export Job completed successfully";
     emit completed(m_trackRefs.size(), m_crateIds.size());
 }
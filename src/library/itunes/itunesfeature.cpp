@@ -1,6 +1,7 @@
 #include "library/itunes/itunesfeature.h"
 
 #include <QAction>
+#include <QDateTime>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QMenu>
@@ -30,6 +31,9 @@
 namespace {
 
 const QString ITDB_PATH_KEY = "mixxx.itunesfeature.itdbpath";
+// The path and modification time of the XML file that has been imported
+// completely into the iTunes tables
+const QString ITDB_IMPORTED_KEY = "mixxx.itunesfeature.itdbimported";
 
 const QString kDict = "dict";
 const QString kKey = "key";
@@ -51,6 +55,11 @@ const QString kRating = "Rating";
 const QString kTrackType = "Track Type";
 const QString kRemote = "Remote";
 
+QString importedLibraryStamp(const QString& dbfile) {
+    return QString::number(QFileInfo(dbfile).lastModified().toMSecsSinceEpoch()) +
+            QChar(':') + dbfile;
+}
+
 QString localhost_token() {
 #if defined(__WINDOWS__)
     return "//localhost/";
@@ -166,14 +175,6 @@ void ITunesFeature::activate() {
 void ITunesFeature::activate(bool forceReload) {
     //qDebug("ITunesFeature::activate()");
     if (!m_isActivated || forceReload) {
-
-        //Delete all table entries of iTunes feature
-        ScopedTransaction transaction(m_database);
-        clearTable("itunes_playlist_tracks");
-        clearTable("itunes_library");
-        clearTable("itunes_playlists");
-        transaction.commit();
-
         emit showTrackModel(m_pITunesTrackModel);
 
         SettingsDAO settings(m_pTrackCollection->database());
@@ -199,6 +200,7 @@ void ITunesFeature::activate(bool forceReload) {
                     nullptr, tr("Select your iTunes library"), QDir::homePath(), "*.xml");
             mixxx::FileInfo fileInfo(m_dbfile);
             if (!fileInfo.checkFileExists()) {
+                clearTables();
                 return;
             }
 
@@ -211,6 +213,18 @@ void ITunesFeature::activate(bool forceReload) {
             settings.setValue(ITDB_PATH_KEY, m_dbfile);
         }
         m_isActivated =  true;
+
+        // The tables are kept between sessions. They only need to be
+        // imported again if the XML file has been modified since.
+        m_importStamp = importedLibraryStamp(m_dbfile);
+        if (!forceReload &&
+                settings.getValue(ITDB_IMPORTED_KEY) == m_importStamp &&
+                loadImportedPlaylists()) {
+            emit enableCoverArtDisplay(false);
+            return;
+        }
+
+        clearTables();
         // Let a worker thread do the XML parsing
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
         m_future = QtConcurrent::run(&ITunesFeature::importLibrary, this);
@@ -441,6 +455,10 @@ TreeItem* ITunesFeature::importLibrary() {
         }
     }
 
+    if (!xml.hasError() && !m_cancelImport && playlist_root) {
+        SettingsDAO(m_database).setValue(ITDB_IMPORTED_KEY, m_importStamp);
+    }
+
     // Even if an error occurred, commit the transaction. The file may have been
     // half-parsed.
     transaction.commit();
@@ -802,6 +820,34 @@ void ITunesFeature::parsePlaylist(QXmlStreamReader& xml, QSqlQuery& query_insert
     }
 }
 
+void ITunesFeature::clearTables() {
+    // Delete all table entries of iTunes feature
+    ScopedTransaction transaction(m_database);
+    SettingsDAO(m_database).setValue(ITDB_IMPORTED_KEY, QString());
+    clearTable("itunes_playlist_tracks");
+    clearTable("itunes_library");
+    clearTable("itunes_playlists");
+    transaction.commit();
+}
+
+bool ITunesFeature::loadImportedPlaylists() {
+    QSqlQuery query(m_database);
+    query.prepare("SELECT name FROM itunes_playlists ORDER BY id");
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    std::unique_ptr<TreeItem> pRootItem = TreeItem::newRoot(this);
+    while (query.next()) {
+        pRootItem->appendChild(query.value(0).toString());
+    }
+    qDebug() << "Using the iTunes library imported from" << m_dbfile;
+    m_pSidebarModel->setRootItem(std::move(pRootItem));
+    m_trackSource->buildIndex();
+    emit showTrackModel(m_pITunesTrackModel);
+    return true;
+}
+
 void ITunesFeature::clearTable(const QString& table_name) {
     QSqlQuery query(m_database);
     query.prepare("delete from "+table_name);
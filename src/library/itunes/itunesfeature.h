@@ -47,7 +47,10 @@ class ITunesFeature : public BaseExternalLibraryFeature {
     TreeItem* parsePlaylists(QXmlStreamReader &xml);
     void parsePlaylist(QXmlStreamReader& xml, QSqlQuery& query1,
                        QSqlQuery &query2, TreeItem*);
+    void clearTables();
     void clearTable(const QString& table_name);
+    /// Builds the sidebar from the tables of a previous import
+    bool loadImportedPlaylists();
     bool readNextStartElement(QXmlStreamReader& xml);
 
     BaseExternalTrackModel* m_pITunesTrackModel;
@@ -59,6 +62,8 @@ class ITunesFeature : public BaseExternalLibraryFeature {
     bool m_cancelImport;
     bool m_isActivated;
     QString m_dbfile;
+    // Stored when the import of m_dbfile has finished
+    QString m_importStamp;
 
     QFutureWatcher<TreeItem*> m_future_watcher;
     QFuture<TreeItem*> m_future;
@@ -4,8 +4,15 @@
 
 #include "moc_locationdelegate.cpp"
 
+namespace {
+
+constexpr int kElidedTextCacheSize = 1000;
+
+} // anonymous namespace
+
 LocationDelegate::LocationDelegate(QTableView* pTableView)
-        : TableItemDelegate(pTableView) {
+        : TableItemDelegate(pTableView),
+          m_elidedTextCache(kElidedTextCacheSize) {
 }
 
 void LocationDelegate::paintItem(
@@ -21,9 +28,19 @@ void LocationDelegate::paintItem(
         // }
         painter->setPen(QPen(option.palette.highlightedText().color()));
     }
-    QString elidedText = option.fontMetrics.elidedText(
-            index.data().toString(),
-            Qt::ElideLeft,
-            columnWidth(index));
-    painter->drawText(option.rect, Qt::AlignVCenter, elidedText);
+    const QString location = index.data().toString();
+    const int width = columnWidth(index);
+    // The font is part of the key because the font of the table view may be
+    // changed by the library font preferences.
+    const QString key = QString::number(width) + QChar('|') +
+            option.font.key() + QChar('|') + location;
+    QString* pElidedText = m_elidedTextCache.object(key);
+    if (!pElidedText) {
+        pElidedText = new QString(option.fontMetrics.elidedText(
+                location,
+                Qt::ElideLeft,
+                width));
+        m_elidedTextCache.insert(key, pElidedText);
+    }
+    painter->drawText(option.rect, Qt::AlignVCenter, *pElidedText);
 }
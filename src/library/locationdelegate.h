@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QCache>
+
 #include "library/tableitemdelegate.h"
 
 
@@ -13,4 +15,9 @@ class LocationDelegate : public TableItemDelegate {
             QPainter* painter,
             const QStyleOptionViewItem& option,
             const QModelIndex& index) const override;
+
+  private:
+    // Eliding long paths is expensive, so the elided text is cached by the
+    // path and the column width
+    mutable QCache<QString, QString> m_elidedTextCache;
 };
@@ -7,6 +7,7 @@
 
 #include "library/basetrackcache.h"
 #include "library/dao/trackschema.h"
+#include "library/dlgduplicates.h"
 #include "library/dlghidden.h"
 #include "library/dlgmissing.h"
 #include "library/hiddentablemodel.h"
@@ -72,11 +73,13 @@ MixxxLibraryFeature::MixxxLibraryFeature(Library* pLibrary,
         : LibraryFeature(pLibrary, pConfig, QStringLiteral("tracks")),
           kMissingTitle(tr("Missing Tracks")),
           kHiddenTitle(tr("Hidden Tracks")),
+          kDuplicatesTitle(tr("Duplicate Tracks")),
           m_pTrackCollection(pLibrary->trackCollectionManager()->internalCollection()),
           m_pLibraryTableModel(nullptr),
           m_pSidebarModel(make_parented<TreeItemModel>(this)),
           m_pMissingView(nullptr),
-          m_pHiddenView(nullptr) {
+          m_pHiddenView(nullptr),
+          m_pDuplicatesView(nullptr) {
     QStringList columns = DEFAULT_COLUMNS;
     QStringList qualifiedTableColumns;
     for (const auto& col : columns) {
@@ -109,6 +112,7 @@ MixxxLibraryFeature::MixxxLibraryFeature(Library* pLibrary,
     std::unique_ptr<TreeItem> pRootItem = TreeItem::newRoot(this);
     pRootItem->appendChild(kMissingTitle);
     pRootItem->appendChild(kHiddenTitle);
+    pRootItem->appendChild(kDuplicatesTitle);
 
     m_pSidebarModel->setRootItem(std::move(pRootItem));
 
@@ -138,6 +142,13 @@ void MixxxLibraryFeature::bindLibraryWidget(WLibrary* pLibraryWidget,
             &DlgMissing::trackSelected,
             this,
             &MixxxLibraryFeature::trackSelected);
+
+    m_pDuplicatesView = new DlgDuplicates(pLibraryWidget, m_pConfig, m_pLibrary, pKeyboard);
+    pLibraryWidget->registerView(kDuplicatesTitle, m_pDuplicatesView);
+    connect(m_pDuplicatesView,
+            &DlgDuplicates::trackSelected,
+            this,
+            &MixxxLibraryFeature::trackSelected);
 }
 
 QVariant MixxxLibraryFeature::title() {
@@ -158,6 +169,9 @@ void MixxxLibraryFeature::refreshLibraryModels() {
     if (m_pHiddenView) {
         m_pHiddenView->onShow();
     }
+    if (m_pDuplicatesView) {
+        m_pDuplicatesView->onShow();
+    }
 }
 
 void MixxxLibraryFeature::searchAndActivate(const QString& query) {
@@ -190,6 +204,8 @@ void MixxxLibraryFeature::activateChild(const QModelIndex& index) {
         emit restoreSearch(m_pMissingView->currentSearch());
     } else if (m_pHiddenView && itemName == kHiddenTitle) {
         emit restoreSearch(m_pHiddenView->currentSearch());
+    } else if (m_pDuplicatesView && itemName == kDuplicatesTitle) {
+        emit restoreSearch(m_pDuplicatesView->currentSearch());
     }
     emit enableCoverArtDisplay(true);
 }
@@ -18,6 +18,7 @@
 #include "preferences/usersettings.h"
 #include "util/parented_ptr.h"
 
+class DlgDuplicates;
 class DlgHidden;
 class DlgMissing;
 class BaseTrackCache;
@@ -68,6 +69,7 @@ class MixxxLibraryFeature final : public LibraryFeature {
   private:
     const QString kMissingTitle;
     const QString kHiddenTitle;
+    const QString kDuplicatesTitle;
     TrackCollection* const m_pTrackCollection;
 
     QSharedPointer<BaseTrackCache> m_pBaseTrackCache;
@@ -77,6 +79,7 @@ class MixxxLibraryFeature final : public LibraryFeature {
 
     DlgMissing* m_pMissingView;
     DlgHidden* m_pHiddenView;
+    DlgDuplicates* m_pDuplicatesView;
 
 #ifdef __ENGINEPRIME__
     parented_ptr<QAction> m_pExportLibraryAction;
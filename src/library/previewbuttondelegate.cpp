@@ -130,23 +130,26 @@ void PreviewButtonDelegate::paintItem(QPainter* painter,
         return;
     }
 
-    // We only need m_pButton to have the right width/height, since we are
-    // calling its render method directly. Every resize/translate of a widget
-    // causes Qt to flush the backing store, so we need to avoid this whenever
-    // possible.
-    if (option.rect.size() != m_pButton->size()) {
-        m_pButton->setFixedSize(option.rect.size());
-    }
-
-    // Update check state
-    m_pButton->setChecked(isTrackLoadedInPreviewDeckAndPlaying(index));
-
-    // Render button at the desired position.
-    painter->translate(option.rect.topLeft());
-
-    // Avoid QWidget::render and call the equivalent of QPushButton::paintEvent
-    // directly.
-    m_pButton->paint(painter);
+    // The button of all rows looks the same besides the check state, so only
+    // two pixmaps need to be rendered for each cell size.
+    const bool checked = isTrackLoadedInPreviewDeckAndPlaying(index);
+    drawCachedCellPixmap(painter,
+            option.rect,
+            checked ? QStringLiteral("preview|checked") : QStringLiteral("preview"),
+            [this, checked](QPainter* pPixmapPainter, const QRect& rect) {
+                // We only need m_pButton to have the right width/height, since
+                // we are calling its render method directly. Every
+                // resize/translate of a widget causes Qt to flush the backing
+                // store, so we need to avoid this whenever possible.
+                if (rect.size() != m_pButton->size()) {
+                    m_pButton->setFixedSize(rect.size());
+                }
+                // Update check state
+                m_pButton->setChecked(checked);
+                // Avoid QWidget::render and call the equivalent of
+                // QPushButton::paintEvent directly.
+                m_pButton->paint(pPixmapPainter);
+            });
 }
 
 void PreviewButtonDelegate::updateEditorGeometry(QWidget* editor,
@@ -3,6 +3,8 @@
 #include <QtDebug>
 #include <QtSql>
 
+#include "util/db/sqlwritebatch.h"
+
 
 #define LOG_FAILED_QUERY(query) qWarning() << __FILE__ << __LINE__ << "FAILED QUERY [" \
     << (query).executedQuery() << "]" << (query).lastError()
@@ -31,6 +33,8 @@ class ScopedTransaction {
                      << m_database.connectionName();
             return false;
         }
+        // Transactions could not be nested
+        SqlWriteBatch::flush(m_database);
         m_active = m_database.transaction();
         return m_active;
     }
@@ -1,5 +1,7 @@
 #include "library/rhythmbox/rhythmboxfeature.h"
 
+#include <QDateTime>
+#include <QFileInfo>
 #include <QMessageBox>
 #include <QStringList>
 #include <QUrl>
@@ -7,6 +9,7 @@
 
 #include "library/baseexternalplaylistmodel.h"
 #include "library/baseexternaltrackmodel.h"
+#include "library/dao/settingsdao.h"
 #include "library/library.h"
 #include "library/queryutil.h"
 #include "library/trackcollection.h"
@@ -14,6 +17,36 @@
 #include "library/treeitem.h"
 #include "moc_rhythmboxfeature.cpp"
 
+namespace {
+
+// The path and modification time of the XML files that have been imported
+// completely into the Rhythmbox tables
+const QString kLibraryImportedKey = "mixxx.rhythmboxfeature.libraryimported";
+const QString kPlaylistsImportedKey = "mixxx.rhythmboxfeature.playlistsimported";
+
+// Try and find the Rhythmbox files. An API call which tells us where
+// the file is would be nice.
+QString findRhythmboxFile(const QString& fileName) {
+    QString filePath = QDir::homePath() + "/.gnome2/rhythmbox/" + fileName;
+    if (!QFile::exists(filePath)) {
+        filePath = QDir::homePath() + "/.local/share/rhythmbox/" + fileName;
+        if (!QFile::exists(filePath)) {
+            return QString();
+        }
+    }
+    return filePath;
+}
+
+QString importedFileStamp(const QString& filePath) {
+    if (filePath.isEmpty()) {
+        return QString();
+    }
+    return QString::number(QFileInfo(filePath).lastModified().toMSecsSinceEpoch()) +
+            QChar(':') + filePath;
+}
+
+} // anonymous namespace
+
 RhythmboxFeature::RhythmboxFeature(Library* pLibrary, UserSettingsPointer pConfig)
         : BaseExternalLibraryFeature(pLibrary, pConfig, QStringLiteral("rhythmbox")),
           m_pSidebarModel(make_parented<TreeItemModel>(this)),
@@ -58,7 +91,8 @@ RhythmboxFeature::RhythmboxFeature(Library* pLibrary, UserSettingsPointer pConfi
             "rhythmbox_playlist_tracks",
             m_trackSource);
 
-    m_isActivated =  false;
+    m_isActivated = false;
+    m_importLibrary = true;
     m_title = tr("Rhythmbox");
 
     m_database =
@@ -116,7 +150,26 @@ void RhythmboxFeature::activate() {
     qDebug() << "RhythmboxFeature::activate()";
 
     if (!m_isActivated) {
-        m_isActivated =  true;
+        m_isActivated = true;
+
+        // The tables are kept between sessions. They only need to be
+        // imported again if the XML files have been modified since. The
+        // playlists refer to the tracks, i.e. they are imported again
+        // whenever the tracks are imported.
+        SettingsDAO settings(m_pTrackCollection->database());
+        m_libraryImportStamp = importedFileStamp(findRhythmboxFile("rhythmdb.xml"));
+        m_playlistsImportStamp = importedFileStamp(findRhythmboxFile("playlists.xml"));
+        m_importLibrary = m_libraryImportStamp.isEmpty() ||
+                settings.getValue(kLibraryImportedKey) != m_libraryImportStamp;
+        const bool importPlaylists = m_importLibrary ||
+                settings.getValue(kPlaylistsImportedKey) != m_playlistsImportStamp;
+        if (!importPlaylists && loadImportedPlaylists()) {
+            emit saveModelState();
+            emit showTrackModel(m_pRhythmboxTrackModel);
+            emit enableCoverArtDisplay(false);
+            return;
+        }
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
         m_track_future = QtConcurrent::run(&RhythmboxFeature::importMusicCollection, this);
 #else
@@ -144,14 +197,14 @@ void RhythmboxFeature::activateChild(const QModelIndex& index) {
 
 TreeItem* RhythmboxFeature::importMusicCollection() {
     qDebug() << "importMusicCollection Thread Id: " << QThread::currentThread();
-     // Try and open the Rhythmbox DB. An API call which tells us where
-     // the file is would be nice.
-    QFile db(QDir::homePath() + "/.gnome2/rhythmbox/rhythmdb.xml");
+    if (!m_importLibrary) {
+        qDebug() << "Reusing the imported Rhythmbox music collection";
+        return importPlaylists();
+    }
+
+    QFile db(findRhythmboxFile("rhythmdb.xml"));
     if (!db.exists()) {
-        db.setFileName(QDir::homePath() + "/.local/share/rhythmbox/rhythmdb.xml");
-        if (!db.exists()) {
-            return nullptr;
-        }
+        return nullptr;
     }
 
     mixxx::FileInfo fileInfo(db);
@@ -160,8 +213,10 @@ TreeItem* RhythmboxFeature::importMusicCollection() {
         return nullptr;
     }
 
-    //Delete all table entries of Traktor feature
+    //Delete all table entries of Rhythmbox feature
     ScopedTransaction transaction(m_database);
+    SettingsDAO(m_database).setValue(kLibraryImportedKey, QString());
+    SettingsDAO(m_database).setValue(kPlaylistsImportedKey, QString());
     clearTable("rhythmbox_playlist_tracks");
     clearTable("rhythmbox_library");
     clearTable("rhythmbox_playlists");
@@ -187,6 +242,9 @@ TreeItem* RhythmboxFeature::importMusicCollection() {
             }
         }
     }
+    if (!xml.hasError() && !m_cancelImport) {
+        SettingsDAO(m_database).setValue(kLibraryImportedKey, m_libraryImportStamp);
+    }
     transaction.commit();
 
     if (xml.hasError()) {
@@ -204,18 +262,21 @@ TreeItem* RhythmboxFeature::importMusicCollection() {
 }
 
 TreeItem* RhythmboxFeature::importPlaylists() {
-    QFile db(QDir::homePath() + "/.gnome2/rhythmbox/playlists.xml");
+    QFile db(findRhythmboxFile("playlists.xml"));
     if (!db.exists()) {
-        db.setFileName(QDir::homePath() + "/.local/share/rhythmbox/playlists.xml");
-        if (!db.exists()) {
-            return nullptr;
-        }
+        return nullptr;
     }
     //Open file
     if (!db.open(QIODevice::ReadOnly)) {
         return nullptr;
     }
 
+    // Insert all playlists in a single transaction
+    ScopedTransaction transaction(m_database);
+    SettingsDAO(m_database).setValue(kPlaylistsImportedKey, QString());
+    clearTable("rhythmbox_playlist_tracks");
+    clearTable("rhythmbox_playlists");
+
     QSqlQuery query_insert_to_playlists(m_database);
     query_insert_to_playlists.prepare("INSERT INTO rhythmbox_playlists (id, name) "
                                       "VALUES (:id, :name)");
@@ -224,6 +285,10 @@ TreeItem* RhythmboxFeature::importPlaylists() {
     query_insert_to_playlist_tracks.prepare(
             "INSERT INTO rhythmbox_playlist_tracks (playlist_id, track_id, position) "
             "VALUES (:playlist_id, :track_id, :position)");
+
+    QSqlQuery query_find_track(m_database);
+    query_find_track.prepare("SELECT id FROM rhythmbox_library WHERE location=:path");
+
     //The tree structure holding the playlists
     std::unique_ptr<TreeItem> rootItem = TreeItem::newRoot(this);
 
@@ -253,11 +318,19 @@ TreeItem* RhythmboxFeature::importPlaylists() {
                 int playlist_id = query_insert_to_playlists.lastInsertId().toInt();
 
                 //Process playlist entries
-                importPlaylist(xml, query_insert_to_playlist_tracks, playlist_id);
+                importPlaylist(xml,
+                        query_insert_to_playlist_tracks,
+                        query_find_track,
+                        playlist_id);
             }
         }
     }
 
+    if (!xml.hasError() && !m_cancelImport) {
+        SettingsDAO(m_database).setValue(kPlaylistsImportedKey, m_playlistsImportStamp);
+    }
+    transaction.commit();
+
     if (xml.hasError()) {
         // do error handling
         qDebug() << "Cannot process Rhythmbox music collection";
@@ -370,6 +443,7 @@ void RhythmboxFeature::importTrack(QXmlStreamReader &xml, QSqlQuery &query) {
 // reads all playlist entries and executes a SQL statement
 void RhythmboxFeature::importPlaylist(QXmlStreamReader &xml,
                                       QSqlQuery &query_insert_to_playlist_tracks,
+                                      QSqlQuery &query_find_track,
                                       int playlist_id) {
     int playlist_position = 1;
     while (!xml.atEnd()) {
@@ -380,19 +454,17 @@ void RhythmboxFeature::importPlaylist(QXmlStreamReader &xml,
 
             //get the ID of the file in the rhythmbox_library table
             int track_id = -1;
-            QSqlQuery finder_query(m_database);
-            finder_query.prepare("select id from rhythmbox_library where location=:path");
-            finder_query.bindValue(":path", fileInfo.location());
-            bool success = finder_query.exec();
+            query_find_track.bindValue(":path", fileInfo.location());
+            bool success = query_find_track.exec();
 
             if (success) {
-                const int idColumn = finder_query.record().indexOf("id");
-                while (finder_query.next()) {
-                    track_id = finder_query.value(idColumn).toInt();
+                const int idColumn = query_find_track.record().indexOf("id");
+                while (query_find_track.next()) {
+                    track_id = query_find_track.value(idColumn).toInt();
                 }
              } else {
                 qDebug() << "SQL Error in RhythmboxFeature.cpp: line"
-                         << __LINE__ << " " << finder_query.lastError();
+                         << __LINE__ << " " << query_find_track.lastError();
             }
 
             query_insert_to_playlist_tracks.bindValue(":playlist_id", playlist_id);
@@ -415,6 +487,23 @@ void RhythmboxFeature::importPlaylist(QXmlStreamReader &xml,
     }
 }
 
+bool RhythmboxFeature::loadImportedPlaylists() {
+    QSqlQuery query(m_database);
+    query.prepare("SELECT name FROM rhythmbox_playlists ORDER BY id");
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    std::unique_ptr<TreeItem> pRootItem = TreeItem::newRoot(this);
+    while (query.next()) {
+        pRootItem->appendChild(query.value(0).toString());
+    }
+    qDebug() << "Using the imported Rhythmbox music collection";
+    m_pSidebarModel->setRootItem(std::move(pRootItem));
+    m_trackSource->buildIndex();
+    return true;
+}
+
 void RhythmboxFeature::clearTable(const QString& table_name) {
     qDebug() << "clearTable Thread Id: " << QThread::currentThread();
     QSqlQuery query(m_database);
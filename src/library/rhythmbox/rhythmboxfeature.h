@@ -39,10 +39,15 @@ class RhythmboxFeature : public BaseExternalLibraryFeature {
     virtual BaseSqlTableModel* getPlaylistModelForPlaylist(const QString& playlist);
     // Removes all rows from a given table
     void clearTable(const QString& table_name);
+    /// Builds the sidebar from the tables of a previous import
+    bool loadImportedPlaylists();
     // reads the properties of a track and executes a SQL statement
     void importTrack(QXmlStreamReader &xml, QSqlQuery &query);
     // reads all playlist entries and executes a SQL statement
-    void importPlaylist(QXmlStreamReader &xml, QSqlQuery &query, int playlist_id);
+    void importPlaylist(QXmlStreamReader &xml,
+            QSqlQuery &query_insert,
+            QSqlQuery &query_find_track,
+            int playlist_id);
 
     BaseExternalTrackModel* m_pRhythmboxTrackModel;
     BaseExternalPlaylistModel* m_pRhythmboxPlaylistModel;
@@ -52,6 +57,12 @@ class RhythmboxFeature : public BaseExternalLibraryFeature {
     bool m_isActivated;
     QString m_title;
 
+    // Decided before starting the import thread
+    bool m_importLibrary;
+    // Stored when the import of the corresponding XML file has finished
+    QString m_libraryImportStamp;
+    QString m_playlistsImportStamp;
+
     QFutureWatcher<TreeItem*> m_track_watcher;
     QFuture<TreeItem*> m_track_future;
     parented_ptr<TreeItemModel> m_pSidebarModel;
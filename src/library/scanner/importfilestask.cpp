@@ -50,7 +50,16 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
-            emit addNewTrack(trackLocation);
+            // Parse the file on this worker thread. The track is added to
+            // the database by the scanner thread.
+            if (!m_scannerGlobal->acquirePendingImportedTrack()) {
+                setSuccess(false);
+                return;
+            }
+            emit addNewTrack(trackLocation,
+                    SoundSourceProxy::importNewTrackMetadataAndCoverImageFromFile(
+                            mixxx::FileAccess(mixxx::FileInfo(fileInfo), m_pToken),
+                            m_scannerGlobal->resetMissingTagMetadataOnImport()));
         }
     }
     // Insert or update the hash in the database.
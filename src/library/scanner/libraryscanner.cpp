@@ -1,8 +1,12 @@
 #include "library/scanner/libraryscanner.h"
 
+#include <utility>
+
 #include "library/coverartutils.h"
+#include "library/library_prefs.h"
 #include "library/queryutil.h"
 #include "library/scanner/libraryscannerdlg.h"
+#include "library/scanner/librarywatcher.h"
 #include "library/scanner/recursivescandirectorytask.h"
 #include "library/scanner/scannertask.h"
 #include "library/scanner/scannerutil.h"
@@ -13,14 +17,22 @@
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/fwdsqlquery.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
 namespace {
 
-// TODO(rryan) make configurable
-constexpr int kScannerThreadPoolSize = 1;
+// Metadata of new tracks is parsed concurrently by the worker threads.
+// The number of threads is limited, because the scanner is mostly bound
+// by I/O and the scanner thread needs to keep up with adding the tracks
+// to the database.
+constexpr int kMaxScannerThreadPoolSize = 4;
+
+// The maximum number of tracks with imported metadata that are waiting
+// to be added to the database by the scanner thread
+constexpr int kMaxPendingImportedTracks = 64;
 
 mixxx::Logger kLogger("LibraryScanner");
 
@@ -102,8 +114,10 @@ LibraryScanner::LibraryScanner(
           m_trackDao(m_cueDao, m_playlistDao,
                   m_analysisDao, m_libraryHashDao,
                   pConfig),
+          m_pConfig(pConfig),
           m_stateSema(1), // only one transaction is possible at a time
-          m_state(IDLE) {
+          m_state(IDLE),
+          m_incrementalScan(false) {
     // Move LibraryScanner to its own thread so that our signals/slots will
     // queue to our event loop.
     moveToThread(this);
@@ -112,7 +126,10 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
+    m_pool.setMaxThreadCount(
+            math_clamp(QThread::idealThreadCount(), 1, kMaxScannerThreadPoolSize));
+
+    qRegisterMetaType<ImportedTrackMetadataPointer>();
 
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
@@ -174,10 +191,22 @@ void LibraryScanner::run() {
         m_analysisDao.initialize(dbConnection);
         m_directoryDao.initialize(dbConnection);
 
+        if (m_pConfig->getValue(mixxx::library::prefs::kWatchDirectoriesConfigKey, false)) {
+            m_pWatcher = std::make_unique<LibraryWatcher>();
+            connect(m_pWatcher.get(),
+                    &LibraryWatcher::directoriesChanged,
+                    this,
+                    &LibraryScanner::slotWatchedDirectoriesChanged);
+            watchLibraryDirectories();
+        }
+
         // Start the event loop.
         kLogger.debug() << "Event loop starting";
         exec();
         kLogger.debug() << "Event loop stopped";
+
+        // The watcher must be destroyed in this thread
+        m_pWatcher.reset();
     }
     kLogger.debug() << "Exiting thread";
 }
@@ -197,18 +226,9 @@ void LibraryScanner::slotStartScan() {
         return;
     }
     changeScannerState(SCANNING);
+    m_incrementalScan = false;
 
-    QSet<QString> trackLocations = m_trackDao.getAllTrackLocations();
-    QHash<QString, mixxx::cache_key_t> directoryHashes = m_libraryHashDao.getDirectoryHashes();
-    QRegularExpression extensionFilter(SoundSourceProxy::getSupportedFileNamesRegex());
-    QRegularExpression coverExtensionFilter =
-            QRegularExpression(CoverArtUtils::supportedCoverArtExtensionsRegex(),
-                    QRegularExpression::CaseInsensitiveOption);
-    QStringList directoryBlacklist = ScannerUtil::getDirectoryBlacklist();
-
-    m_scannerGlobal = ScannerGlobalPointer(
-            new ScannerGlobal(trackLocations, directoryHashes, extensionFilter,
-                              coverExtensionFilter, directoryBlacklist));
+    initScannerGlobal();
 
     m_scannerGlobal->startTimer();
 
@@ -263,6 +283,123 @@ void LibraryScanner::slotStartScan() {
     pWatcher->taskDone();
 }
 
+void LibraryScanner::initScannerGlobal() {
+    QSet<QString> trackLocations = m_trackDao.getAllTrackLocations();
+    QHash<QString, mixxx::cache_key_t> directoryHashes = m_libraryHashDao.getDirectoryHashes();
+    // Tags of modified files are only re-imported if the user has enabled
+    // the synchronization of file tags, see TrackDAO.
+    QHash<QString, qint64> trackSourceSynchronizedMillis;
+    if (m_pConfig->getValue(mixxx::library::prefs::kSyncTrackMetadataConfigKey, false)) {
+        trackSourceSynchronizedMillis = m_trackDao.getAllTrackSourceSynchronizedMillis();
+    }
+    QRegularExpression extensionFilter(SoundSourceProxy::getSupportedFileNamesRegex());
+    QRegularExpression coverExtensionFilter =
+            QRegularExpression(CoverArtUtils::supportedCoverArtExtensionsRegex(),
+                    QRegularExpression::CaseInsensitiveOption);
+    QStringList directoryBlacklist = ScannerUtil::getDirectoryBlacklist();
+
+    m_scannerGlobal = ScannerGlobalPointer(
+            new ScannerGlobal(trackLocations,
+                    directoryHashes,
+                    trackSourceSynchronizedMillis,
+                    extensionFilter,
+                    coverExtensionFilter,
+                    directoryBlacklist,
+                    SyncTrackMetadataParams::readFromUserSettings(*m_pConfig)
+                            .resetMissingTagMetadataOnImport,
+                    kMaxPendingImportedTracks));
+}
+
+void LibraryScanner::slotWatchedDirectoriesChanged(const QStringList& directories) {
+    kLogger.debug() << "slotWatchedDirectoriesChanged" << directories;
+    for (const auto& directory : directories) {
+        if (!m_pendingChangedDirectories.contains(directory)) {
+            m_pendingChangedDirectories.append(directory);
+        }
+    }
+    if (changeScannerState(STARTING)) {
+        startIncrementalScan(std::exchange(m_pendingChangedDirectories, {}));
+    }
+    // Otherwise the directories are scanned after the current scan
+}
+
+void LibraryScanner::startIncrementalScan(const QStringList& directories) {
+    kLogger.debug() << "startIncrementalScan()" << directories;
+    DEBUG_ASSERT(m_state == STARTING);
+
+    m_libraryRootDirs = m_directoryDao.loadAllDirectories();
+    if (m_libraryRootDirs.isEmpty()) {
+        changeScannerState(IDLE);
+        return;
+    }
+    changeScannerState(SCANNING);
+    m_incrementalScan = true;
+
+    initScannerGlobal();
+
+    m_scannerGlobal->startTimer();
+
+    emit scanStarted();
+
+    // Subdirectories that are already known have their own watches
+    // and must not be scanned recursively.
+    const QStringList knownDirectories = m_libraryHashDao.getDirectoryHashes().keys();
+    for (const auto& knownDirectory : knownDirectories) {
+        if (!directories.contains(knownDirectory)) {
+            m_scannerGlobal->testAndMarkDirectoryScanned(QDir(knownDirectory));
+        }
+    }
+
+    m_trackDao.addTracksPrepare();
+
+    TaskWatcher* pWatcher = &m_scannerGlobal->getTaskWatcher();
+    pWatcher->watchTask();
+    connect(pWatcher,
+            &TaskWatcher::allTasksDone,
+            this,
+            &LibraryScanner::slotFinishHashedScan);
+
+    for (const auto& directory : directories) {
+        const auto dirInfo = mixxx::FileInfo(directory);
+        if (!dirInfo.exists() || !dirInfo.isDir()) {
+            // Removed directories are detected by the next full scan
+            continue;
+        }
+        // Reuse the security bookmark of the root directory
+        const auto dirCanonicalLocation = dirInfo.canonicalLocation();
+        for (const mixxx::FileInfo& rootDir : qAsConst(m_libraryRootDirs)) {
+            if (!mixxx::FileInfo::isRootSubCanonicalLocation(
+                        rootDir.canonicalLocation(), dirCanonicalLocation)) {
+                continue;
+            }
+            if (!m_scannerGlobal->testAndMarkDirectoryScanned(dirInfo.toQDir())) {
+                // New subdirectories are scanned immediately
+                queueTask(new RecursiveScanDirectoryTask(this,
+                        m_scannerGlobal,
+                        mixxx::FileAccess(dirInfo, mixxx::FileAccess(rootDir).token()),
+                        true));
+            }
+            break;
+        }
+    }
+    pWatcher->taskDone();
+}
+
+void LibraryScanner::watchLibraryDirectories() {
+    DEBUG_ASSERT(m_pWatcher);
+    // The hashes cover all directories that have been visited by the
+    // previous scans
+    QStringList directories = m_libraryHashDao.getDirectoryHashes().keys();
+    const auto rootDirs = m_directoryDao.loadAllDirectories();
+    for (const mixxx::FileInfo& rootDir : rootDirs) {
+        const QString rootLocation = rootDir.location();
+        if (!directories.contains(rootLocation)) {
+            directories.append(rootLocation);
+        }
+    }
+    m_pWatcher->watchDirectories(directories);
+}
+
 // is called when all tasks of the first stage are done (threads are finished)
 void LibraryScanner::slotFinishHashedScan() {
     kLogger.debug() << "slotFinishHashedScan";
@@ -407,11 +544,12 @@ void LibraryScanner::slotFinishUnhashedScan() {
     m_trackDao.addTracksFinish(!m_scannerGlobal->shouldCancel() &&
                                !bScanFinishedCleanly);
 
-    if (!m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
+    // Tracks and directories are not verified by incremental scans
+    if (!m_incrementalScan && !m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
         cleanUpScan();
     }
 
-    if (!m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
+    if (!m_incrementalScan && !m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
         const auto dbConnection = mixxx::DbConnectionPooled(m_pDbConnectionPool);
         updateQueryPlannerStatisticsForDatabase(dbConnection);
     }
@@ -439,6 +577,14 @@ void LibraryScanner::slotFinishUnhashedScan() {
     // now we may accept new scan commands
 
     emit scanFinished();
+
+    if (m_pWatcher) {
+        // Also watch new directories
+        watchLibraryDirectories();
+        if (!m_pendingChangedDirectories.isEmpty()) {
+            slotWatchedDirectoriesChanged(QStringList());
+        }
+    }
 }
 
 void LibraryScanner::scan() {
@@ -510,6 +656,10 @@ void LibraryScanner::queueTask(ScannerTask* pTask) {
             &ScannerTask::trackExists,
             this,
             &LibraryScanner::slotTrackExists);
+    connect(pTask,
+            &ScannerTask::trackModified,
+            this,
+            &LibraryScanner::slotTrackModified);
     connect(pTask,
             &ScannerTask::addNewTrack,
             this,
@@ -566,13 +716,31 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
     }
 }
 
-void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
+void LibraryScanner::slotTrackModified(const QString& trackPath) {
+    //kLogger.debug() << "slotTrackModified" << trackPath;
+    ScopedTimer timer("LibraryScanner::slotTrackModified");
+    // Loading the track re-imports the metadata from the modified file.
+    // The updated track is saved when the last reference is dropped.
+    const TrackPointer pTrack = m_trackDao.getTrackByRef(TrackRef::fromFilePath(trackPath));
+    if (!pTrack) {
+        kLogger.warning()
+                << "Failed to update modified track:"
+                << trackPath;
+    }
+}
+
+void LibraryScanner::slotAddNewTrack(const QString& trackPath,
+        ImportedTrackMetadataPointer pImportedTrackMetadata) {
     //kLogger.debug() << "slotAddNewTrack" << trackPath;
     ScopedTimer timer("LibraryScanner::addNewTrack");
+    if (m_scannerGlobal) {
+        m_scannerGlobal->releasePendingImportedTrack();
+    }
     // For statistics tracking and to detect moved tracks
     TrackPointer pTrack = m_trackDao.addTracksAddFile(
             trackPath,
-            false);
+            false,
+            pImportedTrackMetadata.get());
     if (pTrack) {
         DEBUG_ASSERT(!pTrack->isDirty());
         // The track's actual location might differ from the
@@ -8,6 +8,7 @@
 #include <QString>
 #include <QThread>
 #include <QThreadPool>
+#include <memory>
 
 #include "library/dao/analysisdao.h"
 #include "library/dao/cuedao.h"
@@ -16,12 +17,14 @@
 #include "library/dao/playlistdao.h"
 #include "library/dao/trackdao.h"
 #include "library/scanner/scannerglobal.h"
+#include "sources/soundsourceproxy.h"
 #include "track/track_decl.h"
 #include "track/trackid.h"
 #include "util/db/dbconnectionpool.h"
 
 class ScannerTask;
 class LibraryScannerDlg;
+class LibraryWatcher;
 
 class LibraryScanner : public QThread {
     FRIEND_TEST(LibraryScannerTest, ScannerRoundtrip);
@@ -62,6 +65,7 @@ class LibraryScanner : public QThread {
 
   private slots:
     void slotStartScan();
+    void slotWatchedDirectoriesChanged(const QStringList& directories);
     void slotFinishHashedScan();
     void slotFinishUnhashedScan();
 
@@ -70,7 +74,9 @@ class LibraryScanner : public QThread {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void slotDirectoryUnchanged(const QString& directoryPath);
     void slotTrackExists(const QString& trackPath);
-    void slotAddNewTrack(const QString& trackPath);
+    void slotTrackModified(const QString& trackPath);
+    void slotAddNewTrack(const QString& trackPath,
+            ImportedTrackMetadataPointer pImportedTrackMetadata);
 
   private:
     enum ScannerState {
@@ -96,6 +102,15 @@ class LibraryScanner : public QThread {
 
     void cleanUpScan();
 
+    void initScannerGlobal();
+
+    // Only scans the given directories and new subdirectories. Tracks
+    // are not verified and missing tracks will only be detected by the
+    // next full scan.
+    void startIncrementalScan(const QStringList& directories);
+
+    void watchLibraryDirectories();
+
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
 
     // The pool of threads used for worker tasks.
@@ -109,6 +124,8 @@ class LibraryScanner : public QThread {
     AnalysisDao m_analysisDao;
     TrackDAO m_trackDao;
 
+    const UserSettingsPointer m_pConfig;
+
     // Global scanner state for scan currently in progress.
     ScannerGlobalPointer m_scannerGlobal;
 
@@ -120,5 +137,12 @@ class LibraryScanner : public QThread {
     volatile ScannerState m_state;
 
     QList<mixxx::FileInfo> m_libraryRootDirs;
+
+    // Only exists in the library scanner thread if watching the
+    // library directories is enabled
+    std::unique_ptr<LibraryWatcher> m_pWatcher;
+    // Changed directories that are scanned after the current scan
+    QStringList m_pendingChangedDirectories;
+    bool m_incrementalScan;
     QScopedPointer<LibraryScannerDlg> m_pProgressDlg;
 };
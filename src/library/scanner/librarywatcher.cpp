@@ -0,0 +1,70 @@
+#include "library/scanner/librarywatcher.h"
+
+#include "moc_librarywatcher.cpp"
+#include "util/logger.h"
+
+namespace {
+
+// Copying or extracting many files into a directory causes a burst of
+// notifications that should result in a single scan
+constexpr int kDebounceMillis = 3000;
+
+const mixxx::Logger kLogger("LibraryWatcher");
+
+} // anonymous namespace
+
+LibraryWatcher::LibraryWatcher(QObject* pParent)
+        : QObject(pParent),
+          m_fileSystemWatcher(this),
+          m_debounceTimer(this) {
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(kDebounceMillis);
+    connect(&m_fileSystemWatcher,
+            &QFileSystemWatcher::directoryChanged,
+            this,
+            &LibraryWatcher::slotDirectoryChanged);
+    connect(&m_debounceTimer,
+            &QTimer::timeout,
+            this,
+            &LibraryWatcher::slotDebounceTimeout);
+}
+
+void LibraryWatcher::watchDirectories(const QStringList& directories) {
+    const QStringList watchedDirectories = m_fileSystemWatcher.directories();
+    if (!watchedDirectories.isEmpty()) {
+        m_fileSystemWatcher.removePaths(watchedDirectories);
+    }
+    if (directories.isEmpty()) {
+        return;
+    }
+    const QStringList failedDirectories = m_fileSystemWatcher.addPaths(directories);
+    if (!failedDirectories.isEmpty()) {
+        // The number of watches might be limited by the operating
+        // system, e.g. by fs.inotify.max_user_watches on Linux
+        kLogger.warning()
+                << "Failed to watch"
+                << failedDirectories.size()
+                << "of"
+                << directories.size()
+                << "directories";
+    }
+    kLogger.info()
+            << "Watching"
+            << directories.size() - failedDirectories.size()
+            << "directories";
+}
+
+void LibraryWatcher::slotDirectoryChanged(const QString& directory) {
+    m_changedDirectories.insert(directory);
+    // Restart the timer until the changes have settled
+    m_debounceTimer.start();
+}
+
+void LibraryWatcher::slotDebounceTimeout() {
+    if (m_changedDirectories.isEmpty()) {
+        return;
+    }
+    const QStringList changedDirectories = m_changedDirectories.values();
+    m_changedDirectories.clear();
+    emit directoriesChanged(changedDirectories);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+/// Watches the directories of the library for changes, i.e. for files
+/// or subdirectories that have been added, removed, or renamed.
+///
+/// Change notifications are debounced. All directories that have changed
+/// until no more notifications are received for the debounce interval
+/// are reported at once.
+///
+/// QFileSystemWatcher does not watch directories recursively. All
+/// subdirectories need to be added explicitly.
+class LibraryWatcher : public QObject {
+    Q_OBJECT
+  public:
+    explicit LibraryWatcher(QObject* pParent = nullptr);
+    ~LibraryWatcher() override = default;
+
+    /// Replaces the set of watched directories
+    void watchDirectories(const QStringList& directories);
+
+  signals:
+    void directoriesChanged(const QStringList& directories);
+
+  private slots:
+    void slotDirectoryChanged(const QString& directory);
+    void slotDebounceTimeout();
+
+  private:
+    QFileSystemWatcher m_fileSystemWatcher;
+    QTimer m_debounceTimer;
+    QSet<QString> m_changedDirectories;
+};
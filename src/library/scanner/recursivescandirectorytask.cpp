@@ -50,6 +50,11 @@ void RecursiveScanDirectoryTask::run() {
     QRegularExpression supportedCoverExtensionsRegex =
             m_scannerGlobal->supportedCoverExtensionsRegex();
 
+    // Files that have been modified since their metadata has been imported
+    // are detected independent of the directory hash, which only covers
+    // the file names.
+    const bool detectModifiedTrackFiles = m_scannerGlobal->detectModifiedTrackFiles();
+
     while (it.hasNext()) {
         QString currentFile = it.next();
         QFileInfo currentFileInfo = it.fileInfo();
@@ -60,6 +65,14 @@ void RecursiveScanDirectoryTask::run() {
                     supportedExtensionsRegex.match(fileName);
             if (supportedExtensionsMatch.hasMatch()) {
                 hasher.addData(currentFile.toUtf8());
+                if (detectModifiedTrackFiles) {
+                    const QString trackLocation =
+                            mixxx::FileInfo(currentFileInfo).location();
+                    if (m_scannerGlobal->trackFileModified(
+                                trackLocation, currentFileInfo)) {
+                        emit trackModified(trackLocation);
+                    }
+                }
                 filesToImport.push_back(currentFileInfo);
             } else {
                 const QRegularExpressionMatch supportedCoverExtensionsMatch =
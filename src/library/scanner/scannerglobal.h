@@ -1,9 +1,11 @@
 #pragma once
 
 #include <QDir>
+#include <QFileInfo>
 #include <QHash>
 #include <QMutex>
 #include <QRegularExpression>
+#include <QSemaphore>
 #include <QSet>
 #include <QSharedPointer>
 #include <QStringList>
@@ -18,14 +20,20 @@ class ScannerGlobal {
   public:
     ScannerGlobal(const QSet<QString>& trackLocations,
             const QHash<QString, mixxx::cache_key_t>& directoryHashes,
+            const QHash<QString, qint64>& trackSourceSynchronizedMillis,
             const QRegularExpression& supportedExtensionsMatcher,
             const QRegularExpression& supportedCoverExtensionsMatcher,
-            const QStringList& directoriesBlacklist)
+            const QStringList& directoriesBlacklist,
+            bool resetMissingTagMetadataOnImport,
+            int maxPendingImportedTracks)
             : m_trackLocations(trackLocations),
               m_directoryHashes(directoryHashes),
+              m_trackSourceSynchronizedMillis(trackSourceSynchronizedMillis),
               m_supportedExtensionsMatcher(supportedExtensionsMatcher),
               m_supportedCoverExtensionsMatcher(supportedCoverExtensionsMatcher),
               m_directoriesBlacklist(directoriesBlacklist),
+              m_resetMissingTagMetadataOnImport(resetMissingTagMetadataOnImport),
+              m_pendingImportedTracks(maxPendingImportedTracks),
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
@@ -41,6 +49,43 @@ class ScannerGlobal {
         return m_trackLocations.contains(trackLocation);
     }
 
+    // Returns whether the file of a track in the database has been modified
+    // after its metadata has been imported. Only the modification time that
+    // has already been read while listing the directory is compared, i.e.
+    // the file is not opened.
+    bool trackFileModified(const QString& trackLocation, const QFileInfo& fileInfo) const {
+        const auto i = m_trackSourceSynchronizedMillis.constFind(trackLocation);
+        if (i == m_trackSourceSynchronizedMillis.constEnd()) {
+            return false;
+        }
+        return fileInfo.lastModified().toMSecsSinceEpoch() > i.value();
+    }
+
+    bool detectModifiedTrackFiles() const {
+        return !m_trackSourceSynchronizedMillis.isEmpty();
+    }
+
+    bool resetMissingTagMetadataOnImport() const {
+        return m_resetMissingTagMetadataOnImport;
+    }
+
+    // Metadata of new tracks is imported concurrently in advance. The
+    // number of imported tracks that are waiting to be added is limited
+    // to bound the memory consumption of embedded cover images. Returns
+    // false if the scan has been cancelled while waiting.
+    bool acquirePendingImportedTrack() {
+        while (!m_pendingImportedTracks.tryAcquire(1, kPendingImportedTrackTimeoutMillis)) {
+            if (m_shouldCancel) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void releasePendingImportedTrack() {
+        m_pendingImportedTracks.release();
+    }
+
     // Returns the directory hash if it exists or mixxx::invalidCacheKey() if it doesn't.
     mixxx::cache_key_t directoryHashInDatabase(const QString& directoryPath) const {
         return m_directoryHashes.value(directoryPath, mixxx::invalidCacheKey());
@@ -154,10 +199,14 @@ class ScannerGlobal {
     }
 
   private:
+    static constexpr int kPendingImportedTrackTimeoutMillis = 100;
+
     TaskWatcher m_watcher;
 
     QSet<QString> m_trackLocations;
     QHash<QString, mixxx::cache_key_t> m_directoryHashes;
+    // Empty if modified files should not be detected
+    QHash<QString, qint64> m_trackSourceSynchronizedMillis;
 
     mutable QMutex m_supportedExtensionsMatcherMutex;
     QRegularExpression m_supportedExtensionsMatcher;
@@ -182,6 +231,9 @@ class ScannerGlobal {
     // this has never been investigated.
     QStringList m_directoriesBlacklist;
 
+    const bool m_resetMissingTagMetadataOnImport;
+    QSemaphore m_pendingImportedTracks;
+
     // The list of directories verified by the scan.
     QStringList m_verifiedDirectories;
 
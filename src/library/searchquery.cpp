@@ -5,6 +5,7 @@
 
 #include "library/dao/trackschema.h"
 #include "library/queryutil.h"
+#include "library/tracksearchindex.h"
 #include "library/trackset/crate/crateschema.h"
 #include "track/keyutils.h"
 #include "track/track.h"
@@ -92,6 +93,15 @@ QString QueryNode::concatSqlClauses(
     }
 }
 
+bool GroupNode::matchesTrackValuesOnly() const {
+    for (const auto& pNode : m_nodes) {
+        if (!pNode->matchesTrackValuesOnly()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool AndNode::match(const TrackPointer& pTrack) const {
     for (const auto& pNode : m_nodes) {
         if (!pNode->match(pTrack)) {
@@ -115,6 +125,21 @@ QString AndNode::toSql() const {
     return concatSqlClauses(queryFragments, "AND");
 }
 
+std::optional<QSet<TrackId>> AndNode::matchIndex(
+        const TrackSearchIndex& index,
+        const QSet<TrackId>& candidates) const {
+    // Each node only needs to evaluate the remaining candidates
+    QSet<TrackId> result = candidates;
+    for (const auto& pNode : m_nodes) {
+        auto nodeResult = pNode->matchIndex(index, result);
+        if (!nodeResult) {
+            return std::nullopt;
+        }
+        result = std::move(*nodeResult);
+    }
+    return result;
+}
+
 bool OrNode::match(const TrackPointer& pTrack) const {
     // An empty OR node would always evaluate to false
     // which is inconsistent with the generated SQL query!
@@ -144,6 +169,24 @@ QString OrNode::toSql() const {
     return concatSqlClauses(queryFragments, "OR");
 }
 
+std::optional<QSet<TrackId>> OrNode::matchIndex(
+        const TrackSearchIndex& index,
+        const QSet<TrackId>& candidates) const {
+    VERIFY_OR_DEBUG_ASSERT(!m_nodes.empty()) {
+        // Consistent with match()
+        return candidates;
+    }
+    QSet<TrackId> result;
+    for (const auto& pNode : m_nodes) {
+        const auto nodeResult = pNode->matchIndex(index, candidates);
+        if (!nodeResult) {
+            return std::nullopt;
+        }
+        result.unite(*nodeResult);
+    }
+    return result;
+}
+
 bool NotNode::match(const TrackPointer& pTrack) const {
     return !m_pNode->match(pTrack);
 }
@@ -160,6 +203,16 @@ QString NotNode::toSql() const {
     }
 }
 
+std::optional<QSet<TrackId>> NotNode::matchIndex(
+        const TrackSearchIndex& index,
+        const QSet<TrackId>& candidates) const {
+    const auto nodeResult = m_pNode->matchIndex(index, candidates);
+    if (!nodeResult) {
+        return std::nullopt;
+    }
+    return QSet<TrackId>(candidates).subtract(*nodeResult);
+}
+
 TextFilterNode::TextFilterNode(const QSqlDatabase& database,
         const QStringList& sqlColumns,
         const QString& argument)
@@ -204,6 +257,12 @@ QString TextFilterNode::toSql() const {
     return concatSqlClauses(searchClauses, "OR");
 }
 
+std::optional<QSet<TrackId>> TextFilterNode::matchIndex(
+        const TrackSearchIndex& index,
+        const QSet<TrackId>& candidates) const {
+    return index.matchText(m_sqlColumns, m_argument, candidates);
+}
+
 bool NullOrEmptyTextFilterNode::match(const TrackPointer& pTrack) const {
     if (!m_sqlColumns.isEmpty()) {
         // only use the major column
@@ -224,6 +283,17 @@ QString NullOrEmptyTextFilterNode::toSql() const {
     return QString();
 }
 
+std::optional<QSet<TrackId>> NullOrEmptyTextFilterNode::matchIndex(
+        const TrackSearchIndex& index,
+        const QSet<TrackId>& candidates) const {
+    if (m_sqlColumns.isEmpty()) {
+        // Consistent with toSql()
+        return candidates;
+    }
+    // only use the major column
+    return index.matchNullOrEmpty(m_sqlColumns.first(), candidates);
+}
+
 CrateFilterNode::CrateFilterNode(const CrateStorage* pCrateStorage,
         const QString& crateNameLike)
         : m_pCrateStorage(pCrateStorage),
@@ -231,7 +301,7 @@ CrateFilterNode::CrateFilterNode(const CrateStorage* pCrateStorage,
           m_matchInitialized(false) {
 }
 
-bool CrateFilterNode::match(const TrackPointer& pTrack) const {
+const std::vector<TrackId>& CrateFilterNode::matchingTrackIds() const {
     if (!m_matchInitialized) {
         CrateTrackSelectResult crateTracks(
                 m_pCrateStorage->selectTracksSortedByCrateNameLike(m_crateNameLike));
@@ -242,8 +312,27 @@ bool CrateFilterNode::match(const TrackPointer& pTrack) const {
 
         m_matchInitialized = true;
     }
+    return m_matchingTrackIds;
+}
 
-    return std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), pTrack->getId());
+bool CrateFilterNode::match(const TrackPointer& pTrack) const {
+    const auto& trackIds = matchingTrackIds();
+    return std::binary_search(trackIds.begin(), trackIds.end(), pTrack->getId());
+}
+
+std::optional<QSet<TrackId>> CrateFilterNode::matchIndex(
+        const TrackSearchIndex& index,
+        const QSet<TrackId>& candidates) const {
+    Q_UNUSED(index);
+    // The tracks of matching crates are loaded from the database,
+    // which is cheap compared to a full table scan
+    QSet<TrackId> result;
+    for (const auto& trackId : matchingTrackIds()) {
+        if (candidates.contains(trackId)) {
+            result.insert(trackId);
+        }
+    }
+    return result;
 }
 
 QString CrateFilterNode::toSql() const {
@@ -2,9 +2,11 @@
 #define SEARCHQUERY_H
 
 #include <QList>
+#include <QSet>
 #include <QSqlDatabase>
 #include <QString>
 #include <QStringList>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -14,6 +16,8 @@
 #include "util/assert.h"
 #include "util/memory.h"
 
+class TrackSearchIndex;
+
 const QString kMissingFieldSearchTerm = "\"\""; // "" searches for an empty string
 
 QVariant getTrackValueForColumn(const TrackPointer& pTrack, const QString& column);
@@ -26,6 +30,25 @@ class QueryNode {
     virtual bool match(const TrackPointer& pTrack) const = 0;
     virtual QString toSql() const = 0;
 
+    /// Evaluates the node with the in-memory search index instead of SQL
+    /// and returns the matching candidates. Returns std::nullopt if the
+    /// node cannot be evaluated with the index.
+    virtual std::optional<QSet<TrackId>> matchIndex(
+            const TrackSearchIndex& index,
+            const QSet<TrackId>& candidates) const {
+        Q_UNUSED(index);
+        Q_UNUSED(candidates);
+        return std::nullopt;
+    }
+
+    /// Returns false if the result depends on anything other than the
+    /// values of the matched tracks, e.g. on crate memberships. The
+    /// results of all other nodes only need to be evaluated again for
+    /// tracks that have been modified.
+    virtual bool matchesTrackValuesOnly() const {
+        return true;
+    }
+
   protected:
     QueryNode() = default;
 
@@ -39,6 +62,8 @@ class GroupNode : public QueryNode {
         m_nodes.push_back(std::move(pNode));
     }
 
+    bool matchesTrackValuesOnly() const override;
+
   protected:
     // NOTE(uklotzde): std::vector is more suitable (efficiency)
     // than a QList for a private member. And QList from Qt 4
@@ -50,12 +75,18 @@ class OrNode : public GroupNode {
   public:
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    std::optional<QSet<TrackId>> matchIndex(
+            const TrackSearchIndex& index,
+            const QSet<TrackId>& candidates) const override;
 };
 
 class AndNode : public GroupNode {
   public:
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    std::optional<QSet<TrackId>> matchIndex(
+            const TrackSearchIndex& index,
+            const QSet<TrackId>& candidates) const override;
 };
 
 class NotNode : public QueryNode {
@@ -67,6 +98,12 @@ class NotNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    std::optional<QSet<TrackId>> matchIndex(
+            const TrackSearchIndex& index,
+            const QSet<TrackId>& candidates) const override;
+    bool matchesTrackValuesOnly() const override {
+        return m_pNode->matchesTrackValuesOnly();
+    }
 
   private:
     std::unique_ptr<QueryNode> m_pNode;
@@ -80,6 +117,9 @@ class TextFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    std::optional<QSet<TrackId>> matchIndex(
+            const TrackSearchIndex& index,
+            const QSet<TrackId>& candidates) const override;
 
   private:
     QSqlDatabase m_database;
@@ -97,6 +137,9 @@ class NullOrEmptyTextFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    std::optional<QSet<TrackId>> matchIndex(
+            const TrackSearchIndex& index,
+            const QSet<TrackId>& candidates) const override;
 
   private:
     QSqlDatabase m_database;
@@ -110,8 +153,17 @@ class CrateFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    std::optional<QSet<TrackId>> matchIndex(
+            const TrackSearchIndex& index,
+            const QSet<TrackId>& candidates) const override;
+    bool matchesTrackValuesOnly() const override {
+        return false;
+    }
 
   private:
+    // Sorted, loaded on first use
+    const std::vector<TrackId>& matchingTrackIds() const;
+
     const CrateStorage* m_pCrateStorage;
     QString m_crateNameLike;
     mutable bool m_matchInitialized;
@@ -124,6 +176,9 @@ class NoCrateFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchesTrackValuesOnly() const override {
+        return false;
+    }
 
   private:
     const CrateStorage* m_pCrateStorage;
@@ -211,6 +266,11 @@ class SqlNode : public QueryNode {
         return m_sql;
     }
 
+    bool matchesTrackValuesOnly() const override {
+        // Arbitrary SQL might depend on other tables
+        return false;
+    }
+
   private:
     QString m_sql;
 };
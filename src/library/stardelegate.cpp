@@ -26,8 +26,21 @@ void StarDelegate::paintItem(
 
     paintItemBackground(painter, option, index);
 
-    StarRating starRating = index.data().value<StarRating>();
-    starRating.paint(painter, option.rect);
+    const StarRating starRating = index.data().value<StarRating>();
+    // The stars are filled with the text color that has been selected by
+    // TableItemDelegate::paint() depending on the state of the cell.
+    const QBrush brush = painter->brush();
+    const QString key = QStringLiteral("stars|") +
+            QString::number(starRating.starCount()) + QChar('/') +
+            QString::number(starRating.maxStarCount()) + QChar('|') +
+            QString::number(brush.color().rgba(), 16);
+    drawCachedCellPixmap(painter,
+            option.rect,
+            key,
+            [&starRating, &brush](QPainter* pPixmapPainter, const QRect& rect) {
+                pPixmapPainter->setBrush(brush);
+                starRating.paint(pPixmapPainter, rect);
+            });
 }
 
 QSize StarDelegate::sizeHint(const QStyleOptionViewItem& option,
@@ -1,5 +1,6 @@
 #include "library/tableitemdelegate.h"
 
+#include <QEvent>
 #include <QPainter>
 #include <QTableView>
 
@@ -7,14 +8,58 @@
 #include "util/painterscope.h"
 #include "widget/wtracktableview.h"
 
+namespace {
+
+// The pixmaps of a full screen of cells of a column fit into the cache
+constexpr int kCellPixmapCacheLimitKb = 4 * 1024;
+
+} // anonymous namespace
+
 TableItemDelegate::TableItemDelegate(QTableView* pTableView)
         : QStyledItemDelegate(pTableView),
-          m_pTableView(pTableView) {
+          m_pTableView(pTableView),
+          m_cellPixmapCache(kCellPixmapCacheLimitKb) {
     DEBUG_ASSERT(m_pTableView);
     auto* pTrackTableView = qobject_cast<WTrackTableView*>(m_pTableView);
     if (pTrackTableView) {
         m_pFocusBorderColor = pTrackTableView->getFocusBorderColor();
     }
+    m_pTableView->installEventFilter(this);
+}
+
+bool TableItemDelegate::eventFilter(QObject* pObj, QEvent* pEvent) {
+    if (pObj == m_pTableView) {
+        switch (pEvent->type()) {
+        case QEvent::StyleChange:
+        case QEvent::PaletteChange:
+        case QEvent::FontChange:
+            m_cellPixmapCache.clear();
+            break;
+        default:
+            break;
+        }
+    }
+    return QStyledItemDelegate::eventFilter(pObj, pEvent);
+}
+
+QString TableItemDelegate::cellPixmapKey(const QString& key, QSize size) const {
+    return key + QChar('|') + QString::number(size.width()) + QChar('x') +
+            QString::number(size.height()) + QChar('@') +
+            QString::number(m_pTableView->devicePixelRatioF());
+}
+
+QPixmap TableItemDelegate::createCellPixmap(QSize size) const {
+    const double devicePixelRatio = m_pTableView->devicePixelRatioF();
+    QPixmap pixmap(size * devicePixelRatio);
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+    pixmap.fill(Qt::transparent);
+    return pixmap;
+}
+
+void TableItemDelegate::insertCellPixmap(const QString& key, const QPixmap& pixmap) const {
+    // The cost is the size of the pixmap in kB
+    const int cost = 1 + pixmap.width() * pixmap.height() * pixmap.depth() / (8 * 1024);
+    m_cellPixmapCache.insert(key, new QPixmap(pixmap), cost);
 }
 
 void TableItemDelegate::paint(
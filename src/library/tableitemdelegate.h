@@ -1,5 +1,8 @@
 #pragma once
 
+#include <QCache>
+#include <QPainter>
+#include <QPixmap>
 #include <QStyledItemDelegate>
 #include <QTableView>
 
@@ -28,8 +31,47 @@ class TableItemDelegate : public QStyledItemDelegate {
 
     int columnWidth(const QModelIndex &index) const;
 
+    /// Draws the pixmap of a cell at `rect`. The pixmap is painted by
+    /// `paintCell(QPainter*, const QRect&)` into a transparent pixmap on the
+    /// first use and then reused for all cells with the same `key` and size.
+    ///
+    /// The key must contain everything besides the size that affects the
+    /// rendering of a cell. Changes of the style, palette or font of the
+    /// table view discard all cached pixmaps.
+    template<typename PaintCell>
+    void drawCachedCellPixmap(
+            QPainter* painter,
+            const QRect& rect,
+            const QString& key,
+            PaintCell paintCell) const {
+        if (rect.isEmpty()) {
+            return;
+        }
+        const QString sizedKey = cellPixmapKey(key, rect.size());
+        const QPixmap* pCachedPixmap = m_cellPixmapCache.object(sizedKey);
+        if (pCachedPixmap) {
+            painter->drawPixmap(rect.topLeft(), *pCachedPixmap);
+            return;
+        }
+        QPixmap pixmap = createCellPixmap(rect.size());
+        {
+            QPainter pixmapPainter(&pixmap);
+            paintCell(&pixmapPainter, QRect(QPoint(), rect.size()));
+        }
+        painter->drawPixmap(rect.topLeft(), pixmap);
+        insertCellPixmap(sizedKey, pixmap);
+    }
+
+    bool eventFilter(QObject* pObj, QEvent* pEvent) override;
+
     QColor m_pFocusBorderColor;
 
   private:
+    QString cellPixmapKey(const QString& key, QSize size) const;
+    QPixmap createCellPixmap(QSize size) const;
+    void insertCellPixmap(const QString& key, const QPixmap& pixmap) const;
+
     QTableView* m_pTableView;
+
+    mutable QCache<QString, QPixmap> m_cellPixmapCache;
 };
@@ -41,6 +41,7 @@ TrackCollectionManager::TrackCollectionManager(
         deleteTrackFn_t /*only-needed-for-testing*/ deleteTrackForTestingFn)
     : QObject(parent),
       m_pConfig(pConfig),
+      m_pDbConnectionPool(pDbConnectionPool),
       m_pInternalCollection(createInternalTrackCollection(this, pConfig, deleteTrackForTestingFn)) {
     const QSqlDatabase dbConnection = mixxx::DbConnectionPooled(pDbConnectionPool);
 
@@ -54,6 +55,10 @@ TrackCollectionManager::TrackCollectionManager(
 
     m_pInternalCollection->connectDatabase(dbConnection);
 
+    if (!deleteTrackForTestingFn) {
+        m_pInternalCollection->getAnalysisDAO().deleteOrphanedAnalyses(dbConnection);
+    }
+
     if (deleteTrackForTestingFn) {
         kLogger.info() << "External collections are disabled in test mode";
     } else {
@@ -569,6 +574,12 @@ TrackPointer TrackCollectionManager::getTrackById(
             trackId);
 }
 
+QList<TrackPointer> TrackCollectionManager::getTracksByIds(
+        const QList<TrackId>& trackIds) const {
+    return internalCollection()->getTracksByIds(
+            trackIds);
+}
+
 TrackPointer TrackCollectionManager::getTrackByRef(
         const TrackRef& trackRef) const {
     return internalCollection()->getTrackByRef(
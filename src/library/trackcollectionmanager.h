@@ -42,6 +42,10 @@ class TrackCollectionManager: public QObject,
         return m_pInternalCollection;
     }
 
+    const mixxx::DbConnectionPoolPtr& dbConnectionPool() const {
+        return m_pDbConnectionPool;
+    }
+
     const QList<ExternalTrackCollection*>& externalCollections() const {
         DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
         return m_externalCollections;
@@ -49,6 +53,8 @@ class TrackCollectionManager: public QObject,
 
     TrackPointer getTrackById(
             TrackId trackId) const;
+    QList<TrackPointer> getTracksByIds(
+            const QList<TrackId>& trackIds) const;
     TrackPointer getTrackByRef(
             const TrackRef& trackRef) const;
     QList<TrackId> resolveTrackIdsFromUrls(
@@ -121,6 +127,8 @@ class TrackCollectionManager: public QObject,
 
     const UserSettingsPointer m_pConfig;
 
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+
     const parented_ptr<TrackCollection> m_pInternalCollection;
 
     QList<ExternalTrackCollection*> m_externalCollections;
@@ -0,0 +1,280 @@
+#include "library/trackcolumnstore.h"
+
+#include "util/assert.h"
+
+namespace {
+
+// Interned strings are referenced by their index, null strings are
+// stored as nulls
+constexpr int kNoString = -1;
+
+int metaTypeOf(const QVariant& value) {
+    return value.userType();
+}
+
+QVariant nullValueOf(int metaType) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return QVariant(QMetaType(metaType));
+#else
+    return QVariant(metaType, nullptr);
+#endif
+}
+
+} // anonymous namespace
+
+TrackColumnStore::TrackColumnStore(int columnCount)
+        : m_columns(columnCount),
+          m_rowCount(0),
+          m_stringBytes(0) {
+    DEBUG_ASSERT(columnCount >= 0);
+}
+
+// static
+TrackColumnStore::ColumnType TrackColumnStore::columnTypeOf(int metaType) {
+    switch (metaType) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+        return ColumnType::Integer;
+    case QMetaType::Double:
+        return ColumnType::Real;
+    case QMetaType::QString:
+        return ColumnType::String;
+    default:
+        return ColumnType::Variant;
+    }
+}
+
+int TrackColumnStore::insertRow(TrackId trackId) {
+    DEBUG_ASSERT(trackId.isValid());
+    const auto i = m_rowsByTrackId.constFind(trackId);
+    if (i != m_rowsByTrackId.constEnd()) {
+        return i.value();
+    }
+    int row;
+    if (m_freeRows.empty()) {
+        row = m_rowCount++;
+        for (auto& column : m_columns) {
+            resizeColumn(&column, m_rowCount);
+        }
+    } else {
+        // Removed rows have already been reset to null
+        row = m_freeRows.back();
+        m_freeRows.pop_back();
+    }
+    m_rowsByTrackId.insert(trackId, row);
+    return row;
+}
+
+void TrackColumnStore::removeRow(TrackId trackId) {
+    const auto i = m_rowsByTrackId.find(trackId);
+    if (i == m_rowsByTrackId.end()) {
+        return;
+    }
+    const int row = i.value();
+    m_rowsByTrackId.erase(i);
+    for (int column = 0; column < columnCount(); ++column) {
+        setValue(row, column, QVariant());
+    }
+    m_freeRows.push_back(row);
+}
+
+void TrackColumnStore::clear() {
+    const int numColumns = columnCount();
+    m_columns.clear();
+    m_columns.resize(numColumns);
+    m_rowCount = 0;
+    m_rowsByTrackId.clear();
+    m_freeRows.clear();
+    m_strings.clear();
+    m_stringIds.clear();
+    m_stringBytes = 0;
+    m_sortKeys.clear();
+}
+
+void TrackColumnStore::resizeColumn(Column* pColumn, int rowCount) const {
+    pColumn->nulls.resize(rowCount, true);
+    switch (pColumn->type) {
+    case ColumnType::Undefined:
+        break;
+    case ColumnType::Integer:
+        pColumn->integers.resize(rowCount);
+        break;
+    case ColumnType::Real:
+        pColumn->reals.resize(rowCount);
+        break;
+    case ColumnType::String:
+        pColumn->strings.resize(rowCount, kNoString);
+        break;
+    case ColumnType::Variant:
+        pColumn->variants.resize(rowCount);
+        break;
+    }
+}
+
+void TrackColumnStore::convertToVariants(Column* pColumn) const {
+    DEBUG_ASSERT(pColumn->type != ColumnType::Variant);
+    std::vector<QVariant> variants(m_rowCount);
+    for (int row = 0; row < m_rowCount; ++row) {
+        if (!pColumn->nulls[row]) {
+            variants[row] = typedValue(*pColumn, row);
+        } else if (pColumn->type != ColumnType::Undefined) {
+            variants[row] = nullValueOf(pColumn->metaType);
+        }
+    }
+    pColumn->type = ColumnType::Variant;
+    pColumn->integers = std::vector<qint64>();
+    pColumn->reals = std::vector<double>();
+    pColumn->strings = std::vector<int>();
+    pColumn->variants = std::move(variants);
+    // The null flags are not used for QVariants
+    std::fill(pColumn->nulls.begin(), pColumn->nulls.end(), false);
+}
+
+int TrackColumnStore::internString(const QString& str) {
+    const auto i = m_stringIds.constFind(str);
+    if (i != m_stringIds.constEnd()) {
+        return i.value();
+    }
+    const int id = m_strings.size();
+    m_strings.append(str);
+    m_stringIds.insert(str, id);
+    m_stringBytes += str.size() * static_cast<qint64>(sizeof(QChar));
+    return id;
+}
+
+void TrackColumnStore::setValue(int row, int column, const QVariant& value) {
+    VERIFY_OR_DEBUG_ASSERT(row >= 0 && row < m_rowCount) {
+        return;
+    }
+    VERIFY_OR_DEBUG_ASSERT(column >= 0 && column < columnCount()) {
+        return;
+    }
+    Column& col = m_columns[column];
+    if (value.isValid()) {
+        const int metaType = metaTypeOf(value);
+        if (col.type == ColumnType::Undefined) {
+            col.type = columnTypeOf(metaType);
+            col.metaType = metaType;
+            resizeColumn(&col, m_rowCount);
+        } else if (col.type != ColumnType::Variant && col.metaType != metaType) {
+            convertToVariants(&col);
+        }
+    }
+    if (col.type == ColumnType::Variant) {
+        col.variants[row] = value;
+        return;
+    }
+    if (!value.isValid() || value.isNull()) {
+        col.nulls[row] = true;
+        if (col.type == ColumnType::String) {
+            col.strings[row] = kNoString;
+        }
+        return;
+    }
+    col.nulls[row] = false;
+    switch (col.type) {
+    case ColumnType::Integer:
+        col.integers[row] = value.toLongLong();
+        break;
+    case ColumnType::Real:
+        col.reals[row] = value.toDouble();
+        break;
+    case ColumnType::String:
+        col.strings[row] = internString(value.toString());
+        break;
+    default:
+        DEBUG_ASSERT(!"unreachable");
+    }
+}
+
+QVariant TrackColumnStore::typedValue(const Column& column, int row) const {
+    switch (column.type) {
+    case ColumnType::Integer:
+        switch (column.metaType) {
+        case QMetaType::Bool:
+            return QVariant(column.integers[row] != 0);
+        case QMetaType::Int:
+            return QVariant(static_cast<int>(column.integers[row]));
+        case QMetaType::UInt:
+            return QVariant(static_cast<uint>(column.integers[row]));
+        case QMetaType::ULongLong:
+            return QVariant(static_cast<qulonglong>(column.integers[row]));
+        default:
+            return QVariant(static_cast<qlonglong>(column.integers[row]));
+        }
+    case ColumnType::Real:
+        return QVariant(column.reals[row]);
+    case ColumnType::String:
+        DEBUG_ASSERT(column.strings[row] != kNoString);
+        return QVariant(m_strings[column.strings[row]]);
+    default:
+        DEBUG_ASSERT(!"unreachable");
+        return QVariant();
+    }
+}
+
+QVariant TrackColumnStore::value(int row, int column) const {
+    if (column < 0 || column >= columnCount()) {
+        return QVariant();
+    }
+    VERIFY_OR_DEBUG_ASSERT(row >= 0 && row < m_rowCount) {
+        return QVariant();
+    }
+    const Column& col = m_columns[column];
+    switch (col.type) {
+    case ColumnType::Undefined:
+        return QVariant();
+    case ColumnType::Variant:
+        return col.variants[row];
+    default:
+        if (col.nulls[row]) {
+            return nullValueOf(col.metaType);
+        }
+        return typedValue(col, row);
+    }
+}
+
+QCollatorSortKey TrackColumnStore::sortKey(int row, int column) const {
+    if (column >= 0 && column < columnCount() &&
+            m_columns[column].type == ColumnType::String) {
+        const int id = m_columns[column].strings[row];
+        if (id != kNoString) {
+            if (m_sortKeys.size() <= static_cast<std::size_t>(id)) {
+                m_sortKeys.resize(m_strings.size());
+            }
+            auto& sortKey = m_sortKeys[id];
+            if (!sortKey) {
+                sortKey = m_collator.sortKey(m_strings[id]);
+            }
+            return *sortKey;
+        }
+    }
+    return m_collator.sortKey(value(row, column).toString());
+}
+
+qint64 TrackColumnStore::memoryUsage() const {
+    qint64 bytes = 0;
+    for (const auto& column : m_columns) {
+        bytes += column.nulls.capacity() / 8;
+        bytes += column.integers.capacity() * sizeof(qint64);
+        bytes += column.reals.capacity() * sizeof(double);
+        bytes += column.strings.capacity() * sizeof(int);
+        // Only the QVariants themselves, not any shared data they refer to
+        bytes += column.variants.capacity() * sizeof(QVariant);
+    }
+    // The hash nodes store the key and the value next to a few pointers
+    bytes += m_rowsByTrackId.size() *
+            static_cast<qint64>(sizeof(TrackId) + sizeof(int) + 2 * sizeof(void*));
+    bytes += m_freeRows.capacity() * sizeof(int);
+    // Each interned string is referenced by both m_strings and m_stringIds
+    // but its characters are shared
+    bytes += m_strings.capacity() * static_cast<qint64>(sizeof(QString));
+    bytes += m_stringIds.size() *
+            static_cast<qint64>(sizeof(QString) + sizeof(int) + 2 * sizeof(void*));
+    bytes += m_stringBytes;
+    bytes += m_sortKeys.capacity() * sizeof(std::optional<QCollatorSortKey>);
+    return bytes;
+}
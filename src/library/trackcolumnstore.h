@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QCollator>
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <optional>
+#include <vector>
+
+#include "track/trackid.h"
+#include "util/string.h"
+
+/// Columnar in-memory storage for the column values of tracks that are
+/// cached by BaseTrackCache.
+///
+/// Instead of a QVector<QVariant> per track the values are stored in
+/// contiguous arrays per column. The type of a column is determined by
+/// the first value that is stored into it. Integer and floating point
+/// values are stored unboxed and strings are interned, i.e. shared by
+/// all tracks with the same artist, album, genre, etc. Columns with values
+/// of other or mixed types fall back to storing QVariants. The original
+/// type of the values is preserved.
+///
+/// Collation sort keys of the interned strings are calculated on demand
+/// and kept for subsequent comparisons.
+///
+/// Not thread-safe, all functions must be called from the same thread.
+class TrackColumnStore final {
+  public:
+    explicit TrackColumnStore(int columnCount);
+
+    int columnCount() const {
+        return static_cast<int>(m_columns.size());
+    }
+
+    /// The number of tracks
+    int size() const {
+        return m_rowsByTrackId.size();
+    }
+
+    bool contains(TrackId trackId) const {
+        return m_rowsByTrackId.contains(trackId);
+    }
+
+    /// Returns the row of the track or -1 if the track is not stored
+    int rowOf(TrackId trackId) const {
+        return m_rowsByTrackId.value(trackId, -1);
+    }
+
+    /// Returns the row of the track. A new row is allocated if the track
+    /// has not been stored before. All values of a new row are null.
+    int insertRow(TrackId trackId);
+
+    void removeRow(TrackId trackId);
+
+    /// Removes all tracks and releases all interned strings
+    void clear();
+
+    void setValue(int row, int column, const QVariant& value);
+
+    /// Returns an invalid QVariant if the column is out of range
+    QVariant value(int row, int column) const;
+
+    /// The collation sort key of the value converted to a string
+    QCollatorSortKey sortKey(int row, int column) const;
+
+    /// Estimates the number of bytes that are allocated for the values
+    qint64 memoryUsage() const;
+
+    /// The collation sort key of an arbitrary string, comparable with
+    /// the sort keys of stored values
+    QCollatorSortKey sortKeyOf(const QString& str) const {
+        return m_collator.sortKey(str);
+    }
+
+  private:
+    enum class ColumnType {
+        // Only null values have been stored
+        Undefined,
+        Integer,
+        Real,
+        String,
+        Variant,
+    };
+
+    struct Column {
+        ColumnType type = ColumnType::Undefined;
+        // The QMetaType of all values for restoring QVariants
+        int metaType = 0;
+        std::vector<bool> nulls;
+        std::vector<qint64> integers;
+        std::vector<double> reals;
+        std::vector<int> strings;
+        std::vector<QVariant> variants;
+    };
+
+    static ColumnType columnTypeOf(int metaType);
+
+    void resizeColumn(Column* pColumn, int rowCount) const;
+    // Replaces the typed storage of the column with QVariants
+    void convertToVariants(Column* pColumn) const;
+    QVariant typedValue(const Column& column, int row) const;
+
+    int internString(const QString& str);
+
+    std::vector<Column> m_columns;
+    int m_rowCount;
+    QHash<TrackId, int> m_rowsByTrackId;
+    std::vector<int> m_freeRows;
+
+    // Interned strings are only released by clear(), i.e. when
+    // rebuilding the index
+    QVector<QString> m_strings;
+    QHash<QString, int> m_stringIds;
+    qint64 m_stringBytes;
+    mutable std::vector<std::optional<QCollatorSortKey>> m_sortKeys;
+
+    const mixxx::StringCollator m_collator;
+};
@@ -0,0 +1,211 @@
+#include "library/tracksearchindex.h"
+
+#include <algorithm>
+
+#include "util/assert.h"
+#include "util/db/dbconnection.h"
+#include "util/db/sqllikewildcards.h"
+
+namespace {
+
+// The posting lists are not rebuilt for a few updated tracks
+constexpr int kMinInvalidDocumentsForCompaction = 1024;
+
+} // anonymous namespace
+
+TrackSearchIndex::TrackSearchIndex(QStringList columns)
+        : m_columns(std::move(columns)),
+          m_invalidDocuments(0) {
+}
+
+// static
+void TrackSearchIndex::collectTrigrams(
+        const QString& value, std::vector<Trigram>* pTrigrams) {
+    for (int i = 2; i < value.size(); ++i) {
+        pTrigrams->push_back(
+                (static_cast<Trigram>(value[i - 2].unicode()) << 32) |
+                (static_cast<Trigram>(value[i - 1].unicode()) << 16) |
+                static_cast<Trigram>(value[i].unicode()));
+    }
+}
+
+bool TrackSearchIndex::columnIndices(
+        const QStringList& columns, QVector<int>* pIndices) const {
+    pIndices->reserve(columns.size());
+    for (const auto& column : columns) {
+        const int index = m_columns.indexOf(column);
+        if (index < 0) {
+            return false;
+        }
+        pIndices->append(index);
+    }
+    return true;
+}
+
+void TrackSearchIndex::updateTrack(TrackId trackId, const QStringList& values) {
+    DEBUG_ASSERT(trackId.isValid());
+    VERIFY_OR_DEBUG_ASSERT(values.size() == m_columns.size()) {
+        return;
+    }
+    invalidateDocument(trackId);
+    Document document;
+    document.trackId = trackId;
+    document.values.reserve(values.size());
+    for (QString value : values) {
+        mixxx::DbConnection::makeStringLatinLow(&value);
+        document.values.append(std::move(value));
+    }
+    const int documentNumber = static_cast<int>(m_documents.size());
+    m_documents.push_back(std::move(document));
+    m_documentsByTrackId.insert(trackId, documentNumber);
+    addPostings(documentNumber);
+    compactIfNeeded();
+}
+
+void TrackSearchIndex::removeTrack(TrackId trackId) {
+    invalidateDocument(trackId);
+    compactIfNeeded();
+}
+
+void TrackSearchIndex::clear() {
+    m_documents.clear();
+    m_documentsByTrackId.clear();
+    m_invalidDocuments = 0;
+    m_postings.clear();
+}
+
+void TrackSearchIndex::addPostings(int documentNumber) {
+    std::vector<Trigram> trigrams;
+    for (const auto& value : m_documents[documentNumber].values) {
+        collectTrigrams(value, &trigrams);
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    for (const auto trigram : trigrams) {
+        // Document numbers are ascending
+        m_postings[trigram].push_back(documentNumber);
+    }
+}
+
+void TrackSearchIndex::invalidateDocument(TrackId trackId) {
+    const auto i = m_documentsByTrackId.find(trackId);
+    if (i == m_documentsByTrackId.end()) {
+        return;
+    }
+    Document& document = m_documents[i.value()];
+    document.trackId = TrackId();
+    document.values.clear();
+    ++m_invalidDocuments;
+    m_documentsByTrackId.erase(i);
+}
+
+void TrackSearchIndex::compactIfNeeded() {
+    if (m_invalidDocuments < kMinInvalidDocumentsForCompaction ||
+            m_invalidDocuments < size()) {
+        return;
+    }
+    std::vector<Document> documents;
+    documents.reserve(size());
+    for (auto& document : m_documents) {
+        if (document.trackId.isValid()) {
+            documents.push_back(std::move(document));
+        }
+    }
+    m_documents = std::move(documents);
+    m_documentsByTrackId.clear();
+    m_invalidDocuments = 0;
+    m_postings.clear();
+    for (int i = 0; i < static_cast<int>(m_documents.size()); ++i) {
+        m_documentsByTrackId.insert(m_documents[i].trackId, i);
+        addPostings(i);
+    }
+}
+
+std::optional<QSet<TrackId>> TrackSearchIndex::matchText(
+        const QStringList& columns,
+        const QString& argument,
+        const QSet<TrackId>& candidates) const {
+    // SQL wildcards in the argument are not escaped by TextFilterNode
+    if (argument.contains(kSqlLikeMatchAll) || argument.contains(kSqlLikeMatchOne)) {
+        return std::nullopt;
+    }
+    QVector<int> indices;
+    if (!columnIndices(columns, &indices)) {
+        return std::nullopt;
+    }
+    QString foldedArgument = argument;
+    mixxx::DbConnection::makeStringLatinLow(&foldedArgument);
+    // TextFilterNode appends a wildcard that matches one character
+    // after a trailing space
+    const bool trailingSpace = !foldedArgument.isEmpty() &&
+            foldedArgument[foldedArgument.size() - 1].isSpace();
+    const auto matches = [&](const Document& document) {
+        for (const int index : indices) {
+            const QString& value = document.values[index];
+            int pos = value.indexOf(foldedArgument);
+            while (pos >= 0) {
+                if (!trailingSpace || pos + foldedArgument.size() < value.size()) {
+                    return true;
+                }
+                pos = value.indexOf(foldedArgument, pos + 1);
+            }
+        }
+        return false;
+    };
+
+    // Only documents that contain all trigrams of the argument might match.
+    // The shortest posting list restricts the documents that need to be
+    // verified.
+    std::vector<Trigram> trigrams;
+    collectTrigrams(foldedArgument, &trigrams);
+    const std::vector<int>* pShortestPostings = nullptr;
+    for (const auto trigram : trigrams) {
+        const auto i = m_postings.constFind(trigram);
+        if (i == m_postings.constEnd()) {
+            return QSet<TrackId>();
+        }
+        if (!pShortestPostings || i.value().size() < pShortestPostings->size()) {
+            pShortestPostings = &i.value();
+        }
+    }
+
+    QSet<TrackId> result;
+    if (pShortestPostings &&
+            pShortestPostings->size() < static_cast<std::size_t>(candidates.size())) {
+        for (const int documentNumber : *pShortestPostings) {
+            const Document& document = m_documents[documentNumber];
+            if (document.trackId.isValid() &&
+                    candidates.contains(document.trackId) &&
+                    matches(document)) {
+                result.insert(document.trackId);
+            }
+        }
+    } else {
+        for (const auto& trackId : candidates) {
+            const auto i = m_documentsByTrackId.constFind(trackId);
+            if (i != m_documentsByTrackId.constEnd() &&
+                    matches(m_documents[i.value()])) {
+                result.insert(trackId);
+            }
+        }
+    }
+    return result;
+}
+
+std::optional<QSet<TrackId>> TrackSearchIndex::matchNullOrEmpty(
+        const QString& column,
+        const QSet<TrackId>& candidates) const {
+    const int index = m_columns.indexOf(column);
+    if (index < 0) {
+        return std::nullopt;
+    }
+    QSet<TrackId> result;
+    for (const auto& trackId : candidates) {
+        const auto i = m_documentsByTrackId.constFind(trackId);
+        if (i != m_documentsByTrackId.constEnd() &&
+                m_documents[i.value()].values[index].isEmpty()) {
+            result.insert(trackId);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <optional>
+#include <vector>
+
+#include "track/trackid.h"
+
+/// In-memory trigram index for searching text columns of tracks.
+///
+/// Matches the semantics of the SQL query generated by TextFilterNode,
+/// i.e. a case-insensitive substring search after folding Latin
+/// characters with DbConnection::makeStringLatinLow().
+///
+/// The posting lists of trigrams are shared by all columns and contain
+/// ascending document numbers. Updating a track appends a new document
+/// and invalidates the previous one. The posting lists are rebuilt when
+/// the number of invalidated documents exceeds the number of valid ones.
+///
+/// Not thread-safe, all functions must be called from the same thread.
+class TrackSearchIndex final {
+  public:
+    explicit TrackSearchIndex(QStringList columns);
+
+    /// The names of the indexed columns
+    const QStringList& columns() const {
+        return m_columns;
+    }
+
+    /// The number of indexed tracks
+    int size() const {
+        return m_documentsByTrackId.size();
+    }
+
+    bool contains(TrackId trackId) const {
+        return m_documentsByTrackId.contains(trackId);
+    }
+
+    /// Adds or replaces a track. The values must be provided in the
+    /// same order as columns().
+    void updateTrack(TrackId trackId, const QStringList& values);
+
+    void removeTrack(TrackId trackId);
+
+    void clear();
+
+    /// Returns the candidates that contain the argument in any of the
+    /// given columns or std::nullopt if this cannot be decided by the
+    /// index, e.g. if a column is not indexed or if the argument contains
+    /// SQL wildcard characters.
+    std::optional<QSet<TrackId>> matchText(
+            const QStringList& columns,
+            const QString& argument,
+            const QSet<TrackId>& candidates) const;
+
+    /// Returns the candidates with a null or empty value in the column
+    /// or std::nullopt if the column is not indexed.
+    std::optional<QSet<TrackId>> matchNullOrEmpty(
+            const QString& column,
+            const QSet<TrackId>& candidates) const;
+
+  private:
+    struct Document {
+        // Invalid for documents that have been replaced or removed
+        TrackId trackId;
+        // Folded values
+        QVector<QString> values;
+    };
+
+    typedef quint64 Trigram;
+
+    static void collectTrigrams(const QString& value, std::vector<Trigram>* pTrigrams);
+
+    // Returns false if any column is not indexed
+    bool columnIndices(const QStringList& columns, QVector<int>* pIndices) const;
+
+    void addPostings(int documentNumber);
+    void invalidateDocument(TrackId trackId);
+    void compactIfNeeded();
+
+    const QStringList m_columns;
+
+    std::vector<Document> m_documents;
+    QHash<TrackId, int> m_documentsByTrackId;
+    int m_invalidDocuments;
+
+    QHash<Trigram, std::vector<int>> m_postings;
+};
@@ -113,6 +113,9 @@ class BasePlaylistFeature : public BaseTrackSetFeature {
 
     PlaylistTableModel* m_pPlaylistTableModel;
     QSet<int> m_playlistIdsOfSelectedTrack;
+    // Filled when constructing the child model from the same query as
+    // the labels, to avoid a query per child when decorating it
+    QSet<int> m_lockedPlaylistIds;
 
   private slots:
     void slotTrackSelected(TrackId trackId);
@@ -19,38 +19,22 @@ const QString CRATE_SUMMARY_VIEW = "crate_summary";
 const QString CRATESUMMARY_TRACK_COUNT = "track_count";
 const QString CRATESUMMARY_TRACK_DURATION = "track_duration";
 
-const QString kCrateTracksJoin =
-        QStringLiteral("LEFT JOIN %3 ON %3.%4=%1.%2")
-                .arg(CRATE_TABLE, CRATETABLE_ID, CRATE_TRACKS_TABLE, CRATETRACKSTABLE_CRATEID);
-
-const QString kLibraryTracksJoin = kCrateTracksJoin +
-        QStringLiteral(" LEFT JOIN %3 ON %3.%4=%1.%2")
-                .arg(CRATE_TRACKS_TABLE, CRATETRACKSTABLE_TRACKID, LIBRARY_TABLE, LIBRARYTABLE_ID);
-
-const QString kCrateSummaryViewSelect =
-        QStringLiteral(
-                "SELECT %1.*,"
-                "COUNT(CASE %2.%4 WHEN 0 THEN 1 ELSE NULL END) AS %5,"
-                "SUM(CASE %2.%4 WHEN 0 THEN %2.%3 ELSE 0 END) AS %6 "
-                "FROM %1")
-                .arg(
-                        CRATE_TABLE,
-                        LIBRARY_TABLE,
-                        LIBRARYTABLE_DURATION,
-                        LIBRARYTABLE_MIXXXDELETED,
-                        CRATESUMMARY_TRACK_COUNT,
-                        CRATESUMMARY_TRACK_DURATION);
+// The summaries are maintained by database triggers
+const QString CRATETABLE_SUMMARY_TRACK_COUNT = "summary_track_count";
+const QString CRATETABLE_SUMMARY_TRACK_DURATION = "summary_track_duration";
 
 const QString kCrateSummaryViewQuery =
         QStringLiteral(
-                "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS %2 %3 "
-                "GROUP BY %4.%5")
+                "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS "
+                "SELECT %2.*,%3 AS %4,MAX(%5,0) AS %6 "
+                "FROM %2")
                 .arg(
                         CRATE_SUMMARY_VIEW,
-                        kCrateSummaryViewSelect,
-                        kLibraryTracksJoin,
                         CRATE_TABLE,
-                        CRATETABLE_ID);
+                        CRATETABLE_SUMMARY_TRACK_COUNT,
+                        CRATESUMMARY_TRACK_COUNT,
+                        CRATETABLE_SUMMARY_TRACK_DURATION,
+                        CRATESUMMARY_TRACK_DURATION);
 
 class CrateQueryBinder final {
   public:
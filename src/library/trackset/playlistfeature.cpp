@@ -3,6 +3,7 @@
 #include <QFile>
 #include <QMenu>
 #include <QtDebug>
+#include <algorithm>
 
 #include "controllers/keyboard/keyboardeventfilter.h"
 #include "library/library.h"
@@ -129,100 +130,54 @@ QList<BasePlaylistFeature::IdAndLabel> PlaylistFeature::createPlaylistLabels() {
     QSqlDatabase database =
             m_pLibrary->trackCollectionManager()->internalCollection()->database();
 
-    QList<BasePlaylistFeature::IdAndLabel> playlistLabels;
+    // The summaries are maintained by database triggers
     QString queryString = QStringLiteral(
-            "CREATE TEMPORARY VIEW IF NOT EXISTS PlaylistsCountsDurations "
-            "AS SELECT "
-            "  Playlists.id AS id, "
-            "  Playlists.name AS name, "
-            "  LOWER(Playlists.name) AS sort_name, "
-            "  COUNT(case library.mixxx_deleted when 0 then 1 else null end) "
-            "    AS count, "
-            "  SUM(case library.mixxx_deleted "
-            "    when 0 then library.duration else 0 end) AS durationSeconds "
-            "FROM Playlists "
-            "LEFT JOIN PlaylistTracks "
-            "  ON PlaylistTracks.playlist_id = Playlists.id "
-            "LEFT JOIN library "
-            "  ON PlaylistTracks.track_id = library.id "
-            "  WHERE Playlists.hidden = 0 "
-            "  GROUP BY Playlists.id");
+            "SELECT id,name,locked,summary_track_count,summary_track_duration "
+            "FROM Playlists WHERE hidden=0");
     queryString.append(
             mixxx::DbConnection::collateLexicographically(
-                    " ORDER BY sort_name"));
+                    " ORDER BY LOWER(name)"));
     QSqlQuery query(database);
+    query.setForwardOnly(true);
     if (!query.exec(queryString)) {
         LOG_FAILED_QUERY(query);
     }
 
-    // Setup the sidebar playlist model
-    QSqlTableModel playlistTableModel(this, database);
-    playlistTableModel.setTable("PlaylistsCountsDurations");
-    playlistTableModel.select();
-    while (playlistTableModel.canFetchMore()) {
-        playlistTableModel.fetchMore();
-    }
-    QSqlRecord record = playlistTableModel.record();
-    int nameColumn = record.indexOf("name");
-    int idColumn = record.indexOf("id");
-    int countColumn = record.indexOf("count");
-    int durationColumn = record.indexOf("durationSeconds");
-
-    for (int row = 0; row < playlistTableModel.rowCount(); ++row) {
-        int id =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, idColumn))
-                        .toInt();
-        QString name =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, nameColumn))
-                        .toString();
-        int count =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, countColumn))
-                        .toInt();
-        int duration =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, durationColumn))
-                        .toInt();
+    m_lockedPlaylistIds.clear();
+    QList<BasePlaylistFeature::IdAndLabel> playlistLabels;
+    while (query.next()) {
+        const int id = query.value(0).toInt();
+        if (query.value(2).toBool()) {
+            m_lockedPlaylistIds.insert(id);
+        }
         BasePlaylistFeature::IdAndLabel idAndLabel;
         idAndLabel.id = id;
-        idAndLabel.label = createPlaylistLabel(name, count, duration);
+        idAndLabel.label = createPlaylistLabel(
+                query.value(1).toString(),
+                query.value(3).toInt(),
+                std::max(query.value(4).toInt(), 0));
         playlistLabels.append(idAndLabel);
     }
     return playlistLabels;
 }
 
 QString PlaylistFeature::fetchPlaylistLabel(int playlistId) {
-    // Setup the sidebar playlist model
     QSqlDatabase database =
             m_pLibrary->trackCollectionManager()->internalCollection()->database();
-    QSqlTableModel playlistTableModel(this, database);
-    playlistTableModel.setTable("PlaylistsCountsDurations");
-    QString filter = "id=" + QString::number(playlistId);
-    playlistTableModel.setFilter(filter);
-    playlistTableModel.select();
-    while (playlistTableModel.canFetchMore()) {
-        playlistTableModel.fetchMore();
+    QSqlQuery query(database);
+    query.prepare(QStringLiteral(
+            "SELECT name,summary_track_count,summary_track_duration "
+            "FROM Playlists WHERE id=:id"));
+    query.bindValue(":id", playlistId);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return QString();
     }
-    QSqlRecord record = playlistTableModel.record();
-    int nameColumn = record.indexOf("name");
-    int countColumn = record.indexOf("count");
-    int durationColumn = record.indexOf("durationSeconds");
-
-    DEBUG_ASSERT(playlistTableModel.rowCount() <= 1);
-    if (playlistTableModel.rowCount() > 0) {
-        QString name =
-                playlistTableModel.data(playlistTableModel.index(0, nameColumn))
-                        .toString();
-        int count = playlistTableModel
-                            .data(playlistTableModel.index(0, countColumn))
-                            .toInt();
-        int duration =
-                playlistTableModel
-                        .data(playlistTableModel.index(0, durationColumn))
-                        .toInt();
-        return createPlaylistLabel(name, count, duration);
+    if (query.next()) {
+        return createPlaylistLabel(
+                query.value(0).toString(),
+                query.value(1).toInt(),
+                std::max(query.value(2).toInt(), 0));
     }
     return QString();
 }
@@ -265,7 +220,7 @@ QModelIndex PlaylistFeature::constructChildModel(int selectedId) {
 }
 
 void PlaylistFeature::decorateChild(TreeItem* item, int playlistId) {
-    if (m_playlistDao.isPlaylistLocked(playlistId)) {
+    if (m_lockedPlaylistIds.contains(playlistId)) {
         item->setIcon(
                 QIcon(":/images/library/ic_library_locked_tracklist.svg"));
     } else {
@@ -178,7 +178,9 @@ QModelIndex SetlogFeature::constructChildModel(int selectedId) {
     int nameColumn = record.indexOf("name");
     int idColumn = record.indexOf("id");
     int createdColumn = record.indexOf("date_created");
+    int lockedColumn = record.indexOf("locked");
 
+    m_lockedPlaylistIds.clear();
     QMap<int, TreeItem*> groups;
 
     QList<TreeItem*> itemList;
@@ -198,6 +200,11 @@ QModelIndex SetlogFeature::constructChildModel(int selectedId) {
                 playlistTableModel
                         .data(playlistTableModel.index(row, createdColumn))
                         .toDateTime();
+        if (playlistTableModel
+                        .data(playlistTableModel.index(row, lockedColumn))
+                        .toBool()) {
+            m_lockedPlaylistIds.insert(id);
+        }
 
         // Create the TreeItem whose parent is the invisible root item
         if (row >= kNumToplevelHistoryEntries) {
@@ -263,7 +270,7 @@ QString SetlogFeature::fetchPlaylistLabel(int playlistId) {
 void SetlogFeature::decorateChild(TreeItem* item, int playlistId) {
     if (playlistId == m_playlistId) {
         item->setIcon(QIcon(":/images/library/ic_library_history_current.svg"));
-    } else if (m_playlistDao.isPlaylistLocked(playlistId)) {
+    } else if (m_lockedPlaylistIds.contains(playlistId)) {
         item->setIcon(QIcon(":/images/library/ic_library_locked.svg"));
     } else {
         item->setIcon(QIcon());
@@ -4,31 +4,94 @@
 #include <QStringList>
 #include <QTextCodec>
 #include <QThread>
+#include <QTimer>
 #include <QtDebug>
+#include <csignal>
 
 #include "config.h"
 #include "coreservices.h"
 #include "errordialoghandler.h"
 #include "mixxxapplication.h"
+#include "preferences/dialog/dlgpreferences.h"
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 #include "qml/qmlapplication.h"
 #else
 #include "mixxxmainwindow.h"
 #endif
+#include "soundio/soundmanager.h"
 #include "sources/soundsourceproxy.h"
 #include "util/cmdlineargs.h"
 #include "util/console.h"
 #include "util/logging.h"
+#include "util/rtsafety.h"
 #include "util/versionstore.h"
 
 namespace {
 
 // Exit codes
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
 constexpr int kFatalErrorOnStartupExitCode = 1;
-#endif
 constexpr int kParseCmdlineArgsErrorExitCode = 2;
 
+// How often a headless instance checks if it has been asked to quit
+constexpr int kHeadlessQuitPollIntervalMillis = 100;
+
+volatile std::sig_atomic_t s_headlessQuitRequested = 0;
+
+void requestHeadlessQuit(int signal) {
+    Q_UNUSED(signal);
+    // Only async-signal-safe operations are permitted here
+    s_headlessQuitRequested = 1;
+}
+
+/// Runs Mixxx without a user interface. Neither the skin and the waveforms
+/// nor any library widgets are created.
+int runHeadless(MixxxApplication* pApp,
+        const std::shared_ptr<mixxx::CoreServices>& pCoreServices) {
+    pCoreServices->initialize(pApp);
+    if (ErrorDialogHandler::instance()->checkError()) {
+        return kFatalErrorOnStartupExitCode;
+    }
+
+    const SoundDeviceError result = pCoreServices->getSoundManager()->setupDevices();
+    if (result != SOUNDDEVICE_ERROR_OK) {
+        qCritical() << "Error setting up sound devices" << result;
+        return kFatalErrorOnStartupExitCode;
+    }
+
+    // FIXME: DlgPreferences has some initialization logic that must be
+    // executed, at least for the effects system. Like for the QML GUI it is
+    // created without a skin loader, but never shown.
+    DlgPreferences preferences(
+            pCoreServices->getScreensaverManager(),
+            nullptr,
+            pCoreServices->getSoundManager(),
+            pCoreServices->getControllerManager(),
+            pCoreServices->getVinylControlManager(),
+            pCoreServices->getEffectsManager(),
+            pCoreServices->getSettingsManager(),
+            pCoreServices->getLibrary());
+    preferences.setHidden(true);
+
+    // Quit the event loop regularly instead of being killed, so that the
+    // library and the settings are saved on shutdown.
+    std::signal(SIGINT, requestHeadlessQuit);
+    std::signal(SIGTERM, requestHeadlessQuit);
+    QTimer quitPollTimer;
+    QObject::connect(&quitPollTimer,
+            &QTimer::timeout,
+            pApp,
+            [pApp]() {
+                if (s_headlessQuitRequested) {
+                    qInfo() << "Quitting headless Mixxx";
+                    pApp->quit();
+                }
+            });
+    quitPollTimer.start(kHeadlessQuitPollIntervalMillis);
+
+    qInfo() << "Running Mixxx headless";
+    return pApp->exec();
+}
+
 constexpr char kScaleFactorEnvVar[] = "QT_SCALE_FACTOR";
 const QString kConfigGroup = QStringLiteral("[Config]");
 const QString kScaleFactorKey = QStringLiteral("ScaleFactor");
@@ -38,6 +101,10 @@ int runMixxx(MixxxApplication* pApp, const CmdlineArgs& args) {
 
     CmdlineArgs::Instance().parseForUserFeedback();
 
+    if (args.getHeadless()) {
+        return runHeadless(pApp, pCoreServices);
+    }
+
     int exitCode;
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
     mixxx::qml::QmlApplication qmlApplication(pApp, pCoreServices);
@@ -146,6 +213,12 @@ int main(int argc, char * argv[]) {
         return kParseCmdlineArgsErrorExitCode;
     }
 
+#ifdef MIXXX_RTSAFETY_CHECKS
+    // Builds with the checks are only meant for debugging, so they always
+    // report the violations of the audio callback
+    mixxx::RtSafety::setEnabled(true);
+#endif
+
     // If you change this here, you also need to change it in
     // ErrorDialogHandler::errorDialog(). TODO(XXX): Remove this hack.
     QThread::currentThread()->setObjectName("Main");
@@ -82,6 +82,10 @@ BaseTrackPlayerImpl::BaseTrackPlayerImpl(
             &EngineBuffer::trackLoadFailed,
             this,
             &BaseTrackPlayerImpl::slotLoadFailed);
+    connect(pEngineBuffer,
+            &EngineBuffer::provisionalReplayGainChanged,
+            this,
+            &BaseTrackPlayerImpl::slotSetProvisionalReplayGain);
 
     m_pEject = std::make_unique<ControlPushButton>(ConfigKey(getGroup(), "eject"));
     connect(m_pEject.get(),
@@ -664,6 +668,19 @@ void BaseTrackPlayerImpl::slotAdjustReplayGain(mixxx::ReplayGain replayGain) {
     }
 }
 
+void BaseTrackPlayerImpl::slotSetProvisionalReplayGain(TrackPointer pTrack, double ratio) {
+    if (!m_pLoadedTrack || pTrack != m_pLoadedTrack ||
+            m_pLoadedTrack->getReplayGain().hasRatio()) {
+        // Outdated or already replaced by the result of the analysis
+        return;
+    }
+    // The first estimate is faded in by EnginePregain, but refining it
+    // while playing would cause an unexpected volume change.
+    if (m_pReplayGain->get() == 0.0 || m_pPlay->get() == 0.0) {
+        setReplayGain(ratio);
+    }
+}
+
 void BaseTrackPlayerImpl::slotSetTrackColor(const mixxx::RgbColor::optional_t& color) {
     m_pTrackColor->forceSet(trackColorToDouble(color));
 }
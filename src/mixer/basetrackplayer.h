@@ -88,6 +88,9 @@ class BaseTrackPlayerImpl : public BaseTrackPlayer {
     // When the replaygain is adjusted, we modify the track pregain
     // to compensate so there is no audible change in volume.
     void slotAdjustReplayGain(mixxx::ReplayGain replayGain);
+    // Applies a loudness estimate of the reader until the track has been
+    // analyzed
+    void slotSetProvisionalReplayGain(TrackPointer pTrack, double ratio);
     void slotSetTrackColor(const mixxx::RgbColor::optional_t& color);
     void slotPlayToggled(double);
 
@@ -28,6 +28,10 @@ const mixxx::Logger kLogger("PlayerManager");
 // Utilize half of the available cores for adhoc analysis of tracks
 const int kNumberOfAnalyzerThreads = math_max(1, QThread::idealThreadCount() / 2);
 
+// Loaded tracks are analyzed in two tiers: The waveform is analyzed first,
+// followed by the expensive beat and key detection at a lower priority.
+const ConfigKey kAnalysisPreviewTierConfigKey("[Library]", "AnalysisPreviewTier");
+
 const QRegularExpression kDeckRegex(QStringLiteral("^\\[Channel(\\d+)\\]$"));
 const QRegularExpression kSamplerRegex(QStringLiteral("^\\[Sampler(\\d+)\\]$"));
 const QRegularExpression kPreviewDeckRegex(QStringLiteral("^\\[PreviewDeck(\\d+)\\]$"));
@@ -112,7 +116,10 @@ PlayerManager::PlayerManager(UserSettingsPointer pConfig,
                   ConfigKey("[Master]", "num_microphones"), true, true)),
           m_pCONumAuxiliaries(new ControlObject(
                   ConfigKey("[Master]", "num_auxiliaries"), true, true)),
-          m_pTrackAnalysisScheduler(TrackAnalysisScheduler::NullPointer()) {
+          m_pTrackAnalysisScheduler(TrackAnalysisScheduler::NullPointer()),
+          m_pDeferredTrackAnalysisScheduler(TrackAnalysisScheduler::NullPointer()),
+          m_trackAnalysisPending(false),
+          m_deferredTrackAnalysisPending(false) {
     m_pCONumDecks->connectValueChangeRequest(this,
             &PlayerManager::slotChangeNumDecks, Qt::DirectConnection);
     m_pCONumSamplers->connectValueChangeRequest(this,
@@ -159,6 +166,10 @@ PlayerManager::~PlayerManager() {
         m_pTrackAnalysisScheduler->stop();
         m_pTrackAnalysisScheduler.reset();
     }
+    if (m_pDeferredTrackAnalysisScheduler) {
+        m_pDeferredTrackAnalysisScheduler->stop();
+        m_pDeferredTrackAnalysisScheduler.reset();
+    }
 }
 
 void PlayerManager::bindToLibrary(Library* pLibrary) {
@@ -175,9 +186,27 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
             &Library::slotLoadLocationToPlayer);
 
     DEBUG_ASSERT(!m_pTrackAnalysisScheduler);
-    m_pTrackAnalysisScheduler = pLibrary->createTrackAnalysisScheduler(
-            kNumberOfAnalyzerThreads,
-            AnalyzerModeFlags::WithWaveform);
+    DEBUG_ASSERT(!m_pDeferredTrackAnalysisScheduler);
+    if (m_pConfig->getValue(kAnalysisPreviewTierConfigKey, true)) {
+        m_pTrackAnalysisScheduler = pLibrary->createTrackAnalysisScheduler(
+                kNumberOfAnalyzerThreads,
+                static_cast<AnalyzerModeFlags>(
+                        AnalyzerModeFlags::WithWaveform |
+                        AnalyzerModeFlags::PreviewTier));
+        m_pDeferredTrackAnalysisScheduler = pLibrary->createTrackAnalysisScheduler(
+                kNumberOfAnalyzerThreads,
+                static_cast<AnalyzerModeFlags>(
+                        AnalyzerModeFlags::DeferredTier |
+                        AnalyzerModeFlags::LowPriority));
+        connect(m_pDeferredTrackAnalysisScheduler.get(),
+                &TrackAnalysisScheduler::finished,
+                this,
+                &PlayerManager::onDeferredTrackAnalysisFinished);
+    } else {
+        m_pTrackAnalysisScheduler = pLibrary->createTrackAnalysisScheduler(
+                kNumberOfAnalyzerThreads,
+                AnalyzerModeFlags::WithWaveform);
+    }
 
     connect(m_pTrackAnalysisScheduler.get(), &TrackAnalysisScheduler::trackProgress,
             this, &PlayerManager::onTrackAnalysisProgress);
@@ -738,6 +767,12 @@ void PlayerManager::slotAnalyzeTrack(TrackPointer track) {
     }
     if (m_pTrackAnalysisScheduler) {
         if (m_pTrackAnalysisScheduler->scheduleTrackById(track->getId())) {
+            if (m_pDeferredTrackAnalysisScheduler) {
+                // The waveform of the loaded track is needed immediately, while
+                // beat and key detection of previously loaded tracks can wait
+                m_pDeferredTrackAnalysisScheduler->suspend();
+            }
+            m_trackAnalysisPending = true;
             m_pTrackAnalysisScheduler->resume();
         }
         // The first progress signal will suspend a running batch analysis
@@ -755,9 +790,33 @@ void PlayerManager::slotSaveEjectedTrack(TrackPointer track) {
 }
 
 void PlayerManager::onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress analyzerProgress) {
+    if (m_pDeferredTrackAnalysisScheduler &&
+            analyzerProgress == kAnalyzerProgressDone) {
+        // Continue with the expensive analyzers after the preview tier has
+        // finished. The deferred analysis is resumed when the preview tier
+        // becomes idle.
+        if (m_pDeferredTrackAnalysisScheduler->scheduleTrackById(trackId)) {
+            m_deferredTrackAnalysisPending = true;
+        }
+    }
     emit trackAnalyzerProgress(trackId, analyzerProgress);
 }
 
 void PlayerManager::onTrackAnalysisFinished() {
+    m_trackAnalysisPending = false;
+    if (m_deferredTrackAnalysisPending) {
+        // The batch analysis of the library remains suspended
+        // until the deferred analysis has finished, too.
+        m_pDeferredTrackAnalysisScheduler->resume();
+        return;
+    }
+    emit trackAnalyzerIdle();
+}
+
+void PlayerManager::onDeferredTrackAnalysisFinished() {
+    m_deferredTrackAnalysisPending = false;
+    if (m_trackAnalysisPending) {
+        return;
+    }
     emit trackAnalyzerIdle();
 }
@@ -221,6 +221,7 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
 
     void onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress analyzerProgress);
     void onTrackAnalysisFinished();
+    void onDeferredTrackAnalysisFinished();
 
   signals:
     void loadLocationToPlayer(const QString& location, const QString& group, bool play);
@@ -285,6 +286,11 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
     parented_ptr<ControlProxy> m_pAutoDjEnabled;
 
     TrackAnalysisScheduler::Pointer m_pTrackAnalysisScheduler;
+    // Optional, runs the expensive analyzers after the waveform
+    // of a loaded track is available
+    TrackAnalysisScheduler::Pointer m_pDeferredTrackAnalysisScheduler;
+    bool m_trackAnalysisPending;
+    bool m_deferredTrackAnalysisPending;
 
     TrackId m_lastEjectedTrackId;
 
@@ -1,7 +1,5 @@
 #include "musicbrainz/chromaprinter.h"
 
-#include <chromaprint.h>
-
 #include <QtDebug>
 #include <vector>
 
@@ -25,12 +23,6 @@ namespace
     typedef void* char_p;
 #endif
 
-// this is worth 2min of audio
-// AcoustID only stores a fingerprint for the first two minutes of a song
-// on their server so we need only a fingerprint of the first two minutes
-// --kain88 July 2012
-    constexpr SINT kFingerprintDuration = 120; // in seconds
-
 QString calcFingerprint(
         mixxx::AudioSourceStereoProxy& audioSourceProxy,
         mixxx::IndexRange fingerprintRange) {
@@ -80,6 +72,24 @@ QString calcFingerprint(
         return QString();
     }
 
+    const QString fingerprint = ChromaPrinter::encodeFingerprint(ctx);
+    chromaprint_free(ctx);
+
+    qDebug() << "generating fingerprint took"
+             << timerGeneratingFingerprint.elapsed().debugMillisWithUnit();
+
+    return fingerprint;
+}
+
+} // anonymous namespace
+
+// static
+QString ChromaPrinter::fingerprintVersion() {
+    return QString::number(CHROMAPRINT_ALGORITHM_DEFAULT);
+}
+
+// static
+QString ChromaPrinter::encodeFingerprint(ChromaprintContext* ctx) {
     uint32_p fprint = nullptr;
     int size = 0;
     int ret = chromaprint_get_raw_fingerprint(ctx, &fprint, &size);
@@ -97,16 +107,9 @@ QString calcFingerprint(
         chromaprint_dealloc(fprint);
         chromaprint_dealloc(encoded);
     }
-    chromaprint_free(ctx);
-
-    qDebug() << "generating fingerprint took"
-             << timerGeneratingFingerprint.elapsed().debugMillisWithUnit();
-
     return fingerprint;
 }
 
-} // anonymous namespace
-
 ChromaPrinter::ChromaPrinter(QObject* parent)
              : QObject(parent) {
 }
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <chromaprint.h>
+
 #include <QObject>
 
 #include "track/track_decl.h"
+#include "util/types.h"
 
 class ChromaPrinter: public QObject {
   Q_OBJECT
@@ -10,4 +13,16 @@ class ChromaPrinter: public QObject {
 public:
       explicit ChromaPrinter(QObject* parent = NULL);
       QString getFingerprint(TrackPointer pTrack);
+
+      // AcoustID only stores a fingerprint for the first two minutes of
+      // a song on their server, so we need only a fingerprint of the
+      // first two minutes.
+      static constexpr SINT kFingerprintDuration = 120; // in seconds
+
+      // Identifies the algorithm of stored fingerprints
+      static QString fingerprintVersion();
+
+      // Returns the encoded fingerprint of all samples that have been
+      // fed into the finished context, or an empty string on failure.
+      static QString encodeFingerprint(ChromaprintContext* ctx);
 };
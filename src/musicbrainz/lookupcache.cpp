@@ -0,0 +1,163 @@
+#include "musicbrainz/lookupcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace musicbrainz {
+
+namespace {
+
+const Logger kLogger("LookupCache");
+
+const QString kAcoustIdDirectoryName = QStringLiteral("acoustid");
+const QString kRecordingsDirectoryName = QStringLiteral("recordings");
+
+// The databases are edited continuously, so the entries are not
+// kept forever
+constexpr qint64 kMaxAgeSeconds = 30 * 24 * 60 * 60;
+
+bool isCached(const QString& filePath) {
+    if (filePath.isEmpty()) {
+        return false;
+    }
+    const QFileInfo fileInfo(filePath);
+    return fileInfo.exists() &&
+            fileInfo.lastModified().secsTo(QDateTime::currentDateTime()) <=
+            kMaxAgeSeconds;
+}
+
+QByteArray readFile(const QString& filePath) {
+    if (!isCached(filePath)) {
+        return QByteArray();
+    }
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        kLogger.warning() << "Failed to open" << filePath;
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void writeFile(const QString& filePath, const QByteArray& data) {
+    if (filePath.isEmpty()) {
+        return;
+    }
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) ||
+            file.write(data) != data.size() ||
+            !file.commit()) {
+        kLogger.warning() << "Failed to write" << filePath;
+    }
+}
+
+QString filePath(
+        const QString& directoryPath,
+        const QString& subdirectoryName,
+        const QString& fileName) {
+    if (directoryPath.isEmpty()) {
+        return QString();
+    }
+    return directoryPath + QChar('/') + subdirectoryName + QChar('/') + fileName;
+}
+
+QString fingerprintFileName(const QString& fingerprint, int durationSeconds) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(fingerprint.toLatin1());
+    hash.addData(QByteArray::number(durationSeconds));
+    return QString::fromLatin1(hash.result().toHex()) + QStringLiteral(".txt");
+}
+
+QString recordingFileName(const QUuid& recordingId) {
+    return recordingId.toString(QUuid::WithoutBraces) + QStringLiteral(".xml");
+}
+
+} // anonymous namespace
+
+// static
+QString LookupCache::s_directoryPath;
+
+// static
+void LookupCache::setDirectory(const QString& directoryPath) {
+    if (!directoryPath.isEmpty()) {
+        const QDir dir(directoryPath);
+        if (!dir.mkpath(kAcoustIdDirectoryName) || !dir.mkpath(kRecordingsDirectoryName)) {
+            kLogger.warning() << "Failed to create directory" << directoryPath;
+            s_directoryPath.clear();
+            return;
+        }
+    }
+    s_directoryPath = directoryPath;
+}
+
+// static
+std::optional<QList<QUuid>> LookupCache::loadRecordingIds(
+        const QString& fingerprint,
+        int durationSeconds) {
+    const QString path = filePath(s_directoryPath,
+            kAcoustIdDirectoryName,
+            fingerprintFileName(fingerprint, durationSeconds));
+    // An empty file is a valid empty result
+    if (!isCached(path)) {
+        return std::nullopt;
+    }
+    const QByteArray data = readFile(path);
+    QList<QUuid> recordingIds;
+    const QList<QByteArray> lines = data.split('\n');
+    for (const QByteArray& line : lines) {
+        if (line.isEmpty()) {
+            continue;
+        }
+        const QUuid recordingId = QUuid::fromString(QLatin1String(line));
+        if (recordingId.isNull()) {
+            kLogger.warning() << "Ignoring invalid cache file" << path;
+            return std::nullopt;
+        }
+        recordingIds.append(recordingId);
+    }
+    return recordingIds;
+}
+
+// static
+void LookupCache::storeRecordingIds(
+        const QString& fingerprint,
+        int durationSeconds,
+        const QList<QUuid>& recordingIds) {
+    QByteArray data;
+    for (const QUuid& recordingId : recordingIds) {
+        data.append(recordingId.toByteArray(QUuid::WithoutBraces)).append('\n');
+    }
+    writeFile(filePath(s_directoryPath,
+                      kAcoustIdDirectoryName,
+                      fingerprintFileName(fingerprint, durationSeconds)),
+            data);
+}
+
+// static
+QByteArray LookupCache::loadRecording(
+        const QUuid& recordingId) {
+    return readFile(filePath(s_directoryPath,
+            kRecordingsDirectoryName,
+            recordingFileName(recordingId)));
+}
+
+// static
+void LookupCache::storeRecording(
+        const QUuid& recordingId,
+        const QByteArray& xmlResponse) {
+    writeFile(filePath(s_directoryPath,
+                      kRecordingsDirectoryName,
+                      recordingFileName(recordingId)),
+            xmlResponse);
+}
+
+} // namespace musicbrainz
+
+} // namespace mixxx
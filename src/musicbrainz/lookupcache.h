@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QUuid>
+#include <optional>
+
+namespace mixxx {
+
+namespace musicbrainz {
+
+/// Stores the results of AcoustID and MusicBrainz lookups on disk, so
+/// looking up the same tracks again does not send any requests until
+/// the entries expire.
+///
+/// AcoustID results are stored as the list of recording ids for the
+/// fingerprint and duration of a track, MusicBrainz results as the
+/// XML response for a recording id.
+class LookupCache {
+  public:
+    /// Enables the cache. Must be called before the first lookup,
+    /// an empty path disables it.
+    static void setDirectory(const QString& directoryPath);
+
+    /// Returns std::nullopt if the fingerprint has not been looked up
+    /// before, which is different from an empty result.
+    static std::optional<QList<QUuid>> loadRecordingIds(
+            const QString& fingerprint,
+            int durationSeconds);
+    static void storeRecordingIds(
+            const QString& fingerprint,
+            int durationSeconds,
+            const QList<QUuid>& recordingIds);
+
+    /// Returns an empty array if the recording is not cached.
+    static QByteArray loadRecording(
+            const QUuid& recordingId);
+    static void storeRecording(
+            const QUuid& recordingId,
+            const QByteArray& xmlResponse);
+
+  private:
+    static QString s_directoryPath;
+};
+
+} // namespace musicbrainz
+
+} // namespace mixxx
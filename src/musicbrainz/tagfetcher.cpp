@@ -1,10 +1,14 @@
 #include "musicbrainz/tagfetcher.h"
 
 #include <QFuture>
+#include <QSet>
+#include <QXmlStreamReader>
 #include <QtConcurrentRun>
 
 #include "moc_tagfetcher.cpp"
 #include "musicbrainz/chromaprinter.h"
+#include "musicbrainz/lookupcache.h"
+#include "musicbrainz/musicbrainzxml.h"
 #include "track/track.h"
 #include "util/thread_affinity.h"
 
@@ -16,6 +20,22 @@ constexpr int kAcoustIdTimeoutMillis = 60000; // msec
 // Long timeout to cope with occasional server-side unresponsiveness
 constexpr int kMusicBrainzTimeoutMillis = 60000; // msec
 
+// The same release might be found through multiple recordings
+void appendTrackReleases(
+        QList<mixxx::musicbrainz::TrackRelease>* pTrackReleases,
+        const QList<mixxx::musicbrainz::TrackRelease>& newTrackReleases) {
+    QSet<QUuid> trackReleaseIds;
+    for (const auto& trackRelease : qAsConst(*pTrackReleases)) {
+        trackReleaseIds.insert(trackRelease.trackReleaseId);
+    }
+    for (const auto& trackRelease : newTrackReleases) {
+        if (!trackReleaseIds.contains(trackRelease.trackReleaseId)) {
+            trackReleaseIds.insert(trackRelease.trackReleaseId);
+            pTrackReleases->append(trackRelease);
+        }
+    }
+}
+
 } // anonymous namespace
 
 TagFetcher::TagFetcher(QObject* parent)
@@ -24,12 +44,19 @@ TagFetcher::TagFetcher(QObject* parent)
 }
 
 void TagFetcher::startFetch(
-        TrackPointer pTrack) {
+        TrackPointer pTrack,
+        const QString& fingerprint) {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
     cancel();
 
     m_pTrack = pTrack;
 
+    if (!fingerprint.isEmpty()) {
+        // Stored by the analysis, no need to decode the track again
+        lookupFingerprint(fingerprint);
+        return;
+    }
+
     emit fetchProgress(tr("Fingerprinting track"));
     const auto fingerprintTask = QtConcurrent::run([pTrack] {
         return ChromaPrinter().getFingerprint(pTrack);
@@ -46,6 +73,8 @@ void TagFetcher::startFetch(
 void TagFetcher::cancel() {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
     m_pTrack.reset();
+    m_fingerprint.clear();
+    m_cachedTrackReleases.clear();
     m_fingerprintWatcher.disconnect(this);
     m_fingerprintWatcher.cancel();
     if (m_pAcoustIdTask) {
@@ -66,7 +95,11 @@ void TagFetcher::slotFingerprintReady() {
     }
 
     DEBUG_ASSERT(m_fingerprintWatcher.isFinished());
-    const QString fingerprint = m_fingerprintWatcher.result();
+    lookupFingerprint(m_fingerprintWatcher.result());
+}
+
+void TagFetcher::lookupFingerprint(const QString& fingerprint) {
+    DEBUG_ASSERT(m_pTrack);
     if (fingerprint.isEmpty()) {
         emit resultAvailable(
                 m_pTrack,
@@ -74,6 +107,15 @@ void TagFetcher::slotFingerprintReady() {
         return;
     }
 
+    auto cachedRecordingIds = mixxx::musicbrainz::LookupCache::loadRecordingIds(
+            fingerprint,
+            m_pTrack->getDurationSecondsInt());
+    if (cachedRecordingIds) {
+        lookupRecordings(std::move(*cachedRecordingIds));
+        return;
+    }
+    m_fingerprint = fingerprint;
+
     emit fetchProgress(tr("Identifying track through Acoustid"));
     DEBUG_ASSERT(!m_pAcoustIdTask);
     m_pAcoustIdTask = make_parented<mixxx::AcoustIdLookupTask>(
@@ -113,13 +155,40 @@ void TagFetcher::slotAcoustIdTaskSucceeded(
     const auto taskDeleter = mixxx::ScopedDeleteLater(pAcoustIdTask);
     pAcoustIdTask->disconnect(this);
 
-    if (recordingIds.isEmpty()) {
+    DEBUG_ASSERT(m_pTrack);
+    mixxx::musicbrainz::LookupCache::storeRecordingIds(
+            m_fingerprint,
+            m_pTrack->getDurationSecondsInt(),
+            recordingIds);
+    lookupRecordings(std::move(recordingIds));
+}
+
+void TagFetcher::lookupRecordings(QList<QUuid>&& recordingIds) {
+    QList<QUuid> uncachedRecordingIds;
+    for (const QUuid& recordingId : qAsConst(recordingIds)) {
+        const QByteArray xmlResponse =
+                mixxx::musicbrainz::LookupCache::loadRecording(recordingId);
+        if (xmlResponse.isEmpty()) {
+            uncachedRecordingIds.append(recordingId);
+            continue;
+        }
+        QXmlStreamReader reader(xmlResponse);
+        auto recordingsResult = mixxx::musicbrainz::parseRecordings(reader);
+        if (!recordingsResult.second) {
+            uncachedRecordingIds.append(recordingId);
+            continue;
+        }
+        appendTrackReleases(&m_cachedTrackReleases, recordingsResult.first);
+    }
+
+    if (uncachedRecordingIds.isEmpty()) {
         auto pTrack = std::move(m_pTrack);
+        auto trackReleases = std::move(m_cachedTrackReleases);
         cancel();
 
         emit resultAvailable(
                 std::move(pTrack),
-                QList<mixxx::musicbrainz::TrackRelease>());
+                std::move(trackReleases));
         return;
     }
 
@@ -127,7 +196,7 @@ void TagFetcher::slotAcoustIdTaskSucceeded(
     DEBUG_ASSERT(!m_pMusicBrainzTask);
     m_pMusicBrainzTask = make_parented<mixxx::MusicBrainzRecordingsTask>(
             &m_network,
-            std::move(recordingIds),
+            std::move(uncachedRecordingIds),
             this);
     connect(m_pMusicBrainzTask,
             &mixxx::MusicBrainzRecordingsTask::succeeded,
@@ -275,9 +344,12 @@ void TagFetcher::slotMusicBrainzTaskSucceeded(
     }
 
     auto pTrack = std::move(m_pTrack);
+    auto trackReleases = std::move(m_cachedTrackReleases);
     cancel();
 
+    appendTrackReleases(&trackReleases, guessedTrackReleases);
+
     emit resultAvailable(
             std::move(pTrack),
-            std::move(guessedTrackReleases));
+            std::move(trackReleases));
 }
@@ -21,8 +21,10 @@ class TagFetcher : public QObject {
             QObject* parent = nullptr);
     ~TagFetcher() override = default;
 
+    // The track is only fingerprinted if no stored fingerprint is passed
     void startFetch(
-            TrackPointer pTrack);
+            TrackPointer pTrack,
+            const QString& fingerprint = QString());
 
   public slots:
     void cancel();
@@ -65,6 +67,10 @@ class TagFetcher : public QObject {
             const mixxx::network::WebResponseWithContent& responseWithContent);
 
   private:
+    void lookupFingerprint(const QString& fingerprint);
+    // Only the recordings that are not in the LookupCache are requested
+    void lookupRecordings(QList<QUuid>&& recordingIds);
+
     bool onAcoustIdTaskTerminated();
     bool onMusicBrainzTaskTerminated();
 
@@ -77,4 +83,9 @@ class TagFetcher : public QObject {
     parented_ptr<mixxx::MusicBrainzRecordingsTask> m_pMusicBrainzTask;
 
     TrackPointer m_pTrack;
+
+    QString m_fingerprint;
+
+    // The releases of the recordings that were found in the LookupCache
+    QList<mixxx::musicbrainz::TrackRelease> m_cachedTrackReleases;
 };
@@ -6,11 +6,14 @@
 #include "defs_urls.h"
 #include "moc_musicbrainzrecordingstask.cpp"
 #include "musicbrainz/gzip.h"
+#include "musicbrainz/lookupcache.h"
 #include "musicbrainz/musicbrainzxml.h"
 #include "network/httpstatuscode.h"
 #include "util/assert.h"
 #include "util/logger.h"
 #include "util/thread_affinity.h"
+#include "util/time.h"
+#include "util/tokenbucket.h"
 #include "util/versionstore.h"
 
 namespace mixxx {
@@ -25,6 +28,11 @@ const QString kRequestPath = QStringLiteral("/ws/2/recording/");
 
 const QByteArray kUserAgentRawHeaderKey = "User-Agent";
 
+// https://musicbrainz.org/doc/MusicBrainz_API/Rate_Limiting
+// An average of one request per second, shared by all tasks. The
+// requests of a track are usually sent in a short burst.
+mixxx::TokenBucket s_rateLimiter(1.0, 3.0);
+
 QString userAgentRawHeaderValue() {
     return VersionStore::applicationName() +
             QStringLiteral("/") +
@@ -72,8 +80,43 @@ MusicBrainzRecordingsTask::MusicBrainzRecordingsTask(
                   networkAccessManager,
                   parent),
           m_queuedRecordingIds(recordingIds),
-          m_parentTimeoutMillis(0) {
+          m_parentTimeoutMillis(0),
+          m_rateLimitTimer(this) {
     musicbrainz::registerMetaTypesOnce();
+    m_rateLimitTimer.setSingleShot(true);
+    connect(&m_rateLimitTimer,
+            &QTimer::timeout,
+            this,
+            [this] {
+                network::WebTask::slotStart(m_parentTimeoutMillis);
+            });
+}
+
+void MusicBrainzRecordingsTask::slotStart(int timeoutMillis) {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+    m_parentTimeoutMillis = timeoutMillis;
+    const qint64 delayMillis = s_rateLimiter.takeToken(
+            Time::elapsed().toIntegerMillis());
+    if (delayMillis > 0) {
+        kLogger.debug()
+                << "Delaying request by"
+                << delayMillis
+                << "ms";
+        m_rateLimitTimer.start(static_cast<int>(delayMillis));
+        return;
+    }
+    network::WebTask::slotStart(timeoutMillis);
+}
+
+void MusicBrainzRecordingsTask::slotAbort() {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+    if (m_rateLimitTimer.isActive()) {
+        // No request is pending while waiting
+        m_rateLimitTimer.stop();
+        emitAborted();
+        return;
+    }
+    network::WebTask::slotAbort();
 }
 
 QNetworkReply* MusicBrainzRecordingsTask::doStartNetworkRequest(
@@ -134,6 +177,13 @@ void MusicBrainzRecordingsTask::doNetworkReplyFinished(
     }
 
     auto recordingsResult = musicbrainz::parseRecordings(reader);
+    if (recordingsResult.second && statusCode != 404) {
+        const QUuid requestedRecordingId = QUuid::fromString(
+                finishedNetworkReply->request().url().path().mid(kRequestPath.size()));
+        if (!requestedRecordingId.isNull()) {
+            musicbrainz::LookupCache::storeRecording(requestedRecordingId, body);
+        }
+    }
     for (auto&& trackRelease : recordingsResult.first) {
         // In case of a response with status 301 (Moved Permanently)
         // the actual recording id might differ from the requested id.
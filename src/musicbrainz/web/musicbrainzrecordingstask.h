@@ -3,6 +3,7 @@
 #include <QList>
 #include <QMap>
 #include <QSet>
+#include <QTimer>
 #include <QUrlQuery>
 #include <QUuid>
 
@@ -21,6 +22,13 @@ class MusicBrainzRecordingsTask : public network::WebTask {
             QObject* parent = nullptr);
     ~MusicBrainzRecordingsTask() override = default;
 
+  public slots:
+    /// Delays the requests to stay within the rate limit of MusicBrainz,
+    /// which is shared by all tasks.
+    void slotStart(
+            int timeoutMillis) override;
+    void slotAbort() override;
+
   signals:
     void succeeded(
             const QList<musicbrainz::TrackRelease>& trackReleases);
@@ -44,8 +52,6 @@ class MusicBrainzRecordingsTask : public network::WebTask {
             int errorCode,
             const QString& errorMessage);
 
-    void continueWithNextRequest();
-
     const QUrlQuery m_urlQuery;
 
     QList<QUuid> m_queuedRecordingIds;
@@ -54,6 +60,8 @@ class MusicBrainzRecordingsTask : public network::WebTask {
     QMap<QUuid, musicbrainz::TrackRelease> m_trackReleases;
 
     int m_parentTimeoutMillis;
+
+    QTimer m_rateLimitTimer;
 };
 
 } // namespace mixxx
@@ -0,0 +1,340 @@
+#include "network/controlserver.h"
+
+#include <QHostAddress>
+#include <QTcpSocket>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+#include "moc_controlserver.cpp"
+#include "util/assert.h"
+#include "util/fpclassify.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace network {
+
+namespace {
+
+const Logger kLogger("mixxx::network::ControlServer");
+
+const QString kConfigGroup = QStringLiteral("[RemoteControl]");
+const ConfigKey kEnabledConfigKey = ConfigKey(kConfigGroup, QStringLiteral("enabled"));
+const ConfigKey kAddressConfigKey = ConfigKey(kConfigGroup, QStringLiteral("address"));
+const ConfigKey kPortConfigKey = ConfigKey(kConfigGroup, QStringLiteral("port"));
+
+const QString kDefaultAddress = QStringLiteral("127.0.0.1");
+constexpr int kDefaultPort = 9322;
+
+// The same interval as [Master],guiTick50ms, which also works without any
+// GUI that drives the GuiTick.
+constexpr int kUpdateIntervalMillis = 50;
+
+// Skip sending values to clients that don't keep up with reading them. The
+// changes are coalesced until the client has caught up.
+constexpr qint64 kMaxPendingBytes = 64 * 1024;
+
+constexpr int kLengthSize = 2;
+constexpr int kMaxMessageSize = 0xFFFF;
+// Type and count
+constexpr int kValuesHeaderSize = 1 + 2;
+// Index and value
+constexpr int kValueSize = 2 + 8;
+constexpr int kMaxValuesPerMessage = (kMaxMessageSize - kValuesHeaderSize) / kValueSize;
+
+enum class MessageType : quint8 {
+    Subscribe = 0x01,
+    Unsubscribe = 0x02,
+    Set = 0x03,
+    SetParameter = 0x04,
+    Error = 0x80,
+    Values = 0x81,
+};
+
+/// Reads values from a message without ever reading beyond its end.
+class MessageReader {
+  public:
+    explicit MessageReader(const QByteArray& message)
+            : m_pData(message.constData()),
+              m_size(message.size()),
+              m_pos(0),
+              m_valid(true) {
+    }
+
+    bool isValid() const {
+        return m_valid;
+    }
+
+    quint8 readUInt8() {
+        if (!checkAvailable(1)) {
+            return 0;
+        }
+        return static_cast<quint8>(m_pData[m_pos++]);
+    }
+
+    quint16 readUInt16() {
+        if (!checkAvailable(2)) {
+            return 0;
+        }
+        const auto value = qFromLittleEndian<quint16>(m_pData + m_pos);
+        m_pos += 2;
+        return value;
+    }
+
+    double readDouble() {
+        if (!checkAvailable(8)) {
+            return 0.0;
+        }
+        const auto bits = qFromLittleEndian<quint64>(m_pData + m_pos);
+        m_pos += 8;
+        double value;
+        static_assert(sizeof(value) == sizeof(bits));
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    QString readString() {
+        const int length = readUInt16();
+        if (!checkAvailable(length)) {
+            return QString();
+        }
+        const auto string = QString::fromUtf8(m_pData + m_pos, length);
+        m_pos += length;
+        return string;
+    }
+
+  private:
+    bool checkAvailable(int size) {
+        if (m_pos + size > m_size) {
+            m_valid = false;
+        }
+        return m_valid;
+    }
+
+    const char* const m_pData;
+    const int m_size;
+    int m_pos;
+    bool m_valid;
+};
+
+char* writeUInt16(char* pDest, quint16 value) {
+    qToLittleEndian(value, pDest);
+    return pDest + 2;
+}
+
+char* writeDouble(char* pDest, double value) {
+    quint64 bits;
+    static_assert(sizeof(value) == sizeof(bits));
+    std::memcpy(&bits, &value, sizeof(bits));
+    qToLittleEndian(bits, pDest);
+    return pDest + 8;
+}
+
+void sendError(QTcpSocket* pSocket, quint16 index) {
+    char message[kLengthSize + 1 + 2];
+    char* pDest = writeUInt16(message, sizeof(message) - kLengthSize);
+    *pDest++ = static_cast<char>(MessageType::Error);
+    writeUInt16(pDest, index);
+    pSocket->write(message, sizeof(message));
+}
+
+} // anonymous namespace
+
+ControlServer::ControlServer(UserSettingsPointer pConfig, QObject* parent)
+        : QObject(parent),
+          m_pConfig(std::move(pConfig)) {
+    connect(&m_server,
+            &QTcpServer::newConnection,
+            this,
+            &ControlServer::slotNewConnection);
+    connect(&m_updateTimer,
+            &QTimer::timeout,
+            this,
+            &ControlServer::slotUpdate);
+}
+
+ControlServer::~ControlServer() {
+    m_updateTimer.stop();
+    m_server.close();
+    for (const auto& pClient : m_clients) {
+        pClient->pSocket->disconnect(this);
+        pClient->pSocket->abort();
+        pClient->pSocket->deleteLater();
+    }
+}
+
+void ControlServer::start() {
+    if (!m_pConfig->getValue(kEnabledConfigKey, false)) {
+        return;
+    }
+    const QHostAddress address(m_pConfig->getValue(kAddressConfigKey, kDefaultAddress));
+    const int port = m_pConfig->getValue(kPortConfigKey, kDefaultPort);
+    if (!m_server.listen(address, static_cast<quint16>(port))) {
+        kLogger.warning()
+                << "Failed to listen on" << address << port
+                << m_server.errorString();
+        return;
+    }
+    kLogger.info() << "Listening on" << address << port;
+    m_updateTimer.start(kUpdateIntervalMillis);
+}
+
+void ControlServer::slotNewConnection() {
+    while (QTcpSocket* pSocket = m_server.nextPendingConnection()) {
+        kLogger.info() << "Client connected from" << pSocket->peerAddress();
+        // Small messages are sent once per update, don't delay them
+        pSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        auto pClient = std::make_unique<Client>();
+        pClient->pSocket = pSocket;
+        Client* pClientPtr = pClient.get();
+        m_clients.push_back(std::move(pClient));
+        connect(pSocket,
+                &QTcpSocket::readyRead,
+                this,
+                [this, pClientPtr]() {
+                    receive(pClientPtr);
+                });
+        connect(pSocket,
+                &QTcpSocket::disconnected,
+                this,
+                [this, pSocket]() {
+                    removeClient(pSocket);
+                });
+    }
+}
+
+void ControlServer::removeClient(QTcpSocket* pSocket) {
+    kLogger.info() << "Client disconnected from" << pSocket->peerAddress();
+    const auto it = std::find_if(m_clients.begin(),
+            m_clients.end(),
+            [pSocket](const auto& pClient) {
+                return pClient->pSocket == pSocket;
+            });
+    VERIFY_OR_DEBUG_ASSERT(it != m_clients.end()) {
+        return;
+    }
+    pSocket->disconnect(this);
+    m_clients.erase(it);
+    pSocket->deleteLater();
+}
+
+void ControlServer::receive(Client* pClient) {
+    pClient->receiveBuffer.append(pClient->pSocket->readAll());
+    int pos = 0;
+    while (pClient->receiveBuffer.size() - pos >= kLengthSize) {
+        const int length = qFromLittleEndian<quint16>(
+                pClient->receiveBuffer.constData() + pos);
+        if (pClient->receiveBuffer.size() - pos - kLengthSize < length) {
+            // Wait for the rest of the message
+            break;
+        }
+        processMessage(pClient,
+                pClient->receiveBuffer.mid(pos + kLengthSize, length));
+        pos += kLengthSize + length;
+    }
+    pClient->receiveBuffer.remove(0, pos);
+}
+
+void ControlServer::processMessage(Client* pClient, const QByteArray& message) {
+    MessageReader reader(message);
+    const auto type = static_cast<MessageType>(reader.readUInt8());
+    const quint16 index = reader.readUInt16();
+    switch (type) {
+    case MessageType::Subscribe: {
+        const QString group = reader.readString();
+        const QString item = reader.readString();
+        if (reader.isValid()) {
+            subscribe(pClient, index, ConfigKey(group, item));
+            return;
+        }
+        break;
+    }
+    case MessageType::Unsubscribe:
+        if (reader.isValid()) {
+            pClient->subscriptions.erase(index);
+            return;
+        }
+        break;
+    case MessageType::Set:
+    case MessageType::SetParameter: {
+        const double value = reader.readDouble();
+        const auto it = pClient->subscriptions.find(index);
+        if (reader.isValid() && !util_isnan(value) &&
+                it != pClient->subscriptions.end()) {
+            if (type == MessageType::Set) {
+                it->second.control.set(value);
+            } else {
+                it->second.control.setParameter(value);
+            }
+            return;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    kLogger.debug() << "Rejecting invalid message" << message.toHex();
+    sendError(pClient->pSocket, index);
+}
+
+void ControlServer::subscribe(Client* pClient, quint16 index, const ConfigKey& key) {
+    PollingControlProxy control(key, ControlFlag::AllowMissingOrInvalid);
+    if (!control.valid()) {
+        kLogger.debug() << "Rejecting subscription of unknown control" << key;
+        sendError(pClient->pSocket, index);
+        return;
+    }
+    pClient->subscriptions.insert_or_assign(index,
+            Subscription{std::move(control), std::nullopt});
+    sendChangedValues(pClient);
+}
+
+void ControlServer::slotUpdate() {
+    for (const auto& pClient : m_clients) {
+        if (pClient->pSocket->bytesToWrite() > kMaxPendingBytes) {
+            continue;
+        }
+        sendChangedValues(pClient.get());
+    }
+}
+
+void ControlServer::sendChangedValues(Client* pClient) {
+    QByteArray message;
+    int count = 0;
+    const auto flush = [&]() {
+        char* pDest = writeUInt16(message.data(),
+                static_cast<quint16>(message.size() - kLengthSize));
+        pDest++; // type
+        writeUInt16(pDest, static_cast<quint16>(count));
+        pClient->pSocket->write(message);
+        message.clear();
+        count = 0;
+    };
+    for (auto& [index, subscription] : pClient->subscriptions) {
+        const double value = subscription.control.get();
+        if (subscription.sentValue && *subscription.sentValue == value) {
+            continue;
+        }
+        subscription.sentValue = value;
+        if (count == 0) {
+            message.reserve(kLengthSize + kValuesHeaderSize +
+                    static_cast<int>(pClient->subscriptions.size()) * kValueSize);
+            message.resize(kLengthSize + kValuesHeaderSize);
+            message[kLengthSize] = static_cast<char>(MessageType::Values);
+        }
+        const int pos = message.size();
+        message.resize(pos + kValueSize);
+        writeDouble(writeUInt16(message.data() + pos, index), value);
+        if (++count == kMaxValuesPerMessage) {
+            flush();
+        }
+    }
+    if (count > 0) {
+        flush();
+    }
+}
+
+} // namespace network
+
+} // namespace mixxx
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QByteArray>
+#include <QObject>
+#include <QTcpServer>
+#include <QTimer>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "control/pollingcontrolproxy.h"
+#include "preferences/usersettings.h"
+
+class QTcpSocket;
+
+namespace mixxx {
+
+namespace network {
+
+/// A TCP server for reading and setting controls remotely, e.g. from
+/// dashboards.
+///
+/// All values are exchanged in a compact binary format. Each message is
+/// prefixed by its length as a 16 bit value, all multi byte values are
+/// little endian and all strings are UTF-8.
+///
+/// Client requests:
+///  * Subscribe: 0x01, u16 index, u16 group length, group,
+///    u16 item length, item
+///  * Unsubscribe: 0x02, u16 index
+///  * Set: 0x03, u16 index, f64 value
+///  * SetParameter: 0x04, u16 index, f64 parameter
+///
+/// Server responses:
+///  * Error: 0x80, u16 index
+///  * Values: 0x81, u16 count, count times u16 index and f64 value
+///
+/// The index is chosen by the client when subscribing and refers to the
+/// control in all following requests and responses. The current value is
+/// sent right away, afterwards only the changed values of all subscribed
+/// controls are sent in a single Values message per update interval.
+///
+/// The values are polled from the main thread, so the engine thread isn't
+/// involved at all. Values are set in the same way as by controller scripts.
+class ControlServer : public QObject {
+    Q_OBJECT
+  public:
+    explicit ControlServer(UserSettingsPointer pConfig, QObject* parent = nullptr);
+    ~ControlServer() override;
+
+    /// Starts listening if the server is enabled in the settings.
+    void start();
+
+  private slots:
+    void slotNewConnection();
+    void slotUpdate();
+
+  private:
+    struct Subscription {
+        PollingControlProxy control;
+        std::optional<double> sentValue;
+    };
+
+    struct Client {
+        QTcpSocket* pSocket;
+        QByteArray receiveBuffer;
+        std::map<quint16, Subscription> subscriptions;
+    };
+
+    void receive(Client* pClient);
+    void processMessage(Client* pClient, const QByteArray& message);
+    void subscribe(Client* pClient, quint16 index, const ConfigKey& key);
+    /// Sends all values that differ from the previously sent ones.
+    void sendChangedValues(Client* pClient);
+    void removeClient(QTcpSocket* pSocket);
+
+    const UserSettingsPointer m_pConfig;
+    QTcpServer m_server;
+    QTimer m_updateTimer;
+    std::vector<std::unique_ptr<Client>> m_clients;
+};
+
+} // namespace network
+
+} // namespace mixxx
@@ -0,0 +1,122 @@
+#include "network/metricsserver.h"
+
+#include <QHostAddress>
+#include <QTcpSocket>
+
+#include "moc_metricsserver.cpp"
+#include "util/logger.h"
+#include "util/metrics.h"
+
+namespace mixxx {
+
+namespace network {
+
+namespace {
+
+const Logger kLogger("mixxx::network::MetricsServer");
+
+const QString kConfigGroup = QStringLiteral("[Metrics]");
+const ConfigKey kEnabledConfigKey = ConfigKey(kConfigGroup, QStringLiteral("enabled"));
+const ConfigKey kAddressConfigKey = ConfigKey(kConfigGroup, QStringLiteral("address"));
+const ConfigKey kPortConfigKey = ConfigKey(kConfigGroup, QStringLiteral("port"));
+
+const QString kDefaultAddress = QStringLiteral("127.0.0.1");
+constexpr int kDefaultPort = 9323;
+
+// Requests are tiny, anything larger is not a scraper
+constexpr int kMaxRequestSize = 8 * 1024;
+
+QByteArray response(const QByteArray& status,
+        const QByteArray& contentType,
+        const QByteArray& body) {
+    QByteArray response = QByteArrayLiteral("HTTP/1.1 ") + status + "\r\n";
+    response += "Content-Type: " + contentType + "\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+} // anonymous namespace
+
+MetricsServer::MetricsServer(UserSettingsPointer pConfig, QObject* parent)
+        : QObject(parent),
+          m_pConfig(std::move(pConfig)) {
+    connect(&m_server,
+            &QTcpServer::newConnection,
+            this,
+            &MetricsServer::slotNewConnection);
+}
+
+MetricsServer::~MetricsServer() {
+    m_server.close();
+}
+
+void MetricsServer::start() {
+    if (!m_pConfig->getValue(kEnabledConfigKey, false)) {
+        return;
+    }
+    const QHostAddress address(m_pConfig->getValue(kAddressConfigKey, kDefaultAddress));
+    const int port = m_pConfig->getValue(kPortConfigKey, kDefaultPort);
+    if (!m_server.listen(address, static_cast<quint16>(port))) {
+        kLogger.warning()
+                << "Failed to listen on" << address << port
+                << m_server.errorString();
+        return;
+    }
+    kLogger.info() << "Listening on" << address << port;
+}
+
+void MetricsServer::slotNewConnection() {
+    while (QTcpSocket* pSocket = m_server.nextPendingConnection()) {
+        // The socket is a child of the server and deleted with it
+        connect(pSocket,
+                &QTcpSocket::readyRead,
+                this,
+                [this, pSocket]() {
+                    receive(pSocket);
+                });
+        connect(pSocket,
+                &QTcpSocket::disconnected,
+                pSocket,
+                &QObject::deleteLater);
+    }
+}
+
+void MetricsServer::receive(QTcpSocket* pSocket) {
+    // Wait until the complete request header has been received. The
+    // request is read but not consumed until then.
+    const QByteArray request = pSocket->peek(kMaxRequestSize);
+    const int headerEnd = request.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        if (request.size() >= kMaxRequestSize) {
+            pSocket->write(response(QByteArrayLiteral("431 Request Header Fields Too Large"),
+                    QByteArrayLiteral("text/plain"),
+                    QByteArray()));
+            pSocket->disconnectFromHost();
+        }
+        return;
+    }
+    pSocket->read(headerEnd + 4);
+
+    const QList<QByteArray> requestLine =
+            request.left(request.indexOf("\r\n")).split(' ');
+    if (requestLine.size() != 3 || requestLine.at(0) != "GET") {
+        pSocket->write(response(QByteArrayLiteral("405 Method Not Allowed"),
+                QByteArrayLiteral("text/plain"),
+                QByteArray()));
+    } else if (requestLine.at(1) != "/metrics") {
+        pSocket->write(response(QByteArrayLiteral("404 Not Found"),
+                QByteArrayLiteral("text/plain"),
+                QByteArray()));
+    } else {
+        pSocket->write(response(QByteArrayLiteral("200 OK"),
+                QByteArrayLiteral("application/openmetrics-text; version=1.0.0; charset=utf-8"),
+                metrics::toOpenMetricsText()));
+    }
+    pSocket->disconnectFromHost();
+}
+
+} // namespace network
+
+} // namespace mixxx
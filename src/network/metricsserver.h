@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QObject>
+#include <QTcpServer>
+
+#include "preferences/usersettings.h"
+
+class QTcpSocket;
+
+namespace mixxx {
+
+namespace network {
+
+/// A minimal HTTP server that exports the values of mixxx::metrics in the
+/// OpenMetrics text format on /metrics, e.g. for scraping by Prometheus.
+///
+/// The metrics are collected all the time independent of the StatsManager,
+/// this server only formats them on request in the main thread.
+class MetricsServer : public QObject {
+    Q_OBJECT
+  public:
+    explicit MetricsServer(UserSettingsPointer pConfig, QObject* parent = nullptr);
+    ~MetricsServer() override;
+
+    /// Starts listening if the server is enabled in the settings.
+    void start();
+
+  private slots:
+    void slotNewConnection();
+
+  private:
+    void receive(QTcpSocket* pSocket);
+
+    const UserSettingsPointer m_pConfig;
+    QTcpServer m_server;
+};
+
+} // namespace network
+
+} // namespace mixxx
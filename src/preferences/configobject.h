@@ -35,8 +35,10 @@ Q_DECLARE_METATYPE(ConfigKey);
 
 // comparison function for ConfigKeys. Used by a QHash in ControlObject
 inline bool operator==(const ConfigKey& lhs, const ConfigKey& rhs) {
-    return lhs.group == rhs.group &&
-            lhs.item == rhs.item;
+    // Many keys share the same group, so the items are compared first,
+    // which rejects most of the different keys earlier.
+    return lhs.item == rhs.item &&
+            lhs.group == rhs.group;
 }
 
 // comparison function for ConfigKeys. Used by a QHash in ControlObject
@@ -63,8 +65,9 @@ inline QDebug operator<<(QDebug stream, const ConfigKey& configKey) {
 inline qhash_seed_t qHash(
         const ConfigKey& key,
         qhash_seed_t seed = 0) {
-    return qHash(key.group, seed) ^
-            qHash(key.item, seed);
+    // Chained instead of XOR-ed, so the hash of (a, b) differs from (b, a)
+    // and equal groups and items don't cancel each other out
+    return qHash(key.item, qHash(key.group, seed));
 }
 
 // The value corresponding to a key. The basic value is a string, but can be
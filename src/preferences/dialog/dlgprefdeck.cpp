@@ -10,6 +10,7 @@
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
 #include "defs_urls.h"
+#include "engine/cachingreader/cachingreaderdiskcache.h"
 #include "engine/controls/ratecontrol.h"
 #include "engine/enginebuffer.h"
 #include "mixer/basetrackplayer.h"
@@ -29,6 +30,7 @@ constexpr double kDefaultTemporaryRateChangeFine = 2.00;
 constexpr double kDefaultPermanentRateChangeCoarse = 0.50;
 constexpr double kDefaultPermanentRateChangeFine = 0.05;
 constexpr int kDefaultRateRampSensitivity = 250;
+constexpr int kDefaultDecodedAudioCacheSizeMB = 0; // disabled
 // bool kDefaultCloneDeckOnLoad is defined in header file to make it available
 // to playermanager.cpp
 } // namespace
@@ -499,6 +501,10 @@ void DlgPrefDeck::slotUpdate() {
     spinBoxTemporaryRateFine->setValue(RateControl::getTemporaryRateChangeFineAmount());
     spinBoxPermanentRateCoarse->setValue(RateControl::getPermanentRateChangeCoarseAmount());
     spinBoxPermanentRateFine->setValue(RateControl::getPermanentRateChangeFineAmount());
+
+    spinBoxDecodedAudioCacheSize->setValue(m_pConfig->getValue(
+            CachingReaderDiskCache::kMaxSizeMBConfigKey,
+            kDefaultDecodedAudioCacheSizeMB));
 }
 
 void DlgPrefDeck::slotResetToDefaults() {
@@ -539,6 +545,8 @@ void DlgPrefDeck::slotResetToDefaults() {
 
     radioButtonOriginalKey->setChecked(true);
     radioButtonResetUnlockedKey->setChecked(true);
+
+    spinBoxDecodedAudioCacheSize->setValue(kDefaultDecodedAudioCacheSizeMB);
 }
 
 void DlgPrefDeck::slotMoveIntroStartCheckbox(bool checked) {
@@ -745,6 +753,10 @@ void DlgPrefDeck::slotApply() {
     m_pConfig->setValue(ConfigKey("[Controls]", "RateTempRight"), m_dRateTempFine);
     m_pConfig->setValue(ConfigKey("[Controls]", "RatePermLeft"), m_dRatePermCoarse);
     m_pConfig->setValue(ConfigKey("[Controls]", "RatePermRight"), m_dRatePermFine);
+
+    // Applied when the next track is loaded
+    m_pConfig->setValue(CachingReaderDiskCache::kMaxSizeMBConfigKey,
+            spinBoxDecodedAudioCacheSize->value());
 }
 
 void DlgPrefDeck::slotNumDecksChanged(double new_count, bool initializing) {
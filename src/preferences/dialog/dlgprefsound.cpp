@@ -1,10 +1,15 @@
 #include "preferences/dialog/dlgprefsound.h"
 
 #include <QMessageBox>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
 #include <QtDebug>
 
 #include "control/controlproxy.h"
+#include "engine/bufferscalers/enginebufferscalelinear.h"
 #include "engine/enginebuffer.h"
+#include "engine/enginechannelprocessorpool.h"
 #include "engine/enginemaster.h"
 #include "mixer/playermanager.h"
 #include "moc_dlgprefsound.cpp"
@@ -94,6 +99,14 @@ DlgPrefSound::DlgPrefSound(QWidget* pParent,
         }
     }
 
+    scalerInterpolationComboBox->clear();
+    scalerInterpolationComboBox->addItem(tr("Linear"),
+            static_cast<int>(EngineBufferScaleLinear::InterpolationMode::Linear));
+    scalerInterpolationComboBox->addItem(tr("Cubic"),
+            static_cast<int>(EngineBufferScaleLinear::InterpolationMode::Cubic));
+    scalerInterpolationComboBox->addItem(tr("Windowed Sinc"),
+            static_cast<int>(EngineBufferScaleLinear::InterpolationMode::Sinc));
+
     m_pLatencyCompensation = new ControlProxy("[Master]", "microphoneLatencyCompensation", this);
     m_pMasterDelay = new ControlProxy("[Master]", "delay", this);
     m_pHeadDelay = new ControlProxy("[Master]", "headDelay", this);
@@ -129,6 +142,8 @@ DlgPrefSound::DlgPrefSound(QWidget* pParent,
         QVariant(static_cast<int>(EngineMaster::MicMonitorMode::MASTER_AND_BOOTH)));
     micMonitorModeComboBox->addItem(tr("Direct monitor (recording and broadcasting only)"),
         QVariant(static_cast<int>(EngineMaster::MicMonitorMode::DIRECT_MONITOR)));
+    micMonitorModeComboBox->addItem(tr("Direct monitor by Mixxx (same sound device only)"),
+        QVariant(static_cast<int>(EngineMaster::MicMonitorMode::SOFTWARE_DIRECT_MONITOR)));
     int modeIndex = micMonitorModeComboBox->findData(
         static_cast<int>(m_pMicMonitorMode->get()));
     micMonitorModeComboBox->setCurrentIndex(modeIndex);
@@ -165,8 +180,40 @@ DlgPrefSound::DlgPrefSound(QWidget* pParent,
             QOverload<int>::of(&QComboBox::currentIndexChanged),
             this,
             &DlgPrefSound::settingChanged);
+    connect(keylockMultiThreadingCheckBox,
+            &QCheckBox::toggled,
+            this,
+            &DlgPrefSound::settingChanged);
+    connect(scalerInterpolationComboBox,
+            QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this,
+            &DlgPrefSound::settingChanged);
+    connect(channelProcessingThreadsSpinBox,
+            QOverload<int>::of(&QSpinBox::valueChanged),
+            this,
+            &DlgPrefSound::settingChanged);
+    connect(realtimeProfileCheckBox,
+            &QCheckBox::toggled,
+            this,
+            &DlgPrefSound::settingChanged);
+    connect(realtimeCallbackCpuSpinBox,
+            QOverload<int>::of(&QSpinBox::valueChanged),
+            this,
+            &DlgPrefSound::settingChanged);
+    connect(realtimeWorkerCpusLineEdit,
+            &QLineEdit::textEdited,
+            this,
+            &DlgPrefSound::settingChanged);
+    connect(realtimeLockMemoryCheckBox,
+            &QCheckBox::toggled,
+            this,
+            &DlgPrefSound::settingChanged);
 
     connect(queryButton, &QAbstractButton::clicked, this, &DlgPrefSound::queryClicked);
+    connect(m_pSoundManager.get(),
+            &SoundManager::devicesHotplugged,
+            this,
+            &DlgPrefSound::devicesHotplugged);
 
     connect(m_pSoundManager.get(),
             &SoundManager::outputRegistered,
@@ -217,6 +264,12 @@ DlgPrefSound::DlgPrefSound(QWidget* pParent,
 
     m_pKeylockEngine =
             new ControlProxy("[Master]", "keylock_engine", this);
+    m_pKeylockMultiThreading =
+            new ControlProxy("[Master]", "keylock_multithreading", this);
+    m_pScalerInterpolation =
+            new ControlProxy("[Master]", "scaler_interpolation", this);
+    m_pChannelProcessingThreads =
+            new ControlProxy("[Master]", "channel_processing_threads", this);
 
 #ifdef __LINUX__
     qDebug() << "RLimit Cur " << RLimit::getCurRtPrio();
@@ -293,6 +346,7 @@ void DlgPrefSound::slotUpdate() {
     m_bSkipConfigClear = true;
     loadSettings();
     checkLatencyCompensation();
+    updateRealtimeStatus();
     m_bSkipConfigClear = false;
     m_settingsModified = false;
 }
@@ -315,6 +369,18 @@ void DlgPrefSound::slotApply() {
         m_pKeylockEngine->set(keylockComboBox->currentData().toDouble());
         m_pSettings->set(ConfigKey("[Master]", "keylock_engine"),
                 ConfigValue(keylockComboBox->currentData().toInt()));
+        m_pKeylockMultiThreading->set(keylockMultiThreadingCheckBox->isChecked() ? 1.0 : 0.0);
+        m_pSettings->setValue(ConfigKey("[Master]", "keylock_multithreading"),
+                keylockMultiThreadingCheckBox->isChecked());
+        m_pScalerInterpolation->set(scalerInterpolationComboBox->currentData().toDouble());
+        m_pSettings->set(ConfigKey("[Master]", "scaler_interpolation"),
+                ConfigValue(scalerInterpolationComboBox->currentData().toInt()));
+        m_pChannelProcessingThreads->set(channelProcessingThreadsSpinBox->value());
+        m_pSettings->setValue(ConfigKey("[Master]", "channel_processing_threads"),
+                channelProcessingThreadsSpinBox->value());
+        const auto realtimeProfile = realtimeProfileFromWidgets();
+        mixxx::RealtimeProfile::writeSettings(m_pSettings, realtimeProfile);
+        mixxx::RealtimeProfile::setSettings(realtimeProfile);
 
         err = m_pSoundManager->setConfig(m_config);
     }
@@ -328,6 +394,8 @@ void DlgPrefSound::slotApply() {
     m_bSkipConfigClear = true;
     loadSettings(); // in case SM decided to change anything it didn't like
     checkLatencyCompensation();
+    // The callback thread reports its status with the first callback
+    QTimer::singleShot(1000, this, &DlgPrefSound::updateRealtimeStatus);
     m_bSkipConfigClear = false;
 }
 
@@ -511,6 +579,28 @@ void DlgPrefSound::loadSettings(const SoundManagerConfig &config) {
         keylockComboBox->setCurrentIndex(keylockComboBox->count() - 1);
     }
 
+    // The multi-threaded keylock engine adds latency and is disabled by default
+    keylockMultiThreadingCheckBox->setChecked(
+            m_pSettings->getValue(ConfigKey("[Master]", "keylock_multithreading"), false));
+
+    // Linear interpolation is the cheapest and the default
+    const int scalerInterpolationIndex = scalerInterpolationComboBox->findData(
+            m_pSettings->getValue(ConfigKey("[Master]", "scaler_interpolation"),
+                    static_cast<int>(EngineBufferScaleLinear::kDefaultInterpolationMode)));
+    if (scalerInterpolationIndex >= 0) {
+        scalerInterpolationComboBox->setCurrentIndex(scalerInterpolationIndex);
+    } else {
+        scalerInterpolationComboBox->setCurrentIndex(0);
+    }
+
+    // No parallel processing by default
+    channelProcessingThreadsSpinBox->setMaximum(
+            EngineChannelProcessorPool::maxNumThreads());
+    channelProcessingThreadsSpinBox->setValue(
+            m_pSettings->getValue(ConfigKey("[Master]", "channel_processing_threads"), 0));
+
+    loadRealtimeProfile(mixxx::RealtimeProfile::readSettings(m_pSettings));
+
     m_loading = false;
     // DlgPrefSoundItem has it's own inhibit flag
     emit loadPaths(m_config);
@@ -528,7 +618,8 @@ void DlgPrefSound::apiChanged(int index) {
     // JACK sets its own buffer size and sample rate that Mixxx cannot change.
     // TODO(Be): Get the buffer size from JACK and update audioBufferComboBox.
     // PortAudio does not have a way to get the buffer size from JACK as of July 2017.
-    if (m_config.getAPI() == MIXXX_PORTAUDIO_JACK_STRING) {
+    if (m_config.getAPI() == MIXXX_PORTAUDIO_JACK_STRING ||
+            m_config.getAPI() == MIXXX_JACK_NATIVE_STRING) {
         sampleRateComboBox->setEnabled(false);
         latencyLabel->setEnabled(false);
         audioBufferComboBox->setEnabled(false);
@@ -682,6 +773,17 @@ void DlgPrefSound::queryClicked() {
     ScopedWaitCursor cursor;
     m_pSoundManager->clearAndQueryDevices();
     updateAPIs();
+    queryButton->setToolTip(QString());
+}
+
+/**
+ * Slot called when sound devices have been plugged in or removed while the
+ * devices are open.
+ */
+void DlgPrefSound::devicesHotplugged() {
+    queryButton->setToolTip(
+            tr("Sound devices have been plugged in or removed. Query the "
+               "devices to update the list, this interrupts the audio."));
 }
 
 /**
@@ -700,6 +802,19 @@ void DlgPrefSound::slotResetToDefaults() {
     }
     m_pKeylockEngine->set(static_cast<double>(keylockEngine));
 
+    keylockMultiThreadingCheckBox->setChecked(false);
+    m_pKeylockMultiThreading->set(0.0);
+
+    const auto scalerInterpolation = EngineBufferScaleLinear::kDefaultInterpolationMode;
+    scalerInterpolationComboBox->setCurrentIndex(
+            scalerInterpolationComboBox->findData(static_cast<int>(scalerInterpolation)));
+    m_pScalerInterpolation->set(static_cast<double>(scalerInterpolation));
+
+    channelProcessingThreadsSpinBox->setValue(0);
+    m_pChannelProcessingThreads->set(0.0);
+
+    loadRealtimeProfile(mixxx::RealtimeProfile::Settings());
+
     masterMixComboBox->setCurrentIndex(1);
     m_pMasterEnabled->set(1.0);
 
@@ -795,7 +910,9 @@ void DlgPrefSound::checkLatencyCompensation() {
 
     if (m_config.hasMicInputs() && !m_config.hasExternalRecordBroadcast()) {
         micMonitorModeComboBox->setEnabled(true);
-        if (configuredMicMonitorMode == EngineMaster::MicMonitorMode::DIRECT_MONITOR) {
+        if (configuredMicMonitorMode == EngineMaster::MicMonitorMode::DIRECT_MONITOR ||
+                configuredMicMonitorMode ==
+                        EngineMaster::MicMonitorMode::SOFTWARE_DIRECT_MONITOR) {
             latencyCompensationSpinBox->setEnabled(true);
             QString warningIcon("<html><img src=':/images/preferences/ic_preferences_warning.png' width='20' height='20'></html> ");
             QString lineBreak("<br/>");
@@ -827,3 +944,63 @@ void DlgPrefSound::checkLatencyCompensation() {
         latencyCompensationWarningLabel->hide();
     }
 }
+
+void DlgPrefSound::loadRealtimeProfile(const mixxx::RealtimeProfile::Settings& settings) {
+    realtimeProfileCheckBox->setChecked(settings.enabled);
+    realtimeCallbackCpuSpinBox->setMaximum(QThread::idealThreadCount() - 1);
+    realtimeCallbackCpuSpinBox->setValue(settings.callbackCpu);
+    QStringList workerCpus;
+    for (int cpu : settings.workerCpus) {
+        workerCpus.append(QString::number(cpu));
+    }
+    realtimeWorkerCpusLineEdit->setText(workerCpus.join(QStringLiteral(",")));
+    realtimeLockMemoryCheckBox->setChecked(settings.lockMemory);
+}
+
+mixxx::RealtimeProfile::Settings DlgPrefSound::realtimeProfileFromWidgets() const {
+    mixxx::RealtimeProfile::Settings settings;
+    settings.enabled = realtimeProfileCheckBox->isChecked();
+    settings.callbackCpu = realtimeCallbackCpuSpinBox->value();
+    const int numCpus = QThread::idealThreadCount();
+    const QStringList workerCpus = realtimeWorkerCpusLineEdit->text().split(',');
+    for (const auto& cpu : workerCpus) {
+        bool ok;
+        const int value = cpu.trimmed().toInt(&ok);
+        if (ok && value >= 0 && value < numCpus) {
+            settings.workerCpus.append(value);
+        }
+    }
+    settings.lockMemory = realtimeLockMemoryCheckBox->isChecked();
+    return settings;
+}
+
+void DlgPrefSound::updateRealtimeStatus() {
+    const auto threadStatus = mixxx::RealtimeProfile::threadStatus();
+    QStringList lines;
+    for (const auto& status : threadStatus) {
+        QString line = status.name + QStringLiteral(": ");
+        if (status.realtime) {
+            line += tr("real-time, priority %1").arg(status.priority);
+        } else {
+            line += tr("not real-time");
+        }
+        if (status.cpu >= 0) {
+            line += QStringLiteral(", ") + tr("CPU %1").arg(status.cpu);
+        }
+        if (!status.error.isEmpty()) {
+            line += QStringLiteral(" (") + status.error.toHtmlEscaped() + QStringLiteral(")");
+        }
+        lines.append(line);
+    }
+    if (lines.isEmpty()) {
+        lines.append(tr("No audio threads are running."));
+    }
+    const std::size_t lockedBytes = mixxx::RealtimeProfile::lockedMemoryBytes();
+    const std::size_t unlockedBytes = mixxx::RealtimeProfile::unlockedMemoryBytes();
+    if (lockedBytes > 0 || unlockedBytes > 0) {
+        lines.append(tr("Locked memory: %1 KB, failed to lock: %2 KB")
+                             .arg(lockedBytes / 1024)
+                             .arg(unlockedBytes / 1024));
+    }
+    realtimeStatusText->setText(lines.join(QStringLiteral("<br/>")));
+}
@@ -9,6 +9,7 @@
 #include "soundio/sounddevice.h"
 #include "soundio/sounddeviceerror.h"
 #include "soundio/soundmanagerconfig.h"
+#include "util/realtimeprofile.h"
 
 class SoundManager;
 class PlayerManager;
@@ -75,6 +76,7 @@ class DlgPrefSound : public DlgPreferencePage, public Ui::DlgPrefSoundDlg  {
     void settingChanged();
     void deviceSettingChanged();
     void queryClicked();
+    void devicesHotplugged();
 
   private:
     void initializePaths();
@@ -82,6 +84,9 @@ class DlgPrefSound : public DlgPreferencePage, public Ui::DlgPrefSoundDlg  {
     void loadSettings(const SoundManagerConfig &config);
     void insertItem(DlgPrefSoundItem *pItem, QVBoxLayout *pLayout);
     void checkLatencyCompensation();
+    void loadRealtimeProfile(const mixxx::RealtimeProfile::Settings& settings);
+    mixxx::RealtimeProfile::Settings realtimeProfileFromWidgets() const;
+    void updateRealtimeStatus();
     bool eventFilter(QObject* object, QEvent* event) override;
 
     std::shared_ptr<SoundManager> m_pSoundManager;
@@ -94,6 +99,9 @@ class DlgPrefSound : public DlgPreferencePage, public Ui::DlgPrefSoundDlg  {
     ControlProxy* m_pBoothDelay;
     ControlProxy* m_pLatencyCompensation;
     ControlProxy* m_pKeylockEngine;
+    ControlProxy* m_pKeylockMultiThreading;
+    ControlProxy* m_pScalerInterpolation;
+    ControlProxy* m_pChannelProcessingThreads;
     ControlProxy* m_pMasterEnabled;
     ControlProxy* m_pMasterMonoMixdown;
     ControlProxy* m_pMicMonitorMode;
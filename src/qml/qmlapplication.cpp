@@ -2,7 +2,9 @@
 
 #include <QtQml/qqmlextensionplugin.h>
 
+#include "control/control.h"
 #include "control/controlsortfiltermodel.h"
+#include "control/realtimecontrol.h"
 #include "moc_qmlapplication.cpp"
 #include "qml/asyncimageprovider.h"
 #include "qml/qmlconfigproxy.h"
@@ -24,6 +26,9 @@ Q_IMPORT_QML_PLUGIN(Mixxx_ControlsPlugin)
 namespace {
 const QString kMainQmlFileName = QStringLiteral("qml/main.qml");
 
+// Roughly the display frame rate
+constexpr int kControlNotificationIntervalMillis = 16;
+
 // Converts a (capturing) lambda into a function pointer that can be passed to
 // qmlRegisterSingletonType.
 template<class F>
@@ -90,6 +95,17 @@ QmlApplication::QmlApplication(
             &QFileSystemWatcher::fileChanged,
             this,
             &QmlApplication::loadQml);
+
+    connect(&m_controlNotificationTimer,
+            &QTimer::timeout,
+            this,
+            &QmlApplication::slotNotifyChangedControls);
+    m_controlNotificationTimer.start(kControlNotificationIntervalMillis);
+}
+
+void QmlApplication::slotNotifyChangedControls() {
+    RealtimeControl::notifyChangedControls();
+    ControlDoublePrivate::dispatchCoalescedValueChanges();
 }
 
 void QmlApplication::loadQml(const QString& path) {
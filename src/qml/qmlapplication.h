@@ -3,6 +3,7 @@
 #include <QApplication>
 #include <QFileSystemWatcher>
 #include <QQmlApplicationEngine>
+#include <QTimer>
 
 #include "coreservices.h"
 #include "preferences/dialog/dlgpreferences.h"
@@ -21,6 +22,9 @@ class QmlApplication : public QObject {
   public slots:
     void loadQml(const QString& path);
 
+  private slots:
+    void slotNotifyChangedControls();
+
   private:
     std::shared_ptr<CoreServices> m_pCoreServices;
 
@@ -29,6 +33,10 @@ class QmlApplication : public QObject {
     std::unique_ptr<QQmlApplicationEngine> m_pAppEngine;
     QFileSystemWatcher m_fileWatcher;
     std::shared_ptr<DlgPreferences> m_pDlgPreferences;
+
+    // Replaces the GuiTick of the legacy skins for delivering coalesced
+    // control change notifications
+    QTimer m_controlNotificationTimer;
 };
 
 } // namespace qml
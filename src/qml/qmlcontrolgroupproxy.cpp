@@ -0,0 +1,126 @@
+#include "qml/qmlcontrolgroupproxy.h"
+
+#include "moc_qmlcontrolgroupproxy.cpp"
+
+namespace mixxx {
+namespace qml {
+
+QmlControlGroupProxy::QmlControlGroupProxy(QObject* parent)
+        : QObject(parent),
+          m_isComponentComplete(false),
+          m_valuesChangedPending(false) {
+}
+
+QmlControlGroupProxy::~QmlControlGroupProxy() = default;
+
+void QmlControlGroupProxy::componentComplete() {
+    m_isComponentComplete = true;
+    reinitializeFromKeys();
+}
+
+void QmlControlGroupProxy::setGroup(const QString& group) {
+    if (m_group == group) {
+        return;
+    }
+    m_group = group;
+    emit groupChanged(group);
+    reinitializeFromKeys();
+}
+
+const QString& QmlControlGroupProxy::getGroup() const {
+    return m_group;
+}
+
+void QmlControlGroupProxy::setKeys(const QStringList& keys) {
+    if (m_keys == keys) {
+        return;
+    }
+    m_keys = keys;
+    emit keysChanged(keys);
+    reinitializeFromKeys();
+}
+
+const QStringList& QmlControlGroupProxy::getKeys() const {
+    return m_keys;
+}
+
+const QVariantMap& QmlControlGroupProxy::getValues() const {
+    return m_values;
+}
+
+void QmlControlGroupProxy::setValue(const QString& key, double newValue) {
+    ControlProxy* pControlProxy = findControlProxy(key);
+    if (!pControlProxy) {
+        qWarning() << "QmlControlGroupProxy: Tried to set unknown CO" << key
+                   << "of group" << m_group;
+        return;
+    }
+    pControlProxy->set(newValue);
+    slotControlProxyValueChanged(newValue);
+}
+
+ControlProxy* QmlControlGroupProxy::findControlProxy(const QString& key) const {
+    for (const auto& pControlProxy : m_controlProxies) {
+        if (pControlProxy->getKey().item == key) {
+            return pControlProxy.get();
+        }
+    }
+    return nullptr;
+}
+
+void QmlControlGroupProxy::reinitializeFromKeys() {
+    // Just ignore this if the component is still loading, because group or
+    // keys may not be set yet.
+    if (!m_isComponentComplete) {
+        return;
+    }
+
+    m_controlProxies.clear();
+    m_controlProxies.reserve(m_keys.size());
+    for (const auto& key : qAsConst(m_keys)) {
+        const ConfigKey coKey(m_group, key);
+        if (!coKey.isValid()) {
+            qWarning() << "QmlControlGroupProxy: Ignoring invalid CO" << coKey;
+            continue;
+        }
+        auto pControlProxy = std::make_unique<ControlProxy>(
+                coKey, this, ControlFlag::NoWarnIfMissing);
+        if (!pControlProxy->valid()) {
+            qWarning() << "QmlControlGroupProxy: Requested CO" << coKey
+                       << "does not exist, ignoring...";
+            continue;
+        }
+        pControlProxy->connectValueChanged(this,
+                &QmlControlGroupProxy::slotControlProxyValueChanged);
+        m_controlProxies.push_back(std::move(pControlProxy));
+    }
+    slotEmitValuesChanged();
+}
+
+void QmlControlGroupProxy::slotControlProxyValueChanged(double newValue) {
+    Q_UNUSED(newValue);
+    if (m_valuesChangedPending) {
+        return;
+    }
+    // Collect all changes of this event loop iteration
+    m_valuesChangedPending = true;
+    QMetaObject::invokeMethod(this,
+            &QmlControlGroupProxy::slotEmitValuesChanged,
+            Qt::QueuedConnection);
+}
+
+void QmlControlGroupProxy::slotEmitValuesChanged() {
+    m_valuesChangedPending = false;
+    QVariantMap values;
+    for (const auto& pControlProxy : m_controlProxies) {
+        values.insert(pControlProxy->getKey().item, pControlProxy->get());
+    }
+    if (values == m_values) {
+        return;
+    }
+    m_values = values;
+    emit valuesChanged();
+}
+
+} // namespace qml
+} // namespace mixxx
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QObject>
+#include <QQmlParserStatus>
+#include <QStringList>
+#include <QVariantMap>
+#include <QtQml>
+#include <memory>
+#include <vector>
+
+#include "control/controlproxy.h"
+
+namespace mixxx {
+namespace qml {
+
+/// Exposes many controls of one group through a single object.
+///
+/// Unlike a ControlProxy per control, the values are published as one map
+/// with a single change notification. All changes that arrive within the
+/// same event loop iteration, e.g. the coalesced changes of the engine
+/// controls for a GuiTick, are delivered by a single valuesChanged signal,
+/// so bindings to the map are only evaluated once.
+class QmlControlGroupProxy : public QObject, public QQmlParserStatus {
+    Q_OBJECT
+    Q_INTERFACES(QQmlParserStatus)
+    Q_PROPERTY(QString group READ getGroup WRITE setGroup NOTIFY groupChanged REQUIRED)
+    Q_PROPERTY(QStringList keys READ getKeys WRITE setKeys NOTIFY keysChanged REQUIRED)
+    Q_PROPERTY(QVariantMap values READ getValues NOTIFY valuesChanged)
+    QML_NAMED_ELEMENT(ControlGroup)
+
+  public:
+    explicit QmlControlGroupProxy(QObject* parent = nullptr);
+    ~QmlControlGroupProxy() override;
+
+    void classBegin() override{};
+    void componentComplete() override;
+
+    void setGroup(const QString& group);
+    const QString& getGroup() const;
+
+    void setKeys(const QStringList& keys);
+    const QStringList& getKeys() const;
+
+    /// Maps each existing control of the keys to its value
+    const QVariantMap& getValues() const;
+
+    /// Sets the value of the control with the given key.
+    Q_INVOKABLE void setValue(const QString& key, double newValue);
+
+  signals:
+    void groupChanged(const QString& group);
+    void keysChanged(const QStringList& keys);
+    void valuesChanged();
+
+  private slots:
+    void slotControlProxyValueChanged(double newValue);
+    void slotEmitValuesChanged();
+
+  private:
+    /// (Re-)Creates the control proxies for all keys once the component
+    /// is complete.
+    void reinitializeFromKeys();
+    ControlProxy* findControlProxy(const QString& key) const;
+
+    bool m_isComponentComplete;
+    bool m_valuesChangedPending;
+    QString m_group;
+    QStringList m_keys;
+    std::vector<std::unique_ptr<ControlProxy>> m_controlProxies;
+    QVariantMap m_values;
+};
+
+} // namespace qml
+} // namespace mixxx
@@ -1,6 +1,7 @@
 #include "qml/qmllibrarytracklistmodel.h"
 
 #include "library/librarytablemodel.h"
+#include "qml/asyncimageprovider.h"
 
 namespace mixxx {
 namespace qml {
@@ -11,13 +12,16 @@ const QHash<int, QByteArray> kRoleNames = {
         {QmlLibraryTrackListModel::AlbumRole, "album"},
         {QmlLibraryTrackListModel::AlbumArtistRole, "albumArtist"},
         {QmlLibraryTrackListModel::FileUrlRole, "fileUrl"},
+        {QmlLibraryTrackListModel::CoverArtUrlRole, "coverArtUrl"},
 };
 }
 
 QmlLibraryTrackListModel::QmlLibraryTrackListModel(LibraryTableModel* pModel, QObject* pParent)
         : QIdentityProxyModel(pParent) {
-    pModel->select();
     setSourceModel(pModel);
+    // Don't block the GUI while querying a large library, the rows are
+    // inserted when the query on the worker connection has finished.
+    pModel->selectAsync();
 }
 
 QVariant QmlLibraryTrackListModel::data(const QModelIndex& proxyIndex, int role) const {
@@ -62,6 +66,18 @@ QVariant QmlLibraryTrackListModel::data(const QModelIndex& proxyIndex, int role)
         }
         return QUrl::fromLocalFile(location);
     }
+    case CoverArtUrlRole: {
+        // The cover art is loaded by the AsyncImageProvider on its own
+        // thread pool once the delegate requests it.
+        column = pSourceModel->fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION);
+        const QString location = QIdentityProxyModel::data(
+                proxyIndex.siblingAtColumn(column), Qt::DisplayRole)
+                                         .toString();
+        if (location.isEmpty()) {
+            return {};
+        }
+        return AsyncImageProvider::trackLocationToCoverArtUrl(location);
+    }
     default:
         break;
     }
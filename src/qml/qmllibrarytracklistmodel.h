@@ -19,6 +19,7 @@ class QmlLibraryTrackListModel : public QIdentityProxyModel {
         AlbumRole,
         AlbumArtistRole,
         FileUrlRole,
+        CoverArtUrlRole,
     };
     Q_ENUM(Roles);
 
@@ -1,23 +1,72 @@
 #include "qml/qmlwaveformoverview.h"
 
+#include <QMatrix4x4>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+#include <QSGVertexColorMaterial>
+#include <algorithm>
+
 #include "mixer/basetrackplayer.h"
 #include "qml/qmlplayerproxy.h"
 
 namespace {
 constexpr double kDesiredChannelHeight = 255;
+
+void appendLine(std::vector<QSGGeometry::ColoredPoint2D>* pVertices,
+        float x,
+        float y1,
+        float y2,
+        const QColor& color) {
+    const auto red = static_cast<unsigned char>(color.red());
+    const auto green = static_cast<unsigned char>(color.green());
+    const auto blue = static_cast<unsigned char>(color.blue());
+    QSGGeometry::ColoredPoint2D vertex;
+    vertex.set(x, y1, red, green, blue, 255);
+    pVertices->push_back(vertex);
+    vertex.set(x, y2, red, green, blue, 255);
+    pVertices->push_back(vertex);
+}
 } // namespace
 
 namespace mixxx {
 namespace qml {
 
 QmlWaveformOverview::QmlWaveformOverview(QQuickItem* parent)
-        : QQuickPaintedItem(parent),
+        : QQuickItem(parent),
           m_pPlayer(nullptr),
           m_channels(ChannelFlag::BothChannels),
           m_renderer(Renderer::RGB),
           m_colorHigh(0xFF0000),
           m_colorMid(0x00FF00),
-          m_colorLow(0x0000FF) {
+          m_colorLow(0x0000FF),
+          m_geometryDirty(true),
+          m_geometryColumns(0) {
+    setFlag(QQuickItem::ItemHasContents);
+
+    // Resizing only changes the transformation of the geometry
+    connect(this, &QQuickItem::widthChanged, this, &QQuickItem::update);
+    connect(this, &QQuickItem::heightChanged, this, &QQuickItem::update);
+
+    connect(this,
+            &QmlWaveformOverview::channelsChanged,
+            this,
+            &QmlWaveformOverview::slotGeometryChanged);
+    connect(this,
+            &QmlWaveformOverview::rendererChanged,
+            this,
+            &QmlWaveformOverview::slotGeometryChanged);
+    connect(this,
+            &QmlWaveformOverview::colorHighChanged,
+            this,
+            &QmlWaveformOverview::slotGeometryChanged);
+    connect(this,
+            &QmlWaveformOverview::colorMidChanged,
+            this,
+            &QmlWaveformOverview::slotGeometryChanged);
+    connect(this,
+            &QmlWaveformOverview::colorLowChanged,
+            this,
+            &QmlWaveformOverview::slotGeometryChanged);
 }
 
 QmlPlayerProxy* QmlWaveformOverview::getPlayer() const {
@@ -51,7 +100,7 @@ void QmlWaveformOverview::setPlayer(QmlPlayerProxy* pPlayer) {
     }
 
     emit playerChanged();
-    update();
+    slotGeometryChanged();
 }
 
 QmlWaveformOverview::Channels QmlWaveformOverview::getChannels() const {
@@ -105,91 +154,122 @@ void QmlWaveformOverview::setCurrentTrack(TrackPointer pTrack) {
 }
 
 void QmlWaveformOverview::slotWaveformUpdated() {
+    slotGeometryChanged();
+}
+
+void QmlWaveformOverview::slotGeometryChanged() {
+    m_geometryDirty = true;
     update();
 }
 
-void QmlWaveformOverview::paint(QPainter* pPainter) {
+QSGNode* QmlWaveformOverview::updatePaintNode(
+        QSGNode* pOldNode, UpdatePaintNodeData* pData) {
+    Q_UNUSED(pData);
+    // This runs on the render thread while the GUI thread is blocked, so
+    // the members can be accessed safely.
+    auto* pTransformNode = static_cast<QSGTransformNode*>(pOldNode);
+    QSGGeometryNode* pGeometryNode;
+    if (!pTransformNode) {
+        pTransformNode = new QSGTransformNode;
+        pGeometryNode = new QSGGeometryNode;
+        auto* pGeometry = new QSGGeometry(
+                QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+        pGeometry->setDrawingMode(QSGGeometry::DrawLines);
+        pGeometryNode->setGeometry(pGeometry);
+        pGeometryNode->setFlag(QSGNode::OwnsGeometry);
+        pGeometryNode->setMaterial(new QSGVertexColorMaterial);
+        pGeometryNode->setFlag(QSGNode::OwnsMaterial);
+        pTransformNode->appendChildNode(pGeometryNode);
+        m_geometryDirty = true;
+    } else {
+        pGeometryNode = static_cast<QSGGeometryNode*>(pTransformNode->firstChild());
+    }
+
+    if (m_geometryDirty) {
+        m_geometryDirty = false;
+        std::vector<QSGGeometry::ColoredPoint2D> vertices;
+        m_geometryColumns = buildVertices(&vertices);
+        QSGGeometry* pGeometry = pGeometryNode->geometry();
+        pGeometry->allocate(static_cast<int>(vertices.size()));
+        std::copy(vertices.cbegin(),
+                vertices.cend(),
+                pGeometry->vertexDataAsColoredPoint2D());
+        pGeometryNode->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    // Map the waveform columns to the width and the values to the height of
+    // the item.
+    QMatrix4x4 matrix;
+    if (m_geometryColumns > 0) {
+        const float scaleX = static_cast<float>(width() / m_geometryColumns);
+        switch (m_channels) {
+        case static_cast<int>(ChannelFlag::LeftChannel):
+            matrix.translate(0.0f, static_cast<float>(height()));
+            matrix.scale(scaleX, static_cast<float>(height() / kDesiredChannelHeight));
+            break;
+        case static_cast<int>(ChannelFlag::RightChannel):
+            matrix.scale(scaleX, static_cast<float>(height() / kDesiredChannelHeight));
+            break;
+        default:
+            matrix.translate(0.0f, static_cast<float>(height() / 2));
+            matrix.scale(scaleX,
+                    static_cast<float>(height() / (2 * kDesiredChannelHeight)));
+        }
+    }
+    pTransformNode->setMatrix(matrix);
+    pTransformNode->markDirty(QSGNode::DirtyMatrix);
+
+    return pTransformNode;
+}
+
+int QmlWaveformOverview::buildVertices(
+        std::vector<QSGGeometry::ColoredPoint2D>* pVertices) const {
     TrackPointer pTrack = m_pCurrentTrack;
     if (!pTrack) {
-        return;
+        return 0;
     }
 
     ConstWaveformPointer pWaveform = pTrack->getWaveformSummary();
     if (!pWaveform) {
-        return;
+        return 0;
     }
 
     const int dataSize = pWaveform->getDataSize();
     if (dataSize == 0) {
-        return;
+        return 0;
     }
 
-    constexpr int actualCompletion = 0;
     // Always multiple of 2
-    const int waveformCompletion = pWaveform->getCompletion();
-    // Test if there is some new to draw (at least of pixel width)
-    const int completionIncrement = waveformCompletion - actualCompletion;
-
-    const qreal desiredWidth = static_cast<qreal>(dataSize) / 2;
-    const double visiblePixelIncrement = completionIncrement * desiredWidth / dataSize;
-    if (waveformCompletion < (dataSize - 2) &&
-            (completionIncrement < 2 || visiblePixelIncrement == 0)) {
-        return;
-    }
-
-    const int nextCompletion = actualCompletion + completionIncrement;
-
+    const int completion = pWaveform->getCompletion();
     const Channels channels = m_channels;
-    pPainter->save();
-
-    switch (channels) {
-    case static_cast<int>(ChannelFlag::LeftChannel):
-        // Draw both channels.
-        // Set the y axis to half the height of the item
-        pPainter->translate(0.0, height());
-        // Set the x axis to half the height of the item
-        pPainter->scale(width() / desiredWidth, height() / kDesiredChannelHeight);
-        break;
-    case static_cast<int>(ChannelFlag::RightChannel):
-        // Set the x axis to half the height of the item
-        pPainter->scale(width() / desiredWidth, height() / kDesiredChannelHeight);
-        break;
-    default:
-        // Draw both channels.
-        // Set the y axis to half the height of the item
-        pPainter->translate(0.0, height() / 2);
-        // Set the x axis to half the height of the item
-        pPainter->scale(width() / desiredWidth, height() / (2 * kDesiredChannelHeight));
-    }
-
-    Renderer renderer = m_renderer;
-    for (int currentCompletion = actualCompletion;
-            currentCompletion < nextCompletion;
+    const int linesPerColumn = m_renderer == Renderer::Filtered ? 3 : 1;
+    pVertices->reserve(static_cast<size_t>(completion) * linesPerColumn * 2);
+    for (int currentCompletion = 0;
+            currentCompletion < completion;
             currentCompletion += 2) {
-        switch (renderer) {
+        switch (m_renderer) {
         case Renderer::Filtered:
-            drawFiltered(pPainter, channels, pWaveform, currentCompletion);
+            appendFiltered(pVertices, channels, pWaveform, currentCompletion);
             break;
         default:
-            drawRgb(pPainter, channels, pWaveform, currentCompletion);
+            appendRgb(pVertices, channels, pWaveform, currentCompletion);
         }
     }
-    pPainter->restore();
+    return dataSize / 2;
 }
 
-void QmlWaveformOverview::drawRgb(QPainter* pPainter,
+void QmlWaveformOverview::appendRgb(std::vector<QSGGeometry::ColoredPoint2D>* pVertices,
         Channels channels,
         ConstWaveformPointer pWaveform,
         int completion) const {
-    const double offsetX = completion / 2.0;
+    const float offsetX = completion / 2.0f;
 
     if (channels.testFlag(ChannelFlag::LeftChannel)) {
         // Draw left channel
         const QColor leftColor = getRgbPenColor(pWaveform, completion);
         if (leftColor.isValid()) {
             const uint8_t leftValue = pWaveform->getAll(completion);
-            pPainter->setPen(leftColor);
-            pPainter->drawLine(QPointF(offsetX, -leftValue), QPointF(offsetX, 0.0));
+            appendLine(pVertices, offsetX, -leftValue, 0.0f, leftColor);
         }
     }
 
@@ -198,44 +278,37 @@ void QmlWaveformOverview::drawRgb(QPainter* pPainter,
         QColor rightColor = getRgbPenColor(pWaveform, completion + 1);
         if (rightColor.isValid()) {
             const uint8_t rightValue = pWaveform->getAll(completion + 1);
-            pPainter->setPen(rightColor);
-            pPainter->drawLine(QPointF(offsetX, 0.0), QPointF(offsetX, rightValue));
+            appendLine(pVertices, offsetX, 0.0f, rightValue, rightColor);
         }
     }
 }
 
-void QmlWaveformOverview::drawFiltered(QPainter* pPainter,
+void QmlWaveformOverview::appendFiltered(std::vector<QSGGeometry::ColoredPoint2D>* pVertices,
         Channels channels,
         ConstWaveformPointer pWaveform,
         int completion) const {
-    const double offsetX = completion / 2.0;
+    const float offsetX = completion / 2.0f;
 
     if (channels.testFlag(ChannelFlag::LeftChannel)) {
         const uint8_t leftHigh = pWaveform->getHigh(completion);
-        pPainter->setPen(m_colorHigh);
-        pPainter->drawLine(QPointF(offsetX, 2 * -leftHigh), QPointF(offsetX, 0.0));
+        appendLine(pVertices, offsetX, 2.0f * -leftHigh, 0.0f, m_colorHigh);
 
         const uint8_t leftMid = pWaveform->getMid(completion);
-        pPainter->setPen(m_colorMid);
-        pPainter->drawLine(QPointF(offsetX, 1.5 * -leftMid), QPointF(offsetX, 0.0));
+        appendLine(pVertices, offsetX, 1.5f * -leftMid, 0.0f, m_colorMid);
 
         const uint8_t leftLow = pWaveform->getLow(completion);
-        pPainter->setPen(m_colorLow);
-        pPainter->drawLine(QPointF(offsetX, -leftLow), QPointF(offsetX, 0.0));
+        appendLine(pVertices, offsetX, -leftLow, 0.0f, m_colorLow);
     }
 
     if (channels.testFlag(ChannelFlag::RightChannel)) {
         const uint8_t rightHigh = pWaveform->getHigh(completion + 1);
-        pPainter->setPen(m_colorHigh);
-        pPainter->drawLine(QPointF(offsetX, 0), QPointF(offsetX, 2 * rightHigh));
+        appendLine(pVertices, offsetX, 0.0f, 2.0f * rightHigh, m_colorHigh);
 
-        const uint8_t rightMid = pWaveform->getMid(completion + 1) * 2;
-        pPainter->setPen(m_colorMid);
-        pPainter->drawLine(QPointF(offsetX, 0), QPointF(offsetX, 1.5 * rightMid));
+        const uint8_t rightMid = pWaveform->getMid(completion + 1);
+        appendLine(pVertices, offsetX, 0.0f, 1.5f * rightMid, m_colorMid);
 
         const uint8_t rightLow = pWaveform->getLow(completion + 1);
-        pPainter->setPen(m_colorLow);
-        pPainter->drawLine(QPointF(offsetX, 0), QPointF(offsetX, rightLow));
+        appendLine(pVertices, offsetX, 0.0f, rightLow, m_colorLow);
     }
 }
 
@@ -1,10 +1,10 @@
 #pragma once
 
-#include <QPainter>
 #include <QPointer>
 #include <QQuickItem>
-#include <QQuickPaintedItem>
+#include <QSGGeometry>
 #include <QtQml>
+#include <vector>
 
 #include "track/track.h"
 
@@ -13,7 +13,12 @@ namespace qml {
 
 class QmlPlayerProxy;
 
-class QmlWaveformOverview : public QQuickPaintedItem {
+/// Renders the waveform summary of the loaded track with the scene graph.
+///
+/// The line geometry is only rebuilt when the waveform or the appearance
+/// changed and is scaled to the size of the item by a transform node, so
+/// redrawing or resizing the item doesn't touch the waveform data.
+class QmlWaveformOverview : public QQuickItem {
     Q_OBJECT
     Q_FLAGS(Channels)
     Q_PROPERTY(mixxx::qml::QmlPlayerProxy* player READ getPlayer WRITE setPlayer
@@ -42,18 +47,20 @@ class QmlWaveformOverview : public QQuickPaintedItem {
     QmlWaveformOverview(QQuickItem* parent = nullptr);
     ~QmlWaveformOverview() override = default;
 
-    void paint(QPainter* painter);
-
     void setPlayer(QmlPlayerProxy* player);
     QmlPlayerProxy* getPlayer() const;
 
     void setChannels(Channels channels);
     Channels getChannels() const;
+  protected:
+    QSGNode* updatePaintNode(QSGNode* pOldNode, UpdatePaintNodeData* pData) override;
+
   private slots:
     void slotTrackLoaded(TrackPointer pLoadedTrack);
     void slotTrackLoading(TrackPointer pNewTrack, TrackPointer pOldTrack);
     void slotTrackUnloaded();
     void slotWaveformUpdated();
+    void slotGeometryChanged();
 
   signals:
     void playerChanged();
@@ -65,11 +72,13 @@ class QmlWaveformOverview : public QQuickPaintedItem {
 
   private:
     void setCurrentTrack(TrackPointer pTrack);
-    void drawFiltered(QPainter* pPainter,
+    /// Returns the number of waveform columns that the vertices cover
+    int buildVertices(std::vector<QSGGeometry::ColoredPoint2D>* pVertices) const;
+    void appendFiltered(std::vector<QSGGeometry::ColoredPoint2D>* pVertices,
             Channels channels,
             ConstWaveformPointer pWaveform,
             int completion) const;
-    void drawRgb(QPainter* pPainter,
+    void appendRgb(std::vector<QSGGeometry::ColoredPoint2D>* pVertices,
             Channels channels,
             ConstWaveformPointer pWaveform,
             int completion) const;
@@ -82,6 +91,8 @@ class QmlWaveformOverview : public QQuickPaintedItem {
     QColor m_colorHigh;
     QColor m_colorMid;
     QColor m_colorLow;
+    bool m_geometryDirty;
+    int m_geometryColumns;
 };
 
 } // namespace qml
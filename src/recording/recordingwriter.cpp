@@ -0,0 +1,167 @@
+#include "recording/recordingwriter.h"
+
+#include "moc_recordingwriter.cpp"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace {
+
+const mixxx::Logger kLogger("RecordingWriter");
+
+// Consecutive writes of the encoder are collected in buffers of this
+// size, which are written at once. This is ~1.5 s of stereo audio
+// with 16 bit at 44.1 kHz.
+constexpr int kBufferCapacity = 256 * 1024;
+
+// Data that the disk could not keep up with is dropped instead of
+// blocking the encoder. This is ~6 minutes of stereo audio with
+// 16 bit at 44.1 kHz.
+constexpr qint64 kMaxPendingBytes = 64 * 1024 * 1024;
+
+} // anonymous namespace
+
+RecordingWriter::RecordingWriter(const QString& fileName)
+        : m_file(fileName),
+          m_pendingBytes(0),
+          m_stop(false),
+          m_error(0),
+          m_open(false),
+          m_pos(0),
+          m_size(0) {
+}
+
+RecordingWriter::~RecordingWriter() {
+    close();
+}
+
+bool RecordingWriter::open() {
+    VERIFY_OR_DEBUG_ASSERT(!isRunning()) {
+        return false;
+    }
+    if (!m_file.open(QIODevice::WriteOnly)) {
+        kLogger.warning()
+                << "Failed to open"
+                << m_file.fileName()
+                << m_file.errorString();
+        return false;
+    }
+    m_pos = 0;
+    m_size = 0;
+    m_pendingBytes = 0;
+    m_stop = false;
+    m_error = 0;
+    m_open = true;
+    start(QThread::HighPriority);
+    return true;
+}
+
+void RecordingWriter::requestClose() {
+    if (!m_open) {
+        return;
+    }
+    m_open = false;
+    {
+        const auto locker = lockMutex(&m_mutex);
+        m_stop = true;
+    }
+    m_buffersAvailable.wakeOne();
+}
+
+void RecordingWriter::close() {
+    requestClose();
+    wait();
+}
+
+bool RecordingWriter::isOpen() const {
+    return m_open;
+}
+
+bool RecordingWriter::hasError() const {
+    return m_error.loadAcquire() != 0;
+}
+
+void RecordingWriter::seek(qint64 pos) {
+    DEBUG_ASSERT(pos >= 0);
+    m_pos = pos;
+}
+
+void RecordingWriter::write(const char* pData, int length) {
+    if (length <= 0) {
+        return;
+    }
+    const qint64 offset = m_pos;
+    m_pos += length;
+    m_size = math_max(m_size, m_pos);
+    {
+        const auto locker = lockMutex(&m_mutex);
+        if (m_pendingBytes + length > kMaxPendingBytes) {
+            if (m_error.fetchAndStoreRelease(1) == 0) {
+                kLogger.warning()
+                        << "Dropping recorded data, the disk is too slow:"
+                        << m_file.fileName();
+            }
+            return;
+        }
+        // Append to the last buffer if the data continues it
+        if (m_pendingBuffers.empty() ||
+                m_pendingBuffers.back().offset +
+                                m_pendingBuffers.back().data.size() !=
+                        offset ||
+                m_pendingBuffers.back().data.size() + length > kBufferCapacity) {
+            Buffer buffer;
+            buffer.offset = offset;
+            buffer.data.reserve(math_max(kBufferCapacity, length));
+            m_pendingBuffers.push_back(std::move(buffer));
+        }
+        m_pendingBuffers.back().data.append(pData, length);
+        m_pendingBytes += length;
+    }
+    m_buffersAvailable.wakeOne();
+}
+
+void RecordingWriter::run() {
+    std::vector<Buffer> buffers;
+    while (true) {
+        bool stop;
+        {
+            auto locker = lockMutex(&m_mutex);
+            while (m_pendingBuffers.empty() && !m_stop) {
+                m_buffersAvailable.wait(&m_mutex);
+            }
+            buffers.swap(m_pendingBuffers);
+            m_pendingBytes = 0;
+            stop = m_stop;
+        }
+        if (!writeBuffers(buffers) && m_error.fetchAndStoreRelease(1) == 0) {
+            kLogger.warning()
+                    << "Failed to write"
+                    << m_file.fileName()
+                    << m_file.errorString();
+        }
+        buffers.clear();
+        if (stop) {
+            m_file.close();
+            return;
+        }
+    }
+}
+
+bool RecordingWriter::writeBuffers(const std::vector<Buffer>& buffers) {
+    bool success = true;
+    for (const auto& buffer : buffers) {
+        if (m_file.pos() != buffer.offset && !m_file.seek(buffer.offset)) {
+            success = false;
+            continue;
+        }
+        if (m_file.write(buffer.data) != buffer.data.size()) {
+            success = false;
+        }
+    }
+    // Hand the data over to the operating system, so that it is not
+    // lost if Mixxx crashes
+    if (!buffers.empty() && !m_file.flush()) {
+        success = false;
+    }
+    return success;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <vector>
+
+/// RecordingWriter writes the encoded audio of a recording to a file on
+/// its own thread. The encoder only appends to large in-memory buffers,
+/// so a slow disk or a full USB stick never blocks the side chain and
+/// with it the broadcasting.
+///
+/// The encoder might seek back to update the header of the file. These
+/// writes are queued in order like all other writes. All functions except
+/// the constructor and destructor must be called from the encoding thread.
+class RecordingWriter : public QThread {
+    Q_OBJECT
+  public:
+    explicit RecordingWriter(const QString& fileName);
+    ~RecordingWriter() override;
+
+    /// Opens the file and starts the writer thread.
+    bool open();
+    /// Lets the writer thread write all pending data and close the file
+    /// without waiting for it. The writer must not be used afterwards.
+    void requestClose();
+    /// Like requestClose(), but blocks until the file has been closed.
+    void close();
+    bool isOpen() const;
+
+    /// Queues the data for writing at the current position, never blocks
+    /// for writing.
+    void write(const char* pData, int length);
+    qint64 pos() const {
+        return m_pos;
+    }
+    void seek(qint64 pos);
+    qint64 size() const {
+        return m_size;
+    }
+
+    /// Returns true if writing failed or if the disk could not keep up
+    /// and data had to be dropped. The recording is incomplete then.
+    bool hasError() const;
+
+  protected:
+    void run() override;
+
+  private:
+    struct Buffer {
+        qint64 offset;
+        QByteArray data;
+    };
+
+    bool writeBuffers(const std::vector<Buffer>& buffers);
+
+    QFile m_file;
+
+    // Shared with the writer thread
+    QMutex m_mutex;
+    QWaitCondition m_buffersAvailable;
+    std::vector<Buffer> m_pendingBuffers;
+    qint64 m_pendingBytes;
+    bool m_stop;
+    QAtomicInt m_error;
+
+    // Only accessed by the encoding thread
+    bool m_open;
+    qint64 m_pos;
+    qint64 m_size;
+};
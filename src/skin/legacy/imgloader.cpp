@@ -2,6 +2,7 @@
 #include <QFileInfo>
 
 #include "imgloader.h"
+#include "skin/legacy/skinresourcepreloader.h"
 #include "widget/wwidget.h"
 
 ImgLoader::ImgLoader() {
@@ -33,6 +34,15 @@ QImage* ImgLoader::getImage(const QString& fileName, double scaleFactor) const {
         }
     }
 
+    {
+        // Decoded on a worker thread while parsing the skin
+        const QImage image = SkinResourcePreloader::image(fileName, scaleFactor);
+        if (!image.isNull()) {
+            *pImage = image;
+            return pImage;
+        }
+    }
+
     {
         QImageReader reader(fileName);
         QSize originalSize = reader.size();
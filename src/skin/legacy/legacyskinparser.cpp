@@ -1,5 +1,6 @@
 #include "skin/legacy/legacyskinparser.h"
 
+#include <QCryptographicHash>
 #include <QDir>
 #include <QGridLayout>
 #include <QLabel>
@@ -24,6 +25,8 @@
 #include "skin/legacy/colorschemeparser.h"
 #include "skin/legacy/launchimage.h"
 #include "skin/legacy/skincontext.h"
+#include "skin/legacy/skinimagecache.h"
+#include "skin/legacy/skinresourcepreloader.h"
 #include "util/cmdlineargs.h"
 #include "util/timer.h"
 #include "util/valuetransformer.h"
@@ -97,6 +100,46 @@ QSet<QString> LegacySkinParser::s_sharedGroupStrings;
 
 static bool sDebug = false;
 
+namespace {
+
+const QString kSkinImageCacheDirectoryName = QStringLiteral("skin_images");
+
+struct CachedXmlDocument {
+    QByteArray contentHash;
+    QDomDocument document;
+};
+
+// The parsed skin and template files are reused when reloading the skin,
+// e.g. after changing the scale factor, as long as their content is
+// unchanged. The documents are never modified while parsing the skin.
+// Only accessed from the GUI thread.
+QHash<QString, CachedXmlDocument> s_xmlDocumentCache;
+
+QDomElement parseXmlFileCached(
+        QFile* pFile,
+        const QString& documentName,
+        QString* pErrorMessage,
+        int* pErrorLine,
+        int* pErrorColumn) {
+    const QByteArray content = pFile->readAll();
+    const QByteArray contentHash =
+            QCryptographicHash::hash(content, QCryptographicHash::Sha1);
+    const QString filePath = QFileInfo(*pFile).absoluteFilePath();
+    const auto it = s_xmlDocumentCache.constFind(filePath);
+    if (it != s_xmlDocumentCache.constEnd() && it->contentHash == contentHash) {
+        return it->document.documentElement();
+    }
+    QDomDocument document(documentName);
+    if (!document.setContent(content, pErrorMessage, pErrorLine, pErrorColumn)) {
+        s_xmlDocumentCache.remove(filePath);
+        return QDomElement();
+    }
+    s_xmlDocumentCache.insert(filePath, CachedXmlDocument{contentHash, document});
+    return document.documentElement();
+}
+
+} // anonymous namespace
+
 ControlObject* LegacySkinParser::controlFromConfigKey(
         const ConfigKey& key, bool bPersist, bool* pCreated) {
     if (!key.isValid()) {
@@ -229,13 +272,16 @@ QDomElement LegacySkinParser::openSkin(const QString& skinPath) {
         return QDomElement();
     }
 
-    QDomDocument skin("skin");
-
     QString errorMessage;
     int errorLine;
     int errorColumn;
 
-    if (!skin.setContent(&skinXmlFile,&errorMessage,&errorLine,&errorColumn)) {
+    const QDomElement skin = parseXmlFileCached(&skinXmlFile,
+            QStringLiteral("skin"),
+            &errorMessage,
+            &errorLine,
+            &errorColumn);
+    if (skin.isNull()) {
         qDebug() << "LegacySkinParser::openSkin - setContent failed see"
                  << "line:" << errorLine << "column:" << errorColumn;
         qDebug() << "LegacySkinParser::openSkin - message:" << errorMessage;
@@ -243,7 +289,7 @@ QDomElement LegacySkinParser::openSkin(const QString& skinPath) {
     }
 
     skinXmlFile.close();
-    return skin.documentElement();
+    return skin;
 }
 
 // static
@@ -327,6 +373,11 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
     m_pContext = std::make_unique<SkinContext>(m_pConfig, skinPath + "/skin.xml");
     m_pContext->setSkinBasePath(skinPath);
 
+    // Read and decode the images of the skin while parsing it
+    SkinImageCache::setDirectory(
+            QDir(m_pConfig->getSettingsPath()).filePath(kSkinImageCacheDirectoryName));
+    const SkinResourcePreloader resourcePreloader(skinPath, m_pContext->getScaleFactor());
+
     if (m_pParent) {
         qDebug() << "ERROR: Somehow a parent already exists -- you are probably re-using a LegacySkinParser which is not advisable!";
     }
@@ -1593,22 +1644,25 @@ QDomElement LegacySkinParser::loadTemplate(const QString& path) {
         qWarning() << "Could not open template file:" << absolutePath;
     }
 
-    QDomDocument tmpl("template");
     QString errorMessage;
     int errorLine;
     int errorColumn;
 
-    if (!tmpl.setContent(&templateFile, &errorMessage,
-                         &errorLine, &errorColumn)) {
+    const QDomElement tmpl = parseXmlFileCached(&templateFile,
+            QStringLiteral("template"),
+            &errorMessage,
+            &errorLine,
+            &errorColumn);
+    if (tmpl.isNull()) {
         qWarning() << "LegacySkinParser::loadTemplate - setContent failed see"
                    << absolutePath << "line:" << errorLine << "column:" << errorColumn;
         qWarning() << "LegacySkinParser::loadTemplate - message:" << errorMessage;
         return QDomElement();
     }
 
-    m_templateCache[absolutePath] = tmpl.documentElement();
+    m_templateCache[absolutePath] = tmpl;
     m_pContext->setSkinTemplatePath(templateFileInfo.absoluteDir().absolutePath());
-    return tmpl.documentElement();
+    return tmpl;
 }
 
 QList<QWidget*> LegacySkinParser::parseTemplate(const QDomElement& node) {
@@ -0,0 +1,118 @@
+#include "skin/legacy/skinimagecache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QPainter>
+#include <QSaveFile>
+#include <QSvgRenderer>
+#include <QtConcurrentRun>
+#include <QtDebug>
+
+#include "skin/legacy/skinresourcepreloader.h"
+#include "util/assert.h"
+
+namespace {
+
+const char* const kImageFormat = "PNG";
+
+void saveImage(const QString& filePath, const QImage& image) {
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open skin image cache file" << filePath;
+        return;
+    }
+    if (!image.save(&file, kImageFormat) || !file.commit()) {
+        qWarning() << "Failed to write skin image cache file" << filePath;
+    }
+}
+
+} // anonymous namespace
+
+// static
+QString SkinImageCache::s_directoryPath;
+
+// static
+void SkinImageCache::setDirectory(const QString& directoryPath) {
+    if (!directoryPath.isEmpty() && !QDir().mkpath(directoryPath)) {
+        qWarning() << "Failed to create skin image cache directory" << directoryPath;
+        s_directoryPath.clear();
+        return;
+    }
+    s_directoryPath = directoryPath;
+}
+
+// static
+QString SkinImageCache::cacheFilePath(const QByteArray& svgData, double scaleFactor) {
+    if (s_directoryPath.isEmpty()) {
+        return QString();
+    }
+    const QByteArray hash = QCryptographicHash::hash(svgData, QCryptographicHash::Sha1);
+    return s_directoryPath + QChar('/') + QString::fromLatin1(hash.toHex()) +
+            QChar('@') + QString::number(scaleFactor) + QStringLiteral(".png");
+}
+
+// static
+QImage SkinImageCache::loadCachedImage(const QByteArray& svgData, double scaleFactor) {
+    const QString filePath = cacheFilePath(svgData, scaleFactor);
+    if (filePath.isEmpty() || !QFile::exists(filePath)) {
+        return QImage();
+    }
+    QImage image;
+    if (!image.load(filePath, kImageFormat)) {
+        qWarning() << "Failed to read skin image cache file" << filePath;
+        return QImage();
+    }
+    return image.convertToFormat(QImage::Format_ARGB32);
+}
+
+// static
+QImage SkinImageCache::renderSvg(const PixmapSource& source, double scaleFactor) {
+    DEBUG_ASSERT(source.isSVG());
+    QByteArray svgData = source.getSvgSourceData();
+    if (svgData.isEmpty()) {
+        if (source.getPath().isEmpty()) {
+            return QImage();
+        }
+        // The image might have been read from the cache on a worker thread
+        const QImage preloadedImage =
+                SkinResourcePreloader::svgImage(source.getPath(), scaleFactor);
+        if (!preloadedImage.isNull()) {
+            return preloadedImage;
+        }
+        svgData = SkinResourcePreloader::svgData(source.getPath());
+        if (svgData.isEmpty()) {
+            QFile file(source.getPath());
+            if (!file.open(QIODevice::ReadOnly)) {
+                qWarning() << "Failed to open SVG file" << source.getPath();
+                return QImage();
+            }
+            svgData = file.readAll();
+        }
+    }
+
+    QImage image = loadCachedImage(svgData, scaleFactor);
+    if (!image.isNull()) {
+        return image;
+    }
+
+    QSvgRenderer renderer;
+    if (!renderer.load(svgData)) {
+        // The above line already logs a warning
+        return QImage();
+    }
+    image = QImage(renderer.defaultSize() * scaleFactor, QImage::Format_ARGB32);
+    image.fill(0x00000000); // Transparent black.
+    QPainter painter(&image);
+    renderer.render(&painter);
+    painter.end();
+
+    const QString filePath = cacheFilePath(svgData, scaleFactor);
+    if (!filePath.isEmpty()) {
+        // The image is implicitly shared and not modified anymore
+        QtConcurrent::run([filePath, image] {
+            saveImage(filePath, image);
+        });
+    }
+    return image;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+
+#include "skin/legacy/pixmapsource.h"
+
+// Stores the SVG images of skins that have been rendered at a scale factor
+// on disk, so they are not rendered again at the next start, after
+// switching skins or after moving the window to a screen with a different
+// scale factor.
+//
+// The files are named after a hash of the SVG data and the scale factor.
+// The rendered images are stored before their colors are corrected for the
+// color scheme of the skin, which is cheap compared to rendering them.
+class SkinImageCache {
+  public:
+    // Enables the cache. Must be called on the GUI thread before a skin is
+    // parsed, an empty path disables it.
+    static void setDirectory(const QString& directoryPath);
+
+    // Renders the SVG source in its default size multiplied by the scale
+    // factor or loads the rendered image from the cache. Newly rendered
+    // images are written to the cache on a worker thread. Returns a null
+    // image if the SVG could not be loaded.
+    static QImage renderSvg(const PixmapSource& source, double scaleFactor);
+
+    // Only loads an image that has been rendered before. This is thread
+    // safe and used to read the cached images of a skin in the background.
+    static QImage loadCachedImage(const QByteArray& svgData, double scaleFactor);
+
+  private:
+    static QString cacheFilePath(const QByteArray& svgData, double scaleFactor);
+
+    static QString s_directoryPath;
+};
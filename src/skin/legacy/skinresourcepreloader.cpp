@@ -0,0 +1,119 @@
+#include "skin/legacy/skinresourcepreloader.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QtConcurrentMap>
+
+#include "skin/legacy/skinimagecache.h"
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+
+namespace {
+
+const QStringList kFileNameFilters = {
+        QStringLiteral("*.svg"),
+        QStringLiteral("*.png"),
+        QStringLiteral("*.jpg"),
+        QStringLiteral("*.jpeg"),
+        QStringLiteral("*.bmp"),
+        QStringLiteral("*.gif"),
+};
+
+// Only accessed from the GUI thread
+SkinResourcePreloader* s_pInstance = nullptr;
+
+inline QString normalizedFilePath(const QString& filePath) {
+    return QDir::cleanPath(QFileInfo(filePath).absoluteFilePath());
+}
+
+inline bool isSvgFile(const QString& filePath) {
+    return filePath.endsWith(QLatin1String(".svg"), Qt::CaseInsensitive);
+}
+
+} // anonymous namespace
+
+SkinResourcePreloader::SkinResourcePreloader(
+        const QString& skinPath, double scaleFactor)
+        : m_scaleFactor(scaleFactor) {
+    DEBUG_ASSERT(!s_pInstance);
+    s_pInstance = this;
+
+    QDirIterator it(skinPath,
+            kFileNameFilters,
+            QDir::Files | QDir::Readable,
+            QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        m_filePaths.append(normalizedFilePath(it.next()));
+    }
+    m_future = QtConcurrent::map(m_filePaths, [this](const QString& filePath) {
+        preloadFile(filePath);
+    });
+}
+
+SkinResourcePreloader::~SkinResourcePreloader() {
+    // Files that have not been preloaded until now are not needed anymore
+    m_future.cancel();
+    m_future.waitForFinished();
+    DEBUG_ASSERT(s_pInstance == this);
+    s_pInstance = nullptr;
+}
+
+void SkinResourcePreloader::preloadFile(const QString& filePath) {
+    if (isSvgFile(filePath)) {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+        const QByteArray data = file.readAll();
+        const QImage svgImage = SkinImageCache::loadCachedImage(data, m_scaleFactor);
+        const auto locked = lockMutex(&m_mutex);
+        m_svgData.insert(filePath, data);
+        if (!svgImage.isNull()) {
+            m_svgImages.insert(filePath, svgImage);
+        }
+        return;
+    }
+    // Same as ImgLoader for images without variants for the scale factor
+    QImageReader reader(filePath);
+    const QSize originalSize = reader.size();
+    if (!originalSize.isValid()) {
+        return;
+    }
+    reader.setScaledSize(originalSize * m_scaleFactor);
+    QImage image;
+    if (!reader.read(&image)) {
+        return;
+    }
+    const auto locked = lockMutex(&m_mutex);
+    m_images.insert(filePath, image);
+}
+
+// static
+QByteArray SkinResourcePreloader::svgData(const QString& filePath) {
+    if (!s_pInstance || !isSvgFile(filePath)) {
+        return QByteArray();
+    }
+    const auto locked = lockMutex(&s_pInstance->m_mutex);
+    return s_pInstance->m_svgData.value(normalizedFilePath(filePath));
+}
+
+// static
+QImage SkinResourcePreloader::image(const QString& filePath, double scaleFactor) {
+    if (!s_pInstance || s_pInstance->m_scaleFactor != scaleFactor) {
+        return QImage();
+    }
+    const auto locked = lockMutex(&s_pInstance->m_mutex);
+    return s_pInstance->m_images.value(normalizedFilePath(filePath));
+}
+
+// static
+QImage SkinResourcePreloader::svgImage(const QString& filePath, double scaleFactor) {
+    if (!s_pInstance || s_pInstance->m_scaleFactor != scaleFactor) {
+        return QImage();
+    }
+    const auto locked = lockMutex(&s_pInstance->m_mutex);
+    return s_pInstance->m_svgImages.value(normalizedFilePath(filePath));
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+// Reads the SVG files and decodes the raster images of a skin on worker
+// threads while the skin is parsed and its widgets are created on the GUI
+// thread. SVG images that have been rendered before are read from the
+// SkinImageCache.
+//
+// Only a single preloader exists at a time, which is registered globally
+// during its lifetime. The image loaders look up their files here first and
+// read them from disk as before if they have not been preloaded (yet), so the
+// GUI thread never waits for the workers. All preloaded data is released when
+// the preloader is destroyed after the skin has been parsed.
+class SkinResourcePreloader {
+  public:
+    SkinResourcePreloader(const QString& skinPath, double scaleFactor);
+    ~SkinResourcePreloader();
+
+    // Not copiable
+    SkinResourcePreloader(const SkinResourcePreloader&) = delete;
+    SkinResourcePreloader& operator=(const SkinResourcePreloader&) = delete;
+
+    // Returns the preloaded content of an SVG file or an empty byte array.
+    static QByteArray svgData(const QString& filePath);
+
+    // Returns the preloaded raster image, which has been scaled like by
+    // ImgLoader, or a null image.
+    static QImage image(const QString& filePath, double scaleFactor);
+
+    // Returns the rendered SVG image that has been read from the
+    // SkinImageCache or a null image.
+    static QImage svgImage(const QString& filePath, double scaleFactor);
+
+  private:
+    void preloadFile(const QString& filePath);
+
+    const double m_scaleFactor;
+    QStringList m_filePaths;
+
+    QMutex m_mutex;
+    QHash<QString, QByteArray> m_svgData;
+    QHash<QString, QImage> m_images;
+    QHash<QString, QImage> m_svgImages;
+
+    QFuture<void> m_future;
+};
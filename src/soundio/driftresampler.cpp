@@ -0,0 +1,178 @@
+#include "soundio/driftresampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace {
+
+// Number of taps on each side of the interpolated position. Together with
+// the window this keeps the passband flat up to 20 kHz at 44.1 kHz.
+constexpr int kHalfTapCount = 24;
+constexpr int kTapCount = 2 * kHalfTapCount;
+constexpr int kPhaseCount = 128;
+// About 70 dB stop band attenuation
+constexpr double kKaiserBeta = 7.0;
+
+// The loop filter runs once per callback. The fill level at the callback
+// jumps by a whole chunk with the jitter between both callbacks, so it is
+// smoothed before the error is used.
+constexpr double kErrorSmoothing = 0.05;
+// The proportional gain keeps the modulation of the ratio by the residual
+// jitter inaudible, the integral gain sets the time constant for locking
+// to the drift to a few hundred callbacks without overshooting.
+constexpr double kProportionalGain = 3.2e-3;
+constexpr double kIntegralGain = 4e-6;
+// Crystals of sound cards deviate by far less than this
+constexpr double kMaxRatioDeviation = 2e-3;
+
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/// Returns the taps for the fractional offsets phase / kPhaseCount,
+/// including the phase kPhaseCount, each normalized to a gain of 1 at DC.
+/// Tap i of a phase applies to the input frame i - kHalfTapCount + 1 relative
+/// to the frame before the interpolated position.
+std::vector<CSAMPLE> polyphaseCoefficients() {
+    std::vector<CSAMPLE> coefficients((kPhaseCount + 1) * kTapCount);
+    for (int phase = 0; phase <= kPhaseCount; ++phase) {
+        const double fraction = static_cast<double>(phase) / kPhaseCount;
+        std::vector<double> taps(kTapCount);
+        double sum = 0.0;
+        for (int i = 0; i < kTapCount; ++i) {
+            const double distance = i - kHalfTapCount + 1 - fraction;
+            const double ratio = distance / kHalfTapCount;
+            const double window = std::abs(ratio) < 1.0
+                    ? besselI0(kKaiserBeta * std::sqrt(1.0 - ratio * ratio)) /
+                            besselI0(kKaiserBeta)
+                    : 0.0;
+            const double sinc = distance == 0.0
+                    ? 1.0
+                    : std::sin(M_PI * distance) / (M_PI * distance);
+            taps[i] = window * sinc;
+            sum += taps[i];
+        }
+        for (int i = 0; i < kTapCount; ++i) {
+            coefficients[phase * kTapCount + i] = static_cast<CSAMPLE>(taps[i] / sum);
+        }
+    }
+    return coefficients;
+}
+
+} // anonymous namespace
+
+DriftResampler::DriftResampler(int channelCount, SINT maxInputFrames)
+        : m_channelCount(channelCount),
+          m_coefficients(polyphaseCoefficients()),
+          m_frameCoefficients(kTapCount),
+          m_input((maxInputFrames + kTapCount) * channelCount),
+          // Silence for the taps before the first input frame, which is
+          // at the position of the first output frame
+          m_inputFrames(kHalfTapCount - 1),
+          m_position(kHalfTapCount - 1),
+          m_ratio(1.0),
+          m_smoothedError(0.0),
+          m_integral(0.0) {
+    DEBUG_ASSERT(channelCount > 0);
+}
+
+// static
+SINT DriftResampler::latencyFrames() {
+    return kHalfTapCount;
+}
+
+void DriftResampler::updateRatio(double fillLevelError) {
+    m_smoothedError += kErrorSmoothing * (fillLevelError - m_smoothedError);
+    m_integral = math_clamp(m_integral + kIntegralGain * m_smoothedError,
+            -kMaxRatioDeviation,
+            kMaxRatioDeviation);
+    m_ratio = 1.0 +
+            math_clamp(kProportionalGain * m_smoothedError + m_integral,
+                    -kMaxRatioDeviation,
+                    kMaxRatioDeviation);
+}
+
+SINT DriftResampler::firstTapFrame(double position) const {
+    return static_cast<SINT>(std::floor(position)) - kHalfTapCount + 1;
+}
+
+void DriftResampler::pushInput(const CSAMPLE* pInput, SINT numFrames) {
+    VERIFY_OR_DEBUG_ASSERT((m_inputFrames + numFrames) * m_channelCount <=
+            static_cast<SINT>(m_input.size())) {
+        numFrames = static_cast<SINT>(m_input.size()) / m_channelCount - m_inputFrames;
+    }
+    std::copy(pInput,
+            pInput + numFrames * m_channelCount,
+            m_input.begin() + m_inputFrames * m_channelCount);
+    m_inputFrames += numFrames;
+}
+
+void DriftResampler::pushSilence(SINT numFrames) {
+    VERIFY_OR_DEBUG_ASSERT((m_inputFrames + numFrames) * m_channelCount <=
+            static_cast<SINT>(m_input.size())) {
+        numFrames = static_cast<SINT>(m_input.size()) / m_channelCount - m_inputFrames;
+    }
+    std::fill(m_input.begin() + m_inputFrames * m_channelCount,
+            m_input.begin() + (m_inputFrames + numFrames) * m_channelCount,
+            CSAMPLE_ZERO);
+    m_inputFrames += numFrames;
+}
+
+SINT DriftResampler::inputFramesRequired(SINT numFrames) const {
+    if (numFrames <= 0) {
+        return 0;
+    }
+    const double lastPosition = m_position + (numFrames - 1) * m_ratio;
+    return math_max<SINT>(0, firstTapFrame(lastPosition) + kTapCount - m_inputFrames);
+}
+
+SINT DriftResampler::process(CSAMPLE* pOutput, SINT maxFrames) {
+    SINT frame = 0;
+    for (; frame < maxFrames; ++frame) {
+        // Computed from the start position, so the number of frames is
+        // consistent with inputFramesRequired()
+        const double position = m_position + frame * m_ratio;
+        const SINT firstTap = firstTapFrame(position);
+        if (firstTap + kTapCount > m_inputFrames) {
+            break;
+        }
+        const double phase = (position - std::floor(position)) * kPhaseCount;
+        const int phaseIndex = static_cast<int>(phase);
+        const auto fraction = static_cast<CSAMPLE>(phase - phaseIndex);
+        const CSAMPLE* pTaps = &m_coefficients[phaseIndex * kTapCount];
+        const CSAMPLE* pNextTaps = pTaps + kTapCount;
+        for (int i = 0; i < kTapCount; ++i) {
+            m_frameCoefficients[i] = pTaps[i] + fraction * (pNextTaps[i] - pTaps[i]);
+        }
+        const CSAMPLE* pInput = &m_input[firstTap * m_channelCount];
+        CSAMPLE* pOutputFrame = &pOutput[frame * m_channelCount];
+        for (int channel = 0; channel < m_channelCount; ++channel) {
+            CSAMPLE sum = 0;
+            for (int i = 0; i < kTapCount; ++i) {
+                sum += m_frameCoefficients[i] * pInput[i * m_channelCount + channel];
+            }
+            pOutputFrame[channel] = sum;
+        }
+    }
+    m_position += frame * m_ratio;
+
+    // Discard the input frames that are no longer needed
+    const SINT consumedFrames = math_max<SINT>(0, firstTapFrame(m_position));
+    if (consumedFrames > 0) {
+        std::copy(m_input.begin() + consumedFrames * m_channelCount,
+                m_input.begin() + m_inputFrames * m_channelCount,
+                m_input.begin());
+        m_inputFrames -= consumedFrames;
+        m_position -= consumedFrames;
+    }
+    return frame;
+}
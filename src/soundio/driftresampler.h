@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+
+#include "util/class.h"
+#include "util/types.h"
+
+/// Asynchronous sample rate converter that compensates the clock drift
+/// between a sound device and the clock reference device, replacing the
+/// duplication and dropping of single frames that causes audible clicks.
+///
+/// The ratio of input frames per output frame is steered by the fill level
+/// of the FIFO between both devices: A second order loop like in a PLL
+/// filters the measured fill level error, whose integral locks the ratio to
+/// the actual drift, while the proportional part pulls the fill level back
+/// to its target. The ratio only deviates by a few hundred ppm from 1, so
+/// the interpolation uses a windowed sinc filter with the full bandwidth
+/// and a polyphase table with linear interpolation between the phases.
+///
+/// Processes interleaved samples with any number of channels. Allocates
+/// all buffers in the constructor, so it can be created in the main thread
+/// and used in the audio callback.
+class DriftResampler {
+  public:
+    /// maxInputFrames is the maximum number of frames passed to
+    /// pushInput() before they are consumed by process()
+    DriftResampler(int channelCount, SINT maxInputFrames);
+
+    /// Updates the ratio from the fill level error of the FIFO in chunks,
+    /// once per callback. A positive error is too full and speeds up the
+    /// consumption of input frames.
+    void updateRatio(double fillLevelError);
+
+    double ratio() const {
+        return m_ratio;
+    }
+
+    /// Appends input frames
+    void pushInput(const CSAMPLE* pInput, SINT numFrames);
+    void pushSilence(SINT numFrames);
+
+    /// Number of additional input frames that are required to produce
+    /// numFrames output frames at the current ratio
+    SINT inputFramesRequired(SINT numFrames) const;
+
+    /// Produces up to maxFrames output frames from the available input and
+    /// returns the number of produced frames
+    SINT process(CSAMPLE* pOutput, SINT maxFrames);
+
+    /// Delay between input and output in frames
+    static SINT latencyFrames();
+
+  private:
+    SINT firstTapFrame(double position) const;
+
+    const int m_channelCount;
+    // (kPhaseCount + 1) * kTapCount coefficients, the additional phase is
+    // the first phase shifted by one frame for the interpolation
+    const std::vector<CSAMPLE> m_coefficients;
+    // Interpolated coefficients of the current output frame
+    std::vector<CSAMPLE> m_frameCoefficients;
+    std::vector<CSAMPLE> m_input;
+    SINT m_inputFrames;
+    // Position of the next output frame relative to the first input frame
+    double m_position;
+
+    double m_ratio;
+    double m_smoothedError;
+    double m_integral;
+
+    DISALLOW_COPY_AND_ASSIGN(DriftResampler);
+};
@@ -7,6 +7,7 @@
 #include "soundio/soundmanagerutil.h"
 #include "util/debug.h"
 #include "util/defs.h"
+#include "util/math.h"
 #include "util/sample.h"
 
 SoundDevice::SoundDevice(UserSettingsPointer config, SoundManager* sm)
@@ -16,6 +17,7 @@ SoundDevice::SoundDevice(UserSettingsPointer config, SoundManager* sm)
           m_iNumOutputChannels(2),
           m_iNumInputChannels(2),
           m_dSampleRate(44100.0),
+          m_dOutputLatencyMillis(0.0),
           m_hostAPI("Unknown API"),
           m_framesPerBuffer(0) {
 }
@@ -75,11 +77,13 @@ SoundDeviceError SoundDevice::addInput(const AudioInputBuffer &in) {
         return SOUNDDEVICE_ERROR_EXCESSIVE_INPUT_CHANNEL;
     }
     m_audioInputs.append(in);
+    m_directMonitorGains.append(CSAMPLE_GAIN_ZERO);
     return SOUNDDEVICE_ERROR_OK;
 }
 
 void SoundDevice::clearInputs() {
     m_audioInputs.clear();
+    m_directMonitorGains.clear();
 }
 
 bool SoundDevice::operator==(const SoundDevice &other) const {
@@ -229,3 +233,55 @@ void SoundDevice::clearInputBuffer(const SINT framesToPush,
         SampleUtil::clear(&pInputBuffer[framesWriteOffset * 2], framesToPush * 2);
     }
 }
+
+void SoundDevice::mixDirectMonitorInputs(CSAMPLE* outputBuffer,
+        const CSAMPLE* inputBuffer,
+        const SINT framesToMix,
+        const int iOutputFrameSize,
+        const int iInputFrameSize) {
+    if (!outputBuffer || !inputBuffer || framesToMix <= 0) {
+        return;
+    }
+    for (int inputIndex = 0; inputIndex < m_audioInputs.size(); ++inputIndex) {
+        const AudioInputBuffer& in = m_audioInputs.at(inputIndex);
+        if (in.getType() != AudioPath::MICROPHONE) {
+            continue;
+        }
+        CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ZERO;
+        for (AudioDestination* pDestination : in.getDestinations()) {
+            newGain = math_max(newGain, pDestination->getDirectMonitorGain());
+        }
+        const CSAMPLE_GAIN oldGain = m_directMonitorGains[inputIndex];
+        m_directMonitorGains[inputIndex] = newGain;
+        if (oldGain == CSAMPLE_GAIN_ZERO && newGain == CSAMPLE_GAIN_ZERO) {
+            continue;
+        }
+        const ChannelGroup inChans = in.getChannelGroup();
+        const int iInChannelBase = inChans.getChannelBase();
+        // Mono inputs are heard on both channels, like in composeInputBuffer()
+        const int iInChannelOffset = inChans.getChannelCount() > 1 ? 1 : 0;
+        const CSAMPLE_GAIN gainDelta = (newGain - oldGain) / framesToMix;
+
+        for (const AudioOutputBuffer& out : qAsConst(m_audioOutputs)) {
+            if (out.getType() != AudioPath::MASTER && out.getType() != AudioPath::BOOTH) {
+                continue;
+            }
+            const ChannelGroup outChans = out.getChannelGroup();
+            const int iOutChannelCount = outChans.getChannelCount();
+            const int iOutChannelBase = outChans.getChannelBase();
+            for (SINT iFrameNo = 0; iFrameNo < framesToMix; ++iFrameNo) {
+                const CSAMPLE_GAIN gain = oldGain + gainDelta * (iFrameNo + 1);
+                const CSAMPLE* pInFrame = &inputBuffer[iFrameNo * iInputFrameSize + iInChannelBase];
+                CSAMPLE* pOutFrame = &outputBuffer[iFrameNo * iOutputFrameSize + iOutChannelBase];
+                if (iOutChannelCount == 1) {
+                    pOutFrame[0] = SampleUtil::clampSample(pOutFrame[0] +
+                            gain * (pInFrame[0] + pInFrame[iInChannelOffset]) / 2.0f);
+                } else {
+                    pOutFrame[0] = SampleUtil::clampSample(pOutFrame[0] + gain * pInFrame[0]);
+                    pOutFrame[1] = SampleUtil::clampSample(
+                            pOutFrame[1] + gain * pInFrame[iInChannelOffset]);
+                }
+            }
+        }
+    }
+}
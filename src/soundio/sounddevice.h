@@ -2,6 +2,7 @@
 
 #include <QString>
 #include <QList>
+#include <QVarLengthArray>
 
 #include "util/types.h"
 #include "preferences/usersettings.h"
@@ -40,6 +41,12 @@ class SoundDevice {
     virtual void writeProcess() = 0;
     virtual QString getError() const = 0;
     virtual unsigned int getDefaultSampleRate() const = 0;
+    /// The delay from writing an output buffer until it is heard, including
+    /// the artificial delay for drift correction. Valid while the device is
+    /// open, 0 if unknown.
+    double getOutputLatencyMillis() const {
+        return m_dOutputLatencyMillis;
+    }
     int getNumOutputChannels() const;
     int getNumInputChannels() const;
     SoundDeviceError addOutput(const AudioOutputBuffer& out);
@@ -70,6 +77,17 @@ class SoundDevice {
     void clearInputBuffer(const SINT framesToPush,
                           const SINT framesWriteOffset);
 
+    /// Mixes the raw samples of the inputs that ask for it, see
+    /// AudioDestination::getDirectMonitorGain(), into the main and booth
+    /// outputs of this device. Called in the device callback after
+    /// the output buffer has been filled, so the input is heard without
+    /// passing through the engine and the Fifos between the devices.
+    void mixDirectMonitorInputs(CSAMPLE* outputBuffer,
+            const CSAMPLE* inputBuffer,
+            const SINT framesToMix,
+            const int iOutputFrameSize,
+            const int iInputFrameSize);
+
     SoundDeviceId m_deviceId;
     UserSettingsPointer m_pConfig;
     // Pointer to the SoundManager object which we'll request audio from.
@@ -82,11 +100,14 @@ class SoundDevice {
     int m_iNumInputChannels;
     // The current samplerate for the sound device.
     double m_dSampleRate;
+    double m_dOutputLatencyMillis;
     // The name of the audio API used by this device.
     QString m_hostAPI;
     SINT m_framesPerBuffer;
     QList<AudioOutputBuffer> m_audioOutputs;
     QList<AudioInputBuffer> m_audioInputs;
+    // The gains of the last callback of m_audioInputs for ramping
+    QVarLengthArray<CSAMPLE_GAIN, 4> m_directMonitorGains;
 };
 
 typedef QSharedPointer<SoundDevice> SoundDevicePointer;
@@ -0,0 +1,456 @@
+#include "soundio/sounddevicejack.h"
+
+#include <jack/jack.h>
+
+#include <QtDebug>
+
+#include "control/controlobject.h"
+#include "engine/engine.h"
+#include "soundio/soundmanager.h"
+#include "soundio/soundmanagerutil.h"
+#include "util/defs.h"
+#include "util/denormalsarezero.h"
+#include "util/math.h"
+#include "util/metrics.h"
+#include "util/realtimeprofile.h"
+#include "util/sample.h"
+#include "util/timer.h"
+#include "util/trace.h"
+#include "util/versionstore.h"
+#include "waveform/visualplayposition.h"
+
+namespace {
+
+constexpr int kCpuUsageUpdateRate = 30; // in 1/s, fits to display frame rate
+
+// JACK clients create their own ports, which are not limited by the
+// number of physical ports. Offer enough channels for the usual routings
+// of main, booth, headphones and decks.
+constexpr int kMinChannelCount = 8;
+
+const QString kJackDeviceName = QStringLiteral("JACK");
+const QString kCallbackThreadName = QStringLiteral("Audio callback JACK");
+
+int jackProcessCallback(jack_nframes_t framesPerBuffer, void* soundDevice) {
+    return static_cast<SoundDeviceJack*>(soundDevice)->callbackProcess(framesPerBuffer);
+}
+
+int jackXrunCallback(void* soundDevice) {
+    static_cast<SoundDeviceJack*>(soundDevice)->callbackXrun();
+    return 0;
+}
+
+void jackShutdownCallback(void* soundDevice) {
+    static_cast<SoundDeviceJack*>(soundDevice)->callbackShutdown();
+}
+
+jack_client_t* openClient(jack_status_t* pStatus) {
+    return jack_client_open(
+            VersionStore::applicationName().toLocal8Bit().constData(),
+            JackNoStartServer,
+            pStatus);
+}
+
+/// Returns the number of physical ports with the given flags
+int countPhysicalPorts(jack_client_t* pClient, unsigned long flags) {
+    const char** ppPorts = jack_get_ports(pClient,
+            nullptr,
+            JACK_DEFAULT_AUDIO_TYPE,
+            JackPortIsPhysical | flags);
+    int count = 0;
+    if (ppPorts) {
+        while (ppPorts[count]) {
+            ++count;
+        }
+        jack_free(ppPorts);
+    }
+    return count;
+}
+
+int highestChannel(const ChannelGroup& channelGroup) {
+    return channelGroup.getChannelBase() + channelGroup.getChannelCount();
+}
+
+} // anonymous namespace
+
+SoundDeviceJack::SoundDeviceJack(UserSettingsPointer config,
+        SoundManager* sm,
+        unsigned int sampleRate,
+        int numOutputChannels,
+        int numInputChannels)
+        : SoundDevice(config, sm),
+          m_pClient(nullptr),
+          m_serverSampleRate(sampleRate),
+          m_serverShutdown(false),
+          m_bDenormalsDisabled(false),
+          m_masterAudioLatencyUsage("[Master]", "audio_latency_usage"),
+          m_framesSinceAudioLatencyUsageUpdate(0),
+          m_callbackEntryToDacSecs(0) {
+    // Setting parent class members:
+    m_hostAPI = MIXXX_JACK_NATIVE_STRING;
+    m_dSampleRate = sampleRate;
+    m_deviceId.name = kJackDeviceName;
+    m_strDisplayName = QObject::tr("JACK server");
+    m_iNumOutputChannels = numOutputChannels;
+    m_iNumInputChannels = numInputChannels;
+}
+
+SoundDeviceJack::~SoundDeviceJack() {
+    close();
+}
+
+// static
+SoundDevicePointer SoundDeviceJack::probe(UserSettingsPointer config, SoundManager* sm) {
+    jack_status_t status;
+    jack_client_t* pClient = openClient(&status);
+    if (!pClient) {
+        qDebug() << "No JACK server running, status" << status;
+        return SoundDevicePointer();
+    }
+    const unsigned int sampleRate = jack_get_sample_rate(pClient);
+    // Our outputs are connected to the physical inputs of the server
+    const int numOutputChannels = math_max(kMinChannelCount,
+            countPhysicalPorts(pClient, JackPortIsInput));
+    const int numInputChannels = math_max(kMinChannelCount,
+            countPhysicalPorts(pClient, JackPortIsOutput));
+    jack_client_close(pClient);
+    return SoundDevicePointer(new SoundDeviceJack(
+            config, sm, sampleRate, numOutputChannels, numInputChannels));
+}
+
+SoundDeviceError SoundDeviceJack::registerPorts(
+        const char* pPrefix, bool isInput, int channelCount, QVector<jack_port_t*>* pPorts) {
+    pPorts->clear();
+    pPorts->reserve(channelCount);
+    for (int i = 0; i < channelCount; ++i) {
+        const QByteArray portName = QStringLiteral("%1_%2").arg(pPrefix).arg(i + 1).toLatin1();
+        jack_port_t* pPort = jack_port_register(m_pClient,
+                portName.constData(),
+                JACK_DEFAULT_AUDIO_TYPE,
+                isInput ? JackPortIsInput : JackPortIsOutput,
+                0);
+        if (!pPort) {
+            m_lastError = QStringLiteral("Could not register JACK port %1")
+                                  .arg(QString::fromLatin1(portName));
+            return SOUNDDEVICE_ERROR_ERR;
+        }
+        pPorts->append(pPort);
+    }
+    return SOUNDDEVICE_ERROR_OK;
+}
+
+SoundDeviceError SoundDeviceJack::open(bool isClkRefDevice, int syncBuffers) {
+    qDebug() << "SoundDeviceJack::open()" << m_deviceId;
+    // The server drives the engine directly, so there is nothing to
+    // synchronize
+    Q_UNUSED(syncBuffers);
+
+    if (m_audioOutputs.empty() && m_audioInputs.empty()) {
+        m_lastError = QStringLiteral(
+                "No inputs or outputs in SDJ::open() "
+                "(THIS IS A BUG, this should be filtered by SM::setupDevices)");
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+    if (!isClkRefDevice) {
+        m_lastError = QStringLiteral(
+                "The JACK server needs to be the clock reference. Assign the "
+                "main output or a deck output to it.");
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+
+    int outputChannelCount = 0;
+    for (const auto& out : std::as_const(m_audioOutputs)) {
+        outputChannelCount = math_max(outputChannelCount, highestChannel(out.getChannelGroup()));
+    }
+    int inputChannelCount = 0;
+    for (const auto& in : std::as_const(m_audioInputs)) {
+        inputChannelCount = math_max(inputChannelCount, highestChannel(in.getChannelGroup()));
+    }
+
+    jack_status_t status;
+    m_pClient = openClient(&status);
+    if (!m_pClient) {
+        m_lastError = QStringLiteral("Could not connect to the JACK server, status 0x%1")
+                              .arg(static_cast<int>(status), 0, 16);
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+    m_serverShutdown = false;
+
+    SoundDeviceError err = registerPorts("out", false, outputChannelCount, &m_outputPorts);
+    if (err == SOUNDDEVICE_ERROR_OK) {
+        err = registerPorts("in", true, inputChannelCount, &m_inputPorts);
+    }
+    if (err != SOUNDDEVICE_ERROR_OK) {
+        close();
+        return err;
+    }
+    m_silentOutputPorts.clear();
+    for (int i = 0; i < m_outputPorts.size(); ++i) {
+        bool used = false;
+        for (const auto& out : std::as_const(m_audioOutputs)) {
+            const ChannelGroup channelGroup = out.getChannelGroup();
+            if (i >= channelGroup.getChannelBase() && i < highestChannel(channelGroup)) {
+                used = true;
+                break;
+            }
+        }
+        if (!used) {
+            m_silentOutputPorts.append(m_outputPorts[i]);
+        }
+    }
+
+    // JACK sets its own buffer size and sample rate that Mixxx cannot change.
+    m_dSampleRate = jack_get_sample_rate(m_pClient);
+    m_framesPerBuffer = jack_get_buffer_size(m_pClient);
+    qDebug() << "JACK sample rate:" << m_dSampleRate << "Hz, buffer size:"
+             << m_framesPerBuffer << "frames";
+    qDebug() << "Output channels:" << outputChannelCount
+             << "| Input channels:" << inputChannelCount;
+
+    jack_set_process_callback(m_pClient, jackProcessCallback, this);
+    jack_set_xrun_callback(m_pClient, jackXrunCallback, this);
+    jack_on_shutdown(m_pClient, jackShutdownCallback, this);
+
+    if (jack_activate(m_pClient) != 0) {
+        m_lastError = QStringLiteral("Could not activate the JACK client");
+        close();
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+    connectPhysicalPorts();
+
+    // The latency of the playback ports includes the buffers of the server
+    // after our buffer
+    uint32_t playbackLatencyFrames = 0;
+    if (!m_outputPorts.isEmpty()) {
+        jack_latency_range_t range;
+        jack_port_get_latency_range(m_outputPorts.first(), JackPlaybackLatency, &range);
+        playbackLatencyFrames = range.max;
+    }
+    const double bufferMSec = m_framesPerBuffer / m_dSampleRate * 1000;
+    const double currentLatencyMSec =
+            (m_framesPerBuffer + playbackLatencyFrames) / m_dSampleRate * 1000;
+    m_callbackEntryToDacSecs = currentLatencyMSec / 1000;
+    qDebug() << "JACK output latency:" << currentLatencyMSec << "ms";
+
+    // Update the samplerate and latency ControlObjects, which allow the
+    // waveform view to properly correct for the latency.
+    ControlObject::set(ConfigKey("[Master]", "latency"), currentLatencyMSec);
+    ControlObject::set(ConfigKey("[Master]", "samplerate"), m_dSampleRate);
+    ControlObject::set(ConfigKey("[Master]", "audio_buffer_size"), bufferMSec);
+    m_clkRefTimer.start();
+    return SOUNDDEVICE_ERROR_OK;
+}
+
+void SoundDeviceJack::connectPhysicalPorts() {
+    // Connect the ports in order like PortAudio does, so that Mixxx plays
+    // without any routing. The connections can be changed with any JACK
+    // patchbay afterwards.
+    const char** ppPlaybackPorts = jack_get_ports(m_pClient,
+            nullptr,
+            JACK_DEFAULT_AUDIO_TYPE,
+            JackPortIsPhysical | JackPortIsInput);
+    if (ppPlaybackPorts) {
+        for (int i = 0; i < m_outputPorts.size() && ppPlaybackPorts[i]; ++i) {
+            if (jack_connect(m_pClient,
+                        jack_port_name(m_outputPorts[i]),
+                        ppPlaybackPorts[i]) != 0) {
+                qWarning() << "Could not connect JACK port" << ppPlaybackPorts[i];
+            }
+        }
+        jack_free(ppPlaybackPorts);
+    }
+
+    const char** ppCapturePorts = jack_get_ports(m_pClient,
+            nullptr,
+            JACK_DEFAULT_AUDIO_TYPE,
+            JackPortIsPhysical | JackPortIsOutput);
+    if (ppCapturePorts) {
+        for (int i = 0; i < m_inputPorts.size() && ppCapturePorts[i]; ++i) {
+            if (jack_connect(m_pClient,
+                        ppCapturePorts[i],
+                        jack_port_name(m_inputPorts[i])) != 0) {
+                qWarning() << "Could not connect JACK port" << ppCapturePorts[i];
+            }
+        }
+        jack_free(ppCapturePorts);
+    }
+}
+
+bool SoundDeviceJack::isOpen() const {
+    return m_pClient != nullptr;
+}
+
+SoundDeviceError SoundDeviceJack::close() {
+    jack_client_t* pClient = m_pClient;
+    m_pClient = nullptr;
+    if (pClient) {
+        if (!m_serverShutdown) {
+            // Blocks until the running process callback has returned
+            jack_deactivate(pClient);
+        }
+        // Also unregisters the ports
+        jack_client_close(pClient);
+    }
+    m_outputPorts.clear();
+    m_inputPorts.clear();
+    m_silentOutputPorts.clear();
+    if (m_bDenormalsDisabled) {
+        mixxx::RealtimeProfile::removeThread(kCallbackThreadName);
+    }
+    m_bDenormalsDisabled = false;
+    return SOUNDDEVICE_ERROR_OK;
+}
+
+void SoundDeviceJack::readProcess() {
+    // Input is read in callbackProcess()
+}
+
+void SoundDeviceJack::writeProcess() {
+    // Output is written in callbackProcess()
+}
+
+QString SoundDeviceJack::getError() const {
+    return m_lastError;
+}
+
+int SoundDeviceJack::callbackProcess(uint32_t framesPerBuffer) {
+    // This must be the very first call to get the correct timing
+    m_clkRefTimer.restart();
+    VisualPlayPosition::setCallbackEntryToDacSecs(m_callbackEntryToDacSecs, m_clkRefTimer);
+
+    Trace trace("SoundDeviceJack::callbackProcess %1", m_deviceId.debugName());
+
+    // The thread of the server already has realtime priority. Only the
+    // handling of denormals needs to be set up like for PortAudio.
+    if (!m_bDenormalsDisabled) {
+        mixxx::RealtimeProfile::recordCurrentThread(
+                mixxx::RealtimeProfile::Role::AudioCallback, kCallbackThreadName);
+#ifdef __SSE__
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+#endif
+#if defined(__aarch64__)
+        // Bit 24 of the Floating-point Control Register enables Flush-to-zero
+        int savedFPCR;
+        asm volatile("mrs %[savedFPCR], FPCR"
+                     : [ savedFPCR ] "=r"(savedFPCR));
+        asm volatile("msr FPCR, %[src]"
+                     :
+                     : [ src ] "r"(savedFPCR | (1 << 24)));
+#endif
+        m_bDenormalsDisabled = true;
+    }
+
+    if (framesPerBuffer * mixxx::kEngineChannelCount > MAX_BUFFER_LEN) {
+        // The engine buffers can not hold this many frames
+        for (jack_port_t* pPort : std::as_const(m_outputPorts)) {
+            SampleUtil::clear(static_cast<CSAMPLE*>(
+                                      jack_port_get_buffer(pPort, framesPerBuffer)),
+                    framesPerBuffer);
+        }
+        m_pSoundManager->underflowHappened(22);
+        return 0;
+    }
+
+    m_pSoundManager->processUnderflowHappened();
+
+    //Note: Input is processed first so that any ControlObject changes made in
+    //      response to input are processed as soon as possible.
+    if (!m_inputPorts.isEmpty()) {
+        ScopedTimer t("SoundDeviceJack::callbackProcess input %1",
+                m_deviceId.debugName());
+        readInputPorts(framesPerBuffer);
+        m_pSoundManager->pushInputBuffers(m_audioInputs, framesPerBuffer);
+    }
+
+    m_pSoundManager->readProcess();
+
+    {
+        ScopedTimer t("SoundDeviceJack::callbackProcess prepare %1",
+                m_deviceId.debugName());
+        m_pSoundManager->onDeviceOutputCallback(framesPerBuffer);
+    }
+
+    if (!m_outputPorts.isEmpty()) {
+        ScopedTimer t("SoundDeviceJack::callbackProcess output %1",
+                m_deviceId.debugName());
+        writeOutputPorts(framesPerBuffer);
+    }
+
+    m_pSoundManager->writeProcess();
+
+    updateAudioLatencyUsage(framesPerBuffer);
+    return 0;
+}
+
+void SoundDeviceJack::readInputPorts(uint32_t framesPerBuffer) {
+    // The port buffers are interleaved into the engine buffers directly
+    for (const auto& in : std::as_const(m_audioInputs)) {
+        const ChannelGroup channelGroup = in.getChannelGroup();
+        const int channelBase = channelGroup.getChannelBase();
+        const auto* pLeft = static_cast<const CSAMPLE*>(
+                jack_port_get_buffer(m_inputPorts[channelBase], framesPerBuffer));
+        // Mono inputs are sent to both channels
+        const auto* pRight = channelGroup.getChannelCount() > 1
+                ? static_cast<const CSAMPLE*>(jack_port_get_buffer(
+                          m_inputPorts[channelBase + 1], framesPerBuffer))
+                : pLeft;
+        // Always stereo
+        SampleUtil::interleaveBuffer(in.getBuffer(), pLeft, pRight, framesPerBuffer);
+    }
+}
+
+void SoundDeviceJack::writeOutputPorts(uint32_t framesPerBuffer) {
+    for (const auto& out : std::as_const(m_audioOutputs)) {
+        const ChannelGroup channelGroup = out.getChannelGroup();
+        const int channelBase = channelGroup.getChannelBase();
+        // Always stereo
+        const CSAMPLE* pAudioOutputBuffer = out.getBuffer();
+        auto* pLeft = static_cast<CSAMPLE*>(
+                jack_port_get_buffer(m_outputPorts[channelBase], framesPerBuffer));
+        if (channelGroup.getChannelCount() == 1) {
+            // All AudioOutputs are stereo as of Mixxx 1.12.0. If we have a mono
+            // output then we need to downsample.
+            for (uint32_t i = 0; i < framesPerBuffer; ++i) {
+                pLeft[i] = SampleUtil::clampSample(
+                        (pAudioOutputBuffer[i * 2] + pAudioOutputBuffer[i * 2 + 1]) / 2.0f);
+            }
+        } else {
+            auto* pRight = static_cast<CSAMPLE*>(
+                    jack_port_get_buffer(m_outputPorts[channelBase + 1], framesPerBuffer));
+            for (uint32_t i = 0; i < framesPerBuffer; ++i) {
+                pLeft[i] = SampleUtil::clampSample(pAudioOutputBuffer[i * 2]);
+                pRight[i] = SampleUtil::clampSample(pAudioOutputBuffer[i * 2 + 1]);
+            }
+        }
+    }
+    for (jack_port_t* pPort : std::as_const(m_silentOutputPorts)) {
+        SampleUtil::clear(
+                static_cast<CSAMPLE*>(jack_port_get_buffer(pPort, framesPerBuffer)),
+                framesPerBuffer);
+    }
+}
+
+void SoundDeviceJack::callbackXrun() {
+    m_pSoundManager->underflowHappened(23);
+}
+
+void SoundDeviceJack::callbackShutdown() {
+    qWarning() << "The JACK server has shut down or disconnected Mixxx";
+    m_serverShutdown = true;
+}
+
+void SoundDeviceJack::updateAudioLatencyUsage(uint32_t framesPerBuffer) {
+    m_framesSinceAudioLatencyUsageUpdate += framesPerBuffer;
+    if (m_framesSinceAudioLatencyUsageUpdate > (m_dSampleRate / kCpuUsageUpdateRate)) {
+        double secInAudioCb = m_timeInAudioCallback.toDoubleSeconds();
+        const double usage =
+                secInAudioCb / (m_framesSinceAudioLatencyUsageUpdate / m_dSampleRate);
+        m_masterAudioLatencyUsage.set(usage);
+        mixxx::metrics::engineLoad.observe(usage);
+        m_timeInAudioCallback = mixxx::Duration::fromSeconds(0);
+        m_framesSinceAudioLatencyUsageUpdate = 0;
+    }
+    // measure time in Audio callback at the very last
+    m_timeInAudioCallback += m_clkRefTimer.elapsed();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include "control/pollingcontrolproxy.h"
+#include "soundio/sounddevice.h"
+#include "util/duration.h"
+#include "util/performancetimer.h"
+
+// Forward declare the JACK structures to prevent leaking jack.h definitions
+// beyond where they are needed.
+struct _jack_client;
+typedef struct _jack_client jack_client_t;
+struct _jack_port;
+typedef struct _jack_port jack_port_t;
+
+class SoundManager;
+
+/// Talks to a JACK server directly instead of going through PortAudio. The
+/// engine is processed in the realtime thread of the server, reading from
+/// and writing to the port buffers of the server without an intermediate
+/// buffer. This also works with PipeWire through its JACK compatible
+/// library.
+///
+/// All ports of the server belong to this single device, which can only be
+/// opened as the clock reference.
+class SoundDeviceJack : public SoundDevice {
+  public:
+    SoundDeviceJack(UserSettingsPointer config,
+            SoundManager* sm,
+            unsigned int sampleRate,
+            int numOutputChannels,
+            int numInputChannels);
+    ~SoundDeviceJack() override;
+
+    /// Returns nullptr if no JACK server is running. The server is not
+    /// started on demand.
+    static SoundDevicePointer probe(UserSettingsPointer config, SoundManager* sm);
+
+    SoundDeviceError open(bool isClkRefDevice, int syncBuffers) override;
+    bool isOpen() const override;
+    SoundDeviceError close() override;
+    void readProcess() override;
+    void writeProcess() override;
+    QString getError() const override;
+
+    unsigned int getDefaultSampleRate() const override {
+        return m_serverSampleRate;
+    }
+
+    // Called in the realtime thread of JACK
+    int callbackProcess(uint32_t framesPerBuffer);
+    void callbackXrun();
+    // Called by JACK when the server shuts down or disconnects Mixxx
+    void callbackShutdown();
+
+  private:
+    SoundDeviceError registerPorts(
+            const char* pPrefix, bool isInput, int channelCount, QVector<jack_port_t*>* pPorts);
+    void connectPhysicalPorts();
+    void readInputPorts(uint32_t framesPerBuffer);
+    void writeOutputPorts(uint32_t framesPerBuffer);
+    void updateAudioLatencyUsage(uint32_t framesPerBuffer);
+
+    jack_client_t* m_pClient;
+    const unsigned int m_serverSampleRate;
+    QVector<jack_port_t*> m_outputPorts;
+    QVector<jack_port_t*> m_inputPorts;
+    // Output ports without an AudioOutput, which are filled with silence
+    QVector<jack_port_t*> m_silentOutputPorts;
+    // Set when the server has shut down, after which the client must only
+    // be closed
+    volatile bool m_serverShutdown;
+
+    // A string describing the last JACK error to occur.
+    QString m_lastError;
+    bool m_bDenormalsDisabled;
+    PollingControlProxy m_masterAudioLatencyUsage;
+    mixxx::Duration m_timeInAudioCallback;
+    uint32_t m_framesSinceAudioLatencyUsageUpdate;
+    double m_callbackEntryToDacSecs;
+    PerformanceTimer m_clkRefTimer;
+};
@@ -1,6 +1,7 @@
 #include "soundio/sounddevicenetwork.h"
 
 #include <QtDebug>
+#include <cmath>
 
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
@@ -39,6 +40,7 @@ SoundDeviceNetwork::SoundDeviceNetwork(UserSettingsPointer config,
           m_masterAudioLatencyUsage("[Master]", "audio_latency_usage"),
           m_framesSinceAudioLatencyUsageUpdate(0),
           m_denormals(false),
+          m_targetFrames(0),
           m_targetTime(0) {
     // Setting parent class members:
     m_hostAPI = "Network stream";
@@ -95,7 +97,8 @@ SoundDeviceError SoundDeviceNetwork::open(bool isClkRefDevice, int syncBuffers)
         // Network stream was just started above so we have to wait until
         // we can pass one chunk.
         // The first callback runs early to do the one time setups
-        m_targetTime = m_audioBufferTime.toIntegerMicros();
+        m_targetFrames = m_framesPerBuffer;
+        m_targetTime = framesToStreamTimeUs(m_targetFrames);
 
         m_pThread = std::make_unique<SoundDeviceNetworkThread>(this);
         m_pThread->start(QThread::TimeCriticalPriority);
@@ -478,7 +481,8 @@ void SoundDeviceNetwork::callbackProcessClkRef() {
 void SoundDeviceNetwork::updateCallbackEntryToDacTime() {
     m_clkRefTimer.start();
     qint64 currentTime = m_pNetworkStream->getInputStreamTimeUs();
-    m_targetTime += m_audioBufferTime.toIntegerMicros();
+    m_targetFrames += m_framesPerBuffer;
+    m_targetTime = framesToStreamTimeUs(m_targetFrames);
     double callbackEntrytoDacSecs = (m_targetTime - currentTime) / 1000000.0;
     callbackEntrytoDacSecs = math_max(callbackEntrytoDacSecs, 0.0001);
     VisualPlayPosition::setCallbackEntryToDacSecs(callbackEntrytoDacSecs, m_clkRefTimer);
@@ -498,22 +502,24 @@ void SoundDeviceNetwork::updateAudioLatencyUsage() {
     }
 
     qint64 currentTime = m_pNetworkStream->getInputStreamTimeUs();
-    unsigned long sleepUs = 0;
+    bool underflow = false;
     if (currentTime > m_targetTime) {
         m_pSoundManager->underflowHappened(22);
         //qDebug() << "underflow" << currentTime << m_targetTime;
+        m_targetFrames = static_cast<qint64>(currentTime * m_dSampleRate / 1000000.0);
         m_targetTime = currentTime;
-    } else {
-        sleepUs = m_targetTime - currentTime;
+        underflow = true;
     }
 
-    //qDebug() << "sleep" << sleepUs;
-
     // measure time in Audio callback at the very last
     m_timeInAudioCallback += m_clkRefTimer.elapsed();
 
     // now go to sleep until the next callback
-    if (sleepUs > 0) {
-        m_pThread->usleep_(sleepUs);
+    if (!underflow) {
+        m_pNetworkStream->sleepUntilInputStreamTimeUs(m_targetTime);
     }
 }
+
+qint64 SoundDeviceNetwork::framesToStreamTimeUs(qint64 frames) const {
+    return static_cast<qint64>(std::llround(frames * 1000000.0 / m_dSampleRate));
+}
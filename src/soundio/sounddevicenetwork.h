@@ -46,6 +46,7 @@ class SoundDeviceNetwork : public SoundDevice {
   private:
     void updateCallbackEntryToDacTime();
     void updateAudioLatencyUsage();
+    qint64 framesToStreamTimeUs(qint64 frames) const;
 
     void workerWriteProcess(NetworkOutputStreamWorkerPtr pWorker,
             int outChunkSize, int readAvailable,
@@ -66,6 +67,9 @@ class SoundDeviceNetwork : public SoundDevice {
     int m_framesSinceAudioLatencyUsageUpdate;
     std::unique_ptr<SoundDeviceNetworkThread> m_pThread;
     bool m_denormals;
+    // The stream time of the next callback is derived from the frame count
+    // to avoid the accumulation of rounding errors
+    qint64 m_targetFrames;
     qint64 m_targetTime;
     PerformanceTimer m_clkRefTimer;
 };
@@ -82,10 +86,6 @@ class SoundDeviceNetworkThread : public QThread {
         m_stop = true;
     }
 
-    void usleep_(unsigned long t) {
-        usleep(t);
-    }
-
   private:
     void run() override {
 #ifdef __LINUX__
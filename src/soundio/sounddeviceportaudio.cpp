@@ -8,13 +8,17 @@
 
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
+#include "soundio/driftresampler.h"
 #include "soundio/sounddevice.h"
 #include "soundio/soundmanager.h"
 #include "soundio/soundmanagerutil.h"
 #include "util/denormalsarezero.h"
 #include "util/fifo.h"
 #include "util/math.h"
+#include "util/metrics.h"
+#include "util/realtimeprofile.h"
 #include "util/sample.h"
+#include "util/time.h"
 #include "util/timer.h"
 #include "util/trace.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
@@ -33,12 +37,21 @@ constexpr int kDriftReserve = 1;
 // Buffer for drift correction 1 full, 1 for r/w, 1 empty
 constexpr int kFifoSize = 2 * kDriftReserve + 1;
 
+// Fill level in chunks the drift correction locks to. This leaves half a
+// chunk in both directions for the jitter between the callbacks.
+constexpr double kDriftTargetFillLevel = kFifoSize / 2.0;
+
 constexpr int kCpuUsageUpdateRate = 30; // in 1/s, fits to display frame rate
 
 // We warn only at invalid timing 3, since the first two
 // callbacks can be always wrong due to a setup/open jitter
 constexpr int m_invalidTimeInfoWarningCount = 3;
 
+// The bandwidth of the delay-locked loop that filters the jitter of the
+// DAC times in the CPU clock domain. Lower values give smoother
+// waveforms, but follow changes of the clock drift more slowly.
+constexpr double kDacTimeFilterBandwidthHz = 0.5;
+
 int paV19Callback(const void *inputBuffer, void *outputBuffer,
                   unsigned long framesPerBuffer,
                   const PaStreamCallbackTimeInfo *timeInfo,
@@ -69,6 +82,10 @@ int paV19CallbackClkRef(const void *inputBuffer, void *outputBuffer,
             (const CSAMPLE*) inputBuffer, timeInfo, statusFlags);
 }
 
+QString callbackThreadName(const SoundDeviceId& deviceId) {
+    return QStringLiteral("Audio callback %1").arg(deviceId.debugName());
+}
+
 const QRegularExpression kAlsaHwDeviceRegex("(.*) \\((plug)?(hw:(\\d)+(,(\\d)+))?\\)");
 
 } // anonymous namespace
@@ -91,7 +108,14 @@ SoundDevicePortAudio::SoundDevicePortAudio(UserSettingsPointer config,
           m_framesSinceAudioLatencyUsageUpdate(0),
           m_syncBuffers(2),
           m_invalidTimeInfoCount(0),
-          m_lastCallbackEntrytoDacSecs(0) {
+          m_lastCallbackEntrytoDacSecs(0),
+          m_dacTimeFilterValid(false),
+          m_callbackEntrySecs(0),
+          m_filteredDacSecs(0),
+          m_filteredNextDacSecs(0),
+          m_filteredBufferSecs(0),
+          m_lastOutputTransferNanos(0),
+          m_lastInputTransferNanos(0) {
     // Setting parent class members:
     m_hostAPI = Pa_GetHostApiInfo(deviceInfo->hostApi)->name;
     m_dSampleRate = deviceInfo->defaultSampleRate;
@@ -271,6 +295,9 @@ SoundDeviceError SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffers
             SampleUtil::clear(dataPtr1, size1);
             SampleUtil::clear(dataPtr2, size2);
             m_outputFifo->releaseWriteRegions(writeCount);
+            // Fetches up to one chunk plus the drift per callback
+            m_pOutputResampler = std::make_unique<DriftResampler>(
+                    m_outputParams.channelCount, 2 * m_framesPerBuffer);
         }
         if (m_inputParams.channelCount) {
             m_inputFifo = new FIFO<CSAMPLE>(
@@ -287,6 +314,10 @@ SoundDeviceError SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffers
             SampleUtil::clear(dataPtr1, size1);
             SampleUtil::clear(dataPtr2, size2);
             m_inputFifo->releaseWriteRegions(writeCount);
+            m_pInputResampler = std::make_unique<DriftResampler>(
+                    m_inputParams.channelCount, 2 * m_framesPerBuffer);
+            m_resampledInput.resize(
+                    m_inputParams.channelCount * 2 * m_framesPerBuffer);
         }
     } else if (m_syncBuffers == 1) { // "Disabled (short delay)"
         // this can be used on a second device when it is driven by the Clock
@@ -359,6 +390,12 @@ SoundDeviceError SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffers
     qDebug() << "   Actual sample rate: " << m_dSampleRate << "Hz, latency:"
              << currentLatencyMSec << "ms";
 
+    m_dOutputLatencyMillis = currentLatencyMSec;
+    if (!isClkRefDevice && m_syncBuffers == 2 && m_outputFifo) {
+        // The output FIFO was pre-filled with silence (see above)
+        m_dOutputLatencyMillis += m_framesPerBuffer * kFifoSize / 2.0 * 1000.0 / m_dSampleRate;
+    }
+
     if (isClkRefDevice) {
         // Update the samplerate and latency ControlObjects, which allow the
         // waveform view to properly correct for the latency.
@@ -366,6 +403,8 @@ SoundDeviceError SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffers
         ControlObject::set(ConfigKey("[Master]", "samplerate"), m_dSampleRate);
         ControlObject::set(ConfigKey("[Master]", "audio_buffer_size"), bufferMSec);
         m_invalidTimeInfoCount = 0;
+        m_dacTimeFilterValid = false;
+        m_callbackEntrySecs = 0;
         m_clkRefTimer.start();
     }
     m_pStream = pStream;
@@ -429,6 +468,11 @@ SoundDeviceError SoundDevicePortAudio::close() {
 
     m_outputFifo = nullptr;
     m_inputFifo = nullptr;
+    m_pOutputResampler.reset();
+    m_pInputResampler.reset();
+    if (m_bSetThreadPriority) {
+        mixxx::RealtimeProfile::removeThread(callbackThreadName(m_deviceId));
+    }
     m_bSetThreadPriority = false;
 
     return SOUNDDEVICE_ERROR_OK;
@@ -560,6 +604,10 @@ void SoundDevicePortAudio::readProcess() {
             }
             m_inputFifo->releaseReadRegions(readCount);
         }
+        if (m_pInputResampler) {
+            m_lastInputTransferNanos.store(mixxx::Time::elapsed().toIntegerNanos(),
+                    std::memory_order_relaxed);
+        }
         if (readCount < inChunkSize) {
             // Fill remaining buffers with zeros
             clearInputBuffer(inChunkSize - readCount, readCount);
@@ -600,6 +648,10 @@ void SoundDevicePortAudio::writeProcess() {
             }
             m_outputFifo->releaseWriteRegions(writeCount);
         }
+        if (m_pOutputResampler) {
+            m_lastOutputTransferNanos.store(mixxx::Time::elapsed().toIntegerNanos(),
+                    std::memory_order_relaxed);
+        }
 
         if (m_syncBuffers == 0) { // "Experimental (no delay)"
             // Polling
@@ -689,124 +741,95 @@ int SoundDevicePortAudio::callbackProcessDrift(
     // Since we are on the non Clock reference device and may have an independent
     // Crystal clock, a drift correction is required
     //
-    // There is a delay of up to one latency between composing a chunk in the Clock
-    // Reference callback and write it to the device. So we need at lest one buffer.
-    // Unfortunately this delay is somehow random, an WILL produce a delay slow
-    // shift without we can avoid it. (That's the price for using a cheap USB soundcard).
-    //
-    // Additional we need an filled chunk and an empty chunk. These are used when on
-    // sound card overtakes the other. This always happens, if they are driven form
-    // two crystals. In a test case every 30 s @ 23 ms. After they are consumed,
-    // the drift correction takes place and fills or clears the reserve buffers.
-    // If this is finished before another overtake happens, we do not face any
-    // dropouts or clicks.
-    // So that's why we need a Fifo of 3 chunks.
-    //
-    // In addition there is a jitter effect. It happens that one callback is delayed,
-    // in this case the second one fires two times and then the first one fires two
-    // time as well to catch up. This is also fixed by the additional buffers. If this
-    // happens just after an regular overtake, we will have clicks again.
-    //
-    // I the tests it turns out that it only happens in the opposite direction, so
-    // 3 chunks are just fine.
+    // The chunks are exchanged with the Clock Reference callback at a random
+    // phase and with jitter, so the fill level of the Fifos seen here jumps by
+    // a whole chunk depending on which callback fired last. Adding the time
+    // since the Clock Reference callback has exchanged its chunk gives the
+    // fill level of a steady flow of frames instead. The resamplers lock
+    // this fill level to the middle of the Fifo by smoothly adapting their
+    // ratio to the drift, which leaves half a chunk for the jitter in both
+    // directions without dropping or duplicating frames.
 
     if (m_inputParams.channelCount) {
-        int inChunkSize = framesPerBuffer * m_inputParams.channelCount;
-        int readAvailable = m_inputFifo->readAvailable();
-        int writeAvailable = m_inputFifo->writeAvailable();
-        if (readAvailable < inChunkSize * kDriftReserve) {
-            // risk of an underflow, duplicate one frame
-            m_inputFifo->write(in, inChunkSize);
-            if (m_inputDrift) {
-                // Do not compensate the first delay, because it is likely a jitter
-                // corrected in the next cycle
-                // Duplicate one frame
-                m_inputFifo->write(
-                        &in[inChunkSize - m_inputParams.channelCount],
-                        m_inputParams.channelCount);
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Skip";
-            } else {
-                m_inputDrift = true;
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Jitter Skip";
-            }
-        } else if (readAvailable == inChunkSize * kDriftReserve) {
-            // Everything Ok
-            m_inputFifo->write(in, inChunkSize);
-            m_inputDrift = false;
-            //qDebug() << "callbackProcess write:" << (float) readAvailable / inChunkSize << "Normal";
-        } else if (writeAvailable >= inChunkSize) {
-            // Risk of overflow, skip one frame
-            if (m_inputDrift) {
-                m_inputFifo->write(in, inChunkSize - m_inputParams.channelCount);
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Skip";
-            } else {
-                m_inputFifo->write(in, inChunkSize);
-                m_inputDrift = true;
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Jitter Skip";
-            }
+        const int inChunkSize = framesPerBuffer * m_inputParams.channelCount;
+        // The last chunk of the Clock Reference callback is consumed partially
+        const double fillLevel =
+                static_cast<double>(m_inputFifo->readAvailable()) / inChunkSize +
+                1.0 - chunksSinceEngineTransfer(m_lastInputTransferNanos);
+        m_pInputResampler->updateRatio(fillLevel - kDriftTargetFillLevel);
+        m_pInputResampler->pushInput(in, framesPerBuffer);
+        const SINT resampledFrames = m_pInputResampler->process(
+                m_resampledInput.data(),
+                m_resampledInput.size() / m_inputParams.channelCount);
+        const int resampledCount = resampledFrames * m_inputParams.channelCount;
+        const int writeAvailable = m_inputFifo->writeAvailable();
+        if (writeAvailable >= resampledCount) {
+            m_inputFifo->write(m_resampledInput.data(), resampledCount);
         } else if (writeAvailable) {
             // Fifo Overflow
-            m_inputFifo->write(in, writeAvailable);
+            m_inputFifo->write(m_resampledInput.data(), writeAvailable);
             m_pSoundManager->underflowHappened(8);
-            //qDebug() << "callbackProcessDrift write:" << (float) readAvailable / inChunkSize << "Overflow";
+            //qDebug() << "callbackProcessDrift write:" << fillLevel << "Overflow";
         } else {
             // Buffer full
             m_pSoundManager->underflowHappened(9);
-            //qDebug() << "callbackProcessDrift write:" << (float) readAvailable / inChunkSize << "Buffer full";
+            //qDebug() << "callbackProcessDrift write:" << fillLevel << "Buffer full";
         }
     }
 
     if (m_outputParams.channelCount) {
-        int outChunkSize = framesPerBuffer * m_outputParams.channelCount;
-        int readAvailable = m_outputFifo->readAvailable();
-
-        if (readAvailable > outChunkSize * (kDriftReserve + 1)) {
-            m_outputFifo->read(out, outChunkSize);
-            if (m_outputDrift) {
-                // Risk of overflow, skip one frame
-                m_outputFifo->releaseReadRegions(m_outputParams.channelCount);
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Skip";
-            } else {
-                m_outputDrift = true;
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Jitter Skip";
-            }
-        } else if (readAvailable == outChunkSize * (kDriftReserve + 1)) {
-            m_outputFifo->read(out, outChunkSize);
-            m_outputDrift = false;
-            //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Normal";
-        } else if (readAvailable >= outChunkSize) {
-            if (m_outputDrift) {
-                // Risk of underflow, duplicate one frame
-                m_outputFifo->read(out,
-                        outChunkSize - m_outputParams.channelCount);
-                SampleUtil::copy(
-                        &out[outChunkSize - m_outputParams.channelCount],
-                        &out[outChunkSize - (2 * m_outputParams.channelCount)],
-                        m_outputParams.channelCount);
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Save";
-            } else {
-                m_outputFifo->read(out, outChunkSize);
-                m_outputDrift = true;
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Jitter Save";
+        const int outChunkSize = framesPerBuffer * m_outputParams.channelCount;
+        const int readAvailable = m_outputFifo->readAvailable();
+        // The last chunk of the Clock Reference callback is produced partially
+        const double fillLevel = static_cast<double>(readAvailable) / outChunkSize -
+                1.0 + chunksSinceEngineTransfer(m_lastOutputTransferNanos);
+        m_pOutputResampler->updateRatio(fillLevel - kDriftTargetFillLevel);
+        const int requiredCount =
+                m_pOutputResampler->inputFramesRequired(framesPerBuffer) *
+                m_outputParams.channelCount;
+        const int readCount = math_min(requiredCount, readAvailable);
+        if (readCount) {
+            CSAMPLE* dataPtr1;
+            ring_buffer_size_t size1;
+            CSAMPLE* dataPtr2;
+            ring_buffer_size_t size2;
+            // We use size1 and size2, so we can ignore the return value
+            (void)m_outputFifo->aquireReadRegions(
+                    readCount, &dataPtr1, &size1, &dataPtr2, &size2);
+            m_pOutputResampler->pushInput(dataPtr1, size1 / m_outputParams.channelCount);
+            if (size2 > 0) {
+                m_pOutputResampler->pushInput(dataPtr2, size2 / m_outputParams.channelCount);
             }
-        } else if (readAvailable) {
-            m_outputFifo->read(out,
-                    readAvailable);
-            // underflow
-            SampleUtil::clear(&out[readAvailable],
-                    outChunkSize - readAvailable);
-            m_pSoundManager->underflowHappened(10);
-            //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Underflow";
-        } else {
+            m_outputFifo->releaseReadRegions(readCount);
+        }
+        if (readCount < requiredCount) {
             // underflow
-            SampleUtil::clear(out, outChunkSize);
-            m_pSoundManager->underflowHappened(11);
-            //qDebug() << "callbackProcess read:" << (float)readAvailable / outChunkSize << "Buffer empty";
+            m_pOutputResampler->pushSilence(
+                    (requiredCount - readCount) / m_outputParams.channelCount);
+            m_pSoundManager->underflowHappened(readCount ? 10 : 11);
+            //qDebug() << "callbackProcessDrift read:" << fillLevel << "Underflow";
         }
-     }
+        const SINT resampledFrames = m_pOutputResampler->process(out, framesPerBuffer);
+        DEBUG_ASSERT(resampledFrames == framesPerBuffer);
+        mixDirectMonitorInputs(out,
+                in,
+                framesPerBuffer,
+                m_outputParams.channelCount,
+                m_inputParams.channelCount);
+    }
     return paContinue;
 }
 
+double SoundDevicePortAudio::chunksSinceEngineTransfer(
+        const std::atomic<qint64>& lastTransferNanos) const {
+    const qint64 elapsedNanos = mixxx::Time::elapsed().toIntegerNanos() -
+            lastTransferNanos.load(std::memory_order_relaxed);
+    const double elapsedFrames = elapsedNanos * m_dSampleRate / 1e9;
+    // The Clock Reference callback exchanges one chunk per buffer, a later
+    // exchange is an underflow handled by the Fifos
+    return math_clamp(elapsedFrames / m_framesPerBuffer, 0.0, 1.0);
+}
+
 int SoundDevicePortAudio::callbackProcess(const SINT framesPerBuffer,
         CSAMPLE *out, const CSAMPLE *in,
         const PaStreamCallbackTimeInfo *timeInfo,
@@ -855,6 +878,11 @@ int SoundDevicePortAudio::callbackProcess(const SINT framesPerBuffer,
             m_pSoundManager->underflowHappened(5);
             //qDebug() << "callbackProcess read:" << "Buffer empty";
         }
+        mixDirectMonitorInputs(out,
+                in,
+                framesPerBuffer,
+                m_outputParams.channelCount,
+                m_inputParams.channelCount);
      }
     return paContinue;
 }
@@ -875,6 +903,9 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     if (!m_bSetThreadPriority) {
         QThread::currentThread()->setPriority(QThread::TimeCriticalPriority);
         m_bSetThreadPriority = true;
+        mixxx::RealtimeProfile::applyToCurrentThread(
+                mixxx::RealtimeProfile::Role::AudioCallback,
+                callbackThreadName(m_deviceId));
 
 
 #ifdef __SSE__
@@ -975,6 +1006,11 @@ int SoundDevicePortAudio::callbackProcessClkRef(
         }
 
         composeOutputBuffer(out, framesPerBuffer, 0, m_outputParams.channelCount);
+        mixDirectMonitorInputs(out,
+                in,
+                framesPerBuffer,
+                m_outputParams.channelCount,
+                m_inputParams.channelCount);
     }
 
     m_pSoundManager->writeProcess();
@@ -1049,19 +1085,52 @@ void SoundDevicePortAudio::updateCallbackEntryToDacTime(
         callbackEntrytoDacSecs = math_clamp(callbackEntrytoDacSecs, 0.0, bufferSizeSec * 2);
     }
 
-    VisualPlayPosition::setCallbackEntryToDacSecs(callbackEntrytoDacSecs, m_clkRefTimer);
+    // The plausibility check above needs the unfiltered value
     m_lastCallbackEntrytoDacSecs = callbackEntrytoDacSecs;
 
+    m_callbackEntrySecs += timeSinceLastCbSecs;
+    VisualPlayPosition::setCallbackEntryToDacSecs(
+            filterCallbackEntryToDacSecs(callbackEntrytoDacSecs, bufferSizeSec),
+            m_clkRefTimer);
+
     //qDebug() << callbackEntrytoDacSecs << timeSinceLastCbSecs;
 }
 
+double SoundDevicePortAudio::filterCallbackEntryToDacSecs(
+        double callbackEntrytoDacSecs, double bufferSizeSecs) {
+    // The DAC time is derived from the callback entry time, which is
+    // measured with the jitter of the scheduling of the callback thread.
+    // Instead the DAC time advances by one buffer per callback with the
+    // pace of the DAC clock. A delay-locked loop follows this clock in the
+    // CPU clock domain, which is also used for the VSync timing. Then the
+    // waveforms scroll smoothly.
+    // See Fons Adriaensen: Using a DLL to filter time (2005)
+    const double dacSecs = m_callbackEntrySecs + callbackEntrytoDacSecs;
+    const double error = dacSecs - m_filteredNextDacSecs;
+    if (!m_dacTimeFilterValid || fabs(error) > bufferSizeSecs) {
+        // (Re-)start after opening the device or after an underflow
+        m_filteredDacSecs = dacSecs;
+        m_filteredBufferSecs = bufferSizeSecs;
+        m_filteredNextDacSecs = dacSecs + bufferSizeSecs;
+        m_dacTimeFilterValid = true;
+        return callbackEntrytoDacSecs;
+    }
+    const double omega = 2 * M_PI * kDacTimeFilterBandwidthHz * bufferSizeSecs;
+    m_filteredDacSecs = m_filteredNextDacSecs;
+    m_filteredNextDacSecs += M_SQRT2 * omega * error + m_filteredBufferSecs;
+    m_filteredBufferSecs += omega * omega * error;
+    return math_max(m_filteredDacSecs - m_callbackEntrySecs, 0.0);
+}
+
 void SoundDevicePortAudio::updateAudioLatencyUsage(
         const SINT framesPerBuffer) {
     m_framesSinceAudioLatencyUsageUpdate += framesPerBuffer;
     if (m_framesSinceAudioLatencyUsageUpdate > (m_dSampleRate / kCpuUsageUpdateRate)) {
         double secInAudioCb = m_timeInAudioCallback.toDoubleSeconds();
-        m_masterAudioLatencyUsage.set(
-                secInAudioCb / (m_framesSinceAudioLatencyUsageUpdate / m_dSampleRate));
+        const double usage =
+                secInAudioCb / (m_framesSinceAudioLatencyUsageUpdate / m_dSampleRate);
+        m_masterAudioLatencyUsage.set(usage);
+        mixxx::metrics::engineLoad.observe(usage);
         m_timeInAudioCallback = mixxx::Duration::fromSeconds(0);
         m_framesSinceAudioLatencyUsageUpdate = 0;
         //qDebug() << m_pMasterAudioLatencyUsage
@@ -3,6 +3,9 @@
 #include <portaudio.h>
 
 #include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include "control/pollingcontrolproxy.h"
 #include "soundio/sounddevice.h"
@@ -11,6 +14,7 @@
 
 class SoundManager;
 class ControlProxy;
+class DriftResampler;
 
 class SoundDevicePortAudio : public SoundDevice {
   public:
@@ -52,7 +56,13 @@ class SoundDevicePortAudio : public SoundDevice {
 
   private:
     void updateCallbackEntryToDacTime(const PaStreamCallbackTimeInfo* timeInfo);
+    // Returns the time from the callback entry to the DAC with the jitter
+    // of the callback scheduling removed
+    double filterCallbackEntryToDacSecs(double callbackEntrytoDacSecs, double bufferSizeSecs);
     void updateAudioLatencyUsage(const SINT framesPerBuffer);
+    // Time since the clock reference callback has read or written the Fifo,
+    // in chunks between 0 and 1
+    double chunksSinceEngineTransfer(const std::atomic<qint64>& lastTransferNanos) const;
 
     // PortAudio stream for this device.
     PaStream* volatile m_pStream;
@@ -68,6 +78,10 @@ class SoundDevicePortAudio : public SoundDevice {
     FIFO<CSAMPLE>* m_inputFifo;
     bool m_outputDrift;
     bool m_inputDrift;
+    // Drift correction of callbackProcessDrift()
+    std::unique_ptr<DriftResampler> m_pOutputResampler;
+    std::unique_ptr<DriftResampler> m_pInputResampler;
+    std::vector<CSAMPLE> m_resampledInput;
 
     // A string describing the last PortAudio error to occur.
     QString m_lastError;
@@ -80,4 +94,14 @@ class SoundDevicePortAudio : public SoundDevice {
     int m_invalidTimeInfoCount;
     PerformanceTimer m_clkRefTimer;
     PaTime m_lastCallbackEntrytoDacSecs;
+    // State of the delay-locked loop that filters the DAC times, all
+    // in seconds of the CPU clock since the device has been opened
+    bool m_dacTimeFilterValid;
+    double m_callbackEntrySecs;
+    double m_filteredDacSecs;
+    double m_filteredNextDacSecs;
+    double m_filteredBufferSecs;
+    // Written by the clock reference callback, read by callbackProcessDrift()
+    std::atomic<qint64> m_lastOutputTransferNanos;
+    std::atomic<qint64> m_lastInputTransferNanos;
 };
@@ -2,10 +2,14 @@
 
 #include <portaudio.h>
 
+#include <QDir>
+#include <QFileSystemWatcher>
 #include <QLibrary>
 #include <QThread>
+#include <QTimer>
 #include <QtDebug>
 #include <cstring> // for memcpy and strcmp
+#include <future>
 
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
@@ -13,8 +17,12 @@
 #include "engine/enginemaster.h"
 #include "engine/sidechain/enginenetworkstream.h"
 #include "engine/sidechain/enginesidechain.h"
+#include "mixer/playermanager.h"
 #include "moc_soundmanager.cpp"
 #include "soundio/sounddevice.h"
+#ifdef __JACK__
+#include "soundio/sounddevicejack.h"
+#endif
 #include "soundio/sounddevicenetwork.h"
 #include "soundio/sounddevicenotfound.h"
 #include "soundio/sounddeviceportaudio.h"
@@ -23,6 +31,7 @@
 #include "util/compatibility/qatomic.h"
 #include "util/defs.h"
 #include "util/sample.h"
+#include "util/time.h"
 #include "util/versionstore.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
 
@@ -32,6 +41,14 @@ namespace {
 
 #define CPU_OVERLOAD_DURATION 500 // in ms
 
+// Opt-in: Increase the audio buffer size if the engine overloads repeatedly
+const ConfigKey kAdaptiveBufferSizeConfigKey =
+        ConfigKey(QStringLiteral("[Soundcard]"), QStringLiteral("AdaptiveBufferSize"));
+// The overload count is increased at most once per CPU_OVERLOAD_DURATION,
+// so this is an overload in half of the time of the window.
+constexpr int kSustainedOverloadCount = 10;
+const auto kSustainedOverloadWindow = mixxx::Duration::fromSeconds(10);
+
 struct DeviceMode {
     SoundDevicePointer pDevice;
     bool isInput;
@@ -40,9 +57,36 @@ struct DeviceMode {
 
 #ifdef __LINUX__
 constexpr unsigned int kSleepSecondsAfterClosingDevice = 5;
+
+// The device nodes of the ALSA sound cards, which are created and removed
+// by udev when a sound card is plugged in or removed
+const QString kSoundDeviceNodesPath = QStringLiteral("/dev/snd");
 #endif
+
+// Plugging in a sound card creates its device nodes one after another
+constexpr int kHotplugSettleMillis = 1000;
+
+// The result of Pa_Initialize() if it has been started by
+// SoundManager::startPortAudioInitialization(). Only accessed by the main
+// thread.
+std::future<PaError> s_portAudioInitialization;
+
 } // anonymous namespace
 
+// static
+void SoundManager::startPortAudioInitialization() {
+#ifdef __LINUX__
+    VERIFY_OR_DEBUG_ASSERT(!s_portAudioInitialization.valid()) {
+        return;
+    }
+    // The JACK client name must be set before PortAudio is initialized
+    setJACKName();
+    s_portAudioInitialization = std::async(std::launch::async, [] {
+        return Pa_Initialize();
+    });
+#endif
+}
+
 SoundManager::SoundManager(UserSettingsPointer pConfig,
         EngineMaster* pMaster)
         : m_pMaster(pMaster),
@@ -54,7 +98,12 @@ SoundManager::SoundManager(UserSettingsPointer pConfig,
           m_underflowUpdateCount(0),
           m_masterAudioLatencyOverloadCount("[Master]",
                   "audio_latency_overload_count"),
-          m_masterAudioLatencyOverload("[Master]", "audio_latency_overload") {
+          m_masterAudioLatencyOverload("[Master]", "audio_latency_overload"),
+          m_pAudioLatencyOverloadCountWatcher(new ControlProxy(
+                  "[Master]", "audio_latency_overload_count", this)),
+          m_overloadsInWindow(0),
+          m_pHotplugWatcher(new QFileSystemWatcher(this)),
+          m_pHotplugTimer(new QTimer(this)) {
     // TODO(xxx) some of these ControlObject are not needed by soundmanager, or are unused here.
     // It is possible to take them out?
     m_pControlObjectSoundStatusCO = new ControlObject(
@@ -78,6 +127,26 @@ SoundManager::SoundManager(UserSettingsPointer pConfig,
         m_config.loadDefaults(this, SoundManagerConfig::ALL);
     }
     checkConfig();
+    m_pAudioLatencyOverloadCountWatcher->connectValueChanged(
+            this, &SoundManager::slotAudioLatencyOverloadCountChanged);
+
+    // PortAudio has no hotplug notification, so the device nodes are
+    // watched where they exist
+    m_pHotplugTimer->setSingleShot(true);
+    m_pHotplugTimer->setInterval(kHotplugSettleMillis);
+    connect(m_pHotplugTimer,
+            &QTimer::timeout,
+            this,
+            &SoundManager::slotHotplugTimeout);
+#ifdef __LINUX__
+    if (QDir(kSoundDeviceNodesPath).exists()) {
+        m_pHotplugWatcher->addPath(kSoundDeviceNodesPath);
+    }
+#endif
+    connect(m_pHotplugWatcher,
+            &QFileSystemWatcher::directoryChanged,
+            m_pHotplugTimer,
+            QOverload<>::of(&QTimer::start));
     // Don't write config to disk, yet -- it may be reset to defaults in case
     // previously configured devices were not found.
     // Write new config after MixxxMainWindow::noOutputDlg where the user has
@@ -139,6 +208,14 @@ QList<QString> SoundManager::getHostAPIList() const {
             apiList.push_back(api->name);
         }
     }
+#ifdef __JACK__
+    for (const auto& pDevice : m_devices) {
+        if (pDevice->getHostAPI() == MIXXX_JACK_NATIVE_STRING) {
+            apiList.push_back(MIXXX_JACK_NATIVE_STRING);
+            break;
+        }
+    }
+#endif
 
     return apiList;
 }
@@ -216,7 +293,7 @@ void SoundManager::clearDeviceList(bool sleepAfterClosing) {
 }
 
 QList<unsigned int> SoundManager::getSampleRates(const QString& api) const {
-    if (api == MIXXX_PORTAUDIO_JACK_STRING) {
+    if (api == MIXXX_PORTAUDIO_JACK_STRING || api == MIXXX_JACK_NATIVE_STRING) {
         // queryDevices must have been called for this to work, but the
         // ctor calls it -bkgood
         QList<unsigned int> samplerates;
@@ -235,6 +312,9 @@ QList<unsigned int> SoundManager::getSampleRates() const {
 void SoundManager::queryDevices() {
     //qDebug() << "SoundManager::queryDevices()";
     queryDevicesPortaudio();
+#ifdef __JACK__
+    queryDevicesJack();
+#endif
     queryDevicesMixxx();
 
     // now tell the prefs that we updated the device list -- bkgood
@@ -250,10 +330,17 @@ void SoundManager::clearAndQueryDevices() {
 void SoundManager::queryDevicesPortaudio() {
     PaError err = paNoError;
     if (!m_paInitialized) {
+        if (s_portAudioInitialization.valid()) {
+            // Only the first query uses the initialization started in the
+            // background, the following ones need to enumerate the devices
+            // again.
+            err = s_portAudioInitialization.get();
+        } else {
 #ifdef Q_OS_LINUX
-        setJACKName();
+            setJACKName();
 #endif
-        err = Pa_Initialize();
+            err = Pa_Initialize();
+        }
         m_paInitialized = true;
     }
     if (err != paNoError) {
@@ -310,6 +397,18 @@ void SoundManager::queryDevicesPortaudio() {
     }
 }
 
+#ifdef __JACK__
+void SoundManager::queryDevicesJack() {
+    auto pDevice = SoundDeviceJack::probe(m_pConfig, this);
+    if (!pDevice) {
+        return;
+    }
+    m_jackSampleRate = static_cast<mixxx::audio::SampleRate::value_t>(
+            pDevice->getDefaultSampleRate());
+    m_devices.push_back(pDevice);
+}
+#endif
+
 void SoundManager::queryDevicesMixxx() {
     auto currentDevice = SoundDevicePointer(new SoundDeviceNetwork(
             m_pConfig, this, m_pNetworkStream));
@@ -371,6 +470,11 @@ SoundDeviceError SoundManager::setupDevices() {
             // TODO(bkgood) look into allocating this with the frames per
             // buffer value from SMConfig
             AudioInputBuffer aib(in, SampleUtil::alloc(MAX_BUFFER_LEN));
+            for (auto it = m_registeredDestinations.constFind(in);
+                    it != m_registeredDestinations.constEnd() && it.key() == in;
+                    ++it) {
+                aib.addDestination(it.value());
+            }
             err = pDevice->addInput(aib);
             if (err != SOUNDDEVICE_ERROR_OK) {
                 SampleUtil::free(aib.getBuffer());
@@ -477,6 +581,8 @@ SoundDeviceError SoundManager::setupDevices() {
         }
     }
 
+    updateDeckOutputLatencies(pNewMasterClockRef);
+
     if (pNewMasterClockRef) {
         qDebug() << "Using" << pNewMasterClockRef->getDisplayName()
                  << "as output sound device clock reference";
@@ -509,6 +615,39 @@ closeAndError:
     return err;
 }
 
+void SoundManager::updateDeckOutputLatencies(const SoundDevicePointer& pClkRefDevice) {
+    QList<int> latencyOffsetDecks;
+    if (pClkRefDevice) {
+        const double clkRefLatencyMillis = pClkRefDevice->getOutputLatencyMillis();
+        for (const auto& pDevice : qAsConst(m_devices)) {
+            if (pDevice == pClkRefDevice || !pDevice->isOpen()) {
+                continue;
+            }
+            const double offsetMillis = pDevice->getOutputLatencyMillis() - clkRefLatencyMillis;
+            for (const auto& out : pDevice->outputs()) {
+                if (out.getType() != AudioOutput::DECK || offsetMillis == 0.0) {
+                    continue;
+                }
+                const int index = out.getIndex();
+                qDebug() << "Deck" << index + 1 << "is heard" << offsetMillis
+                         << "ms after the clock reference device";
+                ControlObject::set(ConfigKey(PlayerManager::groupForDeck(index),
+                                           "sync_output_latency"),
+                        offsetMillis);
+                latencyOffsetDecks.append(index);
+            }
+        }
+    }
+    for (int index : qAsConst(m_latencyOffsetDecks)) {
+        if (!latencyOffsetDecks.contains(index)) {
+            ControlObject::set(ConfigKey(PlayerManager::groupForDeck(index),
+                                       "sync_output_latency"),
+                    0.0);
+        }
+    }
+    m_latencyOffsetDecks = latencyOffsetDecks;
+}
+
 SoundDevicePointer SoundManager::getErrorDevice() const {
     return m_pErrorDevice;
 }
@@ -588,6 +727,10 @@ void SoundManager::checkConfig() {
 void SoundManager::onDeviceOutputCallback(const SINT iFramesPerBuffer) {
     // Produce a block of samples for output. EngineMaster expects stereo
     // samples so multiply iFramesPerBuffer by 2.
+    // Note: Splitting the block into smaller ones would not reduce the
+    // latency of control changes, because all of them are processed right
+    // after each other at the start of the callback and see the same
+    // control values. Only a smaller audio buffer size does.
     m_pMaster->process(iFramesPerBuffer * 2);
 }
 
@@ -597,9 +740,8 @@ void SoundManager::pushInputBuffers(const QList<AudioInputBuffer>& inputs,
                  e = inputs.end(); i != e; ++i) {
         const AudioInputBuffer& in = *i;
         CSAMPLE* pInputBuffer = in.getBuffer();
-        for (auto it = m_registeredDestinations.constFind(in);
-             it != m_registeredDestinations.constEnd() && it.key() == in; ++it) {
-            it.value()->receiveBuffer(in, pInputBuffer, iFramesPerBuffer);
+        for (AudioDestination* pDestination : in.getDestinations()) {
+            pDestination->receiveBuffer(in, pInputBuffer, iFramesPerBuffer);
         }
     }
 }
@@ -632,6 +774,8 @@ void SoundManager::registerInput(const AudioInput& input, AudioDestination* dest
     // Vinyl control inputs are registered twice, once for timecode and once for
     // passthrough, each with different outputs. So unlike outputs, do not assert
     // that the input has not been registered yet.
+    // The destination receives buffers after the devices have been set up
+    // the next time, which also notifies it that its input is configured.
     m_registeredDestinations.insert(input, dest);
 
     emit inputRegistered(input, dest);
@@ -645,7 +789,8 @@ QList<AudioInput> SoundManager::registeredInputs() const {
     return m_registeredDestinations.keys();
 }
 
-void SoundManager::setJACKName() const {
+// static
+void SoundManager::setJACKName() {
 #ifdef Q_OS_LINUX
     typedef PaError (*SetJackClientName)(const char *name);
     QLibrary portaudio("libportaudio.so.2");
@@ -703,3 +848,55 @@ void SoundManager::processUnderflowHappened() {
         --m_underflowUpdateCount;
     }
 }
+
+void SoundManager::slotAudioLatencyOverloadCountChanged(double count) {
+    if (count <= 0 || !m_pConfig->getValue(kAdaptiveBufferSizeConfigKey, false)) {
+        // The count is reset by setupDevices()
+        m_overloadsInWindow = 0;
+        return;
+    }
+    const auto now = mixxx::Time::elapsed();
+    if (m_overloadsInWindow == 0 || now - m_overloadWindowStart > kSustainedOverloadWindow) {
+        m_overloadWindowStart = now;
+        m_overloadsInWindow = 0;
+    }
+    if (++m_overloadsInWindow < kSustainedOverloadCount) {
+        return;
+    }
+    m_overloadsInWindow = 0;
+
+    // The buffer size of JACK is configured in the JACK server
+    if (m_config.getAPI() == MIXXX_PORTAUDIO_JACK_STRING) {
+        return;
+    }
+    const unsigned int sizeIndex = m_config.getAudioBufferSizeIndex();
+    if (sizeIndex >= SoundManagerConfig::kMaxAudioBufferSizeIndex) {
+        return;
+    }
+    qWarning() << "SoundManager: Sustained audio latency overload,"
+               << "increasing the audio buffer size from"
+               << m_config.getFramesPerBuffer() << "frames";
+    // Reopening the devices interrupts the audio once, but is less
+    // disturbing than the continuous dropouts. The new size is applied
+    // like one from the preferences, i.e. it is kept for the next start.
+    SoundManagerConfig config = m_config;
+    config.setAudioBufferSizeIndex(sizeIndex + 1);
+    setConfig(config);
+}
+
+void SoundManager::slotHotplugTimeout() {
+    for (const auto& pDevice : qAsConst(m_devices)) {
+        if (pDevice->isOpen()) {
+            // Updating the device list requires to terminate PortAudio,
+            // which would interrupt the audio.
+            qInfo() << "Sound devices have been plugged in or removed,"
+                    << "query the devices in the preferences to update the list";
+            emit devicesHotplugged();
+            return;
+        }
+    }
+    qInfo() << "Sound devices have been plugged in or removed, updating the list";
+    const bool sleepAfterClosing = false;
+    clearDeviceList(sleepAfterClosing);
+    queryDevices();
+}
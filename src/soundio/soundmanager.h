@@ -14,6 +14,8 @@
 #include "soundio/sounddevice.h"
 #include "soundio/soundmanagerconfig.h"
 #include "util/cmdlineargs.h"
+#include "util/duration.h"
+#include "util/metrics.h"
 #include "util/types.h"
 
 class EngineMaster;
@@ -23,6 +25,8 @@ class AudioSource;
 class AudioDestination;
 class ControlObject;
 class ControlProxy;
+class QFileSystemWatcher;
+class QTimer;
 class SoundDeviceNotFound;
 
 #define MIXXX_PORTAUDIO_JACK_STRING "JACK Audio Connection Kit"
@@ -31,6 +35,8 @@ class SoundDeviceNotFound;
 #define MIXXX_PORTAUDIO_ASIO_STRING "ASIO"
 #define MIXXX_PORTAUDIO_DIRECTSOUND_STRING "Windows DirectSound"
 #define MIXXX_PORTAUDIO_COREAUDIO_STRING "Core Audio"
+// Used by SoundDeviceJack, which bypasses PortAudio
+#define MIXXX_JACK_NATIVE_STRING "JACK (native)"
 
 #define SOUNDMANAGER_DISCONNECTED 0
 #define SOUNDMANAGER_CONNECTING 1
@@ -43,6 +49,16 @@ class SoundManager : public QObject {
     SoundManager(UserSettingsPointer pConfig, EngineMaster *_master);
     ~SoundManager() override;
 
+    // Starts the initialization of PortAudio, which enumerates the devices
+    // of all host APIs, in a worker thread. Probing the ALSA devices and
+    // plugins may take several seconds, which then overlaps with the rest of
+    // the startup. The first queryDevices() waits for the result.
+    //
+    // This is only done on Linux. The Windows host APIs initialize COM for
+    // the calling thread, so PortAudio must be initialized and terminated by
+    // the same thread there.
+    static void startPortAudioInitialization();
+
     // Returns a list of all devices we've enumerated that match the provided
     // filterApi, and have at least one output or input channel if the
     // bOutputDevices or bInputDevices are set, respectively.
@@ -53,6 +69,9 @@ class SoundManager : public QObject {
     void clearAndQueryDevices();
     void queryDevices();
     void queryDevicesPortaudio();
+#ifdef __JACK__
+    void queryDevicesJack();
+#endif
     void queryDevicesMixxx();
 
     // Opens all the devices chosen by the user in the preferences dialog, and
@@ -101,6 +120,7 @@ class SoundManager : public QObject {
 
     void underflowHappened(int code) {
         m_underflowHappened = 1;
+        mixxx::metrics::engineUnderflows.increment();
         // Disable the engine warnings by default, because printing a warning is a
         // locking function that will make the problem worse
         if (CmdlineArgs::Instance().getDeveloper()) {
@@ -115,6 +135,17 @@ class SoundManager : public QObject {
     void devicesSetup(); // emitted when the sound devices have been set up
     void outputRegistered(const AudioOutput& output, AudioSource* src);
     void inputRegistered(const AudioInput& input, AudioDestination* dest);
+    // Emitted when sound devices have been plugged in or removed while
+    // devices are open, so the device list could not be updated.
+    void devicesHotplugged();
+
+  private slots:
+    // Increases the audio buffer size after sustained overloads if the
+    // adaptive buffer size is enabled
+    void slotAudioLatencyOverloadCountChanged(double count);
+    // Updates the device list after sound devices have been plugged in or
+    // removed, unless devices are open
+    void slotHotplugTimeout();
 
   private:
     // Closes all the devices and empties the list of devices we have.
@@ -126,7 +157,11 @@ class SoundManager : public QObject {
     // isn't open is safe.
     void closeDevices(bool sleepAfterClosing);
 
-    void setJACKName() const;
+    static void setJACKName();
+
+    // Publishes how much later than the clock reference device each deck
+    // with its own output is heard, so sync can compensate for it.
+    void updateDeckOutputLatencies(const SoundDevicePointer& pClkRefDevice);
 
     EngineMaster *m_pMaster;
     UserSettingsPointer m_pConfig;
@@ -142,6 +177,8 @@ class SoundManager : public QObject {
     QMultiHash<AudioInput, AudioDestination*> m_registeredDestinations;
     ControlObject* m_pControlObjectSoundStatusCO;
     ControlObject* m_pControlObjectVinylControlGainCO;
+    // Indices of the decks with a non-zero output latency offset
+    QList<int> m_latencyOffsetDecks;
 
     QSharedPointer<EngineNetworkStream> m_pNetworkStream;
 
@@ -149,4 +186,15 @@ class SoundManager : public QObject {
     int m_underflowUpdateCount;
     PollingControlProxy m_masterAudioLatencyOverloadCount;
     PollingControlProxy m_masterAudioLatencyOverload;
+
+    // Notified in the main thread, the audio thread only sets the count
+    ControlProxy* m_pAudioLatencyOverloadCountWatcher;
+    mixxx::Duration m_overloadWindowStart;
+    int m_overloadsInWindow;
+
+    // Watches the device nodes of the sound cards where the platform offers
+    // them. Changes are collected by the timer, because a sound card creates
+    // multiple device nodes.
+    QFileSystemWatcher* m_pHotplugWatcher;
+    QTimer* m_pHotplugTimer;
 };
@@ -476,8 +476,11 @@ void SoundManagerConfig::loadDefaults(SoundManager* soundManager, unsigned int f
         QList<QString> apiList = soundManager->getHostAPIList();
         if (!apiList.isEmpty()) {
 #ifdef __LINUX__
-            //Check for JACK and use that if it's available, otherwise use ALSA
-            if (apiList.contains(MIXXX_PORTAUDIO_JACK_STRING)) {
+            //Check for JACK and use that if it's available, otherwise use ALSA.
+            //The native JACK API has a lower latency than JACK via PortAudio.
+            if (apiList.contains(MIXXX_JACK_NATIVE_STRING)) {
+                m_api = MIXXX_JACK_NATIVE_STRING;
+            } else if (apiList.contains(MIXXX_PORTAUDIO_JACK_STRING)) {
                 m_api = MIXXX_PORTAUDIO_JACK_STRING;
             } else {
                 m_api = MIXXX_PORTAUDIO_ALSA_STRING;
@@ -3,12 +3,15 @@
 #include <QDomElement>
 #include <QList>
 #include <QString>
+#include <QVarLengthArray>
 #include <QtDebug>
 
 #include "util/compatibility/qhash.h"
 #include "util/fifo.h"
 #include "util/types.h"
 
+class AudioDestination;
+
 /// Describes a group of channels, typically a pair for stereo sound in Mixxx.
 class ChannelGroup {
   public:
@@ -180,8 +183,22 @@ class AudioInputBuffer : public AudioInput {
     }
     ~AudioInputBuffer() override = default;
     inline CSAMPLE* getBuffer() const { return m_pBuffer; }
+
+    /// The destinations that receive the buffer. They are resolved once
+    /// when the devices are set up instead of looking them up in every
+    /// audio callback.
+    const QVarLengthArray<AudioDestination*, 2>& getDestinations() const {
+        return m_destinations;
+    }
+    void addDestination(AudioDestination* pDestination) {
+        m_destinations.append(pDestination);
+    }
+
   private:
     CSAMPLE* m_pBuffer;
+    // Vinyl control inputs have two destinations, one for the
+    // timecode and one for passthrough
+    QVarLengthArray<AudioDestination*, 2> m_destinations;
 };
 
 
@@ -230,6 +247,13 @@ public:
     virtual void onInputUnconfigured(const AudioInput& input) {
         Q_UNUSED(input);
     };
+
+    /// Returns the gain with which the raw input is mixed into the main and
+    /// booth outputs of its own sound device, bypassing the engine. This is
+    /// called from the callback thread of the device.
+    virtual CSAMPLE_GAIN getDirectMonitorGain() const {
+        return CSAMPLE_GAIN_ZERO;
+    }
 };
 
 typedef AudioPath::AudioPathType AudioPathType;
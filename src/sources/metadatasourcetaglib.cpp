@@ -323,6 +323,12 @@ class TagSaver {
 
     virtual bool hasModifiedTags() const = 0;
 
+    /// Returns true if saving the modified tags only overwrites the
+    /// existing tags in the file without moving the audio data.
+    virtual bool canSaveModifiedTagsInPlace() {
+        return false;
+    }
+
     virtual bool saveModifiedTags() = 0;
 };
 
@@ -346,6 +352,23 @@ class MpegTagSaver : public TagSaver {
         return m_file.save(m_modifiedTagsBitmask);
     }
 
+    bool canSaveModifiedTagsInPlace() override {
+        // Only an ID3v2 tag at the start of the file that keeps its size
+        // including the padding is overwritten in place. Saving strips
+        // all other tags, which would truncate the file.
+        if (m_modifiedTagsBitmask != TagLib::MPEG::File::ID3v2 ||
+                taglib::hasAPETag(m_file) ||
+                taglib::hasID3v1Tag(m_file) ||
+                !m_file.hasID3v2Tag()) {
+            return false;
+        }
+        TagLib::ID3v2::Tag* pID3v2Tag = m_file.ID3v2Tag(false);
+        VERIFY_OR_DEBUG_ASSERT(pID3v2Tag) {
+            return false;
+        }
+        return pID3v2Tag->render().size() == pID3v2Tag->header()->completeTagSize();
+    }
+
   private:
     static int exportTrackMetadata(TagLib::MPEG::File* pFile, const TrackMetadata& trackMetadata) {
         int modifiedTagsBitmask = TagLib::MPEG::File::NoTags;
@@ -887,6 +910,32 @@ class SafelyWritableFile final {
     QString m_tempFileName;
 };
 
+std::unique_ptr<TagSaver> newTagSaver(
+        taglib::FileType fileType,
+        const QString& fileName,
+        const TrackMetadata& trackMetadata) {
+    switch (fileType) {
+    case taglib::FileType::MP3:
+        return std::make_unique<MpegTagSaver>(fileName, trackMetadata);
+    case taglib::FileType::MP4:
+        return std::make_unique<Mp4TagSaver>(fileName, trackMetadata);
+    case taglib::FileType::FLAC:
+        return std::make_unique<FlacTagSaver>(fileName, trackMetadata);
+    case taglib::FileType::OGG:
+        return std::make_unique<OggTagSaver>(fileName, trackMetadata);
+    case taglib::FileType::OPUS:
+        return std::make_unique<OpusTagSaver>(fileName, trackMetadata);
+    case taglib::FileType::WV:
+        return std::make_unique<WavPackTagSaver>(fileName, trackMetadata);
+    case taglib::FileType::WAV:
+        return std::make_unique<WavTagSaver>(fileName, trackMetadata);
+    case taglib::FileType::AIFF:
+        return std::make_unique<AiffTagSaver>(fileName, trackMetadata);
+    default:
+        return nullptr;
+    }
+}
+
 } // anonymous namespace
 
 std::pair<MetadataSource::ExportResult, QDateTime>
@@ -899,7 +948,28 @@ MetadataSourceTagLib::exportTrackMetadata(
                     << "into file" << m_fileName
                     << "with type" << m_fileType;
 
-    SafelyWritableFile safelyWritableFile(m_fileName, kExportTrackMetadataIntoTemporaryFile);
+    std::unique_ptr<TagSaver> pTagSaver =
+            newTagSaver(m_fileType, m_fileName, trackMetadata);
+    if (!pTagSaver) {
+        kLogger.debug()
+                << "Cannot export track metadata"
+                << "into file" << m_fileName
+                << "with unknown or unsupported type"
+                << m_fileType;
+        return afterExport(ExportResult::Unsupported);
+    }
+
+    // Copying the whole file into a temporary file is not needed if saving
+    // the modified tags doesn't move the audio data. A failure could only
+    // damage the tags then, but not the audio data.
+    const bool useTemporaryFile = kExportTrackMetadataIntoTemporaryFile &&
+            !(pTagSaver->hasModifiedTags() && pTagSaver->canSaveModifiedTagsInPlace());
+    if (useTemporaryFile) {
+        // Close the original file before cloning it
+        pTagSaver.reset();
+    }
+
+    SafelyWritableFile safelyWritableFile(m_fileName, useTemporaryFile);
     if (!safelyWritableFile.isReady()) {
         kLogger.warning()
                 << "Unable to export track metadata into file"
@@ -908,47 +978,11 @@ MetadataSourceTagLib::exportTrackMetadata(
         return afterExport(ExportResult::Failed);
     }
 
-    std::unique_ptr<TagSaver> pTagSaver;
-    switch (m_fileType) {
-    case taglib::FileType::MP3: {
-        pTagSaver = std::make_unique<MpegTagSaver>(safelyWritableFile.fileName(), trackMetadata);
-        break;
-    }
-    case taglib::FileType::MP4: {
-        pTagSaver = std::make_unique<Mp4TagSaver>(safelyWritableFile.fileName(), trackMetadata);
-        break;
-    }
-    case taglib::FileType::FLAC: {
-        pTagSaver = std::make_unique<FlacTagSaver>(safelyWritableFile.fileName(), trackMetadata);
-        break;
-    }
-    case taglib::FileType::OGG: {
-        pTagSaver = std::make_unique<OggTagSaver>(safelyWritableFile.fileName(), trackMetadata);
-        break;
-    }
-    case taglib::FileType::OPUS: {
-        pTagSaver = std::make_unique<OpusTagSaver>(safelyWritableFile.fileName(), trackMetadata);
-        break;
-    }
-    case taglib::FileType::WV: {
-        pTagSaver = std::make_unique<WavPackTagSaver>(safelyWritableFile.fileName(), trackMetadata);
-        break;
-    }
-    case taglib::FileType::WAV: {
-        pTagSaver = std::make_unique<WavTagSaver>(safelyWritableFile.fileName(), trackMetadata);
-        break;
-    }
-    case taglib::FileType::AIFF: {
-        pTagSaver = std::make_unique<AiffTagSaver>(safelyWritableFile.fileName(), trackMetadata);
-        break;
-    }
-    default:
-        kLogger.debug()
-                << "Cannot export track metadata"
-                << "into file" << m_fileName
-                << "with unknown or unsupported type"
-                << m_fileType;
-        return afterExport(ExportResult::Unsupported);
+    if (!pTagSaver) {
+        pTagSaver = newTagSaver(m_fileType, safelyWritableFile.fileName(), trackMetadata);
+        VERIFY_OR_DEBUG_ASSERT(pTagSaver) {
+            return afterExport(ExportResult::Failed);
+        }
     }
 
     if (pTagSaver->hasModifiedTags()) {
@@ -1,8 +1,11 @@
 #include "sources/soundsourceffmpeg.h"
 
+#include <QThread>
 #include <mutex>
+#include <vector>
 
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/sample.h"
 
 #if !defined(VERBOSE_DEBUG_LOG)
@@ -258,10 +261,42 @@ AVFormatContext* openInputFile(
     return pavInputFormatContext;
 }
 
+// Multiple sources are decoded at the same time, i.e. by the caching
+// readers of all decks and by the analyzer threads. Each of them only
+// uses a few threads to avoid oversubscribing the CPU.
+constexpr int kMaxDecodingThreadCount = 4;
+
+void initDecodingThreads(
+        AVCodecContext* pavCodecContext) {
+    DEBUG_ASSERT(pavCodecContext != nullptr);
+    const AVCodec* pavCodec = pavCodecContext->codec;
+    DEBUG_ASSERT(pavCodec != nullptr);
+    const int threadTypes =
+            ((pavCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) ? FF_THREAD_FRAME : 0) |
+            ((pavCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS) ? FF_THREAD_SLICE : 0);
+    if (threadTypes == 0) {
+        // Single-threaded decoding
+        return;
+    }
+    pavCodecContext->thread_type = threadTypes;
+    pavCodecContext->thread_count = math_clamp(
+            QThread::idealThreadCount(), 1, kMaxDecodingThreadCount);
+#if VERBOSE_DEBUG_LOG
+    kLogger.debug()
+            << "Decoding with"
+            << pavCodecContext->thread_count
+            << "threads of type"
+            << threadTypes;
+#endif
+}
+
 bool openDecodingContext(
         AVCodecContext* pavCodecContext) {
     DEBUG_ASSERT(pavCodecContext != nullptr);
 
+    // The threading options must be set before opening the context
+    initDecodingThreads(pavCodecContext);
+
     const int avcodec_open2_result = avcodec_open2(pavCodecContext, pavCodecContext->codec, nullptr);
     if (avcodec_open2_result != 0) {
         DEBUG_ASSERT(avcodec_open2_result < 0);
@@ -622,7 +657,10 @@ SoundSource::OpenResult SoundSourceFFmpeg::tryOpen(
 
     audio::ChannelCount channelCount;
     audio::SampleRate sampleRate;
-    if (!initResampling(&channelCount, &sampleRate)) {
+    if (!initResampling(
+                params.getSignalInfo().getChannelCount(),
+                &channelCount,
+                &sampleRate)) {
         return OpenResult::Failed;
     }
     if (!initChannelCountOnce(channelCount)) {
@@ -700,6 +738,7 @@ SoundSource::OpenResult SoundSourceFFmpeg::tryOpen(
 }
 
 bool SoundSourceFFmpeg::initResampling(
+        audio::ChannelCount requestedChannelCount,
         audio::ChannelCount* pResampledChannelCount,
         audio::SampleRate* pResampledSampleRate) {
     const auto avStreamChannelLayout =
@@ -713,8 +752,17 @@ bool SoundSourceFFmpeg::initResampling(
     // by the same decoder instead of a decoded with a reference signal. As
     // a workaround we decode the stream's channels as is and let Mixxx decide
     // how to handle this later.
+    // The only exception is a requested stereo signal. It is produced with
+    // a custom mixing matrix that maps the channels exactly like
+    // AudioSourceStereoProxy instead of the default matrix of libswresample.
+    // Each decoded sample is then written only once while converting both
+    // the sample format and the channels.
+    const bool downOrUpmixToStereo =
+            requestedChannelCount == audio::ChannelCount::stereo() &&
+            streamChannelCount.isValid() &&
+            streamChannelCount != audio::ChannelCount::stereo();
     const auto resampledChannelCount =
-            /*config.getSignalInfo().getChannelCount().isValid() ? config.getSignalInfo().getChannelCount() :*/ streamChannelCount;
+            downOrUpmixToStereo ? requestedChannelCount : streamChannelCount;
     const auto avResampledChannelLayout =
             av_get_default_channel_layout(resampledChannelCount);
     const auto avStreamSampleFormat =
@@ -754,6 +802,27 @@ bool SoundSourceFFmpeg::initResampling(
                     << "Failed to allocate resampling context";
             return false;
         }
+        if (downOrUpmixToStereo) {
+            // Mono is copied into both channels, and only the first two
+            // channels (front left/right) of multi-channel signals are used
+            const int inputChannels = streamChannelCount;
+            std::vector<double> matrix(2 * inputChannels, 0.0);
+            if (inputChannels == 1) {
+                matrix[0] = 1.0;
+                matrix[1] = 1.0;
+            } else {
+                matrix[0] = 1.0;
+                matrix[inputChannels + 1] = 1.0;
+            }
+            const auto swr_set_matrix_result =
+                    swr_set_matrix(m_pSwrContext, matrix.data(), inputChannels);
+            if (swr_set_matrix_result < 0) {
+                kLogger.warning().noquote()
+                        << "swr_set_matrix() failed:"
+                        << formatErrorString(swr_set_matrix_result);
+                return false;
+            }
+        }
         const auto swr_init_result =
                 swr_init(m_pSwrContext);
         if (swr_init_result < 0) {
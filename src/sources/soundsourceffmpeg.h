@@ -30,6 +30,7 @@ class SoundSourceFFmpeg : public SoundSource {
             const OpenParams& params) override;
 
     bool initResampling(
+            audio::ChannelCount requestedChannelCount,
             audio::ChannelCount* pResampledChannelCount,
             audio::SampleRate* pResampledSampleRate);
     const CSAMPLE* resampleDecodedAVFrame();
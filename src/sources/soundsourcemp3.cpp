@@ -4,6 +4,13 @@
 #include "util/logger.h"
 #include "util/math.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
 #include <id3tag.h>
 
 namespace mixxx {
@@ -85,6 +92,27 @@ constexpr SINT kMaxMp3FramesPerSecond = 39; // fixed: 1 MP3 frame = 26 ms -> ~ 1
 constexpr SINT kSeekFrameListCapacity =
         kMinutesPerFile * kSecondsPerMinute * kMaxMp3FramesPerSecond;
 
+const QByteArray kSeekIndexMagic = QByteArrayLiteral("MXSI");
+constexpr qint32 kSeekIndexVersion = 1;
+
+// Only set once before opening any file
+QString& seekIndexDirectory() {
+    static QString directory;
+    return directory;
+}
+
+QString seekIndexFilePath(const QString& fileName) {
+    if (seekIndexDirectory().isEmpty()) {
+        return QString();
+    }
+    const QByteArray key = QCryptographicHash::hash(
+            QFileInfo(fileName).absoluteFilePath().toUtf8(),
+            QCryptographicHash::Sha1)
+                                   .toHex();
+    return QDir(seekIndexDirectory())
+            .filePath(QString::fromLatin1(key) + QStringLiteral(".idx"));
+}
+
 inline QString formatHeaderFlags(int headerFlags) {
     return QString("0x%1").arg(headerFlags, 4, 16, QLatin1Char('0'));
 }
@@ -183,6 +211,18 @@ SoundSourceMp3::SoundSourceMp3(const QUrl& url)
     initDecoding();
 }
 
+//static
+void SoundSourceMp3::setSeekIndexDirectory(const QString& directory) {
+    if (!QDir().mkpath(directory)) {
+        kLogger.warning()
+                << "Failed to create seek index directory"
+                << directory;
+        seekIndexDirectory() = QString();
+        return;
+    }
+    seekIndexDirectory() = directory;
+}
+
 SoundSourceMp3::~SoundSourceMp3() {
     close();
     finishDecoding();
@@ -228,6 +268,25 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
     DEBUG_ASSERT(m_seekFrameList.empty());
     m_avgSeekFrameCount = 0;
     m_curFrameIndex = 0;
+
+    const QString indexFilePath = seekIndexFilePath(m_file.fileName());
+    if (!indexFilePath.isEmpty()) {
+        audio::ChannelCount channelCount;
+        audio::SampleRate sampleRate;
+        audio::Bitrate bitrate;
+        if (loadSeekIndex(indexFilePath, &channelCount, &sampleRate, &bitrate)) {
+            initChannelCountOnce(channelCount);
+            initSampleRateOnce(sampleRate);
+            initFrameIndexRangeOnce(IndexRange::forward(0, m_curFrameIndex));
+            if (bitrate.isValid()) {
+                initBitrateOnce(bitrate);
+            }
+            return startDecoding();
+        }
+        m_seekFrameList.clear();
+        m_curFrameIndex = 0;
+    }
+
     int headerPerSampleRate[kSampleRateCount];
     for (int i = 0; i < kSampleRateCount; ++i) {
         headerPerSampleRate[i] = 0;
@@ -391,8 +450,6 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
     initFrameIndexRangeOnce(IndexRange::forward(0, m_curFrameIndex));
 
     // Calculate average bitrate values
-    DEBUG_ASSERT(m_seekFrameList.size() > 0); // see above
-    m_avgSeekFrameCount = frameLength() / static_cast<SINT>(m_seekFrameList.size());
     if (cntBitrateFrames > 0) {
         const unsigned long avgBitrate = sumBitrateFrames / cntBitrateFrames;
         initBitrateOnce(avgBitrate / 1000); // bps -> kbps
@@ -400,6 +457,17 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
         kLogger.warning() << "Bitrate cannot be calculated from headers";
     }
 
+    if (!indexFilePath.isEmpty()) {
+        saveSeekIndex(indexFilePath);
+    }
+
+    return startDecoding();
+}
+
+SoundSource::OpenResult SoundSourceMp3::startDecoding() {
+    DEBUG_ASSERT(m_seekFrameList.size() > 0); // see above
+    m_avgSeekFrameCount = frameLength() / static_cast<SINT>(m_seekFrameList.size());
+
     // Terminate m_seekFrameList
     addSeekFrame(m_curFrameIndex, nullptr);
     DEBUG_ASSERT(m_seekFrameList.back().frameIndex == frameIndexMax());
@@ -416,6 +484,116 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
     return OpenResult::Succeeded;
 }
 
+bool SoundSourceMp3::loadSeekIndex(
+        const QString& seekIndexFilePath,
+        audio::ChannelCount* pChannelCount,
+        audio::SampleRate* pSampleRate,
+        audio::Bitrate* pBitrate) {
+    DEBUG_ASSERT(m_seekFrameList.empty());
+    QFile file(seekIndexFilePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        // Not indexed yet
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    QByteArray magic(kSeekIndexMagic.size(), '\0');
+    qint32 version = 0;
+    if (stream.readRawData(magic.data(), magic.size()) != magic.size() ||
+            magic != kSeekIndexMagic) {
+        return false;
+    }
+    stream >> version;
+    if (version != kSeekIndexVersion) {
+        return false;
+    }
+    // The index is outdated if the file has been modified
+    quint64 fileSize = 0;
+    qint64 lastModified = 0;
+    stream >> fileSize >> lastModified;
+    if (fileSize != m_fileSize ||
+            lastModified !=
+                    QFileInfo(m_file).lastModified().toMSecsSinceEpoch()) {
+        return false;
+    }
+    quint32 channelCount = 0;
+    quint32 sampleRate = 0;
+    quint32 bitrate = 0;
+    qint64 frameCount = 0;
+    quint32 seekFrameCount = 0;
+    stream >> channelCount >> sampleRate >> bitrate >> frameCount >> seekFrameCount;
+    if (stream.status() != QDataStream::Ok ||
+            channelCount == 0 ||
+            channelCount > static_cast<quint32>(kChannelCountMax) ||
+            getIndexBySampleRate(audio::SampleRate(sampleRate)) >= kSampleRateCount ||
+            frameCount <= 0 ||
+            seekFrameCount == 0) {
+        kLogger.warning()
+                << "Invalid seek index"
+                << seekIndexFilePath;
+        return false;
+    }
+    m_seekFrameList.reserve(seekFrameCount);
+    for (quint32 i = 0; i < seekFrameCount; ++i) {
+        qint64 frameIndex = 0;
+        quint64 byteOffset = 0;
+        stream >> frameIndex >> byteOffset;
+        // The frames must be ordered and within the file
+        if (stream.status() != QDataStream::Ok ||
+                byteOffset >= m_fileSize ||
+                frameIndex >= frameCount ||
+                (m_seekFrameList.empty() ? frameIndex != 0
+                                         : (frameIndex <= m_seekFrameList.back().frameIndex ||
+                                                   m_pFileData + byteOffset <=
+                                                           m_seekFrameList.back()
+                                                                   .pInputData))) {
+            kLogger.warning()
+                    << "Invalid seek index"
+                    << seekIndexFilePath;
+            return false;
+        }
+        addSeekFrame(static_cast<SINT>(frameIndex), m_pFileData + byteOffset);
+    }
+    m_curFrameIndex = static_cast<SINT>(frameCount);
+    *pChannelCount = audio::ChannelCount(channelCount);
+    *pSampleRate = audio::SampleRate(sampleRate);
+    *pBitrate = audio::Bitrate(bitrate);
+    return true;
+}
+
+void SoundSourceMp3::saveSeekIndex(const QString& seekIndexFilePath) const {
+    // Concurrent readers never see partially written files
+    QSaveFile file(seekIndexFilePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning()
+                << "Failed to save seek index"
+                << seekIndexFilePath
+                << file.errorString();
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream.writeRawData(kSeekIndexMagic.constData(), kSeekIndexMagic.size());
+    stream << kSeekIndexVersion
+           << static_cast<quint64>(m_fileSize)
+           << QFileInfo(m_file).lastModified().toMSecsSinceEpoch()
+           << static_cast<quint32>(getSignalInfo().getChannelCount())
+           << static_cast<quint32>(getSignalInfo().getSampleRate())
+           << static_cast<quint32>(getBitrate())
+           << static_cast<qint64>(m_curFrameIndex)
+           << static_cast<quint32>(m_seekFrameList.size());
+    for (const auto& seekFrame : m_seekFrameList) {
+        stream << static_cast<qint64>(seekFrame.frameIndex)
+               << static_cast<quint64>(seekFrame.pInputData - m_pFileData);
+    }
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        kLogger.warning()
+                << "Failed to save seek index"
+                << seekIndexFilePath
+                << file.errorString();
+    }
+}
+
 void SoundSourceMp3::close() {
     finishDecoding();
 
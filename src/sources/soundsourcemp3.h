@@ -23,6 +23,11 @@ class SoundSourceMp3 final : public SoundSource {
 
     void close() override;
 
+    /// Enables the persistent seek index that avoids scanning all frame
+    /// headers when opening a file again. Must be invoked before opening
+    /// the first file.
+    static void setSeekIndexDirectory(const QString& seekIndexDirectory);
+
   protected:
     ReadableSampleFrames readSampleFramesClamped(
             const WritableSampleFrames& sampleFrames) override;
@@ -32,6 +37,17 @@ class SoundSourceMp3 final : public SoundSource {
             OpenMode mode,
             const OpenParams& params) override;
 
+    // Restores the seek frame list and the audio properties of a
+    // previous scan if the file has not been modified since
+    bool loadSeekIndex(
+            const QString& seekIndexFilePath,
+            audio::ChannelCount* pChannelCount,
+            audio::SampleRate* pSampleRate,
+            audio::Bitrate* pBitrate);
+    void saveSeekIndex(const QString& seekIndexFilePath) const;
+
+    OpenResult startDecoding();
+
     QFile m_file;
     quint64 m_fileSize;
     unsigned char* m_pFileData;
@@ -1,10 +1,14 @@
 #include "sources/soundsourceproxy.h"
 
 #include <QApplication>
+#include <QCryptographicHash>
 #include <QMimeDatabase>
 #include <QMimeType>
 #include <QRegularExpression>
 #include <QStandardPaths>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include "sources/audiosourcetrackproxy.h"
 
@@ -538,6 +542,48 @@ importTrackMetadataAndCoverImageUnavailable() {
     return std::make_pair(mixxx::MetadataSource::ImportResult::Unavailable, QDateTime());
 }
 
+// ~1.5 sec at 44.1 kHz
+constexpr SINT kAudioDigestFrameCount = 65536;
+
+// Hashes a window of decoded samples from the middle of the stream
+// instead of the file contents, i.e. the digest doesn't change when
+// editing the metadata tags of the file. The samples are quantized
+// to 16 bits to tolerate rounding differences between decoders.
+QString computeAudioDigest(const TrackPointer& pTrack) {
+    const auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource();
+    if (!pAudioSource) {
+        return QString();
+    }
+    const auto frameIndexRange = pAudioSource->frameIndexRange();
+    const SINT frameCount = std::min(frameIndexRange.length(), kAudioDigestFrameCount);
+    const auto digestFrameIndexRange = mixxx::IndexRange::forward(
+            frameIndexRange.start() + (frameIndexRange.length() - frameCount) / 2,
+            frameCount);
+    mixxx::SampleBuffer sampleBuffer(
+            pAudioSource->getSignalInfo().frames2samples(frameCount));
+    const auto readableSampleFrames = pAudioSource->readSampleFrames(
+            mixxx::WritableSampleFrames(
+                    digestFrameIndexRange,
+                    mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
+    pAudioSource->close();
+    if (readableSampleFrames.frameIndexRange().empty()) {
+        return QString();
+    }
+
+    std::vector<qint16> quantizedSamples(readableSampleFrames.readableLength());
+    for (SINT i = 0; i < readableSampleFrames.readableLength(); ++i) {
+        const CSAMPLE sample = std::clamp(
+                readableSampleFrames.readableData()[i], -1.0f, 1.0f);
+        quantizedSamples[i] = static_cast<qint16>(std::lround(sample * 32767));
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const qint64 frameLength = frameIndexRange.length();
+    hash.addData(reinterpret_cast<const char*>(&frameLength), sizeof(frameLength));
+    hash.addData(reinterpret_cast<const char*>(quantizedSamples.data()),
+            static_cast<int>(quantizedSamples.size() * sizeof(qint16)));
+    return QString::fromLatin1(hash.result().toHex());
+}
+
 } // anonymous namespace
 
 //static
@@ -552,26 +598,62 @@ SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
         // https://bugs.launchpad.net/mixxx/+bug/1875237
         return importTrackMetadataAndCoverImageUnavailable();
     }
-    TrackPointer pTrack;
-    // Lock the global track cache while accessing the file to ensure
-    // that no metadata is written. Since locking individual files
-    // is not possible the whole cache has to be locked.
     GlobalTrackCacheLocker locker;
-    pTrack = locker.lookupTrackByRef(TrackRef::fromFileInfo(trackFileAccess.info()));
+    TrackPointer pTrack =
+            locker.lookupTrackByRef(TrackRef::fromFileInfo(trackFileAccess.info()));
     if (pTrack) {
         // We can safely unlock the cache if the track object is already cached.
         locker.unlockCache();
-    } else {
-        // If the track object is not cached we need to keep the cache
-        // locked and create a temporary track object instead.
-        pTrack = Track::newTemporary(std::move(trackFileAccess));
+        return SoundSourceProxy(pTrack).importTrackMetadataAndCoverImage(
+                pTrackMetadata,
+                pCoverImage,
+                resetMissingTagMetadata);
     }
+    // If the track object is not cached we need to ensure that no metadata
+    // is written into the file while reading it. Only the file is locked
+    // and the cache is unlocked afterwards, so reading the file doesn't
+    // block other threads that access the cache.
+    const GlobalTrackCacheFileLocker fileLocker(
+            trackFileAccess.info().canonicalLocation());
+    locker.unlockCache();
+    pTrack = Track::newTemporary(std::move(trackFileAccess));
     return SoundSourceProxy(pTrack).importTrackMetadataAndCoverImage(
             pTrackMetadata,
             pCoverImage,
             resetMissingTagMetadata);
 }
 
+//static
+std::shared_ptr<const SoundSourceProxy::ImportedTrackMetadata>
+SoundSourceProxy::importNewTrackMetadataAndCoverImageFromFile(
+        mixxx::FileAccess trackFileAccess,
+        bool resetMissingTagMetadata) {
+    auto pImported = std::make_shared<ImportedTrackMetadata>();
+    pImported->resetMissingTagMetadata = resetMissingTagMetadata;
+    if (!trackFileAccess.info().checkFileExists()) {
+        return pImported;
+    }
+    {
+        // Only locked briefly for the lookup. Metadata is only written
+        // into files of cached tracks and the file of a new track is
+        // not expected to be exported while importing it.
+        GlobalTrackCacheLocker locker;
+        if (locker.lookupTrackByRef(TrackRef::fromFileInfo(trackFileAccess.info()))) {
+            return nullptr;
+        }
+    }
+    // The temporary track object provides the same default metadata
+    // that would be used when creating a new track object.
+    const auto pTrack = Track::newTemporary(std::move(trackFileAccess));
+    std::tie(pImported->importResult, pImported->sourceSynchronizedAt) =
+            SoundSourceProxy(pTrack).importTrackMetadataAndCoverImage(
+                    &pImported->trackMetadata,
+                    &pImported->coverImage,
+                    resetMissingTagMetadata);
+    pImported->audioDigest = computeAudioDigest(pTrack);
+    return pImported;
+}
+
 std::pair<mixxx::MetadataSource::ImportResult, QDateTime>
 SoundSourceProxy::importTrackMetadataAndCoverImage(
         mixxx::TrackMetadata* pTrackMetadata,
@@ -617,7 +699,8 @@ inline bool shouldImportSeratoTagsFromSource(
 
 SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromSource(
         UpdateTrackFromSourceMode mode,
-        const SyncTrackMetadataParams& syncParams) {
+        const SyncTrackMetadataParams& syncParams,
+        const ImportedTrackMetadata* pImportedTrackMetadata) {
     DEBUG_ASSERT(m_pTrack);
 
     if (getUrl().isEmpty()) {
@@ -668,6 +751,12 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
 
     const bool updateMetadataFromSource =
             shouldUpdateTrackMetadataFromSource(sourceSyncStatus, mode);
+    if (!updateMetadataFromSource &&
+            !mixxx::TrackRecord::mayMergeExtraMetadataFromSource(trackMetadata)) {
+        // Parsing the file tags would be in vain, because there is no
+        // extra metadata that could be merged.
+        return UpdateTrackFromSourceResult::NotUpdated;
+    }
 
     // Decide if cover art needs to be re-imported
     if (updateMetadataFromSource) {
@@ -689,11 +778,28 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
 
     // Parse the tags stored in the audio file and the date and time when the
     // file has been last modified to detect future changes of the tags.
-    auto [metadataImportResult, sourceSynchronizedAt] =
-            importTrackMetadataAndCoverImage(
-                    &trackMetadata,
-                    pCoverImg,
-                    syncParams.resetMissingTagMetadataOnImport);
+    // Metadata that has been imported in advance is based on the same default
+    // values as a new track object and could only be used for the initial
+    // import.
+    std::pair<mixxx::MetadataSource::ImportResult, QDateTime> importResult;
+    if (pImportedTrackMetadata &&
+            sourceSyncStatus == mixxx::TrackRecord::SourceSyncStatus::Void &&
+            pImportedTrackMetadata->resetMissingTagMetadata ==
+                    syncParams.resetMissingTagMetadataOnImport) {
+        trackMetadata = pImportedTrackMetadata->trackMetadata;
+        if (pCoverImg) {
+            *pCoverImg = pImportedTrackMetadata->coverImage;
+        }
+        importResult = std::make_pair(
+                pImportedTrackMetadata->importResult,
+                pImportedTrackMetadata->sourceSynchronizedAt);
+    } else {
+        importResult = importTrackMetadataAndCoverImage(
+                &trackMetadata,
+                pCoverImg,
+                syncParams.resetMissingTagMetadataOnImport);
+    }
+    auto [metadataImportResult, sourceSynchronizedAt] = importResult;
     VERIFY_OR_DEBUG_ASSERT(!sourceSynchronizedAt.isValid() ||
             sourceSynchronizedAt.timeSpec() == Qt::UTC) {
         qWarning() << "Converting source synchronization time to UTC:" << sourceSynchronizedAt;
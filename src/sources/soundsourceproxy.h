@@ -1,9 +1,14 @@
 #pragma once
 
+#include <QDateTime>
+#include <QImage>
+#include <QMetaType>
 #include <QMimeType>
+#include <memory>
 
 #include "sources/soundsourceproviderregistry.h"
 #include "track/track_decl.h"
+#include "track/trackmetadata.h"
 #include "util/sandbox.h"
 
 namespace mixxx {
@@ -105,6 +110,38 @@ class SoundSourceProxy {
             QImage* pCoverImage,
             bool resetMissingTagMetadata);
 
+    /// Track metadata and embedded cover image that have been imported
+    /// from a file in advance, i.e. before the track object has been
+    /// created.
+    struct ImportedTrackMetadata {
+        mixxx::MetadataSource::ImportResult importResult =
+                mixxx::MetadataSource::ImportResult::Unavailable;
+        QDateTime sourceSynchronizedAt;
+        mixxx::TrackMetadata trackMetadata;
+        QImage coverImage;
+        bool resetMissingTagMetadata = false;
+        /// Identifies the audio content independent of the location
+        /// and the metadata tags of the file for detecting moved files.
+        /// Empty if the audio stream could not be decoded.
+        QString audioDigest;
+    };
+
+    /// Import both track metadata and cover image from a file for
+    /// creating a new track object later, see updateTrackFromSource().
+    /// Also decodes a short part of the audio stream for calculating
+    /// the audio digest.
+    ///
+    /// This function is thread-safe and can be invoked from any thread.
+    /// In contrast to importTrackMetadataAndCoverImageFromFile() the
+    /// GlobalTrackCache is not locked while reading and multiple files
+    /// can be parsed concurrently. Returns nullptr if the file is
+    /// referenced by a cached track object that might be written
+    /// concurrently.
+    static std::shared_ptr<const ImportedTrackMetadata>
+    importNewTrackMetadataAndCoverImageFromFile(
+            mixxx::FileAccess trackFileAccess,
+            bool resetMissingTagMetadata);
+
     /// Import both track metadata and/or the cover image of the
     /// captured track object from the corresponding file.
     ///
@@ -172,10 +209,15 @@ class SoundSourceProxy {
     /// properly. The application log will contain warning messages for a detailed
     /// analysis in case unexpected behavior has been reported.
     ///
+    /// The metadata that has optionally been imported in advance will
+    /// only be used for the initial import of new track objects instead
+    /// of parsing the file again.
+    ///
     /// Returns true if the track has been modified and false otherwise.
     UpdateTrackFromSourceResult updateTrackFromSource(
             UpdateTrackFromSourceMode mode,
-            const SyncTrackMetadataParams& syncParams);
+            const SyncTrackMetadataParams& syncParams,
+            const ImportedTrackMetadata* pImportedTrackMetadata = nullptr);
 
     /// Opening the audio source through the proxy will update the
     /// audio properties of the corresponding track object. Returns
@@ -242,3 +284,8 @@ class SoundSourceProxy {
     // the corresponding track pointer. Don't pass it around!!
     mixxx::SoundSourcePointer m_pSoundSource;
 };
+
+typedef std::shared_ptr<const SoundSourceProxy::ImportedTrackMetadata>
+        ImportedTrackMetadataPointer;
+
+Q_DECLARE_METATYPE(ImportedTrackMetadataPointer);
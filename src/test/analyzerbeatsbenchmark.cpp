@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+
+#include <QCryptographicHash>
+#include <vector>
+
+#include "analyzer/constants.h"
+#include "analyzer/plugins/analyzerqueenmarybeats.h"
+#include "sources/audiosourcestereoproxy.h"
+#include "sources/soundsourceproxy.h"
+#include "test/mixxxtest.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track.h"
+#include "util/samplebuffer.h"
+
+// Benchmarks of the beat analysis of the reference tracks, which are
+// decoded once before measuring. The argument selects the track. Besides the
+// analyzed frames per second, the label shows a hash of the detected beats,
+// which must not change when optimizing the analysis:
+//   mixxx-test --benchmark --benchmark_filter=BM_AnalyzerQueenMaryBeats
+
+namespace {
+
+const QString kFilePaths[] = {
+        QStringLiteral("sine-30.wav"),
+        QStringLiteral("id3-test-data/cover-test.flac"),
+        QStringLiteral("id3-test-data/cover-test-vbr.mp3"),
+        QStringLiteral("id3-test-data/cover-test.ogg"),
+};
+
+constexpr int kFileCount = sizeof(kFilePaths) / sizeof(kFilePaths[0]);
+
+class DecodedTrack : private SoundSourceProviderRegistration {
+  public:
+    explicit DecodedTrack(const QString& filePath) {
+        auto pTrack = Track::newTemporary(
+                MixxxTest::getOrInitTestDir().filePath(filePath));
+        mixxx::AudioSource::OpenParams config;
+        config.setChannelCount(mixxx::kAnalysisChannels);
+        const auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(config);
+        if (!pAudioSource) {
+            return;
+        }
+        m_sampleRate = pAudioSource->getSignalInfo().getSampleRate();
+        const auto frameIndexRange = pAudioSource->frameIndexRange();
+        m_samples = mixxx::SampleBuffer(
+                frameIndexRange.length() * mixxx::kAnalysisChannels);
+        // The temporary buffer of the proxy only holds a single chunk
+        mixxx::SampleBuffer tempBuffer(pAudioSource->getSignalInfo().frames2samples(
+                mixxx::kAnalysisFramesPerChunk));
+        mixxx::AudioSourceStereoProxy audioSourceProxy(
+                pAudioSource,
+                mixxx::SampleBuffer::WritableSlice(tempBuffer));
+        while (m_frames < frameIndexRange.length()) {
+            const auto readFrameIndexRange = mixxx::IndexRange::forward(
+                    frameIndexRange.start() + m_frames,
+                    std::min(mixxx::kAnalysisFramesPerChunk,
+                            frameIndexRange.length() - m_frames));
+            const auto readableSampleFrames = audioSourceProxy.readSampleFrames(
+                    mixxx::WritableSampleFrames(
+                            readFrameIndexRange,
+                            mixxx::SampleBuffer::WritableSlice(
+                                    m_samples,
+                                    m_frames * mixxx::kAnalysisChannels,
+                                    readFrameIndexRange.length() *
+                                            mixxx::kAnalysisChannels)));
+            if (readableSampleFrames.frameIndexRange() != readFrameIndexRange) {
+                break;
+            }
+            m_frames += readFrameIndexRange.length();
+        }
+    }
+
+    bool isValid() const {
+        return m_frames > 0;
+    }
+
+    mixxx::audio::SampleRate sampleRate() const {
+        return m_sampleRate;
+    }
+
+    SINT frames() const {
+        return m_frames;
+    }
+
+    const CSAMPLE* samples() const {
+        return m_samples.data();
+    }
+
+  private:
+    mixxx::audio::SampleRate m_sampleRate;
+    mixxx::SampleBuffer m_samples;
+    SINT m_frames = 0;
+};
+
+QVector<mixxx::audio::FramePos> analyzeBeats(const DecodedTrack& track) {
+    mixxx::AnalyzerQueenMaryBeats analyzer;
+    analyzer.initialize(track.sampleRate());
+    // Like AnalyzerThread, in chunks of kAnalysisFramesPerChunk
+    for (SINT frame = 0; frame < track.frames();
+            frame += mixxx::kAnalysisFramesPerChunk) {
+        const SINT frames = std::min(mixxx::kAnalysisFramesPerChunk, track.frames() - frame);
+        analyzer.processSamples(track.samples() + frame * mixxx::kAnalysisChannels,
+                static_cast<int>(frames * mixxx::kAnalysisChannels));
+    }
+    analyzer.finalize();
+    return analyzer.getBeats();
+}
+
+QString beatsHash(const QVector<mixxx::audio::FramePos>& beats) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const auto& beat : beats) {
+        const double value = beat.value();
+        hash.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    return QString::fromLatin1(hash.result().toHex().left(12));
+}
+
+} // anonymous namespace
+
+// Reports the analyzed frames per second as items per second
+static void BM_AnalyzerQueenMaryBeats(benchmark::State& state) {
+    const QString& filePath = kFilePaths[state.range(0)];
+    const DecodedTrack track(filePath);
+    if (!track.isValid()) {
+        state.SkipWithError("Failed to decode file");
+        return;
+    }
+    QVector<mixxx::audio::FramePos> beats;
+    SINT analyzedFrames = 0;
+    while (state.KeepRunning()) {
+        beats = analyzeBeats(track);
+        analyzedFrames += track.frames();
+    }
+    state.SetItemsProcessed(analyzedFrames);
+    state.SetLabel((filePath + QStringLiteral(" beats %1 %2")
+                                       .arg(QString::number(beats.size()),
+                                               beatsHash(beats)))
+                           .toStdString());
+}
+BENCHMARK(BM_AnalyzerQueenMaryBeats)->DenseRange(0, kFileCount - 1);
@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <QDataStream>
 #include <vector>
 
 #include "engine/engine.h"
@@ -164,6 +165,48 @@ TEST_F(AnalyzerSilenceTest, ToneTrackWithSilenceInTheMiddle) {
     EXPECT_DOUBLE_EQ(4 * oneFifthOfTrackLength, pOutroCue->getLengthFrames() * kChannelCount);
 }
 
+TEST_F(AnalyzerSilenceTest, ResumeFromCheckpoint) {
+    double omega = 2.0 * M_PI * kTonePitchHz / pTrack->getSampleRate();
+    int oneFifthOfTrackLength = nTrackSampleDataLength / 5;
+
+    // Silence - tone - silence, the checkpoint is located within the tone
+    for (int i = 0; i < nTrackSampleDataLength; i++) {
+        if (i >= oneFifthOfTrackLength && i < 4 * oneFifthOfTrackLength) {
+            pTrackSampleData[i] = static_cast<CSAMPLE>(cos(i / kChannelCount * omega));
+        } else {
+            pTrackSampleData[i] = 0.0;
+        }
+    }
+    const int checkpointSamples = 2 * oneFifthOfTrackLength;
+
+    QByteArray checkpoint;
+    {
+        AnalyzerSilence interruptedAnalyzer(config());
+        ASSERT_TRUE(interruptedAnalyzer.initialize(
+                pTrack, pTrack->getSampleRate(), nTrackSampleDataLength));
+        interruptedAnalyzer.processSamples(pTrackSampleData.data(), checkpointSamples);
+        QDataStream stream(&checkpoint, QIODevice::WriteOnly);
+        ASSERT_TRUE(interruptedAnalyzer.saveCheckpoint(&stream));
+        interruptedAnalyzer.cleanup();
+    }
+
+    ASSERT_TRUE(analyzerSilence.initialize(
+            pTrack, pTrack->getSampleRate(), nTrackSampleDataLength));
+    QDataStream stream(checkpoint);
+    ASSERT_TRUE(analyzerSilence.restoreCheckpoint(&stream));
+    analyzerSilence.processSamples(
+            pTrackSampleData.data() + checkpointSamples,
+            nTrackSampleDataLength - checkpointSamples);
+    analyzerSilence.storeResults(pTrack);
+    analyzerSilence.cleanup();
+
+    CuePointer pIntroCue = pTrack->findCueByType(mixxx::CueType::Intro);
+    EXPECT_DOUBLE_EQ(oneFifthOfTrackLength, pIntroCue->getPosition().toEngineSamplePos());
+
+    CuePointer pOutroCue = pTrack->findCueByType(mixxx::CueType::Outro);
+    EXPECT_DOUBLE_EQ(4 * oneFifthOfTrackLength, pOutroCue->getLengthFrames() * kChannelCount);
+}
+
 TEST_F(AnalyzerSilenceTest, RespectUserEdits) {
     // Arbitrary values
     const auto kManualCuePosition = mixxx::audio::FramePos::fromEngineSamplePos(
@@ -32,10 +32,11 @@ class MockEffectProcessor : public EffectProcessor {
     MockEffectProcessor() {
     }
 
-    MOCK_METHOD3(initialize,
+    MOCK_METHOD4(initialize,
             void(const QSet<ChannelHandleAndGroup>& activeInputChannels,
                     const QSet<ChannelHandleAndGroup>& registeredOutputChannels,
-                    const mixxx::EngineParameters& engineParameters));
+                    const mixxx::EngineParameters& engineParameters,
+                    int oversamplingFactor));
     MOCK_METHOD1(createState, EffectState*(const mixxx::EngineParameters& engineParameters));
     MOCK_METHOD2(loadStatesForInputChannel,
             bool(const ChannelHandle* inputChannel,
@@ -450,6 +450,77 @@ TEST(BeatsTest, NonConstTempoFromBeatPositions) {
     EXPECT_EQ(kBpm * 2, pBeats->getLastMarkerBpm());
 }
 
+TEST(BeatsTest, NonConstTempoManyMarkersIteratorJumps) {
+    // Every beat has another length than the previous one, so each beat gets
+    // its own marker and iterators need to jump across many markers.
+    QVector<audio::FramePos> beatPositions;
+    auto position = kStartPosition;
+    for (int i = 0; i < 200; i++) {
+        beatPositions.append(position);
+        position += 20000 + (i % 2) * 100 + (i % 7) * 10;
+    }
+
+    auto pBeats = Beats::fromBeatPositions(kSampleRate, beatPositions);
+    ASSERT_NE(nullptr, pBeats);
+    ASSERT_LT(100, static_cast<int>(pBeats->getMarkers().size()));
+
+    const auto first = pBeats->cfirstmarker();
+    for (int i = 0; i < beatPositions.size(); i++) {
+        const auto it = first + i;
+        EXPECT_NEAR(beatPositions[i].value(), (*it).value(), kMaxBeatError);
+        EXPECT_EQ(i, it - first);
+        EXPECT_EQ(-i, first - it);
+        EXPECT_EQ(first, (first + i) - i);
+        EXPECT_NEAR(beatPositions[i].value(),
+                pBeats->findNextBeat(beatPositions[i] - 1.5).value(),
+                kMaxBeatError);
+        EXPECT_NEAR(beatPositions[i].value(),
+                pBeats->findPrevBeat(beatPositions[i] + 1.5).value(),
+                kMaxBeatError);
+    }
+
+    auto it = pBeats->clastmarker();
+    for (int i = beatPositions.size() - 1; i >= 0; i--) {
+        EXPECT_EQ(first + i, it);
+        --it;
+    }
+}
+
+TEST(BeatsTest, NonConstTempoTranslate) {
+    QVector<audio::FramePos> beatPositions;
+    QVector<audio::FramePos> translatedBeatPositions;
+    auto position = kStartPosition;
+    for (int i = 0; i < 50; i++) {
+        beatPositions.append(position);
+        translatedBeatPositions.append(position + 300);
+        position += 20000 + (i % 3) * 100;
+    }
+
+    auto pBeats = Beats::fromBeatPositions(kSampleRate, beatPositions);
+    ASSERT_NE(nullptr, pBeats);
+    auto pExpectedBeats = Beats::fromBeatPositions(kSampleRate, translatedBeatPositions);
+    ASSERT_NE(nullptr, pExpectedBeats);
+
+    // The fractional part of the offsets is discarded on each translation
+    auto pTranslatedBeats = pBeats->tryTranslate(1000.5);
+    ASSERT_TRUE(pTranslatedBeats);
+    pTranslatedBeats = (*pTranslatedBeats)->tryTranslate(-699.75);
+    ASSERT_TRUE(pTranslatedBeats);
+
+    EXPECT_EQ(*pExpectedBeats, **pTranslatedBeats);
+    EXPECT_EQ(pExpectedBeats->getMarkers(), (*pTranslatedBeats)->getMarkers());
+    EXPECT_EQ(pExpectedBeats->toByteArray(), (*pTranslatedBeats)->toByteArray());
+    for (const auto& beatPosition : std::as_const(translatedBeatPositions)) {
+        EXPECT_NEAR(beatPosition.value(),
+                (*pTranslatedBeats)->findNextBeat(beatPosition - 1.5).value(),
+                kMaxBeatError);
+    }
+    EXPECT_EQ(pExpectedBeats->getBpmInRange(translatedBeatPositions.front(),
+                      translatedBeatPositions.back()),
+            (*pTranslatedBeats)->getBpmInRange(translatedBeatPositions.front(),
+                    translatedBeatPositions.back()));
+}
+
 TEST(BeatsTest, ConstTempoFindNthBeatWhenOnBeat) {
     const auto it = kConstTempoBeats.cfirstmarker() + 10;
     const audio::FrameDiff_t beatLengthFrames = 60.0 * kSampleRate.value() / kBpm.value();
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "analyzer/plugins/buffering_utils.h"
+
+namespace {
+
+// Frames the mono downmix naively into windows, with the first frame in the
+// center of the first window
+std::vector<std::vector<double>> referenceWindows(const std::vector<CSAMPLE>& stereo,
+        size_t windowSize,
+        size_t stepSize) {
+    std::vector<double> mono(windowSize / 2, 0.0);
+    for (size_t i = 0; i < stereo.size() / 2; ++i) {
+        mono.push_back((stereo[i * 2] + stereo[i * 2 + 1]) * 0.5);
+    }
+    std::vector<std::vector<double>> windows;
+    for (size_t start = 0; start + windowSize <= mono.size(); start += stepSize) {
+        windows.emplace_back(mono.begin() + start, mono.begin() + start + windowSize);
+    }
+    return windows;
+}
+
+class DownmixAndOverlapHelperTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        m_input.resize(2 * 100000);
+        for (size_t i = 0; i < m_input.size(); ++i) {
+            m_input[i] = static_cast<CSAMPLE>((i * 7919) % 1000) / 1000.0f - 0.5f;
+        }
+    }
+
+    std::vector<std::vector<double>> process(
+            size_t windowSize, size_t stepSize, size_t chunkFrames) {
+        std::vector<std::vector<double>> windows;
+        mixxx::DownmixAndOverlapHelper helper;
+        EXPECT_TRUE(helper.initialize(windowSize,
+                stepSize,
+                [&windows](double* pWindow, size_t frames) {
+                    windows.emplace_back(pWindow, pWindow + frames);
+                    return true;
+                }));
+        for (size_t frame = 0; frame < m_input.size() / 2; frame += chunkFrames) {
+            const size_t frames = std::min(chunkFrames, m_input.size() / 2 - frame);
+            EXPECT_TRUE(helper.processStereoSamples(&m_input[frame * 2], frames * 2));
+        }
+        return windows;
+    }
+
+    std::vector<CSAMPLE> m_input;
+};
+
+TEST_F(DownmixAndOverlapHelperTest, WindowsMatchNaiveFraming) {
+    // Window and step sizes of the beat and key analyzers among others
+    const size_t sizes[][2] = {{2048, 512}, {1024, 1024}, {4096, 441}, {16, 3}};
+    const size_t chunkFrames[] = {1, 100, 4096, 100000};
+    for (const auto& size : sizes) {
+        const auto expected = referenceWindows(m_input, size[0], size[1]);
+        for (const auto chunk : chunkFrames) {
+            EXPECT_EQ(expected, process(size[0], size[1], chunk))
+                    << "window " << size[0] << " step " << size[1]
+                    << " chunk " << chunk;
+        }
+    }
+}
+
+TEST_F(DownmixAndOverlapHelperTest, RestoreBuffer) {
+    const size_t windowSize = 2048;
+    const size_t stepSize = 512;
+    const auto expected = referenceWindows(m_input, windowSize, stepSize);
+
+    std::vector<std::vector<double>> windows;
+    const auto callback = [&windows](double* pWindow, size_t frames) {
+        windows.emplace_back(pWindow, pWindow + frames);
+        return true;
+    };
+    const size_t splitFrame = 54321;
+    mixxx::DownmixAndOverlapHelper helper;
+    ASSERT_TRUE(helper.initialize(windowSize, stepSize, callback));
+    helper.processStereoSamples(m_input.data(), splitFrame * 2);
+
+    mixxx::DownmixAndOverlapHelper restoredHelper;
+    ASSERT_TRUE(restoredHelper.initialize(windowSize, stepSize, callback));
+    ASSERT_TRUE(restoredHelper.restoreBuffer(
+            helper.buffer(), helper.bufferWritePosition()));
+    restoredHelper.processStereoSamples(
+            &m_input[splitFrame * 2], m_input.size() - splitFrame * 2);
+    EXPECT_EQ(expected, windows);
+}
+
+} // anonymous namespace
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "engine/cachingreader/cachingreaderchunkindex.h"
+
+namespace {
+
+class CachingReaderChunkIndexTest : public testing::Test {
+  protected:
+    // The index only stores the pointers and never dereferences them
+    CachingReaderChunkForOwner* chunk(SINT i) {
+        return reinterpret_cast<CachingReaderChunkForOwner*>(&m_dummies[i]);
+    }
+
+    std::array<int, 256> m_dummies;
+};
+
+TEST_F(CachingReaderChunkIndexTest, insertFindRemove) {
+    CachingReaderChunkIndex index(80);
+    for (SINT i = 0; i < 80; ++i) {
+        EXPECT_TRUE(index.insert(i * 3, chunk(i)));
+    }
+    EXPECT_EQ(80, index.size());
+    for (SINT i = 0; i < 80; ++i) {
+        EXPECT_EQ(chunk(i), index.find(i * 3));
+        EXPECT_EQ(nullptr, index.find(i * 3 + 1));
+    }
+    // Remove every other entry and verify that all remaining
+    // entries can still be found after backward shifting.
+    for (SINT i = 0; i < 80; i += 2) {
+        EXPECT_EQ(1, index.remove(i * 3));
+        EXPECT_EQ(0, index.remove(i * 3));
+    }
+    EXPECT_EQ(40, index.size());
+    for (SINT i = 0; i < 80; ++i) {
+        if (i % 2 == 0) {
+            EXPECT_EQ(nullptr, index.find(i * 3));
+        } else {
+            EXPECT_EQ(chunk(i), index.find(i * 3));
+        }
+    }
+    index.clear();
+    EXPECT_EQ(0, index.size());
+    EXPECT_EQ(nullptr, index.find(3));
+}
+
+TEST_F(CachingReaderChunkIndexTest, replace) {
+    CachingReaderChunkIndex index(2);
+    EXPECT_TRUE(index.insert(7, chunk(0)));
+    EXPECT_TRUE(index.insert(7, chunk(1)));
+    EXPECT_EQ(1, index.size());
+    EXPECT_EQ(chunk(1), index.find(7));
+}
+
+TEST_F(CachingReaderChunkIndexTest, slidingWindow) {
+    // Simulates the typical access pattern while playing a track: the
+    // oldest chunk is replaced by the next one.
+    constexpr SINT kMaxSize = 16;
+    CachingReaderChunkIndex index(kMaxSize);
+    for (SINT i = 0; i < 1000; ++i) {
+        if (i >= kMaxSize) {
+            EXPECT_EQ(1, index.remove(i - kMaxSize));
+        }
+        EXPECT_TRUE(index.insert(i, chunk(i % kMaxSize)));
+        EXPECT_EQ(chunk(i % kMaxSize), index.find(i));
+    }
+    EXPECT_EQ(kMaxSize, index.size());
+    for (SINT i = 1000 - kMaxSize; i < 1000; ++i) {
+        EXPECT_EQ(chunk(i % kMaxSize), index.find(i));
+    }
+}
+
+} // namespace
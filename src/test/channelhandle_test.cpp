@@ -66,4 +66,29 @@ TEST(ChannelHandleTest, ChannelHandleMap) {
     EXPECT_QSTRING_EQ("foo", map.at(test));
 }
 
+TEST(ChannelHandleTest, ChannelHandleMatrix) {
+    ChannelHandleFactory factory;
+
+    ChannelHandle input = factory.getOrCreateHandle("[Test]");
+    ChannelHandle output = factory.getOrCreateHandle("[Test2]");
+
+    ChannelHandleMatrix<int> matrix;
+    EXPECT_EQ(0, matrix.at(input, output));
+    EXPECT_EQ(0, matrix.at(ChannelHandle(), output));
+
+    matrix(input, output) = 1;
+    EXPECT_EQ(1, matrix.at(input, output));
+    EXPECT_EQ(0, matrix.at(output, input));
+
+    int sum = 0;
+    for (int value : matrix.row(input)) {
+        sum += value;
+    }
+    EXPECT_EQ(1, sum);
+    for (int value : matrix.row(output)) {
+        EXPECT_EQ(0, value);
+    }
+    EXPECT_EQ(matrix.row(ChannelHandle()).begin(), matrix.row(ChannelHandle()).end());
+}
+
 }  // namespace
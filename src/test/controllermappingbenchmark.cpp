@@ -0,0 +1,421 @@
+#include <benchmark/benchmark.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QtDebug>
+#include <algorithm>
+#include <memory>
+
+#include "controllers/controller.h"
+#include "controllers/defs_controllers.h"
+#include "controllers/hid/legacyhidcontrollermapping.h"
+#include "controllers/legacycontrollermappingfilehandler.h"
+#include "controllers/midi/legacymidicontrollermapping.h"
+#include "controllers/midi/midicontroller.h"
+#include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
+#include "test/signalpathtest.h"
+#include "util/performancetimer.h"
+
+// Benchmarks of controller mappings, which replay an input stream against a
+// mapping as fast as possible. Every input message is followed by the event
+// processing of the controller thread, so the time includes the connection
+// callbacks and the output it causes. Besides the time per replay, each
+// benchmark reports the engine.getValue() and engine.setValue() calls, the
+// output messages and bytes and the pause of an explicit garbage collection
+// per replay. The callbacks that took the most time are logged afterwards.
+//
+// All bundled MIDI mappings are benchmarked with a synthetic input stream
+// that sweeps the values of all their input mappings:
+//   mixxx-test --benchmark --benchmark_filter=BM_ControllerMapping
+//
+// The input recorded from a real MIDI or HID controller is replayed with
+//   MIXXX_BENCHMARK_CONTROLLER_MAPPING=res/controllers/<mapping>.xml
+//   MIXXX_BENCHMARK_CONTROLLER_RECORDING=<recording>.txt
+// A recording has one message per line with its timestamp in milliseconds
+// and its bytes in hex, e.g. "1234.5 b0 21 41". Lines starting with # are
+// ignored. The timestamps are passed to the mapping, but not waited for,
+// so timers of the mapping don't fire.
+
+namespace {
+
+constexpr int kIterations = 5;
+constexpr int kReportedCallbacks = 10;
+
+// Values of a knob turned in both directions, a jog wheel moving slowly
+// forward and backward, and a button pressed and released
+constexpr unsigned char kSweepValues[] = {0x00, 0x01, 0x20, 0x3F, 0x40, 0x41, 0x60, 0x7F};
+
+struct RecordedMessage {
+    mixxx::Duration timestamp;
+    QByteArray data;
+};
+
+struct OutputCounter {
+    qint64 messages = 0;
+    qint64 bytes = 0;
+};
+
+QList<RecordedMessage> readRecording(const QString& filePath) {
+    QList<RecordedMessage> messages;
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "Failed to open the controller input recording" << filePath;
+        return messages;
+    }
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#'))) {
+            continue;
+        }
+        const QStringList fields = line.split(QLatin1Char(' '),
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+                Qt::SkipEmptyParts);
+#else
+                QString::SkipEmptyParts);
+#endif
+        bool ok = fields.size() > 1;
+        RecordedMessage message;
+        if (ok) {
+            message.timestamp = mixxx::Duration::fromMicros(
+                    static_cast<qint64>(fields.first().toDouble(&ok) * 1000));
+        }
+        for (int i = 1; ok && i < fields.size(); ++i) {
+            message.data.append(static_cast<char>(fields[i].toUInt(&ok, 16)));
+        }
+        if (!ok) {
+            qWarning() << "Ignoring the invalid recorded message" << line;
+            continue;
+        }
+        messages.append(message);
+    }
+    return messages;
+}
+
+// Covers all handlers of a MIDI mapping, but not the order how they are used
+// by a DJ, for which there is no replacement for a recording
+QList<RecordedMessage> synthesizeInput(const LegacyMidiControllerMapping& mapping) {
+    QList<uint16_t> keys = mapping.getInputMappings().uniqueKeys();
+    std::sort(keys.begin(), keys.end());
+    QList<RecordedMessage> messages;
+    qint64 timestampMillis = 0;
+    for (const uint16_t key : keys) {
+        const MidiKey midiKey = mapping.getInputMappings().value(key).key;
+        // SysEx and system realtime messages are not mapped by their key
+        if (midiKey.status >= 0xF0) {
+            continue;
+        }
+        for (const unsigned char value : kSweepValues) {
+            RecordedMessage message;
+            message.timestamp = mixxx::Duration::fromMillis(++timestampMillis);
+            message.data.append(static_cast<char>(midiKey.status));
+            message.data.append(static_cast<char>(midiKey.control));
+            message.data.append(static_cast<char>(value));
+            messages.append(message);
+        }
+    }
+    return messages;
+}
+
+class BenchmarkMidiController : public MidiController {
+  public:
+    explicit BenchmarkMidiController(OutputCounter* pOutputCounter)
+            : MidiController(QStringLiteral("Benchmark Controller")),
+              m_pOutputCounter(pOutputCounter) {
+        setInputDevice(true);
+        setOutputDevice(true);
+        startEngine();
+        getScriptEngine()->setTesting(true);
+    }
+
+    bool isPolling() const override {
+        return false;
+    }
+
+  protected:
+    void sendShortMsg(unsigned char status,
+            unsigned char byte1,
+            unsigned char byte2) override {
+        Q_UNUSED(status);
+        Q_UNUSED(byte1);
+        Q_UNUSED(byte2);
+        m_pOutputCounter->messages++;
+        m_pOutputCounter->bytes += 3;
+    }
+
+    void sendBytes(const QByteArray& data) override {
+        m_pOutputCounter->messages++;
+        m_pOutputCounter->bytes += data.size();
+    }
+
+  private slots:
+    int open() override {
+        return 0;
+    }
+
+  private:
+    OutputCounter* const m_pOutputCounter;
+};
+
+// Passes the input reports to the incomingData function of the mapping like
+// HidController, without a device
+class BenchmarkHidController : public Controller {
+  public:
+    explicit BenchmarkHidController(OutputCounter* pOutputCounter)
+            : Controller(QStringLiteral("Benchmark Controller")),
+              m_pOutputCounter(pOutputCounter) {
+        setInputDevice(true);
+        setOutputDevice(true);
+        startEngine();
+        getScriptEngine()->setTesting(true);
+    }
+
+    QString mappingExtension() override {
+        return HID_MAPPING_EXTENSION;
+    }
+
+    void setMapping(std::shared_ptr<LegacyControllerMapping> pMapping) override {
+        m_pMapping = downcastAndTakeOwnership<LegacyHidControllerMapping>(std::move(pMapping));
+    }
+
+    std::shared_ptr<LegacyControllerMapping> cloneMapping() override {
+        if (!m_pMapping) {
+            return nullptr;
+        }
+        return m_pMapping->clone();
+    }
+
+    bool isMappable() const override {
+        return m_pMapping && m_pMapping->isMappable();
+    }
+
+    bool matchMapping(const MappingInfo& mapping) override {
+        Q_UNUSED(mapping);
+        return false;
+    }
+
+  protected:
+    void sendBytes(const QByteArray& data) override {
+        m_pOutputCounter->messages++;
+        m_pOutputCounter->bytes += data.size();
+    }
+
+  private slots:
+    int open() override {
+        return 0;
+    }
+
+    int close() override {
+        return 0;
+    }
+
+  private:
+    OutputCounter* const m_pOutputCounter;
+    std::shared_ptr<LegacyHidControllerMapping> m_pMapping;
+};
+
+} // anonymous namespace
+
+// Not in the anonymous namespace, because it is a friend of the controllers
+class ControllerMappingBenchmark : public BaseSignalPathTest {
+  public:
+    ~ControllerMappingBenchmark() override {
+        if (m_pController) {
+            m_pController->stopEngine();
+        }
+    }
+
+    // Applies the mapping and synthesizes input for it if recording is empty
+    bool loadMapping(const QString& filePath, QList<RecordedMessage>* pRecording) {
+        std::shared_ptr<LegacyControllerMapping> pMapping =
+                LegacyControllerMappingFileHandler::loadMapping(
+                        QFileInfo(filePath), QDir(QStringLiteral("res/controllers")));
+        if (!pMapping) {
+            return false;
+        }
+        auto pMidiMapping = std::dynamic_pointer_cast<LegacyMidiControllerMapping>(pMapping);
+        if (pMidiMapping) {
+            if (pRecording->isEmpty()) {
+                *pRecording = synthesizeInput(*pMidiMapping);
+            }
+            pMidiMapping.reset();
+            auto pMidiController = std::make_unique<BenchmarkMidiController>(&m_outputCounter);
+            m_pMidiController = pMidiController.get();
+            m_pController = std::move(pMidiController);
+        } else {
+            m_pController = std::make_unique<BenchmarkHidController>(&m_outputCounter);
+        }
+        m_pController->setMapping(std::move(pMapping));
+        const bool success = m_pController->applyMapping();
+        processEvents();
+        return success;
+    }
+
+    void replay(const QList<RecordedMessage>& recording) {
+        for (const auto& message : recording) {
+            const QByteArray& data = message.data;
+            if (m_pMidiController &&
+                    data.size() <= 3 &&
+                    static_cast<unsigned char>(data.at(0)) != 0xF0) {
+                m_pMidiController->receivedShortMessage(
+                        static_cast<unsigned char>(data.at(0)),
+                        data.size() > 1 ? static_cast<unsigned char>(data.at(1)) : 0,
+                        data.size() > 2 ? static_cast<unsigned char>(data.at(2)) : 0,
+                        message.timestamp);
+            } else {
+                m_pController->receive(data, message.timestamp);
+            }
+            processEvents();
+        }
+    }
+
+    mixxx::Duration collectGarbage() {
+        PerformanceTimer timer;
+        timer.start();
+        m_pController->getScriptEngine()->collectGarbage();
+        return timer.elapsed();
+    }
+
+    ControllerScriptProfiler* scriptProfiler() {
+        return m_pController->scriptProfiler();
+    }
+
+    const OutputCounter& outputCounter() const {
+        return m_outputCounter;
+    }
+
+    void resetCounters() {
+        scriptProfiler()->reset();
+        m_outputCounter = OutputCounter();
+    }
+
+    // Only used for the fixture
+    void TestBody() override {
+    }
+
+  private:
+    void processEvents() {
+        application()->processEvents();
+        application()->processEvents();
+    }
+
+    OutputCounter m_outputCounter;
+    std::unique_ptr<Controller> m_pController;
+    // m_pController if it is a MIDI controller
+    BenchmarkMidiController* m_pMidiController = nullptr;
+};
+
+namespace {
+
+void logSlowestCallbacks(const QString& mapping, const ControllerScriptProfiler& profiler) {
+    QList<ControllerScriptProfiler::SlowCallback> callbacks = profiler.slowCallbacks();
+    std::sort(callbacks.begin(),
+            callbacks.end(),
+            [](const auto& lhs, const auto& rhs) {
+                return lhs.totalDuration > rhs.totalDuration;
+            });
+    qInfo().noquote() << "Script callbacks of" << mapping << "with the most time:";
+    for (int i = 0; i < callbacks.size() && i < kReportedCallbacks; ++i) {
+        const auto& callback = callbacks[i];
+        qInfo().noquote()
+                << ControllerScriptProfiler::callbackTypeName(callback.type)
+                << callback.name << "calls" << callback.count << "total"
+                << callback.totalDuration.formatMicrosWithUnit() << "max"
+                << callback.maxDuration.formatMicrosWithUnit();
+    }
+}
+
+void runMapping(benchmark::State& state,
+        const QString& mappingPath,
+        const QString& recordingPath) {
+    ControllerMappingBenchmark fixture;
+    QList<RecordedMessage> recording;
+    if (!recordingPath.isEmpty()) {
+        recording = readRecording(recordingPath);
+        if (recording.isEmpty()) {
+            state.SkipWithError("The recording has no input");
+            return;
+        }
+    }
+    if (!fixture.loadMapping(mappingPath, &recording)) {
+        state.SkipWithError("The mapping could not be applied");
+        return;
+    }
+    if (recording.isEmpty()) {
+        state.SkipWithError("The mapping has no input mappings");
+        return;
+    }
+
+    // Compiles the handlers and lets the mapping catch up with the controls
+    fixture.replay(recording);
+    fixture.collectGarbage();
+    fixture.resetCounters();
+    fixture.scriptProfiler()->setRecordingAllCallbacks(true);
+
+    mixxx::Duration garbageCollection;
+    for (auto _ : state) {
+        fixture.replay(recording);
+        state.PauseTiming();
+        garbageCollection += fixture.collectGarbage();
+        state.ResumeTiming();
+    }
+    fixture.scriptProfiler()->setRecordingAllCallbacks(false);
+
+    state.SetItemsProcessed(state.iterations() * recording.size());
+    state.counters["getValue"] = benchmark::Counter(
+            static_cast<double>(fixture.scriptProfiler()->getValueCount()),
+            benchmark::Counter::kAvgIterations);
+    state.counters["setValue"] = benchmark::Counter(
+            static_cast<double>(fixture.scriptProfiler()->setValueCount()),
+            benchmark::Counter::kAvgIterations);
+    state.counters["outputs"] = benchmark::Counter(
+            static_cast<double>(fixture.outputCounter().messages),
+            benchmark::Counter::kAvgIterations);
+    state.counters["output_bytes"] = benchmark::Counter(
+            static_cast<double>(fixture.outputCounter().bytes),
+            benchmark::Counter::kAvgIterations);
+    state.counters["gc_ms"] = benchmark::Counter(
+            garbageCollection.toDoubleMillis(),
+            benchmark::Counter::kAvgIterations);
+    logSlowestCallbacks(QFileInfo(mappingPath).fileName(), *fixture.scriptProfiler());
+}
+
+void registerMappingBenchmarks() {
+    const QString mappingPath = qEnvironmentVariable("MIXXX_BENCHMARK_CONTROLLER_MAPPING");
+    const QString recordingPath = qEnvironmentVariable("MIXXX_BENCHMARK_CONTROLLER_RECORDING");
+    if (!mappingPath.isEmpty() && !recordingPath.isEmpty()) {
+        benchmark::RegisterBenchmark("BM_ControllerMapping_Recording",
+                [mappingPath, recordingPath](benchmark::State& state) {
+                    runMapping(state, mappingPath, recordingPath);
+                })
+                ->Iterations(kIterations)
+                ->Unit(benchmark::kMillisecond);
+    }
+
+    const QDir mappingDir(QStringLiteral("res/controllers"));
+    const QStringList mappings = mappingDir.entryList(
+            {QStringLiteral("*") + MIDI_MAPPING_EXTENSION}, QDir::Files, QDir::Name);
+    for (const auto& mapping : mappings) {
+        const QString name = QStringLiteral("BM_ControllerMapping/") +
+                mapping.left(mapping.size() - QStringLiteral(MIDI_MAPPING_EXTENSION).size());
+        const QString path = mappingDir.filePath(mapping);
+        benchmark::RegisterBenchmark(name.toStdString().c_str(),
+                [path](benchmark::State& state) {
+                    runMapping(state, path, QString());
+                })
+                ->Iterations(kIterations)
+                ->Unit(benchmark::kMillisecond);
+    }
+}
+
+// The mappings are found relative to the working directory like in
+// LegacyControllerMappingValidationTest
+struct MappingBenchmarkRegistration {
+    MappingBenchmarkRegistration() {
+        registerMappingBenchmarks();
+    }
+} s_mappingBenchmarkRegistration;
+
+} // anonymous namespace
@@ -0,0 +1,86 @@
+#include "controllers/controllermappinginfoenumerator.h"
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "controllers/defs_controllers.h"
+
+namespace {
+
+class MappingInfoEnumeratorTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+        m_mappingDir = QDir(m_tempDir.filePath(QStringLiteral("controllers")));
+        ASSERT_TRUE(QDir().mkpath(m_mappingDir.absolutePath()));
+        m_indexFilePath = m_tempDir.filePath(QStringLiteral("mappings.cache"));
+    }
+
+    void writeMapping(const QString& fileName, const QString& name) {
+        QFile file(m_mappingDir.filePath(fileName));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(QStringLiteral(
+                "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+                "<MixxxControllerPreset schemaVersion=\"1\">\n"
+                "  <info>\n"
+                "    <name>%1</name>\n"
+                "    <author>Test</author>\n"
+                "    <devices>\n"
+                "      <product protocol=\"hid\" vendor_id=\"0x1\" product_id=\"0x2\"/>\n"
+                "    </devices>\n"
+                "  </info>\n"
+                "</MixxxControllerPreset>\n")
+                           .arg(name)
+                           .toUtf8());
+    }
+
+    QList<MappingInfo> enumerateHidMappings() {
+        MappingInfoEnumerator enumerator(m_mappingDir.absolutePath(), m_indexFilePath);
+        return enumerator.getMappingsByExtension(HID_MAPPING_EXTENSION);
+    }
+
+    QTemporaryDir m_tempDir;
+    QDir m_mappingDir;
+    QString m_indexFilePath;
+};
+
+TEST_F(MappingInfoEnumeratorTest, IndexedMappingsMatchParsedMappings) {
+    writeMapping(QStringLiteral("A.hid.xml"), QStringLiteral("Controller A"));
+    writeMapping(QStringLiteral("B.hid.xml"), QStringLiteral("Controller B"));
+
+    const QList<MappingInfo> parsed = enumerateHidMappings();
+    ASSERT_TRUE(QFile::exists(m_indexFilePath));
+    const QList<MappingInfo> indexed = enumerateHidMappings();
+
+    ASSERT_EQ(2, parsed.size());
+    ASSERT_EQ(parsed.size(), indexed.size());
+    for (int i = 0; i < parsed.size(); ++i) {
+        EXPECT_TRUE(indexed[i].isValid());
+        EXPECT_EQ(parsed[i].getPath(), indexed[i].getPath());
+        EXPECT_EQ(parsed[i].getDirPath(), indexed[i].getDirPath());
+        EXPECT_EQ(parsed[i].getName(), indexed[i].getName());
+        EXPECT_EQ(parsed[i].getAuthor(), indexed[i].getAuthor());
+        ASSERT_EQ(1, indexed[i].getProducts().size());
+        EXPECT_EQ(QStringLiteral("0x1"), indexed[i].getProducts().first().vendor_id);
+        EXPECT_EQ(QStringLiteral("0x2"), indexed[i].getProducts().first().product_id);
+    }
+}
+
+TEST_F(MappingInfoEnumeratorTest, ChangedAndDeletedMappingsAreUpdated) {
+    writeMapping(QStringLiteral("A.hid.xml"), QStringLiteral("Controller A"));
+    writeMapping(QStringLiteral("B.hid.xml"), QStringLiteral("Controller B"));
+    ASSERT_EQ(2, enumerateHidMappings().size());
+
+    // The size differs even if the modification time does not
+    writeMapping(QStringLiteral("A.hid.xml"), QStringLiteral("Renamed Controller A"));
+    ASSERT_TRUE(m_mappingDir.remove(QStringLiteral("B.hid.xml")));
+
+    const QList<MappingInfo> mappings = enumerateHidMappings();
+    ASSERT_EQ(1, mappings.size());
+    EXPECT_EQ(QStringLiteral("Renamed Controller A"), mappings.first().getName());
+}
+
+} // namespace
@@ -0,0 +1,70 @@
+#include "controllers/rendering/controllerscreenrenderer.h"
+
+#include <gtest/gtest.h>
+
+#include <QtEndian>
+
+namespace {
+
+class ControllerScreenRendererTest : public testing::Test {
+  protected:
+    ControllerScreenRendererTest() {
+        m_screen.identifier = QStringLiteral("test");
+        m_screen.size = QSize(40, 20);
+        m_screen.tileSize = 16;
+        m_screen.tileHeader = QByteArray::fromHex("aa55");
+        m_frame = QImage(m_screen.size, QImage::Format_RGB16);
+        m_frame.fill(Qt::black);
+    }
+
+    QList<QByteArray> sendChangedTiles(const QImage& previousFrame) {
+        QList<QByteArray> packets;
+        ControllerScreenRenderer::sendChangedTiles(m_screen,
+                previousFrame,
+                m_frame,
+                [&packets](const QByteArray& packet) {
+                    packets.append(packet);
+                });
+        return packets;
+    }
+
+    quint16 areaValue(const QByteArray& packet, int index) const {
+        const char* pValue = packet.constData() + m_screen.tileHeader.size() + index * 2;
+        return m_screen.bigEndian ? qFromBigEndian<quint16>(pValue)
+                                  : qFromLittleEndian<quint16>(pValue);
+    }
+
+    ControllerScreen m_screen;
+    QImage m_frame;
+};
+
+TEST_F(ControllerScreenRendererTest, FirstFrameIsSentCompletely) {
+    const QList<QByteArray> packets = sendChangedTiles(QImage());
+    // One run of tiles per tile row
+    ASSERT_EQ(2, packets.size());
+    EXPECT_TRUE(packets[0].startsWith(m_screen.tileHeader));
+    EXPECT_EQ(0, areaValue(packets[0], 1));
+    EXPECT_EQ(40, areaValue(packets[0], 2));
+    EXPECT_EQ(16, areaValue(packets[0], 3));
+    EXPECT_EQ(16, areaValue(packets[1], 1));
+    EXPECT_EQ(4, areaValue(packets[1], 3));
+    EXPECT_EQ(m_screen.tileHeader.size() + 8 + 40 * 4 * 2, packets[1].size());
+}
+
+TEST_F(ControllerScreenRendererTest, OnlyChangedTilesAreSent) {
+    const QImage previousFrame = m_frame.copy();
+    EXPECT_TRUE(sendChangedTiles(previousFrame).isEmpty());
+
+    reinterpret_cast<quint16*>(m_frame.scanLine(5))[20] = 0xF800;
+    m_screen.bigEndian = true;
+    const QList<QByteArray> packets = sendChangedTiles(previousFrame);
+    ASSERT_EQ(1, packets.size());
+    EXPECT_EQ(16, areaValue(packets[0], 0));
+    EXPECT_EQ(0, areaValue(packets[0], 1));
+    EXPECT_EQ(16, areaValue(packets[0], 2));
+    EXPECT_EQ(16, areaValue(packets[0], 3));
+    // The changed pixel at row 5, column 4 of the tile
+    EXPECT_EQ(0xF800, areaValue(packets[0], 4 + 5 * 16 + 4));
+}
+
+} // anonymous namespace
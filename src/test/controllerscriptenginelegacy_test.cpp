@@ -247,6 +247,44 @@ TEST_F(ControllerScriptEngineLegacyTest, reset) {
     EXPECT_DOUBLE_EQ(0.0, co->get());
 }
 
+TEST_F(ControllerScriptEngineLegacyTest, getControl) {
+    auto co = std::make_unique<ControlPotmeter>(ConfigKey("[Test]", "co"),
+            -10.0,
+            10.0);
+    EXPECT_TRUE(evaluateAndAssert(
+            "var control = engine.getControl('[Test]', 'co');"
+            "control.set(control.get() + 2.0);"));
+    EXPECT_DOUBLE_EQ(2.0, co->get());
+    EXPECT_TRUE(evaluateAndAssert("control.setParameter(1.0);"));
+    EXPECT_DOUBLE_EQ(10.0, co->get());
+    EXPECT_DOUBLE_EQ(1.0, evaluate("control.getParameter();").toNumber());
+    EXPECT_TRUE(evaluateAndAssert("control.set(NaN);"));
+    EXPECT_DOUBLE_EQ(10.0, co->get());
+    EXPECT_TRUE(evaluateAndAssert("control.reset();"));
+    EXPECT_DOUBLE_EQ(0.0, co->get());
+    EXPECT_EQ(QStringLiteral("[Test]"), evaluate("control.group;").toString());
+    EXPECT_EQ(QStringLiteral("co"), evaluate("control.name;").toString());
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, getControl_InvalidControl) {
+    EXPECT_TRUE(evaluate("engine.getControl('[Nothing]', 'nothing');").isUndefined());
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, setValues) {
+    auto co1 = std::make_unique<ControlObject>(ConfigKey("[Test]", "co1"));
+    auto co2 = std::make_unique<ControlObject>(ConfigKey("[Test]", "co2"));
+    EXPECT_TRUE(evaluateAndAssert(
+            "engine.setValues(["
+            "    engine.getControl('[Test]', 'co1'),"
+            "    engine.getControl('[Test]', 'co2')], [1.0, 2.0]);"));
+    EXPECT_DOUBLE_EQ(1.0, co1->get());
+    EXPECT_DOUBLE_EQ(2.0, co2->get());
+    // Mismatching lengths are rejected
+    EXPECT_FALSE(evaluateAndAssert(
+            "engine.setValues([engine.getControl('[Test]', 'co1')], []);"));
+    EXPECT_DOUBLE_EQ(1.0, co1->get());
+}
+
 TEST_F(ControllerScriptEngineLegacyTest, log) {
     EXPECT_TRUE(evaluateAndAssert("engine.log('Test that logging works.');"));
 }
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include <QtDebug>
+#include <thread>
 
 #include "control/controlobject.h"
+#include "control/controlproxy.h"
 #include "util/memory.h"
 #include "test/mixxxtest.h"
 
@@ -85,4 +87,29 @@ TEST_F(ControlObjectTest, Persistence_ValidValue) {
     EXPECT_DOUBLE_EQ(5.0, co.get());
 }
 
+TEST_F(ControlObjectTest, CoalescedValueChanges) {
+    ControlProxy proxy(ck1);
+    QVector<double> values;
+    proxy.connectValueChanged(&proxy, [&values](double value) {
+        values.append(value);
+    });
+
+    // Changes from the main thread are delivered immediately
+    co1->set(1.0);
+    EXPECT_EQ(QVector<double>{1.0}, values);
+
+    // Changes from other threads are coalesced
+    std::thread([this] {
+        co1->set(2.0);
+        co1->set(3.0);
+    }).join();
+    EXPECT_EQ(QVector<double>{1.0}, values);
+    ControlDoublePrivate::dispatchCoalescedValueChanges();
+    EXPECT_EQ((QVector<double>{1.0, 3.0}), values);
+
+    // Nothing has changed since the last dispatch
+    ControlDoublePrivate::dispatchCoalescedValueChanges();
+    EXPECT_EQ((QVector<double>{1.0, 3.0}), values);
+}
+
 } // namespace
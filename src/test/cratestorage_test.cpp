@@ -1,5 +1,7 @@
 #include "library/trackset/crate/cratestorage.h"
 
+#include <QSqlQuery>
+
 #include "test/librarytest.h"
 
 class CrateStorageTest : public LibraryTest {
@@ -64,3 +66,52 @@ TEST_F(CrateStorageTest, persistentLifecycle) {
     EXPECT_FALSE(m_crateStorage.readCrateByName(kNewCrateName));
     EXPECT_EQ(kNumCrates - 1, m_crateStorage.countCrates());
 }
+
+TEST_F(CrateStorageTest, summaryFollowsTracks) {
+    QList<TrackId> trackIds;
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.prepare(QStringLiteral(
+            "INSERT INTO library (duration, mixxx_deleted) "
+            "VALUES (:duration, 0)")));
+    for (int i = 1; i <= 3; ++i) {
+        query.bindValue(":duration", 60.0 * i);
+        ASSERT_TRUE(query.exec());
+        trackIds.append(TrackId(query.lastInsertId()));
+    }
+
+    CrateId crateId;
+    {
+        Crate crate;
+        crate.setName(QStringLiteral("Crate"));
+        ASSERT_TRUE(m_crateStorage.onInsertingCrate(crate, &crateId));
+    }
+    ASSERT_TRUE(m_crateStorage.onAddingCrateTracks(crateId, trackIds));
+    {
+        CrateSummary crateSummary;
+        ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &crateSummary));
+        EXPECT_EQ(3u, crateSummary.getTrackCount());
+        EXPECT_EQ(360.0, crateSummary.getTrackDuration());
+    }
+
+    // Hiding a track and changing the duration of another one
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "UPDATE library SET mixxx_deleted=1 WHERE id=%1")
+                                   .arg(trackIds[2].toString())));
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "UPDATE library SET duration=30 WHERE id=%1")
+                                   .arg(trackIds[0].toString())));
+    {
+        CrateSummary crateSummary;
+        ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &crateSummary));
+        EXPECT_EQ(2u, crateSummary.getTrackCount());
+        EXPECT_EQ(150.0, crateSummary.getTrackDuration());
+    }
+
+    ASSERT_TRUE(m_crateStorage.onRemovingCrateTracks(crateId, trackIds.mid(0, 2)));
+    {
+        CrateSummary crateSummary;
+        ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &crateSummary));
+        EXPECT_EQ(0u, crateSummary.getTrackCount());
+        EXPECT_EQ(0.0, crateSummary.getTrackDuration());
+    }
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <QSqlQuery>
+
+#include "database/schemamanager.h"
 #include "library/dao/settingsdao.h"
 #include "test/mixxxdbtest.h"
 #include "util/db/dbconnectionpooler.h"
@@ -20,3 +23,37 @@ TEST_F(DbConnectionPoolTest, MoveSemantics) {
     EXPECT_TRUE(p1.isPooling());
     EXPECT_FALSE(p2.isPooling());
 }
+
+class DbConnectionProfileTest : public MixxxDbTest {};
+
+TEST_F(DbConnectionProfileTest, OpenStatements) {
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec("PRAGMA journal_mode"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QStringLiteral("wal"), query.value(0).toString().toLower());
+
+    ASSERT_TRUE(query.exec("PRAGMA synchronous"));
+    ASSERT_TRUE(query.next());
+    // NORMAL
+    EXPECT_EQ(1, query.value(0).toInt());
+
+    ASSERT_TRUE(query.exec("PRAGMA cache_size"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(-16384, query.value(0).toInt());
+}
+
+TEST_F(DbConnectionProfileTest, LibraryIndices) {
+    SchemaManager schemaManager(dbConnection());
+    ASSERT_EQ(SchemaManager::Result::UpgradeSucceeded,
+            schemaManager.upgradeToSchemaVersion(
+                    MixxxDb::kRequiredSchemaVersion, MixxxDb::kDefaultSchemaFile));
+
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(
+            "EXPLAIN QUERY PLAN SELECT id FROM library WHERE location=1"));
+    QString plan;
+    while (query.next()) {
+        plan += query.value(3).toString();
+    }
+    EXPECT_TRUE(plan.contains(QStringLiteral("idx_library_location"))) << plan;
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <deque>
+#include <vector>
+
+#include "soundio/driftresampler.h"
+
+namespace {
+
+constexpr int kChannelCount = 2;
+constexpr SINT kFramesPerBuffer = 256;
+
+CSAMPLE sine(SINT frame) {
+    return static_cast<CSAMPLE>(0.5 * std::sin(2 * M_PI * 0.01 * frame));
+}
+
+TEST(DriftResamplerTest, unityRatioIsTransparent) {
+    DriftResampler resampler(kChannelCount, 2 * kFramesPerBuffer);
+    std::vector<CSAMPLE> input;
+    std::vector<CSAMPLE> output(kFramesPerBuffer * kChannelCount);
+    SINT inputFrame = 0;
+    SINT outputFrame = 0;
+    for (int buffer = 0; buffer < 20; ++buffer) {
+        const SINT requiredFrames = resampler.inputFramesRequired(kFramesPerBuffer);
+        input.resize(requiredFrames * kChannelCount);
+        for (SINT frame = 0; frame < requiredFrames; ++frame) {
+            input[frame * kChannelCount] = sine(inputFrame);
+            input[frame * kChannelCount + 1] = -sine(inputFrame);
+            ++inputFrame;
+        }
+        resampler.pushInput(input.data(), requiredFrames);
+        ASSERT_EQ(kFramesPerBuffer, resampler.process(output.data(), kFramesPerBuffer));
+        for (SINT frame = 0; frame < kFramesPerBuffer; ++frame) {
+            EXPECT_NEAR(sine(outputFrame), output[frame * kChannelCount], 1e-5);
+            EXPECT_NEAR(-sine(outputFrame), output[frame * kChannelCount + 1], 1e-5);
+            ++outputFrame;
+        }
+    }
+}
+
+TEST(DriftResamplerTest, locksToDrift) {
+    // The sound device consumes 300 ppm faster than the engine produces.
+    // Callbacks are simulated in units of the engine buffer duration.
+    constexpr double kDrift = 3e-4;
+    constexpr int kChunkSize = kFramesPerBuffer * kChannelCount;
+    DriftResampler resampler(kChannelCount, 2 * kFramesPerBuffer);
+    std::deque<CSAMPLE> fifo(kChunkSize * 3 / 2, CSAMPLE_ZERO);
+    std::vector<CSAMPLE> input;
+    std::vector<CSAMPLE> output(kChunkSize);
+    double engineTime = 0.0;
+    double lastEngineTime = 0.0;
+    double deviceTime = 0.3;
+    SINT engineFrame = 0;
+    CSAMPLE lastSample = 0;
+    for (int callback = 0; callback < 40000; ++callback) {
+        if (engineTime < deviceTime) {
+            for (SINT frame = 0; frame < kFramesPerBuffer; ++frame) {
+                fifo.push_back(sine(engineFrame));
+                fifo.push_back(sine(engineFrame));
+                ++engineFrame;
+            }
+            ASSERT_LE(fifo.size(), static_cast<size_t>(3 * kChunkSize));
+            lastEngineTime = engineTime;
+            engineTime += 1.0;
+            continue;
+        }
+        const double fillLevel = static_cast<double>(fifo.size()) / kChunkSize -
+                1.0 + std::min(1.0, deviceTime - lastEngineTime);
+        resampler.updateRatio(fillLevel - 1.5);
+        const SINT requiredFrames = resampler.inputFramesRequired(kFramesPerBuffer);
+        ASSERT_LE(static_cast<size_t>(requiredFrames * kChannelCount), fifo.size());
+        input.assign(fifo.begin(), fifo.begin() + requiredFrames * kChannelCount);
+        fifo.erase(fifo.begin(), fifo.begin() + requiredFrames * kChannelCount);
+        resampler.pushInput(input.data(), requiredFrames);
+        ASSERT_EQ(kFramesPerBuffer, resampler.process(output.data(), kFramesPerBuffer));
+        if (callback > 20000) {
+            // No clicks: The signal changes by at most its slope
+            for (SINT frame = 0; frame < kFramesPerBuffer; ++frame) {
+                EXPECT_LE(std::abs(output[frame * kChannelCount] - lastSample), 0.032f);
+                lastSample = output[frame * kChannelCount];
+            }
+        } else {
+            lastSample = output[(kFramesPerBuffer - 1) * kChannelCount];
+        }
+        deviceTime += 1.0 / (1.0 + kDrift);
+    }
+    EXPECT_NEAR(1.0 / (1.0 + kDrift), resampler.ratio(), 1e-5);
+}
+
+} // anonymous namespace
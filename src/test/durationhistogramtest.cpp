@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "util/durationhistogram.h"
+
+namespace {
+
+using mixxx::Duration;
+using mixxx::DurationHistogram;
+
+TEST(DurationHistogramTest, bucketBounds) {
+    // Every value must be counted in a bucket whose upper bound covers it
+    // and the upper bound of the previous bucket must be smaller.
+    for (std::int64_t nanos = 0; nanos < 100000; nanos += 7) {
+        const int index = DurationHistogram::bucketIndex(nanos);
+        ASSERT_LT(index, DurationHistogram::kNumBuckets);
+        EXPECT_LE(nanos, DurationHistogram::bucketUpperBound(index));
+        if (index > 0) {
+            EXPECT_GT(nanos, DurationHistogram::bucketUpperBound(index - 1));
+        }
+    }
+    EXPECT_EQ(DurationHistogram::kNumBuckets - 1,
+            DurationHistogram::bucketIndex(std::int64_t(1) << 40));
+}
+
+TEST(DurationHistogramTest, percentiles) {
+    DurationHistogram histogram;
+    for (int i = 1; i <= 100; ++i) {
+        histogram.record(Duration::fromMicros(i * 10));
+    }
+    const auto summary = histogram.takeSummary();
+    EXPECT_EQ(100u, summary.count);
+    EXPECT_EQ(Duration::fromMicros(1000), summary.max);
+    // The relative error is bounded by the bucket width
+    EXPECT_GE(summary.p50, Duration::fromMicros(500));
+    EXPECT_LE(summary.p50, Duration::fromMicros(563));
+    EXPECT_GE(summary.p99, Duration::fromMicros(990));
+    EXPECT_LE(summary.p99, Duration::fromMicros(1000));
+}
+
+TEST(DurationHistogramTest, summaryOnlyContainsNewDurations) {
+    DurationHistogram histogram;
+    histogram.record(Duration::fromMillis(5));
+    EXPECT_EQ(1u, histogram.takeSummary().count);
+
+    const auto emptySummary = histogram.takeSummary();
+    EXPECT_EQ(0u, emptySummary.count);
+    EXPECT_EQ(Duration::empty(), emptySummary.max);
+
+    histogram.record(Duration::fromMicros(100));
+    const auto summary = histogram.takeSummary();
+    EXPECT_EQ(1u, summary.count);
+    EXPECT_EQ(Duration::fromMicros(100), summary.max);
+    EXPECT_EQ(Duration::fromMicros(100), summary.p99);
+}
+
+} // namespace
@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "encoder/encodercallback.h"
+#include "encoder/encodermp3.h"
+#include "encoder/encodersettings.h"
+#include "encoder/encodervorbis.h"
+#ifdef __OPUS__
+#include "encoder/encoderopus.h"
+#endif
+
+// Benchmarks of Encoder::encodeBuffer() for the encoders of the recording and
+// broadcast workers. The argument is the number of frames passed per call.
+// The sidechain workers pass all samples that have accumulated since they
+// were woken up, which are many thousand frames. The smaller sizes show the
+// overhead per call, e.g.
+//   mixxx-test --benchmark --benchmark_filter=BM_Encoder
+
+namespace {
+
+constexpr int kChannelCount = 2;
+// One second of audio is encoded per iteration
+constexpr int kSampleRate = 48000;
+
+class BenchmarkEncoderSettings : public EncoderSettings {
+  public:
+    int getQuality() const override {
+        return 128;
+    }
+    ChannelMode getChannelMode() const override {
+        return ChannelMode::STEREO;
+    }
+    QString getFormat() const override {
+        return QString();
+    }
+};
+
+class NullEncoderCallback : public EncoderCallback {
+  public:
+    void write(const unsigned char* header,
+            const unsigned char* body,
+            int headerLen,
+            int bodyLen) override {
+        Q_UNUSED(header);
+        Q_UNUSED(body);
+        m_bytesWritten += headerLen + bodyLen;
+    }
+    int tell() override {
+        return static_cast<int>(m_bytesWritten);
+    }
+    void seek(int pos) override {
+        Q_UNUSED(pos);
+    }
+    int filelen() override {
+        return static_cast<int>(m_bytesWritten);
+    }
+
+  private:
+    qint64 m_bytesWritten = 0;
+};
+
+template<typename T>
+void benchmarkEncoder(benchmark::State& state) {
+    const int framesPerCall = static_cast<int>(state.range(0));
+    NullEncoderCallback callback;
+    T encoder(&callback);
+    encoder.setEncoderSettings(BenchmarkEncoderSettings());
+    QString errorMessage;
+    if (encoder.initEncoder(mixxx::audio::SampleRate(kSampleRate), &errorMessage) < 0) {
+        state.SkipWithError(errorMessage.toStdString().c_str());
+        return;
+    }
+
+    // A sine sweep keeps the psychoacoustic models busy
+    std::vector<CSAMPLE> samples(kSampleRate * kChannelCount);
+    for (int i = 0; i < kSampleRate; ++i) {
+        const double t = static_cast<double>(i) / kSampleRate;
+        const auto value = static_cast<CSAMPLE>(0.5 * std::sin(2 * M_PI * (200 + 2000 * t) * t));
+        samples[i * kChannelCount] = value;
+        samples[i * kChannelCount + 1] = -value;
+    }
+
+    const int samplesPerCall = framesPerCall * kChannelCount;
+    for (auto _ : state) {
+        for (int offset = 0; offset + samplesPerCall <= static_cast<int>(samples.size());
+                offset += samplesPerCall) {
+            encoder.encodeBuffer(samples.data() + offset, samplesPerCall);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleRate);
+}
+
+void applyFramesPerCall(benchmark::internal::Benchmark* pBenchmark) {
+    pBenchmark->Arg(64)->Arg(1024)->Arg(16384);
+}
+
+} // anonymous namespace
+
+static void BM_EncoderMp3(benchmark::State& state) {
+    benchmarkEncoder<EncoderMp3>(state);
+}
+BENCHMARK(BM_EncoderMp3)->Apply(applyFramesPerCall);
+
+static void BM_EncoderVorbis(benchmark::State& state) {
+    benchmarkEncoder<EncoderVorbis>(state);
+}
+BENCHMARK(BM_EncoderVorbis)->Apply(applyFramesPerCall);
+
+#ifdef __OPUS__
+static void BM_EncoderOpus(benchmark::State& state) {
+    benchmarkEncoder<EncoderOpus>(state);
+}
+BENCHMARK(BM_EncoderOpus)->Apply(applyFramesPerCall);
+#endif
@@ -1,8 +1,10 @@
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <QtDebug>
 #include <QVector>
+#include <vector>
 
 #include "engine/bufferscalers/enginebufferscalelinear.h"
 #include "engine/readaheadmanager.h"
@@ -296,4 +298,149 @@ TEST_F(EngineBufferScaleLinearTest, TestRepeatedScaleCalls) {
     SampleUtil::free(pOutput);
 }
 
+TEST_F(EngineBufferScaleLinearTest, InterpolationModesAreSamplePerfectAtUnityRate) {
+    // Tell the RAMAN mock to invoke getNextSamplesFake
+    EXPECT_CALL(*m_pReadAheadMock, getNextSamples(_, _, _))
+            .WillRepeatedly(Invoke(m_pReadAheadMock, &ReadAheadManagerMock::getNextSamplesFake));
+
+    QVector<CSAMPLE> readBuffer;
+    for (int i = 0; i < 1000; ++i) {
+        readBuffer.push_back(i);
+    }
+
+    CSAMPLE* pOutput = SampleUtil::alloc(kiLinearScaleReadAheadLength);
+    for (const auto mode : {EngineBufferScaleLinear::InterpolationMode::Cubic,
+                 EngineBufferScaleLinear::InterpolationMode::Sinc}) {
+        m_pScaler->setInterpolationMode(mode);
+        SetRateNoLerp(1.0);
+        m_pReadAheadMock->setReadBuffer(readBuffer.data(), readBuffer.size());
+        m_pScaler->scaleBuffer(pOutput, kiLinearScaleReadAheadLength);
+
+        AssertBufferCycles(pOutput, kiLinearScaleReadAheadLength,
+                           readBuffer.data(), readBuffer.size());
+    }
+
+    SampleUtil::free(pOutput);
+}
+
+TEST_F(EngineBufferScaleLinearTest, InterpolationModesKeepChannelsApart) {
+    // Tell the RAMAN mock to invoke getNextSamplesFake
+    EXPECT_CALL(*m_pReadAheadMock, getNextSamples(_, _, _))
+            .WillRepeatedly(Invoke(m_pReadAheadMock, &ReadAheadManagerMock::getNextSamplesFake));
+
+    CSAMPLE readBuffer[] = { -1.0, 1.0 };
+
+    CSAMPLE* pOutput = SampleUtil::alloc(kiLinearScaleReadAheadLength);
+    for (const auto mode : {EngineBufferScaleLinear::InterpolationMode::Cubic,
+                 EngineBufferScaleLinear::InterpolationMode::Sinc}) {
+        m_pScaler->setInterpolationMode(mode);
+        SetRateNoLerp(0.7);
+        m_pReadAheadMock->setReadBuffer(readBuffer, 2);
+        m_pScaler->scaleBuffer(pOutput, kiLinearScaleReadAheadLength);
+
+        // The first frames are faded in from the silence before the first
+        // frame that was read, skip them.
+        for (int i = 32; i < kiLinearScaleReadAheadLength; i += 2) {
+            EXPECT_NEAR(-1.0, pOutput[i], 1e-5);
+            EXPECT_NEAR(1.0, pOutput[i + 1], 1e-5);
+        }
+    }
+
+    SampleUtil::free(pOutput);
+}
+
+// Repeats a sine wave regardless of the rate, for benchmarks without the
+// overhead of the mock
+class ReadAheadManagerSine : public ReadAheadManager {
+  public:
+    ReadAheadManagerSine()
+            : m_buffer(kiLinearScaleReadAheadLength),
+              m_iReadPosition(0) {
+        // 10 periods in the buffer
+        const SINT frames = m_buffer.size() / 2;
+        for (SINT i = 0; i < frames; ++i) {
+            const auto value = static_cast<CSAMPLE>(std::sin(2 * M_PI * 10 * i / frames));
+            m_buffer[2 * i] = value;
+            m_buffer[2 * i + 1] = value;
+        }
+    }
+
+    SINT getNextSamples(double dRate, CSAMPLE* buffer, SINT requested_samples) override {
+        Q_UNUSED(dRate);
+        const auto bufferSize = static_cast<SINT>(m_buffer.size());
+        SINT samplesRead = 0;
+        while (samplesRead < requested_samples) {
+            const SINT samplesToCopy = math_min(
+                    requested_samples - samplesRead, bufferSize - m_iReadPosition);
+            SampleUtil::copy(buffer + samplesRead, &m_buffer[m_iReadPosition], samplesToCopy);
+            samplesRead += samplesToCopy;
+            m_iReadPosition = (m_iReadPosition + samplesToCopy) % bufferSize;
+        }
+        return samplesRead;
+    }
+
+  private:
+    std::vector<CSAMPLE> m_buffer;
+    SINT m_iReadPosition;
+};
+
+// The arguments are the buffer size in frames and the
+// EngineBufferScaleLinear::InterpolationMode. The items per second are the
+// output frames, so their inverse is the cost per frame.
+void scaleLinear(benchmark::State& state, double rate, bool scratch) {
+    const auto frames = static_cast<SINT>(state.range(0));
+    const auto mode = static_cast<EngineBufferScaleLinear::InterpolationMode>(state.range(1));
+    ReadAheadManagerSine readAheadManager;
+    EngineBufferScaleLinear scaler(&readAheadManager);
+    scaler.setSampleRate(mixxx::audio::SampleRate(44100));
+    scaler.setInterpolationMode(mode);
+    std::vector<CSAMPLE> output(2 * frames);
+
+    double tempoRatio = rate;
+    double pitchRatio = rate;
+    scaler.setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+    scaler.setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+    for (auto _ : state) {
+        if (scratch) {
+            // Changes the direction with every buffer
+            tempoRatio = -tempoRatio;
+            pitchRatio = -pitchRatio;
+            scaler.setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+        }
+        scaler.scaleBuffer(output.data(), static_cast<SINT>(output.size()));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * frames);
+
+    switch (mode) {
+    case EngineBufferScaleLinear::InterpolationMode::Linear:
+        state.SetLabel("linear");
+        break;
+    case EngineBufferScaleLinear::InterpolationMode::Cubic:
+        state.SetLabel("cubic");
+        break;
+    case EngineBufferScaleLinear::InterpolationMode::Sinc:
+        state.SetLabel("sinc");
+        break;
+    }
+}
+
+void applyBufferSizesAndModes(benchmark::internal::Benchmark* pBenchmark) {
+    for (int mode = 0; mode <= 2; ++mode) {
+        for (int frames = 64; frames <= 4096; frames *= 4) {
+            pBenchmark->Args({frames, mode});
+        }
+    }
+}
+
+static void BM_ScaleLinear(benchmark::State& state) {
+    scaleLinear(state, 1.08, false);
+}
+BENCHMARK(BM_ScaleLinear)->Apply(applyBufferSizesAndModes);
+
+static void BM_ScaleLinearScratch(benchmark::State& state) {
+    scaleLinear(state, 2.5, true);
+}
+BENCHMARK(BM_ScaleLinearScratch)->Apply(applyBufferSizesAndModes);
+
 }  // namespace
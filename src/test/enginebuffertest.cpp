@@ -12,6 +12,8 @@
 #include "test/mixxxtest.h"
 #include "test/signalpathtest.h"
 #include "engine/controls/ratecontrol.h"
+#include "util/rtsafety.h"
+#include "util/sample.h"
 
 // In case any of the test in this file fail. You can use the audioplot.py tool
 // in the tools folder to visually compare the results of the enginebuffer
@@ -275,6 +277,39 @@ TEST_F(EngineBufferE2ETest, ReverseTest) {
                                  kProcessBufferSize, "ReverseTest");
 }
 
+TEST_F(EngineBufferE2ETest, NoRealtimeViolationsWhileLoopingSeekingAndReversing) {
+    const bool wasEnabled = mixxx::RtSafety::isEnabled();
+    mixxx::RtSafety::setEnabled(true);
+    if (!mixxx::RtSafety::isEnabled()) {
+        GTEST_SKIP() << "Requires a build with RTSAFETY_CHECKS";
+    }
+    ControlObject::set(ConfigKey(m_sGroup1, "rate"), 0.0);
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    ProcessBuffer();
+    // A loop that is shorter than a buffer wraps several times per callback
+    ControlObject::set(ConfigKey(m_sGroup1, "loop_start_position"), 0.0);
+    ControlObject::set(ConfigKey(m_sGroup1, "loop_end_position"), 200.0);
+    ControlObject::set(ConfigKey(m_sGroup1, "reloop_toggle"), 1.0);
+    ProcessBuffer();
+
+    const int violationCount = mixxx::RtSafety::violationCount();
+    for (int i = 0; i < 10; ++i) {
+        ProcessBuffer();
+    }
+    ControlObject::set(ConfigKey(m_sGroup1, "reverse"), 1.0);
+    for (int i = 0; i < 10; ++i) {
+        ProcessBuffer();
+    }
+    ControlObject::set(ConfigKey(m_sGroup1, "reloop_toggle"), 1.0);
+    m_pChannel1->getEngineBuffer()->queueNewPlaypos(
+            mixxx::audio::FramePos(5000), EngineBuffer::SEEK_EXACT);
+    for (int i = 0; i < 10; ++i) {
+        ProcessBuffer();
+    }
+    EXPECT_EQ(violationCount, mixxx::RtSafety::violationCount());
+    mixxx::RtSafety::setEnabled(wasEnabled);
+}
+
 // DISABLED: This test is too dependent on the sound touch library version.
 TEST_F(EngineBufferE2ETest, DISABLED_SoundTouchToggleTest) {
    // Test various cases where SoundTouch toggles on and off.
@@ -389,6 +424,34 @@ TEST_F(EngineBufferE2ETest, RubberbandReverseTest) {
     // on the uses library version
 }
 
+TEST_F(EngineBufferE2ETest, MultiThreadedRubberbandTest) {
+    ControlObject::set(ConfigKey("[Master]", "keylock_multithreading"), 1.0);
+    ControlObject::set(ConfigKey("[Master]", "keylock_engine"),
+            static_cast<double>(EngineBuffer::KeylockEngine::RubberBandFaster));
+    ControlObject::set(ConfigKey(m_sGroup1, "keylock"), 1.0);
+    ControlObject::set(ConfigKey(m_sGroup1, "rate"), 0.05);
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    for (int i = 0; i < 16; ++i) {
+        ProcessBuffer();
+    }
+    // The output of the stretcher has reached the master output
+    CSAMPLE absLeft = 0;
+    CSAMPLE absRight = 0;
+    SampleUtil::sumAbsPerChannel(
+            &absLeft, &absRight, m_pEngineMaster->masterBuffer(), kProcessBufferSize);
+    EXPECT_GT(absLeft + absRight, 0.0f);
+    const double playposition = ControlObject::get(ConfigKey(m_sGroup1, "playposition"));
+    EXPECT_GT(playposition, 0.0);
+
+    // Must not crash when changing the direction or switching back to the
+    // synchronous processing
+    ControlObject::set(ConfigKey(m_sGroup1, "reverse"), 1.0);
+    ProcessBuffer();
+    ControlObject::set(ConfigKey("[Master]", "keylock_multithreading"), 0.0);
+    ProcessBuffer();
+    ProcessBuffer();
+}
+
 TEST_F(EngineBufferE2ETest, CueGotoAndStopTest) {
     // Be sure, that the Crossfade buffer is processed only once
     // Bug #1504838
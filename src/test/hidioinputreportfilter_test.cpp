@@ -0,0 +1,66 @@
+#include "controllers/hid/hidioinputreportfilter.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+class HidIoInputReportFilterTest : public testing::Test {
+  protected:
+    static bool isChanged(HidIoInputReportFilter* pFilter,
+            std::initializer_list<unsigned char> report) {
+        const std::vector<unsigned char> data(report);
+        return pFilter->isChanged(data.data(), static_cast<int>(data.size()));
+    }
+};
+
+TEST_F(HidIoInputReportFilterTest, UnchangedReportsAreSkipped) {
+    HidIoInputReportFilter filter;
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0x00, 0x10}));
+    EXPECT_FALSE(isChanged(&filter, {0x01, 0x00, 0x10}));
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0x01, 0x10}));
+    // Without fields the ReportID is not known, so a report is always
+    // compared with the previous one
+    EXPECT_TRUE(isChanged(&filter, {0x02, 0x01, 0x10}));
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0x01, 0x10}));
+    // Different size
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0x01}));
+}
+
+TEST_F(HidIoInputReportFilterTest, OnlyDeclaredFieldsAreCompared) {
+    HidInputReportField button;
+    button.reportId = 0x01;
+    button.offset = 1;
+    button.mask = 0x0F;
+    HidInputReportField jog;
+    jog.reportId = 0x01;
+    jog.offset = 2;
+    jog.size = 2;
+    HidIoInputReportFilter filter({button, jog});
+
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0x00, 0x00, 0x00, 0x55}));
+    // Undeclared bits and bytes, like a timer
+    EXPECT_FALSE(isChanged(&filter, {0x01, 0xF0, 0x00, 0x00, 0x56}));
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0xF1, 0x00, 0x00, 0x57}));
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0xF1, 0x00, 0x01, 0x58}));
+    EXPECT_FALSE(isChanged(&filter, {0x01, 0x01, 0x00, 0x01, 0x59}));
+}
+
+TEST_F(HidIoInputReportFilterTest, ReportsAreTrackedPerReportId) {
+    HidInputReportField button;
+    button.reportId = 0x01;
+    button.offset = 1;
+    HidIoInputReportFilter filter({button});
+
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0x00}));
+    // A report without declared fields is passed on any change
+    EXPECT_TRUE(isChanged(&filter, {0x02, 0x10, 0x20}));
+    EXPECT_FALSE(isChanged(&filter, {0x01, 0x00}));
+    EXPECT_FALSE(isChanged(&filter, {0x02, 0x10, 0x20}));
+    EXPECT_TRUE(isChanged(&filter, {0x02, 0x10, 0x21}));
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0x01}));
+
+    filter.reset();
+    EXPECT_TRUE(isChanged(&filter, {0x01, 0x01}));
+}
+
+} // anonymous namespace
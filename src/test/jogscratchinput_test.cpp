@@ -0,0 +1,91 @@
+#include "engine/jogscratchinput.h"
+
+#include <gtest/gtest.h>
+
+#include "util/duration.h"
+
+namespace {
+
+using mixxx::Duration;
+
+constexpr double kBufferSeconds = 0.005;
+
+class JogScratchInputTest : public testing::Test {
+  protected:
+    /// Lets the engine process buffers until the given time
+    double processUntil(JogScratchInput* pInput, Duration end, bool* pEnabled = nullptr) {
+        double distance = 0;
+        bool enabled = true;
+        while (m_now < end) {
+            m_now += Duration::fromSeconds(kBufferSeconds);
+            double rate = 0;
+            enabled = pInput->process(m_now, kBufferSeconds, &rate);
+            if (enabled) {
+                m_rates.push_back(rate);
+                distance += rate * kBufferSeconds;
+            }
+        }
+        if (pEnabled) {
+            *pEnabled = enabled;
+        }
+        return distance;
+    }
+
+    Duration m_now;
+    std::vector<double> m_rates;
+};
+
+TEST_F(JogScratchInputTest, SteadyMovementPlaysAtConstantRate) {
+    auto pInput = JogScratchInput::getJogScratchInput(QStringLiteral("[JogTest1]"));
+    pInput->enable(Duration::empty());
+    // A platter turned at normal speed reporting every millisecond
+    for (int millis = 1; millis <= 100; ++millis) {
+        pInput->move(0.001, Duration::fromMillis(millis));
+        processUntil(pInput.data(), Duration::fromMillis(millis));
+    }
+    ASSERT_GT(m_rates.size(), 1u);
+    // The first buffer ends at the evaluation delay before the first movement
+    EXPECT_EQ(0.0, m_rates[0]);
+    for (size_t i = 1; i < m_rates.size(); ++i) {
+        EXPECT_NEAR(1.0, m_rates[i], 1e-9);
+    }
+}
+
+TEST_F(JogScratchInputTest, IrregularMovementPreservesDistance) {
+    auto pInput = JogScratchInput::getJogScratchInput(QStringLiteral("[JogTest2]"));
+    pInput->enable(Duration::empty());
+    double moved = 0;
+    double played = 0;
+    int millis = 0;
+    for (int i = 0; i < 40; ++i) {
+        // Bursts and gaps like from a polled controller
+        millis += 1 + (i * 7) % 5;
+        const double seconds = ((i % 3) - 0.5) * 0.0013;
+        pInput->move(seconds, Duration::fromMillis(millis));
+        moved += seconds;
+        played += processUntil(pInput.data(), Duration::fromMillis(millis));
+    }
+    pInput->disable(Duration::fromMillis(millis), true);
+    bool enabled = true;
+    played += processUntil(pInput.data(), Duration::fromMillis(millis + 50), &enabled);
+    EXPECT_FALSE(enabled);
+    EXPECT_TRUE(pInput->rampOnRelease());
+    EXPECT_NEAR(moved, played, 1e-12);
+}
+
+TEST_F(JogScratchInputTest, MovementWhileDisabledIsIgnored) {
+    auto pInput = JogScratchInput::getJogScratchInput(QStringLiteral("[JogTest3]"));
+    pInput->move(0.01, Duration::fromMillis(1));
+    bool enabled = true;
+    processUntil(pInput.data(), Duration::fromMillis(20), &enabled);
+    EXPECT_FALSE(enabled);
+    EXPECT_TRUE(m_rates.empty());
+}
+
+TEST_F(JogScratchInputTest, SharedPerGroup) {
+    auto pInput = JogScratchInput::getJogScratchInput(QStringLiteral("[JogTest4]"));
+    EXPECT_EQ(pInput, JogScratchInput::getJogScratchInput(QStringLiteral("[JogTest4]")));
+    EXPECT_NE(pInput, JogScratchInput::getJogScratchInput(QStringLiteral("[JogTest5]")));
+}
+
+} // anonymous namespace
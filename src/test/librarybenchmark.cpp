@@ -0,0 +1,449 @@
+#include <benchmark/benchmark.h>
+
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+#include "library/basetrackcache.h"
+#include "library/dao/trackschema.h"
+#include "library/librarytablemodel.h"
+#include "library/queryutil.h"
+#include "library/scanner/libraryscanner.h"
+#include "library/searchquery.h"
+#include "library/searchqueryparser.h"
+#include "library/trackset/crate/cratestorage.h"
+#include "test/librarytest.h"
+#include "util/fileinfo.h"
+
+// Benchmarks of the library with synthetic collections, the first argument
+// is the number of tracks. The collection is generated directly with SQL
+// before measuring, which takes a few seconds for the largest collections:
+//   mixxx-test --benchmark --benchmark_filter=BM_Library
+//
+// Most operations take milliseconds up to seconds on large collections, so
+// each benchmark runs a fixed number of iterations instead of letting the
+// benchmark library regenerate the collection while estimating them.
+
+namespace {
+
+constexpr int kIterations = 5;
+
+constexpr int kNumArtists = 2000;
+constexpr int kTracksPerAlbum = 12;
+constexpr int kNumCrates = 100;
+
+// Tracks loaded per iteration of the bulk load benchmark
+constexpr int kBulkLoadCount = 1000;
+
+const QString kGenres[] = {
+        QStringLiteral("House"),
+        QStringLiteral("Techno"),
+        QStringLiteral("Drum & Bass"),
+        QStringLiteral("Hip-Hop"),
+        QStringLiteral("Jazz"),
+        QStringLiteral("Rock"),
+        QStringLiteral("Pop"),
+        QStringLiteral("Soul"),
+};
+constexpr int kNumGenres = sizeof(kGenres) / sizeof(kGenres[0]);
+
+const QString kTitleWords[] = {
+        QStringLiteral("Love"),
+        QStringLiteral("Night"),
+        QStringLiteral("Dance"),
+        QStringLiteral("Dream"),
+        QStringLiteral("Fire"),
+        QStringLiteral("Rain"),
+        QStringLiteral("Heart"),
+        QStringLiteral("City"),
+        QStringLiteral("Ocean"),
+        QStringLiteral("Light"),
+};
+constexpr int kNumTitleWords = sizeof(kTitleWords) / sizeof(kTitleWords[0]);
+
+// A subset of the columns of the library view of MixxxLibraryFeature
+const QStringList kTrackSourceColumns = {
+        LIBRARYTABLE_ID,
+        LIBRARYTABLE_PLAYED,
+        LIBRARYTABLE_TIMESPLAYED,
+        LIBRARYTABLE_ALBUMARTIST,
+        LIBRARYTABLE_ALBUM,
+        LIBRARYTABLE_ARTIST,
+        LIBRARYTABLE_TITLE,
+        LIBRARYTABLE_YEAR,
+        LIBRARYTABLE_RATING,
+        LIBRARYTABLE_GENRE,
+        LIBRARYTABLE_COMPOSER,
+        LIBRARYTABLE_GROUPING,
+        LIBRARYTABLE_TRACKNUMBER,
+        LIBRARYTABLE_KEY,
+        LIBRARYTABLE_BPM,
+        LIBRARYTABLE_DURATION,
+        LIBRARYTABLE_BITRATE,
+        LIBRARYTABLE_FILETYPE,
+        LIBRARYTABLE_DATETIMEADDED,
+        TRACKLOCATIONSTABLE_LOCATION,
+        TRACKLOCATIONSTABLE_FSDELETED,
+        LIBRARYTABLE_COMMENT,
+        LIBRARYTABLE_MIXXXDELETED,
+};
+
+class LibraryBenchmark : public LibraryTest {
+  public:
+    using LibraryTest::config;
+    using LibraryTest::dbConnectionPooler;
+    using LibraryTest::internalCollection;
+    using LibraryTest::trackCollectionManager;
+
+    explicit LibraryBenchmark(int numTracks)
+            : m_numTracks(numTracks) {
+        generateCollection();
+    }
+
+    int numTracks() const {
+        return m_numTracks;
+    }
+
+    QString rootPath() const {
+        return m_rootDir.path();
+    }
+
+    QString trackDirectory(int track) const {
+        const int album = track / kTracksPerAlbum;
+        return QStringLiteral("%1/Artist %2/Album %3")
+                .arg(rootPath(),
+                        QString::number(album % kNumArtists),
+                        QString::number(album));
+    }
+
+    QString trackFileName(int track) const {
+        return QStringLiteral("%1 - Track.mp3").arg(track);
+    }
+
+    TrackId trackId(int track) const {
+        // The ids are assigned in the order of insertion
+        return TrackId(track + 1);
+    }
+
+    QSqlDatabase database() const {
+        return internalCollection()->database();
+    }
+
+    // Creates the track source like MixxxLibraryFeature, which is required
+    // by the table models
+    QSharedPointer<BaseTrackCache> createTrackSource() {
+        QStringList qualifiedColumns;
+        for (const auto& column : kTrackSourceColumns) {
+            qualifiedColumns.append(mixxx::trackschema::tableForColumn(column) +
+                    QLatin1Char('.') + column);
+        }
+        const QString tableName = QStringLiteral("library_cache_view");
+        QSqlQuery query(database());
+        if (!query.exec(QStringLiteral(
+                    "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS "
+                    "SELECT %2 FROM library "
+                    "INNER JOIN track_locations "
+                    "ON library.location = track_locations.id")
+                                .arg(tableName, qualifiedColumns.join(',')))) {
+            LOG_FAILED_QUERY(query);
+        }
+        auto pTrackSource = QSharedPointer<BaseTrackCache>::create(
+                internalCollection(),
+                tableName,
+                LIBRARYTABLE_ID,
+                kTrackSourceColumns,
+                true);
+        internalCollection()->connectTrackSource(pTrackSource);
+        return pTrackSource;
+    }
+
+    // Creates an empty file for each track, so the directories can be
+    // scanned
+    bool createTrackFiles() const {
+        for (int track = 0; track < m_numTracks; ++track) {
+            const QString directory = trackDirectory(track);
+            if (track % kTracksPerAlbum == 0 && !QDir().mkpath(directory)) {
+                return false;
+            }
+            QFile file(directory + QLatin1Char('/') + trackFileName(track));
+            if (!file.open(QIODevice::WriteOnly)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Only used for the fixture
+    void TestBody() override {
+    }
+
+  private:
+    void generateCollection() {
+        ScopedTransaction transaction(database());
+        QSqlQuery locationQuery(database());
+        locationQuery.prepare(QStringLiteral(
+                "INSERT INTO track_locations "
+                "(location, filename, directory, filesize, fs_deleted, "
+                "needs_verification) "
+                "VALUES (:location, :filename, :directory, 0, 0, 0)"));
+        QSqlQuery trackQuery(database());
+        trackQuery.prepare(QStringLiteral(
+                "INSERT INTO library "
+                "(artist, title, album, year, genre, tracknumber, location, "
+                "comment, duration, bitrate, samplerate, bpm, channels, "
+                "mixxx_deleted, played, timesplayed, rating, key, "
+                "filetype, header_parsed) "
+                "VALUES (:artist, :title, :album, :year, :genre, :tracknumber, "
+                ":location, :comment, :duration, 320, 44100, :bpm, 2, "
+                "0, 0, :timesplayed, :rating, :key, 'mp3', 1)"));
+        for (int track = 0; track < m_numTracks; ++track) {
+            const QString directory = trackDirectory(track);
+            const QString fileName = trackFileName(track);
+            locationQuery.bindValue(QStringLiteral(":location"),
+                    directory + QLatin1Char('/') + fileName);
+            locationQuery.bindValue(QStringLiteral(":filename"), fileName);
+            locationQuery.bindValue(QStringLiteral(":directory"), directory);
+            if (!locationQuery.exec()) {
+                LOG_FAILED_QUERY(locationQuery);
+                return;
+            }
+
+            const int album = track / kTracksPerAlbum;
+            trackQuery.bindValue(QStringLiteral(":artist"),
+                    QStringLiteral("Artist %1").arg(album % kNumArtists));
+            trackQuery.bindValue(QStringLiteral(":title"),
+                    QStringLiteral("%1 %2 %3")
+                            .arg(kTitleWords[track % kNumTitleWords],
+                                    kTitleWords[(track / kNumTitleWords) % kNumTitleWords],
+                                    QString::number(track)));
+            trackQuery.bindValue(QStringLiteral(":album"),
+                    QStringLiteral("Album %1").arg(album));
+            trackQuery.bindValue(QStringLiteral(":year"),
+                    QString::number(1970 + album % 50));
+            trackQuery.bindValue(QStringLiteral(":genre"), kGenres[album % kNumGenres]);
+            trackQuery.bindValue(QStringLiteral(":tracknumber"),
+                    QString::number(track % kTracksPerAlbum + 1));
+            trackQuery.bindValue(QStringLiteral(":location"),
+                    locationQuery.lastInsertId());
+            trackQuery.bindValue(QStringLiteral(":comment"),
+                    track % 3 == 0 ? QStringLiteral("Remix") : QString());
+            trackQuery.bindValue(QStringLiteral(":duration"), 120.0 + track % 360);
+            trackQuery.bindValue(QStringLiteral(":bpm"), 80.0 + track % 100);
+            trackQuery.bindValue(QStringLiteral(":timesplayed"), track % 7);
+            trackQuery.bindValue(QStringLiteral(":rating"), track % 6);
+            trackQuery.bindValue(QStringLiteral(":key"),
+                    QStringLiteral("%1A").arg(track % 12 + 1));
+            if (!trackQuery.exec()) {
+                LOG_FAILED_QUERY(trackQuery);
+                return;
+            }
+        }
+
+        QSqlQuery crateQuery(database());
+        crateQuery.prepare(QStringLiteral(
+                "INSERT INTO crates (id, name) VALUES (:id, :name)"));
+        for (int crate = 1; crate <= kNumCrates; ++crate) {
+            crateQuery.bindValue(QStringLiteral(":id"), crate);
+            crateQuery.bindValue(QStringLiteral(":name"), QStringLiteral("Crate %1").arg(crate));
+            if (!crateQuery.exec()) {
+                LOG_FAILED_QUERY(crateQuery);
+                return;
+            }
+        }
+        // Every track is in one crate
+        QSqlQuery crateTracksQuery(database());
+        if (!crateTracksQuery.exec(QStringLiteral(
+                    "INSERT INTO crate_tracks (crate_id, track_id) "
+                    "SELECT id % %1 + 1, id FROM library")
+                                           .arg(kNumCrates))) {
+            LOG_FAILED_QUERY(crateTracksQuery);
+            return;
+        }
+        transaction.commit();
+    }
+
+    const int m_numTracks;
+    const QTemporaryDir m_rootDir;
+};
+
+void applyNumTracks(benchmark::internal::Benchmark* pBenchmark) {
+    pBenchmark->Arg(10000)->Arg(100000)->Arg(500000);
+    pBenchmark->Iterations(kIterations)->Unit(benchmark::kMillisecond);
+}
+
+} // anonymous namespace
+
+// Selects all rows of the library view, sorted by artist
+static void BM_Library_TableModelSelect(benchmark::State& state) {
+    LibraryBenchmark benchmark(static_cast<int>(state.range(0)));
+    const auto pTrackSource = benchmark.createTrackSource();
+    LibraryTableModel model(nullptr,
+            benchmark.trackCollectionManager(),
+            "mixxx.db.model.library");
+    model.setSort(model.fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ARTIST),
+            Qt::AscendingOrder);
+    int rows = 0;
+    for (auto _ : state) {
+        model.select();
+        rows = model.rowCount();
+    }
+    state.SetLabel(QStringLiteral("%1 rows").arg(rows).toStdString());
+}
+BENCHMARK(BM_Library_TableModelSelect)->Apply(applyNumTracks);
+
+// Filters all tracks with a search query and sorts the matches by the
+// cached values, without building the index while measuring
+static void BM_Library_TrackCacheFilterAndSort(benchmark::State& state) {
+    LibraryBenchmark benchmark(static_cast<int>(state.range(0)));
+    const auto pTrackSource = benchmark.createTrackSource();
+    pTrackSource->buildIndex();
+    QSet<TrackId> trackIds;
+    trackIds.reserve(benchmark.numTracks());
+    for (int track = 0; track < benchmark.numTracks(); ++track) {
+        trackIds.insert(benchmark.trackId(track));
+    }
+    const QList<SortColumn> sortColumns = {
+            SortColumn(pTrackSource->fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ARTIST),
+                    Qt::AscendingOrder),
+            SortColumn(pTrackSource->fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TITLE),
+                    Qt::AscendingOrder),
+    };
+    QHash<TrackId, int> trackToIndex;
+    for (auto _ : state) {
+        trackToIndex.clear();
+        pTrackSource->filterAndSort(trackIds,
+                QStringLiteral("night genre:house"),
+                QString(),
+                QString(),
+                sortColumns,
+                0,
+                &trackToIndex);
+    }
+    state.SetLabel(QStringLiteral("%1 matches").arg(trackToIndex.size()).toStdString());
+}
+BENCHMARK(BM_Library_TrackCacheFilterAndSort)->Apply(applyNumTracks);
+
+// Parses a search query and executes the resulting SQL
+static void BM_Library_SearchQueryParseAndExecute(benchmark::State& state) {
+    LibraryBenchmark benchmark(static_cast<int>(state.range(0)));
+    const SearchQueryParser parser(benchmark.internalCollection());
+    const QStringList searchColumns = {
+            LIBRARYTABLE_ARTIST,
+            LIBRARYTABLE_ALBUM,
+            LIBRARYTABLE_TITLE,
+            LIBRARYTABLE_GENRE,
+            LIBRARYTABLE_COMMENT,
+            TRACKLOCATIONSTABLE_LOCATION,
+    };
+    int matches = 0;
+    for (auto _ : state) {
+        const auto pQuery = parser.parseQuery(
+                QStringLiteral("dream artist:\"Artist 1\" bpm:>120 -remix"),
+                searchColumns,
+                QString());
+        QSqlQuery query(benchmark.database());
+        query.setForwardOnly(true);
+        if (!query.exec(QStringLiteral(
+                    "SELECT library.id FROM library "
+                    "INNER JOIN track_locations "
+                    "ON library.location = track_locations.id WHERE %1")
+                                .arg(pQuery->toSql()))) {
+            LOG_FAILED_QUERY(query);
+            state.SkipWithError("Failed to execute query");
+            return;
+        }
+        matches = 0;
+        while (query.next()) {
+            ++matches;
+        }
+    }
+    state.SetLabel(QStringLiteral("%1 matches").arg(matches).toStdString());
+}
+BENCHMARK(BM_Library_SearchQueryParseAndExecute)->Apply(applyNumTracks);
+
+// Reads the track count and duration of all crates as shown in the sidebar
+static void BM_Library_CrateSummaries(benchmark::State& state) {
+    LibraryBenchmark benchmark(static_cast<int>(state.range(0)));
+    const CrateStorage& crates = benchmark.internalCollection()->crates();
+    int numCrates = 0;
+    for (auto _ : state) {
+        CrateSummarySelectResult summaries(crates.selectCrateSummaries());
+        CrateSummary summary;
+        numCrates = 0;
+        while (summaries.populateNext(&summary)) {
+            ++numCrates;
+        }
+    }
+    state.SetLabel(QStringLiteral("%1 crates").arg(numCrates).toStdString());
+}
+BENCHMARK(BM_Library_CrateSummaries)->Apply(applyNumTracks);
+
+// Inserts a track at the top of a playlist with a tenth of all tracks and
+// moves the last track to the top, both of which renumber all positions
+static void BM_Library_PlaylistInsertAndMove(benchmark::State& state) {
+    LibraryBenchmark benchmark(static_cast<int>(state.range(0)));
+    PlaylistDAO& playlistDao = benchmark.internalCollection()->getPlaylistDAO();
+    const int playlistId = playlistDao.createPlaylist(QStringLiteral("Benchmark"));
+    QList<TrackId> trackIds;
+    for (int track = 0; track < benchmark.numTracks() / 10; ++track) {
+        trackIds.append(benchmark.trackId(track));
+    }
+    playlistDao.appendTracksToPlaylist(trackIds, playlistId);
+    for (auto _ : state) {
+        playlistDao.insertTrackIntoPlaylist(benchmark.trackId(0), playlistId, 1);
+        playlistDao.moveTrack(playlistId,
+                playlistDao.tracksInPlaylist(playlistId),
+                1);
+    }
+    state.SetLabel(QStringLiteral("%1 playlist tracks")
+                           .arg(playlistDao.tracksInPlaylist(playlistId))
+                           .toStdString());
+}
+BENCHMARK(BM_Library_PlaylistInsertAndMove)->Apply(applyNumTracks);
+
+// Loads Track objects spread over the whole collection, e.g. for exporting
+// a crate. The tracks are released after each iteration.
+static void BM_Library_TrackBulkLoad(benchmark::State& state) {
+    LibraryBenchmark benchmark(static_cast<int>(state.range(0)));
+    const int stride = benchmark.numTracks() / kBulkLoadCount;
+    QList<TrackId> trackIds;
+    for (int i = 0; i < kBulkLoadCount; ++i) {
+        trackIds.append(benchmark.trackId(i * stride));
+    }
+    int loadedTracks = 0;
+    for (auto _ : state) {
+        loadedTracks = benchmark.internalCollection()->getTracksByIds(trackIds).size();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * loadedTracks);
+}
+BENCHMARK(BM_Library_TrackBulkLoad)->Apply(applyNumTracks);
+
+// Rescans a library in which no file has changed. The directory hashes are
+// stored by an initial scan before measuring.
+static void BM_Library_UnchangedRescan(benchmark::State& state) {
+    LibraryBenchmark benchmark(static_cast<int>(state.range(0)));
+    if (!benchmark.createTrackFiles()) {
+        state.SkipWithError("Failed to create track files");
+        return;
+    }
+    benchmark.internalCollection()->getDirectoryDAO().addDirectory(
+            mixxx::FileInfo(benchmark.rootPath()));
+    LibraryScanner scanner(benchmark.dbConnectionPooler(), benchmark.config());
+    scanner.start();
+    const auto scan = [&scanner]() {
+        QEventLoop loop;
+        QObject::connect(&scanner,
+                &LibraryScanner::scanFinished,
+                &loop,
+                &QEventLoop::quit);
+        scanner.scan();
+        loop.exec();
+    };
+    scan();
+    for (auto _ : state) {
+        scan();
+    }
+}
+BENCHMARK(BM_Library_UnchangedRescan)->Apply(applyNumTracks);
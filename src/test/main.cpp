@@ -3,6 +3,15 @@
 #include "errordialoghandler.h"
 #include "mixxxtest.h"
 #include "util/logging.h"
+#include "util/rtsafety.h"
+
+namespace {
+
+void failOnRealtimeViolation(const char* pWhat) {
+    ADD_FAILURE() << "Realtime violation in the audio callback: " << pWhat;
+}
+
+} // anonymous namespace
 
 int main(int argc, char **argv) {
     // We never want to popup error dialogs when running tests.
@@ -15,6 +24,11 @@ int main(int argc, char **argv) {
             break;
         } else if (strcmp(argv[i], "--trace") == 0) {
             mixxx::Logging::setLogLevel(mixxx::LogLevel::Trace);
+        } else if (strcmp(argv[i], "--rtsafety") == 0) {
+            // Fails the tests that process the engine with calls that are
+            // not realtime safe. Requires a build with RTSAFETY_CHECKS.
+            mixxx::RtSafety::setViolationHandler(failOnRealtimeViolation);
+            mixxx::RtSafety::setEnabled(true);
         }
     }
 
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include "util/metrics.h"
+
+namespace {
+
+using namespace mixxx::metrics;
+
+TEST(MetricsTest, HistogramBuckets) {
+    MetricHistogram histogram("test", "help", {1.0, 2.0});
+    histogram.observe(0.5);
+    histogram.observe(1.0);
+    histogram.observe(1.5);
+    histogram.observe(10.0);
+
+    ASSERT_EQ(2, histogram.boundCount());
+    EXPECT_EQ(2u, histogram.bucketCount(0));
+    EXPECT_EQ(1u, histogram.bucketCount(1));
+    // +Inf
+    EXPECT_EQ(1u, histogram.bucketCount(2));
+    EXPECT_DOUBLE_EQ(13.0, histogram.sum());
+}
+
+TEST(MetricsTest, OpenMetricsText) {
+    const quint64 hits = cachingReaderHits.value();
+    cachingReaderHits.increment(3);
+    engineLoad.observe(0.2);
+
+    const QByteArray text = toOpenMetricsText();
+    EXPECT_TRUE(text.contains("# TYPE mixxx_caching_reader_hits counter\n"));
+    EXPECT_TRUE(text.contains("\nmixxx_caching_reader_hits_total " +
+            QByteArray::number(hits + 3) + '\n'));
+    // Histogram buckets are cumulative and end with +Inf
+    quint64 count = 0;
+    for (int bucket = 0; bucket <= engineLoad.boundCount(); ++bucket) {
+        count += engineLoad.bucketCount(bucket);
+    }
+    EXPECT_TRUE(text.contains("\nmixxx_engine_load_bucket{le=\"+Inf\"} " +
+            QByteArray::number(count) + '\n'));
+    EXPECT_TRUE(text.endsWith("# EOF\n"));
+}
+
+} // anonymous namespace
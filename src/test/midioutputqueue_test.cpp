@@ -0,0 +1,81 @@
+#include "controllers/midi/midioutputqueue.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+class MidiOutputQueueTest : public testing::Test {
+  protected:
+    std::vector<MidiOutputQueue::Message> flush() {
+        std::vector<MidiOutputQueue::Message> sent;
+        m_queue.flush([&sent](const MidiOutputQueue::Message& message) {
+            sent.push_back(message);
+        });
+        return sent;
+    }
+
+    MidiOutputQueue m_queue;
+};
+
+TEST_F(MidiOutputQueueTest, DropsRedundantMessages) {
+    EXPECT_TRUE(m_queue.enqueue(0x90, 0x10, 0x7F));
+    EXPECT_EQ(1u, flush().size());
+    EXPECT_FALSE(m_queue.enqueue(0x90, 0x10, 0x7F));
+    EXPECT_TRUE(flush().empty());
+    // A different channel is a different output
+    EXPECT_TRUE(m_queue.enqueue(0x91, 0x10, 0x7F));
+    EXPECT_EQ(1u, flush().size());
+    EXPECT_EQ(2, m_queue.stats().sent);
+    EXPECT_EQ(1, m_queue.stats().redundant);
+}
+
+TEST_F(MidiOutputQueueTest, CoalescesChangesOfAnOutput) {
+    m_queue.enqueue(0xB0, 0x01, 0x00);
+    m_queue.enqueue(0x90, 0x20, 0x7F);
+    m_queue.enqueue(0xB0, 0x01, 0x40);
+    m_queue.enqueue(0x80, 0x20, 0x00);
+    const auto sent = flush();
+    ASSERT_EQ(2u, sent.size());
+    // The last value is sent at the position of the first change
+    EXPECT_EQ(0xB0, sent[0].status);
+    EXPECT_EQ(0x40, sent[0].byte2);
+    // Note on and off address the same output
+    EXPECT_EQ(0x80, sent[1].status);
+    EXPECT_EQ(0x20, sent[1].byte1);
+    EXPECT_EQ(2, m_queue.stats().coalesced);
+}
+
+TEST_F(MidiOutputQueueTest, ChangeBackBeforeFlushIsDropped) {
+    m_queue.enqueue(0x90, 0x10, 0x7F);
+    flush();
+    m_queue.enqueue(0x90, 0x10, 0x00);
+    m_queue.enqueue(0x90, 0x10, 0x7F);
+    EXPECT_TRUE(flush().empty());
+}
+
+TEST_F(MidiOutputQueueTest, KeepsParameterNumberSequences) {
+    for (int i = 0; i < 2; ++i) {
+        m_queue.enqueue(0xB0, 0x63, 0x01);
+        m_queue.enqueue(0xB0, 0x62, static_cast<unsigned char>(i));
+        m_queue.enqueue(0xB0, 0x06, 0x7F);
+    }
+    m_queue.enqueue(0xC0, 0x05, 0x00);
+    m_queue.enqueue(0xC0, 0x05, 0x00);
+    EXPECT_EQ(8u, flush().size());
+}
+
+TEST_F(MidiOutputQueueTest, InvalidateSentState) {
+    m_queue.enqueue(0x90, 0x10, 0x7F);
+    m_queue.enqueue(0x90, 0x11, 0x7F);
+    flush();
+    m_queue.invalidateSentState(0x80, 0x10);
+    EXPECT_TRUE(m_queue.enqueue(0x90, 0x10, 0x7F));
+    EXPECT_FALSE(m_queue.enqueue(0x90, 0x11, 0x7F));
+    flush();
+    m_queue.invalidateSentState();
+    EXPECT_TRUE(m_queue.enqueue(0x90, 0x11, 0x7F));
+}
+
+} // anonymous namespace
@@ -32,8 +32,13 @@ class EffectsBenchmarkTest : public BaseEffectTest {
 
 template <class EffectType>
 void benchmarkBuiltInEffectDefaultParameters(const mixxx::EngineParameters& engineParameters,
-                                            benchmark::State* pState, EffectsManager* pEffectsManager) {
+                                            benchmark::State* pState, EffectsManager* pEffectsManager,
+                                            int oversamplingFactor = 0) {
     EffectManifestPointer pManifest = EffectType::getManifest();
+    if (oversamplingFactor > 0) {
+        // Overrides the factor of the effect
+        pManifest->setOversamplingFactor(oversamplingFactor);
+    }
 
     ChannelHandleFactory factory;
     QSet<ChannelHandleAndGroup> activeInputChannels;
@@ -80,6 +85,18 @@ void benchmarkBuiltInEffectDefaultParameters(const mixxx::EngineParameters& engi
     }                                                                                \
     FOR_COMMON_BUFFER_SIZES(BENCHMARK(BM_BuiltInEffects_DefaultParameters_##EffectName));
 
+#define DECLARE_OVERSAMPLED_EFFECT_BENCHMARK(EffectName, factor)                              \
+    TEST_F(EffectsBenchmarkTest,                                                            \
+            BM_BuiltInEffects_DefaultParameters_##EffectName##_Oversampled##factor##x) {    \
+        mixxx::EngineParameters engineParameters(                                           \
+                mixxx::audio::SampleRate(44100),                                            \
+                state.range_x());                                                           \
+        benchmarkBuiltInEffectDefaultParameters<EffectName>(                                \
+                engineParameters, &state, m_pEffectsManager, factor);                       \
+    }                                                                                       \
+    FOR_COMMON_BUFFER_SIZES(BENCHMARK(                                                      \
+            BM_BuiltInEffects_DefaultParameters_##EffectName##_Oversampled##factor##x));
+
 DECLARE_EFFECT_BENCHMARK(Bessel4LVMixEQEffect)
 DECLARE_EFFECT_BENCHMARK(Bessel8LVMixEQEffect)
 DECLARE_EFFECT_BENCHMARK(BitCrusherEffect)
@@ -92,5 +109,10 @@ DECLARE_EFFECT_BENCHMARK(MoogLadder4FilterEffect)
 DECLARE_EFFECT_BENCHMARK(PhaserEffect)
 DECLARE_EFFECT_BENCHMARK(ReverbEffect)
 
+DECLARE_OVERSAMPLED_EFFECT_BENCHMARK(BitCrusherEffect, 1)
+DECLARE_OVERSAMPLED_EFFECT_BENCHMARK(BitCrusherEffect, 2)
+DECLARE_OVERSAMPLED_EFFECT_BENCHMARK(MoogLadder4FilterEffect, 1)
+DECLARE_OVERSAMPLED_EFFECT_BENCHMARK(MoogLadder4FilterEffect, 4)
+
 }  // namespace
 #endif
@@ -0,0 +1,101 @@
+#include "engine/offlinerenderer.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "encoder/encoder.h"
+#include "test/signalpathtest.h"
+#include "util/sample.h"
+
+namespace {
+
+// Collects the rendered samples instead of encoding them
+class EncoderMock : public Encoder {
+  public:
+    int initEncoder(mixxx::audio::SampleRate sampleRate, QString* pUserErrorMessage) override {
+        Q_UNUSED(sampleRate);
+        Q_UNUSED(pUserErrorMessage);
+        return 0;
+    }
+    void encodeBuffer(const CSAMPLE* samples, const int size) override {
+        m_samples.insert(m_samples.end(), samples, samples + size);
+    }
+    void updateMetaData(const QString& artist, const QString& title, const QString& album) override {
+        Q_UNUSED(artist);
+        Q_UNUSED(title);
+        Q_UNUSED(album);
+    }
+    void flush() override {
+        ++m_flushCount;
+    }
+    void setEncoderSettings(const EncoderSettings& settings) override {
+        Q_UNUSED(settings);
+    }
+
+    std::vector<CSAMPLE> m_samples;
+    int m_flushCount = 0;
+};
+
+CSAMPLE sumAbs(const CSAMPLE* pBuffer, SINT numSamples) {
+    CSAMPLE sumL = 0;
+    CSAMPLE sumR = 0;
+    SampleUtil::sumAbsPerChannel(&sumL, &sumR, pBuffer, numSamples);
+    return sumL + sumR;
+}
+
+class OfflineRendererTest : public SignalPathTest {
+};
+
+TEST_F(OfflineRendererTest, ParseTimeline) {
+    OfflineRenderer::Timeline timeline;
+    QString errorMessage;
+    ASSERT_TRUE(OfflineRenderer::parseTimeline(
+            QStringLiteral("# Comment\n"
+                           "2 [Channel2] play 1\n"
+                           "\n"
+                           "0.5 [Channel1] rate 0.25\n"
+                           "0.5 [Channel1] play 1\n"),
+            mixxx::audio::SampleRate(44100),
+            &timeline,
+            &errorMessage));
+    ASSERT_EQ(3, timeline.size());
+    EXPECT_EQ(22050, timeline.at(0).frame);
+    EXPECT_EQ(ConfigKey(m_sGroup1, "rate"), timeline.at(0).key);
+    EXPECT_EQ(0.25, timeline.at(0).value);
+    EXPECT_EQ(ConfigKey(m_sGroup1, "play"), timeline.at(1).key);
+    EXPECT_EQ(88200, timeline.at(2).frame);
+
+    EXPECT_FALSE(OfflineRenderer::parseTimeline(QStringLiteral("1 [Channel1] play\n"),
+            mixxx::audio::SampleRate(44100),
+            &timeline,
+            &errorMessage));
+    EXPECT_TRUE(errorMessage.startsWith(QStringLiteral("Line 1")));
+}
+
+TEST_F(OfflineRendererTest, AppliesEventsAtTheirFrame) {
+    constexpr SINT kPlayFrame = 441;
+    OfflineRenderer::Timeline timeline;
+    timeline.append({kPlayFrame, ConfigKey(m_sGroup1, "play"), 1.0});
+
+    OfflineRenderer renderer(m_pEngineMaster);
+    renderer.setTimeline(timeline);
+    // The buffer ends before the event
+    ASSERT_EQ(kPlayFrame, renderer.renderBuffer(OfflineRenderer::kDefaultMaxFramesPerBuffer));
+    EXPECT_EQ(0.0, ControlObject::get(ConfigKey(m_sGroup1, "play")));
+    EXPECT_EQ(CSAMPLE_ZERO, sumAbs(renderer.output(), 2 * kPlayFrame));
+
+    EncoderMock encoder;
+    constexpr SINT kFrameCount = 44100;
+    renderer.render(kFrameCount, &encoder);
+    EXPECT_EQ(1.0, ControlObject::get(ConfigKey(m_sGroup1, "play")));
+    EXPECT_EQ(kPlayFrame + kFrameCount, renderer.renderedFrames());
+    ASSERT_EQ(static_cast<std::size_t>(2 * kFrameCount), encoder.m_samples.size());
+    EXPECT_EQ(1, encoder.m_flushCount);
+    // The readers have been waited for, so the sine is audible after the
+    // ramp at the start of the playback
+    EXPECT_LT(CSAMPLE_ZERO, sumAbs(&encoder.m_samples[kFrameCount], kFrameCount));
+    EXPECT_LT(0.0, renderer.realtimeFactor());
+}
+
+} // anonymous namespace
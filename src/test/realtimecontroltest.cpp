@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <QVector>
+
+#include "control/controlobject.h"
+#include "control/realtimecontrol.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+class RealtimeControlTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_key = ConfigKey("[Channel1]", "realtime");
+        m_pControl = std::make_unique<ControlObject>(m_key);
+        QObject::connect(m_pControl.get(),
+                &ControlObject::valueChanged,
+                [this](double value) {
+                    m_notifiedValues.append(value);
+                });
+    }
+
+    ConfigKey m_key;
+    std::unique_ptr<ControlObject> m_pControl;
+    QVector<double> m_notifiedValues;
+};
+
+TEST_F(RealtimeControlTest, SetIsVisibleImmediately) {
+    RealtimeControl realtimeControl(m_key);
+    realtimeControl.set(1.0);
+    EXPECT_DOUBLE_EQ(1.0, m_pControl->get());
+
+    m_pControl->set(2.0);
+    EXPECT_DOUBLE_EQ(2.0, realtimeControl.get());
+}
+
+TEST_F(RealtimeControlTest, NotificationsAreBatched) {
+    RealtimeControl realtimeControl(m_key);
+    realtimeControl.set(1.0);
+    realtimeControl.set(2.0);
+    realtimeControl.set(3.0);
+    EXPECT_TRUE(m_notifiedValues.isEmpty());
+
+    // Only the latest value is notified
+    RealtimeControl::notifyChangedControls();
+    EXPECT_EQ(QVector<double>{3.0}, m_notifiedValues);
+
+    // Nothing has changed since the last notification
+    RealtimeControl::notifyChangedControls();
+    EXPECT_EQ(QVector<double>{3.0}, m_notifiedValues);
+
+    // Setting the current value is a no-op
+    realtimeControl.set(3.0);
+    RealtimeControl::notifyChangedControls();
+    EXPECT_EQ(QVector<double>{3.0}, m_notifiedValues);
+}
+
+TEST_F(RealtimeControlTest, ControlOutlivesCreator) {
+    RealtimeControl realtimeControl(m_key);
+    m_pControl.reset();
+    realtimeControl.set(4.0);
+    EXPECT_DOUBLE_EQ(4.0, realtimeControl.get());
+    RealtimeControl::notifyChangedControls();
+}
+
+} // namespace
@@ -122,6 +122,71 @@ TEST_F(SampleUtilTest, addWithGain) {
     }
 }
 
+TEST_F(SampleUtilTest, addToBothWithRampingGain) {
+    for (int i : qAsConst(evenBuffers)) {
+        const int size = sizes[i];
+        CSAMPLE* src = buffers[i];
+        for (int s = 0; s < size; ++s) {
+            src[s] = static_cast<CSAMPLE>(s % 7) * 0.1f - 0.3f;
+        }
+        std::vector<CSAMPLE> dest1(size, 1.0f);
+        std::vector<CSAMPLE> dest2(size, 2.0f);
+        std::vector<CSAMPLE> expected1(size, 1.0f);
+        std::vector<CSAMPLE> expected2(size, 2.0f);
+        SampleUtil::addToBothWithRampingGain(
+                dest1.data(), 0.5f, 1.0f, dest2.data(), 0.0f, 0.25f, src, size);
+        SampleUtil::addWithRampingGain(expected1.data(), src, 0.5f, 1.0f, size);
+        SampleUtil::addWithRampingGain(expected2.data(), src, 0.0f, 0.25f, size);
+        for (int s = 0; s < size; ++s) {
+            EXPECT_FLOAT_EQ(expected1[s], dest1[s]);
+            EXPECT_FLOAT_EQ(expected2[s], dest2[s]);
+        }
+
+        // Without the second destination
+        SampleUtil::addToBothWithRampingGain(
+                dest1.data(), 1.0f, 1.0f, nullptr, 1.0f, 1.0f, src, size);
+        SampleUtil::addWithGain(expected1.data(), src, 1.0f, size);
+        for (int s = 0; s < size; ++s) {
+            EXPECT_FLOAT_EQ(expected1[s], dest1[s]);
+        }
+    }
+}
+
+TEST_F(SampleUtilTest, bufferSizeKernels) {
+    for (SINT size = 64 * 2; size <= 4096 * 2; size *= 2) {
+        const SampleUtil::BufferSizeKernels kernels = SampleUtil::bufferSizeKernels(size);
+        EXPECT_EQ(size, kernels.numSamples);
+        std::vector<CSAMPLE> src(size);
+        for (SINT s = 0; s < size; ++s) {
+            src[s] = static_cast<CSAMPLE>(s % 7) * 0.1f - 0.3f;
+        }
+        std::vector<CSAMPLE> dest1(size, 1.0f);
+        std::vector<CSAMPLE> dest2(size, 2.0f);
+        std::vector<CSAMPLE> expected1(size, 1.0f);
+        std::vector<CSAMPLE> expected2(size, 2.0f);
+
+        kernels.applyRampingGain(dest1.data(), 1.0f, 0.5f, size);
+        SampleUtil::applyRampingGain(expected1.data(), 1.0f, 0.5f, size);
+        kernels.addWithRampingGain(dest1.data(), src.data(), 0.0f, 0.75f, size);
+        SampleUtil::addWithRampingGain(expected1.data(), src.data(), 0.0f, 0.75f, size);
+        kernels.copyWithRampingGain(dest2.data(), src.data(), 0.25f, 0.5f, size);
+        SampleUtil::copyWithRampingGain(expected2.data(), src.data(), 0.25f, 0.5f, size);
+        kernels.addToBothWithRampingGain(
+                dest1.data(), 0.5f, 1.0f, dest2.data(), 0.0f, 0.25f, src.data(), size);
+        SampleUtil::addToBothWithRampingGain(expected1.data(),
+                0.5f,
+                1.0f,
+                expected2.data(),
+                0.0f,
+                0.25f,
+                src.data(),
+                size);
+        for (SINT s = 0; s < size; ++s) {
+            EXPECT_FLOAT_EQ(expected1[s], dest1[s]);
+            EXPECT_FLOAT_EQ(expected2[s], dest2[s]);
+        }
+    }
+}
 
 TEST_F(SampleUtilTest, add2WithGain) {
     for (int i = 0; i < buffers.size(); ++i) {
@@ -303,6 +368,26 @@ TEST_F(SampleUtilTest, sumAbsPerChannel) {
     }
 }
 
+TEST_F(SampleUtilTest, measureLevelsPerChannel) {
+    for (int i = 0; i < evenBuffers.size(); ++i) {
+        int j = evenBuffers[i];
+        CSAMPLE* buffer = buffers[j];
+        int size = sizes[j];
+        FillBuffer(buffer, -1.0f, size);
+        SampleUtil::applyAlternatingGain(buffer, 1.0, 2.0, size);
+        SampleUtil::ChannelLevels levelsL;
+        SampleUtil::ChannelLevels levelsR;
+        EXPECT_EQ(SampleUtil::CLIP_STATUS(SampleUtil::CLIPPING_RIGHT),
+                SampleUtil::measureLevelsPerChannel(&levelsL, &levelsR, buffer, size));
+        EXPECT_FLOAT_EQ(size / 2, levelsL.sumAbs);
+        EXPECT_FLOAT_EQ(size, levelsR.sumAbs);
+        EXPECT_FLOAT_EQ(size / 2, levelsL.sumSquares);
+        EXPECT_FLOAT_EQ(size * 2, levelsR.sumSquares);
+        EXPECT_FLOAT_EQ(1.0f, levelsL.peak);
+        EXPECT_FLOAT_EQ(2.0f, levelsR.peak);
+    }
+}
+
 TEST_F(SampleUtilTest, interleaveBuffer) {
     for (int i = 0; i < buffers.size(); ++i) {
         CSAMPLE* buffer = buffers[i];
@@ -553,6 +638,7 @@ static void BM_Copy2WithGain(benchmark::State& state) {
     CSAMPLE* buffer3 = SampleUtil::alloc(size);
     SampleUtil::fill(buffer3, 0.0f, size);
 
+    state.SetLabel(SampleUtil::simdInstructionSet());
     while(state.KeepRunning()) {
         SampleUtil::copy2WithGain(buffer, buffer2, 1.1f, buffer3, 1.1f, size);
     }
@@ -572,6 +658,7 @@ static void BM_Copy2WithRampingGain(benchmark::State& state) {
     CSAMPLE* buffer3 = SampleUtil::alloc(size);
     SampleUtil::fill(buffer3, 0.0f, size);
 
+    state.SetLabel(SampleUtil::simdInstructionSet());
     while(state.KeepRunning()) {
         SampleUtil::copy2WithRampingGain(buffer, buffer2, 1.1f, 1.2f, buffer3,
                                          1.1f, 1.2f, size);
@@ -583,4 +670,236 @@ static void BM_Copy2WithRampingGain(benchmark::State& state) {
 }
 BENCHMARK(BM_Copy2WithRampingGain)->Range(64, 4096);
 
+// The following benchmarks cover the multi-versioned functions. The label
+// shows the instruction set of the clones that are used on this CPU.
+
+static void BM_Copy8WithGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.0f, size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        SampleUtil::copy8WithGain(buffer,
+                buffer2, 1.1f, buffer2, 1.2f, buffer2, 1.3f, buffer2, 1.4f,
+                buffer2, 1.5f, buffer2, 1.6f, buffer2, 1.7f, buffer2, 1.8f,
+                size);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+}
+BENCHMARK(BM_Copy8WithGain)->Range(64, 4096);
+
+static void BM_Copy8WithRampingGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.0f, size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        SampleUtil::copy8WithRampingGain(buffer,
+                buffer2, 1.1f, 1.2f, buffer2, 1.2f, 1.3f,
+                buffer2, 1.3f, 1.4f, buffer2, 1.4f, 1.5f,
+                buffer2, 1.5f, 1.6f, buffer2, 1.6f, 1.7f,
+                buffer2, 1.7f, 1.8f, buffer2, 1.8f, 1.9f,
+                size);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+}
+BENCHMARK(BM_Copy8WithRampingGain)->Range(64, 4096);
+
+static void BM_ApplyRampingGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.5f, size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        SampleUtil::applyRampingGain(buffer, 1.0f, 0.999f, size);
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    SampleUtil::free(buffer);
+}
+BENCHMARK(BM_ApplyRampingGain)->Range(64, 4096);
+
+static void BM_CopyWithRampingGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.5f, size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        SampleUtil::copyWithRampingGain(buffer, buffer2, 1.1f, 1.2f, size);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+}
+BENCHMARK(BM_CopyWithRampingGain)->Range(64, 4096);
+
+static void BM_AddWithRampingGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.5f, size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        SampleUtil::addWithRampingGain(buffer, buffer2, 1.1f, 1.2f, size);
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+}
+BENCHMARK(BM_AddWithRampingGain)->Range(64, 4096);
+
+static void BM_BufferSizeKernelsApplyRampingGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.5f, size);
+    const SampleUtil::BufferSizeKernels kernels = SampleUtil::bufferSizeKernels(size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        kernels.applyRampingGain(buffer, 1.0f, 0.999f, size);
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    SampleUtil::free(buffer);
+}
+BENCHMARK(BM_BufferSizeKernelsApplyRampingGain)->RangeMultiplier(2)->Range(128, 4096);
+
+static void BM_AddToBothWithRampingGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.0f, size);
+    CSAMPLE* buffer3 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer3, 0.5f, size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        SampleUtil::addToBothWithRampingGain(
+                buffer, 1.1f, 1.2f, buffer2, 0.5f, 0.4f, buffer3, size);
+        benchmark::DoNotOptimize(buffer);
+        benchmark::DoNotOptimize(buffer2);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+    SampleUtil::free(buffer3);
+}
+BENCHMARK(BM_AddToBothWithRampingGain)->RangeMultiplier(2)->Range(128, 4096);
+
+static void BM_BufferSizeKernelsAddToBothWithRampingGain(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.0f, size);
+    CSAMPLE* buffer3 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer3, 0.5f, size);
+    const SampleUtil::BufferSizeKernels kernels = SampleUtil::bufferSizeKernels(size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        kernels.addToBothWithRampingGain(
+                buffer, 1.1f, 1.2f, buffer2, 0.5f, 0.4f, buffer3, size);
+        benchmark::DoNotOptimize(buffer);
+        benchmark::DoNotOptimize(buffer2);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+    SampleUtil::free(buffer3);
+}
+BENCHMARK(BM_BufferSizeKernelsAddToBothWithRampingGain)->RangeMultiplier(2)->Range(128, 4096);
+
+static void BM_SumAbsPerChannel(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.5f, size);
+    CSAMPLE absL;
+    CSAMPLE absR;
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(
+                SampleUtil::sumAbsPerChannel(&absL, &absR, buffer, size));
+    }
+
+    SampleUtil::free(buffer);
+}
+BENCHMARK(BM_SumAbsPerChannel)->Range(64, 4096);
+
+static void BM_CopyClampBuffer(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 1.5f, size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        SampleUtil::copyClampBuffer(buffer, buffer2, size);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+}
+BENCHMARK(BM_CopyClampBuffer)->Range(64, 4096);
+
+static void BM_InterleaveBuffer(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size * 2);
+    SampleUtil::fill(buffer, 0.0f, size * 2);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.5f, size);
+    CSAMPLE* buffer3 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer3, -0.5f, size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        SampleUtil::interleaveBuffer(buffer, buffer2, buffer3, size);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+    SampleUtil::free(buffer3);
+}
+BENCHMARK(BM_InterleaveBuffer)->Range(64, 4096);
+
+static void BM_DeinterleaveBuffer(benchmark::State& state) {
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size * 2);
+    SampleUtil::fill(buffer, 0.5f, size * 2);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.0f, size);
+    CSAMPLE* buffer3 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer3, 0.0f, size);
+
+    state.SetLabel(SampleUtil::simdInstructionSet());
+    while (state.KeepRunning()) {
+        SampleUtil::deinterleaveBuffer(buffer2, buffer3, buffer, size);
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+    SampleUtil::free(buffer3);
+}
+BENCHMARK(BM_DeinterleaveBuffer)->Range(64, 4096);
+
 }  // namespace
@@ -845,6 +845,20 @@ TEST_F(SearchQueryParserTest, CrateFilterEmpty) {
                  qPrintable(pQuery->toSql()));
 }
 
+TEST_F(SearchQueryParserTest, MatchesTrackValuesOnly) {
+    QStringList searchColumns;
+    searchColumns << "artist";
+
+    EXPECT_TRUE(m_parser.parseQuery(QString("bpm:>120 -abba"), searchColumns, "")
+                        ->matchesTrackValuesOnly());
+    // Crate memberships are not part of the track values
+    EXPECT_FALSE(m_parser.parseQuery(QString("bpm:>120 -crate:test"), searchColumns, "")
+                         ->matchesTrackValuesOnly());
+    // Neither is arbitrary SQL
+    EXPECT_FALSE(m_parser.parseQuery(QString("abba"), searchColumns, "bpm > 120")
+                         ->matchesTrackValuesOnly());
+}
+
 // Checks if the crate filter works with quoted text with whitespaces
 TEST_F(SearchQueryParserTest, CrateFilterQuote){
     // User's search term
@@ -199,6 +199,40 @@ TEST_F(SeratoTagsTest, CueColorConversionRoundtrip) {
     }
 }
 
+TEST_F(SeratoTagsTest, Markers2LazyParsing) {
+    const auto filetype = mixxx::taglib::FileType::MP3;
+    QDir dir(MixxxTest::getOrInitTestDir().filePath(QStringLiteral("serato/data/mp3/markers2/")));
+    dir.setFilter(QDir::Files);
+    dir.setNameFilters(QStringList() << "*.octet-stream");
+    const QFileInfoList fileList = dir.entryInfoList();
+    for (const QFileInfo& fileInfo : fileList) {
+        auto file = QFile(fileInfo.filePath());
+        const bool openOk = file.open(QIODevice::ReadOnly);
+        EXPECT_TRUE(openOk);
+        const QByteArray inputData = file.readAll();
+
+        mixxx::SeratoTags parsedSeratoTags;
+        const bool parseOk = parsedSeratoTags.parseMarkers2(inputData, filetype);
+        EXPECT_TRUE(parseOk);
+
+        mixxx::SeratoTags lazySeratoTags;
+        lazySeratoTags.setMarkers2Data(inputData, filetype);
+        EXPECT_TRUE(lazySeratoTags.hasUnparsedFrames());
+        EXPECT_FALSE(lazySeratoTags.isEmpty());
+
+        // Comparing undecoded tags must not decode them
+        const mixxx::SeratoTags lazySeratoTagsCopy = lazySeratoTags;
+        EXPECT_EQ(lazySeratoTagsCopy, lazySeratoTags);
+        EXPECT_NE(mixxx::SeratoTags(), lazySeratoTags);
+        EXPECT_TRUE(lazySeratoTags.hasUnparsedFrames());
+
+        EXPECT_EQ(parsedSeratoTags.getCueInfos(), lazySeratoTags.getCueInfos());
+        EXPECT_FALSE(lazySeratoTags.hasUnparsedFrames());
+        EXPECT_EQ(parsedSeratoTags.isBpmLocked(), lazySeratoTagsCopy.isBpmLocked());
+        EXPECT_EQ(inputData, lazySeratoTagsCopy.dumpMarkers2(filetype));
+    }
+}
+
 TEST_F(SeratoTagsTest, MarkersParseDumpRoundtrip) {
     const auto filetype = mixxx::taglib::FileType::MP3;
     QDir dir(MixxxTest::getOrInitTestDir().filePath(QStringLiteral("/serato/data/mp3/markers_/")));
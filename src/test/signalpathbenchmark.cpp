@@ -0,0 +1,256 @@
+#include <benchmark/benchmark.h>
+
+#include <QThread>
+#include <memory>
+#include <vector>
+
+#include "effects/effectsmanager.h"
+#include "mixer/sampler.h"
+#include "test/signalpathtest.h"
+
+// Benchmarks of EngineMaster::process() with the whole signal path, i.e.
+// reading, scaling, mixing and effects. The first argument is the buffer
+// size in frames, the optional second argument selects a variant of the
+// scenario as shown in the label. Besides the time per buffer, each
+// benchmark reports how many times faster than realtime the engine runs
+// as "realtime".
+//
+// The results can be compared between builds or machines:
+//   mixxx-test --benchmark --benchmark_filter=BM_SignalPath
+//           --benchmark_out=before.json --benchmark_out_format=json
+//   lib/benchmark/tools/compare.py benchmarks before.json after.json
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+constexpr int kNumSamplers = 4;
+constexpr int kNumEffectUnits = 4;
+constexpr int kNumEffectsPerUnit = 3;
+
+// Buffers processed before measuring, so the readers have read the chunks
+// around the play positions and the scalers are primed
+constexpr int kWarmUpBuffers = 16;
+
+class SignalPathBenchmark : public BaseSignalPathTest {
+  public:
+    using BaseSignalPathTest::getRateSliderValue;
+    using BaseSignalPathTest::m_sGroup1;
+    using BaseSignalPathTest::m_sGroup2;
+
+    SignalPathBenchmark() {
+        const QString trackLocation = getTestDir().filePath(QStringLiteral("sine-30.wav"));
+        m_pTrack = Track::newTemporary(trackLocation);
+        m_pTrack->trySetBpm(120.0);
+        loadTrack(m_pMixerDeck1, m_pTrack);
+        loadTrack(m_pMixerDeck2, m_pTrack);
+        loadTrack(m_pMixerDeck3, m_pTrack);
+    }
+
+    ~SignalPathBenchmark() override {
+        m_samplers.clear();
+    }
+
+    // Starts the first numDecks decks, which repeat the track forever
+    void play(int numDecks) {
+        const QString groups[] = {m_sGroup1, m_sGroup2, m_sGroup3};
+        for (int i = 0; i < numDecks && i < 3; ++i) {
+            ControlObject::set(ConfigKey(groups[i], "repeat"), 1.0);
+            ControlObject::set(ConfigKey(groups[i], "play"), 1.0);
+        }
+    }
+
+    void addSamplers() {
+        for (int i = 0; i < kNumSamplers; ++i) {
+            const QString group = QStringLiteral("[Sampler%1]").arg(i + 1);
+            auto pSampler = std::make_unique<Sampler>(nullptr,
+                    m_pConfig,
+                    m_pEngineMaster,
+                    m_pEffectsManager,
+                    EngineChannel::CENTER,
+                    m_pEngineMaster->registerChannelGroup(group));
+            ControlObject::set(ConfigKey(group, "master"), 1.0);
+            loadTrack(pSampler.get(), m_pTrack);
+            m_samplers.push_back(std::move(pSampler));
+        }
+    }
+
+    void triggerSamplers() {
+        for (int i = 0; i < kNumSamplers; ++i) {
+            const QString group = QStringLiteral("[Sampler%1]").arg(i + 1);
+            ControlObject::set(ConfigKey(group, "repeat"), 1.0);
+            ControlObject::set(ConfigKey(group, "cue_gotoandplay"), 1.0);
+        }
+    }
+
+    // Enables all effects of all standard effect units for the decks
+    void enableEffectUnits(int numDecks) {
+        m_pEffectsManager->setup();
+        const QString groups[] = {m_sGroup1, m_sGroup2, m_sGroup3};
+        for (int unit = 1; unit <= kNumEffectUnits; ++unit) {
+            const QString unitGroup = QStringLiteral("[EffectRack1_EffectUnit%1]").arg(unit);
+            ControlObject::set(ConfigKey(unitGroup, "mix"), 1.0);
+            for (int i = 0; i < numDecks && i < 3; ++i) {
+                ControlObject::set(ConfigKey(unitGroup,
+                                           QStringLiteral("group_%1_enable").arg(groups[i])),
+                        1.0);
+            }
+            for (int effect = 1; effect <= kNumEffectsPerUnit; ++effect) {
+                const QString effectGroup = QStringLiteral("[EffectRack1_EffectUnit%1_Effect%2]")
+                                                    .arg(QString::number(unit),
+                                                            QString::number(effect));
+                if (ControlObject::get(ConfigKey(effectGroup, "loaded")) == 0.0) {
+                    ControlObject::set(ConfigKey(effectGroup, "next_effect"), 1.0);
+                }
+                ControlObject::set(ConfigKey(effectGroup, "enabled"), 1.0);
+            }
+        }
+    }
+
+    void run(benchmark::State* pState) {
+        const int framesPerBuffer = static_cast<int>(pState->range(0));
+        const int samplesPerBuffer = 2 * framesPerBuffer;
+        for (int i = 0; i < kWarmUpBuffers; ++i) {
+            processAndWaitForReaders(samplesPerBuffer);
+        }
+        for (auto _ : *pState) {
+            m_pEngineMaster->process(samplesPerBuffer);
+        }
+        const double frames = static_cast<double>(pState->iterations()) * framesPerBuffer;
+        pState->SetItemsProcessed(static_cast<int64_t>(frames));
+        pState->counters["realtime"] = benchmark::Counter(
+                frames / kSampleRate, benchmark::Counter::kIsRate);
+    }
+
+    // Only used for the fixture
+    void TestBody() override {
+    }
+
+  private:
+    void processAndWaitForReaders(int samplesPerBuffer) {
+        m_pEngineMaster->process(samplesPerBuffer);
+        for (int i = 0; i < 1000; ++i) {
+            if (m_pEngineMaster->wakeWorkersAndCheckReadersIdle()) {
+                break;
+            }
+            QThread::usleep(100);
+        }
+        application()->processEvents();
+    }
+
+    TrackPointer m_pTrack;
+    std::vector<std::unique_ptr<Sampler>> m_samplers;
+};
+
+void applyBufferSizes(benchmark::internal::Benchmark* pBenchmark) {
+    for (int frames = 32; frames <= 4096; frames *= 2) {
+        pBenchmark->Arg(frames);
+    }
+}
+
+void applyBufferSizesAndVariants(benchmark::internal::Benchmark* pBenchmark, int numVariants) {
+    for (int variant = 0; variant < numVariants; ++variant) {
+        for (int frames = 32; frames <= 4096; frames *= 2) {
+            pBenchmark->Args({frames, variant});
+        }
+    }
+}
+
+} // anonymous namespace
+
+// The second argument is the number of playing decks
+static void BM_SignalPath_DecksPlaying(benchmark::State& state) {
+    SignalPathBenchmark benchmark;
+    const int numDecks = static_cast<int>(state.range(1));
+    benchmark.play(numDecks);
+    state.SetLabel(QStringLiteral("%1 decks").arg(numDecks).toStdString());
+    benchmark.run(&state);
+}
+BENCHMARK(BM_SignalPath_DecksPlaying)->Apply([](benchmark::internal::Benchmark* pBenchmark) {
+    for (int numDecks = 0; numDecks <= 3; ++numDecks) {
+        for (int frames = 32; frames <= 4096; frames *= 2) {
+            pBenchmark->Args({frames, numDecks});
+        }
+    }
+});
+
+// The second argument is the EngineBuffer::KeylockEngine
+static void BM_SignalPath_Keylock(benchmark::State& state) {
+    SignalPathBenchmark benchmark;
+    const auto engine = static_cast<EngineBuffer::KeylockEngine>(state.range(1));
+    ControlObject::set(ConfigKey("[Master]", "keylock_engine"), static_cast<double>(engine));
+    ControlObject::set(ConfigKey(SignalPathBenchmark::m_sGroup1, "keylock"), 1.0);
+    ControlObject::set(ConfigKey(SignalPathBenchmark::m_sGroup1, "rate"),
+            benchmark.getRateSliderValue(1.05));
+    benchmark.play(1);
+    switch (engine) {
+    case EngineBuffer::KeylockEngine::SoundTouch:
+        state.SetLabel("SoundTouch");
+        break;
+    case EngineBuffer::KeylockEngine::RubberBandFaster:
+        state.SetLabel("RubberBand faster");
+        break;
+    case EngineBuffer::KeylockEngine::RubberBandFiner:
+        state.SetLabel("RubberBand finer");
+        break;
+    default:
+        break;
+    }
+    benchmark.run(&state);
+}
+BENCHMARK(BM_SignalPath_Keylock)->Apply([](benchmark::internal::Benchmark* pBenchmark) {
+    applyBufferSizesAndVariants(pBenchmark, 3);
+});
+
+// Two decks with different tempos, the second follows the first
+static void BM_SignalPath_Sync(benchmark::State& state) {
+    SignalPathBenchmark benchmark;
+    ControlObject::set(ConfigKey(SignalPathBenchmark::m_sGroup2, "rate"),
+            benchmark.getRateSliderValue(1.03));
+    ControlObject::set(ConfigKey(SignalPathBenchmark::m_sGroup1, "sync_leader"), 1.0);
+    ControlObject::set(ConfigKey(SignalPathBenchmark::m_sGroup2, "sync_enabled"), 1.0);
+    benchmark.play(2);
+    benchmark.run(&state);
+}
+BENCHMARK(BM_SignalPath_Sync)->Apply(applyBufferSizes);
+
+// A loop of a single beat, which is shorter than most of the buffers
+static void BM_SignalPath_Loop(benchmark::State& state) {
+    SignalPathBenchmark benchmark;
+    ControlObject::set(ConfigKey(SignalPathBenchmark::m_sGroup1, "loop_start_position"), 0.0);
+    // One beat at 120 BPM in stereo samples
+    ControlObject::set(ConfigKey(SignalPathBenchmark::m_sGroup1, "loop_end_position"),
+            kSampleRate);
+    ControlObject::set(ConfigKey(SignalPathBenchmark::m_sGroup1, "reloop_toggle"), 1.0);
+    benchmark.play(1);
+    benchmark.run(&state);
+}
+BENCHMARK(BM_SignalPath_Loop)->Apply(applyBufferSizes);
+
+// All effects of all effect units, the second argument is the number of
+// playing decks that are routed through them
+static void BM_SignalPath_EffectUnits(benchmark::State& state) {
+    SignalPathBenchmark benchmark;
+    const int numDecks = static_cast<int>(state.range(1));
+    benchmark.enableEffectUnits(numDecks);
+    benchmark.play(numDecks);
+    state.SetLabel(QStringLiteral("%1 decks").arg(numDecks).toStdString());
+    benchmark.run(&state);
+}
+BENCHMARK(BM_SignalPath_EffectUnits)->Apply([](benchmark::internal::Benchmark* pBenchmark) {
+    for (int numDecks = 1; numDecks <= 2; ++numDecks) {
+        for (int frames = 32; frames <= 4096; frames *= 2) {
+            pBenchmark->Args({frames, numDecks});
+        }
+    }
+});
+
+// Triggered samplers besides a playing deck
+static void BM_SignalPath_Samplers(benchmark::State& state) {
+    SignalPathBenchmark benchmark;
+    benchmark.addSamplers();
+    benchmark.play(1);
+    benchmark.triggerSamplers();
+    state.SetLabel(QStringLiteral("%1 samplers").arg(kNumSamplers).toStdString());
+    benchmark.run(&state);
+}
+BENCHMARK(BM_SignalPath_Samplers)->Apply(applyBufferSizes);
@@ -0,0 +1,188 @@
+#include <benchmark/benchmark.h>
+
+#include <QUrl>
+#include <random>
+
+#include "sources/soundsourceproxy.h"
+#include "test/mixxxtest.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track.h"
+#include "util/samplebuffer.h"
+
+// Benchmarks for decoding the reference files with each provider that
+// supports them. The first argument selects the file and the second
+// argument the provider, i.e. run with --benchmark_filter=BM_SoundSource
+// and compare the labels.
+
+namespace {
+
+const QString kFileNameSuffixes[] = {
+        QStringLiteral(".aiff"),
+        QStringLiteral("-alac.caf"),
+        QStringLiteral(".flac"),
+        QStringLiteral("-itunes-12.7.0-aac.m4a"),
+        QStringLiteral("-itunes-12.7.0-alac.m4a"),
+        QStringLiteral("-vbr.mp3"),
+        QStringLiteral(".ogg"),
+        QStringLiteral(".opus"),
+        QStringLiteral(".wav"),
+        QStringLiteral(".wv"),
+};
+
+constexpr int kFileCount = sizeof(kFileNameSuffixes) / sizeof(kFileNameSuffixes[0]);
+
+// Upper bound for the number of providers that support the same file type
+constexpr int kMaxProviderCount = 4;
+
+// Similar to the chunks that are read by CachingReaderWorker
+constexpr SINT kReadFrameCount = 8192;
+
+class SoundSourceBenchmark : private SoundSourceProviderRegistration {
+  public:
+    explicit SoundSourceBenchmark(benchmark::State* pState) {
+        const QString& fileNameSuffix = kFileNameSuffixes[pState->range(0)];
+        if (!SoundSourceProxy::isFileNameSupported(fileNameSuffix)) {
+            pState->SkipWithError("Unsupported file type");
+            return;
+        }
+        m_filePath = MixxxTest::getOrInitTestDir().filePath(
+                QStringLiteral("id3-test-data/cover-test") + fileNameSuffix);
+        const auto providerRegistrations =
+                SoundSourceProxy::allProviderRegistrationsForUrl(
+                        QUrl::fromLocalFile(m_filePath));
+        const auto providerIndex = static_cast<int>(pState->range(1));
+        if (providerIndex >= providerRegistrations.size()) {
+            pState->SkipWithError("No provider");
+            return;
+        }
+        m_pProvider = providerRegistrations[providerIndex].getProvider();
+        pState->SetLabel(
+                (fileNameSuffix + QChar(' ') + m_pProvider->getDisplayName())
+                        .toStdString());
+    }
+
+    bool isValid() const {
+        return m_pProvider != nullptr;
+    }
+
+    mixxx::AudioSourcePointer openAudioSource() const {
+        auto pTrack = Track::newTemporary(m_filePath);
+        SoundSourceProxy proxy(pTrack, m_pProvider);
+        return proxy.openAudioSource();
+    }
+
+  private:
+    QString m_filePath;
+    mixxx::SoundSourceProviderPointer m_pProvider;
+};
+
+mixxx::IndexRange readSampleFrames(
+        const mixxx::AudioSourcePointer& pAudioSource,
+        mixxx::IndexRange frameIndexRange,
+        mixxx::SampleBuffer* pBuffer) {
+    return pAudioSource
+            ->readSampleFrames(mixxx::WritableSampleFrames(
+                    frameIndexRange,
+                    mixxx::SampleBuffer::WritableSlice(
+                            pBuffer->data(),
+                            pAudioSource->getSignalInfo().frames2samples(
+                                    frameIndexRange.length()))))
+            .frameIndexRange();
+}
+
+void applyFileAndProviderArguments(benchmark::internal::Benchmark* pBenchmark) {
+    for (int file = 0; file < kFileCount; ++file) {
+        for (int provider = 0; provider < kMaxProviderCount; ++provider) {
+            pBenchmark->Args({file, provider});
+        }
+    }
+}
+
+} // anonymous namespace
+
+// Reports the decoded frames per second as items per second
+static void BM_SoundSourceSequentialDecoding(benchmark::State& state) {
+    SoundSourceBenchmark soundSource(&state);
+    if (!soundSource.isValid()) {
+        return;
+    }
+    const auto pAudioSource = soundSource.openAudioSource();
+    if (!pAudioSource) {
+        state.SkipWithError("Failed to open file");
+        return;
+    }
+    mixxx::SampleBuffer buffer(
+            pAudioSource->getSignalInfo().frames2samples(kReadFrameCount));
+    const auto frameIndexRange = pAudioSource->frameIndexRange();
+    SINT decodedFrames = 0;
+    while (state.KeepRunning()) {
+        SINT frameIndex = frameIndexRange.start();
+        while (frameIndex < frameIndexRange.end()) {
+            const auto readRange = readSampleFrames(pAudioSource,
+                    mixxx::IndexRange::forward(frameIndex,
+                            std::min(kReadFrameCount, frameIndexRange.end() - frameIndex)),
+                    &buffer);
+            if (readRange.empty()) {
+                break;
+            }
+            frameIndex = readRange.end();
+            decodedFrames += readRange.length();
+        }
+    }
+    state.SetItemsProcessed(decodedFrames);
+}
+BENCHMARK(BM_SoundSourceSequentialDecoding)->Apply(applyFileAndProviderArguments);
+
+// Reads a chunk at a random position in each iteration
+static void BM_SoundSourceRandomSeek(benchmark::State& state) {
+    SoundSourceBenchmark soundSource(&state);
+    if (!soundSource.isValid()) {
+        return;
+    }
+    const auto pAudioSource = soundSource.openAudioSource();
+    if (!pAudioSource) {
+        state.SkipWithError("Failed to open file");
+        return;
+    }
+    mixxx::SampleBuffer buffer(
+            pAudioSource->getSignalInfo().frames2samples(kReadFrameCount));
+    const auto frameIndexRange = pAudioSource->frameIndexRange();
+    const SINT readFrameCount = std::min(kReadFrameCount, frameIndexRange.length());
+    // The same positions for all files and providers
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<SINT> distribution(
+            frameIndexRange.start(), frameIndexRange.end() - readFrameCount);
+    while (state.KeepRunning()) {
+        readSampleFrames(pAudioSource,
+                mixxx::IndexRange::forward(distribution(generator), readFrameCount),
+                &buffer);
+    }
+}
+BENCHMARK(BM_SoundSourceRandomSeek)->Apply(applyFileAndProviderArguments);
+
+// Opens the file and reads the first chunk in each iteration
+static void BM_SoundSourceFirstFrame(benchmark::State& state) {
+    SoundSourceBenchmark soundSource(&state);
+    if (!soundSource.isValid()) {
+        return;
+    }
+    mixxx::SampleBuffer buffer;
+    while (state.KeepRunning()) {
+        const auto pAudioSource = soundSource.openAudioSource();
+        if (!pAudioSource) {
+            state.SkipWithError("Failed to open file");
+            return;
+        }
+        const auto frameIndexRange = pAudioSource->frameIndexRange();
+        const SINT readFrameCount = std::min(kReadFrameCount, frameIndexRange.length());
+        const SINT sampleCount =
+                pAudioSource->getSignalInfo().frames2samples(readFrameCount);
+        if (buffer.size() < sampleCount) {
+            buffer = mixxx::SampleBuffer(sampleCount);
+        }
+        readSampleFrames(pAudioSource,
+                mixxx::IndexRange::forward(frameIndexRange.start(), readFrameCount),
+                &buffer);
+    }
+}
+BENCHMARK(BM_SoundSourceFirstFrame)->Apply(applyFileAndProviderArguments);
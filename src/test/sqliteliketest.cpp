@@ -1,4 +1,8 @@
 #include <gtest/gtest.h>
+
+#include <QSqlQuery>
+
+#include "test/mixxxdbtest.h"
 #include "util/db/dbconnection.h"
 
 
@@ -49,3 +53,30 @@ TEST_F(SqliteLikeTest, PatternTest) {
     esc = '\0';
     EXPECT_FALSE(mixxx::DbConnection::likeCompareLatinLow(&pattern, &string, esc));
 }
+
+class SqliteLikeQueryTest : public MixxxDbTest {
+  protected:
+    SqliteLikeQueryTest()
+            : MixxxDbTest(true) {
+    }
+
+    bool like(const QString& string, const QString& pattern) const {
+        QSqlQuery query(dbConnection());
+        query.prepare(QStringLiteral("SELECT :string LIKE :pattern"));
+        query.bindValue(QStringLiteral(":string"), string);
+        query.bindValue(QStringLiteral(":pattern"), pattern);
+        EXPECT_TRUE(query.exec());
+        EXPECT_TRUE(query.next());
+        return query.value(0).toBool();
+    }
+};
+
+TEST_F(SqliteLikeQueryTest, AsciiAndLatinStrings) {
+    // ASCII pattern and string are compared without decomposition
+    EXPECT_TRUE(like(QStringLiteral("Sven Vath"), QStringLiteral("%VATH%")));
+    EXPECT_FALSE(like(QStringLiteral("Sven Vath"), QStringLiteral("%vaht%")));
+    // Mixed ASCII and non-ASCII operands
+    EXPECT_TRUE(like(QString::fromUtf8("Sven Väth"), QStringLiteral("%vath%")));
+    EXPECT_TRUE(like(QStringLiteral("Sven Vath"), QString::fromUtf8("%väth%")));
+    EXPECT_FALSE(like(QString::fromUtf8("Tiësto"), QString::fromUtf8("%ä%")));
+}
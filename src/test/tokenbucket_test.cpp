@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "util/tokenbucket.h"
+
+namespace {
+
+TEST(TokenBucketTest, burstUpToCapacity) {
+    mixxx::TokenBucket bucket(1.0, 3.0);
+    EXPECT_EQ(0, bucket.takeToken(0));
+    EXPECT_EQ(0, bucket.takeToken(0));
+    EXPECT_EQ(0, bucket.takeToken(0));
+    EXPECT_EQ(1000, bucket.takeToken(0));
+}
+
+TEST(TokenBucketTest, reservedTokensDelayLaterEvents) {
+    mixxx::TokenBucket bucket(2.0, 1.0);
+    EXPECT_EQ(0, bucket.takeToken(100));
+    EXPECT_EQ(500, bucket.takeToken(100));
+    EXPECT_EQ(1000, bucket.takeToken(100));
+    // The reserved tokens are used up after waiting
+    EXPECT_EQ(0, bucket.takeToken(1600));
+}
+
+TEST(TokenBucketTest, refillIsLimitedToCapacity) {
+    mixxx::TokenBucket bucket(1.0, 2.0);
+    EXPECT_EQ(0, bucket.takeToken(0));
+    EXPECT_EQ(0, bucket.takeToken(60000));
+    EXPECT_EQ(0, bucket.takeToken(60000));
+    EXPECT_EQ(1000, bucket.takeToken(60000));
+}
+
+TEST(TokenBucketTest, timeGoingBackwardsDoesNotRefill) {
+    mixxx::TokenBucket bucket(1.0, 1.0);
+    EXPECT_EQ(0, bucket.takeToken(5000));
+    EXPECT_EQ(1000, bucket.takeToken(1000));
+}
+
+} // namespace
@@ -0,0 +1,61 @@
+#include "util/tracerecorder.h"
+
+#include <gtest/gtest.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include "util/time.h"
+
+namespace {
+
+TEST(TraceRecorderTest, WriteChromeTrace) {
+    mixxx::TraceRecorder::enable();
+    mixxx::TraceRecorder::setCurrentThreadName(QStringLiteral("TraceRecorderTest"));
+    const auto now = mixxx::Time::elapsed();
+    mixxx::TraceRecorder::record("TraceRecorderTest old",
+            now - mixxx::Duration::fromSeconds(21),
+            now - mixxx::Duration::fromSeconds(20));
+    mixxx::TraceRecorder::record("TraceRecorderTest recent",
+            now - mixxx::Duration::fromMillis(2),
+            now - mixxx::Duration::fromMillis(1));
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.filePath(QStringLiteral("trace.json"));
+    ASSERT_TRUE(mixxx::TraceRecorder::writeChromeTrace(
+            filePath, mixxx::Duration::fromSeconds(10)));
+
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+    ASSERT_TRUE(document.isObject());
+
+    int threadTid = -1;
+    int recentCount = 0;
+    int oldCount = 0;
+    const QJsonArray events = document.object().value(QStringLiteral("traceEvents")).toArray();
+    for (const auto& value : events) {
+        const QJsonObject event = value.toObject();
+        const QString name = event.value(QStringLiteral("name")).toString();
+        if (name == QStringLiteral("thread_name") &&
+                event.value(QStringLiteral("args")).toObject().value(QStringLiteral("name")) ==
+                        QStringLiteral("TraceRecorderTest")) {
+            threadTid = event.value(QStringLiteral("tid")).toInt();
+        } else if (name == QStringLiteral("TraceRecorderTest recent")) {
+            ++recentCount;
+            EXPECT_EQ(QStringLiteral("X"), event.value(QStringLiteral("ph")).toString());
+            EXPECT_DOUBLE_EQ(1000.0, event.value(QStringLiteral("dur")).toDouble());
+            EXPECT_EQ(threadTid, event.value(QStringLiteral("tid")).toInt());
+        } else if (name == QStringLiteral("TraceRecorderTest old")) {
+            ++oldCount;
+        }
+    }
+    EXPECT_NE(-1, threadTid);
+    EXPECT_EQ(1, recentCount);
+    EXPECT_EQ(0, oldCount);
+}
+
+} // anonymous namespace
@@ -0,0 +1,87 @@
+#include "library/trackcolumnstore.h"
+
+#include <gtest/gtest.h>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+TEST(TrackColumnStoreTest, preserveTypesAndNulls) {
+    TrackColumnStore store(4);
+    const int row = store.insertRow(TrackId(1));
+    store.setValue(row, 0, QVariant(42));
+    store.setValue(row, 1, QVariant(128.5));
+    store.setValue(row, 2, QVariant(QStringLiteral("Artist")));
+    store.setValue(row, 3, QVariant(true));
+
+    EXPECT_EQ(QVariant(42), store.value(row, 0));
+    EXPECT_EQ(QMetaType::Int, store.value(row, 0).userType());
+    EXPECT_EQ(QVariant(128.5), store.value(row, 1));
+    EXPECT_EQ(QVariant(QStringLiteral("Artist")), store.value(row, 2));
+    EXPECT_EQ(QMetaType::Bool, store.value(row, 3).userType());
+    EXPECT_FALSE(store.value(row, 4).isValid());
+
+    // Nulls keep the type of the column
+    const int otherRow = store.insertRow(TrackId(2));
+    EXPECT_NE(row, otherRow);
+    store.setValue(otherRow, 2, QVariant(QString()));
+    EXPECT_TRUE(store.value(otherRow, 2).isNull());
+    EXPECT_EQ(QMetaType::QString, store.value(otherRow, 2).userType());
+    EXPECT_TRUE(store.value(otherRow, 0).isNull());
+}
+
+TEST(TrackColumnStoreTest, mixedTypes) {
+    TrackColumnStore store(1);
+    const int row1 = store.insertRow(TrackId(1));
+    const int row2 = store.insertRow(TrackId(2));
+    store.setValue(row1, 0, QVariant(2020));
+    store.setValue(row2, 0, QVariant(QStringLiteral("2021-01")));
+
+    EXPECT_EQ(QVariant(2020), store.value(row1, 0));
+    EXPECT_EQ(QVariant(QStringLiteral("2021-01")), store.value(row2, 0));
+}
+
+TEST(TrackColumnStoreTest, reuseRemovedRows) {
+    TrackColumnStore store(1);
+    const int row = store.insertRow(TrackId(1));
+    store.setValue(row, 0, QVariant(QStringLiteral("Title")));
+    EXPECT_EQ(row, store.rowOf(TrackId(1)));
+    EXPECT_EQ(row, store.insertRow(TrackId(1)));
+
+    store.removeRow(TrackId(1));
+    EXPECT_FALSE(store.contains(TrackId(1)));
+    EXPECT_EQ(-1, store.rowOf(TrackId(1)));
+    EXPECT_EQ(0, store.size());
+
+    // The new row must not contain the values of the removed row
+    EXPECT_EQ(row, store.insertRow(TrackId(2)));
+    EXPECT_TRUE(store.value(row, 0).isNull());
+}
+
+TEST(TrackColumnStoreTest, sortKeys) {
+    TrackColumnStore store(1);
+    const int row1 = store.insertRow(TrackId(1));
+    const int row2 = store.insertRow(TrackId(2));
+    store.setValue(row1, 0, QVariant(QStringLiteral("abc")));
+    store.setValue(row2, 0, QVariant(QStringLiteral("ABD")));
+
+    EXPECT_LT(store.sortKey(row1, 0).compare(store.sortKey(row2, 0)), 0);
+    EXPECT_GT(store.sortKeyOf(QStringLiteral("b")).compare(store.sortKey(row2, 0)), 0);
+}
+
+TEST(TrackColumnStoreTest, memoryUsage) {
+    TrackColumnStore store(1);
+    const qint64 emptyUsage = store.memoryUsage();
+    const int row = store.insertRow(TrackId(1));
+    store.setValue(row, 0, QVariant(QStringLiteral("A long title of a track")));
+    const qint64 usage = store.memoryUsage();
+    EXPECT_GT(usage, emptyUsage);
+
+    // Interned strings are kept until the store is cleared
+    store.removeRow(TrackId(1));
+    EXPECT_GE(store.memoryUsage(), usage);
+    store.clear();
+    EXPECT_LT(store.memoryUsage(), usage);
+}
+
+} // namespace
@@ -56,3 +56,44 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, detectMovedTracksByAudioDigest) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+
+    // Neither the file name nor the duration match
+    mixxx::FileInfo oldFile(QDir(QDir::tempPath() + QStringLiteral("/old/dir1")),
+            QStringLiteral("file.mp3"));
+    mixxx::FileInfo newFile(QDir(QDir::tempPath() + QStringLiteral("/new/dir2")),
+            QStringLiteral("renamed.mp3"));
+
+    TrackPointer pOldTrack = Track::newTemporary(mixxx::FileAccess(oldFile));
+    TrackPointer pNewTrack = Track::newTemporary(mixxx::FileAccess(newFile));
+    pOldTrack->setDuration(135);
+    pNewTrack->setDuration(140);
+
+    TrackId oldId = internalCollection()->addTrack(pOldTrack, false);
+    TrackId newId = internalCollection()->addTrack(pNewTrack, false);
+
+    QSqlQuery query(dbConnection());
+    query.prepare("UPDATE library SET audio_digest='0123456789abcdef' WHERE id IN (:id1,:id2)");
+    query.bindValue(":id1", oldId.toVariant());
+    query.bindValue(":id2", newId.toVariant());
+    ASSERT_TRUE(query.exec());
+
+    // Mark as missing
+    query.prepare("UPDATE track_locations SET fs_deleted=1 WHERE location=:location");
+    query.bindValue(":location", oldFile.location());
+    ASSERT_TRUE(query.exec());
+
+    QList<RelocatedTrack> relocatedTracks;
+    QStringList addedTracks(newFile.location());
+    bool cancel = false;
+    EXPECT_TRUE(trackDAO.detectMovedTracks(&relocatedTracks, addedTracks, &cancel));
+
+    ASSERT_EQ(1, relocatedTracks.size());
+    EXPECT_EQ(oldId, relocatedTracks.first().updatedTrackRef().getId());
+    EXPECT_EQ(newId, relocatedTracks.first().deletedTrackId());
+
+    QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
+    EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location()));
+}
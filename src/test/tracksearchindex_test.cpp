@@ -0,0 +1,80 @@
+#include "library/tracksearchindex.h"
+
+#include <gtest/gtest.h>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+class TrackSearchIndexTest : public testing::Test {
+  protected:
+    TrackSearchIndexTest()
+            : m_index(QStringList{QStringLiteral("artist"), QStringLiteral("title")}) {
+        m_index.updateTrack(TrackId(1),
+                QStringList{QStringLiteral("Daft Punk"), QStringLiteral("Around the World")});
+        m_index.updateTrack(TrackId(2),
+                QStringList{QStringLiteral("Röyksopp"), QStringLiteral("Eple")});
+        m_index.updateTrack(TrackId(3),
+                QStringList{QString(), QStringLiteral("Untitled")});
+        m_allTracks = QSet<TrackId>{TrackId(1), TrackId(2), TrackId(3)};
+    }
+
+    TrackSearchIndex m_index;
+    QSet<TrackId> m_allTracks;
+};
+
+TEST_F(TrackSearchIndexTest, matchText) {
+    const QStringList columns{QStringLiteral("artist"), QStringLiteral("title")};
+    EXPECT_EQ(QSet<TrackId>{TrackId(1)},
+            m_index.matchText(columns, QStringLiteral("WORLD"), m_allTracks));
+    // Short arguments without trigrams
+    EXPECT_EQ((QSet<TrackId>{TrackId(1), TrackId(3)}),
+            m_index.matchText(columns, QStringLiteral("t"), m_allTracks));
+    // Latin characters are folded
+    EXPECT_EQ(QSet<TrackId>{TrackId(2)},
+            m_index.matchText(columns, QStringLiteral("royk"), m_allTracks));
+    // Only the given columns and candidates
+    EXPECT_EQ(QSet<TrackId>(),
+            m_index.matchText(QStringList{QStringLiteral("artist")},
+                    QStringLiteral("world"),
+                    m_allTracks));
+    EXPECT_EQ(QSet<TrackId>(),
+            m_index.matchText(columns, QStringLiteral("world"), QSet<TrackId>{TrackId(2)}));
+    // A trailing space must be followed by another character
+    EXPECT_EQ(QSet<TrackId>{TrackId(1)},
+            m_index.matchText(columns, QStringLiteral("daft "), m_allTracks));
+    EXPECT_EQ(QSet<TrackId>(),
+            m_index.matchText(columns, QStringLiteral("punk "), m_allTracks));
+}
+
+TEST_F(TrackSearchIndexTest, fallback) {
+    EXPECT_FALSE(m_index.matchText(QStringList{QStringLiteral("genre")},
+            QStringLiteral("house"),
+            m_allTracks));
+    EXPECT_FALSE(m_index.matchText(QStringList{QStringLiteral("title")},
+            QStringLiteral("a%b"),
+            m_allTracks));
+}
+
+TEST_F(TrackSearchIndexTest, matchNullOrEmpty) {
+    EXPECT_EQ(QSet<TrackId>{TrackId(3)},
+            m_index.matchNullOrEmpty(QStringLiteral("artist"), m_allTracks));
+}
+
+TEST_F(TrackSearchIndexTest, updateAndRemove) {
+    const QStringList columns{QStringLiteral("title")};
+    m_index.updateTrack(TrackId(1),
+            QStringList{QStringLiteral("Daft Punk"), QStringLiteral("One More Time")});
+    EXPECT_EQ(QSet<TrackId>(),
+            m_index.matchText(columns, QStringLiteral("world"), m_allTracks));
+    EXPECT_EQ(QSet<TrackId>{TrackId(1)},
+            m_index.matchText(columns, QStringLiteral("more"), m_allTracks));
+
+    m_index.removeTrack(TrackId(1));
+    EXPECT_FALSE(m_index.contains(TrackId(1)));
+    EXPECT_EQ(2, m_index.size());
+    EXPECT_EQ(QSet<TrackId>(),
+            m_index.matchText(columns, QStringLiteral("more"), m_allTracks));
+}
+
+} // namespace
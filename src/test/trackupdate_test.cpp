@@ -148,3 +148,19 @@ TEST_F(TrackUpdateTest, parseModifiedDirtyAgain) {
 }
 
 // TODO: Add tests for SoundSourceProxy::UpdateTrackFromSourceMode::Newer
+
+TEST_F(TrackUpdateTest, recordSnapshotFollowsModifications) {
+    auto pTrack = newTestTrackParsed();
+
+    const auto pSnapshotBefore = pTrack->getRecordSnapshot();
+    ASSERT_EQ(pTrack->getRecord(), *pSnapshotBefore);
+
+    const QString artistBefore = pTrack->getArtist();
+    pTrack->setArtist(artistBefore + artistBefore);
+
+    // A previously obtained snapshot must never change
+    const auto pSnapshotAfter = pTrack->getRecordSnapshot();
+    EXPECT_EQ(artistBefore, pSnapshotBefore->getMetadata().getTrackInfo().getArtist());
+    EXPECT_EQ(pTrack->getArtist(), pSnapshotAfter->getMetadata().getTrackInfo().getArtist());
+    EXPECT_EQ(pTrack->getRecord(), *pSnapshotAfter);
+}
@@ -0,0 +1,90 @@
+#include "waveform/waveform.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+class WaveformTest : public testing::Test {
+  protected:
+    WaveformTest()
+            // 1000 visual frames with 2 channels
+            : m_waveform(44100, 2 * 44100 * 10, 100, -1) {
+    }
+
+    Waveform m_waveform;
+};
+
+TEST_F(WaveformTest, MipLevels) {
+    const int dataSize = m_waveform.getDataSize();
+    ASSERT_LT(2, m_waveform.getMipLevelCount());
+    WaveformData* data = m_waveform.data();
+    for (int i = 0; i < dataSize; ++i) {
+        data[i].filtered.low = static_cast<unsigned char>(i % 256);
+        data[i].filtered.mid = 0;
+        data[i].filtered.high = 0;
+        data[i].filtered.all = static_cast<unsigned char>(i % 256);
+    }
+
+    // Only the first 2 frames of the full resolution data
+    // have been analyzed
+    m_waveform.setCompletion(4);
+    const WaveformData* level1 = m_waveform.getMipLevelData(1);
+    EXPECT_EQ(2, level1[0].filtered.low);
+    EXPECT_EQ(3, level1[1].filtered.low);
+    EXPECT_EQ(0, level1[2].filtered.low);
+
+    // The incomplete last frame of each level is updated
+    m_waveform.setCompletion(6);
+    EXPECT_EQ(4, level1[2].filtered.low);
+    m_waveform.setCompletion(8);
+    EXPECT_EQ(6, level1[2].filtered.low);
+    EXPECT_EQ(7, level1[3].filtered.all);
+
+    m_waveform.setCompletion(dataSize);
+    const WaveformData* level2 = m_waveform.getMipLevelData(2);
+    EXPECT_EQ(6, level2[0].filtered.low);
+    EXPECT_EQ(7, level2[1].filtered.low);
+    EXPECT_EQ(14, level2[2].filtered.low);
+    EXPECT_EQ((m_waveform.getMipLevelDataSize(1) / 2 + 1) / 2 * 2,
+            m_waveform.getMipLevelDataSize(2));
+}
+
+TEST_F(WaveformTest, MipLevelForVisualFramesPerPixel) {
+    EXPECT_EQ(0, m_waveform.getMipLevelForVisualFramesPerPixel(0.5));
+    EXPECT_EQ(0, m_waveform.getMipLevelForVisualFramesPerPixel(1.9));
+    EXPECT_EQ(1, m_waveform.getMipLevelForVisualFramesPerPixel(2.0));
+    EXPECT_EQ(2, m_waveform.getMipLevelForVisualFramesPerPixel(5.0));
+    EXPECT_EQ(m_waveform.getMipLevelCount() - 1,
+            m_waveform.getMipLevelForVisualFramesPerPixel(1e9));
+}
+
+TEST_F(WaveformTest, ChunkedByteArray) {
+    const int dataSize = m_waveform.getDataSize();
+    WaveformData* data = m_waveform.data();
+    for (int i = 0; i < dataSize; ++i) {
+        data[i].filtered.low = static_cast<unsigned char>(i % 251);
+        data[i].filtered.mid = static_cast<unsigned char>(i % 7);
+        data[i].filtered.high = static_cast<unsigned char>(255 - i % 13);
+        data[i].filtered.all = static_cast<unsigned char>(i / 8);
+    }
+    m_waveform.setCompletion(dataSize);
+    const QByteArray byteArray = m_waveform.toByteArray();
+
+    Waveform deferred(byteArray, Waveform::Decoding::Deferred);
+    EXPECT_EQ(dataSize, deferred.getDataSize());
+    EXPECT_EQ(0, deferred.getCompletion());
+    deferred.decodeDeferredChunks();
+    EXPECT_EQ(dataSize, deferred.getCompletion());
+
+    const Waveform immediate(byteArray);
+    EXPECT_EQ(dataSize, immediate.getCompletion());
+    EXPECT_EQ(m_waveform.getAudioVisualRatio(), immediate.getAudioVisualRatio());
+    for (int i = 0; i < dataSize; ++i) {
+        ASSERT_EQ(data[i].m_i, immediate.get(i).m_i);
+        ASSERT_EQ(data[i].m_i, deferred.get(i).m_i);
+    }
+    EXPECT_EQ(m_waveform.getMipLevelData(1)[10].m_i,
+            immediate.getMipLevelData(1)[10].m_i);
+}
+
+} // anonymous namespace
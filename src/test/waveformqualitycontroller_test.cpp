@@ -0,0 +1,65 @@
+#include "waveform/waveformqualitycontroller.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+const mixxx::Duration kFrameBudget = mixxx::Duration::fromMillis(16);
+const mixxx::Duration kOverloadedRenderTime = mixxx::Duration::fromMillis(15);
+const mixxx::Duration kIdleRenderTime = mixxx::Duration::fromMillis(2);
+
+TEST(WaveformQualityControllerTest, ReduceAndRestore) {
+    WaveformQualityController controller;
+    EXPECT_EQ(0, controller.reduction());
+
+    int frames = 0;
+    while (controller.reduction() < WaveformQualityController::kMaxReduction) {
+        controller.process(kOverloadedRenderTime, kFrameBudget, 0.0);
+        ASSERT_LT(++frames, 1000);
+    }
+    EXPECT_FALSE(controller.useAntialiasing());
+    EXPECT_EQ(8.0, controller.resolutionDivisor());
+
+    // Never reduced beyond the maximum
+    controller.process(kOverloadedRenderTime, kFrameBudget, 0.0);
+    EXPECT_EQ(WaveformQualityController::kMaxReduction, controller.reduction());
+
+    // Restoring takes more frames than reducing
+    int restoreFrames = 0;
+    while (controller.reduction() == WaveformQualityController::kMaxReduction) {
+        controller.process(kIdleRenderTime, kFrameBudget, 0.0);
+        ASSERT_LT(++restoreFrames, 1000);
+    }
+    EXPECT_LT(frames / WaveformQualityController::kMaxReduction, restoreFrames);
+}
+
+TEST(WaveformQualityControllerTest, AudioLatencyUsage) {
+    WaveformQualityController controller;
+    for (int i = 0; i < 100; ++i) {
+        controller.process(kIdleRenderTime, kFrameBudget, 0.9);
+    }
+    EXPECT_LT(0, controller.reduction());
+
+    // No headroom while the engine is still busy
+    const int reduction = controller.reduction();
+    for (int i = 0; i < 1000; ++i) {
+        controller.process(kIdleRenderTime, kFrameBudget, 0.5);
+    }
+    EXPECT_EQ(reduction, controller.reduction());
+}
+
+TEST(WaveformQualityControllerTest, Disabled) {
+    WaveformQualityController controller;
+    for (int i = 0; i < 100; ++i) {
+        controller.process(kOverloadedRenderTime, kFrameBudget, 0.0);
+    }
+    EXPECT_LT(0, controller.reduction());
+    controller.setEnabled(false);
+    EXPECT_EQ(0, controller.reduction());
+    for (int i = 0; i < 100; ++i) {
+        controller.process(kOverloadedRenderTime, kFrameBudget, 0.0);
+    }
+    EXPECT_EQ(0, controller.reduction());
+}
+
+} // anonymous namespace
@@ -0,0 +1,283 @@
+#include <benchmark/benchmark.h>
+
+#include <QDomDocument>
+#include <QImage>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "skin/legacy/skincontext.h"
+#include "test/mixxxtest.h"
+#include "track/track.h"
+#include "waveform/renderers/qtwaveformrendererfilteredsignal.h"
+#include "waveform/renderers/qtwaveformrenderersimplesignal.h"
+#include "waveform/renderers/waveformrendererfilteredsignal.h"
+#include "waveform/renderers/waveformrendererhsv.h"
+#include "waveform/renderers/waveformrendererrgb.h"
+#include "waveform/renderers/waveformwidgetrenderer.h"
+#include "waveform/visualplayposition.h"
+#include "waveform/vsyncthread.h"
+#include "waveform/waveform.h"
+#include "waveform/waveformwidgetfactory.h"
+
+#if !defined(QT_NO_OPENGL) && !defined(QT_OPENGL_ES_2)
+#include <QGLFramebufferObject>
+#include <QGLWidget>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+
+#include "waveform/renderers/glslwaveformrenderersignal.h"
+#include "waveform/renderers/glwaveformrendererfilteredsignal.h"
+#include "waveform/renderers/glwaveformrendererrgb.h"
+#include "waveform/renderers/glwaveformrenderersimplesignal.h"
+#endif
+
+// Benchmarks of the signal renderers of the scrolling waveforms with a
+// synthetic waveform. Each iteration renders one frame while the play
+// position sweeps through the track at the normal playback speed of a
+// 60 Hz display. The first argument is the zoom factor of the waveform.
+//
+// The real time per frame includes waiting for the GPU for the GL renderers,
+// while the CPU time only covers issuing the drawing commands. The GL
+// renderers need an OpenGL context and are skipped if none is available:
+//   mixxx-test --benchmark --benchmark_filter=BM_WaveformRenderer
+
+namespace {
+
+const QString kGroup = QStringLiteral("[Channel1]");
+
+constexpr int kWidth = 1920;
+constexpr int kHeight = 200;
+
+constexpr int kSampleRate = 44100;
+constexpr int kTrackSeconds = 300;
+// The same visual sample rate as the main waveform of AnalyzerWaveform
+constexpr int kVisualSampleRate = 441;
+constexpr double kFrameSeconds = 1.0 / 60;
+// Like a buffer of 1024 frames, only required for
+// VisualPlayPosition
+constexpr double kAudioBufferSizeMillis = 23.0;
+
+const char* kWaveformSetup =
+        "<WaveformDisplay>"
+        "<BgColor>#000000</BgColor>"
+        "<SignalColor>#FF8000</SignalColor>"
+        "<SignalLowColor>#FF0000</SignalLowColor>"
+        "<SignalMidColor>#00FF00</SignalMidColor>"
+        "<SignalHighColor>#0000FF</SignalHighColor>"
+        "<AxesColor>#FFFFFF</AxesColor>"
+        "<PlayPosColor>#FFFFFF</PlayPosColor>"
+        "</WaveformDisplay>";
+
+// Fills the waveform with bands that change at different rates, so
+// neighboring pixels differ like in real music
+WaveformPointer createSyntheticWaveform() {
+    auto pWaveform = WaveformPointer(new Waveform(kSampleRate,
+            kSampleRate * kTrackSeconds * 2,
+            kVisualSampleRate,
+            -1));
+    WaveformData* pData = pWaveform->data();
+    const int dataSize = pWaveform->getDataSize();
+    for (int i = 0; i < dataSize; ++i) {
+        const double t = static_cast<double>(i) / dataSize;
+        const auto band = [t](double frequency) {
+            return static_cast<unsigned char>(
+                    127.5 + 127.5 * std::sin(2 * M_PI * frequency * t));
+        };
+        pData[i].filtered.low = band(400.0);
+        pData[i].filtered.mid = band(2300.0);
+        pData[i].filtered.high = band(9700.0);
+        pData[i].filtered.all = std::max(
+                {pData[i].filtered.low, pData[i].filtered.mid, pData[i].filtered.high});
+    }
+    pWaveform->setCompletion(dataSize);
+    return pWaveform;
+}
+
+class WaveformRendererBenchmark : public MixxxTest {
+  public:
+    WaveformRendererBenchmark()
+            : m_context(config(), QString()),
+              m_vsyncThread(nullptr),
+              m_playPosition(0.0) {
+        // The controls read by WaveformWidgetRenderer and the signal renderers
+        m_controls.push_back(std::make_unique<ControlObject>(
+                ConfigKey(QStringLiteral("[Master]"), QStringLiteral("audio_buffer_size"))));
+        m_controls.back()->set(kAudioBufferSizeMillis);
+        for (const auto& item : {
+                     QStringLiteral("track_samples"),
+                     QStringLiteral("rate_ratio"),
+                     QStringLiteral("total_gain"),
+                     QStringLiteral("filterWaveformEnable"),
+                     QStringLiteral("filterLow"),
+                     QStringLiteral("filterMid"),
+                     QStringLiteral("filterHigh"),
+                     QStringLiteral("filterLowKill"),
+                     QStringLiteral("filterMidKill"),
+                     QStringLiteral("filterHighKill"),
+             }) {
+            m_controls.push_back(std::make_unique<ControlObject>(ConfigKey(kGroup, item)));
+            m_controls.back()->set(1.0);
+        }
+        ControlObject::set(ConfigKey(kGroup, QStringLiteral("filterWaveformEnable")), 0.0);
+        ControlObject::set(ConfigKey(kGroup, QStringLiteral("filterLowKill")), 0.0);
+        ControlObject::set(ConfigKey(kGroup, QStringLiteral("filterMidKill")), 0.0);
+        ControlObject::set(ConfigKey(kGroup, QStringLiteral("filterHighKill")), 0.0);
+        ControlObject::set(ConfigKey(kGroup, QStringLiteral("track_samples")),
+                kSampleRate * kTrackSeconds * 2);
+
+        m_pTrack = Track::newTemporary();
+        m_pTrack->setWaveform(createSyntheticWaveform());
+        m_pVisualPlayPosition = VisualPlayPosition::getVisualPlayPosition(kGroup);
+        WaveformWidgetFactory::createInstance();
+    }
+
+    ~WaveformRendererBenchmark() override {
+        m_pRenderer.reset();
+        WaveformWidgetFactory::destroy();
+    }
+
+    template<class T_Renderer>
+    void createRenderer(double zoom) {
+        m_pRenderer = std::make_unique<WaveformWidgetRenderer>(kGroup);
+        m_pRenderer->addRenderer<T_Renderer>();
+        m_pRenderer->init();
+        QDomDocument document;
+        document.setContent(QString::fromLatin1(kWaveformSetup));
+        m_pRenderer->setup(document.documentElement(), m_context);
+        m_pRenderer->resize(kWidth, kHeight, 1.0f);
+        m_pRenderer->setTrack(m_pTrack);
+        m_pRenderer->setZoom(zoom);
+    }
+
+    // Advances the play position by one display frame and renders it
+    void renderFrame(QPainter* pPainter) {
+        m_playPosition += kFrameSeconds / kTrackSeconds;
+        if (m_playPosition >= 1.0) {
+            m_playPosition = 0.0;
+        }
+        m_pVisualPlayPosition->set(m_playPosition,
+                1.0,
+                0.0,
+                m_playPosition,
+                kTrackSeconds);
+        m_pRenderer->onPreRender(&m_vsyncThread);
+        m_pRenderer->draw(pPainter, nullptr);
+    }
+
+    // Only used for the fixture
+    void TestBody() override {
+    }
+
+  private:
+    SkinContext m_context;
+    VSyncThread m_vsyncThread;
+    std::vector<std::unique_ptr<ControlObject>> m_controls;
+    TrackPointer m_pTrack;
+    QSharedPointer<VisualPlayPosition> m_pVisualPlayPosition;
+    std::unique_ptr<WaveformWidgetRenderer> m_pRenderer;
+    double m_playPosition;
+};
+
+template<class T_Renderer>
+void runSoftwareRenderer(benchmark::State* pState) {
+    WaveformRendererBenchmark fixture;
+    fixture.createRenderer<T_Renderer>(static_cast<double>(pState->range(0)));
+    QImage image(kWidth, kHeight, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    for (auto _ : *pState) {
+        image.fill(Qt::black);
+        fixture.renderFrame(&painter);
+    }
+    pState->counters["fps"] = benchmark::Counter(
+            static_cast<double>(pState->iterations()), benchmark::Counter::kIsRate);
+}
+
+#if !defined(QT_NO_OPENGL) && !defined(QT_OPENGL_ES_2)
+template<class T_Renderer>
+void runGLRenderer(benchmark::State* pState) {
+    WaveformRendererBenchmark fixture;
+    QGLWidget glWidget;
+    glWidget.makeCurrent();
+    if (!glWidget.isValid() || !QOpenGLContext::currentContext()) {
+        pState->SkipWithError("No OpenGL context available");
+        return;
+    }
+    fixture.createRenderer<T_Renderer>(static_cast<double>(pState->range(0)));
+    QGLFramebufferObject framebuffer(kWidth, kHeight);
+    QOpenGLFunctions* pFunctions = QOpenGLContext::currentContext()->functions();
+    QPainter painter(&framebuffer);
+    for (auto _ : *pState) {
+        painter.fillRect(0, 0, kWidth, kHeight, Qt::black);
+        fixture.renderFrame(&painter);
+        // Include the time the GPU needs for rendering the frame
+        painter.beginNativePainting();
+        pFunctions->glFinish();
+        painter.endNativePainting();
+    }
+    pState->counters["fps"] = benchmark::Counter(
+            static_cast<double>(pState->iterations()), benchmark::Counter::kIsRate);
+}
+#endif
+
+void applyZoomFactors(benchmark::internal::Benchmark* pBenchmark) {
+    // The minimum, default and maximum zoom factor
+    pBenchmark->Arg(1)->Arg(3)->Arg(10)->Unit(benchmark::kMicrosecond);
+}
+
+} // anonymous namespace
+
+static void BM_WaveformRenderer_RGB(benchmark::State& state) {
+    runSoftwareRenderer<WaveformRendererRGB>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_RGB)->Apply(applyZoomFactors);
+
+static void BM_WaveformRenderer_HSV(benchmark::State& state) {
+    runSoftwareRenderer<WaveformRendererHSV>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_HSV)->Apply(applyZoomFactors);
+
+static void BM_WaveformRenderer_Filtered(benchmark::State& state) {
+    runSoftwareRenderer<WaveformRendererFilteredSignal>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_Filtered)->Apply(applyZoomFactors);
+
+static void BM_WaveformRenderer_QtFiltered(benchmark::State& state) {
+    runSoftwareRenderer<QtWaveformRendererFilteredSignal>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_QtFiltered)->Apply(applyZoomFactors);
+
+static void BM_WaveformRenderer_QtSimple(benchmark::State& state) {
+    runSoftwareRenderer<QtWaveformRendererSimpleSignal>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_QtSimple)->Apply(applyZoomFactors);
+
+#if !defined(QT_NO_OPENGL) && !defined(QT_OPENGL_ES_2)
+static void BM_WaveformRenderer_GLRGB(benchmark::State& state) {
+    runGLRenderer<GLWaveformRendererRGB>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_GLRGB)->Apply(applyZoomFactors);
+
+static void BM_WaveformRenderer_GLFiltered(benchmark::State& state) {
+    runGLRenderer<GLWaveformRendererFilteredSignal>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_GLFiltered)->Apply(applyZoomFactors);
+
+static void BM_WaveformRenderer_GLSimple(benchmark::State& state) {
+    runGLRenderer<GLWaveformRendererSimpleSignal>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_GLSimple)->Apply(applyZoomFactors);
+
+static void BM_WaveformRenderer_GLSLFiltered(benchmark::State& state) {
+    runGLRenderer<GLSLWaveformRendererFilteredSignal>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_GLSLFiltered)->Apply(applyZoomFactors);
+
+static void BM_WaveformRenderer_GLSLRGB(benchmark::State& state) {
+    runGLRenderer<GLSLWaveformRendererRGBSignal>(&state);
+}
+BENCHMARK(BM_WaveformRenderer_GLSLRGB)->Apply(applyZoomFactors);
+#endif
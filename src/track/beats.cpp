@@ -1,5 +1,6 @@
 #include "track/beats.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iterator>
 #include <vector>
@@ -25,16 +26,16 @@ constexpr double kEpsilon = 0.01;
 namespace mixxx {
 
 mixxx::audio::FrameDiff_t Beats::ConstIterator::beatLengthFrames() const {
-    if (m_it == m_beats->m_markers.cend()) {
+    if (m_it == m_beats->markers().cend()) {
         return m_beats->lastBeatLengthFrames();
     }
 
     const auto nextMarker = std::next(m_it);
     const mixxx::audio::FramePos nextMarkerPosition =
-            (nextMarker != m_beats->m_markers.cend())
-            ? nextMarker->position()
+            (nextMarker != m_beats->markers().cend())
+            ? m_beats->markerPosition(*nextMarker)
             : m_beats->m_lastMarkerPosition;
-    return (nextMarkerPosition - m_it->position()) / m_it->beatsTillNextMarker();
+    return (nextMarkerPosition - m_beats->markerPosition(*m_it)) / m_it->beatsTillNextMarker();
 }
 
 Beats::ConstIterator Beats::ConstIterator::operator+=(Beats::ConstIterator::difference_type n) {
@@ -65,16 +66,23 @@ Beats::ConstIterator Beats::ConstIterator::operator+=(Beats::ConstIterator::diff
     if (beatOffset < m_beatOffset) {
         qWarning() << "Beats: Iterator would go out of possible range, capping "
                       "at latest possible position.";
-        m_it = m_beats->m_markers.cend();
+        m_it = m_beats->markers().cend();
         m_beatOffset = std::numeric_limits<Beats::ConstIterator::difference_type>::max();
         updateValue();
         return *this;
     }
 
     m_beatOffset = beatOffset;
-    while (m_it != m_beats->m_markers.cend() && m_beatOffset >= m_it->beatsTillNextMarker()) {
-        m_beatOffset -= m_it->beatsTillNextMarker();
-        m_it++;
+    if (m_it != m_beats->markers().cend() && m_beatOffset >= m_it->beatsTillNextMarker()) {
+        // Jump to the last marker at or before the target beat
+        const qint64 beatIndex = m_beats->markerBeatIndex(m_it) + m_beatOffset;
+        const auto& indices = m_beats->m_pMarkerSet->beatIndices;
+        const auto indexIt = std::prev(std::upper_bound(
+                indices.cbegin() + (m_it - m_beats->markers().cbegin()),
+                indices.cend(),
+                beatIndex));
+        m_it = m_beats->markers().cbegin() + (indexIt - indices.cbegin());
+        m_beatOffset = static_cast<int>(beatIndex - *indexIt);
     }
     updateValue();
     return *this;
@@ -108,16 +116,26 @@ Beats::ConstIterator Beats::ConstIterator::operator-=(Beats::ConstIterator::diff
     if (beatOffset > m_beatOffset) {
         qWarning() << "Beats: Iterator would go out of possible range, capping "
                       "at earliest possible position.";
-        m_it = m_beats->m_markers.cbegin();
+        m_it = m_beats->markers().cbegin();
         m_beatOffset = std::numeric_limits<Beats::ConstIterator::difference_type>::lowest();
         updateValue();
         return *this;
     }
 
     m_beatOffset = beatOffset;
-    while (m_it != m_beats->m_markers.cbegin() && m_beatOffset < 0) {
-        m_it--;
-        m_beatOffset += m_it->beatsTillNextMarker();
+    if (m_it != m_beats->markers().cbegin() && m_beatOffset < 0) {
+        // Jump to the last marker at or before the target beat, or to the
+        // first marker if the target beat lies before it.
+        const qint64 beatIndex = m_beats->markerBeatIndex(m_it) + m_beatOffset;
+        const auto& indices = m_beats->m_pMarkerSet->beatIndices;
+        auto indexIt = std::upper_bound(indices.cbegin(),
+                indices.cbegin() + (m_it - m_beats->markers().cbegin()),
+                beatIndex);
+        if (indexIt != indices.cbegin()) {
+            indexIt--;
+        }
+        m_it = m_beats->markers().cbegin() + (indexIt - indices.cbegin());
+        m_beatOffset = static_cast<int>(beatIndex - *indexIt);
     }
     updateValue();
     return *this;
@@ -125,32 +143,32 @@ Beats::ConstIterator Beats::ConstIterator::operator-=(Beats::ConstIterator::diff
 
 Beats::ConstIterator::difference_type Beats::ConstIterator::operator-(
         const Beats::ConstIterator& other) const {
-    const int vectorItDiff = m_it - other.m_it;
-    if (vectorItDiff == 0) {
+    if (m_it == other.m_it) {
         return m_beatOffset - other.m_beatOffset;
     }
-
-    if (vectorItDiff > 0) {
-        return -(other - *this);
-    }
-
-    auto it = m_it;
-    int result = -m_beatOffset + other.m_beatOffset;
-    while (it != m_beats->m_markers.cend() && it != other.m_it) {
-        result += it->beatsTillNextMarker();
-        it++;
-    }
-    DEBUG_ASSERT(it == other.m_it);
-    return -result;
+    return static_cast<difference_type>(
+            m_beats->markerBeatIndex(m_it) + m_beatOffset -
+            (m_beats->markerBeatIndex(other.m_it) + other.m_beatOffset));
 }
 
 void Beats::ConstIterator::updateValue() {
-    const auto position = (m_it != m_beats->m_markers.cend())
-            ? m_it->position()
+    const auto position = (m_it != m_beats->markers().cend())
+            ? m_beats->markerPosition(*m_it)
             : m_beats->m_lastMarkerPosition;
     m_value = position + m_beatOffset * beatLengthFrames();
 }
 
+Beats::MarkerSet::MarkerSet(std::vector<BeatMarker> markers)
+        : markers(std::move(markers)) {
+    beatIndices.reserve(this->markers.size() + 1);
+    qint64 beatIndex = 0;
+    for (const auto& marker : this->markers) {
+        beatIndices.push_back(beatIndex);
+        beatIndex += marker.beatsTillNextMarker();
+    }
+    beatIndices.push_back(beatIndex);
+}
+
 // static
 mixxx::BeatsPointer Beats::fromConstTempo(
         mixxx::audio::SampleRate sampleRate,
@@ -444,7 +462,22 @@ Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
         }
         it -= static_cast<int>(n);
     } else {
-        it = std::lower_bound(cfirstmarker(), clastmarker() + 1, position);
+        // Find the section between two markers that contains the position
+        // and search for the beat only in there.
+        // The shared markers are not translated, so search for the
+        // untranslated position instead.
+        const auto markerSetPosition = position - m_markerOffsetFrames;
+        const auto nextMarkerIt = std::upper_bound(markers().cbegin(),
+                markers().cend(),
+                markerSetPosition,
+                [](audio::FramePos position, const BeatMarker& marker) {
+                    return position < marker.position();
+                });
+        const auto sectionEnd = ConstIterator(this, nextMarkerIt, 0);
+        const auto sectionBegin = (nextMarkerIt == markers().cbegin())
+                ? sectionEnd
+                : ConstIterator(this, std::prev(nextMarkerIt), 0);
+        it = std::lower_bound(sectionBegin, sectionEnd, position);
     }
     DEBUG_ASSERT(it == cbegin() || it == cend() || *it >= position);
     DEBUG_ASSERT(it == cbegin() || it == cend() ||
@@ -512,13 +545,13 @@ mixxx::Bpm Beats::getBpmInRange(audio::FramePos startPosition, audio::FramePos e
         return {};
     }
 
-    if (m_markers.empty() || startPosition >= m_lastMarkerPosition) {
+    if (markers().empty() || startPosition >= m_lastMarkerPosition) {
         return m_lastMarkerBpm;
     }
 
     std::unordered_map<int, audio::FrameDiff_t> map;
 
-    auto markerIt = m_markers.crbegin();
+    auto markerIt = markers().crbegin();
     auto nextMarkerPosition = m_lastMarkerPosition;
 
     if (endPosition > m_lastMarkerPosition) {
@@ -527,14 +560,14 @@ mixxx::Bpm Beats::getBpmInRange(audio::FramePos startPosition, audio::FramePos e
         map.emplace(key, endPosition - m_lastMarkerPosition);
     }
 
-    while (markerIt != m_markers.crend() && nextMarkerPosition > startPosition) {
-        if (endPosition <= markerIt->position()) {
-            nextMarkerPosition = markerIt->position();
+    while (markerIt != markers().crend() && nextMarkerPosition > startPosition) {
+        if (endPosition <= markerPosition(*markerIt)) {
+            nextMarkerPosition = markerPosition(*markerIt);
             markerIt++;
             continue;
         }
 
-        audio::FrameDiff_t sectionLengthFrames = nextMarkerPosition - markerIt->position();
+        audio::FrameDiff_t sectionLengthFrames = nextMarkerPosition - markerPosition(*markerIt);
         const audio::FrameDiff_t beatLengthFrames =
                 sectionLengthFrames / markerIt->beatsTillNextMarker();
 
@@ -543,19 +576,19 @@ mixxx::Bpm Beats::getBpmInRange(audio::FramePos startPosition, audio::FramePos e
         // point. This suffices for our use case.
         const auto key = static_cast<int>(std::round(100 * 60.0 * m_sampleRate / beatLengthFrames));
 
-        if (endPosition > markerIt->position() && endPosition < nextMarkerPosition) {
+        if (endPosition > markerPosition(*markerIt) && endPosition < nextMarkerPosition) {
             sectionLengthFrames -= nextMarkerPosition - endPosition;
         }
-        if (startPosition > markerIt->position() && startPosition < nextMarkerPosition) {
-            sectionLengthFrames -= startPosition - markerIt->position();
+        if (startPosition > markerPosition(*markerIt) && startPosition < nextMarkerPosition) {
+            sectionLengthFrames -= startPosition - markerPosition(*markerIt);
         }
 
         const auto found = map.find(key);
         const auto value = (found != map.cend()) ? (*found).second : 0;
-        nextMarkerPosition = markerIt->position();
+        nextMarkerPosition = markerPosition(*markerIt);
         markerIt++;
 
-        if (markerIt == m_markers.crend() && nextMarkerPosition > startPosition) {
+        if (markerIt == markers().crend() && nextMarkerPosition > startPosition) {
             sectionLengthFrames += nextMarkerPosition - startPosition;
         }
 
@@ -573,7 +606,7 @@ mixxx::Bpm Beats::getBpmInRange(audio::FramePos startPosition, audio::FramePos e
 }
 
 mixxx::Bpm Beats::getBpmAroundPosition(audio::FramePos position, int n) const {
-    if (m_markers.empty()) {
+    if (markers().empty()) {
         return m_lastMarkerBpm;
     }
 
@@ -596,19 +629,15 @@ mixxx::Bpm Beats::getBpmAroundPosition(audio::FramePos position, int n) const {
 }
 
 std::optional<BeatsPointer> Beats::tryTranslate(audio::FrameDiff_t offsetFrames) const {
-    std::vector<BeatMarker> markers;
-    std::transform(m_markers.cbegin(),
-            m_markers.cend(),
-            std::back_inserter(markers),
-            [offsetFrames](const BeatMarker& marker) -> BeatMarker {
-                const auto translatedPosition = marker.position() + offsetFrames;
-                return BeatMarker(translatedPosition.toLowerFrameBoundary(),
-                        marker.beatsTillNextMarker());
-            });
-
-    const auto lastMarkerPosition = m_lastMarkerPosition + offsetFrames;
-    return BeatsPointer(new Beats(markers,
-            lastMarkerPosition.toLowerFrameBoundary(),
+    // All marker positions are full frame positions, so rounding each
+    // translated position down is the same as translating all of them by
+    // the rounded offset. This allows to share the markers and their beat
+    // indices with this object, which makes adjusting the beats while
+    // playing independent of the number of markers.
+    const auto fullFrameOffset = std::floor(offsetFrames);
+    return BeatsPointer(new Beats(m_pMarkerSet,
+            m_markerOffsetFrames + fullFrameOffset,
+            m_lastMarkerPosition + fullFrameOffset,
             m_lastMarkerBpm,
             m_sampleRate,
             m_subVersion));
@@ -640,9 +669,9 @@ std::optional<BeatsPointer> Beats::tryScale(BpmScale scale) const {
         return nullptr;
     }
 
-    std::vector<BeatMarker> markers;
-    markers.reserve(m_markers.size());
-    for (const auto& marker : std::as_const(m_markers)) {
+    std::vector<BeatMarker> scaledMarkers;
+    scaledMarkers.reserve(markers().size());
+    for (const auto& marker : markers()) {
         const double beatsTillNextMarkerFractional = marker.beatsTillNextMarker() * scaleFactor;
         const int beatsTillNextMarker = static_cast<int>(std::trunc(beatsTillNextMarkerFractional));
         if (beatsTillNextMarkerFractional != beatsTillNextMarker) {
@@ -652,12 +681,12 @@ std::optional<BeatsPointer> Beats::tryScale(BpmScale scale) const {
             return std::nullopt;
         }
 
-        markers.push_back({marker.position(), beatsTillNextMarker});
+        scaledMarkers.push_back({markerPosition(marker), beatsTillNextMarker});
     }
 
     Bpm lastMarkerBpm = m_lastMarkerBpm * scaleFactor;
 
-    return BeatsPointer(new Beats(markers,
+    return BeatsPointer(new Beats(std::move(scaledMarkers),
             m_lastMarkerPosition,
             lastMarkerBpm,
             m_sampleRate,
@@ -669,12 +698,39 @@ std::optional<BeatsPointer> Beats::trySetBpm(mixxx::Bpm bpm) const {
     return BeatsPointer(new Beats({}, *it, bpm, m_sampleRate, m_subVersion));
 }
 
+std::vector<BeatMarker> Beats::getMarkers() const {
+    if (m_markerOffsetFrames == 0) {
+        return markers();
+    }
+
+    std::vector<BeatMarker> translatedMarkers;
+    translatedMarkers.reserve(markers().size());
+    for (const auto& marker : markers()) {
+        translatedMarkers.push_back({markerPosition(marker), marker.beatsTillNextMarker()});
+    }
+    return translatedMarkers;
+}
+
+bool Beats::hasEqualMarkers(const Beats& other) const {
+    if (m_pMarkerSet == other.m_pMarkerSet) {
+        return m_markerOffsetFrames == other.m_markerOffsetFrames;
+    }
+    return std::equal(markers().cbegin(),
+            markers().cend(),
+            other.markers().cbegin(),
+            other.markers().cend(),
+            [this, &other](const BeatMarker& lhs, const BeatMarker& rhs) {
+                return markerPosition(lhs) == other.markerPosition(rhs) &&
+                        lhs.beatsTillNextMarker() == rhs.beatsTillNextMarker();
+            });
+}
+
 bool Beats::isValid() const {
     if (!m_lastMarkerPosition.isValid() || !m_lastMarkerBpm.isValid()) {
         return false;
     }
 
-    for (const BeatMarker& marker : m_markers) {
+    for (const BeatMarker& marker : markers()) {
         if (!marker.position().isValid() || marker.beatsTillNextMarker() <= 0) {
             return false;
         }
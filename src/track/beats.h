@@ -156,15 +156,12 @@ class Beats : private std::enable_shared_from_this<Beats> {
             mixxx::Bpm lastMarkerBpm,
             mixxx::audio::SampleRate sampleRate,
             const QString& subVersion)
-            : m_markers(std::move(markers)),
-              m_lastMarkerPosition(lastMarkerPosition),
-              m_lastMarkerBpm(lastMarkerBpm),
-              m_sampleRate(sampleRate),
-              m_subVersion(subVersion) {
-        DEBUG_ASSERT(m_lastMarkerPosition.isValid());
-        DEBUG_ASSERT(!m_lastMarkerPosition.isFractional());
-        DEBUG_ASSERT(m_lastMarkerBpm.isValid());
-        DEBUG_ASSERT(m_sampleRate.isValid());
+            : Beats(std::make_shared<const MarkerSet>(std::move(markers)),
+                      0,
+                      lastMarkerPosition,
+                      lastMarkerBpm,
+                      sampleRate,
+                      subVersion) {
     }
 
     Beats(mixxx::audio::FramePos lastMarkerPosition,
@@ -182,13 +179,13 @@ class Beats : private std::enable_shared_from_this<Beats> {
 
     /// Returns an iterator pointing to the position of the first beat marker.
     ConstIterator cfirstmarker() const {
-        return ConstIterator(this, m_markers.cbegin(), 0);
+        return ConstIterator(this, markers().cbegin(), 0);
     }
 
     /// Returns an iterator pointing to the position of the first beat after
     /// the end beat marker.
     ConstIterator clastmarker() const {
-        return ConstIterator(this, m_markers.cend(), 0);
+        return ConstIterator(this, markers().cend(), 0);
     }
 
     /// Returns an iterator pointing to earliest representable beat position
@@ -197,7 +194,7 @@ class Beats : private std::enable_shared_from_this<Beats> {
     /// Warning: Decrementing the iterator returned by this function will
     /// result in an integer underflow.
     ConstIterator cbegin() const {
-        return ConstIterator(this, m_markers.cbegin(), std::numeric_limits<int>::lowest());
+        return ConstIterator(this, markers().cbegin(), std::numeric_limits<int>::lowest());
     }
 
     /// Returns an iterator pointing to latest representable beat position
@@ -206,13 +203,13 @@ class Beats : private std::enable_shared_from_this<Beats> {
     /// Warning: Incrementing the iterator returned by this function will
     /// result in an integer overflow.
     ConstIterator cend() const {
-        return ConstIterator(this, m_markers.cend(), std::numeric_limits<int>::max());
+        return ConstIterator(this, markers().cend(), std::numeric_limits<int>::max());
     }
 
     ConstIterator iteratorFrom(audio::FramePos position) const;
 
     friend bool operator==(const Beats& lhs, const Beats& rhs) {
-        return lhs.m_markers == rhs.m_markers &&
+        return lhs.hasEqualMarkers(rhs) &&
                 lhs.m_lastMarkerPosition == rhs.m_lastMarkerPosition &&
                 lhs.m_lastMarkerBpm == rhs.m_lastMarkerBpm && lhs.m_sampleRate &&
                 rhs.m_sampleRate;
@@ -276,7 +273,7 @@ class Beats : private std::enable_shared_from_this<Beats> {
     /// `DlgTrackInfo`. This should probably be removed or reimplemented to
     /// check if all neighboring beats in this object have the same distance.
     bool hasConstantTempo() const {
-        return m_markers.empty();
+        return markers().empty();
     }
 
     /// Serialize beats to QByteArray.
@@ -372,9 +369,7 @@ class Beats : private std::enable_shared_from_this<Beats> {
         return m_sampleRate;
     }
 
-    const std::vector<BeatMarker>& getMarkers() const {
-        return m_markers;
-    }
+    std::vector<BeatMarker> getMarkers() const;
 
     mixxx::audio::FramePos getLastMarkerPosition() const {
         return m_lastMarkerPosition;
@@ -427,7 +422,56 @@ class Beats : private std::enable_shared_from_this<Beats> {
     mixxx::audio::FrameDiff_t firstBeatLengthFrames() const;
     mixxx::audio::FrameDiff_t lastBeatLengthFrames() const;
 
-    std::vector<BeatMarker> m_markers;
+    /// The markers and their derived data, which are shared between all
+    /// objects that only differ by a translation.
+    struct MarkerSet {
+        explicit MarkerSet(std::vector<BeatMarker> markers);
+
+        const std::vector<BeatMarker> markers;
+        /// Cumulative beat count of each marker and the last marker position,
+        /// so iterators can jump between markers with a binary search instead
+        /// of walking over all markers in between.
+        std::vector<qint64> beatIndices;
+    };
+
+    Beats(std::shared_ptr<const MarkerSet> pMarkerSet,
+            audio::FrameDiff_t markerOffsetFrames,
+            mixxx::audio::FramePos lastMarkerPosition,
+            mixxx::Bpm lastMarkerBpm,
+            mixxx::audio::SampleRate sampleRate,
+            const QString& subVersion)
+            : m_pMarkerSet(std::move(pMarkerSet)),
+              m_markerOffsetFrames(markerOffsetFrames),
+              m_lastMarkerPosition(lastMarkerPosition),
+              m_lastMarkerBpm(lastMarkerBpm),
+              m_sampleRate(sampleRate),
+              m_subVersion(subVersion) {
+        DEBUG_ASSERT(m_pMarkerSet);
+        DEBUG_ASSERT(m_lastMarkerPosition.isValid());
+        DEBUG_ASSERT(!m_lastMarkerPosition.isFractional());
+        DEBUG_ASSERT(m_lastMarkerBpm.isValid());
+        DEBUG_ASSERT(m_sampleRate.isValid());
+    }
+
+    /// The untranslated markers. Use markerPosition() for their positions.
+    const std::vector<BeatMarker>& markers() const {
+        return m_pMarkerSet->markers;
+    }
+    mixxx::audio::FramePos markerPosition(const BeatMarker& marker) const {
+        return marker.position() + m_markerOffsetFrames;
+    }
+    /// The number of beats between the first marker and the marker `it`
+    /// points to, which may also be `markers().cend()`.
+    qint64 markerBeatIndex(std::vector<BeatMarker>::const_iterator it) const {
+        return m_pMarkerSet->beatIndices[it - markers().cbegin()];
+    }
+
+    bool hasEqualMarkers(const Beats& other) const;
+
+    std::shared_ptr<const MarkerSet> m_pMarkerSet;
+    /// The offset in full frames of all marker positions from the positions
+    /// in the shared marker set.
+    audio::FrameDiff_t m_markerOffsetFrames;
     mixxx::audio::FramePos m_lastMarkerPosition;
     mixxx::Bpm m_lastMarkerBpm;
     mixxx::audio::SampleRate m_sampleRate;
@@ -224,6 +224,21 @@ void GlobalTrackCacheResolver::initTrackIdAndUnlockCache(TrackId trackId) {
     DEBUG_ASSERT(m_trackRef == createTrackRef(*m_strongPtr));
 }
 
+GlobalTrackCacheFileLocker::GlobalTrackCacheFileLocker(
+        QString canonicalLocation)
+        : m_pInstance(s_pInstance),
+          m_canonicalLocation(std::move(canonicalLocation)) {
+    if (m_pInstance && !m_canonicalLocation.isEmpty()) {
+        m_pInstance->lockFile(m_canonicalLocation);
+    }
+}
+
+GlobalTrackCacheFileLocker::~GlobalTrackCacheFileLocker() {
+    if (m_pInstance && !m_canonicalLocation.isEmpty()) {
+        m_pInstance->unlockFile(m_canonicalLocation);
+    }
+}
+
 //static
 void GlobalTrackCache::createInstance(
         GlobalTrackCacheSaver* pSaver,
@@ -388,9 +403,29 @@ void GlobalTrackCache::saveEvictedTrack(Track* pEvictedTrack) const {
     // a track that is about to deleted may cause access violations!!
     pEvictedTrack->disconnect();
     pEvictedTrack->blockSignals(true);
+    // Saving may export metadata into the file, which must not be read
+    // concurrently by a thread that doesn't need to lock the cache.
+    const GlobalTrackCacheFileLocker fileLocker(
+            pEvictedTrack->getFileInfo().canonicalLocation());
     m_pSaver->saveEvictedTrack(pEvictedTrack);
 }
 
+void GlobalTrackCache::lockFile(const QString& canonicalLocation) const {
+    const auto locker = lockMutex(&m_lockedFilesMutex);
+    while (m_lockedFiles.contains(canonicalLocation)) {
+        m_fileUnlocked.wait(&m_lockedFilesMutex);
+    }
+    m_lockedFiles.insert(canonicalLocation);
+}
+
+void GlobalTrackCache::unlockFile(const QString& canonicalLocation) const {
+    const auto locker = lockMutex(&m_lockedFilesMutex);
+    const bool removed = m_lockedFiles.remove(canonicalLocation);
+    DEBUG_ASSERT(removed);
+    Q_UNUSED(removed);
+    m_fileUnlocked.wakeAll();
+}
+
 void GlobalTrackCache::deactivate() {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
 
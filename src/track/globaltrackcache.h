@@ -1,5 +1,9 @@
 #pragma once
 
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QWaitCondition>
 #include <map>
 #include <unordered_map>
 
@@ -174,6 +178,27 @@ private:
     TrackRef m_trackRef;
 };
 
+/// Serializes reading and writing the metadata of a single file,
+/// without keeping the whole cache locked while accessing the file.
+///
+/// The file is locked for the lifetime of the object. Acquiring it
+/// while the cache is locked is permitted, because a file is never
+/// locked by a thread that is waiting for the cache.
+class GlobalTrackCacheFileLocker final {
+  public:
+    explicit GlobalTrackCacheFileLocker(QString canonicalLocation);
+    GlobalTrackCacheFileLocker(const GlobalTrackCacheFileLocker&) = delete;
+    GlobalTrackCacheFileLocker(GlobalTrackCacheFileLocker&&) = delete;
+    ~GlobalTrackCacheFileLocker();
+
+    GlobalTrackCacheFileLocker& operator=(const GlobalTrackCacheFileLocker&) = delete;
+    GlobalTrackCacheFileLocker& operator=(GlobalTrackCacheFileLocker&&) = delete;
+
+  private:
+    GlobalTrackCache* m_pInstance;
+    const QString m_canonicalLocation;
+};
+
 /// Callback interface for pre-delete actions
 class /*interface*/ GlobalTrackCacheSaver {
 private:
@@ -229,6 +254,7 @@ class GlobalTrackCache : public QObject {
   private:
     friend class GlobalTrackCacheLocker;
     friend class GlobalTrackCacheResolver;
+    friend class GlobalTrackCacheFileLocker;
 
     GlobalTrackCache(
             GlobalTrackCacheSaver* pSaver,
@@ -275,9 +301,17 @@ class GlobalTrackCache : public QObject {
 
     void saveEvictedTrack(Track* pEvictedTrack) const;
 
+    void lockFile(const QString& canonicalLocation) const;
+    void unlockFile(const QString& canonicalLocation) const;
+
     // Managed by GlobalTrackCacheLocker
     mutable QT_RECURSIVE_MUTEX m_mutex;
 
+    // Managed by GlobalTrackCacheFileLocker
+    mutable QMutex m_lockedFilesMutex;
+    mutable QWaitCondition m_fileUnlocked;
+    mutable QSet<QString> m_lockedFiles;
+
     GlobalTrackCacheSaver* m_pSaver;
 
     deleteTrackFn_t m_deleteTrackFn;
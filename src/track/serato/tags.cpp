@@ -2,6 +2,9 @@
 
 #include <mp3guessenc.h>
 
+#include <QCache>
+#include <QPair>
+
 #include "sources/soundsourceproxy.h"
 #if defined(__COREAUDIO__)
 #include "sources/soundsourcecoreaudio.h"
@@ -16,6 +19,7 @@
 #include "track/serato/cueinfoimporter.h"
 #include "track/taglib/trackmetadata_file.h"
 #include "util/color/predefinedcolorpalettes.h"
+#include "util/compatibility/qmutex.h"
 
 namespace {
 
@@ -38,6 +42,52 @@ QString getPrimaryDecoderNameForFilePath(const QString& filePath) {
 constexpr int kFirstLoopIndex = mixxx::kFirstHotCueIndex + 8;
 constexpr int kNumCuesInMarkersTag = 5;
 
+/// Maximum number of decoded tags per tag type that are kept in memory.
+constexpr int kMaxCachedFrames = 256;
+
+/// Process-wide cache of decoded tags, indexed by the file type and the
+/// raw data. The raw data is compared on lookup, so hash collisions can't
+/// cause wrong results.
+template<typename T>
+class SeratoFrameCache final {
+  public:
+    SeratoFrameCache()
+            : m_cache(kMaxCachedFrames) {
+    }
+
+    /// Leaves `pParsed` unmodified if the data is invalid.
+    bool parse(T* pParsed, const QByteArray& data, mixxx::taglib::FileType fileType) {
+        const auto key = qMakePair(static_cast<int>(fileType), data);
+        {
+            const auto locker = lockMutex(&m_mutex);
+            const T* pCached = m_cache.object(key);
+            if (pCached) {
+                *pParsed = *pCached;
+                return true;
+            }
+        }
+        // Decode outside of the critical section. Concurrent threads
+        // might decode the same data, but only one result is kept.
+        T parsed;
+        if (!T::parse(&parsed, data, fileType)) {
+            return false;
+        }
+        *pParsed = parsed;
+        const auto locker = lockMutex(&m_mutex);
+        m_cache.insert(key, new T(std::move(parsed)));
+        return true;
+    }
+
+    static SeratoFrameCache& instance() {
+        static SeratoFrameCache s_instance;
+        return s_instance;
+    }
+
+  private:
+    QMutex m_mutex;
+    QCache<QPair<int, QByteArray>, T> m_cache;
+};
+
 mixxx::RgbColor getColorFromOtherPalette(
         const ColorPalette& source,
         const ColorPalette& dest,
@@ -257,7 +307,53 @@ double SeratoTags::guessTimingOffsetMillis(
     return timingOffset;
 }
 
+void SeratoTags::parseUnparsedFrames() const {
+    if (!m_unparsedBeatGrid.data.isEmpty()) {
+        if (SeratoFrameCache<SeratoBeatGrid>::instance().parse(&m_seratoBeatGrid,
+                    m_unparsedBeatGrid.data,
+                    m_unparsedBeatGrid.fileType)) {
+            m_seratoBeatGridParserStatus = ParserStatus::Parsed;
+        }
+        m_unparsedBeatGrid = UnparsedFrame();
+    }
+    if (!m_unparsedMarkers.data.isEmpty()) {
+        if (SeratoFrameCache<SeratoMarkers>::instance().parse(&m_seratoMarkers,
+                    m_unparsedMarkers.data,
+                    m_unparsedMarkers.fileType)) {
+            m_seratoMarkersParserStatus = ParserStatus::Parsed;
+        }
+        m_unparsedMarkers = UnparsedFrame();
+    }
+    if (!m_unparsedMarkers2.data.isEmpty()) {
+        if (SeratoFrameCache<SeratoMarkers2>::instance().parse(&m_seratoMarkers2,
+                    m_unparsedMarkers2.data,
+                    m_unparsedMarkers2.fileType)) {
+            m_seratoMarkers2ParserStatus = ParserStatus::Parsed;
+        }
+        m_unparsedMarkers2 = UnparsedFrame();
+    }
+}
+
+bool operator==(const SeratoTags& lhs, const SeratoTags& rhs) {
+    if (!lhs.hasDecodedContent() && !rhs.hasDecodedContent()) {
+        // Compare the raw data without decoding it. Raw data that would
+        // turn out to be invalid when decoded is not considered equal to
+        // empty tags here.
+        return lhs.m_unparsedBeatGrid == rhs.m_unparsedBeatGrid &&
+                lhs.m_unparsedMarkers == rhs.m_unparsedMarkers &&
+                lhs.m_unparsedMarkers2 == rhs.m_unparsedMarkers2;
+    }
+    // FIXME: Find a more efficient way to do this
+    return (lhs.dumpBeatGrid(taglib::FileType::MP3) ==
+                    rhs.dumpBeatGrid(taglib::FileType::MP3) &&
+            lhs.dumpMarkers(taglib::FileType::MP3) ==
+                    rhs.dumpMarkers(taglib::FileType::MP3) &&
+            lhs.dumpMarkers2(taglib::FileType::MP3) ==
+                    rhs.dumpMarkers2(taglib::FileType::MP3));
+}
+
 BeatsImporterPointer SeratoTags::importBeats() const {
+    parseUnparsedFramesIfNeeded();
     if (m_seratoBeatGrid.isEmpty() || !m_seratoBeatGrid.terminalMarker()) {
         return nullptr;
     }
@@ -275,6 +371,8 @@ CueInfoImporterPointer SeratoTags::importCueInfos() const {
 }
 
 QList<CueInfo> SeratoTags::getCueInfos() const {
+    parseUnparsedFramesIfNeeded();
+
     // Import "Serato Markers2" first, then overwrite values with those
     // from "Serato Markers_". This is what Serato does too (i.e. if
     // "Serato Markers_" and "Serato Markers2" contradict each other,
@@ -358,6 +456,8 @@ QList<CueInfo> SeratoTags::getCueInfos() const {
 }
 
 void SeratoTags::setCueInfos(const QList<CueInfo>& cueInfos, double timingOffsetMillis) {
+    parseUnparsedFramesIfNeeded();
+
     // Filter out all cues that cannot be mapped to Serato's tag data,
     // ensure that each hotcue number is unique (by using a map), apply the
     // timing offset and split up cues and loops.
@@ -428,6 +528,8 @@ void SeratoTags::setCueInfos(const QList<CueInfo>& cueInfos, double timingOffset
 }
 
 RgbColor::optional_t SeratoTags::getTrackColor() const {
+    parseUnparsedFramesIfNeeded();
+
     RgbColor::optional_t color = m_seratoMarkers.getTrackColor();
 
     if (!color) {
@@ -443,16 +545,20 @@ RgbColor::optional_t SeratoTags::getTrackColor() const {
 }
 
 void SeratoTags::setTrackColor(const RgbColor::optional_t& color) {
+    parseUnparsedFramesIfNeeded();
+
     mixxx::RgbColor rgbColor = SeratoTags::displayedToStoredTrackColor(color);
     m_seratoMarkers.setTrackColor(rgbColor);
     m_seratoMarkers2.setTrackColor(rgbColor);
 }
 
 bool SeratoTags::isBpmLocked() const {
+    parseUnparsedFramesIfNeeded();
     return m_seratoMarkers2.isBpmLocked();
 }
 
 void SeratoTags::setBpmLocked(bool bpmLocked) {
+    parseUnparsedFramesIfNeeded();
     m_seratoMarkers2.setBpmLocked(bpmLocked);
 }
 
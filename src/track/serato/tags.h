@@ -11,6 +11,11 @@ namespace mixxx {
 
 /// DTO for storing information from the SeratoMarkers_/2 tags used by the
 /// Serato DJ Pro software.
+///
+/// The raw tag data that is stored by the set...Data() functions is only
+/// decoded when the content is accessed for the first time. Decoding takes
+/// place in const member functions, i.e. like any non-thread-safe DTO a
+/// single instance must not be accessed concurrently from multiple threads.
 class SeratoTags final {
   public:
     enum class ParserStatus {
@@ -32,15 +37,19 @@ class SeratoTags final {
     static double guessTimingOffsetMillis(
             const QString& filePath, const audio::SignalInfo& signalInfo);
 
+    /// Tags with raw data that has not been decoded yet are never
+    /// considered empty.
     bool isEmpty() const {
-        return m_seratoBeatGrid.isEmpty() && m_seratoMarkers.isEmpty() &&
-                m_seratoMarkers2.isEmpty();
+        return !hasUnparsedFrames() && m_seratoBeatGrid.isEmpty() &&
+                m_seratoMarkers.isEmpty() && m_seratoMarkers2.isEmpty();
     }
 
     /// Return the cumulated parse status for all Serato tags. If no tags were parsed,
     /// this returns `ParserStatus::None`. If any tag failed to parse, this
     /// returns `ParserStatus::Failed`.
     ParserStatus status() const {
+        parseUnparsedFramesIfNeeded();
+
         if (m_seratoBeatGridParserStatus == ParserStatus::Failed ||
                 m_seratoMarkersParserStatus == ParserStatus::Failed ||
                 m_seratoMarkers2ParserStatus == ParserStatus::Failed) {
@@ -57,32 +66,61 @@ class SeratoTags final {
     }
 
     bool parseBeatGrid(const QByteArray& data, taglib::FileType fileType) {
+        m_unparsedBeatGrid = UnparsedFrame();
         bool success = SeratoBeatGrid::parse(&m_seratoBeatGrid, data, fileType);
         m_seratoBeatGridParserStatus = success ? ParserStatus::Parsed : ParserStatus::Failed;
         return success;
     }
 
     bool parseMarkers(const QByteArray& data, taglib::FileType fileType) {
+        m_unparsedMarkers = UnparsedFrame();
         bool success = SeratoMarkers::parse(&m_seratoMarkers, data, fileType);
         m_seratoMarkersParserStatus = success ? ParserStatus::Parsed : ParserStatus::Failed;
         return success;
     }
 
     bool parseMarkers2(const QByteArray& data, taglib::FileType fileType) {
+        m_unparsedMarkers2 = UnparsedFrame();
         bool success = SeratoMarkers2::parse(&m_seratoMarkers2, data, fileType);
         m_seratoMarkers2ParserStatus = success ? ParserStatus::Parsed : ParserStatus::Failed;
         return success;
     }
 
+    /// Store the raw data of a tag without decoding it. The data is parsed
+    /// on first access and, in contrast to the parse...() functions, invalid
+    /// data is silently discarded and leaves the tag unmodified. Decoded
+    /// results are cached by the raw data, i.e. tracks that are loaded
+    /// repeatedly only need to be decoded once.
+    void setBeatGridData(const QByteArray& data, taglib::FileType fileType) {
+        setUnparsedFrame(&m_unparsedBeatGrid, data, fileType);
+    }
+
+    void setMarkersData(const QByteArray& data, taglib::FileType fileType) {
+        setUnparsedFrame(&m_unparsedMarkers, data, fileType);
+    }
+
+    void setMarkers2Data(const QByteArray& data, taglib::FileType fileType) {
+        setUnparsedFrame(&m_unparsedMarkers2, data, fileType);
+    }
+
+    bool hasUnparsedFrames() const {
+        return !m_unparsedBeatGrid.data.isEmpty() ||
+                !m_unparsedMarkers.data.isEmpty() ||
+                !m_unparsedMarkers2.data.isEmpty();
+    }
+
     QByteArray dumpBeatGrid(taglib::FileType fileType) const {
+        parseUnparsedFramesIfNeeded();
         return m_seratoBeatGrid.dump(fileType);
     }
 
     QByteArray dumpMarkers(taglib::FileType fileType) const {
+        parseUnparsedFramesIfNeeded();
         return m_seratoMarkers.dump(fileType);
     }
 
     QByteArray dumpMarkers2(taglib::FileType fileType) const {
+        parseUnparsedFramesIfNeeded();
         return m_seratoMarkers2.dump(fileType);
     }
 
@@ -96,6 +134,7 @@ class SeratoTags final {
             const audio::SignalInfo& signalInfo,
             const Duration& duration,
             double timingOffset) {
+        parseUnparsedFramesIfNeeded();
         m_seratoBeatGrid.setBeats(pBeats, signalInfo, duration, timingOffset);
     }
 
@@ -105,24 +144,57 @@ class SeratoTags final {
     bool isBpmLocked() const;
     void setBpmLocked(bool bpmLocked);
 
+    friend bool operator==(const SeratoTags& lhs, const SeratoTags& rhs);
+
   private:
-    SeratoBeatGrid m_seratoBeatGrid;
-    ParserStatus m_seratoBeatGridParserStatus;
-    SeratoMarkers m_seratoMarkers;
-    ParserStatus m_seratoMarkersParserStatus;
-    SeratoMarkers2 m_seratoMarkers2;
-    ParserStatus m_seratoMarkers2ParserStatus;
-};
+    struct UnparsedFrame {
+        QByteArray data;
+        taglib::FileType fileType = taglib::FileType::Unknown;
 
-inline bool operator==(const SeratoTags& lhs, const SeratoTags& rhs) {
-    // FIXME: Find a more efficient way to do this
-    return (lhs.dumpBeatGrid(taglib::FileType::MP3) ==
-                    rhs.dumpBeatGrid(taglib::FileType::MP3) &&
-            lhs.dumpMarkers(taglib::FileType::MP3) ==
-                    rhs.dumpMarkers(taglib::FileType::MP3) &&
-            lhs.dumpMarkers2(taglib::FileType::MP3) ==
-                    rhs.dumpMarkers2(taglib::FileType::MP3));
-}
+        bool operator==(const UnparsedFrame& other) const {
+            return data == other.data && fileType == other.fileType;
+        }
+    };
+
+    static void setUnparsedFrame(
+            UnparsedFrame* pFrame,
+            const QByteArray& data,
+            taglib::FileType fileType) {
+        if (data.isEmpty()) {
+            // Nothing to decode
+            return;
+        }
+        pFrame->data = data;
+        pFrame->fileType = fileType;
+    }
+
+    /// Returns true if any content has been decoded or modified.
+    bool hasDecodedContent() const {
+        return m_seratoBeatGridParserStatus != ParserStatus::None ||
+                m_seratoMarkersParserStatus != ParserStatus::None ||
+                m_seratoMarkers2ParserStatus != ParserStatus::None ||
+                !m_seratoBeatGrid.isEmpty() || !m_seratoMarkers.isEmpty() ||
+                !m_seratoMarkers2.isEmpty();
+    }
+
+    void parseUnparsedFramesIfNeeded() const {
+        if (hasUnparsedFrames()) {
+            parseUnparsedFrames();
+        }
+    }
+    void parseUnparsedFrames() const;
+
+    // All members are mutable for decoding the raw data on demand
+    mutable SeratoBeatGrid m_seratoBeatGrid;
+    mutable ParserStatus m_seratoBeatGridParserStatus = ParserStatus::None;
+    mutable UnparsedFrame m_unparsedBeatGrid;
+    mutable SeratoMarkers m_seratoMarkers;
+    mutable ParserStatus m_seratoMarkersParserStatus = ParserStatus::None;
+    mutable UnparsedFrame m_unparsedMarkers;
+    mutable SeratoMarkers2 m_seratoMarkers2;
+    mutable ParserStatus m_seratoMarkers2ParserStatus = ParserStatus::None;
+    mutable UnparsedFrame m_unparsedMarkers2;
+};
 
 inline bool operator!=(const SeratoTags& lhs, const SeratoTags& rhs) {
     return !(lhs == rhs);
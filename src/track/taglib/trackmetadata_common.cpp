@@ -150,12 +150,9 @@ bool parseSeratoBeatGrid(
         FileType fileType) {
     DEBUG_ASSERT(pTrackMetadata);
 
-    SeratoTags seratoTags(pTrackMetadata->getTrackInfo().getSeratoTags());
-    bool isValid = seratoTags.parseBeatGrid(data, fileType);
-    if (isValid) {
-        pTrackMetadata->refTrackInfo().setSeratoTags(seratoTags);
-    }
-    return isValid;
+    // Decoding is deferred until the contents are actually needed
+    pTrackMetadata->refTrackInfo().refSeratoTags().setBeatGridData(data, fileType);
+    return !data.isEmpty();
 }
 
 bool parseSeratoBeatGrid(
@@ -173,12 +170,9 @@ bool parseSeratoMarkers(
         FileType fileType) {
     DEBUG_ASSERT(pTrackMetadata);
 
-    SeratoTags seratoTags(pTrackMetadata->getTrackInfo().getSeratoTags());
-    bool isValid = seratoTags.parseMarkers(data, fileType);
-    if (isValid) {
-        pTrackMetadata->refTrackInfo().setSeratoTags(seratoTags);
-    }
-    return isValid;
+    // Decoding is deferred until the contents are actually needed
+    pTrackMetadata->refTrackInfo().refSeratoTags().setMarkersData(data, fileType);
+    return !data.isEmpty();
 }
 
 bool parseSeratoMarkers(
@@ -196,12 +190,9 @@ bool parseSeratoMarkers2(
         FileType fileType) {
     DEBUG_ASSERT(pTrackMetadata);
 
-    SeratoTags seratoTags(pTrackMetadata->getTrackInfo().getSeratoTags());
-    bool isValid = seratoTags.parseMarkers2(data, fileType);
-    if (isValid) {
-        pTrackMetadata->refTrackInfo().setSeratoTags(seratoTags);
-    }
-    return isValid;
+    // Decoding is deferred until the contents are actually needed
+    pTrackMetadata->refTrackInfo().refSeratoTags().setMarkers2Data(data, fileType);
+    return !data.isEmpty();
 }
 
 bool parseSeratoMarkers2(
@@ -129,6 +129,8 @@ bool parseAlbumPeak(
         bool resetIfEmpty);
 #endif // __EXTRA_METADATA__
 
+/// The Serato tag data is stored without decoding it, see SeratoTags.
+/// Returns false if there is no data.
 bool parseSeratoBeatGrid(
         TrackMetadata* pTrackMetadata,
         const QByteArray& data,
@@ -1,6 +1,7 @@
 #include "track/track.h"
 
 #include <QDirIterator>
+#include <QScopeGuard>
 #include <atomic>
 
 #include "engine/engine.h"
@@ -85,6 +86,7 @@ Track::Track(
         : m_qMutex(QT_RECURSIVE_MUTEX_INIT),
           m_fileAccess(std::move(fileAccess)),
           m_record(trackId),
+          m_pRecordSnapshot(std::make_shared<const mixxx::TrackRecord>(m_record)),
           m_bDirty(false),
           m_bMarkedForMetadataExport(false) {
     if (kLogStats && kLogger.debugEnabled()) {
@@ -550,6 +552,7 @@ QDateTime Track::getDateAdded() const {
 void Track::setDateAdded(const QDateTime& dateAdded) {
     auto locked = lockMutex(&m_qMutex);
     m_record.setDateAdded(dateAdded);
+    updateRecordSnapshotWhileLocked();
 }
 
 void Track::setDuration(mixxx::Duration duration) {
@@ -844,6 +847,7 @@ void Track::initId(TrackId id) {
         return; // abort
     }
     m_record.setId(id);
+    updateRecordSnapshotWhileLocked();
     // Changing the Id does not make the track dirty because the Id is always
     // generated by the database itself.
 }
@@ -851,6 +855,7 @@ void Track::initId(TrackId id) {
 void Track::resetId() {
     const auto locked = lockMutex(&m_qMutex);
     m_record.setId(TrackId());
+    updateRecordSnapshotWhileLocked();
 }
 
 void Track::setURL(const QString& url) {
@@ -1309,6 +1314,7 @@ void Track::setDirtyAndUnlock(QT_RECURSIVE_MUTEX_LOCKER* pLock, bool bDirty) {
     m_bDirty = bDirty;
 
     const auto trackId = m_record.getId();
+    updateRecordSnapshotWhileLocked();
 
     // Unlock before emitting any signals!
     pLock->unlock();
@@ -1329,6 +1335,13 @@ void Track::setDirtyAndUnlock(QT_RECURSIVE_MUTEX_LOCKER* pLock, bool bDirty) {
     }
 }
 
+void Track::updateRecordSnapshotWhileLocked() {
+    auto pRecordSnapshot = std::make_shared<const mixxx::TrackRecord>(m_record);
+    const auto locked = lockMutex(&m_recordSnapshotMutex);
+    m_pRecordSnapshot.swap(pRecordSnapshot);
+    // The previous snapshot is released after unlocking
+}
+
 bool Track::isDirty() const {
     const auto locked = lockMutex(&m_qMutex);
     return m_bDirty;
@@ -1469,6 +1482,10 @@ ExportTrackMetadataResult Track::exportMetadata(
     // be called after all references to the object have been dropped.
     // But it doesn't hurt much, so let's play it safe ;)
     auto locked = lockMutex(&m_qMutex);
+    // The record might be modified on any of the following paths
+    const auto updateRecordSnapshot = qScopeGuard([this] {
+        updateRecordSnapshotWhileLocked();
+    });
     const auto sourceSyncStatus = m_record.checkSourceSyncStatus(m_fileAccess.info());
     switch (sourceSyncStatus) {
     case mixxx::TrackRecord::SourceSyncStatus::Void:
@@ -1747,6 +1764,11 @@ void Track::updateStreamInfoFromSource(
     }
 
     if (!beatsImported && !cuesImported) {
+        if (updated) {
+            // The stream info is stored permanently when the track
+            // is marked dirty next time.
+            updateRecordSnapshotWhileLocked();
+        }
         return;
     }
 
@@ -412,6 +412,16 @@ class Track : public QObject {
 
     mixxx::TrackRecord getRecord(
             bool* pDirty = nullptr) const;
+    /// Returns an immutable snapshot of the record without waiting for
+    /// pending modifications of the track.
+    ///
+    /// All properties read from the same snapshot are consistent with
+    /// each other. A new snapshot is published after each modification
+    /// of the record, before the corresponding signals are emitted.
+    std::shared_ptr<const mixxx::TrackRecord> getRecordSnapshot() const {
+        const auto locked = lockMutex(&m_recordSnapshotMutex);
+        return m_pRecordSnapshot;
+    }
     bool replaceRecord(
             mixxx::TrackRecord newRecord,
             mixxx::BeatsPointer pOptionalBeats = nullptr);
@@ -494,6 +504,10 @@ class Track : public QObject {
     }
     void setDirtyAndUnlock(QT_RECURSIVE_MUTEX_LOCKER* pLock, bool bDirty);
 
+    /// Replaces the record snapshot with a copy of m_record. Must be
+    /// called while m_qMutex is locked after modifying m_record.
+    void updateRecordSnapshotWhileLocked();
+
     void afterKeysUpdated(QT_RECURSIVE_MUTEX_LOCKER* pLock);
 
     void afterBeatsAndBpmUpdated(QT_RECURSIVE_MUTEX_LOCKER* pLock);
@@ -571,6 +585,12 @@ class Track : public QObject {
 
     mixxx::TrackRecord m_record;
 
+    // Only guards the pointer to the snapshot of m_record and is never
+    // held while copying the record. Readers don't need to wait until
+    // a modification that holds m_qMutex has finished.
+    mutable QMutex m_recordSnapshotMutex;
+    std::shared_ptr<const mixxx::TrackRecord> m_pRecordSnapshot;
+
     // Flag that indicates whether or not the TIO has changed. This is used by
     // TrackDAO to determine whether or not to write the Track back.
     bool m_bDirty;
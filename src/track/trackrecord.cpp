@@ -205,6 +205,18 @@ bool TrackRecord::replaceMetadataFromSource(
     return modified;
 }
 
+/*static*/
+bool TrackRecord::mayMergeExtraMetadataFromSource(
+        const TrackMetadata& metadata) {
+#if defined(__EXTRA_METADATA__)
+    Q_UNUSED(metadata);
+    // The extra properties are not stored in the library
+    return true;
+#else
+    return metadata.getTrackInfo().getTrackTotal() == kTrackTotalPlaceholder;
+#endif // __EXTRA_METADATA__
+}
+
 bool TrackRecord::mergeExtraMetadataFromSource(
         const TrackMetadata& importedMetadata) {
     bool modified = false;
@@ -148,6 +148,10 @@ class TrackRecord final {
     // Returns true if any property has been modified or false otherwise.
     bool mergeExtraMetadataFromSource(
             const TrackMetadata& importedMetadata);
+    // Returns false if mergeExtraMetadataFromSource() can't modify the
+    // metadata, which allows to skip parsing the file tags.
+    static bool mayMergeExtraMetadataFromSource(
+            const TrackMetadata& metadata);
 
     /// Update the stream info after opening the audio stream during
     /// a session.
@@ -22,6 +22,8 @@ CmdlineArgs::CmdlineArgs()
           m_controllerDebug(false),
           m_developer(false),
           m_safeMode(false),
+          m_headless(false),
+          m_traceRecorder(false),
           m_debugAssertBreak(false),
           m_settingsPathSet(false),
           m_scaleFactor(1.0),
@@ -200,6 +202,23 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
     parser.addOption(safeMode);
     parser.addOption(safeModeDeprecated);
 
+    const QCommandLineOption headless(QStringLiteral("headless"),
+            forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
+                                      "Runs Mixxx without a user interface, e.g. for "
+                                      "AutoDJ and live broadcasting on a server. Mixxx "
+                                      "can be controlled by controller mappings and is "
+                                      "quit with Ctrl+C.")
+                            : QString());
+    parser.addOption(headless);
+
+    const QCommandLineOption traceRecorder(QStringLiteral("trace-recorder"),
+            forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
+                                      "Records the traced regions of all threads. "
+                                      "The last seconds can be saved as a Chrome "
+                                      "trace file with the [Master],trace_save control.")
+                            : QString());
+    parser.addOption(traceRecorder);
+
     const QCommandLineOption color(QStringLiteral("color"),
             forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
                                       "[auto|always|never] Use colors on the console output.")
@@ -322,6 +341,8 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
     m_controllerDebug = parser.isSet(controllerDebug) || parser.isSet(controllerDebugDeprecated);
     m_developer = parser.isSet(developer);
     m_safeMode = parser.isSet(safeMode) || parser.isSet(safeModeDeprecated);
+    m_headless = parser.isSet(headless);
+    m_traceRecorder = parser.isSet(traceRecorder);
     m_debugAssertBreak = parser.isSet(debugAssertBreak) || parser.isSet(debugAssertBreakDeprecated);
 
     m_musicFiles = parser.positionalArguments();
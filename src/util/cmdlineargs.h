@@ -36,6 +36,12 @@ class CmdlineArgs final {
     }
     bool getDeveloper() const { return m_developer; }
     bool getSafeMode() const { return m_safeMode; }
+    bool getHeadless() const {
+        return m_headless;
+    }
+    bool getTraceRecorder() const {
+        return m_traceRecorder;
+    }
     bool useColors() const {
         return m_useColors;
     }
@@ -72,6 +78,8 @@ class CmdlineArgs final {
     bool m_controllerDebug;
     bool m_developer; // Developer Mode
     bool m_safeMode;
+    bool m_headless;
+    bool m_traceRecorder;
     bool m_debugAssertBreak;
     bool m_settingsPathSet; // has --settingsPath been set on command line ?
     double m_scaleFactor;
@@ -6,6 +6,8 @@
 #include <QRecursiveMutex>
 #endif
 
+#include "util/rtsafety.h"
+
 /// Transitional utility macros and functions to migrate from
 /// non-templated QMutexLocker in Qt5 to templated
 /// QMutexLocker<MutexType> in Qt6. Also includes some helpers
@@ -30,11 +32,14 @@
 #define QT_RECURSIVE_MUTEX_LOCKER QT_MUTEX_LOCKER_TYPE(QT_RECURSIVE_MUTEX)
 
 [[nodiscard]] inline QT_MUTEX_LOCKER lockMutex(QMutex* pMutex) {
+    // QMutex does not lock a pthread mutex that could be intercepted
+    DEBUG_ASSERT_NOT_IN_REALTIME_SECTION("QMutex lock");
     return QT_MUTEX_LOCKER(pMutex);
 }
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 [[nodiscard]] inline QT_RECURSIVE_MUTEX_LOCKER lockMutex(QRecursiveMutex* pMutex) {
+    DEBUG_ASSERT_NOT_IN_REALTIME_SECTION("QRecursiveMutex lock");
     return QT_RECURSIVE_MUTEX_LOCKER(pMutex);
 }
 #endif
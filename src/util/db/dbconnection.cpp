@@ -1,5 +1,6 @@
 #include <QSqlDriver>
 #include <QSqlError>
+#include <QSqlQuery>
 
 #ifdef __SQLITE3__
 #include <sqlite3.h>
@@ -8,6 +9,7 @@
 #include "util/db/dbconnection.h"
 
 #include "util/db/sqllikewildcards.h"
+#include "util/db/sqlwritebatch.h"
 #include "util/memory.h"
 #include "util/logger.h"
 #include "util/assert.h"
@@ -86,13 +88,19 @@ void makeLatinLow(QChar* c, int count) {
 // Compare two strings for equality where the first string is
 // a "LIKE" expression. Return true (1) if they are the same and
 // false (0) if they are different.
-// This is the original sqlite3 icuLikeCompare rewritten for QChar
+// This is the original sqlite3 icuLikeCompare rewritten for QChar.
+// The pattern must already be folded, the characters of the string
+// are folded while comparing them.
+template<typename Char, typename Fold>
 int likeCompareInner(
-        const QChar* pattern, // LIKE pattern
+        const Char* pattern, // LIKE pattern
         int patternSize,
-        const QChar* string, // The string to compare against
+        const Char* string, // The string to compare against
         int stringSize,
-        const QChar esc) { // The escape character
+        const Char esc, // The escape character
+        Fold fold) {
+    const auto matchAll = static_cast<Char>(kSqlLikeMatchAll.toLatin1());
+    const auto matchOne = static_cast<Char>(kSqlLikeMatchOne.toLatin1());
     int iPattern = 0; // Current index in pattern
     int iString = 0; // Current index in string
 
@@ -100,16 +108,16 @@ int likeCompareInner(
 
     while (iPattern < patternSize) {
         // Read (and consume) the next character from the input pattern.
-        QChar uPattern = pattern[iPattern++];
+        Char uPattern = pattern[iPattern++];
         // There are now 4 possibilities:
         // 1. uPattern is an unescaped match-all character "%",
         // 2. uPattern is an unescaped match-one character "_",
         // 3. uPattern is an unescaped escape character, or
         // 4. uPattern is to be handled as an ordinary character
 
-        if (!prevEscape && uPattern == kSqlLikeMatchAll) {
+        if (!prevEscape && uPattern == matchAll) {
             // Case 1.
-            QChar c;
+            Char c;
 
             // Skip any kSqlLikeMatchAll or kSqlLikeMatchOne characters that follow a
             // kSqlLikeMatchAll. For each kSqlLikeMatchOne, skip one character in the
@@ -120,8 +128,8 @@ int likeCompareInner(
                 return 1;
             }
 
-            while ((c = pattern[iPattern]) == kSqlLikeMatchAll || c == kSqlLikeMatchOne) {
-                if (c == kSqlLikeMatchOne) {
+            while ((c = pattern[iPattern]) == matchAll || c == matchOne) {
+                if (c == matchOne) {
                     if (++iString == stringSize) {
                         return 0;
                     }
@@ -134,13 +142,13 @@ int likeCompareInner(
 
             while (iString < stringSize) {
                 if (likeCompareInner(&pattern[iPattern], patternSize - iPattern,
-                                &string[iString], stringSize - iString, esc)) {
+                                &string[iString], stringSize - iString, esc, fold)) {
                     return 1;
                 }
                 iString++;
             }
             return 0;
-        } else if (!prevEscape && uPattern == kSqlLikeMatchOne) {
+        } else if (!prevEscape && uPattern == matchOne) {
             // Case 2.
             if (++iString == stringSize) {
                 return 0;
@@ -153,7 +161,7 @@ int likeCompareInner(
             if (iString == stringSize) {
                 return 0;
             }
-            QChar uString = string[iString++];
+            Char uString = fold(string[iString++]);
             if (uString != uPattern) {
                 return 0;
             }
@@ -163,6 +171,24 @@ int likeCompareInner(
     return iString == stringSize;
 }
 
+inline QChar foldedLatinLow(QChar c) {
+    // Already folded by makeLatinLow()
+    return c;
+}
+
+inline char foldedAsciiLow(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+inline bool isAscii(const char* data, int size) {
+    for (int i = 0; i < size; ++i) {
+        if (static_cast<unsigned char>(data[i]) >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
 #ifdef __SQLITE3__
 
 namespace {
@@ -191,9 +217,27 @@ int sqliteStringCompareUTF16(void* pArg,
 
 const char kLexicographicalCollationFunc[] = "mixxxLexicographicalCollationFunc";
 
+// The folded variants of a LIKE pattern. The pattern is the same
+// for all rows of a statement and only folded once, see
+// sqlite3_set_auxdata().
+struct SqliteLikePattern {
+    QString latinLow;
+    // Only valid if the pattern is ASCII
+    QByteArray asciiLow;
+    bool ascii;
+};
+
+void deleteSqliteLikePattern(void* pPattern) {
+    delete static_cast<SqliteLikePattern*>(pPattern);
+}
+
 // This implements the like() SQL function. This is used by the LIKE operator.
 // The SQL statement 'A LIKE B' is implemented as 'like(B, A)', and if there is
 // an escape character, say E, it is implemented as 'like(B, A, E)'
+//
+// Most strings are plain ASCII, which doesn't need to be decomposed.
+// Those are compared directly on the UTF-8 bytes without converting
+// them into a QString.
 //static
 void sqliteLikeUtf8(sqlite3_context* context,
         int aArgc,
@@ -210,9 +254,7 @@ void sqliteLikeUtf8(sqlite3_context* context,
     if (!a || !b) {
         return;
     }
-
-    QString stringB = QString::fromUtf8(b); // Like String
-    QString stringA = QString::fromUtf8(a);
+    const int aSize = sqlite3_value_bytes(aArgv[1]);
 
     QChar esc = kSqlLikeEscapeDefault;
     if (aArgc == 3) {
@@ -226,7 +268,42 @@ void sqliteLikeUtf8(sqlite3_context* context,
         }
     }
 
-    int ret = DbConnection::likeCompareLatinLow(&stringB, &stringA, esc);
+    const auto* pPattern = static_cast<const SqliteLikePattern*>(
+            sqlite3_get_auxdata(context, 0));
+    SqliteLikePattern pattern;
+    if (!pPattern) {
+        const int bSize = sqlite3_value_bytes(aArgv[0]);
+        pattern.latinLow = QString::fromUtf8(b, bSize);
+        makeLatinLow(pattern.latinLow.data(), pattern.latinLow.length());
+        pattern.ascii = isAscii(b, bSize);
+        if (pattern.ascii) {
+            pattern.asciiLow = QByteArray(b, bSize).toLower();
+        }
+        pPattern = &pattern;
+        // SQLite takes ownership of the copy and might delete it immediately
+        sqlite3_set_auxdata(context, 0, new SqliteLikePattern(pattern), deleteSqliteLikePattern);
+    }
+
+    int ret;
+    if (pPattern->ascii && esc.unicode() < 0x80 && isAscii(a, aSize)) {
+        ret = likeCompareInner(
+                pPattern->asciiLow.constData(),
+                pPattern->asciiLow.size(),
+                a,
+                aSize,
+                esc.toLatin1(),
+                foldedAsciiLow);
+    } else {
+        QString stringA = QString::fromUtf8(a, aSize);
+        makeLatinLow(stringA.data(), stringA.length());
+        ret = likeCompareInner(
+                pPattern->latinLow.constData(),
+                pPattern->latinLow.length(),
+                stringA.constData(),
+                stringA.length(),
+                esc,
+                foldedLatinLow);
+    }
     sqlite3_result_int64(context, ret);
     return;
 }
@@ -312,18 +389,37 @@ bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator
     return true;
 }
 
+void execStatements(const QSqlDatabase& database, const QStringList& statements) {
+    DEBUG_ASSERT(database.isOpen());
+    for (const auto& statement : statements) {
+        QSqlQuery query(database);
+        // Failures are not fatal, the connection remains usable
+        // with the default settings
+        if (!query.exec(statement)) {
+            kLogger.warning()
+                    << "Failed to execute statement"
+                    << statement
+                    << query.lastError();
+        }
+    }
+}
+
 } // anonymous namespace
 
 DbConnection::DbConnection(
         const Params& params,
         const QString& connectionName)
-    : m_sqlDatabase(createDatabase(params, connectionName)) {
+    : m_sqlDatabase(createDatabase(params, connectionName)),
+      m_openStatements(params.openStatements),
+      m_closeStatements(params.closeStatements) {
 }
 
 DbConnection::DbConnection(
         const DbConnection& prototype,
         const QString& connectionName)
-    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)) {
+    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)),
+      m_openStatements(prototype.m_openStatements),
+      m_closeStatements(prototype.m_closeStatements) {
 }
 
 DbConnection::~DbConnection() {
@@ -351,11 +447,14 @@ bool DbConnection::open() {
         m_sqlDatabase.close();
         return false; // abort
     }
+    execStatements(m_sqlDatabase, m_openStatements);
     return true;
 }
 
 void DbConnection::close() {
     if (m_sqlDatabase.isOpen()) {
+        // Pending writes are expected and not an outstanding transaction
+        SqlWriteBatch::flush(m_sqlDatabase);
         // There should never be an outstanding transaction when this code is
         // called. If there is, it means we probably aren't committing a
         // transaction somewhere that should be.
@@ -364,6 +463,7 @@ void DbConnection::close() {
                 << "Rolled back open transaction before closing database connection:"
                 << *this;
         }
+        execStatements(m_sqlDatabase, m_closeStatements);
         if (kLogger.debugEnabled()) {
             kLogger.debug()
                     << "Closing database connection:"
@@ -390,9 +490,9 @@ int DbConnection::likeCompareLatinLow(
     makeLatinLow(pattern->data(), pattern->length());
     makeLatinLow(string->data(), string->length());
     return likeCompareInner(
-            pattern->data(), pattern->length(),
-            string->data(), string->length(),
-            esc);
+            pattern->constData(), pattern->length(),
+            string->constData(), string->length(),
+            esc, foldedLatinLow);
 }
 
 //static
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QSqlDatabase>
+#include <QStringList>
 #include <QtDebug>
 
 #include "util/string.h"
@@ -29,6 +30,11 @@ class DbConnection final {
         QString filePath;
         QString userName;
         QString password;
+        // Executed after opening each connection, e.g. to
+        // configure the connection with PRAGMA statements
+        QStringList openStatements;
+        // Executed before closing each connection
+        QStringList closeStatements;
     };
 
     // All constructors are reserved for DbConnectionPool!!
@@ -63,6 +69,8 @@ class DbConnection final {
 
     QSqlDatabase m_sqlDatabase;
     mixxx::StringCollator m_collator;
+    QStringList m_openStatements;
+    QStringList m_closeStatements;
 };
 
 } // namespace mixxx
@@ -4,6 +4,7 @@
 
 #include "util/performancetimer.h"
 #include "util/logger.h"
+#include "util/metrics.h"
 #include "util/assert.h"
 
 
@@ -68,10 +69,10 @@ bool FwdSqlQuery::execPrepared() {
     DEBUG_ASSERT(isPrepared());
     DEBUG_ASSERT(!hasError());
     PerformanceTimer timer;
-    if (kLogger.traceEnabled()) {
-        timer.start();
-    }
-    if (exec()) {
+    timer.start();
+    const bool success = exec();
+    mixxx::metrics::dbQuerySeconds.observe(timer.elapsed().toDoubleSeconds());
+    if (success) {
         if (kLogger.traceEnabled()) {
             if (kLogger.traceEnabled()) {
                 kLogger.tracePerformance(
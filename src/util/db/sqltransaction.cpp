@@ -1,5 +1,6 @@
 #include "util/db/sqltransaction.h"
 
+#include "util/db/sqlwritebatch.h"
 #include "util/logger.h"
 #include "util/assert.h"
 
@@ -17,6 +18,8 @@ bool beginTransaction(QSqlDatabase database) {
                 << database.connectionName();
         return false;
     }
+    // Transactions could not be nested
+    SqlWriteBatch::flush(database);
     if (database.transaction()) {
         if (kLogger.debugEnabled()) {
             kLogger.debug()
@@ -0,0 +1,118 @@
+#include "util/db/sqlwritebatch.h"
+
+#include <QAbstractEventDispatcher>
+#include <QHash>
+#include <QSqlError>
+#include <QTimer>
+
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SqlWriteBatch");
+
+// Changes become visible for other connections after this delay
+constexpr int kCommitDelayMillis = 250;
+
+// Limits the time that other connections are blocked from writing
+constexpr int kMaxOperations = 500;
+
+struct PendingBatch {
+    QSqlDatabase database;
+    int operations;
+    quint64 generation;
+};
+
+// Connections are bound to a thread
+QHash<QString, PendingBatch>& pendingBatches() {
+    static thread_local QHash<QString, PendingBatch> batches;
+    return batches;
+}
+
+quint64& nextGeneration() {
+    static thread_local quint64 generation = 0;
+    return generation;
+}
+
+bool commitPendingBatch(const QString& connectionName) {
+    auto& batches = pendingBatches();
+    const auto i = batches.find(connectionName);
+    if (i == batches.end()) {
+        return true;
+    }
+    // Don't keep a reference on the connection
+    QSqlDatabase database = std::move(i.value().database);
+    const int operations = i.value().operations;
+    batches.erase(i);
+    if (!database.isOpen()) {
+        kLogger.warning()
+                << "Failed to commit"
+                << operations
+                << "operation(s): No open SQL database connection";
+        return false;
+    }
+    if (!database.commit()) {
+        kLogger.warning()
+                << "Failed to commit"
+                << operations
+                << "operation(s) on"
+                << connectionName
+                << database.lastError();
+        database.rollback();
+        return false;
+    }
+    if (kLogger.debugEnabled()) {
+        kLogger.debug()
+                << "Committed"
+                << operations
+                << "operation(s) on"
+                << connectionName;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// static
+bool SqlWriteBatch::join(const QSqlDatabase& database) {
+    if (!database.isOpen() || !QAbstractEventDispatcher::instance()) {
+        return false;
+    }
+    const QString connectionName = database.connectionName();
+    auto& batches = pendingBatches();
+    auto i = batches.find(connectionName);
+    if (i != batches.end()) {
+        if (i.value().operations < kMaxOperations) {
+            ++i.value().operations;
+            return true;
+        }
+        commitPendingBatch(connectionName);
+    }
+    // Fails if another transaction is active
+    QSqlDatabase batchDatabase = database;
+    if (!batchDatabase.transaction()) {
+        return false;
+    }
+    const quint64 generation = ++nextGeneration();
+    batches.insert(connectionName, PendingBatch{std::move(batchDatabase), 1, generation});
+    QTimer::singleShot(kCommitDelayMillis, [connectionName, generation] {
+        const auto& batches = pendingBatches();
+        const auto i = batches.constFind(connectionName);
+        // Skip batches that have already been committed
+        if (i != batches.constEnd() && i.value().generation == generation) {
+            commitPendingBatch(connectionName);
+        }
+    });
+    return true;
+}
+
+// static
+bool SqlWriteBatch::flush(const QSqlDatabase& database) {
+    return commitPendingBatch(database.connectionName());
+}
+
+// static
+bool SqlWriteBatch::isPending(const QSqlDatabase& database) {
+    return pendingBatches().contains(database.connectionName());
+}
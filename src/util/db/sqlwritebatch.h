@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QSqlDatabase>
+
+/// Groups the writes of subsequent operations on the same database
+/// connection into a single transaction, e.g. when saving many tracks
+/// after an analysis or an import. Committing only once for all of
+/// them avoids syncing the database file with the disk after each
+/// operation.
+///
+/// The pending transaction is committed by the event loop of the
+/// connection's thread after a short delay, after a maximum number of
+/// operations, before a new SqlTransaction is started on the same
+/// connection, when the connection is closed, or explicitly by flush().
+/// Writes of the pending transaction are lost if the application
+/// crashes before it has been committed.
+///
+/// Only available for threads with an event loop. All functions must
+/// be invoked from the thread of the connection.
+class SqlWriteBatch final {
+  public:
+    /// Adds an operation to the pending transaction of the connection
+    /// and starts a new transaction if needed. Returns false if batching
+    /// is not available and the caller needs to use its own transaction,
+    /// e.g. if another transaction is already active.
+    static bool join(const QSqlDatabase& database);
+
+    /// Commits the pending transaction of the connection if any.
+    /// Returns false if committing failed.
+    static bool flush(const QSqlDatabase& database);
+
+    static bool isPending(const QSqlDatabase& database);
+
+    SqlWriteBatch() = delete;
+};
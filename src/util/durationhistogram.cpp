@@ -0,0 +1,93 @@
+#include "util/durationhistogram.h"
+
+namespace mixxx {
+
+namespace {
+
+int highestBit(std::uint64_t value) {
+    int bit = -1;
+    while (value != 0) {
+        value >>= 1;
+        ++bit;
+    }
+    return bit;
+}
+
+} // anonymous namespace
+
+DurationHistogram::DurationHistogram()
+        : m_maxNanos(0),
+          m_lastCounts{} {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+// static
+int DurationHistogram::bucketIndex(std::int64_t nanos) {
+    if (nanos < kSubBuckets) {
+        // Exact buckets for the smallest values
+        return nanos < 0 ? 0 : static_cast<int>(nanos);
+    }
+    const int exponent = highestBit(static_cast<std::uint64_t>(nanos));
+    if (exponent > kMaxExponent) {
+        return kNumBuckets - 1;
+    }
+    const int subBucket = static_cast<int>(
+            (nanos >> (exponent - kSubBucketBits)) & (kSubBuckets - 1));
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + subBucket;
+}
+
+// static
+std::int64_t DurationHistogram::bucketUpperBound(int index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const int exponent = index / kSubBuckets + kSubBucketBits - 1;
+    const int subBucket = index % kSubBuckets;
+    const std::int64_t width = std::int64_t(1) << (exponent - kSubBucketBits);
+    return (kSubBuckets + subBucket) * width + width - 1;
+}
+
+DurationHistogram::Summary DurationHistogram::takeSummary() {
+    std::array<std::uint32_t, kNumBuckets> counts;
+    Summary summary;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        const std::uint32_t total = m_buckets[i].load(std::memory_order_relaxed);
+        // Unsigned arithmetic handles the wrap around of the counters
+        counts[i] = total - m_lastCounts[i];
+        m_lastCounts[i] = total;
+        summary.count += counts[i];
+    }
+    summary.max = Duration::fromNanos(m_maxNanos.exchange(0, std::memory_order_relaxed));
+    if (summary.count == 0) {
+        return summary;
+    }
+    const std::uint64_t p50Rank = (static_cast<std::uint64_t>(summary.count) * 50 + 99) / 100;
+    const std::uint64_t p99Rank = (static_cast<std::uint64_t>(summary.count) * 99 + 99) / 100;
+    std::uint64_t accumulated = 0;
+    bool p50Found = false;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        accumulated += counts[i];
+        if (!p50Found && accumulated >= p50Rank) {
+            summary.p50 = Duration::fromNanos(bucketUpperBound(i));
+            p50Found = true;
+        }
+        if (accumulated >= p99Rank) {
+            summary.p99 = Duration::fromNanos(bucketUpperBound(i));
+            break;
+        }
+    }
+    // The upper bound of a bucket might exceed the actual maximum
+    if (summary.max > Duration::empty()) {
+        if (summary.p50 > summary.max) {
+            summary.p50 = summary.max;
+        }
+        if (summary.p99 > summary.max) {
+            summary.p99 = summary.max;
+        }
+    }
+    return summary;
+}
+
+} // namespace mixxx
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "util/duration.h"
+
+namespace mixxx {
+
+/// A lock-free histogram of durations with a fixed number of logarithmic
+/// buckets. Each power of two is divided into 8 buckets, i.e. the relative
+/// error of the reported percentiles is less than 12.5%.
+///
+/// Durations are recorded by a single real-time thread without allocating
+/// memory or locking. A single other thread, e.g. the GUI thread, can
+/// periodically fetch a summary of all durations that have been recorded
+/// since its previous call.
+class DurationHistogram final {
+  public:
+    struct Summary {
+        std::uint32_t count = 0;
+        Duration p50;
+        Duration p99;
+        Duration max;
+    };
+
+    DurationHistogram();
+
+    /// Called by the writer thread
+    void record(Duration duration) {
+        const std::int64_t nanos = duration.toIntegerNanos();
+        const int index = bucketIndex(nanos);
+        m_buckets[index].store(
+                m_buckets[index].load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+        if (nanos > m_maxNanos.load(std::memory_order_relaxed)) {
+            m_maxNanos.store(nanos, std::memory_order_relaxed);
+        }
+    }
+
+    /// Called by the reader thread. Returns the summary of all durations
+    /// that have been recorded since the last invocation.
+    Summary takeSummary();
+
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    // Covers all durations up to 2^35 ns (~34 s), longer durations
+    // are counted in the last bucket.
+    static constexpr int kMaxExponent = 34;
+    static constexpr int kNumBuckets = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+    static int bucketIndex(std::int64_t nanos);
+    /// The largest duration that is counted in the bucket
+    static std::int64_t bucketUpperBound(int index);
+
+  private:
+    std::array<std::atomic<std::uint32_t>, kNumBuckets> m_buckets;
+    std::atomic<std::int64_t> m_maxNanos;
+
+    // Only accessed by the reader
+    std::array<std::uint32_t, kNumBuckets> m_lastCounts;
+};
+
+} // namespace mixxx
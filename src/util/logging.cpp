@@ -12,6 +12,10 @@
 #include <QString>
 #include <QTextStream>
 #include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
 #include <string_view>
 
 #include "util/assert.h"
@@ -143,17 +147,10 @@ inline QString formatLogFileMessage(
     return levelName + QStringLiteral(" [") + threadName + QStringLiteral("] ") + message;
 }
 
-/// Actually write a log message to a file.
+/// Actually write a formatted log message to a file.
 inline void writeToFile(
-        QtMsgType type,
-        const QString& message,
-        const QString& threadName,
+        const QByteArray& formattedMessage,
         bool flush) {
-    QString formattedMessageStr =
-            formatLogFileMessage(type, message, threadName) +
-            QChar('\n');
-    QByteArray formattedMessage = formattedMessageStr.toLocal8Bit();
-
     const auto locked = lockMutex(&s_mutexLogfile);
     // Writing to a closed QFile could cause an infinite recursive loop
     // by logging to qWarning!
@@ -169,18 +166,10 @@ inline void writeToFile(
     }
 }
 
-/// Actually write a log message to stderr.
+/// Actually write a formatted log message to stderr.
 inline void writeToStdErr(
-        QtMsgType type,
-        const QMessageLogContext& context,
-        const QString& message,
-        const QString& threadName,
+        const QByteArray& formattedMessage,
         bool flush) {
-    QString formattedMessageStr = qFormatLogMessage(type, context, message) + QChar('\n');
-    const QByteArray formattedMessage =
-            formattedMessageStr.replace(kThreadNamePattern, threadName)
-                    .toLocal8Bit();
-
     const auto locked = lockMutex(&s_mutexStdErr);
     const std::size_t written = fwrite(
             formattedMessage.constData(), sizeof(char), formattedMessage.size(), stderr);
@@ -197,6 +186,220 @@ inline void writeToStdErr(
     }
 }
 
+/// A log message that has been formatted by the logging thread. Each line
+/// is empty if the message is not written to the corresponding output.
+struct FormattedMessage {
+    QByteArray stdErrLine;
+    QByteArray fileLine;
+
+    bool operator==(const FormattedMessage& other) const {
+        return stdErrLine == other.stdErrLine && fileLine == other.fileLine;
+    }
+    bool operator!=(const FormattedMessage& other) const {
+        return !(*this == other);
+    }
+};
+
+/// Write the formatted lines of a message to their outputs.
+inline void writeFormattedMessage(const FormattedMessage& message, bool flush) {
+    if (!message.stdErrLine.isEmpty()) {
+        writeToStdErr(message.stdErrLine, flush);
+    }
+    if (!message.fileLine.isEmpty()) {
+        writeToFile(message.fileLine, flush);
+    }
+}
+
+/// Upper bound of queued messages, so a thread that floods the log can't
+/// exhaust the memory while the writer is busy.
+constexpr int kMaxPendingMessages = 10000;
+
+const QString kLogWriterThreadName = QStringLiteral("Logging");
+
+/// The audio callback and the engine channel workers must never wait for a
+/// lock, messages of these threads are dropped instead if the queue is busy.
+const QString kRealtimeThreadNamePrefix = QStringLiteral("Engine");
+
+thread_local bool t_isLogWriterThread = false;
+
+/// Writes the log messages of all threads from a background thread, so the
+/// logging threads don't wait for stderr and the log file. The messages are
+/// formatted by the logging thread and only appended to a queue under a
+/// short lock.
+///
+/// Consecutive repetitions of the same message are counted instead of
+/// written and summarized once a different message arrives or the writer
+/// is drained.
+class AsyncLogWriter {
+  public:
+    ~AsyncLogWriter() {
+        stop();
+    }
+
+    void start() {
+        const auto locked = lockMutex(&m_mutex);
+        VERIFY_OR_DEBUG_ASSERT(!m_pThread) {
+            return;
+        }
+        m_running = true;
+        m_idle = true;
+        m_pThread.reset(QThread::create([this] {
+            t_isLogWriterThread = true;
+            run();
+        }));
+        m_pThread->setObjectName(kLogWriterThreadName);
+        m_pThread->start(QThread::LowPriority);
+    }
+
+    /// Writes the remaining messages and joins the writer thread. Messages
+    /// that are logged afterwards are written synchronously.
+    void stop() {
+        std::unique_ptr<QThread> pThread;
+        {
+            const auto locked = lockMutex(&m_mutex);
+            if (!m_running) {
+                return;
+            }
+            m_running = false;
+            m_wakeUp.wakeOne();
+            pThread = std::move(m_pThread);
+        }
+        pThread->wait();
+    }
+
+    /// Returns false if the message must be written synchronously, because
+    /// the writer is not running.
+    bool enqueue(FormattedMessage&& message, bool realtime) {
+        if (realtime) {
+            if (!m_mutex.tryLock()) {
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        } else {
+            m_mutex.lock();
+        }
+        if (!m_running) {
+            m_mutex.unlock();
+            return false;
+        }
+        if (m_pending.size() >= kMaxPendingMessages) {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_pending.append(std::move(message));
+            m_wakeUp.wakeOne();
+        }
+        m_mutex.unlock();
+        return true;
+    }
+
+    /// Waits until all queued messages have been written, which must be
+    /// done before writing a message synchronously to keep the order.
+    void drain() {
+        if (t_isLogWriterThread) {
+            // The writer itself got here by a failed assertion
+            return;
+        }
+        const auto locked = lockMutex(&m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_drainRequested = true;
+        m_wakeUp.wakeOne();
+        while (m_running && (!m_pending.isEmpty() || !m_idle || m_drainRequested)) {
+            m_drained.wait(&m_mutex);
+        }
+    }
+
+  private:
+    void run() {
+        QVector<FormattedMessage> messages;
+        while (true) {
+            bool drainRequested;
+            bool running;
+            {
+                const auto locked = lockMutex(&m_mutex);
+                while (m_running && m_pending.isEmpty() && !m_drainRequested) {
+                    m_idle = true;
+                    m_drained.wakeAll();
+                    m_wakeUp.wait(&m_mutex);
+                }
+                m_idle = false;
+                messages.swap(m_pending);
+                drainRequested = m_drainRequested;
+                m_drainRequested = false;
+                running = m_running;
+            }
+            for (auto& message : messages) {
+                write(std::move(message));
+            }
+            messages.clear();
+            const int droppedCount = m_droppedCount.exchange(0, std::memory_order_relaxed);
+            if (droppedCount > 0) {
+                writeSummary(QStringLiteral("Warning [%1] %2 log messages were dropped")
+                                     .arg(kLogWriterThreadName, QString::number(droppedCount)),
+                        true);
+            }
+            if (drainRequested || !running) {
+                writeRepeatSummary();
+            }
+            if (!running) {
+                break;
+            }
+        }
+        const auto locked = lockMutex(&m_mutex);
+        m_idle = true;
+        m_drained.wakeAll();
+    }
+
+    void write(FormattedMessage&& message) {
+        if (message == m_lastMessage) {
+            ++m_repeatCount;
+            return;
+        }
+        writeRepeatSummary();
+        writeFormattedMessage(message, false);
+        m_lastMessage = std::move(message);
+    }
+
+    void writeRepeatSummary() {
+        if (m_repeatCount == 0) {
+            return;
+        }
+        writeSummary(QStringLiteral("Info [%1] Last message repeated %2 times")
+                             .arg(kLogWriterThreadName, QString::number(m_repeatCount)),
+                !m_lastMessage.stdErrLine.isEmpty());
+        m_repeatCount = 0;
+        // A repetition after the summary starts a new count
+        m_lastMessage = FormattedMessage();
+    }
+
+    void writeSummary(const QString& summary, bool toStdErr) {
+        const QByteArray line = (summary + QChar('\n')).toLocal8Bit();
+        FormattedMessage message;
+        if (toStdErr) {
+            message.stdErrLine = line;
+        }
+        message.fileLine = line;
+        writeFormattedMessage(message, false);
+    }
+
+    QMutex m_mutex;
+    QWaitCondition m_wakeUp;
+    QWaitCondition m_drained;
+    QVector<FormattedMessage> m_pending;
+    std::unique_ptr<QThread> m_pThread;
+    bool m_running = false;
+    bool m_idle = true;
+    bool m_drainRequested = false;
+    std::atomic<int> m_droppedCount{0};
+
+    // Only accessed by the writer thread
+    FormattedMessage m_lastMessage;
+    int m_repeatCount = 0;
+};
+
+AsyncLogWriter s_asyncLogWriter;
+
 /// Rotate existing logfiles and get the file path of the log file to write to.
 /// May return an invalid/empty QString if the log directory does not exist.
 QString rotateLogFilesAndGetFilePath(const QString& logDirPath) {
@@ -251,13 +454,29 @@ inline void writeToLog(
         textStream << QThread::currentThread();
     }
 
-    const bool flush = flags & WriteFlag::Flush;
+    FormattedMessage formattedMessage;
     if (flags & WriteFlag::StdErr) {
-        writeToStdErr(type, context, message, threadName, flush);
+        QString formattedMessageStr = qFormatLogMessage(type, context, message) + QChar('\n');
+        formattedMessage.stdErrLine =
+                formattedMessageStr.replace(kThreadNamePattern, threadName)
+                        .toLocal8Bit();
     }
     if (flags & WriteFlag::File) {
-        writeToFile(type, message, threadName, flush);
+        formattedMessage.fileLine =
+                (formatLogFileMessage(type, message, threadName) + QChar('\n'))
+                        .toLocal8Bit();
     }
+
+    const bool flush = flags & WriteFlag::Flush;
+    if (flush) {
+        // Messages that need to be flushed are written immediately, e.g.
+        // before aborting on a fatal message, after all queued messages.
+        s_asyncLogWriter.drain();
+    } else if (s_asyncLogWriter.enqueue(std::move(formattedMessage),
+                       threadName.startsWith(kRealtimeThreadNamePrefix))) {
+        return;
+    }
+    writeFormattedMessage(formattedMessage, flush);
 }
 
 } // anonymous namespace
@@ -397,6 +616,10 @@ void Logging::initialize(
 
     s_debugAssertBreak = flags.testFlag(LogFlag::DebugAssertBreak);
 
+    if (flags.testFlag(LogFlag::AsyncWrite)) {
+        s_asyncLogWriter.start();
+    }
+
     if (CmdlineArgs::Instance().useColors()) {
         qSetMessagePattern(kDefaultMessagePatternColor);
     } else {
@@ -441,6 +664,9 @@ void Logging::shutdown() {
     // Reset the Qt message handler to default.
     qInstallMessageHandler(nullptr);
 
+    // Write the queued messages before closing the log file
+    s_asyncLogWriter.stop();
+
     // Even though we uninstalled the message handler, other threads may have
     // already entered it.
     const auto locker = lockMutex(&s_mutexLogfile);
@@ -451,6 +677,7 @@ void Logging::shutdown() {
 
 // static
 void Logging::flushLogFile() {
+    s_asyncLogWriter.drain();
     QMutexLocker locker(&s_mutexLogfile);
     if (s_logfile.isOpen()) {
         s_logfile.flush();
@@ -16,6 +16,8 @@ enum class LogFlag {
     None = 0,
     LogToFile = 1,
     DebugAssertBreak = 1 << 1,
+    /// Write messages from a background thread instead of the logging one
+    AsyncWrite = 1 << 2,
 };
 Q_DECLARE_FLAGS(LogFlags, LogFlag);
 Q_DECLARE_OPERATORS_FOR_FLAGS(LogFlags);
@@ -0,0 +1,67 @@
+#include "util/memoryaccounting.h"
+
+#include <QPixmapCache>
+
+#include "control/controlobject.h"
+#include "moc_memoryaccounting.cpp"
+#include "util/metrics.h"
+
+namespace mixxx {
+
+namespace {
+
+const QString kGroup = QStringLiteral("[Memory]");
+
+// The same default as in CoverArtCache
+const ConfigKey kCoverArtBudgetConfigKey =
+        ConfigKey(kGroup, QStringLiteral("cover_art_budget_kb"));
+constexpr int kDefaultCoverArtBudgetKb = 20480;
+
+constexpr int kUpdateIntervalMillis = 1000;
+
+std::unique_ptr<ControlObject> createBytesControl(const QString& item) {
+    auto pControl = std::make_unique<ControlObject>(ConfigKey(kGroup, item));
+    pControl->setReadOnly();
+    return pControl;
+}
+
+} // anonymous namespace
+
+MemoryAccounting::MemoryAccounting(UserSettingsPointer pConfig, QObject* parent)
+        : QObject(parent),
+          m_pCachingReaderBytes(createBytesControl(QStringLiteral("caching_reader_bytes"))),
+          m_pWaveformBytes(createBytesControl(QStringLiteral("waveform_bytes"))),
+          m_pTrackCacheBytes(createBytesControl(QStringLiteral("track_cache_bytes"))),
+          m_pEffectStateBytes(createBytesControl(QStringLiteral("effect_state_bytes"))),
+          m_pTotalBytes(createBytesControl(QStringLiteral("total_bytes"))) {
+    // Least recently used pixmaps are evicted when the budget is exceeded
+    const int coverArtBudgetKb = pConfig->getValue(
+            kCoverArtBudgetConfigKey, kDefaultCoverArtBudgetKb);
+    if (coverArtBudgetKb > 0) {
+        QPixmapCache::setCacheLimit(coverArtBudgetKb);
+    }
+
+    connect(&m_updateTimer,
+            &QTimer::timeout,
+            this,
+            &MemoryAccounting::slotUpdate);
+    m_updateTimer.start(kUpdateIntervalMillis);
+    slotUpdate();
+}
+
+MemoryAccounting::~MemoryAccounting() = default;
+
+void MemoryAccounting::slotUpdate() {
+    const qint64 cachingReaderBytes = metrics::cachingReaderBytes.value();
+    const qint64 waveformBytes = metrics::waveformBytes.value();
+    const qint64 trackCacheBytes = metrics::trackCacheBytes.value();
+    const qint64 effectStateBytes = metrics::effectStateBytes.value();
+    m_pCachingReaderBytes->forceSet(static_cast<double>(cachingReaderBytes));
+    m_pWaveformBytes->forceSet(static_cast<double>(waveformBytes));
+    m_pTrackCacheBytes->forceSet(static_cast<double>(trackCacheBytes));
+    m_pEffectStateBytes->forceSet(static_cast<double>(effectStateBytes));
+    m_pTotalBytes->forceSet(static_cast<double>(cachingReaderBytes +
+            waveformBytes + trackCacheBytes + effectStateBytes));
+}
+
+} // namespace mixxx
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <memory>
+
+#include "preferences/usersettings.h"
+
+class ControlObject;
+
+namespace mixxx {
+
+/// Publishes the memory usage of the subsystems that hold most of the
+/// memory as read-only controls in the [Memory] group, e.g. for watching
+/// them in the developer tools or from a remote dashboard.
+///
+/// The byte counts are taken from the gauges in mixxx::metrics, which are
+/// updated by the subsystems whenever they (re)allocate their buffers.
+/// Only the budget of the cover art cache is configurable here, the size
+/// of the shared chunk cache is set by [Master],cached_chunks_shared.
+class MemoryAccounting : public QObject {
+    Q_OBJECT
+  public:
+    explicit MemoryAccounting(UserSettingsPointer pConfig, QObject* parent = nullptr);
+    ~MemoryAccounting() override;
+
+  private slots:
+    void slotUpdate();
+
+  private:
+    std::unique_ptr<ControlObject> m_pCachingReaderBytes;
+    std::unique_ptr<ControlObject> m_pWaveformBytes;
+    std::unique_ptr<ControlObject> m_pTrackCacheBytes;
+    std::unique_ptr<ControlObject> m_pEffectStateBytes;
+    std::unique_ptr<ControlObject> m_pTotalBytes;
+    QTimer m_updateTimer;
+};
+
+} // namespace mixxx
@@ -0,0 +1,144 @@
+#include "util/metrics.h"
+
+#include "util/assert.h"
+
+namespace mixxx {
+
+namespace metrics {
+
+MetricHistogram::MetricHistogram(const char* name,
+        const char* help,
+        std::initializer_list<double> upperBounds)
+        : m_name(name),
+          m_help(help),
+          m_upperBounds{},
+          m_boundCount(0),
+          m_bucketCounts{},
+          m_sum(0.0) {
+    DEBUG_ASSERT(upperBounds.size() <= static_cast<size_t>(kMaxBucketCount));
+    for (double upperBound : upperBounds) {
+        if (m_boundCount == kMaxBucketCount) {
+            break;
+        }
+        DEBUG_ASSERT(m_boundCount == 0 || m_upperBounds[m_boundCount - 1] < upperBound);
+        m_upperBounds[m_boundCount++] = upperBound;
+    }
+}
+
+MetricHistogram engineLoad("mixxx_engine_load",
+        "Time spent in the audio callback relative to the duration of the buffer",
+        {0.1, 0.25, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0});
+MetricCounter engineUnderflows("mixxx_engine_underflows",
+        "Audio buffer underflows");
+
+MetricCounter cachingReaderHits("mixxx_caching_reader_hits",
+        "Chunk reads of the decks that were served from the cache");
+MetricCounter cachingReaderMisses("mixxx_caching_reader_misses",
+        "Chunk reads of the decks that could not be served in time");
+
+MetricGauge sideChainBacklogSamples("mixxx_sidechain_backlog_samples",
+        "Samples the recording and broadcast workers read at their last wakeup");
+MetricCounter sideChainLostSamples("mixxx_sidechain_lost_samples",
+        "Samples lost by recording and broadcast workers that fell behind");
+
+MetricGauge broadcastQueueBytes("mixxx_broadcast_queue_bytes",
+        "Encoded bytes waiting to be sent by all broadcast connections");
+MetricCounter broadcastDroppedPackets("mixxx_broadcast_dropped_packets",
+        "Encoded packets dropped because they could not be sent in time");
+
+MetricCounter analyzedTracks("mixxx_analyzed_tracks",
+        "Tracks with a finished analysis");
+MetricCounter analyzedFrames("mixxx_analyzed_frames",
+        "Sample frames passed to the analyzers");
+MetricCounter analysisNanos("mixxx_analysis_nanoseconds",
+        "Time spent decoding and analyzing tracks");
+
+MetricHistogram dbQuerySeconds("mixxx_db_query_seconds",
+        "Execution time of prepared database queries",
+        {0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0});
+
+MetricGauge cachingReaderBytes("mixxx_caching_reader_bytes",
+        "Sample buffers of the chunks of all decks and the shared chunk cache");
+MetricGauge waveformBytes("mixxx_waveform_bytes",
+        "Waveform and overview data of all tracks in memory");
+MetricGauge trackCacheBytes("mixxx_track_cache_bytes",
+        "Estimated column values of all tracks cached for the library views");
+MetricGauge effectStateBytes("mixxx_effect_state_bytes",
+        "Per channel states of all loaded effects, without their own buffers");
+
+namespace {
+
+void writeHeader(QByteArray* pText, const char* name, const char* type, const char* help) {
+    pText->append("# TYPE ").append(name).append(' ').append(type).append('\n');
+    pText->append("# HELP ").append(name).append(' ').append(help).append('\n');
+}
+
+void writeCounter(QByteArray* pText, const MetricCounter& counter) {
+    writeHeader(pText, counter.name(), "counter", counter.help());
+    pText->append(counter.name())
+            .append("_total ")
+            .append(QByteArray::number(counter.value()))
+            .append('\n');
+}
+
+void writeGauge(QByteArray* pText, const MetricGauge& gauge) {
+    writeHeader(pText, gauge.name(), "gauge", gauge.help());
+    pText->append(gauge.name())
+            .append(' ')
+            .append(QByteArray::number(gauge.value()))
+            .append('\n');
+}
+
+void writeHistogram(QByteArray* pText, const MetricHistogram& histogram) {
+    writeHeader(pText, histogram.name(), "histogram", histogram.help());
+    // The buckets are cumulative in the exposition format
+    quint64 count = 0;
+    for (int bucket = 0; bucket <= histogram.boundCount(); ++bucket) {
+        count += histogram.bucketCount(bucket);
+        const QByteArray upperBound = bucket < histogram.boundCount()
+                ? QByteArray::number(histogram.upperBound(bucket), 'g', 17)
+                : QByteArrayLiteral("+Inf");
+        pText->append(histogram.name())
+                .append("_bucket{le=\"")
+                .append(upperBound)
+                .append("\"} ")
+                .append(QByteArray::number(count))
+                .append('\n');
+    }
+    pText->append(histogram.name())
+            .append("_sum ")
+            .append(QByteArray::number(histogram.sum(), 'g', 17))
+            .append('\n');
+    pText->append(histogram.name())
+            .append("_count ")
+            .append(QByteArray::number(count))
+            .append('\n');
+}
+
+} // anonymous namespace
+
+QByteArray toOpenMetricsText() {
+    QByteArray text;
+    writeHistogram(&text, engineLoad);
+    writeCounter(&text, engineUnderflows);
+    writeCounter(&text, cachingReaderHits);
+    writeCounter(&text, cachingReaderMisses);
+    writeGauge(&text, sideChainBacklogSamples);
+    writeCounter(&text, sideChainLostSamples);
+    writeGauge(&text, broadcastQueueBytes);
+    writeCounter(&text, broadcastDroppedPackets);
+    writeCounter(&text, analyzedTracks);
+    writeCounter(&text, analyzedFrames);
+    writeCounter(&text, analysisNanos);
+    writeHistogram(&text, dbQuerySeconds);
+    writeGauge(&text, cachingReaderBytes);
+    writeGauge(&text, waveformBytes);
+    writeGauge(&text, trackCacheBytes);
+    writeGauge(&text, effectStateBytes);
+    text.append("# EOF\n");
+    return text;
+}
+
+} // namespace metrics
+
+} // namespace mixxx
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <initializer_list>
+
+namespace mixxx {
+
+namespace metrics {
+
+/// A monotonically increasing count of events.
+///
+/// Updates are wait-free and never allocate, so all metrics may be
+/// updated from any thread, including the engine thread.
+class MetricCounter {
+  public:
+    MetricCounter(const char* name, const char* help)
+            : m_name(name),
+              m_help(help),
+              m_value(0) {
+    }
+    MetricCounter(const MetricCounter&) = delete;
+    MetricCounter& operator=(const MetricCounter&) = delete;
+
+    void increment(quint64 delta = 1) {
+        m_value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    quint64 value() const {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    const char* name() const {
+        return m_name;
+    }
+    const char* help() const {
+        return m_help;
+    }
+
+  private:
+    const char* const m_name;
+    const char* const m_help;
+    std::atomic<quint64> m_value;
+};
+
+/// A value that may go up and down, e.g. a queue length.
+class MetricGauge {
+  public:
+    MetricGauge(const char* name, const char* help)
+            : m_name(name),
+              m_help(help),
+              m_value(0) {
+    }
+    MetricGauge(const MetricGauge&) = delete;
+    MetricGauge& operator=(const MetricGauge&) = delete;
+
+    void set(qint64 value) {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    /// Allows multiple instances of a component to contribute to the
+    /// same gauge.
+    void add(qint64 delta) {
+        m_value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    qint64 value() const {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    const char* name() const {
+        return m_name;
+    }
+    const char* help() const {
+        return m_help;
+    }
+
+  private:
+    const char* const m_name;
+    const char* const m_help;
+    std::atomic<qint64> m_value;
+};
+
+/// Counts observed values in buckets with fixed upper bounds, from which
+/// percentiles can be estimated by the monitoring system.
+class MetricHistogram {
+  public:
+    static constexpr int kMaxBucketCount = 12;
+
+    /// The upper bounds must be in ascending order. Values above the last
+    /// bound are counted in an implicit +Inf bucket.
+    MetricHistogram(const char* name,
+            const char* help,
+            std::initializer_list<double> upperBounds);
+    MetricHistogram(const MetricHistogram&) = delete;
+    MetricHistogram& operator=(const MetricHistogram&) = delete;
+
+    void observe(double value) {
+        int bucket = 0;
+        while (bucket < m_boundCount && value > m_upperBounds[bucket]) {
+            ++bucket;
+        }
+        m_bucketCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+        double sum = m_sum.load(std::memory_order_relaxed);
+        while (!m_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+        }
+    }
+
+    const char* name() const {
+        return m_name;
+    }
+    const char* help() const {
+        return m_help;
+    }
+    int boundCount() const {
+        return m_boundCount;
+    }
+    double upperBound(int bucket) const {
+        return m_upperBounds[bucket];
+    }
+    /// The number of values in the bucket, not including the lower buckets.
+    /// The +Inf bucket has the index boundCount().
+    quint64 bucketCount(int bucket) const {
+        return m_bucketCounts[bucket].load(std::memory_order_relaxed);
+    }
+    double sum() const {
+        return m_sum.load(std::memory_order_relaxed);
+    }
+
+  private:
+    const char* const m_name;
+    const char* const m_help;
+    std::array<double, kMaxBucketCount> m_upperBounds;
+    int m_boundCount;
+    std::array<std::atomic<quint64>, kMaxBucketCount + 1> m_bucketCounts;
+    std::atomic<double> m_sum;
+};
+
+/// The time spent in the audio callback relative to the buffer duration
+extern MetricHistogram engineLoad;
+extern MetricCounter engineUnderflows;
+
+extern MetricCounter cachingReaderHits;
+extern MetricCounter cachingReaderMisses;
+
+extern MetricGauge sideChainBacklogSamples;
+extern MetricCounter sideChainLostSamples;
+
+extern MetricGauge broadcastQueueBytes;
+extern MetricCounter broadcastDroppedPackets;
+
+extern MetricCounter analyzedTracks;
+extern MetricCounter analyzedFrames;
+extern MetricCounter analysisNanos;
+
+extern MetricHistogram dbQuerySeconds;
+
+// Bytes allocated by the subsystems that hold most of the memory
+extern MetricGauge cachingReaderBytes;
+extern MetricGauge waveformBytes;
+extern MetricGauge trackCacheBytes;
+extern MetricGauge effectStateBytes;
+
+/// Formats the current values of all metrics in the OpenMetrics text format.
+QByteArray toOpenMetricsText();
+
+} // namespace metrics
+
+} // namespace mixxx
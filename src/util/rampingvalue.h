@@ -20,3 +20,37 @@ class RampingValue {
     T m_start;
     T m_increment;
 };
+
+/// Smooths a parameter that changes between buffers, e.g. of an effect, by
+/// ramping it from its value in the previous buffer to the current value
+/// over the frames of the current buffer.
+///
+/// The ramp is a RampingValue, so the loops consuming it stay vectorizable.
+template<typename T>
+class SmoothedValue {
+  public:
+    explicit constexpr SmoothedValue(const T& value)
+            : m_value(value) {
+    }
+
+    /// Returns the ramp from the value of the previous buffer to `value`
+    /// over `steps` and keeps `value` for the next buffer.
+    [[nodiscard]] constexpr RampingValue<T> rampTo(const T& value, int steps) {
+        const RampingValue<T> ramp(m_value, value, steps);
+        m_value = value;
+        return ramp;
+    }
+
+    /// Sets the value the next ramp starts from without ramping, e.g. 0 to
+    /// fade in the next buffer after an effect has been disabled.
+    constexpr void reset(const T& value) {
+        m_value = value;
+    }
+
+    constexpr T value() const {
+        return m_value;
+    }
+
+  private:
+    T m_value;
+};
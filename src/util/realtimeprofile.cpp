@@ -0,0 +1,422 @@
+#include "util/realtimeprofile.h"
+
+#include <QMutex>
+#include <QStringList>
+#include <QThread>
+#include <atomic>
+#include <cstring>
+
+#if defined(__LINUX__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#elif defined(__WINDOWS__)
+#include <windows.h>
+// windows.h must be included first
+#include <avrt.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+#include <mach/thread_policy.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/tracerecorder.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("RealtimeProfile");
+
+const QString kConfigGroup = QStringLiteral("[Master]");
+const ConfigKey kEnabledConfigKey(kConfigGroup, QStringLiteral("realtime_profile"));
+const ConfigKey kCallbackCpuConfigKey(kConfigGroup, QStringLiteral("realtime_callback_cpu"));
+const ConfigKey kWorkerCpusConfigKey(kConfigGroup, QStringLiteral("realtime_worker_cpus"));
+const ConfigKey kLockMemoryConfigKey(kConfigGroup, QStringLiteral("realtime_lock_memory"));
+
+// The audio callback and the threads processing channels in parallel
+// during the callback use the priority that PortAudio requests for its
+// ALSA callback thread, see RLimit. The threads preparing data for
+// the callback run below, but above all threads outside of the audio path.
+constexpr int kCallbackPriority = 82;
+constexpr int kReaderPriority = 70;
+constexpr int kSideChainPriority = 60;
+// Added to the priority of boosted threads, stays below kCallbackPriority
+constexpr int kBoostedPriorityOffset = 5;
+
+#if defined(__APPLE__)
+// The time constraint policy needs a period. The threads of the audio path
+// are woken up at least once per audio buffer, which is usually shorter.
+constexpr double kTimeConstraintPeriodMillis = 10.0;
+#endif
+
+QMutex s_mutex;
+RealtimeProfile::Settings s_settings;
+QList<RealtimeProfile::ThreadStatus> s_threadStatus;
+// Distributes the workers over the configured CPUs
+int s_nextWorkerCpu = 0;
+std::atomic<std::size_t> s_lockedMemoryBytes(0);
+std::atomic<std::size_t> s_unlockedMemoryBytes(0);
+
+int priorityForRole(RealtimeProfile::Role role) {
+    switch (role) {
+    case RealtimeProfile::Role::AudioCallback:
+    case RealtimeProfile::Role::EngineWorker:
+        return kCallbackPriority;
+    case RealtimeProfile::Role::ReaderWorker:
+        return kReaderPriority;
+    case RealtimeProfile::Role::SideChainWorker:
+        return kSideChainPriority;
+    }
+    return kSideChainPriority;
+}
+
+/// Returns an error or an empty string
+QString requestRealtimeScheduling(RealtimeProfile::Role role) {
+#if defined(__LINUX__)
+    struct sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = math_min(
+            priorityForRole(role), sched_get_priority_max(SCHED_FIFO));
+    const int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+        return QStringLiteral("SCHED_FIFO: %1").arg(QString::fromLocal8Bit(strerror(err)));
+    }
+    return QString();
+#elif defined(__WINDOWS__)
+    DWORD taskIndex = 0;
+    HANDLE hTask = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+    if (!hTask) {
+        return QStringLiteral("MMCSS: error %1").arg(GetLastError());
+    }
+    const AVRT_PRIORITY priority =
+            priorityForRole(role) == kCallbackPriority ? AVRT_PRIORITY_CRITICAL
+                                                       : AVRT_PRIORITY_HIGH;
+    if (!AvSetMmThreadPriority(hTask, priority)) {
+        return QStringLiteral("MMCSS priority: error %1").arg(GetLastError());
+    }
+    return QString();
+#elif defined(__APPLE__)
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    const double ticksPerMilli = 1e6 * timebase.denom / timebase.numer;
+    thread_time_constraint_policy_data_t policy;
+    policy.period = static_cast<uint32_t>(kTimeConstraintPeriodMillis * ticksPerMilli);
+    // The callback computes for a fraction of the period, the other threads
+    // may be preempted by it
+    const double computationRatio =
+            priorityForRole(role) == kCallbackPriority ? 0.5 : 0.25;
+    policy.computation = static_cast<uint32_t>(policy.period * computationRatio);
+    policy.constraint = policy.period;
+    policy.preemptible = priorityForRole(role) == kCallbackPriority ? 0 : 1;
+    const kern_return_t err = thread_policy_set(mach_thread_self(),
+            THREAD_TIME_CONSTRAINT_POLICY,
+            reinterpret_cast<thread_policy_t>(&policy),
+            THREAD_TIME_CONSTRAINT_POLICY_COUNT);
+    if (err != KERN_SUCCESS) {
+        return QStringLiteral("THREAD_TIME_CONSTRAINT_POLICY: error %1").arg(err);
+    }
+    return QString();
+#else
+    Q_UNUSED(role);
+    return QStringLiteral("Realtime scheduling is not supported");
+#endif
+}
+
+/// Returns an error or an empty string
+QString pinToCpu(int cpu) {
+#if defined(__LINUX__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    const int err = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    if (err != 0) {
+        return QStringLiteral("CPU %1: %2").arg(cpu).arg(QString::fromLocal8Bit(strerror(err)));
+    }
+    return QString();
+#elif defined(__WINDOWS__)
+    if (!SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu)) {
+        return QStringLiteral("CPU %1: error %2").arg(cpu).arg(GetLastError());
+    }
+    return QString();
+#else
+    // macOS only supports affinity hints, no pinning
+    return QStringLiteral("Pinning to CPU %1 is not supported").arg(cpu);
+#endif
+}
+
+void queryCurrentThread(RealtimeProfile::ThreadStatus* pStatus) {
+    pStatus->realtime = false;
+    pStatus->priority = 0;
+    pStatus->cpu = -1;
+#if defined(__LINUX__)
+    int policy;
+    struct sched_param param;
+    if (pthread_getschedparam(pthread_self(), &policy, &param) == 0) {
+        pStatus->realtime = policy == SCHED_FIFO || policy == SCHED_RR;
+        pStatus->priority = param.sched_priority;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0 &&
+            CPU_COUNT(&cpuSet) == 1) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpuSet)) {
+                pStatus->cpu = cpu;
+                break;
+            }
+        }
+    }
+#elif defined(__WINDOWS__)
+    pStatus->priority = GetThreadPriority(GetCurrentThread());
+    pStatus->realtime = pStatus->priority >= THREAD_PRIORITY_TIME_CRITICAL;
+#elif defined(__APPLE__)
+    thread_time_constraint_policy_data_t policy;
+    mach_msg_type_number_t count = THREAD_TIME_CONSTRAINT_POLICY_COUNT;
+    boolean_t getDefault = false;
+    if (thread_policy_get(mach_thread_self(),
+                THREAD_TIME_CONSTRAINT_POLICY,
+                reinterpret_cast<thread_policy_t>(&policy),
+                &count,
+                &getDefault) == KERN_SUCCESS) {
+        pStatus->realtime = !getDefault;
+    }
+#endif
+}
+
+void recordStatus(const RealtimeProfile::ThreadStatus& status) {
+    const auto locker = lockMutex(&s_mutex);
+    for (auto& existingStatus : s_threadStatus) {
+        if (existingStatus.name == status.name) {
+            existingStatus = status;
+            return;
+        }
+    }
+    s_threadStatus.append(status);
+}
+
+} // anonymous namespace
+
+// static
+RealtimeProfile::Settings RealtimeProfile::readSettings(UserSettingsPointer pConfig) {
+    Settings settings;
+    settings.enabled = pConfig->getValue<bool>(kEnabledConfigKey, false);
+    settings.callbackCpu = pConfig->getValue<int>(kCallbackCpuConfigKey, -1);
+    const QStringList workerCpus = pConfig->getValueString(kWorkerCpusConfigKey)
+                                           .split(',',
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+                                                   Qt::SkipEmptyParts);
+#else
+                                                   QString::SkipEmptyParts);
+#endif
+    for (const auto& cpu : workerCpus) {
+        bool ok;
+        const int value = cpu.trimmed().toInt(&ok);
+        if (ok && value >= 0) {
+            settings.workerCpus.append(value);
+        }
+    }
+    settings.lockMemory = pConfig->getValue<bool>(kLockMemoryConfigKey, true);
+    return settings;
+}
+
+// static
+void RealtimeProfile::writeSettings(UserSettingsPointer pConfig, const Settings& settings) {
+    pConfig->setValue(kEnabledConfigKey, settings.enabled);
+    pConfig->setValue(kCallbackCpuConfigKey, settings.callbackCpu);
+    QStringList workerCpus;
+    for (int cpu : settings.workerCpus) {
+        workerCpus.append(QString::number(cpu));
+    }
+    pConfig->setValue(kWorkerCpusConfigKey, workerCpus.join(QChar(',')));
+    pConfig->setValue(kLockMemoryConfigKey, settings.lockMemory);
+}
+
+// static
+void RealtimeProfile::setSettings(const Settings& settings) {
+    const auto locker = lockMutex(&s_mutex);
+    s_settings = settings;
+    s_nextWorkerCpu = 0;
+}
+
+// static
+RealtimeProfile::Settings RealtimeProfile::settings() {
+    const auto locker = lockMutex(&s_mutex);
+    return s_settings;
+}
+
+// static
+void RealtimeProfile::applyToCurrentThread(Role role, const QString& name) {
+    // Also names the audio callback thread, which is not a QThread
+    TraceRecorder::setCurrentThreadName(name);
+
+    ThreadStatus status;
+    status.name = name;
+    status.role = role;
+
+    int cpu = -1;
+    bool enabled = false;
+    {
+        const auto locker = lockMutex(&s_mutex);
+        enabled = s_settings.enabled;
+        if (enabled) {
+            if (role == Role::AudioCallback) {
+                cpu = s_settings.callbackCpu;
+            } else if (!s_settings.workerCpus.isEmpty()) {
+                cpu = s_settings.workerCpus.at(
+                        s_nextWorkerCpu++ % s_settings.workerCpus.size());
+            }
+        }
+    }
+
+    if (enabled) {
+        QStringList errors;
+        const QString schedulingError = requestRealtimeScheduling(role);
+        if (!schedulingError.isEmpty()) {
+            errors.append(schedulingError);
+        }
+        if (cpu >= 0) {
+            const QString pinningError = pinToCpu(cpu);
+            if (!pinningError.isEmpty()) {
+                errors.append(pinningError);
+            }
+        }
+        status.error = errors.join(QStringLiteral(", "));
+        if (!status.error.isEmpty()) {
+            kLogger.warning() << name << status.error;
+        }
+    }
+
+    queryCurrentThread(&status);
+    kLogger.info() << name << "realtime:" << status.realtime
+                   << "priority:" << status.priority << "CPU:" << status.cpu;
+    recordStatus(status);
+}
+
+// static
+void RealtimeProfile::recordCurrentThread(Role role, const QString& name) {
+    ThreadStatus status;
+    status.name = name;
+    status.role = role;
+    queryCurrentThread(&status);
+    recordStatus(status);
+}
+
+// static
+void RealtimeProfile::setCurrentThreadBoosted(Role role, bool boosted) {
+#if defined(__LINUX__)
+    int policy;
+    struct sched_param param;
+    if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 &&
+            policy == SCHED_FIFO) {
+        param.sched_priority = math_min(
+                priorityForRole(role) + (boosted ? kBoostedPriorityOffset : 0),
+                sched_get_priority_max(SCHED_FIFO));
+        const int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err != 0) {
+            kLogger.warning() << "Failed to boost thread:" << strerror(err);
+        }
+        return;
+    }
+#else
+    Q_UNUSED(role);
+#endif
+    // Without realtime scheduling the thread was started with HighPriority
+    QThread::currentThread()->setPriority(
+            boosted ? QThread::HighestPriority : QThread::HighPriority);
+}
+
+// static
+void RealtimeProfile::removeThread(const QString& name) {
+    const auto locker = lockMutex(&s_mutex);
+    for (int i = 0; i < s_threadStatus.size(); ++i) {
+        if (s_threadStatus.at(i).name == name) {
+            s_threadStatus.removeAt(i);
+            return;
+        }
+    }
+}
+
+// static
+void RealtimeProfile::lockMemory(const void* pData, std::size_t bytes) {
+    if (!pData || bytes == 0) {
+        return;
+    }
+    {
+        const auto locker = lockMutex(&s_mutex);
+        if (!s_settings.enabled || !s_settings.lockMemory) {
+            return;
+        }
+    }
+#if defined(__LINUX__) || defined(__APPLE__)
+    // Touch every page, so it is backed by physical memory before the audio
+    // callback accesses it. Buffers are locked right after their allocation,
+    // so nobody else writes them concurrently.
+    const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    auto* pBytes = static_cast<volatile char*>(const_cast<void*>(pData));
+    for (std::size_t offset = 0; offset < bytes; offset += pageSize) {
+        pBytes[offset] = pBytes[offset];
+    }
+    const bool locked = mlock(pData, bytes) == 0;
+#elif defined(__WINDOWS__)
+    // VirtualLock also faults in the pages. The working set must be
+    // grown for locking more than a few hundred KB.
+    SIZE_T minimumWorkingSetSize;
+    SIZE_T maximumWorkingSetSize;
+    if (GetProcessWorkingSetSize(GetCurrentProcess(),
+                &minimumWorkingSetSize,
+                &maximumWorkingSetSize)) {
+        SetProcessWorkingSetSize(GetCurrentProcess(),
+                minimumWorkingSetSize + bytes,
+                math_max(maximumWorkingSetSize, minimumWorkingSetSize + bytes));
+    }
+    const bool locked = VirtualLock(const_cast<void*>(pData), bytes) != 0;
+#else
+    const bool locked = false;
+#endif
+    if (locked) {
+        s_lockedMemoryBytes.fetch_add(bytes, std::memory_order_relaxed);
+    } else {
+        s_unlockedMemoryBytes.fetch_add(bytes, std::memory_order_relaxed);
+        kLogger.warning() << "Failed to lock" << bytes << "bytes of memory";
+    }
+}
+
+// static
+QList<RealtimeProfile::ThreadStatus> RealtimeProfile::threadStatus() {
+    const auto locker = lockMutex(&s_mutex);
+    return s_threadStatus;
+}
+
+// static
+std::size_t RealtimeProfile::lockedMemoryBytes() {
+    return s_lockedMemoryBytes.load(std::memory_order_relaxed);
+}
+
+// static
+std::size_t RealtimeProfile::unlockedMemoryBytes() {
+    return s_unlockedMemoryBytes.load(std::memory_order_relaxed);
+}
+
+// static
+QString RealtimeProfile::roleName(Role role) {
+    switch (role) {
+    case Role::AudioCallback:
+        return QStringLiteral("Audio callback");
+    case Role::EngineWorker:
+        return QStringLiteral("Engine worker");
+    case Role::ReaderWorker:
+        return QStringLiteral("Reader worker");
+    case Role::SideChainWorker:
+        return QStringLiteral("Side chain worker");
+    }
+    return QString();
+}
+
+} // namespace mixxx
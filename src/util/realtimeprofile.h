@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <cstddef>
+
+#include "preferences/usersettings.h"
+
+namespace mixxx {
+
+/// Audio performance profile for the threads and buffers of the audio path.
+/// When enabled, each thread requests realtime scheduling for its role when
+/// it starts (SCHED_FIFO on Linux, MMCSS on Windows and the time constraint
+/// policy on macOS), is pinned to the configured CPUs, and the engine and
+/// reader buffers are locked in RAM and prefaulted when they are allocated.
+///
+/// The threads record the resulting scheduling, so the status can be
+/// verified in the preferences. Without the profile only the status is
+/// recorded.
+class RealtimeProfile {
+  public:
+    enum class Role {
+        AudioCallback,
+        EngineWorker,
+        ReaderWorker,
+        SideChainWorker,
+    };
+
+    struct Settings {
+        bool enabled = false;
+        /// CPU of the audio callback, -1 for no pinning
+        int callbackCpu = -1;
+        /// CPUs that the other threads are distributed to, empty for no
+        /// pinning
+        QList<int> workerCpus;
+        bool lockMemory = true;
+    };
+
+    struct ThreadStatus {
+        QString name;
+        Role role;
+        bool realtime;
+        /// Priority in the scheduling policy of the platform
+        int priority;
+        /// -1 if the thread is not pinned to a single CPU
+        int cpu;
+        /// Empty if all requests of the profile succeeded
+        QString error;
+    };
+
+    static Settings readSettings(UserSettingsPointer pConfig);
+    static void writeSettings(UserSettingsPointer pConfig, const Settings& settings);
+
+    /// Buffers are only locked if the profile is enabled at allocation time,
+    /// so this must be called before the engine is created. Threads apply
+    /// changes when they are started and the audio callback when the sound
+    /// devices are opened the next time.
+    static void setSettings(const Settings& settings);
+    static Settings settings();
+
+    /// Requests the scheduling of role for the calling thread when the
+    /// profile is enabled and records the resulting status. Must be called
+    /// from the thread itself, only once after it has started.
+    static void applyToCurrentThread(Role role, const QString& name);
+    /// Only records the status of the calling thread, for threads that are
+    /// owned by a sound server that sets up the scheduling itself.
+    static void recordCurrentThread(Role role, const QString& name);
+    /// Raises the priority of the calling thread above the other threads of
+    /// its role while boosted, e.g. for the reader of a playing deck. Stays
+    /// below the audio callback with realtime scheduling.
+    static void setCurrentThreadBoosted(Role role, bool boosted);
+    /// Removes the status of a thread that has been stopped
+    static void removeThread(const QString& name);
+
+    /// Locks and prefaults the memory when the profile is enabled
+    static void lockMemory(const void* pData, std::size_t bytes);
+
+    static QList<ThreadStatus> threadStatus();
+    static std::size_t lockedMemoryBytes();
+    /// Memory that could not be locked, e.g. because of RLIMIT_MEMLOCK
+    static std::size_t unlockedMemoryBytes();
+
+    static QString roleName(Role role);
+};
+
+} // namespace mixxx
@@ -0,0 +1,374 @@
+#include "util/rtsafety.h"
+
+#include <QObject>
+#include <QThread>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#if defined(MIXXX_RTSAFETY_CHECKS) && defined(__GLIBC__)
+#include <dlfcn.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "util/assert.h"
+#include "util/logger.h"
+
+#if defined(MIXXX_RTSAFETY_CHECKS) && !defined(__WINDOWS__)
+// Same layout as in qobject_p.h. This is the private hook that QTest uses
+// to dump the emitted signals, declared here to avoid depending on the
+// private headers of Qt.
+struct QSignalSpyCallbackSet {
+    typedef void (*BeginCallback)(QObject* caller, int signal_or_method_index, void** argv);
+    typedef void (*EndCallback)(QObject* caller, int signal_or_method_index);
+    BeginCallback signal_begin_callback, slot_begin_callback;
+    EndCallback signal_end_callback, slot_end_callback;
+};
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+void Q_CORE_EXPORT qt_register_signal_spy_callbacks(QSignalSpyCallbackSet* callback_set);
+#else
+void Q_CORE_EXPORT qt_register_signal_spy_callbacks(const QSignalSpyCallbackSet& callback_set);
+#endif
+#define MIXXX_RTSAFETY_SIGNAL_SPY
+#endif
+
+namespace mixxx {
+
+#ifdef MIXXX_RTSAFETY_CHECKS
+
+namespace {
+
+const Logger kLogger("RtSafety");
+
+constexpr int kMaxStackFrames = 32;
+// Frames of the checker itself on top of the stack trace of a violation:
+// reportViolation(), checkCall() and the intercepted function
+constexpr int kCheckerFrames = 3;
+// Frames below the checker that identify the call site of a violation
+constexpr int kCallSiteFrames = 8;
+// Must be a power of 2
+constexpr int kMaxReportedCallSites = 1024;
+
+std::atomic<bool> s_enabled(false);
+std::atomic<RtSafety::ViolationHandler> s_violationHandler(nullptr);
+std::atomic<int> s_violationCount(0);
+// Hashes of the call sites that have already been reported, 0 for empty
+std::array<std::atomic<std::uintptr_t>, kMaxReportedCallSites> s_reportedCallSites{};
+
+thread_local int t_realtimeDepth = 0;
+thread_local int t_suspendDepth = 0;
+// Set while a violation is reported, which is not realtime safe itself
+thread_local bool t_reporting = false;
+
+inline bool isCheckedThread() {
+    return t_realtimeDepth > 0 && t_suspendDepth == 0 && !t_reporting &&
+            s_enabled.load(std::memory_order_relaxed);
+}
+
+/// Returns false if the call site has already been reported
+bool markCallSiteReported(std::uintptr_t hash) {
+    if (hash == 0) {
+        hash = 1;
+    }
+    for (int i = 0; i < kMaxReportedCallSites; ++i) {
+        auto& slot = s_reportedCallSites[(hash + i) & (kMaxReportedCallSites - 1)];
+        std::uintptr_t expected = 0;
+        if (slot.compare_exchange_strong(expected, hash, std::memory_order_relaxed)) {
+            return true;
+        }
+        if (expected == hash) {
+            return false;
+        }
+    }
+    // Report all violations once the table is full
+    return true;
+}
+
+void reportViolation(const char* pWhat) {
+    s_violationCount.fetch_add(1, std::memory_order_relaxed);
+#if defined(__GLIBC__)
+    void* frames[kMaxStackFrames];
+    const int numFrames = backtrace(frames, kMaxStackFrames);
+    std::uintptr_t hash = 0;
+    for (int i = kCheckerFrames;
+            i < numFrames && i < kCheckerFrames + kCallSiteFrames;
+            ++i) {
+        hash = hash * 31 + reinterpret_cast<std::uintptr_t>(frames[i]);
+    }
+    if (!markCallSiteReported(hash)) {
+        return;
+    }
+#endif
+    kLogger.warning()
+            << "Realtime violation in thread"
+            << QThread::currentThread()->objectName() << ":" << pWhat;
+#if defined(__GLIBC__)
+    char** pSymbols = backtrace_symbols(frames, numFrames);
+    if (pSymbols) {
+        for (int i = kCheckerFrames - 1; i < numFrames; ++i) {
+            kLogger.warning() << "    " << pSymbols[i];
+        }
+        free(pSymbols);
+    }
+#endif
+    const RtSafety::ViolationHandler handler =
+            s_violationHandler.load(std::memory_order_relaxed);
+    if (handler) {
+        handler(pWhat);
+    }
+}
+
+#ifdef MIXXX_RTSAFETY_SIGNAL_SPY
+void signalBeginCallback(QObject* pCaller, int signalIndex, void** argv) {
+    Q_UNUSED(signalIndex);
+    Q_UNUSED(argv);
+    if (!isCheckedThread()) {
+        return;
+    }
+    // Connections to the receivers in the thread of the caller are queued,
+    // unless they are direct connections
+    if (pCaller->thread() != QThread::currentThread()) {
+        RtSafety::checkCall("signal emitted by an object of another thread");
+    }
+}
+
+QSignalSpyCallbackSet s_signalSpyCallbacks = {
+        signalBeginCallback, nullptr, nullptr, nullptr};
+#endif
+
+} // anonymous namespace
+
+// static
+void RtSafety::setEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+#ifdef MIXXX_RTSAFETY_SIGNAL_SPY
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    qt_register_signal_spy_callbacks(enabled ? &s_signalSpyCallbacks : nullptr);
+#else
+    const QSignalSpyCallbackSet noCallbacks = {nullptr, nullptr, nullptr, nullptr};
+    qt_register_signal_spy_callbacks(enabled ? s_signalSpyCallbacks : noCallbacks);
+#endif
+#endif
+    kLogger.info() << "Realtime safety checks" << (enabled ? "enabled" : "disabled");
+}
+
+// static
+bool RtSafety::isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+// static
+void RtSafety::setViolationHandler(ViolationHandler handler) {
+    s_violationHandler.store(handler, std::memory_order_relaxed);
+}
+
+// static
+int RtSafety::violationCount() {
+    return s_violationCount.load(std::memory_order_relaxed);
+}
+
+// static
+void RtSafety::checkCall(const char* pWhat) {
+    if (!isCheckedThread()) {
+        return;
+    }
+    t_reporting = true;
+    reportViolation(pWhat);
+    t_reporting = false;
+}
+
+// static
+void RtSafety::enterRealtimeSection() {
+    ++t_realtimeDepth;
+}
+
+// static
+void RtSafety::leaveRealtimeSection() {
+    DEBUG_ASSERT(t_realtimeDepth > 0);
+    --t_realtimeDepth;
+}
+
+// static
+void RtSafety::suspendChecks() {
+    ++t_suspendDepth;
+}
+
+// static
+void RtSafety::resumeChecks() {
+    DEBUG_ASSERT(t_suspendDepth > 0);
+    --t_suspendDepth;
+}
+
+#else // MIXXX_RTSAFETY_CHECKS
+
+// static
+void RtSafety::setEnabled(bool enabled) {
+    Q_UNUSED(enabled);
+}
+
+// static
+bool RtSafety::isEnabled() {
+    return false;
+}
+
+// static
+void RtSafety::setViolationHandler(ViolationHandler handler) {
+    Q_UNUSED(handler);
+}
+
+// static
+int RtSafety::violationCount() {
+    return 0;
+}
+
+// static
+void RtSafety::checkCall(const char* pWhat) {
+    Q_UNUSED(pWhat);
+}
+
+// static
+void RtSafety::enterRealtimeSection() {
+}
+
+// static
+void RtSafety::leaveRealtimeSection() {
+}
+
+// static
+void RtSafety::suspendChecks() {
+}
+
+// static
+void RtSafety::resumeChecks() {
+}
+
+#endif // MIXXX_RTSAFETY_CHECKS
+
+} // namespace mixxx
+
+#if defined(MIXXX_RTSAFETY_CHECKS) && defined(__GLIBC__)
+
+// Replaces the functions of glibc for the whole process. The allocator is
+// replaced as described in the manual of glibc and forwards to the
+// implementation of glibc, the other functions forward to the next
+// definition found by the dynamic linker.
+
+namespace {
+
+template<typename Function>
+Function resolveNext(std::atomic<Function>* pCache, const char* pName) {
+    Function pFunction = pCache->load(std::memory_order_relaxed);
+    if (!pFunction) {
+        pFunction = reinterpret_cast<Function>(dlsym(RTLD_NEXT, pName));
+        pCache->store(pFunction, std::memory_order_relaxed);
+    }
+    return pFunction;
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    mixxx::RtSafety::checkCall("malloc");
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    mixxx::RtSafety::checkCall("calloc");
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    mixxx::RtSafety::checkCall("realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    mixxx::RtSafety::checkCall("memalign");
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    mixxx::RtSafety::checkCall("aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** pPtr, size_t alignment, size_t size) {
+    mixxx::RtSafety::checkCall("posix_memalign");
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *pPtr = ptr;
+    return 0;
+}
+
+void free(void* ptr) {
+    if (ptr) {
+        mixxx::RtSafety::checkCall("free");
+    }
+    __libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* pMutex) {
+    static std::atomic<int (*)(pthread_mutex_t*)> s_next(nullptr);
+    mixxx::RtSafety::checkCall("pthread_mutex_lock");
+    return resolveNext(&s_next, "pthread_mutex_lock")(pMutex);
+}
+
+int sem_wait(sem_t* pSemaphore) {
+    static std::atomic<int (*)(sem_t*)> s_next(nullptr);
+    mixxx::RtSafety::checkCall("sem_wait");
+    return resolveNext(&s_next, "sem_wait")(pSemaphore);
+}
+
+int nanosleep(const struct timespec* pDuration, struct timespec* pRemaining) {
+    static std::atomic<int (*)(const struct timespec*, struct timespec*)> s_next(nullptr);
+    mixxx::RtSafety::checkCall("nanosleep");
+    return resolveNext(&s_next, "nanosleep")(pDuration, pRemaining);
+}
+
+int usleep(useconds_t microseconds) {
+    static std::atomic<int (*)(useconds_t)> s_next(nullptr);
+    mixxx::RtSafety::checkCall("usleep");
+    return resolveNext(&s_next, "usleep")(microseconds);
+}
+
+ssize_t read(int fd, void* pBuffer, size_t count) {
+    static std::atomic<ssize_t (*)(int, void*, size_t)> s_next(nullptr);
+    mixxx::RtSafety::checkCall("read");
+    return resolveNext(&s_next, "read")(fd, pBuffer, count);
+}
+
+ssize_t write(int fd, const void* pBuffer, size_t count) {
+    static std::atomic<ssize_t (*)(int, const void*, size_t)> s_next(nullptr);
+    mixxx::RtSafety::checkCall("write");
+    return resolveNext(&s_next, "write")(fd, pBuffer, count);
+}
+
+int poll(struct pollfd* pFds, nfds_t numFds, int timeout) {
+    static std::atomic<int (*)(struct pollfd*, nfds_t, int)> s_next(nullptr);
+    mixxx::RtSafety::checkCall("poll");
+    return resolveNext(&s_next, "poll")(pFds, numFds, timeout);
+}
+
+} // extern "C"
+
+#endif // MIXXX_RTSAFETY_CHECKS && __GLIBC__
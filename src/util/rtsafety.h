@@ -0,0 +1,87 @@
+#pragma once
+
+#include "util/class.h"
+
+namespace mixxx {
+
+/// Detects calls that are not realtime safe while a thread processes the
+/// audio callback. Only functional in builds with the RTSAFETY_CHECKS
+/// option, which defines MIXXX_RTSAFETY_CHECKS. Without it all functions
+/// are no-ops.
+///
+/// With glibc, memory allocation, pthread mutex locks and waits, sleeps and
+/// file I/O are intercepted, in addition to the explicit checks of
+/// DEBUG_ASSERT_NOT_IN_REALTIME_SECTION() and lockMutex(). Signals that are
+/// emitted from a realtime section by an object that lives in another
+/// thread are reported, because they are delivered queued to that thread.
+/// Each violation is reported once per call site with a stack trace.
+class RtSafety {
+  public:
+    typedef void (*ViolationHandler)(const char* pWhat);
+
+    /// The checker is disabled until it is enabled at runtime
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+    /// Called in the violating thread after the violation has been reported
+    static void setViolationHandler(ViolationHandler handler);
+    static int violationCount();
+
+    /// Reports pWhat as a violation if the calling thread is inside of a
+    /// realtime section
+    static void checkCall(const char* pWhat);
+
+    /// Marks the calling thread as processing the audio callback. Can be
+    /// nested.
+    class ScopedRealtimeSection {
+      public:
+        ScopedRealtimeSection() {
+#ifdef MIXXX_RTSAFETY_CHECKS
+            enterRealtimeSection();
+#endif
+        }
+        ~ScopedRealtimeSection() {
+#ifdef MIXXX_RTSAFETY_CHECKS
+            leaveRealtimeSection();
+#endif
+        }
+
+      private:
+        DISALLOW_COPY_AND_ASSIGN(ScopedRealtimeSection);
+    };
+
+    /// Suspends the checks of the calling thread, for code in a realtime
+    /// section that is known to be safe in practice or that is not fixable
+    /// yet
+    class ScopedChecksSuspended {
+      public:
+        ScopedChecksSuspended() {
+#ifdef MIXXX_RTSAFETY_CHECKS
+            suspendChecks();
+#endif
+        }
+        ~ScopedChecksSuspended() {
+#ifdef MIXXX_RTSAFETY_CHECKS
+            resumeChecks();
+#endif
+        }
+
+      private:
+        DISALLOW_COPY_AND_ASSIGN(ScopedChecksSuspended);
+    };
+
+  private:
+    static void enterRealtimeSection();
+    static void leaveRealtimeSection();
+    static void suspendChecks();
+    static void resumeChecks();
+};
+
+} // namespace mixxx
+
+/// Report a violation if the current thread processes the audio callback.
+/// Only checked in builds with RTSAFETY_CHECKS.
+#ifdef MIXXX_RTSAFETY_CHECKS
+#define DEBUG_ASSERT_NOT_IN_REALTIME_SECTION(what) mixxx::RtSafety::checkCall(what)
+#else
+#define DEBUG_ASSERT_NOT_IN_REALTIME_SECTION(what)
+#endif
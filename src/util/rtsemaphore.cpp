@@ -0,0 +1,93 @@
+#include "util/rtsemaphore.h"
+
+#include <QtDebug>
+#include <cerrno>
+
+#if defined(__WINDOWS__)
+#include <windows.h>
+
+#include <climits>
+#endif
+
+#include "util/assert.h"
+
+#if defined(__LINUX__)
+
+RtSemaphore::RtSemaphore() {
+    const int ret = sem_init(&m_semaphore, 0, 0);
+    VERIFY_OR_DEBUG_ASSERT(ret == 0) {
+        qWarning() << "sem_init failed" << errno;
+    }
+}
+
+RtSemaphore::~RtSemaphore() {
+    sem_destroy(&m_semaphore);
+}
+
+void RtSemaphore::acquire() {
+    // Restart when interrupted by a signal
+    while (sem_wait(&m_semaphore) != 0 && errno == EINTR) {
+    }
+}
+
+void RtSemaphore::release() {
+    sem_post(&m_semaphore);
+}
+
+#elif defined(__APPLE__)
+
+RtSemaphore::RtSemaphore()
+        : m_semaphore(dispatch_semaphore_create(0)) {
+    DEBUG_ASSERT(m_semaphore);
+}
+
+RtSemaphore::~RtSemaphore() {
+    dispatch_release(m_semaphore);
+}
+
+void RtSemaphore::acquire() {
+    dispatch_semaphore_wait(m_semaphore, DISPATCH_TIME_FOREVER);
+}
+
+void RtSemaphore::release() {
+    dispatch_semaphore_signal(m_semaphore);
+}
+
+#elif defined(__WINDOWS__)
+
+RtSemaphore::RtSemaphore()
+        : m_semaphore(CreateSemaphoreW(nullptr, 0, LONG_MAX, nullptr)) {
+    VERIFY_OR_DEBUG_ASSERT(m_semaphore) {
+        qWarning() << "CreateSemaphore failed" << GetLastError();
+    }
+}
+
+RtSemaphore::~RtSemaphore() {
+    CloseHandle(m_semaphore);
+}
+
+void RtSemaphore::acquire() {
+    WaitForSingleObject(m_semaphore, INFINITE);
+}
+
+void RtSemaphore::release() {
+    ReleaseSemaphore(m_semaphore, 1, nullptr);
+}
+
+#else
+
+RtSemaphore::RtSemaphore() {
+}
+
+RtSemaphore::~RtSemaphore() {
+}
+
+void RtSemaphore::acquire() {
+    m_semaphore.acquire();
+}
+
+void RtSemaphore::release() {
+    m_semaphore.release();
+}
+
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QtGlobal>
+
+#if defined(__LINUX__)
+#include <semaphore.h>
+#elif defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#elif !defined(__WINDOWS__)
+#include <QSemaphore>
+#endif
+
+#include "util/class.h"
+
+/// Counting semaphore that can be released from the audio callback.
+///
+/// Unlike QSemaphore and QWaitCondition, release() does not lock a mutex
+/// that might be held by the waiting thread, which would invert the
+/// priority of the callback. It uses the semaphore of the operating system,
+/// which only enters the kernel when a thread is waiting: a POSIX semaphore
+/// on Linux, a dispatch semaphore on macOS and a semaphore object on
+/// Windows.
+class RtSemaphore {
+  public:
+    RtSemaphore();
+    ~RtSemaphore();
+
+    /// Blocks until the semaphore has been released
+    void acquire();
+    /// Wait-free when no thread is waiting
+    void release();
+
+  private:
+#if defined(__LINUX__)
+    sem_t m_semaphore;
+#elif defined(__APPLE__)
+    dispatch_semaphore_t m_semaphore;
+#elif defined(__WINDOWS__)
+    // A HANDLE, without including windows.h
+    void* m_semaphore;
+#else
+    QSemaphore m_semaphore;
+#endif
+
+    DISALLOW_COPY_AND_ASSIGN(RtSemaphore);
+};
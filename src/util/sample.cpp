@@ -37,6 +37,147 @@ constexpr bool useAlignedAlloc() {
             sizeof(CSAMPLE*) == sizeof(size_t);
 }
 
+// The bodies of the SampleUtil functions that are also compiled for the
+// fixed buffer sizes of SampleUtil::bufferSizeKernels(). Inlining them
+// with a constant numSamples allows the compiler to unroll the loops
+// completely and to omit the scalar remainder loops. They must be inlined
+// into the multi-versioned functions to be compiled for their targets.
+#if defined(__GNUC__)
+#define SAMPLEUTIL_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define SAMPLEUTIL_ALWAYS_INLINE __forceinline
+#else
+#define SAMPLEUTIL_ALWAYS_INLINE inline
+#endif
+
+SAMPLEUTIL_ALWAYS_INLINE void applyRampingGainKernel(CSAMPLE* pBuffer,
+        CSAMPLE_GAIN old_gain,
+        CSAMPLE_GAIN new_gain,
+        SINT numSamples) {
+    if (old_gain == CSAMPLE_GAIN_ONE && new_gain == CSAMPLE_GAIN_ONE) {
+        return;
+    }
+    if (old_gain == CSAMPLE_GAIN_ZERO && new_gain == CSAMPLE_GAIN_ZERO) {
+        SampleUtil::clear(pBuffer, numSamples);
+        return;
+    }
+
+    const CSAMPLE_GAIN gain_delta = (new_gain - old_gain)
+            / CSAMPLE_GAIN(numSamples / 2);
+    if (gain_delta != 0) {
+        const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
+        // note: LOOP VECTORIZED.
+        for (int i = 0; i < numSamples / 2; ++i) {
+            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
+            // a loop counter i += 2 prevents vectorizing.
+            pBuffer[i * 2] *= gain;
+            pBuffer[i * 2 + 1] *= gain;
+        }
+    } else {
+        // note: LOOP VECTORIZED.
+        for (int i = 0; i < numSamples; ++i) {
+            pBuffer[i] *= old_gain;
+        }
+    }
+}
+
+SAMPLEUTIL_ALWAYS_INLINE void addWithRampingGainKernel(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN old_gain,
+        CSAMPLE_GAIN new_gain,
+        SINT numSamples) {
+    if (old_gain == CSAMPLE_GAIN_ZERO && new_gain == CSAMPLE_GAIN_ZERO) {
+        return;
+    }
+
+    const CSAMPLE_GAIN gain_delta = (new_gain - old_gain)
+            / CSAMPLE_GAIN(numSamples / 2);
+    if (gain_delta != 0) {
+        const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
+        // note: LOOP VECTORIZED.
+        for (int i = 0; i < numSamples / 2; ++i) {
+            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
+            pDest[i * 2] += pSrc[i * 2] * gain;
+            pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
+        }
+    } else {
+        // note: LOOP VECTORIZED.
+        for (int i = 0; i < numSamples; ++i) {
+            pDest[i] += pSrc[i] * old_gain;
+        }
+    }
+}
+
+SAMPLEUTIL_ALWAYS_INLINE void addToBothWithRampingGainKernel(CSAMPLE* M_RESTRICT pDest1,
+        CSAMPLE_GAIN old_gain1,
+        CSAMPLE_GAIN new_gain1,
+        CSAMPLE* M_RESTRICT pDest2,
+        CSAMPLE_GAIN old_gain2,
+        CSAMPLE_GAIN new_gain2,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numSamples) {
+    if (!pDest2 || (old_gain2 == CSAMPLE_GAIN_ZERO && new_gain2 == CSAMPLE_GAIN_ZERO)) {
+        addWithRampingGainKernel(pDest1, pSrc, old_gain1, new_gain1, numSamples);
+        return;
+    }
+    if (old_gain1 == CSAMPLE_GAIN_ZERO && new_gain1 == CSAMPLE_GAIN_ZERO) {
+        addWithRampingGainKernel(pDest2, pSrc, old_gain2, new_gain2, numSamples);
+        return;
+    }
+
+    // Constant gains are a ramp with a delta of 0, the additional
+    // multiplication is negligible compared to the memory accesses
+    const CSAMPLE_GAIN gain_delta1 = (new_gain1 - old_gain1)
+            / CSAMPLE_GAIN(numSamples / 2);
+    const CSAMPLE_GAIN start_gain1 = old_gain1 + gain_delta1;
+    const CSAMPLE_GAIN gain_delta2 = (new_gain2 - old_gain2)
+            / CSAMPLE_GAIN(numSamples / 2);
+    const CSAMPLE_GAIN start_gain2 = old_gain2 + gain_delta2;
+    // note: LOOP VECTORIZED.
+    for (int i = 0; i < numSamples / 2; ++i) {
+        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
+        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
+        const CSAMPLE left = pSrc[i * 2];
+        const CSAMPLE right = pSrc[i * 2 + 1];
+        pDest1[i * 2] += left * gain1;
+        pDest1[i * 2 + 1] += right * gain1;
+        pDest2[i * 2] += left * gain2;
+        pDest2[i * 2 + 1] += right * gain2;
+    }
+}
+
+SAMPLEUTIL_ALWAYS_INLINE void copyWithRampingGainKernel(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN old_gain,
+        CSAMPLE_GAIN new_gain,
+        SINT numSamples) {
+    if (old_gain == CSAMPLE_GAIN_ONE && new_gain == CSAMPLE_GAIN_ONE) {
+        SampleUtil::copy(pDest, pSrc, numSamples);
+        return;
+    }
+    if (old_gain == CSAMPLE_GAIN_ZERO && new_gain == CSAMPLE_GAIN_ZERO) {
+        SampleUtil::clear(pDest, numSamples);
+        return;
+    }
+
+    const CSAMPLE_GAIN gain_delta = (new_gain - old_gain)
+            / CSAMPLE_GAIN(numSamples / 2);
+    if (gain_delta != 0) {
+        const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
+        // note: LOOP VECTORIZED only with "int i" (not SINT i)
+        for (int i = 0; i < numSamples / 2; ++i) {
+            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
+            pDest[i * 2] = pSrc[i * 2] * gain;
+            pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
+        }
+    } else {
+        // note: LOOP VECTORIZED.
+        for (SINT i = 0; i < numSamples; ++i) {
+            pDest[i] = pSrc[i] * old_gain;
+        }
+    }
+}
+
 } // anonymous namespace
 
 // static
@@ -110,6 +251,33 @@ void SampleUtil::free(CSAMPLE* pBuffer) {
 }
 
 // static
+const char* SampleUtil::simdInstructionSet() {
+#ifdef SAMPLEUTIL_MULTIVERSIONING
+    // Approximates the priorities of the resolver of SAMPLEUTIL_TARGET_CLONES
+    if (__builtin_cpu_supports("avx512f")) {
+        return "AVX-512";
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return "AVX2";
+    }
+#endif
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX2__)
+    return "AVX2";
+#elif defined(__AVX__)
+    return "AVX";
+#elif defined(__SSE2__)
+    return "SSE2";
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    return "NEON";
+#else
+    return "generic";
+#endif
+}
+
+// static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::applyGain(CSAMPLE* pBuffer, CSAMPLE_GAIN gain,
         SINT numSamples) {
     if (gain == CSAMPLE_GAIN_ONE) {
@@ -127,33 +295,10 @@ void SampleUtil::applyGain(CSAMPLE* pBuffer, CSAMPLE_GAIN gain,
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::applyRampingGain(CSAMPLE* pBuffer, CSAMPLE_GAIN old_gain,
         CSAMPLE_GAIN new_gain, SINT numSamples) {
-    if (old_gain == CSAMPLE_GAIN_ONE && new_gain == CSAMPLE_GAIN_ONE) {
-        return;
-    }
-    if (old_gain == CSAMPLE_GAIN_ZERO && new_gain == CSAMPLE_GAIN_ZERO) {
-        clear(pBuffer, numSamples);
-        return;
-    }
-
-    const CSAMPLE_GAIN gain_delta = (new_gain - old_gain)
-            / CSAMPLE_GAIN(numSamples / 2);
-    if (gain_delta != 0) {
-        const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
-        // note: LOOP VECTORIZED.
-        for (int i = 0; i < numSamples / 2; ++i) {
-            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
-            // a loop counter i += 2 prevents vectorizing.
-            pBuffer[i * 2] *= gain;
-            pBuffer[i * 2 + 1] *= gain;
-        }
-    } else {
-        // note: LOOP VECTORIZED.
-        for (int i = 0; i < numSamples; ++i) {
-            pBuffer[i] *= old_gain;
-        }
-    }
+    applyRampingGainKernel(pBuffer, old_gain, new_gain, numSamples);
 }
 
 // static
@@ -225,6 +370,7 @@ void SampleUtil::add(CSAMPLE* M_RESTRICT pDest,
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::addWithGain(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc,
         CSAMPLE_GAIN gain, SINT numSamples) {
@@ -238,33 +384,37 @@ void SampleUtil::addWithGain(CSAMPLE* M_RESTRICT pDest,
     }
 }
 
+// static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::addWithRampingGain(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc,
         CSAMPLE_GAIN old_gain, CSAMPLE_GAIN new_gain,
         SINT numSamples) {
-    if (old_gain == CSAMPLE_GAIN_ZERO && new_gain == CSAMPLE_GAIN_ZERO) {
-        return;
-    }
+    addWithRampingGainKernel(pDest, pSrc, old_gain, new_gain, numSamples);
+}
 
-    const CSAMPLE_GAIN gain_delta = (new_gain - old_gain)
-            / CSAMPLE_GAIN(numSamples / 2);
-    if (gain_delta != 0) {
-        const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
-        // note: LOOP VECTORIZED.
-        for (int i = 0; i < numSamples / 2; ++i) {
-            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
-            pDest[i * 2] += pSrc[i * 2] * gain;
-            pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
-        }
-    } else {
-        // note: LOOP VECTORIZED.
-        for (int i = 0; i < numSamples; ++i) {
-            pDest[i] += pSrc[i] * old_gain;
-        }
-    }
+// static
+SAMPLEUTIL_TARGET_CLONES
+void SampleUtil::addToBothWithRampingGain(CSAMPLE* M_RESTRICT pDest1,
+        CSAMPLE_GAIN old_gain1,
+        CSAMPLE_GAIN new_gain1,
+        CSAMPLE* M_RESTRICT pDest2,
+        CSAMPLE_GAIN old_gain2,
+        CSAMPLE_GAIN new_gain2,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numSamples) {
+    addToBothWithRampingGainKernel(pDest1,
+            old_gain1,
+            new_gain1,
+            pDest2,
+            old_gain2,
+            new_gain2,
+            pSrc,
+            numSamples);
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::add2WithGain(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
         const CSAMPLE* M_RESTRICT pSrc2, CSAMPLE_GAIN gain2,
@@ -284,6 +434,7 @@ void SampleUtil::add2WithGain(CSAMPLE* M_RESTRICT pDest,
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::add3WithGain(CSAMPLE* pDest,
         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
         const CSAMPLE* M_RESTRICT pSrc2, CSAMPLE_GAIN gain2,
@@ -307,6 +458,7 @@ void SampleUtil::add3WithGain(CSAMPLE* pDest,
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::copyWithGain(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc,
         CSAMPLE_GAIN gain, SINT numSamples) {
@@ -330,40 +482,111 @@ void SampleUtil::copyWithGain(CSAMPLE* M_RESTRICT pDest,
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc,
         CSAMPLE_GAIN old_gain,
         CSAMPLE_GAIN new_gain,
         SINT numSamples) {
-    if (old_gain == CSAMPLE_GAIN_ONE && new_gain == CSAMPLE_GAIN_ONE) {
-        copy(pDest, pSrc, numSamples);
-        return;
-    }
-    if (old_gain == CSAMPLE_GAIN_ZERO && new_gain == CSAMPLE_GAIN_ZERO) {
-        clear(pDest, numSamples);
-        return;
-    }
+    copyWithRampingGainKernel(pDest, pSrc, old_gain, new_gain, numSamples);
+}
 
-    const CSAMPLE_GAIN gain_delta = (new_gain - old_gain)
-            / CSAMPLE_GAIN(numSamples / 2);
-    if (gain_delta != 0) {
-        const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
-        // note: LOOP VECTORIZED only with "int i" (not SINT i)
-        for (int i = 0; i < numSamples / 2; ++i) {
-            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
-            pDest[i * 2] = pSrc[i * 2] * gain;
-            pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
-        }
-    } else {
-        // note: LOOP VECTORIZED.
-        for (SINT i = 0; i < numSamples; ++i) {
-            pDest[i] = pSrc[i] * old_gain;
-        }
-    }
+namespace {
 
-    // OR! need to test which fares better
-    // copy(pDest, pSrc, iNumSamples);
-    // applyRampingGain(pDest, gain);
+// Defines the fixed size versions of the kernels for stereo buffers of
+// FRAMES frames. They are plain functions instead of templates, because
+// clang does not support multi-versioned function templates.
+#define SAMPLEUTIL_DEFINE_BUFFER_SIZE_KERNELS(FRAMES)                        \
+    SAMPLEUTIL_TARGET_CLONES                                                  \
+    void applyRampingGain##FRAMES(CSAMPLE* pBuffer,                           \
+            CSAMPLE_GAIN old_gain,                                            \
+            CSAMPLE_GAIN new_gain,                                            \
+            SINT numSamples) {                                                \
+        DEBUG_ASSERT(numSamples == FRAMES * 2);                               \
+        Q_UNUSED(numSamples);                                                 \
+        applyRampingGainKernel(pBuffer, old_gain, new_gain, FRAMES * 2);      \
+    }                                                                         \
+    SAMPLEUTIL_TARGET_CLONES                                                  \
+    void copyWithRampingGain##FRAMES(CSAMPLE* M_RESTRICT pDest,               \
+            const CSAMPLE* M_RESTRICT pSrc,                                   \
+            CSAMPLE_GAIN old_gain,                                            \
+            CSAMPLE_GAIN new_gain,                                            \
+            SINT numSamples) {                                                \
+        DEBUG_ASSERT(numSamples == FRAMES * 2);                               \
+        Q_UNUSED(numSamples);                                                 \
+        copyWithRampingGainKernel(pDest, pSrc, old_gain, new_gain, FRAMES * 2); \
+    }                                                                         \
+    SAMPLEUTIL_TARGET_CLONES                                                  \
+    void addWithRampingGain##FRAMES(CSAMPLE* M_RESTRICT pDest,                \
+            const CSAMPLE* M_RESTRICT pSrc,                                   \
+            CSAMPLE_GAIN old_gain,                                            \
+            CSAMPLE_GAIN new_gain,                                            \
+            SINT numSamples) {                                                \
+        DEBUG_ASSERT(numSamples == FRAMES * 2);                               \
+        Q_UNUSED(numSamples);                                                 \
+        addWithRampingGainKernel(pDest, pSrc, old_gain, new_gain, FRAMES * 2); \
+    }                                                                         \
+    SAMPLEUTIL_TARGET_CLONES                                                  \
+    void addToBothWithRampingGain##FRAMES(CSAMPLE* M_RESTRICT pDest1,         \
+            CSAMPLE_GAIN old_gain1,                                           \
+            CSAMPLE_GAIN new_gain1,                                           \
+            CSAMPLE* M_RESTRICT pDest2,                                       \
+            CSAMPLE_GAIN old_gain2,                                           \
+            CSAMPLE_GAIN new_gain2,                                           \
+            const CSAMPLE* M_RESTRICT pSrc,                                   \
+            SINT numSamples) {                                                \
+        DEBUG_ASSERT(numSamples == FRAMES * 2);                               \
+        Q_UNUSED(numSamples);                                                 \
+        addToBothWithRampingGainKernel(pDest1,                                \
+                old_gain1,                                                    \
+                new_gain1,                                                    \
+                pDest2,                                                       \
+                old_gain2,                                                    \
+                new_gain2,                                                    \
+                pSrc,                                                         \
+                FRAMES * 2);                                                  \
+    }                                                                         \
+    constexpr SampleUtil::BufferSizeKernels kBufferSizeKernels##FRAMES = {   \
+            FRAMES * 2,                                                       \
+            &applyRampingGain##FRAMES,                                        \
+            &copyWithRampingGain##FRAMES,                                     \
+            &addWithRampingGain##FRAMES,                                      \
+            &addToBothWithRampingGain##FRAMES};
+
+// The buffer sizes offered in the sound hardware preferences
+SAMPLEUTIL_DEFINE_BUFFER_SIZE_KERNELS(64)
+SAMPLEUTIL_DEFINE_BUFFER_SIZE_KERNELS(128)
+SAMPLEUTIL_DEFINE_BUFFER_SIZE_KERNELS(256)
+SAMPLEUTIL_DEFINE_BUFFER_SIZE_KERNELS(512)
+SAMPLEUTIL_DEFINE_BUFFER_SIZE_KERNELS(1024)
+SAMPLEUTIL_DEFINE_BUFFER_SIZE_KERNELS(2048)
+
+#undef SAMPLEUTIL_DEFINE_BUFFER_SIZE_KERNELS
+
+} // anonymous namespace
+
+// static
+SampleUtil::BufferSizeKernels SampleUtil::bufferSizeKernels(SINT numSamples) {
+    switch (numSamples) {
+    case 64 * 2:
+        return kBufferSizeKernels64;
+    case 128 * 2:
+        return kBufferSizeKernels128;
+    case 256 * 2:
+        return kBufferSizeKernels256;
+    case 512 * 2:
+        return kBufferSizeKernels512;
+    case 1024 * 2:
+        return kBufferSizeKernels1024;
+    case 2048 * 2:
+        return kBufferSizeKernels2048;
+    default:
+        return BufferSizeKernels{numSamples,
+                &SampleUtil::applyRampingGain,
+                &SampleUtil::copyWithRampingGain,
+                &SampleUtil::addWithRampingGain,
+                &SampleUtil::addToBothWithRampingGain};
+    }
 }
 
 // static
@@ -396,6 +619,7 @@ void SampleUtil::convertFloat32ToS16(SAMPLE* pDest, const CSAMPLE* pSrc,
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
 SampleUtil::CLIP_STATUS SampleUtil::sumAbsPerChannel(CSAMPLE* pfAbsL,
         CSAMPLE* pfAbsR, const CSAMPLE* pBuffer, SINT numSamples) {
     CSAMPLE fAbsL = CSAMPLE_ZERO;
@@ -427,6 +651,51 @@ SampleUtil::CLIP_STATUS SampleUtil::sumAbsPerChannel(CSAMPLE* pfAbsL,
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
+SampleUtil::CLIP_STATUS SampleUtil::measureLevelsPerChannel(
+        ChannelLevels* pLevelsL,
+        ChannelLevels* pLevelsR,
+        const CSAMPLE* pBuffer,
+        SINT numSamples) {
+    CSAMPLE fAbsL = CSAMPLE_ZERO;
+    CSAMPLE fAbsR = CSAMPLE_ZERO;
+    CSAMPLE fSquaresL = CSAMPLE_ZERO;
+    CSAMPLE fSquaresR = CSAMPLE_ZERO;
+    CSAMPLE fPeakL = CSAMPLE_ZERO;
+    CSAMPLE fPeakR = CSAMPLE_ZERO;
+
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numSamples / 2; ++i) {
+        const CSAMPLE l = pBuffer[i * 2];
+        const CSAMPLE absl = fabs(l);
+        fAbsL += absl;
+        fSquaresL += l * l;
+        fPeakL = absl > fPeakL ? absl : fPeakL;
+        const CSAMPLE r = pBuffer[i * 2 + 1];
+        const CSAMPLE absr = fabs(r);
+        fAbsR += absr;
+        fSquaresR += r * r;
+        fPeakR = absr > fPeakR ? absr : fPeakR;
+    }
+
+    pLevelsL->sumAbs = fAbsL;
+    pLevelsL->sumSquares = fSquaresL;
+    pLevelsL->peak = fPeakL;
+    pLevelsR->sumAbs = fAbsR;
+    pLevelsR->sumSquares = fSquaresR;
+    pLevelsR->peak = fPeakR;
+    SampleUtil::CLIP_STATUS clipping = SampleUtil::NO_CLIPPING;
+    if (fPeakL > CSAMPLE_PEAK) {
+        clipping |= SampleUtil::CLIPPING_LEFT;
+    }
+    if (fPeakR > CSAMPLE_PEAK) {
+        clipping |= SampleUtil::CLIPPING_RIGHT;
+    }
+    return clipping;
+}
+
+// static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::copyClampBuffer(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc, SINT iNumSamples) {
     // note: LOOP VECTORIZED.
@@ -436,6 +705,7 @@ void SampleUtil::copyClampBuffer(CSAMPLE* M_RESTRICT pDest,
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::interleaveBuffer(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc1,
         const CSAMPLE* M_RESTRICT pSrc2,
@@ -448,6 +718,7 @@ void SampleUtil::interleaveBuffer(CSAMPLE* M_RESTRICT pDest,
 }
 
 // static
+SAMPLEUTIL_TARGET_CLONES
 void SampleUtil::deinterleaveBuffer(CSAMPLE* M_RESTRICT pDest1,
         CSAMPLE* M_RESTRICT pDest2,
         const CSAMPLE* M_RESTRICT pSrc,
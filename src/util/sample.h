@@ -8,6 +8,27 @@
 #include "util/types.h"
 #include "util/platform.h"
 
+// The hot sample processing loops are compiled multiple times for
+// different x86 micro-architectures (function multi-versioning). The
+// best clone for the CPU is selected once at load time by a resolver
+// function that is generated by the compiler and queries cpuid, i.e.
+// the clones are called directly without any per-call checks.
+// The clones are pointless if the build already targets AVX-512 and
+// require ifunc support from the dynamic linker (ELF, glibc).
+// NEON is part of the base instruction set on ARM64 and is already used
+// by the auto-vectorized loops of the default build.
+#if defined(__x86_64__) && defined(__ELF__) && defined(__GLIBC__) && \
+        !defined(__AVX512F__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define SAMPLEUTIL_MULTIVERSIONING
+#define SAMPLEUTIL_TARGET_CLONES \
+    __attribute__((target_clones("arch=skylake-avx512", "arch=haswell", "default")))
+#endif
+#endif
+#ifndef SAMPLEUTIL_TARGET_CLONES
+#define SAMPLEUTIL_TARGET_CLONES
+#endif
+
 // A group of utilities for working with samples.
 class SampleUtil {
   public:
@@ -25,6 +46,10 @@ class SampleUtil {
     // This is some legacy, we cannot easily revert.
     static constexpr double kPlayPositionChannels = 2.0;
 
+    // The name of the instruction set of the multi-versioned functions
+    // that are used on this CPU, e.g. for logging and benchmarks.
+    static const char* simdInstructionSet();
+
     // Allocated a buffer of CSAMPLE's with length size. Ensures that the buffer
     // is 16-byte aligned for SSE enhancement.
     static CSAMPLE* alloc(SINT size);
@@ -160,6 +185,42 @@ class SampleUtil {
             CSAMPLE_GAIN old_gain, CSAMPLE_GAIN new_gain,
             SINT numSamples);
 
+    // The ramping gain functions that mix and scale the engine buffers,
+    // either compiled for a fixed buffer size or the generic versions.
+    // The engine only uses a few power of two buffer sizes, and with a
+    // constant size the loops are unrolled completely and the scalar
+    // remainder loops are omitted. The functions must be called with
+    // exactly numSamples samples.
+    struct BufferSizeKernels {
+        SINT numSamples;
+        void (*applyRampingGain)(CSAMPLE* pBuffer,
+                CSAMPLE_GAIN old_gain,
+                CSAMPLE_GAIN new_gain,
+                SINT numSamples);
+        void (*copyWithRampingGain)(CSAMPLE* pDest,
+                const CSAMPLE* pSrc,
+                CSAMPLE_GAIN old_gain,
+                CSAMPLE_GAIN new_gain,
+                SINT numSamples);
+        void (*addWithRampingGain)(CSAMPLE* pDest,
+                const CSAMPLE* pSrc,
+                CSAMPLE_GAIN old_gain,
+                CSAMPLE_GAIN new_gain,
+                SINT numSamples);
+        void (*addToBothWithRampingGain)(CSAMPLE* pDest1,
+                CSAMPLE_GAIN old_gain1,
+                CSAMPLE_GAIN new_gain1,
+                CSAMPLE* pDest2,
+                CSAMPLE_GAIN old_gain2,
+                CSAMPLE_GAIN new_gain2,
+                const CSAMPLE* pSrc,
+                SINT numSamples);
+    };
+
+    // Selects the kernels for stereo buffers of numSamples samples. This
+    // is meant to be called when the buffer size changes, not per buffer.
+    static BufferSizeKernels bufferSizeKernels(SINT numSamples);
+
     // Add pSrc to pDest
     static void add(CSAMPLE* pDest, const CSAMPLE* pSrc, SINT numSamples);
 
@@ -172,6 +233,18 @@ class SampleUtil {
             CSAMPLE_GAIN old_gain, CSAMPLE_GAIN new_gain,
             SINT numSamples);
 
+    // Add each sample of pSrc to pDest1 and pDest2, each ramping from its
+    // own old to its new gain. pSrc is read only once, which is faster than
+    // two calls of addWithRampingGain(). pDest2 may be null.
+    static void addToBothWithRampingGain(CSAMPLE* pDest1,
+            CSAMPLE_GAIN old_gain1,
+            CSAMPLE_GAIN new_gain1,
+            CSAMPLE* pDest2,
+            CSAMPLE_GAIN old_gain2,
+            CSAMPLE_GAIN new_gain2,
+            const CSAMPLE* pSrc,
+            SINT numSamples);
+
     // Add to each sample of pDest, pSrc1 multiplied by gain1 plus pSrc2
     // multiplied by gain2
     static void add2WithGain(CSAMPLE* pDest, const CSAMPLE* pSrc1,
@@ -201,6 +274,22 @@ class SampleUtil {
     static CLIP_STATUS sumAbsPerChannel(CSAMPLE* pfAbsL, CSAMPLE* pfAbsR,
             const CSAMPLE* pBuffer, SINT numSamples);
 
+    // The levels of one channel of a buffer as measured by
+    // measureLevelsPerChannel()
+    struct ChannelLevels {
+        CSAMPLE sumAbs = CSAMPLE_ZERO;
+        CSAMPLE sumSquares = CSAMPLE_ZERO;
+        // The maximum absolute value
+        CSAMPLE peak = CSAMPLE_ZERO;
+    };
+
+    // Like sumAbsPerChannel(), but additionally measures the sum of the
+    // squares for RMS and the sample peak of each channel in the same pass.
+    static CLIP_STATUS measureLevelsPerChannel(ChannelLevels* pLevelsL,
+            ChannelLevels* pLevelsR,
+            const CSAMPLE* pBuffer,
+            SINT numSamples);
+
     // Copies every sample in pSrc to pDest, limiting the values in pDest
     // to the valid range of CSAMPLE. pDest and pSrc must not overlap.
     static void copyClampBuffer(CSAMPLE* pDest, const CSAMPLE* pSrc,
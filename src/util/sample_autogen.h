@@ -3,6 +3,7 @@
 // THIS FILE IS AUTO-GENERATED. DO NOT EDIT DIRECTLY! //
 // SEE tools/generate_sample_functions.py             //
 ////////////////////////////////////////////////////////
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy1WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                  int iNumSamples) {
@@ -15,6 +16,7 @@ static inline void copy1WithGain(CSAMPLE* M_RESTRICT pDest,
         pDest[i] = pSrc0[i] * gain0;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy1WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                         int iNumSamples) {
@@ -31,6 +33,7 @@ static inline void copy1WithRampingGain(CSAMPLE* M_RESTRICT pDest,
         pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy2WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                  const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -49,6 +52,7 @@ static inline void copy2WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc1[i] * gain1;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy2WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -75,6 +79,7 @@ static inline void copy2WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc1[i * 2 + 1] * gain1;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy3WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                  const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -99,6 +104,7 @@ static inline void copy3WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc2[i] * gain2;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy3WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -135,6 +141,7 @@ static inline void copy3WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc2[i * 2 + 1] * gain2;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy4WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                  const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -165,6 +172,7 @@ static inline void copy4WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc3[i] * gain3;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy4WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -211,6 +219,7 @@ static inline void copy4WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc3[i * 2 + 1] * gain3;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy5WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                  const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -247,6 +256,7 @@ static inline void copy5WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc4[i] * gain4;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy5WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -303,6 +313,7 @@ static inline void copy5WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc4[i * 2 + 1] * gain4;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy6WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                  const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -345,6 +356,7 @@ static inline void copy6WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc5[i] * gain5;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy6WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -411,6 +423,7 @@ static inline void copy6WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc5[i * 2 + 1] * gain5;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy7WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                  const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -459,6 +472,7 @@ static inline void copy7WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc6[i] * gain6;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy7WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -535,6 +549,7 @@ static inline void copy7WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc6[i * 2 + 1] * gain6;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy8WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                  const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -589,6 +604,7 @@ static inline void copy8WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc7[i] * gain7;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy8WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -675,6 +691,7 @@ static inline void copy8WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc7[i * 2 + 1] * gain7;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy9WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                  const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -735,6 +752,7 @@ static inline void copy9WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc8[i] * gain8;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy9WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                         const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -831,6 +849,7 @@ static inline void copy9WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc8[i * 2 + 1] * gain8;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy10WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -897,6 +916,7 @@ static inline void copy10WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc9[i] * gain9;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy10WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -1003,6 +1023,7 @@ static inline void copy10WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc9[i * 2 + 1] * gain9;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy11WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -1075,6 +1096,7 @@ static inline void copy11WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc10[i] * gain10;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy11WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -1191,6 +1213,7 @@ static inline void copy11WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc10[i * 2 + 1] * gain10;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy12WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -1269,6 +1292,7 @@ static inline void copy12WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc11[i] * gain11;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy12WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -1395,6 +1419,7 @@ static inline void copy12WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc11[i * 2 + 1] * gain11;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy13WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -1479,6 +1504,7 @@ static inline void copy13WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc12[i] * gain12;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy13WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -1615,6 +1641,7 @@ static inline void copy13WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc12[i * 2 + 1] * gain12;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy14WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -1705,6 +1732,7 @@ static inline void copy14WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc13[i] * gain13;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy14WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -1851,6 +1879,7 @@ static inline void copy14WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc13[i * 2 + 1] * gain13;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy15WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -1947,6 +1976,7 @@ static inline void copy15WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc14[i] * gain14;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy15WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -2103,6 +2133,7 @@ static inline void copy15WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc14[i * 2 + 1] * gain14;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy16WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -2205,6 +2236,7 @@ static inline void copy16WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc15[i] * gain15;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy16WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -2371,6 +2403,7 @@ static inline void copy16WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc15[i * 2 + 1] * gain15;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy17WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -2479,6 +2512,7 @@ static inline void copy17WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc16[i] * gain16;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy17WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -2655,6 +2689,7 @@ static inline void copy17WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc16[i * 2 + 1] * gain16;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy18WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -2769,6 +2804,7 @@ static inline void copy18WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc17[i] * gain17;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy18WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -2955,6 +2991,7 @@ static inline void copy18WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc17[i * 2 + 1] * gain17;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy19WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -3075,6 +3112,7 @@ static inline void copy19WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc18[i] * gain18;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy19WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -3271,6 +3309,7 @@ static inline void copy19WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc18[i * 2 + 1] * gain18;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy20WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -3397,6 +3436,7 @@ static inline void copy20WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc19[i] * gain19;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy20WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -3603,6 +3643,7 @@ static inline void copy20WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc19[i * 2 + 1] * gain19;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy21WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -3735,6 +3776,7 @@ static inline void copy21WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc20[i] * gain20;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy21WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -3951,6 +3993,7 @@ static inline void copy21WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc20[i * 2 + 1] * gain20;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy22WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -4089,6 +4132,7 @@ static inline void copy22WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc21[i] * gain21;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy22WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -4315,6 +4359,7 @@ static inline void copy22WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc21[i * 2 + 1] * gain21;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy23WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -4459,6 +4504,7 @@ static inline void copy23WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc22[i] * gain22;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy23WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -4695,6 +4741,7 @@ static inline void copy23WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc22[i * 2 + 1] * gain22;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy24WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -4845,6 +4892,7 @@ static inline void copy24WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc23[i] * gain23;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy24WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -5091,6 +5139,7 @@ static inline void copy24WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc23[i * 2 + 1] * gain23;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy25WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -5247,6 +5296,7 @@ static inline void copy25WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc24[i] * gain24;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy25WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -5503,6 +5553,7 @@ static inline void copy25WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc24[i * 2 + 1] * gain24;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy26WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -5665,6 +5716,7 @@ static inline void copy26WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc25[i] * gain25;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy26WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -5931,6 +5983,7 @@ static inline void copy26WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc25[i * 2 + 1] * gain25;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy27WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -6099,6 +6152,7 @@ static inline void copy27WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc26[i] * gain26;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy27WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -6375,6 +6429,7 @@ static inline void copy27WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc26[i * 2 + 1] * gain26;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy28WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -6549,6 +6604,7 @@ static inline void copy28WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc27[i] * gain27;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy28WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -6835,6 +6891,7 @@ static inline void copy28WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc27[i * 2 + 1] * gain27;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy29WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -7015,6 +7072,7 @@ static inline void copy29WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc28[i] * gain28;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy29WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -7311,6 +7369,7 @@ static inline void copy29WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc28[i * 2 + 1] * gain28;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy30WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -7497,6 +7556,7 @@ static inline void copy30WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc29[i] * gain29;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy30WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -7803,6 +7863,7 @@ static inline void copy30WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc29[i * 2 + 1] * gain29;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy31WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -7995,6 +8056,7 @@ static inline void copy31WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc30[i] * gain30;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy31WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
@@ -8311,6 +8373,7 @@ static inline void copy31WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                            pSrc30[i * 2 + 1] * gain30;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy32WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
                                   const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1,
@@ -8509,6 +8572,7 @@ static inline void copy32WithGain(CSAMPLE* M_RESTRICT pDest,
                    pSrc31[i] * gain31;
     }
 }
+SAMPLEUTIL_TARGET_CLONES
 static inline void copy32WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
                                          const CSAMPLE* M_RESTRICT pSrc1, CSAMPLE_GAIN gain1in, CSAMPLE_GAIN gain1out,
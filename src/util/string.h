@@ -28,6 +28,12 @@ class StringCollator {
         return m_collator.compare(s1, s2);
     }
 
+    /// Sort keys are faster than compare() when comparing the same
+    /// string multiple times.
+    QCollatorSortKey sortKey(const QString& s) const {
+        return m_collator.sortKey(s);
+    }
+
   private:
     QCollator m_collator;
 };
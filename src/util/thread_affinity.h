@@ -6,6 +6,7 @@
 #include <QThread>
 
 #include "util/assert.h"
+#include "util/rtsafety.h"
 
 /// Assert that the current thread is the same as the host
 /// thread of the given QObject pointer. That thread runs
@@ -18,3 +19,10 @@
 /// thread of the application.
 #define DEBUG_ASSERT_MAIN_THREAD_AFFINITY() \
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(QCoreApplication::instance())
+
+/// Assert that the current thread is not processing the audio
+/// callback, e.g. before blocking or allocating. Violations are
+/// reported with a stack trace by the realtime safety checker,
+/// see util/rtsafety.h.
+#define DEBUG_ASSERT_NO_REALTIME_THREAD_AFFINITY() \
+    DEBUG_ASSERT_NOT_IN_REALTIME_SECTION(Q_FUNC_INFO)
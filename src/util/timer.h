@@ -8,6 +8,8 @@
 #include "util/parented_ptr.h"
 #include "util/performancetimer.h"
 #include "util/stat.h"
+#include "util/time.h"
+#include "util/tracerecorder.h"
 
 const Stat::ComputeFlags kDefaultComputeFlags = Stat::COUNT | Stat::SUM | Stat::AVERAGE |
         Stat::MAX | Stat::MIN | Stat::SAMPLE_VARIANCE;
@@ -55,7 +57,12 @@ class ScopedTimer {
     ScopedTimer(const char* key, int i,
                 Stat::ComputeFlags compute = kDefaultComputeFlags)
             : m_pTimer(NULL),
-              m_cancel(false) {
+              m_cancel(false),
+              m_pRecordedTag(nullptr) {
+        if (mixxx::TraceRecorder::isEnabled()) {
+            m_pRecordedTag = key;
+            m_recordedStart = mixxx::Time::elapsed();
+        }
         if (CmdlineArgs::Instance().getDeveloper()) {
             initialize(QString(key), QString::number(i), compute);
         }
@@ -64,7 +71,12 @@ class ScopedTimer {
     ScopedTimer(const char* key, const char *arg = NULL,
                 Stat::ComputeFlags compute = kDefaultComputeFlags)
             : m_pTimer(NULL),
-              m_cancel(false) {
+              m_cancel(false),
+              m_pRecordedTag(nullptr) {
+        if (mixxx::TraceRecorder::isEnabled()) {
+            m_pRecordedTag = key;
+            m_recordedStart = mixxx::Time::elapsed();
+        }
         if (CmdlineArgs::Instance().getDeveloper()) {
             initialize(QString(key), arg ? QString(arg) : QString(), compute);
         }
@@ -73,13 +85,22 @@ class ScopedTimer {
     ScopedTimer(const char* key, const QString& arg,
                 Stat::ComputeFlags compute = kDefaultComputeFlags)
             : m_pTimer(NULL),
-              m_cancel(false) {
+              m_cancel(false),
+              m_pRecordedTag(nullptr) {
+        if (mixxx::TraceRecorder::isEnabled()) {
+            m_pRecordedTag = key;
+            m_recordedStart = mixxx::Time::elapsed();
+        }
         if (CmdlineArgs::Instance().getDeveloper()) {
             initialize(QString(key), arg, compute);
         }
     }
 
     virtual ~ScopedTimer() {
+        if (m_pRecordedTag && !m_cancel) {
+            mixxx::TraceRecorder::record(
+                    m_pRecordedTag, m_recordedStart, mixxx::Time::elapsed());
+        }
         if (m_pTimer) {
             if (!m_cancel) {
                 m_pTimer->elapsed(true);
@@ -107,6 +128,9 @@ class ScopedTimer {
     Timer* m_pTimer;
     char m_timerMem[sizeof(Timer)];
     bool m_cancel;
+    // Only set if the TraceRecorder is enabled
+    const char* m_pRecordedTag;
+    mixxx::Duration m_recordedStart;
 };
 
 // A timer that provides a similar API to QTimer but uses render events from the
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QtGlobal>
+#include <cmath>
+
+#include "util/math.h"
+
+namespace mixxx {
+
+/// Limits the average rate of events, e.g. requests to a web service,
+/// while allowing bursts of up to the capacity of the bucket.
+///
+/// Tokens taken from an empty bucket are reserved in advance, i.e. the
+/// delays returned for consecutive events keep increasing and the caller
+/// is expected to wait for the returned delay before each event.
+class TokenBucket {
+  public:
+    TokenBucket(double tokensPerSecond, double capacity)
+            : m_tokensPerMilli(tokensPerSecond / 1000),
+              m_capacity(capacity),
+              m_tokens(capacity),
+              m_lastRefillMillis(-1) {
+    }
+
+    /// Takes a token at the monotonic time nowMillis and returns the
+    /// delay in milliseconds until it may be used, 0 if it may be used
+    /// immediately.
+    qint64 takeToken(qint64 nowMillis) {
+        if (m_lastRefillMillis >= 0 && nowMillis > m_lastRefillMillis) {
+            m_tokens = math_min(m_capacity,
+                    m_tokens + (nowMillis - m_lastRefillMillis) * m_tokensPerMilli);
+        }
+        m_lastRefillMillis = math_max(m_lastRefillMillis, nowMillis);
+        m_tokens -= 1.0;
+        if (m_tokens >= 0.0) {
+            return 0;
+        }
+        return static_cast<qint64>(std::ceil(-m_tokens / m_tokensPerMilli));
+    }
+
+  private:
+    const double m_tokensPerMilli;
+    const double m_capacity;
+    double m_tokens;
+    qint64 m_lastRefillMillis;
+};
+
+} // namespace mixxx
@@ -8,13 +8,17 @@
 #include "util/event.h"
 #include "util/performancetimer.h"
 #include "util/stat.h"
+#include "util/time.h"
+#include "util/tracerecorder.h"
 
 class Trace {
   public:
     Trace(const char* tag, const char* arg=NULL,
           bool writeToStdout=false, bool time=true)
             : m_writeToStdout(writeToStdout),
-              m_time(time) {
+              m_time(time),
+              m_pRecordedTag(nullptr) {
+        startRecording(tag);
         if (writeToStdout || CmdlineArgs::Instance().getDeveloper()) {
             initialize(tag, arg);
         }
@@ -23,7 +27,9 @@ class Trace {
     Trace(const char* tag, int arg,
           bool writeToStdout=false, bool time=true)
             : m_writeToStdout(writeToStdout),
-              m_time(time) {
+              m_time(time),
+              m_pRecordedTag(nullptr) {
+        startRecording(tag);
         if (writeToStdout || CmdlineArgs::Instance().getDeveloper()) {
             initialize(tag, QString::number(arg));
         }
@@ -32,13 +38,20 @@ class Trace {
     Trace(const char* tag, const QString& arg,
           bool writeToStdout=false, bool time=true)
             : m_writeToStdout(writeToStdout),
-              m_time(time) {
+              m_time(time),
+              m_pRecordedTag(nullptr) {
+        startRecording(tag);
         if (writeToStdout || CmdlineArgs::Instance().getDeveloper()) {
             initialize(tag, arg);
         }
     }
 
     virtual ~Trace() {
+        if (m_pRecordedTag) {
+            mixxx::TraceRecorder::record(
+                    m_pRecordedTag, m_recordedStart, mixxx::Time::elapsed());
+        }
+
         // Proxy for whether initialize was called.
         if (m_tag.isEmpty()) {
             return;
@@ -69,6 +82,13 @@ class Trace {
     }
 
   private:
+    void startRecording(const char* tag) {
+        if (mixxx::TraceRecorder::isEnabled()) {
+            m_pRecordedTag = tag;
+            m_recordedStart = mixxx::Time::elapsed();
+        }
+    }
+
     void initialize(const QString& key, const QString& arg) {
         if (arg.isEmpty()) {
             m_tag = key;
@@ -88,7 +108,9 @@ class Trace {
     QString m_tag;
     const bool m_writeToStdout, m_time;
     PerformanceTimer m_timer;
-
+    // Only set if the TraceRecorder is enabled
+    const char* m_pRecordedTag;
+    mixxx::Duration m_recordedStart;
 };
 
 class DebugTrace : public Trace {
@@ -0,0 +1,178 @@
+#include "util/tracerecorder.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QTextStream>
+#include <QThread>
+#include <QtDebug>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "util/compatibility/qmutex.h"
+#include "util/time.h"
+
+namespace mixxx {
+
+namespace {
+
+// About 10 seconds of the engine thread at small buffer sizes
+constexpr int kRegionsPerThread = 1 << 15;
+
+// All fields are atomic, because they are read while the owning thread
+// may overwrite them. Torn regions are detected by the write count.
+struct Region {
+    std::atomic<const char*> tag;
+    std::atomic<qint64> startNanos;
+    std::atomic<qint64> endNanos;
+};
+
+struct ThreadBuffer {
+    explicit ThreadBuffer(int id)
+            : id(id),
+              writeCount(0) {
+    }
+
+    const int id;
+    // Guarded by s_mutex
+    QString name;
+    std::atomic<quint64> writeCount;
+    std::array<Region, kRegionsPerThread> regions;
+};
+
+struct RecordedRegion {
+    const char* tag;
+    qint64 startNanos;
+    qint64 endNanos;
+};
+
+QMutex s_mutex;
+// Never released until the application exits, threads that ended keep
+// their regions
+std::vector<std::unique_ptr<ThreadBuffer>> s_threadBuffers;
+
+thread_local ThreadBuffer* t_pThreadBuffer = nullptr;
+
+ThreadBuffer* currentThreadBuffer() {
+    if (t_pThreadBuffer) {
+        return t_pThreadBuffer;
+    }
+    const auto locker = lockMutex(&s_mutex);
+    auto pThreadBuffer = std::make_unique<ThreadBuffer>(
+            static_cast<int>(s_threadBuffers.size()) + 1);
+    pThreadBuffer->name = QThread::currentThread()->objectName();
+    t_pThreadBuffer = pThreadBuffer.get();
+    s_threadBuffers.push_back(std::move(pThreadBuffer));
+    return t_pThreadBuffer;
+}
+
+/// Copies the regions that have not been overwritten while copying them.
+std::vector<RecordedRegion> copyRegions(const ThreadBuffer& threadBuffer) {
+    const quint64 count = threadBuffer.writeCount.load(std::memory_order_acquire);
+    const quint64 first = count > kRegionsPerThread ? count - kRegionsPerThread : 0;
+    std::vector<RecordedRegion> regions;
+    regions.reserve(static_cast<size_t>(count - first));
+    for (quint64 i = first; i < count; ++i) {
+        const Region& region = threadBuffer.regions[i % kRegionsPerThread];
+        regions.push_back(RecordedRegion{
+                region.tag.load(std::memory_order_relaxed),
+                region.startNanos.load(std::memory_order_relaxed),
+                region.endNanos.load(std::memory_order_relaxed)});
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // The thread may have overwritten the oldest regions in the meantime,
+    // including the one for the region it is currently writing
+    const quint64 countAfter = threadBuffer.writeCount.load(std::memory_order_relaxed);
+    if (countAfter + 1 > first + kRegionsPerThread) {
+        const quint64 overwritten = countAfter + 1 - kRegionsPerThread - first;
+        regions.erase(regions.begin(),
+                regions.begin() +
+                        static_cast<std::ptrdiff_t>(
+                                std::min<quint64>(overwritten, regions.size())));
+    }
+    return regions;
+}
+
+QString escapeJson(const QString& string) {
+    QString escaped = string;
+    escaped.replace(QLatin1Char('\\'), QLatin1String("\\\\"));
+    escaped.replace(QLatin1Char('"'), QLatin1String("\\\""));
+    return escaped;
+}
+
+} // anonymous namespace
+
+// static
+bool TraceRecorder::s_enabled = false;
+
+// static
+void TraceRecorder::enable() {
+    s_enabled = true;
+}
+
+// static
+void TraceRecorder::record(const char* tag, Duration start, Duration end) {
+    ThreadBuffer* pThreadBuffer = currentThreadBuffer();
+    const quint64 index = pThreadBuffer->writeCount.load(std::memory_order_relaxed);
+    Region& region = pThreadBuffer->regions[index % kRegionsPerThread];
+    region.tag.store(tag, std::memory_order_relaxed);
+    region.startNanos.store(start.toIntegerNanos(), std::memory_order_relaxed);
+    region.endNanos.store(end.toIntegerNanos(), std::memory_order_relaxed);
+    pThreadBuffer->writeCount.store(index + 1, std::memory_order_release);
+}
+
+// static
+void TraceRecorder::setCurrentThreadName(const QString& name) {
+    if (!s_enabled) {
+        return;
+    }
+    ThreadBuffer* pThreadBuffer = currentThreadBuffer();
+    const auto locker = lockMutex(&s_mutex);
+    pThreadBuffer->name = name;
+}
+
+// static
+bool TraceRecorder::writeChromeTrace(const QString& filePath, Duration window) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "TraceRecorder: Could not open" << filePath << "for writing";
+        return false;
+    }
+    const qint64 startNanos = (Time::elapsed() - window).toIntegerNanos();
+
+    QTextStream out(&file);
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    const auto locker = lockMutex(&s_mutex);
+    for (const auto& pThreadBuffer : s_threadBuffers) {
+        const QString name = pThreadBuffer->name.isEmpty()
+                ? QStringLiteral("Thread %1").arg(pThreadBuffer->id)
+                : pThreadBuffer->name;
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << pThreadBuffer->id << ",\"args\":{\"name\":\""
+            << escapeJson(name) << "\"}}";
+        for (const auto& region : copyRegions(*pThreadBuffer)) {
+            if (region.endNanos < startNanos) {
+                continue;
+            }
+            // The timestamps are in microseconds
+            out << ",\n{\"name\":\"" << escapeJson(QString::fromUtf8(region.tag))
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << pThreadBuffer->id
+                << ",\"ts\":" << QString::number(region.startNanos / 1000.0, 'f', 3)
+                << ",\"dur\":"
+                << QString::number((region.endNanos - region.startNanos) / 1000.0, 'f', 3)
+                << '}';
+        }
+    }
+    out << "\n]}\n";
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+} // namespace mixxx
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QString>
+
+#include "util/duration.h"
+
+namespace mixxx {
+
+/// Records the regions of Trace and ScopedTimer of all threads, so the last
+/// seconds before e.g. a dropout can be inspected in a trace viewer like
+/// chrome://tracing or Perfetto.
+///
+/// Each thread writes into its own ring buffer of a fixed size, which is
+/// allocated when the thread records its first region. Recording a region
+/// afterwards only takes two clock reads and a few relaxed stores, so the
+/// recorder is cheap enough to stay enabled during a performance.
+/// The oldest regions are overwritten, so busy threads cover a shorter
+/// time span than idle ones.
+class TraceRecorder {
+  public:
+    /// Must be called at startup before any other thread is started.
+    static void enable();
+
+    static bool isEnabled() {
+        return s_enabled;
+    }
+
+    /// Records a region of the current thread. The tag must be a string
+    /// literal, only the pointer is stored.
+    static void record(const char* tag, Duration start, Duration end);
+
+    /// Names the current thread in the written traces. Unnamed threads are
+    /// named by the object name of their QThread.
+    static void setCurrentThreadName(const QString& name);
+
+    /// Writes all recorded regions of all threads that ended within the
+    /// window before now in the Chrome trace event format.
+    static bool writeChromeTrace(const QString& filePath, Duration window);
+
+  private:
+    static bool s_enabled;
+};
+
+} // namespace mixxx
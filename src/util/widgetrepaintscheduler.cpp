@@ -0,0 +1,51 @@
+#include "util/widgetrepaintscheduler.h"
+
+#include "control/controlproxy.h"
+#include "moc_widgetrepaintscheduler.cpp"
+#include "util/assert.h"
+
+WidgetRepaintScheduler::WidgetRepaintScheduler()
+        : m_pGuiTick(make_parented<ControlProxy>(
+                  "[Master]", "guiTickTime", this, ControlFlag::NoAssertIfMissing)) {
+    if (m_pGuiTick->valid()) {
+        m_pGuiTick->connectValueChanged(this, &WidgetRepaintScheduler::slotGuiTick);
+    }
+}
+
+// static
+WidgetRepaintScheduler* WidgetRepaintScheduler::instance() {
+    // Lives until the application exits, like the widgets it serves
+    static WidgetRepaintScheduler* s_pInstance = new WidgetRepaintScheduler();
+    return s_pInstance;
+}
+
+// static
+void WidgetRepaintScheduler::scheduleUpdate(QWidget* pWidget) {
+    instance()->schedule(pWidget);
+}
+
+void WidgetRepaintScheduler::schedule(QWidget* pWidget) {
+    VERIFY_OR_DEBUG_ASSERT(pWidget) {
+        return;
+    }
+    if (!m_pGuiTick->valid()) {
+        pWidget->update();
+        return;
+    }
+    // Replaces a stale pointer if a deleted widget had the same address
+    m_dirtyWidgets.insert(pWidget, QPointer<QWidget>(pWidget));
+}
+
+void WidgetRepaintScheduler::slotGuiTick(double) {
+    if (m_dirtyWidgets.isEmpty()) {
+        return;
+    }
+    // Widgets may schedule themselves again while being updated
+    const auto dirtyWidgets = std::move(m_dirtyWidgets);
+    m_dirtyWidgets.clear();
+    for (const auto& pWidget : dirtyWidgets) {
+        if (pWidget) {
+            pWidget->update();
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QWidget>
+
+#include "util/parented_ptr.h"
+
+class ControlProxy;
+
+// Coalesces the repaints of widgets that are requested between two render
+// ticks of the VSyncThread.
+//
+// Widgets like VU meters and status lights receive their control changes at
+// arbitrary times. Calling QWidget::update directly from these slots lets Qt
+// paint each of them on its own, sometimes several times per frame and out of
+// step with the waveforms. Instead, the widgets are only marked as dirty here.
+// All dirty widgets are updated at once with the next guiTickTime, right
+// after the changed controls have been notified, so Qt paints the union of
+// their regions in a single pass per frame.
+//
+// If there is no GuiTick, e.g. in tests, the widgets are updated immediately.
+class WidgetRepaintScheduler : public QObject {
+    Q_OBJECT
+  public:
+    // Must be called from the main thread.
+    static void scheduleUpdate(QWidget* pWidget);
+
+  private slots:
+    void slotGuiTick(double);
+
+  private:
+    WidgetRepaintScheduler();
+
+    static WidgetRepaintScheduler* instance();
+
+    void schedule(QWidget* pWidget);
+
+    parented_ptr<ControlProxy> m_pGuiTick;
+    // Keyed by the widget pointer to schedule each widget only once.
+    // The QPointer detects widgets that have been deleted in the meantime.
+    QHash<QWidget*, QPointer<QWidget>> m_dirtyWidgets;
+};
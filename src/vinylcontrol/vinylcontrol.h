@@ -3,6 +3,7 @@
 #include <QString>
 
 #include "util/types.h"
+#include "util/duration.h"
 #include "preferences/usersettings.h"
 #include "vinylcontrol/vinylsignalquality.h"
 
@@ -16,7 +17,12 @@ class VinylControl : public QObject {
 
     virtual void toggleVinylControl(bool enable);
     virtual bool isEnabled();
-    virtual void analyzeSamples(CSAMPLE* pSamples, size_t nFrames) = 0;
+    /// Analyzes the next nFrames stereo frames of the input. bufferTimestamp
+    /// is the mixxx::Time::elapsed() of the engine callback that delivered the
+    /// last of these frames.
+    virtual void analyzeSamples(CSAMPLE* pSamples,
+            size_t nFrames,
+            mixxx::Duration bufferTimestamp) = 0;
     virtual bool writeQualityReport(VinylSignalQualityReport* qualityReportFifo) = 0;
 
   protected:
@@ -5,19 +5,94 @@
 #include "util/defs.h"
 #include "util/event.h"
 #include "util/sample.h"
+#include "util/time.h"
 #include "util/timer.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
 #include "vinylcontrol/vinylcontrol.h"
 #include "vinylcontrol/vinylcontrolxwax.h"
 
 #define SIGNAL_QUALITY_FIFO_SIZE 256
-#define SAMPLE_PIPE_FIFO_SIZE 65536
+// Each deck thread drains its pipe as soon as it is woken, so the pipe only
+// needs to bridge scheduling hiccups: ~170 ms of stereo samples at 96 kHz.
+#define SAMPLE_PIPE_FIFO_SIZE 32768
+
+namespace {
+constexpr int kChannels = 2;
+} // anonymous namespace
+
+VinylControlDeckProcessor::VinylControlDeckProcessor(
+        VinylControlProcessor* pProcessor, int index)
+        : QThread(),
+          m_pProcessor(pProcessor),
+          m_index(index),
+          m_samplePipe(SAMPLE_PIPE_FIFO_SIZE),
+          m_pWorkBuffer(SampleUtil::alloc(SAMPLE_PIPE_FIFO_SIZE)),
+          m_lastBufferTimestampNanos(0),
+          m_bQuit(0) {
+    start(QThread::HighPriority);
+}
+
+VinylControlDeckProcessor::~VinylControlDeckProcessor() {
+    shutdown();
+    wait();
+    SampleUtil::free(m_pWorkBuffer);
+}
+
+void VinylControlDeckProcessor::shutdown() {
+    m_bQuit = 1;
+    m_samplesAvailable.release();
+}
+
+void VinylControlDeckProcessor::receiveBuffer(
+        const CSAMPLE* pBuffer, unsigned int nFrames) {
+    m_lastBufferTimestampNanos.storeRelease(mixxx::Time::elapsed().toIntegerNanos());
+
+    const int nSamples = nFrames * kChannels;
+    int samplesWritten = m_samplePipe.write(pBuffer, nSamples);
+
+    if (samplesWritten < nSamples) {
+        qWarning() << "ERROR: Buffer overflow in VinylControlProcessor. Dropping samples on the floor."
+                   << "VCIndex:" << m_index;
+    }
+
+    m_samplesAvailable.release();
+}
+
+void VinylControlDeckProcessor::run() {
+    QThread::currentThread()->setObjectName(
+            QString("VinylControlDeckProcessor %1").arg(m_index + 1));
+
+    while (m_bQuit.loadAcquire() == 0) {
+        // Wait for the engine callback or shutdown() and collapse the wake-ups
+        // of all buffers that arrived in the meantime, they are read at once.
+        m_samplesAvailable.acquire();
+        m_samplesAvailable.tryAcquire(m_samplesAvailable.available());
+        if (m_bQuit.loadAcquire() != 0) {
+            break;
+        }
+
+        int samplesRead = m_samplePipe.read(m_pWorkBuffer, SAMPLE_PIPE_FIFO_SIZE);
+        if (samplesRead <= 0) {
+            continue;
+        }
+        const auto bufferTimestamp = mixxx::Duration::fromNanos(
+                m_lastBufferTimestampNanos.loadAcquire());
+
+        if (samplesRead % 2 != 0) {
+            qWarning() << "VinylControlProcessor received non-even number of samples via sample FIFO.";
+            samplesRead--;
+        }
+        m_pProcessor->analyzeSamples(m_index,
+                m_pWorkBuffer,
+                samplesRead / kChannels,
+                bufferTimestamp);
+    }
+}
 
 VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPointer pConfig)
         : QThread(pParent),
           m_pConfig(pConfig),
           m_pToggle(new ControlPushButton(ConfigKey(VINYL_PREF_KEY, "Toggle"))),
-          m_pWorkBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_processorsLock(QT_RECURSIVE_MUTEX_INIT),
           m_processors(kMaximumVinylControlInputs, NULL),
           m_signalQualityFifo(SIGNAL_QUALITY_FIFO_SIZE),
@@ -31,19 +106,23 @@ VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPoint
             Qt::DirectConnection);
 
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-        m_samplePipes[i] = new FIFO<CSAMPLE>(SAMPLE_PIPE_FIFO_SIZE);
+        m_deckProcessors[i] = new VinylControlDeckProcessor(this, i);
     }
 
     start(QThread::HighPriority);
 }
 
 VinylControlProcessor::~VinylControlProcessor() {
-    m_bQuit = true;
-    m_samplesAvailableSignal.wakeAll();
+    shutdown();
     wait();
 
+    // Stop the deck threads before deleting the VinylControls they use.
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        delete m_deckProcessors[i];
+        m_deckProcessors[i] = nullptr;
+    }
+
     delete m_pToggle;
-    SampleUtil::free(m_pWorkBuffer);
 
     {
         const auto locker = lockMutex(&m_processorsLock);
@@ -51,9 +130,6 @@ VinylControlProcessor::~VinylControlProcessor() {
             VinylControl* pProcessor = m_processors.at(i);
             m_processors[i] = NULL;
             delete pProcessor;
-
-            delete m_samplePipes[i];
-            m_samplePipes[i] = nullptr;
         }
     }
 
@@ -67,86 +143,85 @@ void VinylControlProcessor::setSignalQualityReporting(bool enable) {
 }
 
 void VinylControlProcessor::shutdown() {
+    const auto locker = lockMutex(&m_wakeMutex);
     m_bQuit = true;
-    m_samplesAvailableSignal.wakeAll();
+    m_wakeSignal.wakeAll();
 }
 
 void VinylControlProcessor::requestReloadConfig() {
+    const auto locker = lockMutex(&m_wakeMutex);
     m_bReloadConfig = true;
-    m_samplesAvailableSignal.wakeAll();
+    m_wakeSignal.wakeAll();
 }
 
 void VinylControlProcessor::run() {
     unsigned static id = 0; //the id of this thread, for debugging purposes //XXX copypasta (should factor this out somehow), -kousu 2/2009
     QThread::currentThread()->setObjectName(QString("VinylControlProcessor %1").arg(++id));
 
+    auto locker = lockMutex(&m_wakeMutex);
     while (!m_bQuit) {
         if (m_bReloadConfig) {
-            reloadConfig();
             m_bReloadConfig = false;
+            locker.unlock();
+            reloadConfig();
+            locker.relock();
+            continue;
         }
 
-        for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-            auto locker = lockMutex(&m_processorsLock);
-            VinylControl* pProcessor = m_processors[i];
-            locker.unlock();
-            FIFO<CSAMPLE>* pSamplePipe = m_samplePipes[i];
-
-            if (pSamplePipe->readAvailable() > 0) {
-                int samplesRead = pSamplePipe->read(m_pWorkBuffer, MAX_BUFFER_LEN);
-
-                if (samplesRead % 2 != 0) {
-                    qWarning() << "VinylControlProcessor received non-even number of samples via sample FIFO.";
-                    samplesRead--;
-                }
-                int framesRead = samplesRead / 2;
-
-                if (pProcessor) {
-                    pProcessor->analyzeSamples(m_pWorkBuffer, framesRead);
-                } else {
-                    // Samples are being written to a non-existent processor. Warning?
-                    qWarning() << "Samples written to non-existent VinylControl processor:" << i;
-                }
-            }
+        // Wait for a signal from the main thread that we should reload the
+        // config or quit.
+        m_wakeSignal.wait(&m_wakeMutex);
+    }
+}
 
-            // TODO(rryan) define a time-based update rate. This will update way
-            // too quickly.
-            if (pProcessor && m_bReportSignalQuality) {
-                VinylSignalQualityReport report;
-                if (pProcessor->writeQualityReport(&report)) {
-                    report.processor = i;
-                    if (m_signalQualityFifo.write(&report, 1) != 1) {
-                        qWarning() << "VinylControlProcessor could not write signal quality report for VC index:" << i;
-                    }
-                }
-            }
-        }
+void VinylControlProcessor::analyzeSamples(int index,
+        CSAMPLE* pSamples,
+        size_t nFrames,
+        mixxx::Duration bufferTimestamp) {
+    // Keeps the VinylControl of this deck alive until it is done.
+    const auto processingLocker = lockMutex(m_deckProcessors[index]->processingMutex());
+    auto locker = lockMutex(&m_processorsLock);
+    VinylControl* pProcessor = m_processors[index];
+    locker.unlock();
 
-        if (m_bQuit) {
-            break;
-        }
+    if (!pProcessor) {
+        // Samples are being written to a non-existent processor. Warning?
+        qWarning() << "Samples written to non-existent VinylControl processor:" << index;
+        return;
+    }
 
-        // Wait for a signal from the main thread or engine thread that we
-        // should wake up and process input.
-        m_waitForSampleMutex.lock();
-        m_samplesAvailableSignal.wait(&m_waitForSampleMutex);
-        m_waitForSampleMutex.unlock();
+    pProcessor->analyzeSamples(pSamples, nFrames, bufferTimestamp);
+
+    // TODO(rryan) define a time-based update rate. This will update way
+    // too quickly.
+    if (m_bReportSignalQuality) {
+        VinylSignalQualityReport report;
+        if (pProcessor->writeQualityReport(&report)) {
+            report.processor = index;
+            const auto fifoLocker = lockMutex(&m_signalQualityFifoMutex);
+            if (m_signalQualityFifo.write(&report, 1) != 1) {
+                qWarning() << "VinylControlProcessor could not write signal quality report for VC index:" << index;
+            }
+        }
     }
 }
 
+VinylControl* VinylControlProcessor::replaceProcessor(int index, VinylControl* pNew) {
+    const auto processingLocker = lockMutex(m_deckProcessors[index]->processingMutex());
+    const auto locker = lockMutex(&m_processorsLock);
+    VinylControl* pCurrent = m_processors.at(index);
+    m_processors.replace(index, pNew);
+    return pCurrent;
+}
+
 void VinylControlProcessor::reloadConfig() {
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-        auto locker = lockMutex(&m_processorsLock);
-        VinylControl* pCurrent = m_processors[i];
-
-        if (pCurrent == nullptr) {
+        if (!deckConfigured(i)) {
             continue;
         }
 
-        VinylControl *pNew = new VinylControlXwax(
-            m_pConfig, kVCGroup.arg(i + 1));
-        m_processors.replace(i, pNew);
-        locker.unlock();
+        VinylControl* pCurrent = replaceProcessor(
+                i, new VinylControlXwax(m_pConfig, kVCGroup.arg(i + 1)));
         // Delete outside of the critical section to avoid deadlocks.
         delete pCurrent;
     }
@@ -168,10 +243,7 @@ void VinylControlProcessor::onInputConfigured(const AudioInput& input) {
     VinylControl *pNew = new VinylControlXwax(
         m_pConfig, kVCGroup.arg(index + 1));
 
-    auto locker = lockMutex(&m_processorsLock);
-    VinylControl* pCurrent = m_processors.at(index);
-    m_processors.replace(index, pNew);
-    locker.unlock();
+    VinylControl* pCurrent = replaceProcessor(index, pNew);
     // Delete outside of the critical section to avoid deadlocks.
     delete pCurrent;
 }
@@ -190,10 +262,7 @@ void VinylControlProcessor::onInputUnconfigured(const AudioInput& input) {
         return;
     }
 
-    auto locker = lockMutex(&m_processorsLock);
-    VinylControl* pVC = m_processors.at(index);
-    m_processors.replace(index, NULL);
-    locker.unlock();
+    VinylControl* pVC = replaceProcessor(index, nullptr);
     // Delete outside of the critical section to avoid deadlocks.
     delete pVC;
 }
@@ -218,23 +287,14 @@ void VinylControlProcessor::receiveBuffer(const AudioInput& input,
         return;
     }
 
-    FIFO<CSAMPLE>* pSamplePipe = m_samplePipes[vcIndex];
+    VinylControlDeckProcessor* pDeckProcessor = m_deckProcessors[vcIndex];
 
-    if (pSamplePipe == nullptr) {
+    if (pDeckProcessor == nullptr) {
         // Should not be possible.
         return;
     }
 
-    constexpr int kChannels = 2;
-    const int nSamples = nFrames * kChannels;
-    int samplesWritten = pSamplePipe->write(pBuffer, nSamples);
-
-    if (samplesWritten < nSamples) {
-        qWarning() << "ERROR: Buffer overflow in VinylControlProcessor. Dropping samples on the floor."
-                   << "VCIndex:" << vcIndex;
-    }
-
-    m_samplesAvailableSignal.wakeAll();
+    pDeckProcessor->receiveBuffer(pBuffer, nFrames);
 }
 
 void VinylControlProcessor::toggleDeck(double value) {
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <QAtomicInteger>
 #include <QMutex>
 #include <QObject>
+#include <QSemaphore>
 #include <QThread>
 #include <QVector>
 #include <QWaitCondition>
@@ -9,16 +11,55 @@
 #include "preferences/usersettings.h"
 #include "soundio/soundmanagerutil.h"
 #include "util/compatibility/qmutex.h"
+#include "util/duration.h"
 #include "util/fifo.h"
 #include "vinylcontrol/vinylsignalquality.h"
 
 class VinylControl;
+class VinylControlProcessor;
 class ControlPushButton;
 
-// VinylControlProcessor is a thread that is in charge of receiving samples from
-// the engine callback and feeding those samples to the VinylControl
-// classes. The most important thing is that the connection between the engine
-// callback and VinylControlProcessor (the receiveBuffer method) is lock-free.
+// VinylControlDeckProcessor is the thread that decodes the timecode of a
+// single vinyl control input. It is woken by the engine callback as soon as
+// new samples of its input arrive, so a busy deck never delays another one.
+class VinylControlDeckProcessor : public QThread {
+    Q_OBJECT
+  public:
+    VinylControlDeckProcessor(VinylControlProcessor* pProcessor, int index);
+    ~VinylControlDeckProcessor() override;
+
+    // Called by the engine callback. Lock-free apart from waking the thread.
+    void receiveBuffer(const CSAMPLE* pBuffer, unsigned int nFrames);
+
+    void shutdown();
+
+    // Held while the VinylControl of this deck analyzes samples. Lock it
+    // before the processors lock to replace the VinylControl.
+    QMutex* processingMutex() {
+        return &m_processingMutex;
+    }
+
+  protected:
+    void run() override;
+
+  private:
+    VinylControlProcessor* const m_pProcessor;
+    const int m_index;
+    FIFO<CSAMPLE> m_samplePipe;
+    CSAMPLE* m_pWorkBuffer;
+    // The mixxx::Time::elapsed() of the last engine callback in nanoseconds
+    QAtomicInteger<qint64> m_lastBufferTimestampNanos;
+    QSemaphore m_samplesAvailable;
+    QMutex m_processingMutex;
+    QAtomicInt m_bQuit;
+};
+
+// VinylControlProcessor is in charge of receiving samples from the engine
+// callback and feeding those samples to the VinylControl classes, each of
+// which runs on its own VinylControlDeckProcessor thread. The most important
+// thing is that the connection between the engine callback and
+// VinylControlProcessor (the receiveBuffer method) is lock-free. The
+// VinylControlProcessor thread itself only handles config reloads.
 class VinylControlProcessor : public QThread, public AudioDestination {
     Q_OBJECT
   public:
@@ -45,7 +86,7 @@ class VinylControlProcessor : public QThread, public AudioDestination {
     virtual void onInputUnconfigured(const AudioInput& input);
 
     // Called by the engine callback. Must not touch any state in
-    // VinylControlProcessor except for m_samplePipes. NOTE:
+    // VinylControlProcessor except for m_deckProcessors. NOTE:
 
     // This is called by SoundManager whenever there are new samples from the
     // configured input to be processed. This is run in the callback thread of
@@ -62,19 +103,30 @@ class VinylControlProcessor : public QThread, public AudioDestination {
     void toggleDeck(double value);
 
   private:
+    friend class VinylControlDeckProcessor;
+
+    // Called from the deck processor thread of the given index.
+    void analyzeSamples(int index,
+            CSAMPLE* pSamples,
+            size_t nFrames,
+            mixxx::Duration bufferTimestamp);
+
     void reloadConfig();
+    // Returns the previous VinylControl, which the caller must delete.
+    VinylControl* replaceProcessor(int index, VinylControl* pNew);
 
     UserSettingsPointer m_pConfig;
     ControlPushButton* m_pToggle;
-    // A pre-allocated array of FIFOs for writing samples from the engine
-    // callback to the processor thread. There is a maximum of
-    // kMaximumVinylControlInputs pipes.
-    FIFO<CSAMPLE>* m_samplePipes[kMaximumVinylControlInputs];
-    CSAMPLE* m_pWorkBuffer;
-    QWaitCondition m_samplesAvailableSignal;
-    QMutex m_waitForSampleMutex;
+    // A pre-allocated array of deck processor threads, each with its own FIFO
+    // for writing samples from the engine callback. There is a maximum of
+    // kMaximumVinylControlInputs decks.
+    VinylControlDeckProcessor* m_deckProcessors[kMaximumVinylControlInputs];
+    QWaitCondition m_wakeSignal;
+    QMutex m_wakeMutex;
     QT_RECURSIVE_MUTEX m_processorsLock;
     QVector<VinylControl*> m_processors;
+    // The deck processor threads are multiple producers for the SPSC FIFO.
+    QMutex m_signalQualityFifoMutex;
     FIFO<VinylSignalQualityReport> m_signalQualityFifo;
     volatile bool m_bReportSignalQuality;
     volatile bool m_bQuit;
@@ -2,11 +2,13 @@
 #include <limits.h>
 
 #include "vinylcontrol/vinylcontrolxwax.h"
+#include "util/assert.h"
 #include "util/timer.h"
 #include "control/controlproxy.h"
 #include "control/controlobject.h"
 #include "util/math.h"
 #include "util/defs.h"
+#include "util/time.h"
 
 /****** TODO *******
    Stuff to maybe implement here
@@ -18,13 +20,17 @@
 
 namespace {
 constexpr int kChannels = 2;
+// The delay between the engine callback and the analysis is only compensated
+// up to this value. A longer delay means the processor thread stalled and
+// extrapolating that far would be a guess.
+constexpr double kMaxProcessingDelaySeconds = 0.1;
 } // namespace
 
 // Sample threshold below which we consider there to be no signal.
 constexpr double kMinSignal = 75.0 / SAMPLE_MAXIMUM;
 
-bool VinylControlXwax::s_bLUTInitialized = false;
 QMutex VinylControlXwax::s_xwaxLUTMutex;
+QHash<timecode_def*, int> VinylControlXwax::s_lutUsers;
 
 VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, const QString& group)
         : VinylControl(pConfig, group),
@@ -109,14 +115,6 @@ VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, const QString& g
         m_pSteadyGross = new SteadyPitch(0.5, false);
     }
 
-    timecode_def* tc_def = timecoder_find_definition(timecode);
-    if (tc_def == nullptr) {
-        qDebug() << "Error finding timecode definition for " << timecode
-                 << ", defaulting to" << MIXXX_VINYL_DEFAULT_XWAX_NAME;
-        timecode = MIXXX_VINYL_DEFAULT_XWAX_NAME;
-        tc_def = timecoder_find_definition(timecode);
-    }
-
     double speed = 1.0;
     double rpm = 100.0 / 3.0;
     if (strVinylSpeed == MIXXX_VINYL_SPEED_45) {
@@ -140,19 +138,27 @@ VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, const QString& g
     m_pPitchRing.resize(m_iPitchRingSize);
 
     qDebug() << "Xwax Vinyl control starting with a sample rate of:" << iSampleRate;
-    qDebug() << "Building timecode lookup tables for" << strVinylType << "with speed" << strVinylSpeed;
+    qDebug() << "Using timecode lookup tables for" << strVinylType << "with speed" << strVinylSpeed;
 
     // Initialize the timecoder structure. Use the static mutex so that we only
     // do this once across the VinylControlXwax instances.
     s_xwaxLUTMutex.lock();
 
+    // Builds the LUT only if no other deck uses this timecode already.
+    timecode_def* tc_def = timecoder_find_definition(timecode);
+    if (tc_def == nullptr) {
+        qDebug() << "Error finding timecode definition for " << timecode
+                 << ", defaulting to" << MIXXX_VINYL_DEFAULT_XWAX_NAME;
+        timecode = MIXXX_VINYL_DEFAULT_XWAX_NAME;
+        tc_def = timecoder_find_definition(timecode);
+    }
+    if (tc_def) {
+        ++s_lutUsers[tc_def];
+    }
+
     timecoder_init(&timecoder, tc_def, speed, iSampleRate, /* phono */ false);
     timecoder_monitor_init(&timecoder, MIXXX_VINYL_SCOPE_SIZE);
-    //Note that timecoder_init will not double-malloc the LUTs, and after this we are guaranteed
-    //that the LUT has been generated unless we ran out of memory.
-    s_bLUTInitialized = true;
     m_uiSafeZone = timecoder_get_safe(&timecoder);
-    //}
     s_xwaxLUTMutex.unlock();
 
     qDebug() << "Starting vinyl control xwax thread";
@@ -163,12 +169,19 @@ VinylControlXwax::~VinylControlXwax() {
     delete m_pSteadyGross;
 
     // Cleanup xwax nicely
+    timecode_def* tc_def = timecoder_get_definition(&timecoder);
     timecoder_monitor_clear(&timecoder);
     timecoder_clear(&timecoder);
 
-    // TODO(rryan): This looks wrong. freeLUTs is called later by
-    // VinylControlProcessor so we are probably leaking the LUTs.
-    s_bLUTInitialized = false;
+    // Free the LUT if this was the last deck using the timecode, e.g. after
+    // the timecode type has been changed in the preferences.
+    s_xwaxLUTMutex.lock();
+    auto it = s_lutUsers.find(tc_def);
+    if (it != s_lutUsers.end() && --it.value() <= 0) {
+        s_lutUsers.erase(it);
+        timecoder_free_definition_lookup(tc_def);
+    }
+    s_xwaxLUTMutex.unlock();
 
     m_pVCRate->set(0.0);
 }
@@ -176,10 +189,11 @@ VinylControlXwax::~VinylControlXwax() {
 //static
 void VinylControlXwax::freeLUTs() {
     s_xwaxLUTMutex.lock(); //Static mutex! We don't want two threads doing this!
-    if (s_bLUTInitialized) {
-        timecoder_free_lookup(); //Frees all the LUTs in xwax.
-        s_bLUTInitialized = false;
-    }
+    // The LUTs are freed along with their last user, this only frees the ones
+    // of VinylControlXwax instances that have not been deleted.
+    DEBUG_ASSERT(s_lutUsers.isEmpty());
+    timecoder_free_lookup(); //Frees all the LUTs in xwax.
+    s_lutUsers.clear();
     s_xwaxLUTMutex.unlock();
 }
 
@@ -195,7 +209,9 @@ bool VinylControlXwax::writeQualityReport(VinylSignalQualityReport* pReport) {
 }
 
 
-void VinylControlXwax::analyzeSamples(CSAMPLE* pSamples, size_t nFrames) {
+void VinylControlXwax::analyzeSamples(CSAMPLE* pSamples,
+        size_t nFrames,
+        mixxx::Duration bufferTimestamp) {
     ScopedTimer t("VinylControlXwax::analyzeSamples");
     auto gain = static_cast<CSAMPLE_GAIN>(m_pVinylControlInputGain->get());
 
@@ -280,6 +296,15 @@ void VinylControlXwax::analyzeSamples(CSAMPLE* pSamples, size_t nFrames) {
     // make sure m_dVinylPosition only has good values
     if (m_iPosition != -1) {
         m_dVinylPosition = static_cast<double>(m_iPosition) / 1000.0 - m_iLeadInTime;
+        // The timecode position belongs to the end of the buffer, which was
+        // captured when the engine callback delivered it. The file position
+        // is read now, so advance the vinyl position by the distance the
+        // record travelled in the meantime.
+        const double processingDelay = math_clamp(
+                (mixxx::Time::elapsed() - bufferTimestamp).toDoubleSeconds(),
+                0.0,
+                kMaxProcessingDelaySeconds);
+        m_dVinylPosition += dVinylPitch * processingDelay;
     }
 
     // Initialize drift control to zero in case we don't get any position data
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QTime>
 #include <vector>
 
@@ -27,7 +28,9 @@ class VinylControlXwax : public VinylControl {
     virtual ~VinylControlXwax();
 
     static void freeLUTs();
-    void analyzeSamples(CSAMPLE* pSamples, size_t nFrames);
+    void analyzeSamples(CSAMPLE* pSamples,
+            size_t nFrames,
+            mixxx::Duration bufferTimestamp) override;
 
     virtual bool writeQualityReport(VinylSignalQualityReport* qualityReportFifo);
 
@@ -143,5 +146,8 @@ class VinylControlXwax : public VinylControl {
     struct timecoder timecoder;
     // Static mutex that protects our creation/destruction of the xwax LUTs
     static QMutex s_xwaxLUTMutex;
-    static bool s_bLUTInitialized;
+    // xwax builds one read-only LUT per timecode definition, which is shared
+    // by all timecoders using it. Counts the users of each one, so the LUT of
+    // a timecode is freed as soon as no deck uses it anymore.
+    static QHash<timecode_def*, int> s_lutUsers;
 };
@@ -2,6 +2,7 @@
 
 #include "waveform/guitick.h"
 #include "control/controlobject.h"
+#include "control/realtimecontrol.h"
 
 GuiTick::GuiTick() {
     m_pCOGuiTickTime = std::make_unique<ControlObject>(ConfigKey("[Master]", "guiTickTime"));
@@ -12,6 +13,11 @@ GuiTick::GuiTick() {
 // this is called from WaveformWidgetFactory::render in the main thread with the
 // configured waveform frame rate
 void GuiTick::process() {
+    // Notify the listeners of all controls that have been changed by the
+    // engine or other threads since the last tick
+    RealtimeControl::notifyChangedControls();
+    ControlDoublePrivate::dispatchCoalescedValueChanges();
+
     m_cpuTimeLastTick += m_cpuTimer.restart();
     double cpuTimeLastTickSeconds = m_cpuTimeLastTick.toDoubleSeconds();
     m_pCOGuiTickTime->set(cpuTimeLastTickSeconds);
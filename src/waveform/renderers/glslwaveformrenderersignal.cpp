@@ -3,6 +3,7 @@
 
 #include <QGLFramebufferObject>
 #include <QGLShaderProgram>
+#include <algorithm>
 
 #include "moc_glslwaveformrenderersignal.cpp"
 #include "track/track.h"
@@ -82,10 +83,15 @@ bool GLSLWaveformRendererSignal::loadTexture() {
     ConstWaveformPointer waveform;
     int dataSize = 0;
     const WaveformData* data = nullptr;
+    // The analyzer continues writing while the texture is uploaded. Data
+    // that is written after reading the completion is uploaded again by
+    // the next update.
+    int completion = 0;
 
     if (trackInfo) {
         waveform = trackInfo->getWaveform();
         if (waveform) {
+            completion = waveform->getCompletion();
             dataSize = waveform->getDataSize();
             if (dataSize > 1) {
                 data = waveform->data();
@@ -126,9 +132,11 @@ bool GLSLWaveformRendererSignal::loadTexture() {
         if (error) {
             qDebug() << "GLSLWaveformRendererSignal::loadTexture - glTexImage2D error" << error;
         }
+        m_textureRenderedWaveformCompletion = completion;
     } else {
         glDeleteTextures(1, &m_textureId);
         m_textureId = 0;
+        m_textureRenderedWaveformCompletion = 0;
     }
 
     glDisable(GL_TEXTURE_2D);
@@ -136,6 +144,41 @@ bool GLSLWaveformRendererSignal::loadTexture() {
     return true;
 }
 
+void GLSLWaveformRendererSignal::updateTexture(
+        const ConstWaveformPointer& waveform, int completion) {
+    DEBUG_ASSERT(m_textureId);
+    const int textureWidth = waveform->getTextureStride();
+    const int textureHeight = waveform->getTextureSize() / textureWidth;
+    // Rows of the texture that contain new data, the first row might
+    // have been uploaded partially before
+    const int firstRow = m_textureRenderedWaveformCompletion / textureWidth;
+    const int lastRow = std::min(
+            (completion + textureWidth - 1) / textureWidth, textureHeight);
+    if (firstRow >= lastRow) {
+        m_textureRenderedWaveformCompletion = completion;
+        return;
+    }
+
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, m_textureId);
+    glTexSubImage2D(GL_TEXTURE_2D,
+            0,
+            0,
+            firstRow,
+            textureWidth,
+            lastRow - firstRow,
+            GL_RGBA,
+            GL_UNSIGNED_BYTE,
+            waveform->data() + firstRow * textureWidth);
+    int error = glGetError();
+    if (error) {
+        qDebug() << "GLSLWaveformRendererSignal::updateTexture - glTexSubImage2D error" << error;
+    }
+    glDisable(GL_TEXTURE_2D);
+
+    m_textureRenderedWaveformCompletion = completion;
+}
+
 void GLSLWaveformRendererSignal::createGeometry() {
 
     if (m_unitQuadListId != -1) {
@@ -285,8 +328,12 @@ void GLSLWaveformRendererSignal::draw(QPainter* painter, QPaintEvent* /*event*/)
     // do not remove currenCompletion temp variable !
     const int currentCompletion = waveform->getCompletion();
     if (m_textureRenderedWaveformCompletion < currentCompletion) {
-        loadTexture();
-        m_textureRenderedWaveformCompletion = currentCompletion;
+        if (m_textureId && m_textureRenderedWaveformCompletion > 0) {
+            // The texture has been allocated for this waveform
+            updateTexture(waveform, currentCompletion);
+        } else {
+            loadTexture();
+        }
     }
 
     // Per-band gain from the EQ knobs.
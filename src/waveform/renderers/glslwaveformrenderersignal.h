@@ -5,6 +5,7 @@
 
 #include "track/track_decl.h"
 #include "util/memory.h"
+#include "waveform/waveform.h"
 #include "waveform/renderers/waveformrenderersignalbase.h"
 
 QT_FORWARD_DECLARE_CLASS(QGLFramebufferObject)
@@ -36,6 +37,9 @@ class GLSLWaveformRendererSignal : public QObject,
     void debugClick();
     bool loadShaders();
     bool loadTexture();
+    // Uploads only the part of the waveform that has been analyzed
+    // since the texture has been loaded or updated
+    void updateTexture(const ConstWaveformPointer& waveform, int completion);
 
   public slots:
     void slotWaveformUpdated();
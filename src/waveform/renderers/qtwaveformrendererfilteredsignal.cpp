@@ -281,7 +281,8 @@ void QtWaveformRendererFilteredSignal::draw(QPainter* painter, QPaintEvent* /*ev
 
     PainterScope PainterScope(painter);
 
-    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setRenderHint(QPainter::Antialiasing,
+            WaveformWidgetFactory::instance()->getQualityController().useAntialiasing());
     painter->resetTransform();
 
     // Rotate if drawing vertical waveforms
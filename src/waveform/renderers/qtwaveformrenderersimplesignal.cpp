@@ -61,7 +61,8 @@ void QtWaveformRendererSimpleSignal::draw(QPainter* painter, QPaintEvent* /*even
 
     PainterScope PainterScope(painter);
 
-    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setRenderHint(QPainter::Antialiasing,
+            WaveformWidgetFactory::instance()->getQualityController().useAntialiasing());
     painter->resetTransform();
 
     // Rotate if drawing vertical waveforms
@@ -1,18 +1,23 @@
 #include <QDomNode>
 #include <QPaintEvent>
 #include <QPainter>
+#include <algorithm>
 
 #include "waveform/renderers/waveformrenderbeat.h"
 
 #include "control/controlobject.h"
+#include "moc_waveformrenderbeat.cpp"
 #include "track/track.h"
 #include "waveform/renderers/waveformwidgetrenderer.h"
+#include "waveform/waveformwidgetfactory.h"
 #include "widget/wskincolor.h"
 #include "widget/wwidget.h"
 #include "util/painterscope.h"
 
 WaveformRenderBeat::WaveformRenderBeat(WaveformWidgetRenderer* waveformWidgetRenderer)
-        : WaveformRendererAbstract(waveformWidgetRenderer) {
+        : WaveformRendererAbstract(waveformWidgetRenderer),
+          m_beatPositionsStart(0.0),
+          m_beatPositionsEnd(0.0) {
     m_beats.resize(128);
 }
 
@@ -24,14 +29,61 @@ void WaveformRenderBeat::setup(const QDomNode& node, const SkinContext& context)
     m_beatColor = WSkinColor::getCorrectColor(m_beatColor).toRgb();
 }
 
-void WaveformRenderBeat::draw(QPainter* painter, QPaintEvent* /*event*/) {
+void WaveformRenderBeat::onSetTrack() {
+    slotBeatsUpdated();
+
     TrackPointer trackInfo = m_waveformRenderer->getTrackInfo();
+    if (!trackInfo) {
+        return;
+    }
+    connect(trackInfo.get(),
+            &Track::beatsUpdated,
+            this,
+            &WaveformRenderBeat::slotBeatsUpdated);
+}
 
+void WaveformRenderBeat::slotBeatsUpdated() {
+    TrackPointer trackInfo = m_waveformRenderer->getTrackInfo();
     if (!trackInfo) {
+        m_pBeats.reset();
         return;
     }
+    m_pBeats = trackInfo->getBeats();
+}
 
-    mixxx::BeatsPointer trackBeats = trackInfo->getBeats();
+void WaveformRenderBeat::updateBeatPositions(
+        const mixxx::BeatsPointer& pBeats,
+        double startSamplePosition,
+        double endSamplePosition) {
+    if (pBeats == m_pBeatPositionsBeats &&
+            startSamplePosition >= m_beatPositionsStart &&
+            endSamplePosition <= m_beatPositionsEnd) {
+        return;
+    }
+    // Cover the displayed range on both sides, i.e. the positions only
+    // need to be looked up again after scrolling by a whole width
+    const double margin = endSamplePosition - startSamplePosition;
+    m_pBeatPositionsBeats = pBeats;
+    m_beatPositionsStart = startSamplePosition - margin;
+    m_beatPositionsEnd = endSamplePosition + margin;
+    m_beatPositions.clear();
+    const auto endPosition = mixxx::audio::FramePos::fromEngineSamplePos(
+            m_beatPositionsEnd);
+    for (auto it = pBeats->iteratorFrom(
+                 mixxx::audio::FramePos::fromEngineSamplePos(m_beatPositionsStart));
+            it != pBeats->cend() && *it <= endPosition;
+            ++it) {
+        m_beatPositions.push_back(it->toEngineSamplePos());
+    }
+}
+
+void WaveformRenderBeat::draw(QPainter* painter, QPaintEvent* /*event*/) {
+    if (!m_waveformRenderer->getTrackInfo()) {
+        return;
+    }
+
+    // Beats are immutable and the pointer is only replaced on the GUI thread
+    const mixxx::BeatsPointer trackBeats = m_pBeats;
     if (!trackBeats) {
         return;
     }
@@ -56,20 +108,22 @@ void WaveformRenderBeat::draw(QPainter* painter, QPaintEvent* /*event*/) {
     //          << "firstDisplayedPosition" << firstDisplayedPosition
     //          << "lastDisplayedPosition" << lastDisplayedPosition;
 
-    const auto startPosition = mixxx::audio::FramePos::fromEngineSamplePos(
-            firstDisplayedPosition * trackSamples);
-    const auto endPosition = mixxx::audio::FramePos::fromEngineSamplePos(
-            lastDisplayedPosition * trackSamples);
-    auto it = trackBeats->iteratorFrom(startPosition);
+    const double startSamplePosition = firstDisplayedPosition * trackSamples;
+    const double endSamplePosition = lastDisplayedPosition * trackSamples;
+    updateBeatPositions(trackBeats, startSamplePosition, endSamplePosition);
+    auto it = std::lower_bound(m_beatPositions.cbegin(),
+            m_beatPositions.cend(),
+            startSamplePosition);
 
     // if no beat do not waste time saving/restoring painter
-    if (it == trackBeats->cend() || *it > endPosition) {
+    if (it == m_beatPositions.cend() || *it > endSamplePosition) {
         return;
     }
 
     PainterScope PainterScope(painter);
 
-    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setRenderHint(QPainter::Antialiasing,
+            WaveformWidgetFactory::instance()->getQualityController().useAntialiasing());
 
     QPen beatPen(m_beatColor);
     beatPen.setWidthF(std::max(1.0, scaleFactor()));
@@ -81,8 +135,8 @@ void WaveformRenderBeat::draw(QPainter* painter, QPaintEvent* /*event*/) {
 
     int beatCount = 0;
 
-    for (; it != trackBeats->cend() && *it <= endPosition; ++it) {
-        double beatPosition = it->toEngineSamplePos();
+    for (; it != m_beatPositions.cend() && *it <= endSamplePosition; ++it) {
+        double beatPosition = *it;
         double xBeatPoint =
                 m_waveformRenderer->transformSamplePositionInRendererWorld(beatPosition);
 
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <QColor>
+#include <QObject>
+#include <vector>
 
 #include "skin/legacy/skincontext.h"
+#include "track/beats.h"
 #include "util/class.h"
 #include "waveform/renderers/waveformrendererabstract.h"
 
-class WaveformRenderBeat : public WaveformRendererAbstract {
+class WaveformRenderBeat : public QObject, public WaveformRendererAbstract {
+    Q_OBJECT
   public:
     explicit WaveformRenderBeat(WaveformWidgetRenderer* waveformWidgetRenderer);
     virtual ~WaveformRenderBeat();
@@ -14,9 +18,34 @@ class WaveformRenderBeat : public WaveformRendererAbstract {
     virtual void setup(const QDomNode& node, const SkinContext& context);
     virtual void draw(QPainter* painter, QPaintEvent* event);
 
+    // Called when a new track is loaded.
+    void onSetTrack() override;
+
+  public slots:
+    // Called when the beats of the loaded track have changed and when a
+    // new track is loaded.
+    void slotBeatsUpdated();
+
   private:
+    // Looks up the beats around the displayed range unless they have
+    // already been looked up for the previous frames
+    void updateBeatPositions(
+            const mixxx::BeatsPointer& pBeats,
+            double startSamplePosition,
+            double endSamplePosition);
+
+    // Snapshot of the beat grid that is drawn, i.e. the track doesn't
+    // need to be locked for every frame
+    mixxx::BeatsPointer m_pBeats;
     QColor m_beatColor;
     QVector<QLineF> m_beats;
 
+    // Engine sample positions of the beats between m_beatPositionsStart
+    // and m_beatPositionsEnd
+    std::vector<double> m_beatPositions;
+    mixxx::BeatsPointer m_pBeatPositionsBeats;
+    double m_beatPositionsStart;
+    double m_beatPositionsEnd;
+
     DISALLOW_COPY_AND_ASSIGN(WaveformRenderBeat);
 };
@@ -33,12 +33,27 @@ void WaveformRendererHSV::draw(QPainter* painter,
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    if (waveform->getDataSize() <= 1) {
+        return;
+    }
+
+    // When zoomed out each pixel covers many visual frames. The decimated
+    // data of a lower resolution level contains at most 2 frames per pixel.
+    const double visualFramesPerPixel =
+            (m_waveformRenderer->getLastDisplayedPosition() -
+                    m_waveformRenderer->getFirstDisplayedPosition()) *
+            waveform->getDataSize() / 2.0 / m_waveformRenderer->getLength();
+    // Draw less detail while the frame budget is exceeded
+    const double resolutionDivisor =
+            WaveformWidgetFactory::instance()->getQualityController().resolutionDivisor();
+    const int mipLevel = waveform->getMipLevelForVisualFramesPerPixel(
+            visualFramesPerPixel * resolutionDivisor);
+    const int dataSize = waveform->getMipLevelDataSize(mipLevel);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getMipLevelData(mipLevel);
     if (data == nullptr) {
         return;
     }
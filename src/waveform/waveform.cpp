@@ -1,12 +1,83 @@
+#include "waveform/waveform.h"
+
+#include <QDataStream>
 #include <QtDebug>
 
-#include "waveform/waveform.h"
 #include "proto/waveform.pb.h"
+#include "util/assert.h"
+#include "util/math.h"
+#include "util/metrics.h"
 
 using namespace mixxx::track;
 
 constexpr int kNumChannels = 2;
 
+// Levels with fewer frames would only be used by waveforms that are
+// zoomed out far beyond the length of a track
+constexpr int kMinMipLevelFrames = 256;
+
+constexpr int kMaxMipLevels = 16;
+
+// Waveforms that have been stored in the chunked format start with these
+// bytes. Protobuf messages of the legacy format start with the tag of the
+// visual_sample_rate field.
+const QByteArray kChunkedFormatMagic = QByteArrayLiteral("MXWF");
+
+constexpr quint8 kChunkedFormatVersion = 1;
+
+// About 18 s of the main waveform
+constexpr int kChunkSize = 16 * 1024;
+
+namespace {
+
+// Each chunk is compressed separately to be decoded independently. The
+// bands are stored as separate planes with the differences between
+// subsequent values of the same channel, which compresses far better
+// than the absolute values.
+QByteArray encodeChunk(const WaveformData* pData, int size) {
+    QByteArray planes(4 * size, '\0');
+    char* pLow = planes.data();
+    char* pMid = pLow + size;
+    char* pHigh = pMid + size;
+    char* pAll = pHigh + size;
+    WaveformData previous[kNumChannels] = {WaveformData(0), WaveformData(0)};
+    for (int i = 0; i < size; ++i) {
+        const WaveformData& datum = pData[i];
+        WaveformData& previousDatum = previous[i % kNumChannels];
+        pLow[i] = static_cast<char>(datum.filtered.low - previousDatum.filtered.low);
+        pMid[i] = static_cast<char>(datum.filtered.mid - previousDatum.filtered.mid);
+        pHigh[i] = static_cast<char>(datum.filtered.high - previousDatum.filtered.high);
+        pAll[i] = static_cast<char>(datum.filtered.all - previousDatum.filtered.all);
+        previousDatum = datum;
+    }
+    return qCompress(planes);
+}
+
+bool decodeChunk(const QByteArray& chunk, WaveformData* pData, int size) {
+    const QByteArray planes = qUncompress(chunk);
+    if (planes.size() != 4 * size) {
+        return false;
+    }
+    const char* pLow = planes.constData();
+    const char* pMid = pLow + size;
+    const char* pHigh = pMid + size;
+    const char* pAll = pHigh + size;
+    WaveformData previous[kNumChannels] = {WaveformData(0), WaveformData(0)};
+    for (int i = 0; i < size; ++i) {
+        WaveformData& previousDatum = previous[i % kNumChannels];
+        WaveformData datum;
+        datum.filtered.low = static_cast<unsigned char>(previousDatum.filtered.low + pLow[i]);
+        datum.filtered.mid = static_cast<unsigned char>(previousDatum.filtered.mid + pMid[i]);
+        datum.filtered.high = static_cast<unsigned char>(previousDatum.filtered.high + pHigh[i]);
+        datum.filtered.all = static_cast<unsigned char>(previousDatum.filtered.all + pAll[i]);
+        pData[i] = datum;
+        previousDatum = datum;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
 // Return the smallest power of 2 which is greater than the desired size when
 // squared.
 int computeTextureStride(int size) {
@@ -17,15 +88,24 @@ int computeTextureStride(int size) {
     return stride;
 }
 
-Waveform::Waveform(const QByteArray& data)
+Waveform::Waveform(const QByteArray& data, Decoding decoding)
         : m_id(-1),
           m_saveState(SaveState::NotSaved),
           m_dataSize(0),
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(computeTextureStride(0)),
+          m_chunkSize(0),
+          m_accountedBytes(0),
           m_completion(-1) {
-    readByteArray(data);
+    if (data.startsWith(kChunkedFormatMagic)) {
+        readChunkedByteArray(data);
+        if (decoding == Decoding::Immediate) {
+            decodeDeferredChunks();
+        }
+    } else {
+        readByteArray(data);
+    }
 }
 
 Waveform::Waveform(int audioSampleRate, int audioSamples,
@@ -36,6 +116,8 @@ Waveform::Waveform(int audioSampleRate, int audioSamples,
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(1024),
+          m_chunkSize(0),
+          m_accountedBytes(0),
           m_completion(-1) {
     int numberOfVisualSamples = 0;
     if (audioSampleRate > 0) {
@@ -65,65 +147,111 @@ Waveform::Waveform(int audioSampleRate, int audioSamples,
 }
 
 Waveform::~Waveform() {
+    mixxx::metrics::waveformBytes.add(-m_accountedBytes);
 }
 
-QByteArray Waveform::toByteArray() const {
-    io::Waveform waveform;
-    waveform.set_visual_sample_rate(m_visualSampleRate);
-    waveform.set_audio_visual_ratio(m_audioVisualRatio);
-
-    io::Waveform::Signal* all = waveform.mutable_signal_all();
-    io::Waveform::FilteredSignal* filtered = waveform.mutable_signal_filtered();
-    // TODO(rryan) get the actual cutoff values from analyzerwaveform.cpp so
-    // that if they change we don't have to remember to update these.
-
-    // Frequency cutoffs for butterworth filters:
-    // filtered->set_low_cutoff_frequency(200);
-    // filtered->set_mid_low_cutoff_frequency(200);
-    // filtered->set_mid_high_cutoff_frequency(2000);
-    // filtered->set_high_cutoff_frequency(2000);
-
-    // Frequency cutoff for bessel_lowpass4
-    filtered->set_low_cutoff_frequency(600);
-    // Frequency cutoff for bessel_bandpass
-    filtered->set_mid_low_cutoff_frequency(600);
-    filtered->set_mid_high_cutoff_frequency(4000);
-    // Frequency cutoff for bessel_highpass4
-    filtered->set_high_cutoff_frequency(4000);
-
-    io::Waveform::Signal* low = filtered->mutable_low();
-    io::Waveform::Signal* mid = filtered->mutable_mid();
-    io::Waveform::Signal* high = filtered->mutable_high();
-
-    // TODO(vrince) set max/min for each signal
-    int numChannels = kNumChannels;
-    all->set_units(io::Waveform::RMS);
-    all->set_channels(numChannels);
-    low->set_units(io::Waveform::RMS);
-    low->set_channels(numChannels);
-    mid->set_units(io::Waveform::RMS);
-    mid->set_channels(numChannels);
-    high->set_units(io::Waveform::RMS);
-    high->set_channels(numChannels);
+void Waveform::updateAccountedBytes() {
+    qint64 bytes = static_cast<qint64>(m_data.capacity() * sizeof(WaveformData));
+    for (const auto& level : m_mipLevels) {
+        bytes += static_cast<qint64>(level.data.capacity() * sizeof(WaveformData));
+    }
+    for (const auto& encodedChunk : qAsConst(m_encodedChunks)) {
+        bytes += encodedChunk.size();
+    }
+    mixxx::metrics::waveformBytes.add(bytes - m_accountedBytes);
+    m_accountedBytes = bytes;
+}
 
-    int dataSize = getDataSize();
-    for (int i = 0; i < dataSize; ++i) {
-        const WaveformData& datum = m_data.at(i);
-        all->add_value(datum.filtered.all);
-        low->add_value(datum.filtered.low);
-        mid->add_value(datum.filtered.mid);
-        high->add_value(datum.filtered.high);
+QByteArray Waveform::toByteArray() const {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream.writeRawData(kChunkedFormatMagic.constData(), kChunkedFormatMagic.size());
+    const int dataSize = getDataSize();
+    const int chunkCount = (dataSize + kChunkSize - 1) / kChunkSize;
+    stream << kChunkedFormatVersion
+           << m_visualSampleRate
+           << m_audioVisualRatio
+           << static_cast<qint32>(dataSize)
+           << static_cast<qint32>(kChunkSize)
+           << static_cast<qint32>(chunkCount);
+    for (int chunk = 0; chunk < chunkCount; ++chunk) {
+        const int first = chunk * kChunkSize;
+        const int size = math_min(kChunkSize, dataSize - first);
+        stream << encodeChunk(&m_data[first], size);
     }
 
-    qDebug() << "Writing waveform from byte array:"
+    qDebug() << "Writing waveform to byte array:"
              << "dataSize" << dataSize
-             << "allSignalSize" << all->value_size()
-             << "visualSampleRate" << waveform.visual_sample_rate()
-             << "audioVisualRatio" << waveform.audio_visual_ratio();
+             << "chunkCount" << chunkCount
+             << "byteSize" << data.size()
+             << "visualSampleRate" << m_visualSampleRate
+             << "audioVisualRatio" << m_audioVisualRatio;
+    return data;
+}
 
-    std::string output;
-    waveform.SerializeToString(&output);
-    return QByteArray(output.data(), static_cast<int>(output.length()));
+void Waveform::readChunkedByteArray(const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream.skipRawData(kChunkedFormatMagic.size());
+    quint8 formatVersion = 0;
+    double visualSampleRate = 0;
+    double audioVisualRatio = 0;
+    qint32 dataSize = 0;
+    qint32 chunkSize = 0;
+    qint32 chunkCount = 0;
+    stream >> formatVersion
+            >> visualSampleRate
+            >> audioVisualRatio
+            >> dataSize
+            >> chunkSize
+            >> chunkCount;
+    if (stream.status() != QDataStream::Ok ||
+            formatVersion != kChunkedFormatVersion ||
+            dataSize < 0 || chunkSize <= 0 ||
+            chunkCount != (dataSize + chunkSize - 1) / chunkSize) {
+        qDebug() << "ERROR: Could not read Waveform header from QByteArray of size"
+                 << data.size();
+        return;
+    }
+    QVector<QByteArray> encodedChunks;
+    encodedChunks.reserve(chunkCount);
+    for (int chunk = 0; chunk < chunkCount; ++chunk) {
+        QByteArray encodedChunk;
+        stream >> encodedChunk;
+        encodedChunks.append(std::move(encodedChunk));
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qDebug() << "ERROR: Could not read Waveform chunks from QByteArray of size"
+                 << data.size();
+        return;
+    }
+
+    resize(dataSize);
+    m_visualSampleRate = visualSampleRate;
+    m_audioVisualRatio = audioVisualRatio;
+    m_chunkSize = chunkSize;
+    m_encodedChunks = std::move(encodedChunks);
+    updateAccountedBytes();
+    setCompletion(0);
+    m_saveState = SaveState::Saved;
+}
+
+void Waveform::decodeDeferredChunks() {
+    const int dataSize = getDataSize();
+    for (int chunk = 0; chunk < m_encodedChunks.size(); ++chunk) {
+        const int first = chunk * m_chunkSize;
+        const int size = math_min(m_chunkSize, dataSize - first);
+        if (!decodeChunk(m_encodedChunks[chunk], &m_data[first], size)) {
+            qDebug() << "ERROR: Could not decode Waveform chunk" << chunk;
+            // Keep the completion of the previous chunks
+            break;
+        }
+        // Renderers already display the decoded part
+        setCompletion(first + size);
+    }
+    m_encodedChunks.clear();
+    updateAccountedBytes();
 }
 
 void Waveform::readByteArray(const QByteArray& data) {
@@ -193,7 +321,7 @@ void Waveform::readByteArray(const QByteArray& data) {
         m_data[i].filtered.mid = use_mid ? static_cast<unsigned char>(mid.value(i)) : 0;
         m_data[i].filtered.high = use_high ? static_cast<unsigned char>(high.value(i)) : 0;
     }
-    m_completion = dataSize;
+    setCompletion(dataSize);
     m_saveState = SaveState::Saved;
 }
 
@@ -201,15 +329,96 @@ void Waveform::resize(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.resize(m_textureStride * m_textureStride);
+    allocateMipLevels();
 }
 
 void Waveform::assign(int size, int value) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.assign(m_textureStride * m_textureStride, value);
+    allocateMipLevels();
     m_saveState = SaveState::SavePending;
 }
 
+void Waveform::allocateMipLevels() {
+    m_mipLevels.clear();
+    int frames = m_dataSize / kNumChannels;
+    while (frames > kMinMipLevelFrames &&
+            static_cast<int>(m_mipLevels.size()) < kMaxMipLevels) {
+        frames = (frames + 1) / 2;
+        MipLevel level;
+        level.data.assign(frames * kNumChannels, WaveformData(0));
+        level.completedFrames = 0;
+        m_mipLevels.push_back(std::move(level));
+    }
+    updateAccountedBytes();
+}
+
+void Waveform::setCompletion(int completion) {
+    // Readers must not see a completion before the levels have been updated
+    updateMipLevels(completion);
+    m_completion.storeRelease(completion);
+}
+
+void Waveform::updateMipLevels(int completion) {
+    const WaveformData* pSourceData = m_data.data();
+    // Frames of the source level that will not change anymore...
+    int sourceCompletedFrames =
+            math_clamp(completion, 0, m_dataSize) / kNumChannels;
+    // ...and frames that contain any data, including an incomplete
+    // last frame of the previous level
+    int sourceFrames = sourceCompletedFrames;
+    for (auto& level : m_mipLevels) {
+        const int levelFrames = static_cast<int>(level.data.size()) / kNumChannels;
+        const int lastFrame = math_min((sourceFrames + 1) / 2, levelFrames);
+        for (int frame = level.completedFrames; frame < lastFrame; ++frame) {
+            const int sourceFrame = frame * 2;
+            for (int channel = 0; channel < kNumChannels; ++channel) {
+                WaveformData datum = pSourceData[sourceFrame * kNumChannels + channel];
+                if (sourceFrame + 1 < sourceFrames) {
+                    const WaveformData& next =
+                            pSourceData[(sourceFrame + 1) * kNumChannels + channel];
+                    datum.filtered.low = math_max(datum.filtered.low, next.filtered.low);
+                    datum.filtered.mid = math_max(datum.filtered.mid, next.filtered.mid);
+                    datum.filtered.high = math_max(datum.filtered.high, next.filtered.high);
+                    datum.filtered.all = math_max(datum.filtered.all, next.filtered.all);
+                }
+                level.data[frame * kNumChannels + channel] = datum;
+            }
+        }
+        level.completedFrames = sourceCompletedFrames / 2;
+        pSourceData = level.data.data();
+        sourceCompletedFrames = level.completedFrames;
+        sourceFrames = lastFrame;
+    }
+}
+
+int Waveform::getMipLevelForVisualFramesPerPixel(double visualFramesPerPixel) const {
+    int level = 0;
+    while (level < static_cast<int>(m_mipLevels.size()) &&
+            visualFramesPerPixel >= 2.0) {
+        visualFramesPerPixel /= 2.0;
+        ++level;
+    }
+    return level;
+}
+
+int Waveform::getMipLevelDataSize(int level) const {
+    DEBUG_ASSERT(level >= 0 && level < getMipLevelCount());
+    if (level == 0) {
+        return m_dataSize;
+    }
+    return static_cast<int>(m_mipLevels[level - 1].data.size());
+}
+
+const WaveformData* Waveform::getMipLevelData(int level) const {
+    DEBUG_ASSERT(level >= 0 && level < getMipLevelCount());
+    if (level == 0) {
+        return data();
+    }
+    return m_mipLevels[level - 1].data.data();
+}
+
 void Waveform::dump() const {
     qDebug() << "Waveform" << this
              << "size("+QString::number(getDataSize())+")"
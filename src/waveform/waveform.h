@@ -5,6 +5,7 @@
 #include <QMutex>
 #include <QSharedPointer>
 #include <QString>
+#include <QVector>
 #include <vector>
 
 #include "util/class.h"
@@ -34,7 +35,16 @@ class Waveform {
         Saved
     };
 
-    explicit Waveform(const QByteArray& pData = QByteArray());
+    enum class Decoding {
+        Immediate,
+        // Only the header is decoded by the constructor. The data is decoded
+        // by decodeDeferredChunks(), e.g. after the waveform has already been
+        // set for a track.
+        Deferred,
+    };
+
+    explicit Waveform(const QByteArray& pData = QByteArray(),
+            Decoding decoding = Decoding::Immediate);
     Waveform(int audioSampleRate, int audioSamples,
              int desiredVisualSampleRate, int maxVisualSamples);
 
@@ -70,8 +80,14 @@ class Waveform {
         m_description = description;
     }
 
+    // Stores the data in a chunked format. The legacy protobuf format
+    // can still be read.
     QByteArray toByteArray() const;
 
+    // Decodes the chunks that are pending after constructing the waveform
+    // with deferred decoding. The completion is updated after each chunk.
+    void decodeDeferredChunks();
+
     // We do not lock the mutex since m_dataSize and m_visualSampleRate are not
     // changed after the constructor runs.
     bool isValid() const {
@@ -99,9 +115,8 @@ class Waveform {
     int getCompletion() const {
         return m_completion.loadAcquire();
     }
-    void setCompletion(int completion) {
-        m_completion = completion;
-    }
+    // Also updates the decimated data up to the new completion
+    void setCompletion(int completion);
 
     // We do not lock the mutex since m_textureStride is not changed after
     // the constructor runs.
@@ -130,12 +145,35 @@ class Waveform {
     // constructor runs.
     const WaveformData* data() const { return &m_data[0];}
 
+    // The data is also available at lower resolutions that are decimated
+    // by powers of 2, i.e. each visual frame of a level contains the maximum
+    // of each band over 2, 4, 8, ... frames of the full resolution data.
+    // Level 0 is the full resolution data. Zoomed out renderers read from
+    // a level with about one frame per pixel instead of reducing all data
+    // points of each pixel.
+    //
+    // We do not lock the mutex since the levels are not resized after the
+    // constructor runs.
+    int getMipLevelCount() const {
+        return static_cast<int>(m_mipLevels.size()) + 1;
+    }
+    // Returns the lowest resolution level with at least one visual frame
+    // per pixel
+    int getMipLevelForVisualFramesPerPixel(double visualFramesPerPixel) const;
+    int getMipLevelDataSize(int level) const;
+    const WaveformData* getMipLevelData(int level) const;
+
     void dump() const;
 
   private:
     void readByteArray(const QByteArray& data);
+    void readChunkedByteArray(const QByteArray& data);
     void resize(int size);
     void assign(int size, int value = 0);
+    void allocateMipLevels();
+    void updateMipLevels(int completion);
+    // Updates waveformBytes after the size of the data has changed
+    void updateAccountedBytes();
 
     inline WaveformData& at(int i) { return m_data[i];}
     inline unsigned char& low(int i) { return m_data[i].filtered.low;}
@@ -171,6 +209,23 @@ class Waveform {
     // stride is N. Not allowed to change after the constructor runs.
     int m_textureStride;
 
+    struct MipLevel {
+        // Interleaved channels like m_data
+        std::vector<WaveformData> data;
+        // The last frame might need to be updated when more data has been
+        // analyzed. Only accessed by the thread that sets the completion.
+        int completedFrames;
+    };
+    // Not allowed to be resized after the constructor runs.
+    std::vector<MipLevel> m_mipLevels;
+
+    // Encoded data that has not been decoded yet
+    QVector<QByteArray> m_encodedChunks;
+    int m_chunkSize;
+
+    // The bytes of all data that are accounted in waveformBytes
+    qint64 m_accountedBytes;
+
     // For performance, completion is shared as a QAtomicInt and does not lock
     // the mutex. The completion of the waveform calculation.
     QAtomicInt m_completion;
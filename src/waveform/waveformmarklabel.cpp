@@ -14,7 +14,25 @@ void WaveformMarkLabel::prerender(QPointF bottomLeft,
         return;
     }
 
+    if (!m_pixmap.isNull() &&
+            text == m_text &&
+            icon.cacheKey() == m_icon.cacheKey() &&
+            font == m_font &&
+            textColor == m_textColor &&
+            backgroundColor == m_backgroundColor &&
+            widgetWidth == m_widgetWidth &&
+            scaleFactor == m_scaleFactor) {
+        moveArea(bottomLeft, widgetWidth);
+        return;
+    }
+
     m_text = text;
+    m_icon = icon;
+    m_font = font;
+    m_textColor = textColor;
+    m_backgroundColor = backgroundColor;
+    m_widgetWidth = widgetWidth;
+    m_scaleFactor = scaleFactor;
     QFontMetrics fontMetrics(font);
     constexpr int padding = 2;
 
@@ -38,14 +56,8 @@ void WaveformMarkLabel::prerender(QPointF bottomLeft,
 
     // pixmapRect has a top left of (0,0) for rendering to m_pixmap.
     // m_areaRect is the same size but shifted to the coordinates of the widget.
-    m_areaRect = pixmapRect;
-    QPointF topLeft = QPointF(bottomLeft.x(),
-            bottomLeft.y() - pixmapRect.height());
-    m_areaRect.moveTo(topLeft);
-
-    if (m_areaRect.right() > widgetWidth) {
-        m_areaRect.setLeft(widgetWidth - m_areaRect.width());
-    }
+    m_pixmapSize = pixmapRect.size();
+    moveArea(bottomLeft, widgetWidth);
 
     m_pixmap = QPixmap(static_cast<int>(pixmapRect.width() * scaleFactor),
             static_cast<int>(pixmapRect.height() * scaleFactor));
@@ -74,6 +86,16 @@ void WaveformMarkLabel::prerender(QPointF bottomLeft,
     }
 };
 
+void WaveformMarkLabel::moveArea(QPointF bottomLeft, float widgetWidth) {
+    QPointF topLeft = QPointF(bottomLeft.x(),
+            bottomLeft.y() - m_pixmapSize.height());
+    m_areaRect = QRectF(topLeft, m_pixmapSize);
+
+    if (m_areaRect.right() > widgetWidth) {
+        m_areaRect.setLeft(widgetWidth - m_areaRect.width());
+    }
+}
+
 void WaveformMarkLabel::draw(QPainter* pPainter) {
     pPainter->drawPixmap(m_areaRect.topLeft(), m_pixmap);
 }
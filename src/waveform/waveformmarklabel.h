@@ -15,7 +15,8 @@ class WaveformMarkLabel {
   public:
     WaveformMarkLabel() {};
 
-    // Render the label to an internal QPixmap buffer
+    // Render the label to an internal QPixmap buffer. The buffer is reused
+    // if only the position of the label has changed.
     void prerender(QPointF bottomLeft,
             const QPixmap& icon,
             QString text,
@@ -46,17 +47,24 @@ class WaveformMarkLabel {
 
     void clear() {
         m_text = QString();
+        m_icon = QPixmap();
         m_pixmap = QPixmap();
+        m_pixmapSize = QSizeF();
         m_areaRect = QRectF();
     }
 
   private:
+    void moveArea(QPointF bottomLeft, float widgetWidth);
+
     QPixmap m_icon;
     QString m_text;
     QFont m_font;
     QColor m_textColor;
     QColor m_backgroundColor;
+    float m_widgetWidth = 0;
+    double m_scaleFactor = 0;
 
     QPixmap m_pixmap;
+    QSizeF m_pixmapSize;
     QRectF m_areaRect;
 };
@@ -0,0 +1,83 @@
+#include "waveform/waveformqualitycontroller.h"
+
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("WaveformQualityController");
+
+// Fractions of the frame budget
+constexpr double kOverloadedRenderTime = 0.8;
+constexpr double kHeadroomRenderTime = 0.4;
+
+// Fractions of the audio buffer duration
+constexpr double kOverloadedAudioLatencyUsage = 0.6;
+constexpr double kHeadroomAudioLatencyUsage = 0.4;
+
+// Reduce the quality quickly, but restore it slowly to avoid switching
+// back and forth
+constexpr int kOverloadedFramesToReduce = 10;
+constexpr int kHeadroomFramesToRestore = 180;
+
+} // anonymous namespace
+
+WaveformQualityController::WaveformQualityController()
+        : m_enabled(true),
+          m_reduction(0),
+          m_overloadedFrames(0),
+          m_headroomFrames(0) {
+}
+
+void WaveformQualityController::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!m_enabled) {
+        m_reduction = 0;
+        m_overloadedFrames = 0;
+        m_headroomFrames = 0;
+    }
+}
+
+bool WaveformQualityController::process(
+        mixxx::Duration renderTime,
+        mixxx::Duration frameBudget,
+        double audioLatencyUsage) {
+    if (!m_enabled || frameBudget <= mixxx::Duration::empty()) {
+        return false;
+    }
+    const double renderTimeRatio = renderTime.toDoubleSeconds() /
+            frameBudget.toDoubleSeconds();
+    if (renderTimeRatio > kOverloadedRenderTime ||
+            audioLatencyUsage > kOverloadedAudioLatencyUsage) {
+        m_headroomFrames = 0;
+        if (m_reduction < kMaxReduction &&
+                ++m_overloadedFrames >= kOverloadedFramesToReduce) {
+            m_overloadedFrames = 0;
+            ++m_reduction;
+            kLogger.info()
+                    << "Reducing the waveform quality to level"
+                    << m_reduction
+                    << "render time ratio:"
+                    << renderTimeRatio
+                    << "audio latency usage:"
+                    << audioLatencyUsage;
+            return true;
+        }
+        return false;
+    }
+    m_overloadedFrames = 0;
+    if (renderTimeRatio < kHeadroomRenderTime &&
+            audioLatencyUsage < kHeadroomAudioLatencyUsage) {
+        if (m_reduction > 0 &&
+                ++m_headroomFrames >= kHeadroomFramesToRestore) {
+            m_headroomFrames = 0;
+            --m_reduction;
+            kLogger.info()
+                    << "Restoring the waveform quality to level"
+                    << m_reduction;
+            return true;
+        }
+    } else {
+        m_headroomFrames = 0;
+    }
+    return false;
+}
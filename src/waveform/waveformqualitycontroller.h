@@ -0,0 +1,51 @@
+#pragma once
+
+#include "util/duration.h"
+
+/// Lowers the quality of the waveforms while rendering them takes too
+/// long for the frame budget or while the audio engine is busy, and
+/// restores it when there is enough headroom again.
+///
+/// The quality is reduced in steps. Renderers read the current step and
+/// draw less detail, e.g. by selecting a lower resolution mip level or by
+/// drawing without antialiasing.
+class WaveformQualityController {
+  public:
+    static constexpr int kMaxReduction = 3;
+
+    WaveformQualityController();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const {
+        return m_enabled;
+    }
+
+    /// Accounts for the time it took to render a frame and the fraction of
+    /// the audio buffer duration that has been used by the audio engine.
+    /// Returns true if the reduction has changed.
+    bool process(
+            mixxx::Duration renderTime,
+            mixxx::Duration frameBudget,
+            double audioLatencyUsage);
+
+    /// 0 for the full quality up to kMaxReduction
+    int reduction() const {
+        return m_reduction;
+    }
+
+    /// Factor of visual frames per pixel that renderers should assume when
+    /// selecting the resolution of the waveform
+    double resolutionDivisor() const {
+        return static_cast<double>(1 << m_reduction);
+    }
+
+    bool useAntialiasing() const {
+        return m_reduction == 0;
+    }
+
+  private:
+    bool m_enabled;
+    int m_reduction;
+    int m_overloadedFrames;
+    int m_headroomFrames;
+};
@@ -11,6 +11,7 @@
 #include <QtDebug>
 
 #include "control/controlpotmeter.h"
+#include "control/controlproxy.h"
 #include "moc_waveformwidgetfactory.cpp"
 #include "util/cmdlineargs.h"
 #include "util/math.h"
@@ -113,6 +114,7 @@ WaveformWidgetFactory::WaveformWidgetFactory()
           m_openGLShaderAvailable(false),
           m_beatGridAlpha(90),
           m_vsyncThread(nullptr),
+          m_pAudioLatencyUsage(nullptr),
           m_pGuiTick(nullptr),
           m_pVisualsManager(nullptr),
           m_frameCnt(0),
@@ -341,6 +343,10 @@ bool WaveformWidgetFactory::setConfig(UserSettingsPointer config) {
             WaveformWidgetRenderer::s_defaultPlayMarkerPosition);
     setPlayMarkerPosition(m_playMarkerPosition);
 
+    bool adaptiveQuality = m_config->getValue(
+            ConfigKey("[Waveform]", "AdaptiveQuality"), isAdaptiveQuality());
+    setAdaptiveQuality(adaptiveQuality);
+
     return true;
 }
 
@@ -598,6 +604,13 @@ void WaveformWidgetFactory::setOverviewNormalized(bool normalize) {
     }
 }
 
+void WaveformWidgetFactory::setAdaptiveQuality(bool adaptive) {
+    m_qualityController.setEnabled(adaptive);
+    if (m_config) {
+        m_config->setValue(ConfigKey("[Waveform]", "AdaptiveQuality"), adaptive);
+    }
+}
+
 void WaveformWidgetFactory::setPlayMarkerPosition(double position) {
     //qDebug() << "setPlayMarkerPosition, position=" << position;
     m_playMarkerPosition = position;
@@ -635,6 +648,8 @@ void WaveformWidgetFactory::render() {
     //qDebug() << "render()" << m_vsyncThread->elapsed();
 
     if (!m_skipRender) {
+        PerformanceTimer renderTimer;
+        renderTimer.start();
         if (m_type) {   // no regular updates for an empty waveform
             // next rendered frame is displayed after next buffer swap and than after VSync
             QVarLengthArray<bool, 10> shouldRenderWaveforms(
@@ -669,6 +684,13 @@ void WaveformWidgetFactory::render() {
                 //qDebug() << "render" << i << m_vsyncThread->elapsed();
             }
         }
+        if (m_type) {
+            const double audioLatencyUsage =
+                    m_pAudioLatencyUsage ? m_pAudioLatencyUsage->get() : 0.0;
+            m_qualityController.process(renderTimer.elapsed(),
+                    mixxx::Duration::fromMicros(static_cast<qint64>(1e6 / m_frameRate)),
+                    audioLatencyUsage);
+        }
 
         // WSpinnys are also double-buffered QGLWidgets, like all the waveform
         // renderers. Render all the WSpinny widgets now.
@@ -1025,6 +1047,11 @@ int WaveformWidgetFactory::findIndexOf(WWaveformViewer* viewer) const {
 void WaveformWidgetFactory::startVSync(GuiTick* pGuiTick, VisualsManager* pVisualsManager) {
     m_pGuiTick = pGuiTick;
     m_pVisualsManager = pVisualsManager;
+    // The engine controls exist when the widgets are rendered
+    m_pAudioLatencyUsage = new ControlProxy(QStringLiteral("[Master]"),
+            QStringLiteral("audio_latency_usage"),
+            this,
+            ControlFlag::NoAssertIfMissing);
     m_vsyncThread = new VSyncThread(this);
     m_vsyncThread->setObjectName(QStringLiteral("VSync"));
     m_vsyncThread->setVSyncType(m_vSyncType);
@@ -9,8 +9,10 @@
 #include "util/performancetimer.h"
 #include "util/singleton.h"
 #include "waveform/waveform.h"
+#include "waveform/waveformqualitycontroller.h"
 #include "waveform/widgets/waveformwidgettype.h"
 
+class ControlProxy;
 class WVuMeter;
 class WWaveformViewer;
 class WaveformWidgetAbstract;
@@ -118,6 +120,14 @@ class WaveformWidgetFactory : public QObject, public Singleton<WaveformWidgetFac
     void setOverviewNormalized(bool normalize);
     int isOverviewNormalized() const { return m_overviewNormalized;}
 
+    void setAdaptiveQuality(bool adaptive);
+    bool isAdaptiveQuality() const {
+        return m_qualityController.isEnabled();
+    }
+    const WaveformQualityController& getQualityController() const {
+        return m_qualityController;
+    }
+
     const QVector<WaveformWidgetAbstractHandle> getAvailableTypes() const { return m_waveformWidgetHandles;}
     void getAvailableVSyncTypes(QList<QPair<int, QString>>* list);
     void destroyWidgets();
@@ -188,6 +198,8 @@ class WaveformWidgetFactory : public QObject, public Singleton<WaveformWidgetFac
     int m_beatGridAlpha;
 
     VSyncThread* m_vsyncThread;
+    ControlProxy* m_pAudioLatencyUsage;
+    WaveformQualityController m_qualityController;
     GuiTick* m_pGuiTick;  // not owned
     VisualsManager* m_pVisualsManager;  // not owned
 
@@ -5,6 +5,8 @@
 #include <QtDebug>
 
 #include "skin/legacy/imgloader.h"
+#include "skin/legacy/skinimagecache.h"
+#include "skin/legacy/skinresourcepreloader.h"
 
 #include "util/math.h"
 #include "util/memory.h"
@@ -52,22 +54,6 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
     if (!source.isSVG()) {
         m_pPixmap.reset(WPixmapStore::getPixmapNoCache(source.getPath(), scaleFactor));
     } else {
-        auto pSvg = std::make_unique<QSvgRenderer>();
-        if (!source.getSvgSourceData().isEmpty()) {
-            // Call here the different overload for svg content
-            if (!pSvg->load(source.getSvgSourceData())) {
-                // The above line already logs a warning
-                return;
-            }
-        } else if (!source.getPath().isEmpty()) {
-            if (!pSvg->load(source.getPath())) {
-                // The above line already logs a warning
-                return;
-            }
-        } else {
-            return;
-        }
-        m_pSvg.reset(pSvg.release());
 #ifdef __APPLE__
         // Apple does Retina scaling behind the scenes, so we also pass a
         // Paintable::FIXED image. On the other targets, it is better to
@@ -80,15 +66,35 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
 #endif
             // The SVG renderer doesn't directly support tiling, so we render
             // it to a pixmap which will then get tiled.
-            QImage copy_buffer(m_pSvg->defaultSize() * scaleFactor, QImage::Format_ARGB32);
-            copy_buffer.fill(0x00000000);  // Transparent black.
-            QPainter painter(&copy_buffer);
-            m_pSvg->render(&painter);
+            QImage copy_buffer = SkinImageCache::renderSvg(source, scaleFactor);
+            if (copy_buffer.isNull()) {
+                return;
+            }
             WPixmapStore::correctImageColors(&copy_buffer);
 
             m_pPixmap.reset(new QPixmap(copy_buffer.size()));
             m_pPixmap->convertFromImage(copy_buffer);
+            return;
         }
+
+        auto pSvg = std::make_unique<QSvgRenderer>();
+        if (!source.getSvgSourceData().isEmpty()) {
+            // Call here the different overload for svg content
+            if (!pSvg->load(source.getSvgSourceData())) {
+                // The above line already logs a warning
+                return;
+            }
+        } else if (!source.getPath().isEmpty()) {
+            // The file might have been read on a worker thread already
+            const QByteArray svgData = SkinResourcePreloader::svgData(source.getPath());
+            if (!(svgData.isEmpty() ? pSvg->load(source.getPath()) : pSvg->load(svgData))) {
+                // The above line already logs a warning
+                return;
+            }
+        } else {
+            return;
+        }
+        m_pSvg.reset(pSvg.release());
     }
 }
 
@@ -7,6 +7,7 @@
 #include <QPoint>
 
 #include "util/math.h"
+#include "util/widgetrepaintscheduler.h"
 
 template <class T>
 class SliderEventHandler {
@@ -163,10 +164,11 @@ class SliderEventHandler {
             // Check a second time for no-ops. It's possible the parameter changed
             // but the visible pixmap didn't. Only update() the widget if we're
             // really sure we need to since this involves painting ALL of its
-            // parents.
+            // parents. The update is deferred to the next frame, because
+            // controllers may move the slider many times per frame.
             if (newPos != m_dPos) {
                 m_dPos = newPos;
-                pWidget->update();
+                WidgetRepaintScheduler::scheduleUpdate(pWidget);
             }
         }
     }
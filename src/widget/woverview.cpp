@@ -63,6 +63,7 @@ WOverview::WOverview(
           m_pHoveredMark(nullptr),
           m_bTimeRulerActive(false),
           m_orientation(Qt::Horizontal),
+          m_waveformLayerImageKey(0),
           m_iLabelFontSize(10),
           m_a(1.0),
           m_b(0.0),
@@ -146,6 +147,7 @@ void WOverview::setup(const QDomNode& node, const SkinContext& context) {
                 context.makeSkinPath(m_backgroundPixmapPath),
                 m_scaleFactor);
     }
+    invalidateWaveformLayer();
 
     m_endOfTrackColor = QColor(200, 25, 20);
     const QString endOfTrackColorName = context.selectString(node, "EndOfTrackColor");
@@ -237,9 +239,6 @@ void WOverview::onConnectedControlChanged(double dParameter, double dValue) {
     bool redraw = false;
     int oldPos = m_iPlayPos;
     m_iPlayPos = valueToPosition(dParameter);
-    if (oldPos != m_iPlayPos) {
-        redraw = true;
-    }
 
     if (!m_bLeftClickDragging) {
         // if not dragged the pick-up moves with the play position
@@ -258,6 +257,8 @@ void WOverview::onConnectedControlChanged(double dParameter, double dValue) {
 
     if (redraw) {
         update();
+    } else if (oldPos != m_iPlayPos) {
+        updatePlayPosition(oldPos, m_iPlayPos);
     }
 }
 
@@ -330,6 +331,7 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
     m_pixmapDone = false;
     m_trackLoaded = false;
     m_endOfTrack = false;
+    invalidateWaveformLayer();
 
     if (pNewTrack) {
         m_pCurrentTrack = pNewTrack;
@@ -351,6 +353,7 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
 void WOverview::onEndOfTrackChange(double v) {
     //qDebug() << "WOverview::onEndOfTrackChange()" << v;
     m_endOfTrack = v > 0.0;
+    invalidateWaveformLayer();
     update();
 }
 
@@ -429,6 +432,19 @@ void WOverview::updateCues(const QList<CuePointer> &loadedCues) {
 
 // connecting the tracks cuesUpdated and onMarkChanged is not possible
 // due to the incompatible signatures. This is a "wrapper" workaround
+void WOverview::updatePlayPosition(int oldPosition, int newPosition) {
+    // The pickup position is drawn with triangles that are wider than
+    // the line
+    const int margin = 3 + static_cast<int>(std::ceil(m_scaleFactor));
+    const int start = std::min(oldPosition, newPosition) - margin;
+    const int end = std::max(oldPosition, newPosition) + margin;
+    if (m_orientation == Qt::Horizontal) {
+        update(start, 0, end - start + 1, height());
+    } else {
+        update(0, start, width(), end - start + 1);
+    }
+}
+
 void WOverview::receiveCuesUpdated() {
     onMarkChanged(0);
 }
@@ -591,18 +607,11 @@ void WOverview::paintEvent(QPaintEvent* pEvent) {
     ScopedTimer t("WOverview::paintEvent");
 
     QPainter painter(this);
-    painter.fillRect(rect(), m_backgroundColor);
-
-    if (!m_backgroundPixmap.isNull()) {
-        painter.drawPixmap(rect(), m_backgroundPixmap);
-    }
+    drawWaveformLayer(&painter);
 
     if (m_pCurrentTrack) {
         // Refer to util/ScopePainter.h to understand the semantics of
         // ScopePainter.
-        drawEndOfTrackBackground(&painter);
-        drawAxis(&painter);
-        drawWaveformPixmap(&painter);
         drawPlayedOverlay(&painter);
         drawPlayPosition(&painter);
         drawEndOfTrackFrame(&painter);
@@ -630,6 +639,38 @@ void WOverview::paintEvent(QPaintEvent* pEvent) {
     }
 }
 
+void WOverview::drawWaveformLayer(QPainter* pPainter) {
+    if (m_pCurrentTrack) {
+        updateWaveformImageScaled();
+    }
+    const qint64 imageKey = (m_pCurrentTrack && !m_waveformSourceImage.isNull())
+            ? m_waveformImageScaled.cacheKey()
+            : 0;
+    if (m_waveformLayer.isNull() || m_waveformLayerImageKey != imageKey) {
+        m_waveformLayer = QPixmap(size() * m_devicePixelRatio);
+        m_waveformLayer.setDevicePixelRatio(m_devicePixelRatio);
+        m_waveformLayer.fill(Qt::transparent);
+        QPainter painter(&m_waveformLayer);
+        painter.fillRect(rect(), m_backgroundColor);
+        if (!m_backgroundPixmap.isNull()) {
+            painter.drawPixmap(rect(), m_backgroundPixmap);
+        }
+        if (m_pCurrentTrack) {
+            drawEndOfTrackBackground(&painter);
+            drawAxis(&painter);
+            if (imageKey != 0) {
+                painter.drawImage(rect(), m_waveformImageScaled);
+            }
+        }
+        m_waveformLayerImageKey = imageKey;
+    }
+    pPainter->drawPixmap(rect(), m_waveformLayer);
+}
+
+void WOverview::invalidateWaveformLayer() {
+    m_waveformLayer = QPixmap();
+}
+
 void WOverview::drawEndOfTrackBackground(QPainter* pPainter) {
     if (m_endOfTrack) {
         PainterScope painterScope(pPainter);
@@ -649,10 +690,9 @@ void WOverview::drawAxis(QPainter* pPainter) {
     }
 }
 
-void WOverview::drawWaveformPixmap(QPainter* pPainter) {
+void WOverview::updateWaveformImageScaled() {
     WaveformWidgetFactory* widgetFactory = WaveformWidgetFactory::instance();
     if (!m_waveformSourceImage.isNull()) {
-        PainterScope painterScope(pPainter);
         float diffGain;
         bool normalize = widgetFactory->isOverviewNormalized();
         if (normalize && m_pixmapDone && m_waveformPeak > 1) {
@@ -679,8 +719,6 @@ void WOverview::drawWaveformPixmap(QPainter* pPainter) {
                     Qt::SmoothTransformation);
             m_diffGain = diffGain;
         }
-
-        pPainter->drawImage(rect(), m_waveformImageScaled);
     }
 }
 
@@ -1270,6 +1308,7 @@ void WOverview::resizeEvent(QResizeEvent* pEvent) {
 
     m_waveformImageScaled = QImage();
     m_diffGain = 0;
+    invalidateWaveformLayer();
     Init();
 }
 
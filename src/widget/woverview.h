@@ -108,9 +108,13 @@ class WOverview : public WWidget, public TrackDropTarget {
     // Append the waveform overview pixmap according to available data
     // in waveform
     virtual bool drawNextPixmapPart() = 0;
+    // Draws the cached layer with the parts that don't depend on the
+    // play position and rebuilds it if needed
+    void drawWaveformLayer(QPainter* pPainter);
+    void invalidateWaveformLayer();
     void drawEndOfTrackBackground(QPainter* pPainter);
     void drawAxis(QPainter* pPainter);
-    void drawWaveformPixmap(QPainter* pPainter);
+    void updateWaveformImageScaled();
     void drawPlayedOverlay(QPainter* pPainter);
     void drawPlayPosition(QPainter* pPainter);
     void drawEndOfTrackFrame(QPainter* pPainter);
@@ -131,6 +135,8 @@ class WOverview : public WWidget, public TrackDropTarget {
     }
 
     void updateCues(const QList<CuePointer> &loadedCues);
+    // Only repaints the columns around the old and the new play position
+    void updatePlayPosition(int oldPosition, int newPosition);
 
     const QString m_group;
     UserSettingsPointer m_pConfig;
@@ -167,6 +173,9 @@ class WOverview : public WWidget, public TrackDropTarget {
     Qt::Orientation m_orientation;
 
     QPixmap m_backgroundPixmap;
+    // Background, axis and the scaled waveform image
+    QPixmap m_waveformLayer;
+    qint64 m_waveformLayerImageKey;
     QString m_backgroundPixmapPath;
     QColor m_backgroundColor;
     int m_iLabelFontSize;
@@ -1,8 +1,9 @@
 #include "widget/wspinny.h"
 
 #include <QApplication>
+#include <QGLShaderProgram>
+#include <QMatrix4x4>
 #include <QMimeData>
-#include <QStylePainter>
 #include <QUrl>
 #include <QWindow>
 #include <QtDebug>
@@ -22,6 +23,30 @@
 #include "waveform/vsyncthread.h"
 #include "wimagestore.h"
 
+namespace {
+
+// Draws a texture with premultiplied alpha on a quad
+const char* const kVertexShaderSource =
+        "uniform highp mat4 matrix;\n"
+        "attribute highp vec4 position;\n"
+        "attribute highp vec2 texcoord;\n"
+        "varying highp vec2 vTexcoord;\n"
+        "void main() {\n"
+        "    vTexcoord = texcoord;\n"
+        "    gl_Position = matrix * position;\n"
+        "}\n";
+const char* const kFragmentShaderSource =
+        "uniform sampler2D spinnyTexture;\n"
+        "varying highp vec2 vTexcoord;\n"
+        "void main() {\n"
+        "    gl_FragColor = texture2D(spinnyTexture, vTexcoord);\n"
+        "}\n";
+
+// QGLWidget::convertToGLFormat() flips the images vertically
+constexpr GLfloat kQuadTexcoords[] = {0, 1, 0, 0, 1, 1, 1, 0};
+
+} // anonymous namespace
+
 // The SampleBuffers format enables antialiasing.
 WSpinny::WSpinny(
         QWidget* parent,
@@ -62,6 +87,16 @@ WSpinny::WSpinny(
           m_dRotationsPerSecond(MIXXX_VINYL_SPEED_33_NUM / 60),
           m_bClampFailedWarning(false),
           m_bGhostPlayback(false),
+          m_bGLInitialized(false),
+          m_bgTexture(0),
+          m_maskTexture(0),
+          m_fgTexture(0),
+          m_ghostTexture(0),
+          m_coverTexture(0),
+          m_vinylQualityTexture(0),
+          m_bImageTexturesDirty(true),
+          m_bCoverTextureDirty(true),
+          m_bVinylQualityTextureDirty(true),
           m_pPlayer(pPlayer),
           m_pCoverMenu(new WCoverArtMenu(this)),
           m_pDlgCoverArt(new DlgCoverArtFullSize(parent, pPlayer, m_pCoverMenu)) {
@@ -108,6 +143,12 @@ WSpinny::~WSpinny() {
 #ifdef __VINYLCONTROL__
     m_pVCManager->removeSignalQualityListener(this);
 #endif
+    if (m_bGLInitialized) {
+        makeCurrent();
+        deleteTextures();
+        m_pShaderProgram.reset();
+        doneCurrent();
+    }
 }
 
 void WSpinny::onVinylSignalQualityUpdate(const VinylSignalQualityReport& report) {
@@ -141,6 +182,7 @@ void WSpinny::onVinylSignalQualityUpdate(const VinylSignalQualityReport& report)
             line++;
         }
     }
+    m_bVinylQualityTextureDirty = true;
 #else
     Q_UNUSED(report);
 #endif
@@ -177,6 +219,7 @@ void WSpinny::setup(const QDomNode& node,
         m_ghostImageScaled = m_pGhostImage->scaled(
                 size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
     }
+    m_bImageTexturesDirty = true;
 
     // Dynamic skin option, set in WSpinny's <ShowCoverControl> node.
     if (showCoverConfigKey.isValid()) {
@@ -201,6 +244,7 @@ void WSpinny::setup(const QDomNode& node,
     m_qImage = QImage(m_iVinylScopeSize, m_iVinylScopeSize, QImage::Format_ARGB32);
     // fill with transparent black
     m_qImage.fill(qRgba(0,0,0,0));
+    m_bVinylQualityTextureDirty = true;
 #endif
 
     m_pPlayPos = new ControlProxy(
@@ -258,6 +302,7 @@ void WSpinny::slotLoadTrack(TrackPointer pTrack) {
     m_lastRequestedCover = CoverInfo();
     m_loadedCover = QPixmap();
     m_loadedCoverScaled = QPixmap();
+    m_bCoverTextureDirty = true;
     m_loadedTrack = pTrack;
     if (m_loadedTrack) {
         connect(m_loadedTrack.get(),
@@ -281,6 +326,7 @@ void WSpinny::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack) {
     m_lastRequestedCover = CoverInfo();
     m_loadedCover = QPixmap();
     m_loadedCoverScaled = QPixmap();
+    m_bCoverTextureDirty = true;
     update();
 }
 
@@ -303,6 +349,7 @@ void WSpinny::slotCoverFound(
             m_loadedTrack->getLocation() == coverInfo.trackLocation) {
         m_loadedCover = pixmap;
         m_loadedCoverScaled = scaledCoverArt(pixmap);
+        m_bCoverTextureDirty = true;
         update();
     }
 }
@@ -344,46 +391,52 @@ void WSpinny::render(VSyncThread* vSyncThread) {
                 &m_dGhostAngleCurrentPlaypos);
     }
 
-    double scaleFactor = devicePixelRatioF();
+    if (context() != QGLContext::currentContext()) {
+        makeCurrent();
+    }
+    maybeInitializeGL();
+    if (!m_pShaderProgram->isLinked()) {
+        return;
+    }
+    updateImageTextures();
+
+    const double scaleFactor = devicePixelRatioF();
+    glViewport(0,
+            0,
+            static_cast<GLsizei>(width() * scaleFactor),
+            static_cast<GLsizei>(height() * scaleFactor));
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    m_pShaderProgram->bind();
 
-    QPainter p(this);
-    p.setRenderHint(QPainter::Antialiasing);
-    p.setRenderHint(QPainter::SmoothPixmapTransform);
+    // Maps the widget coordinates like a QPainter
+    QMatrix4x4 matrix;
+    matrix.ortho(rect());
 
-    if (m_pBgImage) {
-        p.drawImage(rect(), *m_pBgImage, m_pBgImage->rect());
-    }
+    drawTexture(m_bgTexture, matrix, rect());
 
     if (m_bShowCover && !m_loadedCoverScaled.isNull()) {
         // Some covers aren't square, so center them.
-        double x = (width() - m_loadedCoverScaled.width() / scaleFactor) / 2;
-        double y = (height() - m_loadedCoverScaled.height() / scaleFactor) / 2;
-        p.drawPixmap(QPointF(x, y), m_loadedCoverScaled);
+        const QSizeF coverSize = QSizeF(m_loadedCoverScaled.size()) / scaleFactor;
+        drawTexture(m_coverTexture,
+                matrix,
+                QRectF(QPointF((width() - coverSize.width()) / 2,
+                               (height() - coverSize.height()) / 2),
+                        coverSize));
     }
 
-    if (m_pMaskImage) {
-        p.drawImage(rect(), *m_pMaskImage, m_pMaskImage->rect());
-    }
+    drawTexture(m_maskTexture, matrix, rect());
 
 #ifdef __VINYLCONTROL__
     // Overlay the signal quality drawing if vinyl is active
     if (m_bVinylActive && m_bSignalActive) {
         // draw the last good image
-        p.drawImage(this->rect(), m_qImage);
+        drawTexture(m_vinylQualityTexture, matrix, rect());
     }
 #endif
 
-    // To rotate the foreground image around the center of the image,
-    // we use the classic trick of translating the coordinate system such that
-    // the origin is at the center of the image. We then rotate the coordinate system,
-    // and draw the image at the corner.
-    p.translate(width() / 2, height() / 2);
-
-    bool paintGhost = m_bGhostPlayback && m_pGhostImage && !m_pGhostImage->isNull();
-    if (paintGhost) {
-        p.save();
-    }
-
     if (m_dAngleCurrentPlaypos != m_dAngleLastPlaypos) {
         m_fAngle = static_cast<float>(calculateAngle(m_dAngleCurrentPlaypos));
         m_dAngleLastPlaypos = m_dAngleCurrentPlaypos;
@@ -394,24 +447,142 @@ void WSpinny::render(VSyncThread* vSyncThread) {
         m_dGhostAngleLastPlaypos = m_dGhostAngleCurrentPlaypos;
     }
 
-    if (paintGhost) {
-        p.restore();
-        p.save();
-        p.rotate(m_fGhostAngle);
-        p.drawImage(-(m_ghostImageScaled.width() / 2),
-                    -(m_ghostImageScaled.height() / 2), m_ghostImageScaled);
+    // The images are rotated around the center of the widget by the
+    // transformation of the quad, without touching their pixels.
+    QMatrix4x4 centerMatrix = matrix;
+    centerMatrix.translate(width() / 2.0f, height() / 2.0f);
 
-        //Rotate back to the playback position (not the ghost position),
-        //and draw the beat marks from there.
-        p.restore();
+    if (m_bGhostPlayback && !m_ghostImageScaled.isNull()) {
+        QMatrix4x4 ghostMatrix = centerMatrix;
+        ghostMatrix.rotate(m_fGhostAngle, 0, 0, 1);
+        const QSizeF ghostSize = m_ghostImageScaled.size();
+        drawTexture(m_ghostTexture,
+                ghostMatrix,
+                QRectF(QPointF(-ghostSize.width() / 2, -ghostSize.height() / 2),
+                        ghostSize));
     }
 
-    if (m_pFgImage && !m_pFgImage->isNull()) {
-        // Now rotate the image and draw it on the screen.
-        p.rotate(m_fAngle);
-        p.drawImage(-(m_fgImageScaled.width() / 2),
-                    -(m_fgImageScaled.height() / 2), m_fgImageScaled);
+    if (!m_fgImageScaled.isNull()) {
+        QMatrix4x4 fgMatrix = centerMatrix;
+        fgMatrix.rotate(m_fAngle, 0, 0, 1);
+        const QSizeF fgSize = m_fgImageScaled.size();
+        drawTexture(m_fgTexture,
+                fgMatrix,
+                QRectF(QPointF(-fgSize.width() / 2, -fgSize.height() / 2), fgSize));
+    }
+
+    m_pShaderProgram->release();
+    glDisable(GL_BLEND);
+}
+
+void WSpinny::maybeInitializeGL() {
+    if (m_bGLInitialized) {
+        return;
+    }
+    m_bGLInitialized = true;
+    initializeOpenGLFunctions();
+
+    m_pShaderProgram = std::make_unique<QGLShaderProgram>(context());
+    if (!m_pShaderProgram->addShaderFromSourceCode(
+                QGLShader::Vertex, kVertexShaderSource) ||
+            !m_pShaderProgram->addShaderFromSourceCode(
+                    QGLShader::Fragment, kFragmentShaderSource) ||
+            !m_pShaderProgram->link()) {
+        qWarning() << "WSpinny: Failed to build the shader program"
+                   << m_pShaderProgram->log();
+    }
+}
+
+void WSpinny::updateImageTextures() {
+    if (m_bImageTexturesDirty) {
+        updateTexture(&m_bgTexture, m_pBgImage ? *m_pBgImage : QImage());
+        updateTexture(&m_maskTexture, m_pMaskImage ? *m_pMaskImage : QImage());
+        updateTexture(&m_fgTexture, m_fgImageScaled);
+        updateTexture(&m_ghostTexture, m_ghostImageScaled);
+        m_bImageTexturesDirty = false;
+    }
+    if (m_bCoverTextureDirty) {
+        updateTexture(&m_coverTexture, m_loadedCoverScaled.toImage());
+        m_bCoverTextureDirty = false;
+    }
+    if (m_bVinylQualityTextureDirty) {
+        updateTexture(&m_vinylQualityTexture, m_qImage);
+        m_bVinylQualityTextureDirty = false;
+    }
+}
+
+void WSpinny::updateTexture(GLuint* pTexture, const QImage& image) {
+    if (image.isNull()) {
+        if (*pTexture != 0) {
+            glDeleteTextures(1, pTexture);
+            *pTexture = 0;
+        }
+        return;
+    }
+    if (*pTexture == 0) {
+        glGenTextures(1, pTexture);
+        glBindTexture(GL_TEXTURE_2D, *pTexture);
+        // Images may have any size, which restricts OpenGL ES to these
+        // parameters
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, *pTexture);
+    }
+    const QImage glImage = QGLWidget::convertToGLFormat(
+            image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+    glTexImage2D(GL_TEXTURE_2D,
+            0,
+            GL_RGBA,
+            glImage.width(),
+            glImage.height(),
+            0,
+            GL_RGBA,
+            GL_UNSIGNED_BYTE,
+            glImage.constBits());
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void WSpinny::deleteTextures() {
+    for (GLuint* pTexture : {&m_bgTexture,
+                 &m_maskTexture,
+                 &m_fgTexture,
+                 &m_ghostTexture,
+                 &m_coverTexture,
+                 &m_vinylQualityTexture}) {
+        updateTexture(pTexture, QImage());
+    }
+}
+
+void WSpinny::drawTexture(GLuint texture, const QMatrix4x4& matrix, const QRectF& rect) {
+    if (texture == 0) {
+        return;
     }
+    // A triangle strip from the top left to the bottom right corner
+    const GLfloat vertices[] = {
+            static_cast<GLfloat>(rect.left()),
+            static_cast<GLfloat>(rect.top()),
+            static_cast<GLfloat>(rect.left()),
+            static_cast<GLfloat>(rect.bottom()),
+            static_cast<GLfloat>(rect.right()),
+            static_cast<GLfloat>(rect.top()),
+            static_cast<GLfloat>(rect.right()),
+            static_cast<GLfloat>(rect.bottom())};
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    m_pShaderProgram->setUniformValue("matrix", matrix);
+    m_pShaderProgram->setUniformValue("spinnyTexture", 0);
+    m_pShaderProgram->enableAttributeArray("position");
+    m_pShaderProgram->enableAttributeArray("texcoord");
+    m_pShaderProgram->setAttributeArray("position", GL_FLOAT, vertices, 2);
+    m_pShaderProgram->setAttributeArray("texcoord", GL_FLOAT, kQuadTexcoords, 2);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    m_pShaderProgram->disableAttributeArray("position");
+    m_pShaderProgram->disableAttributeArray("texcoord");
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void WSpinny::swap() {
@@ -441,6 +612,8 @@ QPixmap WSpinny::scaledCoverArt(const QPixmap& normal) {
 
 void WSpinny::resizeEvent(QResizeEvent* /*unused*/) {
     m_loadedCoverScaled = scaledCoverArt(m_loadedCover);
+    m_bCoverTextureDirty = true;
+    m_bImageTexturesDirty = true;
     if (m_pFgImage && !m_pFgImage->isNull()) {
         m_fgImageScaled = m_pFgImage->scaled(
                 size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
@@ -3,7 +3,9 @@
 #include <QEvent>
 #include <QGLWidget>
 #include <QHideEvent>
+#include <QOpenGLFunctions>
 #include <QShowEvent>
+#include <memory>
 
 #include "library/dlgcoverartfullsize.h"
 #include "mixer/basetrackplayer.h"
@@ -18,12 +20,17 @@
 
 class ConfigKey;
 class ControlProxy;
+class QGLShaderProgram;
+class QMatrix4x4;
 class VisualPlayPosition;
 class VinylControlManager;
 class VSyncThread;
 
-class WSpinny : public QGLWidget, public WBaseWidget, public VinylSignalQualityListener,
-                public TrackDropTarget {
+class WSpinny : public QGLWidget,
+                public WBaseWidget,
+                public VinylSignalQualityListener,
+                public TrackDropTarget,
+                protected QOpenGLFunctions {
     Q_OBJECT
   public:
     WSpinny(QWidget* parent, const QString& group,
@@ -83,6 +90,14 @@ class WSpinny : public QGLWidget, public WBaseWidget, public VinylSignalQualityL
     QPixmap scaledCoverArt(const QPixmap& normal);
 
   private:
+    // The context of the widget must be current for all of these
+    void maybeInitializeGL();
+    void updateImageTextures();
+    // Replaces the texture by a copy of the image, or deletes it if the image is null
+    void updateTexture(GLuint* pTexture, const QImage& image);
+    void deleteTextures();
+    void drawTexture(GLuint texture, const QMatrix4x4& matrix, const QRectF& rect);
+
     const QString m_group;
     UserSettingsPointer m_pConfig;
     std::shared_ptr<QImage> m_pBgImage;
@@ -134,6 +149,20 @@ class WSpinny : public QGLWidget, public WBaseWidget, public VinylSignalQualityL
     bool m_bClampFailedWarning;
     bool m_bGhostPlayback;
 
+    // All images are drawn as textured quads, which are only uploaded
+    // again after the images have changed.
+    bool m_bGLInitialized;
+    std::unique_ptr<QGLShaderProgram> m_pShaderProgram;
+    GLuint m_bgTexture;
+    GLuint m_maskTexture;
+    GLuint m_fgTexture;
+    GLuint m_ghostTexture;
+    GLuint m_coverTexture;
+    GLuint m_vinylQualityTexture;
+    bool m_bImageTexturesDirty;
+    bool m_bCoverTextureDirty;
+    bool m_bVinylQualityTextureDirty;
+
     BaseTrackPlayer* m_pPlayer;
     WCoverArtMenu* m_pCoverMenu;
     DlgCoverArtFullSize* m_pDlgCoverArt;
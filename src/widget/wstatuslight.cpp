@@ -7,6 +7,7 @@
 #include <QtDebug>
 
 #include "moc_wstatuslight.cpp"
+#include "util/widgetrepaintscheduler.h"
 
 WStatusLight::WStatusLight(QWidget * parent)
         : WWidget(parent),
@@ -93,7 +94,7 @@ void WStatusLight::onConnectedControlChanged(double dParameter, double dValue) {
 
     if (newPos != m_iPos) {
         m_iPos = newPos;
-        update();
+        WidgetRepaintScheduler::scheduleUpdate(this);
     }
 }
 
@@ -120,6 +120,18 @@ void WTrackMenu::createMenus() {
         m_pPlaylistMenu = new QMenu(this);
         m_pPlaylistMenu->setTitle(tr("Add to Playlist"));
         connect(m_pPlaylistMenu, &QMenu::aboutToShow, this, &WTrackMenu::slotPopulatePlaylistMenu);
+        // The playlist menu doesn't depend on the selected tracks and is
+        // only rebuilt after the playlists have changed
+        const PlaylistDAO* pPlaylistDao = &m_pLibrary->trackCollectionManager()
+                                                   ->internalCollection()
+                                                   ->getPlaylistDAO();
+        connect(pPlaylistDao, &PlaylistDAO::added, this, &WTrackMenu::slotInvalidatePlaylistMenu);
+        connect(pPlaylistDao, &PlaylistDAO::deleted, this, &WTrackMenu::slotInvalidatePlaylistMenu);
+        connect(pPlaylistDao, &PlaylistDAO::renamed, this, &WTrackMenu::slotInvalidatePlaylistMenu);
+        connect(pPlaylistDao,
+                &PlaylistDAO::lockChanged,
+                this,
+                &WTrackMenu::slotInvalidatePlaylistMenu);
     }
 
     if (featureIsEnabled(Feature::Crate)) {
@@ -127,6 +139,22 @@ void WTrackMenu::createMenus() {
         m_pCrateMenu->setTitle(tr("Crates"));
         m_pCrateMenu->setObjectName("CratesMenu");
         connect(m_pCrateMenu, &QMenu::aboutToShow, this, &WTrackMenu::slotPopulateCrateMenu);
+        // The check boxes of the crates are reused until the crates have
+        // changed, only their states depend on the selected tracks
+        const TrackCollection* pTrackCollection =
+                m_pLibrary->trackCollectionManager()->internalCollection();
+        connect(pTrackCollection,
+                &TrackCollection::crateInserted,
+                this,
+                &WTrackMenu::slotInvalidateCrateMenu);
+        connect(pTrackCollection,
+                &TrackCollection::crateUpdated,
+                this,
+                &WTrackMenu::slotInvalidateCrateMenu);
+        connect(pTrackCollection,
+                &TrackCollection::crateDeleted,
+                this,
+                &WTrackMenu::slotInvalidateCrateMenu);
     }
 
     if (featureIsEnabled(Feature::Metadata)) {
@@ -781,11 +809,9 @@ void WTrackMenu::updateMenus() {
         }
     }
 
-    if (featureIsEnabled(Feature::Playlist)) {
-        // Playlist menu is lazy loaded on hover by slotPopulatePlaylistMenu
-        // to avoid unnecessary database queries
-        m_bPlaylistMenuLoaded = false;
-    }
+    // The playlist menu is lazy loaded on hover by slotPopulatePlaylistMenu
+    // to avoid unnecessary database queries, and kept until the playlists
+    // change
 
     if (featureIsEnabled(Feature::Crate)) {
         // Crate menu is lazy loaded on hover by slotPopulateCrateMenu
@@ -1156,27 +1182,18 @@ void WTrackMenu::slotPopulatePlaylistMenu() {
     const PlaylistDAO& playlistDao = m_pLibrary->trackCollectionManager()
                                              ->internalCollection()
                                              ->getPlaylistDAO();
-    QMap<QString, int> playlists;
-    int numPlaylists = playlistDao.playlistCount();
-    for (int i = 0; i < numPlaylists; ++i) {
-        int iPlaylistId = playlistDao.getPlaylistId(i);
-        playlists.insert(playlistDao.getPlaylistName(iPlaylistId), iPlaylistId);
-    }
-    QMapIterator<QString, int> it(playlists);
-    while (it.hasNext()) {
-        it.next();
-        if (!playlistDao.isHidden(it.value())) {
-            // No leak because making the menu the parent means they will be
-            // auto-deleted
-            auto* pAction = new QAction(
-                    mixxx::escapeTextPropertyWithoutShortcuts(it.key()),
-                    m_pPlaylistMenu);
-            bool locked = playlistDao.isPlaylistLocked(it.value());
-            pAction->setEnabled(!locked);
-            m_pPlaylistMenu->addAction(pAction);
-            int iPlaylistId = it.value();
-            connect(pAction, &QAction::triggered, this, [this, iPlaylistId] { addSelectionToPlaylist(iPlaylistId); });
-        }
+    const QList<PlaylistDAO::PlaylistInfo> playlistInfos =
+            playlistDao.getPlaylistInfos(PlaylistDAO::PLHT_NOT_HIDDEN);
+    for (const auto& playlistInfo : playlistInfos) {
+        // No leak because making the menu the parent means they will be
+        // auto-deleted
+        auto* pAction = new QAction(
+                mixxx::escapeTextPropertyWithoutShortcuts(playlistInfo.name),
+                m_pPlaylistMenu);
+        pAction->setEnabled(!playlistInfo.locked);
+        m_pPlaylistMenu->addAction(pAction);
+        const int iPlaylistId = playlistInfo.id;
+        connect(pAction, &QAction::triggered, this, [this, iPlaylistId] { addSelectionToPlaylist(iPlaylistId); });
     }
     m_pPlaylistMenu->addSeparator();
     QAction* newPlaylistAction = new QAction(tr("Create New Playlist"), m_pPlaylistMenu);
@@ -1185,6 +1202,10 @@ void WTrackMenu::slotPopulatePlaylistMenu() {
     m_bPlaylistMenuLoaded = true;
 }
 
+void WTrackMenu::slotInvalidatePlaylistMenu() {
+    m_bPlaylistMenuLoaded = false;
+}
+
 void WTrackMenu::addSelectionToPlaylist(int iPlaylistId) {
     const TrackIdList trackIds = getTrackIds();
     if (trackIds.isEmpty()) {
@@ -1245,7 +1266,6 @@ void WTrackMenu::slotPopulateCrateMenu() {
     if (m_bCrateMenuLoaded) {
         return;
     }
-    m_pCrateMenu->clear();
     const TrackIdList trackIds = getTrackIds();
 
     CrateSummarySelectResult allCrates(
@@ -1255,6 +1275,23 @@ void WTrackMenu::slotPopulateCrateMenu() {
                     .selectCratesWithTrackCount(trackIds));
 
     CrateSummary crate;
+    if (!m_crateCheckBoxes.isEmpty()) {
+        // Only the track counts have changed since the check boxes were
+        // created
+        while (allCrates.populateNext(&crate)) {
+            QCheckBox* pCheckBox = m_crateCheckBoxes.value(crate.getId());
+            VERIFY_OR_DEBUG_ASSERT(pCheckBox) {
+                continue;
+            }
+            // Don't add or remove tracks from the crate
+            const QSignalBlocker signalBlocker(pCheckBox);
+            updateCrateCheckBox(pCheckBox, crate.getTrackCount(), trackIds.length());
+        }
+        m_bCrateMenuLoaded = true;
+        return;
+    }
+
+    m_pCrateMenu->clear();
     while (allCrates.populateNext(&crate)) {
         auto pAction = make_parented<QWidgetAction>(
                 m_pCrateMenu);
@@ -1280,14 +1317,8 @@ void WTrackMenu::slotPopulateCrateMenu() {
         pAction->setEnabled(!crate.isLocked());
         pAction->setDefaultWidget(pCheckBox.get());
 
-        if (crate.getTrackCount() == 0) {
-            pCheckBox->setChecked(false);
-        } else if (crate.getTrackCount() == (uint)trackIds.length()) {
-            pCheckBox->setChecked(true);
-        } else {
-            pCheckBox->setTristate(true);
-            pCheckBox->setCheckState(Qt::PartiallyChecked);
-        }
+        updateCrateCheckBox(pCheckBox.get(), crate.getTrackCount(), trackIds.length());
+        m_crateCheckBoxes.insert(crate.getId(), pCheckBox.get());
 
         m_pCrateMenu->addAction(pAction.get());
         connect(pAction.get(), &QAction::triggered, this, [this, pCheckBox{pCheckBox.get()}] { updateSelectionCrates(pCheckBox); });
@@ -1300,6 +1331,25 @@ void WTrackMenu::slotPopulateCrateMenu() {
     m_bCrateMenuLoaded = true;
 }
 
+void WTrackMenu::slotInvalidateCrateMenu() {
+    m_crateCheckBoxes.clear();
+    m_bCrateMenuLoaded = false;
+}
+
+// static
+void WTrackMenu::updateCrateCheckBox(QCheckBox* pCheckBox, uint trackCount, int numTracks) {
+    if (trackCount == 0) {
+        pCheckBox->setTristate(false);
+        pCheckBox->setChecked(false);
+    } else if (trackCount == static_cast<uint>(numTracks)) {
+        pCheckBox->setTristate(false);
+        pCheckBox->setChecked(true);
+    } else {
+        pCheckBox->setTristate(true);
+        pCheckBox->setCheckState(Qt::PartiallyChecked);
+    }
+}
+
 void WTrackMenu::updateSelectionCrates(QWidget* pWidget) {
     auto* pCheckBox = qobject_cast<QCheckBox*>(pWidget);
     VERIFY_OR_DEBUG_ASSERT(pCheckBox) {
@@ -2028,7 +2078,8 @@ void WTrackMenu::slotShowDlgTrackInfo() {
     // Create a fresh dialog on invocation
     m_pDlgTrackInfo = std::make_unique<DlgTrackInfo>(
             m_pConfig,
-            m_pTrackModel);
+            m_pTrackModel,
+            &m_pLibrary->trackCollectionManager()->internalCollection()->getAnalysisDAO());
     connect(m_pDlgTrackInfo.get(),
             &QDialog::finished,
             this,
@@ -2052,7 +2103,8 @@ void WTrackMenu::slotShowDlgTagFetcher() {
     }
     // Create a fresh dialog on invocation
     m_pDlgTagFetcher = std::make_unique<DlgTagFetcher>(
-            m_pTrackModel);
+            m_pTrackModel,
+            &m_pLibrary->trackCollectionManager()->internalCollection()->getAnalysisDAO());
     connect(m_pDlgTagFetcher.get(),
             &QDialog::finished,
             this,
@@ -8,6 +8,7 @@
 #include "library/coverart.h"
 #include "library/dao/playlistdao.h"
 #include "library/trackprocessing.h"
+#include "library/trackset/crate/crateid.h"
 #include "preferences/usersettings.h"
 #include "track/beats.h"
 #include "track/trackref.h"
@@ -20,6 +21,7 @@ class DlgTrackInfo;
 //class DlgDeleteFilesConfirmation;
 class ExternalTrackCollection;
 class Library;
+class QCheckBox;
 class TrackModel;
 class WColorPickerAction;
 class WCoverArtMenu;
@@ -131,7 +133,9 @@ class WTrackMenu : public QMenu {
 
     // Playlist and crate
     void slotPopulatePlaylistMenu();
+    void slotInvalidatePlaylistMenu();
     void slotPopulateCrateMenu();
+    void slotInvalidateCrateMenu();
     void addSelectionToNewCrate();
 
     // Auto DJ
@@ -186,6 +190,7 @@ class WTrackMenu : public QMenu {
 
     void addSelectionToPlaylist(int iPlaylistId);
     void updateSelectionCrates(QWidget* pWidget);
+    static void updateCrateCheckBox(QCheckBox* pCheckBox, uint trackCount, int numTracks);
 
     void addToAutoDJ(PlaylistDAO::AutoDJSendLoc loc);
     void addToAnalysis();
@@ -318,6 +323,8 @@ class WTrackMenu : public QMenu {
 
     bool m_bPlaylistMenuLoaded;
     bool m_bCrateMenuLoaded;
+    // The check boxes in m_pCrateMenu, empty until it is populated
+    QHash<CrateId, QCheckBox*> m_crateCheckBoxes;
 
     Features m_eActiveFeatures;
     const Features m_eTrackModelFeatures;
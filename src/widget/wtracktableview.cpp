@@ -7,6 +7,7 @@
 #include <QUrl>
 
 #include "control/controlobject.h"
+#include "library/basesqltablemodel.h"
 #include "library/dao/trackschema.h"
 #include "library/library.h"
 #include "library/library_prefs.h"
@@ -155,6 +156,9 @@ void WTrackTableView::loadTrackModel(QAbstractItemModel* model, bool restoreStat
         return;
     }
 
+    // Callbacks must not be invoked for another model
+    disconnect(m_selectFinishedConnection);
+
     // If the model has not changed there's no need to exchange the headers
     // which would cause a small GUI freeze
     if (getTrackModel() == trackModel) {
@@ -164,7 +168,9 @@ void WTrackTableView::loadTrackModel(QAbstractItemModel* model, bool restoreStat
                 horizontalHeader()->sortIndicatorOrder());
 
         if (restoreState) {
-            restoreCurrentViewState();
+            afterSelectFinished([this] {
+                restoreCurrentViewState();
+            });
         }
         return;
     }
@@ -319,11 +325,32 @@ void WTrackTableView::loadTrackModel(QAbstractItemModel* model, bool restoreStat
 
     // trigger restoring scrollBar position, selection etc.
     if (restoreState) {
-        restoreCurrentViewState();
+        afterSelectFinished([this] {
+            restoreCurrentViewState();
+        });
     }
     initTrackMenu();
 }
 
+void WTrackTableView::afterSelectFinished(std::function<void()> callback) {
+    disconnect(m_selectFinishedConnection);
+    const auto* pSqlTableModel = qobject_cast<BaseSqlTableModel*>(model());
+    if (!pSqlTableModel || !pSqlTableModel->isSelectPending()) {
+        callback();
+        return;
+    }
+    // Only the most recent callback is invoked
+    m_selectFinishedConnection = connect(pSqlTableModel,
+            &BaseSqlTableModel::selectFinished,
+            this,
+            [this, callback = std::move(callback)] {
+                // The connection owns the callback
+                const auto pendingCallback = callback;
+                disconnect(m_selectFinishedConnection);
+                pendingCallback();
+            });
+}
+
 void WTrackTableView::initTrackMenu() {
     auto* trackModel = getTrackModel();
     DEBUG_ASSERT(trackModel);
@@ -457,6 +484,17 @@ void WTrackTableView::slotDeleteTracksFromDisk() {
     m_pTrackMenu->slotRemoveFromDisk();
 }
 
+void WTrackTableView::slotHide() {
+    QModelIndexList indices = selectionModel()->selectedRows();
+    if (indices.isEmpty()) {
+        return;
+    }
+    TrackModel* trackModel = getTrackModel();
+    if (trackModel) {
+        trackModel->hideTracks(indices);
+    }
+}
+
 void WTrackTableView::slotUnhide() {
     QModelIndexList indices = selectionModel()->selectedRows();
     if (indices.isEmpty()) {
@@ -510,21 +548,27 @@ void WTrackTableView::onSearch(const QString& text) {
             prevColumn = currentIndex().column();
         }
         trackModel->search(text);
-        if (queryIsLessSpecific) {
-            // If the user removed query terms, we try to select the same
-            // tracks as before
-            setCurrentTrackId(prevTrack, prevColumn);
-            setSelectedTracks(selectedTracks);
-        } else {
-            // The user created a more specific search query, try to restore a
-            // previous state
-            if (!restoreCurrentViewState()) {
-                // We found no saved state for this query, try to select the
-                // tracks last active, if they are part of the result set
+        afterSelectFinished([this,
+                                    queryIsLessSpecific,
+                                    selectedTracks,
+                                    prevTrack,
+                                    prevColumn] {
+            if (queryIsLessSpecific) {
+                // If the user removed query terms, we try to select the same
+                // tracks as before
                 setCurrentTrackId(prevTrack, prevColumn);
                 setSelectedTracks(selectedTracks);
+            } else {
+                // The user created a more specific search query, try to restore a
+                // previous state
+                if (!restoreCurrentViewState()) {
+                    // We found no saved state for this query, try to select the
+                    // tracks last active, if they are part of the result set
+                    setCurrentTrackId(prevTrack, prevColumn);
+                    setSelectedTracks(selectedTracks);
+                }
             }
-        }
+        });
     }
 }
 
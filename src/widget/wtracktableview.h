@@ -2,6 +2,7 @@
 
 #include <QAbstractItemModel>
 #include <QSortFilterProxyModel>
+#include <functional>
 
 #include "control/controlproxy.h"
 #include "control/pollingcontrolproxy.h"
@@ -61,6 +62,7 @@ class WTrackTableView : public WLibraryTableView {
   public slots:
     void loadTrackModel(QAbstractItemModel* model, bool restoreState = false);
     void slotMouseDoubleClicked(const QModelIndex &);
+    void slotHide();
     void slotUnhide();
     void slotPurge();
     void slotDeleteTracksFromDisk();
@@ -111,6 +113,10 @@ class WTrackTableView : public WLibraryTableView {
 
     void initTrackMenu();
 
+    // Invokes the callback after the rows of the current model have been
+    // selected. Rows might still be selected asynchronously in the background.
+    void afterSelectFinished(std::function<void()> callback);
+
     void hideOrRemoveSelectedTracks();
 
     const UserSettingsPointer m_pConfig;
@@ -123,6 +129,8 @@ class WTrackTableView : public WLibraryTableView {
     QColor m_pFocusBorderColor;
     bool m_sorting;
 
+    QMetaObject::Connection m_selectFinishedConnection;
+
     // Control the delay to load a cover art.
     mixxx::Duration m_lastUserAction;
     bool m_selectionChangedSinceLastGuiTick;
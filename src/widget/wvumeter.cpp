@@ -9,6 +9,7 @@
 #include "moc_wvumeter.cpp"
 #include "util/math.h"
 #include "util/timer.h"
+#include "util/widgetrepaintscheduler.h"
 #include "widget/wpixmapstore.h"
 
 #define DEFAULT_FALLTIME 20
@@ -150,7 +151,7 @@ void WVuMeter::updateState(mixxx::Duration elapsed) {
 
 void WVuMeter::maybeUpdate() {
     if (m_dParameter != m_dLastParameter || m_dPeakParameter != m_dLastPeakParameter) {
-        repaint();
+        WidgetRepaintScheduler::scheduleUpdate(this);
     }
 }
 
@@ -3,11 +3,13 @@ import argparse
 import sys
 
 # To use, run this from the top level of the Git repository tree:
-# scripts/generate_sample_functions.py
+# tools/generate_sample_functions.py
 #     --sample_autogen_h src/util/sample_autogen.h
 
 BASIC_INDENT = 4
 
+TARGET_CLONES_MACRO = "SAMPLEUTIL_TARGET_CLONES"
+
 COPY_WITH_GAIN_METHOD_PATTERN = "copy%(i)dWithGain"
 
 
@@ -44,19 +46,16 @@ def hanging_indent(base, groups, hanging_suffix, terminator, depth=0):
 
 
 def write_sample_autogen(output, num_channels):
-    output.append("#ifndef MIXXX_UTIL_SAMPLEAUTOGEN_H")
-    output.append("#define MIXXX_UTIL_SAMPLEAUTOGEN_H")
+    output.append("#pragma once")
     output.append("////////////////////////////////////////////////////////")
     output.append("// THIS FILE IS AUTO-GENERATED. DO NOT EDIT DIRECTLY! //")
-    output.append("// SEE scripts/generate_sample_functions.py           //")
+    output.append("// SEE tools/generate_sample_functions.py             //")
     output.append("////////////////////////////////////////////////////////")
 
     for i in range(1, num_channels + 1):
         copy_with_gain(output, 0, i)
         copy_with_ramping_gain(output, 0, i)
 
-    output.append("#endif /* MIXXX_UTIL_SAMPLEAUTOGEN_H */")
-
 
 def copy_with_gain(output, base_indent_depth, num_channels):
     def write(data, depth=0):
@@ -67,6 +66,8 @@ def copy_with_gain(output, base_indent_depth, num_channels):
     header = "static inline void %s(" % copy_with_gain_method_name(
         num_channels
     )
+    # Multi-versioned for the supported instruction sets, see util/sample.h
+    write(TARGET_CLONES_MACRO)
     arg_groups = (
         ["CSAMPLE* M_RESTRICT pDest"]
         + [
@@ -126,6 +127,8 @@ def copy_with_ramping_gain(output, base_indent_depth, num_channels):
     header = "static inline void %s(" % copy_with_ramping_gain_method_name(
         num_channels
     )
+    # Multi-versioned for the supported instruction sets, see util/sample.h
+    write(TARGET_CLONES_MACRO)
     arg_groups = (
         ["CSAMPLE* M_RESTRICT pDest"]
         + [